@@ -161,6 +161,38 @@ TEST(BoundedQueueTest, busy_wait) {
   t.join();
 }
 
+TEST(BoundedQueueTest, adaptive_wait) {
+  BoundedQueue<int> queue;
+  auto strategy = new AdaptiveWaitStrategy();
+  queue.Init(100, strategy);
+  std::atomic<int> sum = {0};
+  std::thread t([&]() {
+    int value = 0;
+    while (queue.WaitDequeue(&value)) {
+      sum += value;
+    }
+  });
+  // a fast producer the consumer keeps up with by spinning
+  for (int i = 0; i < 1000; ++i) {
+    while (!queue.Enqueue(1)) {
+    }
+  }
+  EXPECT_GT(strategy->average_interval_ns(), 0);
+  // and a slow one it parks on
+  for (int i = 0; i < 10; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    queue.Enqueue(1);
+  }
+  EXPECT_GT(strategy->average_interval_ns(), 500 * 1000);
+  while (!queue.Empty()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.BreakAllWait();
+  t.join();
+  EXPECT_EQ(1010, sum.load());
+}
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
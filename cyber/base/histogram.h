@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_HISTOGRAM_H_
+#define CYBER_BASE_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+// Lock-free histogram with power-of-two buckets. Recording a sample costs a
+// few relaxed atomic operations, so it can be used on hot paths such as
+// transport wake-ups. Bucket i holds samples in [2^(i-1), 2^i - 1].
+class Histogram {
+ public:
+  static const int kBucketNum = 65;
+
+  Histogram() { Reset(); }
+
+  void Record(uint64_t value) {
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(
+                              max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  void Reset() {
+    for (auto& bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+  uint64_t Bucket(int i) const {
+    return buckets_[i].load(std::memory_order_relaxed);
+  }
+  uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t Mean() const {
+    uint64_t count = Count();
+    return count == 0 ? 0 : sum_.load(std::memory_order_relaxed) / count;
+  }
+
+  // Upper bound of the bucket holding the p-th percentile, p in [0, 100].
+  uint64_t Percentile(double p) const {
+    uint64_t count = Count();
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(p / 100.0 * count + 0.5);
+    target = target == 0 ? 1 : target;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketNum; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        uint64_t upper = i == 0 ? 0 : (i == 64 ? UINT64_MAX : (1ULL << i) - 1);
+        return upper < Max() ? upper : Max();
+      }
+    }
+    return Max();
+  }
+
+  std::string ToString() const {
+    std::ostringstream oss;
+    oss << "count: " << Count() << " mean: " << Mean()
+        << " p50: " << Percentile(50) << " p90: " << Percentile(90)
+        << " p99: " << Percentile(99) << " max: " << Max();
+    return oss.str();
+  }
+
+ private:
+  static int BucketIndex(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+  }
+
+  std::atomic<uint64_t> buckets_[kBucketNum];
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_HISTOGRAM_H_
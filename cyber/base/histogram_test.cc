@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/histogram.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(HistogramTest, empty) {
+  Histogram histogram;
+  EXPECT_EQ(0, histogram.Count());
+  EXPECT_EQ(0, histogram.Mean());
+  EXPECT_EQ(0, histogram.Percentile(50));
+}
+
+TEST(HistogramTest, percentile) {
+  Histogram histogram;
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.Record(i);
+  }
+  EXPECT_EQ(100, histogram.Count());
+  EXPECT_EQ(50, histogram.Mean());
+  EXPECT_EQ(100, histogram.Max());
+  // 50 falls in bucket [32, 63]
+  EXPECT_EQ(63, histogram.Percentile(50));
+  // clamped to the max sample
+  EXPECT_EQ(100, histogram.Percentile(99));
+  EXPECT_EQ(1, histogram.Percentile(0));
+
+  histogram.Record(0);
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.Count());
+  EXPECT_EQ(0, histogram.Max());
+}
+
+TEST(HistogramTest, concurrent_record) {
+  Histogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&histogram]() {
+      for (int j = 0; j < 10000; ++j) {
+        histogram.Record(j);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(40000, histogram.Count());
+  EXPECT_EQ(9999, histogram.Max());
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
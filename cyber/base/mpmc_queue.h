@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_MPMC_QUEUE_H_
+#define CYBER_BASE_MPMC_QUEUE_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+/**
+ * @brief A bounded lock-free multi-producer multi-consumer queue.
+ *
+ * Every cell carries a sequence number telling whether it is ready to be
+ * written or read at a given position, so producers and consumers only
+ * contend on their own position counter and never wait for each other to
+ * commit, unlike BoundedQueue.
+ */
+template <typename T>
+class MPMCQueue {
+ public:
+  MPMCQueue() {}
+  MPMCQueue(const MPMCQueue& other) = delete;
+  MPMCQueue& operator=(const MPMCQueue& other) = delete;
+  ~MPMCQueue() = default;
+
+  // the capacity is rounded up to a power of two
+  bool Init(uint64_t capacity);
+  bool Enqueue(const T& element) { return Emplace(element); }
+  bool Enqueue(T&& element) { return Emplace(std::move(element)); }
+  bool Dequeue(T* element);
+  uint64_t Size();
+  bool Empty() { return Size() == 0; }
+  uint64_t Capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<uint64_t> seq;
+    T data;
+  };
+
+  template <typename U>
+  bool Emplace(U&& element);
+
+  std::unique_ptr<Cell[]> cells_;
+  uint64_t mask_ = 0;
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> enqueue_pos_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> dequeue_pos_ = {0};
+};
+
+template <typename T>
+bool MPMCQueue<T>::Init(uint64_t capacity) {
+  if (capacity == 0 || cells_ != nullptr) {
+    return false;
+  }
+  uint64_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  cells_.reset(new Cell[size]);
+  for (uint64_t i = 0; i < size; ++i) {
+    cells_[i].seq.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+  return true;
+}
+
+template <typename T>
+template <typename U>
+bool MPMCQueue<T>::Emplace(U&& element) {
+  uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Cell* cell = nullptr;
+  while (true) {
+    cell = &cells_[pos & mask_];
+    uint64_t seq = cell->seq.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the cell still holds an element from the previous lap
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->data = std::forward<U>(element);
+  cell->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool MPMCQueue<T>::Dequeue(T* element) {
+  uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  Cell* cell = nullptr;
+  while (true) {
+    cell = &cells_[pos & mask_];
+    uint64_t seq = cell->seq.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  *element = std::move(cell->data);
+  cell->data = T();
+  cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+uint64_t MPMCQueue<T>::Size() {
+  uint64_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+  uint64_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+  return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_MPMC_QUEUE_H_
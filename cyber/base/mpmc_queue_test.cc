@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/mpmc_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(MPMCQueueTest, Enqueue) {
+  MPMCQueue<int> queue;
+  EXPECT_TRUE(queue.Init(100));
+  EXPECT_FALSE(queue.Init(100));
+  EXPECT_EQ(128, queue.Capacity());
+  EXPECT_TRUE(queue.Empty());
+  for (int i = 1; i <= 128; i++) {
+    EXPECT_TRUE(queue.Enqueue(i));
+    EXPECT_EQ(i, queue.Size());
+  }
+  EXPECT_FALSE(queue.Enqueue(129));
+}
+
+TEST(MPMCQueueTest, Dequeue) {
+  MPMCQueue<std::shared_ptr<int>> queue;
+  EXPECT_TRUE(queue.Init(4));
+  std::shared_ptr<int> value;
+  for (int i = 0; i < 100; i++) {
+    auto element = std::make_shared<int>(i);
+    EXPECT_TRUE(queue.Enqueue(element));
+    EXPECT_TRUE(queue.Dequeue(&value));
+    EXPECT_EQ(i, *value);
+    // the queue does not keep a reference to dequeued elements
+    value.reset();
+    EXPECT_EQ(1, element.use_count());
+  }
+  EXPECT_FALSE(queue.Dequeue(&value));
+}
+
+TEST(MPMCQueueTest, concurrency) {
+  MPMCQueue<int> queue;
+  EXPECT_TRUE(queue.Init(16));
+  const int kThreadNum = 8;
+  const int kElementNum = 20000;
+  std::atomic<int64_t> sum = {0};
+  std::atomic<int> dequeued = {0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 1; j <= kElementNum; ++j) {
+        while (!queue.Enqueue(j)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&]() {
+      int value = 0;
+      while (dequeued.load() < kThreadNum * kElementNum) {
+        if (queue.Dequeue(&value)) {
+          sum += value;
+          ++dequeued;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(int64_t(kThreadNum) * kElementNum * (kElementNum + 1) / 2,
+            sum.load());
+  EXPECT_TRUE(queue.Empty());
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "cyber/base/bounded_queue.h"
+#include "cyber/base/wait_strategy.h"
 
 namespace apollo {
 namespace cyber {
@@ -35,7 +36,10 @@ namespace base {
 
 class ThreadPool {
  public:
-  explicit ThreadPool(std::size_t thread_num, std::size_t max_task_num = 1000);
+  // takes ownership of |strategy|, workers block on a condition variable
+  // when it is null
+  explicit ThreadPool(std::size_t thread_num, std::size_t max_task_num = 1000,
+                      WaitStrategy* strategy = nullptr);
 
   template <typename F, typename... Args>
   auto Enqueue(F&& f, Args&&... args)
@@ -49,9 +53,13 @@ class ThreadPool {
   std::atomic_bool stop_;
 };
 
-inline ThreadPool::ThreadPool(std::size_t threads, std::size_t max_task_num)
+inline ThreadPool::ThreadPool(std::size_t threads, std::size_t max_task_num,
+                              WaitStrategy* strategy)
     : stop_(false) {
-  if (!task_queue_.Init(max_task_num, new BlockWaitStrategy())) {
+  if (strategy == nullptr) {
+    strategy = new BlockWaitStrategy();
+  }
+  if (!task_queue_.Init(max_task_num, strategy)) {
     throw std::runtime_error("Task queue init failed.");
   }
   for (size_t i = 0; i < threads; ++i) {
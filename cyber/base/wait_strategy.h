@@ -17,12 +17,21 @@
 #ifndef CYBER_BASE_WAIT_STRATEGY_H_
 #define CYBER_BASE_WAIT_STRATEGY_H_
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <climits>
 #include <condition_variable>
 #include <cstdlib>
 #include <mutex>
 #include <thread>
 
+#include "cyber/base/macros.h"
+
 namespace apollo {
 namespace cyber {
 namespace base {
@@ -115,6 +124,129 @@ class TimeoutBlockWaitStrategy : public WaitStrategy {
   std::chrono::milliseconds time_out_;
 };
 
+/**
+ * @brief Spins, then yields, then parks on a futex.
+ *
+ * The spin and yield budgets follow the average interval between recent
+ * notifications: a queue fed every few microseconds is waited on by spinning,
+ * one fed every few milliseconds parks almost at once. A waiter never misses
+ * a notification because it remembers the notification count seen before its
+ * last failed attempt and only parks while the count is unchanged.
+ */
+class AdaptiveWaitStrategy : public WaitStrategy {
+ public:
+  AdaptiveWaitStrategy() {}
+  AdaptiveWaitStrategy(uint64_t max_spin_ns, uint64_t max_yield_ns)
+      : max_spin_ns_(max_spin_ns), max_yield_ns_(max_yield_ns) {}
+
+  void NotifyOne() override {
+    UpdateInterval();
+    epoch_.fetch_add(1);
+    if (waiters_.load() > 0) {
+      Futex(FUTEX_WAKE_PRIVATE, 1);
+    }
+  }
+
+  void BreakAllWait() override {
+    epoch_.fetch_add(1);
+    Futex(FUTEX_WAKE_PRIVATE, INT_MAX);
+  }
+
+  bool EmptyWait() override {
+    auto& waiter = Waiter();
+    uint32_t epoch = epoch_.load(std::memory_order_acquire);
+    if (waiter.owner != this || waiter.epoch != epoch) {
+      // a new wait, or a notification arrived since the last attempt,
+      // let the caller try again before waiting on this count
+      waiter.owner = this;
+      waiter.epoch = epoch;
+      return true;
+    }
+    if (Spin(epoch)) {
+      return true;
+    }
+    waiters_.fetch_add(1);
+    Futex(FUTEX_WAIT_PRIVATE, epoch);
+    waiters_.fetch_sub(1);
+    return true;
+  }
+
+  // Spins and yields for the learned budget without parking, true once a
+  // notification arrives. For waiters that block some other way, such as a
+  // croutine hanging up.
+  bool Spin() { return Spin(epoch_.load(std::memory_order_acquire)); }
+
+  uint64_t average_interval_ns() const { return avg_interval_ns_.load(); }
+
+ private:
+  struct WaiterState {
+    const AdaptiveWaitStrategy* owner = nullptr;
+    uint32_t epoch = 0;
+  };
+
+  static WaiterState& Waiter() {
+    static thread_local WaiterState waiter;
+    return waiter;
+  }
+
+  static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void UpdateInterval() {
+    auto now = NowNs();
+    auto last = last_notify_ns_.exchange(now, std::memory_order_relaxed);
+    if (last == 0 || now <= last) {
+      return;
+    }
+    // an exponential moving average over roughly the last 8 notifications
+    auto interval = now - last;
+    auto avg = avg_interval_ns_.load(std::memory_order_relaxed);
+    avg_interval_ns_.store(avg == 0 ? interval : avg - avg / 8 + interval / 8,
+                           std::memory_order_relaxed);
+  }
+
+  bool Spin(uint32_t epoch) {
+    // wait about twice the expected interval, and not at all when
+    // notifications are too rare for spinning to pay off
+    auto interval = avg_interval_ns_.load(std::memory_order_relaxed);
+    if (interval == 0 || interval > max_yield_ns_) {
+      return epoch_.load(std::memory_order_acquire) != epoch;
+    }
+    auto budget = 2 * interval;
+    auto spin_ns = std::min(budget, max_spin_ns_);
+    auto yield_ns = std::min(budget, max_yield_ns_);
+    auto start = NowNs();
+    uint64_t elapsed = 0;
+    while (elapsed < yield_ns) {
+      if (epoch_.load(std::memory_order_acquire) != epoch) {
+        return true;
+      }
+      if (elapsed < spin_ns) {
+        cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+      elapsed = NowNs() - start;
+    }
+    return epoch_.load(std::memory_order_acquire) != epoch;
+  }
+
+  long Futex(int op, uint32_t val) {  // NOLINT
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), op, val,
+                   nullptr, nullptr, 0);
+  }
+
+  uint64_t max_spin_ns_ = 20 * 1000;
+  uint64_t max_yield_ns_ = 200 * 1000;
+  alignas(CACHELINE_SIZE) std::atomic<uint32_t> epoch_ = {0};
+  std::atomic<uint32_t> waiters_ = {0};
+  std::atomic<uint64_t> last_notify_ns_ = {0};
+  std::atomic<uint64_t> avg_interval_ns_ = {0};
+};
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
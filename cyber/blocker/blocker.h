@@ -18,14 +18,20 @@
 #define CYBER_BLOCKER_BLOCKER_H_
 
 #include <stddef.h>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/rw_lock_guard.h"
+
 namespace apollo {
 namespace cyber {
 namespace blocker {
@@ -60,6 +66,11 @@ struct BlockerAttr {
   std::string channel_name;
 };
 
+// Keeps the last capacity messages published on a channel, and the ones
+// taken by the last Observe(). Publishing neither allocates nor serializes
+// publishers: each claims a slot of a ring with an atomic counter and only
+// spins on that slot to swap the pointer in, and the callbacks are run under
+// a shared lock, which Subscribe and Unsubscribe take exclusively.
 template <typename T>
 class Blocker : public BlockerBase {
   friend class BlockerManager;
@@ -100,27 +111,57 @@ class Blocker : public BlockerBase {
   const std::string& channel_name() const override;
 
  private:
+  struct Slot {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    // 1 + the publish index of msg, 0 when empty
+    uint64_t seq = 0;
+    MessagePtr msg;
+  };
+
   void Reset() override;
   void Enqueue(const MessagePtr& msg);
   void Notify(const MessagePtr& msg);
 
+  // Visits the published messages from the latest, until visitor returns
+  // false.
+  template <typename Visitor>
+  void ForEachPublished(Visitor visitor) const;
+
+  static void LockSlot(Slot* slot) {
+    while (slot->lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  static void UnlockSlot(Slot* slot) {
+    slot->lock.clear(std::memory_order_release);
+  }
+
   BlockerAttr attr_;
   MessageQueue observed_msg_queue_;
-  MessageQueue published_msg_queue_;
-  mutable std::mutex msg_mutex_;
+  mutable std::mutex observed_mutex_;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t num_slots_ = 0;
+  std::atomic<uint64_t> publish_count_ = {0};
+  // taken exclusively only to resize or clear the slots
+  mutable base::AtomicRWLock slots_lock_;
 
   CallbackMap published_callbacks_;
-  mutable std::mutex cb_mutex_;
+  // readers first, so that a callback may publish on the channel again
+  mutable base::AtomicRWLock cb_lock_{false};
 
   MessageType dummy_msg_;
 };
 
 template <typename T>
-Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {}
+Blocker<T>::Blocker(const BlockerAttr& attr) : attr_(attr), dummy_msg_() {
+  if (attr_.capacity > 0) {
+    slots_.reset(new Slot[attr_.capacity]);
+    num_slots_ = attr_.capacity;
+  }
+}
 
 template <typename T>
 Blocker<T>::~Blocker() {
-  published_msg_queue_.clear();
   observed_msg_queue_.clear();
   published_callbacks_.clear();
 }
@@ -138,51 +179,53 @@ void Blocker<T>::Publish(const MessagePtr& msg) {
 
 template <typename T>
 void Blocker<T>::Reset() {
-  {
-    std::lock_guard<std::mutex> lock(msg_mutex_);
-    observed_msg_queue_.clear();
-    published_msg_queue_.clear();
-  }
-  {
-    std::lock_guard<std::mutex> lock(cb_mutex_);
-    published_callbacks_.clear();
-  }
+  ClearObserved();
+  ClearPublished();
+  base::WriteLockGuard<base::AtomicRWLock> lock(cb_lock_);
+  published_callbacks_.clear();
 }
 
 template <typename T>
 void Blocker<T>::ClearObserved() {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  std::lock_guard<std::mutex> lock(observed_mutex_);
   observed_msg_queue_.clear();
 }
 
 template <typename T>
 void Blocker<T>::ClearPublished() {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.clear();
+  base::WriteLockGuard<base::AtomicRWLock> lock(slots_lock_);
+  for (size_t i = 0; i < num_slots_; ++i) {
+    slots_[i].seq = 0;
+    slots_[i].msg.reset();
+  }
 }
 
 template <typename T>
 void Blocker<T>::Observe() {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  observed_msg_queue_ = published_msg_queue_;
+  MessageQueue observed;
+  ForEachPublished([&observed](const MessagePtr& msg) {
+    observed.push_back(msg);
+    return true;
+  });
+  std::lock_guard<std::mutex> lock(observed_mutex_);
+  observed_msg_queue_.swap(observed);
 }
 
 template <typename T>
 bool Blocker<T>::IsObservedEmpty() const {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  std::lock_guard<std::mutex> lock(observed_mutex_);
   return observed_msg_queue_.empty();
 }
 
 template <typename T>
 bool Blocker<T>::IsPublishedEmpty() const {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  return published_msg_queue_.empty();
+  return GetLatestPublishedPtr() == nullptr;
 }
 
 template <typename T>
 bool Blocker<T>::Subscribe(const std::string& callback_id,
                            const Callback& callback) {
-  std::lock_guard<std::mutex> lock(cb_mutex_);
+  base::WriteLockGuard<base::AtomicRWLock> lock(cb_lock_);
   if (published_callbacks_.find(callback_id) != published_callbacks_.end()) {
     return false;
   }
@@ -192,13 +235,13 @@ bool Blocker<T>::Subscribe(const std::string& callback_id,
 
 template <typename T>
 bool Blocker<T>::Unsubscribe(const std::string& callback_id) {
-  std::lock_guard<std::mutex> lock(cb_mutex_);
+  base::WriteLockGuard<base::AtomicRWLock> lock(cb_lock_);
   return published_callbacks_.erase(callback_id) != 0;
 }
 
 template <typename T>
 auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  std::lock_guard<std::mutex> lock(observed_mutex_);
   if (observed_msg_queue_.empty()) {
     return dummy_msg_;
   }
@@ -207,7 +250,7 @@ auto Blocker<T>::GetLatestObserved() const -> const MessageType& {
 
 template <typename T>
 auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  std::lock_guard<std::mutex> lock(observed_mutex_);
   if (observed_msg_queue_.empty()) {
     return nullptr;
   }
@@ -216,7 +259,7 @@ auto Blocker<T>::GetLatestObservedPtr() const -> const MessagePtr {
 
 template <typename T>
 auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  std::lock_guard<std::mutex> lock(observed_mutex_);
   if (observed_msg_queue_.empty()) {
     return nullptr;
   }
@@ -225,11 +268,12 @@ auto Blocker<T>::GetOldestObservedPtr() const -> const MessagePtr {
 
 template <typename T>
 auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  if (published_msg_queue_.empty()) {
-    return nullptr;
-  }
-  return published_msg_queue_.front();
+  MessagePtr latest = nullptr;
+  ForEachPublished([&latest](const MessagePtr& msg) {
+    latest = msg;
+    return false;
+  });
+  return latest;
 }
 
 template <typename T>
@@ -249,11 +293,28 @@ size_t Blocker<T>::capacity() const {
 
 template <typename T>
 void Blocker<T>::set_capacity(size_t capacity) {
-  std::lock_guard<std::mutex> lock(msg_mutex_);
+  base::WriteLockGuard<base::AtomicRWLock> lock(slots_lock_);
+  // the latest messages which still fit, moved to a ring of the new size
+  std::vector<MessagePtr> kept;
+  uint64_t end = publish_count_.load();
+  uint64_t begin = end > num_slots_ ? end - num_slots_ : 0;
+  for (uint64_t index = end; index > begin && kept.size() < capacity;
+       --index) {
+    Slot& slot = slots_[(index - 1) % num_slots_];
+    if (slot.seq == index) {
+      kept.push_back(std::move(slot.msg));
+    }
+  }
+
+  slots_.reset(capacity > 0 ? new Slot[capacity] : nullptr);
+  num_slots_ = capacity;
   attr_.capacity = capacity;
-  while (published_msg_queue_.size() > capacity) {
-    published_msg_queue_.pop_back();
+  for (size_t i = 0; i < kept.size(); ++i) {
+    uint64_t index = kept.size() - 1 - i;
+    slots_[index % capacity].seq = index + 1;
+    slots_[index % capacity].msg = std::move(kept[i]);
   }
+  publish_count_.store(kept.size());
 }
 
 template <typename T>
@@ -263,24 +324,56 @@ const std::string& Blocker<T>::channel_name() const {
 
 template <typename T>
 void Blocker<T>::Enqueue(const MessagePtr& msg) {
-  if (attr_.capacity == 0) {
+  // released after the lock, the last reference may be a big message
+  MessagePtr dropped = nullptr;
+  base::ReadLockGuard<base::AtomicRWLock> lock(slots_lock_);
+  if (num_slots_ == 0) {
     return;
   }
-  std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.push_front(msg);
-  while (published_msg_queue_.size() > attr_.capacity) {
-    published_msg_queue_.pop_back();
+  uint64_t index = publish_count_.fetch_add(1, std::memory_order_relaxed);
+  Slot* slot = &slots_[index % num_slots_];
+  LockSlot(slot);
+  // unless a publisher a lap ahead got there first
+  if (slot->seq <= index) {
+    dropped.swap(slot->msg);
+    slot->msg = msg;
+    slot->seq = index + 1;
   }
+  UnlockSlot(slot);
 }
 
 template <typename T>
 void Blocker<T>::Notify(const MessagePtr& msg) {
-  std::lock_guard<std::mutex> lock(cb_mutex_);
+  base::ReadLockGuard<base::AtomicRWLock> lock(cb_lock_);
   for (const auto& item : published_callbacks_) {
     item.second(msg);
   }
 }
 
+template <typename T>
+template <typename Visitor>
+void Blocker<T>::ForEachPublished(Visitor visitor) const {
+  base::ReadLockGuard<base::AtomicRWLock> lock(slots_lock_);
+  if (num_slots_ == 0) {
+    return;
+  }
+  uint64_t end = publish_count_.load(std::memory_order_acquire);
+  uint64_t begin = end > num_slots_ ? end - num_slots_ : 0;
+  for (uint64_t index = end; index > begin; --index) {
+    Slot* slot = &slots_[(index - 1) % num_slots_];
+    MessagePtr msg = nullptr;
+    LockSlot(slot);
+    // skips slots still being filled, or already refilled
+    if (slot->seq == index) {
+      msg = slot->msg;
+    }
+    UnlockSlot(slot);
+    if (msg != nullptr && !visitor(msg)) {
+      return;
+    }
+  }
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
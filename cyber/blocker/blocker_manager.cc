@@ -25,18 +25,17 @@ BlockerManager::BlockerManager() {}
 BlockerManager::~BlockerManager() { blockers_.clear(); }
 
 void BlockerManager::Observe() {
-  std::lock_guard<std::mutex> lock(blocker_mutex_);
+  base::ReadLockGuard<base::AtomicRWLock> lock(blockers_lock_);
   for (auto& item : blockers_) {
     item.second->Observe();
   }
 }
 
 void BlockerManager::Reset() {
-  std::lock_guard<std::mutex> lock(blocker_mutex_);
+  base::ReadLockGuard<base::AtomicRWLock> lock(blockers_lock_);
   for (auto& item : blockers_) {
     item.second->Reset();
   }
-  blockers_.clear();
 }
 
 }  // namespace blocker
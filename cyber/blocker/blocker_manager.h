@@ -18,10 +18,11 @@
 #define CYBER_BLOCKER_BLOCKER_MANAGER_H_
 
 #include <memory>
-#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/rw_lock_guard.h"
 #include "cyber/blocker/blocker.h"
 
 namespace apollo {
@@ -65,6 +66,8 @@ class BlockerManager {
   std::shared_ptr<Blocker<T>> GetOrCreateBlocker(const BlockerAttr& attr);
 
   void Observe();
+  // Empties the blockers and drops their callbacks, but keeps them, so the
+  // handles IntraWriter and IntraReader hold stay attached to the channels.
   void Reset();
 
  private:
@@ -73,7 +76,8 @@ class BlockerManager {
   BlockerManager& operator=(const BlockerManager&) = delete;
 
   BlockerMap blockers_;
-  std::mutex blocker_mutex_;
+  // exclusive only to add a blocker
+  base::AtomicRWLock blockers_lock_;
 };
 
 template <typename T>
@@ -124,7 +128,7 @@ std::shared_ptr<Blocker<T>> BlockerManager::GetBlocker(
     const std::string& channel_name) {
   std::shared_ptr<Blocker<T>> blocker = nullptr;
   {
-    std::lock_guard<std::mutex> lock(blocker_mutex_);
+    base::ReadLockGuard<base::AtomicRWLock> lock(blockers_lock_);
     auto search = blockers_.find(channel_name);
     if (search != blockers_.end()) {
       blocker = std::dynamic_pointer_cast<Blocker<T>>(search->second);
@@ -138,7 +142,14 @@ std::shared_ptr<Blocker<T>> BlockerManager::GetOrCreateBlocker(
     const BlockerAttr& attr) {
   std::shared_ptr<Blocker<T>> blocker = nullptr;
   {
-    std::lock_guard<std::mutex> lock(blocker_mutex_);
+    base::ReadLockGuard<base::AtomicRWLock> lock(blockers_lock_);
+    auto search = blockers_.find(attr.channel_name);
+    if (search != blockers_.end()) {
+      return std::dynamic_pointer_cast<Blocker<T>>(search->second);
+    }
+  }
+  {
+    base::WriteLockGuard<base::AtomicRWLock> lock(blockers_lock_);
     auto search = blockers_.find(attr.channel_name);
     if (search != blockers_.end()) {
       blocker = std::dynamic_pointer_cast<Blocker<T>>(search->second);
@@ -17,7 +17,11 @@
 #include "cyber/blocker/blocker.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "cyber/proto/unit_test.pb.h"
 
@@ -105,6 +109,76 @@ TEST(BlockerTest, subscribe) {
   EXPECT_FALSE(res);
 }
 
+TEST(BlockerTest, capacity) {
+  BlockerAttr attr(3, "channel");
+  Blocker<UnitTest> blocker(attr);
+
+  for (int i = 0; i < 5; ++i) {
+    UnitTest msg;
+    msg.set_case_name(std::to_string(i));
+    blocker.Publish(msg);
+  }
+  blocker.Observe();
+  std::vector<std::string> observed;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed.push_back((*it)->case_name());
+  }
+  EXPECT_EQ(observed, std::vector<std::string>({"4", "3", "2"}));
+
+  // the latest ones stay
+  blocker.set_capacity(2);
+  EXPECT_EQ(blocker.capacity(), 2);
+  blocker.Observe();
+  EXPECT_EQ(blocker.GetLatestObserved().case_name(), "4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "3");
+
+  blocker.set_capacity(4);
+  UnitTest msg;
+  msg.set_case_name("5");
+  blocker.Publish(msg);
+  blocker.Observe();
+  EXPECT_EQ(blocker.GetLatestObserved().case_name(), "5");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "3");
+
+  blocker.set_capacity(0);
+  blocker.Publish(msg);
+  EXPECT_TRUE(blocker.IsPublishedEmpty());
+}
+
+TEST(BlockerTest, concurrent_publish) {
+  BlockerAttr attr(16, "channel");
+  Blocker<UnitTest> blocker(attr);
+
+  std::atomic<int> received = {0};
+  blocker.Subscribe("BlockerTest",
+                    [&received](const std::shared_ptr<UnitTest>&) {
+                      received.fetch_add(1);
+                    });
+
+  const int kThreads = 4;
+  const int kMessages = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&blocker] {
+      for (int j = 0; j < kMessages; ++j) {
+        blocker.Publish(std::make_shared<UnitTest>());
+        blocker.GetLatestPublishedPtr();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(received.load(), kThreads * kMessages);
+  blocker.Observe();
+  size_t observed = 0;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    ++observed;
+  }
+  EXPECT_EQ(observed, 16);
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
@@ -34,6 +34,7 @@ template <typename MessageT>
 class IntraReader : public apollo::cyber::Reader<MessageT> {
  public:
   using MessagePtr = std::shared_ptr<MessageT>;
+  using BlockerPtr = std::shared_ptr<Blocker<MessageT>>;
   using Callback = std::function<void(const std::shared_ptr<MessageT>&)>;
   using Iterator =
       typename std::list<std::shared_ptr<MessageT>>::const_iterator;
@@ -59,8 +60,11 @@ class IntraReader : public apollo::cyber::Reader<MessageT> {
 
  private:
   void OnMessage(const MessagePtr& msg_ptr);
+  BlockerPtr GetBlocker() const;
 
   Callback msg_callback_;
+  // taken by Init, so that the calls after need no lookup by channel name
+  BlockerPtr blocker_;
 };
 
 template <typename MessageT>
@@ -78,10 +82,15 @@ bool IntraReader<MessageT>::Init() {
   if (this->init_.exchange(true)) {
     return true;
   }
-  return BlockerManager::Instance()->Subscribe<MessageT>(
-      this->role_attr_.channel_name(), this->role_attr_.qos_profile().depth(),
-      this->role_attr_.node_name(), std::bind(&IntraReader<MessageT>::OnMessage,
-                                              this, std::placeholders::_1));
+  blocker_ = BlockerManager::Instance()->GetOrCreateBlocker<MessageT>(
+      BlockerAttr(this->role_attr_.qos_profile().depth(),
+                  this->role_attr_.channel_name()));
+  if (blocker_ == nullptr) {
+    return false;
+  }
+  return blocker_->Subscribe(this->role_attr_.node_name(),
+                             std::bind(&IntraReader<MessageT>::OnMessage, this,
+                                       std::placeholders::_1));
 }
 
 template <typename MessageT>
@@ -89,14 +98,12 @@ void IntraReader<MessageT>::Shutdown() {
   if (!this->init_.exchange(false)) {
     return;
   }
-  BlockerManager::Instance()->Unsubscribe<MessageT>(
-      this->role_attr_.channel_name(), this->role_attr_.node_name());
+  blocker_->Unsubscribe(this->role_attr_.node_name());
 }
 
 template <typename MessageT>
 void IntraReader<MessageT>::ClearData() {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     blocker->ClearObserved();
     blocker->ClearPublished();
@@ -105,8 +112,7 @@ void IntraReader<MessageT>::ClearData() {
 
 template <typename MessageT>
 void IntraReader<MessageT>::Observe() {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     blocker->Observe();
   }
@@ -114,8 +120,7 @@ void IntraReader<MessageT>::Observe() {
 
 template <typename MessageT>
 bool IntraReader<MessageT>::Empty() const {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     return blocker->IsObservedEmpty();
   }
@@ -124,8 +129,7 @@ bool IntraReader<MessageT>::Empty() const {
 
 template <typename MessageT>
 bool IntraReader<MessageT>::HasReceived() const {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     return !blocker->IsPublishedEmpty();
   }
@@ -134,14 +138,18 @@ bool IntraReader<MessageT>::HasReceived() const {
 
 template <typename MessageT>
 void IntraReader<MessageT>::Enqueue(const std::shared_ptr<MessageT>& msg) {
-  BlockerManager::Instance()->Publish<MessageT>(this->role_attr_.channel_name(),
-                                                msg);
+  auto blocker = GetBlocker();
+  if (blocker != nullptr) {
+    blocker->Publish(msg);
+  } else {
+    BlockerManager::Instance()->Publish<MessageT>(
+        this->role_attr_.channel_name(), msg);
+  }
 }
 
 template <typename MessageT>
 void IntraReader<MessageT>::SetHistoryDepth(const uint32_t& depth) {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     blocker->set_capacity(depth);
   }
@@ -149,8 +157,7 @@ void IntraReader<MessageT>::SetHistoryDepth(const uint32_t& depth) {
 
 template <typename MessageT>
 uint32_t IntraReader<MessageT>::GetHistoryDepth() const {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     return static_cast<uint32_t>(blocker->capacity());
   }
@@ -159,8 +166,7 @@ uint32_t IntraReader<MessageT>::GetHistoryDepth() const {
 
 template <typename MessageT>
 std::shared_ptr<MessageT> IntraReader<MessageT>::GetLatestObserved() const {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     return blocker->GetLatestObservedPtr();
   }
@@ -169,8 +175,7 @@ std::shared_ptr<MessageT> IntraReader<MessageT>::GetLatestObserved() const {
 
 template <typename MessageT>
 std::shared_ptr<MessageT> IntraReader<MessageT>::GetOldestObserved() const {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   if (blocker != nullptr) {
     return blocker->GetOldestObservedPtr();
   }
@@ -179,18 +184,16 @@ std::shared_ptr<MessageT> IntraReader<MessageT>::GetOldestObserved() const {
 
 template <typename MessageT>
 auto IntraReader<MessageT>::Begin() const -> Iterator {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   ACHECK(blocker != nullptr);
   return blocker->ObservedBegin();
 }
 
 template <typename MessageT>
 auto IntraReader<MessageT>::End() const -> Iterator {
-  auto blocker = BlockerManager::Instance()->GetBlocker<MessageT>(
-      this->role_attr_.channel_name());
+  auto blocker = GetBlocker();
   ACHECK(blocker != nullptr);
-  return blocker->ObservedBegin();
+  return blocker->ObservedEnd();
 }
 
 template <typename MessageT>
@@ -202,6 +205,15 @@ void IntraReader<MessageT>::OnMessage(const MessagePtr& msg_ptr) {
   }
 }
 
+template <typename MessageT>
+auto IntraReader<MessageT>::GetBlocker() const -> BlockerPtr {
+  if (blocker_ != nullptr) {
+    return blocker_;
+  }
+  return BlockerManager::Instance()->GetBlocker<MessageT>(
+      this->role_attr_.channel_name());
+}
+
 }  // namespace blocker
 }  // namespace cyber
 }  // namespace apollo
@@ -30,7 +30,7 @@ template <typename MessageT>
 class IntraWriter : public apollo::cyber::Writer<MessageT> {
  public:
   using MessagePtr = std::shared_ptr<MessageT>;
-  using BlockerManagerPtr = std::shared_ptr<BlockerManager>;
+  using BlockerPtr = std::shared_ptr<Blocker<MessageT>>;
 
   explicit IntraWriter(const proto::RoleAttributes& attr);
   virtual ~IntraWriter();
@@ -42,7 +42,8 @@ class IntraWriter : public apollo::cyber::Writer<MessageT> {
   bool Write(const MessagePtr& msg_ptr) override;
 
  private:
-  BlockerManagerPtr blocker_manager_;
+  // taken once, so writing needs no lookup by channel name
+  BlockerPtr blocker_;
 };
 
 template <typename MessageT>
@@ -59,9 +60,11 @@ bool IntraWriter<MessageT>::Init() {
   {
     std::lock_guard<std::mutex> g(this->lock_);
     if (this->init_) { return true; }
-    blocker_manager_ = BlockerManager::Instance();
-    blocker_manager_->GetOrCreateBlocker<MessageT>(
+    blocker_ = BlockerManager::Instance()->GetOrCreateBlocker<MessageT>(
         BlockerAttr(this->role_attr_.channel_name()));
+    if (blocker_ == nullptr) {
+      return false;
+    }
     this->init_ = true;
   }
   return true;
@@ -74,7 +77,7 @@ void IntraWriter<MessageT>::Shutdown() {
     if (!this->init_) { return; }
     this->init_ = false;
   }
-  blocker_manager_ = nullptr;
+  blocker_ = nullptr;
 }
 
 template <typename MessageT>
@@ -82,8 +85,8 @@ bool IntraWriter<MessageT>::Write(const MessageT& msg) {
   if (!WriterBase::IsInit()) {
     return false;
   }
-  return blocker_manager_->Publish<MessageT>(this->role_attr_.channel_name(),
-                                             msg);
+  blocker_->Publish(msg);
+  return true;
 }
 
 template <typename MessageT>
@@ -91,8 +94,8 @@ bool IntraWriter<MessageT>::Write(const MessagePtr& msg_ptr) {
   if (!WriterBase::IsInit()) {
     return false;
   }
-  return blocker_manager_->Publish<MessageT>(this->role_attr_.channel_name(),
-                                             msg_ptr);
+  blocker_->Publish(msg_ptr);
+  return true;
 }
 
 }  // namespace blocker
@@ -17,6 +17,7 @@
 #define CYBER_CLASS_LOADER_CLASS_LOADER_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -66,9 +67,7 @@ std::vector<std::string> ClassLoader::GetValidClassNames() {
 
 template <typename Base>
 bool ClassLoader::IsClassValid(const std::string& class_name) {
-  std::vector<std::string> valid_classes = GetValidClassNames<Base>();
-  return (std::find(valid_classes.begin(), valid_classes.end(), class_name) !=
-          valid_classes.end());
+  return utility::IsClassValid<Base>(class_name, this);
 }
 
 template <typename Base>
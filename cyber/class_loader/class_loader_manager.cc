@@ -47,10 +47,8 @@ std::vector<std::string> ClassLoaderManager::GetAllValidLibPath() {
 }
 
 bool ClassLoaderManager::IsLibraryValid(const std::string& library_name) {
-  std::vector<std::string> valid_libraries = GetAllValidLibPath();
-  return (valid_libraries.end() != std::find(valid_libraries.begin(),
-                                             valid_libraries.end(),
-                                             library_name));
+  auto search = libpath_loader_map_.find(library_name);
+  return search != libpath_loader_map_.end() && search->second != nullptr;
 }
 
 bool ClassLoaderManager::LoadLibrary(const std::string& library_path) {
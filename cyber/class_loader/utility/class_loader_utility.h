@@ -71,6 +71,8 @@ template <typename Base>
 Base* CreateClassObj(const std::string& class_name, ClassLoader* loader);
 template <typename Base>
 std::vector<std::string> GetValidClassNames(ClassLoader* loader);
+template <typename Base>
+bool IsClassValid(const std::string& class_name, ClassLoader* loader);
 
 template <typename Derived, typename Base>
 void RegisterClass(const std::string& class_name,
@@ -127,6 +129,17 @@ std::vector<std::string> GetValidClassNames(ClassLoader* loader) {
   return classes;
 }
 
+template <typename Base>
+bool IsClassValid(const std::string& class_name, ClassLoader* loader) {
+  std::lock_guard<std::recursive_mutex> lck(GetClassFactoryMapMapMutex());
+
+  ClassClassFactoryMap& factoryMap =
+      GetClassFactoryMapByBaseClass(typeid(Base).name());
+  auto search = factoryMap.find(class_name);
+  return search != factoryMap.end() && search->second != nullptr &&
+         search->second->IsOwnedBy(loader);
+}
+
 }  // End namespace utility
 }  // End namespace class_loader
 }  // namespace cyber
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/common/numa.h"
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+namespace {
+
+const char* const kNodePath = "/sys/devices/system/node/";
+
+// parses the kernel list format, e.g. "0-3,8-11"
+bool ParseList(const std::string& str, std::vector<int>* list) {
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.empty() || item == "\n") {
+      continue;
+    }
+    auto pos = item.find('-');
+    try {
+      if (pos == std::string::npos) {
+        list->push_back(std::stoi(item));
+      } else {
+        auto first = std::stoi(item.substr(0, pos));
+        auto last = std::stoi(item.substr(pos + 1));
+        for (int i = first; i <= last; ++i) {
+          list->push_back(i);
+        }
+      }
+    } catch (...) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReadList(const std::string& path, std::vector<int>* list) {
+  std::ifstream fin(path);
+  std::string content;
+  if (!fin || !std::getline(fin, content)) {
+    return false;
+  }
+  return ParseList(content, list);
+}
+
+size_t PageSize() {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+}  // namespace
+
+int NumaNodeNum() {
+  static const int node_num = []() {
+    std::vector<int> nodes;
+    if (!ReadList(std::string(kNodePath) + "possible", &nodes) ||
+        nodes.empty()) {
+      return 1;
+    }
+    return nodes.back() + 1;
+  }();
+  return node_num;
+}
+
+bool GetNumaNodeCpus(int node, std::vector<int>* cpus) {
+  if (node < 0 || node >= NumaNodeNum()) {
+    return false;
+  }
+  return ReadList(kNodePath + std::string("node") + std::to_string(node) +
+                      "/cpulist",
+                  cpus);
+}
+
+int GetCurrentNumaNode() {
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return -1;
+  }
+  return static_cast<int>(node);
+}
+
+bool BindMemoryToNumaNode(void* addr, size_t size, int node) {
+  if (addr == nullptr || node < 0 || NumaNodeNum() <= 1) {
+    return false;
+  }
+  if (node >= NumaNodeNum() || node >= 64) {
+    AWARN << "invalid numa node " << node;
+    return false;
+  }
+  auto page_size = PageSize();
+  auto begin = reinterpret_cast<uintptr_t>(addr) & ~(page_size - 1);
+  auto end = reinterpret_cast<uintptr_t>(addr) + size;
+  uint64_t mask = 1UL << node;
+  if (syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, &mask,
+              sizeof(mask) * 8, 0) != 0) {
+    AWARN << "bind memory to numa node " << node << " failed, errno: "
+          << errno;
+    return false;
+  }
+  return true;
+}
+
+bool SetThreadNumaNode(int node) {
+  if (NumaNodeNum() <= 1) {
+    return false;
+  }
+  long ret = 0;  // NOLINT
+  if (node < 0) {
+    ret = syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+  } else if (node < NumaNodeNum() && node < 64) {
+    uint64_t mask = 1UL << node;
+    ret = syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, sizeof(mask) * 8);
+  } else {
+    AWARN << "invalid numa node " << node;
+    return false;
+  }
+  if (ret != 0) {
+    AWARN << "set numa node " << node << " failed, errno: " << errno;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
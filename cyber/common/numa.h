@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_COMMON_NUMA_H_
+#define CYBER_COMMON_NUMA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+// Thin wrappers over the kernel NUMA interfaces, so no libnuma is needed.
+// Every call degrades to a no-op on hosts without NUMA support.
+
+// number of configured nodes, 1 on a UMA host
+int NumaNodeNum();
+
+bool GetNumaNodeCpus(int node, std::vector<int>* cpus);
+
+// node of the CPU the calling thread runs on, -1 if unknown
+int GetCurrentNumaNode();
+
+// Prefers |node| for pages of [addr, addr + size) faulted from now on. On
+// shared memory the policy belongs to the segment, so it also applies to
+// pages first touched by other processes.
+bool BindMemoryToNumaNode(void* addr, size_t size, int node);
+
+// Prefers |node| for memory the calling thread touches first, a negative
+// node restores the default local policy.
+bool SetThreadNumaNode(int node);
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_COMMON_NUMA_H_
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/common/numa.h"
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+TEST(NumaTest, node_cpus) {
+  EXPECT_GE(NumaNodeNum(), 1);
+  std::vector<int> cpus;
+  EXPECT_FALSE(GetNumaNodeCpus(-1, &cpus));
+  EXPECT_FALSE(GetNumaNodeCpus(NumaNodeNum(), &cpus));
+
+  int node = GetCurrentNumaNode();
+  if (node < 0 || !GetNumaNodeCpus(node, &cpus)) {
+    return;
+  }
+  EXPECT_FALSE(cpus.empty());
+  int cpu = sched_getcpu();
+  EXPECT_NE(std::find(cpus.begin(), cpus.end(), cpu), cpus.end());
+}
+
+TEST(NumaTest, bind_memory) {
+  const size_t size = 1 << 20;
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(addr, MAP_FAILED);
+  EXPECT_FALSE(BindMemoryToNumaNode(nullptr, size, 0));
+  EXPECT_FALSE(BindMemoryToNumaNode(addr, size, -1));
+  if (NumaNodeNum() > 1) {
+    EXPECT_TRUE(BindMemoryToNumaNode(addr, size, 0));
+    EXPECT_TRUE(SetThreadNumaNode(0));
+    EXPECT_TRUE(SetThreadNumaNode(-1));
+  } else {
+    // no-ops on a UMA host
+    EXPECT_FALSE(BindMemoryToNumaNode(addr, size, 0));
+    EXPECT_FALSE(SetThreadNumaNode(0));
+  }
+  munmap(addr, size);
+}
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
@@ -115,7 +115,7 @@ bool Component<M0, NullType, NullType, NullType>::Process(
 
 inline bool Component<NullType, NullType, NullType>::Initialize(
     const ComponentConfig& config) {
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
   if (!Init()) {
     AERROR << "Component Init() failed." << std::endl;
@@ -127,7 +127,7 @@ inline bool Component<NullType, NullType, NullType>::Initialize(
 template <typename M0>
 bool Component<M0, NullType, NullType, NullType>::Initialize(
     const ComponentConfig& config) {
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
 
   if (config.readers_size() < 1) {
@@ -149,10 +149,14 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
 
   std::weak_ptr<Component<M0>> self =
       std::dynamic_pointer_cast<Component<M0>>(shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg) {
+  auto pipeline = HeadOfPipeline();
+  auto func = [self, pipeline](const std::shared_ptr<M0>& msg) {
     auto ptr = self.lock();
     if (ptr) {
       ptr->Process(msg);
+      if (pipeline != nullptr) {
+        pipeline->RunStages();
+      }
     } else {
       AERROR << "Component object has been destroyed.";
     }
@@ -179,6 +183,17 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
   data::VisitorConfig conf = {readers_[0]->ChannelId(),
                               readers_[0]->PendingQueueSize()};
   auto dv = std::make_shared<data::DataVisitor<M0>>(conf);
+  if (RunInPipeline([func, dv]() {
+        bool processed = false;
+        std::shared_ptr<M0> msg;
+        while (dv->TryFetch(msg)) {
+          func(msg);
+          processed = true;
+        }
+        return processed;
+      })) {
+    return true;
+  }
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0>(func, dv);
   auto sched = scheduler::Instance();
@@ -197,7 +212,7 @@ bool Component<M0, M1, NullType, NullType>::Process(
 template <typename M0, typename M1>
 bool Component<M0, M1, NullType, NullType>::Initialize(
     const ComponentConfig& config) {
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
 
   if (config.readers_size() < 2) {
@@ -261,11 +276,15 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   auto sched = scheduler::Instance();
   std::weak_ptr<Component<M0, M1>> self =
       std::dynamic_pointer_cast<Component<M0, M1>>(shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg0,
-                     const std::shared_ptr<M1>& msg1) {
+  auto pipeline = HeadOfPipeline();
+  auto func = [self, pipeline](const std::shared_ptr<M0>& msg0,
+                               const std::shared_ptr<M1>& msg1) {
     auto ptr = self.lock();
     if (ptr) {
       ptr->Process(msg0, msg1);
+      if (pipeline != nullptr) {
+        pipeline->RunStages();
+      }
     } else {
       AERROR << "Component object has been destroyed.";
     }
@@ -275,7 +294,20 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list,
+                                                        config.fusion());
+  if (RunInPipeline([func, dv]() {
+        bool processed = false;
+        std::shared_ptr<M0> msg0;
+        std::shared_ptr<M1> msg1;
+        while (dv->TryFetch(msg0, msg1)) {
+          func(msg0, msg1);
+          processed = true;
+        }
+        return processed;
+      })) {
+    return true;
+  }
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -294,7 +326,7 @@ bool Component<M0, M1, M2, NullType>::Process(const std::shared_ptr<M0>& msg0,
 template <typename M0, typename M1, typename M2>
 bool Component<M0, M1, M2, NullType>::Initialize(
     const ComponentConfig& config) {
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
 
   if (config.readers_size() < 3) {
@@ -370,12 +402,16 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   std::weak_ptr<Component<M0, M1, M2, NullType>> self =
       std::dynamic_pointer_cast<Component<M0, M1, M2, NullType>>(
           shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg0,
-                     const std::shared_ptr<M1>& msg1,
-                     const std::shared_ptr<M2>& msg2) {
+  auto pipeline = HeadOfPipeline();
+  auto func = [self, pipeline](const std::shared_ptr<M0>& msg0,
+                               const std::shared_ptr<M1>& msg1,
+                               const std::shared_ptr<M2>& msg2) {
     auto ptr = self.lock();
     if (ptr) {
       ptr->Process(msg0, msg1, msg2);
+      if (pipeline != nullptr) {
+        pipeline->RunStages();
+      }
     } else {
       AERROR << "Component object has been destroyed.";
     }
@@ -385,7 +421,21 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list,
+                                                            config.fusion());
+  if (RunInPipeline([func, dv]() {
+        bool processed = false;
+        std::shared_ptr<M0> msg0;
+        std::shared_ptr<M1> msg1;
+        std::shared_ptr<M2> msg2;
+        while (dv->TryFetch(msg0, msg1, msg2)) {
+          func(msg0, msg1, msg2);
+          processed = true;
+        }
+        return processed;
+      })) {
+    return true;
+  }
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -404,7 +454,7 @@ bool Component<M0, M1, M2, M3>::Process(const std::shared_ptr<M0>& msg0,
 
 template <typename M0, typename M1, typename M2, typename M3>
 bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
 
   if (config.readers_size() < 4) {
@@ -493,12 +543,16 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   auto sched = scheduler::Instance();
   std::weak_ptr<Component<M0, M1, M2, M3>> self =
       std::dynamic_pointer_cast<Component<M0, M1, M2, M3>>(shared_from_this());
-  auto func = [self](
+  auto pipeline = HeadOfPipeline();
+  auto func = [self, pipeline](
       const std::shared_ptr<M0>& msg0, const std::shared_ptr<M1>& msg1,
       const std::shared_ptr<M2>& msg2, const std::shared_ptr<M3>& msg3) {
     auto ptr = self.lock();
     if (ptr) {
       ptr->Process(msg0, msg1, msg2, msg3);
+      if (pipeline != nullptr) {
+        pipeline->RunStages();
+      }
     } else {
       AERROR << "Component object has been destroyed." << std::endl;
     }
@@ -508,7 +562,22 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(
+      config_list, config.fusion());
+  if (RunInPipeline([func, dv]() {
+        bool processed = false;
+        std::shared_ptr<M0> msg0;
+        std::shared_ptr<M1> msg1;
+        std::shared_ptr<M2> msg2;
+        std::shared_ptr<M3> msg3;
+        while (dv->TryFetch(msg0, msg1, msg2, msg3)) {
+          func(msg0, msg1, msg2, msg3);
+          processed = true;
+        }
+        return processed;
+      })) {
+    return true;
+  }
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2, M3>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -20,11 +20,13 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/class_loader/class_loader.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
+#include "cyber/component/pipeline.h"
 #include "cyber/node/node.h"
 #include "cyber/proto/component_conf.pb.h"
 #include "cyber/scheduler/scheduler.h"
@@ -57,6 +59,12 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     scheduler::Instance()->RemoveTask(node_->Name());
   }
 
+  // Makes the component stage index of pipeline, before Initialize.
+  void JoinPipeline(const std::shared_ptr<Pipeline>& pipeline, size_t index) {
+    pipeline_ = pipeline;
+    pipeline_stage_ = index;
+  }
+
   template <typename T>
   bool GetProtoConfig(T* config) const {
     return common::GetProtoFromFile(config_file_path_, config);
@@ -67,6 +75,15 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
   virtual void Clear() { return; }
   const std::string& ConfigFilePath() const { return config_file_path_; }
 
+  void CreateNode(const std::string& name) {
+    node_.reset(new Node(name));
+    // a downstream stage pulls in what its readers received before it runs,
+    // including what the stages before it published in the same cycle
+    if (pipeline_ != nullptr && pipeline_stage_ > 0) {
+      node_->SetReadersPulled();
+    }
+  }
+
   void LoadConfigFiles(const ComponentConfig& config) {
     if (!config.config_file_path().empty()) {
       if (config.config_file_path()[0] != '/') {
@@ -85,6 +102,12 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
       }
       google::SetCommandLineOption("flagfile", flag_file_path.c_str());
     }
+
+    if (config.has_period_ms() || config.has_deadline_ms()) {
+      scheduler::Instance()->SetTaskDeadline(config.name(),
+                                             config.period_ms() * 1000,
+                                             config.deadline_ms() * 1000);
+    }
   }
 
   void LoadConfigFiles(const TimerComponentConfig& config) {
@@ -107,10 +130,40 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     }
   }
 
+  // The pipeline whose downstream stages run after each message this
+  // component processes, nullptr unless it is the head of one.
+  std::shared_ptr<Pipeline> HeadOfPipeline() const {
+    return pipeline_stage_ == 0 ? pipeline_ : nullptr;
+  }
+
+  // Hands stage to the pipeline if the component is a downstream stage,
+  // which then creates no task of its own. Returns false otherwise.
+  bool RunInPipeline(Pipeline::Stage stage) {
+    if (pipeline_ == nullptr || pipeline_stage_ == 0) {
+      return false;
+    }
+    std::weak_ptr<Node> weak_node = node_;
+    auto pulled_stage = [weak_node, stage]() {
+      auto node = weak_node.lock();
+      if (node == nullptr) {
+        return false;
+      }
+      node->PullReaders();
+      return stage();
+    };
+    if (!pipeline_->SetStage(pipeline_stage_, std::move(pulled_stage))) {
+      AERROR << "Invalid stage " << pipeline_stage_ << " of pipeline "
+             << pipeline_->name();
+    }
+    return true;
+  }
+
   std::atomic<bool> is_shutdown_ = {false};
   std::shared_ptr<Node> node_ = nullptr;
   std::string config_file_path_ = "";
   std::vector<std::shared_ptr<ReaderBase>> readers_;
+  std::shared_ptr<Pipeline> pipeline_ = nullptr;
+  size_t pipeline_stage_ = 0;
 };
 
 }  // namespace cyber
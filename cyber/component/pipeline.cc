@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/component/pipeline.h"
+
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+
+Pipeline::Pipeline(const std::string& name, size_t stage_num)
+    : name_(name), stages_(stage_num) {}
+
+bool Pipeline::SetStage(size_t index, Stage stage) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index == 0 || index >= stages_.size()) {
+    return false;
+  }
+  stages_[index] = std::move(stage);
+  return true;
+}
+
+void Pipeline::RunStages() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 1; i < stages_.size(); ++i) {
+    if (stages_[i] == nullptr || !stages_[i]()) {
+      break;
+    }
+  }
+}
+
+void Pipeline::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& stage : stages_) {
+    stage = nullptr;
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_COMPONENT_PIPELINE_H_
+#define CYBER_COMPONENT_PIPELINE_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+// A chain of components declared by the pipelines of a dag, executed as one
+// task: the head stage keeps its own task, and after each message it
+// processes runs the downstream stages in order, in that task, instead of
+// each stage waiting to be woken by the messages of the stage before. A
+// stage processes what the stages before it published in the same cycle,
+// passed by pointer through the intra path.
+class Pipeline {
+ public:
+  // Processes what the stage has received, returns false when there was
+  // nothing to process.
+  using Stage = std::function<bool()>;
+
+  Pipeline(const std::string& name, size_t stage_num);
+
+  const std::string& name() const { return name_; }
+  size_t stage_num() const { return stages_.size(); }
+
+  // Sets the downstream stage index, in [1, stage_num()).
+  bool SetStage(size_t index, Stage stage);
+
+  // Runs the downstream stages in order, up to the first one which has
+  // nothing to process or is not initialized, so a stage only runs in the
+  // cycles the stage before it ran. Called in the task of the head stage.
+  void RunStages();
+
+  void Clear();
+
+ private:
+  std::string name_;
+  std::mutex mutex_;
+  std::vector<Stage> stages_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_COMPONENT_PIPELINE_H_
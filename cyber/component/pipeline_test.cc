@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/component/pipeline.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+
+TEST(PipelineTest, run_stages) {
+  Pipeline pipeline("pipeline", 4);
+  EXPECT_EQ(pipeline.name(), "pipeline");
+  EXPECT_EQ(pipeline.stage_num(), 4);
+
+  std::string trace;
+  int pending = 0;
+  // the head has no stage, nor has a stage past the end
+  EXPECT_FALSE(pipeline.SetStage(0, [] { return true; }));
+  EXPECT_FALSE(pipeline.SetStage(4, [] { return true; }));
+  EXPECT_TRUE(pipeline.SetStage(1, [&trace] {
+    trace += "1";
+    return true;
+  }));
+  EXPECT_TRUE(pipeline.SetStage(3, [&trace] {
+    trace += "3";
+    return true;
+  }));
+
+  // stage 2 is not initialized yet
+  pipeline.RunStages();
+  EXPECT_EQ(trace, "1");
+
+  EXPECT_TRUE(pipeline.SetStage(2, [&trace, &pending] {
+    if (pending == 0) {
+      return false;
+    }
+    --pending;
+    trace += "2";
+    return true;
+  }));
+  trace.clear();
+  pipeline.RunStages();
+  EXPECT_EQ(trace, "1");
+
+  trace.clear();
+  pending = 1;
+  pipeline.RunStages();
+  EXPECT_EQ(trace, "123");
+
+  trace.clear();
+  pipeline.Clear();
+  pipeline.RunStages();
+  EXPECT_TRUE(trace.empty());
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -36,7 +36,7 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
     AERROR << "Missing required field in config file.";
     return false;
   }
-  node_.reset(new Node(config.name()));
+  CreateNode(config.name());
   LoadConfigFiles(config);
   if (!Init()) {
     return false;
@@ -44,12 +44,28 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
 
   std::weak_ptr<TimerComponent> self =
       std::dynamic_pointer_cast<TimerComponent>(shared_from_this());
-  auto func = [self]() {
+  auto pipeline = HeadOfPipeline();
+  auto func = [self, pipeline]() {
     auto ptr = self.lock();
     if (ptr) {
       ptr->Proc();
+      if (pipeline != nullptr) {
+        pipeline->RunStages();
+      }
     }
   };
+  // a downstream stage runs once in every cycle of the pipeline instead of
+  // on its timer
+  if (RunInPipeline([self]() {
+        auto ptr = self.lock();
+        if (ptr == nullptr) {
+          return false;
+        }
+        ptr->Process();
+        return true;
+      })) {
+    return true;
+  }
   timer_.reset(new Timer(config.interval(), func, false));
   timer_->Start();
   return true;
@@ -16,12 +16,13 @@
 
 #include "cyber/croutine/croutine.h"
 
+#include <new>
 #include <utility>
 
-#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/detail/stack_pool.h"
 #include "cyber/event/perf_event_cache.h"
 
 namespace apollo {
@@ -33,9 +34,9 @@ using apollo::cyber::event::SchedPerf;
 
 thread_local CRoutine *CRoutine::current_routine_ = nullptr;
 thread_local char *CRoutine::main_stack_ = nullptr;
+thread_local AllocationCount thread_allocation_count = {0, 0};
 
 namespace {
-std::shared_ptr<base::CCObjectPool<RoutineContext>> context_pool = nullptr;
 std::once_flag pool_init_flag;
 
 void CRoutineEntry(void *arg) {
@@ -45,30 +46,44 @@ void CRoutineEntry(void *arg) {
 }
 }
 
-CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
+CRoutine::CRoutine(const std::function<void()> &func, size_t stack_size)
+    : func_(func) {
   std::call_once(pool_init_flag, [&]() {
+    // routine_num bounds the stacks kept for reuse, not the croutines
     auto routine_num = 100;
     auto &global_conf = common::GlobalData::Instance()->Config();
     if (global_conf.has_scheduler_conf() &&
         global_conf.scheduler_conf().has_routine_num()) {
       routine_num = global_conf.scheduler_conf().routine_num();
     }
-    context_pool.reset(new base::CCObjectPool<RoutineContext>(routine_num));
+    StackPool::Instance()->set_max_cached_num(routine_num);
   });
 
-  context_ = context_pool->GetObject();
-  if (context_ == nullptr) {
-    AWARN << "Maximum routine context number exceeded! Please check "
-             "[routine_num] in config file.";
-    context_.reset(new RoutineContext());
+  context_.reset(new RoutineContext());
+  if (!StackPool::Instance()->Allocate(stack_size, context_.get())) {
+    AERROR << "Allocate croutine stack failed, size: " << stack_size;
+    throw std::bad_alloc();
   }
 
   MakeContext(CRoutineEntry, this, context_.get());
+  if (RoutineStatistics::GetLevel() != RoutineStatistics::DISABLED) {
+    statistics_.reset(new RoutineStatistics());
+    statistics_->MarkReady(RoutineStatistics::Now());
+  }
   state_ = RoutineState::READY;
   updated_.test_and_set(std::memory_order_release);
 }
 
-CRoutine::~CRoutine() { context_ = nullptr; }
+CRoutine::~CRoutine() {
+  StackPool::Instance()->Free(context_.get());
+  context_ = nullptr;
+}
+
+size_t CRoutine::stack_size() const { return context_->stack_size; }
+
+size_t CRoutine::stack_high_water_mark() const {
+  return StackPool::HighWaterMark(*context_);
+}
 
 RoutineState CRoutine::Resume() {
   if (unlikely(force_stop_)) {
@@ -81,6 +96,10 @@ RoutineState CRoutine::Resume() {
     return state_;
   }
 
+  uint64_t resume_time = 0;
+  if (statistics_ != nullptr) {
+    resume_time = statistics_->BeforeResume();
+  }
   current_routine_ = this;
   PerfEventCache::Instance()->AddSchedEvent(
       SchedPerf::SWAP_IN, id_, processor_id_, static_cast<int>(state_));
@@ -88,6 +107,15 @@ RoutineState CRoutine::Resume() {
   PerfEventCache::Instance()->AddSchedEvent(
       SchedPerf::SWAP_OUT, id_, processor_id_, static_cast<int>(state_));
   current_routine_ = nullptr;
+  if (statistics_ != nullptr) {
+    statistics_->AfterResume(resume_time, state_ == RoutineState::READY);
+    if (state_ == RoutineState::SLEEP) {
+      statistics_->MarkReady(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              wake_time_.time_since_epoch())
+              .count());
+    }
+  }
   return state_;
 }
 
@@ -27,6 +27,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/routine_statistics.h"
 
 namespace apollo {
 namespace cyber {
@@ -39,7 +40,7 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 
 class CRoutine {
  public:
-  explicit CRoutine(const RoutineFunc &func);
+  explicit CRoutine(const RoutineFunc &func, size_t stack_size = STACK_SIZE);
   virtual ~CRoutine();
 
   // static interfaces
@@ -96,6 +97,13 @@ class CRoutine {
     return group_name_;
   }
 
+  size_t stack_size() const;
+  // bytes of the stack touched so far, rounded up to pages
+  size_t stack_high_water_mark() const;
+
+  // nullptr unless routine statistics are enabled
+  const RoutineStatistics *statistics() const { return statistics_.get(); }
+
  private:
   CRoutine(CRoutine &) = delete;
   CRoutine &operator=(CRoutine &) = delete;
@@ -120,6 +128,8 @@ class CRoutine {
 
   std::string group_name_;
 
+  std::unique_ptr<RoutineStatistics> statistics_;
+
   static thread_local CRoutine *current_routine_;
   static thread_local char *main_stack_;
 };
@@ -205,6 +215,9 @@ inline void CRoutine::Release() {
 }
 
 inline void CRoutine::SetUpdateFlag() {
+  if (statistics_ != nullptr) {
+    statistics_->MarkReady(RoutineStatistics::Now());
+  }
   updated_.clear(std::memory_order_release);
 }
 
@@ -21,9 +21,9 @@ namespace cyber {
 namespace croutine {
 
 void MakeContext(const func &f1, const void *arg, RoutineContext *ctx) {
-  ctx->sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *) - REGISTERS_SIZE;
+  ctx->sp = ctx->stack + ctx->stack_size - 2 * sizeof(void *) - REGISTERS_SIZE;
   std::memset(ctx->sp, 0, REGISTERS_SIZE);
-  char *sp = ctx->stack + STACK_SIZE - 2 * sizeof(void *);
+  char *sp = ctx->stack + ctx->stack_size - 2 * sizeof(void *);
   *reinterpret_cast<void **>(sp) = reinterpret_cast<void *>(f1);
   sp -= sizeof(void *);
   *reinterpret_cast<void **>(sp) = const_cast<void *>(arg);
@@ -31,12 +31,14 @@ namespace apollo {
 namespace cyber {
 namespace croutine {
 
+// default stack size, the real one is picked per croutine
 constexpr size_t STACK_SIZE = 8 * 1024 * 1024;
 constexpr size_t REGISTERS_SIZE = 56;
 
 typedef void (*func)(void*);
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  char* stack = nullptr;
+  size_t stack_size = 0;
   char* sp = nullptr;
 };
 
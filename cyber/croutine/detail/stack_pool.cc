@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+StackPool::StackPool() {}
+
+StackPool::~StackPool() {
+  auto page_size = PageSize();
+  for (auto& item : cached_stacks_) {
+    for (auto stack : item.second) {
+      munmap(stack - page_size, item.first + page_size);
+    }
+  }
+}
+
+size_t StackPool::PageSize() {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+bool StackPool::Allocate(size_t stack_size, RoutineContext* ctx) {
+  auto page_size = PageSize();
+  stack_size = (stack_size + page_size - 1) / page_size * page_size;
+  char* stack = nullptr;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    auto& cached = cached_stacks_[stack_size];
+    if (!cached.empty()) {
+      stack = cached.back();
+      cached.pop_back();
+      --cached_num_;
+    }
+  }
+
+  if (stack == nullptr) {
+    void* addr = mmap(nullptr, stack_size + page_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK,
+                      -1, 0);
+    if (addr == MAP_FAILED) {
+      AERROR << "map croutine stack failed, size: " << stack_size
+             << ", errno: " << errno;
+      return false;
+    }
+    if (mprotect(addr, page_size, PROT_NONE) != 0) {
+      AERROR << "protect croutine stack guard failed, errno: " << errno;
+      munmap(addr, stack_size + page_size);
+      return false;
+    }
+    stack = static_cast<char*>(addr) + page_size;
+  }
+
+  ctx->stack = stack;
+  ctx->stack_size = stack_size;
+  return true;
+}
+
+void StackPool::Free(RoutineContext* ctx) {
+  if (ctx->stack == nullptr) {
+    return;
+  }
+  auto page_size = PageSize();
+  madvise(ctx->stack, ctx->stack_size, MADV_DONTNEED);
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (cached_num_ < max_cached_num_) {
+      cached_stacks_[ctx->stack_size].emplace_back(ctx->stack);
+      ++cached_num_;
+      ctx->stack = nullptr;
+    }
+  }
+  if (ctx->stack != nullptr) {
+    munmap(ctx->stack - page_size, ctx->stack_size + page_size);
+    ctx->stack = nullptr;
+  }
+  ctx->stack_size = 0;
+  ctx->sp = nullptr;
+}
+
+size_t StackPool::HighWaterMark(const RoutineContext& ctx) {
+  if (ctx.stack == nullptr) {
+    return 0;
+  }
+  auto page_size = PageSize();
+  size_t page_num = ctx.stack_size / page_size;
+  std::vector<unsigned char> resident(page_num);
+  if (mincore(ctx.stack, ctx.stack_size, resident.data()) != 0) {
+    return 0;
+  }
+  // the stack grows down, the lowest touched page bounds its usage
+  for (size_t i = 0; i < page_num; ++i) {
+    if (resident[i] & 1) {
+      return (page_num - i) * page_size;
+    }
+  }
+  return 0;
+}
+
+size_t StackPool::cached_num() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  return cached_num_;
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+#define CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Croutine stacks are mapped with a PROT_NONE guard page below them, so an
+// overflow faults instead of corrupting the neighbour. Pages are only
+// committed when touched, and freed stacks are returned to the kernel with
+// MADV_DONTNEED before they are cached for reuse by the next croutine of the
+// same stack size.
+class StackPool {
+ public:
+  ~StackPool();
+
+  bool Allocate(size_t stack_size, RoutineContext* ctx);
+  void Free(RoutineContext* ctx);
+
+  // Upper bound of the bytes the stack has used, from its resident pages.
+  static size_t HighWaterMark(const RoutineContext& ctx);
+
+  void set_max_cached_num(size_t num) { max_cached_num_ = num; }
+  size_t cached_num();
+
+ private:
+  static size_t PageSize();
+
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<char*>> cached_stacks_;
+  size_t cached_num_ = 0;
+  size_t max_cached_num_ = 100;
+
+  DECLARE_SINGLETON(StackPool)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_POOL_H_
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+TEST(StackPoolTest, allocate_and_reuse) {
+  auto pool = StackPool::Instance();
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+
+  RoutineContext ctx;
+  EXPECT_TRUE(pool->Allocate(64 * 1024 + 1, &ctx));
+  EXPECT_NE(ctx.stack, nullptr);
+  EXPECT_EQ(ctx.stack_size, 64 * 1024 + page_size);
+  // nothing is committed before the stack is touched
+  EXPECT_EQ(StackPool::HighWaterMark(ctx), 0);
+
+  std::memset(ctx.stack + ctx.stack_size - 3 * page_size, 1, 3 * page_size);
+  EXPECT_EQ(StackPool::HighWaterMark(ctx), 3 * page_size);
+
+  char* stack = ctx.stack;
+  size_t cached_num = pool->cached_num();
+  pool->Free(&ctx);
+  EXPECT_EQ(ctx.stack, nullptr);
+  EXPECT_EQ(pool->cached_num(), cached_num + 1);
+
+  // a stack of the same size is reused, without its old pages
+  RoutineContext other;
+  EXPECT_TRUE(pool->Allocate(64 * 1024 + page_size, &other));
+  EXPECT_EQ(other.stack, stack);
+  EXPECT_EQ(StackPool::HighWaterMark(other), 0);
+  EXPECT_EQ(other.stack[other.stack_size - 1], 0);
+  pool->Free(&other);
+}
+
+TEST(StackPoolTest, guard_page) {
+  RoutineContext ctx;
+  EXPECT_TRUE(StackPool::Instance()->Allocate(16 * 1024, &ctx));
+  EXPECT_DEATH(ctx.stack[-1] = 1, "");
+  StackPool::Instance()->Free(&ctx);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
@@ -25,6 +25,7 @@
 #include "cyber/croutine/croutine.h"
 #include "cyber/data/data_visitor.h"
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/transport/message/latency_tracer.h"
 
 namespace apollo {
 namespace cyber {
@@ -58,7 +59,10 @@ RoutineFactory CreateRoutineFactory(
       for (;;) {
         CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
         if (dv->TryFetch(msg)) {
-          f(msg);
+          {
+            transport::CallbackLatencyScope scope(msg.get());
+            f(msg);
+          }
           CRoutine::Yield(RoutineState::READY);
         } else {
           CRoutine::Yield();
@@ -81,7 +85,10 @@ RoutineFactory CreateRoutineFactory(
       for (;;) {
         CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
         if (dv->TryFetch(msg0, msg1)) {
-          f(msg0, msg1);
+          {
+            transport::CallbackLatencyScope scope(msg0.get());
+            f(msg0, msg1);
+          }
           CRoutine::Yield(RoutineState::READY);
         } else {
           CRoutine::Yield();
@@ -105,7 +112,10 @@ RoutineFactory CreateRoutineFactory(
       for (;;) {
         CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
         if (dv->TryFetch(msg0, msg1, msg2)) {
-          f(msg0, msg1, msg2);
+          {
+            transport::CallbackLatencyScope scope(msg0.get());
+            f(msg0, msg1, msg2);
+          }
           CRoutine::Yield(RoutineState::READY);
         } else {
           CRoutine::Yield();
@@ -130,7 +140,10 @@ RoutineFactory CreateRoutineFactory(
       for (;;) {
         CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
         if (dv->TryFetch(msg0, msg1, msg2, msg3)) {
-          f(msg0, msg1, msg2, msg3);
+          {
+            transport::CallbackLatencyScope scope(msg0.get());
+            f(msg0, msg1, msg2, msg3);
+          }
           CRoutine::Yield(RoutineState::READY);
         } else {
           CRoutine::Yield();
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_ROUTINE_STATISTICS_H_
+#define CYBER_CROUTINE_ROUTINE_STATISTICS_H_
+
+#include <sys/resource.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "cyber/base/histogram.h"
+#include "cyber/common/environment.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Allocations made by a thread so far. Only binaries which replace operator
+// new count them, mainboard does, elsewhere they stay zero.
+struct AllocationCount {
+  uint64_t count;
+  uint64_t bytes;
+};
+
+extern thread_local AllocationCount thread_allocation_count;
+
+// Always-on counters of one croutine, allocated only when the environment
+// variable cyber_routine_stat is set. 1 records latencies, run times and the
+// allocations made while running with a few clock reads per resume, 2 also
+// counts how often the processor thread was preempted by the kernel while
+// running the croutine and the CPU time it spent (two getrusage calls per
+// resume). All counters are relaxed atomics, readers may see a slightly
+// inconsistent snapshot.
+class RoutineStatistics {
+ public:
+  enum Level { DISABLED = 0, BASIC = 1, PREEMPTION = 2 };
+
+  static Level GetLevel() {
+    static const Level level = []() {
+      auto value = common::GetEnv("cyber_routine_stat");
+      if (value.empty()) {
+        return DISABLED;
+      }
+      int number = std::atoi(value.c_str());
+      return number >= PREEMPTION ? PREEMPTION
+                                  : (number > 0 ? BASIC : DISABLED);
+    }();
+    return level;
+  }
+
+  static uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // The croutine became runnable at `time`, keeps the earliest time until
+  // the croutine is resumed.
+  void MarkReady(uint64_t time) {
+    uint64_t expected = 0;
+    ready_time_.compare_exchange_strong(expected, time,
+                                        std::memory_order_relaxed);
+  }
+
+  uint64_t BeforeResume() {
+    uint64_t now = Now();
+    uint64_t ready_time = ready_time_.exchange(0, std::memory_order_relaxed);
+    if (ready_time != 0) {
+      ready_latency_.Record(now > ready_time ? now - ready_time : 0);
+    }
+    allocations_ = thread_allocation_count;
+    if (GetLevel() == PREEMPTION) {
+      usage_ = GetThreadUsage();
+    }
+    return now;
+  }
+
+  // `ready` tells the croutine yielded while still being runnable.
+  void AfterResume(uint64_t resume_time, bool ready) {
+    uint64_t now = Now();
+    run_time_.Record(now - resume_time);
+    resume_count_.fetch_add(1, std::memory_order_relaxed);
+    if (ready) {
+      yield_count_.fetch_add(1, std::memory_order_relaxed);
+      MarkReady(now);
+    }
+    alloc_count_.fetch_add(thread_allocation_count.count - allocations_.count,
+                           std::memory_order_relaxed);
+    alloc_bytes_.fetch_add(thread_allocation_count.bytes - allocations_.bytes,
+                           std::memory_order_relaxed);
+    if (GetLevel() == PREEMPTION) {
+      ThreadUsage usage = GetThreadUsage();
+      preempt_count_.fetch_add(
+          usage.involuntary_switches - usage_.involuntary_switches,
+          std::memory_order_relaxed);
+      cpu_time_.fetch_add(usage.cpu_time - usage_.cpu_time,
+                          std::memory_order_relaxed);
+    }
+  }
+
+  // nanoseconds from becoming runnable to being resumed
+  const base::Histogram& ready_latency() const { return ready_latency_; }
+  // nanoseconds per resume
+  const base::Histogram& run_time() const { return run_time_; }
+  uint64_t resume_count() const { return resume_count_.load(); }
+  uint64_t yield_count() const { return yield_count_.load(); }
+  uint64_t preempt_count() const { return preempt_count_.load(); }
+  // allocations made while running, and their bytes
+  uint64_t alloc_count() const { return alloc_count_.load(); }
+  uint64_t alloc_bytes() const { return alloc_bytes_.load(); }
+  // nanoseconds of CPU time while running, user and system
+  uint64_t cpu_time() const { return cpu_time_.load(); }
+
+ private:
+  struct ThreadUsage {
+    uint64_t involuntary_switches = 0;
+    uint64_t cpu_time = 0;
+  };
+
+  static ThreadUsage GetThreadUsage() {
+    ThreadUsage thread_usage;
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+      return thread_usage;
+    }
+    thread_usage.involuntary_switches = usage.ru_nivcsw;
+    thread_usage.cpu_time =
+        (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000ULL +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000ULL;
+    return thread_usage;
+  }
+
+  base::Histogram ready_latency_;
+  base::Histogram run_time_;
+  std::atomic<uint64_t> ready_time_ = {0};
+  std::atomic<uint64_t> resume_count_ = {0};
+  std::atomic<uint64_t> yield_count_ = {0};
+  std::atomic<uint64_t> preempt_count_ = {0};
+  std::atomic<uint64_t> alloc_count_ = {0};
+  std::atomic<uint64_t> alloc_bytes_ = {0};
+  std::atomic<uint64_t> cpu_time_ = {0};
+  // only touched by the processor running the croutine
+  AllocationCount allocations_ = {0, 0};
+  ThreadUsage usage_;
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_ROUTINE_STATISTICS_H_
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/routine_statistics.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+TEST(RoutineStatisticsTest, resume) {
+  RoutineStatistics statistics;
+  auto ready_time = RoutineStatistics::Now();
+  statistics.MarkReady(ready_time);
+  // a later notification keeps the first ready time
+  statistics.MarkReady(ready_time + 1000000000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  auto resume_time = statistics.BeforeResume();
+  statistics.AfterResume(resume_time, true);
+  EXPECT_EQ(statistics.resume_count(), 1);
+  EXPECT_EQ(statistics.yield_count(), 1);
+  EXPECT_EQ(statistics.ready_latency().Count(), 1);
+  EXPECT_GE(statistics.ready_latency().Max(), 2000000);
+  EXPECT_EQ(statistics.run_time().Count(), 1);
+
+  // yielded while ready, so the next resume records a latency again
+  resume_time = statistics.BeforeResume();
+  statistics.AfterResume(resume_time, false);
+  EXPECT_EQ(statistics.ready_latency().Count(), 2);
+
+  // waiting for data, nothing to record until marked ready
+  resume_time = statistics.BeforeResume();
+  statistics.AfterResume(resume_time, false);
+  EXPECT_EQ(statistics.resume_count(), 3);
+  EXPECT_EQ(statistics.yield_count(), 1);
+  EXPECT_EQ(statistics.ready_latency().Count(), 2);
+  EXPECT_EQ(statistics.run_time().Count(), 3);
+  EXPECT_EQ(statistics.preempt_count(), 0);
+  EXPECT_EQ(statistics.cpu_time(), 0);
+}
+
+TEST(RoutineStatisticsTest, allocations) {
+  RoutineStatistics statistics;
+  auto resume_time = statistics.BeforeResume();
+  // what a replaced operator new counts while the croutine runs
+  thread_allocation_count.count += 2;
+  thread_allocation_count.bytes += 96;
+  statistics.AfterResume(resume_time, false);
+
+  // made outside of the croutine, not charged to it
+  thread_allocation_count.count += 1;
+  thread_allocation_count.bytes += 8;
+  resume_time = statistics.BeforeResume();
+  thread_allocation_count.count += 1;
+  thread_allocation_count.bytes += 32;
+  statistics.AfterResume(resume_time, false);
+
+  EXPECT_EQ(statistics.alloc_count(), 3);
+  EXPECT_EQ(statistics.alloc_bytes(), 128);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
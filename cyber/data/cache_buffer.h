@@ -17,13 +17,25 @@
 #ifndef CYBER_DATA_CACHE_BUFFER_H_
 #define CYBER_DATA_CACHE_BUFFER_H_
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <vector>
+#include <thread>
+#include <utility>
+
+#include "cyber/base/macros.h"
 
 namespace apollo {
 namespace cyber {
 namespace data {
 
+// Ring of the latest messages of a channel. Fill() must not run
+// concurrently with itself, multiple producers serialize on Mutex().
+// Readers use Fetch() and Latest(): they never take Mutex() and never block
+// the writer, each slot carries the position it holds, so a reader simply
+// misses a message the writer has already overwritten. operator[], at(),
+// Front() and Back() return references and are for single threaded use.
 template <typename T>
 class CacheBuffer {
  public:
@@ -32,51 +44,113 @@ class CacheBuffer {
 
   explicit CacheBuffer(uint32_t size) {
     capacity_ = size + 1;
-    buffer_.resize(capacity_);
+    slots_.reset(new Slot[capacity_]);
   }
 
   CacheBuffer(const CacheBuffer& rhs) {
     std::lock_guard<std::mutex> lg(rhs.mutex_);
-    head_ = rhs.head_;
-    tail_ = rhs.tail_;
-    buffer_ = rhs.buffer_;
+    head_.store(rhs.head_.load());
+    tail_.store(rhs.tail_.load());
     capacity_ = rhs.capacity_;
+    slots_.reset(new Slot[capacity_]);
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      slots_[i].pos = rhs.slots_[i].pos;
+      slots_[i].value = rhs.slots_[i].value;
+    }
   }
 
-  T& operator[](const uint64_t& pos) { return buffer_[GetIndex(pos)]; }
-  const T& at(const uint64_t& pos) const { return buffer_[GetIndex(pos)]; }
+  T& operator[](const uint64_t& pos) { return slots_[GetIndex(pos)].value; }
+  const T& at(const uint64_t& pos) const {
+    return slots_[GetIndex(pos)].value;
+  }
 
-  uint64_t Head() const { return head_ + 1; }
-  uint64_t Tail() const { return tail_; }
-  uint64_t Size() const { return tail_ - head_; }
+  uint64_t Head() const { return head_.load(std::memory_order_acquire) + 1; }
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  uint64_t Size() const { return Tail() - (Head() - 1); }
 
-  const T& Front() const { return buffer_[GetIndex(head_ + 1)]; }
-  const T& Back() const { return buffer_[GetIndex(tail_)]; }
+  const T& Front() const { return at(Head()); }
+  const T& Back() const { return at(Tail()); }
 
-  bool Empty() const { return tail_ == 0; }
-  bool Full() const { return capacity_ - 1 == tail_ - head_; }
+  bool Empty() const { return Tail() == 0; }
+  bool Full() const { return capacity_ - 1 == Size(); }
 
   void Fill(const T& value) {
-    if (Full()) {
-      buffer_[GetIndex(head_)] = value;
-      ++head_;
-      ++tail_;
-    } else {
-      buffer_[GetIndex(tail_ + 1)] = value;
-      ++tail_;
+    T old = value;
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_relaxed);
+    // with one spare slot the next position never collides with a position
+    // still in the buffer, only with the one dropped last time
+    auto& slot = slots_[GetIndex(tail + 1)];
+    slot.Lock();
+    std::swap(slot.value, old);
+    slot.pos = tail + 1;
+    slot.Unlock();
+    if (capacity_ - 1 == tail - head) {
+      head_.store(head + 1, std::memory_order_release);
+    }
+    tail_.store(tail + 1, std::memory_order_release);
+    // the replaced message is released outside the slot lock
+  }
+
+  // Copies the message at |pos|, fails if it was never written or has been
+  // overwritten already.
+  bool Fetch(uint64_t pos, T* value) const {
+    auto& slot = slots_[GetIndex(pos)];
+    T copy;
+    slot.Lock();
+    bool found = slot.pos == pos && pos != 0;
+    if (found) {
+      copy = slot.value;
+    }
+    slot.Unlock();
+    if (found) {
+      *value = std::move(copy);
+    }
+    return found;
+  }
+
+  bool Latest(T* value) const {
+    while (true) {
+      auto tail = Tail();
+      if (tail == 0) {
+        return false;
+      }
+      if (Fetch(tail, value)) {
+        return true;
+      }
     }
   }
 
   std::mutex& Mutex() { return mutex_; }
 
  private:
+  // The lock only covers copying a message in or out of the slot, so the
+  // writer and a reader contend only when the reader is a full lap behind.
+  struct Slot {
+    void Lock() const {
+      int spins = 0;
+      while (locked.exchange(true, std::memory_order_acquire)) {
+        if (++spins < 64) {
+          cpu_relax();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+    void Unlock() const { locked.store(false, std::memory_order_release); }
+
+    mutable std::atomic<bool> locked = {false};
+    uint64_t pos = 0;
+    T value;
+  };
+
   CacheBuffer& operator=(const CacheBuffer& other) = delete;
   uint64_t GetIndex(const uint64_t& pos) const { return pos % capacity_; }
 
-  uint64_t head_ = 0;
-  uint64_t tail_ = 0;
+  std::atomic<uint64_t> head_ = {0};
+  std::atomic<uint64_t> tail_ = {0};
   uint64_t capacity_ = 0;
-  std::vector<T> buffer_;
+  std::unique_ptr<Slot[]> slots_;
   mutable std::mutex mutex_;
 };
 
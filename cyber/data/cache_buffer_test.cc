@@ -17,10 +17,12 @@
 #include "cyber/data/cache_buffer.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
-
+#include <vector>
 
 namespace apollo {
 namespace cyber {
@@ -53,6 +55,61 @@ TEST(CacheBufferTest, cache_buffer_test) {
   EXPECT_TRUE(buffer1.Full());
 }
 
+TEST(CacheBufferTest, fetch) {
+  CacheBuffer<int> buffer(2);
+  int value = 0;
+  EXPECT_FALSE(buffer.Latest(&value));
+  EXPECT_FALSE(buffer.Fetch(0, &value));
+  EXPECT_FALSE(buffer.Fetch(1, &value));
+  buffer.Fill(10);
+  buffer.Fill(20);
+  EXPECT_TRUE(buffer.Fetch(1, &value));
+  EXPECT_EQ(10, value);
+  EXPECT_TRUE(buffer.Latest(&value));
+  EXPECT_EQ(20, value);
+
+  // the oldest message is dropped, its slot is reused a lap later
+  buffer.Fill(30);
+  EXPECT_TRUE(buffer.Fetch(2, &value));
+  EXPECT_EQ(20, value);
+  EXPECT_TRUE(buffer.Fetch(1, &value));
+  buffer.Fill(40);
+  EXPECT_FALSE(buffer.Fetch(1, &value));
+  EXPECT_EQ(3, buffer.Head());
+  EXPECT_EQ(4, buffer.Tail());
+}
+
+TEST(CacheBufferTest, concurrent_read) {
+  CacheBuffer<std::shared_ptr<uint64_t>> buffer(4);
+  const uint64_t msg_num = 100000;
+  std::atomic<bool> failed = {false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      std::shared_ptr<uint64_t> msg;
+      uint64_t last = 0;
+      while (last < msg_num) {
+        if (!buffer.Latest(&msg)) {
+          continue;
+        }
+        // messages are seen in order and never torn
+        if (*msg < last) {
+          failed.store(true);
+        }
+        last = *msg;
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    buffer.Fill(std::make_shared<uint64_t>(i));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_FALSE(failed.load());
+  EXPECT_EQ(msg_num, buffer.Tail());
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
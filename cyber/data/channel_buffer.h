@@ -20,10 +20,12 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/data/cache_buffer.h"
 #include "cyber/data/data_notifier.h"
 #include "cyber/proto/component_conf.pb.h"
 
@@ -57,50 +59,52 @@ class ChannelBuffer {
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+  while (true) {
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index > tail) {
+      return false;
+    } else if (*index < buffer_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail
+            << "] ";
+      *index = tail;
+    }
+    if (buffer_->Fetch(*index, &m)) {
+      return true;
+    }
+    // overwritten since Head() was read, start over from the newest
   }
-
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
-  }
-  m = buffer_->at(*index);
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  m = buffer_->Back();
-  return true;
+  return buffer_->Latest(&m);
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+  auto tail = buffer_->Tail();
+  if (tail == 0) {
     return false;
   }
 
   auto num = std::min(buffer_->Size(), fetch_size);
   vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  // messages overwritten in the meantime are skipped, they are the oldest
+  std::shared_ptr<T> m;
+  for (auto index = tail - num + 1; index <= tail; ++index) {
+    if (buffer_->Fetch(index, &m)) {
+      vec->emplace_back(std::move(m));
+    }
   }
   return true;
 }
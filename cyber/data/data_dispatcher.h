@@ -79,6 +79,7 @@ bool DataDispatcher<T>::Dispatch(const uint64_t channel_id,
   if (buffers_map_.Get(channel_id, &buffers)) {
     for (auto& buffer_wptr : *buffers) {
       if (auto buffer = buffer_wptr.lock()) {
+        // only serializes publishers, readers never take it
         std::lock_guard<std::mutex> lock(buffer->Mutex());
         buffer->Fill(msg);
       }
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cyber/data/data_dispatcher.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+namespace {
+
+struct Message {
+  uint64_t id;
+};
+
+using Buffer = CacheBuffer<std::shared_ptr<Message>>;
+
+// One busy reader thread per buffer, polling the latest message the way a
+// fusion of several channels would.
+class Readers {
+ public:
+  Readers(uint64_t channel_id, int num, bool locked) {
+    for (int i = 0; i < num; ++i) {
+      buffers_.emplace_back(channel_id, new Buffer(10));
+    }
+    for (auto& buffer : buffers_) {
+      threads_.emplace_back([this, &buffer, locked]() {
+        std::shared_ptr<Message> msg;
+        while (!stop_.load(std::memory_order_relaxed)) {
+          if (locked) {
+            std::lock_guard<std::mutex> lock(buffer.Buffer()->Mutex());
+            if (!buffer.Buffer()->Empty()) {
+              msg = buffer.Buffer()->Back();
+            }
+          } else {
+            buffer.Latest(msg);
+          }
+        }
+      });
+    }
+  }
+
+  ~Readers() {
+    stop_.store(true);
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  std::vector<ChannelBuffer<Message>>& buffers() { return buffers_; }
+
+ private:
+  std::atomic<bool> stop_ = {false};
+  std::vector<ChannelBuffer<Message>> buffers_;
+  std::vector<std::thread> threads_;
+};
+
+uint64_t NextChannelId() {
+  static std::atomic<uint64_t> channel_id = {1};
+  return channel_id.fetch_add(1);
+}
+
+}  // namespace
+
+// Every subscriber's buffer filled under the mutex its readers also take,
+// as DataDispatcher and ChannelBuffer did before.
+static void BM_LockedDispatch(benchmark::State& state) {  // NOLINT
+  Readers readers(NextChannelId(), static_cast<int>(state.range(0)), true);
+  auto msg = std::make_shared<Message>();
+  while (state.KeepRunning()) {
+    for (auto& buffer : readers.buffers()) {
+      std::lock_guard<std::mutex> lock(buffer.Buffer()->Mutex());
+      buffer.Buffer()->Fill(msg);
+    }
+  }
+}
+BENCHMARK(BM_LockedDispatch)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+static void BM_Dispatch(benchmark::State& state) {  // NOLINT
+  auto channel_id = NextChannelId();
+  Readers readers(channel_id, static_cast<int>(state.range(0)), false);
+  auto dispatcher = DataDispatcher<Message>::Instance();
+  for (auto& buffer : readers.buffers()) {
+    dispatcher->AddBuffer(buffer);
+  }
+  auto msg = std::make_shared<Message>();
+  while (state.KeepRunning()) {
+    dispatcher->Dispatch(channel_id, msg);
+  }
+}
+BENCHMARK(BM_Dispatch)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -28,6 +28,7 @@
 #include "cyber/data/data_visitor_base.h"
 #include "cyber/data/fusion/all_latest.h"
 #include "cyber/data/fusion/data_fusion.h"
+#include "cyber/data/fusion/time_sync.h"
 
 namespace apollo {
 namespace cyber {
@@ -43,11 +44,29 @@ struct VisitorConfig {
 template <typename T>
 using BufferType = CacheBuffer<std::shared_ptr<T>>;
 
+using apollo::cyber::proto::FusionOption;
+
+template <typename M0, typename M1, typename M2, typename M3,
+          typename... Buffers>
+fusion::DataFusion<M0, M1, M2, M3>* CreateDataFusion(
+    const FusionOption& option, const Buffers&... buffers) {
+  switch (option.policy()) {
+    case FusionOption::APPROXIMATE_TIME:
+      return new fusion::ApproximateTime<M0, M1, M2, M3>(
+          static_cast<uint64_t>(option.tolerance_us()) * 1000, buffers...);
+    case FusionOption::EXACT_TIME:
+      return new fusion::ExactTime<M0, M1, M2, M3>(buffers...);
+    default:
+      return new fusion::AllLatest<M0, M1, M2, M3>(buffers...);
+  }
+}
+
 template <typename M0, typename M1 = NullType, typename M2 = NullType,
           typename M3 = NullType>
 class DataVisitor : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(const std::vector<VisitorConfig>& configs,
+                       const FusionOption& option = FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -61,8 +80,13 @@ class DataVisitor : public DataVisitorBase {
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     DataDispatcher<M3>::Instance()->AddBuffer(buffer_m3_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
-        buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    if (option.policy() != FusionOption::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m2_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m3_.channel_id(), notifier_);
+    }
+    data_fusion_ = CreateDataFusion<M0, M1, M2, M3>(
+        option, buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
   }
 
   ~DataVisitor() {
@@ -92,7 +116,8 @@ class DataVisitor : public DataVisitorBase {
 template <typename M0, typename M1, typename M2>
 class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(const std::vector<VisitorConfig>& configs,
+                       const FusionOption& option = FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -103,8 +128,12 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ =
-        new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_, buffer_m2_);
+    if (option.policy() != FusionOption::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m2_.channel_id(), notifier_);
+    }
+    data_fusion_ = CreateDataFusion<M0, M1, M2, NullType>(
+        option, buffer_m0_, buffer_m1_, buffer_m2_);
   }
 
   ~DataVisitor() {
@@ -133,7 +162,8 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
 template <typename M0, typename M1>
 class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(const std::vector<VisitorConfig>& configs,
+                       const FusionOption& option = FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -141,7 +171,11 @@ class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    if (option.policy() != FusionOption::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+    }
+    data_fusion_ = CreateDataFusion<M0, M1, NullType, NullType>(
+        option, buffer_m0_, buffer_m1_);
   }
 
   ~DataVisitor() {
@@ -131,6 +131,28 @@ TEST(DataVisitorTest, four_channel) {
   EXPECT_FALSE(dv->TryFetch(msg0, msg1, msg2, msg3));
 }
 
+TEST(DataVisitorTest, time_sync_notify) {
+  auto channel_a = str_hash("/sync_channel_a");
+  auto channel_b = str_hash("/sync_channel_b");
+  std::vector<VisitorConfig> configs = {{channel_a, 10}, {channel_b, 10}};
+  FusionOption option;
+  option.set_policy(FusionOption::APPROXIMATE_TIME);
+  auto dv = std::make_shared<DataVisitor<RawMessage, RawMessage>>(configs,
+                                                                  option);
+  int notified = 0;
+  dv->RegisterNotifyCallback([&notified]() { ++notified; });
+
+  DispatchMessage(channel_a, 1);
+  std::shared_ptr<RawMessage> msg0;
+  std::shared_ptr<RawMessage> msg1;
+  EXPECT_FALSE(dv->TryFetch(msg0, msg1));
+  // the late channel wakes the visitor as well
+  DispatchMessage(channel_b, 1);
+  EXPECT_EQ(2, notified);
+  EXPECT_TRUE(dv->TryFetch(msg0, msg1));
+  EXPECT_FALSE(dv->TryFetch(msg0, msg1));
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
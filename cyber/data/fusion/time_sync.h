@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_TIME_SYNC_H_
+#define CYBER_DATA_FUSION_TIME_SYNC_H_
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/common/types.h"
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/fusion/data_fusion.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+DEFINE_TYPE_TRAIT(HasHeader, header)
+
+// Nanoseconds of header().timestamp_sec(). Messages without a header all
+// have timestamp 0, so they pair the way AllLatest pairs them.
+template <typename T>
+typename std::enable_if<HasHeader<T>::value, uint64_t>::type MessageTimestamp(
+    const T& msg) {
+  return static_cast<uint64_t>(
+      std::llround(msg.header().timestamp_sec() * 1e9));
+}
+
+template <typename T>
+typename std::enable_if<!HasHeader<T>::value, uint64_t>::type
+MessageTimestamp(const T&) {
+  return 0;
+}
+
+enum class MatchResult {
+  MATCHED,
+  // nothing close enough yet, but a later message may be
+  PENDING,
+  // the channel is already past the timestamp
+  MISSED,
+};
+
+inline MatchResult Combine(MatchResult lhs, MatchResult rhs) {
+  if (lhs == MatchResult::MISSED || rhs == MatchResult::MISSED) {
+    return MatchResult::MISSED;
+  }
+  if (lhs == MatchResult::PENDING || rhs == MatchResult::PENDING) {
+    return MatchResult::PENDING;
+  }
+  return MatchResult::MATCHED;
+}
+
+// Finds the message of the channel history closest to |timestamp| within
+// |tolerance|, assuming timestamps increase along a channel.
+template <typename M>
+MatchResult MatchChannel(const ChannelBuffer<M>& channel, uint64_t timestamp,
+                         uint64_t tolerance, std::shared_ptr<M>* m) {
+  auto buffer = channel.Buffer();
+  auto tail = buffer->Tail();
+  bool found = false;
+  bool has_newest = false;
+  uint64_t newest = 0;
+  uint64_t best = 0;
+  std::shared_ptr<M> msg;
+  for (auto pos = tail; pos > 0 && pos >= buffer->Head(); --pos) {
+    if (!buffer->Fetch(pos, &msg)) {
+      // overwritten meanwhile, so are the older ones
+      break;
+    }
+    auto ts = MessageTimestamp(*msg);
+    if (!has_newest) {
+      has_newest = true;
+      newest = ts;
+    }
+    auto diff = ts > timestamp ? ts - timestamp : timestamp - ts;
+    if (diff <= tolerance && (!found || diff < best)) {
+      found = true;
+      best = diff;
+      *m = msg;
+    }
+    if (ts + tolerance < timestamp) {
+      break;
+    }
+  }
+  if (found) {
+    return MatchResult::MATCHED;
+  }
+  return has_newest && newest > timestamp + tolerance ? MatchResult::MISSED
+                                                      : MatchResult::PENDING;
+}
+
+// Walks the messages of channel 0 in order and pairs each one with the
+// messages of the other channels whose timestamps are within a tolerance.
+// A message of channel 0 that waits for the others blocks the ones after
+// it, a message that can no longer be paired is dropped and counted.
+template <typename M0>
+class TimeSync {
+ public:
+  TimeSync(uint64_t tolerance_ns, const ChannelBuffer<M0>& buffer)
+      : tolerance_(tolerance_ns), buffer_(buffer) {}
+
+  ~TimeSync() {
+    if (dropped_ > 0) {
+      AINFO << "channel[" << GlobalData::GetChannelById(buffer_.channel_id())
+            << "] fused " << matched_ << " messages, dropped " << dropped_;
+    }
+  }
+
+  template <typename MatchFunc>
+  bool Sync(uint64_t* index, std::shared_ptr<M0>& m0,  // NOLINT
+            MatchFunc&& match) {
+    while (buffer_.Fetch(index, m0)) {
+      auto result = match(MessageTimestamp(*m0), tolerance_);
+      if (result == MatchResult::MATCHED) {
+        ++matched_;
+        return true;
+      }
+      if (result == MatchResult::PENDING) {
+        return false;
+      }
+      ++dropped_;
+      ++*index;
+    }
+    return false;
+  }
+
+  uint64_t tolerance() const { return tolerance_; }
+  uint64_t matched_count() const { return matched_; }
+  uint64_t dropped_count() const { return dropped_; }
+
+ private:
+  uint64_t tolerance_;
+  uint64_t matched_ = 0;
+  uint64_t dropped_ = 0;
+  ChannelBuffer<M0> buffer_;
+};
+
+template <typename M0, typename M1 = NullType, typename M2 = NullType,
+          typename M3 = NullType>
+class ApproximateTime : public DataFusion<M0, M1, M2, M3> {
+ public:
+  ApproximateTime(uint64_t tolerance_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1,
+                  const ChannelBuffer<M2>& buffer_2,
+                  const ChannelBuffer<M3>& buffer_3)
+      : sync_(tolerance_ns, buffer_0),
+        buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2),
+        buffer_m3_(buffer_3) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2, std::shared_ptr<M3>& m3) override {
+    return sync_.Sync(index, m0, [&](uint64_t ts, uint64_t tolerance) {
+      return Combine(
+          Combine(MatchChannel(buffer_m1_, ts, tolerance, &m1),
+                  MatchChannel(buffer_m2_, ts, tolerance, &m2)),
+          MatchChannel(buffer_m3_, ts, tolerance, &m3));
+    });
+  }
+
+  const TimeSync<M0>& sync() const { return sync_; }
+
+ private:
+  TimeSync<M0> sync_;
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+  ChannelBuffer<M3> buffer_m3_;
+};
+
+template <typename M0, typename M1, typename M2>
+class ApproximateTime<M0, M1, M2, NullType> : public DataFusion<M0, M1, M2> {
+ public:
+  ApproximateTime(uint64_t tolerance_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1,
+                  const ChannelBuffer<M2>& buffer_2)
+      : sync_(tolerance_ns, buffer_0),
+        buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2) override {
+    return sync_.Sync(index, m0, [&](uint64_t ts, uint64_t tolerance) {
+      return Combine(MatchChannel(buffer_m1_, ts, tolerance, &m1),
+                     MatchChannel(buffer_m2_, ts, tolerance, &m2));
+    });
+  }
+
+  const TimeSync<M0>& sync() const { return sync_; }
+
+ private:
+  TimeSync<M0> sync_;
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+};
+
+template <typename M0, typename M1>
+class ApproximateTime<M0, M1, NullType, NullType> : public DataFusion<M0, M1> {
+ public:
+  ApproximateTime(uint64_t tolerance_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<M1>& buffer_1)
+      : sync_(tolerance_ns, buffer_0), buffer_m1_(buffer_1) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0,
+              std::shared_ptr<M1>& m1) override {
+    return sync_.Sync(index, m0, [&](uint64_t ts, uint64_t tolerance) {
+      return MatchChannel(buffer_m1_, ts, tolerance, &m1);
+    });
+  }
+
+  const TimeSync<M0>& sync() const { return sync_; }
+
+ private:
+  TimeSync<M0> sync_;
+  ChannelBuffer<M1> buffer_m1_;
+};
+
+// Pairs only messages with identical timestamps.
+template <typename M0, typename M1 = NullType, typename M2 = NullType,
+          typename M3 = NullType>
+class ExactTime : public ApproximateTime<M0, M1, M2, M3> {
+ public:
+  template <typename... Buffers>
+  explicit ExactTime(const Buffers&... buffers)
+      : ApproximateTime<M0, M1, M2, M3>(0, buffers...) {}
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_TIME_SYNC_H_
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/time_sync.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+namespace {
+
+struct Header {
+  double timestamp_sec() const { return timestamp; }
+  double timestamp = 0.0;
+};
+
+struct Stamped {
+  explicit Stamped(double ts) { header_.timestamp = ts; }
+  const Header& header() const { return header_; }
+  Header header_;
+};
+
+using Buffer = CacheBuffer<std::shared_ptr<Stamped>>;
+
+void Fill(const ChannelBuffer<Stamped>& channel, double ts) {
+  channel.Buffer()->Fill(std::make_shared<Stamped>(ts));
+}
+
+}  // namespace
+
+TEST(TimeSyncTest, message_timestamp) {
+  EXPECT_EQ(1500000000ULL, MessageTimestamp(Stamped(1.5)));
+  EXPECT_EQ(0, MessageTimestamp(1));
+}
+
+TEST(TimeSyncTest, approximate_time) {
+  ChannelBuffer<Stamped> camera(common::Hash("/sync/camera"), new Buffer(10));
+  ChannelBuffer<Stamped> lidar(common::Hash("/sync/lidar"), new Buffer(10));
+  // 20ms tolerance
+  ApproximateTime<Stamped, Stamped> sync(20000000, camera, lidar);
+
+  uint64_t index = 0;
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+  EXPECT_FALSE(sync.Fusion(&index, m0, m1));
+
+  // the camera frame waits for a lidar sweep close enough to it
+  Fill(camera, 1.00);
+  Fill(lidar, 0.90);
+  EXPECT_FALSE(sync.Fusion(&index, m0, m1));
+  Fill(lidar, 1.01);
+  EXPECT_TRUE(sync.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(1.00, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.01, m1->header().timestamp_sec());
+  ++index;
+
+  // the closest sweep in the history wins
+  Fill(lidar, 1.04);
+  Fill(lidar, 1.06);
+  Fill(camera, 1.045);
+  EXPECT_TRUE(sync.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(1.04, m1->header().timestamp_sec());
+  ++index;
+
+  // lidar is already past this frame, it is dropped for the next one
+  Fill(lidar, 1.20);
+  Fill(camera, 1.10);
+  Fill(camera, 1.19);
+  EXPECT_TRUE(sync.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(1.19, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.20, m1->header().timestamp_sec());
+  ++index;
+  EXPECT_FALSE(sync.Fusion(&index, m0, m1));
+
+  EXPECT_EQ(3, sync.sync().matched_count());
+  EXPECT_EQ(1, sync.sync().dropped_count());
+}
+
+TEST(TimeSyncTest, exact_time) {
+  ChannelBuffer<Stamped> m0_channel(common::Hash("/sync/m0"), new Buffer(10));
+  ChannelBuffer<Stamped> m1_channel(common::Hash("/sync/m1"), new Buffer(10));
+  ChannelBuffer<Stamped> m2_channel(common::Hash("/sync/m2"), new Buffer(10));
+  ExactTime<Stamped, Stamped, Stamped> sync(m0_channel, m1_channel,
+                                            m2_channel);
+
+  uint64_t index = 0;
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+  std::shared_ptr<Stamped> m2;
+  Fill(m0_channel, 1.0);
+  Fill(m1_channel, 1.0);
+  EXPECT_FALSE(sync.Fusion(&index, m0, m1, m2));
+  Fill(m2_channel, 1.0);
+  EXPECT_TRUE(sync.Fusion(&index, m0, m1, m2));
+  ++index;
+
+  // m2 skips 1.1, so that message of m0 can never be paired
+  Fill(m0_channel, 1.1);
+  Fill(m1_channel, 1.1);
+  Fill(m2_channel, 1.2);
+  Fill(m0_channel, 1.2);
+  Fill(m1_channel, 1.2);
+  EXPECT_TRUE(sync.Fusion(&index, m0, m1, m2));
+  EXPECT_DOUBLE_EQ(1.2, m0->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.2, m1->header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(1.2, m2->header().timestamp_sec());
+  EXPECT_EQ(1, sync.sync().dropped_count());
+}
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
@@ -27,7 +27,13 @@ namespace apollo {
 namespace cyber {
 namespace event {
 
-enum class EventType { SCHED_EVENT = 0, TRANS_EVENT = 1, TRY_FETCH_EVENT = 3 };
+enum class EventType {
+  SCHED_EVENT = 0,
+  TRANS_EVENT = 1,
+  TRY_FETCH_EVENT = 3,
+  TRACE_EVENT = 4,
+  NAME_EVENT = 5,
+};
 
 enum class TransPerf { TRANS_FROM = 1, TRANS_TO = 2, WRITE_NOTIFY = 3 };
 
@@ -39,6 +45,27 @@ enum class SchedPerf {
   RT_CREATE = 5,
 };
 
+// An event as it is queued and written to a binary perf file. The file
+// starts with kPerfBinaryMagic and the stamp it was opened at, then holds
+// one record per event. Before the first event of an id a NAME_EVENT record
+// names it, followed by the name padded to a multiple of 8 bytes.
+struct PerfRecord {
+  uint64_t stamp;
+  // cr_id, channel_id, trace name id, or the id named by a NAME_EVENT
+  uint64_t id;
+  // msg_seq, first trace arg, or the name length of a NAME_EVENT
+  uint64_t arg0;
+  // proc_id, second trace arg, or the event type of a NAME_EVENT
+  int32_t arg1;
+  // cr_state
+  int16_t arg2;
+  uint8_t etype;
+  uint8_t eid;
+};
+static_assert(sizeof(PerfRecord) == 32, "PerfRecord must stay 32 bytes");
+
+constexpr char kPerfBinaryMagic[8] = "CYBPERF";
+
 class EventBase {
  public:
   virtual std::string SerializeToString() = 0;
@@ -118,6 +145,35 @@ class TransportEvent : public EventBase {
   uint64_t channel_id_ = UINT64_MAX;
 };
 
+// event_id
+// 0 a named trace point, see CYBER_TRACE_EVENT
+class TraceEvent : public EventBase {
+ public:
+  TraceEvent() { etype_ = static_cast<int>(EventType::TRACE_EVENT); }
+
+  std::string SerializeToString() override {
+    std::stringstream ss;
+    ss << etype_ << "\t";
+    ss << eid_ << "\t";
+    ss << name_ << "\t";
+    ss << arg0_ << "\t";
+    ss << arg1_ << "\t";
+    ss << stamp_;
+    return ss.str();
+  }
+
+  void set_name(const std::string& name) { name_ = name; }
+  void set_args(uint64_t arg0, int arg1) {
+    arg0_ = arg0;
+    arg1_ = arg1;
+  }
+
+ private:
+  std::string name_;
+  uint64_t arg0_ = 0;
+  int arg1_ = 0;
+};
+
 }  // namespace event
 }  // namespace cyber
 }  // namespace apollo
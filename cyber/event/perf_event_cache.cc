@@ -16,12 +16,14 @@
 
 #include "cyber/event/perf_event_cache.h"
 
+#include <cstring>
 #include <string>
 
 #include "cyber/base/macros.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/common/util.h"
 #include "cyber/state.h"
 #include "cyber/time/time.h"
 
@@ -42,9 +44,16 @@ PerfEventCache::PerfEventCache() {
       std::stoi(sched_perf)) {
     enable_sched_perf_ = true;
   }
+  auto trace_perf = GetEnv("cyber_trace_perf");
+  if (trace_perf != "" &&
+      std::stoi(trace_perf)) {
+    enable_trace_perf_ = true;
+  }
+  binary_ = GetEnv("cyber_perf_format") == "binary";
 
   if (enable_sched_perf_ ||
-      enable_trans_perf_) {
+      enable_trans_perf_ ||
+      enable_trace_perf_) {
     if (!event_queue_.Init(kEventQueueSize)) {
       AERROR << "Event queue init failed.";
       throw std::runtime_error("Event queue init failed.");
@@ -55,7 +64,8 @@ PerfEventCache::PerfEventCache() {
 
 PerfEventCache::~PerfEventCache() {
   if (!enable_sched_perf_ &&
-      !enable_trans_perf_) {
+      !enable_trans_perf_ &&
+      !enable_trace_perf_) {
     return;
   }
 
@@ -68,7 +78,9 @@ PerfEventCache::~PerfEventCache() {
     io_thread_.join();
   }
 
-  of_ << cyber::Time::Now().ToNanosecond() << std::endl;
+  if (!binary_) {
+    of_ << cyber::Time::Now().ToNanosecond() << std::endl;
+  }
   of_.flush();
   of_.close();
 }
@@ -80,14 +92,14 @@ void PerfEventCache::AddSchedEvent(const SchedPerf event_id,
     return;
   }
 
-  EventBasePtr e = std::make_shared<SchedEvent>();
-  e->set_eid(static_cast<int>(event_id));
-  e->set_stamp(Time::Now().ToNanosecond());
-  e->set_cr_state(cr_state);
-  e->set_cr_id(cr_id);
-  e->set_proc_id(proc_id);
-
-  event_queue_.Enqueue(e);
+  PerfRecord record;
+  record.eid = static_cast<uint8_t>(event_id);
+  record.etype = static_cast<uint8_t>(EventType::SCHED_EVENT);
+  record.id = cr_id;
+  record.arg0 = 0;
+  record.arg1 = proc_id;
+  record.arg2 = static_cast<int16_t>(cr_state);
+  Enqueue(&record);
 }
 
 void PerfEventCache::AddTransportEvent(const TransPerf event_id,
@@ -97,21 +109,123 @@ void PerfEventCache::AddTransportEvent(const TransPerf event_id,
     return;
   }
 
-  EventBasePtr e = std::make_shared<TransportEvent>();
-  e->set_eid(static_cast<int>(event_id));
-  e->set_channel_id(channel_id);
-  e->set_msg_seq(msg_seq);
-  e->set_stamp(Time::Now().ToNanosecond());
+  PerfRecord record;
+  record.eid = static_cast<uint8_t>(event_id);
+  record.etype = static_cast<uint8_t>(EventType::TRANS_EVENT);
+  record.id = channel_id;
+  record.arg0 = msg_seq;
+  record.arg1 = 0;
+  record.arg2 = 0;
+  Enqueue(&record);
+}
+
+void PerfEventCache::AddTraceEvent(const uint64_t name_id,
+                                   const uint64_t arg0, const int arg1) {
+  if (likely(!enable_trace_perf_)) {
+    return;
+  }
+
+  PerfRecord record;
+  record.eid = 0;
+  record.etype = static_cast<uint8_t>(EventType::TRACE_EVENT);
+  record.id = name_id;
+  record.arg0 = arg0;
+  record.arg1 = arg1;
+  record.arg2 = 0;
+  Enqueue(&record);
+}
+
+uint64_t PerfEventCache::RegisterTraceName(const std::string& name) {
+  uint64_t id = common::Hash(name);
+  std::lock_guard<std::mutex> lock(trace_names_mutex_);
+  trace_names_[id] = name;
+  return id;
+}
+
+void PerfEventCache::Enqueue(PerfRecord* record) {
+  record->stamp = Time::Now().ToNanosecond();
+  event_queue_.Enqueue(*record);
+}
+
+std::string PerfEventCache::EventName(const PerfRecord& record) {
+  switch (static_cast<EventType>(record.etype)) {
+    case EventType::SCHED_EVENT:
+      return common::GlobalData::GetTaskNameById(record.id);
+    case EventType::TRANS_EVENT:
+      return common::GlobalData::GetChannelById(record.id);
+    default: {
+      std::lock_guard<std::mutex> lock(trace_names_mutex_);
+      auto it = trace_names_.find(record.id);
+      return it == trace_names_.end() ? "" : it->second;
+    }
+  }
+}
+
+void PerfEventCache::WriteText(const PerfRecord& record) {
+  switch (static_cast<EventType>(record.etype)) {
+    case EventType::SCHED_EVENT: {
+      SchedEvent e;
+      e.set_eid(record.eid);
+      e.set_stamp(record.stamp);
+      e.set_cr_state(record.arg2);
+      e.set_cr_id(record.id);
+      e.set_proc_id(record.arg1);
+      of_ << e.SerializeToString() << std::endl;
+      break;
+    }
+    case EventType::TRANS_EVENT: {
+      TransportEvent e;
+      e.set_eid(record.eid);
+      e.set_channel_id(record.id);
+      e.set_msg_seq(record.arg0);
+      e.set_stamp(record.stamp);
+      of_ << e.SerializeToString() << std::endl;
+      break;
+    }
+    default: {
+      TraceEvent e;
+      e.set_eid(record.eid);
+      e.set_name(EventName(record));
+      e.set_args(record.arg0, record.arg1);
+      e.set_stamp(record.stamp);
+      of_ << e.SerializeToString() << std::endl;
+      break;
+    }
+  }
+}
 
-  event_queue_.Enqueue(e);
+void PerfEventCache::WriteBinary(const PerfRecord& record) {
+  auto etype = static_cast<EventType>(record.etype);
+  auto& named_ids =
+      named_ids_[etype == EventType::TRACE_EVENT ? 2 : record.etype];
+  if (named_ids.insert(record.id).second) {
+    // names are resolved here once per id instead of once per event
+    std::string name = EventName(record);
+    PerfRecord name_record;
+    std::memset(&name_record, 0, sizeof(name_record));
+    name_record.stamp = record.stamp;
+    name_record.etype = static_cast<uint8_t>(EventType::NAME_EVENT);
+    name_record.id = record.id;
+    name_record.arg0 = name.size();
+    name_record.arg1 = record.etype;
+    of_.write(reinterpret_cast<const char*>(&name_record),
+              sizeof(name_record));
+    name.resize((name.size() + 7) & ~static_cast<size_t>(7), '\0');
+    of_.write(name.data(), name.size());
+  }
+  of_.write(reinterpret_cast<const char*>(&record), sizeof(record));
 }
 
 void PerfEventCache::Run() {
-  EventBasePtr event;
+  PerfRecord record;
   int buf_size = 0;
   while (!shutdown_ && !apollo::cyber::IsShutdown()) {
-    if (event_queue_.WaitDequeue(&event)) {
-      of_ << event->SerializeToString() << std::endl;
+    if (event_queue_.WaitDequeue(&record)) {
+      if (binary_) {
+        WriteBinary(record);
+      } else {
+        WriteText(record);
+      }
       buf_size++;
       if (buf_size >= kFlushSize) {
         of_.flush();
@@ -123,9 +237,17 @@ void PerfEventCache::Run() {
 
 void PerfEventCache::Start() {
   auto now = Time::Now();
-  std::string perf_file = "cyber_perf_" + now.ToString() + ".data";
-  of_.open(perf_file, std::ios::trunc);
-  of_ << Time::Now().ToNanosecond() << std::endl;
+  if (binary_) {
+    std::string perf_file = "cyber_perf_" + now.ToString() + ".bin";
+    of_.open(perf_file, std::ios::trunc | std::ios::binary);
+    uint64_t stamp = now.ToNanosecond();
+    of_.write(kPerfBinaryMagic, sizeof(kPerfBinaryMagic));
+    of_.write(reinterpret_cast<const char*>(&stamp), sizeof(stamp));
+  } else {
+    std::string perf_file = "cyber_perf_" + now.ToString() + ".data";
+    of_.open(perf_file, std::ios::trunc);
+    of_ << Time::Now().ToNanosecond() << std::endl;
+  }
   io_thread_ = std::thread(&PerfEventCache::Run, this);
 }
 
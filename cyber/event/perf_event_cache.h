@@ -20,7 +20,11 @@
 #include <chrono>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "cyber/base/bounded_queue.h"
 #include "cyber/common/macros.h"
@@ -30,28 +34,55 @@ namespace apollo {
 namespace cyber {
 namespace event {
 
+// Records a trace point with two integer args when cyber_trace_perf is set.
+// The name is registered once per call site and only written out once.
+#define CYBER_TRACE_EVENT(name, arg0, arg1)                               \
+  do {                                                                    \
+    static const uint64_t cyber_trace_id =                                \
+        ::apollo::cyber::event::PerfEventCache::Instance()                \
+            ->RegisterTraceName(name);                                    \
+    ::apollo::cyber::event::PerfEventCache::Instance()->AddTraceEvent(    \
+        cyber_trace_id, (arg0), (arg1));                                  \
+  } while (0)
+
+// Collects perf events and writes them out from a separate thread, either as
+// text lines or, with cyber_perf_format=binary, as fixed size records that
+// are formatted offline, see ConvertPerfToChromeTrace().
 class PerfEventCache {
  public:
-  using EventBasePtr = std::shared_ptr<EventBase>;
-
   ~PerfEventCache();
   void AddSchedEvent(const SchedPerf event_id, const uint64_t cr_id,
                      const int proc_id, const int cr_state = -1);
   void AddTransportEvent(const TransPerf event_id, const uint64_t channel_id,
                          const uint64_t msg_seq);
+  void AddTraceEvent(const uint64_t name_id, const uint64_t arg0,
+                     const int arg1);
+
+  uint64_t RegisterTraceName(const std::string& name);
 
  private:
   void Start();
   void Run();
+  void Enqueue(PerfRecord* record);
+  void WriteText(const PerfRecord& record);
+  void WriteBinary(const PerfRecord& record);
+  std::string EventName(const PerfRecord& record);
 
   std::thread io_thread_;
   std::ofstream of_;
 
   bool enable_trans_perf_ = false;
   bool enable_sched_perf_ = false;
+  bool enable_trace_perf_ = false;
+  bool binary_ = false;
   std::atomic<bool> shutdown_ = {false};
 
-  base::BoundedQueue<EventBasePtr> event_queue_;
+  base::BoundedQueue<PerfRecord> event_queue_;
+
+  std::mutex trace_names_mutex_;
+  std::unordered_map<uint64_t, std::string> trace_names_;
+  // ids already named in the binary file, by sched, transport and trace
+  std::unordered_set<uint64_t> named_ids_[3];
 
   const int kFlushSize = 512;
   const uint64_t kEventQueueSize = 8192;
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/event/perf_event_converter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/common/log.h"
+#include "cyber/event/perf_event.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+namespace {
+
+// trace processes, one per kind of event
+const int kSchedPid = 0;
+const int kTransportPid = 1;
+const int kTracePid = 2;
+
+std::string Escape(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      escaped += buf;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+const char* SchedEventName(int eid) {
+  switch (static_cast<SchedPerf>(eid)) {
+    case SchedPerf::NOTIFY_IN:
+      return "notify_in";
+    case SchedPerf::NEXT_RT:
+      return "next_routine";
+    case SchedPerf::RT_CREATE:
+      return "create";
+    default:
+      return "unknown";
+  }
+}
+
+const char* TransportEventName(int eid) {
+  switch (static_cast<TransPerf>(eid)) {
+    case TransPerf::TRANS_FROM:
+      return "trans_from";
+    case TransPerf::TRANS_TO:
+      return "trans_to";
+    case TransPerf::WRITE_NOTIFY:
+      return "write_notify";
+    default:
+      return "unknown";
+  }
+}
+
+class TraceWriter {
+ public:
+  TraceWriter(std::ostream* out, uint64_t start) : out_(out), start_(start) {
+    *out_ << "{\"traceEvents\":[";
+    Metadata(kSchedPid, "sched");
+    Metadata(kTransportPid, "transport");
+    Metadata(kTracePid, "trace");
+  }
+
+  ~TraceWriter() { *out_ << "\n]}\n"; }
+
+  // Opens an event and writes the fields common to all of them, the caller
+  // adds the rest and closes it.
+  std::ostream& Begin(const std::string& name, const char* phase,
+                      uint64_t stamp, int pid, int tid) {
+    char ts[32];
+    double us = stamp > start_ ? static_cast<double>(stamp - start_) / 1000
+                               : 0.0;
+    snprintf(ts, sizeof(ts), "%.3f", us);
+    *out_ << ",\n{\"name\":\"" << Escape(name) << "\",\"ph\":\"" << phase
+          << "\",\"ts\":" << ts << ",\"pid\":" << pid << ",\"tid\":" << tid;
+    return *out_;
+  }
+
+ private:
+  void Metadata(int pid, const char* name) {
+    *out_ << (pid == kSchedPid ? "\n" : ",\n")
+          << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+          << ",\"args\":{\"name\":\"" << name << "\"}}";
+  }
+
+  std::ostream* out_;
+  uint64_t start_;
+};
+
+}  // namespace
+
+bool ConvertPerfToChromeTrace(std::istream* in, std::ostream* out) {
+  char magic[sizeof(kPerfBinaryMagic)];
+  uint64_t start = 0;
+  in->read(magic, sizeof(magic));
+  in->read(reinterpret_cast<char*>(&start), sizeof(start));
+  if (!*in || std::memcmp(magic, kPerfBinaryMagic, sizeof(magic)) != 0) {
+    AERROR << "not a binary perf file.";
+    return false;
+  }
+
+  // names by event type and id
+  std::unordered_map<uint64_t, std::string> names[3];
+  auto name_of = [&names](uint64_t id, int idx) -> std::string {
+    auto it = names[idx].find(id);
+    if (it == names[idx].end() || it->second.empty()) {
+      return std::to_string(id);
+    }
+    return it->second;
+  };
+
+  TraceWriter writer(out, start);
+  PerfRecord record;
+  while (in->read(reinterpret_cast<char*>(&record), sizeof(record))) {
+    switch (static_cast<EventType>(record.etype)) {
+      case EventType::NAME_EVENT: {
+        std::string name((record.arg0 + 7) & ~static_cast<uint64_t>(7), '\0');
+        if (!in->read(&name[0], name.size())) {
+          AERROR << "truncated perf file.";
+          return false;
+        }
+        name.resize(record.arg0);
+        auto etype = static_cast<EventType>(record.arg1);
+        if (etype == EventType::SCHED_EVENT) {
+          names[0][record.id] = name;
+        } else if (etype == EventType::TRANS_EVENT) {
+          names[1][record.id] = name;
+        } else {
+          names[2][record.id] = name;
+        }
+        break;
+      }
+      case EventType::SCHED_EVENT: {
+        auto name = name_of(record.id, 0);
+        auto eid = static_cast<SchedPerf>(record.eid);
+        if (eid == SchedPerf::SWAP_IN || eid == SchedPerf::SWAP_OUT) {
+          // a coroutine runs between swapping in and out of its processor
+          writer.Begin(name, eid == SchedPerf::SWAP_IN ? "B" : "E",
+                       record.stamp, kSchedPid, record.arg1)
+              << ",\"args\":{\"state\":" << record.arg2 << "}}";
+        } else {
+          writer.Begin(name + " " + SchedEventName(record.eid), "i",
+                       record.stamp, kSchedPid, record.arg1)
+              << ",\"s\":\"t\",\"args\":{\"state\":" << record.arg2 << "}}";
+        }
+        break;
+      }
+      case EventType::TRANS_EVENT:
+        writer.Begin(name_of(record.id, 1) + " " +
+                         TransportEventName(record.eid),
+                     "i", record.stamp, kTransportPid, 0)
+            << ",\"s\":\"t\",\"args\":{\"seq\":" << record.arg0 << "}}";
+        break;
+      case EventType::TRACE_EVENT:
+        writer.Begin(name_of(record.id, 2), "i", record.stamp, kTracePid, 0)
+            << ",\"s\":\"t\",\"args\":{\"arg0\":" << record.arg0
+            << ",\"arg1\":" << record.arg1 << "}}";
+        break;
+      default:
+        AWARN << "skip perf event of unknown type "
+              << static_cast<int>(record.etype);
+        break;
+    }
+  }
+  if (in->gcount() != 0) {
+    AERROR << "truncated perf file.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
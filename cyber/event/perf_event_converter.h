@@ -0,0 +1,39 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_EVENT_PERF_EVENT_CONVERTER_H_
+#define CYBER_EVENT_PERF_EVENT_CONVERTER_H_
+
+#include <istream>
+#include <ostream>
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Converts a binary perf file, written with cyber_perf_format=binary, into
+// the JSON trace event format loaded by chrome://tracing and Perfetto.
+// Coroutines run as slices on the track of their processor, transport and
+// trace events are instants. Returns false if 'in' is not a perf file or is
+// truncated, what was converted so far is still a valid trace.
+bool ConvertPerfToChromeTrace(std::istream* in, std::ostream* out);
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_PERF_EVENT_CONVERTER_H_
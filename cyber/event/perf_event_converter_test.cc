@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/event/perf_event_converter.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "cyber/event/perf_event.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+namespace {
+
+void WriteRecord(std::ostream* out, EventType etype, int eid, uint64_t stamp,
+                 uint64_t id, uint64_t arg0, int arg1) {
+  PerfRecord record;
+  std::memset(&record, 0, sizeof(record));
+  record.etype = static_cast<uint8_t>(etype);
+  record.eid = static_cast<uint8_t>(eid);
+  record.stamp = stamp;
+  record.id = id;
+  record.arg0 = arg0;
+  record.arg1 = arg1;
+  out->write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+void WriteName(std::ostream* out, EventType etype, uint64_t id,
+               std::string name) {
+  WriteRecord(out, EventType::NAME_EVENT, 0, 0, id, name.size(),
+              static_cast<int>(etype));
+  name.resize((name.size() + 7) & ~static_cast<size_t>(7), '\0');
+  out->write(name.data(), name.size());
+}
+
+std::string Header(uint64_t start) {
+  std::string header(kPerfBinaryMagic, sizeof(kPerfBinaryMagic));
+  header.append(reinterpret_cast<const char*>(&start), sizeof(start));
+  return header;
+}
+
+}  // namespace
+
+TEST(PerfEventConverterTest, convert) {
+  std::stringstream in;
+  in << Header(1000000);
+  WriteName(&in, EventType::SCHED_EVENT, 7, "planning");
+  WriteRecord(&in, EventType::SCHED_EVENT,
+              static_cast<int>(SchedPerf::SWAP_IN), 1002000, 7, 0, 3);
+  WriteRecord(&in, EventType::SCHED_EVENT,
+              static_cast<int>(SchedPerf::SWAP_OUT), 1005500, 7, 0, 3);
+  WriteName(&in, EventType::TRANS_EVENT, 9, "/apollo/\"chassis\"");
+  WriteRecord(&in, EventType::TRANS_EVENT,
+              static_cast<int>(TransPerf::TRANS_FROM), 1006000, 9, 42, 0);
+  WriteName(&in, EventType::TRACE_EVENT, 11, "fusion");
+  WriteRecord(&in, EventType::TRACE_EVENT, 0, 1007000, 11, 5, -1);
+
+  std::stringstream out;
+  EXPECT_TRUE(ConvertPerfToChromeTrace(&in, &out));
+  std::string trace = out.str();
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+  EXPECT_NE(trace.find("{\"name\":\"planning\",\"ph\":\"B\",\"ts\":2.000,"
+                       "\"pid\":0,\"tid\":3"),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"planning\",\"ph\":\"E\",\"ts\":5.500,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"/apollo/\\\"chassis\\\" trans_from\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"seq\":42}"), std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"arg0\":5,\"arg1\":-1}"),
+            std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+TEST(PerfEventConverterTest, bad_input) {
+  std::stringstream not_perf("cyber perf text file");
+  std::stringstream out;
+  EXPECT_FALSE(ConvertPerfToChromeTrace(&not_perf, &out));
+
+  std::stringstream truncated;
+  truncated << Header(0);
+  WriteRecord(&truncated, EventType::TRACE_EVENT, 0, 1, 11, 0, 0);
+  truncated.write("\0\0\0", 3);
+  EXPECT_FALSE(ConvertPerfToChromeTrace(&truncated, &out));
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
@@ -31,6 +31,8 @@
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/event/perf_event_cache.h"
 #include "cyber/logger/async_logger.h"
+#include "cyber/node/channel_stats_reporter.h"
+#include "cyber/node/latency_reporter.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
 #include "cyber/task/task.h"
@@ -113,6 +115,8 @@ bool Init(const char* binary_name) {
     g_atexit_registered = true;
   }
   SetState(STATE_INITIALIZED);
+  LatencyReporter::Instance()->Start();
+  ChannelStatsReporter::Instance()->Start();
   return true;
 }
 
@@ -121,6 +125,8 @@ void Clear() {
   if (GetState() == STATE_SHUTDOWN || GetState() == STATE_UNINITIALIZED) {
     return;
   }
+  ChannelStatsReporter::CleanUp();
+  LatencyReporter::CleanUp();
   TaskManager::CleanUp();
   TimerManager::CleanUp();
   scheduler::CleanUp();
@@ -15,12 +15,47 @@
  *****************************************************************************/
 
 #include "cyber/io/session.h"
+
+#include <poll.h>
+
+#include <cstdlib>
+#include <string>
+
 #include "cyber/common/log.h"
+#include "cyber/io/uring_poller.h"
 
 namespace apollo {
 namespace cyber {
 namespace io {
 
+namespace {
+
+bool UseUring() {
+  static const bool use_uring = [] {
+    const char *backend = ::getenv("CYBER_IO_BACKEND");
+    if (backend == nullptr || std::string(backend) != "io_uring") {
+      return false;
+    }
+    if (!UringPoller::Instance()->IsAvailable()) {
+      AWARN << "io_uring is unavailable, falling back to epoll.";
+      return false;
+    }
+    return true;
+  }();
+  return use_uring;
+}
+
+// io_uring results carry the negated errno
+ssize_t SetErrno(ssize_t result) {
+  if (result < 0) {
+    errno = static_cast<int>(-result);
+    return -1;
+  }
+  return result;
+}
+
+}  // namespace
+
 Session::Session() : Session(-1) {}
 
 Session::Session(int fd) : fd_(fd), poll_handler_(nullptr) {
@@ -55,7 +90,7 @@ auto Session::Accept(struct sockaddr *addr, socklen_t *addrlen) -> SessionPtr {
 
   int sock_fd = accept4(fd_, addr, addrlen, SOCK_NONBLOCK);
   while (sock_fd == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    poll_handler_->Block(-1, true);
+    Block(-1, true);
     sock_fd = accept4(fd_, addr, addrlen, SOCK_NONBLOCK);
   }
 
@@ -73,7 +108,7 @@ int Session::Connect(const struct sockaddr *addr, socklen_t addrlen) {
   socklen_t optlen = sizeof(optval);
   int res = connect(fd_, addr, addrlen);
   if (res == -1 && errno == EINPROGRESS) {
-    poll_handler_->Block(-1, false);
+    Block(-1, false);
     getsockopt(fd_, SOL_SOCKET, SO_ERROR, reinterpret_cast<void *>(&optval),
                &optlen);
     if (optval == 0) {
@@ -88,7 +123,9 @@ int Session::Connect(const struct sockaddr *addr, socklen_t addrlen) {
 int Session::Close() {
   ACHECK(fd_ != -1);
 
-  poll_handler_->Unblock();
+  if (!UseUring()) {
+    poll_handler_->Unblock();
+  }
   int res = close(fd_);
   fd_ = -1;
   return res;
@@ -104,7 +141,7 @@ ssize_t Session::Recv(void *buf, size_t len, int flags, int timeout_ms) {
   }
 
   while (nbytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, true)) {
+    if (Block(timeout_ms, true)) {
       nbytes = recv(fd_, buf, len, flags);
     }
     if (timeout_ms > 0) {
@@ -126,7 +163,7 @@ ssize_t Session::RecvFrom(void *buf, size_t len, int flags,
   }
 
   while (nbytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, true)) {
+    if (Block(timeout_ms, true)) {
       nbytes = recvfrom(fd_, buf, len, flags, src_addr, addrlen);
     }
     if (timeout_ms > 0) {
@@ -146,7 +183,7 @@ ssize_t Session::Send(const void *buf, size_t len, int flags, int timeout_ms) {
   }
 
   while ((nbytes == -1) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, false)) {
+    if (Block(timeout_ms, false)) {
       nbytes = send(fd_, buf, len, flags);
     }
     if (timeout_ms > 0) {
@@ -169,7 +206,7 @@ ssize_t Session::SendTo(const void *buf, size_t len, int flags,
   }
 
   while ((nbytes == -1) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, false)) {
+    if (Block(timeout_ms, false)) {
       nbytes = sendto(fd_, buf, len, flags, dest_addr, addrlen);
     }
     if (timeout_ms > 0) {
@@ -189,7 +226,7 @@ ssize_t Session::Read(void *buf, size_t count, int timeout_ms) {
   }
 
   while ((nbytes == -1) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, true)) {
+    if (Block(timeout_ms, true)) {
       nbytes = read(fd_, buf, count);
     }
     if (timeout_ms > 0) {
@@ -209,7 +246,7 @@ ssize_t Session::Write(const void *buf, size_t count, int timeout_ms) {
   }
 
   while ((nbytes == -1) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-    if (poll_handler_->Block(timeout_ms, false)) {
+    if (Block(timeout_ms, false)) {
       nbytes = write(fd_, buf, count);
     }
     if (timeout_ms > 0) {
@@ -219,6 +256,49 @@ ssize_t Session::Write(const void *buf, size_t count, int timeout_ms) {
   return nbytes;
 }
 
+ssize_t Session::ReadFixed(void *buf, size_t count, int buf_index,
+                           int timeout_ms) {
+  ACHECK(buf != nullptr);
+  ACHECK(fd_ != -1);
+
+  if (UseUring()) {
+    // the kernel waits for the fd itself
+    ssize_t res = UringPoller::Instance()->ReadFixed(fd_, buf, count,
+                                                     buf_index, timeout_ms);
+    if (res != -EBUSY) {
+      return SetErrno(res);
+    }
+  }
+  return Read(buf, count, timeout_ms);
+}
+
+ssize_t Session::WriteFixed(const void *buf, size_t count, int buf_index,
+                            int timeout_ms) {
+  ACHECK(buf != nullptr);
+  ACHECK(fd_ != -1);
+
+  if (UseUring()) {
+    ssize_t res = UringPoller::Instance()->WriteFixed(fd_, buf, count,
+                                                      buf_index, timeout_ms);
+    if (res != -EBUSY) {
+      return SetErrno(res);
+    }
+  }
+  return Write(buf, count, timeout_ms);
+}
+
+bool Session::Block(int timeout_ms, bool is_read) {
+  if (UseUring() && timeout_ms != 0) {
+    uint32_t target_events = is_read ? POLLIN : POLLOUT;
+    int events = UringPoller::Instance()->Poll(fd_, target_events, timeout_ms);
+    // a full submission ring waits on epoll instead
+    if (events != -EBUSY) {
+      return events > 0 && (events & target_events) != 0;
+    }
+  }
+  return poll_handler_->Block(timeout_ms, is_read);
+}
+
 }  // namespace io
 }  // namespace cyber
 }  // namespace apollo
@@ -60,6 +60,14 @@ class Session {
   ssize_t Read(void *buf, size_t count, int timeout_ms = -1);
   ssize_t Write(const void *buf, size_t count, int timeout_ms = -1);
 
+  // Read and Write on buf inside the buffer buf_index registered with
+  // UringPoller::RegisterBuffers, so the kernel needs not map its pages
+  // again for every operation. Plain Read and Write with the epoll backend.
+  ssize_t ReadFixed(void *buf, size_t count, int buf_index,
+                    int timeout_ms = -1);
+  ssize_t WriteFixed(const void *buf, size_t count, int buf_index,
+                     int timeout_ms = -1);
+
   int fd() const { return fd_; }
 
  private:
@@ -68,6 +76,9 @@ class Session {
     poll_handler_->set_fd(fd);
   }
 
+  // Waits with the backend CYBER_IO_BACKEND selects, epoll by default.
+  bool Block(int timeout_ms, bool is_read);
+
   int fd_;
   PollHandlerPtr poll_handler_;
 };
@@ -0,0 +1,392 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/io/uring_poller.h"
+
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "cyber/common/log.h"
+#include "cyber/scheduler/scheduler_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+using croutine::CRoutine;
+using croutine::RoutineState;
+
+namespace {
+
+// how long the kernel submission thread spins before it sleeps
+const unsigned kSqThreadIdleMs = 10;
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+UringPoller::UringPoller() {
+  if (!Init()) {
+    AERROR << "UringPoller init failed!";
+    Clear();
+  }
+}
+
+UringPoller::~UringPoller() { Shutdown(); }
+
+void UringPoller::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  // wake up the reaping thread
+  struct io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_NOP;
+  if (Push(sqe, nullptr, -1)) {
+    Submit();
+  }
+  Clear();
+}
+
+int UringPoller::Poll(int fd, uint32_t events, int timeout_ms) {
+  struct io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_POLL_ADD;
+  sqe.fd = fd;
+  sqe.poll32_events = events;
+  int result = Execute(&sqe, timeout_ms);
+  // the linked timeout fired
+  if (result == -ECANCELED) {
+    return 0;
+  }
+  return result;
+}
+
+bool UringPoller::RegisterBuffers(const std::vector<struct iovec>& buffers) {
+  if (is_shutdown_.load()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(buffers_mutex_);
+  if (has_buffers_) {
+    if (syscall(__NR_io_uring_register, ring_fd_, IORING_UNREGISTER_BUFFERS,
+                nullptr, 0) != 0) {
+      AERROR << "unregister buffers failed, " << strerror(errno);
+      return false;
+    }
+    has_buffers_ = false;
+  }
+
+  if (buffers.empty()) {
+    return true;
+  }
+  if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+              buffers.data(), buffers.size()) != 0) {
+    AERROR << "register buffers failed, " << strerror(errno);
+    return false;
+  }
+  has_buffers_ = true;
+  return true;
+}
+
+ssize_t UringPoller::ReadFixed(int fd, void* buf, size_t count,
+                               int buf_index, int timeout_ms) {
+  struct io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_READ_FIXED;
+  sqe.fd = fd;
+  if (timeout_ms == 0) {
+    sqe.rw_flags = RWF_NOWAIT;
+  }
+  sqe.addr = reinterpret_cast<uint64_t>(buf);
+  sqe.len = static_cast<uint32_t>(count);
+  // the current file position, as read(2)
+  sqe.off = static_cast<uint64_t>(-1);
+  sqe.buf_index = static_cast<uint16_t>(buf_index);
+  int result = Execute(&sqe, timeout_ms);
+  return result == -ECANCELED ? -EAGAIN : result;
+}
+
+ssize_t UringPoller::WriteFixed(int fd, const void* buf, size_t count,
+                                int buf_index, int timeout_ms) {
+  struct io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_WRITE_FIXED;
+  sqe.fd = fd;
+  if (timeout_ms == 0) {
+    sqe.rw_flags = RWF_NOWAIT;
+  }
+  sqe.addr = reinterpret_cast<uint64_t>(buf);
+  sqe.len = static_cast<uint32_t>(count);
+  sqe.off = static_cast<uint64_t>(-1);
+  sqe.buf_index = static_cast<uint16_t>(buf_index);
+  int result = Execute(&sqe, timeout_ms);
+  return result == -ECANCELED ? -EAGAIN : result;
+}
+
+bool UringPoller::Init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const char* sq_poll = ::getenv("CYBER_IO_URING_SQPOLL");
+  if (sq_poll != nullptr && std::string(sq_poll) == "1") {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = kSqThreadIdleMs;
+  }
+
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, kRingSize, &params));
+  if (ring_fd_ < 0) {
+    AERROR << "io_uring setup failed, " << strerror(errno);
+    return false;
+  }
+  sq_poll_ = (params.flags & IORING_SETUP_SQPOLL) != 0;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    AERROR << "mmap submission ring failed, " << strerror(errno);
+    return false;
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      AERROR << "mmap completion ring failed, " << strerror(errno);
+      return false;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    AERROR << "mmap submission entries failed, " << strerror(errno);
+    return false;
+  }
+  sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+  sq_head_ = RingField<unsigned>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_flags_ = RingField<unsigned>(sq_ring_, params.sq_off.flags);
+  sq_array_ = RingField<unsigned>(sq_ring_, params.sq_off.array);
+  sq_mask_ = *RingField<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  cq_head_ = RingField<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<unsigned>(cq_ring_, params.cq_off.tail);
+  cqes_ = RingField<struct io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  cq_mask_ = *RingField<unsigned>(cq_ring_, params.cq_off.ring_mask);
+
+  is_shutdown_.exchange(false);
+  thread_ = std::thread(&UringPoller::ThreadFunc, this);
+  scheduler::Instance()->SetInnerThreadAttr(&thread_, "io_uring_poller");
+  return true;
+}
+
+void UringPoller::Clear() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  cq_ring_ = nullptr;
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = nullptr;
+  }
+
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+void UringPoller::ThreadFunc() {
+  // block all signals in this thread
+  sigset_t signal_set;
+  sigfillset(&signal_set);
+  pthread_sigmask(SIG_BLOCK, &signal_set, NULL);
+
+  while (!is_shutdown_.load()) {
+    Enter(0, 1, IORING_ENTER_GETEVENTS);
+    Reap();
+    // retries what a full completion ring made the kernel refuse
+    Submit();
+  }
+}
+
+int UringPoller::Execute(struct io_uring_sqe* sqe, int timeout_ms) {
+  if (is_shutdown_.load()) {
+    return -ESHUTDOWN;
+  }
+
+  Operation op;
+  op.routine = CRoutine::GetCurrentRoutine();
+  if (!Push(*sqe, &op, timeout_ms)) {
+    return -EBUSY;
+  }
+  Submit();
+
+  if (op.routine != nullptr) {
+    while (!op.done.load(std::memory_order_acquire)) {
+      CRoutine::Yield(RoutineState::IO_WAIT);
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(op.mutex);
+    op.cv.wait(lock, [&op] { return op.done.load(); });
+  }
+  return op.result;
+}
+
+bool UringPoller::Push(const struct io_uring_sqe& sqe, Operation* op,
+                       int timeout_ms) {
+  unsigned count = timeout_ms > 0 ? 2 : 1;
+  std::lock_guard<std::mutex> lock(sq_mutex_);
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  unsigned tail = *sq_tail_;
+  if (tail + count - head > sq_entries_) {
+    AWARN << "io_uring submission ring is full.";
+    return false;
+  }
+
+  unsigned index = tail & sq_mask_;
+  sqes_[index] = sqe;
+  sqes_[index].user_data = reinterpret_cast<uint64_t>(op);
+  sq_array_[index] = index;
+  if (timeout_ms > 0) {
+    // cancels the operation when it is not done in time
+    sqes_[index].flags |= IOSQE_IO_LINK;
+    op->timeout.tv_sec = timeout_ms / 1000;
+    op->timeout.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    index = (tail + 1) & sq_mask_;
+    memset(&sqes_[index], 0, sizeof(sqes_[index]));
+    sqes_[index].opcode = IORING_OP_LINK_TIMEOUT;
+    sqes_[index].fd = -1;
+    sqes_[index].addr = reinterpret_cast<uint64_t>(&op->timeout);
+    sqes_[index].len = 1;
+    sq_array_[index] = index;
+  }
+  __atomic_store_n(sq_tail_, tail + count, __ATOMIC_RELEASE);
+  to_submit_ += count;
+  return true;
+}
+
+void UringPoller::Submit() {
+  if (sq_poll_) {
+    // the tail store must be visible before the flag is read
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP) {
+      Enter(0, 0, IORING_ENTER_SQ_WAKEUP);
+    }
+    return;
+  }
+
+  // The first thread in submits for all which queue while it is in the
+  // kernel, so concurrent operations share io_uring_enter calls.
+  std::unique_lock<std::mutex> lock(sq_mutex_);
+  if (submitting_) {
+    return;
+  }
+  submitting_ = true;
+  while (to_submit_ > 0) {
+    unsigned count = to_submit_;
+    to_submit_ = 0;
+    lock.unlock();
+    int submitted = Enter(count, 0, 0);
+    lock.lock();
+    if (submitted < 0) {
+      submitted = 0;
+    }
+    if (static_cast<unsigned>(submitted) < count) {
+      to_submit_ += count - submitted;
+      if (submitted == 0) {
+        break;
+      }
+    }
+  }
+  submitting_ = false;
+}
+
+void UringPoller::Reap() {
+  unsigned head = *cq_head_;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    // linked timeouts and wake ups carry no operation
+    auto op = reinterpret_cast<Operation*>(cqe.user_data);
+    if (op != nullptr) {
+      Complete(op, cqe.res);
+    }
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
+
+void UringPoller::Complete(Operation* op, int result) {
+  op->result = result;
+  // op lives on the stack of its waiter, which may return as soon as done
+  // is set
+  CRoutine* routine = op->routine;
+  if (routine != nullptr) {
+    op->done.store(true, std::memory_order_release);
+    routine->SetUpdateFlag();
+    scheduler::Instance()->NotifyTask(routine->id());
+  } else {
+    std::lock_guard<std::mutex> lock(op->mutex);
+    op->done.store(true);
+    op->cv.notify_one();
+  }
+}
+
+int UringPoller::Enter(unsigned to_submit, unsigned min_complete,
+                       unsigned flags) {
+  int res = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit,
+                                     min_complete, flags, nullptr, 0));
+  if (res < 0 && errno != EINTR) {
+    AERROR << "io_uring enter failed, " << strerror(errno);
+  }
+  return res;
+}
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
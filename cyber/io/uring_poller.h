@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_IO_URING_POLLER_H_
+#define CYBER_IO_URING_POLLER_H_
+
+#include <linux/io_uring.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "cyber/croutine/croutine.h"
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+// An io_uring counterpart of Poller, used by Session when CYBER_IO_BACKEND
+// is "io_uring". Operations are queued on the submission ring and handed to
+// the kernel by whichever thread finds no submission in progress, so the
+// operations of many sessions go in one io_uring_enter; with
+// CYBER_IO_URING_SQPOLL=1 a kernel thread picks them up and submitting takes
+// no syscall at all. One thread reaps the completions in batches and resumes
+// the croutines waiting on them, threads which are not croutines wait on a
+// condition variable.
+//
+// Results are those of the syscalls, negated errno on failure.
+class UringPoller {
+ public:
+  virtual ~UringPoller();
+
+  void Shutdown();
+
+  // Whether the ring was set up, false on kernels without io_uring.
+  bool IsAvailable() const { return !is_shutdown_.load(); }
+
+  // Waits until fd has one of the poll(2) events, returns those it has, 0
+  // when timeout_ms (> 0) passes first, -EBUSY when the submission ring is
+  // full.
+  int Poll(int fd, uint32_t events, int timeout_ms);
+
+  // Registers the buffers of ReadFixed and WriteFixed, replacing those
+  // registered before. The kernel pins them once instead of mapping the
+  // pages of every operation.
+  bool RegisterBuffers(const std::vector<struct iovec>& buffers);
+
+  // Like read(2) and write(2) with buf inside the registered buffer
+  // buf_index, and the timeout of Session: the kernel waits until the fd is
+  // ready, -EAGAIN when timeout_ms (> 0) passes first or, for 0, right
+  // away.
+  ssize_t ReadFixed(int fd, void* buf, size_t count, int buf_index,
+                    int timeout_ms);
+  ssize_t WriteFixed(int fd, const void* buf, size_t count, int buf_index,
+                     int timeout_ms);
+
+ private:
+  struct Operation {
+    croutine::CRoutine* routine = nullptr;
+    struct __kernel_timespec timeout;
+    int result = 0;
+    std::atomic<bool> done = {false};
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+
+  bool Init();
+  void Clear();
+  void ThreadFunc();
+  int Execute(struct io_uring_sqe* sqe, int timeout_ms);
+  bool Push(const struct io_uring_sqe& sqe, Operation* op, int timeout_ms);
+  void Submit();
+  void Reap();
+  static void Complete(Operation* op, int result);
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+
+  int ring_fd_ = -1;
+  bool sq_poll_ = false;
+  std::thread thread_;
+  std::atomic<bool> is_shutdown_ = {true};
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_flags_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  struct io_uring_cqe* cqes_ = nullptr;
+  unsigned cq_mask_ = 0;
+
+  // guards the submission ring, to_submit_ and submitting_
+  std::mutex sq_mutex_;
+  // queued on the ring, not yet passed to io_uring_enter
+  unsigned to_submit_ = 0;
+  bool submitting_ = false;
+
+  std::mutex buffers_mutex_;
+  bool has_buffers_ = false;
+
+  const unsigned kRingSize = 256;
+
+  DECLARE_SINGLETON(UringPoller)
+};
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_IO_URING_POLLER_H_
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/io/uring_poller.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+TEST(UringPollerTest, operation) {
+  auto poller = UringPoller::Instance();
+  ASSERT_NE(poller, nullptr);
+  // kernels without io_uring leave Session on epoll
+  if (!poller->IsAvailable()) {
+    return;
+  }
+
+  int pipe_fd[2] = {-1, -1};
+  ASSERT_EQ(pipe(pipe_fd), 0);
+  ASSERT_EQ(fcntl(pipe_fd[0], F_SETFL, O_NONBLOCK), 0);
+  ASSERT_EQ(fcntl(pipe_fd[1], F_SETFL, O_NONBLOCK), 0);
+
+  // nothing to read, times out
+  EXPECT_EQ(poller->Poll(pipe_fd[0], POLLIN, 50), 0);
+  EXPECT_NE(poller->Poll(pipe_fd[1], POLLOUT, 50) & POLLOUT, 0);
+
+  // many waiters, one write wakes them all
+  std::vector<std::thread> threads;
+  std::vector<int> events(8, 0);
+  for (size_t i = 0; i < events.size(); ++i) {
+    threads.emplace_back([poller, &pipe_fd, &events, i] {
+      events[i] = poller->Poll(pipe_fd[0], POLLIN, 1000);
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  char msg = 'C';
+  ASSERT_EQ(write(pipe_fd[1], &msg, 1), 1);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int event : events) {
+    EXPECT_NE(event & POLLIN, 0);
+  }
+  ASSERT_EQ(read(pipe_fd[0], &msg, 1), 1);
+
+  // registered buffers
+  char buffer[64];
+  std::vector<struct iovec> buffers(1);
+  buffers[0].iov_base = buffer;
+  buffers[0].iov_len = sizeof(buffer);
+  ASSERT_TRUE(poller->RegisterBuffers(buffers));
+  EXPECT_EQ(poller->ReadFixed(pipe_fd[0], buffer, 16, 0, 0), -EAGAIN);
+  EXPECT_EQ(poller->ReadFixed(pipe_fd[0], buffer, 16, 0, 50), -EAGAIN);
+  std::strcpy(buffer, "hello");
+  EXPECT_EQ(poller->WriteFixed(pipe_fd[1], buffer, 5, 0, -1), 5);
+  std::memset(buffer, 0, sizeof(buffer));
+  EXPECT_EQ(poller->ReadFixed(pipe_fd[0], buffer + 8, 16, 0, -1), 5);
+  EXPECT_STREQ(buffer + 8, "hello");
+  // outside of the registered buffer
+  EXPECT_LT(poller->ReadFixed(pipe_fd[0], &msg, 1, 0, -1), 0);
+  EXPECT_TRUE(poller->RegisterBuffers({}));
+
+  poller->Shutdown();
+  EXPECT_FALSE(poller->IsAvailable());
+  EXPECT_EQ(poller->Poll(pipe_fd[0], POLLIN, 50), -ESHUTDOWN);
+  EXPECT_FALSE(poller->RegisterBuffers(buffers));
+
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+}
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,7 +16,11 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <limits.h>
 #include <stdlib.h>
+
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -32,14 +36,45 @@ namespace logger {
 
 static std::unordered_map<std::string, LogFileObject*> moduleLoggerMap;
 
+namespace {
+
+std::atomic<uint64_t> next_logger_id = {1};
+
+inline uint32_t AlignRecord(size_t size) {
+  return static_cast<uint32_t>((size + 7) & ~static_cast<size_t>(7));
+}
+
+inline int8_t LogLevel(char severity) {
+  switch (severity) {
+    case 'F':
+      return 3;
+    case 'E':
+      return 2;
+    case 'W':
+      return 1;
+    case 'I':
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+}  // namespace
+
+AsyncLogger::LocalRing::~LocalRing() {
+  if (buffer) {
+    buffer->closed.store(true);
+  }
+}
+
 AsyncLogger::AsyncLogger(google::base::Logger* wrapped, int max_buffer_bytes)
-    : max_buffer_bytes_(max_buffer_bytes),
-      wrapped_(wrapped),
-      active_buf_(new Buffer()),
-      flushing_buf_(new Buffer()) {
-  if (max_buffer_bytes_ <= 0) {
-    max_buffer_bytes_ = 2 * 1024 * 1024;
+    : id_(next_logger_id.fetch_add(1)), wrapped_(wrapped) {
+  if (max_buffer_bytes <= 0) {
+    max_buffer_bytes = 2 * 1024 * 1024;
   }
+  thread_buffer_bytes_ =
+      std::max<size_t>(16 * 1024, AlignRecord(max_buffer_bytes / 16));
+  iov_.reserve(IOV_MAX);
 }
 
 AsyncLogger::~AsyncLogger() {
@@ -53,6 +88,7 @@ AsyncLogger::~AsyncLogger() {
 void AsyncLogger::Start() {
   CHECK_EQ(state_, INITTED);
   state_ = RUNNING;
+  running_.store(true);
   thread_ = std::thread(&AsyncLogger::RunThread, this);
   scheduler::Instance()->SetInnerThreadAttr(&thread_, "async_log");
   // std::cout << "Async Logger Start!" << std::endl;
@@ -63,53 +99,114 @@ void AsyncLogger::Stop() {
     std::unique_lock<std::mutex> lock(mutex_);
     CHECK_EQ(state_, RUNNING);
     state_ = STOPPED;
+    running_.store(false);
     wake_flusher_cv_.notify_one();
   }
   thread_.join();
-  CHECK(active_buf_->messages.empty());
-  CHECK(flushing_buf_->messages.empty());
+  // pick up what was written while the flusher was exiting
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    draining_ = buffers_;
+  }
+  DrainBuffers();
+  draining_.clear();
   // std::cout << "Async Logger Stop!" << std::endl;
 }
 
+AsyncLogger::ThreadBuffer* AsyncLogger::LocalBuffer() {
+  static thread_local LocalRing ring;
+  if (unlikely(ring.logger_id != id_)) {
+    if (ring.buffer) {
+      ring.buffer->closed.store(true);
+    }
+    ring.buffer = std::make_shared<ThreadBuffer>(thread_buffer_bytes_);
+    ring.logger_id = id_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.emplace_back(ring.buffer);
+  }
+  return ring.buffer.get();
+}
+
 void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
                         int message_len) {
-  // drop message when acitve buffer full
-  if (unlikely(BufferFull(*active_buf_))) {
+  if (unlikely(!running_.load(std::memory_order_acquire) ||
+               message_len <= 0)) {
     return;
   }
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (state_ != RUNNING) {
-      // std::cout << "Async Logger not running!" << std::endl;
-      return;
-    }
+  auto buffer = LocalBuffer();
 
-    switch (message[0]) {
-      case 'F': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 3),
-                         force_flush);
-        break;
-      }
-      case 'E': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 2),
-                         force_flush);
-        break;
-      }
-      case 'W': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 1),
-                         force_flush);
-        break;
-      }
-      case 'I': {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), 0),
-                         force_flush);
-        break;
-      }
-      default: {
-        active_buf_->add(Msg(timestamp, std::string(message, message_len), -1),
-                         force_flush);
-      }
+  // cut the module tag out here, see FindModuleName()
+  size_t len = static_cast<size_t>(message_len);
+  const char* module = nullptr;
+  size_t module_len = 0;
+  size_t tag_len = 0;
+  auto lpos = static_cast<const char*>(std::memchr(message, '[', len));
+  if (lpos != nullptr) {
+    auto rpos = static_cast<const char*>(
+        std::memchr(lpos, ']', len - (lpos - message)));
+    if (rpos != nullptr) {
+      module = lpos + 1;
+      module_len = rpos - lpos - 1;
+      tag_len = rpos - lpos + 1;
     }
+  }
+  if (module_len >= kPadding) {
+    module_len = 0;
+  }
+  auto size = AlignRecord(sizeof(Record) + module_len + len - tag_len);
+
+  // reserve the record, never wrapping around the end of the ring
+  auto capacity = buffer->capacity;
+  auto head = buffer->head.load(std::memory_order_relaxed);
+  auto tail = buffer->tail.load(std::memory_order_acquire);
+  auto offset = head % capacity;
+  uint64_t padding = capacity - offset < size ? capacity - offset : 0;
+  if (unlikely(head + padding + size - tail > capacity)) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  char* data = buffer->data.get();
+  if (padding >= sizeof(Record)) {
+    auto record = reinterpret_cast<Record*>(data + offset);
+    record->size = static_cast<uint32_t>(padding);
+    record->module_len = kPadding;
+  }
+  if (padding > 0) {
+    head += padding;
+    offset = 0;
+  }
+
+  auto record = reinterpret_cast<Record*>(data + offset);
+  record->size = size;
+  record->module_len = static_cast<uint16_t>(module_len);
+  record->level = LogLevel(message[0]);
+  record->flush = record->level > 0;
+  record->message_len = static_cast<uint32_t>(len - tag_len);
+  record->ts = timestamp;
+  char* dst = data + offset + sizeof(Record);
+  std::memcpy(dst, module, module_len);
+  dst += module_len;
+  if (tag_len > 0) {
+    auto prefix_len = static_cast<size_t>(lpos - message);
+    std::memcpy(dst, message, prefix_len);
+    std::memcpy(dst + prefix_len, lpos + tag_len, len - prefix_len - tag_len);
+  } else {
+    std::memcpy(dst, message, len);
+  }
+  buffer->head.store(head + size, std::memory_order_release);
+
+  Wake(force_flush);
+}
+
+void AsyncLogger::Wake(bool force_flush) {
+  if (force_flush) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_ = true;
+    wake_pending_.store(true);
+    wake_flusher_cv_.notify_one();
+  } else if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+    // the first message since the last drain wakes the flusher up
+    std::lock_guard<std::mutex> lock(mutex_);
     wake_flusher_cv_.notify_one();
   }
 }
@@ -122,10 +219,10 @@ void AsyncLogger::Flush() {
   }
 
   // Wake up the writer thread at least twice.
-  // This ensures both buffers were completely flushed.
+  // This ensures the messages written so far were completely flushed.
   uint64_t orig_flush_count = flush_count_;
   while (flush_count_ < (orig_flush_count + 2) && state_ == RUNNING) {
-    active_buf_->flush = true;
+    flush_ = true;
     wake_flusher_cv_.notify_one();
     flush_complete_cv_.wait(lock);
   }
@@ -133,54 +230,129 @@ void AsyncLogger::Flush() {
 
 uint32_t AsyncLogger::LogSize() { return wrapped_->LogSize(); }
 
+uint64_t AsyncLogger::drop_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t count = drop_count_.load();
+  for (auto& buffer : buffers_) {
+    count += buffer->dropped.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+bool AsyncLogger::HasPending() {
+  for (auto& buffer : buffers_) {
+    if (buffer->head.load(std::memory_order_acquire) !=
+        buffer->tail.load(std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void AsyncLogger::RunThread() {
   std::unique_lock<std::mutex> lock(mutex_);
-  while (state_ == RUNNING || active_buf_->needs_flush_or_write()) {
-    while (!active_buf_->needs_flush_or_write() && state_ == RUNNING) {
+  while (state_ == RUNNING || HasPending()) {
+    while (!flush_ && !wake_pending_.load() && state_ == RUNNING) {
       if (wake_flusher_cv_.wait_for(lock, std::chrono::seconds(2)) ==
           std::cv_status::timeout) {
-        active_buf_->flush = true;
+        flush_ = true;
       }
     }
 
-    active_buf_.swap(flushing_buf_);
+    bool flush = flush_;
+    flush_ = false;
+    // messages added from now on wake the flusher up again
+    wake_pending_.exchange(false, std::memory_order_acq_rel);
+    draining_ = buffers_;
     lock.unlock();
 
-    for (auto& msg : flushing_buf_->messages) {
-      std::string module_name;
-      FindModuleName(&msg.message, &module_name);
-
-      LogFileObject* fileobject = nullptr;
-      if (moduleLoggerMap.find(module_name) != moduleLoggerMap.end()) {
-        fileobject = moduleLoggerMap[module_name];
-      } else {
-        fileobject = new LogFileObject(google::INFO, module_name.c_str());
-        fileobject->SetSymlinkBasename(module_name.c_str());
-        moduleLoggerMap[module_name] = fileobject;
-      }
-      if (fileobject) {
-        const bool should_flush = msg.level > 0;
-        fileobject->Write(should_flush, msg.ts, msg.message.data(),
-                          static_cast<int>(msg.message.size()));
-      }
-    }
-
-    if (flushing_buf_->flush) {
+    DrainBuffers();
+    if (flush) {
       for (auto& module_logger : moduleLoggerMap) {
         module_logger.second->Flush();
       }
     }
-    flushing_buf_->clear();
+    draining_.clear();
 
     lock.lock();
+    // release the rings of exited threads once they are drained
+    for (auto it = buffers_.begin(); it != buffers_.end();) {
+      auto& buffer = *it;
+      if (buffer->closed.load() &&
+          buffer->head.load() == buffer->tail.load()) {
+        drop_count_.fetch_add(buffer->dropped.load());
+        it = buffers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
     flush_count_++;
     flush_complete_cv_.notify_all();
   }
 }
 
-bool AsyncLogger::BufferFull(const Buffer& buf) const {
-  // We evenly divide our total buffer space into two buffers.
-  return buf.size > (max_buffer_bytes_ / 2);
+void AsyncLogger::DrainBuffers() {
+  for (auto& buffer : draining_) {
+    auto head = buffer->head.load(std::memory_order_acquire);
+    auto tail = buffer->tail.load(std::memory_order_relaxed);
+    const char* data = buffer->data.get();
+    while (tail < head) {
+      auto offset = tail % buffer->capacity;
+      if (buffer->capacity - offset < sizeof(Record)) {
+        // too short for a padding record, the writer skipped it as well
+        tail += buffer->capacity - offset;
+        continue;
+      }
+      auto record = reinterpret_cast<const Record*>(data + offset);
+      tail += record->size;
+      if (record->module_len == kPadding) {
+        continue;
+      }
+      auto module = reinterpret_cast<const char*>(record + 1);
+      if (batch_module_.size() != record->module_len ||
+          batch_module_.compare(0, record->module_len, module,
+                                record->module_len) != 0) {
+        WriteBatch();
+        batch_module_.assign(module, record->module_len);
+      }
+      if (iov_.size() >= static_cast<size_t>(IOV_MAX)) {
+        WriteBatch();
+      }
+      if (iov_.empty()) {
+        batch_ts_ = record->ts;
+      }
+      iov_.push_back({const_cast<char*>(module) + record->module_len,
+                      record->message_len});
+      batch_flush_ |= record->flush != 0;
+    }
+    // the batch points into the ring, write it before handing space back
+    WriteBatch();
+    buffer->tail.store(tail, std::memory_order_release);
+  }
+}
+
+void AsyncLogger::WriteBatch() {
+  if (iov_.empty()) {
+    return;
+  }
+  const std::string& module_name =
+      batch_module_.empty() ? common::GlobalData::Instance()->ProcessGroup()
+                            : batch_module_;
+  LogFileObject* fileobject = nullptr;
+  auto search = moduleLoggerMap.find(module_name);
+  if (search != moduleLoggerMap.end()) {
+    fileobject = search->second;
+  } else {
+    fileobject = new LogFileObject(google::INFO, module_name.c_str());
+    fileobject->SetSymlinkBasename(module_name.c_str());
+    moduleLoggerMap[module_name] = fileobject;
+  }
+  if (fileobject) {
+    fileobject->Write(batch_flush_, batch_ts_, iov_.data(),
+                      static_cast<int>(iov_.size()));
+  }
+  iov_.clear();
+  batch_flush_ = false;
 }
 
 }  // namespace logger
@@ -17,6 +17,8 @@
 #ifndef INCLUDE_CYBER_COMMON_ASYNC_LOGGER_H_
 #define INCLUDE_CYBER_COMMON_ASYNC_LOGGER_H_
 
+#include <sys/uio.h>
+
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -37,34 +39,33 @@ namespace cyber {
 namespace logger {
 
 // Wrapper for a glog Logger which asynchronously writes log messages.
-// This class starts a new thread responsible for forwarding the messages
-// to the logger, and performs double buffering. Writers append to the
-// current buffer and then wake up the logger thread. The logger swaps in
-// a new buffer and writes any accumulated messages to the wrapped
-// Logger.
+// Every thread that logs gets its own ring of preformatted messages, which
+// only that thread appends to and only the logger thread drains, so Write()
+// takes no lock and copies the message once. The logger thread wakes up on
+// new messages, routes them to the file of their module and writes the
+// consecutive messages of a module with a single writev().
 //
-// This double-buffering design dramatically improves performance, especially
-// for logging messages which require flushing the underlying file (i.e WARNING
-// and above for default). The flush can take a couple of milliseconds, and in
-// some cases can even block for hundreds of milliseconds or more. With the
-// double-buffered approach, threads can proceed with useful work while the IO
-// thread blocks.
+// This dramatically improves performance, especially for logging messages
+// which require flushing the underlying file (i.e WARNING and above for
+// default). The flush can take a couple of milliseconds, and in some cases
+// can even block for hundreds of milliseconds or more. Threads proceed with
+// useful work while the IO thread blocks.
 //
 // The semantics provided by this wrapper are slightly weaker than the default
 // glog semantics. By default, glog will immediately (synchronously) flush
-// WARNING
-// and above to the underlying file, whereas here we are deferring that flush to
-// a separate thread. This means that a crash just after a 'LOG_WARN' would
-// may be missing the message in the logs, but the perf benefit is probably
-// worth it. We do take care that a glog FATAL message flushes all buffered log
-// messages before exiting.
+// WARNING and above to the underlying file, whereas here we are deferring
+// that flush to a separate thread. This means that a crash just after a
+// 'LOG_WARN' would may be missing the message in the logs, but the perf
+// benefit is probably worth it. We do take care that a glog FATAL message
+// flushes all buffered log messages before exiting. Messages of different
+// threads keep their timestamps but may be interleaved out of order.
 //
-// NOTE: the logger limits the total amount of buffer space, so if the
-// underlying
-// log blocks for too long, eventually the threads generating the log messages
-// will block as well. This prevents runaway memory usage.
+// NOTE: the ring of a thread is bounded, when the IO thread falls behind the
+// messages that do not fit are dropped and counted instead of blocking the
+// threads generating them.
 class AsyncLogger : public google::base::Logger {
  public:
+  // Each logging thread buffers up to 'max_buffer_bytes' / 16, at least 16KB.
   explicit AsyncLogger(google::base::Logger* wrapped, int max_buffer_bytes);
 
   ~AsyncLogger();
@@ -82,13 +83,11 @@ class AsyncLogger : public google::base::Logger {
   // Write a message to the log.
   //
   // 'force_flush' is set by the GLog library based on the configured
-  // '--logbuflevel' flag.
-  // Any messages logged at the configured level or higher result in
-  // 'force_flush'
-  // being set to true, indicating that the message should be immediately
-  // written to the
-  // log rather than buffered in memory. See the class-level docs above for more
-  // details about the implementation provided here.
+  // '--logbuflevel' flag. Any messages logged at the configured level or
+  // higher result in 'force_flush' being set to true, indicating that the
+  // message should be immediately written to the log rather than buffered in
+  // memory. See the class-level docs above for more details about the
+  // implementation provided here.
   //
   // REQUIRES: Start() must have been called.
   void Write(bool force_flush, time_t timestamp, const char* message,
@@ -102,61 +101,59 @@ class AsyncLogger : public google::base::Logger {
   // logged data may not have been flushed to disk yet.
   uint32_t LogSize() override;
 
+  // Messages dropped so far because the ring of their thread was full.
+  uint64_t drop_count() const;
+
  private:
-  // A buffered message.
-  //
-  // TODO(todd): using std::string for buffered messages is convenient but not
-  // as efficient as it could be. It's better to make the buffers just be
-  // Arenas and allocate both the message data and Msg struct from them, forming
-  // a linked list.
-  struct Msg {
-    time_t ts;
-    std::string message;
-    int32_t level;
-
-    Msg(time_t ts, std::string&& message, int32_t level)
-        : ts(ts), message(std::move(message)), level(level) {}
+  // A message in a ring, followed by the module name and then the message
+  // with the module tag cut out. Records are 8-byte aligned and never wrap,
+  // the end of the ring is skipped with a padding record.
+  struct Record {
+    uint32_t size;
+    uint16_t module_len;
+    int8_t level;
+    uint8_t flush;
+    uint32_t message_len;
+    uint32_t reserved;
+    int64_t ts;
+  };
+  static const uint16_t kPadding = UINT16_MAX;
+
+  // Single producer, single consumer ring of records.
+  struct ThreadBuffer {
+    explicit ThreadBuffer(size_t size) : capacity(size), data(new char[size]) {}
+
+    const uint64_t capacity;
+    std::unique_ptr<char[]> data;
+    // producer position, written by the logging thread only
+    std::atomic<uint64_t> head = {0};
+    std::atomic<uint64_t> dropped = {0};
+    // set when the logging thread exits
+    std::atomic<bool> closed = {false};
+    // keeps the consumer position off the producer's cache line
+    char padding[64];
+    // consumer position, written by the logger thread only
+    std::atomic<uint64_t> tail = {0};
   };
 
-  // A buffer of messages waiting to be flushed.
-  struct Buffer {
-    std::vector<Msg> messages;
-
-    // Estimate of the size of 'messages'.
-    std::atomic<int> size = {0};
-
-    // Whether this buffer needs an explicit flush of the
-    // underlying logger.
-    bool flush = false;
-
-    Buffer() {}
-
-    inline void clear() {
-      messages.clear();
-      size = 0;
-      flush = false;
-    }
-
-    inline void add(Msg&& msg, bool force_flush) {
-      size += static_cast<int>(sizeof(msg))
-              + static_cast<int>(msg.message.size());
-      messages.emplace_back(std::move(msg));
-      flush |= force_flush;
-    }
-
-    inline bool needs_flush_or_write() const {
-      return flush || !messages.empty();
-    }
-
-   private:
-    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  // The ring of the calling thread, tied to the logger it was created for.
+  struct LocalRing {
+    ~LocalRing();
+    uint64_t logger_id = 0;
+    std::shared_ptr<ThreadBuffer> buffer;
   };
 
-  bool BufferFull(const Buffer& buf) const;
+  ThreadBuffer* LocalBuffer();
+  void Wake(bool force_flush);
+  bool HasPending();
+  void DrainBuffers();
+  void WriteBatch();
   void RunThread();
 
-  // The maximum number of bytes used by the entire class.
-  int max_buffer_bytes_;
+  const uint64_t id_;
+
+  // Size of the ring of each thread.
+  size_t thread_buffer_bytes_;
 
   google::base::Logger* const wrapped_;
   std::thread thread_;
@@ -165,35 +162,40 @@ class AsyncLogger : public google::base::Logger {
   // 64 bits should be enough to never worry about overflow.
   uint64_t flush_count_ = 0;
 
-  // Count of how many times the writer thread has dropped the log messages.
+  // Count of dropped log messages of the rings already released.
   // 64 bits should be enough to never worry about overflow.
-  uint64_t drop_count_ = 0;
+  std::atomic<uint64_t> drop_count_ = {0};
 
-  // Protects buffers as well as 'state_'.
-  std::mutex mutex_;
+  // Protects 'buffers_', 'state_' and 'flush_'.
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+  // Set by app threads when they add a message, cleared by the flusher
+  // before it drains. Only the thread setting it takes the mutex to wake the
+  // flusher up.
+  std::atomic<bool> wake_pending_ = {false};
+  bool flush_ = false;
 
   // Signaled by app threads to wake up the flusher, either for new
   // data or because 'state_' changed.
   std::condition_variable wake_flusher_cv_;
 
-  // Signaled by the flusher thread when the flusher has swapped in
-  // a free buffer to write to.
-  // std::condition_variable free_buffer_cv_;
-
   // Signaled by the flusher thread when it has completed flushing
   // the current buffer.
   std::condition_variable flush_complete_cv_;
 
-  // The buffer to which application threads append new log messages.
-  std::unique_ptr<Buffer> active_buf_;
-
-  // The buffer currently being flushed by the logger thread, cleared
-  // after a successful flush.
-  std::unique_ptr<Buffer> flushing_buf_;
+  // Owned by the flusher thread: the rings being drained and the messages
+  // of the module being batched.
+  std::vector<std::shared_ptr<ThreadBuffer>> draining_;
+  std::vector<struct iovec> iov_;
+  std::string batch_module_;
+  time_t batch_ts_ = 0;
+  bool batch_flush_ = false;
 
   // Trigger for the logger thread to stop.
   enum State { INITTED, RUNNING, STOPPED };
   State state_ = INITTED;
+  std::atomic<bool> running_ = {false};
 
   DISALLOW_COPY_AND_ASSIGN(AsyncLogger);
 };
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/logger/async_logger.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/cyber.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+TEST(AsyncLoggerTest, write_and_flush) {
+  AsyncLogger logger(google::base::GetLogger(google::INFO), 0);
+  logger.Start();
+  time_t timep;
+  time(&timep);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&logger, timep, i]() {
+      std::string message = "I1014 12:00:00.000000 1 test.cc:1] [AsyncLogger" +
+                            std::to_string(i % 2) + "] async logger test\n";
+      for (int j = 0; j < 100; ++j) {
+        logger.Write(false, timep, message.c_str(),
+                     static_cast<int>(message.size()));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  logger.Flush();
+  // 4 * 100 small messages fit in the 128KB ring of each thread
+  EXPECT_EQ(logger.drop_count(), 0);
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
@@ -49,8 +49,11 @@
 #include "cyber/logger/log_file_object.h"
 
 #include <fcntl.h>
+#include <limits.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
@@ -187,13 +190,10 @@ bool LogFileObject::CreateLogfile(const std::string& time_pid_string) {
   return true;
 }
 
-void LogFileObject::Write(bool force_flush, time_t timestamp,
-                          const char* message, int message_len) {
-  std::lock_guard<std::mutex> lock(lock_);
-
+bool LogFileObject::PrepareFileUnlocked(time_t timestamp) {
   // We don't log if the base_name_ is "" (which means "don't write")
   if (base_filename_selected_ && base_filename_.empty()) {
-    return;
+    return false;
   }
 
   if (static_cast<int>(file_length_ >> 20) >=
@@ -211,7 +211,7 @@ void LogFileObject::Write(bool force_flush, time_t timestamp,
     // this could matter would be when we have trouble creating the log
     // file.  If that happens, we'll lose lots of log messages, of course!
     if (++rollover_attempt_ != kRolloverAttemptFrequency) {
-      return;
+      return false;
     }
     rollover_attempt_ = 0;
 
@@ -251,7 +251,7 @@ void LogFileObject::Write(bool force_flush, time_t timestamp,
         perror("Could not create logging file");
         fprintf(stderr, "COULD NOT CREATE A LOGGINGFILE %s!",
                 time_pid_string.c_str());
-        return;
+        return false;
       }
     }
 
@@ -273,13 +273,23 @@ void LogFileObject::Write(bool force_flush, time_t timestamp,
     const uint32_t header_len =
         static_cast<uint32_t>(file_header_string.size());
     if (file_ == nullptr) {
-      return;
+      return false;
     }
     fwrite(file_header_string.data(), 1, header_len, file_);
     file_length_ += header_len;
     bytes_since_flush_ += header_len;
   }
 
+  return true;
+}
+
+void LogFileObject::Write(bool force_flush, time_t timestamp,
+                          const char* message, int message_len) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (!PrepareFileUnlocked(timestamp)) {
+    return;
+  }
+
   // Write to LOG file
   if (!stop_writing) {
     // fwrite() doesn't return an error when the disk is full, for
@@ -311,6 +321,57 @@ void LogFileObject::Write(bool force_flush, time_t timestamp,
   }
 }
 
+void LogFileObject::Write(bool force_flush, time_t timestamp,
+                          const struct iovec* iov, int iovcnt) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (!PrepareFileUnlocked(timestamp)) {
+    return;
+  }
+
+  if (stop_writing) {
+    if (::apollo::cyber::logger::CycleClock_Now() >= next_flush_time_) {
+      stop_writing = false;  // check to see if disk has free space.
+    }
+    return;
+  }
+
+  // whatever stdio still buffers goes first, then the batch in one call
+  fflush(file_);
+  int fd = fileno(file_);
+  // a short write leaves part of an iovec, so work on a copy
+  std::vector<struct iovec> rest(iov, iov + iovcnt);
+  struct iovec* cur = rest.data();
+  while (iovcnt > 0) {
+    ssize_t written = writev(fd, cur, std::min(iovcnt, IOV_MAX));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == ENOSPC) {  // disk full, stop writing to disk
+        stop_writing = true;
+      }
+      return;
+    }
+    file_length_ += static_cast<uint32_t>(written);
+    auto left = static_cast<size_t>(written);
+    while (iovcnt > 0 && left >= cur->iov_len) {
+      left -= cur->iov_len;
+      ++cur;
+      --iovcnt;
+    }
+    if (left > 0) {
+      cur->iov_base = static_cast<char*>(cur->iov_base) + left;
+      cur->iov_len -= left;
+    }
+  }
+
+  if (force_flush ||
+      ::apollo::cyber::logger::CycleClock_Now() >= next_flush_time_) {
+    // nothing is left in stdio, but the flush deadline moves on
+    FlushUnlocked();
+  }
+}
+
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
@@ -17,6 +17,8 @@
 #ifndef CYBER_LOGGER_LOG_FILE_OBJECT_H_
 #define CYBER_LOGGER_LOG_FILE_OBJECT_H_
 
+#include <sys/uio.h>
+
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -34,6 +36,9 @@ class LogFileObject : public google::base::Logger {
 
   void Write(bool force_flush, time_t timestamp, const char* message,
              int message_len) override;
+  // Writes a batch of messages with as few writev() calls as possible.
+  void Write(bool force_flush, time_t timestamp, const struct iovec* iov,
+             int iovcnt);
 
   void SetBasename(const char* basename);
   void SetExtension(const char* ext);
@@ -51,6 +56,8 @@ class LogFileObject : public google::base::Logger {
 
  private:
   bool CreateLogfile(const std::string& time_pid_string);
+  // Rolls over or creates the file as needed, false if nothing can be written.
+  bool PrepareFileUnlocked(time_t timestamp);
   static const uint32_t kRolloverAttemptFrequency = 0x20;
   std::mutex lock_;
   bool base_filename_selected_;
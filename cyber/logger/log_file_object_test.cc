@@ -39,6 +39,18 @@ TEST(LogFileObjectTest, init_and_write) {
   logfileobject.Flush();
 }
 
+TEST(LogFileObjectTest, write_iovec) {
+  LogFileObject logfileobject(google::INFO, "logfile_iovec");
+  time_t timep;
+  time(&timep);
+  std::string first = "cyber logger test\n";
+  std::string second = "cyber logger iovec test\n";
+  struct iovec iov[2] = {{&first[0], first.size()},
+                         {&second[0], second.size()}};
+  logfileobject.Write(true, timep, iov, 2);
+  logfileobject.Flush();
+}
+
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
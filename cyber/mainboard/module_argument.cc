@@ -19,6 +19,9 @@
 #include <getopt.h>
 #include <libgen.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 using apollo::cyber::common::GlobalData;
 
 namespace apollo {
@@ -38,6 +41,10 @@ void ModuleArgument::DisplayUsage() {
            "namespace for running this module, default in manager process\n"
         << "    -s, --sched_name=sched_name: sched policy "
            "conf for hole process, sched_name should be conf in cyber.pb.conf\n"
+        << "    -j, --init_threads=N: initialize up to N components in "
+           "parallel, components wait for the ones they depend on, default 1\n"
+        << "    -t, --startup_timeline=FILE: write how long loading and "
+           "initializing took to FILE, viewable in chrome://tracing\n"
         << "Example:\n"
         << "    " << binary_name_ << " -h\n"
         << "    " << binary_name_ << " -d dag_conf_file1 -d dag_conf_file2 "
@@ -68,12 +75,14 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
 void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
   opterr = 0;  // extern int opterr
   int long_index = 0;
-  const std::string short_opts = "hd:p:s:";
+  const std::string short_opts = "hd:p:s:j:t:";
   static const struct option long_opts[] = {
       {"help", no_argument, nullptr, 'h'},
       {"dag_conf", required_argument, nullptr, 'd'},
       {"process_name", required_argument, nullptr, 'p'},
       {"sched_name", required_argument, nullptr, 's'},
+      {"init_threads", required_argument, nullptr, 'j'},
+      {"startup_timeline", required_argument, nullptr, 't'},
       {NULL, no_argument, nullptr, 0}};
 
   // log command for info
@@ -107,6 +116,12 @@ void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
       case 's':
         sched_name_ = std::string(optarg);
         break;
+      case 'j':
+        init_threads_ = std::max(1, std::atoi(optarg));
+        break;
+      case 't':
+        startup_timeline_ = std::string(optarg);
+        break;
       case 'h':
         DisplayUsage();
         exit(0);
@@ -44,12 +44,16 @@ class ModuleArgument {
   inline std::list<std::string> GetDAGConfList() const {
     return dag_conf_list_;
   }
+  inline int GetInitThreads() const { return init_threads_; }
+  inline std::string GetStartupTimeline() const { return startup_timeline_; }
 
  private:
   std::list<std::string> dag_conf_list_;
   std::string binary_name_;
   std::string process_group_;
   std::string sched_name_;
+  int init_threads_ = 1;
+  std::string startup_timeline_;
 };
 
 }  // namespace mainboard
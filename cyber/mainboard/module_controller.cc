@@ -16,6 +16,12 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include "cyber/common/environment.h"
@@ -30,12 +36,25 @@ ModuleController::ModuleController(const ModuleArgument& args) { args_ = args; }
 
 ModuleController::~ModuleController() {}
 
-bool ModuleController::Init() { return LoadAll(); }
+bool ModuleController::Init() {
+  if (!LoadAll()) {
+    return false;
+  }
+  // the modules run fine without statistics
+  routine_stat_reporter_.Start();
+  return true;
+}
 
 void ModuleController::Clear() {
+  routine_stat_reporter_.Stop();
   for (auto& component : component_list_) {
     component->Shutdown();
   }
+  for (auto& pipeline : pipelines_) {
+    pipeline->Clear();
+  }
+  pipelines_.clear();
+  tasks_.clear();
   component_list_.clear();  // keep alive
   class_loader_manager_.UnloadAllLibrary();
 }
@@ -66,12 +85,22 @@ bool ModuleController::LoadAll() {
       return false;
     }
   }
-  return true;
+
+  bool ret = JoinPipelines() && InitializeAll();
+  timeline_.Log();
+  if (!args_.GetStartupTimeline().empty()) {
+    timeline_.DumpChromeTrace(args_.GetStartupTimeline());
+  }
+  return ret;
 }
 
 bool ModuleController::LoadModule(const DagConfig& dag_config) {
   const std::string work_root = common::WorkRoot();
 
+  pipeline_configs_.insert(pipeline_configs_.end(),
+                           dag_config.pipelines().begin(),
+                           dag_config.pipelines().end());
+
   for (auto module_config : dag_config.module_config()) {
     std::string load_path;
     if (module_config.module_library().front() == '/') {
@@ -86,35 +115,195 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
       return false;
     }
 
-    class_loader_manager_.LoadLibrary(load_path);
+    {
+      // libraries register their classes in process wide state while being
+      // opened, so they are loaded one by one
+      StartupTimeline::Span span(&timeline_, "load", load_path);
+      class_loader_manager_.LoadLibrary(load_path);
+    }
 
     for (auto& component : module_config.components()) {
-      const std::string& class_name = component.class_name();
-      std::shared_ptr<ComponentBase> base =
-          class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr) {
+      if (!CreateComponent(component)) {
         return false;
       }
+    }
 
-      if (!base->Initialize(component.config())) {
+    for (auto& component : module_config.timer_components()) {
+      if (!CreateComponent(component)) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
     }
+  }
+  return true;
+}
 
-    for (auto& component : module_config.timer_components()) {
-      const std::string& class_name = component.class_name();
-      std::shared_ptr<ComponentBase> base =
-          class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr) {
+template <typename ComponentInfoT>
+bool ModuleController::CreateComponent(const ComponentInfoT& info) {
+  std::shared_ptr<ComponentBase> base =
+      class_loader_manager_.CreateClassObj<ComponentBase>(info.class_name());
+  if (base == nullptr) {
+    return false;
+  }
+
+  ComponentTask task;
+  task.name = info.config().name();
+  task.depends.assign(info.depends().begin(), info.depends().end());
+  task.component = base;
+  auto config = info.config();
+  task.initialize = [base, config]() { return base->Initialize(config); };
+  tasks_.emplace_back(std::move(task));
+  return true;
+}
+
+bool ModuleController::JoinPipelines() {
+  std::unordered_map<std::string, ComponentTask*> index;
+  for (auto& task : tasks_) {
+    index[task.name] = &task;
+  }
+
+  std::unordered_map<std::string, std::string> joined;
+  for (auto& config : pipeline_configs_) {
+    if (config.stages_size() < 2) {
+      AERROR << "Pipeline " << config.name() << " has too few stages.";
+      return false;
+    }
+    auto pipeline =
+        std::make_shared<Pipeline>(config.name(), config.stages_size());
+    for (int i = 0; i < config.stages_size(); ++i) {
+      const std::string& stage = config.stages(i);
+      auto search = index.find(stage);
+      if (search == index.end()) {
+        AERROR << "Pipeline " << config.name()
+               << " has unknown component: " << stage;
         return false;
       }
+      if (!joined.emplace(stage, config.name()).second) {
+        AERROR << "Component " << stage << " is in both pipeline "
+               << joined[stage] << " and " << config.name();
+        return false;
+      }
+      search->second->component->JoinPipeline(pipeline, i);
+    }
+    AINFO << "Pipeline " << config.name() << " runs "
+          << config.stages_size() << " components in one task.";
+    pipelines_.emplace_back(std::move(pipeline));
+  }
+  pipeline_configs_.clear();
+  return true;
+}
+
+bool ModuleController::InitializeComponent(ComponentTask* task) {
+  StartupTimeline::Span span(&timeline_, "init", task->name);
+  task->initialized = task->initialize();
+  if (!task->initialized) {
+    AERROR << "Failed to initialize component: " << task->name;
+  }
+  return task->initialized;
+}
+
+bool ModuleController::InitializeAll() {
+  bool ret = true;
+  if (args_.GetInitThreads() > 1) {
+    ret = InitializeInParallel();
+  } else {
+    for (auto& task : tasks_) {
+      if (!InitializeComponent(&task)) {
+        ret = false;
+        break;
+      }
+    }
+  }
+
+  // only initialized components are shut down later, in dag order
+  for (auto& task : tasks_) {
+    if (task.initialized) {
+      component_list_.emplace_back(task.component);
+    }
+  }
+  tasks_.clear();
+  return ret;
+}
+
+bool ModuleController::InitializeInParallel() {
+  std::unordered_map<std::string, size_t> index;
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    index[tasks_[i].name] = i;
+  }
 
-      if (!base->Initialize(component.config())) {
+  // a task is ready once nothing it depends on is left to initialize
+  std::vector<size_t> waiting(tasks_.size(), 0);
+  std::vector<std::vector<size_t>> dependents(tasks_.size());
+  std::deque<size_t> ready;
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    for (auto& depend : tasks_[i].depends) {
+      auto search = index.find(depend);
+      if (search == index.end()) {
+        AERROR << "Component " << tasks_[i].name
+               << " depends on unknown component: " << depend;
         return false;
       }
-      component_list_.emplace_back(std::move(base));
+      ++waiting[i];
+      dependents[search->second].emplace_back(i);
     }
+    if (waiting[i] == 0) {
+      ready.emplace_back(i);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t running = 0;
+  size_t done = 0;
+  bool failed = false;
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&] { return failed || !ready.empty() || running == 0; });
+      if (failed || ready.empty()) {
+        break;
+      }
+      size_t i = ready.front();
+      ready.pop_front();
+      ++running;
+      lock.unlock();
+      bool ok = InitializeComponent(&tasks_[i]);
+      lock.lock();
+      --running;
+      ++done;
+      if (!ok) {
+        failed = true;
+      } else {
+        for (auto dependent : dependents[i]) {
+          if (--waiting[dependent] == 0) {
+            ready.emplace_back(dependent);
+          }
+        }
+      }
+      cv.notify_all();
+    }
+  };
+
+  size_t thread_num = std::min(static_cast<size_t>(args_.GetInitThreads()),
+                               tasks_.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (failed) {
+    return false;
+  }
+  if (done != tasks_.size()) {
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+      if (waiting[i] > 0) {
+        AERROR << "Component " << tasks_[i].name
+               << " is part of a dependency cycle.";
+      }
+    }
+    return false;
   }
   return true;
 }
@@ -16,6 +16,7 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -23,6 +24,8 @@
 #include "cyber/class_loader/class_loader_manager.h"
 #include "cyber/component/component.h"
 #include "cyber/mainboard/module_argument.h"
+#include "cyber/mainboard/routine_stat_reporter.h"
+#include "cyber/mainboard/startup_timeline.h"
 #include "cyber/proto/dag_conf.pb.h"
 
 namespace apollo {
@@ -30,6 +33,7 @@ namespace cyber {
 namespace mainboard {
 
 using apollo::cyber::proto::DagConfig;
+using apollo::cyber::proto::PipelineConfig;
 
 class ModuleController {
  public:
@@ -41,12 +45,32 @@ class ModuleController {
   void Clear();
 
  private:
+  // a created component, initialized once all it depends on is
+  struct ComponentTask {
+    std::string name;
+    std::vector<std::string> depends;
+    std::shared_ptr<ComponentBase> component;
+    std::function<bool()> initialize;
+    bool initialized = false;
+  };
+
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  template <typename ComponentInfoT>
+  bool CreateComponent(const ComponentInfoT& info);
+  bool JoinPipelines();
+  bool InitializeComponent(ComponentTask* task);
+  bool InitializeAll();
+  bool InitializeInParallel();
 
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
+  std::vector<ComponentTask> tasks_;
+  std::vector<PipelineConfig> pipeline_configs_;
+  std::vector<std::shared_ptr<Pipeline>> pipelines_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
+  RoutineStatReporter routine_stat_reporter_;
+  StartupTimeline timeline_;
 };
 
 }  // namespace mainboard
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/mainboard/routine_stat_reporter.h"
+
+#include <string>
+
+#include "cyber/common/global_data.h"
+#include "cyber/cyber.h"
+#include "cyber/croutine/routine_statistics.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::croutine::RoutineStatistics;
+
+namespace {
+constexpr auto kReportInterval = std::chrono::seconds(1);
+}
+
+RoutineStatReporter::~RoutineStatReporter() { Stop(); }
+
+bool RoutineStatReporter::Start() {
+  if (RoutineStatistics::GetLevel() == RoutineStatistics::DISABLED) {
+    return true;
+  }
+  auto global_data = GlobalData::Instance();
+  std::string suffix = global_data->HostName() + "_" +
+                       std::to_string(global_data->ProcessId());
+  node_ = CreateNode("routine_stat_reporter_" + suffix);
+  if (node_ == nullptr) {
+    AERROR << "create routine stat reporter node failed.";
+    return false;
+  }
+  writer_ = node_->CreateWriter<RoutineStatList>("/apollo/cyber/routine_stat/" +
+                                                 suffix);
+  if (writer_ == nullptr) {
+    AERROR << "create routine stat writer failed.";
+    return false;
+  }
+  running_ = true;
+  thread_ = std::thread(&RoutineStatReporter::Run, this);
+  return true;
+}
+
+void RoutineStatReporter::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void RoutineStatReporter::Run() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (running_) {
+    cv_.wait_for(lk, kReportInterval);
+    if (!running_) {
+      break;
+    }
+    auto stat_list = std::make_shared<RoutineStatList>();
+    Fill(stat_list.get());
+    writer_->Write(stat_list);
+  }
+}
+
+void RoutineStatReporter::Fill(RoutineStatList* stat_list) {
+  auto global_data = GlobalData::Instance();
+  stat_list->set_host_name(global_data->HostName());
+  stat_list->set_process_id(global_data->ProcessId());
+  stat_list->set_timestamp(Time::Now().ToNanosecond());
+  for (auto& cr : scheduler::Instance()->GetRoutines()) {
+    auto statistics = cr->statistics();
+    if (statistics == nullptr) {
+      continue;
+    }
+    auto stat = stat_list->add_routines();
+    stat->set_name(cr->name());
+    stat->set_id(cr->id());
+    stat->set_group_name(cr->group_name());
+    stat->set_processor_id(cr->processor_id());
+    stat->set_resume_count(statistics->resume_count());
+    stat->set_yield_count(statistics->yield_count());
+    stat->set_preempt_count(statistics->preempt_count());
+    auto& ready_latency = statistics->ready_latency();
+    stat->set_ready_latency_mean(ready_latency.Mean());
+    stat->set_ready_latency_p50(ready_latency.Percentile(50));
+    stat->set_ready_latency_p99(ready_latency.Percentile(99));
+    stat->set_ready_latency_max(ready_latency.Max());
+    auto& run_time = statistics->run_time();
+    stat->set_run_time_mean(run_time.Mean());
+    stat->set_run_time_p99(run_time.Percentile(99));
+    stat->set_run_time_max(run_time.Max());
+    stat->set_stack_size(cr->stack_size());
+    stat->set_stack_high_water_mark(cr->stack_high_water_mark());
+    stat->set_alloc_count(statistics->alloc_count());
+    stat->set_alloc_bytes(statistics->alloc_bytes());
+    stat->set_cpu_time(statistics->cpu_time());
+  }
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MAINBOARD_ROUTINE_STAT_REPORTER_H_
+#define CYBER_MAINBOARD_ROUTINE_STAT_REPORTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/node/node.h"
+#include "cyber/proto/routine_stat.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+using apollo::cyber::proto::RoutineStatList;
+
+// Publishes the statistics of all croutines of this process once a second
+// on /apollo/cyber/routine_stat/<host>_<pid>, where cyber_monitor shows
+// them like any other channel. A component runs in a croutine named after
+// it, so its entry tells the allocations and CPU time of its Proc calls.
+// Does nothing unless cyber_routine_stat is set.
+class RoutineStatReporter {
+ public:
+  RoutineStatReporter() = default;
+  ~RoutineStatReporter();
+
+  bool Start();
+  void Stop();
+
+ private:
+  void Run();
+  void Fill(RoutineStatList* stat_list);
+
+  std::unique_ptr<Node> node_ = nullptr;
+  std::shared_ptr<Writer<RoutineStatList>> writer_ = nullptr;
+  std::atomic<bool> running_ = {false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MAINBOARD_ROUTINE_STAT_REPORTER_H_
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/mainboard/startup_timeline.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+namespace {
+
+std::string Escape(const std::string& str) {
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+}  // namespace
+
+StartupTimeline::Span::Span(StartupTimeline* timeline,
+                            const std::string& category,
+                            const std::string& name)
+    : timeline_(timeline),
+      category_(category),
+      name_(name),
+      begin_(Clock::now()) {}
+
+StartupTimeline::Span::~Span() {
+  timeline_->Add(category_, name_, begin_, Clock::now());
+}
+
+void StartupTimeline::Add(const std::string& category, const std::string& name,
+                          Clock::time_point begin, Clock::time_point end) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  Event event;
+  event.category = category;
+  event.name = name;
+  event.begin_us = duration_cast<microseconds>(begin - start_).count();
+  event.end_us = duration_cast<microseconds>(end - start_).count();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto thread = threads_.emplace(std::this_thread::get_id(),
+                                 static_cast<uint32_t>(threads_.size()));
+  event.thread_index = thread.first->second;
+  events_.emplace_back(std::move(event));
+}
+
+std::vector<StartupTimeline::Event> StartupTimeline::SortedEvents() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Event> events(events_);
+  std::sort(events.begin(), events.end(),
+            [](const Event& lhs, const Event& rhs) {
+              return lhs.begin_us < rhs.begin_us;
+            });
+  return events;
+}
+
+void StartupTimeline::Log() {
+  auto events = SortedEvents();
+  if (events.empty()) {
+    return;
+  }
+  uint64_t end_us = 0;
+  const Event* slowest = &events.front();
+  for (auto& event : events) {
+    end_us = std::max(end_us, event.end_us);
+    if (event.end_us - event.begin_us > slowest->end_us - slowest->begin_us) {
+      slowest = &event;
+    }
+  }
+  AINFO << "startup took " << end_us / 1000 << " ms, the slowest step is "
+        << slowest->category << " " << slowest->name << " with "
+        << (slowest->end_us - slowest->begin_us) / 1000 << " ms";
+  for (auto& event : events) {
+    AINFO << "  [" << event.begin_us / 1000 << ", " << event.end_us / 1000
+          << "] ms " << event.category << " " << event.name;
+  }
+}
+
+bool StartupTimeline::DumpChromeTrace(const std::string& path) {
+  std::ofstream out(path, std::ios::trunc);
+  if (!out.is_open()) {
+    AERROR << "can not open startup timeline file " << path;
+    return false;
+  }
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto& event : SortedEvents()) {
+    out << (first ? "" : ",") << "\n{\"name\":\"" << Escape(event.name)
+        << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":"
+        << event.begin_us << ",\"dur\":" << event.end_us - event.begin_us
+        << ",\"pid\":" << getpid() << ",\"tid\":" << event.thread_index
+        << "}";
+    first = false;
+  }
+  out << "\n]}\n";
+  return out.good();
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_MAINBOARD_STARTUP_TIMELINE_H_
+#define CYBER_MAINBOARD_STARTUP_TIMELINE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+// Records how long loading each library and initializing each component
+// took during mainboard startup, for the log and chrome://tracing.
+class StartupTimeline {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  StartupTimeline() : start_(Clock::now()) {}
+
+  // a span of the timeline, recorded when it goes out of scope
+  class Span {
+   public:
+    Span(StartupTimeline* timeline, const std::string& category,
+         const std::string& name);
+    ~Span();
+
+   private:
+    StartupTimeline* timeline_;
+    std::string category_;
+    std::string name_;
+    Clock::time_point begin_;
+  };
+
+  void Log();
+  bool DumpChromeTrace(const std::string& path);
+
+ private:
+  struct Event {
+    std::string category;
+    std::string name;
+    uint64_t begin_us;
+    uint64_t end_us;
+    uint32_t thread_index;
+  };
+
+  void Add(const std::string& category, const std::string& name,
+           Clock::time_point begin, Clock::time_point end);
+  std::vector<Event> SortedEvents();
+
+  Clock::time_point start_;
+  std::mutex mutex_;
+  std::vector<Event> events_;
+  std::map<std::thread::id, uint32_t> threads_;
+};
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MAINBOARD_STARTUP_TIMELINE_H_
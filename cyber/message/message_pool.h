@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_MESSAGE_POOL_H_
+#define CYBER_MESSAGE_MESSAGE_POOL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+DEFINE_TYPE_TRAIT(HasClear, Clear)
+
+template <typename T>
+typename std::enable_if<HasClear<T>::value>::type ClearMessage(T* message) {
+  message->Clear();
+}
+
+// never pooled, see MessagePoolManager::Enable
+template <typename T>
+typename std::enable_if<!HasClear<T>::value>::type ClearMessage(T* message) {
+  (void)message;
+}
+
+// Recycles deserialized messages. A released message is cleared and kept
+// for the next Acquire(), and protobuf keeps the nested messages, repeated
+// elements and string buffers of a cleared message, so parsing a message of
+// a similar shape into it allocates next to nothing. Messages come back
+// when their last shared_ptr drops, which may be on any thread.
+template <typename MessageT>
+class MessagePool
+    : public std::enable_shared_from_this<MessagePool<MessageT>> {
+ public:
+  using MessagePtr = std::shared_ptr<MessageT>;
+
+  explicit MessagePool(uint32_t capacity) : capacity_(capacity) {}
+  virtual ~MessagePool() {
+    for (auto msg : free_list_) {
+      delete msg;
+    }
+  }
+
+  MessagePtr Acquire();
+
+  uint32_t capacity() const { return capacity_; }
+  // messages constructed because the free list was empty
+  uint64_t alloc_count() const { return alloc_count_.load(); }
+  // messages handed out again after being released
+  uint64_t reuse_count() const { return reuse_count_.load(); }
+
+ private:
+  static void Release(const std::weak_ptr<MessagePool>& pool, MessageT* msg);
+
+  uint32_t capacity_;
+  std::mutex mutex_;
+  std::vector<MessageT*> free_list_;
+  std::atomic<uint64_t> alloc_count_ = {0};
+  std::atomic<uint64_t> reuse_count_ = {0};
+};
+
+template <typename MessageT>
+auto MessagePool<MessageT>::Acquire() -> MessagePtr {
+  MessageT* msg = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_list_.empty()) {
+      msg = free_list_.back();
+      free_list_.pop_back();
+    }
+  }
+  if (msg == nullptr) {
+    msg = new MessageT();
+    alloc_count_.fetch_add(1);
+  } else {
+    reuse_count_.fetch_add(1);
+  }
+  std::weak_ptr<MessagePool> pool = this->shared_from_this();
+  return MessagePtr(msg, [pool](MessageT* msg) { Release(pool, msg); });
+}
+
+template <typename MessageT>
+void MessagePool<MessageT>::Release(const std::weak_ptr<MessagePool>& pool,
+                                    MessageT* msg) {
+  auto self = pool.lock();
+  if (self != nullptr) {
+    ClearMessage(msg);
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    if (self->free_list_.size() < self->capacity_) {
+      self->free_list_.push_back(msg);
+      return;
+    }
+  }
+  delete msg;
+}
+
+// Pools by channel id. Transport takes the pool of a channel when it
+// creates the channel's receiver, so every reader of the channel in this
+// process gets recycled messages once one of them asks for it.
+template <typename MessageT>
+class MessagePoolManager {
+ public:
+  using PoolPtr = std::shared_ptr<MessagePool<MessageT>>;
+
+  // returns false if MessageT can not be cleared for reuse
+  bool Enable(uint64_t channel_id, uint32_t capacity);
+  PoolPtr GetPool(uint64_t channel_id);
+
+ private:
+  std::unordered_map<uint64_t, PoolPtr> pools_;
+  std::mutex mutex_;
+
+  DECLARE_SINGLETON(MessagePoolManager<MessageT>)
+};
+
+template <typename MessageT>
+MessagePoolManager<MessageT>::MessagePoolManager() {}
+
+template <typename MessageT>
+bool MessagePoolManager<MessageT>::Enable(uint64_t channel_id,
+                                          uint32_t capacity) {
+  if (!HasClear<MessageT>::value) {
+    AWARN << "message type can not be recycled, channel id: " << channel_id;
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pools_.count(channel_id) == 0) {
+    pools_[channel_id] = std::make_shared<MessagePool<MessageT>>(capacity);
+  }
+  return true;
+}
+
+template <typename MessageT>
+auto MessagePoolManager<MessageT>::GetPool(uint64_t channel_id) -> PoolPtr {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto search = pools_.find(channel_id);
+  return search == pools_.end() ? nullptr : search->second;
+}
+
+// a recycled message if the channel has a pool, a new one otherwise
+template <typename MessageT>
+std::shared_ptr<MessageT> NewMessage(
+    const std::shared_ptr<MessagePool<MessageT>>& pool) {
+  return pool == nullptr ? std::make_shared<MessageT>() : pool->Acquire();
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_MESSAGE_POOL_H_
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/message_pool.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(MessagePoolTest, recycle) {
+  auto pool = std::make_shared<MessagePool<proto::UnitTest>>(1);
+  auto msg = pool->Acquire();
+  msg->set_class_name("MessagePoolTest");
+  proto::UnitTest* first = msg.get();
+  msg = nullptr;
+  EXPECT_EQ(pool->alloc_count(), 1);
+
+  // a released message comes back cleared
+  msg = pool->Acquire();
+  EXPECT_EQ(msg.get(), first);
+  EXPECT_FALSE(msg->has_class_name());
+  EXPECT_EQ(pool->reuse_count(), 1);
+
+  // the pool keeps no more than its capacity
+  auto other = pool->Acquire();
+  EXPECT_EQ(pool->alloc_count(), 2);
+  msg = nullptr;
+  other = nullptr;
+  msg = pool->Acquire();
+  other = pool->Acquire();
+  EXPECT_EQ(pool->reuse_count(), 2);
+  EXPECT_EQ(pool->alloc_count(), 3);
+
+  // messages may outlive their pool
+  pool = nullptr;
+  other = nullptr;
+  msg = nullptr;
+}
+
+TEST(MessagePoolTest, manager) {
+  auto manager = MessagePoolManager<proto::UnitTest>::Instance();
+  EXPECT_EQ(manager->GetPool(1), nullptr);
+  EXPECT_TRUE(manager->Enable(1, 8));
+  auto pool = manager->GetPool(1);
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool->capacity(), 8);
+  EXPECT_TRUE(manager->Enable(1, 16));
+  EXPECT_EQ(manager->GetPool(1), pool);
+
+  EXPECT_FALSE(MessagePoolManager<RawMessage>::Instance()->Enable(1, 8));
+  EXPECT_EQ(MessagePoolManager<RawMessage>::Instance()->GetPool(1), nullptr);
+  EXPECT_NE(NewMessage<RawMessage>(nullptr), nullptr);
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/node/channel_stats_reporter.h"
+
+#include <chrono>
+#include <string>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/message/channel_stats.h"
+
+namespace apollo {
+namespace cyber {
+
+using common::GlobalData;
+using transport::ChannelCounters;
+using transport::ChannelStats;
+
+const char* ChannelStatsReporter::kChannelName = "/apollo/cyber/channel_stats";
+
+ChannelStatsReporter::ChannelStatsReporter() {}
+
+ChannelStatsReporter::~ChannelStatsReporter() { Shutdown(); }
+
+void ChannelStatsReporter::Start() {
+  auto channel_stats = common::GetEnv("cyber_channel_stats");
+  if (channel_stats != "" && !std::stoi(channel_stats)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  auto global_data = GlobalData::Instance();
+  node_.reset(new Node("channel_stats_reporter_" + global_data->HostName() +
+                       "_" + std::to_string(global_data->ProcessId())));
+  writer_ = node_->CreateWriter<proto::ChannelStatsReport>(kChannelName);
+  if (writer_ == nullptr) {
+    AERROR << "create channel stats writer failed.";
+    node_.reset();
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&ChannelStatsReporter::Run, this);
+}
+
+void ChannelStatsReporter::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void ChannelStatsReporter::FillReport(proto::ChannelStatsReport* report) {
+  auto global_data = GlobalData::Instance();
+  report->set_process_name(global_data->HostName() + ":" +
+                           std::to_string(global_data->ProcessId()));
+  report->set_timestamp(Time::Now().ToNanosecond());
+  ChannelStats::Instance()->ForEachCounters(
+      [report](uint64_t channel_id, const ChannelCounters& counters) {
+        auto channel = report->add_channel();
+        auto name = GlobalData::GetChannelById(channel_id);
+        channel->set_channel_name(name.empty() ? std::to_string(channel_id)
+                                               : name);
+        channel->set_sent_msgs(counters.sent_msgs.load());
+        channel->set_sent_bytes(counters.sent_bytes.load());
+        channel->set_last_send_time(counters.last_send_time.load());
+        channel->set_last_send_interval(counters.last_send_interval.load());
+        channel->set_received_msgs(counters.received_msgs.load());
+        channel->set_dropped_msgs(counters.dropped_msgs.load());
+        channel->set_last_receive_time(counters.last_receive_time.load());
+        channel->set_latency_sum(counters.latency_sum.load());
+        channel->set_latency_count(counters.latency_count.load());
+      });
+}
+
+void ChannelStatsReporter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, std::chrono::seconds(1));
+    if (!running_) {
+      break;
+    }
+    lock.unlock();
+    auto report = std::make_shared<proto::ChannelStatsReport>();
+    FillReport(report.get());
+    writer_->Write(report);
+    lock.lock();
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_NODE_CHANNEL_STATS_REPORTER_H_
+#define CYBER_NODE_CHANNEL_STATS_REPORTER_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+#include "cyber/proto/channel_stats.pb.h"
+
+namespace apollo {
+namespace cyber {
+
+// Publishes the counters of transport::ChannelStats once per second on
+// kChannelName, so that monitors learn the health of every channel from one
+// small message per process. Runs unless cyber_channel_stats=0.
+class ChannelStatsReporter {
+ public:
+  static const char* kChannelName;
+
+  ~ChannelStatsReporter();
+
+  // Must follow cyber::Init().
+  void Start();
+  void Shutdown();
+
+  // Fills 'report' with the counters of this process.
+  static void FillReport(proto::ChannelStatsReport* report);
+
+ private:
+  void Run();
+
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::ChannelStatsReport>> writer_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+
+  DECLARE_SINGLETON(ChannelStatsReporter)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_CHANNEL_STATS_REPORTER_H_
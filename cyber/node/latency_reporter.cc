@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/node/latency_reporter.h"
+
+#include <chrono>
+#include <string>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/message/latency_tracer.h"
+
+namespace apollo {
+namespace cyber {
+
+using common::GlobalData;
+using transport::LatencyStats;
+using transport::LatencyTracer;
+
+namespace {
+
+void FillHistogram(const base::Histogram& histogram,
+                   proto::LatencyHistogram* msg) {
+  msg->set_count(histogram.Count());
+  msg->set_sum(histogram.Sum());
+  msg->set_max(histogram.Max());
+  // trailing empty buckets are left out
+  int last = base::Histogram::kBucketNum - 1;
+  while (last >= 0 && histogram.Bucket(last) == 0) {
+    --last;
+  }
+  for (int i = 0; i <= last; ++i) {
+    msg->add_bucket(histogram.Bucket(i));
+  }
+}
+
+// channels of other processes are known once discovery has seen them
+std::string ChannelName(uint64_t channel_id) {
+  auto name = GlobalData::GetChannelById(channel_id);
+  return name.empty() ? std::to_string(channel_id) : name;
+}
+
+}  // namespace
+
+const char* LatencyReporter::kChannelName = "/apollo/cyber/latency";
+
+LatencyReporter::LatencyReporter() {}
+
+LatencyReporter::~LatencyReporter() { Shutdown(); }
+
+void LatencyReporter::Start() {
+  if (!LatencyTracer::Instance()->enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return;
+  }
+  auto global_data = GlobalData::Instance();
+  node_.reset(new Node("latency_reporter_" + global_data->HostName() + "_" +
+                       std::to_string(global_data->ProcessId())));
+  writer_ = node_->CreateWriter<proto::LatencyReport>(kChannelName);
+  if (writer_ == nullptr) {
+    AERROR << "create latency report writer failed.";
+    node_.reset();
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&LatencyReporter::Run, this);
+}
+
+void LatencyReporter::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void LatencyReporter::FillReport(proto::LatencyReport* report) {
+  auto global_data = GlobalData::Instance();
+  report->set_process_name(global_data->HostName() + ":" +
+                           std::to_string(global_data->ProcessId()));
+  report->set_timestamp(Time::Now().ToNanosecond());
+  LatencyTracer::Instance()->ForEachStats(
+      [report](uint64_t channel_id, uint64_t origin_channel_id,
+               const LatencyStats& stats) {
+        auto channel = report->add_channel();
+        channel->set_channel_name(ChannelName(channel_id));
+        channel->set_origin_channel_name(ChannelName(origin_channel_id));
+        FillHistogram(stats.transport, channel->mutable_transport());
+        FillHistogram(stats.queue, channel->mutable_queue());
+        FillHistogram(stats.callback, channel->mutable_callback());
+        FillHistogram(stats.end_to_end, channel->mutable_end_to_end());
+      });
+}
+
+void LatencyReporter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, std::chrono::seconds(1));
+    if (!running_) {
+      break;
+    }
+    lock.unlock();
+    auto report = std::make_shared<proto::LatencyReport>();
+    FillReport(report.get());
+    if (report->channel_size() > 0) {
+      writer_->Write(report);
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
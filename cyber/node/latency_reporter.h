@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_NODE_LATENCY_REPORTER_H_
+#define CYBER_NODE_LATENCY_REPORTER_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+#include "cyber/proto/latency_report.pb.h"
+
+namespace apollo {
+namespace cyber {
+
+// Publishes the histograms of transport::LatencyTracer once per second on
+// kChannelName, where cyber_latency picks them up live or from a record.
+class LatencyReporter {
+ public:
+  static const char* kChannelName;
+
+  ~LatencyReporter();
+
+  // Starts reporting if latency tracing is on, must follow cyber::Init().
+  void Start();
+  void Shutdown();
+
+  // Fills 'report' with what the tracer has seen so far.
+  static void FillReport(proto::LatencyReport* report);
+
+ private:
+  void Run();
+
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::LatencyReport>> writer_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool running_ = false;
+
+  DECLARE_SINGLETON(LatencyReporter)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_LATENCY_REPORTER_H_
@@ -39,6 +39,15 @@ void Node::Observe() {
   }
 }
 
+void Node::SetReadersPulled() { node_channel_impl_->pull_readers_ = true; }
+
+void Node::PullReaders() {
+  std::lock_guard<std::mutex> lg(readers_mutex_);
+  for (auto& reader : readers_) {
+    reader.second->Pull();
+  }
+}
+
 void Node::ClearData() {
   for (auto& reader : readers_) {
     reader.second->ClearData();
@@ -30,13 +30,19 @@ namespace cyber {
 
 template <typename M0, typename M1, typename M2, typename M3>
 class Component;
+class ComponentBase;
 class TimerComponent;
+class ChannelStatsReporter;
+class LatencyReporter;
 
 class Node {
  public:
   template <typename M0, typename M1, typename M2, typename M3>
   friend class Component;
+  friend class ComponentBase;
   friend class TimerComponent;
+  friend class ChannelStatsReporter;
+  friend class LatencyReporter;
   friend std::unique_ptr<Node> CreateNode(const std::string&,
                                           const std::string&);
   virtual ~Node();
@@ -86,6 +92,11 @@ class Node {
   explicit Node(const std::string& node_name,
                 const std::string& name_space = "");
 
+  // The readers created afterwards run no task, PullReaders takes in what
+  // they received. Used by the downstream stages of a pipeline.
+  void SetReadersPulled();
+  void PullReaders();
+
   std::string node_name_;
   std::string name_space_;
 
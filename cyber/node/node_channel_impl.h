@@ -23,6 +23,7 @@
 #include "cyber/blocker/intra_reader.h"
 #include "cyber/blocker/intra_writer.h"
 #include "cyber/common/global_data.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/node/reader.h"
 #include "cyber/node/writer.h"
@@ -43,15 +44,21 @@ struct ReaderConfig {
     qos_profile.set_durability(proto::QosDurabilityPolicy::DURABILITY_VOLATILE);
 
     pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE;
+    message_pool_size = 0;
   }
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        message_pool_size(other.message_pool_size) {}
 
   std::string channel_name;
   proto::QosProfile qos_profile;
   uint32_t pending_queue_size;
+  // Keeps up to this many released messages of the channel to deserialize
+  // into again, see message::MessagePool. The pool must be enabled by the
+  // first reader of the channel in the process, 0 disables it.
+  uint32_t message_pool_size;
 };
 
 class NodeChannelImpl {
@@ -119,6 +126,8 @@ class NodeChannelImpl {
   void FillInAttr(proto::RoleAttributes* attr);
 
   bool is_reality_mode_;
+  // readers are pulled, see Reader::SetPulled
+  bool pull_readers_ = false;
   std::string node_name_;
   proto::RoleAttributes node_attr_;
   NodeManagerPtr node_manager_ = nullptr;
@@ -170,6 +179,11 @@ auto NodeChannelImpl::CreateReader(const ReaderConfig& config,
   proto::RoleAttributes role_attr;
   role_attr.set_channel_name(config.channel_name);
   role_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  if (config.message_pool_size > 0) {
+    message::MessagePoolManager<MessageT>::Instance()->Enable(
+        GlobalData::RegisterChannel(config.channel_name),
+        config.message_pool_size);
+  }
   return this->template CreateReader<MessageT>(role_attr, reader_func,
                                                config.pending_queue_size);
 }
@@ -194,6 +208,9 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
   } else {
     reader_ptr = std::make_shared<Reader<MessageT>>(new_attr, reader_func,
                                                     pending_queue_size);
+    if (pull_readers_) {
+      reader_ptr->SetPulled();
+    }
   }
 
   RETURN_VAL_IF_NULL(reader_ptr, nullptr);
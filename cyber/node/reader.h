@@ -62,8 +62,13 @@ class Reader : public ReaderBase {
          uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE);
   virtual ~Reader();
 
+  // Makes Init create no task for the reader, so the messages it receives
+  // are only taken in by Pull, in the task of its caller. Call before Init.
+  void SetPulled() { pulled_ = true; }
+
   bool Init() override;
   void Shutdown() override;
+  void Pull() override;
   void Observe() override;
   void ClearData() override;
   bool HasReceived() const override;
@@ -95,6 +100,9 @@ class Reader : public ReaderBase {
   CallbackFunc<MessageT> reader_func_;
   ReceiverPtr receiver_ = nullptr;
   std::string croutine_name_;
+  bool pulled_ = false;
+  std::shared_ptr<data::DataVisitor<MessageT>> pulled_visitor_ = nullptr;
+  CallbackFunc<MessageT> pulled_func_;
 
   BlockerPtr blocker_ = nullptr;
 
@@ -143,17 +151,22 @@ bool Reader<MessageT>::Init() {
   } else {
     func = [this](const std::shared_ptr<MessageT>& msg) { this->Enqueue(msg); };
   }
-  auto sched = scheduler::Instance();
-  croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
   auto dv = std::make_shared<data::DataVisitor<MessageT>>(
       role_attr_.channel_id(), pending_queue_size_);
-  // Using factory to wrap templates.
-  croutine::RoutineFactory factory =
-      croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
-  if (!sched->CreateTask(factory, croutine_name_)) {
-    AERROR << "Create Task Failed!";
-    init_.exchange(false);
-    return false;
+  if (pulled_) {
+    pulled_visitor_ = std::move(dv);
+    pulled_func_ = std::move(func);
+  } else {
+    auto sched = scheduler::Instance();
+    croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
+    // Using factory to wrap templates.
+    croutine::RoutineFactory factory =
+        croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
+    if (!sched->CreateTask(factory, croutine_name_)) {
+      AERROR << "Create Task Failed!";
+      init_.exchange(false);
+      return false;
+    }
   }
 
   receiver_ = ReceiverManager<MessageT>::Instance()->GetReceiver(role_attr_);
@@ -165,6 +178,17 @@ bool Reader<MessageT>::Init() {
   return true;
 }
 
+template <typename MessageT>
+void Reader<MessageT>::Pull() {
+  if (!init_.load() || pulled_visitor_ == nullptr) {
+    return;
+  }
+  std::shared_ptr<MessageT> msg;
+  while (pulled_visitor_->TryFetch(msg)) {
+    pulled_func_(msg);
+  }
+}
+
 template <typename MessageT>
 void Reader<MessageT>::Shutdown() {
   if (!init_.exchange(false)) {
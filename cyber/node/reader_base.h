@@ -23,9 +23,12 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cyber/base/macros.h"
 #include "cyber/common/macros.h"
 #include "cyber/common/util.h"
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/transport/message/channel_stats.h"
+#include "cyber/transport/message/latency_tracer.h"
 #include "cyber/transport/transport.h"
 
 namespace apollo {
@@ -53,6 +56,9 @@ class ReaderBase {
   virtual bool HasWriter() { return false; }
   virtual void GetWriters(std::vector<proto::RoleAttributes>* writers) {}
 
+  // Takes in what a pulled reader received, see Reader::SetPulled.
+  virtual void Pull() {}
+
   const std::string& GetChannelName() const {
     return role_attr_.channel_name();
   }
@@ -99,16 +105,23 @@ auto ReceiverManager<MessageT>::GetReceiver(
   // so reader for datacache we use map to keep one instance for per channel
   const std::string& channel_name = role_attr.channel_name();
   if (receiver_map_.count(channel_name) == 0) {
+    auto counters = transport::ChannelStats::Instance()->GetCounters(
+        role_attr.channel_id());
     receiver_map_[channel_name] =
         transport::Transport::Instance()->CreateReceiver<MessageT>(
-            role_attr, [](const std::shared_ptr<MessageT>& msg,
-                          const transport::MessageInfo& msg_info,
-                          const proto::RoleAttributes& reader_attr) {
+            role_attr, [counters](const std::shared_ptr<MessageT>& msg,
+                                  const transport::MessageInfo& msg_info,
+                                  const proto::RoleAttributes& reader_attr) {
               (void)msg_info;
               (void)reader_attr;
               PerfEventCache::Instance()->AddTransportEvent(
                   TransPerf::TRANS_TO, reader_attr.channel_id(),
                   msg_info.seq_num());
+              transport::ChannelStats::OnReceive(counters, msg_info);
+              if (unlikely(transport::LatencyTracer::Instance()->enabled())) {
+                transport::LatencyTracer::Instance()->OnDequeue(
+                    reader_attr.channel_id(), msg.get(), msg_info);
+              }
               data::DataDispatcher<MessageT>::Instance()->Dispatch(
                   reader_attr.channel_id(), msg);
               PerfEventCache::Instance()->AddTransportEvent(
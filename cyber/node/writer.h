@@ -46,6 +46,16 @@ class Writer : public WriterBase {
   virtual bool Write(const MessageT& msg);
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  // Zero-copy writing for large messages. Loan() hands out a buffer
+  // inside the shared memory segment of this channel; serialize the message
+  // into `loaned->data`, set `loaned->size` and call Publish(). Returns false
+  // when the current readers can't be served from shared memory, in which
+  // case fall back to Write(). A loan not published must be given back with
+  // ReturnLoan() before the writer shuts down.
+  bool Loan(std::size_t size, transport::LoanedBuffer* loaned);
+  bool Publish(transport::LoanedBuffer* loaned);
+  void ReturnLoan(transport::LoanedBuffer* loaned);
+
   bool HasReader() override;
   void GetReaders(std::vector<proto::RoleAttributes>* readers) override;
 
@@ -81,6 +91,11 @@ bool Writer<MessageT>::Init() {
     init_ = true;
   }
   this->role_attr_.set_id(transmitter_->id().HashValue());
+  // readers on other hosts connect there when the channel is streamed
+  if (transmitter_->attributes().has_socket_addr()) {
+    this->role_attr_.mutable_socket_addr()->CopyFrom(
+        transmitter_->attributes().socket_addr());
+  }
   channel_manager_ = service_discovery::TopologyManager::Instance()->
     channel_manager();
   JoinTheTopology();
@@ -112,6 +127,27 @@ bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   return transmitter_->Transmit(msg_ptr);
 }
 
+template <typename MessageT>
+bool Writer<MessageT>::Loan(std::size_t size,
+                            transport::LoanedBuffer* loaned) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  RETURN_VAL_IF_NULL(loaned, false);
+  return transmitter_->Loan(size, loaned);
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::Publish(transport::LoanedBuffer* loaned) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  RETURN_VAL_IF_NULL(loaned, false);
+  return transmitter_->Publish(loaned);
+}
+
+template <typename MessageT>
+void Writer<MessageT>::ReturnLoan(transport::LoanedBuffer* loaned) {
+  RETURN_IF(!WriterBase::IsInit());
+  transmitter_->ReturnLoan(loaned);
+}
+
 template <typename MessageT>
 void Writer<MessageT>::JoinTheTopology() {
   // add listener
@@ -15,14 +15,83 @@
  *****************************************************************************/
 
 #include "cyber/parameter/parameter_client.h"
+
+#include <algorithm>
+
 #include "cyber/node/node.h"
 #include "cyber/parameter/parameter_service_names.h"
 
 namespace apollo {
 namespace cyber {
 
+using base::AtomicRWLock;
+using base::ReadLockGuard;
+using base::WriteLockGuard;
+
+namespace {
+// changes kept while the cache is loaded, more are dropped and loaded again
+constexpr size_t kMaxPendingUpdates = 1024;
+}  // namespace
+
+void ParameterClient::Cache::Update(const ParamUpdate& update) {
+  WriteLockGuard<AtomicRWLock> lock(rw_lock);
+  if (loaded.load() && ApplyUpdate(update)) {
+    return;
+  }
+  loaded.store(false);
+  if (pending_updates.size() >= kMaxPendingUpdates) {
+    pending_updates.clear();
+  }
+  pending_updates.push_back(update);
+}
+
+bool ParameterClient::Cache::Load(const Params& server_params) {
+  WriteLockGuard<AtomicRWLock> lock(rw_lock);
+  params.clear();
+  for (const auto& param : server_params.param()) {
+    params[param.name()] = param;
+  }
+  version = server_params.version();
+  epoch = server_params.epoch();
+  std::sort(pending_updates.begin(), pending_updates.end(),
+            [](const ParamUpdate& lhs, const ParamUpdate& rhs) {
+              return lhs.version() < rhs.version();
+            });
+  bool complete = true;
+  for (const auto& update : pending_updates) {
+    if (!ApplyUpdate(update)) {
+      complete = false;
+      break;
+    }
+  }
+  pending_updates.clear();
+  loaded.store(complete);
+  return complete;
+}
+
+bool ParameterClient::Cache::ApplyUpdate(const ParamUpdate& update) {
+  if (update.epoch() < epoch) {
+    // of the server before it restarted
+    return true;
+  }
+  if (update.epoch() > epoch) {
+    return false;
+  }
+  if (update.version() <= version) {
+    // in the loaded parameters already
+    return true;
+  }
+  if (update.version() != version + 1) {
+    return false;
+  }
+  params[update.param().name()] = update.param();
+  version = update.version();
+  return true;
+}
+
 ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
-                                 const std::string& service_node_name)
+                                 const std::string& service_node_name,
+                                 bool use_cache)
     : node_(node) {
   get_parameter_client_ = node_->CreateClient<ParamName, Param>(
       FixParameterServiceName(service_node_name, GET_PARAMETER_SERVICE_NAME));
@@ -32,10 +101,63 @@ ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
 
   list_parameters_client_ = node_->CreateClient<NodeName, Params>(
       FixParameterServiceName(service_node_name, LIST_PARAMETERS_SERVICE_NAME));
+
+  if (!use_cache) {
+    return;
+  }
+  auto cache = std::make_shared<Cache>();
+  std::weak_ptr<Cache> weak_cache = cache;
+  param_update_reader_ = node_->CreateReader<ParamUpdate>(
+      FixParameterServiceName(service_node_name,
+                              PARAMETER_UPDATES_CHANNEL_NAME),
+      [weak_cache](const std::shared_ptr<ParamUpdate>& update) {
+        auto cache = weak_cache.lock();
+        if (cache != nullptr) {
+          cache->Update(*update);
+        }
+      });
+  if (param_update_reader_ == nullptr) {
+    AWARN << "Cannot follow the parameters of " << service_node_name
+          << ", they are read from the services.";
+    return;
+  }
+  cache_ = cache;
+  // subscribed first, the changes made while loading are not missed
+  LoadCache();
+}
+
+bool ParameterClient::CallListParameters(Params* params) {
+  auto request = std::make_shared<NodeName>();
+  request->set_value(node_->Name());
+  auto response = list_parameters_client_->SendRequest(request);
+  if (response == nullptr) {
+    AERROR << "Call " << list_parameters_client_->ServiceName() << " failed";
+    return false;
+  }
+  params->Swap(response.get());
+  return true;
+}
+
+bool ParameterClient::LoadCache() {
+  if (cache_->loaded.load()) {
+    return true;
+  }
+  Params params;
+  return CallListParameters(&params) && cache_->Load(params);
 }
 
 bool ParameterClient::GetParameter(const std::string& param_name,
                                    Parameter* parameter) {
+  if (cache_ != nullptr && LoadCache()) {
+    ReadLockGuard<AtomicRWLock> lock(cache_->rw_lock);
+    auto it = cache_->params.find(param_name);
+    if (it == cache_->params.end()) {
+      AWARN << "Parameter " << param_name << " not exists yet.";
+      return false;
+    }
+    parameter->FromProtoParam(it->second);
+    return true;
+  }
   auto request = std::make_shared<ParamName>();
   request->set_value(param_name);
   auto response = get_parameter_client_->SendRequest(request);
@@ -62,14 +184,20 @@ bool ParameterClient::SetParameter(const Parameter& parameter) {
 }
 
 bool ParameterClient::ListParameters(std::vector<Parameter>* parameters) {
-  auto request = std::make_shared<NodeName>();
-  request->set_value(node_->Name());
-  auto response = list_parameters_client_->SendRequest(request);
-  if (response == nullptr) {
-    AERROR << "Call " << list_parameters_client_->ServiceName() << " failed";
+  if (cache_ != nullptr && LoadCache()) {
+    ReadLockGuard<AtomicRWLock> lock(cache_->rw_lock);
+    for (auto& item : cache_->params) {
+      Parameter parameter;
+      parameter.FromProtoParam(item.second);
+      parameters->emplace_back(parameter);
+    }
+    return true;
+  }
+  Params params;
+  if (!CallListParameters(&params)) {
     return false;
   }
-  for (auto& param : response->param()) {
+  for (auto& param : params.param()) {
     Parameter parameter;
     parameter.FromProtoParam(param);
     parameters->emplace_back(parameter);
@@ -17,10 +17,14 @@
 #ifndef CYBER_PARAMETER_PARAMETER_CLIENT_H_
 #define CYBER_PARAMETER_PARAMETER_CLIENT_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/node/reader.h"
 #include "cyber/parameter/parameter.h"
 #include "cyber/proto/parameter.pb.h"
 #include "cyber/service/client.h"
@@ -37,17 +41,34 @@ class ParameterClient {
   using ParamName = apollo::cyber::proto::ParamName;
   using BoolResult = apollo::cyber::proto::BoolResult;
   using Params = apollo::cyber::proto::Params;
+  using ParamUpdate = apollo::cyber::proto::ParamUpdate;
   using GetParameterClient = Client<ParamName, Param>;
   using SetParameterClient = Client<Param, BoolResult>;
   using ListParametersClient = Client<NodeName, Params>;
   /**
    * @brief Construct a new ParameterClient object
    *
+   * With use_cache, the parameters of the server are loaded into a local
+   * cache, kept up to date by the changes the server publishes, and
+   * GetParameter() and ListParameters() read the cache instead of calling
+   * the services. Guarantees of the cache:
+   * - it holds the parameters as of some change of the server, and goes
+   *   through the later changes in the order the server made them;
+   * - a lost change or a restarted server is noticed at the next change,
+   *   and the cache is loaded again by the next read;
+   * - a change, even one by this client, is seen once its notification
+   *   arrives, so a read right after SetParameter() may miss it;
+   * - reads keep answering from the cache while the server is gone.
+   * Only one cached client per node and server is possible, the others
+   * call the services.
+   *
    * @param node shared_ptr of the node handler
    * @param service_node_name node name which provide a param services
+   * @param use_cache read a local cache of the parameters
    */
   ParameterClient(const std::shared_ptr<Node>& node,
-                  const std::string& service_node_name);
+                  const std::string& service_node_name,
+                  bool use_cache = false);
 
   /**
    * @brief Get the Parameter object
@@ -80,10 +101,33 @@ class ParameterClient {
   bool ListParameters(std::vector<Parameter>* parameters);
 
  private:
+  struct Cache {
+    // Applies a change, or keeps it while the cache is not loaded.
+    void Update(const ParamUpdate& update);
+    // Replaces the parameters with those of the server, then applies the
+    // changes received meanwhile. False if some change is missing.
+    bool Load(const Params& params);
+    bool ApplyUpdate(const ParamUpdate& update);
+
+    base::AtomicRWLock rw_lock;
+    std::unordered_map<std::string, Param> params;
+    uint64_t version = 0;
+    uint64_t epoch = 0;
+    std::atomic<bool> loaded = {false};
+    std::vector<ParamUpdate> pending_updates;
+  };
+
+  bool CallListParameters(Params* params);
+  bool LoadCache();
+
   std::shared_ptr<Node> node_;
   std::shared_ptr<GetParameterClient> get_parameter_client_;
   std::shared_ptr<SetParameterClient> set_parameter_client_;
   std::shared_ptr<ListParametersClient> list_parameters_client_;
+
+  // nullptr unless use_cache, shared with the callback of the reader
+  std::shared_ptr<Cache> cache_;
+  std::shared_ptr<Reader<ParamUpdate>> param_update_reader_;
 };
 
 }  // namespace cyber
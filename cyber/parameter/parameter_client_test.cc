@@ -88,6 +88,32 @@ TEST_F(ParameterClientTest, list_parameter) {
   EXPECT_FALSE(pc_->ListParameters(&parameters));
 }
 
+TEST_F(ParameterClientTest, cached_parameter) {
+  ps_->SetParameter(Parameter("int", 1));
+  ParameterClient cached_pc(node_, "parameter_server", true);
+  Parameter parameter;
+  EXPECT_TRUE(cached_pc.GetParameter("int", &parameter));
+  EXPECT_EQ(1, parameter.AsInt64());
+  EXPECT_FALSE(cached_pc.GetParameter("double", &parameter));
+
+  // set on the server, and through a client
+  ps_->SetParameter(Parameter("int", 2));
+  EXPECT_TRUE(pc_->SetParameter(Parameter("double", 0.5)));
+  usleep(100000);
+  EXPECT_TRUE(cached_pc.GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+  EXPECT_TRUE(cached_pc.GetParameter("double", &parameter));
+  EXPECT_DOUBLE_EQ(0.5, parameter.AsDouble());
+  std::vector<Parameter> parameters;
+  EXPECT_TRUE(cached_pc.ListParameters(&parameters));
+  EXPECT_EQ(2, parameters.size());
+
+  // the cache still answers
+  ps_.reset();
+  EXPECT_TRUE(cached_pc.GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+}
+
 }  // namespace cyber
 }  // namespace apollo
 
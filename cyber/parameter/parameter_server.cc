@@ -17,13 +17,19 @@
 #include "cyber/common/log.h"
 #include "cyber/node/node.h"
 #include "cyber/parameter/parameter_service_names.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
 ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
-    : node_(node) {
+    : node_(node), epoch_(Time::Now().ToNanosecond()) {
   auto name = node_->Name();
+  param_update_writer_ = node_->CreateWriter<ParamUpdate>(
+      FixParameterServiceName(name, PARAMETER_UPDATES_CHANNEL_NAME));
+  if (param_update_writer_ == nullptr) {
+    AWARN << "Parameter changes of " << name << " will not be published.";
+  }
   get_parameter_service_ = node_->CreateService<ParamName, Param>(
       FixParameterServiceName(name, GET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<ParamName>& request,
@@ -40,8 +46,7 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
       FixParameterServiceName(name, SET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<Param>& request,
              std::shared_ptr<BoolResult>& response) {
-        std::lock_guard<std::mutex> lock(param_map_mutex_);
-        param_map_[request->name()] = *request;
+        SetParam(*request);
         response->set_value(true);
       });
 
@@ -54,12 +59,26 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
           auto param = response->add_param();
           param->CopyFrom(item.second);
         }
+        response->set_version(version_);
+        response->set_epoch(epoch_);
       });
 }
 
 void ParameterServer::SetParameter(const Parameter& parameter) {
+  SetParam(parameter.ToProtoParam());
+}
+
+void ParameterServer::SetParam(const Param& param) {
+  auto update = std::make_shared<ParamUpdate>();
+  update->mutable_param()->CopyFrom(param);
+  // published under the lock, so the changes go out in version order
   std::lock_guard<std::mutex> lock(param_map_mutex_);
-  param_map_[parameter.Name()] = parameter.ToProtoParam();
+  param_map_[param.name()] = param;
+  update->set_version(++version_);
+  update->set_epoch(epoch_);
+  if (param_update_writer_ != nullptr) {
+    param_update_writer_->Write(update);
+  }
 }
 
 bool ParameterServer::GetParameter(const std::string& parameter_name,
@@ -38,8 +38,10 @@ class ParameterServer {
   using ParamName = apollo::cyber::proto::ParamName;
   using BoolResult = apollo::cyber::proto::BoolResult;
   using Params = apollo::cyber::proto::Params;
+  using ParamUpdate = apollo::cyber::proto::ParamUpdate;
   /**
-   * @brief Construct a new ParameterServer object
+   * @brief Construct a new ParameterServer object, which publishes every
+   * change of its parameters for the caches of ParameterClient
    *
    * @param node shared_ptr of the node handler
    */
@@ -70,13 +72,20 @@ class ParameterServer {
   void ListParameters(std::vector<Parameter>* parameters);
 
  private:
+  void SetParam(const Param& param);
+
   std::shared_ptr<Node> node_;
   std::shared_ptr<Service<ParamName, Param>> get_parameter_service_;
   std::shared_ptr<Service<Param, BoolResult>> set_parameter_service_;
   std::shared_ptr<Service<NodeName, Params>> list_parameters_service_;
 
+  std::shared_ptr<Writer<ParamUpdate>> param_update_writer_;
+
   std::mutex param_map_mutex_;
   std::unordered_map<std::string, Param> param_map_;
+  // of the last change, published along with it
+  uint64_t version_ = 0;
+  uint64_t epoch_ = 0;
 };
 
 }  // namespace cyber
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "cyber/py_wrapper/py_buffer.h"
 #include "cyber/py_wrapper/py_node.h"
 
 #define PYOBJECT_NULL_STRING PyString_FromStringAndSize("", 0)
@@ -158,11 +159,50 @@ PyObject *cyber_PyReader_read(PyObject *self, PyObject *args) {
 
   bool wait = (r == 1 ? true : false);
 
-  std::string reader_ret = reader->read(wait);
+  // other python threads run while this one waits for a message
+  std::string reader_ret;
+  Py_BEGIN_ALLOW_THREADS
+  reader_ret = reader->read(wait);
+  Py_END_ALLOW_THREADS
   // AINFO << "c++:PyReader_read -> " << reader_ret;
   return PyString_FromStringAndSize(reader_ret.c_str(), reader_ret.size());
 }
 
+PyObject *cyber_PyReader_read_view(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  PyObject *pyobj_iswait = nullptr;
+
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OO:cyber_PyReader_read_view"),
+                        &pyobj_reader, &pyobj_iswait)) {
+    AINFO << "cyber_PyReader_read_view:PyArg_ParseTuple failed!";
+    Py_RETURN_NONE;
+  }
+  apollo::cyber::PyReader *reader = PyObjectToPtr<apollo::cyber::PyReader *>(
+      pyobj_reader, "apollo_cyber_pyreader");
+  if (nullptr == reader) {
+    AINFO << "cyber_PyReader_read_view:PyReader ptr is null!";
+    Py_RETURN_NONE;
+  }
+
+  int r = PyObject_IsTrue(pyobj_iswait);
+  if (r == -1) {
+    AINFO << "cyber_PyReader_read_view:pyobj_iswait is error!";
+    Py_RETURN_NONE;
+  }
+
+  apollo::cyber::PyReader::MessagePtr message;
+  Py_BEGIN_ALLOW_THREADS
+  message = reader->read_message(r == 1);
+  Py_END_ALLOW_THREADS
+  if (message == nullptr) {
+    Py_RETURN_NONE;
+  }
+  // the buffer keeps the received message alive instead of copying it
+  const std::string &data = message->data();
+  return apollo::cyber::NewPyMessageBuffer(message, data.data(), data.size());
+}
+
 PyObject *cyber_PyReader_register_func(PyObject *self, PyObject *args) {
   PyObject *pyobj_regist_fun = 0;
   PyObject *pyobj_reader = 0;
@@ -611,6 +651,7 @@ static PyMethodDef _cyber_node_methods[] = {
     {"delete_PyReader", cyber_delete_PyReader, METH_VARARGS, ""},
     {"PyReader_register_func", cyber_PyReader_register_func, METH_VARARGS, ""},
     {"PyReader_read", cyber_PyReader_read, METH_VARARGS, ""},
+    {"PyReader_read_view", cyber_PyReader_read_view, METH_VARARGS, ""},
 
     // PyClient fun
     {"new_PyClient", cyber_new_PyClient, METH_VARARGS, ""},
@@ -643,5 +684,11 @@ static PyMethodDef _cyber_node_methods[] = {
 
 /// Init function of this module
 PyMODINIT_FUNC init_cyber_node(void) {
-  Py_InitModule("_cyber_node", _cyber_node_methods);
+  PyObject *module = Py_InitModule("_cyber_node", _cyber_node_methods);
+  PyTypeObject *buffer_type = apollo::cyber::PyMessageBufferType();
+  if (module != nullptr && buffer_type != nullptr) {
+    Py_INCREF(buffer_type);
+    PyModule_AddObject(module, "MessageBuffer",
+                       reinterpret_cast<PyObject *>(buffer_type));
+  }
 }
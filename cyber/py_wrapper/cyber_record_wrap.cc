@@ -17,7 +17,10 @@
 #include <Python.h>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "cyber/py_wrapper/py_buffer.h"
 #include "cyber/py_wrapper/py_record.h"
 
 #define PYOBJECT_NULL_STRING PyString_FromStringAndSize("", 0)
@@ -31,6 +34,35 @@ T PyObjectToPtr(PyObject *pyobj, const std::string &type_ptr) {
   return obj_ptr;
 }
 
+void SetDictItem(PyObject *dict, const char *key, PyObject *value) {
+  PyDict_SetItemString(dict, key, value);
+  Py_XDECREF(value);
+}
+
+// With as_view, data is a MessageBuffer taking over the bytes of message.
+PyObject *BagMessageToPyDict(apollo::cyber::record::BagMessage *message,
+                             bool as_view) {
+  PyObject *pyobj_bag_message = PyDict_New();
+  SetDictItem(pyobj_bag_message, "channel_name",
+              PyString_FromStringAndSize(message->channel_name.c_str(),
+                                         message->channel_name.size()));
+  if (as_view) {
+    SetDictItem(pyobj_bag_message, "data",
+                apollo::cyber::NewPyMessageBuffer(std::move(message->data)));
+  } else {
+    SetDictItem(pyobj_bag_message, "data",
+                PyString_FromStringAndSize(message->data.c_str(),
+                                           message->data.size()));
+  }
+  SetDictItem(pyobj_bag_message, "data_type",
+              PyString_FromStringAndSize(message->data_type.c_str(),
+                                         message->data_type.size()));
+  SetDictItem(pyobj_bag_message, "timestamp",
+              PyLong_FromUnsignedLongLong(message->timestamp));
+  SetDictItem(pyobj_bag_message, "end", PyBool_FromLong(message->end));
+  return pyobj_bag_message;
+}
+
 PyObject *cyber_new_PyRecordReader(PyObject *self, PyObject *args) {
   char *filepath = nullptr;
   Py_ssize_t len = 0;
@@ -84,21 +116,48 @@ PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
   }
 
   apollo::cyber::record::BagMessage result;
+  // reading and decompressing chunks needs no python objects
+  Py_BEGIN_ALLOW_THREADS
   result = reader->ReadMessage(begin_time, end_time);
-  PyObject *pyobj_bag_message = PyDict_New();
-  PyDict_SetItemString(pyobj_bag_message, "channel_name",
-                       Py_BuildValue("s", result.channel_name.c_str()));
-  PyDict_SetItemString(
-      pyobj_bag_message, "data",
-      Py_BuildValue("s#", result.data.c_str(), result.data.length()));
-  PyDict_SetItemString(pyobj_bag_message, "data_type",
-                       Py_BuildValue("s", result.data_type.c_str()));
-  PyDict_SetItem(pyobj_bag_message, Py_BuildValue("s", "timestamp"),
-                 Py_BuildValue("K", result.timestamp));
-  PyDict_SetItem(pyobj_bag_message, Py_BuildValue("s", "end"),
-                 result.end ? Py_True : Py_False);
+  Py_END_ALLOW_THREADS
 
-  return pyobj_bag_message;
+  return BagMessageToPyDict(&result, false);
+}
+
+PyObject *cyber_PyRecordReader_ReadMessages(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  Py_ssize_t max_count = 0;
+  uint64_t begin_time = 0;
+  uint64_t end_time = UINT64_MAX;
+  int as_view = 1;
+  if (!PyArg_ParseTuple(
+          args, const_cast<char *>("OnKK|i:PyRecordReader_ReadMessages"),
+          &pyobj_reader, &max_count, &begin_time, &end_time, &as_view)) {
+    return nullptr;
+  }
+
+  auto reader =
+      (apollo::cyber::record::PyRecordReader *)PyCapsule_GetPointer(
+          pyobj_reader, "apollo_cyber_record_pyrecordfilereader");
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessages ptr is null!";
+    return nullptr;
+  }
+  if (max_count <= 0) {
+    return PyList_New(0);
+  }
+
+  std::vector<apollo::cyber::record::BagMessage> messages;
+  Py_BEGIN_ALLOW_THREADS
+  messages = reader->ReadMessages(max_count, begin_time, end_time);
+  Py_END_ALLOW_THREADS
+
+  PyObject *pyobj_list = PyList_New(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    PyList_SET_ITEM(pyobj_list, i,
+                    BagMessageToPyDict(&messages[i], as_view != 0));
+  }
+  return pyobj_list;
 }
 
 PyObject *cyber_PyRecordReader_GetMessageNumber(PyObject *self,
@@ -506,6 +565,8 @@ static PyMethodDef _cyber_record_methods[] = {
     {"delete_PyRecordReader", cyber_delete_PyRecordReader, METH_VARARGS, ""},
     {"PyRecordReader_ReadMessage", cyber_PyRecordReader_ReadMessage,
      METH_VARARGS, ""},
+    {"PyRecordReader_ReadMessages", cyber_PyRecordReader_ReadMessages,
+     METH_VARARGS, ""},
     {"PyRecordReader_GetMessageNumber", cyber_PyRecordReader_GetMessageNumber,
      METH_VARARGS, ""},
     {"PyRecordReader_GetMessageType", cyber_PyRecordReader_GetMessageType,
@@ -544,5 +605,11 @@ static PyMethodDef _cyber_record_methods[] = {
 /// Init function of this module
 PyMODINIT_FUNC init_cyber_record(void) {
   AINFO << "init _cyber_record";
-  Py_InitModule("_cyber_record", _cyber_record_methods);
+  PyObject *module = Py_InitModule("_cyber_record", _cyber_record_methods);
+  PyTypeObject *buffer_type = apollo::cyber::PyMessageBufferType();
+  if (module != nullptr && buffer_type != nullptr) {
+    Py_INCREF(buffer_type);
+    PyModule_AddObject(module, "MessageBuffer",
+                       reinterpret_cast<PyObject *>(buffer_type));
+  }
 }
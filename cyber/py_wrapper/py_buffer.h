@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef PYTHON_WRAPPER_PY_BUFFER_H_
+#define PYTHON_WRAPPER_PY_BUFFER_H_
+
+#include <Python.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+
+// A read-only Python object over message bytes C++ keeps alive, exposed
+// through the buffer protocols, so that numpy.frombuffer, memoryview or
+// struct.unpack_from read them in place. str() copies them.
+struct PyMessageBuffer {
+  PyObject_HEAD
+  std::shared_ptr<const void>* owner;
+  const char* data;
+  Py_ssize_t size;
+};
+
+inline PyMessageBuffer* AsPyMessageBuffer(PyObject* self) {
+  return reinterpret_cast<PyMessageBuffer*>(self);
+}
+
+inline void PyMessageBuffer_dealloc(PyObject* self) {
+  delete AsPyMessageBuffer(self)->owner;
+  PyObject_Del(self);
+}
+
+inline int PyMessageBuffer_getbuffer(PyObject* self, Py_buffer* view,
+                                     int flags) {
+  auto buffer = AsPyMessageBuffer(self);
+  return PyBuffer_FillInfo(view, self, const_cast<char*>(buffer->data),
+                           buffer->size, 1, flags);
+}
+
+// the old buffer protocol, still the one most of python 2 asks for
+inline Py_ssize_t PyMessageBuffer_getreadbuffer(PyObject* self,
+                                                Py_ssize_t segment,
+                                                void** ptr) {
+  if (segment != 0) {
+    PyErr_SetString(PyExc_SystemError,
+                    "accessing non-existent buffer segment");
+    return -1;
+  }
+  auto buffer = AsPyMessageBuffer(self);
+  *ptr = const_cast<char*>(buffer->data);
+  return buffer->size;
+}
+
+inline Py_ssize_t PyMessageBuffer_getcharbuffer(PyObject* self,
+                                                Py_ssize_t segment,
+                                                char** ptr) {
+  return PyMessageBuffer_getreadbuffer(self, segment,
+                                       reinterpret_cast<void**>(ptr));
+}
+
+inline Py_ssize_t PyMessageBuffer_getsegcount(PyObject* self,
+                                              Py_ssize_t* lenp) {
+  if (lenp != nullptr) {
+    *lenp = AsPyMessageBuffer(self)->size;
+  }
+  return 1;
+}
+
+inline Py_ssize_t PyMessageBuffer_length(PyObject* self) {
+  return AsPyMessageBuffer(self)->size;
+}
+
+inline PyObject* PyMessageBuffer_str(PyObject* self) {
+  auto buffer = AsPyMessageBuffer(self);
+  return PyString_FromStringAndSize(buffer->data, buffer->size);
+}
+
+// Readied on the first call, which must hold the GIL.
+inline PyTypeObject* PyMessageBufferType() {
+  static PyTypeObject type;
+  static PyBufferProcs buffer_procs;
+  static PySequenceMethods sequence_methods;
+  static bool ready = [] {
+    buffer_procs.bf_getreadbuffer = PyMessageBuffer_getreadbuffer;
+    buffer_procs.bf_getsegcount = PyMessageBuffer_getsegcount;
+    buffer_procs.bf_getcharbuffer = PyMessageBuffer_getcharbuffer;
+    buffer_procs.bf_getbuffer = PyMessageBuffer_getbuffer;
+    sequence_methods.sq_length = PyMessageBuffer_length;
+
+    Py_REFCNT(&type) = 1;
+    type.tp_name = "cyber.MessageBuffer";
+    type.tp_basicsize = sizeof(PyMessageBuffer);
+    type.tp_dealloc = PyMessageBuffer_dealloc;
+    type.tp_as_sequence = &sequence_methods;
+    type.tp_as_buffer = &buffer_procs;
+    type.tp_str = PyMessageBuffer_str;
+    type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER;
+    type.tp_doc = "Read-only bytes of a cyber message, shared with C++.";
+    return PyType_Ready(&type) == 0;
+  }();
+  return ready ? &type : nullptr;
+}
+
+// A buffer over size bytes at data, which owner keeps valid.
+inline PyObject* NewPyMessageBuffer(std::shared_ptr<const void> owner,
+                                    const char* data, size_t size) {
+  PyTypeObject* type = PyMessageBufferType();
+  if (type == nullptr) {
+    return nullptr;
+  }
+  PyMessageBuffer* buffer = PyObject_New(PyMessageBuffer, type);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  buffer->owner = new std::shared_ptr<const void>(std::move(owner));
+  buffer->data = data;
+  buffer->size = static_cast<Py_ssize_t>(size);
+  return reinterpret_cast<PyObject*>(buffer);
+}
+
+// A buffer taking over data, without copying it.
+inline PyObject* NewPyMessageBuffer(std::string&& data) {
+  auto owner = std::make_shared<std::string>(std::move(data));
+  const char* bytes = owner->data();
+  size_t size = owner->size();
+  return NewPyMessageBuffer(std::move(owner), bytes, size);
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // PYTHON_WRAPPER_PY_BUFFER_H_
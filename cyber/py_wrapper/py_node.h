@@ -84,6 +84,9 @@ class PyWriter {
 
 class PyReader {
  public:
+  using MessagePtr =
+      std::shared_ptr<const apollo::cyber::message::PyMessageWrap>;
+
   PyReader(const std::string &channel, const std::string &type,
            apollo::cyber::Node *node)
       : node_(node), channel_name_(channel), data_type_(type), func_(nullptr) {
@@ -99,7 +102,17 @@ class PyReader {
   void register_func(int (*func)(const char *)) { func_ = func; }
 
   std::string read(bool wait = false) {
-    std::string msg("");
+    auto message = read_message(wait);
+    if (message == nullptr) {
+      return std::string("");
+    }
+    return message->data();
+  }
+
+  // The received message itself, so that its bytes can be viewed in place,
+  // nullptr when there is none and wait is false.
+  MessagePtr read_message(bool wait = false) {
+    MessagePtr msg = nullptr;
     std::unique_lock<std::mutex> ul(msg_lock_);
     if (!cache_.empty()) {
       msg = std::move(cache_.front());
@@ -120,11 +133,10 @@ class PyReader {
   }
 
  private:
-  void cb(const std::shared_ptr<const apollo::cyber::message::PyMessageWrap>
-              &message) {
+  void cb(const MessagePtr &message) {
     {
       std::lock_guard<std::mutex> lg(msg_lock_);
-      cache_.push_back(message->data());
+      cache_.push_back(message);
     }
     if (func_) {
       func_(channel_name_.c_str());
@@ -138,7 +150,7 @@ class PyReader {
   int (*func_)(const char *) = nullptr;
   std::shared_ptr<apollo::cyber::Reader<apollo::cyber::message::PyMessageWrap>>
       reader_;
-  std::deque<std::string> cache_;
+  std::deque<MessagePtr> cache_;
   std::mutex msg_lock_;
   std::condition_variable msg_cond_;
 };
@@ -25,6 +25,8 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "cyber/cyber.h"
 #include "cyber/init.h"
@@ -69,14 +71,30 @@ class PyRecordReader {
     }
 
     ret_msg.end = false;
-    ret_msg.channel_name = record_message.channel_name;
-    ret_msg.data = record_message.content;
+    ret_msg.channel_name = std::move(record_message.channel_name);
+    ret_msg.data = std::move(record_message.content);
     ret_msg.timestamp = record_message.time;
-    ret_msg.data_type =
-        record_reader_->GetMessageType(record_message.channel_name);
+    ret_msg.data_type = record_reader_->GetMessageType(ret_msg.channel_name);
     return ret_msg;
   }
 
+  // Up to max_count messages at once, none at the end of the record, so
+  // that python crosses into C++ once per batch.
+  std::vector<BagMessage> ReadMessages(size_t max_count,
+                                       uint64_t begin_time = 0,
+                                       uint64_t end_time = UINT64_MAX) {
+    std::vector<BagMessage> messages;
+    messages.reserve(max_count);
+    while (messages.size() < max_count) {
+      BagMessage message = ReadMessage(begin_time, end_time);
+      if (message.end) {
+        break;
+      }
+      messages.push_back(std::move(message));
+    }
+    return messages;
+  }
+
   uint64_t GetMessageNumber(const std::string& channel_name) {
     return record_reader_->GetMessageNumber(channel_name);
   }
@@ -69,6 +69,29 @@ TEST(CyberRecordTest, record_readerwriter) {
   EXPECT_TRUE(header.is_complete());
 }
 
+TEST(CyberRecordTest, read_messages) {
+  apollo::cyber::record::PyRecordWriter rec_writer;
+
+  EXPECT_TRUE(rec_writer.Open(TEST_FILE));
+  rec_writer.WriteChannel(CHAN_2, MSG_TYPE, STR_10B);
+  for (uint64_t i = 0; i < 5; ++i) {
+    rec_writer.WriteMessage(CHAN_2, STR_10B, 100 + i);
+  }
+  rec_writer.Close();
+
+  apollo::cyber::record::PyRecordReader rec_reader(TEST_FILE);
+  auto messages = rec_reader.ReadMessages(3);
+  ASSERT_EQ(3, messages.size());
+  EXPECT_EQ(CHAN_2, messages[0].channel_name);
+  EXPECT_EQ(STR_10B, messages[0].data);
+  EXPECT_EQ(100, messages[0].timestamp);
+  EXPECT_EQ(102, messages[2].timestamp);
+  messages = rec_reader.ReadMessages(3);
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ(104, messages[1].timestamp);
+  EXPECT_TRUE(rec_reader.ReadMessages(3).empty());
+}
+
 int main(int argc, char** argv) {
   apollo::cyber::Init(argv[0]);
   testing::InitGoogleTest(&argc, argv);
@@ -66,6 +66,29 @@ class RecordReader(object):
                 #print "No message more."
                 break
 
+    def read_messages_batch(self, start_time=0, end_time=18446744073709551615,
+                            batch_size=64, zero_copy=True):
+        """
+        read message from bag file, batch_size messages per call into C++.
+        @param self
+        @param start_time:
+        @param end_time:
+        @param batch_size: messages read while the GIL is released
+        @param zero_copy: message is a read-only buffer over the record data,
+                          numpy.frombuffer and memoryview read it in place,
+                          str(message) copies it
+        @return: generator of (message, data_type, timestamp)
+        """
+        while True:
+            messages = _CYBER_RECORD.PyRecordReader_ReadMessages(
+                self.record_reader, batch_size, start_time, end_time,
+                1 if zero_copy else 0)
+            for message in messages:
+                yield PyBagMessage(message["channel_name"], message["data"],
+                                   message["data_type"], message["timestamp"])
+            if len(messages) < batch_size:
+                break
+
     def get_messagenumber(self, channel_name):
         """
         return message count.
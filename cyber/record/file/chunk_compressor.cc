@@ -0,0 +1,184 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "cyber/record/file/chunk_compressor.h"
+
+#include <lz4frame.h>
+#include <zstd.h>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+namespace {
+
+const size_t kDecompressStep = 256 * 1024;
+
+}  // namespace
+
+bool ChunkCompressor::IsSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_LZ4 ||
+         type == CompressType::COMPRESS_ZSTD;
+}
+
+bool ChunkCompressor::Compress(CompressType type, const std::string& raw,
+                               std::string* compressed) {
+  RETURN_VAL_IF_NULL(compressed, false);
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      *compressed = raw;
+      return true;
+    case CompressType::COMPRESS_LZ4:
+      return CompressLz4(raw, compressed);
+    case CompressType::COMPRESS_ZSTD:
+      return CompressZstd(raw, compressed);
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+}
+
+bool ChunkCompressor::Decompress(CompressType type, const char* data,
+                                 size_t size, std::string* raw) {
+  RETURN_VAL_IF_NULL(data, false);
+  RETURN_VAL_IF_NULL(raw, false);
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      raw->append(data, size);
+      return true;
+    case CompressType::COMPRESS_LZ4:
+      return DecompressLz4(data, size, raw);
+    case CompressType::COMPRESS_ZSTD:
+      return DecompressZstd(data, size, raw);
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+}
+
+bool ChunkCompressor::CompressLz4(const std::string& raw,
+                                  std::string* compressed) {
+  LZ4F_preferences_t prefs = {};
+  prefs.frameInfo.contentSize = raw.size();
+  compressed->resize(LZ4F_compressFrameBound(raw.size(), &prefs));
+  size_t ret = LZ4F_compressFrame(&(*compressed)[0], compressed->size(),
+                                  raw.data(), raw.size(), &prefs);
+  if (LZ4F_isError(ret)) {
+    AERROR << "LZ4 compress failed: " << LZ4F_getErrorName(ret);
+    return false;
+  }
+  compressed->resize(ret);
+  return true;
+}
+
+bool ChunkCompressor::DecompressLz4(const char* data, size_t size,
+                                    std::string* raw) {
+  LZ4F_dctx* dctx = nullptr;
+  size_t ret = LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+  if (LZ4F_isError(ret)) {
+    AERROR << "LZ4 create context failed: " << LZ4F_getErrorName(ret);
+    return false;
+  }
+
+  size_t begin = raw->size();
+  LZ4F_frameInfo_t frame_info;
+  size_t src_size = size;
+  ret = LZ4F_getFrameInfo(dctx, &frame_info, data, &src_size);
+  if (!LZ4F_isError(ret) && frame_info.contentSize > 0) {
+    raw->reserve(begin + frame_info.contentSize);
+  }
+  const char* src = data + src_size;
+  const char* end = data + size;
+  bool output_full = false;
+  while (!LZ4F_isError(ret) && ret != 0 && (src < end || output_full)) {
+    size_t offset = raw->size();
+    raw->resize(offset + kDecompressStep);
+    size_t dst_size = kDecompressStep;
+    src_size = end - src;
+    ret = LZ4F_decompress(dctx, &(*raw)[offset], &dst_size, src, &src_size,
+                          nullptr);
+    raw->resize(offset + dst_size);
+    src += src_size;
+    output_full = dst_size == kDecompressStep;
+  }
+  LZ4F_freeDecompressionContext(dctx);
+
+  if (LZ4F_isError(ret)) {
+    AERROR << "LZ4 decompress failed: " << LZ4F_getErrorName(ret);
+    return false;
+  }
+  if (ret != 0) {
+    AERROR << "LZ4 frame is truncated.";
+    return false;
+  }
+  return true;
+}
+
+bool ChunkCompressor::CompressZstd(const std::string& raw,
+                                   std::string* compressed) {
+  compressed->resize(ZSTD_compressBound(raw.size()));
+  size_t ret = ZSTD_compress(&(*compressed)[0], compressed->size(), raw.data(),
+                             raw.size(), kZstdLevel);
+  if (ZSTD_isError(ret)) {
+    AERROR << "ZSTD compress failed: " << ZSTD_getErrorName(ret);
+    return false;
+  }
+  compressed->resize(ret);
+  return true;
+}
+
+bool ChunkCompressor::DecompressZstd(const char* data, size_t size,
+                                     std::string* raw) {
+  unsigned long long content_size =  // NOLINT
+      ZSTD_getFrameContentSize(data, size);
+  if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+      content_size != ZSTD_CONTENTSIZE_ERROR) {
+    raw->reserve(raw->size() + content_size);
+  }
+
+  ZSTD_DStream* dstream = ZSTD_createDStream();
+  RETURN_VAL_IF_NULL(dstream, false);
+  ZSTD_initDStream(dstream);
+  ZSTD_inBuffer input = {data, size, 0};
+  size_t ret = 0;
+  bool output_full = false;
+  do {
+    size_t offset = raw->size();
+    raw->resize(offset + kDecompressStep);
+    ZSTD_outBuffer output = {&(*raw)[offset], kDecompressStep, 0};
+    ret = ZSTD_decompressStream(dstream, &output, &input);
+    raw->resize(offset + output.pos);
+    output_full = output.pos == kDecompressStep;
+  } while (!ZSTD_isError(ret) && ret != 0 &&
+           (input.pos < input.size || output_full));
+  ZSTD_freeDStream(dstream);
+
+  if (ZSTD_isError(ret)) {
+    AERROR << "ZSTD decompress failed: " << ZSTD_getErrorName(ret);
+    return false;
+  }
+  if (ret != 0) {
+    AERROR << "ZSTD frame is truncated.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
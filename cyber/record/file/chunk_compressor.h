@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+#define CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+
+#include <cstddef>
+#include <string>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using ::apollo::cyber::proto::CompressType;
+
+// Compresses the serialized chunk body sections of a record file. Both
+// codecs write self-describing frames, so the section size on disk is the
+// compressed size and no extra framing is needed.
+class ChunkCompressor {
+ public:
+  static bool IsSupported(CompressType type);
+  static bool Compress(CompressType type, const std::string& raw,
+                       std::string* compressed);
+  // streaming decompression, appends the raw bytes to `raw`
+  static bool Decompress(CompressType type, const char* data, size_t size,
+                         std::string* raw);
+
+ private:
+  static bool CompressLz4(const std::string& raw, std::string* compressed);
+  static bool DecompressLz4(const char* data, size_t size, std::string* raw);
+  static bool CompressZstd(const std::string& raw, std::string* compressed);
+  static bool DecompressZstd(const char* data, size_t size, std::string* raw);
+
+  // fast enough for recording on the vehicle
+  static const int kZstdLevel = 3;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compressor.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+TEST(ChunkCompressorTest, round_trip) {
+  std::string raw;
+  for (int i = 0; i < 100000; ++i) {
+    raw.append(std::to_string(i));
+  }
+
+  for (auto type : {CompressType::COMPRESS_NONE, CompressType::COMPRESS_LZ4,
+                    CompressType::COMPRESS_ZSTD}) {
+    EXPECT_TRUE(ChunkCompressor::IsSupported(type));
+    std::string compressed;
+    EXPECT_TRUE(ChunkCompressor::Compress(type, raw, &compressed));
+    if (type != CompressType::COMPRESS_NONE) {
+      EXPECT_LT(compressed.size(), raw.size());
+    }
+    std::string decompressed;
+    EXPECT_TRUE(ChunkCompressor::Decompress(type, compressed.data(),
+                                            compressed.size(), &decompressed));
+    EXPECT_EQ(raw, decompressed);
+  }
+}
+
+TEST(ChunkCompressorTest, empty_input) {
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    std::string compressed;
+    EXPECT_TRUE(ChunkCompressor::Compress(type, "", &compressed));
+    std::string decompressed;
+    EXPECT_TRUE(ChunkCompressor::Decompress(type, compressed.data(),
+                                            compressed.size(), &decompressed));
+    EXPECT_TRUE(decompressed.empty());
+  }
+}
+
+TEST(ChunkCompressorTest, corrupted_input) {
+  std::string raw(1024 * 1024, 'r');
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    std::string compressed;
+    EXPECT_TRUE(ChunkCompressor::Compress(type, raw, &compressed));
+    std::string decompressed;
+    EXPECT_FALSE(ChunkCompressor::Decompress(
+        type, compressed.data(), compressed.size() / 2, &decompressed));
+  }
+  EXPECT_FALSE(ChunkCompressor::IsSupported(CompressType::COMPRESS_BZ2));
+  std::string compressed;
+  EXPECT_FALSE(
+      ChunkCompressor::Compress(CompressType::COMPRESS_BZ2, raw, &compressed));
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
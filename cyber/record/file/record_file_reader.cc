@@ -16,6 +16,13 @@
 
 #include "cyber/record/file/record_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <climits>
+#include <cstring>
+
+#include <google/protobuf/wire_format_lite.h>
+
 #include "cyber/common/file.h"
 
 namespace apollo {
@@ -24,7 +31,7 @@ namespace record {
 
 RecordFileReader::RecordFileReader() : end_of_file_(false) {}
 
-RecordFileReader::~RecordFileReader() {}
+RecordFileReader::~RecordFileReader() { UnmapFile(); }
 
 bool RecordFileReader::Open(const std::string& path) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -47,7 +54,10 @@ bool RecordFileReader::Open(const std::string& path) {
   return true;
 }
 
-void RecordFileReader::Close() { close(fd_); }
+void RecordFileReader::Close() {
+  UnmapFile();
+  close(fd_);
+}
 
 bool RecordFileReader::Reset() {
   if (!SetPosition(sizeof(struct Section) + HEADER_LENGTH)) {
@@ -76,6 +86,10 @@ bool RecordFileReader::ReadHeader() {
               "file.";
     return false;
   }
+  if (!ChunkCompressor::IsSupported(header_.compress())) {
+    AERROR << "Unsupported compress type: " << header_.compress();
+    return false;
+  }
   if (!SetPosition(sizeof(struct Section) + HEADER_LENGTH)) {
     AERROR << "Skip bytes for reaching the nex section failed.";
     return false;
@@ -130,6 +144,197 @@ bool RecordFileReader::ReadSection(Section* section) {
   return true;
 }
 
+bool RecordFileReader::ReadRawSection(uint64_t size, std::string* data) {
+  data->resize(size);
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t count = read(fd_, &(*data)[offset], size - offset);
+    if (count < 0) {
+      AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
+      return false;
+    } else if (count == 0) {
+      end_of_file_ = true;
+      AERROR << "Section is truncated, expect: " << size
+             << ", actual: " << offset;
+      return false;
+    }
+    offset += count;
+  }
+  return true;
+}
+
+bool RecordFileReader::DecodeChunkBody(const std::string& data,
+                                       ChunkBody* chunk_body) {
+  if (header_.compress() == CompressType::COMPRESS_NONE) {
+    return chunk_body->ParseFromString(data);
+  }
+  std::string raw;
+  if (!ChunkCompressor::Decompress(header_.compress(), data.data(),
+                                   data.size(), &raw)) {
+    AERROR << "Decompress section failed.";
+    return false;
+  }
+  return chunk_body->ParseFromString(raw);
+}
+
+bool RecordFileReader::ReadCompressedSection(
+    uint64_t size, google::protobuf::Message* message) {
+  std::string compressed;
+  if (!ReadRawSection(size, &compressed)) {
+    return false;
+  }
+  std::string raw;
+  if (!ChunkCompressor::Decompress(header_.compress(), compressed.data(),
+                                   compressed.size(), &raw)) {
+    AERROR << "Decompress section failed.";
+    return false;
+  }
+  if (!message->ParseFromString(raw)) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
+bool RecordFileReader::MapFile() {
+  if (mapped_data_ != nullptr) {
+    return true;
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) < 0 || file_stat.st_size == 0) {
+    AERROR << "Stat file failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  void* addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "Map file failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  // chunks are picked through the index, readahead of neighbours is wasted
+  madvise(addr, file_stat.st_size, MADV_RANDOM);
+  mapped_data_ = static_cast<const char*>(addr);
+  mapped_size_ = file_stat.st_size;
+  return true;
+}
+
+void RecordFileReader::UnmapFile() {
+  if (mapped_data_ != nullptr) {
+    munmap(const_cast<char*>(mapped_data_), mapped_size_);
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+  }
+}
+
+bool RecordFileReader::ParseChunkBody(const char* data, size_t size,
+                                      const std::set<std::string>& channels,
+                                      uint64_t message_number,
+                                      ChunkBody* chunk_body) {
+  using google::protobuf::internal::WireFormatLite;
+  chunk_body->Clear();
+  if (channels.empty() && message_number == 0) {
+    return chunk_body->ParseFromArray(data, static_cast<int>(size));
+  }
+
+  // walk the wire format of ChunkBody, a SingleMessage is serialized with
+  // its channel_name first so other channels are skipped by length
+  const uint32_t kMessagesTag = WireFormatLite::MakeTag(
+      ChunkBody::kMessagesFieldNumber,
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const uint32_t kChannelNameTag = WireFormatLite::MakeTag(
+      SingleMessage::kChannelNameFieldNumber,
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(data),
+                         static_cast<int>(size));
+  uint64_t kept_number = 0;
+  uint32_t tag = 0;
+  while ((tag = input.ReadTag()) != 0) {
+    if (tag != kMessagesTag) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length = 0;
+    if (!input.ReadVarint32(&length)) {
+      return false;
+    }
+    const int begin = input.CurrentPosition();
+    auto limit = input.PushLimit(length);
+    std::string channel_name;
+    bool has_name = input.ReadTag() == kChannelNameTag &&
+                    WireFormatLite::ReadString(&input, &channel_name);
+    if (!has_name) {
+      // unusual field order, fall back to parsing the whole message
+      SingleMessage message;
+      if (!message.ParseFromArray(data + begin, length)) {
+        return false;
+      }
+      channel_name = message.channel_name();
+      if (channels.empty() || channels.count(channel_name) > 0) {
+        chunk_body->add_messages()->Swap(&message);
+        ++kept_number;
+      }
+      input.Skip(input.BytesUntilLimit());
+    } else if (channels.empty() || channels.count(channel_name) > 0) {
+      auto message = chunk_body->add_messages();
+      if (!message->MergeFromCodedStream(&input)) {
+        return false;
+      }
+      message->set_channel_name(channel_name);
+      ++kept_number;
+    } else if (!input.Skip(input.BytesUntilLimit())) {
+      return false;
+    }
+    input.PopLimit(limit);
+    if (message_number > 0 && kept_number >= message_number) {
+      break;
+    }
+  }
+  return true;
+}
+
+bool RecordFileReader::ReadChunkBodyAt(uint64_t position, ChunkBody* chunk_body,
+                                       const std::set<std::string>& channels,
+                                       uint64_t message_number) {
+  RETURN_VAL_IF_NULL(chunk_body, false);
+  if (!MapFile()) {
+    return false;
+  }
+  Section section;
+  if (position + sizeof(section) > mapped_size_) {
+    AERROR << "Chunk position out of file, position: " << position;
+    return false;
+  }
+  std::memcpy(&section, mapped_data_ + position, sizeof(section));
+  uint64_t data_position = position + sizeof(section);
+  if (section.type != SectionType::SECTION_CHUNK_BODY ||
+      section.size > INT_MAX || data_position + section.size > mapped_size_) {
+    AERROR << "Invalid chunk body section at position: " << position
+           << ", type: " << section.type << ", size: " << section.size;
+    return false;
+  }
+
+  const char* data = mapped_data_ + data_position;
+  madvise(const_cast<char*>(mapped_data_) + (data_position & ~4095UL),
+          section.size + (data_position & 4095UL), MADV_WILLNEED);
+  if (header_.compress() != CompressType::COMPRESS_NONE) {
+    std::string raw;
+    if (!ChunkCompressor::Decompress(header_.compress(), data, section.size,
+                                     &raw)) {
+      AERROR << "Decompress chunk body failed, position: " << position;
+      return false;
+    }
+    return ParseChunkBody(raw.data(), raw.size(), channels, message_number,
+                          chunk_body);
+  }
+  if (!ParseChunkBody(data, section.size, channels, message_number,
+                      chunk_body)) {
+    AERROR << "Parse chunk body failed, position: " << position;
+    return false;
+  }
+  return true;
+}
+
 bool RecordFileReader::SkipSection(uint64_t size) {
   uint64_t c = CurrentPosition();
   if (!SetPosition(c + size)) {
@@ -23,11 +23,14 @@
 #include <google/protobuf/text_format.h>
 #include <fstream>
 #include <memory>
+#include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/record/file/chunk_compressor.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
 #include "cyber/time/time.h"
@@ -53,10 +56,32 @@ class RecordFileReader : public RecordFileBase {
   bool ReadSection(uint64_t size, T* message);
   bool ReadIndex();
   bool EndOfFile() { return end_of_file_; }
+  // Random access read of the chunk body section at `position`, through a
+  // read-only mapping of the file. Does not move the file offset.
+  // A non-empty `channels` keeps only messages of those channels, the others
+  // are skipped without being parsed. Parsing stops after `message_number`
+  // kept messages if it is not 0.
+  bool ReadChunkBodyAt(uint64_t position, ChunkBody* chunk_body,
+                       const std::set<std::string>& channels = {},
+                       uint64_t message_number = 0);
+  // Reads the next `size` bytes of the file as they are stored, e.g. a
+  // chunk body section still compressed, to be copied to another record.
+  bool ReadRawSection(uint64_t size, std::string* data);
+  // Parses a chunk body section read by ReadRawSection().
+  bool DecodeChunkBody(const std::string& data, ChunkBody* chunk_body);
 
  private:
   bool ReadHeader();
+  static bool ParseChunkBody(const char* data, size_t size,
+                             const std::set<std::string>& channels,
+                             uint64_t message_number, ChunkBody* chunk_body);
+  bool MapFile();
+  void UnmapFile();
+  bool ReadCompressedSection(uint64_t size,
+                             google::protobuf::Message* message);
   bool end_of_file_;
+  const char* mapped_data_ = nullptr;
+  size_t mapped_size_ = 0;
 };
 
 template <typename T>
@@ -68,6 +93,10 @@ bool RecordFileReader::ReadSection(uint64_t size, T* message) {
     AERROR << "Size is zero.";
     return false;
   }
+  if (std::is_same<T, ChunkBody>::value &&
+      header_.compress() != CompressType::COMPRESS_NONE) {
+    return ReadCompressedSection(size, message);
+  }
   FileInputStream raw_input(fd_, static_cast<int>(size));
   CodedInputStream coded_input(&raw_input);
   CodedInputStream::Limit limit = coded_input.PushLimit(static_cast<int>(size));
@@ -74,6 +74,27 @@ TEST(ChunkTest, TestAll) {
   ASSERT_TRUE(ck->empty());
 }
 
+TEST(ChunkTest, TestAddSerialized) {
+  Chunk ck;
+  std::string content(STR_10B);
+  ck.add(CHAN_1, content.data(), content.size(), 1e9);
+  ck.add(CHAN_2, content.data(), 5, 2e9);
+  ASSERT_EQ(1e9, ck.header_.begin_time());
+  ASSERT_EQ(2e9, ck.header_.end_time());
+  ASSERT_EQ(15, ck.header_.raw_size());
+  ASSERT_EQ(2, ck.body_.messages_size());
+  ASSERT_EQ(CHAN_2, ck.body_.messages(1).channel_name());
+  ASSERT_EQ("12345", ck.body_.messages(1).content());
+
+  // cleared messages are reused with their buffers
+  const SingleMessage* first = &ck.body_.messages(0);
+  ck.clear();
+  ck.add(CHAN_1, content.data(), content.size(), 3e9);
+  ASSERT_EQ(first, &ck.body_.messages(0));
+  ASSERT_EQ(content, ck.body_.messages(0).content());
+  ASSERT_EQ(1, ck.header_.message_number());
+}
+
 TEST(RecordFileTest, TestOneMessageFile) {
   // writer open one message file
   RecordFileWriter* rfw = new RecordFileWriter();
@@ -212,6 +233,176 @@ TEST(RecordFileTest, TestOneChunkFile) {
   ASSERT_EQ(3, rfw->GetHeader().message_number());
 }
 
+TEST(RecordFileTest, TestManyChunksFile) {
+  RecordFileWriter* rfw = new RecordFileWriter();
+  ASSERT_TRUE(rfw->Open(TEST_FILE));
+  // flush a chunk roughly every 10 messages
+  Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 1000);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  ASSERT_TRUE(rfw->WriteHeader(header));
+
+  Channel chan1;
+  chan1.set_name(CHAN_1);
+  chan1.set_message_type(MSG_TYPE);
+  ASSERT_TRUE(rfw->WriteChannel(chan1));
+
+  const int msg_num = 1000;
+  std::string content(100, 'm');
+  for (int i = 1; i <= msg_num; ++i) {
+    SingleMessage msg;
+    msg.set_channel_name(chan1.name());
+    msg.set_content(content);
+    msg.set_time(i);
+    ASSERT_TRUE(rfw->WriteMessage(msg));
+  }
+  rfw->Close();
+  ASSERT_EQ(msg_num, rfw->GetHeader().message_number());
+  ASSERT_GT(rfw->GetHeader().chunk_number(), 1);
+  ASSERT_EQ(rfw->GetHeader().chunk_number(), rfw->flush_latency().Count());
+  delete rfw;
+
+  RecordFileReader* rfr = new RecordFileReader();
+  ASSERT_TRUE(rfr->Open(TEST_FILE));
+  Section sec;
+  uint64_t next_time = 1;
+  while (rfr->ReadSection(&sec)) {
+    if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+      ASSERT_TRUE(rfr->SkipSection(sec.size));
+      continue;
+    }
+    ChunkBody ckb;
+    ASSERT_TRUE(rfr->ReadSection<ChunkBody>(sec.size, &ckb));
+    for (int i = 0; i < ckb.messages_size(); ++i) {
+      ASSERT_EQ(next_time++, ckb.messages(i).time());
+    }
+  }
+  ASSERT_EQ(msg_num + 1, next_time);
+  delete rfr;
+}
+
+TEST(RecordFileTest, TestCompressedChunkFile) {
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_ZSTD}) {
+    RecordFileWriter* rfw = new RecordFileWriter();
+    ASSERT_TRUE(rfw->Open(TEST_FILE));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+    ASSERT_TRUE(rfw->WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(CHAN_1);
+    chan1.set_message_type(MSG_TYPE);
+    ASSERT_TRUE(rfw->WriteChannel(chan1));
+
+    std::string content(64 * 1024, 'c');
+    for (int i = 1; i <= 3; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(content);
+      msg.set_time(i * 1e9);
+      ASSERT_TRUE(rfw->WriteMessage(msg));
+    }
+    rfw->Close();
+    ASSERT_EQ(1, rfw->GetHeader().chunk_number());
+    delete rfw;
+
+    RecordFileReader* rfr = new RecordFileReader();
+    ASSERT_TRUE(rfr->Open(TEST_FILE));
+    ASSERT_EQ(type, rfr->GetHeader().compress());
+    Section sec;
+    ASSERT_TRUE(rfr->ReadSection(&sec));
+    ASSERT_EQ(SectionType::SECTION_CHANNEL, sec.type);
+    ASSERT_TRUE(rfr->SkipSection(sec.size));
+    ASSERT_TRUE(rfr->ReadSection(&sec));
+    ASSERT_EQ(SectionType::SECTION_CHUNK_HEADER, sec.type);
+    ASSERT_TRUE(rfr->SkipSection(sec.size));
+
+    ASSERT_TRUE(rfr->ReadSection(&sec));
+    ASSERT_EQ(SectionType::SECTION_CHUNK_BODY, sec.type);
+    // the repeated content compresses well
+    ASSERT_LT(sec.size, content.size());
+    ChunkBody ckb;
+    ASSERT_TRUE(rfr->ReadSection<ChunkBody>(sec.size, &ckb));
+    ASSERT_EQ(3, ckb.messages_size());
+    ASSERT_EQ(content, ckb.messages(2).content());
+    ASSERT_EQ(3e9, ckb.messages(2).time());
+    delete rfr;
+  }
+}
+
+TEST(RecordFileTest, TestCopyRawChunk) {
+  const char COPY_FILE[] = "copy.record";
+  RecordFileWriter* rfw = new RecordFileWriter();
+  ASSERT_TRUE(rfw->Open(TEST_FILE));
+  Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  header.set_compress(CompressType::COMPRESS_LZ4);
+  ASSERT_TRUE(rfw->WriteHeader(header));
+  for (int i = 2; i <= 4; ++i) {
+    ASSERT_TRUE(rfw->WriteMessage(i % 2 ? CHAN_1 : CHAN_2, STR_10B, 10, i));
+  }
+  rfw->Close();
+  delete rfw;
+
+  RecordFileReader* rfr = new RecordFileReader();
+  ASSERT_TRUE(rfr->Open(TEST_FILE));
+  Section sec;
+  ASSERT_TRUE(rfr->ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_HEADER, sec.type);
+  ChunkHeader ckh;
+  ASSERT_TRUE(rfr->ReadSection<ChunkHeader>(sec.size, &ckh));
+  ASSERT_TRUE(rfr->ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_BODY, sec.type);
+  std::string raw_body;
+  ASSERT_TRUE(rfr->ReadRawSection(sec.size, &raw_body));
+  ASSERT_EQ(sec.size, raw_body.size());
+  delete rfr;
+
+  // a message written before the copied chunk stays before it
+  rfw = new RecordFileWriter();
+  ASSERT_TRUE(rfw->Open(COPY_FILE));
+  ASSERT_TRUE(rfw->WriteHeader(header));
+  ASSERT_TRUE(rfw->WriteMessage(CHAN_1, STR_10B, 10, 1));
+  ASSERT_TRUE(rfw->WriteRawChunk(ckh, raw_body, {{CHAN_1, 1}, {CHAN_2, 2}}));
+  ASSERT_EQ(2, rfw->GetMessageNumber(CHAN_1));
+  ASSERT_EQ(2, rfw->GetMessageNumber(CHAN_2));
+  rfw->Close();
+  ASSERT_EQ(2, rfw->GetHeader().chunk_number());
+  ASSERT_EQ(4, rfw->GetHeader().message_number());
+  delete rfw;
+
+  rfr = new RecordFileReader();
+  ASSERT_TRUE(rfr->Open(COPY_FILE));
+  uint64_t next_time = 1;
+  while (rfr->ReadSection(&sec)) {
+    if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+      ASSERT_TRUE(rfr->SkipSection(sec.size));
+      continue;
+    }
+    ChunkBody ckb;
+    ASSERT_TRUE(rfr->ReadRawSection(sec.size, &raw_body));
+    ASSERT_TRUE(rfr->DecodeChunkBody(raw_body, &ckb));
+    for (int i = 0; i < ckb.messages_size(); ++i) {
+      ASSERT_EQ(next_time++, ckb.messages(i).time());
+    }
+  }
+  ASSERT_EQ(5, next_time);
+  ASSERT_TRUE(rfr->ReadIndex());
+  Index index = rfr->GetIndex();
+  int chunk_headers = 0;
+  for (const auto& single_index : index.indexes()) {
+    if (single_index.type() == SectionType::SECTION_CHUNK_HEADER) {
+      ++chunk_headers;
+    }
+  }
+  ASSERT_EQ(2, chunk_headers);
+  delete rfr;
+  unlink(COPY_FILE);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -35,7 +35,7 @@ bool RecordFileWriter::Open(const std::string& path) {
   if (::apollo::cyber::common::PathExists(path_)) {
     AWARN << "File exist and overwrite, file: " << path_;
   }
-  fd_ = open(path_.data(), O_CREAT | O_WRONLY,
+  fd_ = open(path_.data(), O_CREAT | O_WRONLY | O_TRUNC,
              S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
   if (fd_ < 0) {
     AERROR << "Open file failed, file: " << path_ << ", fd: " << fd_
@@ -55,29 +55,24 @@ bool RecordFileWriter::Open(const std::string& path) {
 
 void RecordFileWriter::Close() {
   if (is_writing_) {
-    // wait for the flush operation that may exist now
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    // last swap
+    // hand over the last chunk once the flush in progress is done, the flush
+    // thread writes it before exiting
     {
       std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      flush_cv_.wait(flush_lock, [this] { return chunk_flush_->empty(); });
       chunk_flush_.swap(chunk_active_);
-      flush_cv_.notify_one();
-    }
-
-    // wait for the last flush opertation
-    while (!chunk_flush_->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      is_writing_ = false;
+      flush_cv_.notify_all();
     }
-
-    is_writing_ = false;
-    flush_cv_.notify_all();
     if (flush_thread_ && flush_thread_->joinable()) {
       flush_thread_->join();
       flush_thread_ = nullptr;
     }
+    if (flush_latency_.Count() > 0) {
+      AINFO << "Chunk flush latency(ns): " << flush_latency_.ToString()
+            << ", stall count: " << flush_stall_count_.load()
+            << ", file: " << path_;
+    }
 
     if (!WriteIndex()) {
       AERROR << "Write index section failed, file: " << path_;
@@ -98,6 +93,10 @@ void RecordFileWriter::Close() {
 
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (!ChunkCompressor::IsSupported(header.compress())) {
+    AERROR << "Unsupported compress type: " << header.compress();
+    return false;
+  }
   header_ = header;
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
@@ -148,7 +147,23 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
 
 bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
                                   const ChunkBody& chunk_body) {
+  std::map<std::string, uint64_t> channel_message_number;
+  for (const auto& message : chunk_body.messages()) {
+    ++channel_message_number[message.channel_name()];
+  }
+  return WriteChunk(chunk_header, channel_message_number, [&]() {
+    return header_.compress() == CompressType::COMPRESS_NONE
+               ? WriteSection<ChunkBody>(chunk_body)
+               : WriteCompressedChunkBody(chunk_body);
+  });
+}
+
+bool RecordFileWriter::WriteChunk(
+    const ChunkHeader& chunk_header,
+    const std::map<std::string, uint64_t>& channel_message_number,
+    const std::function<bool()>& write_body) {
   std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t chunk_begin = CurrentPosition();
   if (!WriteSection<ChunkHeader>(chunk_header)) {
     AERROR << "Write chunk header fail";
     return false;
@@ -161,8 +176,12 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   chunk_header_cache->set_end_time(chunk_header.end_time());
   chunk_header_cache->set_message_number(chunk_header.message_number());
   chunk_header_cache->set_raw_size(chunk_header.raw_size());
+  for (const auto& item : channel_message_number) {
+    chunk_header_cache->add_channel_name(item.first);
+    chunk_header_cache->add_channel_message_number(item.second);
+  }
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
-  if (!WriteSection<ChunkBody>(chunk_body)) {
+  if (!write_body()) {
     AERROR << "Write chunk body fail";
     return false;
   }
@@ -177,58 +196,157 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   single_index->set_type(SectionType::SECTION_CHUNK_BODY);
   single_index->set_position(CurrentPosition());
   ChunkBodyCache* chunk_body_cache = new ChunkBodyCache();
-  chunk_body_cache->set_message_number(chunk_body.messages_size());
+  chunk_body_cache->set_message_number(chunk_header.message_number());
   single_index->set_allocated_chunk_body_cache(chunk_body_cache);
+
+  // Start writeback of this chunk right away rather than letting dirty pages
+  // pile up until the kernel throttles the writer, and drop the chunks
+  // written before it from the page cache, they are not read back.
+  uint64_t chunk_end = CurrentPosition();
+  sync_file_range(fd_, chunk_begin, chunk_end - chunk_begin,
+                  SYNC_FILE_RANGE_WRITE);
+  if (chunk_begin > dropped_position_) {
+    posix_fadvise(fd_, dropped_position_, chunk_begin - dropped_position_,
+                  POSIX_FADV_DONTNEED);
+    dropped_position_ = chunk_begin;
+  }
   return true;
 }
 
+bool RecordFileWriter::WriteCompressedChunkBody(const ChunkBody& chunk_body) {
+  std::string raw;
+  if (!chunk_body.SerializeToString(&raw)) {
+    AERROR << "Serialize chunk body failed.";
+    return false;
+  }
+  std::string compressed;
+  if (!ChunkCompressor::Compress(header_.compress(), raw, &compressed)) {
+    AERROR << "Compress chunk body failed.";
+    return false;
+  }
+  return WriteRawChunkBody(compressed);
+}
+
+bool RecordFileWriter::WriteRawChunkBody(const std::string& chunk_body) {
+  Section section = {SectionType::SECTION_CHUNK_BODY, chunk_body.size()};
+  ssize_t count = write(fd_, &section, sizeof(section));
+  if (count != sizeof(section)) {
+    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+    return false;
+  }
+  const char* ptr = chunk_body.data();
+  size_t left = chunk_body.size();
+  while (left > 0) {
+    count = write(fd_, ptr, left);
+    if (count < 0) {
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    ptr += count;
+    left -= count;
+  }
+  header_.set_size(CurrentPosition());
+  return true;
+}
+
+bool RecordFileWriter::WriteRawChunk(
+    const ChunkHeader& chunk_header, const std::string& chunk_body,
+    const std::map<std::string, uint64_t>& channel_message_number) {
+  // Flush the pending messages in place so that the file stays in order,
+  // the flush thread is idle while chunk_flush_ is empty.
+  std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  flush_cv_.wait(flush_lock, [this] { return chunk_flush_->empty(); });
+  if (!chunk_active_->empty()) {
+    if (!WriteChunk(chunk_active_->header_, chunk_active_->body_)) {
+      AERROR << "Write chunk fail.";
+    }
+    chunk_active_->clear();
+  }
+  is_stalled_ = false;
+  for (const auto& item : channel_message_number) {
+    channel_message_number_map_[item.first] += item.second;
+  }
+  return WriteChunk(chunk_header, channel_message_number,
+                    [&]() { return WriteRawChunkBody(chunk_body); });
+}
+
 bool RecordFileWriter::WriteMessage(const SingleMessage& message) {
-  chunk_active_->add(message);
-  auto it = channel_message_number_map_.find(message.channel_name());
+  return WriteMessage(message.channel_name(), message.content().data(),
+                      message.content().size(), message.time());
+}
+
+bool RecordFileWriter::WriteMessage(const std::string& channel_name,
+                                    const char* content, size_t size,
+                                    uint64_t time) {
+  std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+  chunk_active_->add(channel_name, content, size, time);
+  auto it = channel_message_number_map_.find(channel_name);
   if (it != channel_message_number_map_.end()) {
     it->second++;
   } else {
-    channel_message_number_map_.insert(
-        std::make_pair(message.channel_name(), 1));
+    channel_message_number_map_.insert(std::make_pair(channel_name, 1));
+  }
+  if (!NeedFlush(*chunk_active_)) {
+    return true;
+  }
+  if (!chunk_flush_->empty()) {
+    // the flush thread is still writing, keep filling the active chunk
+    // instead of blocking the caller, it is swapped once the write is done
+    if (!is_stalled_) {
+      is_stalled_ = true;
+      flush_stall_count_.fetch_add(1);
+    }
+    return true;
+  }
+  chunk_flush_.swap(chunk_active_);
+  flush_cv_.notify_all();
+  return true;
+}
+
+bool RecordFileWriter::NeedFlush(const Chunk& chunk) const {
+  if (chunk.header_.message_number() == 0) {
+    return false;
   }
-  bool need_flush = false;
   if (header_.chunk_interval() > 0 &&
-      message.time() - chunk_active_->header_.begin_time() >
+      chunk.header_.end_time() - chunk.header_.begin_time() >
           header_.chunk_interval()) {
-    need_flush = true;
+    return true;
   }
   if (header_.chunk_raw_size() > 0 &&
-      chunk_active_->header_.raw_size() > header_.chunk_raw_size()) {
-    need_flush = true;
-  }
-  if (!need_flush) {
+      chunk.header_.raw_size() > header_.chunk_raw_size()) {
     return true;
   }
-  {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    chunk_flush_.swap(chunk_active_);
-    flush_cv_.notify_one();
-  }
-  return true;
+  return false;
 }
 
 void RecordFileWriter::Flush() {
-  while (is_writing_) {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  while (true) {
     flush_cv_.wait(flush_lock,
                    [this] { return !chunk_flush_->empty() || !is_writing_; });
-    if (!is_writing_) {
-      break;
-    }
     if (chunk_flush_->empty()) {
-      continue;
+      break;
     }
+
+    // chunk_flush_ is only swapped while empty, so it can be written
+    // without holding the lock writers need
+    flush_lock.unlock();
+    auto begin = std::chrono::steady_clock::now();
     if (!WriteChunk(chunk_flush_->header_, chunk_flush_->body_)) {
       AERROR << "Write chunk fail.";
     }
+    flush_latency_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count());
+    flush_lock.lock();
+
     chunk_flush_->clear();
+    if (is_stalled_ || (is_writing_ && NeedFlush(*chunk_active_))) {
+      is_stalled_ = false;
+      chunk_flush_.swap(chunk_active_);
+    }
+    flush_cv_.notify_all();
   }
-  return;
 }
 
 uint64_t RecordFileWriter::GetMessageNumber(
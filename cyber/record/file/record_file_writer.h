@@ -20,16 +20,21 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/text_format.h>
+#include <atomic>
 #include <condition_variable>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <map>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 
+#include "cyber/base/histogram.h"
 #include "cyber/common/log.h"
+#include "cyber/record/file/chunk_compressor.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
 #include "cyber/time/time.h"
@@ -53,20 +58,31 @@ struct Chunk {
   }
 
   inline void add(const SingleMessage& message) {
+    add(message.channel_name(), message.content().data(),
+        message.content().size(), message.time());
+  }
+
+  // Builds the message in place. Messages dropped by clear() are kept by
+  // the repeated field and reused here together with their buffers, so a
+  // steady stream of messages is appended without allocating.
+  inline void add(const std::string& channel_name, const char* content,
+                  size_t size, uint64_t time) {
     std::lock_guard<std::mutex> lock(mutex_);
     SingleMessage* p_message = body_.add_messages();
-    *p_message = message;
+    p_message->set_channel_name(channel_name);
+    p_message->set_content(content, size);
+    p_message->set_time(time);
     if (0 == header_.begin_time()) {
-      header_.set_begin_time(message.time());
+      header_.set_begin_time(time);
     }
-    if (header_.begin_time() > message.time()) {
-      header_.set_begin_time(message.time());
+    if (header_.begin_time() > time) {
+      header_.set_begin_time(time);
     }
-    if (header_.end_time() < message.time()) {
-      header_.set_end_time(message.time());
+    if (header_.end_time() < time) {
+      header_.set_end_time(time);
     }
     header_.set_message_number(header_.message_number() + 1);
-    header_.set_raw_size(header_.raw_size() + message.content().size());
+    header_.set_raw_size(header_.raw_size() + size);
   }
 
   inline bool empty() { return header_.message_number() == 0; }
@@ -85,11 +101,31 @@ class RecordFileWriter : public RecordFileBase {
   bool WriteHeader(const Header& header);
   bool WriteChannel(const Channel& channel);
   bool WriteMessage(const SingleMessage& message);
+  bool WriteMessage(const std::string& channel_name, const char* content,
+                    size_t size, uint64_t time);
+  // Appends a chunk read by RecordFileReader::ReadRawSection() as it is,
+  // without parsing or compressing it again. The body must be stored the
+  // way the header of this file says, and `channel_message_number` counts
+  // its messages per channel. Messages written before go to the file first.
+  bool WriteRawChunk(
+      const ChunkHeader& chunk_header, const std::string& chunk_body,
+      const std::map<std::string, uint64_t>& channel_message_number);
   uint64_t GetMessageNumber(const std::string& channel_name) const;
+  // times a chunk was due while the previous one was still being flushed
+  uint64_t flush_stall_count() const { return flush_stall_count_; }
+  // time spent writing each chunk, in nanoseconds
+  const base::Histogram& flush_latency() const { return flush_latency_; }
+
  private:
   bool WriteChunk(const ChunkHeader& chunk_header, const ChunkBody& chunk_body);
+  bool WriteChunk(const ChunkHeader& chunk_header,
+                  const std::map<std::string, uint64_t>& channel_message_number,
+                  const std::function<bool()>& write_body);
+  bool NeedFlush(const Chunk& chunk) const;
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteCompressedChunkBody(const ChunkBody& chunk_body);
+  bool WriteRawChunkBody(const std::string& chunk_body);
   bool WriteIndex();
   void Flush();
   bool is_writing_ = false;
@@ -98,6 +134,10 @@ class RecordFileWriter : public RecordFileBase {
   std::shared_ptr<std::thread> flush_thread_ = nullptr;
   std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
+  bool is_stalled_ = false;
+  std::atomic<uint64_t> flush_stall_count_ = {0};
+  base::Histogram flush_latency_;
+  uint64_t dropped_position_ = 0;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
 };
 
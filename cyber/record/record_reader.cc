@@ -16,6 +16,7 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace apollo {
@@ -24,7 +25,7 @@ namespace record {
 
 using proto::SectionType;
 
-RecordReader::~RecordReader() {}
+RecordReader::~RecordReader() { ClearPrefetched(chunk_index_.size()); }
 
 RecordReader::RecordReader(const std::string& file) {
   file_reader_.reset(new RecordFileReader());
@@ -50,15 +51,42 @@ RecordReader::RecordReader(const std::string& file) {
       channel_info_.insert(
           std::make_pair(channel_cache->name(), *channel_cache));
     }
+    BuildChunkIndex();
   }
   file_reader_->Reset();
 }
 
+void RecordReader::BuildChunkIndex() {
+  for (const auto& single_idx : index_.indexes()) {
+    if (single_idx.type() != SectionType::SECTION_CHUNK_HEADER) {
+      continue;
+    }
+    if (!single_idx.has_chunk_header_cache()) {
+      AERROR << "single chunk index does not have chunk_header_cache.";
+      chunk_index_.clear();
+      return;
+    }
+    // the chunk header index points right behind the header section, where
+    // the chunk body section starts
+    ChunkIndex chunk;
+    chunk.cache = &single_idx.chunk_header_cache();
+    chunk.body_position = single_idx.position();
+    chunk.max_end_time = chunk.cache->end_time();
+    chunk_index_.push_back(chunk);
+  }
+  for (size_t i = 1; i < chunk_index_.size(); ++i) {
+    chunk_index_[i].max_end_time = std::max(chunk_index_[i].max_end_time,
+                                            chunk_index_[i - 1].max_end_time);
+  }
+}
+
 void RecordReader::Reset() {
   file_reader_->Reset();
   reach_end_ = false;
   message_index_ = 0;
+  next_chunk_ = 0;
   chunk_ = ChunkBody();
+  ClearPrefetched(chunk_index_.size());
 }
 
 std::set<std::string> RecordReader::GetChannelList() const {
@@ -75,8 +103,8 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     return false;
   }
   while (message_index_ < chunk_.messages_size()) {
-    const auto& next_message = chunk_.messages(message_index_);
-    uint64_t time = next_message.time();
+    auto* next_message = chunk_.mutable_messages(message_index_);
+    uint64_t time = next_message->time();
     if (time > end_time) {
       return false;
     }
@@ -85,8 +113,9 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
       continue;
     }
 
-    message->channel_name = next_message.channel_name();
-    message->content = next_message.content();
+    message->channel_name = next_message->channel_name();
+    // a message is read once per chunk load, hand its content over
+    message->content.swap(*next_message->mutable_content());
     message->time = time;
     return true;
   }
@@ -98,7 +127,134 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   return false;
 }
 
+bool RecordReader::MatchChannelFilter(const proto::ChunkHeaderCache& cache,
+                                      uint64_t* message_number) const {
+  *message_number = 0;
+  // records written without channel names in the index match any filter
+  if (channel_filter_.empty() || cache.channel_name_size() == 0) {
+    return true;
+  }
+  bool has_number =
+      cache.channel_message_number_size() == cache.channel_name_size();
+  bool match = false;
+  for (int i = 0; i < cache.channel_name_size(); ++i) {
+    if (channel_filter_.count(cache.channel_name(i)) > 0) {
+      match = true;
+      if (has_number) {
+        *message_number += cache.channel_message_number(i);
+      }
+    }
+  }
+  return match;
+}
+
+bool RecordReader::ReadNextChunkByIndex(uint64_t begin_time,
+                                        uint64_t end_time) {
+  // chunks before the first one that may reach begin_time are never needed,
+  // jump over them instead of walking their headers
+  auto first = std::lower_bound(
+      chunk_index_.begin() + next_chunk_, chunk_index_.end(), begin_time,
+      [](const ChunkIndex& chunk, uint64_t time) {
+        return chunk.max_end_time < time;
+      });
+  next_chunk_ = first - chunk_index_.begin();
+  while (next_chunk_ < chunk_index_.size()) {
+    const auto& chunk = chunk_index_[next_chunk_];
+    if (chunk.cache->begin_time() > end_time) {
+      // keep the chunk for the following time range
+      return false;
+    }
+    ++next_chunk_;
+    uint64_t message_number = 0;
+    if (chunk.cache->end_time() < begin_time ||
+        !MatchChannelFilter(*chunk.cache, &message_number)) {
+      continue;
+    }
+    if (!ReadChunkByIndex(next_chunk_ - 1, message_number)) {
+      return false;
+    }
+    Prefetch(begin_time);
+    return true;
+  }
+  return false;
+}
+
+bool RecordReader::ReadChunkByIndex(size_t index, uint64_t message_number) {
+  // chunks skipped by a jump forward are never consumed
+  ClearPrefetched(index);
+  const auto& chunk = chunk_index_[index];
+  auto search = prefetched_.find(index);
+  if (search != prefetched_.end()) {
+    auto body = search->second.get();
+    prefetched_.erase(search);
+    if (body == nullptr) {
+      AERROR << "Failed to read chunk body at position: "
+             << chunk.body_position << ", file: " << file_reader_->GetPath();
+      return false;
+    }
+    chunk_.Swap(body.get());
+    return true;
+  }
+  if (!file_reader_->ReadChunkBodyAt(chunk.body_position, &chunk_,
+                                     channel_filter_, message_number)) {
+    AERROR << "Failed to read chunk body at position: " << chunk.body_position
+           << ", file: " << file_reader_->GetPath();
+    return false;
+  }
+  return true;
+}
+
+void RecordReader::Prefetch(uint64_t begin_time) {
+  if (prefetch_window_ == 0) {
+    return;
+  }
+  // the file is mapped by the synchronous read of the first chunk, after
+  // that ReadChunkBodyAt only reads the mapping and is safe on any thread
+  size_t scheduled = 0;
+  for (size_t i = next_chunk_;
+       i < chunk_index_.size() && scheduled < prefetch_window_; ++i) {
+    const auto& chunk = chunk_index_[i];
+    uint64_t message_number = 0;
+    if (chunk.cache->end_time() < begin_time ||
+        !MatchChannelFilter(*chunk.cache, &message_number)) {
+      continue;
+    }
+    ++scheduled;
+    if (prefetched_.count(i) > 0) {
+      continue;
+    }
+    auto reader = file_reader_.get();
+    auto position = chunk.body_position;
+    auto channels = channel_filter_;
+    auto future = prefetch_pool_->Enqueue(
+        [reader, position, channels, message_number]() {
+          auto body = std::make_shared<ChunkBody>();
+          if (!reader->ReadChunkBodyAt(position, body.get(), channels,
+                                       message_number)) {
+            body = nullptr;
+          }
+          return body;
+        });
+    if (!future.valid()) {
+      return;
+    }
+    prefetched_[i] = std::move(future);
+  }
+}
+
+void RecordReader::ClearPrefetched(size_t before) {
+  // a pending decode still reads file_reader_, wait for it before dropping
+  auto end = prefetched_.lower_bound(before);
+  for (auto itr = prefetched_.begin(); itr != end; ++itr) {
+    itr->second.wait();
+  }
+  prefetched_.erase(prefetched_.begin(), end);
+}
+
 bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
+  if (!chunk_index_.empty()) {
+    return ReadNextChunkByIndex(begin_time, end_time);
+  }
   bool skip_next_chunk_body = false;
   while (!reach_end_) {
     Section section;
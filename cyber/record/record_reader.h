@@ -17,11 +17,15 @@
 #ifndef CYBER_RECORD_RECORD_READER_H_
 #define CYBER_RECORD_RECORD_READER_H_
 
+#include <future>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/proto/record.pb.h"
 #include "cyber/record/file/record_file_reader.h"
 #include "cyber/record/record_base.h"
@@ -58,16 +62,54 @@ class RecordReader : public RecordBase {
   const proto::Header& header() const { return header_; }
   const ChannelInfoMap& channel_info() const { return channel_info_; }
 
+  // Reads only messages of these channels when the record has an index,
+  // chunks without them are skipped and other messages are never parsed.
+  // An empty set reads every message.
+  void set_channel_filter(const std::set<std::string>& channels) {
+    ClearPrefetched(chunk_index_.size());
+    channel_filter_ = channels;
+  }
+
+  // Decodes up to |window| upcoming indexed chunks on |pool| while the
+  // current one is consumed. A null pool or a zero window reads every chunk
+  // on the calling thread, which is the default.
+  void set_prefetch(const std::shared_ptr<base::ThreadPool>& pool,
+                    size_t window) {
+    prefetch_pool_ = pool;
+    prefetch_window_ = pool == nullptr ? 0 : window;
+  }
+
  private:
+  struct ChunkIndex {
+    const proto::ChunkHeaderCache* cache;
+    uint64_t body_position;
+    // max end time of this and all previous chunks
+    uint64_t max_end_time;
+  };
+
+  void BuildChunkIndex();
+  bool MatchChannelFilter(const proto::ChunkHeaderCache& cache,
+                          uint64_t* message_number) const;
   bool ReadNextChunk(uint64_t begin_time, uint64_t end_time);
+  bool ReadNextChunkByIndex(uint64_t begin_time, uint64_t end_time);
+  bool ReadChunkByIndex(size_t index, uint64_t message_number);
+  void Prefetch(uint64_t begin_time);
+  void ClearPrefetched(size_t before);
 
   bool is_valid_ = false;
   bool reach_end_ = false;
   proto::ChunkBody chunk_;
   proto::Index index_;
   int message_index_ = 0;
+  std::vector<ChunkIndex> chunk_index_;
+  size_t next_chunk_ = 0;
+  std::set<std::string> channel_filter_;
   ChannelInfoMap channel_info_;
   FileReaderPtr file_reader_;
+  std::shared_ptr<base::ThreadPool> prefetch_pool_;
+  size_t prefetch_window_ = 0;
+  // chunks being decoded on the pool, by position in chunk_index_
+  std::map<size_t, std::future<std::shared_ptr<ChunkBody>>> prefetched_;
 };
 
 }  // namespace record
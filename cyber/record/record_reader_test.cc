@@ -90,6 +90,80 @@ TEST(RecordTest, TestSingleRecordFile) {
   ASSERT_FALSE(reader.ReadMessage(&message, 0, MESSAGE_NUM - 2));
 }
 
+TEST(RecordTest, TestReadByChunkIndex) {
+  // messages 10s apart, so every chunk holds only a few of them
+  const uint64_t kInterval = 10000000000UL;
+  RecordWriter writer;
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(TEST_FILE);
+  writer.WriteChannel(CHANNEL_NAME_1, MESSAGE_TYPE_1, PROTO_DESC);
+  writer.WriteChannel(CHANNEL_NAME_2, MESSAGE_TYPE_2, PROTO_DESC);
+  for (uint32_t i = 0; i < 4 * MESSAGE_NUM; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    writer.WriteMessage(i < 2 * MESSAGE_NUM ? CHANNEL_NAME_1 : CHANNEL_NAME_2,
+                        msg, i * kInterval);
+  }
+  writer.Close();
+
+  RecordReader reader(TEST_FILE);
+  RecordMessage message;
+  ASSERT_TRUE(reader.ReadMessage(&message, 3 * MESSAGE_NUM * kInterval));
+  ASSERT_EQ(CHANNEL_NAME_2, message.channel_name);
+  ASSERT_EQ(std::to_string(3 * MESSAGE_NUM), message.content);
+  uint32_t count = 1;
+  while (reader.ReadMessage(&message, 3 * MESSAGE_NUM * kInterval)) {
+    ++count;
+  }
+  ASSERT_EQ(MESSAGE_NUM, count);
+
+  // messages of other channels are skipped without being parsed
+  reader.Reset();
+  reader.set_channel_filter({CHANNEL_NAME_2});
+  count = 0;
+  while (reader.ReadMessage(&message)) {
+    ASSERT_EQ(CHANNEL_NAME_2, message.channel_name);
+    ASSERT_EQ(std::to_string(2 * MESSAGE_NUM + count), message.content);
+    ++count;
+  }
+  ASSERT_EQ(2 * MESSAGE_NUM, count);
+
+  reader.Reset();
+  reader.set_channel_filter({"/test/unknown"});
+  ASSERT_FALSE(reader.ReadMessage(&message));
+}
+
+TEST(RecordTest, TestPrefetchChunks) {
+  const uint64_t kInterval = 10000000000UL;
+  RecordWriter writer;
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(TEST_FILE);
+  writer.WriteChannel(CHANNEL_NAME_1, MESSAGE_TYPE_1, PROTO_DESC);
+  for (uint32_t i = 0; i < 4 * MESSAGE_NUM; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    writer.WriteMessage(CHANNEL_NAME_1, msg, i * kInterval);
+  }
+  writer.Close();
+
+  RecordReader reader(TEST_FILE);
+  reader.set_prefetch(std::make_shared<base::ThreadPool>(2), 4);
+  RecordMessage message;
+  uint32_t count = 0;
+  while (reader.ReadMessage(&message)) {
+    ASSERT_EQ(std::to_string(count), message.content);
+    ++count;
+  }
+  ASSERT_EQ(4 * MESSAGE_NUM, count);
+
+  // a jump forward drops the chunks decoded ahead of it
+  reader.Reset();
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  ASSERT_EQ("0", message.content);
+  ASSERT_TRUE(reader.ReadMessage(&message, 3 * MESSAGE_NUM * kInterval));
+  ASSERT_EQ(std::to_string(3 * MESSAGE_NUM), message.content);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -105,6 +105,7 @@ void RecordViewer::Sort() {
 void RecordViewer::Reset() {
   for (auto& reader : readers_) {
     reader->Reset();
+    reader->set_channel_filter(channels_);
   }
   curr_begin_time_ = begin_time_;
   msg_buffer_.clear();
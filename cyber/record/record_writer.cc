@@ -115,24 +115,26 @@ bool RecordWriter::WriteChannel(const std::string& channel_name,
   return true;
 }
 
-bool RecordWriter::WriteMessage(const SingleMessage& message) {
+bool RecordWriter::WriteSerialized(const std::string& channel_name,
+                                   const char* data, size_t size,
+                                   uint64_t time_nanosec) {
   std::lock_guard<std::mutex> lg(mutex_);
-  OnNewMessage(message.channel_name());
-  if (!file_writer_->WriteMessage(message)) {
+  OnNewMessage(channel_name);
+  if (!file_writer_->WriteMessage(channel_name, data, size, time_nanosec)) {
     AERROR << "write message fail.";
     return false;
   }
 
-  segment_raw_size_ += message.content().size();
+  segment_raw_size_ += size;
   if (segment_begin_time_ == 0) {
-    segment_begin_time_ = message.time();
+    segment_begin_time_ = time_nanosec;
   }
-  if (segment_begin_time_ > message.time()) {
-    segment_begin_time_ = message.time();
+  if (segment_begin_time_ > time_nanosec) {
+    segment_begin_time_ = time_nanosec;
   }
 
   if ((header_.segment_interval() > 0 &&
-       message.time() - segment_begin_time_ > header_.segment_interval()) ||
+       time_nanosec - segment_begin_time_ > header_.segment_interval()) ||
       (header_.segment_raw_size() > 0 &&
        segment_raw_size_ > header_.segment_raw_size())) {
     file_writer_backup_.swap(file_writer_);
@@ -163,6 +165,19 @@ bool RecordWriter::SetIntervalOfFileSegmentation(uint64_t time_sec) {
   return true;
 }
 
+bool RecordWriter::SetCompressType(CompressType compress_type) {
+  if (is_opened_) {
+    AWARN << "please call this interface before opening file.";
+    return false;
+  }
+  if (!ChunkCompressor::IsSupported(compress_type)) {
+    AWARN << "unsupported compress type: " << compress_type;
+    return false;
+  }
+  header_.set_compress(compress_type);
+  return true;
+}
+
 bool RecordWriter::IsNewChannel(const std::string& channel_name) {
   auto search = channel_message_number_map_.find(channel_name);
   if (search == channel_message_number_map_.end()) {
@@ -63,6 +63,8 @@ class RecordWriter : public RecordBase {
 
   bool SetIntervalOfFileSegmentation(uint64_t time_sec);
 
+  bool SetCompressType(CompressType compress_type);
+
   uint64_t GetMessageNumber(const std::string& channel_name) const override;
 
   const std::string& GetMessageType(
@@ -72,7 +74,10 @@ class RecordWriter : public RecordBase {
       const std::string& channel_name) const override;
 
  private:
-  bool WriteMessage(const proto::SingleMessage& single_msg);
+  // appends the serialized bytes straight to the active chunk, without
+  // building an intermediate SingleMessage
+  bool WriteSerialized(const std::string& channel_name, const char* data,
+                       size_t size, uint64_t time_nanosec);
   bool SplitOutfile();
   bool IsNewChannel(const std::string& channel_name);
   void OnNewChannel(const std::string& channel_name,
@@ -98,11 +103,8 @@ inline bool RecordWriter::WriteMessage(const std::string& channel_name,
                                        const std::string& content,
                                        const uint64_t time_nanosec,
                                        const std::string& proto_desc) {
-  proto::SingleMessage single_msg;
-  single_msg.set_channel_name(channel_name);
-  single_msg.set_content(content);
-  single_msg.set_time(time_nanosec);
-  return WriteMessage(single_msg);
+  return WriteSerialized(channel_name, content.data(), content.size(),
+                         time_nanosec);
 }
 
 template <>
@@ -114,7 +116,8 @@ inline bool RecordWriter::WriteMessage(
     AERROR << "nullptr error, channel: " << channel_name;
     return false;
   }
-  return WriteMessage(channel_name, message->message, time_nanosec);
+  return WriteSerialized(channel_name, message->message.data(),
+                         message->message.size(), time_nanosec);
 }
 
 template <typename MessageT>
@@ -16,6 +16,8 @@
 
 #include "cyber/scheduler/policy/classic_context.h"
 
+#include <algorithm>
+
 #include "cyber/event/perf_event_cache.h"
 
 namespace apollo {
@@ -24,6 +26,7 @@ namespace scheduler {
 
 using apollo::cyber::croutine::RoutineState;
 using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
 using apollo::cyber::base::AtomicRWLock;
 using apollo::cyber::croutine::CRoutine;
 using apollo::cyber::event::PerfEventCache;
@@ -37,37 +40,164 @@ GRP_WQ_MUTEX ClassicContext::mtx_wq_;
 GRP_WQ_CV ClassicContext::cv_wq_;
 RQ_LOCK_GROUP ClassicContext::rq_locks_;
 CR_GROUP ClassicContext::cr_group_;
+CTX_GROUP ClassicContext::ctx_group_;
 
 std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
   if (unlikely(stop_)) {
     return nullptr;
   }
 
+  if (work_stealing_) {
+    return NextLocalRoutine();
+  }
+
+  if (unlikely(group_queues_ == nullptr)) {
+    return nullptr;
+  }
+
   for (int i = MAX_PRIO - 1; i >= 0; --i) {
-    ReadLockGuard<AtomicRWLock> lk(rq_locks_[group_name_].at(i));
-    for (auto& cr : cr_group_[group_name_].at(i)) {
-      if (!cr->Acquire()) {
+    auto cr = NextReadyRoutine(group_queues_->at(i), &group_locks_->at(i));
+    if (cr != nullptr) {
+      return cr;
+    }
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> ClassicContext::NextLocalRoutine() {
+  auto& peers = *peers_;
+  const uint32_t peer_num = static_cast<uint32_t>(peers.size());
+  uint32_t steal_mask = 0;
+  for (auto peer : peers) {
+    if (peer != this) {
+      steal_mask |= peer->ready_mask_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // a notified croutine of a peer wins over local ones of lower priority
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    auto cr = NextReadyRoutine(local_queues_.at(i), &local_locks_.at(i));
+    if (cr != nullptr) {
+      return cr;
+    }
+    const uint32_t bit = 1u << i;
+    if ((steal_mask & bit) == 0) {
+      continue;
+    }
+    // rotate the first victim so thieves do not pile on the same peer
+    ++next_victim_;
+    for (uint32_t k = 0; k < peer_num; ++k) {
+      auto victim = peers[(next_victim_ + k) % peer_num];
+      if (victim == this ||
+          (victim->ready_mask_.load(std::memory_order_relaxed) & bit) == 0) {
         continue;
       }
-
-      if (cr->UpdateState() == RoutineState::READY) {
-        PerfEventCache::Instance()->AddSchedEvent(SchedPerf::NEXT_RT, cr->id(),
-                                                  cr->processor_id());
+      victim->ready_mask_.fetch_and(~bit);
+      cr = NextReadyRoutine(victim->local_queues_.at(i),
+                            &victim->local_locks_.at(i));
+      if (cr != nullptr) {
+        // others of the same priority may still be ready
+        victim->ready_mask_.fetch_or(bit);
+        steal_count_.fetch_add(1, std::memory_order_relaxed);
         return cr;
       }
+    }
+  }
+
+  return nullptr;
+}
 
-      if (unlikely(cr->state() == RoutineState::SLEEP)) {
-        if (!need_sleep_ || wake_time_ > cr->wake_time()) {
-          need_sleep_ = true;
-          wake_time_ = cr->wake_time();
-        }
+std::shared_ptr<CRoutine> ClassicContext::NextReadyRoutine(
+    const CROUTINE_QUEUE& queue, AtomicRWLock* lock) {
+  ReadLockGuard<AtomicRWLock> lk(*lock);
+  for (auto& cr : queue) {
+    if (!cr->Acquire()) {
+      continue;
+    }
+
+    if (cr->UpdateState() == RoutineState::READY) {
+      PerfEventCache::Instance()->AddSchedEvent(SchedPerf::NEXT_RT, cr->id(),
+                                                cr->processor_id());
+      return cr;
+    }
+
+    if (unlikely(cr->state() == RoutineState::SLEEP)) {
+      if (!need_sleep_ || wake_time_ > cr->wake_time()) {
+        need_sleep_ = true;
+        wake_time_ = cr->wake_time();
       }
+    }
+
+    cr->Release();
+  }
+
+  return nullptr;
+}
+
+void ClassicContext::SetGroupName(const std::string& group_name) {
+  group_name_ = group_name;
+  group_locks_ = &rq_locks_[group_name];
+  group_queues_ = &cr_group_[group_name];
+}
+
+void ClassicContext::EnableWorkStealing() {
+  auto& contexts = ctx_group_[group_name_];
+  work_stealing_ = true;
+  index_ = static_cast<uint32_t>(contexts.size());
+  next_victim_ = index_;
+  peers_ = &contexts;
+  contexts.emplace_back(this);
+}
+
+bool ClassicContext::IsWorkStealing(const std::string& group_name) {
+  auto search = ctx_group_.find(group_name);
+  return search != ctx_group_.end() && !search->second.empty();
+}
+
+void ClassicContext::Enqueue(const std::shared_ptr<CRoutine>& cr) {
+  auto& contexts = ctx_group_[cr->group_name()];
+  auto ctx = *std::min_element(
+      contexts.begin(), contexts.end(),
+      [](const ClassicContext* lhs, const ClassicContext* rhs) {
+        return lhs->routine_num_.load() < rhs->routine_num_.load();
+      });
+  cr->set_processor_id(ctx->index_);
+  {
+    WriteLockGuard<AtomicRWLock> lk(ctx->local_locks_.at(cr->priority()));
+    ctx->local_queues_.at(cr->priority()).emplace_back(cr);
+  }
+  ctx->routine_num_.fetch_add(1);
+}
 
+bool ClassicContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
+  auto& contexts = ctx_group_[cr->group_name()];
+  if (cr->processor_id() < 0 ||
+      cr->processor_id() >= static_cast<int>(contexts.size())) {
+    return false;
+  }
+  auto ctx = contexts[cr->processor_id()];
+  auto prio = cr->priority();
+  WriteLockGuard<AtomicRWLock> lk(ctx->local_locks_.at(prio));
+  auto& queue = ctx->local_queues_.at(prio);
+  for (auto it = queue.begin(); it != queue.end(); ++it) {
+    if ((*it)->id() == cr->id()) {
+      (*it)->Stop();
+      queue.erase(it);
+      ctx->routine_num_.fetch_sub(1);
       cr->Release();
+      return true;
     }
   }
+  return false;
+}
 
-  return nullptr;
+void ClassicContext::NotifyReady(const std::shared_ptr<CRoutine>& cr) {
+  auto& contexts = ctx_group_[cr->group_name()];
+  if (cr->processor_id() >= 0 &&
+      cr->processor_id() < static_cast<int>(contexts.size())) {
+    contexts[cr->processor_id()]->ready_mask_.fetch_or(1u << cr->priority());
+  }
 }
 
 void ClassicContext::Wait() {
@@ -93,6 +223,10 @@ void ClassicContext::Shutdown() {
     }
   }
   cv_wq_[group_name_].notify_all();
+  if (work_stealing_) {
+    ADEBUG << "processor " << index_ << " of group " << group_name_
+           << " stole " << steal_count() << " croutines.";
+  }
 }
 
 void ClassicContext::Notify(const std::string& group_name) {
@@ -18,6 +18,7 @@
 #define CYBER_SCHEDULER_POLICY_CLASSIC_CONTEXT_H_
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -46,6 +47,9 @@ using RQ_LOCK_GROUP = std::unordered_map<std::string, LOCK_QUEUE>;
 using GRP_WQ_MUTEX = std::unordered_map<std::string, std::mutex>;
 using GRP_WQ_CV = std::unordered_map<std::string, std::condition_variable>;
 
+class ClassicContext;
+using CTX_GROUP = std::unordered_map<std::string, std::vector<ClassicContext*>>;
+
 class ClassicContext : public ProcessorContext {
  public:
   std::shared_ptr<CRoutine> NextRoutine() override;
@@ -54,7 +58,20 @@ class ClassicContext : public ProcessorContext {
 
   static void Notify(const std::string& group_name);
 
-  void SetGroupName(const std::string& group_name) { group_name_ = group_name; }
+  // Work stealing groups keep croutines in per processor run queues instead
+  // of cr_group_. All contexts of the group must be registered before any
+  // processor runs them.
+  void EnableWorkStealing();
+  static bool IsWorkStealing(const std::string& group_name);
+  // Puts the croutine on the least loaded processor of its group.
+  static void Enqueue(const std::shared_ptr<CRoutine>& cr);
+  static bool RemoveCRoutine(const std::shared_ptr<CRoutine>& cr);
+  // Lets the other processors know the croutine may be ready to steal.
+  static void NotifyReady(const std::shared_ptr<CRoutine>& cr);
+
+  uint64_t steal_count() const { return steal_count_.load(); }
+
+  void SetGroupName(const std::string& group_name);
   std::string group_name_;
 
   alignas(CACHELINE_SIZE) static RQ_LOCK_GROUP rq_locks_;
@@ -63,9 +80,30 @@ class ClassicContext : public ProcessorContext {
   alignas(CACHELINE_SIZE) static GRP_WQ_MUTEX mtx_wq_;
   alignas(CACHELINE_SIZE) static GRP_WQ_CV cv_wq_;
 
+  alignas(CACHELINE_SIZE) static CTX_GROUP ctx_group_;
+
  private:
+  std::shared_ptr<CRoutine> NextReadyRoutine(const CROUTINE_QUEUE& queue,
+                                             base::AtomicRWLock* lock);
+  std::shared_ptr<CRoutine> NextLocalRoutine();
+
+  // run queues of the group, looked up once rather than on every poll
+  MULTI_PRIO_QUEUE* group_queues_ = nullptr;
+  LOCK_QUEUE* group_locks_ = nullptr;
+
   std::chrono::steady_clock::time_point wake_time_;
   bool need_sleep_ = false;
+
+  bool work_stealing_ = false;
+  uint32_t index_ = 0;
+  uint32_t next_victim_ = 0;
+  std::vector<ClassicContext*>* peers_ = nullptr;
+  MULTI_PRIO_QUEUE local_queues_;
+  LOCK_QUEUE local_locks_;
+  std::atomic<uint32_t> routine_num_ = {0};
+  std::atomic<uint64_t> steal_count_ = {0};
+  // one bit per priority, set when a croutine of that priority is notified
+  alignas(CACHELINE_SIZE) std::atomic<uint32_t> ready_mask_ = {0};
 };
 
 }  // namespace scheduler
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/edf_context.h"
+
+#include "cyber/common/log.h"
+#include "cyber/event/perf_event_cache.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+using apollo::cyber::event::PerfEventCache;
+using apollo::cyber::event::SchedPerf;
+
+namespace {
+inline uint64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+void EdfRunQueue::Enqueue(const std::shared_ptr<CRoutine>& cr,
+                          uint64_t relative_deadline_ns) {
+  std::lock_guard<std::mutex> lg(rq_mutex_);
+  auto& task = tasks_[cr->id()];
+  task.cr = cr;
+  task.relative_deadline_ns = relative_deadline_ns;
+}
+
+bool EdfRunQueue::RemoveCRoutine(uint64_t crid) {
+  std::lock_guard<std::mutex> lg(rq_mutex_);
+  auto search = tasks_.find(crid);
+  if (search == tasks_.end()) {
+    return false;
+  }
+  auto cr = search->second.cr;
+  cr->Stop();
+  tasks_.erase(search);
+  cr->Release();
+  return true;
+}
+
+void EdfRunQueue::ReleaseJob(uint64_t crid) {
+  auto now = Now();
+  std::lock_guard<std::mutex> lg(rq_mutex_);
+  auto search = tasks_.find(crid);
+  if (search != tasks_.end() && search->second.absolute_deadline_ns == 0) {
+    search->second.absolute_deadline_ns =
+        now + search->second.relative_deadline_ns;
+  }
+}
+
+bool EdfRunQueue::GetStat(uint64_t crid, EdfTaskStat* stat) {
+  std::lock_guard<std::mutex> lg(rq_mutex_);
+  auto search = tasks_.find(crid);
+  if (search == tasks_.end()) {
+    return false;
+  }
+  *stat = search->second.stat;
+  return true;
+}
+
+void EdfRunQueue::Notify() { cv_wq_.notify_one(); }
+
+std::shared_ptr<CRoutine> EdfContext::NextRoutine() {
+  if (unlikely(stop_)) {
+    return nullptr;
+  }
+
+  auto now = Now();
+  std::lock_guard<std::mutex> lg(rq_->rq_mutex_);
+  FinishJob(now);
+
+  EdfRunQueue::Task* next = nullptr;
+  for (auto& item : rq_->tasks_) {
+    auto& task = item.second;
+    auto& cr = task.cr;
+    if (!cr->Acquire()) {
+      continue;
+    }
+
+    if (cr->UpdateState() == RoutineState::READY) {
+      if (task.absolute_deadline_ns == 0) {
+        task.absolute_deadline_ns = now + task.relative_deadline_ns;
+      }
+      // earliest deadline first, higher priority on a tie
+      if (next == nullptr ||
+          task.absolute_deadline_ns < next->absolute_deadline_ns ||
+          (task.absolute_deadline_ns == next->absolute_deadline_ns &&
+           cr->priority() > next->cr->priority())) {
+        if (next != nullptr) {
+          next->cr->Release();
+        }
+        next = &task;
+        continue;
+      }
+    } else if (unlikely(cr->state() == RoutineState::SLEEP)) {
+      if (!need_sleep_ || wake_time_ > cr->wake_time()) {
+        need_sleep_ = true;
+        wake_time_ = cr->wake_time();
+      }
+    }
+
+    cr->Release();
+  }
+
+  if (next == nullptr) {
+    return nullptr;
+  }
+  last_crid_ = next->cr->id();
+  PerfEventCache::Instance()->AddSchedEvent(SchedPerf::NEXT_RT, last_crid_,
+                                            next->cr->processor_id());
+  return next->cr;
+}
+
+void EdfContext::FinishJob(uint64_t now) {
+  if (last_crid_ == 0) {
+    return;
+  }
+  auto search = rq_->tasks_.find(last_crid_);
+  last_crid_ = 0;
+  if (search == rq_->tasks_.end()) {
+    return;
+  }
+  auto& task = search->second;
+  // another processor resumed it meanwhile, the job goes on there
+  if (!task.cr->Acquire()) {
+    return;
+  }
+  if (task.cr->state() != RoutineState::READY &&
+      task.absolute_deadline_ns != 0) {
+    ++task.stat.job_count;
+    if (now > task.absolute_deadline_ns) {
+      ++task.stat.deadline_miss_count;
+      AWARN_EVERY(100) << task.cr->name() << " missed its deadline by "
+                       << (now - task.absolute_deadline_ns) / 1000
+                       << "us, misses: " << task.stat.deadline_miss_count;
+    }
+    task.absolute_deadline_ns = 0;
+  }
+  task.cr->Release();
+}
+
+void EdfContext::Wait() {
+  std::unique_lock<std::mutex> lk(rq_->mtx_wq_);
+  if (stop_) {
+    return;
+  }
+
+  if (unlikely(need_sleep_)) {
+    auto duration = wake_time_ - std::chrono::steady_clock::now();
+    rq_->cv_wq_.wait_for(lk, duration);
+    need_sleep_ = false;
+  } else {
+    rq_->cv_wq_.wait(lk);
+  }
+}
+
+void EdfContext::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lg(rq_->mtx_wq_);
+    if (!stop_) {
+      stop_ = true;
+    }
+  }
+  rq_->cv_wq_.notify_all();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
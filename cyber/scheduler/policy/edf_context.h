@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using croutine::CRoutine;
+
+struct EdfTaskStat {
+  uint64_t job_count = 0;
+  uint64_t deadline_miss_count = 0;
+};
+
+// Croutines shared by all processors of the edf policy. A job of a croutine
+// is released when it is notified, or when it is found ready without one,
+// and has to finish before release time plus its relative deadline.
+class EdfRunQueue {
+ public:
+  void Enqueue(const std::shared_ptr<CRoutine>& cr,
+               uint64_t relative_deadline_ns);
+  bool RemoveCRoutine(uint64_t crid);
+  void ReleaseJob(uint64_t crid);
+  bool GetStat(uint64_t crid, EdfTaskStat* stat);
+
+  void Notify();
+
+ private:
+  friend class EdfContext;
+
+  struct Task {
+    std::shared_ptr<CRoutine> cr;
+    uint64_t relative_deadline_ns = 0;
+    // 0 while the croutine has no pending job
+    uint64_t absolute_deadline_ns = 0;
+    EdfTaskStat stat;
+  };
+
+  std::mutex rq_mutex_;
+  std::unordered_map<uint64_t, Task> tasks_;
+
+  std::mutex mtx_wq_;
+  std::condition_variable cv_wq_;
+};
+
+class EdfContext : public ProcessorContext {
+ public:
+  explicit EdfContext(const std::shared_ptr<EdfRunQueue>& rq) : rq_(rq) {}
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+ private:
+  void FinishJob(uint64_t now);
+
+  std::shared_ptr<EdfRunQueue> rq_;
+  // croutine resumed last by this processor
+  uint64_t last_crid_ = 0;
+
+  std::chrono::steady_clock::time_point wake_time_;
+  bool need_sleep_ = false;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
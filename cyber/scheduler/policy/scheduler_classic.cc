@@ -22,6 +22,7 @@
 
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
+#include "cyber/common/numa.h"
 #include "cyber/event/perf_event_cache.h"
 #include "cyber/scheduler/policy/classic_context.h"
 #include "cyber/scheduler/processor.h"
@@ -84,23 +85,62 @@ void SchedulerClassic::CreateProcessor() {
       task_pool_size_ = proc_num;
     }
 
-    auto& affinity = group.affinity();
+    std::string affinity = group.affinity();
     auto& processor_policy = group.processor_policy();
     auto processor_prio = group.processor_prio();
     std::vector<int> cpuset;
     ParseCpuset(group.cpuset(), &cpuset);
 
+    auto numa_node = group.numa_node();
+    if (numa_node >= 0 && cpuset.empty()) {
+      if (common::GetNumaNodeCpus(numa_node, &cpuset)) {
+        if (affinity.empty()) {
+          affinity = "range";
+        }
+      } else {
+        AWARN << "group " << group_name << " has invalid numa node "
+              << numa_node;
+      }
+    }
+    group_numa_nodes_[group_name] = numa_node;
+
+    if (group.dedicated_core()) {
+      if (affinity.empty()) {
+        affinity = "1to1";
+      }
+      if (affinity == "1to1" && cpuset.size() < proc_num) {
+        AWARN << "dedicated group " << group_name << " has " << proc_num
+              << " processors but only " << cpuset.size() << " cpus.";
+        affinity = "range";
+      }
+    }
+
     ClassicContext::cr_group_[group_name];
     ClassicContext::rq_locks_[group_name];
     ClassicContext::mtx_wq_[group_name];
     ClassicContext::cv_wq_[group_name];
+    ClassicContext::ctx_group_[group_name].clear();
 
+    // the run queues of a work stealing group are all visible to each
+    // other before the first processor starts
+    std::vector<std::shared_ptr<ClassicContext>> ctxs;
     for (uint32_t i = 0; i < proc_num; i++) {
       auto ctx = std::make_shared<ClassicContext>();
       ctx->SetGroupName(group_name);
+      if (group.work_stealing()) {
+        ctx->EnableWorkStealing();
+      }
+      ctxs.emplace_back(ctx);
+    }
+
+    for (uint32_t i = 0; i < proc_num; i++) {
+      auto& ctx = ctxs[i];
       pctxs_.emplace_back(ctx);
 
       auto proc = std::make_shared<Processor>();
+      // before the thread starts, so a dedicated one never waits
+      proc->SetNumaNode(numa_node);
+      proc->SetDedicated(group.dedicated_core());
       proc->BindContext(ctx);
       proc->SetAffinity(cpuset, affinity, i);
       proc->SetSchedPolicy(processor_policy, processor_prio);
@@ -147,7 +187,9 @@ bool SchedulerClassic::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
   }
 
   // Enqueue task.
-  {
+  if (ClassicContext::IsWorkStealing(cr->group_name())) {
+    ClassicContext::Enqueue(cr);
+  } else {
     WriteLockGuard<AtomicRWLock> lk(
         ClassicContext::rq_locks_[cr->group_name()].at(cr->priority()));
     ClassicContext::cr_group_[cr->group_name()].at(cr->priority())
@@ -172,6 +214,9 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
       if (cr->state() == RoutineState::DATA_WAIT) {
         cr->SetUpdateFlag();
       }
+      if (ClassicContext::IsWorkStealing(cr->group_name())) {
+        ClassicContext::NotifyReady(cr);
+      }
 
       ClassicContext::Notify(cr->group_name());
       return true;
@@ -180,6 +225,15 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
   return false;
 }
 
+int SchedulerClassic::TaskNumaNode(const std::string& name) {
+  // tasks not in conf run in the first group, as in DispatchTask
+  auto it = cr_confs_.find(name);
+  auto& group_name = it != cr_confs_.end() ? it->second.group_name()
+                                           : classic_conf_.groups(0).name();
+  auto node = group_numa_nodes_.find(group_name);
+  return node != group_numa_nodes_.end() ? node->second : -1;
+}
+
 bool SchedulerClassic::RemoveTask(const std::string& name) {
   if (unlikely(stop_)) {
     return true;
@@ -218,6 +272,10 @@ bool SchedulerClassic::RemoveCRoutine(uint64_t crid) {
     }
   }
 
+  if (ClassicContext::IsWorkStealing(group_name)) {
+    return ClassicContext::RemoveCRoutine(cr);
+  }
+
   WriteLockGuard<AtomicRWLock> lk(
       ClassicContext::rq_locks_[group_name].at(prio));
   for (auto it = ClassicContext::cr_group_[group_name].at(prio).begin();
@@ -39,6 +39,7 @@ class SchedulerClassic : public Scheduler {
   bool RemoveCRoutine(uint64_t crid) override;
   bool RemoveTask(const std::string& name) override;
   bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+  int TaskNumaNode(const std::string& name) override;
 
  private:
   friend Scheduler* Instance();
@@ -48,6 +49,7 @@ class SchedulerClassic : public Scheduler {
   bool NotifyProcessor(uint64_t crid) override;
 
   std::unordered_map<std::string, ClassicTask> cr_confs_;
+  std::unordered_map<std::string, int> group_numa_nodes_;
 
   ClassicConf classic_conf_;
 };
@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_edf.h"
+
+#include <vector>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/file.h"
+#include "cyber/common/global_data.h"
+#include "cyber/event/perf_event_cache.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::common::GetAbsolutePath;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::common::PathExists;
+using apollo::cyber::common::WorkRoot;
+using apollo::cyber::croutine::RoutineState;
+using apollo::cyber::event::PerfEventCache;
+using apollo::cyber::event::SchedPerf;
+
+SchedulerEdf::SchedulerEdf() : rq_(std::make_shared<EdfRunQueue>()) {
+  std::string conf("conf/");
+  conf.append(GlobalData::Instance()->ProcessGroup()).append(".conf");
+  auto cfg_file = GetAbsolutePath(WorkRoot(), conf);
+
+  apollo::cyber::proto::CyberConfig cfg;
+  if (PathExists(cfg_file) && GetProtoFromFile(cfg_file, &cfg)) {
+    edf_conf_ = cfg.scheduler_conf().edf_conf();
+    for (auto& task : edf_conf_.tasks()) {
+      cr_confs_[task.name()] = task;
+    }
+  }
+
+  if (!edf_conf_.has_processor_num()) {
+    uint32_t proc_num = 2;
+    auto& global_conf = GlobalData::Instance()->Config();
+    if (global_conf.has_scheduler_conf() &&
+        global_conf.scheduler_conf().has_default_proc_num()) {
+      proc_num = global_conf.scheduler_conf().default_proc_num();
+    }
+    edf_conf_.set_processor_num(proc_num);
+  }
+  task_pool_size_ = edf_conf_.processor_num();
+
+  CreateProcessor();
+}
+
+void SchedulerEdf::CreateProcessor() {
+  std::vector<int> cpuset;
+  ParseCpuset(edf_conf_.cpuset(), &cpuset);
+
+  for (uint32_t i = 0; i < edf_conf_.processor_num(); i++) {
+    auto ctx = std::make_shared<EdfContext>(rq_);
+    pctxs_.emplace_back(ctx);
+
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    proc->SetAffinity(cpuset, edf_conf_.affinity(), i);
+    proc->SetSchedPolicy(edf_conf_.processor_policy(),
+                         edf_conf_.processor_prio());
+    processors_.emplace_back(proc);
+  }
+}
+
+void SchedulerEdf::SetTaskDeadline(const std::string& name,
+                                   uint64_t period_us, uint64_t deadline_us) {
+  std::lock_guard<std::mutex> lg(cr_confs_mtx_);
+  // the scheduler conf overrides what the component declares
+  if (cr_confs_.find(name) != cr_confs_.end()) {
+    return;
+  }
+  auto& task = cr_confs_[name];
+  task.set_name(name);
+  if (period_us > 0) {
+    task.set_period_us(static_cast<uint32_t>(period_us));
+  }
+  if (deadline_us > 0) {
+    task.set_deadline_us(static_cast<uint32_t>(deadline_us));
+  }
+}
+
+uint64_t SchedulerEdf::RelativeDeadline(const std::string& name) {
+  uint64_t deadline_us = edf_conf_.default_deadline_us();
+  std::lock_guard<std::mutex> lg(cr_confs_mtx_);
+  auto search = cr_confs_.find(name);
+  if (search != cr_confs_.end()) {
+    if (search->second.has_deadline_us()) {
+      deadline_us = search->second.deadline_us();
+    } else if (search->second.has_period_us()) {
+      deadline_us = search->second.period_us();
+    }
+  }
+  return deadline_us * 1000;
+}
+
+bool SchedulerEdf::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  if (likely(id_cr_wl_.find(cr->id()) == id_cr_wl_.end())) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (id_cr_wl_.find(cr->id()) == id_cr_wl_.end()) {
+        id_cr_wl_[cr->id()];
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(id_cr_wl_[cr->id()]);
+
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(cr->id()) != id_cr_.end()) {
+      return false;
+    }
+    id_cr_[cr->id()] = cr;
+  }
+
+  rq_->Enqueue(cr, RelativeDeadline(cr->name()));
+
+  PerfEventCache::Instance()->AddSchedEvent(SchedPerf::RT_CREATE, cr->id(),
+                                            cr->processor_id());
+  rq_->Notify();
+  return true;
+}
+
+bool SchedulerEdf::NotifyProcessor(uint64_t crid) {
+  if (unlikely(stop_)) {
+    return true;
+  }
+
+  {
+    ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(crid) != id_cr_.end()) {
+      auto cr = id_cr_[crid];
+      if (cr->state() == RoutineState::DATA_WAIT) {
+        cr->SetUpdateFlag();
+      }
+
+      rq_->ReleaseJob(crid);
+      rq_->Notify();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SchedulerEdf::RemoveTask(const std::string& name) {
+  if (unlikely(stop_)) {
+    return true;
+  }
+
+  auto crid = GlobalData::GenerateHashId(name);
+  return RemoveCRoutine(crid);
+}
+
+bool SchedulerEdf::RemoveCRoutine(uint64_t crid) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  if (unlikely(id_cr_wl_.find(crid) == id_cr_wl_.end())) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (id_cr_wl_.find(crid) == id_cr_wl_.end()) {
+        id_cr_wl_[crid];
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(id_cr_wl_[crid]);
+
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(crid) == id_cr_.end()) {
+      return false;
+    }
+    id_cr_[crid]->Stop();
+    id_cr_.erase(crid);
+  }
+
+  return rq_->RemoveCRoutine(crid);
+}
+
+bool SchedulerEdf::GetTaskStat(const std::string& name, EdfTaskStat* stat) {
+  return rq_->GetStat(GlobalData::GenerateHashId(name), stat);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
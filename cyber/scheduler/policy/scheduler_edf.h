@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
+#define CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/proto/edf_conf.pb.h"
+#include "cyber/scheduler/policy/edf_context.h"
+#include "cyber/scheduler/scheduler.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::proto::EdfConf;
+using apollo::cyber::proto::EdfTask;
+
+class SchedulerEdf : public Scheduler {
+ public:
+  bool RemoveCRoutine(uint64_t crid) override;
+  bool RemoveTask(const std::string& name) override;
+  bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+  void SetTaskDeadline(const std::string& name, uint64_t period_us,
+                       uint64_t deadline_us) override;
+
+  bool GetTaskStat(const std::string& name, EdfTaskStat* stat);
+
+ private:
+  friend Scheduler* Instance();
+  SchedulerEdf();
+
+  void CreateProcessor();
+  bool NotifyProcessor(uint64_t crid) override;
+  uint64_t RelativeDeadline(const std::string& name);
+
+  std::mutex cr_confs_mtx_;
+  std::unordered_map<std::string, EdfTask> cr_confs_;
+
+  EdfConf edf_conf_;
+  std::shared_ptr<EdfRunQueue> rq_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
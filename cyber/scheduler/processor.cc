@@ -23,6 +23,7 @@
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/common/numa.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/scheduler/processor_context.h"
 
@@ -78,13 +79,20 @@ void Processor::SetSchedPolicy(std::string spolicy, int sched_priority) {
 
 void Processor::Run() {
   tid_.store(static_cast<int>(syscall(SYS_gettid)));
+  int numa_node = -1;
 
   while (likely(running_)) {
+    if (unlikely(numa_node_.load(std::memory_order_relaxed) != numa_node)) {
+      numa_node = numa_node_.load();
+      common::SetThreadNumaNode(numa_node);
+    }
     if (likely(context_ != nullptr)) {
       auto croutine = context_->NextRoutine();
       if (croutine) {
         croutine->Resume();
         croutine->Release();
+      } else if (dedicated_.load(std::memory_order_relaxed)) {
+        cpu_relax();
       } else {
         context_->Wait();
       }
@@ -46,6 +46,10 @@ class Processor {
   void BindContext(const std::shared_ptr<ProcessorContext>& context);
   void SetAffinity(const std::vector<int>&, const std::string&, int);
   void SetSchedPolicy(std::string spolicy, int sched_priority);
+  // applied by the processor thread itself, since memory policy is per thread
+  void SetNumaNode(int node) { numa_node_.store(node); }
+  // Busy polls the context instead of waiting in it when nothing is ready.
+  void SetDedicated(bool dedicated) { dedicated_.store(dedicated); }
 
  private:
   std::shared_ptr<ProcessorContext> context_;
@@ -56,6 +60,8 @@ class Processor {
   std::thread thread_;
 
   std::atomic<pid_t> tid_{-1};
+  std::atomic<int> numa_node_{-1};
+  std::atomic<bool> dedicated_{false};
   std::atomic<bool> running_{false};
 };
 
@@ -48,7 +48,7 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
 
   auto task_id = GlobalData::RegisterTaskName(name);
 
-  auto cr = std::make_shared<CRoutine>(func);
+  auto cr = std::make_shared<CRoutine>(func, StackSize(name));
   cr->set_id(task_id);
   cr->set_name(name);
 
@@ -67,6 +67,32 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
   return true;
 }
 
+size_t Scheduler::StackSize(const std::string& name) {
+  auto& global_conf = GlobalData::Instance()->Config();
+  const auto& sched_conf = global_conf.scheduler_conf();
+  uint32_t stack_size_kb = sched_conf.stack_size_kb();
+  size_t prefix_length = 0;
+  for (const auto& stack : sched_conf.routine_stacks()) {
+    const auto& prefix = stack.name_prefix();
+    if (prefix.size() >= prefix_length &&
+        name.compare(0, prefix.size(), prefix) == 0) {
+      prefix_length = prefix.size();
+      stack_size_kb = stack.stack_size_kb();
+    }
+  }
+  return static_cast<size_t>(stack_size_kb) * 1024;
+}
+
+std::vector<std::shared_ptr<CRoutine>> Scheduler::GetRoutines() {
+  std::vector<std::shared_ptr<CRoutine>> routines;
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  routines.reserve(id_cr_.size());
+  for (auto& item : id_cr_) {
+    routines.emplace_back(item.second);
+  }
+  return routines;
+}
+
 bool Scheduler::NotifyTask(uint64_t crid) {
   if (unlikely(stop_.load())) {
     return true;
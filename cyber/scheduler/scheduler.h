@@ -59,10 +59,17 @@ class Scheduler {
 
   void Shutdown();
   uint32_t TaskPoolSize() { return task_pool_size_; }
+  std::vector<std::shared_ptr<CRoutine>> GetRoutines();
 
   virtual bool RemoveTask(const std::string& name) = 0;
   virtual void SetInnerThreadAttr(const std::thread* thr,
                                   const std::string& name) {}
+  // Timing constraints of a task, only used by deadline aware policies.
+  virtual void SetTaskDeadline(const std::string& name, uint64_t period_us,
+                               uint64_t deadline_us) {}
+
+  // Numa node the processors of a task run on, -1 when not pinned to one.
+  virtual int TaskNumaNode(const std::string& name) { return -1; }
 
   virtual bool DispatchTask(const std::shared_ptr<CRoutine>&) = 0;
   virtual bool NotifyProcessor(uint64_t crid) = 0;
@@ -71,6 +78,7 @@ class Scheduler {
  protected:
   Scheduler() : stop_(false) {}
   void ParseCpuset(const std::string&, std::vector<int>*);
+  size_t StackSize(const std::string& name);
 
   AtomicRWLock id_cr_lock_;
   std::unordered_map<uint64_t, std::mutex> id_cr_wl_;
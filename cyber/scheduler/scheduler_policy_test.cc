@@ -21,6 +21,7 @@
 #include "cyber/cyber.h"
 #include "cyber/scheduler/policy/choreography_context.h"
 #include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/policy/edf_context.h"
 #include "cyber/scheduler/policy/scheduler_choreography.h"
 #include "cyber/scheduler/policy/scheduler_classic.h"
 #include "cyber/scheduler/processor.h"
@@ -74,6 +75,109 @@ TEST(SchedulerPolicyTest, classic) {
   processor->Stop();
 }
 
+TEST(SchedulerPolicyTest, classic_work_stealing) {
+  const std::string group_name("work_stealing_grp");
+  auto ctx0 = std::make_shared<ClassicContext>();
+  auto ctx1 = std::make_shared<ClassicContext>();
+  ctx0->SetGroupName(group_name);
+  ctx1->SetGroupName(group_name);
+  ctx0->EnableWorkStealing();
+  ctx1->EnableWorkStealing();
+  EXPECT_TRUE(ClassicContext::IsWorkStealing(group_name));
+  EXPECT_FALSE(ClassicContext::IsWorkStealing(DEFAULT_GROUP_NAME));
+
+  auto cr0 = std::make_shared<CRoutine>(func);
+  cr0->set_id(GlobalData::RegisterTaskName("work_stealing_cr0"));
+  cr0->set_group_name(group_name);
+  cr0->set_priority(2);
+  auto cr1 = std::make_shared<CRoutine>(func);
+  cr1->set_id(GlobalData::RegisterTaskName("work_stealing_cr1"));
+  cr1->set_group_name(group_name);
+  cr1->set_priority(1);
+  ClassicContext::Enqueue(cr0);
+  ClassicContext::Enqueue(cr1);
+  EXPECT_EQ(cr0->processor_id(), 0);
+  EXPECT_EQ(cr1->processor_id(), 1);
+
+  // nothing of the peer is notified, so nothing is stolen
+  cr1->set_state(croutine::RoutineState::DATA_WAIT);
+  EXPECT_EQ(ctx1->NextRoutine(), nullptr);
+
+  ClassicContext::NotifyReady(cr0);
+  EXPECT_EQ(ctx1->NextRoutine(), cr0);
+  EXPECT_EQ(ctx1->steal_count(), 1);
+  cr0->Release();
+
+  EXPECT_TRUE(ClassicContext::RemoveCRoutine(cr0));
+  EXPECT_TRUE(ClassicContext::RemoveCRoutine(cr1));
+  EXPECT_FALSE(ClassicContext::RemoveCRoutine(cr1));
+  ctx0->Shutdown();
+  ctx1->Shutdown();
+}
+
+TEST(SchedulerPolicyTest, classic_dedicated) {
+  const std::string group_name("dedicated_grp");
+  auto ctx = std::make_shared<ClassicContext>();
+  ctx->SetGroupName(group_name);
+  auto processor = std::make_shared<Processor>();
+  processor->SetDedicated(true);
+  processor->BindContext(ctx);
+  // let the processor find its run queues empty first
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  std::atomic<bool> done = {false};
+  auto cr = std::make_shared<CRoutine>([&done]() { done.store(true); });
+  cr->set_id(GlobalData::RegisterTaskName("dedicated_cr"));
+  {
+    base::WriteLockGuard<AtomicRWLock> lk(
+        ClassicContext::rq_locks_[group_name][0]);
+    ClassicContext::cr_group_[group_name][0].emplace_back(cr);
+  }
+
+  // nothing notifies the group, a dedicated processor finds it by polling
+  for (int i = 0; i < 1000 && !done.load(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(done.load());
+
+  ctx->Shutdown();
+  processor->Stop();
+  ClassicContext::cr_group_[group_name][0].clear();
+}
+
+TEST(SchedulerPolicyTest, edf) {
+  auto rq = std::make_shared<EdfRunQueue>();
+  auto ctx = std::make_shared<EdfContext>(rq);
+
+  auto cr_slow = std::make_shared<CRoutine>(func);
+  cr_slow->set_id(GlobalData::RegisterTaskName("edf_slow"));
+  cr_slow->set_priority(10);
+  auto cr_urgent = std::make_shared<CRoutine>(func);
+  cr_urgent->set_id(GlobalData::RegisterTaskName("edf_urgent"));
+  cr_urgent->set_priority(1);
+  rq->Enqueue(cr_slow, 100000000);
+  rq->Enqueue(cr_urgent, 1000000);
+
+  // the earlier deadline wins over the higher priority
+  EXPECT_EQ(ctx->NextRoutine(), cr_urgent);
+  cr_urgent->set_state(croutine::RoutineState::DATA_WAIT);
+  cr_urgent->Release();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  // the finished job of cr_urgent is accounted on the next pick
+  EXPECT_EQ(ctx->NextRoutine(), cr_slow);
+  cr_slow->Release();
+  EdfTaskStat stat;
+  EXPECT_TRUE(rq->GetStat(cr_urgent->id(), &stat));
+  EXPECT_EQ(stat.job_count, 1);
+  EXPECT_EQ(stat.deadline_miss_count, 1);
+
+  EXPECT_TRUE(rq->RemoveCRoutine(cr_slow->id()));
+  EXPECT_TRUE(rq->RemoveCRoutine(cr_urgent->id()));
+  EXPECT_FALSE(rq->GetStat(cr_urgent->id(), &stat));
+  ctx->Shutdown();
+}
+
 TEST(SchedulerPolicyTest, sched_classic) {
   GlobalData::Instance()->SetProcessGroup("example_classic_sched");
   auto sched1 = dynamic_cast<SchedulerClassic*>(scheduler::Instance());
@@ -17,20 +17,23 @@
 #ifndef CYBER_SERVICE_CLIENT_H_
 #define CYBER_SERVICE_CLIENT_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
-#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
-#include <tuple>
-#include <unordered_map>
 #include <utility>
 
+#include "cyber/base/histogram.h"
 #include "cyber/common/log.h"
 #include "cyber/common/types.h"
+#include "cyber/croutine/croutine.h"
 
 #include "cyber/node/node_channel_impl.h"
 #include "cyber/service/client_base.h"
+#include "cyber/service/pending_requests.h"
 
 namespace apollo {
 namespace cyber {
@@ -72,6 +75,13 @@ class Client : public ClientBase {
   bool ServiceIsReady() const;
   void Destroy();
 
+  // Round trip times of the answered requests, in nanoseconds.
+  const base::Histogram& latency() const { return latency_; }
+  // Requests of SendRequest() which got no response in time.
+  uint64_t timeout_count() const {
+    return timeout_count_.load(std::memory_order_relaxed);
+  }
+
   template <typename RatioT = std::milli>
   bool WaitForService(std::chrono::duration<int64_t, RatioT> timeout =
                           std::chrono::duration<int64_t, RatioT>(-1)) {
@@ -80,6 +90,25 @@ class Client : public ClientBase {
   }
 
  private:
+  struct PendingRequest {
+    SharedPromise promise;
+    CallbackType callback;
+    SharedFuture future;
+    uint64_t send_time = 0;
+  };
+
+  SharedFuture SendPendingRequest(SharedRequest request, CallbackType&& cb,
+                                  uint64_t* seq);
+  // Yields the croutine while waiting when called from one, so that the
+  // processor runs other croutines meanwhile.
+  static bool WaitForResponse(const SharedFuture& future,
+                              const std::chrono::seconds& timeout_s);
+  static uint64_t MonoTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
   void HandleResponse(const std::shared_ptr<Response>& response,
                       const transport::MessageInfo& request_info);
   bool IsInit(void) const { return response_receiver_ != nullptr; }
@@ -90,10 +119,9 @@ class Client : public ClientBase {
                      const transport::MessageInfo&)>
       response_callback_;
 
-  std::unordered_map<uint64_t,
-                     std::tuple<SharedPromise, CallbackType, SharedFuture>>
-      pending_requests_;
-  std::mutex pending_requests_mutex_;
+  // Requests are sent without waiting for the responses of the earlier
+  // ones, from any number of threads.
+  PendingRequests<PendingRequest> pending_requests_;
 
   std::shared_ptr<transport::Transmitter<Request>> request_transmitter_;
   std::shared_ptr<transport::Receiver<Response>> response_receiver_;
@@ -101,7 +129,10 @@ class Client : public ClientBase {
   std::string response_channel_;
 
   transport::Identity writer_id_;
-  uint64_t sequence_number_;
+  std::atomic<uint64_t> sequence_number_;
+
+  base::Histogram latency_;
+  std::atomic<uint64_t> timeout_count_ = {0};
 };
 
 template <typename Request, typename Response>
@@ -155,16 +186,44 @@ typename Client<Request, Response>::SharedResponse
 Client<Request, Response>::SendRequest(SharedRequest request,
                                        const std::chrono::seconds& timeout_s) {
   if (!IsInit()) { return nullptr; }
-  auto future = AsyncSendRequest(request);
+  uint64_t seq = 0;
+  auto future = SendPendingRequest(request, [](SharedFuture) {}, &seq);
   if (!future.valid()) {
     return nullptr;
   }
-  auto status = future.wait_for(timeout_s);
-  if (status == std::future_status::ready) {
+  if (WaitForResponse(future, timeout_s)) {
     return future.get();
-  } else {
-    return nullptr;
   }
+  timeout_count_.fetch_add(1, std::memory_order_relaxed);
+  // a late response finds nothing to answer
+  PendingRequest pending;
+  pending_requests_.Take(seq, &pending);
+  return nullptr;
+}
+
+template <typename Request, typename Response>
+bool Client<Request, Response>::WaitForResponse(
+    const SharedFuture& future, const std::chrono::seconds& timeout_s) {
+  auto routine = croutine::CRoutine::GetCurrentRoutine();
+  if (routine == nullptr) {
+    return future.wait_for(timeout_s) == std::future_status::ready;
+  }
+  // Only sleeping croutines are woken on time by the schedulers, so poll,
+  // backing off from 50us to 1ms.
+  auto deadline = std::chrono::steady_clock::now() + timeout_s;
+  croutine::Duration interval(50);
+  while (future.wait_for(std::chrono::seconds(0)) !=
+         std::future_status::ready) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
+    routine->Sleep(std::min(
+        interval,
+        std::chrono::duration_cast<croutine::Duration>(deadline - now)));
+    interval = std::min(interval * 2, croutine::Duration(1000));
+  }
+  return true;
 }
 
 template <typename Request, typename Response>
@@ -193,19 +252,36 @@ template <typename Request, typename Response>
 typename Client<Request, Response>::SharedFuture
 Client<Request, Response>::AsyncSendRequest(SharedRequest request,
                                             CallbackType&& cb) {
-  if (IsInit()) {
-    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-    sequence_number_++;
-    transport::MessageInfo info(writer_id_, sequence_number_, writer_id_);
-    request_transmitter_->Transmit(request, info);
-    SharedPromise call_promise = std::make_shared<Promise>();
-    SharedFuture f(call_promise->get_future());
-    pending_requests_[info.seq_num()] =
-        std::make_tuple(call_promise, std::forward<CallbackType>(cb), f);
-    return f;
-  } else {
+  uint64_t seq = 0;
+  return SendPendingRequest(request, std::forward<CallbackType>(cb), &seq);
+}
+
+template <typename Request, typename Response>
+typename Client<Request, Response>::SharedFuture
+Client<Request, Response>::SendPendingRequest(SharedRequest request,
+                                              CallbackType&& cb,
+                                              uint64_t* seq) {
+  if (!IsInit()) {
     return std::shared_future<std::shared_ptr<Response>>();
   }
+  *seq = sequence_number_.fetch_add(1, std::memory_order_relaxed) + 1;
+  PendingRequest pending;
+  pending.promise = std::make_shared<Promise>();
+  pending.future = pending.promise->get_future();
+  pending.callback = std::forward<CallbackType>(cb);
+  SharedFuture f = pending.future;
+  // registered before sending, the response may come right away
+  pending.send_time = MonoTimeNs();
+  PendingRequest evicted;
+  if (pending_requests_.Add(*seq, std::move(pending), &evicted)) {
+    AWARN << "too many pending requests of " << service_name_
+          << ", the oldest gets no response.";
+    evicted.promise->set_value(nullptr);
+    evicted.callback(evicted.future);
+  }
+  transport::MessageInfo info(writer_id_, *seq, writer_id_);
+  request_transmitter_->Transmit(request, info);
+  return f;
 }
 
 template <typename Request, typename Response>
@@ -218,21 +294,16 @@ void Client<Request, Response>::HandleResponse(
     const std::shared_ptr<Response>& response,
     const transport::MessageInfo& request_header) {
   ADEBUG << "client recv response.";
-  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
   if (request_header.spare_id() != writer_id_) {
     return;
   }
-  uint64_t sequence_number = request_header.seq_num();
-  if (this->pending_requests_.count(sequence_number) == 0) {
+  PendingRequest pending;
+  if (!pending_requests_.Take(request_header.seq_num(), &pending)) {
     return;
   }
-  auto tuple = this->pending_requests_[sequence_number];
-  auto call_promise = std::get<0>(tuple);
-  auto callback = std::get<1>(tuple);
-  auto future = std::get<2>(tuple);
-  this->pending_requests_.erase(sequence_number);
-  call_promise->set_value(response);
-  callback(future);
+  latency_.Record(MonoTimeNs() - pending.send_time);
+  pending.promise->set_value(response);
+  pending.callback(pending.future);
 }
 
 }  // namespace cyber
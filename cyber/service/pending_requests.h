@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SERVICE_PENDING_REQUESTS_H_
+#define CYBER_SERVICE_PENDING_REQUESTS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+
+// The requests of a client waiting for their responses, keyed by sequence
+// number. A fixed ring of Capacity slots, claimed with a compare-and-swap on
+// the state of the slot, so that sending requests and handling responses
+// never take a lock. A request shares its slot with those Capacity sequence
+// numbers apart, and is evicted by them if it is still waiting.
+template <typename T, std::size_t Capacity = 256>
+class PendingRequests {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of 2.");
+
+ public:
+  // Adds `value` as the request `seq`, which must not be 0. Returns true if
+  // an older request had to be moved out of the slot to `evicted`.
+  bool Add(uint64_t seq, T&& value, T* evicted) {
+    Slot& slot = slots_[seq & (Capacity - 1)];
+    uint64_t state = slot.state.load(std::memory_order_acquire);
+    while (state == kBusy || !slot.state.compare_exchange_weak(
+                                 state, kBusy, std::memory_order_acquire)) {
+      if (state == kBusy) {
+        state = slot.state.load(std::memory_order_acquire);
+      }
+    }
+    bool has_evicted = state != kFree;
+    if (has_evicted) {
+      *evicted = std::move(slot.value);
+    }
+    slot.value = std::move(value);
+    slot.state.store(seq, std::memory_order_release);
+    return has_evicted;
+  }
+
+  // Moves the request `seq` out to `value`, false if it is not waiting, e.g.
+  // it was answered or evicted already.
+  bool Take(uint64_t seq, T* value) {
+    Slot& slot = slots_[seq & (Capacity - 1)];
+    uint64_t state = seq;
+    if (!slot.state.compare_exchange_strong(state, kBusy,
+                                            std::memory_order_acquire)) {
+      return false;
+    }
+    *value = std::move(slot.value);
+    slot.value = T();
+    slot.state.store(kFree, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  static constexpr uint64_t kFree = 0;
+  static constexpr uint64_t kBusy = UINT64_MAX;
+
+  struct Slot {
+    // kFree, kBusy while claimed, or the sequence number of the request
+    std::atomic<uint64_t> state = {kFree};
+    T value;
+  };
+
+  Slot slots_[Capacity];
+};
+
+template <typename T, std::size_t Capacity>
+constexpr uint64_t PendingRequests<T, Capacity>::kFree;
+template <typename T, std::size_t Capacity>
+constexpr uint64_t PendingRequests<T, Capacity>::kBusy;
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SERVICE_PENDING_REQUESTS_H_
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/service/pending_requests.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+TEST(PendingRequestsTest, add_take) {
+  PendingRequests<std::shared_ptr<int>, 4> requests;
+  std::shared_ptr<int> value;
+  EXPECT_FALSE(requests.Take(1, &value));
+  EXPECT_FALSE(requests.Add(1, std::make_shared<int>(1), &value));
+  EXPECT_FALSE(requests.Add(2, std::make_shared<int>(2), &value));
+  // same slot as 1, but another request
+  EXPECT_FALSE(requests.Take(5, &value));
+
+  EXPECT_TRUE(requests.Take(2, &value));
+  EXPECT_EQ(2, *value);
+  EXPECT_FALSE(requests.Take(2, &value));
+  EXPECT_TRUE(requests.Take(1, &value));
+  EXPECT_EQ(1, *value);
+}
+
+TEST(PendingRequestsTest, evict) {
+  PendingRequests<std::shared_ptr<int>, 4> requests;
+  std::shared_ptr<int> value;
+  EXPECT_FALSE(requests.Add(3, std::make_shared<int>(3), &value));
+  EXPECT_TRUE(requests.Add(7, std::make_shared<int>(7), &value));
+  EXPECT_EQ(3, *value);
+  EXPECT_FALSE(requests.Take(3, &value));
+  EXPECT_TRUE(requests.Take(7, &value));
+  EXPECT_EQ(7, *value);
+}
+
+TEST(PendingRequestsTest, concurrent) {
+  PendingRequests<uint64_t, 64> requests;
+  const uint64_t kRequestNum = 100000;
+  std::atomic<uint64_t> sent = {0};
+  std::atomic<uint64_t> evicted_num = {0};
+  std::atomic<uint64_t> taken_num = {0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&]() {
+      uint64_t seq = 0;
+      while ((seq = ++sent) <= kRequestNum) {
+        uint64_t value = seq;
+        uint64_t evicted = 0;
+        if (requests.Add(seq, std::move(value), &evicted)) {
+          ++evicted_num;
+        }
+      }
+    });
+    threads.emplace_back([&]() {
+      for (uint64_t seq = 1; seq <= kRequestNum; ++seq) {
+        uint64_t value = 0;
+        if (requests.Take(seq, &value)) {
+          EXPECT_EQ(seq, value);
+          ++taken_num;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  uint64_t left_num = 0;
+  for (uint64_t seq = 1; seq <= kRequestNum; ++seq) {
+    uint64_t value = 0;
+    if (requests.Take(seq, &value)) {
+      ++left_num;
+    }
+  }
+  // every request is answered, evicted or still waiting, exactly once
+  EXPECT_EQ(kRequestNum, taken_num + evicted_num + left_num);
+}
+
+}  // namespace cyber
+}  // namespace apollo
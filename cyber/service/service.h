@@ -115,10 +115,11 @@ void Service<Request, Response>::Process() {
     if (!inited_) {
       break;
     }
-    if (!tasks_.empty()) {
-      auto task = tasks_.front();
-      tasks_.pop_front();
-      ul.unlock();
+    // handle all the requests queued meanwhile, pipelined by the clients
+    std::list<std::function<void()>> tasks;
+    tasks.swap(tasks_);
+    ul.unlock();
+    for (auto& task : tasks) {
       task();
     }
   }
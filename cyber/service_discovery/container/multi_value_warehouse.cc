@@ -40,12 +40,14 @@ bool MultiValueWarehouse::Add(uint64_t key, const RolePtr& role,
   }
   std::pair<uint64_t, RolePtr> role_pair(key, role);
   roles_.insert(role_pair);
+  processes_[ProcessName(role->attributes())].insert(role_pair);
   return true;
 }
 
 void MultiValueWarehouse::Clear() {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
   roles_.clear();
+  processes_.clear();
 }
 
 std::size_t MultiValueWarehouse::Size() {
@@ -55,7 +57,11 @@ std::size_t MultiValueWarehouse::Size() {
 
 void MultiValueWarehouse::Remove(uint64_t key) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
-  roles_.erase(key);
+  auto range = roles_.equal_range(key);
+  for (auto it = range.first; it != range.second;) {
+    RemoveFromProcess(key, it->second);
+    it = roles_.erase(it);
+  }
 }
 
 void MultiValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
@@ -63,6 +69,7 @@ void MultiValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
   auto range = roles_.equal_range(key);
   for (auto it = range.first; it != range.second;) {
     if (it->second->Match(role->attributes())) {
+      RemoveFromProcess(key, it->second);
       it = roles_.erase(it);
     } else {
       ++it;
@@ -72,13 +79,22 @@ void MultiValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
 
 void MultiValueWarehouse::Remove(const RoleAttributes& target_attr) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto it = roles_.begin(); it != roles_.end();) {
-    auto curr_role = it->second;
-    if (curr_role->Match(target_attr)) {
-      it = roles_.erase(it);
-    } else {
-      ++it;
+  // copied, the candidates may be the process map entry being erased
+  RoleMap matched;
+  for (auto& item : Candidates(target_attr)) {
+    if (item.second->Match(target_attr)) {
+      matched.insert(item);
+    }
+  }
+  for (auto& item : matched) {
+    auto range = roles_.equal_range(item.first);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == item.second) {
+        roles_.erase(it);
+        break;
+      }
     }
+    RemoveFromProcess(item.first, item.second);
   }
 }
 
@@ -146,7 +162,7 @@ bool MultiValueWarehouse::Search(const RoleAttributes& target_attr,
                                  RolePtr* first_matched_role) {
   RETURN_VAL_IF_NULL(first_matched_role, false);
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       *first_matched_role = item.second;
       return true;
@@ -171,7 +187,7 @@ bool MultiValueWarehouse::Search(const RoleAttributes& target_attr,
   RETURN_VAL_IF_NULL(matched_roles, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       matched_roles->emplace_back(item.second);
       find = true;
@@ -186,7 +202,7 @@ bool MultiValueWarehouse::Search(
   RETURN_VAL_IF_NULL(matched_roles_attr, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       matched_roles_attr->emplace_back(item.second->attributes());
       find = true;
@@ -211,6 +227,33 @@ void MultiValueWarehouse::GetAllRoles(std::vector<RoleAttributes>* roles_attr) {
   }
 }
 
+const MultiValueWarehouse::RoleMap& MultiValueWarehouse::Candidates(
+    const RoleAttributes& target_attr) const {
+  if (!HasProcess(target_attr)) {
+    return roles_;
+  }
+  static const RoleMap empty;
+  auto search = processes_.find(ProcessName(target_attr));
+  return search == processes_.end() ? empty : search->second;
+}
+
+void MultiValueWarehouse::RemoveFromProcess(uint64_t key, const RolePtr& role) {
+  auto process = processes_.find(ProcessName(role->attributes()));
+  if (process == processes_.end()) {
+    return;
+  }
+  auto range = process->second.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == role) {
+      process->second.erase(it);
+      break;
+    }
+  }
+  if (process->second.empty()) {
+    processes_.erase(process);
+  }
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_CONTAINER_MULTI_VALUE_WAREHOUSE_H_
 
 #include <stdint.h>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -67,7 +68,14 @@ class MultiValueWarehouse : public WarehouseBase {
   void GetAllRoles(std::vector<proto::RoleAttributes>* roles_attr) override;
 
  private:
+  using ProcessMap = std::unordered_map<std::string, RoleMap>;
+
+  const RoleMap& Candidates(const proto::RoleAttributes& target_attr) const;
+  void RemoveFromProcess(uint64_t key, const RolePtr& role);
+
   RoleMap roles_;
+  // the same roles again, grouped by ProcessName
+  ProcessMap processes_;
   base::AtomicRWLock rw_lock_;
 };
 
@@ -35,13 +35,19 @@ bool SingleValueWarehouse::Add(uint64_t key, const RolePtr& role,
       return false;
     }
   }
+  auto search = roles_.find(key);
+  if (search != roles_.end()) {
+    RemoveFromProcess(key, search->second);
+  }
   roles_[key] = role;
+  processes_[ProcessName(role->attributes())][key] = role;
   return true;
 }
 
 void SingleValueWarehouse::Clear() {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
   roles_.clear();
+  processes_.clear();
 }
 
 std::size_t SingleValueWarehouse::Size() {
@@ -51,7 +57,12 @@ std::size_t SingleValueWarehouse::Size() {
 
 void SingleValueWarehouse::Remove(uint64_t key) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
-  roles_.erase(key);
+  auto search = roles_.find(key);
+  if (search == roles_.end()) {
+    return;
+  }
+  RemoveFromProcess(key, search->second);
+  roles_.erase(search);
 }
 
 void SingleValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
@@ -63,19 +74,23 @@ void SingleValueWarehouse::Remove(uint64_t key, const RolePtr& role) {
   if (!search->second->Match(role->attributes())) {
     return;
   }
+  RemoveFromProcess(key, search->second);
   roles_.erase(search);
 }
 
 void SingleValueWarehouse::Remove(const RoleAttributes& target_attr) {
   WriteLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto it = roles_.begin(); it != roles_.end();) {
-    auto curr_role = it->second;
-    if (curr_role->Match(target_attr)) {
-      it = roles_.erase(it);
-    } else {
-      ++it;
+  // copied, the candidates may be the process map entry being erased
+  RoleMap matched;
+  for (auto& item : Candidates(target_attr)) {
+    if (item.second->Match(target_attr)) {
+      matched.insert(item);
     }
   }
+  for (auto& item : matched) {
+    RemoveFromProcess(item.first, item.second);
+    roles_.erase(item.first);
+  }
 }
 
 bool SingleValueWarehouse::Search(uint64_t key) {
@@ -136,7 +151,7 @@ bool SingleValueWarehouse::Search(const RoleAttributes& target_attr,
                                   RolePtr* first_matched_role) {
   RETURN_VAL_IF_NULL(first_matched_role, false);
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       *first_matched_role = item.second;
       return true;
@@ -161,7 +176,7 @@ bool SingleValueWarehouse::Search(const RoleAttributes& target_attr,
   RETURN_VAL_IF_NULL(matched_roles, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       matched_roles->emplace_back(item.second);
       find = true;
@@ -176,7 +191,7 @@ bool SingleValueWarehouse::Search(
   RETURN_VAL_IF_NULL(matched_roles_attr, false);
   bool find = false;
   ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  for (auto& item : roles_) {
+  for (auto& item : Candidates(target_attr)) {
     if (item.second->Match(target_attr)) {
       matched_roles_attr->emplace_back(item.second->attributes());
       find = true;
@@ -202,6 +217,28 @@ void SingleValueWarehouse::GetAllRoles(
   }
 }
 
+const SingleValueWarehouse::RoleMap& SingleValueWarehouse::Candidates(
+    const RoleAttributes& target_attr) const {
+  if (!HasProcess(target_attr)) {
+    return roles_;
+  }
+  static const RoleMap empty;
+  auto search = processes_.find(ProcessName(target_attr));
+  return search == processes_.end() ? empty : search->second;
+}
+
+void SingleValueWarehouse::RemoveFromProcess(uint64_t key,
+                                             const RolePtr& role) {
+  auto process = processes_.find(ProcessName(role->attributes()));
+  if (process == processes_.end()) {
+    return;
+  }
+  process->second.erase(key);
+  if (process->second.empty()) {
+    processes_.erase(process);
+  }
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_CONTAINER_WAREHOUSE_BASE_H_
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "cyber/service_discovery/role/role.h"
@@ -26,6 +27,16 @@ namespace apollo {
 namespace cyber {
 namespace service_discovery {
 
+// warehouses index roles by the process they belong to, so searches naming
+// both host_name and process_id don't scan every role
+inline bool HasProcess(const proto::RoleAttributes& attr) {
+  return attr.has_host_name() && attr.has_process_id();
+}
+
+inline std::string ProcessName(const proto::RoleAttributes& attr) {
+  return attr.host_name() + '+' + std::to_string(attr.process_id());
+}
+
 class WarehouseBase {
  public:
   WarehouseBase() {}
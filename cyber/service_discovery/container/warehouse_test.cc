@@ -274,6 +274,46 @@ TEST_F(WarehouseTest, get_all_roles) {
   EXPECT_EQ(role_attr_vec.size(), 2 * key_num_);
 }
 
+TEST_F(WarehouseTest, search_by_process) {
+  RoleAttributes other;
+  other.set_host_name("caros");
+  other.set_process_id(54321);
+  other.set_node_id(key_num_);
+  other.set_channel_id(key_num_);
+  other.set_id(2 * key_num_);
+  auto role = std::make_shared<RoleWriter>(other);
+  single_.Add(key_num_, role);
+  multi_.Add(key_num_, role);
+
+  RoleAttributes process;
+  process.set_host_name("caros");
+  process.set_process_id(54321);
+  std::vector<RolePtr> role_vec;
+  EXPECT_TRUE(single_.Search(process, &role_vec));
+  EXPECT_EQ(role_vec.size(), 1);
+  role_vec.clear();
+  EXPECT_TRUE(multi_.Search(process, &role_vec));
+  EXPECT_EQ(role_vec.size(), 1);
+
+  // replacing a role of the single value warehouse moves it between processes
+  single_.Add(key_num_ - 1, role);
+  role_vec.clear();
+  EXPECT_TRUE(single_.Search(process, &role_vec));
+  EXPECT_EQ(role_vec.size(), 2);
+  process.set_process_id(12345);
+  role_vec.clear();
+  EXPECT_TRUE(single_.Search(process, &role_vec));
+  EXPECT_EQ(role_vec.size(), key_num_ - 1);
+
+  process.set_process_id(54321);
+  single_.Remove(process);
+  multi_.Remove(process);
+  EXPECT_FALSE(single_.Search(process));
+  EXPECT_FALSE(multi_.Search(process));
+  EXPECT_EQ(single_.Size(), key_num_ - 1);
+  EXPECT_EQ(multi_.Size(), 2 * key_num_);
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -19,6 +19,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
+#include "cyber/service_discovery/container/warehouse_base.h"
 #include "cyber/time/time.h"
 #include "cyber/transport/qos/qos_profile_conf.h"
 #include "cyber/transport/rtps/attributes_filler.h"
@@ -32,6 +33,14 @@ namespace service_discovery {
 using transport::AttributesFiller;
 using transport::QosProfileConf;
 
+namespace {
+// changes made within this interval go out in one batch, which folds the
+// burst of joins of a starting process into a few messages
+constexpr std::chrono::milliseconds kBatchInterval(10);
+// a process that stays out of sync is asked again after this long
+constexpr uint64_t kSnapshotRequestIntervalNs = 1000000000;
+}  // namespace
+
 Manager::Manager()
     : is_shutdown_(false),
       is_discovery_started_(false),
@@ -40,7 +49,11 @@ Manager::Manager()
       channel_name_(""),
       publisher_(nullptr),
       subscriber_(nullptr),
-      listener_(nullptr) {
+      listener_(nullptr),
+      snapshot_pending_(false),
+      sequence_(0),
+      start_time_ns_(0),
+      converge_time_ns_(0) {
   host_name_ = common::GlobalData::Instance()->HostName();
   process_id_ = common::GlobalData::Instance()->ProcessId();
 }
@@ -54,11 +67,18 @@ bool Manager::StartDiscovery(RtpsParticipant* participant) {
   if (is_discovery_started_.exchange(true)) {
     return true;
   }
+  start_time_ns_ = cyber::Time::Now().ToNanosecond();
   if (!CreatePublisher(participant) || !CreateSubscriber(participant)) {
     AERROR << "create publisher or subscriber failed.";
     StopDiscovery();
     return false;
   }
+  {
+    std::lock_guard<std::mutex> lock(local_mutex_);
+    // roles joined before discovery started are announced now
+    snapshot_pending_ = !local_roles_.empty();
+  }
+  flush_thread_ = std::thread(&Manager::FlushThread, this);
   return true;
 }
 
@@ -67,6 +87,15 @@ void Manager::StopDiscovery() {
     return;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(local_mutex_);
+    flush_cv_.notify_one();
+  }
+  // publishes what is still pending, e.g. the leaves of a shutdown
+  if (flush_thread_.joinable()) {
+    flush_thread_.join();
+  }
+
   if (publisher_ != nullptr) {
     eprosima::fastrtps::Domain::removePublisher(publisher_);
     publisher_ = nullptr;
@@ -188,26 +217,79 @@ void Manager::OnRemoteChange(const std::string& msg_str) {
     return;
   }
 
-  ChangeMsg msg;
-  RETURN_IF(!message::ParseFromString(msg_str, &msg));
-  if (IsFromSameProcess(msg)) {
+  ChangeMsgBatch batch;
+  RETURN_IF(!message::ParseFromString(msg_str, &batch));
+  if (batch.host_name() == host_name_ && batch.process_id() == process_id_) {
     return;
   }
-  RETURN_IF(!Check(msg.role_attr()));
-  Dispose(msg);
+  for (auto& request : batch.snapshot_request()) {
+    if (request.host_name() == host_name_ &&
+        request.process_id() == process_id_) {
+      std::lock_guard<std::mutex> lock(local_mutex_);
+      snapshot_pending_ = true;
+      flush_cv_.notify_one();
+      break;
+    }
+  }
+  if (!batch.has_sequence()) {
+    return;
+  }
+
+  RoleAttributes process;
+  process.set_host_name(batch.host_name());
+  process.set_process_id(batch.process_id());
+  std::lock_guard<std::mutex> lock(remote_mutex_);
+  auto& state = remotes_[ProcessName(process)];
+  // replayed by the transient local history, or already covered
+  if (batch.sequence() <= state.sequence) {
+    return;
+  }
+  if (batch.snapshot()) {
+    ApplySnapshot(batch, &state);
+    state.sequence = batch.sequence();
+    MarkSynced(&state);
+    return;
+  }
+
+  bool in_order = batch.sequence() == state.sequence + 1;
+  for (auto& msg : batch.change_msg()) {
+    if (Check(msg.role_attr())) {
+      ApplyRemote(msg, &state);
+    }
+  }
+  state.sequence = batch.sequence();
+  if (in_order && (state.synced || batch.sequence() == 1)) {
+    MarkSynced(&state);
+    return;
+  }
+
+  // some changes were missed, ask the process for all of its roles
+  state.synced = false;
+  uint64_t now = cyber::Time::Now().ToNanosecond();
+  if (now - state.request_time_ns < kSnapshotRequestIntervalNs) {
+    return;
+  }
+  state.request_time_ns = now;
+  std::lock_guard<std::mutex> local_lock(local_mutex_);
+  pending_requests_.emplace_back(process);
+  flush_cv_.notify_one();
 }
 
 bool Manager::Publish(const ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lock(local_mutex_);
+  auto key = RoleKey(msg);
+  if (msg.operate_type() == OperateType::OPT_JOIN) {
+    local_roles_[key] = msg;
+  } else {
+    local_roles_.erase(key);
+  }
+
   if (!is_discovery_started_.load()) {
     ADEBUG << "discovery is not started.";
     return true;
   }
-
-  apollo::cyber::transport::UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
-  if (publisher_ != nullptr) {
-    return publisher_->write(reinterpret_cast<void*>(&m));
-  }
+  pending_changes_.emplace_back(msg);
+  flush_cv_.notify_one();
   return true;
 }
 
@@ -221,6 +303,136 @@ bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
   return true;
 }
 
+void Manager::ForgetRemote(const std::string& host_name, int process_id) {
+  RoleAttributes process;
+  process.set_host_name(host_name);
+  process.set_process_id(process_id);
+  std::lock_guard<std::mutex> lock(remote_mutex_);
+  remotes_.erase(ProcessName(process));
+}
+
+bool Manager::IsConverged() {
+  std::lock_guard<std::mutex> lock(remote_mutex_);
+  for (auto& item : remotes_) {
+    if (!item.second.synced) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string Manager::RoleKey(const ChangeMsg& msg) {
+  auto& attr = msg.role_attr();
+  return std::to_string(msg.role_type()) + '/' +
+         std::to_string(attr.node_id()) + '/' +
+         std::to_string(attr.channel_id()) + '/' +
+         std::to_string(attr.service_id()) + '/' + std::to_string(attr.id());
+}
+
+void Manager::FlushThread() {
+  while (true) {
+    ChangeMsgBatch batch;
+    {
+      std::unique_lock<std::mutex> lock(local_mutex_);
+      auto pending = [this] {
+        return snapshot_pending_ || !pending_changes_.empty() ||
+               !pending_requests_.empty();
+      };
+      flush_cv_.wait(lock, [this, &pending] {
+        return !is_discovery_started_.load() || pending();
+      });
+      if (is_discovery_started_.load()) {
+        flush_cv_.wait_for(lock, kBatchInterval,
+                           [this] { return !is_discovery_started_.load(); });
+      }
+      if (!pending()) {
+        return;
+      }
+
+      batch.set_host_name(host_name_);
+      batch.set_process_id(process_id_);
+      for (auto& request : pending_requests_) {
+        batch.add_snapshot_request()->CopyFrom(request);
+      }
+      if (snapshot_pending_) {
+        // the snapshot already includes the pending changes
+        batch.set_snapshot(true);
+        for (auto& item : local_roles_) {
+          batch.add_change_msg()->CopyFrom(item.second);
+        }
+      } else {
+        for (auto& msg : pending_changes_) {
+          batch.add_change_msg()->CopyFrom(msg);
+        }
+      }
+      if (snapshot_pending_ || !pending_changes_.empty()) {
+        batch.set_sequence(++sequence_);
+      }
+      snapshot_pending_ = false;
+      pending_changes_.clear();
+      pending_requests_.clear();
+    }
+    if (!PublishBatch(batch)) {
+      AWARN << "publish change batch " << batch.sequence() << " of "
+            << channel_name_ << " failed.";
+    }
+  }
+}
+
+bool Manager::PublishBatch(const ChangeMsgBatch& batch) {
+  apollo::cyber::transport::UnderlayMessage m;
+  RETURN_VAL_IF(!message::SerializeToString(batch, &m.data()), false);
+  if (publisher_ != nullptr) {
+    return publisher_->write(reinterpret_cast<void*>(&m));
+  }
+  return true;
+}
+
+void Manager::ApplyRemote(const ChangeMsg& msg, RemoteState* state) {
+  auto key = RoleKey(msg);
+  if (msg.operate_type() == OperateType::OPT_JOIN) {
+    if (!state->roles.emplace(key, msg).second) {
+      return;
+    }
+  } else if (state->roles.erase(key) == 0) {
+    return;
+  }
+  Dispose(msg);
+}
+
+void Manager::ApplySnapshot(const ChangeMsgBatch& batch, RemoteState* state) {
+  RoleMap roles;
+  for (auto& msg : batch.change_msg()) {
+    if (Check(msg.role_attr())) {
+      roles.emplace(RoleKey(msg), msg);
+    }
+  }
+  for (auto& item : state->roles) {
+    if (roles.count(item.first) == 0) {
+      ChangeMsg msg(item.second);
+      msg.set_timestamp(cyber::Time::Now().ToNanosecond());
+      msg.set_operate_type(OperateType::OPT_LEAVE);
+      Dispose(msg);
+    }
+  }
+  for (auto& item : roles) {
+    if (state->roles.count(item.first) == 0) {
+      Dispose(item.second);
+    }
+  }
+  state->roles.swap(roles);
+}
+
+void Manager::MarkSynced(RemoteState* state) {
+  if (state->synced) {
+    return;
+  }
+  state->synced = true;
+  converge_time_ns_.store(cyber::Time::Now().ToNanosecond() - start_time_ns_);
+  ADEBUG << channel_name_ << " in sync after "
+         << converge_time_ns_.load() / 1000000 << " ms.";
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -18,9 +18,13 @@
 #define CYBER_SERVICE_DISCOVERY_SPECIFIC_MANAGER_MANAGER_H_
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -38,6 +42,7 @@ namespace cyber {
 namespace service_discovery {
 
 using proto::ChangeMsg;
+using proto::ChangeMsgBatch;
 using proto::ChangeType;
 using proto::OperateType;
 using proto::RoleAttributes;
@@ -70,6 +75,11 @@ class Manager {
   virtual void OnTopoModuleLeave(const std::string& host_name,
                                  int process_id) = 0;
 
+  // true when the roles of every remote process heard of are up to date
+  bool IsConverged();
+  // time from StartDiscovery until the last remote process got in sync
+  uint64_t converge_time_ns() const { return converge_time_ns_.load(); }
+
  protected:
   bool CreatePublisher(RtpsParticipant* participant);
   bool CreateSubscriber(RtpsParticipant* participant);
@@ -85,6 +95,8 @@ class Manager {
   bool Publish(const ChangeMsg& msg);
   void OnRemoteChange(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
+  // drops what is known of a remote process once it left
+  void ForgetRemote(const std::string& host_name, int process_id);
 
   std::atomic<bool> is_shutdown_;
   std::atomic<bool> is_discovery_started_;
@@ -98,6 +110,41 @@ class Manager {
   SubscriberListener* listener_;
 
   ChangeSignal signal_;
+
+ private:
+  // key: RoleKey
+  using RoleMap = std::unordered_map<std::string, ChangeMsg>;
+
+  struct RemoteState {
+    uint64_t sequence = 0;
+    bool synced = false;
+    uint64_t request_time_ns = 0;
+    RoleMap roles;
+  };
+
+  static std::string RoleKey(const ChangeMsg& msg);
+
+  void FlushThread();
+  bool PublishBatch(const ChangeMsgBatch& batch);
+  void ApplyRemote(const ChangeMsg& msg, RemoteState* state);
+  void ApplySnapshot(const ChangeMsgBatch& batch, RemoteState* state);
+  void MarkSynced(RemoteState* state);
+
+  // local roles and the changes not published yet, guarded by local_mutex_
+  std::mutex local_mutex_;
+  std::condition_variable flush_cv_;
+  RoleMap local_roles_;
+  std::vector<ChangeMsg> pending_changes_;
+  std::vector<RoleAttributes> pending_requests_;
+  bool snapshot_pending_;
+  uint64_t sequence_;
+  std::thread flush_thread_;
+
+  // key: ProcessName
+  std::mutex remote_mutex_;
+  std::unordered_map<std::string, RemoteState> remotes_;
+  uint64_t start_time_ns_;
+  std::atomic<uint64_t> converge_time_ns_;
 };
 
 }  // namespace service_discovery
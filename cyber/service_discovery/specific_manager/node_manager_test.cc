@@ -27,6 +27,24 @@ namespace apollo {
 namespace cyber {
 namespace service_discovery {
 
+class RemoteNodeManager : public NodeManager {
+ public:
+  using NodeManager::OnRemoteChange;
+};
+
+void AddNodeChange(const std::string& node_name, OperateType opt,
+                   ChangeMsgBatch* batch) {
+  auto msg = batch->add_change_msg();
+  msg->set_change_type(ChangeType::CHANGE_NODE);
+  msg->set_operate_type(opt);
+  msg->set_role_type(RoleType::ROLE_NODE);
+  auto attr = msg->mutable_role_attr();
+  attr->set_host_name(batch->host_name());
+  attr->set_process_id(batch->process_id());
+  attr->set_node_name(node_name);
+  attr->set_node_id(common::GlobalData::RegisterNode(node_name));
+}
+
 class NodeManagerTest : public ::testing::Test {
  protected:
   NodeManagerTest() { node_manager_ = std::make_shared<NodeManager>(); }
@@ -128,6 +146,48 @@ TEST_F(NodeManagerTest, get_nodes) {
   EXPECT_EQ(attr_nodes.size(), 1);
 }
 
+TEST(NodeManagerRemoteTest, snapshot_and_delta) {
+  RemoteNodeManager node_manager;
+  ChangeMsgBatch batch;
+  batch.set_host_name("remote_host");
+  batch.set_process_id(4096);
+
+  batch.set_sequence(1);
+  AddNodeChange("remote_node", OperateType::OPT_JOIN, &batch);
+  node_manager.OnRemoteChange(batch.SerializeAsString());
+  EXPECT_TRUE(node_manager.HasNode("remote_node"));
+  EXPECT_TRUE(node_manager.IsConverged());
+
+  // sequence 2 is lost, the manager falls out of sync
+  batch.clear_change_msg();
+  batch.set_sequence(3);
+  AddNodeChange("remote_node_3", OperateType::OPT_JOIN, &batch);
+  node_manager.OnRemoteChange(batch.SerializeAsString());
+  EXPECT_TRUE(node_manager.HasNode("remote_node_3"));
+  EXPECT_FALSE(node_manager.IsConverged());
+
+  // the snapshot replaces all that is known of the process
+  batch.clear_change_msg();
+  batch.set_sequence(4);
+  batch.set_snapshot(true);
+  AddNodeChange("remote_node_2", OperateType::OPT_JOIN, &batch);
+  AddNodeChange("remote_node_3", OperateType::OPT_JOIN, &batch);
+  node_manager.OnRemoteChange(batch.SerializeAsString());
+  EXPECT_FALSE(node_manager.HasNode("remote_node"));
+  EXPECT_TRUE(node_manager.HasNode("remote_node_2"));
+  EXPECT_TRUE(node_manager.HasNode("remote_node_3"));
+  EXPECT_TRUE(node_manager.IsConverged());
+
+  // a replayed batch is ignored
+  batch.clear_change_msg();
+  batch.set_sequence(2);
+  batch.set_snapshot(false);
+  AddNodeChange("remote_node_2", OperateType::OPT_LEAVE, &batch);
+  node_manager.OnRemoteChange(batch.SerializeAsString());
+  EXPECT_TRUE(node_manager.HasNode("remote_node_2"));
+  node_manager.Shutdown();
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
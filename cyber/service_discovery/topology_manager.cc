@@ -16,6 +16,8 @@
 
 #include "cyber/service_discovery/topology_manager.h"
 
+#include <algorithm>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
@@ -64,6 +66,23 @@ void TopologyManager::RemoveChangeListener(const ChangeConnection& conn) {
   local_conn.Disconnect();
 }
 
+bool TopologyManager::IsConverged() {
+  if (!init_.load()) {
+    return false;
+  }
+  return node_manager_->IsConverged() && channel_manager_->IsConverged() &&
+         service_manager_->IsConverged();
+}
+
+uint64_t TopologyManager::ConvergeTimeNs() {
+  if (!init_.load()) {
+    return 0;
+  }
+  return std::max({node_manager_->converge_time_ns(),
+                   channel_manager_->converge_time_ns(),
+                   service_manager_->converge_time_ns()});
+}
+
 bool TopologyManager::Init() {
   if (init_.exchange(true)) {
     return true;
@@ -65,6 +65,11 @@ class TopologyManager {
   ChannelManagerPtr& channel_manager() { return channel_manager_; }
   ServiceManagerPtr& service_manager() { return service_manager_; }
 
+  // true when every manager is in sync with all processes heard of
+  bool IsConverged();
+  // time from the start of discovery until the topology was last in sync
+  uint64_t ConvergeTimeNs();
+
  private:
   bool Init();
 
@@ -17,7 +17,10 @@
 #ifndef CYBER_TASK_TASK_H_
 #define CYBER_TASK_TASK_H_
 
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <memory>
 #include <utility>
 
 #include "cyber/task/task_manager.h"
@@ -40,6 +43,78 @@ static inline void Yield() {
   }
 }
 
+namespace detail {
+
+// Shared by the caller and the helper tasks of one ParallelFor. Chunks are
+// claimed through a single counter, so no task object is created per chunk,
+// and a helper that starts late finds nothing to claim and never touches
+// the user function.
+template <typename F>
+struct ParallelForState {
+  ParallelForState(size_t b, size_t e, size_t g, F* f)
+      : begin(b), end(e), grain(g), chunk_num((e - b + g - 1) / g), func(f) {}
+
+  void Work() {
+    size_t chunk = 0;
+    while ((chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) <
+           chunk_num) {
+      size_t first = begin + chunk * grain;
+      size_t last = std::min(first + grain, end);
+      for (size_t i = first; i < last; ++i) {
+        (*func)(i);
+      }
+      done_chunk.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  const size_t begin;
+  const size_t end;
+  const size_t grain;
+  const size_t chunk_num;
+  F* func;
+  std::atomic<size_t> next_chunk = {0};
+  std::atomic<size_t> done_chunk = {0};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Calls func(i) for every i in [begin, end) on the task pool.
+ *
+ * The range is cut into chunks of |grain| indices, 0 picks a grain giving
+ * every task processor a few chunks. The calling thread or croutine works on
+ * the chunks as well and returns once all of them are done, so ParallelFor
+ * may be nested or called from inside a task.
+ */
+template <typename F>
+static void ParallelFor(size_t begin, size_t end, size_t grain, F&& func) {
+  if (begin >= end) {
+    return;
+  }
+  auto task_manager = TaskManager::Instance();
+  size_t worker_num = task_manager->pool_size() + 1;
+  if (grain == 0) {
+    grain = std::max<size_t>(1, (end - begin) / (worker_num * 4));
+  }
+  size_t chunk_num = (end - begin + grain - 1) / grain;
+  if (chunk_num <= 1 || worker_num <= 1) {
+    for (size_t i = begin; i < end; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  using State =
+      detail::ParallelForState<typename std::remove_reference<F>::type>;
+  auto state = std::make_shared<State>(begin, end, grain, &func);
+  auto helper_num = static_cast<uint32_t>(std::min(chunk_num, worker_num) - 1);
+  task_manager->Post([state]() { state->Work(); }, helper_num);
+  state->Work();
+  while (state->done_chunk.load(std::memory_order_acquire) < chunk_num) {
+    Yield();
+  }
+}
+
 template <typename Rep, typename Period>
 static void SleepFor(const std::chrono::duration<Rep, Period>& sleep_duration) {
   auto routine = croutine::CRoutine::GetCurrentRoutine();
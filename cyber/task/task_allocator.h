@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TASK_TASK_ALLOCATOR_H_
+#define CYBER_TASK_TASK_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "cyber/base/mpmc_queue.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief Free lists of small blocks for the shared states of task futures.
+ *
+ * Blocks are grouped in size classes of kBlockSize bytes and kept in
+ * lock-free queues, freeing a block on one thread and reusing it on another
+ * is the common case. Larger requests and overflow go to malloc.
+ */
+class TaskMemoryPool {
+ public:
+  static constexpr size_t kBlockSize = 64;
+  static constexpr size_t kClassNum = 4;
+  static constexpr uint64_t kFreeListSize = 1024;
+
+  void* Allocate(size_t size) {
+    auto index = ClassIndex(size);
+    void* block = nullptr;
+    if (index < kClassNum && free_lists_[index].Dequeue(&block)) {
+      return block;
+    }
+    size = index < kClassNum ? (index + 1) * kBlockSize : size;
+    block = std::malloc(size);
+    if (block == nullptr) {
+      throw std::bad_alloc();
+    }
+    return block;
+  }
+
+  void Deallocate(void* block, size_t size) {
+    auto index = ClassIndex(size);
+    if (index < kClassNum && free_lists_[index].Enqueue(block)) {
+      return;
+    }
+    std::free(block);
+  }
+
+  uint64_t FreeBlockNum() {
+    uint64_t num = 0;
+    for (auto& free_list : free_lists_) {
+      num += free_list.Size();
+    }
+    return num;
+  }
+
+ private:
+  static size_t ClassIndex(size_t size) {
+    return size == 0 ? 0 : (size - 1) / kBlockSize;
+  }
+
+  base::MPMCQueue<void*> free_lists_[kClassNum];
+
+  DECLARE_SINGLETON(TaskMemoryPool)
+};
+
+inline TaskMemoryPool::TaskMemoryPool() {
+  for (auto& free_list : free_lists_) {
+    free_list.Init(kFreeListSize);
+  }
+}
+
+// Stateless allocator handing out pooled blocks, meant for
+// std::promise(std::allocator_arg, TaskAllocator<T>()).
+template <typename T>
+struct TaskAllocator {
+  using value_type = T;
+
+  TaskAllocator() = default;
+  template <typename U>
+  TaskAllocator(const TaskAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(TaskMemoryPool::Instance()->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    TaskMemoryPool::Instance()->Deallocate(p, n * sizeof(T));
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const TaskAllocator<T>&, const TaskAllocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const TaskAllocator<T>&, const TaskAllocator<U>&) {
+  return false;
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TASK_TASK_ALLOCATOR_H_
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TASK_TASK_FUNCTION_H_
+#define CYBER_TASK_TASK_FUNCTION_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief A move-only void() callable with inline storage.
+ *
+ * Callables of up to kInlineSize bytes, which covers a bound member function
+ * with a few arguments and its promise, are stored in place, so moving a
+ * task through the task queue never allocates. Larger ones go to the heap.
+ */
+class TaskFunction {
+ public:
+  static constexpr size_t kInlineSize = 96;
+
+  TaskFunction() = default;
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<
+                typename std::decay<F>::type, TaskFunction>::value>::type>
+  TaskFunction(F&& func) {  // NOLINT
+    using Func = typename std::decay<F>::type;
+    Construct<Func>(std::forward<F>(func), StoredInline<Func>());
+  }
+
+  TaskFunction(TaskFunction&& other) noexcept { MoveFrom(&other); }
+
+  TaskFunction& operator=(TaskFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(&other);
+    }
+    return *this;
+  }
+
+  TaskFunction(const TaskFunction&) = delete;
+  TaskFunction& operator=(const TaskFunction&) = delete;
+
+  ~TaskFunction() { Reset(); }
+
+  explicit operator bool() const { return invoke_ != nullptr; }
+
+  void operator()() { invoke_(&storage_); }
+
+  void Reset() {
+    if (manage_ != nullptr) {
+      manage_(Operation::DESTROY, &storage_, nullptr);
+      manage_ = nullptr;
+      invoke_ = nullptr;
+    }
+  }
+
+ private:
+  enum class Operation { MOVE, DESTROY };
+
+  template <typename Func>
+  using StoredInline = std::integral_constant<
+      bool, sizeof(Func) <= kInlineSize &&
+                alignof(Func) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible<Func>::value>;
+
+  using Invoker = void (*)(void*);
+  using Manager = void (*)(Operation, void*, void*);
+
+  template <typename Func, typename F>
+  void Construct(F&& func, std::true_type /* inline */) {
+    new (&storage_) Func(std::forward<F>(func));
+    invoke_ = [](void* storage) { (*static_cast<Func*>(storage))(); };
+    manage_ = [](Operation op, void* src, void* dst) {
+      auto func = static_cast<Func*>(src);
+      if (op == Operation::MOVE) {
+        new (dst) Func(std::move(*func));
+      }
+      func->~Func();
+    };
+  }
+
+  template <typename Func, typename F>
+  void Construct(F&& func, std::false_type /* inline */) {
+    *reinterpret_cast<Func**>(&storage_) = new Func(std::forward<F>(func));
+    invoke_ = [](void* storage) { (**static_cast<Func**>(storage))(); };
+    manage_ = [](Operation op, void* src, void* dst) {
+      auto func = static_cast<Func**>(src);
+      if (op == Operation::MOVE) {
+        *static_cast<Func**>(dst) = *func;
+      } else {
+        delete *func;
+      }
+    };
+  }
+
+  void MoveFrom(TaskFunction* other) {
+    if (other->manage_ != nullptr) {
+      other->manage_(Operation::MOVE, &other->storage_, &storage_);
+      invoke_ = other->invoke_;
+      manage_ = other->manage_;
+      other->invoke_ = nullptr;
+      other->manage_ = nullptr;
+    }
+  }
+
+  typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type
+      storage_;
+  Invoker invoke_ = nullptr;
+  Manager manage_ = nullptr;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TASK_TASK_FUNCTION_H_
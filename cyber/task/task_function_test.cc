@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/task/task_function.h"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "cyber/task/task_allocator.h"
+
+namespace apollo {
+namespace cyber {
+
+TEST(TaskFunctionTest, inline_and_heap) {
+  int count = 0;
+  TaskFunction small([&count]() { ++count; });
+  std::array<char, TaskFunction::kInlineSize + 1> padding{};
+  TaskFunction large([&count, padding]() { count += 1 + padding[0]; });
+  small();
+  large();
+  EXPECT_EQ(count, 2);
+
+  TaskFunction moved(std::move(large));
+  EXPECT_FALSE(large);
+  ASSERT_TRUE(moved);
+  moved();
+  moved = std::move(small);
+  moved();
+  EXPECT_EQ(count, 4);
+
+  TaskFunction empty;
+  EXPECT_FALSE(empty);
+}
+
+TEST(TaskFunctionTest, destroy_target) {
+  auto resource = std::make_shared<int>(1);
+  {
+    TaskFunction task([resource]() {});
+    EXPECT_EQ(resource.use_count(), 2);
+    TaskFunction other(std::move(task));
+    EXPECT_EQ(resource.use_count(), 2);
+  }
+  EXPECT_EQ(resource.use_count(), 1);
+}
+
+TEST(TaskAllocatorTest, reuse_blocks) {
+  auto pool = TaskMemoryPool::Instance();
+  void* block = pool->Allocate(40);
+  auto free_num = pool->FreeBlockNum();
+  pool->Deallocate(block, 40);
+  EXPECT_EQ(pool->FreeBlockNum(), free_num + 1);
+  EXPECT_EQ(pool->Allocate(TaskMemoryPool::kBlockSize), block);
+  pool->Deallocate(block, TaskMemoryPool::kBlockSize);
+
+  {
+    std::promise<int> promise(std::allocator_arg, TaskAllocator<int>());
+    auto future = promise.get_future();
+    promise.set_value(3);
+    EXPECT_EQ(future.get(), 3);
+  }
+  // the shared state went back to the pool
+  EXPECT_GT(pool->FreeBlockNum(), free_num);
+}
+
+}  // namespace cyber
+}  // namespace apollo
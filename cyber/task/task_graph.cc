@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/task/task_graph.h"
+
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace cyber {
+
+TaskGraph::TaskGraph() : state_(new State()) {}
+
+size_t TaskGraph::AddTask(std::function<void()> func) {
+  std::unique_ptr<Node> node(new Node());
+  node->func = std::move(func);
+  state_->nodes.emplace_back(std::move(node));
+  validated_ = false;
+  return state_->nodes.size() - 1;
+}
+
+bool TaskGraph::Precede(size_t before, size_t after) {
+  auto& nodes = state_->nodes;
+  if (before >= nodes.size() || after >= nodes.size() || before == after) {
+    AERROR << "invalid dependency " << before << " -> " << after;
+    return false;
+  }
+  nodes[before]->successors.push_back(after);
+  nodes[after]->dependency_num++;
+  validated_ = false;
+  return true;
+}
+
+bool TaskGraph::Validate() const {
+  // Kahn's algorithm, every node must be reachable from a root
+  auto& nodes = state_->nodes;
+  std::vector<uint32_t> dependency_num(nodes.size());
+  std::vector<size_t> ready;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    dependency_num[i] = nodes[i]->dependency_num;
+    if (dependency_num[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+  size_t visited = 0;
+  while (!ready.empty()) {
+    auto id = ready.back();
+    ready.pop_back();
+    ++visited;
+    for (auto successor : nodes[id]->successors) {
+      if (--dependency_num[successor] == 0) {
+        ready.push_back(successor);
+      }
+    }
+  }
+  return visited == nodes.size();
+}
+
+bool TaskGraph::Run() {
+  auto& nodes = state_->nodes;
+  if (nodes.empty()) {
+    return true;
+  }
+  if (!validated_) {
+    if (!Validate()) {
+      AERROR << "task graph has a cycle";
+      return false;
+    }
+    if (state_->ready_queue == nullptr ||
+        state_->ready_queue->Capacity() < nodes.size()) {
+      // helpers of a previous run may still hold the old state
+      auto state = std::make_shared<State>();
+      state->nodes = std::move(state_->nodes);
+      state->ready_queue.reset(new base::MPMCQueue<size_t>());
+      state->ready_queue->Init(state->nodes.size());
+      state_ = std::move(state);
+    }
+    validated_ = true;
+  }
+
+  auto& state = state_;
+  state->finished.store(0, std::memory_order_relaxed);
+  for (auto& node : state->nodes) {
+    node->pending.store(node->dependency_num, std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < state->nodes.size(); ++i) {
+    if (state->nodes[i]->dependency_num == 0) {
+      state->Schedule(i);
+    }
+  }
+  // the caller works on ready tasks too, so a graph run from inside a task
+  // never waits on a busy pool
+  while (state->finished.load(std::memory_order_acquire) <
+         state->nodes.size()) {
+    size_t id = 0;
+    if (state->ready_queue->Dequeue(&id)) {
+      state->Execute(id);
+    } else {
+      Yield();
+    }
+  }
+  return true;
+}
+
+void TaskGraph::State::Schedule(size_t id) {
+  ready_queue->Enqueue(id);
+  auto self = shared_from_this();
+  TaskManager::Instance()->Post([self]() { self->Work(); });
+}
+
+void TaskGraph::State::Execute(size_t id) {
+  auto& node = nodes[id];
+  node->func();
+  for (auto successor : node->successors) {
+    if (nodes[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) ==
+        1) {
+      Schedule(successor);
+    }
+  }
+  finished.fetch_add(1, std::memory_order_release);
+}
+
+void TaskGraph::State::Work() {
+  size_t id = 0;
+  while (ready_queue->Dequeue(&id)) {
+    Execute(id);
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
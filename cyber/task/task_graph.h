@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TASK_TASK_GRAPH_H_
+#define CYBER_TASK_TASK_GRAPH_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "cyber/base/mpmc_queue.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief A fork-join graph of tasks run on the task pool.
+ *
+ * Tasks are added once and the graph may be run any number of times, the
+ * nodes and their dependency counters are reused between runs. A graph must
+ * not be run concurrently with itself.
+ */
+class TaskGraph {
+ public:
+  TaskGraph();
+
+  // returns the id of the task, used to declare dependencies
+  size_t AddTask(std::function<void()> func);
+
+  // |after| starts only once |before| has finished
+  bool Precede(size_t before, size_t after);
+
+  // runs all tasks and returns once they are done, false on a cycle
+  bool Run();
+
+  size_t size() const { return state_->nodes.size(); }
+
+ private:
+  struct Node {
+    std::function<void()> func;
+    std::vector<size_t> successors;
+    uint32_t dependency_num = 0;
+    std::atomic<uint32_t> pending = {0};
+  };
+
+  // shared with the helper tasks, which may outlive the run they were
+  // posted for
+  struct State : public std::enable_shared_from_this<State> {
+    void Schedule(size_t id);
+    void Execute(size_t id);
+    void Work();
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::unique_ptr<base::MPMCQueue<size_t>> ready_queue;
+    std::atomic<size_t> finished = {0};
+  };
+
+  bool Validate() const;
+
+  std::shared_ptr<State> state_;
+  bool validated_ = false;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TASK_TASK_GRAPH_H_
@@ -28,16 +28,24 @@ using apollo::cyber::common::GlobalData;
 static const char* const task_prefix = "/internal/task";
 
 TaskManager::TaskManager()
-    : task_queue_size_(1000),
-      task_queue_(new base::BoundedQueue<std::function<void()>>()) {
-  if (!task_queue_->Init(task_queue_size_, new base::BlockWaitStrategy())) {
+    : task_queue_size_(1000), task_queue_(new base::MPMCQueue<TaskFunction>()) {
+  if (!task_queue_->Init(task_queue_size_)) {
     AERROR << "Task queue init failed";
     throw std::runtime_error("Task queue init failed");
   }
+  auto& sched_conf = GlobalData::Instance()->Config().scheduler_conf();
+  if (sched_conf.task_wait_strategy() == "adaptive") {
+    // short budgets, a spinning task keeps other croutines off its processor
+    wait_strategy_.reset(
+        new base::AdaptiveWaitStrategy(20 * 1000UL, 50 * 1000UL));
+  }
   auto func = [this]() {
     while (!stop_) {
-      std::function<void()> task;
+      TaskFunction task;
       if (!task_queue_->Dequeue(&task)) {
+        if (wait_strategy_ != nullptr && wait_strategy_->Spin()) {
+          continue;
+        }
         auto routine = croutine::CRoutine::GetCurrentRoutine();
         routine->HangUp();
         continue;
@@ -58,6 +66,25 @@ TaskManager::TaskManager()
 
 TaskManager::~TaskManager() { Shutdown(); }
 
+bool TaskManager::Post(const std::function<void()>& func, uint32_t num) {
+  if (stop_.load()) {
+    return false;
+  }
+  uint32_t posted = 0;
+  while (posted < num && task_queue_->Enqueue(TaskFunction(func))) {
+    ++posted;
+  }
+  if (posted > 0) {
+    if (wait_strategy_ != nullptr) {
+      wait_strategy_->NotifyOne();
+    }
+    for (auto& task : tasks_) {
+      scheduler::Instance()->NotifyTask(task);
+    }
+  }
+  return posted == num;
+}
+
 void TaskManager::Shutdown() {
   if (stop_.exchange(true)) {
     return;
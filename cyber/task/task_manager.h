@@ -18,6 +18,8 @@
 #define CYBER_TASK_TASK_MANAGER_H_
 
 #include <atomic>
+#include <exception>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -25,8 +27,11 @@
 #include <utility>
 #include <vector>
 
-#include "cyber/base/bounded_queue.h"
+#include "cyber/base/mpmc_queue.h"
+#include "cyber/base/wait_strategy.h"
 #include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/task/task_allocator.h"
+#include "cyber/task/task_function.h"
 
 namespace apollo {
 namespace cyber {
@@ -41,24 +46,77 @@ class TaskManager {
   auto Enqueue(F&& func, Args&&... args)
       -> std::future<typename std::result_of<F(Args...)>::type> {
     using return_type = typename std::result_of<F(Args...)>::type;
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(func), std::forward<Args>(args)...));
+    std::future<return_type> res;
+    auto task =
+        PackageTask(&res, std::forward<F>(func), std::forward<Args>(args)...);
     if (!stop_.load()) {
-      task_queue_->Enqueue([task]() { (*task)(); });
-      for (auto& task : tasks_) {
-        scheduler::Instance()->NotifyTask(task);
+      if (task_queue_->Enqueue(std::move(task))) {
+        if (wait_strategy_ != nullptr) {
+          wait_strategy_->NotifyOne();
+        }
+        for (auto& task : tasks_) {
+          scheduler::Instance()->NotifyTask(task);
+        }
+      } else {
+        // run it here rather than dropping it when the queue is full
+        task();
       }
     }
-    std::future<return_type> res(task->get_future());
     return res;
   }
 
+  // The shared state of the future comes from the task memory pool and the
+  // returned task fits the inline storage of TaskFunction, so packaging a
+  // hot task does not reach malloc.
+  template <typename F, typename... Args>
+  static TaskFunction PackageTask(
+      std::future<typename std::result_of<F(Args...)>::type>* res, F&& func,
+      Args&&... args) {
+    using return_type = typename std::result_of<F(Args...)>::type;
+    std::promise<return_type> promise(std::allocator_arg,
+                                      TaskAllocator<return_type>());
+    *res = promise.get_future();
+    return TaskFunction(
+        [promise = std::move(promise),
+         call = std::bind(std::forward<F>(func),
+                          std::forward<Args>(args)...)]() mutable {
+          SetPromise(&promise, &call);
+        });
+  }
+
+  // Enqueues |num| copies of |func| without creating a future. Returns false
+  // if the queue is full or stopped, callers must then run the work
+  // themselves.
+  bool Post(const std::function<void()>& func, uint32_t num = 1);
+
+  uint32_t pool_size() const { return static_cast<uint32_t>(tasks_.size()); }
+
  private:
+  template <typename R, typename F>
+  static void SetPromise(std::promise<R>* promise, F* call) {
+    try {
+      promise->set_value((*call)());
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  }
+
+  template <typename F>
+  static void SetPromise(std::promise<void>* promise, F* call) {
+    try {
+      (*call)();
+      promise->set_value();
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  }
+
   uint32_t num_threads_ = 0;
   uint32_t task_queue_size_ = 1000;
   std::atomic<bool> stop_ = {false};
   std::vector<uint64_t> tasks_;
-  std::shared_ptr<base::BoundedQueue<std::function<void()>>> task_queue_;
+  std::shared_ptr<base::MPMCQueue<TaskFunction>> task_queue_;
+  std::unique_ptr<base::AdaptiveWaitStrategy> wait_strategy_;
   DECLARE_SINGLETON(TaskManager);
 };
 
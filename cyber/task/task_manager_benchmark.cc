@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "cyber/base/bounded_queue.h"
+#include "cyber/base/mpmc_queue.h"
+#include "cyber/task/task_manager.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+struct Message {
+  uint64_t id;
+};
+
+class Planner {
+ public:
+  uint64_t Step(const std::shared_ptr<Message>& msg) { return msg->id + 1; }
+};
+
+}  // namespace
+
+// The path TaskManager::Enqueue used before: a packaged_task in a shared_ptr
+// wrapped by a std::function, pushed through a BoundedQueue.
+static void BM_LegacyEnqueue(benchmark::State& state) {  // NOLINT
+  base::BoundedQueue<std::function<void()>> queue;
+  queue.Init(1024, new base::BlockWaitStrategy());
+  Planner planner;
+  auto msg = std::make_shared<Message>();
+  while (state.KeepRunning()) {
+    auto task = std::make_shared<std::packaged_task<uint64_t()>>(
+        std::bind(&Planner::Step, &planner, msg));
+    queue.Enqueue([task]() { (*task)(); });
+    auto res = task->get_future();
+    std::function<void()> func;
+    queue.Dequeue(&func);
+    func();
+    benchmark::DoNotOptimize(res.get());
+  }
+}
+BENCHMARK(BM_LegacyEnqueue);
+
+static void BM_PooledEnqueue(benchmark::State& state) {  // NOLINT
+  base::MPMCQueue<TaskFunction> queue;
+  queue.Init(1024);
+  Planner planner;
+  auto msg = std::make_shared<Message>();
+  while (state.KeepRunning()) {
+    std::future<uint64_t> res;
+    queue.Enqueue(
+        TaskManager::PackageTask(&res, &Planner::Step, &planner, msg));
+    TaskFunction func;
+    queue.Dequeue(&func);
+    func();
+    benchmark::DoNotOptimize(res.get());
+  }
+}
+BENCHMARK(BM_PooledEnqueue);
+
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
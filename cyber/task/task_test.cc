@@ -17,12 +17,15 @@
 #include "cyber/task/task.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "cyber/common/log.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
+#include "cyber/task/task_graph.h"
 
 namespace apollo {
 namespace cyber {
@@ -96,6 +99,64 @@ TEST(AsyncTest, run_member_function) {
   foo.RunOnce();
 }
 
+TEST(ParallelForTest, cover_range) {
+  std::vector<std::atomic<int>> visits(1000);
+  ParallelFor(0, visits.size(), 7, [&](size_t i) { visits[i]++; });
+  for (auto& visit : visits) {
+    EXPECT_EQ(visit.load(), 1);
+  }
+
+  std::atomic<uint64_t> sum = {0};
+  ParallelFor(10, 20, 0, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 145);
+  ParallelFor(5, 5, 0, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 145);
+}
+
+TEST(ParallelForTest, nested) {
+  std::atomic<int> count = {0};
+  auto res = Async([&]() {
+    ParallelFor(0, 8, 1, [&](size_t) {
+      ParallelFor(0, 8, 1, [&](size_t) { count++; });
+    });
+  });
+  res.get();
+  EXPECT_EQ(count.load(), 64);
+}
+
+TEST(TaskGraphTest, dependency) {
+  TaskGraph graph;
+  std::vector<int> order;
+  std::mutex order_mutex;
+  auto record = [&](int id) {
+    return [&, id]() {
+      std::lock_guard<std::mutex> lock(order_mutex);
+      order.push_back(id);
+    };
+  };
+  // 0 -> {1, 2} -> 3
+  auto a = graph.AddTask(record(0));
+  auto b = graph.AddTask(record(1));
+  auto c = graph.AddTask(record(2));
+  auto d = graph.AddTask(record(3));
+  EXPECT_TRUE(graph.Precede(a, b));
+  EXPECT_TRUE(graph.Precede(a, c));
+  EXPECT_TRUE(graph.Precede(b, d));
+  EXPECT_TRUE(graph.Precede(c, d));
+  EXPECT_FALSE(graph.Precede(a, 4));
+
+  for (int run = 0; run < 3; ++run) {
+    order.clear();
+    EXPECT_TRUE(graph.Run());
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order.back(), 3);
+  }
+
+  EXPECT_TRUE(graph.Precede(d, a));
+  EXPECT_FALSE(graph.Run());
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
@@ -16,18 +16,31 @@
 
 #include "cyber/timer/timer_manager.h"
 
+#include <chrono>
+
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/time/duration.h"
-#include "cyber/time/rate.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
+namespace {
+
+const proto::TimerConf& TimerConfig() {
+  return common::GlobalData::Instance()->Config().timer_conf();
+}
+
+}  // namespace
+
 TimerManager::TimerManager()
-    : timing_wheel_(Duration(0.01)),
-      time_gran_(Duration(0.01)),
-      running_(false) {}  // default time gran = 1ms
+    : timing_wheel_(
+          Duration(static_cast<int64_t>(TimerConfig().resolution_us()) * 1000),
+          TimerConfig().queue_size()),
+      time_gran_(static_cast<int64_t>(timing_wheel_.tick_duration())),
+      running_(false) {}  // default time gran = 10ms
 
 TimerManager::~TimerManager() {
   if (running_) {
@@ -71,10 +84,17 @@ void TimerManager::Remove(uint64_t timer_id) {
 bool TimerManager::IsRunning() { return running_; }
 
 void TimerManager::ThreadFuncImpl() {
-  Rate rate(time_gran_);
+  // step on an absolute schedule so the time spent in Step() never adds up
+  // to drift, a late thread catches up tick by tick
+  auto gran = time_gran_.ToNanosecond();
+  auto next_tick = Time::Now().ToNanosecond();
   while (running_) {
     timing_wheel_.Step();
-    rate.Sleep();
+    next_tick += gran;
+    auto now = Time::Now().ToNanosecond();
+    if (next_tick > now) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(next_tick - now));
+    }
   }
 }
 
@@ -18,6 +18,7 @@
 #define CYBER_TIMER_TIMER_TASK_H_
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
@@ -52,9 +53,11 @@ class TimerTask {
   uint64_t deadline_ = 0;
   uint64_t interval_ = 0;
   CallHandler handler_;
-  uint64_t rest_rounds_ = 0;
   bool oneshot_ = true;
   uint64_t fire_count_ = 0;
+  // position of the task in the hierarchical timing wheel
+  uint32_t level_ = 0;
+  uint64_t slot_ = 0;
 
  public:
   uint64_t Id() { return tid_; }
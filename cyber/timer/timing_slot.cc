@@ -16,7 +16,8 @@
 
 #include "cyber/timer/timing_slot.h"
 
-#include "cyber/common/log.h"
+#include <utility>
+
 #include "cyber/timer/timer_task.h"
 
 namespace apollo {
@@ -26,40 +27,12 @@ void TimingSlot::AddTask(const std::shared_ptr<TimerTask>& task) {
   tasks_.emplace(task->Id(), task);
 }
 
-void TimingSlot::EnumTaskList(
-    uint64_t deadline, bool async, BoundedQueue<HandlePackage>* hander_queue,
-    BoundedQueue<std::shared_ptr<TimerTask>>* rep_queue) {
-  for (auto it = tasks_.begin(); it != tasks_.end();) {
-    auto task = it->second;  // *it;
-    auto del_it = it;
-    it++;
-    // std::cout << "judge: task->" << task->deadline << " : " << deadline;
-    if (task->deadline_ <= deadline) {
-      if (task->rest_rounds_ == 0) {
-        if (async) {
-          HandlePackage hp;
-          hp.handle = task->handler_;
-          hp.id = task->Id();
-          if (!hander_queue->Enqueue(hp)) {
-            AERROR << "hander queue is full";
-          }
-        } else {
-          task->Fire(false);
-        }
-
-        if (!task->oneshot_) {  // repeat timer,push back
-          task->fire_count_++;
-          rep_queue->Enqueue(task);
-        }
-        tasks_.erase(del_it);
-
-      } else {
-        AERROR << "task deadline overflow...";
-      }
-    } else {  // no expired, -- rounds
-      task->rest_rounds_--;
-    }
+void TimingSlot::MoveTasks(std::vector<std::shared_ptr<TimerTask>>* tasks) {
+  tasks->reserve(tasks->size() + tasks_.size());
+  for (auto& item : tasks_) {
+    tasks->emplace_back(std::move(item.second));
   }
+  tasks_.clear();
 }
 }  // namespace cyber
 }  // namespace apollo
@@ -17,32 +17,15 @@
 #ifndef CYBER_TIMER_TIMING_SLOT_H_
 #define CYBER_TIMER_TIMING_SLOT_H_
 
-#include <algorithm>
-#include <iostream>
-#include <list>
-#include <map>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
-#include "cyber/base/bounded_queue.h"
-
 namespace apollo {
 namespace cyber {
 
-using apollo::cyber::base::BoundedQueue;
-using CallHandler = std::function<void()>;
-
 class TimerTask;
 
-struct HandlePackage {
-  uint64_t id;
-  CallHandler handle;
-};
-
 class TimingSlot {
  private:
   //  no needs for multi-thread
@@ -52,10 +35,10 @@ class TimingSlot {
   TimingSlot() = default;
   void AddTask(const std::shared_ptr<TimerTask>& task);
   void RemoveTask(uint64_t id) { tasks_.erase(id); }
+  bool Empty() const { return tasks_.empty(); }
 
-  void EnumTaskList(uint64_t deadline, bool async,
-                    BoundedQueue<HandlePackage>* hander_queue,
-                    BoundedQueue<std::shared_ptr<TimerTask>>* rep_list);
+  // moves all tasks out of the slot, used to fire or cascade them
+  void MoveTasks(std::vector<std::shared_ptr<TimerTask>>* tasks);
 };  // TimeSlot end
 
 }  // namespace cyber
@@ -17,8 +17,10 @@
 #include "cyber/timer/timing_wheel.h"
 
 #include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
 
-#include "cyber/base/for_each.h"
 #include "cyber/common/log.h"
 #include "cyber/task/task.h"
 #include "cyber/time/time.h"
@@ -27,66 +29,50 @@
 namespace apollo {
 namespace cyber {
 
-TimingWheel::TimingWheel() {
-  if (!add_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Add queue init failed.";
-    throw std::runtime_error("Add queue init failed.");
-  }
-  if (!repeat_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Repeated task queue init failed.";
-    throw std::runtime_error("Repeated queue init failed.");
-  }
-  if (!handler_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Handler queue init failed.";
-    throw std::runtime_error("Handler queue init failed.");
+TimingWheel::TimingWheel() { Init(TIMER_QUEUE_SIZE); }
+
+TimingWheel::TimingWheel(const Duration& tick_duration, uint64_t queue_size) {
+  if (tick_duration.ToNanosecond() > 0) {
+    tick_duration_ = tick_duration.ToNanosecond();
+  } else {
+    AWARN << "Invalid tick duration, use " << tick_duration_ << "ns.";
   }
+  Init(queue_size);
 }
 
-TimingWheel::TimingWheel(const Duration& tick_duration) {
-  tick_duration_ = tick_duration.ToNanosecond();
-  resolution_ = tick_duration_ / 1000000UL;
-  if (!add_queue_.Init(BOUNDED_QUEUE_SIZE)) {
+void TimingWheel::Init(uint64_t queue_size) {
+  if (!add_queue_.Init(queue_size)) {
     AERROR << "Add queue init failed.";
     throw std::runtime_error("Add queue init failed.");
   }
-  if (!repeat_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Repeated task queue init failed.";
-    throw std::runtime_error("Repeated queue init failed.");
-  }
-  if (!handler_queue_.Init(BOUNDED_QUEUE_SIZE)) {
-    AERROR << "Handler queue init failed.";
-    throw std::runtime_error("Handler queue init failed.");
+  if (!cancel_queue_.Init(queue_size)) {
+    AERROR << "Cancel queue init failed.";
+    throw std::runtime_error("Cancel queue init failed.");
   }
 }
 
 uint64_t TimingWheel::StartTimer(uint64_t interval, CallHandler handler,
                                  bool oneshot) {
-  if (id_counter_ > UINT64_MAX) {
-    AERROR << "Timer ID pool is full.";
-    return -1;
-  } else if (interval > TIMER_TASK_MAX_INTERVAL) {
-    AERROR << "The interval of timer task MUST less than or equal "
-           << TIMER_TASK_MAX_INTERVAL << "ms.";
-    return -1;
-  } else if (interval < resolution_) {
+  if (interval * 1000 * 1000 < tick_duration_) {
     AERROR << "The interval of timer task MUST larger than or equal "
-           << resolution_ << "ms.";
+           << tick_duration_ << "ns.";
     return -1;
   }
   auto now = Time::Now().ToNanosecond();
+  auto id = ++id_counter_;
+  // a periodic task must not overlap itself, other tasks run freely
+  auto task_mutex = std::make_shared<std::mutex>();
   auto task = std::make_shared<TimerTask>(
-      ++id_counter_, now, interval,
-      [handler](void) {
-        static std::mutex task_mutex;
-        std::lock_guard<std::mutex> lock(task_mutex);
+      id, now, interval,
+      [handler, task_mutex](void) {
+        std::lock_guard<std::mutex> lock(*task_mutex);
         handler();
       },
       oneshot);
-  if (add_queue_.Enqueue(task)) {
-    ADEBUG << "start timer id: " << id_counter_;
-    return id_counter_;
+  if (add_queue_.Enqueue(std::move(task))) {
+    ADEBUG << "start timer id: " << id;
+    return id;
   } else {
-    --id_counter_;
     AERROR << "add queue is full, Enqueue failed!";
     return -1;
   }
@@ -96,85 +82,120 @@ void TimingWheel::Step() {
   if (start_time_ == 0) {
     start_time_ = Time::Now().ToNanosecond();
   }
-  uint64_t deadline = tick_duration_ * (tick_ + 1);
-  uint64_t idx = tick_ & mask_;
-  RemoveCancelledTasks(idx);
+  Cascade();
   FillAddSlot();
-  time_slots_[idx].EnumTaskList(deadline, true, &handler_queue_,
-                                &repeat_queue_);
+  RemoveCancelledTasks();
+
+  std::vector<std::shared_ptr<TimerTask>> expired;
+  time_slots_[0][tick_ & mask_].MoveTasks(&expired);
+  for (auto& task : expired) {
+    cyber::Async(task->handler_);
+    if (task->oneshot_) {
+      tasks_.erase(task->Id());
+    } else {
+      task->fire_count_++;
+    }
+  }
 
   // timing wheel tick one time
   tick_++;
 
-  FillRepeatSlot();
-
-  while (!handler_queue_.Empty()) {
-    HandlePackage hp;
-    if (handler_queue_.Dequeue(&hp)) {
-      cyber::Async(hp.handle);
+  for (auto& task : expired) {
+    if (!task->oneshot_) {
+      FillSlot(task);
     }
   }
 }
 
 void TimingWheel::StopTimer(uint64_t timer_id) {
-  {
-    std::lock_guard<std::mutex> lg(cancelled_mutex_);
-    cancelled_list_.push_back(timer_id);
+  if (!cancel_queue_.Enqueue(timer_id)) {
+    AERROR << "cancel queue is full, stop timer " << timer_id << " failed!";
   }
 }
 
-void TimingWheel::RemoveCancelledTasks(uint64_t slot_index) {
-  if (slot_index >= TIMING_WHEEL_SIZE) {
-    return;
+void TimingWheel::RemoveCancelledTasks() {
+  uint64_t id = 0;
+  while (cancel_queue_.Dequeue(&id)) {
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+      // the task may still be on its way through the add queue
+      pending_cancels_[id] = tick_;
+      continue;
+    }
+    time_slots_[it->second->level_][it->second->slot_].RemoveTask(id);
+    tasks_.erase(it);
   }
-  {
-    std::lock_guard<std::mutex> lg(cancelled_mutex_);
-    for (auto id : cancelled_list_) {
-      FOR_EACH(i, 0, TIMING_WHEEL_SIZE) {
-        time_slots_[i].RemoveTask(id);
+
+  // drop cancellations of tasks that already finished or never existed
+  if ((tick_ & mask_) == 0) {
+    for (auto it = pending_cancels_.begin(); it != pending_cancels_.end();) {
+      if (it->second + TIMING_WHEEL_SIZE < tick_) {
+        it = pending_cancels_.erase(it);
+      } else {
+        ++it;
       }
     }
-    cancelled_list_.clear();
   }
 }
 
 void TimingWheel::FillAddSlot() {
   std::shared_ptr<TimerTask> task;
-  while (!add_queue_.Empty()) {
-    if (!add_queue_.Dequeue(&task)) {
-      return;
+  while (add_queue_.Dequeue(&task)) {
+    if (pending_cancels_.erase(task->Id()) > 0) {
+      continue;
     }
+    tasks_[task->Id()] = task;
     FillSlot(task);
   }
 }
 
-void TimingWheel::FillRepeatSlot() {
-  std::shared_ptr<TimerTask> task;
-  while (!repeat_queue_.Empty()) {
-    if (!repeat_queue_.Dequeue(&task)) {
-      return;
+void TimingWheel::Cascade() {
+  if (tick_ == 0 || (tick_ & mask_) != 0) {
+    return;
+  }
+  // the highest level whose slot starts at this tick, every level below it
+  // has wrapped as well so cascade from the top down
+  int level = 1;
+  while (level + 1 < TIMING_WHEEL_LEVEL &&
+         ((tick_ >> (TIMING_WHEEL_BITS * level)) & mask_) == 0) {
+    ++level;
+  }
+  std::vector<std::shared_ptr<TimerTask>> tasks;
+  for (; level > 0; --level) {
+    auto idx = (tick_ >> (TIMING_WHEEL_BITS * level)) & mask_;
+    tasks.clear();
+    time_slots_[level][idx].MoveTasks(&tasks);
+    for (auto& task : tasks) {
+      FillSlot(task);
     }
-    FillSlot(task);
   }
 }
 
 void TimingWheel::FillSlot(const std::shared_ptr<TimerTask>& task) {
-  task->deadline_ = task->init_time_ +
-                    (task->fire_count_ + 1) * (task->interval_) * 1000 * 1000 -
-                    start_time_;
-
-  // Calculate how many tickes have been run since the time wheel start
-  uint64_t t = task->deadline_ / tick_duration_;  // perTick = 1ms
-  if (t < tick_) {
-    task->rest_rounds_ = 0;
-  } else {
-    task->rest_rounds_ = (t - tick_) / TIMING_WHEEL_SIZE;
-  }
-  uint64_t ticks = std::max(t, tick_);  // right now
-  uint64_t idx = ticks & mask_;
-  time_slots_[idx].AddTask(task);
-
-  ADEBUG << "task id " << task->Id() << " insert to index " << idx;
+  uint64_t deadline = task->init_time_ + (task->fire_count_ + 1) *
+                                            task->interval_ * 1000 * 1000;
+  task->deadline_ = deadline > start_time_ ? deadline - start_time_ : 0;
+
+  // the first tick not earlier than the deadline, never fire ahead of time
+  uint64_t t = (task->deadline_ + tick_duration_ - 1) / tick_duration_;
+  t = std::max(t, tick_);
+
+  // the lowest level on which the deadline shares the current revolution,
+  // tasks beyond the top level horizon wait there for another round
+  uint32_t level = 0;
+  while (level + 1 < TIMING_WHEEL_LEVEL &&
+         (t >> (TIMING_WHEEL_BITS * (level + 1))) !=
+             (tick_ >> (TIMING_WHEEL_BITS * (level + 1)))) {
+    ++level;
+  }
+  uint64_t idx = (t >> (TIMING_WHEEL_BITS * level)) & mask_;
+  task->level_ = level;
+  task->slot_ = idx;
+  time_slots_[level][idx].AddTask(task);
+
+  ADEBUG << "task id " << task->Id() << " insert to level " << level
+         << " index " << idx;
 }
+
 }  // namespace cyber
 }  // namespace apollo
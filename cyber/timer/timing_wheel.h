@@ -17,38 +17,43 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
-#include <algorithm>
-#include <iostream>
-#include <list>
-#include <map>
+#include <atomic>
+#include <functional>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
-#include "cyber/base/bounded_queue.h"
+#include "cyber/base/mpmc_queue.h"
 #include "cyber/time/duration.h"
 #include "cyber/timer/timing_slot.h"
 
 namespace apollo {
 namespace cyber {
 
-using apollo::cyber::base::BoundedQueue;
+using apollo::cyber::base::MPMCQueue;
 using CallHandler = std::function<void()>;
 
-static const int TIMING_WHEEL_SIZE = 128;
-static const int THREAD_POOL_SIZE = 4;
-static const uint64_t BOUNDED_QUEUE_SIZE = 200;
-static const int TIMER_TASK_MAX_INTERVAL = 1000;
+static const int TIMING_WHEEL_BITS = 7;
+static const int TIMING_WHEEL_SIZE = 1 << TIMING_WHEEL_BITS;
+static const int TIMING_WHEEL_LEVEL = 4;
+static const uint64_t TIMER_QUEUE_SIZE = 4096;
 
 class TimerTask;
 
+/**
+ * @brief Hierarchical timing wheel.
+ *
+ * Level 0 has one slot per tick, every upper level has slots spanning a whole
+ * revolution of the level below and cascades its tasks down when the lower
+ * level wraps, so long intervals never lap the wheel. Timers are added and
+ * cancelled through lock-free queues, all other state belongs to the thread
+ * calling Step().
+ */
 class TimingWheel {
  public:
   TimingWheel();
-  explicit TimingWheel(const Duration& tick_duration);
+  explicit TimingWheel(const Duration& tick_duration,
+                       uint64_t queue_size = TIMER_QUEUE_SIZE);
   ~TimingWheel() = default;
 
   uint64_t StartTimer(uint64_t interval, CallHandler handler, bool oneshot);
@@ -57,33 +62,33 @@ class TimingWheel {
 
   void Step();
 
+  uint64_t tick_duration() const { return tick_duration_; }
+
  private:
+  void Init(uint64_t queue_size);
   void FillAddSlot();
-  void FillRepeatSlot();
   void FillSlot(const std::shared_ptr<TimerTask>& task);
+  void RemoveCancelledTasks();
+  void Cascade();
 
-  void RemoveCancelledTasks(uint64_t slot_index);
-
-  uint64_t id_counter_ = 0;
+  std::atomic<uint64_t> id_counter_ = {0};
 
   uint64_t tick_ = 0;
 
   uint64_t start_time_ = 0;
 
-  TimingSlot time_slots_[TIMING_WHEEL_SIZE];
+  TimingSlot time_slots_[TIMING_WHEEL_LEVEL][TIMING_WHEEL_SIZE];
 
   uint64_t mask_ = TIMING_WHEEL_SIZE - 1;
 
   uint64_t tick_duration_ = 10 * 1000 * 1000;  // 10ms
-  uint64_t resolution_ = 10;                   // 10ms
-
-  // we need implement a lock-free high performance concurrent queue.
-  // Now, just a blocking-queue just for works.
-  std::list<uint64_t> cancelled_list_;
-  std::mutex cancelled_mutex_;
-  BoundedQueue<std::shared_ptr<TimerTask>> add_queue_;
-  BoundedQueue<std::shared_ptr<TimerTask>> repeat_queue_;
-  BoundedQueue<HandlePackage> handler_queue_;
+
+  // tasks in the wheel and cancellations whose task has not been added yet
+  std::unordered_map<uint64_t, std::shared_ptr<TimerTask>> tasks_;
+  std::unordered_map<uint64_t, uint64_t> pending_cancels_;
+
+  MPMCQueue<std::shared_ptr<TimerTask>> add_queue_;
+  MPMCQueue<uint64_t> cancel_queue_;
 };
 
 }  // namespace cyber
@@ -71,6 +71,63 @@ TEST(TimingWheelTest, Period) {
   }
 }
 
+TEST(TimingWheelTest, LongInterval) {
+  // 1ms ticks, the task lives on the third level before cascading down
+  TimingWheel tw(Duration(0.001));
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  tw.Step();
+  tw.StartTimer(20000, f, true);
+  for (int i = 0; i < 19990; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  ASSERT_EQ(0, th->count());
+  for (int i = 0; i < 20; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  ASSERT_EQ(1, th->count());
+}
+
+TEST(TimingWheelTest, SubMillisecond) {
+  TimingWheel tw(Duration(static_cast<int64_t>(500 * 1000)));
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  tw.Step();
+  tw.StartTimer(1, f, false);
+  for (int i = 0; i < 20; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  ASSERT_TRUE(th->count() >= 9 && th->count() <= 10);
+
+  TimingWheel coarse(Duration(0.02));
+  ASSERT_EQ(static_cast<uint64_t>(-1), coarse.StartTimer(10, f, true));
+}
+
+TEST(TimingWheelTest, Cancel) {
+  TimingWheel tw;
+  std::shared_ptr<TestHandler> th(new TestHandler());
+  std::function<void(void)> f = std::bind(&TestHandler::increment, th.get());
+  tw.Step();
+  auto id = tw.StartTimer(10, f, false);
+  auto long_id = tw.StartTimer(5000, f, false);
+  for (int i = 0; i < 5; i++) {
+    tw.Step();
+  }
+  tw.StopTimer(id);
+  tw.StopTimer(long_id);
+  usleep(10 * 1000);
+  auto count = th->count();
+  ASSERT_TRUE(count >= 4 && count <= 5);
+  for (int i = 0; i < 1000; i++) {
+    tw.Step();
+  }
+  usleep(10 * 1000);
+  ASSERT_EQ(count, th->count());
+}
+
 }  // namespace cyber
 }  // namespace apollo
 
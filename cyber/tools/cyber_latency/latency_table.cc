@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/tools/cyber_latency/latency_table.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+namespace latency {
+
+namespace {
+
+void Merge(const proto::LatencyHistogram& from,
+           proto::LatencyHistogram* to) {
+  to->set_count(to->count() + from.count());
+  to->set_sum(to->sum() + from.sum());
+  to->set_max(std::max(to->max(), from.max()));
+  while (to->bucket_size() < from.bucket_size()) {
+    to->add_bucket(0);
+  }
+  for (int i = 0; i < from.bucket_size(); ++i) {
+    to->set_bucket(i, to->bucket(i) + from.bucket(i));
+  }
+}
+
+void PrintRow(const char* hop, const proto::LatencyHistogram& histogram,
+              std::ostream* out) {
+  if (histogram.count() == 0) {
+    return;
+  }
+  auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+  char row[160];
+  snprintf(row, sizeof(row),
+           "    %-12s %10llu %10.3f %10.3f %10.3f %10.3f %10.3f\n", hop,
+           static_cast<unsigned long long>(histogram.count()),  // NOLINT
+           ms(histogram.sum() / histogram.count()),
+           ms(Percentile(histogram, 50)), ms(Percentile(histogram, 90)),
+           ms(Percentile(histogram, 99)), ms(histogram.max()));
+  *out << row;
+}
+
+}  // namespace
+
+uint64_t Percentile(const proto::LatencyHistogram& histogram, double p) {
+  if (histogram.count() == 0) {
+    return 0;
+  }
+  uint64_t target = static_cast<uint64_t>(p / 100.0 * histogram.count() + 0.5);
+  target = target == 0 ? 1 : target;
+  uint64_t seen = 0;
+  for (int i = 0; i < histogram.bucket_size(); ++i) {
+    seen += histogram.bucket(i);
+    if (seen >= target) {
+      uint64_t upper = i == 0 ? 0 : (i == 64 ? UINT64_MAX : (1ULL << i) - 1);
+      return std::min(upper, histogram.max());
+    }
+  }
+  return histogram.max();
+}
+
+void LatencyTable::Update(const proto::LatencyReport& report) {
+  // histograms accumulate in the process, the latest report has them all
+  reports_[report.process_name()] = report;
+}
+
+void LatencyTable::Print(std::ostream* out) const {
+  // origin channel -> channel -> merged hops
+  std::map<std::string, std::map<std::string, proto::ChannelLatency>> table;
+  for (auto& item : reports_) {
+    for (auto& channel : item.second.channel()) {
+      auto& merged =
+          table[channel.origin_channel_name()][channel.channel_name()];
+      Merge(channel.transport(), merged.mutable_transport());
+      Merge(channel.queue(), merged.mutable_queue());
+      Merge(channel.callback(), merged.mutable_callback());
+      Merge(channel.end_to_end(), merged.mutable_end_to_end());
+    }
+  }
+
+  char head[160];
+  snprintf(head, sizeof(head), "    %-12s %10s %10s %10s %10s %10s %10s\n",
+           "hop(ms)", "count", "mean", "p50", "p90", "p99", "max");
+  for (auto& pipeline : table) {
+    *out << "pipeline from " << pipeline.first << "\n";
+    for (auto& channel : pipeline.second) {
+      *out << "  " << channel.first << "\n" << head;
+      PrintRow("transport", channel.second.transport(), out);
+      PrintRow("queue", channel.second.queue(), out);
+      PrintRow("callback", channel.second.callback(), out);
+      PrintRow("end_to_end", channel.second.end_to_end(), out);
+    }
+  }
+}
+
+}  // namespace latency
+}  // namespace cyber
+}  // namespace apollo
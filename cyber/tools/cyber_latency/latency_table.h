@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TOOLS_CYBER_LATENCY_LATENCY_TABLE_H_
+#define CYBER_TOOLS_CYBER_LATENCY_LATENCY_TABLE_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "cyber/proto/latency_report.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace latency {
+
+// Merges the latest report of every process into per-pipeline latency
+// histograms, a pipeline being the channels that derive from one origin.
+class LatencyTable {
+ public:
+  void Update(const proto::LatencyReport& report);
+  void Print(std::ostream* out) const;
+  bool Empty() const { return reports_.empty(); }
+
+ private:
+  std::map<std::string, proto::LatencyReport> reports_;
+};
+
+// Upper bound of the bucket of the p-th percentile, like base::Histogram.
+uint64_t Percentile(const proto::LatencyHistogram& histogram, double p);
+
+}  // namespace latency
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TOOLS_CYBER_LATENCY_LATENCY_TABLE_H_
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <unistd.h>
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cyber/cyber.h"
+#include "cyber/node/latency_reporter.h"
+#include "cyber/proto/latency_report.pb.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/tools/cyber_latency/latency_table.h"
+
+using apollo::cyber::LatencyReporter;
+using apollo::cyber::latency::LatencyTable;
+using apollo::cyber::proto::LatencyReport;
+using apollo::cyber::record::RecordMessage;
+using apollo::cyber::record::RecordReader;
+
+namespace {
+
+int PrintRecord(const std::string& file) {
+  RecordReader reader(file);
+  if (!reader.IsValid()) {
+    std::cout << "can not open record " << file << std::endl;
+    return -1;
+  }
+  LatencyTable table;
+  RecordMessage message;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name != LatencyReporter::kChannelName) {
+      continue;
+    }
+    LatencyReport report;
+    if (report.ParseFromString(message.content)) {
+      table.Update(report);
+    }
+  }
+  if (table.Empty()) {
+    std::cout << "no " << LatencyReporter::kChannelName << " message in "
+              << file << std::endl;
+    return -1;
+  }
+  table.Print(&std::cout);
+  return 0;
+}
+
+int PrintLive() {
+  std::mutex mutex;
+  LatencyTable table;
+  auto node =
+      apollo::cyber::CreateNode("cyber_latency_" + std::to_string(getpid()));
+  auto reader = node->CreateReader<LatencyReport>(
+      LatencyReporter::kChannelName,
+      [&mutex, &table](const std::shared_ptr<LatencyReport>& report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        table.Update(*report);
+      });
+  if (reader == nullptr) {
+    std::cout << "can not read " << LatencyReporter::kChannelName << std::endl;
+    return -1;
+  }
+
+  while (apollo::cyber::OK()) {
+    apollo::cyber::SleepFor(std::chrono::seconds(1));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (table.Empty()) {
+      std::cout << "waiting for processes started with cyber_latency_trace=1"
+                << std::endl;
+      continue;
+    }
+    std::cout << "\n";
+    table.Print(&std::cout);
+  }
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc == 3 && std::string(argv[1]) == "-f") {
+    return PrintRecord(argv[2]);
+  }
+  if (argc != 1) {
+    std::cout << "usage: " << argv[0] << " [-f <file.record>]\n"
+              << "Print per-hop latency published on "
+              << LatencyReporter::kChannelName
+              << " by processes started with cyber_latency_trace=1,"
+              << " live or from a record." << std::endl;
+    return -1;
+  }
+  apollo::cyber::Init(argv[0]);
+  int ret = PrintLive();
+  apollo::cyber::Clear();
+  return ret;
+}
@@ -19,12 +19,37 @@
 #include "./screen.h"
 
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "cyber/common/global_data.h"
+
 namespace {
 constexpr int ReaderWriterOffset = 4;
+
+// Looks the type up in ProtobufFactory once, the channels of the same type
+// copy its prototype.
+google::protobuf::Message* NewMessageByType(const std::string& type) {
+  static std::mutex mutex;
+  static std::map<std::string, std::unique_ptr<google::protobuf::Message>>
+      prototypes;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& prototype = prototypes[type];
+  if (prototype == nullptr) {
+    prototype.reset(
+        apollo::cyber::message::ProtobufFactory::Instance()
+            ->GenerateMessageByType(type));
+    if (prototype == nullptr) {
+      prototypes.erase(type);
+      return nullptr;
+    }
+  }
+  return prototype->New();
+}
 }  // namespace
 
 const char* GeneralChannelMessage::errCode2Str(
@@ -83,21 +108,37 @@ double GeneralChannelMessage::frame_ratio(void) {
   auto time_now = apollo::cyber::Time::MonoTime();
   auto interval = time_now - time_last_calc_;
   if (interval.ToNanosecond() > 1000000000) {
-    int old = frame_counter_;
-    while (!frame_counter_.compare_exchange_strong(old, 0)) {
-    }
-    if (old == 0) {
-      return 0.0;
-    }
-    auto curMsgTime = msg_time_;
-    auto deltaTime = curMsgTime - last_time_;
-    frame_ratio_ = old / deltaTime.ToSecond();
-    last_time_ = curMsgTime;
+    uint64_t received =
+        counters_->received_msgs.load(std::memory_order_relaxed);
+    frame_ratio_ = static_cast<double>(received - last_received_msgs_) /
+                   interval.ToSecond();
+    last_received_msgs_ = received;
     time_last_calc_ = time_now;
   }
   return frame_ratio_;
 }
 
+bool GeneralChannelMessage::ParseLatestMessage(void) {
+  decltype(channel_message_) channelMsg = CopyMsgPtr();
+  if (channelMsg == nullptr || raw_msg_class_ == nullptr) {
+    return false;
+  }
+  if (channelMsg != parsed_message_) {
+    is_parsed_ = raw_msg_class_->ParseFromString(channelMsg->message);
+    parsed_message_ = channelMsg;
+    line_count_width_ = -1;
+  }
+  return is_parsed_;
+}
+
+int GeneralChannelMessage::ParsedLineCount(int screenWidth) {
+  if (line_count_width_ != screenWidth) {
+    line_count_ = lineCount(*raw_msg_class_, screenWidth);
+    line_count_width_ = screenWidth;
+  }
+  return line_count_;
+}
+
 GeneralChannelMessage* GeneralChannelMessage::OpenChannel(
     const std::string& channelName) {
   if (channelName.empty() || node_name_.empty()) {
@@ -112,6 +153,12 @@ GeneralChannelMessage* GeneralChannelMessage::OpenChannel(
     return castErrorCode2Ptr(ErrorCode::CreateNodeFailed);
   }
 
+  counters_ = apollo::cyber::transport::ChannelStats::Instance()->GetCounters(
+      apollo::cyber::common::GlobalData::RegisterChannel(channelName));
+  last_received_msgs_ =
+      counters_->received_msgs.load(std::memory_order_relaxed);
+  time_last_calc_ = apollo::cyber::Time::MonoTime();
+
   auto callBack = [this](
       const std::shared_ptr<apollo::cyber::message::RawMessage>& rawMsg) {
     updateRawMessage(rawMsg);
@@ -176,6 +223,24 @@ void GeneralChannelMessage::RenderInfo(const Screen* s, int key,
            1;
   SplitPages(key);
 
+  if (counters_ != nullptr) {
+    std::ostringstream outStr;
+    outStr << "Received: "
+           << counters_->received_msgs.load(std::memory_order_relaxed)
+           << "  Dropped: "
+           << counters_->dropped_msgs.load(std::memory_order_relaxed);
+    uint64_t latency_count =
+        counters_->latency_count.load(std::memory_order_relaxed);
+    if (latency_count > 0) {
+      outStr << "  Latency: "
+             << counters_->latency_sum.load(std::memory_order_relaxed) /
+                    latency_count / 1000
+             << " us";
+    }
+    s->AddStr(0, lineNo++, outStr.str().c_str());
+    ++lineNo;
+  }
+
   bool hasReader = true;
   std::vector<std::string>* vec = &readers_;
 
@@ -218,8 +283,7 @@ void GeneralChannelMessage::RenderDebugString(const Screen* s, int key,
                                               unsigned lineNo) {
   if (has_message_come()) {
     if (raw_msg_class_ == nullptr) {
-      auto rawFactory = apollo::cyber::message::ProtobufFactory::Instance();
-      raw_msg_class_ = rawFactory->GenerateMessageByType(message_type());
+      raw_msg_class_ = NewMessageByType(message_type());
     }
 
     if (raw_msg_class_ == nullptr) {
@@ -239,8 +303,8 @@ void GeneralChannelMessage::RenderDebugString(const Screen* s, int key,
         outStr.str("");
         outStr << channelMsg->message.size() << " Bytes";
         s->AddStr(outStr.str().c_str());
-        if (raw_msg_class_->ParseFromString(channelMsg->message)) {
-          int lcount = lineCount(*raw_msg_class_, s->Width());
+        if (ParseLatestMessage()) {
+          int lcount = ParsedLineCount(s->Width());
           page_item_count_ = s->Height() - lineNo;
           pages_ = lcount / page_item_count_ + 1;
           SplitPages(key);
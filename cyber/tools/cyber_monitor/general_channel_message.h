@@ -17,9 +17,12 @@
 #ifndef TOOLS_CVT_MONITOR_GENERAL_CHANNEL_MESSAGE_H_
 #define TOOLS_CVT_MONITOR_GENERAL_CHANNEL_MESSAGE_H_
 
-#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
 
 #include "cyber/message/raw_message.h"
+#include "cyber/transport/message/channel_stats.h"
 #include "general_message_base.h"
 
 class CyberTopologyMessage;
@@ -104,9 +107,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
         current_state_(State::ShowDebugString),
         has_message_come_(false),
         message_type_(),
-        frame_counter_(0),
-        last_time_(apollo::cyber::Time::MonoTime()),
-        msg_time_(last_time_.ToNanosecond() + 1),
+        counters_(nullptr),
+        last_received_msgs_(0),
         channel_node_(nullptr),
         node_name_(nodeName),
         readers_(),
@@ -114,7 +116,11 @@ class GeneralChannelMessage : public GeneralMessageBase {
         channel_message_(nullptr),
         channel_reader_(nullptr),
         inner_lock_(),
-        raw_msg_class_(nullptr) {}
+        raw_msg_class_(nullptr),
+        parsed_message_(nullptr),
+        is_parsed_(false),
+        line_count_(0),
+        line_count_width_(-1) {}
 
   GeneralChannelMessage(const GeneralChannelMessage&) = delete;
   GeneralChannelMessage& operator=(const GeneralChannelMessage&) = delete;
@@ -141,8 +147,6 @@ class GeneralChannelMessage : public GeneralMessageBase {
   void updateRawMessage(
       const std::shared_ptr<apollo::cyber::message::RawMessage>& rawMsg) {
     set_has_message_come(true);
-    msg_time_ = apollo::cyber::Time::MonoTime();
-    ++frame_counter_;
     std::lock_guard<std::mutex> _g(inner_lock_);
     channel_message_.reset();
     channel_message_ = rawMsg;
@@ -159,6 +163,13 @@ class GeneralChannelMessage : public GeneralMessageBase {
 
   GeneralChannelMessage* OpenChannel(const std::string& channelName);
 
+  // Parses the latest message into raw_msg_class_, unless it is the one
+  // parsed last, so refreshing the screen deserializes each message once.
+  // Keeps raw_msg_class_ itself, the GeneralMessage views point into it.
+  bool ParseLatestMessage(void);
+  // lineCount() of the parsed message, walked again only when it changes.
+  int ParsedLineCount(int screenWidth);
+
   void RenderDebugString(const Screen* s, int key, unsigned lineNo);
   void RenderInfo(const Screen* s, int key, unsigned lineNo);
 
@@ -168,9 +179,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
 
   bool has_message_come_;
   std::string message_type_;
-  std::atomic<int> frame_counter_;
-  apollo::cyber::Time last_time_;
-  apollo::cyber::Time msg_time_;
+  // Of this process, so the frame ratio and drops of the channel are read
+  // off its reader instead of being counted again.
+  const apollo::cyber::transport::ChannelCounters* counters_;
+  uint64_t last_received_msgs_;
   apollo::cyber::Time time_last_calc_ = apollo::cyber::Time::MonoTime();
 
   std::unique_ptr<apollo::cyber::Node> channel_node_;
@@ -186,6 +198,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
   mutable std::mutex inner_lock_;
 
   google::protobuf::Message* raw_msg_class_;
+  std::shared_ptr<apollo::cyber::message::RawMessage> parsed_message_;
+  bool is_parsed_;
+  int line_count_;
+  int line_count_width_;
 
   friend class CyberTopologyMessage;
   friend class GeneralMessage;
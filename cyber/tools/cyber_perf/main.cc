@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "cyber/event/perf_event_converter.h"
+
+using apollo::cyber::event::ConvertPerfToChromeTrace;
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cout << "usage: " << argv[0] << " <perf.bin> <trace.json>\n"
+              << "Convert a perf file recorded with cyber_perf_format=binary"
+              << " into a trace for chrome://tracing or ui.perfetto.dev."
+              << std::endl;
+    return -1;
+  }
+
+  std::ifstream in(argv[1], std::ios::binary);
+  if (!in.is_open()) {
+    std::cout << "can not open " << argv[1] << std::endl;
+    return -1;
+  }
+  std::ofstream out(argv[2], std::ios::trunc);
+  if (!out.is_open()) {
+    std::cout << "can not open " << argv[2] << std::endl;
+    return -1;
+  }
+  return ConvertPerfToChromeTrace(&in, &out) ? 0 : -1;
+}
@@ -0,0 +1,549 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/tools/cyber_recorder/exporter.h"
+
+#include <google/protobuf/wire_format_lite.h>
+#include <algorithm>
+#include <cinttypes>
+#include <thread>
+#include <utility>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/message/protobuf_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedInputStream;
+
+bool FieldProjection::Init(const Descriptor* descriptor,
+                           const std::vector<std::string>& paths) {
+  for (const auto& path : paths) {
+    std::vector<Node>* nodes = &root_;
+    const Descriptor* message = descriptor;
+    size_t begin = 0;
+    while (true) {
+      size_t end = path.find('.', begin);
+      const std::string name = path.substr(begin, end - begin);
+      const FieldDescriptor* field =
+          message == nullptr ? nullptr : message->FindFieldByName(name);
+      if (field == nullptr) {
+        AERROR << "No field " << name << " in " << path << " of "
+               << descriptor->full_name();
+        return false;
+      }
+      if (field->is_repeated()) {
+        AERROR << "Repeated field " << name << " in " << path
+               << " is not supported.";
+        return false;
+      }
+      auto it = std::find_if(nodes->begin(), nodes->end(),
+                             [field](const Node& node) {
+                               return node.field == field;
+                             });
+      if (it == nodes->end()) {
+        nodes->push_back({field, -1, {}});
+        it = nodes->end() - 1;
+      }
+      if (end != std::string::npos) {
+        if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+          AERROR << "Field " << name << " in " << path << " is no message.";
+          return false;
+        }
+        nodes = &it->children;
+        message = field->message_type();
+        begin = end + 1;
+        continue;
+      }
+      if (it->column >= 0) {
+        break;
+      }
+      Column column = {path, "", 0};
+      Value value;
+      value.u8 = 0;
+      switch (field->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+          column.dtype = "<f8";
+          column.value_size = sizeof(double);
+          value.f8 = field->default_value_double();
+          break;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+          column.dtype = "<f4";
+          column.value_size = sizeof(float);
+          value.f4 = field->default_value_float();
+          break;
+        case FieldDescriptor::CPPTYPE_INT32:
+          column.dtype = "<i4";
+          column.value_size = sizeof(int32_t);
+          value.i4 = field->default_value_int32();
+          break;
+        case FieldDescriptor::CPPTYPE_ENUM:
+          column.dtype = "<i4";
+          column.value_size = sizeof(int32_t);
+          value.i4 = field->default_value_enum()->number();
+          break;
+        case FieldDescriptor::CPPTYPE_INT64:
+          column.dtype = "<i8";
+          column.value_size = sizeof(int64_t);
+          value.i8 = field->default_value_int64();
+          break;
+        case FieldDescriptor::CPPTYPE_UINT32:
+          column.dtype = "<u4";
+          column.value_size = sizeof(uint32_t);
+          value.u4 = field->default_value_uint32();
+          break;
+        case FieldDescriptor::CPPTYPE_UINT64:
+          column.dtype = "<u8";
+          column.value_size = sizeof(uint64_t);
+          value.u8 = field->default_value_uint64();
+          break;
+        case FieldDescriptor::CPPTYPE_BOOL:
+          column.dtype = "|b1";
+          column.value_size = sizeof(bool);
+          value.b1 = field->default_value_bool();
+          break;
+        default:
+          AERROR << "Field " << path << " is no number.";
+          return false;
+      }
+      it->column = static_cast<int>(columns_.size());
+      columns_.push_back(column);
+      defaults_.push_back(value);
+      break;
+    }
+  }
+  return true;
+}
+
+bool FieldProjection::Project(const std::string& message,
+                              std::string* columns) const {
+  std::vector<Value> values(defaults_);
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(message.data()),
+                         static_cast<int>(message.size()));
+  if (!Scan(root_, &input, values.data())) {
+    return false;
+  }
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    columns[i].append(reinterpret_cast<const char*>(&values[i]),
+                      columns_[i].value_size);
+  }
+  return true;
+}
+
+bool FieldProjection::Scan(const std::vector<Node>& nodes,
+                           CodedInputStream* input, Value* values) const {
+  uint32_t tag = 0;
+  while ((tag = input->ReadTag()) != 0) {
+    const int number = WireFormatLite::GetTagFieldNumber(tag);
+    auto it = std::find_if(nodes.begin(), nodes.end(), [number](const Node& n) {
+      return n.field->number() == number;
+    });
+    // the fields not asked for, and those of an unexpected wire type such as
+    // a packed encoding, are skipped
+    if (it == nodes.end() ||
+        WireFormatLite::GetTagWireType(tag) !=
+            WireFormatLite::WireTypeForFieldType(
+                static_cast<WireFormatLite::FieldType>(it->field->type()))) {
+      if (!WireFormatLite::SkipField(input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    if (it->column >= 0) {
+      if (!ReadValue(it->field, input, &values[it->column])) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length = 0;
+    if (!input->ReadVarint32(&length)) {
+      return false;
+    }
+    auto limit = input->PushLimit(static_cast<int>(length));
+    if (!Scan(it->children, input, values) ||
+        !input->ConsumedEntireMessage()) {
+      return false;
+    }
+    input->PopLimit(limit);
+  }
+  return true;
+}
+
+bool FieldProjection::ReadValue(const FieldDescriptor* field,
+                                CodedInputStream* input, Value* value) {
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_DOUBLE:
+      return WireFormatLite::ReadPrimitive<double,
+                                           WireFormatLite::TYPE_DOUBLE>(
+          input, &value->f8);
+    case FieldDescriptor::TYPE_FLOAT:
+      return WireFormatLite::ReadPrimitive<float, WireFormatLite::TYPE_FLOAT>(
+          input, &value->f4);
+    case FieldDescriptor::TYPE_INT32:
+      return WireFormatLite::ReadPrimitive<int32_t,
+                                           WireFormatLite::TYPE_INT32>(
+          input, &value->i4);
+    case FieldDescriptor::TYPE_SINT32:
+      return WireFormatLite::ReadPrimitive<int32_t,
+                                           WireFormatLite::TYPE_SINT32>(
+          input, &value->i4);
+    case FieldDescriptor::TYPE_SFIXED32:
+      return WireFormatLite::ReadPrimitive<int32_t,
+                                           WireFormatLite::TYPE_SFIXED32>(
+          input, &value->i4);
+    case FieldDescriptor::TYPE_ENUM:
+      return WireFormatLite::ReadPrimitive<int, WireFormatLite::TYPE_ENUM>(
+          input, &value->i4);
+    case FieldDescriptor::TYPE_INT64:
+      return WireFormatLite::ReadPrimitive<int64_t,
+                                           WireFormatLite::TYPE_INT64>(
+          input, &value->i8);
+    case FieldDescriptor::TYPE_SINT64:
+      return WireFormatLite::ReadPrimitive<int64_t,
+                                           WireFormatLite::TYPE_SINT64>(
+          input, &value->i8);
+    case FieldDescriptor::TYPE_SFIXED64:
+      return WireFormatLite::ReadPrimitive<int64_t,
+                                           WireFormatLite::TYPE_SFIXED64>(
+          input, &value->i8);
+    case FieldDescriptor::TYPE_UINT32:
+      return WireFormatLite::ReadPrimitive<uint32_t,
+                                           WireFormatLite::TYPE_UINT32>(
+          input, &value->u4);
+    case FieldDescriptor::TYPE_FIXED32:
+      return WireFormatLite::ReadPrimitive<uint32_t,
+                                           WireFormatLite::TYPE_FIXED32>(
+          input, &value->u4);
+    case FieldDescriptor::TYPE_UINT64:
+      return WireFormatLite::ReadPrimitive<uint64_t,
+                                           WireFormatLite::TYPE_UINT64>(
+          input, &value->u8);
+    case FieldDescriptor::TYPE_FIXED64:
+      return WireFormatLite::ReadPrimitive<uint64_t,
+                                           WireFormatLite::TYPE_FIXED64>(
+          input, &value->u8);
+    case FieldDescriptor::TYPE_BOOL:
+      return WireFormatLite::ReadPrimitive<bool, WireFormatLite::TYPE_BOOL>(
+          input, &value->b1);
+    default:
+      return false;
+  }
+}
+
+NpyWriter::~NpyWriter() { Close(); }
+
+bool NpyWriter::Open(const std::string& path, const std::string& dtype,
+                     size_t value_size) {
+  file_ = fopen(path.c_str(), "wb");
+  if (file_ == nullptr) {
+    AERROR << "Open file failed, file: " << path << ", errno: " << errno;
+    return false;
+  }
+  dtype_ = dtype;
+  value_size_ = value_size;
+  count_ = 0;
+  return WriteHeader();
+}
+
+bool NpyWriter::Append(const std::string& values) {
+  if (fwrite(values.data(), 1, values.size(), file_) != values.size()) {
+    AERROR << "Write file failed, errno: " << errno;
+    return false;
+  }
+  count_ += values.size() / value_size_;
+  return true;
+}
+
+bool NpyWriter::Close() {
+  if (file_ == nullptr) {
+    return true;
+  }
+  bool result = WriteHeader();
+  fclose(file_);
+  file_ = nullptr;
+  return result;
+}
+
+bool NpyWriter::WriteHeader() {
+  // Format version 1.0, the header is padded to 64 bytes. The length of the
+  // array is padded too, so that the header keeps its size when it is
+  // rewritten with the final length.
+  char shape[32];
+  snprintf(shape, sizeof(shape), "(%20" PRIu64 ",)", count_);
+  std::string header = "{'descr': '" + dtype_ +
+                       "', 'fortran_order': False, 'shape': " + shape + ", }";
+  const size_t kPreambleSize = 10;
+  header.append(63 - (kPreambleSize + header.size()) % 64, ' ');
+  header.push_back('\n');
+  std::string preamble("\x93NUMPY\x01\x00", 8);
+  const uint16_t header_size = static_cast<uint16_t>(header.size());
+  preamble.append(reinterpret_cast<const char*>(&header_size),
+                  sizeof(header_size));
+  if (fseek(file_, 0, SEEK_SET) != 0 ||
+      fwrite(preamble.data(), 1, preamble.size(), file_) != preamble.size() ||
+      fwrite(header.data(), 1, header.size(), file_) != header.size() ||
+      fseek(file_, 0, SEEK_END) != 0) {
+    AERROR << "Write npy header failed, errno: " << errno;
+    return false;
+  }
+  return true;
+}
+
+Exporter::Exporter(const ExportParam& param) : param_(param) {
+  for (const auto& item : param_.fields) {
+    channel_names_.insert(item.first);
+  }
+}
+
+bool Exporter::Proc() {
+  if (channel_names_.empty()) {
+    AERROR << "No field to export.";
+    return false;
+  }
+  if (!Prepare() || !OpenWriters()) {
+    return false;
+  }
+
+  std::vector<std::thread> workers;
+  for (uint32_t i = 0; i < std::max(param_.threads, 1U); ++i) {
+    workers.emplace_back(&Exporter::RunWorker, this);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  bool result = !failed_;
+  for (const auto& item : channels_) {
+    for (const auto& writer : item.second->writers) {
+      result = writer->Close() && result;
+    }
+    AINFO << "Exported " << item.second->rows << " messages of "
+          << item.first;
+  }
+  return result;
+}
+
+bool Exporter::Prepare() {
+  for (size_t i = 0; i < param_.files.size(); ++i) {
+    RecordFileReader reader;
+    if (!reader.Open(param_.files[i])) {
+      AERROR << "Open record file failed, file: " << param_.files[i];
+      return false;
+    }
+    if (!reader.ReadIndex()) {
+      AERROR << "Read index failed, recover the record first, file: "
+             << param_.files[i];
+      return false;
+    }
+    Index index = reader.GetIndex();
+    for (const auto& single_index : index.indexes()) {
+      if (single_index.type() == SectionType::SECTION_CHANNEL &&
+          channel_names_.count(single_index.channel_cache().name()) > 0 &&
+          !PrepareChannel(single_index.channel_cache().name(),
+                          single_index.channel_cache())) {
+        return false;
+      }
+      if (single_index.type() != SectionType::SECTION_CHUNK_HEADER) {
+        continue;
+      }
+      const auto& chunk_header_cache = single_index.chunk_header_cache();
+      if (chunk_header_cache.end_time() < param_.begin_time ||
+          chunk_header_cache.begin_time() > param_.end_time) {
+        continue;
+      }
+      // records written before the index listed the channels of chunks
+      // have all of them read
+      if (chunk_header_cache.channel_name_size() > 0 &&
+          std::none_of(chunk_header_cache.channel_name().begin(),
+                       chunk_header_cache.channel_name().end(),
+                       [this](const std::string& channel_name) {
+                         return channel_names_.count(channel_name) > 0;
+                       })) {
+        continue;
+      }
+      tasks_.push_back({i, single_index.position()});
+    }
+  }
+  for (const auto& channel_name : channel_names_) {
+    if (channels_.count(channel_name) == 0) {
+      AWARN << "Channel " << channel_name << " is not in the records.";
+    }
+  }
+  return true;
+}
+
+bool Exporter::PrepareChannel(const std::string& channel_name,
+                              const ChannelCache& channel_cache) {
+  auto it = channels_.find(channel_name);
+  if (it != channels_.end()) {
+    if (it->second->message_type != channel_cache.message_type()) {
+      AERROR << "Channel " << channel_name << " has messages of both "
+             << it->second->message_type << " and "
+             << channel_cache.message_type();
+      return false;
+    }
+    return true;
+  }
+  auto factory = message::ProtobufFactory::Instance();
+  factory->RegisterMessage(channel_cache.proto_desc());
+  const Descriptor* descriptor =
+      factory->FindMessageTypeByName(channel_cache.message_type());
+  if (descriptor == nullptr) {
+    AERROR << "No descriptor of " << channel_cache.message_type()
+           << " for channel " << channel_name;
+    return false;
+  }
+  std::unique_ptr<ChannelExport> channel(new ChannelExport());
+  channel->message_type = channel_cache.message_type();
+  if (!channel->projection.Init(descriptor, param_.fields[channel_name])) {
+    return false;
+  }
+  channels_[channel_name] = std::move(channel);
+  return true;
+}
+
+bool Exporter::OpenWriters() {
+  for (const auto& item : channels_) {
+    std::string directory = item.first;
+    directory.erase(0, directory.find_first_not_of('/'));
+    std::replace(directory.begin(), directory.end(), '/', '.');
+    directory = param_.output_dir + "/" + directory;
+    if (!common::EnsureDirectory(directory)) {
+      AERROR << "Create directory failed: " << directory;
+      return false;
+    }
+    auto& writers = item.second->writers;
+    writers.emplace_back(new NpyWriter());
+    if (!writers.back()->Open(directory + "/time.npy", "<u8",
+                              sizeof(uint64_t))) {
+      return false;
+    }
+    for (const auto& column : item.second->projection.columns()) {
+      writers.emplace_back(new NpyWriter());
+      if (!writers.back()->Open(directory + "/" + column.path + ".npy",
+                                column.dtype, column.value_size)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void Exporter::RunWorker() {
+  const size_t kMaxPendingChunks = 4 * std::max(param_.threads, 1U);
+  // a reader per record, for the mappings of the files
+  std::vector<std::unique_ptr<RecordFileReader>> readers(param_.files.size());
+  while (true) {
+    size_t task_index = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this, kMaxPendingChunks] {
+        return failed_ || next_task_ >= tasks_.size() ||
+               next_task_ < next_write_ + kMaxPendingChunks;
+      });
+      if (failed_ || next_task_ >= tasks_.size()) {
+        return;
+      }
+      task_index = next_task_++;
+    }
+
+    ChunkColumns chunk_columns;
+    bool exported = ExportChunk(tasks_[task_index], &readers, &chunk_columns);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!exported) {
+      failed_ = true;
+      cv_.notify_all();
+      return;
+    }
+    pending_chunks_[task_index] = std::move(chunk_columns);
+    while (!failed_ && !pending_chunks_.empty() &&
+           pending_chunks_.begin()->first == next_write_) {
+      failed_ = !WriteChunk(pending_chunks_.begin()->second);
+      pending_chunks_.erase(pending_chunks_.begin());
+      ++next_write_;
+    }
+    cv_.notify_all();
+  }
+}
+
+bool Exporter::ExportChunk(
+    const ChunkTask& task,
+    std::vector<std::unique_ptr<RecordFileReader>>* readers,
+    ChunkColumns* chunk_columns) const {
+  auto& reader = (*readers)[task.file_index];
+  if (reader == nullptr) {
+    reader.reset(new RecordFileReader());
+    if (!reader->Open(param_.files[task.file_index])) {
+      AERROR << "Open record file failed, file: "
+             << param_.files[task.file_index];
+      return false;
+    }
+  }
+  ChunkBody chunk_body;
+  if (!reader->ReadChunkBodyAt(task.position, &chunk_body, channel_names_)) {
+    AERROR << "Read chunk failed, file: " << param_.files[task.file_index]
+           << ", position: " << task.position;
+    return false;
+  }
+  for (const auto& message : chunk_body.messages()) {
+    if (message.time() < param_.begin_time ||
+        message.time() > param_.end_time) {
+      continue;
+    }
+    auto it = channels_.find(message.channel_name());
+    if (it == channels_.end()) {
+      continue;
+    }
+    const FieldProjection& projection = it->second->projection;
+    auto& columns = (*chunk_columns)[message.channel_name()];
+    if (columns.empty()) {
+      columns.resize(1 + projection.columns().size());
+    }
+    if (!projection.Project(message.content(), &columns[1])) {
+      AWARN << "Skip a malformed message of " << message.channel_name()
+            << " at " << message.time();
+      continue;
+    }
+    const uint64_t time = message.time();
+    columns[0].append(reinterpret_cast<const char*>(&time), sizeof(time));
+  }
+  return true;
+}
+
+bool Exporter::WriteChunk(const ChunkColumns& chunk_columns) {
+  for (const auto& item : chunk_columns) {
+    ChannelExport* channel = channels_[item.first].get();
+    for (size_t i = 0; i < item.second.size(); ++i) {
+      if (!channel->writers[i]->Append(item.second[i])) {
+        return false;
+      }
+    }
+    channel->rows += item.second[0].size() / sizeof(uint64_t);
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
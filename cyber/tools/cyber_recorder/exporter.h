@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TOOLS_CYBER_RECORDER_EXPORTER_H_
+#define CYBER_TOOLS_CYBER_RECORDER_EXPORTER_H_
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cyber/proto/record.pb.h"
+#include "cyber/record/file/record_file_reader.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+// Decodes only the fields of a message along the paths asked for, such as
+// "pose.position.x", walking its wire format and skipping everything else.
+// The fields are scalars, reached through singular messages.
+class FieldProjection {
+ public:
+  struct Column {
+    std::string path;
+    // numpy type of the values, e.g. "<f8"
+    std::string dtype;
+    size_t value_size;
+  };
+
+  bool Init(const google::protobuf::Descriptor* descriptor,
+            const std::vector<std::string>& paths);
+  const std::vector<Column>& columns() const { return columns_; }
+  // Appends the value of every field to its column in columns[], the
+  // default of the field if the message does not have it.
+  bool Project(const std::string& message, std::string* columns) const;
+
+ private:
+  union Value {
+    double f8;
+    float f4;
+    int32_t i4;
+    int64_t i8;
+    uint32_t u4;
+    uint64_t u8;
+    bool b1;
+  };
+  struct Node {
+    const google::protobuf::FieldDescriptor* field;
+    // of a scalar field, -1 for the messages on the way
+    int column;
+    std::vector<Node> children;
+  };
+
+  bool Scan(const std::vector<Node>& nodes,
+            google::protobuf::io::CodedInputStream* input,
+            Value* values) const;
+  static bool ReadValue(const google::protobuf::FieldDescriptor* field,
+                        google::protobuf::io::CodedInputStream* input,
+                        Value* value);
+
+  std::vector<Node> root_;
+  std::vector<Column> columns_;
+  std::vector<Value> defaults_;
+};
+
+// A one dimensional numpy array file, written as it is appended to.
+class NpyWriter {
+ public:
+  ~NpyWriter();
+  bool Open(const std::string& path, const std::string& dtype,
+            size_t value_size);
+  bool Append(const std::string& values);
+  // Writes the final shape into the header.
+  bool Close();
+
+ private:
+  bool WriteHeader();
+
+  FILE* file_ = nullptr;
+  std::string dtype_;
+  size_t value_size_ = 0;
+  uint64_t count_ = 0;
+};
+
+struct ExportParam {
+  std::vector<std::string> files;
+  // channel -> paths of the fields to export
+  std::map<std::string, std::vector<std::string>> fields;
+  std::string output_dir;
+  uint32_t threads = 4;
+  uint64_t begin_time = 0;
+  uint64_t end_time = UINT64_MAX;
+};
+
+// Exports fields of the messages in records to columns for analysis, a numpy
+// array per field in a directory per channel, along with the record time of
+// the messages:
+//   <output_dir>/apollo.canbus.chassis/time.npy
+//   <output_dir>/apollo.canbus.chassis/speed_mps.npy
+// The chunks of the records are decoded in parallel, found through their
+// indexes, and only the fields asked for are decoded.
+class Exporter {
+ public:
+  explicit Exporter(const ExportParam& param);
+  bool Proc();
+
+ private:
+  struct ChannelExport {
+    std::string message_type;
+    FieldProjection projection;
+    // the record time first, then the fields
+    std::vector<std::unique_ptr<NpyWriter>> writers;
+    uint64_t rows = 0;
+  };
+  struct ChunkTask {
+    size_t file_index;
+    uint64_t position;
+  };
+  // the columns of one chunk per channel, as the writers of the channel
+  using ChunkColumns = std::map<std::string, std::vector<std::string>>;
+
+  bool Prepare();
+  bool PrepareChannel(const std::string& channel_name,
+                      const ChannelCache& channel_cache);
+  bool OpenWriters();
+  void RunWorker();
+  bool ExportChunk(
+      const ChunkTask& task,
+      std::vector<std::unique_ptr<RecordFileReader>>* readers,
+      ChunkColumns* chunk_columns) const;
+  bool WriteChunk(const ChunkColumns& chunk_columns);
+
+  ExportParam param_;
+  std::set<std::string> channel_names_;
+  std::map<std::string, std::unique_ptr<ChannelExport>> channels_;
+  std::vector<ChunkTask> tasks_;
+
+  // Chunks are decoded in any order but written in the order of the records,
+  // the workers wait when too many are pending.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t next_task_ = 0;
+  size_t next_write_ = 0;
+  std::map<size_t, ChunkColumns> pending_chunks_;
+  bool failed_ = false;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TOOLS_CYBER_RECORDER_EXPORTER_H_
@@ -84,6 +84,10 @@ bool Info::Display(const std::string& file) {
   std::cout << std::setw(w) << "channel_number:" << hdr.channel_number()
             << std::endl;
 
+  // compress
+  std::cout << std::setw(w) << "compress:"
+            << proto::CompressType_Name(hdr.compress()) << std::endl;
+
   // read index section
   if (!file_reader.ReadIndex()) {
     AERROR << "read index section of the file fail. file: " << file;
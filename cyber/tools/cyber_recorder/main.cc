@@ -16,14 +16,17 @@
 
 #include <getopt.h>
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cyber/common/file.h"
 #include "cyber/common/time_conversion.h"
 #include "cyber/init.h"
+#include "cyber/tools/cyber_recorder/exporter.h"
 #include "cyber/tools/cyber_recorder/info.h"
 #include "cyber/tools/cyber_recorder/player/player.h"
 #include "cyber/tools/cyber_recorder/recorder.h"
@@ -33,6 +36,9 @@
 using apollo::cyber::common::GetFileName;
 using apollo::cyber::common::StringToUnixSeconds;
 using apollo::cyber::common::UnixSecondsToString;
+using apollo::cyber::proto::CompressType;
+using apollo::cyber::record::Exporter;
+using apollo::cyber::record::ExportParam;
 using apollo::cyber::record::Info;
 using apollo::cyber::record::Player;
 using apollo::cyber::record::PlayParam;
@@ -41,10 +47,11 @@ using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:h";
-const char PLAY_OPTIONS[] = "f:c:lr:b:e:s:d:h";
-const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
+const char RECORD_OPTIONS[] = "o:ac:z:h";
+const char PLAY_OPTIONS[] = "f:c:lr:b:e:s:d:j:h";
+const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:i:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
+const char EXPORT_OPTIONS[] = "f:o:p:b:e:j:h";
 
 void DisplayUsage(const std::string& binary);
 void DisplayUsage(const std::string& binary, const std::string& command);
@@ -59,6 +66,7 @@ void DisplayUsage(const std::string& binary) {
             << "\trecord\tRecord same topic.\n"
             << "\tsplit\tSplit an exist record.\n"
             << "\trecover\tRecover an exist record.\n"
+            << "\texport\tExport fields of exist records to numpy arrays.\n"
             << std::endl;
 }
 
@@ -81,6 +89,8 @@ void DisplayUsage(const std::string& binary, const std::string& command) {
     DisplayUsage(binary, command, SPLIT_OPTIONS);
   } else if (command == "recover") {
     DisplayUsage(binary, command, RECOVER_OPTIONS);
+  } else if (command == "export") {
+    DisplayUsage(binary, command, EXPORT_OPTIONS);
   } else {
     std::cout << "Unknown command: " << command << std::endl;
     DisplayUsage(binary);
@@ -95,7 +105,17 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-f, --file <file>\t\t\tinput record file" << std::endl;
         break;
       case 'o':
-        std::cout << "\t-o, --output <file>\t\t\toutput record file"
+        if (command == "export") {
+          std::cout << "\t-o, --output <dir>\t\t\toutput directory"
+                    << std::endl;
+        } else {
+          std::cout << "\t-o, --output <file>\t\t\toutput record file"
+                    << std::endl;
+        }
+        break;
+      case 'p':
+        std::cout << "\t-p, --field <channel:path[,path]>\t" << command
+                  << " the fields, e.g. /apollo/canbus/chassis:speed_mps"
                   << std::endl;
         break;
       case 'a':
@@ -132,6 +152,18 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-d, --delay <seconds>\t\t\t" << command
                   << " delayed n seconds" << std::endl;
         break;
+      case 'j':
+        std::cout << "\t-j, --decode-threads <2>\t\tdecode chunks ahead of "
+                  << command << " with n threads" << std::endl;
+        break;
+      case 'i':
+        std::cout << "\t-i, --interval <seconds>\t\t" << command
+                  << " into files of n seconds each" << std::endl;
+        break;
+      case 'z':
+        std::cout << "\t-z, --compress <lz4|zstd>\t\tcompress chunks of the "
+                  << command << " file" << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -157,12 +189,13 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:h";
+  const std::string short_opts = "f:c:k:o:p:alr:b:e:s:d:j:i:z:h";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
       {"black-channel", required_argument, nullptr, 'k'},
       {"output", required_argument, nullptr, 'o'},
+      {"field", required_argument, nullptr, 'p'},
       {"all", no_argument, nullptr, 'a'},
       {"loop", no_argument, nullptr, 'l'},
       {"rate", required_argument, nullptr, 'r'},
@@ -170,12 +203,16 @@ int main(int argc, char** argv) {
       {"end", required_argument, nullptr, 'e'},
       {"start", required_argument, nullptr, 's'},
       {"delay", required_argument, nullptr, 'd'},
+      {"decode-threads", required_argument, nullptr, 'j'},
+      {"interval", required_argument, nullptr, 'i'},
+      {"compress", required_argument, nullptr, 'z'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
   std::vector<std::string> opt_output_vec;
   std::vector<std::string> opt_white_channels;
   std::vector<std::string> opt_black_channels;
+  std::vector<std::string> opt_fields;
   bool opt_all = false;
   bool opt_loop = false;
   float opt_rate = 1.0f;
@@ -183,6 +220,9 @@ int main(int argc, char** argv) {
   uint64_t opt_end = UINT64_MAX;
   uint64_t opt_start = 0;
   uint64_t opt_delay = 0;
+  uint32_t opt_decode_threads = 2;
+  uint64_t opt_interval = 0;
+  CompressType opt_compress = CompressType::COMPRESS_NONE;
 
   do {
     int opt =
@@ -224,6 +264,16 @@ int main(int argc, char** argv) {
       case 'o':
         opt_output_vec.push_back(std::string(optarg));
         break;
+      case 'p':
+        opt_fields.emplace_back(std::string(optarg));
+        for (int i = optind; i < argc; i++) {
+          if (*argv[i] != '-') {
+            opt_fields.emplace_back(std::string(argv[i]));
+          } else {
+            break;
+          }
+        }
+        break;
       case 'a':
         opt_all = true;
         break;
@@ -277,6 +327,43 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'j':
+        try {
+          opt_decode_threads = std::stoi(optarg);
+        } catch (const std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -j/--decode-threads "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -j/--decode-threads "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
+      case 'i':
+        try {
+          opt_interval = std::stoul(optarg);
+        } catch (const std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -i/--interval " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -i/--interval "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
+      case 'z':
+        if (std::string(optarg) == "lz4") {
+          opt_compress = CompressType::COMPRESS_LZ4;
+        } else if (std::string(optarg) == "zstd") {
+          opt_compress = CompressType::COMPRESS_ZSTD;
+        } else {
+          std::cout << "Invalid argument: -z/--compress "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -329,6 +416,7 @@ int main(int argc, char** argv) {
     play_param.end_time_ns = opt_end;
     play_param.start_time_s = opt_start;
     play_param.delay_time_s = opt_delay;
+    play_param.decode_threads = opt_decode_threads;
     play_param.files_to_play.insert(opt_file_vec.begin(), opt_file_vec.end());
     play_param.channels_to_play.insert(opt_white_channels.begin(),
                                        opt_white_channels.end());
@@ -354,8 +442,8 @@ int main(int argc, char** argv) {
     }
     bool record_result = true;
     ::apollo::cyber::Init(argv[0]);
-    auto recorder = std::make_shared<Recorder>(opt_output_vec[0], opt_all,
-                                               opt_white_channels);
+    auto recorder = std::make_shared<Recorder>(
+        opt_output_vec[0], opt_all, opt_white_channels, opt_compress);
     record_result = record_result && recorder->Start() ? true : false;
     if (record_result) {
       while (!::apollo::cyber::IsShutdown()) {
@@ -369,19 +457,75 @@ int main(int argc, char** argv) {
       std::cout << "MUST specify file option (-f)." << std::endl;
       return -1;
     }
-    if (opt_file_vec.size() > 1 || opt_output_vec.size() > 1) {
-      std::cout << "TOO many input/output file option (-f/-o)." << std::endl;
+    if (!opt_output_vec.empty() &&
+        opt_output_vec.size() != opt_file_vec.size()) {
+      std::cout << "MUST specify one output file option (-o) per input file "
+                   "(-f), or none."
+                << std::endl;
       return -1;
     }
     if (opt_output_vec.empty()) {
-      std::string default_output_file = opt_file_vec[0] + ".split";
-      opt_output_vec.push_back(default_output_file);
+      for (const auto& file : opt_file_vec) {
+        opt_output_vec.push_back(file + ".split");
+      }
     }
     ::apollo::cyber::Init(argv[0]);
-    Spliter spliter(opt_file_vec[0], opt_output_vec[0], opt_white_channels,
-                    opt_black_channels, opt_begin, opt_end);
-    bool split_result = spliter.Proc();
+    // the files are independent, split them all at once
+    std::vector<std::thread> split_threads;
+    std::unique_ptr<bool[]> split_results(new bool[opt_file_vec.size()]);
+    for (size_t i = 0; i < opt_file_vec.size(); ++i) {
+      split_threads.emplace_back([&, i]() {
+        Spliter spliter(opt_file_vec[i], opt_output_vec[i], opt_white_channels,
+                        opt_black_channels, opt_begin, opt_end,
+                        opt_interval * 1000 * 1000 * 1000ULL);
+        split_results[i] = spliter.Proc();
+      });
+    }
+    bool split_result = true;
+    for (size_t i = 0; i < split_threads.size(); ++i) {
+      split_threads[i].join();
+      split_result = split_result && split_results[i];
+    }
     return split_result ? 0 : -1;
+  } else if (command == "export") {
+    if (opt_file_vec.empty()) {
+      std::cout << "MUST specify file option (-f)." << std::endl;
+      return -1;
+    }
+    if (opt_fields.empty()) {
+      std::cout << "MUST specify field option (-p)." << std::endl;
+      return -1;
+    }
+    if (opt_output_vec.size() > 1) {
+      std::cout << "TOO many ouput directory option (-o)." << std::endl;
+      return -1;
+    }
+    ExportParam export_param;
+    export_param.files = opt_file_vec;
+    export_param.output_dir = opt_output_vec.empty() ? "." : opt_output_vec[0];
+    export_param.threads = opt_decode_threads;
+    export_param.begin_time = opt_begin;
+    export_param.end_time = opt_end;
+    for (const auto& field : opt_fields) {
+      // channel names have no ':', the paths may be listed with ','
+      size_t colon = field.rfind(':');
+      if (colon == std::string::npos || colon == 0) {
+        std::cout << "Invalid argument: -p/--field " << field << std::endl;
+        return -1;
+      }
+      auto& paths = export_param.fields[field.substr(0, colon)];
+      size_t begin = colon + 1;
+      while (begin <= field.size()) {
+        size_t end = std::min(field.find(',', begin), field.size());
+        if (end > begin) {
+          paths.push_back(field.substr(begin, end - begin));
+        }
+        begin = end + 1;
+      }
+    }
+    ::apollo::cyber::Init(argv[0]);
+    Exporter exporter(export_param);
+    return exporter.Proc() ? 0 : -1;
   }
 
   // unknown command
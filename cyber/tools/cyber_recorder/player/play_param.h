@@ -33,6 +33,8 @@ struct PlayParam {
   uint64_t end_time_ns = UINT64_MAX;
   uint64_t start_time_s = 0;
   uint64_t delay_time_s = 0;
+  // threads decoding chunks ahead of playback, 0 decodes on the producer
+  uint32_t decode_threads = 2;
   std::set<std::string> files_to_play;
   std::set<std::string> channels_to_play;
 };
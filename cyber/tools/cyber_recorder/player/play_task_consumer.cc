@@ -16,13 +16,15 @@
 
 #include "cyber/tools/cyber_recorder/player/play_task_consumer.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
-#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+const uint64_t PlayTaskConsumer::kLateThresholdNanoSec = 1000000UL;
 const uint64_t PlayTaskConsumer::kPauseSleepNanoSec = 100000000UL;
 const uint64_t PlayTaskConsumer::kWaitProduceSleepNanoSec = 5000000UL;
 const uint64_t PlayTaskConsumer::MIN_SLEEP_DURATION_NS = 200000000UL;
@@ -37,7 +39,8 @@ PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
       is_playonce_(false),
       base_msg_play_time_ns_(0),
       base_msg_real_time_ns_(0),
-      last_played_msg_real_time_ns_(0) {
+      last_played_msg_real_time_ns_(0),
+      late_msg_num_(0) {
   if (play_rate_ <= 0) {
     AERROR << "invalid play rate: " << play_rate_
            << " , we will use default value(1.0).";
@@ -65,9 +68,22 @@ void PlayTaskConsumer::Stop() {
   }
 }
 
+bool PlayTaskConsumer::SleepUntil(const Clock::time_point& deadline) {
+  const auto slice = std::chrono::nanoseconds(MIN_SLEEP_DURATION_NS);
+  while (!is_stopped_.load()) {
+    auto now = Clock::now();
+    if (now >= deadline) {
+      return true;
+    }
+    std::this_thread::sleep_until(std::min(deadline, now + slice));
+  }
+  return false;
+}
+
 void PlayTaskConsumer::ThreadFunc() {
-  uint64_t base_real_time_ns = 0;
-  uint64_t accumulated_pause_time_ns = 0;
+  // every message is due at an absolute time derived from the first one, so
+  // wake-up jitter and slow publishes never add up over the record
+  Clock::time_point base_real_time;
 
   while (!is_stopped_.load()) {
     auto task = task_buffer_->Front();
@@ -77,54 +93,50 @@ void PlayTaskConsumer::ThreadFunc() {
       continue;
     }
 
-    uint64_t sleep_ns = 0;
-
     if (base_msg_play_time_ns_ == 0) {
       base_msg_play_time_ns_ = task->msg_play_time_ns();
       base_msg_real_time_ns_ = task->msg_real_time_ns();
+      base_real_time = Clock::now();
       if (base_msg_play_time_ns_ > begin_time_ns_) {
-        sleep_ns = static_cast<uint64_t>(
+        base_real_time += std::chrono::nanoseconds(static_cast<uint64_t>(
             static_cast<double>(base_msg_play_time_ns_ - begin_time_ns_) /
-            play_rate_);
-        while (sleep_ns > MIN_SLEEP_DURATION_NS && !is_stopped_.load()) {
-          std::this_thread::sleep_for(
-              std::chrono::nanoseconds(MIN_SLEEP_DURATION_NS));
-          sleep_ns -= MIN_SLEEP_DURATION_NS;
-        }
-
-        if (is_stopped_.load()) {
-          break;
-        }
-
-        std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+            play_rate_));
       }
-      base_real_time_ns = Time::Now().ToNanosecond();
-      ADEBUG << "base_msg_play_time_ns: " << base_msg_play_time_ns_
-             << "base_real_time_ns: " << base_real_time_ns;
+      ADEBUG << "base_msg_play_time_ns: " << base_msg_play_time_ns_;
+    }
+
+    auto deadline =
+        base_real_time +
+        std::chrono::nanoseconds(static_cast<uint64_t>(
+            static_cast<double>(task->msg_play_time_ns() -
+                                base_msg_play_time_ns_) /
+            play_rate_));
+    if (!SleepUntil(deadline)) {
+      break;
     }
 
-    uint64_t task_interval_ns = static_cast<uint64_t>(
-        static_cast<double>(task->msg_play_time_ns() - base_msg_play_time_ns_) /
-        play_rate_);
-    uint64_t real_time_interval_ns = Time::Now().ToNanosecond() -
-                                     base_real_time_ns -
-                                     accumulated_pause_time_ns;
-    if (task_interval_ns > real_time_interval_ns) {
-      sleep_ns = task_interval_ns - real_time_interval_ns;
-      std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+    uint64_t lateness_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             deadline)
+            .count();
+    lateness_.Record(lateness_ns);
+    if (lateness_ns > kLateThresholdNanoSec) {
+      late_msg_num_.fetch_add(1);
     }
 
     task->Play();
     is_playonce_.exchange(false);
 
     last_played_msg_real_time_ns_ = task->msg_real_time_ns();
+    auto pause_begin = Clock::now();
     while (is_paused_.load() && !is_stopped_.load()) {
       if (is_playonce_.load()) {
         break;
       }
       std::this_thread::sleep_for(std::chrono::nanoseconds(kPauseSleepNanoSec));
-      accumulated_pause_time_ns += kPauseSleepNanoSec;
     }
+    // the paused time shifts every following deadline
+    base_real_time += Clock::now() - pause_begin;
     task_buffer_->PopFront();
   }
 }
@@ -19,9 +19,11 @@
 
 #include <stdint.h>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <thread>
 
+#include "cyber/base/histogram.h"
 #include "cyber/tools/cyber_recorder/player/play_task_buffer.h"
 
 namespace apollo {
@@ -30,6 +32,7 @@ namespace record {
 
 class PlayTaskConsumer {
  public:
+  using Clock = std::chrono::steady_clock;
   using ThreadPtr = std::unique_ptr<std::thread>;
   using TaskBufferPtr = std::shared_ptr<PlayTaskBuffer>;
 
@@ -49,8 +52,13 @@ class PlayTaskConsumer {
     return last_played_msg_real_time_ns_;
   }
 
+  // how far behind its deadline each message was published
+  const base::Histogram& lateness() const { return lateness_; }
+  uint64_t late_msg_num() const { return late_msg_num_.load(); }
+
  private:
   void ThreadFunc();
+  bool SleepUntil(const Clock::time_point& deadline);
 
   double play_rate_;
   ThreadPtr consume_th_;
@@ -62,6 +70,9 @@ class PlayTaskConsumer {
   uint64_t base_msg_play_time_ns_;
   uint64_t base_msg_real_time_ns_;
   uint64_t last_played_msg_real_time_ns_;
+  base::Histogram lateness_;
+  std::atomic<uint64_t> late_msg_num_;
+  static const uint64_t kLateThresholdNanoSec;
   static const uint64_t kPauseSleepNanoSec;
   static const uint64_t kWaitProduceSleepNanoSec;
   static const uint64_t MIN_SLEEP_DURATION_NS;
@@ -30,6 +30,7 @@ namespace record {
 const uint32_t PlayTaskProducer::kMinTaskBufferSize = 500;
 const uint32_t PlayTaskProducer::kPreloadTimeSec = 3;
 const uint64_t PlayTaskProducer::kSleepIntervalNanoSec = 1000000;
+const uint32_t PlayTaskProducer::kPrefetchChunksPerThread = 2;
 
 PlayTaskProducer::PlayTaskProducer(const TaskBufferPtr& task_buffer,
                                    const PlayParam& play_param)
@@ -106,6 +107,10 @@ bool PlayTaskProducer::ReadRecordInfo() {
   }
 
   auto pb_factory = message::ProtobufFactory::Instance();
+  if (play_param_.decode_threads > 0) {
+    decode_pool_ =
+        std::make_shared<base::ThreadPool>(play_param_.decode_threads);
+  }
 
   // loop each file
   for (auto& file : play_param_.files_to_play) {
@@ -118,6 +123,10 @@ bool PlayTaskProducer::ReadRecordInfo() {
       continue;
     }
 
+    // chunks are decoded ahead on the pool, the producer thread only turns
+    // parsed messages into tasks
+    record_reader->set_prefetch(
+        decode_pool_, play_param_.decode_threads * kPrefetchChunksPerThread);
     record_readers_.emplace_back(record_reader);
 
     auto& channel_info = record_reader->channel_info();
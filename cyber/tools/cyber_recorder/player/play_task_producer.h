@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/node/node.h"
 #include "cyber/node/writer.h"
@@ -76,6 +77,7 @@ class PlayTaskProducer {
   WriterMap writers_;
   MessageTypeMap msg_types_;
   std::vector<RecordReaderPtr> record_readers_;
+  std::shared_ptr<base::ThreadPool> decode_pool_;
 
   uint64_t earliest_begin_time_;
   uint64_t latest_end_time_;
@@ -84,6 +86,7 @@ class PlayTaskProducer {
   static const uint32_t kMinTaskBufferSize;
   static const uint32_t kPreloadTimeSec;
   static const uint64_t kSleepIntervalNanoSec;
+  static const uint32_t kPrefetchChunksPerThread;
 };
 
 }  // namespace record
@@ -158,6 +158,16 @@ bool Player::Start() {
   }
 
   std::cout << "\nplay finished." << std::endl;
+  const auto& lateness = consumer_->lateness();
+  if (lateness.Count() > 0) {
+    std::cout << "played " << lateness.Count() << " messages, "
+              << consumer_->late_msg_num() << " of them over 1ms late"
+              << ", lateness(ms) p50: "
+              << static_cast<double>(lateness.Percentile(50)) / 1e6
+              << ", p99: " << static_cast<double>(lateness.Percentile(99)) / 1e6
+              << ", max: " << static_cast<double>(lateness.Max()) / 1e6
+              << std::endl;
+  }
   std::cout.flags(before);
   return true;
 }
@@ -21,13 +21,21 @@ namespace cyber {
 namespace record {
 
 Recorder::Recorder(const std::string& output, bool all_channels,
-                   const std::vector<std::string>& channel_vec)
-    : output_(output), all_channels_(all_channels), channel_vec_(channel_vec) {}
+                   const std::vector<std::string>& channel_vec,
+                   CompressType compress_type)
+    : output_(output),
+      all_channels_(all_channels),
+      channel_vec_(channel_vec),
+      compress_type_(compress_type) {}
 
 Recorder::~Recorder() { Stop(); }
 
 bool Recorder::Start() {
   writer_.reset(new RecordWriter());
+  if (!writer_->SetCompressType(compress_type_)) {
+    AERROR << "Set compress type error.";
+    return false;
+  }
   if (!writer_->Open(output_)) {
     AERROR << "Datafile open file error.";
     return false;
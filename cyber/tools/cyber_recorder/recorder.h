@@ -46,7 +46,8 @@ namespace record {
 class Recorder : public std::enable_shared_from_this<Recorder> {
  public:
   Recorder(const std::string& output, bool all_channels,
-           const std::vector<std::string>& channel_vec);
+           const std::vector<std::string>& channel_vec,
+           CompressType compress_type = CompressType::COMPRESS_NONE);
   ~Recorder();
   bool Start();
   bool Stop();
@@ -61,6 +62,7 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
   std::string output_;
   bool all_channels_ = true;
   std::vector<std::string> channel_vec_;
+  CompressType compress_type_;
   std::unordered_map<std::string, std::shared_ptr<ReaderBase>>
       channel_reader_map_;
   uint64_t message_count_;
@@ -37,6 +37,7 @@ bool Recoverer::Proc() {
 
   // open output file
   Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(reader_.GetHeader().compress());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
@@ -67,7 +68,9 @@ bool Recoverer::Proc() {
     }
   }
 
-  // read through record file
+  // read through record file, a chunk which is intact is copied as it is
+  ChunkHeader chdr;
+  bool chunk_header_valid = false;
   reader_.Reset();
   while (!reader_.EndOfFile()) {
     Section section;
@@ -93,18 +96,36 @@ bool Recoverer::Proc() {
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
-        if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
+        chunk_header_valid = reader_.ReadSection<ChunkHeader>(section.size,
+                                                              &chdr);
+        if (!chunk_header_valid) {
           AINFO << "one chunk header section broken, skip it.";
         }
         break;
       }
       case SectionType::SECTION_CHUNK_BODY: {
+        bool chunk_intact = chunk_header_valid;
+        chunk_header_valid = false;
+        std::string raw_body;
         ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
+        if (!reader_.ReadRawSection(section.size, &raw_body) ||
+            !reader_.DecodeChunkBody(raw_body, &cbd)) {
           AINFO << "one chunk body section broken, skip it";
           break;
         }
+        if (chunk_intact &&
+            chdr.message_number() ==
+                static_cast<uint64_t>(cbd.messages_size())) {
+          std::map<std::string, uint64_t> channel_message_number;
+          for (const auto& message : cbd.messages()) {
+            ++channel_message_number[message.channel_name()];
+          }
+          if (!writer_.WriteRawChunk(chdr, raw_body, channel_message_number)) {
+            AERROR << "write chunk failed.";
+            return false;
+          }
+          break;
+        }
         for (int idx = 0; idx < cbd.messages_size(); ++idx) {
           if (!writer_.WriteMessage(cbd.messages(idx))) {
             AERROR << "add new message failed.";
@@ -18,6 +18,7 @@
 #define CYBER_TOOLS_CYBER_RECORDER_RECOVERER_H_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
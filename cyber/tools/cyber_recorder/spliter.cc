@@ -16,6 +16,8 @@
 
 #include "cyber/tools/cyber_recorder/spliter.h"
 
+#include <cstdio>
+
 namespace apollo {
 namespace cyber {
 namespace record {
@@ -23,16 +25,109 @@ namespace record {
 Spliter::Spliter(const std::string& input_file, const std::string& output_file,
                  const std::vector<std::string>& white_channels,
                  const std::vector<std::string>& black_channels,
-                 uint64_t begin_time, uint64_t end_time)
+                 uint64_t begin_time, uint64_t end_time,
+                 uint64_t shard_interval)
     : input_file_(input_file),
       output_file_(output_file),
       white_channels_(white_channels),
       black_channels_(black_channels),
       begin_time_(begin_time),
-      end_time_(end_time) {}
+      end_time_(end_time),
+      shard_interval_(shard_interval) {}
 
 Spliter::~Spliter() {}
 
+bool Spliter::IsChannelSelected(const std::string& channel_name) const {
+  if (!white_channels_.empty() &&
+      std::find(white_channels_.begin(), white_channels_.end(),
+                channel_name) == white_channels_.end()) {
+    return false;
+  }
+  return std::find(black_channels_.begin(), black_channels_.end(),
+                   channel_name) == black_channels_.end();
+}
+
+uint64_t Spliter::GetShard(uint64_t time) const {
+  if (shard_interval_ == 0 || time <= shard_begin_time_) {
+    return 0;
+  }
+  return (time - shard_begin_time_) / shard_interval_;
+}
+
+bool Spliter::OpenShard(uint64_t shard) {
+  // messages a little out of order stay in the shard being written
+  if (writer_ != nullptr && shard <= shard_) {
+    return true;
+  }
+  shard_ = shard;
+  std::string path = output_file_;
+  if (shard_interval_ > 0) {
+    char index[8];
+    snprintf(index, sizeof(index), "%05u", shard_file_index_++);
+    path += "." + std::string(index);
+  }
+  // closing the previous shard writes its index
+  writer_.reset(new RecordFileWriter());
+  if (!writer_->Open(path)) {
+    AERROR << "open output file failed. file: " << path;
+    return false;
+  }
+  if (!writer_->WriteHeader(output_header_)) {
+    AERROR << "write header to output file failed. file: " << path;
+    return false;
+  }
+  for (const auto& channel : channels_) {
+    writer_->WriteChannel(channel);
+  }
+  return true;
+}
+
+bool Spliter::CopyChunk(const ChunkHeader& chunk_header,
+                        const ChunkHeaderCache& chunk_header_cache,
+                        uint64_t size) {
+  std::string chunk_body;
+  if (!reader_.ReadRawSection(size, &chunk_body)) {
+    AERROR << "read chunk body section fail.";
+    return false;
+  }
+  std::map<std::string, uint64_t> channel_message_number;
+  for (int i = 0; i < chunk_header_cache.channel_name_size(); ++i) {
+    channel_message_number[chunk_header_cache.channel_name(i)] =
+        chunk_header_cache.channel_message_number(i);
+  }
+  if (!OpenShard(GetShard(chunk_header.begin_time())) ||
+      !writer_->WriteRawChunk(chunk_header, chunk_body,
+                              channel_message_number)) {
+    AERROR << "write chunk failed.";
+    return false;
+  }
+  ++copied_chunks_;
+  return true;
+}
+
+bool Spliter::SplitChunk(uint64_t size) {
+  ChunkBody cbd;
+  if (!reader_.ReadSection<ChunkBody>(size, &cbd)) {
+    AERROR << "read chunk body section fail.";
+    return false;
+  }
+  for (const auto& message : cbd.messages()) {
+    if (!IsChannelSelected(message.channel_name())) {
+      continue;
+    }
+    if (message.time() < begin_time_ || message.time() > end_time_) {
+      continue;
+    }
+    if (!OpenShard(GetShard(message.time())) ||
+        !writer_->WriteMessage(message)) {
+      AERROR << "add new message failed.";
+      return false;
+    }
+  }
+  ++split_chunks_;
+  return true;
+}
+
 bool Spliter::Proc() {
   // check params
   if (begin_time_ >= end_time_) {
@@ -63,19 +158,30 @@ bool Spliter::Proc() {
     return false;
   }
 
-  // open output file
-  Header new_hdr = HeaderBuilder::GetHeader();
-  if (!writer_.Open(output_file_)) {
-    AERROR << "open output file failed. file: " << output_file_;
-    return false;
+  // the channels of every chunk, to know which can be copied whole
+  if (reader_.ReadIndex()) {
+    Index index = reader_.GetIndex();
+    for (const auto& single_index : index.indexes()) {
+      if (single_index.type() == SectionType::SECTION_CHUNK_HEADER &&
+          single_index.chunk_header_cache().channel_name_size() > 0) {
+        chunk_header_caches_[single_index.position()] =
+            single_index.chunk_header_cache();
+      }
+    }
   }
-  if (!writer_.WriteHeader(new_hdr)) {
-    AERROR << "write header to output file failed. file: " << output_file_;
+
+  // open output file
+  output_header_ = HeaderBuilder::GetHeader();
+  output_header_.set_compress(header.compress());
+  shard_begin_time_ = std::max(begin_time_, header.begin_time());
+  if (!OpenShard(0)) {
     return false;
   }
 
   // read through record file
+  ChunkHeader chdr;
   bool skip_next_chunk_body(false);
+  const ChunkHeaderCache* chunk_to_copy = nullptr;
   reader_.Reset();
   while (!reader_.EndOfFile()) {
     Section section;
@@ -93,24 +199,34 @@ bool Spliter::Proc() {
           AERROR << "read channel section fail.";
           return false;
         }
-        if (white_channels_.empty() ||
-            std::find(white_channels_.begin(), white_channels_.end(),
-                      chan.name()) != white_channels_.end()) {
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        chan.name()) == black_channels_.end()) {
-            writer_.WriteChannel(chan);
-          }
+        if (IsChannelSelected(chan.name())) {
+          channels_.push_back(chan);
+          writer_->WriteChannel(chan);
         }
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
         if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
           AERROR << "read chunk header section fail.";
           return false;
         }
+        chunk_to_copy = nullptr;
         if (begin_time_ > chdr.end_time() || end_time_ < chdr.begin_time()) {
           skip_next_chunk_body = true;
+          break;
+        }
+        // a chunk within the time range and one shard whose channels are
+        // all selected is copied whole
+        auto it = chunk_header_caches_.find(reader_.CurrentPosition());
+        if (it != chunk_header_caches_.end() &&
+            begin_time_ <= chdr.begin_time() && chdr.end_time() <= end_time_ &&
+            GetShard(chdr.begin_time()) == GetShard(chdr.end_time()) &&
+            std::all_of(it->second.channel_name().begin(),
+                        it->second.channel_name().end(),
+                        [this](const std::string& channel_name) {
+                          return IsChannelSelected(channel_name);
+                        })) {
+          chunk_to_copy = &it->second;
         }
         break;
       }
@@ -120,32 +236,13 @@ bool Spliter::Proc() {
           skip_next_chunk_body = false;
           break;
         }
-        ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
-          AERROR << "read chunk body section fail.";
+        bool written = chunk_to_copy != nullptr
+                           ? CopyChunk(chdr, *chunk_to_copy, section.size)
+                           : SplitChunk(section.size);
+        chunk_to_copy = nullptr;
+        if (!written) {
           return false;
         }
-        for (int idx = 0; idx < cbd.messages_size(); ++idx) {
-          if (!white_channels_.empty() &&
-              std::find(white_channels_.begin(), white_channels_.end(),
-                        cbd.messages(idx).channel_name()) ==
-                  white_channels_.end()) {
-            continue;
-          }
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        cbd.messages(idx).channel_name()) !=
-              black_channels_.end()) {
-            continue;
-          }
-          if (cbd.messages(idx).time() < begin_time_ ||
-              cbd.messages(idx).time() > end_time_) {
-            continue;
-          }
-          if (!writer_.WriteMessage(cbd.messages(idx))) {
-            AERROR << "add new message failed.";
-            return false;
-          }
-        }
         break;
       }
       default: {
@@ -155,7 +252,9 @@ bool Spliter::Proc() {
       }
     }  // end for switch
   }    // end for while
-  AINFO << "split record file done.";
+  writer_.reset();
+  AINFO << "split record file done, chunks copied: " << copied_chunks_
+        << ", chunks split: " << split_chunks_;
   return true;
 }  // end for Proc()
 
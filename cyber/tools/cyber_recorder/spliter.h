@@ -18,8 +18,10 @@
 #define CYBER_TOOLS_CYBER_RECORDER_SPLITER_H_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -32,23 +34,37 @@ using ::apollo::cyber::proto::Header;
 using ::apollo::cyber::proto::ChunkHeader;
 using ::apollo::cyber::proto::ChunkBody;
 using ::apollo::cyber::proto::ChannelCache;
+using ::apollo::cyber::proto::ChunkHeaderCache;
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+// Copies the messages of the selected channels and time range to a new
+// record, or to one record per `shard_interval` nanoseconds of it if that is
+// not 0, named <output_file>.00000, <output_file>.00001 and so on. A chunk
+// which is kept whole, and whose channels are known from the index of the
+// input, is copied as it is stored, without decoding it.
 class Spliter {
  public:
   Spliter(const std::string& input_file, const std::string& output_file,
           const std::vector<std::string>& white_channels,
           const std::vector<std::string>& black_channels,
-          uint64_t begin_time = 0, uint64_t end_time = UINT64_MAX);
+          uint64_t begin_time = 0, uint64_t end_time = UINT64_MAX,
+          uint64_t shard_interval = 0);
   virtual ~Spliter();
   bool Proc();
 
  private:
+  bool IsChannelSelected(const std::string& channel_name) const;
+  uint64_t GetShard(uint64_t time) const;
+  bool OpenShard(uint64_t shard);
+  bool CopyChunk(const ChunkHeader& chunk_header,
+                 const ChunkHeaderCache& chunk_header_cache, uint64_t size);
+  bool SplitChunk(uint64_t size);
+
   RecordFileReader reader_;
-  RecordFileWriter writer_;
+  std::unique_ptr<RecordFileWriter> writer_;
   std::string input_file_;
   std::string output_file_;
   std::vector<std::string> white_channels_;
@@ -56,6 +72,16 @@ class Spliter {
   bool all_channels_;
   uint64_t begin_time_;
   uint64_t end_time_;
+  uint64_t shard_interval_;
+  uint64_t shard_begin_time_ = 0;
+  uint64_t shard_ = 0;
+  uint32_t shard_file_index_ = 0;
+  Header output_header_;
+  std::vector<Channel> channels_;
+  // chunk body position -> chunk header cache, from the index of the input
+  std::unordered_map<uint64_t, ChunkHeaderCache> chunk_header_caches_;
+  uint64_t copied_chunks_ = 0;
+  uint64_t split_chunks_ = 0;
 };
 
 }  // namespace record
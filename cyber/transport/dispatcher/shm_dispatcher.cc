@@ -15,6 +15,9 @@
  *****************************************************************************/
 
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
+
+#include <chrono>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/scheduler/scheduler_factory.h"
@@ -26,7 +29,13 @@ namespace transport {
 
 using common::GlobalData;
 
-ShmDispatcher::ShmDispatcher() : host_id_(0) { Init(); }
+namespace {
+// ring mode back-off: spin this many empty polls before sleeping
+constexpr uint32_t kRingSpinPolls = 64;
+constexpr auto kRingPollInterval = std::chrono::microseconds(50);
+}  // namespace
+
+ShmDispatcher::ShmDispatcher() : host_id_(0), ring_mode_(false) { Init(); }
 
 ShmDispatcher::~ShmDispatcher() { Shutdown(); }
 
@@ -39,6 +48,11 @@ void ShmDispatcher::Shutdown() {
     thread_.join();
   }
 
+  if (notifier_ != nullptr && notifier_->wakeup_latency().Count() > 0) {
+    AINFO << "shm notifier wakeup latency(ns): "
+          << notifier_->wakeup_latency().ToString();
+  }
+
   {
     ReadLockGuard<AtomicRWLock> lock(segments_lock_);
     segments_.clear();
@@ -52,8 +66,12 @@ void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
     return;
   }
   auto segment = std::make_shared<Segment>(channel_id, READ_ONLY);
+  // keep the blocks on the node of the processors running the reader
+  segment->set_numa_node(scheduler::Instance()->TaskNumaNode(
+      self_attr.node_name() + "_" + self_attr.channel_name()));
   segments_[channel_id] = segment;
   previous_indexes_[channel_id] = UINT32_MAX;
+  next_seqs_[channel_id] = Segment::kInvalidSeq;
 }
 
 void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
@@ -82,6 +100,26 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
   segments_[channel_id]->ReleaseReadBlock(*rb);
 }
 
+bool ShmDispatcher::ReadRingMessage(uint64_t channel_id,
+                                    const SegmentPtr& segment) {
+  auto rb = std::make_shared<ReadableBlock>();
+  if (!segment->AcquireNextBlockToRead(&next_seqs_[channel_id], rb.get())) {
+    return false;
+  }
+
+  MessageInfo msg_info;
+  const char* msg_info_addr =
+      reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
+  if (!msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size()) ||
+      !Segment::ValidateReadBlock(*rb)) {
+    ADEBUG << "block overwritten while reading, channel: "
+           << GlobalData::GetChannelById(channel_id);
+    return true;
+  }
+  OnMessage(channel_id, rb, msg_info);
+  return true;
+}
+
 void ShmDispatcher::OnMessage(uint64_t channel_id,
                               const std::shared_ptr<ReadableBlock>& rb,
                               const MessageInfo& msg_info) {
@@ -145,8 +183,38 @@ void ShmDispatcher::ThreadFunc() {
   }
 }
 
+void ShmDispatcher::RingThreadFunc() {
+  uint32_t empty_polls = 0;
+  while (!is_shutdown_.load()) {
+    bool has_message = false;
+    {
+      ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+      for (auto& item : segments_) {
+        while (!is_shutdown_.load() &&
+               ReadRingMessage(item.first, item.second)) {
+          has_message = true;
+        }
+      }
+    }
+
+    if (has_message) {
+      empty_polls = 0;
+    } else if (++empty_polls < kRingSpinPolls) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(kRingPollInterval);
+    }
+  }
+}
+
 bool ShmDispatcher::Init() {
   host_id_ = common::Hash(GlobalData::Instance()->HostIp());
+  ring_mode_ = ShmConf::RingModeEnabled();
+  if (ring_mode_) {
+    thread_ = std::thread(&ShmDispatcher::RingThreadFunc, this);
+    scheduler::Instance()->SetInnerThreadAttr(&thread_, "shm_disp");
+    return true;
+  }
   notifier_ = NotifierFactory::CreateNotifier();
   thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
   scheduler::Instance()->SetInnerThreadAttr(&thread_, "shm_disp");
@@ -27,6 +27,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/message_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
 #include "cyber/transport/shm/notifier_factory.h"
@@ -63,14 +64,19 @@ class ShmDispatcher : public Dispatcher {
  private:
   void AddSegment(const RoleAttributes& self_attr);
   void ReadMessage(uint64_t channel_id, uint32_t block_index);
+  bool ReadRingMessage(uint64_t channel_id, const SegmentPtr& segment);
   void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
                  const MessageInfo& msg_info);
   void ThreadFunc();
+  void RingThreadFunc();
   bool Init();
 
   uint64_t host_id_;
+  bool ring_mode_;
   SegmentContainer segments_;
   std::unordered_map<uint64_t, uint32_t> previous_indexes_;
+  // ring mode: next sequence number to read, per channel
+  std::unordered_map<uint64_t, uint64_t> next_seqs_;
   AtomicRWLock segments_lock_;
   std::thread thread_;
   NotifierPtr notifier_;
@@ -82,11 +88,15 @@ template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(pool);
     RETURN_IF(!message::ParseFromArray(
         rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    RETURN_IF(!Segment::ValidateReadBlock(*rb));
     listener(msg, msg_info);
   };
 
@@ -99,11 +109,15 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const RoleAttributes& opposite_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+  auto pool = message::MessagePoolManager<MessageT>::Instance()->GetPool(
+      self_attr.channel_id());
+  auto listener_adapter = [listener, pool](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(pool);
     RETURN_IF(!message::ParseFromArray(
         rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+    RETURN_IF(!Segment::ValidateReadBlock(*rb));
     listener(msg, msg_info);
   };
 
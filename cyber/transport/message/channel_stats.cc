@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/message/channel_stats.h"
+
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+ChannelStats::ChannelStats() {}
+
+ChannelCounters* ChannelStats::GetCounters(uint64_t channel_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& counters = counters_[channel_id];
+  if (counters == nullptr) {
+    counters.reset(new ChannelCounters());
+  }
+  return counters.get();
+}
+
+void ChannelStats::OnSend(ChannelCounters* counters) {
+  uint64_t now = Time::Now().ToNanosecond();
+  counters->sent_msgs.fetch_add(1, std::memory_order_relaxed);
+  uint64_t last = counters->last_send_time.exchange(now);
+  if (last != 0 && now > last) {
+    counters->last_send_interval.store(now - last, std::memory_order_relaxed);
+  }
+}
+
+void ChannelStats::OnReceive(ChannelCounters* counters,
+                             const MessageInfo& msg_info) {
+  uint64_t now = Time::Now().ToNanosecond();
+  counters->received_msgs.fetch_add(1, std::memory_order_relaxed);
+  counters->last_receive_time.store(now, std::memory_order_relaxed);
+  if (msg_info.has_trace() && now > msg_info.send_time()) {
+    counters->latency_sum.fetch_add(now - msg_info.send_time(),
+                                    std::memory_order_relaxed);
+    counters->latency_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // The first message of a writer sets where it starts, and messages resent
+  // from its history go back in sequence, neither is a drop.
+  std::lock_guard<std::mutex> lock(counters->seq_mutex);
+  auto& last_seq_num =
+      counters->last_seq_nums[msg_info.sender_id().HashValue()];
+  if (last_seq_num != 0 && msg_info.seq_num() > last_seq_num + 1) {
+    counters->dropped_msgs.fetch_add(msg_info.seq_num() - last_seq_num - 1,
+                                     std::memory_order_relaxed);
+  }
+  if (msg_info.seq_num() > last_seq_num) {
+    last_seq_num = msg_info.seq_num();
+  }
+}
+
+void ChannelStats::ForEachCounters(const CountersVisitor& visitor) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& item : counters_) {
+    visitor(item.first, *item.second);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
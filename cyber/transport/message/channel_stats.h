@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TRANSPORT_MESSAGE_CHANNEL_STATS_H_
+#define CYBER_TRANSPORT_MESSAGE_CHANNEL_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Cumulative counters of a channel in this process. Times are in
+// nanoseconds, 0 until the first message.
+struct ChannelCounters {
+  // Written by this process.
+  std::atomic<uint64_t> sent_msgs{0};
+  // Handed to the shm and rtps transports, so a message sent over both counts
+  // twice, and intra process messages count none.
+  std::atomic<uint64_t> sent_bytes{0};
+  std::atomic<uint64_t> last_send_time{0};
+  // Between the last two sends.
+  std::atomic<uint64_t> last_send_interval{0};
+
+  // Taken off the transports for the readers of this process.
+  std::atomic<uint64_t> received_msgs{0};
+  // Gaps in the sequence numbers of the writers.
+  std::atomic<uint64_t> dropped_msgs{0};
+  std::atomic<uint64_t> last_receive_time{0};
+  // Send -> receive, of the messages stamped by latency tracing only.
+  std::atomic<uint64_t> latency_sum{0};
+  std::atomic<uint64_t> latency_count{0};
+
+  // The last sequence number of every writer, for the drops.
+  std::mutex seq_mutex;
+  std::unordered_map<uint64_t, uint64_t> last_seq_nums;
+};
+
+// Message counters per channel, always on. Endpoints look their counters up
+// once and then only bump atomics, so checking the health of a channel needs
+// neither a reader nor parsing any of its messages. ChannelStatsReporter
+// shares them with other processes.
+class ChannelStats {
+ public:
+  using CountersVisitor =
+      std::function<void(uint64_t channel_id, const ChannelCounters&)>;
+
+  // The counters of 'channel_id', valid as long as the process runs.
+  ChannelCounters* GetCounters(uint64_t channel_id);
+
+  static void OnSend(ChannelCounters* counters);
+  static void OnSendBytes(ChannelCounters* counters, std::size_t bytes) {
+    counters->sent_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  static void OnReceive(ChannelCounters* counters, const MessageInfo& msg_info);
+
+  void ForEachCounters(const CountersVisitor& visitor);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<ChannelCounters>> counters_;
+
+  DECLARE_SINGLETON(ChannelStats)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_CHANNEL_STATS_H_
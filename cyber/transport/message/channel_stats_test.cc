@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/message/channel_stats.h"
+
+#include <gtest/gtest.h>
+
+#include "cyber/transport/common/identity.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ChannelStatsTest, count_sends) {
+  auto stats = ChannelStats::Instance();
+  auto counters = stats->GetCounters(1);
+  EXPECT_EQ(counters, stats->GetCounters(1));
+  EXPECT_NE(counters, stats->GetCounters(2));
+
+  ChannelStats::OnSend(counters);
+  ChannelStats::OnSendBytes(counters, 100);
+  EXPECT_EQ(0, counters->last_send_interval.load());
+  ChannelStats::OnSend(counters);
+  ChannelStats::OnSendBytes(counters, 100);
+  EXPECT_EQ(2, counters->sent_msgs.load());
+  EXPECT_EQ(200, counters->sent_bytes.load());
+  EXPECT_GT(counters->last_send_time.load(), 0);
+  EXPECT_EQ(0, counters->received_msgs.load());
+}
+
+TEST(ChannelStatsTest, count_drops) {
+  auto counters = ChannelStats::Instance()->GetCounters(3);
+  Identity writer1;
+  Identity writer2;
+
+  // writers may be joined midway
+  ChannelStats::OnReceive(counters, MessageInfo(writer1, 5));
+  ChannelStats::OnReceive(counters, MessageInfo(writer2, 1));
+  ChannelStats::OnReceive(counters, MessageInfo(writer1, 6));
+  ChannelStats::OnReceive(counters, MessageInfo(writer2, 2));
+  EXPECT_EQ(0, counters->dropped_msgs.load());
+
+  ChannelStats::OnReceive(counters, MessageInfo(writer1, 9));
+  EXPECT_EQ(2, counters->dropped_msgs.load());
+  // resent from history
+  ChannelStats::OnReceive(counters, MessageInfo(writer1, 7));
+  ChannelStats::OnReceive(counters, MessageInfo(writer1, 10));
+  EXPECT_EQ(2, counters->dropped_msgs.load());
+
+  EXPECT_EQ(7, counters->received_msgs.load());
+  EXPECT_GT(counters->last_receive_time.load(), 0);
+  // untraced messages have no latency
+  EXPECT_EQ(0, counters->latency_count.load());
+
+  MessageInfo traced(writer2, 3);
+  traced.set_send_time(1);
+  ChannelStats::OnReceive(counters, traced);
+  EXPECT_EQ(1, counters->latency_count.load());
+  EXPECT_GT(counters->latency_sum.load(), 0);
+
+  int visited = 0;
+  ChannelStats::Instance()->ForEachCounters(
+      [&visited](uint64_t channel_id, const ChannelCounters& counters) {
+        if (channel_id == 3) {
+          EXPECT_EQ(8, counters.received_msgs.load());
+        }
+        ++visited;
+      });
+  EXPECT_GE(visited, 1);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -17,10 +17,10 @@
 #ifndef CYBER_TRANSPORT_MESSAGE_HISTORY_H_
 #define CYBER_TRANSPORT_MESSAGE_HISTORY_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <list>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include "cyber/common/global_data.h"
@@ -31,6 +31,12 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+// Keeps the last depth() messages added, for readers joining late. The
+// messages are kept in a ring of slots allocated by Enable: the single
+// writer (the transmitter, under its lock) fills one slot per Add with no
+// allocation and no history wide lock, and GetCachedMessage copies the
+// consecutive messages added before it started, up to the newest, oldest
+// first: those the writer overwrites meanwhile are left out.
 template <typename MessageT>
 class History {
  public:
@@ -46,8 +52,8 @@ class History {
   explicit History(const HistoryAttributes& attr);
   virtual ~History();
 
-  void Enable() { enabled_ = true; }
-  void Disable() { enabled_ = false; }
+  void Enable();
+  void Disable() { enabled_.store(false, std::memory_order_release); }
 
   void Add(const MessagePtr& msg, const MessageInfo& msg_info);
   void Clear();
@@ -58,16 +64,33 @@ class History {
   uint32_t max_depth() const { return max_depth_; }
 
  private:
-  bool enabled_;
+  struct Slot {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    // 1 + the add index of msg, 0 when empty
+    uint64_t seq = 0;
+    MessagePtr msg;
+    MessageInfo msg_info;
+  };
+
+  static void LockSlot(Slot* slot) {
+    while (slot->lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  static void UnlockSlot(Slot* slot) {
+    slot->lock.clear(std::memory_order_release);
+  }
+
+  std::atomic<bool> enabled_ = {false};
   uint32_t depth_;
   uint32_t max_depth_;
-  std::list<CachedMessage> msgs_;
-  mutable std::mutex msgs_mutex_;
+  std::unique_ptr<Slot[]> slots_;
+  // the add index of the next message, and of the first one after Clear
+  std::atomic<uint64_t> add_count_ = {0};
+  std::atomic<uint64_t> clear_count_ = {0};
 };
 
 template <typename MessageT>
-History<MessageT>::History(const HistoryAttributes& attr)
-    : enabled_(false), max_depth_(1000) {
+History<MessageT>::History(const HistoryAttributes& attr) : max_depth_(1000) {
   auto& global_conf = common::GlobalData::Instance()->Config();
   if (global_conf.has_transport_conf() &&
       global_conf.transport_conf().has_resource_limit()) {
@@ -90,41 +113,90 @@ History<MessageT>::~History() {
   Clear();
 }
 
+template <typename MessageT>
+void History<MessageT>::Enable() {
+  // the slots are only allocated for channels with transient local
+  // durability, the others never enable their history
+  if (slots_ == nullptr && depth_ > 0) {
+    slots_.reset(new Slot[depth_]);
+  }
+  enabled_.store(true, std::memory_order_release);
+}
+
 template <typename MessageT>
 void History<MessageT>::Add(const MessagePtr& msg,
                             const MessageInfo& msg_info) {
-  if (!enabled_) {
+  if (!enabled_.load(std::memory_order_acquire) || slots_ == nullptr) {
     return;
   }
-  std::lock_guard<std::mutex> lock(msgs_mutex_);
-  msgs_.emplace_back(msg, msg_info);
-  while (msgs_.size() > depth_) {
-    msgs_.pop_front();
-  }
+  uint64_t index = add_count_.load(std::memory_order_relaxed);
+  Slot* slot = &slots_[index % depth_];
+  MessagePtr replaced = msg;
+  LockSlot(slot);
+  slot->msg.swap(replaced);
+  slot->msg_info = msg_info;
+  slot->seq = index + 1;
+  UnlockSlot(slot);
+  add_count_.store(index + 1, std::memory_order_release);
+  // the message the slot held is released outside of its lock
 }
 
 template <typename MessageT>
 void History<MessageT>::Clear() {
-  std::lock_guard<std::mutex> lock(msgs_mutex_);
-  msgs_.clear();
+  clear_count_.store(add_count_.load(std::memory_order_acquire),
+                     std::memory_order_release);
+  if (slots_ == nullptr) {
+    return;
+  }
+  for (uint32_t i = 0; i < depth_; ++i) {
+    MessagePtr cleared;
+    Slot* slot = &slots_[i];
+    LockSlot(slot);
+    if (slot->seq <= clear_count_.load(std::memory_order_relaxed)) {
+      slot->msg.swap(cleared);
+      slot->seq = 0;
+    }
+    UnlockSlot(slot);
+  }
 }
 
 template <typename MessageT>
 void History<MessageT>::GetCachedMessage(
     std::vector<CachedMessage>* msgs) const {
-  if (msgs == nullptr) {
+  if (msgs == nullptr || slots_ == nullptr) {
     return;
   }
 
-  std::lock_guard<std::mutex> lock(msgs_mutex_);
-  msgs->reserve(msgs_.size());
-  msgs->insert(msgs->begin(), msgs_.begin(), msgs_.end());
+  // Clear never moves past the messages added, so begin <= end
+  uint64_t begin = clear_count_.load(std::memory_order_acquire);
+  uint64_t end = add_count_.load(std::memory_order_acquire);
+  if (end - begin > depth_) {
+    begin = end - depth_;
+  }
+  // Newest first: the writer overwrites the oldest slots first, so once a
+  // slot holds a newer message than expected, so do all older ones.
+  size_t first = msgs->size();
+  msgs->reserve(first + (end - begin));
+  for (uint64_t index = end; index > begin; --index) {
+    Slot* slot = &slots_[(index - 1) % depth_];
+    LockSlot(slot);
+    bool expected = slot->seq == index;
+    if (expected) {
+      msgs->emplace_back(slot->msg, slot->msg_info);
+    }
+    UnlockSlot(slot);
+    if (!expected) {
+      break;
+    }
+  }
+  std::reverse(msgs->begin() + first, msgs->end());
 }
 
 template <typename MessageT>
 size_t History<MessageT>::GetSize() const {
-  std::lock_guard<std::mutex> lock(msgs_mutex_);
-  return msgs_.size();
+  uint64_t begin = clear_count_.load(std::memory_order_acquire);
+  uint64_t count = add_count_.load(std::memory_order_acquire) - begin;
+  return static_cast<size_t>(std::min<uint64_t>(count, depth_));
 }
 
 }  // namespace transport
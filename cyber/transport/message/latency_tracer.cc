@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/message/latency_tracer.h"
+
+#include <string>
+
+#include "cyber/common/environment.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// The callback running on this thread.
+struct CallbackTrace {
+  bool active = false;
+  uint64_t start_time = 0;
+  uint64_t origin_time = 0;
+  uint64_t origin_channel_id = 0;
+  LatencyStats* stats = nullptr;
+};
+
+thread_local CallbackTrace current_callback;
+
+inline uint64_t Elapsed(uint64_t from, uint64_t to) {
+  return to > from ? to - from : 0;
+}
+
+}  // namespace
+
+LatencyTracer::LatencyTracer() {
+  auto latency_trace = common::GetEnv("cyber_latency_trace");
+  if (latency_trace != "" && std::stoi(latency_trace)) {
+    enabled_ = true;
+  }
+}
+
+void LatencyTracer::StampSend(uint64_t channel_id, MessageInfo* msg_info) {
+  uint64_t now = Time::Now().ToNanosecond();
+  msg_info->set_send_time(now);
+  if (current_callback.active) {
+    msg_info->set_origin_time(current_callback.origin_time);
+    msg_info->set_origin_channel_id(current_callback.origin_channel_id);
+  } else {
+    msg_info->set_origin_time(now);
+    msg_info->set_origin_channel_id(channel_id);
+  }
+}
+
+void LatencyTracer::OnDequeue(uint64_t channel_id, const void* msg,
+                              const MessageInfo& msg_info) {
+  if (!msg_info.has_trace()) {
+    return;
+  }
+  uint64_t now = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto stats = GetStats(channel_id, msg_info.origin_channel_id());
+  stats->transport.Record(Elapsed(msg_info.send_time(), now));
+
+  auto& pending = pending_[pending_pos_++ % kPendingNum];
+  pending.msg = msg;
+  pending.dequeue_time = now;
+  pending.origin_time = msg_info.origin_time();
+  pending.origin_channel_id = msg_info.origin_channel_id();
+  pending.stats = stats;
+}
+
+void LatencyTracer::OnCallbackStart(const void* msg) {
+  current_callback.active = false;
+  uint64_t now = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  // newest first, every reader of an intra-process message shares it
+  for (uint64_t i = 0; i < kPendingNum && i < pending_pos_; ++i) {
+    auto& pending = pending_[(pending_pos_ - 1 - i) % kPendingNum];
+    if (pending.msg != msg) {
+      continue;
+    }
+    pending.stats->queue.Record(Elapsed(pending.dequeue_time, now));
+    current_callback.active = true;
+    current_callback.start_time = now;
+    current_callback.origin_time = pending.origin_time;
+    current_callback.origin_channel_id = pending.origin_channel_id;
+    current_callback.stats = pending.stats;
+    return;
+  }
+}
+
+void LatencyTracer::OnCallbackEnd() {
+  if (!current_callback.active) {
+    return;
+  }
+  current_callback.active = false;
+  uint64_t now = Time::Now().ToNanosecond();
+  auto stats = current_callback.stats;
+  stats->callback.Record(Elapsed(current_callback.start_time, now));
+  stats->end_to_end.Record(Elapsed(current_callback.origin_time, now));
+}
+
+void LatencyTracer::ForEachStats(const StatsVisitor& visitor) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& item : stats_) {
+    visitor(item.first.first, item.first.second, *item.second);
+  }
+}
+
+LatencyStats* LatencyTracer::GetStats(uint64_t channel_id,
+                                      uint64_t origin_channel_id) {
+  auto& stats = stats_[std::make_pair(channel_id, origin_channel_id)];
+  if (stats == nullptr) {
+    stats.reset(new LatencyStats());
+  }
+  return stats.get();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
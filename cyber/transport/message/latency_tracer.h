@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TRANSPORT_MESSAGE_LATENCY_TRACER_H_
+#define CYBER_TRANSPORT_MESSAGE_LATENCY_TRACER_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "cyber/base/histogram.h"
+#include "cyber/base/macros.h"
+#include "cyber/common/macros.h"
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Latency of the messages of a channel that derive from an origin channel,
+// in nanoseconds.
+struct LatencyStats {
+  // send -> taken off the transport by the receiver
+  base::Histogram transport;
+  // taken off the transport -> callback start
+  base::Histogram queue;
+  // callback start -> callback end
+  base::Histogram callback;
+  // send of the origin message -> callback end
+  base::Histogram end_to_end;
+};
+
+// Per-hop message latency, enabled with cyber_latency_trace=1.
+//
+// Transmitters stamp every message with its send time and with the origin
+// it derives from: a message sent from a callback inherits the origin of the
+// message the callback handles, any other message is its own origin. The
+// stamps travel with MessageInfo over every transport. Receivers note when
+// they take a message off the transport, and the croutine running a
+// callback for it measures queueing and run time.
+class LatencyTracer {
+ public:
+  using StatsVisitor = std::function<void(
+      uint64_t channel_id, uint64_t origin_channel_id, const LatencyStats&)>;
+
+  bool enabled() const { return enabled_; }
+
+  // Stamps 'msg_info' of a message about to be sent on 'channel_id'.
+  void StampSend(uint64_t channel_id, MessageInfo* msg_info);
+
+  // A receiver took 'msg' of 'channel_id' off the transport.
+  void OnDequeue(uint64_t channel_id, const void* msg,
+                 const MessageInfo& msg_info);
+
+  // Bracket a callback for 'msg' on the calling thread. A callback that
+  // yields its croutine midway may be accounted to the wrong message.
+  void OnCallbackStart(const void* msg);
+  void OnCallbackEnd();
+
+  void ForEachStats(const StatsVisitor& visitor);
+
+ private:
+  // A dequeued message waiting for its callback.
+  struct Pending {
+    const void* msg = nullptr;
+    uint64_t dequeue_time = 0;
+    uint64_t origin_time = 0;
+    uint64_t origin_channel_id = 0;
+    LatencyStats* stats = nullptr;
+  };
+  // Messages a callback skips are overwritten by newer ones.
+  static const int kPendingNum = 256;
+
+  LatencyStats* GetStats(uint64_t channel_id, uint64_t origin_channel_id);
+
+  bool enabled_ = false;
+
+  std::mutex mutex_;
+  Pending pending_[kPendingNum];
+  uint64_t pending_pos_ = 0;
+  std::map<std::pair<uint64_t, uint64_t>, std::unique_ptr<LatencyStats>>
+      stats_;
+
+  DECLARE_SINGLETON(LatencyTracer)
+};
+
+// Brackets a callback for 'msg' on the calling thread when tracing is on.
+class CallbackLatencyScope {
+ public:
+  explicit CallbackLatencyScope(const void* msg)
+      : enabled_(LatencyTracer::Instance()->enabled()) {
+    if (unlikely(enabled_)) {
+      LatencyTracer::Instance()->OnCallbackStart(msg);
+    }
+  }
+  ~CallbackLatencyScope() {
+    if (unlikely(enabled_)) {
+      LatencyTracer::Instance()->OnCallbackEnd();
+    }
+  }
+
+ private:
+  bool enabled_;
+  DISALLOW_COPY_AND_ASSIGN(CallbackLatencyScope);
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_LATENCY_TRACER_H_
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/message/latency_tracer.h"
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <thread>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(LatencyTracerTest, propagate_origin) {
+  setenv("cyber_latency_trace", "1", 1);
+  auto tracer = LatencyTracer::Instance();
+  EXPECT_TRUE(tracer->enabled());
+
+  // a message sent outside of a callback is its own origin
+  MessageInfo lidar;
+  tracer->StampSend(1, &lidar);
+  EXPECT_TRUE(lidar.has_trace());
+  EXPECT_EQ(lidar.origin_time(), lidar.send_time());
+  EXPECT_EQ(1, lidar.origin_channel_id());
+
+  int msg = 0;
+  tracer->OnDequeue(2, &msg, lidar);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  {
+    CallbackLatencyScope scope(&msg);
+    // a message sent from the callback inherits the origin
+    MessageInfo obstacles;
+    tracer->StampSend(3, &obstacles);
+    EXPECT_EQ(lidar.origin_time(), obstacles.origin_time());
+    EXPECT_EQ(1, obstacles.origin_channel_id());
+    EXPECT_GE(obstacles.send_time(), lidar.send_time());
+  }
+
+  // once the callback is done messages start a new pipeline
+  MessageInfo other;
+  tracer->StampSend(3, &other);
+  EXPECT_EQ(3, other.origin_channel_id());
+
+  int visited = 0;
+  tracer->ForEachStats([&visited](uint64_t channel_id,
+                                  uint64_t origin_channel_id,
+                                  const LatencyStats& stats) {
+    ++visited;
+    EXPECT_EQ(2, channel_id);
+    EXPECT_EQ(1, origin_channel_id);
+    EXPECT_EQ(1, stats.transport.Count());
+    EXPECT_EQ(1, stats.queue.Count());
+    EXPECT_GE(stats.queue.Max(), 1000000);
+    EXPECT_EQ(1, stats.callback.Count());
+    EXPECT_EQ(1, stats.end_to_end.Count());
+  });
+  EXPECT_EQ(1, visited);
+}
+
+TEST(LatencyTracerTest, untraced_message) {
+  auto tracer = LatencyTracer::Instance();
+  int msg = 0;
+  tracer->OnDequeue(4, &msg, MessageInfo());
+  {
+    CallbackLatencyScope scope(&msg);
+    MessageInfo info;
+    tracer->StampSend(5, &info);
+    EXPECT_EQ(5, info.origin_channel_id());
+  }
+  tracer->ForEachStats([](uint64_t channel_id, uint64_t origin_channel_id,
+                          const LatencyStats& stats) {
+    EXPECT_NE(4, channel_id);
+  });
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_MESSAGE_LOANED_BUFFER_H_
+#define CYBER_TRANSPORT_MESSAGE_LOANED_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cyber/transport/shm/segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// A region of a shm block lent to a writer, so that a message can be
+// serialized in place instead of being copied into the segment. The caller
+// writes at most `capacity` bytes to `data` and sets `size` before
+// publishing.
+struct LoanedBuffer {
+  uint8_t* data = nullptr;
+  std::size_t capacity = 0;
+  std::size_t size = 0;
+  WritableBlock block;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_LOANED_BUFFER_H_
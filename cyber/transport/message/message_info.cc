@@ -18,6 +18,9 @@
 
 #include <arpa/inet.h>
 
+#include <cinttypes>
+#include <cstdio>
+
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -25,6 +28,7 @@ namespace cyber {
 namespace transport {
 
 const std::size_t MessageInfo::kSize = 2 * ID_SIZE + sizeof(uint64_t);
+const std::size_t MessageInfo::kTraceSize = 3 * sizeof(uint64_t);
 
 MessageInfo::MessageInfo() : sender_id_(false), seq_num_(0), spare_id_(false) {}
 
@@ -38,7 +42,10 @@ MessageInfo::MessageInfo(const Identity& sender_id, uint64_t seq_num,
 MessageInfo::MessageInfo(const MessageInfo& another)
     : sender_id_(another.sender_id_),
       seq_num_(another.seq_num_),
-      spare_id_(another.spare_id_) {}
+      spare_id_(another.spare_id_),
+      send_time_(another.send_time_),
+      origin_time_(another.origin_time_),
+      origin_channel_id_(another.origin_channel_id_) {}
 
 MessageInfo::~MessageInfo() {}
 
@@ -47,6 +54,9 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
     sender_id_ = another.sender_id_;
     seq_num_ = another.seq_num_;
     spare_id_ = another.spare_id_;
+    send_time_ = another.send_time_;
+    origin_time_ = another.origin_time_;
+    origin_channel_id_ = another.origin_channel_id_;
   }
   return *this;
 }
@@ -73,13 +83,20 @@ bool MessageInfo::SerializeTo(std::string* dst) const {
   dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&seq_num_)),
               sizeof(seq_num_));
   dst->append(spare_id_.data(), ID_SIZE);
+  if (has_trace()) {
+    dst->append(reinterpret_cast<const char*>(&send_time_), sizeof(send_time_));
+    dst->append(reinterpret_cast<const char*>(&origin_time_),
+                sizeof(origin_time_));
+    dst->append(reinterpret_cast<const char*>(&origin_channel_id_),
+                sizeof(origin_channel_id_));
+  }
 
   return true;
 }
 
 bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
   RETURN_VAL_IF_NULL(dst, false);
-  if (len < kSize) {
+  if (len < ByteSize()) {
     return false;
   }
 
@@ -90,6 +107,14 @@ bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
          sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   memcpy(ptr, spare_id_.data(), ID_SIZE);
+  if (has_trace()) {
+    ptr += ID_SIZE;
+    memcpy(ptr, &send_time_, sizeof(send_time_));
+    ptr += sizeof(send_time_);
+    memcpy(ptr, &origin_time_, sizeof(origin_time_));
+    ptr += sizeof(origin_time_);
+    memcpy(ptr, &origin_channel_id_, sizeof(origin_channel_id_));
+  }
 
   return true;
 }
@@ -100,7 +125,7 @@ bool MessageInfo::DeserializeFrom(const std::string& src) {
 
 bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   RETURN_VAL_IF_NULL(src, false);
-  if (len != kSize) {
+  if (len != kSize && len != kSize + kTraceSize) {
     AWARN << "src size mismatch, given[" << len << "] target[" << kSize << "]";
     return false;
   }
@@ -111,10 +136,43 @@ bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   memcpy(reinterpret_cast<char*>(&seq_num_), ptr, sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   spare_id_.set_data(ptr);
+  if (len == kSize + kTraceSize) {
+    ptr += ID_SIZE;
+    memcpy(&send_time_, ptr, sizeof(send_time_));
+    ptr += sizeof(send_time_);
+    memcpy(&origin_time_, ptr, sizeof(origin_time_));
+    ptr += sizeof(origin_time_);
+    memcpy(&origin_channel_id_, ptr, sizeof(origin_channel_id_));
+  } else {
+    send_time_ = 0;
+    origin_time_ = 0;
+    origin_channel_id_ = 0;
+  }
 
   return true;
 }
 
+std::string MessageInfo::TraceToString() const {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%" PRIu64 "/%" PRIu64 "/%" PRIu64, send_time_,
+           origin_time_, origin_channel_id_);
+  return buf;
+}
+
+bool MessageInfo::TraceFromString(const std::string& str) {
+  uint64_t send_time = 0;
+  uint64_t origin_time = 0;
+  uint64_t origin_channel_id = 0;
+  if (sscanf(str.c_str(), "%" SCNu64 "/%" SCNu64 "/%" SCNu64, &send_time,
+             &origin_time, &origin_channel_id) != 3) {
+    return false;
+  }
+  send_time_ = send_time;
+  origin_time_ = origin_time;
+  origin_channel_id_ = origin_channel_id;
+  return true;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -54,12 +54,39 @@ class MessageInfo {
   const Identity& spare_id() const { return spare_id_; }
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
+  // Hop timestamps, only set when latency tracing is on, see LatencyTracer.
+  // The origin is the first message of the pipeline this one derives from.
+  uint64_t send_time() const { return send_time_; }
+  void set_send_time(uint64_t send_time) { send_time_ = send_time; }
+
+  uint64_t origin_time() const { return origin_time_; }
+  void set_origin_time(uint64_t origin_time) { origin_time_ = origin_time; }
+
+  uint64_t origin_channel_id() const { return origin_channel_id_; }
+  void set_origin_channel_id(uint64_t origin_channel_id) {
+    origin_channel_id_ = origin_channel_id;
+  }
+
+  bool has_trace() const { return send_time_ != 0; }
+  // Text form of the hop timestamps, for transports that only carry strings.
+  std::string TraceToString() const;
+  bool TraceFromString(const std::string& str);
+
+  // Serialized size, the hop timestamps are only sent when set.
+  std::size_t ByteSize() const {
+    return has_trace() ? kSize + kTraceSize : kSize;
+  }
+
   static const std::size_t kSize;
+  static const std::size_t kTraceSize;
 
  private:
   Identity sender_id_;
   uint64_t seq_num_;
   Identity spare_id_;
+  uint64_t send_time_ = 0;
+  uint64_t origin_time_ = 0;
+  uint64_t origin_channel_id_ = 0;
 };
 
 }  // namespace transport
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cyber/common/global_data.h"
@@ -75,6 +76,40 @@ TEST(MessageInfoTest, message_info_test) {
   EXPECT_FALSE(info2.DeserializeFrom("error"));
 }
 
+TEST(MessageInfoTest, trace) {
+  Identity sender_id;
+  MessageInfo info1(sender_id, 1);
+  EXPECT_FALSE(info1.has_trace());
+  EXPECT_EQ(MessageInfo::kSize, info1.ByteSize());
+
+  info1.set_send_time(300);
+  info1.set_origin_time(100);
+  info1.set_origin_channel_id(42);
+  EXPECT_TRUE(info1.has_trace());
+  EXPECT_EQ(MessageInfo::kSize + MessageInfo::kTraceSize, info1.ByteSize());
+
+  std::string str;
+  EXPECT_TRUE(info1.SerializeTo(&str));
+  EXPECT_EQ(info1.ByteSize(), str.size());
+  MessageInfo info2;
+  EXPECT_TRUE(info2.DeserializeFrom(str));
+  EXPECT_EQ(300, info2.send_time());
+  EXPECT_EQ(100, info2.origin_time());
+  EXPECT_EQ(42, info2.origin_channel_id());
+
+  // a message without hop timestamps clears them
+  MessageInfo info3(sender_id, 2);
+  EXPECT_TRUE(info3.SerializeTo(&str));
+  EXPECT_TRUE(info2.DeserializeFrom(str));
+  EXPECT_FALSE(info2.has_trace());
+
+  MessageInfo info4;
+  EXPECT_TRUE(info4.TraceFromString(info1.TraceToString()));
+  EXPECT_EQ(300, info4.send_time());
+  EXPECT_EQ(42, info4.origin_channel_id());
+  EXPECT_FALSE(info4.TraceFromString("1/2"));
+}
+
 TEST(HistoryTest, history_test) {
   Identity sender_id;
   sender_id.set_data("sender");
@@ -118,6 +153,61 @@ TEST(HistoryTest, history_test) {
   EXPECT_EQ(1000, history4.depth());
 }
 
+TEST(HistoryTest, snapshot_while_adding) {
+  Identity sender_id;
+  sender_id.set_data("sender");
+  MessageInfo message_info(sender_id, 0);
+  auto message = std::make_shared<RawMessage>();
+
+  const uint32_t depth = 16;
+  History<RawMessage> history(
+      HistoryAttributes(proto::QosHistoryPolicy::HISTORY_KEEP_LAST, depth));
+  std::vector<History<RawMessage>::CachedMessage> messages;
+  history.GetCachedMessage(&messages);
+  EXPECT_TRUE(messages.empty());
+  history.Enable();
+
+  const uint64_t count = 100000;
+  std::thread writer([&]() {
+    MessageInfo info(message_info);
+    for (uint64_t i = 1; i <= count; ++i) {
+      info.set_seq_num(i);
+      history.Add(message, info);
+    }
+  });
+  // every snapshot is a run of consecutive messages, the newest ones when
+  // it started
+  uint64_t last_newest = 0;
+  while (last_newest < count) {
+    messages.clear();
+    history.GetCachedMessage(&messages);
+    ASSERT_LE(messages.size(), depth);
+    for (size_t i = 1; i < messages.size(); ++i) {
+      ASSERT_EQ(messages[i - 1].msg_info.seq_num() + 1,
+                messages[i].msg_info.seq_num());
+    }
+    if (!messages.empty()) {
+      ASSERT_GE(messages.back().msg_info.seq_num(), last_newest);
+      last_newest = messages.back().msg_info.seq_num();
+    }
+  }
+  writer.join();
+  EXPECT_EQ(depth, messages.size());
+  EXPECT_EQ(depth, history.GetSize());
+
+  history.Clear();
+  EXPECT_EQ(0, history.GetSize());
+  messages.clear();
+  history.GetCachedMessage(&messages);
+  EXPECT_TRUE(messages.empty());
+  message_info.set_seq_num(count + 1);
+  history.Add(message, message_info);
+  messages.clear();
+  history.GetCachedMessage(&messages);
+  ASSERT_EQ(1, messages.size());
+  EXPECT_EQ(count + 1, messages[0].msg_info.seq_num());
+}
+
 TEST(ListenerHandlerTest, listener_handler_test) {
   Identity sender_id;
   sender_id.set_data("sender");
@@ -38,6 +38,24 @@ QosProfile QosProfileConf::CreateQosProfile(
   return qos_profile;
 }
 
+QosProfile QosProfileConf::CreateBatchQosProfile(const QosProfile& qos_profile,
+                                                 uint32_t window_us,
+                                                 uint32_t max_bytes) {
+  QosProfile batch_qos_profile(qos_profile);
+  batch_qos_profile.set_batch_window_us(window_us);
+  batch_qos_profile.set_batch_max_bytes(max_bytes);
+
+  return batch_qos_profile;
+}
+
+QosProfile QosProfileConf::CreateStreamQosProfile(
+    const QosProfile& qos_profile) {
+  QosProfile stream_qos_profile(qos_profile);
+  stream_qos_profile.set_diff_host_stream(true);
+
+  return stream_qos_profile;
+}
+
 const uint32_t QosProfileConf::QOS_HISTORY_DEPTH_SYSTEM_DEFAULT = 0;
 const uint32_t QosProfileConf::QOS_MPS_SYSTEM_DEFAULT = 0;
 
@@ -77,11 +95,21 @@ const QosProfile QosProfileConf::QOS_PROFILE_TF_STATIC = CreateQosProfile(
     QosReliabilityPolicy::RELIABILITY_RELIABLE,
     QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL);
 
+// discovery announces deltas plus snapshots on request, a late joiner only
+// needs the last few batches to find whether it must ask for a snapshot
 const QosProfile QosProfileConf::QOS_PROFILE_TOPO_CHANGE = CreateQosProfile(
-    QosHistoryPolicy::HISTORY_KEEP_ALL, 10, QOS_MPS_SYSTEM_DEFAULT,
+    QosHistoryPolicy::HISTORY_KEEP_LAST, 10, QOS_MPS_SYSTEM_DEFAULT,
     QosReliabilityPolicy::RELIABILITY_RELIABLE,
     QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL);
 
+// small high rate messages crossing hosts, e.g. chassis or localization
+const QosProfile QosProfileConf::QOS_PROFILE_BATCHED =
+    CreateBatchQosProfile(QOS_PROFILE_SENSOR_DATA, 1000, 16384);
+
+// large messages crossing hosts, e.g. point clouds or images
+const QosProfile QosProfileConf::QOS_PROFILE_STREAMED =
+    CreateStreamQosProfile(QOS_PROFILE_SENSOR_DATA);
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
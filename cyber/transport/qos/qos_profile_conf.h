@@ -39,6 +39,10 @@ class QosProfileConf {
                                      uint32_t depth, uint32_t mps,
                                      const QosReliabilityPolicy& reliability,
                                      const QosDurabilityPolicy& durability);
+  static QosProfile CreateBatchQosProfile(const QosProfile& qos_profile,
+                                          uint32_t window_us,
+                                          uint32_t max_bytes);
+  static QosProfile CreateStreamQosProfile(const QosProfile& qos_profile);
 
   static const uint32_t QOS_HISTORY_DEPTH_SYSTEM_DEFAULT;
   static const uint32_t QOS_MPS_SYSTEM_DEFAULT;
@@ -51,6 +55,8 @@ class QosProfileConf {
   static const QosProfile QOS_PROFILE_SYSTEM_DEFAULT;
   static const QosProfile QOS_PROFILE_TF_STATIC;
   static const QosProfile QOS_PROFILE_TOPO_CHANGE;
+  static const QosProfile QOS_PROFILE_BATCHED;
+  static const QosProfile QOS_PROFILE_STREAMED;
 };
 
 }  // namespace transport
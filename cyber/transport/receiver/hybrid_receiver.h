@@ -35,6 +35,7 @@
 #include "cyber/transport/receiver/intra_receiver.h"
 #include "cyber/transport/receiver/rtps_receiver.h"
 #include "cyber/transport/receiver/shm_receiver.h"
+#include "cyber/transport/receiver/stream_receiver.h"
 #include "cyber/transport/rtps/participant.h"
 
 namespace apollo {
@@ -82,6 +83,7 @@ class HybridReceiver : public Receiver<M> {
   void ReceiveHistoryMsg(const RoleAttributes& opposite_attr);
   void ThreadFunc(const RoleAttributes& opposite_attr);
   Relation GetRelation(const RoleAttributes& opposite_attr);
+  OptionalMode GetMode(Relation relation, const RoleAttributes& opposite_attr);
 
   HistoryPtr history_;
   ReceiverContainer receivers_;
@@ -137,11 +139,11 @@ void HybridReceiver<M>::Enable(const RoleAttributes& opposite_attr) {
   RETURN_IF(relation == NO_RELATION);
 
   uint64_t id = opposite_attr.id();
+  auto mode = GetMode(relation, opposite_attr);
   std::lock_guard<std::mutex> lock(mutex_);
-  if (transmitters_[mapping_table_[relation]].count(id) == 0) {
-    transmitters_[mapping_table_[relation]].insert(
-        std::make_pair(id, opposite_attr));
-    receivers_[mapping_table_[relation]]->Enable(opposite_attr);
+  if (transmitters_[mode].count(id) == 0) {
+    transmitters_[mode].insert(std::make_pair(id, opposite_attr));
+    receivers_[mode]->Enable(opposite_attr);
     ReceiveHistoryMsg(opposite_attr);
   }
 }
@@ -152,10 +154,11 @@ void HybridReceiver<M>::Disable(const RoleAttributes& opposite_attr) {
   RETURN_IF(relation == NO_RELATION);
 
   uint64_t id = opposite_attr.id();
+  auto mode = GetMode(relation, opposite_attr);
   std::lock_guard<std::mutex> lock(mutex_);
-  if (transmitters_[mapping_table_[relation]].count(id) > 0) {
-    transmitters_[mapping_table_[relation]].erase(id);
-    receivers_[mapping_table_[relation]]->Disable(opposite_attr);
+  if (transmitters_[mode].count(id) > 0) {
+    transmitters_[mode].erase(id);
+    receivers_[mode]->Disable(opposite_attr);
   }
 }
 
@@ -200,6 +203,8 @@ void HybridReceiver<M>::InitReceivers() {
   modes.insert(mode_->same_proc());
   modes.insert(mode_->diff_proc());
   modes.insert(mode_->diff_host());
+  // any writer on another host may serve this reader over its stream
+  modes.insert(OptionalMode::STREAM);
   auto listener = std::bind(&HybridReceiver<M>::OnNewMessage, this,
                             std::placeholders::_1, std::placeholders::_2);
   for (auto& mode : modes) {
@@ -212,6 +217,10 @@ void HybridReceiver<M>::InitReceivers() {
         receivers_[mode] =
             std::make_shared<ShmReceiver<M>>(this->attr_, listener);
         break;
+      case OptionalMode::STREAM:
+        receivers_[mode] =
+            std::make_shared<StreamReceiver<M>>(this->attr_, listener);
+        break;
       default:
         receivers_[mode] =
             std::make_shared<RtpsReceiver<M>>(this->attr_, listener);
@@ -304,6 +313,16 @@ Relation HybridReceiver<M>::GetRelation(const RoleAttributes& opposite_attr) {
   return SAME_PROC;
 }
 
+template <typename M>
+OptionalMode HybridReceiver<M>::GetMode(Relation relation,
+                                        const RoleAttributes& opposite_attr) {
+  // the writer decides, it announces an address when it serves a stream
+  if (relation == DIFF_HOST && opposite_attr.has_socket_addr()) {
+    return OptionalMode::STREAM;
+  }
+  return mapping_table_[relation];
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
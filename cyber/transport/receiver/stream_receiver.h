@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RECEIVER_STREAM_RECEIVER_H_
+#define CYBER_TRANSPORT_RECEIVER_STREAM_RECEIVER_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/message/message_pool.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/receiver/receiver.h"
+#include "cyber/transport/stream/stream_client.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Receives from the StreamTransmitters of writers on other hosts, with one
+// StreamClient per writer connecting to the socket_addr it announced.
+template <typename M>
+class StreamReceiver : public Receiver<M> {
+ public:
+  StreamReceiver(const RoleAttributes& attr,
+                 const typename Receiver<M>::MessageListener& msg_listener);
+  virtual ~StreamReceiver();
+
+  void Enable() override;
+  void Disable() override;
+
+  void Enable(const RoleAttributes& opposite_attr) override;
+  void Disable(const RoleAttributes& opposite_attr) override;
+
+ private:
+  void OnPayload(const std::string& payload, const MessageInfo& msg_info);
+
+  typename message::MessagePoolManager<M>::PoolPtr pool_;
+  std::mutex mutex_;
+  // key: id of the writer
+  std::unordered_map<uint64_t, std::unique_ptr<StreamClient>> clients_;
+};
+
+template <typename M>
+StreamReceiver<M>::StreamReceiver(
+    const RoleAttributes& attr,
+    const typename Receiver<M>::MessageListener& msg_listener)
+    : Receiver<M>(attr, msg_listener) {
+  pool_ = message::MessagePoolManager<M>::Instance()->GetPool(
+      attr.channel_id());
+}
+
+template <typename M>
+StreamReceiver<M>::~StreamReceiver() {
+  Disable();
+}
+
+template <typename M>
+void StreamReceiver<M>::Enable() {
+  this->enabled_ = true;
+}
+
+template <typename M>
+void StreamReceiver<M>::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  clients_.clear();
+  this->enabled_ = false;
+}
+
+template <typename M>
+void StreamReceiver<M>::Enable(const RoleAttributes& opposite_attr) {
+  if (!opposite_attr.has_socket_addr()) {
+    AERROR << "writer of " << opposite_attr.channel_name()
+           << " has no stream address.";
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& client = clients_[opposite_attr.id()];
+  if (client != nullptr) {
+    return;
+  }
+  client.reset(new StreamClient(
+      opposite_attr.socket_addr().ip(),
+      static_cast<uint16_t>(opposite_attr.socket_addr().port()),
+      std::bind(&StreamReceiver<M>::OnPayload, this, std::placeholders::_1,
+                std::placeholders::_2)));
+  client->Start();
+}
+
+template <typename M>
+void StreamReceiver<M>::Disable(const RoleAttributes& opposite_attr) {
+  std::unique_ptr<StreamClient> client;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(opposite_attr.id());
+    if (it == clients_.end()) {
+      return;
+    }
+    client = std::move(it->second);
+    clients_.erase(it);
+  }
+  // joins the client thread, which may be delivering a message
+  client->Shutdown();
+}
+
+template <typename M>
+void StreamReceiver<M>::OnPayload(const std::string& payload,
+                                  const MessageInfo& msg_info) {
+  auto msg = message::NewMessage<M>(pool_);
+  if (!message::ParseFromString(payload, msg.get())) {
+    AERROR << "fail to parse message of " << this->attr_.channel_name();
+    return;
+  }
+  this->OnNewMessage(msg, msg_info);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RECEIVER_STREAM_RECEIVER_H_
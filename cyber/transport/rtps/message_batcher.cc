@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "cyber/transport/rtps/message_batcher.h"
+
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// entry layout: uint32_t info size | MessageInfo | uint32_t msg size | msg
+static const size_t kMaxEntryHeadSize =
+    2 * sizeof(uint32_t) + MessageInfo::kSize + MessageInfo::kTraceSize;
+
+MessageBatcher::MessageBatcher(uint32_t window_us, uint32_t max_bytes,
+                               const FlushHandler& handler)
+    : window_(window_us), max_bytes_(max_bytes), handler_(handler) {
+  payload_.reserve(max_bytes_);
+  thread_ = std::thread(&MessageBatcher::ThreadFunc, this);
+}
+
+MessageBatcher::~MessageBatcher() { Shutdown(); }
+
+void MessageBatcher::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  FlushLocked();
+}
+
+bool MessageBatcher::Append(const std::string& msg,
+                            const MessageInfo& msg_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool ret = true;
+  uint32_t info_size = static_cast<uint32_t>(msg_info.ByteSize());
+  size_t head_size = 2 * sizeof(uint32_t) + info_size;
+  size_t entry_size = head_size + msg.size();
+  if (msg_num_ > 0 && payload_.size() + entry_size > max_bytes_) {
+    ret = FlushLocked();
+  }
+
+  char head[kMaxEntryHeadSize];
+  std::memcpy(head, &info_size, sizeof(info_size));
+  msg_info.SerializeTo(head + sizeof(info_size), info_size);
+  uint32_t msg_size = static_cast<uint32_t>(msg.size());
+  std::memcpy(head + sizeof(info_size) + info_size, &msg_size,
+              sizeof(msg_size));
+  payload_.append(head, head_size);
+  payload_.append(msg);
+  last_info_ = msg_info;
+
+  if (++msg_num_ == 1) {
+    deadline_ = std::chrono::steady_clock::now() + window_;
+    cv_.notify_one();
+  }
+  if (payload_.size() >= max_bytes_ || is_shutdown_.load()) {
+    ret = FlushLocked() && ret;
+  }
+  return ret;
+}
+
+bool MessageBatcher::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return FlushLocked();
+}
+
+bool MessageBatcher::FlushLocked() {
+  if (msg_num_ == 0) {
+    return true;
+  }
+  ADEBUG << "flush batch of " << msg_num_ << " msgs, " << payload_.size()
+         << " bytes.";
+  bool ret = handler_(payload_, last_info_);
+  payload_.clear();
+  msg_num_ = 0;
+  return ret;
+}
+
+void MessageBatcher::ThreadFunc() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!is_shutdown_.load()) {
+    if (msg_num_ == 0) {
+      cv_.wait(lock,
+               [this]() { return msg_num_ > 0 || is_shutdown_.load(); });
+      continue;
+    }
+    if (std::chrono::steady_clock::now() >= deadline_) {
+      FlushLocked();
+      continue;
+    }
+    cv_.wait_until(lock, deadline_);
+  }
+}
+
+bool MessageBatcher::Unpack(const std::string& payload,
+                            std::vector<Entry>* entries) {
+  RETURN_VAL_IF_NULL(entries, false);
+  const char* ptr = payload.data();
+  size_t left = payload.size();
+  while (left > 0) {
+    uint32_t info_size = 0;
+    if (left >= sizeof(info_size)) {
+      std::memcpy(&info_size, ptr, sizeof(info_size));
+    }
+    size_t head_size = 2 * sizeof(uint32_t) + info_size;
+    if (left < head_size) {
+      AERROR << "truncated batch entry head.";
+      return false;
+    }
+    MessageInfo msg_info;
+    RETURN_VAL_IF(
+        !msg_info.DeserializeFrom(ptr + sizeof(info_size), info_size), false);
+    uint32_t msg_size = 0;
+    std::memcpy(&msg_size, ptr + sizeof(info_size) + info_size,
+                sizeof(msg_size));
+    ptr += head_size;
+    left -= head_size;
+    if (left < msg_size) {
+      AERROR << "truncated batch entry, size: " << msg_size
+             << ", left: " << left;
+      return false;
+    }
+    entries->emplace_back(std::make_shared<std::string>(ptr, msg_size),
+                          msg_info);
+    ptr += msg_size;
+    left -= msg_size;
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef CYBER_TRANSPORT_RTPS_MESSAGE_BATCHER_H_
+#define CYBER_TRANSPORT_RTPS_MESSAGE_BATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Coalesces serialized messages into one RTPS payload. The payload is flushed
+// when batch_window_us has passed since its first message, or when it would
+// grow beyond batch_max_bytes. Each entry keeps its own MessageInfo, so the
+// receiving side can split the payload back out in order.
+class MessageBatcher {
+ public:
+  using FlushHandler = std::function<bool(const std::string& payload,
+                                          const MessageInfo& last_info)>;
+  using Entry = std::pair<std::shared_ptr<std::string>, MessageInfo>;
+
+  MessageBatcher(uint32_t window_us, uint32_t max_bytes,
+                 const FlushHandler& handler);
+  virtual ~MessageBatcher();
+
+  bool Append(const std::string& msg, const MessageInfo& msg_info);
+  bool Flush();
+  // flushes what is pending and stops the flush thread
+  void Shutdown();
+
+  static bool Unpack(const std::string& payload, std::vector<Entry>* entries);
+
+  // UnderlayMessage datatype marking a batched payload
+  static const char* DataType() { return "apollo.cyber.batch"; }
+
+ private:
+  bool FlushLocked();
+  void ThreadFunc();
+
+  std::chrono::microseconds window_;
+  uint32_t max_bytes_;
+  FlushHandler handler_;
+
+  std::string payload_;
+  uint32_t msg_num_ = 0;
+  MessageInfo last_info_;
+  std::chrono::steady_clock::time_point deadline_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<bool> is_shutdown_ = {false};
+  std::thread thread_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RTPS_MESSAGE_BATCHER_H_
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rtps/message_batcher.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(MessageBatcherTest, flush_by_size) {
+  std::vector<std::string> payloads;
+  MessageBatcher batcher(
+      1000000, 320,
+      [&payloads](const std::string& payload, const MessageInfo& last_info) {
+        payloads.emplace_back(payload);
+        return true;
+      });
+
+  Identity sender;
+  std::string msg(100, 'a');
+  for (uint64_t i = 0; i < 4; ++i) {
+    EXPECT_TRUE(batcher.Append(msg, MessageInfo(sender, i)));
+  }
+  // two entries fit into 320 bytes
+  ASSERT_EQ(payloads.size(), 1);
+
+  std::vector<MessageBatcher::Entry> entries;
+  EXPECT_TRUE(MessageBatcher::Unpack(payloads[0], &entries));
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(*entries[0].first, msg);
+  EXPECT_EQ(entries[0].second.seq_num(), 0);
+  EXPECT_EQ(entries[1].second.seq_num(), 1);
+  EXPECT_EQ(entries[1].second.sender_id(), sender);
+
+  batcher.Shutdown();
+  ASSERT_EQ(payloads.size(), 2);
+  entries.clear();
+  EXPECT_TRUE(MessageBatcher::Unpack(payloads[1], &entries));
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[1].second.seq_num(), 3);
+}
+
+TEST(MessageBatcherTest, flush_by_window) {
+  std::mutex mutex;
+  std::vector<std::string> payloads;
+  MessageBatcher batcher(
+      1000, 65536,
+      [&](const std::string& payload, const MessageInfo& last_info) {
+        std::lock_guard<std::mutex> lock(mutex);
+        payloads.emplace_back(payload);
+        return true;
+      });
+
+  Identity sender;
+  EXPECT_TRUE(batcher.Append("first", MessageInfo(sender, 1)));
+  EXPECT_TRUE(batcher.Append("second", MessageInfo(sender, 2)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(payloads.size(), 1);
+  std::vector<MessageBatcher::Entry> entries;
+  EXPECT_TRUE(MessageBatcher::Unpack(payloads[0], &entries));
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(*entries[0].first, "first");
+  EXPECT_EQ(*entries[1].first, "second");
+}
+
+TEST(MessageBatcherTest, unpack_truncated) {
+  std::string payload;
+  MessageBatcher batcher(
+      1000000, 65536,
+      [&payload](const std::string& data, const MessageInfo& last_info) {
+        payload = data;
+        return true;
+      });
+  EXPECT_TRUE(batcher.Append("message", MessageInfo()));
+  EXPECT_TRUE(batcher.Flush());
+
+  std::vector<MessageBatcher::Entry> entries;
+  EXPECT_FALSE(MessageBatcher::Unpack(payload.substr(0, 10), &entries));
+  EXPECT_FALSE(
+      MessageBatcher::Unpack(payload.substr(0, payload.size() - 1), &entries));
+  EXPECT_FALSE(MessageBatcher::Unpack(payload, nullptr));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -56,6 +56,21 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       ((int64_t)m_info.related_sample_identity.sequence_number().high) << 32 |
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
+  msg_info_.set_send_time(0);
+
+  if (m.datatype() == MessageBatcher::DataType()) {
+    std::vector<MessageBatcher::Entry> entries;
+    RETURN_IF(!MessageBatcher::Unpack(m.data(), &entries));
+    for (auto& entry : entries) {
+      callback_(channel_id, entry.first, entry.second);
+    }
+    return;
+  }
+
+  const std::string trace_tag(TraceDataType());
+  if (m.datatype().compare(0, trace_tag.size(), trace_tag) == 0) {
+    msg_info_.TraceFromString(m.datatype().substr(trace_tag.size()));
+  }
 
   // fetch message string
   std::shared_ptr<std::string> msg_str =
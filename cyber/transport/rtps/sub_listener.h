@@ -22,8 +22,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/rtps/message_batcher.h"
 #include "cyber/transport/rtps/underlay_message.h"
 #include "cyber/transport/rtps/underlay_message_type.h"
 #include "fastrtps/Domain.h"
@@ -47,6 +49,10 @@ class SubListener : public eprosima::fastrtps::SubscriberListener {
   explicit SubListener(const NewMsgCallback& callback);
   virtual ~SubListener();
 
+  // Data type of a message sent with hop timestamps, which follow the tag
+  // in the text form of MessageInfo::TraceToString().
+  static const char* TraceDataType() { return "apollo.cyber.trace/"; }
+
   void onNewDataMessage(eprosima::fastrtps::Subscriber* sub);
   void onSubscriptionMatched(eprosima::fastrtps::Subscriber* sub,
                              eprosima::fastrtps::MatchingInfo& info);  // NOLINT
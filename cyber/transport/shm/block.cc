@@ -72,6 +72,20 @@ void Block::ReleaseWriteLock() { lock_num_.fetch_add(1); }
 
 void Block::ReleaseReadLock() { lock_num_.fetch_sub(1); }
 
+void Block::BeginWrite(uint64_t stamp) {
+  stamp_.store(stamp - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void Block::EndWrite(uint64_t stamp) {
+  stamp_.store(stamp, std::memory_order_release);
+}
+
+bool Block::ValidateStamp(uint64_t stamp) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return stamp_.load(std::memory_order_relaxed) == stamp;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -39,6 +39,16 @@ class Block {
     msg_info_size_ = msg_info_size;
   }
 
+  // Seqlock stamp used by the lock-free ring mode of Segment. A block that
+  // carries message `seq` is stamped WrittenStamp(seq) - 1 while being
+  // written and WrittenStamp(seq) once the write completes.
+  uint64_t stamp() const { return stamp_.load(std::memory_order_acquire); }
+  static uint64_t WrittenStamp(uint64_t seq) { return 2 * seq + 2; }
+
+  // Returns true if the block still holds the message stamped `stamp`, i.e.
+  // nothing read from it since the stamp was observed can be torn.
+  bool ValidateStamp(uint64_t stamp) const;
+
   static const int32_t kRWLockFree;
   static const int32_t kWriteExclusive;
   static const int32_t kMaxTryLockTimes;
@@ -49,7 +59,11 @@ class Block {
   void ReleaseWriteLock();
   void ReleaseReadLock();
 
+  void BeginWrite(uint64_t stamp);
+  void EndWrite(uint64_t stamp);
+
   volatile std::atomic<int32_t> lock_num_ = {0};
+  std::atomic<uint64_t> stamp_ = {0};
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
@@ -63,6 +63,7 @@ bool ConditionNotifier::Notify(const ReadableInfo& info) {
     std::unique_lock<std::mutex> lck(indicator_->mtx);
     auto idx = indicator_->written_info_num % kBufLength;
     indicator_->infos[idx] = info;
+    indicator_->infos[idx].set_notify_time(Now());
     ++indicator_->written_info_num;
   }
 
@@ -107,6 +108,7 @@ bool ConditionNotifier::Listen(int timeout_ms, ReadableInfo* info) {
   auto idx = next_listen_num_ % kBufLength;
   *info = indicator_->infos[idx];
   next_listen_num_ += 1;
+  RecordWakeup(*info);
 
   return true;
 }
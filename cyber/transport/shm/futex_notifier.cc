@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <linux/futex.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+namespace {
+
+// the segment is shared between processes, so no FUTEX_PRIVATE_FLAG here
+long FutexCall(std::atomic<uint32_t>* addr, int op, uint32_t val,  // NOLINT
+               const struct timespec* timeout) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), op, val,
+                 timeout, nullptr, 0);
+}
+
+}  // namespace
+
+const uint32_t FutexNotifier::kSlotNum;
+
+FutexNotifier::FutexNotifier() {
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/futex_notifier"));
+  ADEBUG << "futex notifier key: " << key_;
+  shm_size_ = sizeof(Indicator);
+
+  if (!Init()) {
+    AERROR << "fail to init futex notifier.";
+    is_shutdown_.exchange(true);
+    return;
+  }
+  next_listen_num_ = indicator_->reserved_num.load(std::memory_order_acquire);
+}
+
+FutexNotifier::~FutexNotifier() { Shutdown(); }
+
+void FutexNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  indicator_->futex.fetch_add(1);
+  FutexCall(&indicator_->futex, FUTEX_WAKE, INT_MAX, nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Reset();
+}
+
+bool FutexNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  uint64_t num = indicator_->reserved_num.fetch_add(1);
+  Slot& slot = indicator_->slots[num % kSlotNum];
+  slot.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.info = info;
+  slot.info.set_notify_time(Now());
+  slot.seq.store(num + 1, std::memory_order_release);
+
+  Wake();
+  return true;
+}
+
+void FutexNotifier::Wake() {
+  indicator_->futex.fetch_add(1);
+  // writers stay in user space unless somebody is sleeping
+  if (indicator_->waiters.load() > 0) {
+    FutexCall(&indicator_->futex, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+}
+
+bool FutexNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    uint32_t futex_val = indicator_->futex.load();
+    if (TryRead(info)) {
+      RecordWakeup(*info);
+      return true;
+    }
+
+    auto left = deadline - std::chrono::steady_clock::now();
+    if (left <= std::chrono::nanoseconds(0)) {
+      // a slot reserved for a whole timeout means its writer went away
+      if (next_listen_num_ < indicator_->reserved_num.load()) {
+        AWARN << "skip unpublished info: " << next_listen_num_;
+        ++next_listen_num_;
+      }
+      ADEBUG << "timeout";
+      return false;
+    }
+    auto left_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+    struct timespec ts;
+    ts.tv_sec = left_ns / 1000000000;
+    ts.tv_nsec = left_ns % 1000000000;
+
+    indicator_->waiters.fetch_add(1);
+    FutexCall(&indicator_->futex, FUTEX_WAIT, futex_val, &ts);
+    indicator_->waiters.fetch_sub(1);
+  }
+
+  AINFO << "notifier is shutdown.";
+  return false;
+}
+
+bool FutexNotifier::TryRead(ReadableInfo* info) {
+  while (true) {
+    uint64_t reserved_num =
+        indicator_->reserved_num.load(std::memory_order_acquire);
+    if (next_listen_num_ >= reserved_num) {
+      return false;
+    }
+    // lapped by the writers, skip to the oldest slot still in the ring
+    if (reserved_num - next_listen_num_ > kSlotNum) {
+      AWARN << "listener lagged, skip "
+            << reserved_num - kSlotNum - next_listen_num_ << " infos.";
+      next_listen_num_ = reserved_num - kSlotNum;
+    }
+
+    Slot& slot = indicator_->slots[next_listen_num_ % kSlotNum];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq == 0 || seq < next_listen_num_ + 1) {
+      // reserved but not published yet
+      return false;
+    }
+    if (seq == next_listen_num_ + 1) {
+      *info = slot.info;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) == seq) {
+        ++next_listen_num_;
+        return true;
+      }
+    }
+    // overwritten while reading, retry with the new reserved num
+    ++next_listen_num_;
+  }
+}
+
+bool FutexNotifier::Init() { return OpenOrCreate(); }
+
+bool FutexNotifier::OpenOrCreate() {
+  // create managed_shm_
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, shm_size_, 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Reset();
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  // create indicator_
+  indicator_ = new (managed_shm_) Indicator();
+  if (indicator_ == nullptr) {
+    AERROR << "create indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  ADEBUG << "open or create true.";
+  return true;
+}
+
+bool FutexNotifier::OpenOnly() {
+  // get managed_shm_
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed.";
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    return false;
+  }
+
+  // get indicator_
+  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
+  if (indicator_ == nullptr) {
+    AERROR << "get indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  ADEBUG << "open true.";
+  return true;
+}
+
+bool FutexNotifier::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  ADEBUG << "remove success.";
+
+  return true;
+}
+
+void FutexNotifier::Reset() {
+  indicator_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(FutexNotifierTest, notify_and_listen) {
+  auto notifier = FutexNotifier::Instance();
+  ASSERT_NE(notifier, nullptr);
+
+  ReadableInfo info;
+  EXPECT_FALSE(notifier->Listen(10, &info));
+  EXPECT_FALSE(notifier->Listen(10, nullptr));
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_TRUE(notifier->Notify(ReadableInfo(1, i, 2)));
+  }
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_TRUE(notifier->Listen(10, &info));
+    EXPECT_EQ(info.host_id(), 1);
+    EXPECT_EQ(info.block_index(), i);
+    EXPECT_EQ(info.channel_id(), 2);
+    EXPECT_NE(info.notify_time(), 0);
+  }
+  EXPECT_FALSE(notifier->Listen(10, &info));
+  EXPECT_GE(notifier->wakeup_latency().Count(), 3);
+}
+
+TEST(FutexNotifierTest, wake_sleeping_listener) {
+  auto notifier = FutexNotifier::Instance();
+  ReadableInfo info;
+  std::thread notify_thread([notifier]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    notifier->Notify(ReadableInfo(1, 7, 2));
+  });
+  EXPECT_TRUE(notifier->Listen(1000, &info));
+  EXPECT_EQ(info.block_index(), 7);
+  notify_thread.join();
+}
+
+TEST(FutexNotifierTest, lapped_listener) {
+  auto notifier = FutexNotifier::Instance();
+  for (uint32_t i = 0; i < FutexNotifier::kSlotNum + 10; ++i) {
+    EXPECT_TRUE(notifier->Notify(ReadableInfo(1, i, 2)));
+  }
+  ReadableInfo info;
+  EXPECT_TRUE(notifier->Listen(10, &info));
+  EXPECT_EQ(info.block_index(), 10);
+}
+
+TEST(FutexNotifierTest, shutdown) {
+  auto notifier = FutexNotifier::Instance();
+  notifier->Shutdown();
+  ReadableInfo info;
+  EXPECT_FALSE(notifier->Notify(info));
+  EXPECT_FALSE(notifier->Listen(10, &info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
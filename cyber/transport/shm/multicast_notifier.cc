@@ -65,8 +65,10 @@ bool MulticastNotifier::Notify(const ReadableInfo& info) {
     return false;
   }
 
+  ReadableInfo stamped_info(info);
+  stamped_info.set_notify_time(Now());
   std::string info_str;
-  info.SerializeTo(&info_str);
+  stamped_info.SerializeTo(&info_str);
   ssize_t nbytes =
       sendto(notify_fd_, info_str.c_str(), info_str.size(), 0,
              (struct sockaddr*)&notify_addr_, sizeof(notify_addr_));
@@ -94,7 +96,11 @@ bool MulticastNotifier::Listen(int timeout_ms, ReadableInfo* info) {
       AERROR << "fail to recvfrom, " << strerror(errno);
       return false;
     }
-    return info->DeserializeFrom(buf, nbytes);
+    if (!info->DeserializeFrom(buf, nbytes)) {
+      return false;
+    }
+    RecordWakeup(*info);
+    return true;
   } else if (ready_num == 0) {
     ADEBUG << "timeout, no readableinfo.";
   } else {
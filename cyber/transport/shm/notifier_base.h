@@ -17,8 +17,10 @@
 #ifndef CYBER_TRANSPORT_SHM_NOTIFIER_BASE_H_
 #define CYBER_TRANSPORT_SHM_NOTIFIER_BASE_H_
 
+#include <chrono>
 #include <memory>
 
+#include "cyber/base/histogram.h"
 #include "cyber/transport/shm/readable_info.h"
 
 namespace apollo {
@@ -35,6 +37,25 @@ class NotifierBase {
   virtual void Shutdown() = 0;
   virtual bool Notify(const ReadableInfo& info) = 0;
   virtual bool Listen(int timeout_ms, ReadableInfo* info) = 0;
+
+  // Latency from Notify() to the matching Listen() returning, in ns.
+  const base::Histogram& wakeup_latency() const { return wakeup_latency_; }
+
+ protected:
+  static uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void RecordWakeup(const ReadableInfo& info) {
+    uint64_t now = Now();
+    if (info.notify_time() != 0 && now >= info.notify_time()) {
+      wakeup_latency_.Record(now - info.notify_time());
+    }
+  }
+
+  base::Histogram wakeup_latency_;
 };
 
 }  // namespace transport
@@ -21,6 +21,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/shm/futex_notifier.h"
 #include "cyber/transport/shm/multicast_notifier.h"
 
 namespace apollo {
@@ -43,6 +44,8 @@ auto NotifierFactory::CreateNotifier() -> NotifierPtr {
     return CreateMulticastNotifier();
   } else if (notifier_type == ConditionNotifier::Type()) {
     return CreateConditionNotifier();
+  } else if (notifier_type == FutexNotifier::Type()) {
+    return CreateFutexNotifier();
   }
 
   AINFO << "unknown notifier, we use default notifier: " << notifier_type;
@@ -53,6 +56,10 @@ auto NotifierFactory::CreateConditionNotifier() -> NotifierPtr {
   return ConditionNotifier::Instance();
 }
 
+auto NotifierFactory::CreateFutexNotifier() -> NotifierPtr {
+  return FutexNotifier::Instance();
+}
+
 auto NotifierFactory::CreateMulticastNotifier() -> NotifierPtr {
   return MulticastNotifier::Instance();
 }
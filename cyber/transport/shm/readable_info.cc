@@ -24,13 +24,17 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
-const size_t ReadableInfo::kSize = sizeof(uint64_t) * 2 + sizeof(uint32_t);
+const size_t ReadableInfo::kSize = sizeof(uint64_t) * 3 + sizeof(uint32_t);
 
-ReadableInfo::ReadableInfo() : host_id_(0), block_index_(0), channel_id_(0) {}
+ReadableInfo::ReadableInfo()
+    : host_id_(0), block_index_(0), channel_id_(0), notify_time_(0) {}
 
 ReadableInfo::ReadableInfo(uint64_t host_id, uint32_t block_index,
                            uint64_t channel_id)
-    : host_id_(host_id), block_index_(block_index), channel_id_(channel_id) {}
+    : host_id_(host_id),
+      block_index_(block_index),
+      channel_id_(channel_id),
+      notify_time_(0) {}
 
 ReadableInfo::~ReadableInfo() {}
 
@@ -39,6 +43,7 @@ ReadableInfo& ReadableInfo::operator=(const ReadableInfo& other) {
     this->host_id_ = other.host_id_;
     this->block_index_ = other.block_index_;
     this->channel_id_ = other.channel_id_;
+    this->notify_time_ = other.notify_time_;
   }
   return *this;
 }
@@ -52,6 +57,8 @@ bool ReadableInfo::SerializeTo(std::string* dst) const {
               sizeof(block_index_));
   dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&channel_id_)),
               sizeof(channel_id_));
+  dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&notify_time_)),
+              sizeof(notify_time_));
   return true;
 }
 
@@ -72,6 +79,8 @@ bool ReadableInfo::DeserializeFrom(const char* src, std::size_t len) {
   memcpy(reinterpret_cast<char*>(&block_index_), ptr, sizeof(block_index_));
   ptr += sizeof(block_index_);
   memcpy(reinterpret_cast<char*>(&channel_id_), ptr, sizeof(channel_id_));
+  ptr += sizeof(channel_id_);
+  memcpy(reinterpret_cast<char*>(&notify_time_), ptr, sizeof(notify_time_));
 
   return true;
 }
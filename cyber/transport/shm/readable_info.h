@@ -50,12 +50,17 @@ class ReadableInfo {
   uint64_t channel_id() const { return channel_id_; }
   void set_channel_id(uint64_t channel_id) { channel_id_ = channel_id; }
 
+  // steady clock time of the notification, in nanoseconds
+  uint64_t notify_time() const { return notify_time_; }
+  void set_notify_time(uint64_t notify_time) { notify_time_ = notify_time; }
+
   static const size_t kSize;
 
  private:
   uint64_t host_id_;
   uint32_t block_index_;
   uint64_t channel_id_;
+  uint64_t notify_time_;
 };
 
 }  // namespace transport
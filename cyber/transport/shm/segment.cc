@@ -17,8 +17,10 @@
 #include "cyber/transport/shm/segment.h"
 
 #include <algorithm>
+#include <thread>
 
 #include "cyber/common/log.h"
+#include "cyber/common/numa.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
 
@@ -26,15 +28,23 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+const uint64_t Segment::kInvalidSeq = UINT64_MAX;
+
 Segment::Segment(uint64_t channel_id, const ReadWriteMode& mode)
+    : Segment(channel_id, mode, ShmConf::RingModeEnabled()) {}
+
+Segment::Segment(uint64_t channel_id, const ReadWriteMode& mode,
+                 bool ring_mode)
     : init_(false),
       mode_(mode),
+      ring_mode_(ring_mode),
       conf_(),
       state_(nullptr),
       blocks_(nullptr),
       managed_shm_(nullptr),
       block_buf_lock_(),
-      block_buf_addrs_() {
+      block_buf_addrs_(),
+      pools_lock_() {
   id_ = static_cast<key_t>(channel_id);
 }
 
@@ -53,9 +63,15 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     result = Remap();
   }
 
-  if (msg_size > conf_.ceiling_msg_size()) {
-    conf_.Update(msg_size);
-    result = Recreate();
+  uint32_t pool = 0;
+  if (result && msg_size > conf_.ceiling_msg_size()) {
+    if (ring_mode_) {
+      // ring slots must fit any message, so the whole ring is resized
+      conf_.Update(msg_size);
+      result = Recreate();
+    } else {
+      result = AcquireBlockPool(msg_size, &pool);
+    }
   }
 
   if (!result) {
@@ -63,19 +79,26 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  uint32_t index = GetNextWritableBlockIndex();
+  uint32_t index = 0;
+  if (ring_mode_) {
+    index = GetNextRingBlockIndex(&writable_block->stamp);
+  } else {
+    index = GetNextWritableBlockIndex(pool);
+  }
   writable_block->index = index;
-  writable_block->block = &blocks_[index];
-  writable_block->buf = block_buf_addrs_[index];
-  return true;
+  return LocateBlock(index, &writable_block->block, &writable_block->buf);
 }
 
 void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
-  auto index = writable_block.index;
-  if (index >= conf_.block_num()) {
+  Block* block = nullptr;
+  uint8_t* buf = nullptr;
+  if (!LocateBlock(writable_block.index, &block, &buf)) {
     return;
   }
-  blocks_[index].ReleaseWriteLock();
+  if (writable_block.stamp != 0) {
+    block->EndWrite(writable_block.stamp);
+  }
+  block->ReleaseWriteLock();
 }
 
 bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
@@ -86,7 +109,8 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     return false;
   }
   auto index = readable_block->index;
-  if (index >= conf_.block_num()) {
+  uint32_t pool = index >> kBlockPoolShift;
+  if (pool >= State::kMaxBlockPools) {
     AERROR << "invalid block_index[" << index << "].";
     return false;
   }
@@ -96,25 +120,113 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     result = Remap();
   }
 
+  if (result && pool != 0) {
+    result = AttachBlockPool(pool);
+  }
+
   if (!result) {
     AERROR << "segment update failed.";
     return false;
   }
 
-  if (!blocks_[index].TryLockForRead()) {
+  Block* block = nullptr;
+  uint8_t* buf = nullptr;
+  if (!LocateBlock(index, &block, &buf)) {
+    AERROR << "invalid block_index[" << index << "].";
+    return false;
+  }
+
+  if (!block->TryLockForRead()) {
     return false;
   }
-  readable_block->block = blocks_ + index;
-  readable_block->buf = block_buf_addrs_[index];
+  readable_block->block = block;
+  readable_block->buf = buf;
   return true;
 }
 
 void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
-  auto index = readable_block.index;
-  if (index >= conf_.block_num()) {
+  Block* block = nullptr;
+  uint8_t* buf = nullptr;
+  if (!LocateBlock(readable_block.index, &block, &buf)) {
     return;
   }
-  blocks_[index].ReleaseReadLock();
+  block->ReleaseReadLock();
+}
+
+bool Segment::AcquireNextBlockToRead(uint64_t* next_seq,
+                                     ReadableBlock* readable_block) {
+  RETURN_VAL_IF_NULL(next_seq, false);
+  RETURN_VAL_IF_NULL(readable_block, false);
+
+  if (!init_) {
+    // readers poll in ring mode, so stay quiet until a writer creates the shm
+    if (shmget(id_, 0, 0644) == -1 || !Init()) {
+      return false;
+    }
+  }
+
+  if (state_->need_remap()) {
+    if (!Remap()) {
+      AERROR << "segment update failed.";
+      return false;
+    }
+    // the writer recreated the segment and restarted its sequence
+    if (*next_seq != kInvalidSeq && *next_seq > state_->seq()) {
+      *next_seq = 0;
+    }
+  }
+
+  uint64_t written_seq = state_->seq();
+  if (*next_seq == kInvalidSeq) {
+    *next_seq = written_seq;
+  }
+
+  uint32_t block_num = conf_.block_num();
+  uint64_t seq = *next_seq;
+  if (written_seq > seq + block_num) {
+    ADEBUG << "reader lapped, skip " << written_seq - block_num - seq
+           << " messages.";
+    seq = written_seq - block_num;
+  }
+
+  for (; seq < written_seq; ++seq) {
+    uint32_t index = static_cast<uint32_t>(seq % block_num);
+    Block* block = blocks_ + index;
+    uint64_t expected_stamp = Block::WrittenStamp(seq);
+    uint64_t stamp = block->stamp();
+    if (stamp < expected_stamp) {
+      // still being written, try again on the next poll
+      break;
+    }
+    if (stamp > expected_stamp) {
+      // already overwritten by a later lap
+      continue;
+    }
+
+    uint64_t msg_size = block->msg_size();
+    uint64_t msg_info_size = block->msg_info_size();
+    if (msg_size + msg_info_size > conf_.block_buf_size() ||
+        !block->ValidateStamp(expected_stamp)) {
+      continue;
+    }
+
+    readable_block->index = index;
+    readable_block->block = block;
+    readable_block->buf = block_buf_addrs_[index];
+    readable_block->stamp = expected_stamp;
+    *next_seq = seq + 1;
+    return true;
+  }
+
+  *next_seq = seq;
+  return false;
+}
+
+bool Segment::ValidateReadBlock(const ReadableBlock& readable_block) {
+  if (readable_block.stamp == 0) {
+    return true;
+  }
+  return readable_block.block->ValidateStamp(readable_block.stamp);
 }
 
 bool Segment::Init() {
@@ -164,6 +276,8 @@ bool Segment::OpenOrCreate() {
     shmctl(shmid, IPC_RMID, 0);
     return false;
   }
+  common::BindMemoryToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                               numa_node_);
 
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
@@ -251,6 +365,8 @@ bool Segment::OpenOnly() {
   }
 
   conf_.Update(state_->ceiling_msg_size());
+  common::BindMemoryToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                               numa_node_);
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -320,6 +436,7 @@ bool Segment::Destroy() {
     state_->DecreaseReferenceCounts();
     uint32_t reference_counts = state_->reference_counts();
     if (reference_counts == 0) {
+      RemoveBlockPools();
       return Remove();
     }
   } catch (...) {
@@ -331,6 +448,7 @@ bool Segment::Destroy() {
 }
 
 void Segment::Reset() {
+  DetachBlockPools();
   state_ = nullptr;
   blocks_ = nullptr;
   {
@@ -346,6 +464,8 @@ void Segment::Reset() {
 
 bool Segment::Remap() {
   init_ = false;
+  ++remap_count_;
+  AINFO << "remap segment, count: " << remap_count_;
   ADEBUG << "before reset.";
   Reset();
   ADEBUG << "after reset.";
@@ -354,30 +474,209 @@ bool Segment::Remap() {
 
 bool Segment::Recreate() {
   init_ = false;
+  ++recreate_count_;
+  AINFO << "recreate segment, ceiling size: " << conf_.ceiling_msg_size()
+        << " count: " << recreate_count_;
   state_->set_need_remap(true);
   Reset();
   Remove();
   return OpenOrCreate();
 }
 
-uint32_t Segment::GetNextWritableBlockIndex() {
+uint32_t Segment::GetNextWritableBlockIndex(uint32_t pool) {
   uint32_t try_idx = state_->wrote_num();
 
-  auto max_mod_num = conf_.block_num() - 1;
+  Block* blocks = blocks_;
+  uint32_t block_num = conf_.block_num();
+  if (pool != 0) {
+    blocks = pools_[pool].blocks;
+    block_num = pools_[pool].conf.block_num();
+  }
+
+  auto max_mod_num = block_num - 1;
   while (1) {
-    if (try_idx >= conf_.block_num()) {
+    if (try_idx >= block_num) {
       try_idx &= max_mod_num;
     }
 
-    if (blocks_[try_idx].TryLockForWrite()) {
+    if (blocks[try_idx].TryLockForWrite()) {
       state_->IncreaseWroteNum();
-      return try_idx;
+      return (pool << kBlockPoolShift) | try_idx;
     }
 
     ++try_idx;
   }
 }
 
+uint32_t Segment::GetNextRingBlockIndex(uint64_t* stamp) {
+  uint64_t seq = state_->FetchAndIncreaseSeq();
+  uint32_t index = static_cast<uint32_t>(seq % conf_.block_num());
+
+  // readers never lock ring blocks, so only a writer lapping us can hold it
+  while (!blocks_[index].TryLockForWrite()) {
+    std::this_thread::yield();
+  }
+  *stamp = Block::WrittenStamp(seq);
+  blocks_[index].BeginWrite(*stamp);
+  return index;
+}
+
+bool Segment::LocateBlock(uint32_t index, Block** block, uint8_t** buf) {
+  uint32_t pool = index >> kBlockPoolShift;
+  uint32_t block_index = index & kBlockIndexMask;
+  if (pool == 0) {
+    if (block_index >= conf_.block_num()) {
+      return false;
+    }
+    *block = blocks_ + block_index;
+    *buf = block_buf_addrs_[block_index];
+    return true;
+  }
+
+  if (pool >= State::kMaxBlockPools || !pools_[pool].attached.load() ||
+      block_index >= pools_[pool].conf.block_num()) {
+    return false;
+  }
+  *block = pools_[pool].blocks + block_index;
+  *buf = pools_[pool].bufs + block_index * pools_[pool].conf.block_buf_size();
+  return true;
+}
+
+bool Segment::AcquireBlockPool(std::size_t msg_size, uint32_t* pool) {
+  // slots are claimed in order, pick the smallest pool the message fits in
+  uint32_t fit_pool = 0;
+  uint64_t fit_ceiling = 0;
+  uint32_t i = 1;
+  for (; i < State::kMaxBlockPools; ++i) {
+    uint64_t ceiling = state_->block_pool_ceiling(i);
+    if (ceiling == 0) {
+      break;
+    }
+    if (ceiling >= msg_size && (fit_pool == 0 || ceiling < fit_ceiling)) {
+      fit_pool = i;
+      fit_ceiling = ceiling;
+    }
+  }
+
+  // grow online: add a pool of a larger size class next to the existing ones
+  ShmConf pool_conf(msg_size);
+  if (fit_pool == 0 && pool_conf.ceiling_msg_size() < msg_size) {
+    AERROR << "msg size " << msg_size << " exceeds the largest size class.";
+    return false;
+  }
+  for (; fit_pool == 0 && i < State::kMaxBlockPools; ++i) {
+    if (state_->ClaimBlockPool(i, pool_conf.ceiling_msg_size())) {
+      fit_pool = i;
+      ++grow_count_;
+      AINFO << "add block pool " << i
+            << ", ceiling size: " << pool_conf.ceiling_msg_size()
+            << " grow count: " << grow_count_;
+    } else if (state_->block_pool_ceiling(i) >= msg_size) {
+      // another writer claimed the slot for a large enough pool first
+      fit_pool = i;
+    }
+  }
+
+  if (fit_pool == 0) {
+    AERROR << "no block pool left for msg size: " << msg_size;
+    return false;
+  }
+
+  *pool = fit_pool;
+  return AttachBlockPool(fit_pool);
+}
+
+bool Segment::AttachBlockPool(uint32_t pool) {
+  if (pools_[pool].attached.load()) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> _g(pools_lock_);
+  if (pools_[pool].attached.load()) {
+    return true;
+  }
+
+  uint64_t ceiling = state_->block_pool_ceiling(pool);
+  if (ceiling == 0) {
+    AERROR << "block pool " << pool << " does not exist.";
+    return false;
+  }
+
+  // pool shm starts zero-filled, which is a valid unlocked state for blocks,
+  // so whichever process gets here first creates it
+  BlockPool& block_pool = pools_[pool];
+  block_pool.conf.Update(ceiling);
+  key_t key = GetBlockPoolKey(pool);
+  auto shm_size = block_pool.conf.managed_shm_size();
+  bool created = true;
+  int shmid = shmget(key, shm_size, 0644 | IPC_CREAT | IPC_EXCL);
+  if (shmid == -1 && errno == EEXIST) {
+    created = false;
+    shmid = shmget(key, 0, 0644);
+    struct shmid_ds shm_stat;
+    if (shmid != -1 && shmctl(shmid, IPC_STAT, &shm_stat) == 0 &&
+        shm_stat.shm_segsz < shm_size) {
+      AINFO << "stale block pool " << pool << ", recreate.";
+      shmctl(shmid, IPC_RMID, 0);
+      created = true;
+      shmid = shmget(key, shm_size, 0644 | IPC_CREAT | IPC_EXCL);
+    }
+  }
+  if (shmid == -1) {
+    AERROR << "get block pool shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  void* shm = shmat(shmid, nullptr, 0);
+  if (shm == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach block pool shm failed.";
+    return false;
+  }
+  common::BindMemoryToNumaNode(shm, shm_size, numa_node_);
+
+  uint32_t block_num = block_pool.conf.block_num();
+  if (created) {
+    block_pool.blocks = new (shm) Block[block_num];
+  } else {
+    block_pool.blocks = reinterpret_cast<Block*>(shm);
+  }
+  block_pool.shm = shm;
+  block_pool.bufs = static_cast<uint8_t*>(shm) + block_num * sizeof(Block);
+  block_pool.attached.store(true);
+  return true;
+}
+
+void Segment::DetachBlockPools() {
+  std::lock_guard<std::mutex> _g(pools_lock_);
+  for (uint32_t i = 1; i < State::kMaxBlockPools; ++i) {
+    BlockPool& block_pool = pools_[i];
+    if (!block_pool.attached.exchange(false)) {
+      continue;
+    }
+    shmdt(block_pool.shm);
+    block_pool.shm = nullptr;
+    block_pool.blocks = nullptr;
+    block_pool.bufs = nullptr;
+  }
+}
+
+void Segment::RemoveBlockPools() {
+  for (uint32_t i = 1; i < State::kMaxBlockPools; ++i) {
+    if (state_->block_pool_ceiling(i) == 0) {
+      break;
+    }
+    int shmid = shmget(GetBlockPoolKey(i), 0, 0644);
+    if (shmid != -1) {
+      shmctl(shmid, IPC_RMID, 0);
+    }
+  }
+}
+
+key_t Segment::GetBlockPoolKey(uint32_t pool) const {
+  return static_cast<key_t>(
+      common::Hash(std::to_string(id_) + "_pool_" + std::to_string(pool)));
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #include <sys/shm.h>
 #include <sys/types.h>
 #include <cstddef>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -47,12 +48,15 @@ struct WritableBlock {
   uint32_t index = 0;
   Block* block = nullptr;
   uint8_t* buf = nullptr;
+  // Ring mode only: the block's completed stamp, 0 for locked segments.
+  uint64_t stamp = 0;
 };
 using ReadableBlock = WritableBlock;
 
 class Segment final {
  public:
   Segment(uint64_t channel_id, const ReadWriteMode& mode);
+  Segment(uint64_t channel_id, const ReadWriteMode& mode, bool ring_mode);
   ~Segment();
 
   bool AcquireBlockToWrite(std::size_t msg_size, WritableBlock* writable_block);
@@ -61,6 +65,33 @@ class Segment final {
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  // Ring mode reader interface. Fetches the oldest completed message at or
+  // after `*next_seq` without taking any lock, skipping messages that were
+  // overwritten, and advances `*next_seq` past it. Pass kInvalidSeq to start
+  // from the newest message. The caller must check ValidateReadBlock() after
+  // consuming the payload, since the writer may lap the reader meanwhile.
+  bool AcquireNextBlockToRead(uint64_t* next_seq,
+                              ReadableBlock* readable_block);
+  static bool ValidateReadBlock(const ReadableBlock& readable_block);
+
+  bool ring_mode() const { return ring_mode_; }
+
+  // Numa node the shm should prefer for pages faulted after attaching, set
+  // before the first access. The policy is shared by every process mapping
+  // the shm, so a reader's node also steers pages the writer touches first.
+  void set_numa_node(int node) { numa_node_ = node; }
+
+  // Layout changes seen by this process: remaps after another process
+  // recreated the segment, recreations done here, and block pools added here.
+  uint64_t remap_count() const { return remap_count_; }
+  uint64_t recreate_count() const { return recreate_count_; }
+  uint64_t grow_count() const { return grow_count_; }
+
+  static const uint64_t kInvalidSeq;
+  // The pool of a block is kept in the high bits of its index.
+  static const uint32_t kBlockPoolShift = 24;
+  static const uint32_t kBlockIndexMask = (1U << kBlockPoolShift) - 1;
+
  private:
   bool Init();
   bool OpenOrCreate();
@@ -71,11 +102,32 @@ class Segment final {
   bool Remap();
   bool Recreate();
 
-  uint32_t GetNextWritableBlockIndex();
+  uint32_t GetNextWritableBlockIndex(uint32_t pool);
+  uint32_t GetNextRingBlockIndex(uint64_t* stamp);
+
+  // Messages larger than the segment's ceiling go to extension block pools,
+  // each in its own shm, which are added on demand instead of recreating the
+  // segment and stalling its readers.
+  struct BlockPool {
+    std::atomic<bool> attached = {false};
+    ShmConf conf;
+    void* shm = nullptr;
+    Block* blocks = nullptr;
+    uint8_t* bufs = nullptr;
+  };
+
+  bool LocateBlock(uint32_t index, Block** block, uint8_t** buf);
+  bool AcquireBlockPool(std::size_t msg_size, uint32_t* pool);
+  bool AttachBlockPool(uint32_t pool);
+  void DetachBlockPools();
+  void RemoveBlockPools();
+  key_t GetBlockPoolKey(uint32_t pool) const;
 
   bool init_;
   key_t id_;
   ReadWriteMode mode_;
+  bool ring_mode_;
+  int numa_node_ = -1;
   ShmConf conf_;
 
   State* state_;
@@ -83,6 +135,13 @@ class Segment final {
   void* managed_shm_;
   std::mutex block_buf_lock_;
   std::unordered_map<uint32_t, uint8_t*> block_buf_addrs_;
+  // pools_[0] stays unused, the segment's own blocks form pool 0
+  BlockPool pools_[State::kMaxBlockPools];
+  std::mutex pools_lock_;
+
+  uint64_t remap_count_ = 0;
+  uint64_t recreate_count_ = 0;
+  uint64_t grow_count_ = 0;
 };
 
 }  // namespace transport
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/segment.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+bool WriteString(Segment* segment, const std::string& str) {
+  WritableBlock wb;
+  if (!segment->AcquireBlockToWrite(str.size(), &wb)) {
+    return false;
+  }
+  std::memcpy(wb.buf, str.data(), str.size());
+  wb.block->set_msg_size(str.size());
+  wb.block->set_msg_info_size(0);
+  segment->ReleaseWrittenBlock(wb);
+  return true;
+}
+
+std::string ReadString(const ReadableBlock& rb) {
+  return std::string(reinterpret_cast<const char*>(rb.buf),
+                     rb.block->msg_size());
+}
+
+}  // namespace
+
+TEST(SegmentTest, ring_read_write) {
+  uint64_t channel_id = common::Hash("segment_test_ring_read_write");
+  Segment writer(channel_id, WRITE_ONLY, true);
+  Segment reader(channel_id, READ_ONLY, true);
+  EXPECT_TRUE(writer.ring_mode());
+
+  uint64_t next_seq = Segment::kInvalidSeq;
+  ReadableBlock rb;
+  EXPECT_FALSE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+
+  EXPECT_TRUE(WriteString(&writer, "first"));
+  // a new reader starts from the newest message
+  EXPECT_FALSE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(next_seq, 1);
+
+  EXPECT_TRUE(WriteString(&writer, "second"));
+  EXPECT_TRUE(WriteString(&writer, "third"));
+  EXPECT_TRUE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(ReadString(rb), "second");
+  EXPECT_TRUE(Segment::ValidateReadBlock(rb));
+  EXPECT_TRUE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(ReadString(rb), "third");
+  EXPECT_TRUE(Segment::ValidateReadBlock(rb));
+  EXPECT_FALSE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(next_seq, 3);
+}
+
+TEST(SegmentTest, ring_reader_lapped) {
+  uint64_t channel_id = common::Hash("segment_test_ring_reader_lapped");
+  Segment writer(channel_id, WRITE_ONLY, true);
+  Segment reader(channel_id, READ_ONLY, true);
+
+  EXPECT_TRUE(WriteString(&writer, "0"));
+  uint64_t next_seq = 0;
+  ReadableBlock rb;
+  EXPECT_TRUE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(ReadString(rb), "0");
+
+  // overwrite the block the reader holds, then lap the reader entirely
+  ShmConf conf;
+  for (uint32_t i = 1; i <= conf.block_num() + 2; ++i) {
+    EXPECT_TRUE(WriteString(&writer, std::to_string(i)));
+  }
+  EXPECT_FALSE(Segment::ValidateReadBlock(rb));
+
+  EXPECT_TRUE(reader.AcquireNextBlockToRead(&next_seq, &rb));
+  EXPECT_EQ(ReadString(rb), "3");
+  EXPECT_TRUE(Segment::ValidateReadBlock(rb));
+}
+
+TEST(SegmentTest, locked_read_write) {
+  uint64_t channel_id = common::Hash("segment_test_locked_read_write");
+  Segment writer(channel_id, WRITE_ONLY, false);
+  Segment reader(channel_id, READ_ONLY, false);
+
+  EXPECT_TRUE(WriteString(&writer, "locked"));
+  ReadableBlock rb;
+  rb.index = 0;
+  EXPECT_TRUE(reader.AcquireBlockToRead(&rb));
+  EXPECT_EQ(ReadString(rb), "locked");
+  EXPECT_TRUE(Segment::ValidateReadBlock(rb));
+  reader.ReleaseReadBlock(rb);
+}
+
+TEST(SegmentTest, grow_block_pools) {
+  uint64_t channel_id = common::Hash("segment_test_grow_block_pools");
+  Segment writer(channel_id, WRITE_ONLY, false);
+  Segment reader(channel_id, READ_ONLY, false);
+
+  std::string small_msg(1024, 's');
+  std::string large_msg(64 * 1024, 'l');
+  std::string larger_msg(512 * 1024, 'x');
+
+  WritableBlock wb;
+  EXPECT_TRUE(writer.AcquireBlockToWrite(small_msg.size(), &wb));
+  writer.ReleaseWrittenBlock(wb);
+  EXPECT_EQ(wb.index >> Segment::kBlockPoolShift, 0);
+
+  EXPECT_TRUE(writer.AcquireBlockToWrite(large_msg.size(), &wb));
+  std::memcpy(wb.buf, large_msg.data(), large_msg.size());
+  wb.block->set_msg_size(large_msg.size());
+  writer.ReleaseWrittenBlock(wb);
+  uint32_t large_index = wb.index;
+  EXPECT_EQ(large_index >> Segment::kBlockPoolShift, 1);
+
+  EXPECT_TRUE(writer.AcquireBlockToWrite(larger_msg.size(), &wb));
+  writer.ReleaseWrittenBlock(wb);
+  EXPECT_EQ(wb.index >> Segment::kBlockPoolShift, 2);
+
+  // small messages keep using the segment's own blocks
+  EXPECT_TRUE(writer.AcquireBlockToWrite(small_msg.size(), &wb));
+  writer.ReleaseWrittenBlock(wb);
+  EXPECT_EQ(wb.index >> Segment::kBlockPoolShift, 0);
+
+  EXPECT_EQ(writer.grow_count(), 2);
+  EXPECT_EQ(writer.recreate_count(), 0);
+
+  ReadableBlock rb;
+  rb.index = large_index;
+  EXPECT_TRUE(reader.AcquireBlockToRead(&rb));
+  EXPECT_EQ(ReadString(rb), large_msg);
+  reader.ReleaseReadBlock(rb);
+  EXPECT_EQ(reader.remap_count(), 0);
+
+  rb.index = (3 << Segment::kBlockPoolShift);
+  EXPECT_FALSE(reader.AcquireBlockToRead(&rb));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include "cyber/transport/shm/shm_conf.h"
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -108,6 +109,13 @@ uint32_t ShmConf::GetBlockNum(const uint64_t& ceiling_msg_size) {
   return num;
 }
 
+bool ShmConf::RingModeEnabled() {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  return g_conf.has_transport_conf() &&
+         g_conf.transport_conf().has_shm_conf() &&
+         g_conf.transport_conf().shm_conf().ring_mode();
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -37,6 +37,9 @@ class ShmConf {
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
 
+  // Whether shm_conf in the global config selects lock-free ring segments.
+  static bool RingModeEnabled();
+
  private:
   uint64_t GetCeilingMessageSize(const uint64_t& real_msg_size);
   uint64_t GetBlockBufSize(const uint64_t& ceiling_msg_size);
@@ -20,8 +20,15 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+const uint32_t State::kMaxBlockPools;
+
 State::State(const uint64_t& ceiling_msg_size)
-    : ceiling_msg_size_(ceiling_msg_size) {}
+    : ceiling_msg_size_(ceiling_msg_size) {
+  pool_ceilings_[0].store(ceiling_msg_size);
+  for (uint32_t i = 1; i < kMaxBlockPools; ++i) {
+    pool_ceilings_[i].store(0);
+  }
+}
 
 State::~State() {}
 
@@ -31,10 +31,13 @@ class State {
   explicit State(const uint64_t& ceiling_msg_size);
   virtual ~State();
 
-
   void IncreaseWroteNum() { wrote_num_.fetch_add(1); }
   void ResetWroteNum() { wrote_num_.store(0); }
 
+  // Ring mode: reserve the next message sequence number for a writer.
+  uint64_t FetchAndIncreaseSeq() { return seq_.fetch_add(1); }
+  uint64_t seq() { return seq_.load(); }
+
   void DecreaseReferenceCounts() {
     uint32_t current_reference_count = reference_count_.load();
     do {
@@ -50,15 +53,32 @@ class State {
   void set_need_remap(bool need) { need_remap_.store(need); }
   bool need_remap() { return need_remap_; }
 
+  // Extension block pools that let a segment grow to larger size classes
+  // without being recreated. Slot 0 is the segment's own block pool, a
+  // claimed slot holds the ceiling message size of its pool.
+  bool ClaimBlockPool(uint32_t pool, uint64_t ceiling_msg_size) {
+    uint64_t unclaimed = 0;
+    return pool < kMaxBlockPools &&
+           pool_ceilings_[pool].compare_exchange_strong(unclaimed,
+                                                        ceiling_msg_size);
+  }
+  uint64_t block_pool_ceiling(uint32_t pool) {
+    return pool < kMaxBlockPools ? pool_ceilings_[pool].load() : 0;
+  }
+
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
   uint32_t wrote_num() { return wrote_num_.load(); }
 
+  static const uint32_t kMaxBlockPools = 8;
+
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> wrote_num_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
+  std::atomic<uint64_t> seq_ = {0};
+  std::atomic<uint64_t> pool_ceilings_[kMaxBlockPools];
 };
 
 }  // namespace transport
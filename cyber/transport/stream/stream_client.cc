@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/stream/stream_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/stream/stream_frame.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+// how long to wait before connecting again
+const auto kReconnectInterval = std::chrono::milliseconds(100);
+}  // namespace
+
+StreamClient::StreamClient(const std::string& ip, uint16_t port,
+                           const MessageHandler& handler)
+    : ip_(ip), port_(port), handler_(handler) {}
+
+StreamClient::~StreamClient() { Shutdown(); }
+
+void StreamClient::Start() {
+  if (!is_shutdown_.exchange(false)) {
+    return;
+  }
+  thread_ = std::thread(&StreamClient::ThreadFunc, this);
+}
+
+void StreamClient::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ != -1) {
+      shutdown(fd_, SHUT_RDWR);
+    }
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void StreamClient::ThreadFunc() {
+  while (!is_shutdown_.load()) {
+    int fd = Connect();
+    if (fd != -1) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (is_shutdown_.load()) {
+          close(fd);
+          break;
+        }
+        fd_ = fd;
+      }
+      is_connected_ = true;
+      while (ReadFrame(fd)) {
+      }
+      is_connected_ = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fd_ = -1;
+      }
+      close(fd);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, kReconnectInterval,
+                 [this] { return is_shutdown_.load(); });
+  }
+}
+
+int StreamClient::Connect() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd == -1) {
+    AERROR << "fail to create stream fd, " << strerror(errno);
+    return -1;
+  }
+
+  int yes = 1;
+  int buffer_size = kStreamSocketBufferSize;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = inet_addr(ip_.c_str());
+  addr.sin_port = htons(port_);
+  if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    ADEBUG << "fail to connect stream " << ip_ << ":" << port_ << ", "
+           << strerror(errno);
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool StreamClient::ReadFrame(int fd) {
+  StreamFrameHeader header;
+  if (!ReadAll(fd, reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  if (header.magic != kStreamFrameMagic ||
+      header.info_size > kStreamMaxInfoSize ||
+      header.payload_size > kStreamMaxPayloadSize) {
+    AERROR << "invalid stream frame from " << ip_ << ":" << port_;
+    return false;
+  }
+
+  char info_buf[kStreamMaxInfoSize];
+  MessageInfo msg_info;
+  if (!ReadAll(fd, info_buf, header.info_size) ||
+      !msg_info.DeserializeFrom(info_buf, header.info_size)) {
+    return false;
+  }
+
+  payload_.resize(header.payload_size);
+  if (!ReadAll(fd, &payload_[0], payload_.size())) {
+    return false;
+  }
+  handler_(payload_, msg_info);
+  return true;
+}
+
+bool StreamClient::ReadAll(int fd, char* buf, size_t size) {
+  while (size > 0) {
+    ssize_t nbytes = recv(fd, buf, size, MSG_WAITALL);
+    if (nbytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nbytes <= 0) {
+      return false;
+    }
+    buf += nbytes;
+    size -= nbytes;
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
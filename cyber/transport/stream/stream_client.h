@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_STREAM_STREAM_CLIENT_H_
+#define CYBER_TRANSPORT_STREAM_STREAM_CLIENT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// The reader end of a stream. Connects to the StreamServer of a writer,
+// again whenever the connection is lost, and hands every message to the
+// handler on its own thread. The payload is read into a buffer kept across
+// messages, so it stops allocating once it has seen the largest one.
+class StreamClient {
+ public:
+  using MessageHandler = std::function<void(const std::string& payload,
+                                            const MessageInfo& msg_info)>;
+
+  StreamClient(const std::string& ip, uint16_t port,
+               const MessageHandler& handler);
+  virtual ~StreamClient();
+
+  void Start();
+  void Shutdown();
+
+  bool IsConnected() const { return is_connected_.load(); }
+
+ private:
+  void ThreadFunc();
+  int Connect();
+  bool ReadFrame(int fd);
+  bool ReadAll(int fd, char* buf, size_t size);
+
+  std::string ip_;
+  uint16_t port_;
+  MessageHandler handler_;
+
+  std::atomic<bool> is_shutdown_ = {true};
+  std::atomic<bool> is_connected_ = {false};
+  std::thread thread_;
+  // guards fd_, so that Shutdown can wake up a blocking read
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int fd_ = -1;
+
+  std::string payload_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_STREAM_STREAM_CLIENT_H_
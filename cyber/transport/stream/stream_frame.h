@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_STREAM_STREAM_FRAME_H_
+#define CYBER_TRANSPORT_STREAM_STREAM_FRAME_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// A message on a stream is this header, the serialized MessageInfo and the
+// serialized message, in host byte order like the shm segments.
+struct StreamFrameHeader {
+  uint32_t magic;
+  uint32_t info_size;
+  uint64_t payload_size;
+};
+
+constexpr uint32_t kStreamFrameMagic = 0x54535943;  // "CYST"
+// larger than MessageInfo::ByteSize() with its hop timestamps
+constexpr uint32_t kStreamMaxInfoSize = 256;
+constexpr uint64_t kStreamMaxPayloadSize = 1ULL << 30;
+
+// socket buffers sized for a few large sensor messages in flight
+constexpr int kStreamSocketBufferSize = 8 * 1024 * 1024;
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_STREAM_STREAM_FRAME_H_
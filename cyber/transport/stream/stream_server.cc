@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/stream/stream_server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/stream/stream_frame.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+// how often the accepting thread checks for shutdown
+const int kAcceptPollTimeoutMs = 100;
+}  // namespace
+
+StreamServer::StreamServer() {}
+
+StreamServer::~StreamServer() { Shutdown(); }
+
+bool StreamServer::Listen(uint16_t port) {
+  if (!is_shutdown_.load()) {
+    return true;
+  }
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ == -1) {
+    AERROR << "fail to create stream listen fd, " << strerror(errno);
+    return false;
+  }
+
+  int yes = 1;
+  if (setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) < 0) {
+    AERROR << "fail to setsockopt SO_REUSEADDR, " << strerror(errno);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  socklen_t addr_len = sizeof(addr);
+  if (bind(listen_fd_, (struct sockaddr*)&addr, addr_len) < 0 ||
+      listen(listen_fd_, SOMAXCONN) < 0 ||
+      getsockname(listen_fd_, (struct sockaddr*)&addr, &addr_len) < 0) {
+    AERROR << "fail to listen on stream port " << port << ", "
+           << strerror(errno);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+  port_ = ntohs(addr.sin_port);
+
+  is_shutdown_ = false;
+  thread_ = std::thread(&StreamServer::ThreadFunc, this);
+  return true;
+}
+
+void StreamServer::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  close(listen_fd_);
+  listen_fd_ = -1;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int fd : conn_fds_) {
+    close(fd);
+  }
+  conn_fds_.clear();
+}
+
+bool StreamServer::Send(const MessageInfo& msg_info,
+                        const std::string& payload) {
+  if (is_shutdown_.load()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (conn_fds_.empty()) {
+    return true;
+  }
+
+  StreamFrameHeader header;
+  header.magic = kStreamFrameMagic;
+  header.info_size = static_cast<uint32_t>(msg_info.ByteSize());
+  header.payload_size = payload.size();
+  header_.resize(sizeof(header) + header.info_size);
+  memcpy(&header_[0], &header, sizeof(header));
+  if (!msg_info.SerializeTo(&header_[sizeof(header)], header.info_size)) {
+    return false;
+  }
+
+  bool result = true;
+  for (auto it = conn_fds_.begin(); it != conn_fds_.end();) {
+    if (SendTo(*it, header_.data(), header_.size(), payload)) {
+      ++it;
+      continue;
+    }
+    // a partial frame is left behind, the reader has to start over
+    AWARN << "stream reader dropped, " << strerror(errno);
+    close(*it);
+    it = conn_fds_.erase(it);
+    result = false;
+  }
+  return result;
+}
+
+size_t StreamServer::connection_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return conn_fds_.size();
+}
+
+void StreamServer::ThreadFunc() {
+  struct pollfd fds;
+  fds.fd = listen_fd_;
+  fds.events = POLLIN;
+  while (!is_shutdown_.load()) {
+    int ready_num = poll(&fds, 1, kAcceptPollTimeoutMs);
+    if (ready_num <= 0) {
+      continue;
+    }
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd == -1) {
+      continue;
+    }
+
+    int yes = 1;
+    int buffer_size = kStreamSocketBufferSize;
+    struct timeval timeout;
+    timeout.tv_sec = kSendTimeoutMs / 1000;
+    timeout.tv_usec = (kSendTimeoutMs % 1000) * 1000;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    conn_fds_.push_back(fd);
+  }
+}
+
+bool StreamServer::SendTo(int fd, const char* header, size_t header_size,
+                          const std::string& payload) {
+  struct iovec iov[2];
+  iov[0].iov_base = const_cast<char*>(header);
+  iov[0].iov_len = header_size;
+  iov[1].iov_base = const_cast<char*>(payload.data());
+  iov[1].iov_len = payload.size();
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = 2;
+  while (msg.msg_iovlen > 0) {
+    ssize_t nbytes = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if (nbytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    // skip what went out, the kernel may take part of a large frame
+    size_t sent = static_cast<size_t>(nbytes);
+    while (msg.msg_iovlen > 0 && sent >= msg.msg_iov->iov_len) {
+      sent -= msg.msg_iov->iov_len;
+      ++msg.msg_iov;
+      --msg.msg_iovlen;
+    }
+    if (msg.msg_iovlen > 0) {
+      msg.msg_iov->iov_base = static_cast<char*>(msg.msg_iov->iov_base) + sent;
+      msg.msg_iov->iov_len -= sent;
+    }
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
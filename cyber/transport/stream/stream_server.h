@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_STREAM_STREAM_SERVER_H_
+#define CYBER_TRANSPORT_STREAM_STREAM_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// The writer end of a stream: a tcp socket the readers of other hosts
+// connect to. Every message goes out with a single sendmsg per reader,
+// gathering the frame header, the MessageInfo and the serialized message
+// without copying them together, and without the fragmentation and
+// acknowledgements of rtps. A reader which does not take a message within
+// kSendTimeoutMs is disconnected, it reconnects and misses what was sent
+// meanwhile, like a best effort rtps reader.
+class StreamServer {
+ public:
+  StreamServer();
+  virtual ~StreamServer();
+
+  // Listens on port of all interfaces, any free one for 0.
+  bool Listen(uint16_t port);
+  void Shutdown();
+
+  bool Send(const MessageInfo& msg_info, const std::string& payload);
+
+  uint16_t port() const { return port_; }
+  size_t connection_num();
+
+  static const int kSendTimeoutMs = 100;
+
+ private:
+  void ThreadFunc();
+  bool SendTo(int fd, const char* header, size_t header_size,
+              const std::string& payload);
+
+  int listen_fd_ = -1;
+  uint16_t port_ = 0;
+  std::atomic<bool> is_shutdown_ = {true};
+  std::thread thread_;
+
+  std::mutex mutex_;
+  std::vector<int> conn_fds_;
+  // frame header and MessageInfo of the message being sent
+  std::string header_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_STREAM_STREAM_SERVER_H_
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/stream/stream_client.h"
+#include "cyber/transport/stream/stream_server.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  for (int i = 0; i < 200; ++i) {
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST(StreamTest, send_and_receive) {
+  StreamServer server;
+  ASSERT_TRUE(server.Listen(0));
+  EXPECT_NE(server.port(), 0);
+  // no reader, nothing to do
+  Identity sender;
+  EXPECT_TRUE(server.Send(MessageInfo(sender, 0), "dropped"));
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> payloads;
+  std::vector<uint64_t> seq_nums;
+  StreamClient client("127.0.0.1", server.port(),
+                      [&](const std::string& payload,
+                          const MessageInfo& msg_info) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        payloads.push_back(payload);
+                        seq_nums.push_back(msg_info.seq_num());
+                        cv.notify_all();
+                      });
+  client.Start();
+  ASSERT_TRUE(WaitFor([&] { return server.connection_num() == 1; }));
+
+  // larger than the socket buffers, goes out in several sends
+  std::string large(24 * 1024 * 1024, 'x');
+  large.back() = 'y';
+  MessageInfo msg_info(sender, 1);
+  EXPECT_TRUE(server.Send(msg_info, "point cloud"));
+  msg_info.set_seq_num(2);
+  EXPECT_TRUE(server.Send(msg_info, ""));
+  msg_info.set_seq_num(3);
+  EXPECT_TRUE(server.Send(msg_info, large));
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+                            [&] { return payloads.size() == 3; }));
+  }
+  EXPECT_EQ(payloads[0], "point cloud");
+  EXPECT_EQ(payloads[1], "");
+  EXPECT_EQ(payloads[2], large);
+  EXPECT_EQ(seq_nums, std::vector<uint64_t>({1, 2, 3}));
+
+  // the writer goes away, the reader notices
+  server.Shutdown();
+  EXPECT_TRUE(WaitFor([&] { return !client.IsConnected(); }));
+  EXPECT_FALSE(server.Send(msg_info, "late"));
+  client.Shutdown();
+}
+
+TEST(StreamTest, reconnect) {
+  StreamServer server;
+  ASSERT_TRUE(server.Listen(0));
+  uint16_t port = server.port();
+  server.Shutdown();
+
+  std::atomic<int> count = {0};
+  StreamClient client("127.0.0.1", port,
+                      [&](const std::string&, const MessageInfo&) {
+                        ++count;
+                      });
+  client.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(client.IsConnected());
+
+  // the writer shows up on the same port later
+  StreamServer late_server;
+  ASSERT_TRUE(late_server.Listen(port));
+  ASSERT_TRUE(WaitFor([&] { return late_server.connection_num() == 1; }));
+  EXPECT_TRUE(late_server.Send(MessageInfo(), "hello"));
+  EXPECT_TRUE(WaitFor([&] { return count.load() == 1; }));
+
+  // shutting down wakes up the blocking read
+  client.Shutdown();
+  EXPECT_FALSE(client.IsConnected());
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
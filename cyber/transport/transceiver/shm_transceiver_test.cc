@@ -147,6 +147,87 @@ TEST_F(ShmTransceiverTest, enable_and_disable) {
   EXPECT_EQ(msgs.size(), 0);
 }
 
+TEST_F(ShmTransceiverTest, loan_and_publish) {
+  std::vector<proto::UnitTest> msgs;
+  RoleAttributes attr;
+  attr.set_channel_name(channel_name_);
+  attr.set_channel_id(common::Hash(channel_name_));
+  ReceiverPtr receiver = std::make_shared<ShmReceiver<proto::UnitTest>>(
+      attr, [&msgs](const std::shared_ptr<proto::UnitTest>& msg,
+                    const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        msgs.emplace_back(*msg);
+      });
+  receiver->Enable();
+
+  proto::UnitTest msg;
+  msg.set_class_name("ShmTransceiverTest");
+  msg.set_case_name("loan_and_publish");
+  std::size_t msg_size = msg.ByteSizeLong();
+
+  LoanedBuffer loaned;
+  EXPECT_TRUE(transmitter_a_->Loan(msg_size, &loaned));
+  EXPECT_GE(loaned.capacity, msg_size);
+  EXPECT_TRUE(
+      msg.SerializeToArray(loaned.data, static_cast<int>(loaned.capacity)));
+  loaned.size = msg_size;
+  EXPECT_TRUE(transmitter_a_->Publish(&loaned));
+  EXPECT_EQ(loaned.data, nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(msgs.size(), 1);
+  EXPECT_EQ(msgs[0].case_name(), "loan_and_publish");
+
+  // a returned loan is never delivered
+  EXPECT_TRUE(transmitter_a_->Loan(msg_size, &loaned));
+  transmitter_a_->ReturnLoan(&loaned);
+  EXPECT_EQ(loaned.data, nullptr);
+  EXPECT_FALSE(transmitter_a_->Publish(&loaned));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(msgs.size(), 1);
+
+  transmitter_a_->Disable();
+  EXPECT_FALSE(transmitter_a_->Loan(msg_size, &loaned));
+  receiver->Disable();
+}
+
+TEST_F(ShmTransceiverTest, transmit_with_cache) {
+  std::vector<proto::UnitTest> msgs;
+  RoleAttributes attr;
+  attr.set_channel_name(channel_name_);
+  attr.set_channel_id(common::Hash(channel_name_));
+  ReceiverPtr receiver = std::make_shared<ShmReceiver<proto::UnitTest>>(
+      attr, [&msgs](const std::shared_ptr<proto::UnitTest>& msg,
+                    const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        msgs.emplace_back(*msg);
+      });
+  receiver->Enable();
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("ShmTransceiverTest");
+  msg->set_case_name("transmit_with_cache");
+
+  // an empty cache means the transmitter serializes by itself
+  std::string serialized;
+  MessageInfo msg_info(transmitter_a_->id(), 1);
+  EXPECT_TRUE(transmitter_a_->TransmitWithCache(msg, msg_info, &serialized));
+
+  // a filled cache is sent as is
+  proto::UnitTest cached_msg;
+  cached_msg.set_case_name("cached");
+  cached_msg.SerializeToString(&serialized);
+  msg_info.set_seq_num(2);
+  EXPECT_TRUE(transmitter_a_->TransmitWithCache(msg, msg_info, &serialized));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(msgs.size(), 2);
+  EXPECT_EQ(msgs[0].case_name(), "transmit_with_cache");
+  EXPECT_EQ(msgs[1].case_name(), "cached");
+
+  receiver->Disable();
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/util.h"
+#include "cyber/proto/unit_test.pb.h"
+#include "cyber/transport/receiver/stream_receiver.h"
+#include "cyber/transport/transmitter/stream_transmitter.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using TransmitterPtr = std::shared_ptr<Transmitter<proto::UnitTest>>;
+using ReceiverPtr = std::shared_ptr<Receiver<proto::UnitTest>>;
+
+TEST(StreamTransceiverTest, enable_and_disable) {
+  std::string channel_name("stream_channel");
+  RoleAttributes attr;
+  attr.set_host_ip("127.0.0.1");
+  attr.set_channel_name(channel_name);
+  attr.set_channel_id(common::Hash(channel_name));
+
+  TransmitterPtr transmitter =
+      std::make_shared<StreamTransmitter<proto::UnitTest>>(attr);
+  // the address the writer announces
+  auto& transmitter_attr = transmitter->attributes();
+  ASSERT_TRUE(transmitter_attr.has_socket_addr());
+  EXPECT_EQ(transmitter_attr.socket_addr().ip(), "127.0.0.1");
+  EXPECT_NE(transmitter_attr.socket_addr().port(), 0);
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("StreamTransceiverTest");
+  msg->set_case_name(std::string(4 * 1024 * 1024, 'p'));
+  EXPECT_FALSE(transmitter->Transmit(msg));
+  transmitter->Enable();
+
+  std::mutex mutex;
+  std::vector<proto::UnitTest> msgs;
+  ReceiverPtr receiver = std::make_shared<StreamReceiver<proto::UnitTest>>(
+      attr, [&](const std::shared_ptr<proto::UnitTest>& msg,
+                const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        std::lock_guard<std::mutex> lock(mutex);
+        msgs.emplace_back(*msg);
+      });
+  receiver->Enable();
+  receiver->Enable(transmitter_attr);
+  // repeated call
+  receiver->Enable(transmitter_attr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  EXPECT_TRUE(transmitter->Transmit(msg));
+  std::string serialized;
+  EXPECT_TRUE(transmitter->TransmitWithCache(msg, MessageInfo(), &serialized));
+  EXPECT_FALSE(serialized.empty());
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(msgs.size(), 2);
+    for (auto& item : msgs) {
+      EXPECT_EQ(item.class_name(), "StreamTransceiverTest");
+      EXPECT_EQ(item.case_name(), msg->case_name());
+    }
+    msgs.clear();
+  }
+
+  receiver->Disable(transmitter_attr);
+  EXPECT_TRUE(transmitter->Transmit(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_TRUE(msgs.empty());
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -36,6 +36,7 @@
 #include "cyber/transport/transmitter/intra_transmitter.h"
 #include "cyber/transport/transmitter/rtps_transmitter.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
+#include "cyber/transport/transmitter/stream_transmitter.h"
 #include "cyber/transport/transmitter/transmitter.h"
 
 namespace apollo {
@@ -71,6 +72,12 @@ class HybridTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  // Loans are only granted while every matched reader is served by shm and
+  // no history is kept, since the other paths need the message object.
+  bool Loan(std::size_t size, LoanedBuffer* loaned) override;
+  bool Publish(LoanedBuffer* loaned, const MessageInfo& msg_info) override;
+  void ReturnLoan(LoanedBuffer* loaned) override;
+
  private:
   void InitMode();
   void ObtainConfig();
@@ -165,12 +172,59 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
                                     const MessageInfo& msg_info) {
   std::lock_guard<std::mutex> lock(mutex_);
   history_->Add(msg, msg_info);
-  for (auto& item : transmitters_) {
-    item.second->Transmit(msg, msg_info);
+  // Intra readers take the pointer. Rtps and stream run before shm since
+  // they need the bytes in a string anyway, shm then copies them instead of
+  // serializing again. Disabled transmitters leave the cache untouched.
+  std::string serialized;
+  for (auto mode : {OptionalMode::INTRA, OptionalMode::RTPS,
+                    OptionalMode::STREAM, OptionalMode::SHM}) {
+    auto it = transmitters_.find(mode);
+    if (it != transmitters_.end()) {
+      it->second->TransmitWithCache(msg, msg_info, &serialized);
+    }
   }
   return true;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::Loan(std::size_t size, LoanedBuffer* loaned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (this->attr_.qos_profile().durability() ==
+      QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL) {
+    return false;
+  }
+  auto shm = transmitters_.find(OptionalMode::SHM);
+  if (shm == transmitters_.end() || receivers_[OptionalMode::SHM].empty()) {
+    return false;
+  }
+  for (auto& item : receivers_) {
+    if (item.first != OptionalMode::SHM && !item.second.empty()) {
+      return false;
+    }
+  }
+  return shm->second->Loan(size, loaned);
+}
+
+template <typename M>
+bool HybridTransmitter<M>::Publish(LoanedBuffer* loaned,
+                                   const MessageInfo& msg_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto shm = transmitters_.find(OptionalMode::SHM);
+  if (shm == transmitters_.end()) {
+    return false;
+  }
+  return shm->second->Publish(loaned, msg_info);
+}
+
+template <typename M>
+void HybridTransmitter<M>::ReturnLoan(LoanedBuffer* loaned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto shm = transmitters_.find(OptionalMode::SHM);
+  if (shm != transmitters_.end()) {
+    shm->second->ReturnLoan(loaned);
+  }
+}
+
 template <typename M>
 void HybridTransmitter<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -182,13 +236,14 @@ void HybridTransmitter<M>::InitMode() {
 template <typename M>
 void HybridTransmitter<M>::ObtainConfig() {
   auto& global_conf = common::GlobalData::Instance()->Config();
-  if (!global_conf.has_transport_conf()) {
-    return;
+  if (global_conf.has_transport_conf() &&
+      global_conf.transport_conf().has_communication_mode()) {
+    mode_->CopyFrom(global_conf.transport_conf().communication_mode());
   }
-  if (!global_conf.transport_conf().has_communication_mode()) {
-    return;
+  // channels of large messages serve other hosts over their own stream
+  if (this->attr_.qos_profile().diff_host_stream()) {
+    mode_->set_diff_host(OptionalMode::STREAM);
   }
-  mode_->CopyFrom(global_conf.transport_conf().communication_mode());
 
   mapping_table_[SAME_PROC] = mode_->same_proc();
   mapping_table_[DIFF_PROC] = mode_->diff_proc();
@@ -221,6 +276,15 @@ void HybridTransmitter<M>::InitTransmitters() {
       case OptionalMode::SHM:
         transmitters_[mode] = std::make_shared<ShmTransmitter<M>>(this->attr_);
         break;
+      case OptionalMode::STREAM:
+        transmitters_[mode] =
+            std::make_shared<StreamTransmitter<M>>(this->attr_);
+        // announced by the writer, readers connect there
+        if (transmitters_[mode]->attributes().has_socket_addr()) {
+          this->attr_.mutable_socket_addr()->CopyFrom(
+              transmitters_[mode]->attributes().socket_addr());
+        }
+        break;
       default:
         transmitters_[mode] =
             std::make_shared<RtpsTransmitter<M>>(this->attr_, participant_);
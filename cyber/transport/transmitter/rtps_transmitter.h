@@ -23,7 +23,9 @@
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/rtps/attributes_filler.h"
+#include "cyber/transport/rtps/message_batcher.h"
 #include "cyber/transport/rtps/participant.h"
+#include "cyber/transport/rtps/sub_listener.h"
 #include "cyber/transport/transmitter/transmitter.h"
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -47,12 +49,17 @@ class RtpsTransmitter : public Transmitter<M> {
   void Disable() override;
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool TransmitWithCache(const MessagePtr& msg, const MessageInfo& msg_info,
+                         std::string* serialized) override;
 
  private:
-  bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Transmit(const M& msg, const MessageInfo& msg_info,
+                std::string* serialized);
+  bool Write(UnderlayMessage* m, const MessageInfo& msg_info);
 
   ParticipantPtr participant_;
   eprosima::fastrtps::Publisher* publisher_;
+  std::unique_ptr<MessageBatcher> batcher_;
 };
 
 template <typename M>
@@ -79,12 +86,26 @@ void RtpsTransmitter<M>::Enable() {
   publisher_ = eprosima::fastrtps::Domain::createPublisher(
       participant_->fastrtps_participant(), pub_attr);
   RETURN_IF_NULL(publisher_);
+
+  auto& qos = this->attr_.qos_profile();
+  if (qos.batch_window_us() > 0) {
+    batcher_.reset(new MessageBatcher(
+        qos.batch_window_us(), qos.batch_max_bytes(),
+        [this](const std::string& payload, const MessageInfo& last_info) {
+          UnderlayMessage m;
+          m.data() = payload;
+          m.datatype() = MessageBatcher::DataType();
+          return Write(&m, last_info);
+        }));
+  }
   this->enabled_ = true;
 }
 
 template <typename M>
 void RtpsTransmitter<M>::Disable() {
   if (this->enabled_) {
+    // flushes the pending batch while the publisher is still alive
+    batcher_.reset();
     publisher_ = nullptr;
     this->enabled_ = false;
   }
@@ -93,20 +114,55 @@ void RtpsTransmitter<M>::Disable() {
 template <typename M>
 bool RtpsTransmitter<M>::Transmit(const MessagePtr& msg,
                                   const MessageInfo& msg_info) {
-  return Transmit(*msg, msg_info);
+  return Transmit(*msg, msg_info, nullptr);
 }
 
 template <typename M>
-bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
+bool RtpsTransmitter<M>::TransmitWithCache(const MessagePtr& msg,
+                                           const MessageInfo& msg_info,
+                                           std::string* serialized) {
+  return Transmit(*msg, msg_info, serialized);
+}
+
+template <typename M>
+bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info,
+                                  std::string* serialized) {
   if (!this->enabled_) {
     ADEBUG << "not enable.";
     return false;
   }
 
+  bool cached = serialized != nullptr && !serialized->empty();
+  if (cached) {
+    ChannelStats::OnSendBytes(this->counters_, serialized->size());
+  }
+  if (cached && batcher_ != nullptr) {
+    return batcher_->Append(*serialized, msg_info);
+  }
+
   UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  if (cached) {
+    m.data() = *serialized;
+  } else {
+    RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+    ChannelStats::OnSendBytes(this->counters_, m.data().size());
+  }
 
+  bool result = batcher_ != nullptr ? batcher_->Append(m.data(), msg_info)
+                                    : Write(&m, msg_info);
+  if (serialized != nullptr && !cached) {
+    serialized->swap(m.data());
+  }
+  return result;
+}
+
+template <typename M>
+bool RtpsTransmitter<M>::Write(UnderlayMessage* m,
+                               const MessageInfo& msg_info) {
   eprosima::fastrtps::rtps::WriteParams wparams;
+  if (msg_info.has_trace()) {
+    m->datatype(SubListener::TraceDataType() + msg_info.TraceToString());
+  }
 
   char* ptr =
       reinterpret_cast<char*>(&wparams.related_sample_identity().writer_guid());
@@ -122,7 +178,7 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   if (participant_->is_shutdown()) {
     return false;
   }
-  return publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  return publisher_->write(reinterpret_cast<void*>(m), wparams);
 }
 
 }  // namespace transport
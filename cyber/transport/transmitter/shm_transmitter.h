@@ -47,9 +47,19 @@ class ShmTransmitter : public Transmitter<M> {
   void Disable() override;
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool TransmitWithCache(const MessagePtr& msg, const MessageInfo& msg_info,
+                         std::string* serialized) override;
+
+  bool Loan(std::size_t size, LoanedBuffer* loaned) override;
+  bool Publish(LoanedBuffer* loaned, const MessageInfo& msg_info) override;
+  void ReturnLoan(LoanedBuffer* loaned) override;
 
  private:
-  bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Transmit(const M& msg, const MessageInfo& msg_info,
+                const std::string* serialized);
+  bool Commit(const WritableBlock& wb, std::size_t msg_size,
+              const MessageInfo& msg_info);
+  void Abandon(const WritableBlock& wb);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -78,7 +88,9 @@ void ShmTransmitter<M>::Enable() {
   }
 
   segment_ = std::make_shared<Segment>(channel_id_, WRITE_ONLY);
-  notifier_ = NotifierFactory::CreateNotifier();
+  if (!segment_->ring_mode()) {
+    notifier_ = NotifierFactory::CreateNotifier();
+  }
   this->enabled_ = true;
 }
 
@@ -94,39 +106,109 @@ void ShmTransmitter<M>::Disable() {
 template <typename M>
 bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
                                  const MessageInfo& msg_info) {
-  return Transmit(*msg, msg_info);
+  return Transmit(*msg, msg_info, nullptr);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::TransmitWithCache(const MessagePtr& msg,
+                                          const MessageInfo& msg_info,
+                                          std::string* serialized) {
+  return Transmit(*msg, msg_info, serialized);
 }
 
 template <typename M>
-bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
+bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info,
+                                 const std::string* serialized) {
   if (!this->enabled_) {
     ADEBUG << "not enable.";
     return false;
   }
 
+  bool cached = serialized != nullptr && !serialized->empty();
   WritableBlock wb;
-  std::size_t msg_size = message::ByteSize(msg);
+  std::size_t msg_size = cached ? serialized->size() : message::ByteSize(msg);
   if (!segment_->AcquireBlockToWrite(msg_size, &wb)) {
     AERROR << "acquire block failed.";
     return false;
   }
 
   ADEBUG << "block index: " << wb.index;
-  if (!message::SerializeToArray(msg, wb.buf, static_cast<int>(msg_size))) {
+  if (cached) {
+    std::memcpy(wb.buf, serialized->data(), msg_size);
+  } else if (!message::SerializeToArray(msg, wb.buf,
+                                        static_cast<int>(msg_size))) {
     AERROR << "serialize to array failed.";
-    segment_->ReleaseWrittenBlock(wb);
+    Abandon(wb);
     return false;
   }
+  return Commit(wb, msg_size, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Loan(std::size_t size, LoanedBuffer* loaned) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  if (!segment_->AcquireBlockToWrite(size, &loaned->block)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+  loaned->data = loaned->block.buf;
+  loaned->capacity = size;
+  loaned->size = 0;
+  return true;
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Publish(LoanedBuffer* loaned,
+                                const MessageInfo& msg_info) {
+  RETURN_VAL_IF_NULL(loaned, false);
+  RETURN_VAL_IF_NULL(loaned->data, false);
+  if (!this->enabled_ || loaned->size > loaned->capacity) {
+    AERROR << "invalid loan, size: " << loaned->size
+           << " capacity: " << loaned->capacity;
+    ReturnLoan(loaned);
+    return false;
+  }
+
+  bool result = Commit(loaned->block, loaned->size, msg_info);
+  loaned->data = nullptr;
+  return result;
+}
+
+template <typename M>
+void ShmTransmitter<M>::ReturnLoan(LoanedBuffer* loaned) {
+  if (loaned == nullptr || loaned->data == nullptr) {
+    return;
+  }
+  if (segment_ != nullptr) {
+    Abandon(loaned->block);
+  }
+  loaned->data = nullptr;
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Commit(const WritableBlock& wb, std::size_t msg_size,
+                               const MessageInfo& msg_info) {
   wb.block->set_msg_size(msg_size);
 
   char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-  if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+  if (!msg_info.SerializeTo(msg_info_addr, msg_info.ByteSize())) {
     AERROR << "serialize message info failed.";
-    segment_->ReleaseWrittenBlock(wb);
+    Abandon(wb);
     return false;
   }
-  wb.block->set_msg_info_size(MessageInfo::kSize);
+  wb.block->set_msg_info_size(msg_info.ByteSize());
   segment_->ReleaseWrittenBlock(wb);
+  ChannelStats::OnSendBytes(this->counters_, msg_size);
+
+  // ring mode readers poll the segment, no notification needed
+  if (notifier_ == nullptr) {
+    return true;
+  }
 
   ReadableInfo readable_info(host_id_, wb.index, channel_id_);
 
@@ -136,6 +218,14 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   return notifier_->Notify(readable_info);
 }
 
+template <typename M>
+void ShmTransmitter<M>::Abandon(const WritableBlock& wb) {
+  // readers reject blocks without a valid message info
+  wb.block->set_msg_size(0);
+  wb.block->set_msg_info_size(0);
+  segment_->ReleaseWrittenBlock(wb);
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
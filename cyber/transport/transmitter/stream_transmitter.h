@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_TRANSMITTER_STREAM_TRANSMITTER_H_
+#define CYBER_TRANSPORT_TRANSMITTER_STREAM_TRANSMITTER_H_
+
+#include <memory>
+#include <string>
+
+#include "cyber/common/log.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/stream/stream_server.h"
+#include "cyber/transport/transmitter/transmitter.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Serves the readers of other hosts over a StreamServer. It listens as soon
+// as it is created, and its attributes carry the address in socket_addr,
+// which the writer announces so that readers know where to connect.
+template <typename M>
+class StreamTransmitter : public Transmitter<M> {
+ public:
+  using MessagePtr = std::shared_ptr<M>;
+
+  explicit StreamTransmitter(const RoleAttributes& attr);
+  virtual ~StreamTransmitter();
+
+  void Enable() override;
+  void Disable() override;
+
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+  bool TransmitWithCache(const MessagePtr& msg, const MessageInfo& msg_info,
+                         std::string* serialized) override;
+
+ private:
+  bool Transmit(const M& msg, const MessageInfo& msg_info,
+                std::string* serialized);
+
+  StreamServer server_;
+  std::string serialized_;
+};
+
+template <typename M>
+StreamTransmitter<M>::StreamTransmitter(const RoleAttributes& attr)
+    : Transmitter<M>(attr) {
+  if (!server_.Listen(0)) {
+    AERROR << "stream of channel " << attr.channel_name() << " not served.";
+    return;
+  }
+  this->attr_.mutable_socket_addr()->set_ip(attr.host_ip());
+  this->attr_.mutable_socket_addr()->set_port(server_.port());
+}
+
+template <typename M>
+StreamTransmitter<M>::~StreamTransmitter() {
+  Disable();
+  server_.Shutdown();
+}
+
+template <typename M>
+void StreamTransmitter<M>::Enable() {
+  this->enabled_ = true;
+}
+
+template <typename M>
+void StreamTransmitter<M>::Disable() {
+  this->enabled_ = false;
+}
+
+template <typename M>
+bool StreamTransmitter<M>::Transmit(const MessagePtr& msg,
+                                    const MessageInfo& msg_info) {
+  return Transmit(*msg, msg_info, nullptr);
+}
+
+template <typename M>
+bool StreamTransmitter<M>::TransmitWithCache(const MessagePtr& msg,
+                                             const MessageInfo& msg_info,
+                                             std::string* serialized) {
+  return Transmit(*msg, msg_info, serialized);
+}
+
+template <typename M>
+bool StreamTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info,
+                                    std::string* serialized) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  // without a cache serialized_ keeps its capacity across messages, an
+  // empty cache is filled in for the next transmitter
+  std::string* payload = serialized != nullptr ? serialized : &serialized_;
+  if (serialized == nullptr || serialized->empty()) {
+    RETURN_VAL_IF(!message::SerializeToString(msg, payload), false);
+  }
+  ChannelStats::OnSendBytes(this->counters_, payload->size());
+  return server_.Send(msg_info, *payload);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_TRANSMITTER_STREAM_TRANSMITTER_H_
@@ -22,7 +22,11 @@
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/base/macros.h"
 #include "cyber/transport/common/endpoint.h"
+#include "cyber/transport/message/channel_stats.h"
+#include "cyber/transport/message/latency_tracer.h"
+#include "cyber/transport/message/loaned_buffer.h"
 #include "cyber/transport/message/message_info.h"
 
 namespace apollo {
@@ -48,6 +52,21 @@ class Transmitter : public Endpoint {
 
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
+  // Like Transmit(), but `serialized` caches the serialized msg across
+  // several transmitters: a non-empty cache is used as is, and a transmitter
+  // that serializes into a string fills it in for the next one.
+  virtual bool TransmitWithCache(const MessagePtr& msg,
+                                 const MessageInfo& msg_info,
+                                 std::string* serialized);
+
+  // Zero-copy publishing: Loan() lends a transport buffer of at least `size`
+  // bytes that the caller fills with the serialized message and then hands to
+  // Publish(), or gives back with ReturnLoan(). Only transmitters backed by
+  // shared memory support loans; the others return false.
+  virtual bool Loan(std::size_t size, LoanedBuffer* loaned);
+  virtual bool Publish(LoanedBuffer* loaned);
+  virtual bool Publish(LoanedBuffer* loaned, const MessageInfo& msg_info);
+  virtual void ReturnLoan(LoanedBuffer* loaned);
 
   uint64_t NextSeqNum() { return ++seq_num_; }
 
@@ -56,11 +75,14 @@ class Transmitter : public Endpoint {
  protected:
   uint64_t seq_num_;
   MessageInfo msg_info_;
+  ChannelCounters* counters_;
 };
 
 template <typename M>
 Transmitter<M>::Transmitter(const RoleAttributes& attr)
-    : Endpoint(attr), seq_num_(0) {
+    : Endpoint(attr),
+      seq_num_(0),
+      counters_(ChannelStats::Instance()->GetCounters(attr.channel_id())) {
   msg_info_.set_sender_id(this->id_);
   msg_info_.set_seq_num(this->seq_num_);
 }
@@ -71,11 +93,55 @@ Transmitter<M>::~Transmitter() {}
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
+  if (unlikely(LatencyTracer::Instance()->enabled())) {
+    LatencyTracer::Instance()->StampSend(attr_.channel_id(), &msg_info_);
+  }
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANS_FROM, attr_.channel_id(), msg_info_.seq_num());
+  ChannelStats::OnSend(counters_);
   return Transmit(msg, msg_info_);
 }
 
+template <typename M>
+bool Transmitter<M>::TransmitWithCache(const MessagePtr& msg,
+                                       const MessageInfo& msg_info,
+                                       std::string* serialized) {
+  (void)serialized;
+  return Transmit(msg, msg_info);
+}
+
+template <typename M>
+bool Transmitter<M>::Loan(std::size_t size, LoanedBuffer* loaned) {
+  (void)size;
+  (void)loaned;
+  return false;
+}
+
+template <typename M>
+bool Transmitter<M>::Publish(LoanedBuffer* loaned) {
+  msg_info_.set_seq_num(NextSeqNum());
+  if (unlikely(LatencyTracer::Instance()->enabled())) {
+    LatencyTracer::Instance()->StampSend(attr_.channel_id(), &msg_info_);
+  }
+  PerfEventCache::Instance()->AddTransportEvent(
+      TransPerf::TRANS_FROM, attr_.channel_id(), msg_info_.seq_num());
+  ChannelStats::OnSend(counters_);
+  return Publish(loaned, msg_info_);
+}
+
+template <typename M>
+bool Transmitter<M>::Publish(LoanedBuffer* loaned,
+                             const MessageInfo& msg_info) {
+  (void)loaned;
+  (void)msg_info;
+  return false;
+}
+
+template <typename M>
+void Transmitter<M>::ReturnLoan(LoanedBuffer* loaned) {
+  (void)loaned;
+}
+
 template <typename M>
 void Transmitter<M>::Enable(const RoleAttributes& opposite_attr) {
   (void)opposite_attr;
@@ -32,12 +32,14 @@
 #include "cyber/transport/receiver/receiver.h"
 #include "cyber/transport/receiver/rtps_receiver.h"
 #include "cyber/transport/receiver/shm_receiver.h"
+#include "cyber/transport/receiver/stream_receiver.h"
 #include "cyber/transport/rtps/participant.h"
 #include "cyber/transport/shm/notifier_factory.h"
 #include "cyber/transport/transmitter/hybrid_transmitter.h"
 #include "cyber/transport/transmitter/intra_transmitter.h"
 #include "cyber/transport/transmitter/rtps_transmitter.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
+#include "cyber/transport/transmitter/stream_transmitter.h"
 #include "cyber/transport/transmitter/transmitter.h"
 
 namespace apollo {
@@ -108,6 +110,10 @@ auto Transport::CreateTransmitter(const RoleAttributes& attr,
           std::make_shared<RtpsTransmitter<M>>(modified_attr, participant());
       break;
 
+    case OptionalMode::STREAM:
+      transmitter = std::make_shared<StreamTransmitter<M>>(modified_attr);
+      break;
+
     default:
       transmitter =
           std::make_shared<HybridTransmitter<M>>(modified_attr, participant());
@@ -152,6 +158,11 @@ auto Transport::CreateReceiver(
       receiver = std::make_shared<RtpsReceiver<M>>(modified_attr, msg_listener);
       break;
 
+    case OptionalMode::STREAM:
+      receiver =
+          std::make_shared<StreamReceiver<M>>(modified_attr, msg_listener);
+      break;
+
     default:
       receiver = std::make_shared<HybridReceiver<M>>(
           modified_attr, msg_listener, participant());
@@ -16,6 +16,9 @@
 
 #include "modules/canbus/canbus_component.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "modules/canbus/common/canbus_gflags.h"
 #include "modules/canbus/vehicle/vehicle_factory.h"
 #include "modules/common/adapters/adapter_gflags.h"
@@ -66,6 +69,9 @@ bool CanbusComponent::Init() {
     return false;
   }
 
+  vehicle_brand_ = VehicleParameter::VehicleBrand_Name(
+      canbus_conf_.vehicle_parameter().brand());
+
   message_manager_ = vehicle_object->CreateMessageManager();
   if (message_manager_ == nullptr) {
     AERROR << "Failed to create message manager.";
@@ -167,25 +173,59 @@ bool CanbusComponent::Init() {
 }
 
 void CanbusComponent::PublishChassis() {
-  Chassis chassis = vehicle_controller_->chassis();
+  if (chassis_msg_ == nullptr || chassis_msg_.use_count() > 1) {
+    chassis_msg_ = std::make_shared<Chassis>();
+  }
+  Chassis &chassis = *chassis_msg_;
+  chassis = vehicle_controller_->chassis();
+  const int64_t send_timestamp = can_sender_.update_send_timestamp();
+  const int64_t command_timestamp = control_command_timestamp_;
+  if (send_timestamp > 0 && command_timestamp > 0) {
+    chassis.set_control_command_latency_ms(
+        static_cast<double>(send_timestamp - command_timestamp) / 1000);
+  }
   common::util::FillHeader(node_->Name(), &chassis);
-  chassis_writer_->Write(std::make_shared<Chassis>(chassis));
   ADEBUG << chassis.ShortDebugString();
+  chassis_writer_->Write(chassis_msg_);
 }
 
 void CanbusComponent::PublishChassisDetail() {
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
-  ADEBUG << chassis_detail.ShortDebugString();
-  chassis_detail_writer_->Write(
-      std::make_shared<ChassisDetail>(chassis_detail));
+  // the snapshot is shared with the vehicle controller, which only reads it,
+  // and is never written again while anyone holds it
+  auto chassis_detail = std::const_pointer_cast<ChassisDetail>(
+      message_manager_->GetSensorDataSnapshot());
+  ADEBUG << chassis_detail->ShortDebugString();
+  chassis_detail_writer_->Write(chassis_detail);
+}
+
+void CanbusComponent::RecordPublishLatency(const int64_t latency_us) {
+  if (FLAGS_chassis_publish_latency_report_cycles <= 0) {
+    return;
+  }
+  ++publish_cycles_;
+  publish_latency_sum_us_ += latency_us;
+  publish_latency_max_us_ = std::max(publish_latency_max_us_, latency_us);
+  if (publish_cycles_ < FLAGS_chassis_publish_latency_report_cycles) {
+    return;
+  }
+  AINFO << "Chassis publish latency of " << vehicle_brand_ << " over "
+        << publish_cycles_ << " cycles: avg "
+        << publish_latency_sum_us_ / publish_cycles_ << " us, max "
+        << publish_latency_max_us_ << " us.";
+  publish_cycles_ = 0;
+  publish_latency_sum_us_ = 0;
+  publish_latency_max_us_ = 0;
 }
 
 bool CanbusComponent::Proc() {
+  const auto start = std::chrono::steady_clock::now();
   PublishChassis();
   if (FLAGS_enable_chassis_detail_pub) {
     PublishChassisDetail();
   }
+  RecordPublishLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
   return true;
 }
 
@@ -212,6 +252,8 @@ void CanbusComponent::OnControlCommand(const ControlCommand &control_command) {
               "vehicle_controller_->Update error.";
     return;
   }
+  control_command_timestamp_ = static_cast<int64_t>(
+      control_command.header().timestamp_sec() * 1e6);
   can_sender_.Update();
 }
 
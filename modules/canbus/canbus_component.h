@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -82,6 +83,7 @@ class CanbusComponent final : public apollo::cyber::TimerComponent {
  private:
   void PublishChassis();
   void PublishChassisDetail();
+  void RecordPublishLatency(const int64_t latency_us);
   void OnControlCommand(const apollo::control::ControlCommand &control_command);
   void OnGuardianCommand(
       const apollo::guardian::GuardianCommand &guardian_command);
@@ -100,9 +102,19 @@ class CanbusComponent final : public apollo::cyber::TimerComponent {
       message_manager_;
   std::unique_ptr<VehicleController> vehicle_controller_;
   int64_t last_timestamp_ = 0;
+  // header time of the last control command sent to the can sender, in us
+  std::atomic<int64_t> control_command_timestamp_{0};
   ::apollo::common::monitor::MonitorLogBuffer monitor_logger_buffer_;
   std::shared_ptr<Writer<Chassis>> chassis_writer_;
   std::shared_ptr<Writer<ChassisDetail>> chassis_detail_writer_;
+  // the last published chassis, filled again once no reader holds it
+  std::shared_ptr<Chassis> chassis_msg_;
+
+  // publish latency of the vehicle over the current report cycles, in us
+  std::string vehicle_brand_;
+  int32_t publish_cycles_ = 0;
+  int64_t publish_latency_sum_us_ = 0;
+  int64_t publish_latency_max_us_ = 0;
 };
 
 CYBER_REGISTER_COMPONENT(CanbusComponent)
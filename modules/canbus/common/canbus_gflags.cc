@@ -35,6 +35,11 @@ DEFINE_int64(min_cmd_interval, 5, "Minimum control command interval in ms.");
 // chassis_detail message publish
 DEFINE_bool(enable_chassis_detail_pub, false, "Chassis Detail message publish");
 
+// chassis publish latency
+DEFINE_int32(chassis_publish_latency_report_cycles, 1000,
+             "Number of chassis publish cycles the publish latency of the "
+             "vehicle is reported over, 0 to not report it.");
+
 // canbus test files
 DEFINE_string(canbus_test_file,
               "/apollo/modules/canbus/testdata/canbus_test.pb.txt",
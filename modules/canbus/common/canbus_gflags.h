@@ -34,6 +34,9 @@ DECLARE_int64(min_cmd_interval);
 // chassis_detail message publish
 DECLARE_bool(enable_chassis_detail_pub);
 
+// chassis publish latency
+DECLARE_int32(chassis_publish_latency_report_cycles);
+
 // canbus test files
 DECLARE_string(canbus_test_file);
 
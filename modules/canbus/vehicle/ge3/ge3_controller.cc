@@ -138,8 +138,8 @@ void Ge3Controller::Stop() {
 Chassis Ge3Controller::chassis() {
   chassis_.Clear();
 
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
 
   // 21, 22, previously 1, 2
   if (driving_mode() == Chassis::EMERGENCY_MODE) {
@@ -640,8 +640,8 @@ void Ge3Controller::SetTurningSignal(const ControlCommand& command) {
 void Ge3Controller::ResetProtocol() { message_manager_->ResetSendMessages(); }
 
 bool Ge3Controller::CheckChassisError() {
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
   if (!chassis_detail.has_ge3()) {
     AERROR_EVERY(100) << "ChassisDetail has NO ge3 vehicle info."
                       << chassis_detail.DebugString();
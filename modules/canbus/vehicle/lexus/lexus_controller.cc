@@ -143,8 +143,8 @@ void LexusController::Stop() {
 Chassis LexusController::chassis() {
   chassis_.Clear();
 
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
 
   // 21, 22, previously 1, 2
   if (driving_mode() == Chassis::EMERGENCY_MODE) {
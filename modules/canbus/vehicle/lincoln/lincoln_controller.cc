@@ -149,8 +149,8 @@ void LincolnController::Stop() {
 Chassis LincolnController::chassis() {
   chassis_.Clear();
 
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
 
   // 21, 22, previously 1, 2
   if (driving_mode() == Chassis::EMERGENCY_MODE) {
@@ -352,8 +352,8 @@ Chassis LincolnController::chassis() {
   if (chassis_detail.license().has_vin()) {
     chassis_.mutable_license()->set_vin(chassis_detail.license().vin());
     if (!received_vin_) {
-      apollo::common::KVDB::Put("apollo:canbus:vin",
-                                chassis_detail.license().vin());
+      apollo::common::KVDB::PutAsync("apollo:canbus:vin",
+                                     chassis_detail.license().vin());
       received_vin_ = true;
     }
   }
@@ -471,8 +471,8 @@ void LincolnController::Gear(Chassis::GearPosition ref_gear_position) {
     return;
   }
 
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
   const Chassis::GearPosition current_gear_position =
       chassis_detail.gear().gear_state();
 
@@ -633,8 +633,8 @@ void LincolnController::ResetProtocol() {
 
 bool LincolnController::CheckChassisError() {
   // steer fault
-  ChassisDetail chassis_detail;
-  message_manager_->GetSensorData(&chassis_detail);
+  const auto detail_snapshot = message_manager_->GetSensorDataSnapshot();
+  const ChassisDetail &chassis_detail = *detail_snapshot;
 
   int32_t error_cnt = 0;
   int32_t chassis_error_mask = 0;
@@ -30,6 +30,7 @@ DECLARE_string(planning_pad_topic);
 DECLARE_string(monitor_topic);
 DECLARE_string(pad_topic);
 DECLARE_string(control_command_topic);
+DECLARE_string(control_latency_topic);
 DECLARE_string(pointcloud_topic);
 DECLARE_string(pointcloud_64_topic);
 DECLARE_string(pointcloud_128_topic);
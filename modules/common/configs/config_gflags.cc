@@ -33,6 +33,24 @@ DEFINE_string(end_way_point_filename, "default_end_way_point.txt",
               "End way point of the map, will be sent in RoutingRequest.");
 DEFINE_string(speed_control_filename, "speed_control.pb.txt",
               "The speed control region in a map.");
+DEFINE_bool(use_parallel_map_loading, false,
+            "Build the map element tables and the spatial indices of a map "
+            "on multiple threads.");
+DEFINE_bool(use_parallel_map_compiling, false,
+            "Parse the OpenDRIVE roads and create the routing topo graph "
+            "on multiple threads.");
+DEFINE_double(map_tile_size, 500.0, "Side length in meters of the map tiles.");
+DEFINE_double(map_tile_load_radius, 1000.0,
+              "Tiles within this distance to the vehicle are loaded.");
+DEFINE_double(map_tile_evict_radius, 1500.0,
+              "Loaded tiles beyond this distance to the vehicle are evicted.");
+DEFINE_double(map_tile_corridor_radius, 50.0,
+              "Tiles within this distance to the routing corridor are loaded.");
+DEFINE_bool(use_hdmap_query_cache, false,
+            "Cache the lanes around the recent map queries of every thread.");
+DEFINE_double(hdmap_query_cache_resolution, 1.0,
+              "Size in meters of the cells the cached lane queries are "
+              "quantized to.");
 
 DEFINE_string(vehicle_config_path,
               "/apollo/modules/common/data/vehicle_param.pb.txt",
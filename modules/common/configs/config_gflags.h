@@ -29,6 +29,14 @@ DECLARE_string(sim_map_filename);
 DECLARE_string(routing_map_filename);
 DECLARE_string(end_way_point_filename);
 DECLARE_string(speed_control_filename);
+DECLARE_bool(use_parallel_map_loading);
+DECLARE_bool(use_parallel_map_compiling);
+DECLARE_double(map_tile_size);
+DECLARE_double(map_tile_load_radius);
+DECLARE_double(map_tile_evict_radius);
+DECLARE_double(map_tile_corridor_radius);
+DECLARE_bool(use_hdmap_query_cache);
+DECLARE_double(hdmap_query_cache_resolution);
 
 DECLARE_double(look_forward_time_sec);
 
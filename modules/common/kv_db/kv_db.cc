@@ -17,12 +17,17 @@
 
 #include <sqlite3.h>
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "gflags/gflags.h"
 
 #include "cyber/common/log.h"
-#include "modules/common/util/file.h"
-#include "modules/common/util/string_util.h"
-#include "modules/common/util/util.h"
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db.sqlite",
               "Path to Key-value DB file.");
@@ -30,56 +35,111 @@ DEFINE_string(kv_db_path, "/apollo/data/kv_db.sqlite",
 namespace apollo {
 namespace common {
 namespace {
-using apollo::common::util::StrCat;
 
-// Self-maintained sqlite instance.
-class SqliteWraper {
+// A sqlite connection with the statements KVDB needs prepared once.
+class SqliteConnection {
  public:
-  static int Callback(void *data, int argc, char **argv, char **col_name) {
-    if (data != nullptr) {
-      std::string *data_str = static_cast<std::string*>(data);
-      *data_str = argc > 0 ? argv[0] : "";
-    }
-    return 0;
-  }
-
-  SqliteWraper() {
-    // Open DB.
-    if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != 0) {
+  SqliteConnection() {
+    if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != SQLITE_OK) {
       AERROR << "Can't open Key-Value database: " << sqlite3_errmsg(db_);
       Release();
       return;
     }
+    // Wait for the lock of the other connection rather than failing.
+    sqlite3_busy_timeout(db_, 1000);
 
-    // Create table if it doesn't exist.
-    static const char *kCreateTableSql =
+    // With WAL the readers don't block the writer nor the other way round,
+    // and a commit only syncs the log at checkpoints.
+    static const char *kSetupSql =
+        "PRAGMA journal_mode=WAL;"
+        "PRAGMA synchronous=NORMAL;"
         "CREATE TABLE IF NOT EXISTS key_value "
         "(key VARCHAR(128) PRIMARY KEY NOT NULL, value TEXT);";
-    if (!SQL(kCreateTableSql)) {
+    if (!Exec(kSetupSql) ||
+        !Prepare("INSERT OR REPLACE INTO key_value (key, value) "
+                 "VALUES (?, ?);",
+                 &put_) ||
+        !Prepare("DELETE FROM key_value WHERE key=?;", &delete_) ||
+        !Prepare("SELECT value FROM key_value WHERE key=?;", &get_)) {
       Release();
     }
   }
 
-  ~SqliteWraper() { Release(); }
+  ~SqliteConnection() { Release(); }
 
-  bool SQL(const std::string &sql, std::string *value = nullptr) {
-    AINFO << "Executing SQL: " << sql;
+  bool is_open() const { return db_ != nullptr; }
+
+  bool Exec(const char *sql) {
     if (db_ == nullptr) {
       AERROR << "DB is not open properly.";
       return false;
     }
-
     char *error = nullptr;
-    if (sqlite3_exec(db_, sql.c_str(), Callback, value, &error) != SQLITE_OK) {
-      AERROR << "Failed to execute SQL: " << error;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+      AERROR << "Failed to execute SQL: " << sql << ", " << error;
       sqlite3_free(error);
       return false;
     }
     return true;
   }
 
+  // An empty value deletes the key.
+  bool Put(const std::string &key, const std::string &value) {
+    if (value.empty()) {
+      return Step(delete_, key, nullptr) == SQLITE_DONE;
+    }
+    return Step(put_, key, &value) == SQLITE_DONE;
+  }
+
+  // Returns false on errors only, a missing key gives an empty value.
+  bool Get(const std::string &key, std::string *value) {
+    value->clear();
+    const int ret = Step(get_, key, nullptr, value);
+    return ret == SQLITE_ROW || ret == SQLITE_DONE;
+  }
+
  private:
+  bool Prepare(const char *sql, sqlite3_stmt **stmt) {
+    if (sqlite3_prepare_v2(db_, sql, -1, stmt, nullptr) != SQLITE_OK) {
+      AERROR << "Failed to prepare SQL: " << sql << ", "
+             << sqlite3_errmsg(db_);
+      return false;
+    }
+    return true;
+  }
+
+  int Step(sqlite3_stmt *stmt, const std::string &key,
+           const std::string *param, std::string *column = nullptr) {
+    if (db_ == nullptr) {
+      AERROR << "DB is not open properly.";
+      return SQLITE_ERROR;
+    }
+    sqlite3_bind_text(stmt, 1, key.data(), static_cast<int>(key.size()),
+                      SQLITE_TRANSIENT);
+    if (param != nullptr) {
+      sqlite3_bind_text(stmt, 2, param->data(),
+                        static_cast<int>(param->size()), SQLITE_TRANSIENT);
+    }
+    const int ret = sqlite3_step(stmt);
+    if (ret == SQLITE_ROW && column != nullptr) {
+      const auto *text = sqlite3_column_text(stmt, 0);
+      if (text != nullptr) {
+        column->assign(reinterpret_cast<const char *>(text),
+                       sqlite3_column_bytes(stmt, 0));
+      }
+    } else if (ret != SQLITE_DONE) {
+      AERROR << "Failed to execute SQL: " << sqlite3_errmsg(db_);
+    }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return ret;
+  }
+
   void Release() {
+    for (sqlite3_stmt *stmt : {put_, delete_, get_}) {
+      sqlite3_finalize(stmt);
+    }
+    put_ = delete_ = get_ = nullptr;
     if (db_ != nullptr) {
       sqlite3_close(db_);
       db_ = nullptr;
@@ -87,37 +147,161 @@ class SqliteWraper {
   }
 
   sqlite3 *db_ = nullptr;
+  sqlite3_stmt *put_ = nullptr;
+  sqlite3_stmt *delete_ = nullptr;
+  sqlite3_stmt *get_ = nullptr;
+};
+
+// Process-wide store in front of the DB file. Values are served from memory
+// once read or written, and the writes are committed by a background thread
+// which takes all the pending ones into a single transaction. Only the
+// latest value of a key is kept pending, an empty one meaning deleted.
+class KVStore {
+ public:
+  static KVStore *Instance() {
+    // Destroyed at exit, which commits the remaining writes.
+    static KVStore store;
+    return &store;
+  }
+
+  ~KVStore() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_one();
+    writer_thread_.join();
+  }
+
+  // Blocks until the write is committed if wait is true.
+  bool Put(const std::string &key, const std::string &value, bool wait) {
+    if (!writer_.is_open()) {
+      return false;
+    }
+    std::future<bool> committed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_[key] = value;
+      pending_[key] = value;
+      if (wait) {
+        waiters_.emplace_back();
+        committed = waiters_.back().get_future();
+      }
+    }
+    cv_.notify_one();
+    return wait ? committed.get() : true;
+  }
+
+  bool Get(const std::string &key, std::string *value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto iter = cache_.find(key);
+      if (iter != cache_.end()) {
+        *value = iter->second;
+        return true;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(reader_mutex_);
+      if (!reader_.Get(key, value)) {
+        return false;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A write which came in meanwhile is newer than what was read.
+    *value = cache_.emplace(key, *value).first->second;
+    return true;
+  }
+
+ private:
+  KVStore() : writer_thread_(&KVStore::WriterLoop, this) {}
+
+  void WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return stopped_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        break;
+      }
+      std::unordered_map<std::string, std::string> batch;
+      std::vector<std::promise<bool>> waiters;
+      batch.swap(pending_);
+      waiters.swap(waiters_);
+      lock.unlock();
+
+      const bool success = Commit(batch);
+
+      lock.lock();
+      if (!success) {
+        // Let the reads see what the DB actually holds.
+        for (const auto &entry : batch) {
+          if (pending_.count(entry.first) == 0) {
+            cache_.erase(entry.first);
+          }
+        }
+      }
+      for (auto &waiter : waiters) {
+        waiter.set_value(success);
+      }
+    }
+  }
+
+  bool Commit(const std::unordered_map<std::string, std::string> &batch) {
+    if (!writer_.Exec("BEGIN;")) {
+      return false;
+    }
+    for (const auto &entry : batch) {
+      if (!writer_.Put(entry.first, entry.second)) {
+        writer_.Exec("ROLLBACK;");
+        return false;
+      }
+    }
+    if (!writer_.Exec("COMMIT;")) {
+      writer_.Exec("ROLLBACK;");
+      return false;
+    }
+    return true;
+  }
+
+  SqliteConnection writer_;
+  std::mutex reader_mutex_;
+  SqliteConnection reader_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+  std::unordered_map<std::string, std::string> cache_;
+  std::unordered_map<std::string, std::string> pending_;
+  std::vector<std::promise<bool>> waiters_;
+  std::thread writer_thread_;
 };
 
 }  // namespace
 
 bool KVDB::Put(const std::string &key, const std::string &value) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(StrCat("INSERT OR REPLACE INTO key_value (key, value) "
-                           "VALUES ('", key, "', '", value, "');"));
+  return KVStore::Instance()->Put(key, value, true);
+}
+
+bool KVDB::PutAsync(const std::string &key, const std::string &value) {
+  return KVStore::Instance()->Put(key, value, false);
 }
 
 bool KVDB::Delete(const std::string &key) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(StrCat("DELETE FROM key_value WHERE key='", key, "';"));
+  return KVStore::Instance()->Put(key, "", true);
 }
 
 bool KVDB::Has(const std::string &key) {
-  SqliteWraper sqlite;
   std::string value;
-  const bool ret = sqlite.SQL(
-      StrCat("SELECT value FROM key_value WHERE key='", key, "';"), &value);
   // Take empty field as non-exist.
-  return ret && !value.empty();
+  return KVStore::Instance()->Get(key, &value) && !value.empty();
 }
 
 std::string KVDB::Get(const std::string &key,
                       const std::string &default_value) {
-  SqliteWraper sqlite;
   std::string value;
-  const bool ret = sqlite.SQL(
-      StrCat("SELECT value FROM key_value WHERE key='", key, "';"), &value);
-  return (ret && !value.empty()) ? value : default_value;
+  return (KVStore::Instance()->Get(key, &value) && !value.empty())
+             ? value
+             : default_value;
 }
 
 }  // namespace common
@@ -30,20 +30,29 @@ namespace common {
  *
  * @brief Lightweight key-value database to store system-wide parameters.
  *        We prefer keys like "apollo:data:commit_id".
+ *
+ *        Values are cached in memory, and writes are committed in batches by
+ *        a background thread, so reads only touch the DB file once per key.
  */
 class KVDB {
  public:
   /**
    * @brief Store {key, value} to DB.
-   * @param sync Whether flush right after writing.
-   * @return Success or not.
+   * @return Success or not, after the value is committed.
    */
   static bool Put(const std::string &key, const std::string &value);
 
+  /**
+   * @brief Store {key, value} to DB without waiting for the commit. The value
+   *        is visible to Get() right away, but may be lost on a crash or a
+   *        failed commit, so use it for non-critical keys only.
+   * @return Whether the DB is available.
+   */
+  static bool PutAsync(const std::string &key, const std::string &value);
+
   /**
    * @brief Delete a key.
-   * @param sync Whether flush right after writing.
-   * @return Success or not.
+   * @return Success or not, after the deletion is committed.
    */
   static bool Delete(const std::string &key);
 
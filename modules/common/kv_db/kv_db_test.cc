@@ -46,6 +46,23 @@ TEST(KVDBTest, GetDefault) {
   EXPECT_EQ("default", KVDB::Get("test_key", "default"));
 }
 
+TEST(KVDBTest, PutAsync) {
+  EXPECT_TRUE(KVDB::PutAsync("test_key", "val0"));
+  EXPECT_TRUE(KVDB::Has("test_key"));
+  EXPECT_EQ("val0", KVDB::Get("test_key"));
+
+  // A sync write also commits the async ones queued before it.
+  EXPECT_TRUE(KVDB::PutAsync("test_key", "val1"));
+  EXPECT_TRUE(KVDB::Put("test_key_2", "val2"));
+  EXPECT_EQ("val1", KVDB::Get("test_key"));
+  EXPECT_EQ("val2", KVDB::Get("test_key_2"));
+
+  EXPECT_TRUE(KVDB::Delete("test_key"));
+  EXPECT_TRUE(KVDB::Delete("test_key_2"));
+  EXPECT_FALSE(KVDB::Has("test_key"));
+  EXPECT_FALSE(KVDB::Has("test_key_2"));
+}
+
 TEST(KVDBTest, MultiThreads) {
   static const int N_THREADS = 10;
 
@@ -107,6 +107,24 @@ class AABoxKDTree2dNode {
     return nearest_object;
   }
 
+  /**
+   * @brief Get the nearest object to a target point by the KD-tree
+   *        rooted at this node, starting from an object known to be close.
+   * @param point The target point. Search it's nearest object.
+   * @param hint An object close to the target point, e.g. the nearest
+   *        object of a previous point nearby. Subtrees farther than it are
+   *        skipped.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point, ObjectPtr hint) const {
+    ObjectPtr nearest_object = hint;
+    double min_distance_sqr = hint == nullptr
+                                  ? std::numeric_limits<double>::infinity()
+                                  : hint->DistanceSquareTo(point);
+    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
+    return nearest_object;
+  }
+
   /**
    * @brief Get objects within a distance to a point by the KD-tree
    *        rooted at this node.
@@ -440,6 +458,17 @@ class AABoxKDTree2d {
     return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
   }
 
+  /**
+   * @brief Get the nearest object to a target point, starting from an object
+   *        known to be close.
+   * @param point The target point. Search it's nearest object.
+   * @param hint An object of the tree close to the target point.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point, ObjectPtr hint) const {
+    return root_ == nullptr ? nullptr : root_->GetNearestObject(point, hint);
+  }
+
   /**
    * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
@@ -86,8 +86,12 @@ TEST(AABoxKDTree2dNode, OverallTests) {
       }
       for (int k = 0; k < kNumTrees; ++k) {
         const Object *nearest_object = kdtrees[k]->GetNearestObject(point);
-        const double actual_distance = nearest_object->DistanceTo(point);
+        double actual_distance = nearest_object->DistanceTo(point);
         EXPECT_NEAR(actual_distance, expected_distance, 1e-3);
+        const Object *hint = &objects[i % num_boxes];
+        nearest_object = kdtrees[k]->GetNearestObject(point, hint);
+        EXPECT_NEAR(nearest_object->DistanceTo(point), expected_distance,
+                    1e-3);
       }
     }
     for (int i = 0; i < kNumQueries; ++i) {
@@ -25,6 +25,94 @@ namespace apollo {
 namespace common {
 namespace math {
 
+namespace {
+
+// Same as the single state conversion, with cos(atan2(dl, 1 - kappa * l))
+// computed without trigonometry. The results never alias the inputs; saying
+// so spares the run time checks that otherwise keep the loop from being
+// vectorized.
+void FrenetToCartesianKernel(
+    const std::size_t size, const double* __restrict rx,
+    const double* __restrict ry, const double* __restrict cos_theta_r,
+    const double* __restrict sin_theta_r, const double* __restrict rkappa,
+    const double* __restrict rdkappa, const double* __restrict s_condition,
+    const double* __restrict d_condition, double* __restrict x,
+    double* __restrict y, double* __restrict kappa, double* __restrict v,
+    double* __restrict a) {
+  for (std::size_t i = 0; i < size; ++i) {
+    const double l = d_condition[3 * i];
+    const double dl = d_condition[3 * i + 1];
+    const double ddl = d_condition[3 * i + 2];
+    const double ds = s_condition[3 * i + 1];
+    const double dds = s_condition[3 * i + 2];
+
+    x[i] = rx[i] - sin_theta_r[i] * l;
+    y[i] = ry[i] + cos_theta_r[i] * l;
+
+    const double one_minus_kappa_r_d = 1 - rkappa[i] * l;
+    const double tan_delta_theta = dl / one_minus_kappa_r_d;
+    const double cos_delta_theta =
+        one_minus_kappa_r_d /
+        std::sqrt(one_minus_kappa_r_d * one_minus_kappa_r_d + dl * dl);
+
+    const double kappa_r_d_prime = rdkappa[i] * l + rkappa[i] * dl;
+    const double kappa_x =
+        (((ddl + kappa_r_d_prime * tan_delta_theta) * cos_delta_theta *
+          cos_delta_theta) /
+             (one_minus_kappa_r_d) +
+         rkappa[i]) *
+        cos_delta_theta / (one_minus_kappa_r_d);
+    kappa[i] = kappa_x;
+
+    const double d_dot = dl * ds;
+    v[i] = std::sqrt(one_minus_kappa_r_d * one_minus_kappa_r_d * ds * ds +
+                     d_dot * d_dot);
+
+    const double delta_theta_prime =
+        one_minus_kappa_r_d / cos_delta_theta * kappa_x - rkappa[i];
+    a[i] = dds * one_minus_kappa_r_d / cos_delta_theta +
+           ds * ds / cos_delta_theta * (dl * delta_theta_prime -
+                                        kappa_r_d_prime);
+  }
+}
+
+}  // namespace
+
+void FrenetReferencePoints::Clear() {
+  s_.clear();
+  x_.clear();
+  y_.clear();
+  theta_.clear();
+  cos_theta_.clear();
+  sin_theta_.clear();
+  kappa_.clear();
+  dkappa_.clear();
+}
+
+void FrenetReferencePoints::Reserve(const std::size_t size) {
+  s_.reserve(size);
+  x_.reserve(size);
+  y_.reserve(size);
+  theta_.reserve(size);
+  cos_theta_.reserve(size);
+  sin_theta_.reserve(size);
+  kappa_.reserve(size);
+  dkappa_.reserve(size);
+}
+
+void FrenetReferencePoints::Add(const double s, const double x, const double y,
+                                const double theta, const double kappa,
+                                const double dkappa) {
+  s_.push_back(s);
+  x_.push_back(x);
+  y_.push_back(y);
+  theta_.push_back(theta);
+  cos_theta_.push_back(std::cos(theta));
+  sin_theta_.push_back(std::sin(theta));
+  kappa_.push_back(kappa);
+  dkappa_.push_back(dkappa);
+}
+
 void CartesianFrenetConverter::cartesian_to_frenet(
     const double rs, const double rx, const double ry, const double rtheta,
     const double rkappa, const double rdkappa, const double x, const double y,
@@ -130,6 +218,62 @@ void CartesianFrenetConverter::frenet_to_cartesian(
                (d_condition[1] * delta_theta_prime - kappa_r_d_prime);
 }
 
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const FrenetReferencePoints& ref_points, const std::vector<Vec2d>& points,
+    std::vector<double>* const ptr_d) {
+  const std::size_t size = points.size();
+  CHECK_EQ(size, ref_points.size());
+  ptr_d->resize(size);
+
+  const double* rx = ref_points.x().data();
+  const double* ry = ref_points.y().data();
+  const double* cos_theta_r = ref_points.cos_theta().data();
+  const double* sin_theta_r = ref_points.sin_theta().data();
+  const Vec2d* xy = points.data();
+  double* d = ptr_d->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    const double dx = xy[i].x() - rx[i];
+    const double dy = xy[i].y() - ry[i];
+    const double cross_rd_nd = cos_theta_r[i] * dy - sin_theta_r[i] * dx;
+    d[i] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+  }
+}
+
+void CartesianFrenetConverter::frenet_to_cartesian(
+    const FrenetReferencePoints& ref_points,
+    const std::vector<std::array<double, 3>>& s_conditions,
+    const std::vector<std::array<double, 3>>& d_conditions,
+    CartesianStates* const ptr_states) {
+  const std::size_t size = ref_points.size();
+  CHECK_EQ(size, s_conditions.size());
+  CHECK_EQ(size, d_conditions.size());
+  ptr_states->x.resize(size);
+  ptr_states->y.resize(size);
+  ptr_states->theta.resize(size);
+  ptr_states->kappa.resize(size);
+  ptr_states->v.resize(size);
+  ptr_states->a.resize(size);
+
+  // the conditions are contiguous triples
+  FrenetToCartesianKernel(
+      size, ref_points.x().data(), ref_points.y().data(),
+      ref_points.cos_theta().data(), ref_points.sin_theta().data(),
+      ref_points.kappa().data(), ref_points.dkappa().data(),
+      s_conditions.data()->data(), d_conditions.data()->data(),
+      ptr_states->x.data(), ptr_states->y.data(), ptr_states->kappa.data(),
+      ptr_states->v.data(), ptr_states->a.data());
+
+  for (std::size_t i = 0; i < size; ++i) {
+    CHECK(std::abs(ref_points.s()[i] - s_conditions[i][0]) < 1.0e-6)
+        << "The reference point s and s_condition[0] don't match";
+    const double one_minus_kappa_r_d =
+        1 - ref_points.kappa()[i] * d_conditions[i][0];
+    ptr_states->theta[i] = NormalizeAngle(
+        std::atan2(d_conditions[i][1], one_minus_kappa_r_d) +
+        ref_points.theta()[i]);
+  }
+}
+
 double CartesianFrenetConverter::CalculateTheta(const double rtheta,
                                                 const double rkappa,
                                                 const double l,
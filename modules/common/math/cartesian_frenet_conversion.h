@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "modules/common/math/vec2d.h"
 
@@ -28,6 +29,52 @@ namespace apollo {
 namespace common {
 namespace math {
 
+/**
+ * @class FrenetReferencePoints
+ * @brief Reference points of the batch conversions, stored per component so
+ *        that the conversions are vectorized. The cosine and sine of the
+ *        headings are computed once when the points are added.
+ */
+class FrenetReferencePoints {
+ public:
+  void Clear();
+  void Reserve(const std::size_t size);
+  void Add(const double s, const double x, const double y, const double theta,
+           const double kappa, const double dkappa);
+
+  std::size_t size() const { return s_.size(); }
+  const std::vector<double>& s() const { return s_; }
+  const std::vector<double>& x() const { return x_; }
+  const std::vector<double>& y() const { return y_; }
+  const std::vector<double>& theta() const { return theta_; }
+  const std::vector<double>& cos_theta() const { return cos_theta_; }
+  const std::vector<double>& sin_theta() const { return sin_theta_; }
+  const std::vector<double>& kappa() const { return kappa_; }
+  const std::vector<double>& dkappa() const { return dkappa_; }
+
+ private:
+  std::vector<double> s_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> theta_;
+  std::vector<double> cos_theta_;
+  std::vector<double> sin_theta_;
+  std::vector<double> kappa_;
+  std::vector<double> dkappa_;
+};
+
+/**
+ * @brief Results of the batch frenet_to_cartesian, stored per component.
+ */
+struct CartesianStates {
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> theta;
+  std::vector<double> kappa;
+  std::vector<double> v;
+  std::vector<double> a;
+};
+
 // Notations:
 // s_condition = [s, s_dot, s_ddot]
 // s: longitudinal coordinate w.r.t reference line.
@@ -76,6 +123,25 @@ class CartesianFrenetConverter {
                                   double* const ptr_kappa, double* const ptr_v,
                                   double* const ptr_a);
 
+  /**
+   * Batch version of the position conversion: the i-th point is converted
+   * w.r.t. the i-th reference point, its s is the s of the reference point.
+   */
+  static void cartesian_to_frenet(const FrenetReferencePoints& ref_points,
+                                  const std::vector<Vec2d>& points,
+                                  std::vector<double>* const ptr_d);
+
+  /**
+   * Batch version of frenet_to_cartesian: the i-th state is converted w.r.t.
+   * the i-th reference point. Only the headings are computed out of the
+   * vectorized loop.
+   */
+  static void frenet_to_cartesian(
+      const FrenetReferencePoints& ref_points,
+      const std::vector<std::array<double, 3>>& s_conditions,
+      const std::vector<std::array<double, 3>>& d_conditions,
+      CartesianStates* const ptr_states);
+
   // given sl point extract x, y, theta, kappa
   static double CalculateTheta(const double rtheta, const double rkappa,
                                const double l, const double dl);
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -65,6 +66,63 @@ TEST(TestCartesianFrenetConversion, cartesian_to_frenet_test) {
   EXPECT_NEAR(a, a_out, 1.0e-6);
 }
 
+TEST(TestCartesianFrenetConversion, batch_test) {
+  FrenetReferencePoints ref_points;
+  std::vector<Vec2d> points;
+  std::vector<std::array<double, 3>> s_conditions;
+  std::vector<std::array<double, 3>> d_conditions;
+  for (int i = 0; i < 37; ++i) {
+    const double rs = 10.0 + i;
+    const double rtheta = -M_PI + 0.17 * i;
+    const double rkappa = 0.01 * (i % 7) - 0.03;
+    const double rdkappa = 0.001 * (i % 5);
+    ref_points.Add(rs, 0.5 * i, -0.2 * i, rtheta, rkappa, rdkappa);
+    points.emplace_back(0.5 * i + 1.5 * std::sin(0.3 * i), -0.2 * i + 1.0);
+    s_conditions.push_back({rs, 2.0 + 0.1 * i, 0.5 - 0.05 * i});
+    d_conditions.push_back(
+        {1.5 * std::cos(0.4 * i), 0.1 * std::sin(0.7 * i), 0.01 * (i % 3)});
+  }
+
+  std::vector<double> ds;
+  CartesianFrenetConverter::cartesian_to_frenet(ref_points, points, &ds);
+  CartesianStates states;
+  CartesianFrenetConverter::frenet_to_cartesian(ref_points, s_conditions,
+                                                d_conditions, &states);
+  ASSERT_EQ(points.size(), ds.size());
+  ASSERT_EQ(points.size(), states.x.size());
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const double rs = ref_points.s()[i];
+    const double rx = ref_points.x()[i];
+    const double ry = ref_points.y()[i];
+    const double rtheta = ref_points.theta()[i];
+    const double rkappa = ref_points.kappa()[i];
+    const double rdkappa = ref_points.dkappa()[i];
+
+    double s = 0.0;
+    double d = 0.0;
+    CartesianFrenetConverter::cartesian_to_frenet(
+        rs, rx, ry, rtheta, points[i].x(), points[i].y(), &s, &d);
+    EXPECT_NEAR(d, ds[i], 1.0e-9);
+
+    double x = 0.0;
+    double y = 0.0;
+    double theta = 0.0;
+    double kappa = 0.0;
+    double v = 0.0;
+    double a = 0.0;
+    CartesianFrenetConverter::frenet_to_cartesian(
+        rs, rx, ry, rtheta, rkappa, rdkappa, s_conditions[i], d_conditions[i],
+        &x, &y, &theta, &kappa, &v, &a);
+    EXPECT_NEAR(x, states.x[i], 1.0e-9);
+    EXPECT_NEAR(y, states.y[i], 1.0e-9);
+    EXPECT_NEAR(theta, states.theta[i], 1.0e-9);
+    EXPECT_NEAR(kappa, states.kappa[i], 1.0e-9);
+    EXPECT_NEAR(v, states.v[i], 1.0e-9);
+    EXPECT_NEAR(a, states.a[i], 1.0e-9);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -242,11 +242,14 @@ inline void ExtendedKalmanFilter<T, XN, ZN, UN>::Correct(
 
   S_ = H_ * P_ * H_.transpose() + R_;
 
-  K_ = P_ * H_.transpose() * PseudoInverse<T, ZN>(S_);
+  K_ = MultiplyByCovarianceInverse<T, XN, ZN>(P_ * H_.transpose(), S_);
 
   x_ = x_ + K_ * y_;
 
-  P_ = (Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_) * P_;
+  // Joseph form, which keeps P symmetric and positive semi-definite
+  const Eigen::Matrix<T, XN, XN> I_KH =
+      Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_;
+  P_ = I_KH * P_ * I_KH.transpose() + K_ * R_ * K_.transpose();
 }
 
 }  // namespace math
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Polynomial approximations of sin, cos, atan2 and exp with a bounded
+ *        error. They are inline and branch free: both sides of a selection
+ *        are computed, so that the loops calling them can be vectorized.
+ *
+ * GCC only vectorizes such loops with -fno-trapping-math in the copts of the
+ * calling target. Without it, FastSin, FastCos and FastAtan2 are still about
+ * twice as fast as libm, but FastExp is slower than the table based exp of
+ * glibc; see fast_math_benchmark.
+ *
+ * The Relaxed* functions are meant for the paths which do not need the libm
+ * accuracy, like cost evaluation and visualization. They call libm unless
+ * the build defines USE_FAST_MATH, e.g. with --define FAST_MATH=true.
+ * Geometry used for collision checking should keep calling libm.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace fast_math_internal {
+
+// pi / 2 split in a part with a short mantissa and the remainder, so that
+// q * kPiOver2Hi is exact for the quadrants of |x| < 1e6
+constexpr double kTwoOverPi = 0.63661977236758134308;
+constexpr double kPiOver2Hi = 1.57079632673412561417e+00;
+constexpr double kPiOver2Lo = 6.07710050650619224932e-11;
+constexpr double kPiOver4 = 0.78539816339744830962;
+constexpr double kPiOver2 = 1.57079632679489661923;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kTanPiOver8 = 0.41421356237309504880;
+
+// the same split for ln(2)
+constexpr double kLog2E = 1.44269504088896340736;
+constexpr double kLn2Hi = 6.93147180369123816490e-01;
+constexpr double kLn2Lo = 1.90821492927058770002e-10;
+constexpr double kExpMax = 709.78271289338397;
+constexpr double kExpMin = -708.0;
+
+// adding 1.5 * 2^52 rounds |v| < 2^51 to the nearest integer, which is then
+// held in two's complement by the low bits of the sum. Unlike nearbyint, it
+// vectorizes without SSE4.1, but it must not be built with -ffast-math.
+constexpr double kRoundShift = 6755399441055744.0;
+
+inline double RoundShifted(const double v) { return v + kRoundShift; }
+
+inline int64_t ShiftedBits(const double shifted) {
+  int64_t bits = 0;
+  std::memcpy(&bits, &shifted, sizeof(double));
+  return bits;
+}
+
+// sin(r) and cos(r) for |r| <= pi / 4, from their Taylor series
+inline double SinKernel(const double r) {
+  const double r2 = r * r;
+  return r + r * r2 *
+                 (-1.0 / 6.0 +
+                  r2 * (1.0 / 120.0 +
+                        r2 * (-1.0 / 5040.0 +
+                              r2 * (1.0 / 362880.0 +
+                                    r2 * (-1.0 / 39916800.0)))));
+}
+
+inline double CosKernel(const double r) {
+  const double r2 = r * r;
+  return 1.0 - 0.5 * r2 +
+         r2 * r2 *
+             (1.0 / 24.0 +
+              r2 * (-1.0 / 720.0 +
+                    r2 * (1.0 / 40320.0 +
+                          r2 * (-1.0 / 3628800.0 +
+                                r2 * (1.0 / 479001600.0)))));
+}
+
+// the quadrant of x and x reduced to [-pi / 4, pi / 4]
+inline int64_t ReduceToQuadrant(const double x, double* const r) {
+  const double shifted = RoundShifted(x * kTwoOverPi);
+  const double q = shifted - kRoundShift;
+  *r = (x - q * kPiOver2Hi) - q * kPiOver2Lo;
+  return ShiftedBits(shifted);
+}
+
+// atan(t) for 0 <= t <= tan(pi / 8), from a Chebyshev interpolation of
+// atan(t) / t in t^2
+inline double AtanKernel(const double t) {
+  const double s = t * t;
+  return t * (0.99999999997839872 +
+              s * (-0.33333332097609419 +
+                   s * (0.19999883856553433 +
+                        s * (-0.142815887727062 +
+                             s * (0.11040489227792956 +
+                                  s * (-0.084561928898677932 +
+                                       s * 0.04707348147569243))))));
+}
+
+}  // namespace fast_math_internal
+
+/**
+ * @brief Approximation of std::sin, with an absolute error below 1e-10 for
+ *        |x| < 1e6.
+ */
+inline double FastSin(const double x) {
+  double r = 0.0;
+  const int64_t quadrant = fast_math_internal::ReduceToQuadrant(x, &r);
+  const double sin_r = fast_math_internal::SinKernel(r);
+  const double cos_r = fast_math_internal::CosKernel(r);
+  const double s = (quadrant & 1) ? cos_r : sin_r;
+  return (quadrant & 2) ? -s : s;
+}
+
+/**
+ * @brief Approximation of std::cos, with an absolute error below 1e-10 for
+ *        |x| < 1e6.
+ */
+inline double FastCos(const double x) {
+  double r = 0.0;
+  const int64_t quadrant = fast_math_internal::ReduceToQuadrant(x, &r);
+  const double sin_r = fast_math_internal::SinKernel(r);
+  const double cos_r = fast_math_internal::CosKernel(r);
+  const double c = (quadrant & 1) ? sin_r : cos_r;
+  return ((quadrant + 1) & 2) ? -c : c;
+}
+
+/**
+ * @brief Approximation of std::atan2 for finite inputs, with an absolute error
+ *        below 1e-10. Returns 0 for the origin, whatever the signs of zeros.
+ */
+inline double FastAtan2(const double y, const double x) {
+  using fast_math_internal::kPi;
+  using fast_math_internal::kPiOver2;
+  using fast_math_internal::kPiOver4;
+  const double abs_x = std::fabs(x);
+  const double abs_y = std::fabs(y);
+  const double max_xy = abs_y > abs_x ? abs_y : abs_x;
+  const double min_xy = abs_y > abs_x ? abs_x : abs_y;
+  const double a = min_xy / (max_xy > 0.0 ? max_xy : 1.0);
+  // atan(a) = pi / 4 + atan((a - 1) / (a + 1))
+  const bool reduce = a > fast_math_internal::kTanPiOver8;
+  const double reduced_a = (a - 1.0) / (a + 1.0);
+  const double t = reduce ? reduced_a : a;
+  const double atan_t = std::copysign(
+      fast_math_internal::AtanKernel(std::fabs(t)), t);
+  double angle = reduce ? kPiOver4 + atan_t : atan_t;
+  angle = abs_y > abs_x ? kPiOver2 - angle : angle;
+  angle = x < 0.0 ? kPi - angle : angle;
+  return y < 0.0 ? -angle : angle;
+}
+
+/**
+ * @brief Approximation of std::exp for finite x, with a relative error below
+ *        1e-12. Returns 0 below -708 instead of the subnormal values.
+ */
+inline double FastExp(const double x) {
+  using fast_math_internal::kExpMax;
+  using fast_math_internal::kExpMin;
+  // exp(x) = 2^n * exp(g), with |g| <= ln(2) / 2
+  const double clamped_x =
+      x < kExpMin ? kExpMin : (x > kExpMax ? kExpMax : x);
+  const double shifted =
+      fast_math_internal::RoundShifted(clamped_x * fast_math_internal::kLog2E);
+  const double n = shifted - fast_math_internal::kRoundShift;
+  const double g = (clamped_x - n * fast_math_internal::kLn2Hi) -
+                   n * fast_math_internal::kLn2Lo;
+  // Taylor series of exp(g) up to g^11, with Horner's method
+  double exp_g = 1.0 / 39916800.0;
+  exp_g = exp_g * g + 1.0 / 3628800.0;
+  exp_g = exp_g * g + 1.0 / 362880.0;
+  exp_g = exp_g * g + 1.0 / 40320.0;
+  exp_g = exp_g * g + 1.0 / 5040.0;
+  exp_g = exp_g * g + 1.0 / 720.0;
+  exp_g = exp_g * g + 1.0 / 120.0;
+  exp_g = exp_g * g + 1.0 / 24.0;
+  exp_g = exp_g * g + 1.0 / 6.0;
+  exp_g = exp_g * g + 1.0 / 2.0;
+  exp_g = exp_g * g + 1.0;
+  exp_g = exp_g * g + 1.0;
+  // n is in [-1021, 1024] and 2^(n - 1) is always a normal number; the
+  // shift drops the high bits of the shifted sum
+  const int64_t scale_bits =
+      (fast_math_internal::ShiftedBits(shifted) + 1022) << 52;
+  double scale = 0.0;
+  std::memcpy(&scale, &scale_bits, sizeof(double));
+  // the result is always used, so that it is not computed in a branch
+  const bool in_range = x >= kExpMin && x <= kExpMax;
+  const double overflow =
+      x > kExpMax ? std::numeric_limits<double>::infinity() : 0.0;
+  return exp_g * scale * (in_range ? 2.0 : 0.0) + overflow;
+}
+
+#if USE_FAST_MATH
+
+inline double RelaxedSin(const double x) { return FastSin(x); }
+inline double RelaxedCos(const double x) { return FastCos(x); }
+inline double RelaxedAtan2(const double y, const double x) {
+  return FastAtan2(y, x);
+}
+
+#else
+
+inline double RelaxedSin(const double x) { return std::sin(x); }
+inline double RelaxedCos(const double x) { return std::cos(x); }
+inline double RelaxedAtan2(const double y, const double x) {
+  return std::atan2(y, x);
+}
+
+#endif
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file fast_math_benchmark.cc
+ * @brief Compares the throughput of the fast_math approximations with libm on
+ *        arrays of inputs, and reports their largest error as a counter.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "modules/common/math/fast_math.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+constexpr int kNumInputs = 4096;
+
+std::vector<double> MakeInputs(const double min, const double max) {
+  std::vector<double> inputs(kNumInputs);
+  for (int i = 0; i < kNumInputs; ++i) {
+    inputs[i] = min + (max - min) * i / (kNumInputs - 1);
+  }
+  return inputs;
+}
+
+template <typename Function>
+void RunUnary(benchmark::State& state, const std::vector<double>& inputs,
+              Function function) {
+  std::vector<double> outputs(inputs.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      outputs[i] = function(inputs[i]);
+    }
+    benchmark::DoNotOptimize(outputs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+// the points of the unit circle, as atan2 inputs
+void MakeCircle(std::vector<double>* const xs, std::vector<double>* const ys) {
+  for (const double angle : MakeInputs(-M_PI, M_PI)) {
+    xs->push_back(std::cos(angle));
+    ys->push_back(std::sin(angle));
+  }
+}
+
+template <typename Function>
+void RunBinary(benchmark::State& state, const std::vector<double>& ys,
+               const std::vector<double>& xs, Function function) {
+  std::vector<double> outputs(xs.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      outputs[i] = function(ys[i], xs[i]);
+    }
+    benchmark::DoNotOptimize(outputs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * xs.size());
+}
+
+// largest absolute, or relative, difference with the libm function
+template <typename Function, typename Reference>
+double MaxError(const std::vector<double>& inputs, Function function,
+                Reference reference, const bool relative) {
+  double max_error = 0.0;
+  for (const double x : inputs) {
+    const double expected = reference(x);
+    const double error = std::fabs(function(x) - expected);
+    max_error = std::max(
+        max_error, relative ? error / std::fabs(expected) : error);
+  }
+  return max_error;
+}
+
+}  // namespace
+
+static void BM_LibmSin(benchmark::State& state) {  // NOLINT
+  RunUnary(state, MakeInputs(-10.0, 10.0),
+           [](const double x) { return std::sin(x); });
+}
+BENCHMARK(BM_LibmSin);
+
+static void BM_FastSin(benchmark::State& state) {  // NOLINT
+  const std::vector<double> inputs = MakeInputs(-10.0, 10.0);
+  RunUnary(state, inputs, [](const double x) { return FastSin(x); });
+  state.counters["max_error"] = MaxError(
+      inputs, FastSin, [](const double x) { return std::sin(x); }, false);
+}
+BENCHMARK(BM_FastSin);
+
+static void BM_LibmCos(benchmark::State& state) {  // NOLINT
+  RunUnary(state, MakeInputs(-10.0, 10.0),
+           [](const double x) { return std::cos(x); });
+}
+BENCHMARK(BM_LibmCos);
+
+static void BM_FastCos(benchmark::State& state) {  // NOLINT
+  const std::vector<double> inputs = MakeInputs(-10.0, 10.0);
+  RunUnary(state, inputs, [](const double x) { return FastCos(x); });
+  state.counters["max_error"] = MaxError(
+      inputs, FastCos, [](const double x) { return std::cos(x); }, false);
+}
+BENCHMARK(BM_FastCos);
+
+static void BM_LibmAtan2(benchmark::State& state) {  // NOLINT
+  std::vector<double> xs;
+  std::vector<double> ys;
+  MakeCircle(&xs, &ys);
+  RunBinary(state, ys, xs,
+            [](const double y, const double x) { return std::atan2(y, x); });
+}
+BENCHMARK(BM_LibmAtan2);
+
+static void BM_FastAtan2(benchmark::State& state) {  // NOLINT
+  std::vector<double> xs;
+  std::vector<double> ys;
+  MakeCircle(&xs, &ys);
+  RunBinary(state, ys, xs,
+            [](const double y, const double x) { return FastAtan2(y, x); });
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    max_error = std::max(max_error, std::fabs(FastAtan2(ys[i], xs[i]) -
+                                              std::atan2(ys[i], xs[i])));
+  }
+  state.counters["max_error"] = max_error;
+}
+BENCHMARK(BM_FastAtan2);
+
+static void BM_LibmExp(benchmark::State& state) {  // NOLINT
+  RunUnary(state, MakeInputs(-20.0, 20.0),
+           [](const double x) { return std::exp(x); });
+}
+BENCHMARK(BM_LibmExp);
+
+static void BM_FastExp(benchmark::State& state) {  // NOLINT
+  const std::vector<double> inputs = MakeInputs(-20.0, 20.0);
+  RunUnary(state, inputs, [](const double x) { return FastExp(x); });
+  state.counters["max_error"] = MaxError(
+      inputs, FastExp, [](const double x) { return std::exp(x); }, true);
+}
+BENCHMARK(BM_FastExp);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/fast_math.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(FastMathTest, SinCos) {
+  for (int i = -200000; i <= 200000; ++i) {
+    const double x = i * 1e-3;
+    EXPECT_NEAR(FastSin(x), std::sin(x), 1e-10) << x;
+    EXPECT_NEAR(FastCos(x), std::cos(x), 1e-10) << x;
+  }
+  for (const double x : {-9.9e5, -12345.678, 0.0, 31415.9265, 9.9e5}) {
+    EXPECT_NEAR(FastSin(x), std::sin(x), 1e-10) << x;
+    EXPECT_NEAR(FastCos(x), std::cos(x), 1e-10) << x;
+  }
+}
+
+TEST(FastMathTest, Atan2) {
+  for (int i = 0; i < 3600; ++i) {
+    const double angle = i * M_PI / 1800.0;
+    for (const double radius : {1e-12, 1e-3, 1.0, 1e3, 1e12}) {
+      const double x = radius * std::cos(angle);
+      const double y = radius * std::sin(angle);
+      EXPECT_NEAR(FastAtan2(y, x), std::atan2(y, x), 1e-10) << x << ", " << y;
+    }
+  }
+  EXPECT_DOUBLE_EQ(FastAtan2(0.0, 0.0), 0.0);
+  EXPECT_DOUBLE_EQ(FastAtan2(0.0, -1.0), M_PI);
+  EXPECT_DOUBLE_EQ(FastAtan2(1.0, 0.0), M_PI_2);
+  EXPECT_DOUBLE_EQ(FastAtan2(-1.0, 0.0), -M_PI_2);
+}
+
+TEST(FastMathTest, Exp) {
+  for (int i = -708000; i <= 709000; ++i) {
+    const double x = i * 1e-3;
+    const double expected = std::exp(x);
+    EXPECT_NEAR(FastExp(x), expected, expected * 1e-12) << x;
+  }
+  EXPECT_DOUBLE_EQ(FastExp(0.0), 1.0);
+  EXPECT_DOUBLE_EQ(FastExp(-800.0), 0.0);
+  EXPECT_EQ(FastExp(710.0), std::numeric_limits<double>::infinity());
+  EXPECT_NEAR(FastExp(709.78), std::exp(709.78), std::exp(709.78) * 1e-12);
+}
+
+TEST(FastMathTest, Relaxed) {
+  // libm unless the build defines USE_FAST_MATH
+  EXPECT_NEAR(RelaxedSin(0.5), std::sin(0.5), 1e-10);
+  EXPECT_NEAR(RelaxedCos(0.5), std::cos(0.5), 1e-10);
+  EXPECT_NEAR(RelaxedAtan2(0.5, -2.0), std::atan2(0.5, -2.0), 1e-10);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,510 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the templated FlatAABoxKDTree2d class.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/math_utils.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief The math namespace deals with a number of useful mathematical objects.
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class FlatAABoxKDTree2d
+ * @brief A bounding volume hierarchy of axis-aligned bounding boxes with the
+ *        same queries as AABoxKDTree2d. The nodes are stored breadth-first in
+ *        one array, every node holds the boxes of its four children packed
+ *        per coordinate so that the four boxes are tested in one vectorized
+ *        loop, and the objects under every node are contiguous.
+ */
+template <class ObjectType>
+class FlatAABoxKDTree2d {
+ public:
+  using ObjectPtr = const ObjectType *;
+
+  /// The number of children of a node.
+  static constexpr int kWidth = 4;
+
+  /**
+   * @brief Contructor which takes a vector of objects and parameters.
+   * @param objects Objects to build the tree, which must outlive it.
+   * @param params Parameters to build the tree, the depth counts the binary
+   *        splits as in AABoxKDTree2d.
+   */
+  FlatAABoxKDTree2d(const std::vector<ObjectType> &objects,
+                    const AABoxKDTreeParams &params)
+      : params_(params) {
+    objects_.reserve(objects.size());
+    for (const auto &object : objects) {
+      objects_.push_back(&object);
+    }
+    if (!objects_.empty()) {
+      Build();
+    }
+  }
+
+  /**
+   * @brief Get the nearest object to a target point.
+   * @param point The target point. Search it's nearest object.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point) const {
+    return GetNearestObject(point, nullptr);
+  }
+
+  /**
+   * @brief Get the nearest object to a target point, starting from an object
+   *        known to be close.
+   * @param point The target point. Search it's nearest object.
+   * @param hint An object of the tree close to the target point.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point, ObjectPtr hint) const {
+    if (nodes_.empty()) {
+      return nullptr;
+    }
+    ObjectPtr nearest_object = hint;
+    double min_distance_sqr = hint == nullptr
+                                  ? std::numeric_limits<double>::infinity()
+                                  : hint->DistanceSquareTo(point);
+    GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
+    return nearest_object;
+  }
+
+  /**
+   * @brief Get the nearest objects to a sequence of points, e.g. the points
+   *        of a trajectory. The nearest object to a point seeds the search
+   *        of the next point.
+   * @param points The target points.
+   * @return The nearest object to every point.
+   */
+  std::vector<ObjectPtr> GetNearestObjects(
+      const std::vector<Vec2d> &points) const {
+    std::vector<ObjectPtr> nearest_objects;
+    nearest_objects.reserve(points.size());
+    ObjectPtr hint = nullptr;
+    for (const auto &point : points) {
+      hint = GetNearestObject(point, hint);
+      nearest_objects.push_back(hint);
+    }
+    return nearest_objects;
+  }
+
+  /**
+   * @brief Get objects within a distance to a point.
+   * @param point The center point of the range to search objects.
+   * @param distance The radius of the range to search objects.
+   * @return All objects within the specified distance to the specified point.
+   */
+  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
+                                    const double distance) const {
+    std::vector<ObjectPtr> result_objects;
+    if (nodes_.empty()) {
+      return result_objects;
+    }
+    const double distance_sqr = Square(distance);
+    int stack[kMaxStackSize];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const Node &node = nodes_[stack[--stack_size]];
+      double lower_distance_sqr[kWidth];
+      double upper_distance_sqr[kWidth];
+      LowerDistanceSquares(node, point, lower_distance_sqr);
+      UpperDistanceSquares(node, point, upper_distance_sqr);
+      for (int k = 0; k < kWidth; ++k) {
+        if (lower_distance_sqr[k] > distance_sqr) {
+          continue;
+        }
+        if (upper_distance_sqr[k] <= distance_sqr) {
+          result_objects.insert(result_objects.end(),
+                                objects_.begin() + node.begin[k],
+                                objects_.begin() + node.end[k]);
+        } else if (node.child[k] >= 0) {
+          stack[stack_size++] = node.child[k];
+        } else {
+          AddObjectsInRange(node.begin[k], node.end[k], point, distance_sqr,
+                            &result_objects);
+        }
+      }
+    }
+    return result_objects;
+  }
+
+  /**
+   * @brief Get objects within a distance to every point of a batch, in one
+   *        traversal of the nodes around the batch.
+   * @param points The center points of the ranges to search objects.
+   * @param distance The radius of the ranges to search objects.
+   * @return The objects within the distance to every point.
+   */
+  std::vector<std::vector<ObjectPtr>> GetObjects(
+      const std::vector<Vec2d> &points, const double distance) const {
+    std::vector<std::vector<ObjectPtr>> result_objects(points.size());
+    if (nodes_.empty() || points.empty()) {
+      return result_objects;
+    }
+    // the box of the ranges of all the points
+    double query_min_x = std::numeric_limits<double>::infinity();
+    double query_min_y = std::numeric_limits<double>::infinity();
+    double query_max_x = -std::numeric_limits<double>::infinity();
+    double query_max_y = -std::numeric_limits<double>::infinity();
+    for (const auto &point : points) {
+      query_min_x = std::min(query_min_x, point.x() - distance);
+      query_min_y = std::min(query_min_y, point.y() - distance);
+      query_max_x = std::max(query_max_x, point.x() + distance);
+      query_max_y = std::max(query_max_y, point.y() + distance);
+    }
+    const double distance_sqr = Square(distance);
+    int stack[kMaxStackSize];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const Node &node = nodes_[stack[--stack_size]];
+      bool is_overlapped[kWidth];
+      for (int k = 0; k < kWidth; ++k) {
+        is_overlapped[k] =
+            node.min_x[k] <= query_max_x && node.max_x[k] >= query_min_x &&
+            node.min_y[k] <= query_max_y && node.max_y[k] >= query_min_y;
+      }
+      for (int k = 0; k < kWidth; ++k) {
+        if (!is_overlapped[k]) {
+          continue;
+        }
+        if (node.child[k] >= 0) {
+          stack[stack_size++] = node.child[k];
+          continue;
+        }
+        for (size_t i = 0; i < points.size(); ++i) {
+          if (LowerDistanceSquare(node, k, points[i]) <= distance_sqr) {
+            AddObjectsInRange(node.begin[k], node.end[k], points[i],
+                              distance_sqr, &result_objects[i]);
+          }
+        }
+      }
+    }
+    return result_objects;
+  }
+
+  /**
+   * @brief Get the axis-aligned bounding box of the objects.
+   * @return The axis-aligned bounding box of the objects.
+   */
+  AABox2d GetBoundingBox() const {
+    return nodes_.empty() ? AABox2d()
+                          : AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+  }
+
+ private:
+  // the traversal stack grows by at most kWidth - 1 per level
+  static constexpr int kMaxStackSize = 64;
+  static constexpr int kMaxNumLevels = (kMaxStackSize - 1) / (kWidth - 1);
+
+  struct Node {
+    // the boxes of the children, empty for the unused ones
+    double min_x[kWidth];
+    double min_y[kWidth];
+    double max_x[kWidth];
+    double max_y[kWidth];
+    // the child node, -1 if the child is a leaf or unused
+    int child[kWidth];
+    // objects_[begin, end) are under the child
+    int begin[kWidth];
+    int end[kWidth];
+  };
+
+  struct Box {
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+  };
+
+  struct Range {
+    int begin = 0;
+    int end = 0;
+    // the number of binary splits above the range
+    int depth = 0;
+    // the boundary of the objects in the range
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+  };
+
+  void Build() {
+    std::deque<std::pair<int, Range>> pending_nodes;
+    nodes_.emplace_back();
+    const Range root = MakeRange(0, static_cast<int>(objects_.size()), 0);
+    min_x_ = root.min_x;
+    min_y_ = root.min_y;
+    max_x_ = root.max_x;
+    max_y_ = root.max_y;
+    pending_nodes.emplace_back(0, root);
+    std::vector<int> levels(1, 1);
+    while (!pending_nodes.empty()) {
+      const int node_index = pending_nodes.front().first;
+      const Range range = pending_nodes.front().second;
+      pending_nodes.pop_front();
+
+      // two rounds of binary splits give up to four children
+      std::vector<Range> children(1, range);
+      for (int round = 0; round < 2; ++round) {
+        std::vector<Range> split_children;
+        for (const Range &child : children) {
+          if (ShouldSplit(child)) {
+            const int middle = Split(child);
+            split_children.push_back(
+                MakeRange(child.begin, middle, child.depth + 1));
+            split_children.push_back(
+                MakeRange(middle, child.end, child.depth + 1));
+          } else {
+            split_children.push_back(child);
+          }
+        }
+        children.swap(split_children);
+      }
+
+      InitNode(&nodes_[node_index]);
+      for (size_t k = 0; k < children.size(); ++k) {
+        const Range &child = children[k];
+        Node &node = nodes_[node_index];
+        node.min_x[k] = child.min_x;
+        node.min_y[k] = child.min_y;
+        node.max_x[k] = child.max_x;
+        node.max_y[k] = child.max_y;
+        node.begin[k] = child.begin;
+        node.end[k] = child.end;
+        if (ShouldSplit(child)) {
+          const int child_index = static_cast<int>(nodes_.size());
+          node.child[k] = child_index;
+          // invalidates node
+          nodes_.emplace_back();
+          levels.push_back(levels[node_index] + 1);
+          CHECK_LE(levels.back(), kMaxNumLevels);
+          pending_nodes.emplace_back(child_index, child);
+        }
+      }
+    }
+    object_boxes_.reserve(objects_.size());
+    for (ObjectPtr object : objects_) {
+      const AABox2d &aabox = object->aabox();
+      object_boxes_.push_back(
+          {aabox.min_x(), aabox.min_y(), aabox.max_x(), aabox.max_y()});
+    }
+  }
+
+  bool ShouldSplit(const Range &range) const {
+    if (params_.max_depth >= 0 && range.depth >= params_.max_depth) {
+      return false;
+    }
+    if (range.end - range.begin <= std::max(1, params_.max_leaf_size)) {
+      return false;
+    }
+    if (params_.max_leaf_dimension >= 0.0 &&
+        std::max(range.max_x - range.min_x, range.max_y - range.min_y) <=
+            params_.max_leaf_dimension) {
+      return false;
+    }
+    return true;
+  }
+
+  // splits the objects at the median of their centers along the longer
+  // axis of their boundary, and returns the index of the median
+  int Split(const Range &range) {
+    const bool split_x =
+        range.max_x - range.min_x >= range.max_y - range.min_y;
+    const int middle = (range.begin + range.end) / 2;
+    std::nth_element(objects_.begin() + range.begin, objects_.begin() + middle,
+                     objects_.begin() + range.end,
+                     [split_x](ObjectPtr obj1, ObjectPtr obj2) {
+                       return split_x ? obj1->aabox().center_x() <
+                                            obj2->aabox().center_x()
+                                      : obj1->aabox().center_y() <
+                                            obj2->aabox().center_y();
+                     });
+    return middle;
+  }
+
+  Range MakeRange(const int begin, const int end, const int depth) const {
+    Range range;
+    range.begin = begin;
+    range.end = end;
+    range.depth = depth;
+    range.min_x = std::numeric_limits<double>::infinity();
+    range.min_y = std::numeric_limits<double>::infinity();
+    range.max_x = -std::numeric_limits<double>::infinity();
+    range.max_y = -std::numeric_limits<double>::infinity();
+    for (int i = begin; i < end; ++i) {
+      const AABox2d &aabox = objects_[i]->aabox();
+      range.min_x = std::fmin(range.min_x, aabox.min_x());
+      range.min_y = std::fmin(range.min_y, aabox.min_y());
+      range.max_x = std::fmax(range.max_x, aabox.max_x());
+      range.max_y = std::fmax(range.max_y, aabox.max_y());
+    }
+    CHECK(!std::isinf(range.max_x) && !std::isinf(range.max_y) &&
+          !std::isinf(range.min_x) && !std::isinf(range.min_y))
+        << "the provided object box size is infinity";
+    return range;
+  }
+
+  static void InitNode(Node *node) {
+    for (int k = 0; k < kWidth; ++k) {
+      node->min_x[k] = std::numeric_limits<double>::infinity();
+      node->min_y[k] = std::numeric_limits<double>::infinity();
+      node->max_x[k] = -std::numeric_limits<double>::infinity();
+      node->max_y[k] = -std::numeric_limits<double>::infinity();
+      node->child[k] = -1;
+      node->begin[k] = 0;
+      node->end[k] = 0;
+    }
+  }
+
+  // the unused children are infinitely far
+  static void LowerDistanceSquares(const Node &node, const Vec2d &point,
+                                   double *distance_sqr) {
+    const double x = point.x();
+    const double y = point.y();
+    for (int k = 0; k < kWidth; ++k) {
+      const double dx =
+          std::max(std::max(node.min_x[k] - x, x - node.max_x[k]), 0.0);
+      const double dy =
+          std::max(std::max(node.min_y[k] - y, y - node.max_y[k]), 0.0);
+      distance_sqr[k] = dx * dx + dy * dy;
+    }
+  }
+
+  static double LowerDistanceSquare(const Node &node, const int k,
+                                    const Vec2d &point) {
+    const double dx = std::max(
+        std::max(node.min_x[k] - point.x(), point.x() - node.max_x[k]), 0.0);
+    const double dy = std::max(
+        std::max(node.min_y[k] - point.y(), point.y() - node.max_y[k]), 0.0);
+    return dx * dx + dy * dy;
+  }
+
+  // the distance to the farthest corner of the children
+  static void UpperDistanceSquares(const Node &node, const Vec2d &point,
+                                   double *distance_sqr) {
+    const double x = point.x();
+    const double y = point.y();
+    for (int k = 0; k < kWidth; ++k) {
+      const double dx = std::max(x - node.min_x[k], node.max_x[k] - x);
+      const double dy = std::max(y - node.min_y[k], node.max_y[k] - y);
+      distance_sqr[k] = dx * dx + dy * dy;
+    }
+  }
+
+  // the distance to the box of an object bounds the distance to the object
+  double ObjectLowerDistanceSquare(const int i, const Vec2d &point) const {
+    const double dx = std::max(
+        std::max(object_boxes_[i].min_x - point.x(),
+                 point.x() - object_boxes_[i].max_x),
+        0.0);
+    const double dy = std::max(
+        std::max(object_boxes_[i].min_y - point.y(),
+                 point.y() - object_boxes_[i].max_y),
+        0.0);
+    return dx * dx + dy * dy;
+  }
+
+  void AddObjectsInRange(const int begin, const int end, const Vec2d &point,
+                         const double distance_sqr,
+                         std::vector<ObjectPtr> *const result_objects) const {
+    for (int i = begin; i < end; ++i) {
+      if (ObjectLowerDistanceSquare(i, point) <= distance_sqr &&
+          objects_[i]->DistanceSquareTo(point) <= distance_sqr) {
+        result_objects->push_back(objects_[i]);
+      }
+    }
+  }
+
+  void GetNearestObjectInternal(const int node_index, const Vec2d &point,
+                                double *const min_distance_sqr,
+                                ObjectPtr *const nearest_object) const {
+    const Node &node = nodes_[node_index];
+    double lower_distance_sqr[kWidth];
+    LowerDistanceSquares(node, point, lower_distance_sqr);
+    // visits the nearer children first
+    int order[kWidth];
+    for (int k = 0; k < kWidth; ++k) {
+      order[k] = k;
+    }
+    std::sort(order, order + kWidth, [&lower_distance_sqr](int k1, int k2) {
+      return lower_distance_sqr[k1] < lower_distance_sqr[k2];
+    });
+    for (const int k : order) {
+      if (lower_distance_sqr[k] >= *min_distance_sqr - kMathEpsilon) {
+        return;
+      }
+      if (node.child[k] >= 0) {
+        GetNearestObjectInternal(node.child[k], point, min_distance_sqr,
+                                 nearest_object);
+      } else {
+        for (int i = node.begin[k]; i < node.end[k]; ++i) {
+          if (ObjectLowerDistanceSquare(i, point) >= *min_distance_sqr) {
+            continue;
+          }
+          const double distance_sqr = objects_[i]->DistanceSquareTo(point);
+          if (distance_sqr < *min_distance_sqr) {
+            *min_distance_sqr = distance_sqr;
+            *nearest_object = objects_[i];
+          }
+        }
+      }
+      if (*min_distance_sqr <= kMathEpsilon) {
+        return;
+      }
+    }
+  }
+
+ private:
+  AABoxKDTreeParams params_;
+  std::vector<ObjectPtr> objects_;
+  // the boxes of objects_, read without following the object pointers
+  std::vector<Box> object_boxes_;
+  std::vector<Node> nodes_;
+
+  // Boundary
+  double min_x_ = 0.0;
+  double max_x_ = 0.0;
+  double min_y_ = 0.0;
+  double max_y_ = 0.0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
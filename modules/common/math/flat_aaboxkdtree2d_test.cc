@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/flat_aaboxkdtree2d.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+class Object {
+ public:
+  Object(const double x1, const double y1, const double x2, const double y2,
+         const int id)
+      : aabox_({x1, y1}, {x2, y2}),
+        line_segment_({x1, y1}, {x2, y2}),
+        id_(id) {}
+  const AABox2d &aabox() const { return aabox_; }
+  double DistanceTo(const Vec2d &point) const {
+    return line_segment_.DistanceTo(point);
+  }
+  double DistanceSquareTo(const Vec2d &point) const {
+    return line_segment_.DistanceSquareTo(point);
+  }
+  int id() const { return id_; }
+
+ private:
+  AABox2d aabox_;
+  LineSegment2d line_segment_;
+  int id_ = 0;
+};
+
+std::set<int> GetIds(const std::vector<const Object *> &objects) {
+  std::set<int> ids;
+  for (const Object *object : objects) {
+    ids.insert(object->id());
+  }
+  return ids;
+}
+
+}  // namespace
+
+TEST(FlatAABoxKDTree2d, OverallTests) {
+  const int kNumBoxes[5] = {1, 10, 50, 100, 1000};
+  const int kNumQueries = 1000;
+  const double kSize = 100;
+  const int kNumTrees = 4;
+  AABoxKDTreeParams kdtree_params[kNumTrees];
+  kdtree_params[1].max_depth = 2;
+  kdtree_params[2].max_leaf_dimension = kSize / 4.0;
+  kdtree_params[3].max_leaf_size = 20;
+
+  for (int num_boxes : kNumBoxes) {
+    std::vector<Object> objects;
+    for (int i = 0; i < num_boxes; ++i) {
+      const double cx = RandomDouble(-kSize, kSize);
+      const double cy = RandomDouble(-kSize, kSize);
+      const double dx = RandomDouble(-kSize / 10.0, kSize / 10.0);
+      const double dy = RandomDouble(-kSize / 10.0, kSize / 10.0);
+      objects.emplace_back(cx - dx, cy - dy, cx + dx, cy + dy, i);
+    }
+    std::unique_ptr<FlatAABoxKDTree2d<Object>> kdtrees[kNumTrees];
+    for (int i = 0; i < kNumTrees; ++i) {
+      kdtrees[i].reset(
+          new FlatAABoxKDTree2d<Object>(objects, kdtree_params[i]));
+    }
+    AABoxKDTree2d<Object> node_kdtree(objects, AABoxKDTreeParams());
+    std::vector<Vec2d> points;
+    for (int i = 0; i < kNumQueries; ++i) {
+      const Vec2d point(RandomDouble(-kSize * 1.5, kSize * 1.5),
+                        RandomDouble(-kSize * 1.5, kSize * 1.5));
+      points.push_back(point);
+      double expected_distance = std::numeric_limits<double>::infinity();
+      for (const auto &object : objects) {
+        expected_distance =
+            std::min(expected_distance, object.DistanceTo(point));
+      }
+      EXPECT_NEAR(node_kdtree.GetNearestObject(point)->DistanceTo(point),
+                  expected_distance, 1e-3);
+      for (int k = 0; k < kNumTrees; ++k) {
+        const Object *nearest_object = kdtrees[k]->GetNearestObject(point);
+        EXPECT_NEAR(nearest_object->DistanceTo(point), expected_distance,
+                    1e-3);
+        const Object *hint = &objects[i % num_boxes];
+        nearest_object = kdtrees[k]->GetNearestObject(point, hint);
+        EXPECT_NEAR(nearest_object->DistanceTo(point), expected_distance,
+                    1e-3);
+      }
+    }
+    for (int k = 0; k < kNumTrees; ++k) {
+      const auto nearest_objects = kdtrees[k]->GetNearestObjects(points);
+      ASSERT_EQ(points.size(), nearest_objects.size());
+      for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(nearest_objects[i]->DistanceTo(points[i]),
+                    node_kdtree.GetNearestObject(points[i])
+                        ->DistanceTo(points[i]),
+                    1e-3);
+      }
+    }
+
+    for (int i = 0; i < kNumQueries; ++i) {
+      const Vec2d point(RandomDouble(-kSize * 1.5, kSize * 1.5),
+                        RandomDouble(-kSize * 1.5, kSize * 1.5));
+      const double distance = RandomDouble(0, kSize * 2.0);
+      for (int k = 0; k < kNumTrees; ++k) {
+        std::vector<const Object *> result_objects =
+            kdtrees[k]->GetObjects(point, distance);
+        std::set<int> result_ids = GetIds(result_objects);
+        EXPECT_EQ(result_objects.size(), result_ids.size());
+        for (const auto &object : objects) {
+          const double d = object.DistanceTo(point);
+          if (std::abs(d - distance) <= 1e-3) {
+            continue;
+          }
+          if (d < distance) {
+            EXPECT_TRUE(result_ids.count(object.id()));
+          } else {
+            EXPECT_FALSE(result_ids.count(object.id()));
+          }
+        }
+      }
+    }
+
+    // a batch of points along a path
+    const double kDistance = kSize / 10.0;
+    std::vector<Vec2d> path_points;
+    for (int i = 0; i < 50; ++i) {
+      path_points.emplace_back(-kSize + i * kSize / 25.0, i * kSize / 50.0);
+    }
+    for (int k = 0; k < kNumTrees; ++k) {
+      const auto batch_objects =
+          kdtrees[k]->GetObjects(path_points, kDistance);
+      ASSERT_EQ(path_points.size(), batch_objects.size());
+      for (size_t i = 0; i < path_points.size(); ++i) {
+        EXPECT_EQ(GetIds(node_kdtree.GetObjects(path_points[i], kDistance)),
+                  GetIds(batch_objects[i]));
+      }
+    }
+    EXPECT_DOUBLE_EQ(node_kdtree.GetBoundingBox().min_x(),
+                     kdtrees[0]->GetBoundingBox().min_x());
+    EXPECT_DOUBLE_EQ(node_kdtree.GetBoundingBox().max_y(),
+                     kdtrees[0]->GetBoundingBox().max_y());
+  }
+}
+
+TEST(FlatAABoxKDTree2d, Empty) {
+  std::vector<Object> objects;
+  FlatAABoxKDTree2d<Object> kdtree(objects, AABoxKDTreeParams());
+  EXPECT_EQ(nullptr, kdtree.GetNearestObject({0.0, 0.0}));
+  EXPECT_TRUE(kdtree.GetObjects({0.0, 0.0}, 10.0).empty());
+  EXPECT_EQ(1, kdtree.GetObjects(std::vector<Vec2d>(1), 10.0).size());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
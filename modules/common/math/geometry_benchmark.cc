@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file geometry_benchmark.cc
+ * @brief Compares the single point queries of Polygon2d with the batch ones,
+ *        for several numbers of points.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::vector<Vec2d> MakePoints(const int num_points) {
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.emplace_back(10.0 * std::sin(i * 1.3), 10.0 * std::cos(i * 0.7));
+  }
+  return points;
+}
+
+// a concave polygon around the origin
+Polygon2d MakePolygon() {
+  return Polygon2d({{-6, -3}, {0, -5}, {6, -3}, {7, 2}, {0, 1}, {-5, 4}});
+}
+
+}  // namespace
+
+static void BM_Polygon2dIsPointIn(benchmark::State& state) {  // NOLINT
+  const std::vector<Vec2d> points =
+      MakePoints(static_cast<int>(state.range(0)));
+  const Polygon2d polygon = MakePolygon();
+  std::vector<int> points_in(points.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      points_in[i] = polygon.IsPointIn(points[i]) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(points_in.data());
+  }
+}
+BENCHMARK(BM_Polygon2dIsPointIn)->Arg(16)->Arg(128)->Arg(1024);
+
+static void BM_Polygon2dBatchIsPointIn(benchmark::State& state) {  // NOLINT
+  const std::vector<Vec2d> points =
+      MakePoints(static_cast<int>(state.range(0)));
+  const Polygon2d polygon = MakePolygon();
+  std::vector<int> points_in;
+  for (auto _ : state) {
+    polygon.IsPointIn(points, &points_in);
+    benchmark::DoNotOptimize(points_in.data());
+  }
+}
+BENCHMARK(BM_Polygon2dBatchIsPointIn)->Arg(16)->Arg(128)->Arg(1024);
+
+static void BM_Polygon2dDistanceSquareTo(benchmark::State& state) {  // NOLINT
+  const std::vector<Vec2d> points =
+      MakePoints(static_cast<int>(state.range(0)));
+  const Polygon2d polygon = MakePolygon();
+  std::vector<double> distance_sqrs(points.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      distance_sqrs[i] = polygon.DistanceSquareTo(points[i]);
+    }
+    benchmark::DoNotOptimize(distance_sqrs.data());
+  }
+}
+BENCHMARK(BM_Polygon2dDistanceSquareTo)->Arg(16)->Arg(128)->Arg(1024);
+
+static void BM_Polygon2dBatchDistanceSquareTo(
+    benchmark::State& state) {  // NOLINT
+  const std::vector<Vec2d> points =
+      MakePoints(static_cast<int>(state.range(0)));
+  const Polygon2d polygon = MakePolygon();
+  std::vector<double> distance_sqrs;
+  for (auto _ : state) {
+    polygon.DistanceSquareTo(points, &distance_sqrs);
+    benchmark::DoNotOptimize(distance_sqrs.data());
+  }
+}
+BENCHMARK(BM_Polygon2dBatchDistanceSquareTo)->Arg(16)->Arg(128)->Arg(1024);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -269,13 +269,16 @@ inline void KalmanFilter<T, XN, ZN, UN>::Correct(
 
   S_ = static_cast<Eigen::Matrix<T, ZN, ZN>>(H_ * P_ * H_.transpose() + R_);
 
-  K_ = static_cast<Eigen::Matrix<T, XN, ZN>>(
-      P_ * H_.transpose() * PseudoInverse<T, ZN>(S_));
+  K_ = MultiplyByCovarianceInverse<T, XN, ZN>(
+      static_cast<Eigen::Matrix<T, XN, ZN>>(P_ * H_.transpose()), S_);
 
   x_ = x_ + K_ * y_;
 
+  // Joseph form, which keeps P symmetric and positive semi-definite
+  const Eigen::Matrix<T, XN, XN> I_KH =
+      Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_;
   P_ = static_cast<Eigen::Matrix<T, XN, XN>>(
-    (Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_) * P_);
+      I_KH * P_ * I_KH.transpose() + K_ * R_ * K_.transpose());
 }
 
 template <typename T, unsigned int XN, unsigned int ZN, unsigned int UN>
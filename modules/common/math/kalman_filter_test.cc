@@ -101,6 +101,20 @@ TEST_F(KalmanFilterTest, SyntheticTrackingTest) {
   EXPECT_NEAR(0.08826, state_cov(1, 1), 0.001);
 }
 
+TEST_F(KalmanFilterTest, CovarianceStaysSymmetric) {
+  Eigen::Matrix<double, 1, 1> z;
+  Eigen::Matrix<double, 1, 1> u;
+  u(0, 0) = 0.1;
+  for (int i = 0; i < 1000; ++i) {
+    kf_.Predict(u);
+    z(0, 0) = 0.05 * i * i;
+    kf_.Correct(z);
+    const Eigen::Matrix<double, 2, 2> state_cov = kf_.GetStateCovariance();
+    ASSERT_NEAR(state_cov(0, 1), state_cov(1, 0), 1e-12);
+    ASSERT_GT(state_cov.determinant(), 0.0);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
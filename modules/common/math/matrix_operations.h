@@ -27,6 +27,7 @@
 
 #include "Eigen/Dense"
 #include "Eigen/SVD"
+#include "Eigen/SparseCore"
 
 #include "cyber/common/log.h"
 
@@ -77,6 +78,30 @@ Eigen::Matrix<T, N, M> PseudoInverse(const Eigen::Matrix<T, M, N> &m,
                                              PseudoInverse<T, M>(t));
 }
 
+/**
+ * @brief Computes m * s^-1 for a symmetric positive definite s, such as a
+ * covariance matrix, with a Cholesky decomposition of s instead of an inverse.
+ * Falls back to the pseudo-inverse of s when it is not positive definite.
+ *
+ * @param m The matrix to be multiplied
+ * @param s The symmetric positive definite matrix to be inverted
+ *
+ * @return The product of m by the inverse of s.
+ */
+template <typename T, unsigned int M, unsigned int N>
+Eigen::Matrix<T, M, N> MultiplyByCovarianceInverse(
+    const Eigen::Matrix<T, M, N> &m, const Eigen::Matrix<T, N, N> &s) {
+  const Eigen::LLT<Eigen::Matrix<T, N, N>> llt(s);
+  if (llt.info() != Eigen::Success) {
+    return static_cast<Eigen::Matrix<T, M, N>>(m * PseudoInverse<T, N>(s));
+  }
+  // for the small fixed sizes, solving for the inverse and multiplying by it
+  // is faster than solving for the product
+  const Eigen::Matrix<T, N, N> s_inverse =
+      llt.solve(Eigen::Matrix<T, N, N>::Identity());
+  return static_cast<Eigen::Matrix<T, M, N>>(m * s_inverse);
+}
+
 /**
 * @brief Computes bilinear transformation of the continuous to discrete form
 for state space representation
@@ -157,6 +182,31 @@ void DenseToCSCMatrix(const Eigen::Matrix<T, M, N> &dense_matrix,
   indptr->emplace_back(data_count);
 }
 
+/**
+ * @brief Converts a column major sparse matrix to the CSC arrays, dropping the
+ *        entries DenseToCSCMatrix drops, so that both give the same arrays.
+ */
+template <typename T, typename D>
+void SparseToCSCMatrix(const Eigen::SparseMatrix<T> &sparse_matrix,
+                       std::vector<T> *data, std::vector<D> *indices,
+                       std::vector<D> *indptr) {
+  constexpr double epsilon = 1e-9;
+  int data_count = 0;
+  for (int c = 0; c < sparse_matrix.outerSize(); ++c) {
+    indptr->emplace_back(data_count);
+    for (typename Eigen::SparseMatrix<T>::InnerIterator it(sparse_matrix, c);
+         it; ++it) {
+      if (std::fabs(it.value()) < epsilon) {
+        continue;
+      }
+      data->emplace_back(it.value());
+      ++data_count;
+      indices->emplace_back(static_cast<D>(it.row()));
+    }
+  }
+  indptr->emplace_back(data_count);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
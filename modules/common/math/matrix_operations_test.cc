@@ -72,6 +72,24 @@ TEST(PseudoInverseTest, PseudoInverseII) {
   EXPECT_FLOAT_EQ(D(0, 4), 0);
 }
 
+TEST(MultiplyByCovarianceInverseTest, MultiplyByCovarianceInverse) {
+  Eigen::Matrix<double, 3, 2> m;
+  m << 1.0, 2.0, -0.5, 0.3, 4.0, -1.0;
+  Eigen::Matrix<double, 2, 2> s;
+  s << 2.0, 0.5, 0.5, 1.0;
+  const Eigen::Matrix<double, 3, 2> expected = m * s.inverse();
+  Eigen::Matrix<double, 3, 2> product =
+      MultiplyByCovarianceInverse<double, 3, 2>(m, s);
+  EXPECT_TRUE(product.isApprox(expected, 1e-12));
+
+  // not positive definite, as with the pseudo-inverse
+  s << 1.0, 1.0, 1.0, 1.0;
+  const Eigen::Matrix<double, 3, 2> pseudo_product =
+      m * PseudoInverse<double, 2>(s);
+  product = MultiplyByCovarianceInverse<double, 3, 2>(m, s);
+  EXPECT_TRUE(product.isApprox(pseudo_product, 1e-12));
+}
+
 TEST(ContinuousToDiscreteTest, c2d_fixed_size) {
   double ts = 0.0;
 
@@ -380,6 +398,37 @@ TEST(DENSE_TO_CSC_MATRIX, patterned_dense_to_csc_matrix_test) {
   std::cout << std::endl;
 }
 
+TEST(SPARSE_TO_CSC_MATRIX, same_as_dense_to_csc_matrix_test) {
+  Eigen::MatrixXd dense_matrix(4, 6);
+  dense_matrix << 11, 0, 0, 14, 0, 16, 0, 22, 0, 0, 25, 26, 0, 0, 33, 34, 0,
+      36, 41, 0, 43, 44, 1e-12, 46;
+
+  // filled out of order and left uncompressed, with an explicit zero
+  Eigen::SparseMatrix<double> sparse_matrix(4, 6);
+  sparse_matrix.reserve(Eigen::VectorXi::Constant(6, 4));
+  for (int r = 3; r >= 0; --r) {
+    for (int c = 0; c < 6; ++c) {
+      if (dense_matrix(r, c) != 0.0 || (r == 2 && c == 1)) {
+        sparse_matrix.coeffRef(r, c) = dense_matrix(r, c);
+      }
+    }
+  }
+
+  std::vector<double> dense_data;
+  std::vector<int> dense_indices;
+  std::vector<int> dense_indptr;
+  DenseToCSCMatrix(dense_matrix, &dense_data, &dense_indices, &dense_indptr);
+
+  std::vector<double> data;
+  std::vector<int> indices;
+  std::vector<int> indptr;
+  SparseToCSCMatrix(sparse_matrix, &data, &indices, &indptr);
+
+  EXPECT_EQ(data, dense_data);
+  EXPECT_EQ(indices, dense_indices);
+  EXPECT_EQ(indptr, dense_indptr);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,319 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/mpc_osqp_solver.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Matrix = Eigen::MatrixXd;
+
+namespace {
+
+// Shifts the blocks of a solution one step ahead, the last block is repeated.
+// The blocks are [first, first + num_step * block_size).
+void ShiftBlocks(const std::vector<c_float> &from, const size_t first,
+                 const size_t num_step, const size_t block_size,
+                 std::vector<c_float> *to) {
+  for (size_t k = 0; k < num_step; ++k) {
+    const size_t source = first + std::min(k + 1, num_step - 1) * block_size;
+    std::copy(from.begin() + source, from.begin() + source + block_size,
+              to->begin() + first + k * block_size);
+  }
+}
+
+}  // namespace
+
+MpcOsqpSolver::MpcOsqpSolver(const double eps, const int max_iter) {
+  osqp_set_default_settings(&settings_);
+  if (eps > 0.0) {
+    settings_.eps_abs = eps;
+    settings_.eps_rel = eps;
+  }
+  if (max_iter > 0) {
+    settings_.max_iter = max_iter;
+  }
+  settings_.polish = false;
+  settings_.verbose = false;
+  settings_.warm_start = true;
+}
+
+MpcOsqpSolver::~MpcOsqpSolver() { Reset(); }
+
+void MpcOsqpSolver::Reset() {
+  osqp_cleanup(work_);
+  work_ = nullptr;
+  num_state_ = 0;
+  num_control_ = 0;
+  horizon_ = 0;
+  last_primal_.clear();
+  last_dual_.clear();
+  workspace_reused_ = false;
+}
+
+bool MpcOsqpSolver::Solve(const Matrix &matrix_a, const Matrix &matrix_b,
+                          const Matrix &matrix_c, const Matrix &matrix_q,
+                          const Matrix &matrix_r, const Matrix &matrix_lower,
+                          const Matrix &matrix_upper,
+                          const Matrix &matrix_initial_state,
+                          const std::vector<Matrix> &reference,
+                          std::vector<Matrix> *control) {
+  const int num_state = static_cast<int>(matrix_a.rows());
+  const int num_control = static_cast<int>(matrix_b.cols());
+  const int horizon = static_cast<int>(reference.size());
+  if (matrix_a.rows() != matrix_a.cols() || matrix_b.rows() != num_state ||
+      matrix_c.rows() != num_state || matrix_q.rows() != num_state ||
+      matrix_r.rows() != num_control || matrix_lower.rows() != num_control ||
+      matrix_upper.rows() != num_control ||
+      matrix_initial_state.rows() != num_state || horizon == 0 ||
+      control->size() != reference.size()) {
+    AERROR << "One or more matrices have incompatible dimensions. Aborting.";
+    return false;
+  }
+
+  workspace_reused_ = work_ != nullptr && num_state == num_state_ &&
+                      num_control == num_control_ && horizon == horizon_;
+  if (!workspace_reused_) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+    last_primal_.clear();
+    last_dual_.clear();
+    num_state_ = num_state;
+    num_control_ = num_control;
+    horizon_ = horizon;
+    BuildPattern();
+  }
+  FillValues(matrix_a, matrix_b, matrix_c, matrix_q, matrix_r, matrix_lower,
+             matrix_upper, matrix_initial_state, reference);
+
+  if (workspace_reused_ &&
+      (osqp_update_P_A(work_, P_data_.data(), OSQP_NULL,
+                       static_cast<c_int>(P_data_.size()), A_data_.data(),
+                       OSQP_NULL, static_cast<c_int>(A_data_.size())) != 0 ||
+       osqp_update_lin_cost(work_, q_.data()) != 0 ||
+       osqp_update_bounds(work_, lower_bounds_.data(),
+                          upper_bounds_.data()) != 0)) {
+    AWARN << "Failed to update the osqp workspace, setting it up again.";
+    workspace_reused_ = false;
+  }
+  if (!workspace_reused_ && !Setup()) {
+    AERROR << "Failed to set up the osqp workspace.";
+    Reset();
+    return false;
+  }
+  WarmStart();
+
+  osqp_solve(work_);
+  if (work_->info->status_val != OSQP_SOLVED) {
+    AERROR << "Linear MPC osqp solver failed, status: "
+           << work_->info->status_val;
+    last_primal_.clear();
+    last_dual_.clear();
+    return false;
+  }
+  last_primal_.assign(work_->solution->x, work_->solution->x + num_var_);
+  last_dual_.assign(work_->solution->y,
+                    work_->solution->y + num_constraint_);
+
+  const c_float *controls = work_->solution->x + horizon_ * num_state_;
+  for (int k = 0; k < horizon_; ++k) {
+    for (int i = 0; i < num_control_; ++i) {
+      (*control)[k](i, 0) = controls[k * num_control_ + i];
+    }
+  }
+  return true;
+}
+
+void MpcOsqpSolver::BuildPattern() {
+  const int nx = num_state_;
+  const int nu = num_control_;
+  const int n = horizon_;
+  num_var_ = n * (nx + nu);
+  num_constraint_ = n * (nx + nu);
+
+  // P: upper triangles of the Q blocks of the states, then of the R blocks
+  P_indices_.clear();
+  P_indptr_.clear();
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nx; ++c) {
+      P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+      for (int r = 0; r <= c; ++r) {
+        P_indices_.push_back(k * nx + r);
+      }
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nu; ++c) {
+      P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+      for (int r = 0; r <= c; ++r) {
+        P_indices_.push_back(n * nx + k * nu + r);
+      }
+    }
+  }
+  P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+  P_data_.resize(P_indices_.size());
+
+  // A: the dynamics rows x(k + 1) - A * x(k) - B * u(k) = C, then the bounds
+  // of u(k)
+  A_indices_.clear();
+  A_indptr_.clear();
+  for (int k = 0; k < n; ++k) {
+    // x(k + 1), in its own dynamics row and in the one of the next step
+    for (int c = 0; c < nx; ++c) {
+      A_indptr_.push_back(static_cast<c_int>(A_indices_.size()));
+      A_indices_.push_back(k * nx + c);
+      if (k + 1 < n) {
+        for (int r = 0; r < nx; ++r) {
+          A_indices_.push_back((k + 1) * nx + r);
+        }
+      }
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nu; ++c) {
+      A_indptr_.push_back(static_cast<c_int>(A_indices_.size()));
+      for (int r = 0; r < nx; ++r) {
+        A_indices_.push_back(k * nx + r);
+      }
+      A_indices_.push_back(n * nx + k * nu + c);
+    }
+  }
+  A_indptr_.push_back(static_cast<c_int>(A_indices_.size()));
+  A_data_.resize(A_indices_.size());
+
+  q_.resize(num_var_);
+  lower_bounds_.resize(num_constraint_);
+  upper_bounds_.resize(num_constraint_);
+  warm_primal_.resize(num_var_);
+  warm_dual_.resize(num_constraint_);
+}
+
+void MpcOsqpSolver::FillValues(const Matrix &matrix_a, const Matrix &matrix_b,
+                               const Matrix &matrix_c, const Matrix &matrix_q,
+                               const Matrix &matrix_r,
+                               const Matrix &matrix_lower,
+                               const Matrix &matrix_upper,
+                               const Matrix &matrix_initial_state,
+                               const std::vector<Matrix> &reference) {
+  const int nx = num_state_;
+  const int nu = num_control_;
+  const int n = horizon_;
+
+  // same order as the pattern, the cost of x(k + 1) - reference[k] weighted
+  // by Q and the cost of u(k) weighted by R
+  size_t index = 0;
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nx; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        P_data_[index++] = matrix_q(r, c);
+      }
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nu; ++c) {
+      for (int r = 0; r <= c; ++r) {
+        P_data_[index++] = matrix_r(r, c);
+      }
+    }
+  }
+
+  index = 0;
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nx; ++c) {
+      A_data_[index++] = 1.0;
+      if (k + 1 < n) {
+        for (int r = 0; r < nx; ++r) {
+          A_data_[index++] = -matrix_a(r, c);
+        }
+      }
+    }
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int c = 0; c < nu; ++c) {
+      for (int r = 0; r < nx; ++r) {
+        A_data_[index++] = -matrix_b(r, c);
+      }
+      A_data_[index++] = 1.0;
+    }
+  }
+
+  for (int k = 0; k < n; ++k) {
+    const Matrix weighted_reference = matrix_q * reference[k];
+    for (int i = 0; i < nx; ++i) {
+      q_[k * nx + i] = -weighted_reference(i, 0);
+    }
+  }
+  std::fill(q_.begin() + n * nx, q_.end(), 0.0);
+
+  // the initial state is known, it moves to the right side of the first step
+  const Matrix first_step = matrix_a * matrix_initial_state + matrix_c;
+  for (int k = 0; k < n; ++k) {
+    for (int i = 0; i < nx; ++i) {
+      const double value = k == 0 ? first_step(i, 0) : matrix_c(i, 0);
+      lower_bounds_[k * nx + i] = value;
+      upper_bounds_[k * nx + i] = value;
+    }
+    for (int i = 0; i < nu; ++i) {
+      lower_bounds_[n * nx + k * nu + i] = matrix_lower(i, 0);
+      upper_bounds_[n * nx + k * nu + i] = matrix_upper(i, 0);
+    }
+  }
+}
+
+bool MpcOsqpSolver::Setup() {
+  // osqp_setup copies the problem data, so the arrays are only borrowed here
+  OSQPData data;
+  data.n = num_var_;
+  data.m = num_constraint_;
+  data.P = csc_matrix(data.n, data.n, static_cast<c_int>(P_data_.size()),
+                      P_data_.data(), P_indices_.data(), P_indptr_.data());
+  data.q = q_.data();
+  data.A = csc_matrix(data.m, data.n, static_cast<c_int>(A_data_.size()),
+                      A_data_.data(), A_indices_.data(), A_indptr_.data());
+  data.l = lower_bounds_.data();
+  data.u = upper_bounds_.data();
+
+  work_ = osqp_setup(&data, &settings_);
+
+  c_free(data.A);
+  c_free(data.P);
+  return work_ != nullptr;
+}
+
+void MpcOsqpSolver::WarmStart() {
+  if (last_primal_.empty()) {
+    return;
+  }
+  // the previous solution, one control period later
+  const size_t nx = static_cast<size_t>(num_state_);
+  const size_t nu = static_cast<size_t>(num_control_);
+  const size_t n = static_cast<size_t>(horizon_);
+  ShiftBlocks(last_primal_, 0, n, nx, &warm_primal_);
+  ShiftBlocks(last_primal_, n * nx, n, nu, &warm_primal_);
+  ShiftBlocks(last_dual_, 0, n, nx, &warm_dual_);
+  ShiftBlocks(last_dual_, n * nx, n, nu, &warm_dual_);
+  osqp_warm_start(work_, warm_primal_.data(), warm_dual_.data());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file mpc_osqp_solver.h
+ * @brief Solve the linear mpc problem as a sparse qp with osqp.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "osqp/include/osqp.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class MpcOsqpSolver
+ * @brief Solves the problem of SolveLinearMPC with osqp. The states of the
+ * horizon stay decision variables tied by the dynamics, so the qp keeps the
+ * sparsity of the model instead of condensing it into dense matrices. The
+ * osqp workspace is kept between solves: while the dimensions are the same
+ * only its values are updated, and the solve starts from the previous
+ * solution shifted by one step.
+ */
+class MpcOsqpSolver {
+ public:
+  /**
+   * @param eps The absolute and relative tolerance of osqp
+   * @param max_iter The maximum number of osqp iterations
+   * Non positive values keep the defaults of osqp.
+   */
+  MpcOsqpSolver(const double eps, const int max_iter);
+
+  ~MpcOsqpSolver();
+
+  MpcOsqpSolver(const MpcOsqpSolver &) = delete;
+  MpcOsqpSolver &operator=(const MpcOsqpSolver &) = delete;
+
+  /**
+   * @brief Same problem and arguments as SolveLinearMPC.
+   * @param control The feedback control matrix (pointer), its size is the
+   *        horizon
+   * @return If the problem is solved
+   */
+  bool Solve(const Eigen::MatrixXd &matrix_a, const Eigen::MatrixXd &matrix_b,
+             const Eigen::MatrixXd &matrix_c, const Eigen::MatrixXd &matrix_q,
+             const Eigen::MatrixXd &matrix_r,
+             const Eigen::MatrixXd &matrix_lower,
+             const Eigen::MatrixXd &matrix_upper,
+             const Eigen::MatrixXd &matrix_initial_state,
+             const std::vector<Eigen::MatrixXd> &reference,
+             std::vector<Eigen::MatrixXd> *control);
+
+  /**
+   * @brief Releases the workspace and forgets the previous solution.
+   */
+  void Reset();
+
+  // whether the last solve updated the previous workspace in place
+  bool workspace_reused() const { return workspace_reused_; }
+
+ private:
+  void BuildPattern();
+
+  void FillValues(const Eigen::MatrixXd &matrix_a,
+                  const Eigen::MatrixXd &matrix_b,
+                  const Eigen::MatrixXd &matrix_c,
+                  const Eigen::MatrixXd &matrix_q,
+                  const Eigen::MatrixXd &matrix_r,
+                  const Eigen::MatrixXd &matrix_lower,
+                  const Eigen::MatrixXd &matrix_upper,
+                  const Eigen::MatrixXd &matrix_initial_state,
+                  const std::vector<Eigen::MatrixXd> &reference);
+
+  bool Setup();
+
+  void WarmStart();
+
+  OSQPSettings settings_;
+  OSQPWorkspace *work_ = nullptr;
+
+  int num_state_ = 0;
+  int num_control_ = 0;
+  int horizon_ = 0;
+
+  // the variables are [x(1) .. x(N), u(0) .. u(N - 1)], the constraints are
+  // the dynamics of the N steps, then the bounds of the N controls
+  c_int num_var_ = 0;
+  c_int num_constraint_ = 0;
+
+  // upper triangular P and A in csc format, every entry of the model blocks
+  // is kept so that the pattern does not depend on the values
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> q_;
+  std::vector<c_float> lower_bounds_;
+  std::vector<c_float> upper_bounds_;
+
+  // solution of the last solved problem, empty if it was not solved
+  std::vector<c_float> last_primal_;
+  std::vector<c_float> last_dual_;
+  std::vector<c_float> warm_primal_;
+  std::vector<c_float> warm_dual_;
+
+  bool workspace_reused_ = false;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/mpc_osqp_solver.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/mpc_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Matrix = Eigen::MatrixXd;
+
+class MpcOsqpSolverTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    matrix_a_ = Matrix(kStates, kStates);
+    matrix_a_ << 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1;
+    matrix_b_ = Matrix(kStates, kControls);
+    matrix_b_ << 0, 1, 0, 0, 1, 0, 0, 1;
+    matrix_c_ = Matrix(kStates, 1);
+    matrix_c_ << 0, 0, 0, 0.1;
+    matrix_q_ = Matrix(kStates, kStates);
+    matrix_q_ << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0;
+    matrix_r_ = Matrix::Identity(kControls, kControls);
+    lower_bound_ = Matrix(kControls, 1);
+    lower_bound_ << -2, -2;
+    upper_bound_ = Matrix(kControls, 1);
+    upper_bound_ << 2, 2;
+  }
+
+ protected:
+  static constexpr int kStates = 4;
+  static constexpr int kControls = 2;
+  static constexpr int kHorizon = 10;
+
+  Matrix matrix_a_;
+  Matrix matrix_b_;
+  Matrix matrix_c_;
+  Matrix matrix_q_;
+  Matrix matrix_r_;
+  Matrix lower_bound_;
+  Matrix upper_bound_;
+};
+
+TEST_F(MpcOsqpSolverTest, SameAsActiveSet) {
+  MpcOsqpSolver solver(1e-6, 20000);
+  std::vector<Matrix> reference(kHorizon, Matrix::Zero(kStates, 1));
+  Matrix initial_state(kStates, 1);
+  initial_state << 3, -4, 0.5, 0.2;
+
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    for (auto &state : reference) {
+      state << 2.0 * cycle, 1.0, 0.0, 0.0;
+    }
+    std::vector<Matrix> expected(kHorizon, Matrix::Zero(kControls, 1));
+    EXPECT_TRUE(SolveLinearMPC(matrix_a_, matrix_b_, matrix_c_, matrix_q_,
+                               matrix_r_, lower_bound_, upper_bound_,
+                               initial_state, reference, 0.01, 100,
+                               &expected));
+    std::vector<Matrix> control(kHorizon, Matrix::Zero(kControls, 1));
+    EXPECT_TRUE(solver.Solve(matrix_a_, matrix_b_, matrix_c_, matrix_q_,
+                             matrix_r_, lower_bound_, upper_bound_,
+                             initial_state, reference, &control));
+    EXPECT_EQ(cycle > 0, solver.workspace_reused());
+    for (int k = 0; k < kHorizon; ++k) {
+      for (int i = 0; i < kControls; ++i) {
+        EXPECT_NEAR(expected[k](i, 0), control[k](i, 0), 1e-3);
+        EXPECT_LE(control[k](i, 0), upper_bound_(i, 0) + 1e-4);
+        EXPECT_GE(control[k](i, 0), lower_bound_(i, 0) - 1e-4);
+      }
+    }
+    initial_state = matrix_a_ * initial_state + matrix_b_ * control[0] +
+                    matrix_c_;
+  }
+}
+
+TEST_F(MpcOsqpSolverTest, HorizonChange) {
+  MpcOsqpSolver solver(1e-6, 20000);
+  Matrix initial_state = Matrix::Zero(kStates, 1);
+  Matrix reference_state(kStates, 1);
+  reference_state << 20, 20, 0, 0;
+
+  for (const int horizon : {kHorizon, 2 * kHorizon}) {
+    std::vector<Matrix> reference(horizon, reference_state);
+    std::vector<Matrix> control(horizon, Matrix::Zero(kControls, 1));
+    EXPECT_TRUE(solver.Solve(matrix_a_, matrix_b_, matrix_c_, matrix_q_,
+                             matrix_r_, lower_bound_, upper_bound_,
+                             initial_state, reference, &control));
+    EXPECT_FALSE(solver.workspace_reused());
+    EXPECT_NEAR(upper_bound_(0), control[0](0), 1e-4);
+  }
+}
+
+TEST_F(MpcOsqpSolverTest, IncompatibleDimensions) {
+  MpcOsqpSolver solver(0.0, 0);
+  std::vector<Matrix> reference(kHorizon, Matrix::Zero(kStates, 1));
+  std::vector<Matrix> control(kHorizon - 1, Matrix::Zero(kControls, 1));
+  EXPECT_FALSE(solver.Solve(matrix_a_, matrix_b_, matrix_c_, matrix_q_,
+                            matrix_r_, lower_bound_, upper_bound_,
+                            Matrix::Zero(kStates, 1), reference, &control));
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file mpc_solver_benchmark.cc
+ * @brief Compares SolveLinearMPC and the MpcOsqpSolver on the lateral and
+ *        longitudinal model of the mpc controller, for several horizons.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "Eigen/LU"
+
+#include "modules/common/math/mpc_osqp_solver.h"
+#include "modules/common/math/mpc_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+using Matrix = Eigen::MatrixXd;
+
+constexpr int kStates = 6;
+constexpr int kControls = 2;
+
+// the model of the mpc controller at a constant speed, with its default conf
+class ControllerModel {
+ public:
+  ControllerModel() {
+    const double ts = 0.01;
+    const double cf = 155494.663;
+    const double cr = 155494.663;
+    const double mass = 2080.0;
+    const double lf = 1.4;
+    const double lr = 1.4;
+    const double iz = lf * lf * mass / 2.0 + lr * lr * mass / 2.0;
+    const double v = 10.0;
+
+    Matrix matrix_a = Matrix::Zero(kStates, kStates);
+    matrix_a(0, 1) = 1.0;
+    matrix_a(1, 1) = -(cf + cr) / mass / v;
+    matrix_a(1, 2) = (cf + cr) / mass;
+    matrix_a(1, 3) = (lr * cr - lf * cf) / mass / v;
+    matrix_a(2, 3) = 1.0;
+    matrix_a(3, 1) = (lr * cr - lf * cf) / iz / v;
+    matrix_a(3, 2) = (lf * cf - lr * cr) / iz;
+    matrix_a(3, 3) = -(lf * lf * cf + lr * lr * cr) / iz / v;
+    matrix_a(4, 5) = 1.0;
+    const Matrix matrix_i = Matrix::Identity(kStates, kStates);
+    matrix_ad_ = (matrix_i - ts * 0.5 * matrix_a).inverse() *
+                 (matrix_i + ts * 0.5 * matrix_a);
+
+    matrix_bd_ = Matrix::Zero(kStates, kControls);
+    matrix_bd_(1, 0) = cf / mass * ts;
+    matrix_bd_(3, 0) = lf * cf / iz * ts;
+    matrix_bd_(5, 1) = -ts;
+    matrix_cd_ = Matrix::Zero(kStates, 1);
+
+    matrix_q_ = Matrix::Zero(kStates, kStates);
+    matrix_q_(0, 0) = 0.05;
+    matrix_q_(2, 2) = 1.0;
+    matrix_r_ = Matrix::Identity(kControls, kControls);
+    lower_bound_ = Matrix(kControls, 1);
+    lower_bound_ << -0.6, -4.0;
+    upper_bound_ = Matrix(kControls, 1);
+    upper_bound_ << 0.6, 2.0;
+    initial_state_ = Matrix(kStates, 1);
+    initial_state_ << 0.5, 0.1, 0.05, 0.0, 0.3, 0.2;
+  }
+
+  // the state drifts a bit from one cycle to the next
+  Matrix State(const int cycle) const {
+    return initial_state_ * (1.0 + 0.01 * (cycle % 10));
+  }
+
+  Matrix matrix_ad_;
+  Matrix matrix_bd_;
+  Matrix matrix_cd_;
+  Matrix matrix_q_;
+  Matrix matrix_r_;
+  Matrix lower_bound_;
+  Matrix upper_bound_;
+  Matrix initial_state_;
+};
+
+}  // namespace
+
+static void BM_ActiveSetMPC(benchmark::State& state) {  // NOLINT
+  const ControllerModel model;
+  const int horizon = static_cast<int>(state.range(0));
+  const std::vector<Matrix> reference(horizon, Matrix::Zero(kStates, 1));
+  int cycle = 0;
+  for (auto _ : state) {
+    std::vector<Matrix> control(horizon, Matrix::Zero(kControls, 1));
+    benchmark::DoNotOptimize(SolveLinearMPC(
+        model.matrix_ad_, model.matrix_bd_, model.matrix_cd_, model.matrix_q_,
+        model.matrix_r_, model.lower_bound_, model.upper_bound_,
+        model.State(cycle++), reference, 0.01, 150, &control));
+  }
+}
+BENCHMARK(BM_ActiveSetMPC)->Arg(10)->Arg(20)->Arg(40)->Arg(80);
+
+static void BM_OsqpMPC(benchmark::State& state) {  // NOLINT
+  const ControllerModel model;
+  const int horizon = static_cast<int>(state.range(0));
+  const std::vector<Matrix> reference(horizon, Matrix::Zero(kStates, 1));
+  MpcOsqpSolver solver(0.01, 0);
+  int cycle = 0;
+  for (auto _ : state) {
+    std::vector<Matrix> control(horizon, Matrix::Zero(kControls, 1));
+    benchmark::DoNotOptimize(solver.Solve(
+        model.matrix_ad_, model.matrix_bd_, model.matrix_cd_, model.matrix_q_,
+        model.matrix_r_, model.lower_bound_, model.upper_bound_,
+        model.State(cycle++), reference, &control));
+  }
+}
+BENCHMARK(BM_OsqpMPC)->Arg(10)->Arg(20)->Arg(40)->Arg(80);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -53,6 +53,12 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
     }
   }
 
+  return MatchToPath(reference_line, index_min, x, y);
+}
+
+PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
+                                   const std::size_t index_min, const double x,
+                                   const double y) {
   std::size_t index_start = (index_min == 0) ? index_min : index_min - 1;
   std::size_t index_end =
       (index_min + 1 == reference_line.size()) ? index_min : index_min + 1;
@@ -68,7 +74,11 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
 std::pair<double, double> PathMatcher::GetPathFrenetCoordinate(
     const std::vector<PathPoint>& reference_line, const double x,
     const double y) {
-  auto matched_path_point = MatchToPath(reference_line, x, y);
+  return GetPathFrenetCoordinate(MatchToPath(reference_line, x, y), x, y);
+}
+
+std::pair<double, double> PathMatcher::GetPathFrenetCoordinate(
+    const PathPoint& matched_path_point, const double x, const double y) {
   double rtheta = matched_path_point.theta();
   double rx = matched_path_point.x();
   double ry = matched_path_point.y();
@@ -117,6 +127,29 @@ PathPoint PathMatcher::FindProjectionPoint(const PathPoint& p0,
   return InterpolateUsingLinearApproximation(p0, p1, p0.s() + delta_s);
 }
 
+IndexedPathMatcher::IndexedPathMatcher(
+    const std::vector<PathPoint>& reference_line)
+    : reference_line_(reference_line) {
+  CHECK_GT(reference_line_.size(), 0);
+  boxes_.reserve(reference_line_.size());
+  for (std::size_t i = 0; i < reference_line_.size(); ++i) {
+    boxes_.emplace_back(reference_line_[i], i);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 16;
+  kdtree_.reset(new FlatAABoxKDTree2d<PathPointBox>(boxes_, params));
+}
+
+PathPoint IndexedPathMatcher::MatchToPath(const double x, const double y) {
+  hint_ = kdtree_->GetNearestObject(Vec2d(x, y), hint_);
+  return PathMatcher::MatchToPath(reference_line_, hint_->index(), x, y);
+}
+
+std::pair<double, double> IndexedPathMatcher::GetPathFrenetCoordinate(
+    const double x, const double y) {
+  return PathMatcher::GetPathFrenetCoordinate(MatchToPath(x, y), x, y);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -20,9 +20,13 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/flat_aaboxkdtree2d.h"
+#include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
@@ -44,10 +48,69 @@ class PathMatcher {
                                const double s);
 
  private:
+  friend class IndexedPathMatcher;
+
+  // projects (x, y) to the path around its nearest path point
+  static PathPoint MatchToPath(const std::vector<PathPoint>& reference_line,
+                               const std::size_t index_min, const double x,
+                               const double y);
+
+  static std::pair<double, double> GetPathFrenetCoordinate(
+      const PathPoint& matched_path_point, const double x, const double y);
+
   static PathPoint FindProjectionPoint(const PathPoint& p0, const PathPoint& p1,
                                        const double x, const double y);
 };
 
+/**
+ * @class IndexedPathMatcher
+ * @brief Matches points to a reference line with the same results as
+ *        PathMatcher, but finds the nearest path point in a
+ *        FlatAABoxKDTree2d instead of scanning the whole path. The last
+ *        match seeds the next search, as the successive queries are usually
+ *        close to each other, e.g. the corners of an obstacle.
+ */
+class IndexedPathMatcher {
+ public:
+  /**
+   * @brief Index a reference line.
+   * @param reference_line The path points, which must outlive the matcher.
+   */
+  explicit IndexedPathMatcher(const std::vector<PathPoint>& reference_line);
+
+  PathPoint MatchToPath(const double x, const double y);
+
+  std::pair<double, double> GetPathFrenetCoordinate(const double x,
+                                                    const double y);
+
+ private:
+  class PathPointBox {
+   public:
+    PathPointBox(const PathPoint& path_point, const std::size_t index)
+        : point_(path_point.x(), path_point.y()),
+          aabox_(point_, point_),
+          index_(index) {}
+    const AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const Vec2d& point) const {
+      return point_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const Vec2d& point) const {
+      return point_.DistanceSquareTo(point);
+    }
+    std::size_t index() const { return index_; }
+
+   private:
+    Vec2d point_;
+    AABox2d aabox_;
+    std::size_t index_ = 0;
+  };
+
+  const std::vector<PathPoint>& reference_line_;
+  std::vector<PathPointBox> boxes_;
+  std::unique_ptr<FlatAABoxKDTree2d<PathPointBox>> kdtree_;
+  const PathPointBox* hint_ = nullptr;
+};
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
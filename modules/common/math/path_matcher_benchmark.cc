@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file path_matcher_benchmark.cc
+ * @brief Compares the PathMatcher with the IndexedPathMatcher, and the single
+ *        state frenet_to_cartesian with the batch one, for several path
+ *        lengths.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "modules/common/math/cartesian_frenet_conversion.h"
+#include "modules/common/math/path_matcher.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// an s-shaped path sampled every meter
+std::vector<PathPoint> MakePath(const int num_points) {
+  std::vector<PathPoint> path;
+  double s = 0.0;
+  for (int i = 0; i < num_points; ++i) {
+    PathPoint point;
+    point.set_x(i * 0.9);
+    point.set_y(10.0 * std::sin(i * 0.02));
+    point.set_theta(std::atan2(0.2 * std::cos(i * 0.02), 0.9));
+    point.set_kappa(-0.004 * std::sin(i * 0.02));
+    point.set_dkappa(-0.0001 * std::cos(i * 0.02));
+    if (i > 0) {
+      s += std::hypot(point.x() - path.back().x(), point.y() - path.back().y());
+    }
+    point.set_s(s);
+    path.push_back(point);
+  }
+  return path;
+}
+
+// the corners of a car every 10 meters along the path
+std::vector<Vec2d> MakeCorners(const std::vector<PathPoint>& path) {
+  std::vector<Vec2d> corners;
+  for (std::size_t i = 0; i < path.size(); i += 10) {
+    for (const double dx : {-2.4, 2.4}) {
+      for (const double dy : {-1.0, 1.0}) {
+        corners.emplace_back(path[i].x() + dx, path[i].y() + 3.0 + dy);
+      }
+    }
+  }
+  return corners;
+}
+
+}  // namespace
+
+static void BM_PathMatcher(benchmark::State& state) {  // NOLINT
+  const std::vector<PathPoint> path =
+      MakePath(static_cast<int>(state.range(0)));
+  const std::vector<Vec2d> corners = MakeCorners(path);
+  for (auto _ : state) {
+    for (const Vec2d& corner : corners) {
+      benchmark::DoNotOptimize(PathMatcher::GetPathFrenetCoordinate(
+          path, corner.x(), corner.y()));
+    }
+  }
+}
+BENCHMARK(BM_PathMatcher)->Arg(100)->Arg(500)->Arg(2000);
+
+static void BM_IndexedPathMatcher(benchmark::State& state) {  // NOLINT
+  const std::vector<PathPoint> path =
+      MakePath(static_cast<int>(state.range(0)));
+  const std::vector<Vec2d> corners = MakeCorners(path);
+  for (auto _ : state) {
+    // the index is built once per planning cycle
+    IndexedPathMatcher path_matcher(path);
+    for (const Vec2d& corner : corners) {
+      benchmark::DoNotOptimize(
+          path_matcher.GetPathFrenetCoordinate(corner.x(), corner.y()));
+    }
+  }
+}
+BENCHMARK(BM_IndexedPathMatcher)->Arg(100)->Arg(500)->Arg(2000);
+
+static void BM_FrenetToCartesian(benchmark::State& state) {  // NOLINT
+  const std::vector<PathPoint> path =
+      MakePath(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    for (const PathPoint& point : path) {
+      const std::array<double, 3> s_condition = {point.s(), 10.0, 0.5};
+      const std::array<double, 3> d_condition = {0.5, 0.01, 0.001};
+      double x = 0.0;
+      double y = 0.0;
+      double theta = 0.0;
+      double kappa = 0.0;
+      double v = 0.0;
+      double a = 0.0;
+      CartesianFrenetConverter::frenet_to_cartesian(
+          point.s(), point.x(), point.y(), point.theta(), point.kappa(),
+          point.dkappa(), s_condition, d_condition, &x, &y, &theta, &kappa, &v,
+          &a);
+      benchmark::DoNotOptimize(a);
+    }
+  }
+}
+BENCHMARK(BM_FrenetToCartesian)->Arg(100)->Arg(500)->Arg(2000);
+
+static void BM_BatchFrenetToCartesian(benchmark::State& state) {  // NOLINT
+  const std::vector<PathPoint> path =
+      MakePath(static_cast<int>(state.range(0)));
+  FrenetReferencePoints ref_points;
+  std::vector<std::array<double, 3>> s_conditions;
+  std::vector<std::array<double, 3>> d_conditions;
+  CartesianStates states;
+  for (auto _ : state) {
+    // the reference points are gathered from the matched path points
+    ref_points.Clear();
+    s_conditions.clear();
+    d_conditions.clear();
+    for (const PathPoint& point : path) {
+      ref_points.Add(point.s(), point.x(), point.y(), point.theta(),
+                     point.kappa(), point.dkappa());
+      s_conditions.push_back({point.s(), 10.0, 0.5});
+      d_conditions.push_back({0.5, 0.01, 0.001});
+    }
+    CartesianFrenetConverter::frenet_to_cartesian(ref_points, s_conditions,
+                                                  d_conditions, &states);
+    benchmark::DoNotOptimize(states.a.data());
+  }
+}
+BENCHMARK(BM_BatchFrenetToCartesian)->Arg(100)->Arg(500)->Arg(2000);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/path_matcher.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// an s-shaped path sampled every meter
+std::vector<PathPoint> MakePath(const int num_points) {
+  std::vector<PathPoint> path;
+  double s = 0.0;
+  for (int i = 0; i < num_points; ++i) {
+    PathPoint point;
+    point.set_x(i * 0.9);
+    point.set_y(10.0 * std::sin(i * 0.02));
+    point.set_theta(std::atan2(0.2 * std::cos(i * 0.02), 0.9));
+    if (i > 0) {
+      s += std::hypot(point.x() - path.back().x(), point.y() - path.back().y());
+    }
+    point.set_s(s);
+    path.push_back(point);
+  }
+  return path;
+}
+
+}  // namespace
+
+TEST(PathMatcherTest, IndexedPathMatcher) {
+  const std::vector<PathPoint> path = MakePath(500);
+  IndexedPathMatcher indexed_path_matcher(path);
+
+  // points along the path, as the corners of obstacles
+  for (int i = 0; i < 1000; ++i) {
+    const double x = RandomDouble(-20.0, 470.0);
+    const double y = RandomDouble(-20.0, 20.0);
+    const PathPoint expected = PathMatcher::MatchToPath(path, x, y);
+    const PathPoint matched = indexed_path_matcher.MatchToPath(x, y);
+    EXPECT_NEAR(expected.s(), matched.s(), 1e-9);
+    EXPECT_NEAR(expected.x(), matched.x(), 1e-9);
+    EXPECT_NEAR(expected.y(), matched.y(), 1e-9);
+
+    const auto expected_sl = PathMatcher::GetPathFrenetCoordinate(path, x, y);
+    const auto sl = indexed_path_matcher.GetPathFrenetCoordinate(x, y);
+    EXPECT_NEAR(expected_sl.first, sl.first, 1e-9);
+    EXPECT_NEAR(expected_sl.second, sl.second, 1e-9);
+  }
+}
+
+TEST(PathMatcherTest, SinglePoint) {
+  const std::vector<PathPoint> path = MakePath(1);
+  IndexedPathMatcher indexed_path_matcher(path);
+  const PathPoint matched = indexed_path_matcher.MatchToPath(3.0, 4.0);
+  EXPECT_DOUBLE_EQ(0.0, matched.s());
+  EXPECT_DOUBLE_EQ(0.0, matched.x());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -28,6 +28,98 @@
 namespace apollo {
 namespace common {
 namespace math {
+namespace {
+
+void SplitCoordinates(const std::vector<Vec2d> &points,
+                      std::vector<double> *const xs,
+                      std::vector<double> *const ys) {
+  xs->resize(points.size());
+  ys->resize(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    (*xs)[i] = points[i].x();
+    (*ys)[i] = points[i].y();
+  }
+}
+
+// LineSegment2d::IsPointIn of a segment longer than kMathEpsilon for each
+// point, set as 1.0 into on_boundary. The points never alias the results,
+// which spares the run time checks that keep the loops from being vectorized.
+void BoundaryKernel(const LineSegment2d &segment, const std::size_t size,
+                    const double *__restrict xs, const double *__restrict ys,
+                    double *__restrict on_boundary) {
+  const double start_x = segment.start().x();
+  const double start_y = segment.start().y();
+  const double end_x = segment.end().x();
+  const double end_y = segment.end().y();
+  const double lower_x = std::min(start_x, end_x) - kMathEpsilon;
+  const double upper_x = std::max(start_x, end_x) + kMathEpsilon;
+  const double lower_y = std::min(start_y, end_y) - kMathEpsilon;
+  const double upper_y = std::max(start_y, end_y) + kMathEpsilon;
+  for (std::size_t i = 0; i < size; ++i) {
+    const double prod = (start_x - xs[i]) * (end_y - ys[i]) -
+                        (start_y - ys[i]) * (end_x - xs[i]);
+    const bool within = (xs[i] >= lower_x) & (xs[i] <= upper_x) &
+                        (ys[i] >= lower_y) & (ys[i] <= upper_y);
+    const double on_segment = within ? 1.0 : on_boundary[i];
+    on_boundary[i] =
+        std::abs(prod) > kMathEpsilon ? on_boundary[i] : on_segment;
+  }
+}
+
+// counts the crossings of the edge from point_j to point_i by the rays cast
+// from the points, as Polygon2d::IsPointIn
+void CrossingKernel(const Vec2d &point_i, const Vec2d &point_j,
+                    const std::size_t size, const double *__restrict xs,
+                    const double *__restrict ys,
+                    double *__restrict crossings) {
+  const double x_i = point_i.x();
+  const double y_i = point_i.y();
+  const double x_j = point_j.x();
+  const double y_j = point_j.y();
+  // side < 0.0 is the same as -side > 0.0
+  const double side_sign = y_i < y_j ? 1.0 : -1.0;
+  for (std::size_t k = 0; k < size; ++k) {
+    const bool straddles = (y_i > ys[k]) != (y_j > ys[k]);
+    const double side =
+        (x_i - xs[k]) * (y_j - ys[k]) - (y_i - ys[k]) * (x_j - xs[k]);
+    const bool crosses = straddles & (side * side_sign > 0.0);
+    crossings[k] += crosses ? 1.0 : 0.0;
+  }
+}
+
+// LineSegment2d::DistanceSquareTo of a segment longer than kMathEpsilon for
+// each point, as the minimum with distance_sqrs
+void DistanceSquareKernel(const LineSegment2d &segment,
+                          const std::size_t size, const double *__restrict xs,
+                          const double *__restrict ys,
+                          double *__restrict distance_sqrs) {
+  const double start_x = segment.start().x();
+  const double start_y = segment.start().y();
+  const double end_x = segment.end().x();
+  const double end_y = segment.end().y();
+  const double unit_x = segment.unit_direction().x();
+  const double unit_y = segment.unit_direction().y();
+  const double length = segment.length();
+  for (std::size_t i = 0; i < size; ++i) {
+    const double x0 = xs[i] - start_x;
+    const double y0 = ys[i] - start_y;
+    const double proj = x0 * unit_x + y0 * unit_y;
+    const double start_distance_sqr = x0 * x0 + y0 * y0;
+    const double dx = xs[i] - end_x;
+    const double dy = ys[i] - end_y;
+    const double end_distance_sqr = dx * dx + dy * dy;
+    const double line_distance = x0 * unit_y - y0 * unit_x;
+    const double line_distance_sqr = line_distance * line_distance;
+    const double distance_sqr =
+        proj <= 0.0 ? start_distance_sqr
+                    : (proj >= length ? end_distance_sqr : line_distance_sqr);
+    // the same as std::min(distance_sqrs[i], distance_sqr)
+    distance_sqrs[i] =
+        distance_sqr < distance_sqrs[i] ? distance_sqr : distance_sqrs[i];
+  }
+}
+
+}  // namespace
 
 Polygon2d::Polygon2d(const Box2d &box) {
   box.GetAllCorners(&points_);
@@ -142,6 +234,68 @@ bool Polygon2d::IsPointIn(const Vec2d &point) const {
   return c & 1;
 }
 
+void Polygon2d::IsPointIn(const std::vector<Vec2d> &points,
+                          std::vector<int> *const points_in) const {
+  CHECK_GE(points_.size(), 3);
+  const std::size_t size = points.size();
+  std::vector<double> xs;
+  std::vector<double> ys;
+  SplitCoordinates(points, &xs, &ys);
+  std::vector<double> on_boundary(size, 0.0);
+  for (const LineSegment2d &segment : line_segments_) {
+    if (segment.length() > kMathEpsilon) {
+      BoundaryKernel(segment, size, xs.data(), ys.data(), on_boundary.data());
+      continue;
+    }
+    for (std::size_t k = 0; k < size; ++k) {
+      if (segment.IsPointIn(points[k])) {
+        on_boundary[k] = 1.0;
+      }
+    }
+  }
+  std::vector<double> crossings(size, 0.0);
+  int j = num_points_ - 1;
+  for (int i = 0; i < num_points_; ++i) {
+    CrossingKernel(points_[i], points_[j], size, xs.data(), ys.data(),
+                   crossings.data());
+    j = i;
+  }
+  points_in->resize(size);
+  for (std::size_t k = 0; k < size; ++k) {
+    (*points_in)[k] =
+        on_boundary[k] != 0.0 || (static_cast<int>(crossings[k]) & 1) ? 1 : 0;
+  }
+}
+
+void Polygon2d::DistanceSquareTo(
+    const std::vector<Vec2d> &points,
+    std::vector<double> *const distance_sqrs) const {
+  CHECK_GE(points_.size(), 3);
+  const std::size_t size = points.size();
+  std::vector<int> points_in;
+  IsPointIn(points, &points_in);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  SplitCoordinates(points, &xs, &ys);
+  distance_sqrs->assign(size, std::numeric_limits<double>::infinity());
+  for (const LineSegment2d &segment : line_segments_) {
+    if (segment.length() > kMathEpsilon) {
+      DistanceSquareKernel(segment, size, xs.data(), ys.data(),
+                           distance_sqrs->data());
+      continue;
+    }
+    for (std::size_t k = 0; k < size; ++k) {
+      (*distance_sqrs)[k] =
+          std::min((*distance_sqrs)[k], segment.DistanceSquareTo(points[k]));
+    }
+  }
+  for (std::size_t k = 0; k < size; ++k) {
+    if (points_in[k] != 0) {
+      (*distance_sqrs)[k] = 0.0;
+    }
+  }
+}
+
 bool Polygon2d::HasOverlap(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   if (polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
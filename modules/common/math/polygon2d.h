@@ -168,6 +168,25 @@ class Polygon2d {
    */
   bool IsPointOnBoundary(const Vec2d &point) const;
 
+  /**
+   * @brief Check for each of many points if it is within the polygon. The
+   *        points are tested against one edge after another in branch free
+   *        loops, which the compiler vectorizes.
+   * @param points The target points.
+   * @param points_in The i-th element is IsPointIn(points[i]), as 0 or 1.
+   */
+  void IsPointIn(const std::vector<Vec2d> &points,
+                 std::vector<int> *const points_in) const;
+
+  /**
+   * @brief Compute the squares of distance from many points to the polygon,
+   *        in vectorized loops as IsPointIn does for many points.
+   * @param points The points to compute whose squares of distance.
+   * @param distance_sqrs The i-th element is DistanceSquareTo(points[i]).
+   */
+  void DistanceSquareTo(const std::vector<Vec2d> &points,
+                        std::vector<double> *const distance_sqrs) const;
+
   /**
    * @brief Check if the polygon contains a line segment.
    * @param line_segment The target line segment. To check if the polygon
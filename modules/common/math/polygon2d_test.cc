@@ -342,6 +342,34 @@ TEST(Polygon2dTest, ConvexHull) {
   }
 }
 
+TEST(Polygon2dTest, BatchPointQueries) {
+  const std::vector<Polygon2d> polygons = {
+      Polygon2d(Box2d(Vec2d(1.0, 2.0), 0.4, 4.0, 2.0)),
+      Polygon2d({{0, 0}, {4, 0}, {4, 4}, {2, 2}, {0, 4}}),
+      Polygon2d({{-1, 0}, {0, -1}, {1, 0}, {0, 3}})};
+  std::vector<Vec2d> points;
+  for (double x = -2.0; x <= 6.0; x += 0.25) {
+    for (double y = -2.0; y <= 6.0; y += 0.25) {
+      points.emplace_back(x, y);
+    }
+  }
+  for (int i = 0; i < 200; ++i) {
+    points.emplace_back(RandomDouble(-3.0, 7.0), RandomDouble(-3.0, 7.0));
+  }
+  for (const Polygon2d &polygon : polygons) {
+    std::vector<int> points_in;
+    polygon.IsPointIn(points, &points_in);
+    std::vector<double> distance_sqrs;
+    polygon.DistanceSquareTo(points, &distance_sqrs);
+    ASSERT_EQ(points.size(), points_in.size());
+    ASSERT_EQ(points.size(), distance_sqrs.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(polygon.IsPointIn(points[i]), points_in[i] != 0);
+      EXPECT_EQ(polygon.DistanceSquareTo(points[i]), distance_sqrs[i]);
+    }
+  }
+}
+
 TEST(Polygon2dTest, Overlap) {
   const Polygon2d poly1(Box2d::CreateAABox({0, 0}, {2, 2}));
   const Polygon2d poly2(Box2d::CreateAABox({1, 1}, {3, 3}));
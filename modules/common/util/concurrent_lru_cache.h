@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "modules/common/util/lru_cache.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/*
+ * An LRUCache which can be shared by threads. The keys are spread by their
+ * hash over shards, each of which is an LRUCache with its own lock, so that
+ * threads working on different keys rarely wait for each other. Entries are
+ * evicted in the least recently used order of their shard, which
+ * approximates the order of the whole cache.
+ *
+ * The values are copied in and out under the lock of their shard; there is
+ * no access by pointer, as another thread may evict the entry at any time.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ConcurrentLRUCache {
+ public:
+  static constexpr size_t kDefaultNumShards = 16;
+
+  explicit ConcurrentLRUCache(const size_t capacity,
+                              const size_t num_shards = kDefaultNumShards) {
+    // every shard holds at least one entry
+    const size_t shard_count = std::max<size_t>(
+        1, std::min(num_shards, std::max<size_t>(1, capacity)));
+    shard_capacity_ = (capacity + shard_count - 1) / shard_count;
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+      shards_.emplace_back(new Shard(shard_capacity_));
+    }
+  }
+
+  /*
+   * for both add & update purposes
+   */
+  template <typename VV>
+  bool Put(const K& key, VV&& val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.Put(key, std::forward<VV>(val));
+  }
+
+  /*
+   * update existing elements only
+   */
+  template <typename VV>
+  bool Update(const K& key, VV&& val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.Update(key, std::forward<VV>(val));
+  }
+
+  /*
+   * silently update existing elements only
+   */
+  template <typename VV>
+  bool UpdateSilently(const K& key, VV* val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.UpdateSilently(key, val);
+  }
+
+  /*
+   * add new elements only
+   */
+  template <typename VV>
+  bool Add(const K& key, VV* val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.Add(key, val);
+  }
+
+  template <typename VV>
+  bool PutAndGetObsolete(const K& key, VV* val, K* obs) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.PutAndGetObsolete(key, val, obs);
+  }
+
+  template <typename VV>
+  bool AddAndGetObsolete(const K& key, VV* val, K* obs) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.AddAndGetObsolete(key, val, obs);
+  }
+
+  bool GetCopySilently(const K& key, V* const val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.GetCopySilently(key, val);
+  }
+
+  bool GetCopy(const K& key, V* const val) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.GetCopy(key, val);
+  }
+
+  bool Contains(const K& key) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.Contains(key);
+  }
+
+  bool Prioritize(const K& key) {
+    Shard* shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->cache.Prioritize(key);
+  }
+
+  /*
+   * the sum of the shard sizes, each of which may change right after it is
+   * read
+   */
+  size_t size() {
+    size_t size = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->cache.size();
+    }
+    return size;
+  }
+
+  bool Empty() { return size() == 0; }
+
+  size_t capacity() const { return shards_.size() * shard_capacity_; }
+
+  size_t num_shards() const { return shards_.size(); }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->cache.Clear();
+    }
+  }
+
+ private:
+  struct Shard {
+    explicit Shard(const size_t capacity) : cache(capacity) {}
+    std::mutex mutex;
+    LRUCache<K, V> cache;
+  };
+
+  Shard* GetShard(const K& key) {
+    return shards_[hash_(key) % shards_.size()].get();
+  }
+
+  Hash hash_;
+  size_t shard_capacity_ = 0;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
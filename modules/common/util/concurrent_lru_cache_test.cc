@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/concurrent_lru_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ConcurrentLRUCache, SingleShard) {
+  // with one shard, it evicts as the LRUCache does
+  ConcurrentLRUCache<int, int> cache(3, 1);
+  EXPECT_EQ(1, cache.num_shards());
+  EXPECT_EQ(3, cache.capacity());
+  EXPECT_TRUE(cache.Empty());
+  EXPECT_TRUE(cache.Put(1, 10));
+  EXPECT_TRUE(cache.Put(2, 20));
+  EXPECT_TRUE(cache.Put(3, 30));
+  int value = 0;
+  EXPECT_TRUE(cache.GetCopy(1, &value));
+  EXPECT_EQ(10, value);
+  int obsolete = -1;
+  int new_value = 40;
+  EXPECT_TRUE(cache.PutAndGetObsolete(4, &new_value, &obsolete));
+  EXPECT_EQ(2, obsolete);
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_EQ(3, cache.size());
+
+  // the same results as the LRUCache for the other operations
+  LRUCache<int, int> lru_cache(3);
+  for (int key : {1, 3, 4}) {
+    cache.GetCopy(key, &value);
+    lru_cache.Put(key, value);
+  }
+  EXPECT_EQ(lru_cache.Update(3, 31), cache.Update(3, 31));
+  EXPECT_EQ(lru_cache.Update(5, 50), cache.Update(5, 50));
+  new_value = 11;
+  EXPECT_EQ(lru_cache.Add(1, &new_value), cache.Add(1, &new_value));
+  EXPECT_EQ(lru_cache.Prioritize(3), cache.Prioritize(3));
+  for (int key : {1, 3, 4, 5}) {
+    int lru_value = 0;
+    value = 0;
+    EXPECT_EQ(lru_cache.GetCopySilently(key, &lru_value),
+              cache.GetCopySilently(key, &value));
+    EXPECT_EQ(lru_value, value);
+  }
+
+  cache.Clear();
+  EXPECT_TRUE(cache.Empty());
+  EXPECT_FALSE(cache.GetCopy(1, &value));
+}
+
+TEST(ConcurrentLRUCache, Shards) {
+  ConcurrentLRUCache<int, int> cache(100, 8);
+  EXPECT_EQ(8, cache.num_shards());
+  EXPECT_EQ(104, cache.capacity());
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, i * 2);
+    EXPECT_LE(cache.size(), cache.capacity());
+  }
+  // the most recent entry of each shard is kept
+  int value = 0;
+  EXPECT_TRUE(cache.GetCopy(999, &value));
+  EXPECT_EQ(1998, value);
+  EXPECT_FALSE(cache.Contains(0));
+
+  // fewer entries than shards
+  ConcurrentLRUCache<int, int> small_cache(2, 8);
+  EXPECT_EQ(2, small_cache.num_shards());
+  EXPECT_EQ(2, small_cache.capacity());
+}
+
+TEST(ConcurrentLRUCache, ConcurrentAccess) {
+  ConcurrentLRUCache<int, std::string> cache(64, 4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 5000; ++i) {
+        const int key = (i * 7 + t) % 128;
+        std::string value;
+        if (cache.GetCopy(key, &value)) {
+          EXPECT_EQ(std::to_string(key), value);
+        } else {
+          cache.Put(key, std::to_string(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_FALSE(cache.Empty());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A string with its capacity fixed at compile time.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class FixedString
+ * @brief A string of up to N chars stored inline, for ids and names which
+ * have a known bound, so that copying them never allocates. Input longer
+ * than N is truncated; assign() and append() tell when that happened.
+ */
+template <size_t N>
+class FixedString {
+ public:
+  FixedString() { data_[0] = '\0'; }
+
+  FixedString(const char* str) { assign(str); }  // NOLINT
+
+  FixedString(const std::string& str) { assign(str); }  // NOLINT
+
+  FixedString(const char* str, const size_t length) { assign(str, length); }
+
+  static constexpr size_t capacity() { return N; }
+  size_t size() const { return size_; }
+  size_t length() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const char* c_str() const { return data_; }
+  const char* data() const { return data_; }
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + size_; }
+  char operator[](const size_t i) const { return data_[i]; }
+
+  std::string ToString() const { return std::string(data_, size_); }
+
+  /**
+   * @return false if str was truncated to fit.
+   */
+  bool assign(const char* str, const size_t length) {
+    size_ = 0;
+    return append(str, length);
+  }
+  bool assign(const char* str) { return assign(str, std::strlen(str)); }
+  bool assign(const std::string& str) {
+    return assign(str.data(), str.size());
+  }
+
+  /**
+   * @return false if str was truncated to fit.
+   */
+  bool append(const char* str, const size_t length) {
+    const size_t count = std::min(length, N - size_);
+    std::memcpy(data_ + size_, str, count);
+    size_ += count;
+    data_[size_] = '\0';
+    return count == length;
+  }
+  bool append(const char* str) { return append(str, std::strlen(str)); }
+  bool append(const std::string& str) {
+    return append(str.data(), str.size());
+  }
+
+  void clear() {
+    size_ = 0;
+    data_[0] = '\0';
+  }
+
+  int compare(const char* str, const size_t length) const {
+    const int ret = std::memcmp(data_, str, std::min(size_, length));
+    if (ret != 0) {
+      return ret;
+    }
+    return size_ < length ? -1 : (size_ > length ? 1 : 0);
+  }
+
+ private:
+  char data_[N + 1];
+  size_t size_ = 0;
+};
+
+template <size_t N>
+bool operator==(const FixedString<N>& lhs, const FixedString<N>& rhs) {
+  return lhs.compare(rhs.data(), rhs.size()) == 0;
+}
+
+template <size_t N>
+bool operator==(const FixedString<N>& lhs, const std::string& rhs) {
+  return lhs.compare(rhs.data(), rhs.size()) == 0;
+}
+
+template <size_t N>
+bool operator==(const FixedString<N>& lhs, const char* rhs) {
+  return lhs.compare(rhs, std::strlen(rhs)) == 0;
+}
+
+template <size_t N>
+bool operator==(const std::string& lhs, const FixedString<N>& rhs) {
+  return rhs == lhs;
+}
+
+template <size_t N>
+bool operator==(const char* lhs, const FixedString<N>& rhs) {
+  return rhs == lhs;
+}
+
+template <size_t N, typename U>
+bool operator!=(const FixedString<N>& lhs, const U& rhs) {
+  return !(lhs == rhs);
+}
+
+template <size_t N>
+bool operator!=(const std::string& lhs, const FixedString<N>& rhs) {
+  return !(rhs == lhs);
+}
+
+template <size_t N>
+bool operator!=(const char* lhs, const FixedString<N>& rhs) {
+  return !(rhs == lhs);
+}
+
+template <size_t N>
+bool operator<(const FixedString<N>& lhs, const FixedString<N>& rhs) {
+  return lhs.compare(rhs.data(), rhs.size()) < 0;
+}
+
+template <size_t N>
+std::ostream& operator<<(std::ostream& os, const FixedString<N>& str) {
+  return os.write(str.data(), str.size());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+namespace std {
+
+template <size_t N>
+struct hash<apollo::common::util::FixedString<N>> {
+  size_t operator()(const apollo::common::util::FixedString<N>& str) const {
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+    for (const char c : str) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return hash;
+  }
+};
+
+}  // namespace std
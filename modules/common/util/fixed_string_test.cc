@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/common/util/fixed_string.h"
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(FixedStringTest, AssignAndAppend) {
+  FixedString<8> str;
+  EXPECT_TRUE(str.empty());
+  EXPECT_STREQ("", str.c_str());
+
+  EXPECT_TRUE(str.assign("lane"));
+  EXPECT_TRUE(str.append("_1"));
+  EXPECT_EQ(6, str.size());
+  EXPECT_EQ("lane_1", str);
+  EXPECT_EQ(std::string("lane_1"), str.ToString());
+
+  // too long for the capacity
+  EXPECT_FALSE(str.append("_23"));
+  EXPECT_EQ("lane_1_2", str);
+  EXPECT_FALSE(str.assign(std::string("0123456789")));
+  EXPECT_EQ("01234567", str);
+  EXPECT_STREQ("01234567", str.c_str());
+
+  str.clear();
+  EXPECT_EQ("", str);
+}
+
+TEST(FixedStringTest, Compare) {
+  const FixedString<16> a("abc");
+  const FixedString<16> b("abd");
+  const FixedString<16> ab("ab");
+  EXPECT_EQ(a, FixedString<16>(std::string("abc")));
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, ab);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(ab < a);
+  EXPECT_FALSE(a < a);
+
+  std::ostringstream os;
+  os << a;
+  EXPECT_EQ("abc", os.str());
+}
+
+TEST(FixedStringTest, Hash) {
+  std::unordered_set<FixedString<16>> set;
+  set.insert("obstacle_1");
+  set.insert("obstacle_2");
+  set.insert("obstacle_1");
+  EXPECT_EQ(2, set.size());
+  EXPECT_EQ(1, set.count("obstacle_2"));
+  EXPECT_EQ(0, set.count("obstacle_3"));
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A vector with its capacity fixed at compile time.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class FixedVector
+ * @brief A subset of std::vector storing up to N elements inline, so it never
+ * allocates. Growing past N is a programming error and aborts; check full()
+ * first where the input may legitimately exceed the capacity.
+ */
+template <typename T, size_t N>
+class FixedVector {
+ public:
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  FixedVector() = default;
+
+  FixedVector(const size_t count, const T& value) {
+    for (size_t i = 0; i < count; ++i) {
+      push_back(value);
+    }
+  }
+
+  FixedVector(std::initializer_list<T> init) {
+    for (const T& value : init) {
+      push_back(value);
+    }
+  }
+
+  FixedVector(const FixedVector& other) {
+    for (const T& value : other) {
+      push_back(value);
+    }
+  }
+
+  FixedVector(FixedVector&& other) {
+    for (T& value : other) {
+      push_back(std::move(value));
+    }
+    other.clear();
+  }
+
+  ~FixedVector() { clear(); }
+
+  FixedVector& operator=(const FixedVector& other) {
+    if (this != &other) {
+      clear();
+      for (const T& value : other) {
+        push_back(value);
+      }
+    }
+    return *this;
+  }
+
+  FixedVector& operator=(FixedVector&& other) {
+    if (this != &other) {
+      clear();
+      for (T& value : other) {
+        push_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  static constexpr size_t capacity() { return N; }
+  static constexpr size_t max_size() { return N; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == N; }
+
+  T* data() { return reinterpret_cast<T*>(storage_); }
+  const T* data() const { return reinterpret_cast<const T*>(storage_); }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  T& operator[](const size_t i) { return data()[i]; }
+  const T& operator[](const size_t i) const { return data()[i]; }
+
+  T& at(const size_t i) {
+    ACHECK(i < size_) << "index " << i << " out of size " << size_;
+    return data()[i];
+  }
+  const T& at(const size_t i) const {
+    ACHECK(i < size_) << "index " << i << " out of size " << size_;
+    return data()[i];
+  }
+
+  T& front() { return data()[0]; }
+  const T& front() const { return data()[0]; }
+  T& back() { return data()[size_ - 1]; }
+  const T& back() const { return data()[size_ - 1]; }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    ACHECK(size_ < N) << "FixedVector is full at " << N;
+    T* value = new (data() + size_) T(std::forward<Args>(args)...);
+    ++size_;
+    return *value;
+  }
+
+  void pop_back() {
+    --size_;
+    data()[size_].~T();
+  }
+
+  /**
+   * @brief Removes [first, last) and returns the position following them.
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator dst = begin() + (first - cbegin());
+    iterator src = begin() + (last - cbegin());
+    if (dst != src) {
+      iterator new_end = std::move(src, end(), dst);
+      while (end() != new_end) {
+        pop_back();
+      }
+    }
+    return dst;
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  void resize(const size_t count) {
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      emplace_back();
+    }
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop_back();
+    }
+  }
+
+ private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_[N];
+  size_t size_ = 0;
+};
+
+template <typename T, size_t N>
+bool operator==(const FixedVector<T, N>& lhs, const FixedVector<T, N>& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t N>
+bool operator!=(const FixedVector<T, N>& lhs, const FixedVector<T, N>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
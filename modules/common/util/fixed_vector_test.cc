@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/common/util/fixed_vector.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(FixedVectorTest, PushAndPop) {
+  FixedVector<std::string, 4> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(4, vec.capacity());
+  vec.push_back("a");
+  vec.emplace_back(2, 'b');
+  vec.push_back(std::string("c"));
+  EXPECT_EQ(3, vec.size());
+  EXPECT_FALSE(vec.full());
+  EXPECT_EQ("a", vec.front());
+  EXPECT_EQ("bb", vec[1]);
+  EXPECT_EQ("c", vec.back());
+  vec.push_back("d");
+  EXPECT_TRUE(vec.full());
+
+  vec.pop_back();
+  EXPECT_EQ(3, vec.size());
+  EXPECT_EQ("c", vec.back());
+
+  std::string joined;
+  for (const auto& str : vec) {
+    joined += str;
+  }
+  EXPECT_EQ("abbc", joined);
+}
+
+TEST(FixedVectorTest, Erase) {
+  FixedVector<int, 8> vec = {0, 1, 2, 3, 4, 5};
+  auto iter = vec.erase(vec.begin() + 1);
+  EXPECT_EQ(2, *iter);
+  EXPECT_EQ((FixedVector<int, 8>{0, 2, 3, 4, 5}), vec);
+  iter = vec.erase(vec.begin() + 1, vec.begin() + 3);
+  EXPECT_EQ(4, *iter);
+  EXPECT_EQ((FixedVector<int, 8>{0, 4, 5}), vec);
+  vec.erase(vec.begin(), vec.end());
+  EXPECT_TRUE(vec.empty());
+
+  vec.resize(3);
+  EXPECT_EQ((FixedVector<int, 8>{0, 0, 0}), vec);
+}
+
+TEST(FixedVectorTest, CopyAndMove) {
+  FixedVector<std::unique_ptr<int>, 2> ptrs;
+  ptrs.emplace_back(new int(1));
+  ptrs.emplace_back(new int(2));
+  FixedVector<std::unique_ptr<int>, 2> moved(std::move(ptrs));
+  EXPECT_TRUE(ptrs.empty());
+  ASSERT_EQ(2, moved.size());
+  EXPECT_EQ(2, *moved[1]);
+
+  FixedVector<std::string, 2> strs(2, "x");
+  FixedVector<std::string, 2> copy;
+  copy = strs;
+  EXPECT_EQ(strs, copy);
+  copy[0] = "y";
+  EXPECT_NE(strs, copy);
+}
+
+TEST(FixedVectorTest, DestroysElements) {
+  auto counter = std::make_shared<int>(0);
+  {
+    FixedVector<std::shared_ptr<int>, 4> vec(3, counter);
+    EXPECT_EQ(4, counter.use_count());
+    vec.pop_back();
+    EXPECT_EQ(3, counter.use_count());
+  }
+  EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(FixedVectorDeathTest, Overflow) {
+  FixedVector<int, 1> vec;
+  vec.push_back(1);
+  EXPECT_DEATH(vec.push_back(2), "");
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,396 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief An open addressing hash map with a bounded capacity.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class FlatHashMap
+ * @brief A subset of std::unordered_map which keeps its entries in a single
+ * table, allocated when the map is constructed or reserve() is called. It
+ * never allocates otherwise: inserting into a full map fails, returning
+ * {end(), false}, and erasing or clearing keeps the table for reuse.
+ *
+ * Keys are placed by linear probing and erased by shifting the following
+ * entries back, so there are no tombstones and lookups stay short however
+ * many times the map is refilled. Like std::unordered_map, pointers and
+ * iterators are invalidated by reserve(); unlike it, erase() moves other
+ * entries and invalidates them too.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class FlatHashMap {
+ private:
+  struct Slot {
+    bool used = false;
+    typename std::aligned_storage<sizeof(std::pair<const K, V>),
+                                  alignof(std::pair<const K, V>)>::type value;
+  };
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<
+      Slot>
+      SlotAllocator;
+
+  template <typename Value, typename SlotType>
+  class Iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    Iterator() = default;
+    Iterator(SlotType* slot, SlotType* end) : slot_(slot), end_(end) {
+      SkipUnused();
+    }
+    // iterator to const_iterator
+    template <typename OtherValue, typename OtherSlot>
+    Iterator(const Iterator<OtherValue, OtherSlot>& other)  // NOLINT
+        : slot_(other.slot_), end_(other.end_) {}
+
+    Value& operator*() const {
+      return *reinterpret_cast<Value*>(&slot_->value);
+    }
+    Value* operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      ++slot_;
+      SkipUnused();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return slot_ == other.slot_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return slot_ != other.slot_;
+    }
+
+   private:
+    template <typename, typename>
+    friend class Iterator;
+    friend class FlatHashMap;
+
+    void SkipUnused() {
+      while (slot_ != end_ && !slot_->used) {
+        ++slot_;
+      }
+    }
+
+    SlotType* slot_ = nullptr;
+    SlotType* end_ = nullptr;
+  };
+
+ public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<const K, V> value_type;
+  typedef Hash hasher;
+  typedef KeyEqual key_equal;
+  typedef Allocator allocator_type;
+  typedef Iterator<value_type, Slot> iterator;
+  typedef Iterator<const value_type, const Slot> const_iterator;
+
+  /**
+   * @brief Constructs a map which holds up to capacity entries.
+   */
+  explicit FlatHashMap(const size_t capacity = 0,
+                       const Allocator& allocator = Allocator())
+      : allocator_(allocator) {
+    reserve(capacity);
+  }
+
+  explicit FlatHashMap(const Allocator& allocator)
+      : FlatHashMap(0, allocator) {}
+
+  /**
+   * @brief Like the standard containers, the copy takes the allocator the
+   * one of the source selects for copies.
+   */
+  FlatHashMap(const FlatHashMap& other)
+      : allocator_(std::allocator_traits<SlotAllocator>::
+                       select_on_container_copy_construction(
+                           other.allocator_)) {
+    reserve(other.size());
+    for (const auto& entry : other) {
+      emplace(entry.first, entry.second);
+    }
+  }
+
+  FlatHashMap(FlatHashMap&& other) : allocator_(other.allocator_) {
+    Swap(&other);
+  }
+
+  ~FlatHashMap() {
+    clear();
+    Deallocate();
+  }
+
+  /**
+   * @brief Keeps the allocator of this map, and its table when it is large
+   * enough for the entries of other.
+   */
+  FlatHashMap& operator=(const FlatHashMap& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      for (const auto& entry : other) {
+        emplace(entry.first, entry.second);
+      }
+    }
+    return *this;
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (allocator_ == other.allocator_) {
+      clear();
+      Swap(&other);
+    } else {
+      clear();
+      reserve(other.size());
+      for (auto& entry : other) {
+        emplace(entry.first, std::move(entry.second));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(allocator_); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  /**
+   * @brief The number of entries the map holds without reserve().
+   */
+  size_t capacity() const { return capacity_; }
+  bool full() const { return size_ == capacity_; }
+
+  iterator begin() { return iterator(slots_, slots_ + num_slots_); }
+  iterator end() {
+    return iterator(slots_ + num_slots_, slots_ + num_slots_);
+  }
+  const_iterator begin() const {
+    return const_iterator(slots_, slots_ + num_slots_);
+  }
+  const_iterator end() const {
+    return const_iterator(slots_ + num_slots_, slots_ + num_slots_);
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  iterator find(const K& key) {
+    Slot* slot = FindSlot(key);
+    return slot == nullptr ? end() : iterator(slot, slots_ + num_slots_);
+  }
+
+  const_iterator find(const K& key) const {
+    const Slot* slot = const_cast<FlatHashMap*>(this)->FindSlot(key);
+    return slot == nullptr ? end()
+                           : const_iterator(slot, slots_ + num_slots_);
+  }
+
+  size_t count(const K& key) const { return find(key) == end() ? 0 : 1; }
+
+  /**
+   * @brief Inserts {key, V(args...)} if the key is not in the map yet.
+   * @return The entry of the key and whether it was inserted, or
+   * {end(), false} if the key is new but the map is full.
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+    if (num_slots_ == 0) {
+      return {end(), false};
+    }
+    size_t index = Index(key);
+    while (slots_[index].used) {
+      if (key_equal_(Value(&slots_[index]).first, key)) {
+        return {iterator(&slots_[index], slots_ + num_slots_), false};
+      }
+      index = (index + 1) & (num_slots_ - 1);
+    }
+    if (full()) {
+      return {end(), false};
+    }
+    new (&slots_[index].value) value_type(
+        std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    slots_[index].used = true;
+    ++size_;
+    return {iterator(&slots_[index], slots_ + num_slots_), true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value.first, value.second);
+  }
+
+  /**
+   * @return The number of erased entries, 0 or 1.
+   */
+  size_t erase(const K& key) {
+    Slot* slot = FindSlot(key);
+    if (slot == nullptr) {
+      return 0;
+    }
+    const size_t mask = num_slots_ - 1;
+    size_t hole = slot - slots_;
+    Value(slot).~value_type();
+    // Shift back the entries which would not be found across the hole.
+    for (size_t i = (hole + 1) & mask; slots_[i].used; i = (i + 1) & mask) {
+      const size_t home = Index(Value(&slots_[i]).first);
+      // distances of the hole and the entry from its home slot
+      if (((hole - home) & mask) < ((i - home) & mask)) {
+        new (&slots_[hole].value) value_type(std::move(Value(&slots_[i])));
+        Value(&slots_[i]).~value_type();
+        hole = i;
+      }
+    }
+    slots_[hole].used = false;
+    --size_;
+    return 1;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < num_slots_ && size_ > 0; ++i) {
+      if (slots_[i].used) {
+        Value(&slots_[i]).~value_type();
+        slots_[i].used = false;
+        --size_;
+      }
+    }
+  }
+
+  /**
+   * @brief Grows the table to hold at least capacity entries. This is the
+   * only call, besides the constructors, which allocates.
+   */
+  void reserve(const size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    // keep the load factor under 3/4
+    size_t num_slots = 8;
+    while (num_slots * 3 / 4 < capacity) {
+      num_slots *= 2;
+    }
+    Slot* old_slots = slots_;
+    const size_t old_num_slots = num_slots_;
+    slots_ = std::allocator_traits<SlotAllocator>::allocate(allocator_,
+                                                            num_slots);
+    for (size_t i = 0; i < num_slots; ++i) {
+      new (&slots_[i]) Slot();
+    }
+    num_slots_ = num_slots;
+    capacity_ = num_slots * 3 / 4;
+    shift_ = 64;
+    for (size_t n = num_slots; n > 1; n >>= 1) {
+      --shift_;
+    }
+    size_ = 0;
+    for (size_t i = 0; i < old_num_slots; ++i) {
+      if (old_slots[i].used) {
+        emplace(Value(&old_slots[i]).first,
+                std::move(Value(&old_slots[i]).second));
+        Value(&old_slots[i]).~value_type();
+      }
+    }
+    if (old_slots != nullptr) {
+      std::allocator_traits<SlotAllocator>::deallocate(allocator_, old_slots,
+                                                       old_num_slots);
+    }
+  }
+
+ private:
+  static value_type& Value(Slot* slot) {
+    return *reinterpret_cast<value_type*>(&slot->value);
+  }
+
+  size_t Index(const K& key) const {
+    // Fibonacci hashing spreads the identity hashes of integers.
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(hasher_(key)) * 0x9E3779B97F4A7C15ULL) >>
+        shift_);
+  }
+
+  Slot* FindSlot(const K& key) {
+    if (size_ == 0) {
+      return nullptr;
+    }
+    for (size_t index = Index(key); slots_[index].used;
+         index = (index + 1) & (num_slots_ - 1)) {
+      if (key_equal_(Value(&slots_[index]).first, key)) {
+        return &slots_[index];
+      }
+    }
+    return nullptr;
+  }
+
+  void Swap(FlatHashMap* other) {
+    std::swap(slots_, other->slots_);
+    std::swap(num_slots_, other->num_slots_);
+    std::swap(capacity_, other->capacity_);
+    std::swap(size_, other->size_);
+    std::swap(shift_, other->shift_);
+  }
+
+  void Deallocate() {
+    if (slots_ != nullptr) {
+      std::allocator_traits<SlotAllocator>::deallocate(allocator_, slots_,
+                                                       num_slots_);
+      slots_ = nullptr;
+    }
+  }
+
+  SlotAllocator allocator_;
+  Hash hasher_;
+  KeyEqual key_equal_;
+  Slot* slots_ = nullptr;
+  size_t num_slots_ = 0;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  int shift_ = 64;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/common/util/flat_hash_map.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+namespace {
+
+int num_allocations = 0;
+
+template <typename T>
+struct CountingAllocator : public std::allocator<T> {
+  template <typename U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {}  // NOLINT
+
+  T* allocate(const size_t n) {
+    ++num_allocations;
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+}  // namespace
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<std::string, int> map(4);
+  EXPECT_TRUE(map.empty());
+  EXPECT_LE(4, map.capacity());
+
+  EXPECT_TRUE(map.emplace("one", 1).second);
+  EXPECT_TRUE(map.insert({"two", 2}).second);
+  auto result = map.emplace("one", 11);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, result.first->second);
+  EXPECT_EQ(2, map.size());
+
+  ASSERT_NE(map.end(), map.find("two"));
+  EXPECT_EQ(2, map.find("two")->second);
+  EXPECT_EQ(map.end(), map.find("three"));
+  EXPECT_EQ(1, map.count("one"));
+
+  EXPECT_EQ(1, map.erase("one"));
+  EXPECT_EQ(0, map.erase("one"));
+  EXPECT_EQ(0, map.count("one"));
+  EXPECT_EQ(1, map.count("two"));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatHashMapTest, FailsWhenFull) {
+  FlatHashMap<int, int> map(10);
+  const size_t capacity = map.capacity();
+  for (size_t i = 0; i < capacity; ++i) {
+    EXPECT_TRUE(map.emplace(static_cast<int>(i), 0).second);
+  }
+  EXPECT_TRUE(map.full());
+  auto result = map.emplace(-1, 0);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(map.end(), result.first);
+  // existing keys are still found
+  EXPECT_FALSE(map.emplace(0, 1).second);
+
+  map.reserve(capacity + 1);
+  EXPECT_LT(capacity, map.capacity());
+  EXPECT_TRUE(map.emplace(-1, 0).second);
+  for (size_t i = 0; i < capacity; ++i) {
+    EXPECT_EQ(1, map.count(static_cast<int>(i)));
+  }
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap) {
+  FlatHashMap<int, int> map(256);
+  std::unordered_map<int, int> expected;
+  uint32_t seed = 1;
+  for (int step = 0; step < 100000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    // few distinct keys, so the probe sequences collide and wrap around
+    const int key = static_cast<int>((seed >> 16) % 300) * 64;
+    if ((seed >> 8) % 3 == 0) {
+      EXPECT_EQ(expected.erase(key), map.erase(key));
+    } else if (expected.size() < map.capacity() || expected.count(key)) {
+      EXPECT_EQ(expected.emplace(key, step).second,
+                map.emplace(key, step).second);
+    }
+    ASSERT_EQ(expected.size(), map.size());
+  }
+  size_t num_entries = 0;
+  for (const auto& entry : map) {
+    ASSERT_EQ(1, expected.count(entry.first));
+    EXPECT_EQ(expected[entry.first], entry.second);
+    ++num_entries;
+  }
+  EXPECT_EQ(expected.size(), num_entries);
+}
+
+TEST(FlatHashMapTest, NoAllocationAfterConstruction) {
+  typedef FlatHashMap<int, int, std::hash<int>, std::equal_to<int>,
+                      CountingAllocator<std::pair<const int, int>>>
+      Map;
+  num_allocations = 0;
+  Map map(32);
+  EXPECT_EQ(1, num_allocations);
+  for (int i = 0; i < 1000; ++i) {
+    map.emplace(i, i);
+    if (map.full()) {
+      map.clear();
+    }
+    map.erase(i - 5);
+  }
+  EXPECT_EQ(1, num_allocations);
+
+  Map moved(std::move(map));
+  EXPECT_EQ(1, num_allocations);
+  EXPECT_EQ(0, map.capacity());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
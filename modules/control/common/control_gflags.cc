@@ -56,3 +56,12 @@ DEFINE_int32(pad_msg_pending_queue_size, 10,
              "Max pad message pending queue size");
 
 DEFINE_bool(reverse_heading_control, false, "test vehicle reverse control");
+
+DEFINE_bool(enable_control_latency_report, false,
+            "Publish the timing of every control cycle on the control "
+            "latency topic");
+DEFINE_double(control_latency_jitter_bucket_ms, 0.5,
+              "Width of the buckets of the control cycle jitter histogram, "
+              "in ms");
+DEFINE_int32(control_latency_jitter_bucket_num, 20,
+             "Number of buckets of the control cycle jitter histogram");
@@ -50,3 +50,7 @@ DECLARE_int32(localization_pending_queue_size);
 DECLARE_int32(pad_msg_pending_queue_size);
 
 DECLARE_bool(reverse_heading_control);
+
+DECLARE_bool(enable_control_latency_report);
+DECLARE_double(control_latency_jitter_bucket_ms);
+DECLARE_int32(control_latency_jitter_bucket_num);
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/jitter_monitor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace control {
+
+JitterMonitor::JitterMonitor(const double period_ms,
+                             const double bucket_width_ms,
+                             const int num_buckets)
+    : period_ms_(period_ms),
+      bucket_width_ms_(bucket_width_ms),
+      counts_(std::max(num_buckets, 1), 0) {
+  CHECK_GT(bucket_width_ms_, 0.0);
+}
+
+void JitterMonitor::AddCycle(const double timestamp_sec) {
+  const double last_timestamp_sec = last_timestamp_sec_;
+  last_timestamp_sec_ = timestamp_sec;
+  if (last_timestamp_sec <= 0.0) {
+    return;
+  }
+  cycle_time_ms_ = (timestamp_sec - last_timestamp_sec) * 1000;
+  jitter_ms_ = cycle_time_ms_ - period_ms_;
+
+  const double abs_jitter_ms = std::abs(jitter_ms_);
+  const size_t bucket =
+      std::min(static_cast<size_t>(abs_jitter_ms / bucket_width_ms_),
+               counts_.size() - 1);
+  ++counts_[bucket];
+  max_jitter_ms_ = std::max(max_jitter_ms_, abs_jitter_ms);
+  sum_jitter_ms_ += abs_jitter_ms;
+  ++num_cycles_;
+}
+
+void JitterMonitor::GetHistogram(JitterHistogram *histogram) const {
+  CHECK_NOTNULL(histogram);
+  histogram->Clear();
+  histogram->set_bucket_width_ms(bucket_width_ms_);
+  for (const uint64_t count : counts_) {
+    histogram->add_count(count);
+  }
+  histogram->set_max_jitter_ms(max_jitter_ms_);
+  histogram->set_mean_jitter_ms(
+      num_cycles_ > 0 ? sum_jitter_ms_ / static_cast<double>(num_cycles_)
+                      : 0.0);
+}
+
+}  // namespace control
+}  // namespace apollo
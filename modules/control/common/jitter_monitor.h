@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief jitter of the control cycles
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/control/proto/control_latency.pb.h"
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class JitterMonitor
+ * @brief Measures the time between the starts of two control cycles and
+ *        keeps a histogram of its deviation from the control period.
+ */
+class JitterMonitor {
+ public:
+  /**
+   * @brief constructor
+   * @param period_ms expected time between two cycles
+   * @param bucket_width_ms width of the buckets of the histogram
+   * @param num_buckets number of buckets, the last one also counts all the
+   *        larger jitters
+   */
+  JitterMonitor(const double period_ms, const double bucket_width_ms,
+                const int num_buckets);
+
+  /**
+   * @brief record the start of a cycle
+   * @param timestamp_sec start time of the cycle
+   */
+  void AddCycle(const double timestamp_sec);
+
+  /**
+   * @brief time between the last two cycles, 0 until two were recorded
+   */
+  double cycle_time_ms() const { return cycle_time_ms_; }
+
+  /**
+   * @brief signed deviation of the last cycle time from the period
+   */
+  double jitter_ms() const { return jitter_ms_; }
+
+  void GetHistogram(JitterHistogram *histogram) const;
+
+ private:
+  const double period_ms_;
+  const double bucket_width_ms_;
+  std::vector<uint64_t> counts_;
+
+  double last_timestamp_sec_ = 0.0;
+  double cycle_time_ms_ = 0.0;
+  double jitter_ms_ = 0.0;
+  double max_jitter_ms_ = 0.0;
+  double sum_jitter_ms_ = 0.0;
+  uint64_t num_cycles_ = 0;
+};
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/jitter_monitor.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+TEST(JitterMonitorTest, Histogram) {
+  JitterMonitor jitter_monitor(10.0, 0.5, 4);
+  JitterHistogram histogram;
+
+  jitter_monitor.AddCycle(100.0);
+  EXPECT_DOUBLE_EQ(0.0, jitter_monitor.cycle_time_ms());
+  jitter_monitor.GetHistogram(&histogram);
+  ASSERT_EQ(4, histogram.count_size());
+  EXPECT_EQ(0, histogram.count(0));
+  EXPECT_DOUBLE_EQ(0.0, histogram.mean_jitter_ms());
+
+  jitter_monitor.AddCycle(100.0102);
+  EXPECT_NEAR(10.2, jitter_monitor.cycle_time_ms(), 1e-6);
+  EXPECT_NEAR(0.2, jitter_monitor.jitter_ms(), 1e-6);
+  jitter_monitor.AddCycle(100.0193);
+  EXPECT_NEAR(-0.9, jitter_monitor.jitter_ms(), 1e-6);
+  // larger than the last bucket
+  jitter_monitor.AddCycle(100.0343);
+  EXPECT_NEAR(5.0, jitter_monitor.jitter_ms(), 1e-6);
+
+  jitter_monitor.GetHistogram(&histogram);
+  EXPECT_DOUBLE_EQ(0.5, histogram.bucket_width_ms());
+  ASSERT_EQ(4, histogram.count_size());
+  EXPECT_EQ(1, histogram.count(0));
+  EXPECT_EQ(1, histogram.count(1));
+  EXPECT_EQ(0, histogram.count(2));
+  EXPECT_EQ(1, histogram.count(3));
+  EXPECT_NEAR(5.0, histogram.max_jitter_ms(), 1e-6);
+  EXPECT_NEAR(6.1 / 3.0, histogram.mean_jitter_ms(), 1e-6);
+}
+
+}  // namespace control
+}  // namespace apollo
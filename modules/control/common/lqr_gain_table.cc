@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/lqr_gain_table.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace control {
+
+bool LqrGainTable::Init(
+    const double min_speed, const double max_speed, const double resolution,
+    const std::function<Eigen::MatrixXd(const double)> &compute_gain) {
+  gains_.clear();
+  if (resolution <= 0.0 || max_speed <= min_speed) {
+    AERROR << "invalid speed grid: [" << min_speed << ", " << max_speed
+           << "] with resolution " << resolution;
+    return false;
+  }
+  const int num_intervals =
+      static_cast<int>(std::ceil((max_speed - min_speed) / resolution));
+  min_speed_ = min_speed;
+  resolution_ = resolution;
+  max_speed_ = min_speed_ + num_intervals * resolution_;
+  gains_.reserve(num_intervals + 1);
+  for (int i = 0; i <= num_intervals; ++i) {
+    gains_.push_back(compute_gain(min_speed_ + i * resolution_));
+  }
+  return true;
+}
+
+bool LqrGainTable::Interpolate(const double speed,
+                               Eigen::MatrixXd *gain) const {
+  CHECK_NOTNULL(gain);
+  if (gains_.empty() || speed < min_speed_ || speed > max_speed_) {
+    return false;
+  }
+  const double position = (speed - min_speed_) / resolution_;
+  const int index = std::min(static_cast<int>(position),
+                             static_cast<int>(gains_.size()) - 2);
+  const double ratio = position - index;
+  *gain = (1.0 - ratio) * gains_[index] + ratio * gains_[index + 1];
+  return true;
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief LQR gains precomputed on a speed grid
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "Eigen/Core"
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class LqrGainTable
+ * @brief Gains of a speed dependent LQR problem, solved once for every point
+ *        of a uniform speed grid and linearly interpolated in between.
+ */
+class LqrGainTable {
+ public:
+  LqrGainTable() = default;
+
+  /**
+   * @brief solve the gains on the grid [min_speed, max_speed]
+   * @param min_speed lowest speed of the grid
+   * @param max_speed highest speed of the grid
+   * @param resolution distance between two speeds of the grid
+   * @param compute_gain solves the LQR problem at a speed
+   * @return true if the grid is valid
+   */
+  bool Init(const double min_speed, const double max_speed,
+            const double resolution,
+            const std::function<Eigen::MatrixXd(const double)> &compute_gain);
+
+  /**
+   * @brief interpolate the gain at a speed
+   * @param speed speed of the vehicle
+   * @param gain interpolated gain
+   * @return false if the table is empty or the speed is outside the grid
+   */
+  bool Interpolate(const double speed, Eigen::MatrixXd *gain) const;
+
+  bool initialized() const { return !gains_.empty(); }
+
+ private:
+  double min_speed_ = 0.0;
+  double max_speed_ = 0.0;
+  double resolution_ = 0.0;
+  std::vector<Eigen::MatrixXd> gains_;
+};
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/lqr_gain_table.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+namespace {
+
+Eigen::MatrixXd ComputeGain(const double speed) {
+  Eigen::MatrixXd gain(1, 2);
+  gain << speed, 2.0 * speed + 1.0;
+  return gain;
+}
+
+}  // namespace
+
+TEST(LqrGainTableTest, Interpolate) {
+  LqrGainTable table;
+  EXPECT_FALSE(table.initialized());
+  Eigen::MatrixXd gain;
+  EXPECT_FALSE(table.Interpolate(1.0, &gain));
+
+  EXPECT_TRUE(table.Init(0.0, 10.0, 0.5, ComputeGain));
+  EXPECT_TRUE(table.initialized());
+  for (const double speed : {0.0, 0.2, 3.75, 9.9, 10.0}) {
+    EXPECT_TRUE(table.Interpolate(speed, &gain));
+    ASSERT_EQ(1, gain.rows());
+    ASSERT_EQ(2, gain.cols());
+    EXPECT_NEAR(speed, gain(0, 0), 1e-9);
+    EXPECT_NEAR(2.0 * speed + 1.0, gain(0, 1), 1e-9);
+  }
+
+  // outside of the grid
+  EXPECT_FALSE(table.Interpolate(-0.1, &gain));
+  EXPECT_FALSE(table.Interpolate(10.1, &gain));
+}
+
+TEST(LqrGainTableTest, InvalidGrid) {
+  LqrGainTable table;
+  EXPECT_FALSE(table.Init(0.0, 10.0, 0.0, ComputeGain));
+  EXPECT_FALSE(table.Init(10.0, 10.0, 0.1, ComputeGain));
+  EXPECT_FALSE(table.initialized());
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -92,6 +92,16 @@ bool ControlComponent::Init() {
       node_->CreateWriter<ControlCommand>(FLAGS_control_command_topic);
   CHECK(control_cmd_writer_ != nullptr);
 
+  if (FLAGS_enable_control_latency_report) {
+    control_latency_writer_ =
+        node_->CreateWriter<ControlLatency>(FLAGS_control_latency_topic);
+    CHECK(control_latency_writer_ != nullptr);
+    jitter_monitor_.reset(new JitterMonitor(
+        control_conf_.control_period() * 1000,
+        FLAGS_control_latency_jitter_bucket_ms,
+        FLAGS_control_latency_jitter_bucket_num));
+  }
+
   // set initial vehicle state by cmd
   // need to sleep, because advertised channel is not ready immediately
   // simple test shows a short delay of 80 ms or so
@@ -221,6 +231,20 @@ Status ControlComponent::ProduceControlCommand(
     debug->mutable_trajectory_header()->CopyFrom(
         local_view_.trajectory.header());
 
+    // age of the inputs when they are used
+    const double current_timestamp = Clock::NowInSeconds();
+    auto latency_stats = control_command->mutable_latency_stats();
+    latency_stats->set_chassis_age_ms(
+        (current_timestamp - local_view_.chassis.header().timestamp_sec()) *
+        1000);
+    latency_stats->set_localization_age_ms(
+        (current_timestamp -
+         local_view_.localization.header().timestamp_sec()) *
+        1000);
+    latency_stats->set_trajectory_age_ms(
+        (current_timestamp - local_view_.trajectory.header().timestamp_sec()) *
+        1000);
+
     Status status_compute = controller_agent_.ComputeControlCommand(
         &local_view_.localization, &local_view_.chassis,
         &local_view_.trajectory, control_command);
@@ -258,6 +282,9 @@ Status ControlComponent::ProduceControlCommand(
 
 bool ControlComponent::Proc() {
   double start_timestamp = Clock::NowInSeconds();
+  if (jitter_monitor_ != nullptr) {
+    jitter_monitor_->AddCycle(start_timestamp);
+  }
 
   chassis_reader_->Observe();
   const auto &chassis_msg = chassis_reader_->GetLatestObserved();
@@ -332,6 +359,10 @@ bool ControlComponent::Proc() {
 
   common::util::FillHeader(node_->Name(), &control_command);
 
+  if (control_latency_writer_ != nullptr) {
+    PublishLatency(control_command);
+  }
+
   ADEBUG << control_command.ShortDebugString();
   if (control_conf_.is_control_test_mode()) {
     ADEBUG << "Skip publish control command in test mode";
@@ -343,6 +374,22 @@ bool ControlComponent::Proc() {
   return true;
 }
 
+void ControlComponent::PublishLatency(const ControlCommand &control_command) {
+  ControlLatency control_latency;
+  control_latency.mutable_latency_stats()->CopyFrom(
+      control_command.latency_stats());
+  if (local_view_.chassis.has_control_command_latency_ms()) {
+    control_latency.set_can_send_latency_ms(
+        local_view_.chassis.control_command_latency_ms());
+  }
+  control_latency.set_cycle_time_ms(jitter_monitor_->cycle_time_ms());
+  control_latency.set_jitter_ms(jitter_monitor_->jitter_ms());
+  jitter_monitor_->GetHistogram(control_latency.mutable_jitter_histogram());
+  common::util::FillHeader(node_->Name(), &control_latency);
+  control_latency_writer_->Write(
+      std::make_shared<ControlLatency>(control_latency));
+}
+
 Status ControlComponent::CheckInput(LocalView *local_view) {
   ADEBUG << "Received localization:"
          << local_view->localization.ShortDebugString();
@@ -26,11 +26,13 @@
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/control/proto/control_cmd.pb.h"
 #include "modules/control/proto/control_conf.pb.h"
+#include "modules/control/proto/control_latency.pb.h"
 #include "modules/control/proto/pad_msg.pb.h"
 #include "modules/localization/proto/localization.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/common/util/util.h"
+#include "modules/control/common/jitter_monitor.h"
 #include "modules/control/controller/controller_agent.h"
 
 /**
@@ -85,6 +87,7 @@ class ControlComponent final : public apollo::cyber::TimerComponent {
   common::Status CheckInput(LocalView *local_view);
   common::Status CheckTimestamp(const LocalView &local_view);
   common::Status CheckPad();
+  void PublishLatency(const apollo::control::ControlCommand &control_command);
 
  private:
   double init_time_ = 0.0;
@@ -115,9 +118,13 @@ class ControlComponent final : public apollo::cyber::TimerComponent {
       localization_reader_;
   std::shared_ptr<Reader<apollo::planning::ADCTrajectory>> trajectory_reader_;
   std::shared_ptr<Writer<apollo::control::ControlCommand>> control_cmd_writer_;
+  std::shared_ptr<Writer<apollo::control::ControlLatency>>
+      control_latency_writer_;
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
 
   LocalView local_view_;
+
+  std::unique_ptr<JitterMonitor> jitter_monitor_;
 };
 
 CYBER_REGISTER_COMPONENT(ControlComponent)
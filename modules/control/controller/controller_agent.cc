@@ -110,6 +110,7 @@ Status ControllerAgent::ComputeControlCommand(
     ADEBUG << "controller: " << controller->Name()
            << " calculation time is: " << time_diff_ms << " ms.";
     cmd->mutable_latency_stats()->add_controller_time_ms(time_diff_ms);
+    cmd->mutable_latency_stats()->add_controller_name(controller->Name());
   }
   return Status::OK();
 }
@@ -231,6 +231,7 @@ Status LatController::Init(const ControlConf *control_conf) {
   InitializeFilters(control_conf_);
   auto &lat_controller_conf = control_conf_->lat_controller_conf();
   LoadLatGainScheduler(lat_controller_conf);
+  LoadLqrGainTables(lat_controller_conf);
   LogInitParameters();
   return Status::OK();
 }
@@ -265,6 +266,38 @@ void LatController::LoadLatGainScheduler(
       << "Fail to load heading error gain scheduler";
 }
 
+void LatController::LoadLqrGainTables(
+    const LatControllerConf &lat_controller_conf) {
+  if (!lat_controller_conf.use_lqr_gain_table()) {
+    return;
+  }
+  const int matrix_size = basic_state_size_ + preview_window_;
+  Matrix matrix_q = Matrix::Zero(matrix_size, matrix_size);
+  Matrix reverse_matrix_q = Matrix::Zero(matrix_size, matrix_size);
+  for (int i = 0; i < matrix_size; ++i) {
+    matrix_q(i, i) = lat_controller_conf.matrix_q(i);
+    reverse_matrix_q(i, i) = lat_controller_conf.reverse_matrix_q(i);
+  }
+
+  const double start_timestamp = Clock::NowInSeconds();
+  CHECK(lqr_gain_table_.Init(
+      lat_controller_conf.lqr_gain_table_min_speed(),
+      lat_controller_conf.lqr_gain_table_max_speed(),
+      lat_controller_conf.lqr_gain_table_speed_resolution(),
+      [&](const double speed) { return ComputeLqrGain(speed, matrix_q); }))
+      << "Fail to compute the lqr gain table";
+  CHECK(reverse_lqr_gain_table_.Init(
+      lat_controller_conf.lqr_gain_table_min_speed(),
+      lat_controller_conf.lqr_gain_table_max_speed(),
+      lat_controller_conf.lqr_gain_table_speed_resolution(),
+      [&](const double speed) {
+        return ComputeLqrGain(speed, reverse_matrix_q);
+      }))
+      << "Fail to compute the reverse lqr gain table";
+  AINFO << "Lateral control lqr gain tables computed in "
+        << (Clock::NowInSeconds() - start_timestamp) * 1000 << " ms";
+}
+
 void LatController::Stop() { CloseLogFile(); }
 
 std::string LatController::Name() const { return name_; }
@@ -355,17 +388,13 @@ Status LatController::ComputeControlCommand(
   // Error Rate, preview lateral error1 , preview lateral error2, ...]
   UpdateState(debug);
 
-  UpdateMatrix();
-
-  // Compound discrete matrix with road preview model
-  UpdateMatrixCompound();
-
   // Adjust matrix_q_updated when in reverse gear
   int q_param_size = control_conf_->lat_controller_conf().matrix_q_size();
   int reverse_q_param_size =
       control_conf_->lat_controller_conf().reverse_matrix_q_size();
-  if (VehicleStateProvider::Instance()->gear() ==
-      canbus::Chassis::GEAR_REVERSE) {
+  const bool is_reverse = VehicleStateProvider::Instance()->gear() ==
+                          canbus::Chassis::GEAR_REVERSE;
+  if (is_reverse) {
     for (int i = 0; i < reverse_q_param_size; ++i) {
       matrix_q_(i, i) =
           control_conf_->lat_controller_conf().reverse_matrix_q(i);
@@ -376,22 +405,19 @@ Status LatController::ComputeControlCommand(
     }
   }
 
-  // Add gain scheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) *
-        lat_err_interpolation_->Interpolate(vehicle_state->linear_velocity());
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(
-                              vehicle_state->linear_velocity());
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
-  } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+  // Interpolate the precomputed gains and only solve the lqr problem when
+  // the speed is outside of the tables
+  const double lqr_start_timestamp = Clock::NowInSeconds();
+  const LqrGainTable &lqr_gain_table =
+      is_reverse ? reverse_lqr_gain_table_ : lqr_gain_table_;
+  const bool from_gain_table = lqr_gain_table.Interpolate(
+      vehicle_state->linear_velocity(), &matrix_k_);
+  if (!from_gain_table) {
+    matrix_k_ = ComputeLqrGain(vehicle_state->linear_velocity(), matrix_q_);
   }
+  ADEBUG << "LQR gain " << (from_gain_table ? "interpolated" : "solved")
+         << " in " << (Clock::NowInSeconds() - lqr_start_timestamp) * 1000
+         << " ms.";
 
   // feedback = - K * state
   // Convert vehicle steer angle from rad to degree and then to steer degree
@@ -515,9 +541,8 @@ void LatController::UpdateState(SimpleLateralDebug *debug) {
   }
 }
 
-void LatController::UpdateMatrix() {
-  const double v = std::max(VehicleStateProvider::Instance()->linear_velocity(),
-                            minimum_speed_protection_);
+void LatController::UpdateMatrix(const double speed) {
+  const double v = std::max(speed, minimum_speed_protection_);
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
   matrix_a_(1, 3) = matrix_a_coeff_(1, 3) / v;
   matrix_a_(3, 1) = matrix_a_coeff_(3, 1) / v;
@@ -540,6 +565,31 @@ void LatController::UpdateMatrixCompound() {
   }
 }
 
+Matrix LatController::ComputeLqrGain(const double speed,
+                                    const Matrix &matrix_q) {
+  UpdateMatrix(speed);
+
+  // Compound discrete matrix with road preview model
+  UpdateMatrixCompound();
+
+  Matrix matrix_k;
+  // Add gain scheduler for higher speed steering
+  if (FLAGS_enable_gain_scheduler) {
+    matrix_q_updated_(0, 0) =
+        matrix_q(0, 0) * lat_err_interpolation_->Interpolate(speed);
+    matrix_q_updated_(2, 2) =
+        matrix_q(2, 2) * heading_err_interpolation_->Interpolate(speed);
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k);
+  } else {
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k);
+  }
+  return matrix_k;
+}
+
 double LatController::ComputeFeedForward(double ref_curvature) const {
   const double kv =
       lr_ * mass_ / 2 / cf_ / wheelbase_ - lf_ * mass_ / 2 / cr_ / wheelbase_;
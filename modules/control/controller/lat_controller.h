@@ -33,6 +33,7 @@
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
 #include "modules/control/common/interpolation_1d.h"
+#include "modules/control/common/lqr_gain_table.h"
 #include "modules/control/common/trajectory_analyzer.h"
 #include "modules/control/controller/controller.h"
 
@@ -106,10 +107,16 @@ class LatController : public Controller {
   // logic for reverse driving mode
   void UpdateDrivingOrientation();
 
-  void UpdateMatrix();
+  void UpdateMatrix(const double speed);
 
   void UpdateMatrixCompound();
 
+  // solve the lqr problem at a speed with the state weighting matrix_q
+  Eigen::MatrixXd ComputeLqrGain(const double speed,
+                                 const Eigen::MatrixXd &matrix_q);
+
+  void LoadLqrGainTables(const LatControllerConf &lat_controller_conf);
+
   double ComputeFeedForward(double ref_curvature) const;
 
   void ComputeLateralErrors(const double x, const double y, const double theta,
@@ -200,6 +207,10 @@ class LatController : public Controller {
 
   std::unique_ptr<Interpolation1D> heading_err_interpolation_;
 
+  // lqr gains solved at init for the forward and the reverse gears
+  LqrGainTable lqr_gain_table_;
+  LqrGainTable reverse_lqr_gain_table_;
+
   // MeanFilter heading_rate_filter_;
   common::MeanFilter lateral_error_filter_;
   common::MeanFilter heading_error_filter_;
@@ -103,6 +103,14 @@ bool MPCController::LoadControlConf(const ControlConf *control_conf) {
 
   mpc_eps_ = control_conf->mpc_controller_conf().eps();
   mpc_max_iteration_ = control_conf->mpc_controller_conf().max_iteration();
+  horizon_ = control_conf->mpc_controller_conf().horizon();
+  CHECK_GT(horizon_, 0) << "[MPCController] Invalid horizon.";
+  if (control_conf->mpc_controller_conf().use_osqp_solver()) {
+    mpc_osqp_solver_.reset(
+        new common::math::MpcOsqpSolver(mpc_eps_, mpc_max_iteration_));
+  } else {
+    mpc_osqp_solver_.reset();
+  }
   throttle_deadzone_ = control_conf->mpc_controller_conf().throttle_deadzone();
   brake_deadzone_ = control_conf->mpc_controller_conf().brake_deadzone();
 
@@ -341,10 +349,17 @@ Status MPCController::ComputeControlCommand(
   double mpc_start_timestamp = Clock::NowInSeconds();
   double steer_angle_feedback = 0.0;
   double acc_feedback = 0.0;
-  if (common::math::SolveLinearMPC(
-          matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
-          matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
-          mpc_eps_, mpc_max_iteration_, &control) != true) {
+  const bool solved =
+      mpc_osqp_solver_ != nullptr
+          ? mpc_osqp_solver_->Solve(matrix_ad_, matrix_bd_, matrix_cd_,
+                                    matrix_q_updated_, matrix_r_updated_,
+                                    lower_bound, upper_bound, matrix_state_,
+                                    reference, &control)
+          : common::math::SolveLinearMPC(
+                matrix_ad_, matrix_bd_, matrix_cd_, matrix_q_updated_,
+                matrix_r_updated_, lower_bound, upper_bound, matrix_state_,
+                reference, mpc_eps_, mpc_max_iteration_, &control);
+  if (!solved) {
     AERROR << "MPC solver failed";
   } else {
     ADEBUG << "MPC problem solved! ";
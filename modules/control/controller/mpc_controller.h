@@ -32,6 +32,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/mpc_osqp_solver.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/interpolation_2d.h"
 #include "modules/control/common/trajectory_analyzer.h"
@@ -173,7 +174,7 @@ class MPCController : public Controller {
 
   const int controls_ = 2;
 
-  const int horizon_ = 10;
+  int horizon_ = 10;
   // vehicle state matrix
   Eigen::MatrixXd matrix_a_;
   // vehicle state matrix (discrete-time)
@@ -214,6 +215,9 @@ class MPCController : public Controller {
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
 
+  // kept between the cycles, only set when the osqp solver is configured
+  std::unique_ptr<common::math::MpcOsqpSolver> mpc_osqp_solver_;
+
   common::DigitalFilter digital_filter_;
 
   std::unique_ptr<Interpolation1D> lat_err_interpolation_;
@@ -35,7 +35,16 @@ bool DataComponent::Init() {
     return true;
   }
 
-  if (!RecordService::Init(node_)) {
+  if (data_conf_.smart_record().enabled()) {
+    smart_recorder_ =
+        std::make_shared<SmartRecorder>(data_conf_.smart_record());
+    if (!smart_recorder_->Start()) {
+      AERROR << "Unable to start the smart recorder";
+      return false;
+    }
+  }
+
+  if (!RecordService::Init(node_, smart_recorder_)) {
     AERROR << "Unable to initialize data recorder service";
     return false;
   }
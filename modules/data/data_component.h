@@ -28,6 +28,7 @@
 
 #include "modules/data/proto/data.pb.h"
 #include "modules/data/proto/data_conf.pb.h"
+#include "modules/data/recorder/smart_recorder.h"
 
 /**
  * @namespace apollo::data
@@ -55,6 +56,7 @@ class DataComponent final
   DataConf data_conf_;
   std::shared_ptr<apollo::cyber::Reader<DataInputCommand>>
     data_input_cmd_reader_;
+  std::shared_ptr<SmartRecorder> smart_recorder_;
 };
 
 CYBER_REGISTER_COMPONENT(DataComponent)
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/message_ring_buffer.h"
+
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/record/file/chunk_compressor.h"
+#include "cyber/record/file/record_file_writer.h"
+#include "cyber/record/header_builder.h"
+
+namespace apollo {
+namespace data {
+
+using apollo::cyber::proto::Channel;
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::CompressType;
+using apollo::cyber::proto::Header;
+using apollo::cyber::record::ChunkCompressor;
+using apollo::cyber::record::HeaderBuilder;
+using apollo::cyber::record::RecordFileWriter;
+
+MessageRingBuffer::MessageRingBuffer(uint64_t duration,
+                                     uint64_t chunk_interval,
+                                     CompressType compress_type,
+                                     uint64_t max_bytes)
+    : duration_(duration),
+      chunk_interval_(chunk_interval),
+      compress_type_(compress_type),
+      max_bytes_(max_bytes) {}
+
+void MessageRingBuffer::AddChannel(const std::string& channel_name,
+                                   const std::string& message_type,
+                                   const std::string& proto_desc) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& channel : channels_) {
+    if (channel.name() == channel_name) {
+      return;
+    }
+  }
+  Channel channel;
+  channel.set_name(channel_name);
+  channel.set_message_type(message_type);
+  channel.set_proto_desc(proto_desc);
+  channels_.push_back(std::move(channel));
+}
+
+void MessageRingBuffer::AddMessage(const std::string& channel_name,
+                                   const std::string& content,
+                                   uint64_t time) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto* message = active_body_.add_messages();
+    message->set_channel_name(channel_name);
+    message->set_content(content);
+    message->set_time(time);
+    if (active_header_.message_number() == 0 ||
+        active_header_.begin_time() > time) {
+      active_header_.set_begin_time(time);
+    }
+    if (active_header_.end_time() < time) {
+      active_header_.set_end_time(time);
+    }
+    active_header_.set_message_number(active_header_.message_number() + 1);
+    active_header_.set_raw_size(active_header_.raw_size() + content.size());
+    if (!NeedSeal()) {
+      return;
+    }
+  }
+  // while a chunk is being sealed, the next one keeps growing and is sealed
+  // by a later message
+  std::unique_lock<std::mutex> seal_lock(seal_mutex_, std::try_to_lock);
+  if (seal_lock.owns_lock()) {
+    Seal();
+  }
+}
+
+bool MessageRingBuffer::NeedSeal() const {
+  return active_header_.message_number() > 0 &&
+         active_header_.end_time() - active_header_.begin_time() >=
+             chunk_interval_;
+}
+
+void MessageRingBuffer::Seal() {
+  ChunkHeader header;
+  ChunkBody body;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active_header_.message_number() == 0) {
+      return;
+    }
+    header.Swap(&active_header_);
+    body.Swap(&active_body_);
+  }
+
+  auto chunk = std::make_shared<Chunk>();
+  chunk->header = std::move(header);
+  for (const auto& message : body.messages()) {
+    ++chunk->channel_message_number[message.channel_name()];
+  }
+  std::string raw;
+  if (!body.SerializeToString(&raw)) {
+    AERROR << "Serialize chunk body failed.";
+    return;
+  }
+  if (compress_type_ == CompressType::COMPRESS_NONE) {
+    chunk->body = std::move(raw);
+  } else if (!ChunkCompressor::Compress(compress_type_, raw, &chunk->body)) {
+    AERROR << "Compress chunk body failed.";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  bytes_ += chunk->body.size();
+  chunks_.push_back(std::move(chunk));
+  while (chunks_.size() > 1 &&
+         (chunks_.back()->header.end_time() -
+                  chunks_.front()->header.end_time() >
+              duration_ ||
+          bytes_ > max_bytes_)) {
+    bytes_ -= chunks_.front()->body.size();
+    chunks_.pop_front();
+  }
+}
+
+bool MessageRingBuffer::Dump(uint64_t begin_time, uint64_t end_time,
+                             const std::string& path) {
+  {
+    std::lock_guard<std::mutex> seal_lock(seal_mutex_);
+    Seal();
+  }
+  std::vector<Channel> channels;
+  std::vector<std::shared_ptr<const Chunk>> chunks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    channels = channels_;
+    for (const auto& chunk : chunks_) {
+      if (chunk->header.end_time() >= begin_time &&
+          chunk->header.begin_time() <= end_time) {
+        chunks.push_back(chunk);
+      }
+    }
+  }
+  if (chunks.empty()) {
+    AWARN << "No message to dump between " << begin_time << " and "
+          << end_time;
+    return false;
+  }
+
+  RecordFileWriter writer;
+  if (!writer.Open(path)) {
+    AERROR << "Open record file failed, file: " << path;
+    return false;
+  }
+  Header header = HeaderBuilder::GetHeader();
+  header.set_compress(compress_type_);
+  if (!writer.WriteHeader(header)) {
+    AERROR << "Write header failed, file: " << path;
+    return false;
+  }
+  for (const auto& channel : channels) {
+    writer.WriteChannel(channel);
+  }
+  for (const auto& chunk : chunks) {
+    if (!writer.WriteRawChunk(chunk->header, chunk->body,
+                              chunk->channel_message_number)) {
+      AERROR << "Write chunk failed, file: " << path;
+      return false;
+    }
+  }
+  writer.Close();
+  return true;
+}
+
+uint64_t MessageRingBuffer::bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+}  // namespace data
+}  // namespace apollo
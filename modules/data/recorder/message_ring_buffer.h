@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/proto/record.pb.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class MessageRingBuffer
+ * @brief The messages of the last `duration` nanoseconds, serialized and
+ * packed into compressed chunks of `chunk_interval` as a record file would
+ * hold them, so that a window of them is written to disk by copying chunks.
+ * Thread safe, messages are added from the reader of every channel.
+ */
+class MessageRingBuffer {
+ public:
+  MessageRingBuffer(uint64_t duration, uint64_t chunk_interval,
+                    apollo::cyber::proto::CompressType compress_type,
+                    uint64_t max_bytes);
+
+  void AddChannel(const std::string& channel_name,
+                  const std::string& message_type,
+                  const std::string& proto_desc);
+
+  void AddMessage(const std::string& channel_name, const std::string& content,
+                  uint64_t time);
+
+  /**
+   * @brief Writes the channels and the chunks overlapping [begin_time,
+   * end_time] to a new record at path. Chunks are not cut, so the record may
+   * start and end up to a chunk interval beyond the window.
+   */
+  bool Dump(uint64_t begin_time, uint64_t end_time, const std::string& path);
+
+  /**
+   * @brief Size of the compressed chunks kept, in bytes.
+   */
+  uint64_t bytes() const;
+
+ private:
+  struct Chunk {
+    apollo::cyber::proto::ChunkHeader header;
+    std::string body;
+    std::map<std::string, uint64_t> channel_message_number;
+  };
+
+  bool NeedSeal() const;
+  // Compresses the messages added so far into a chunk. Only one chunk is
+  // sealed at a time, so that they stay in order, and without holding
+  // mutex_, so that adding messages does not wait for the compression.
+  void Seal();
+
+  const uint64_t duration_;
+  const uint64_t chunk_interval_;
+  const apollo::cyber::proto::CompressType compress_type_;
+  const uint64_t max_bytes_;
+
+  mutable std::mutex mutex_;
+  std::vector<apollo::cyber::proto::Channel> channels_;
+  apollo::cyber::proto::ChunkHeader active_header_;
+  apollo::cyber::proto::ChunkBody active_body_;
+  std::deque<std::shared_ptr<const Chunk>> chunks_;
+  uint64_t bytes_ = 0;
+
+  std::mutex seal_mutex_;
+};
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/message_ring_buffer.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/record/file/record_file_reader.h"
+
+namespace apollo {
+namespace data {
+
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::CompressType;
+using apollo::cyber::proto::SectionType;
+using apollo::cyber::record::RecordFileReader;
+using apollo::cyber::record::Section;
+
+namespace {
+
+const char kRecordFile[] = "message_ring_buffer_test.record";
+
+// The times of the messages in the record file.
+std::vector<uint64_t> ReadTimes(const std::string& path) {
+  std::vector<uint64_t> times;
+  RecordFileReader reader;
+  EXPECT_TRUE(reader.Open(path));
+  Section section;
+  while (reader.ReadSection(&section)) {
+    if (section.type == SectionType::SECTION_INDEX) {
+      break;
+    }
+    if (section.type != SectionType::SECTION_CHUNK_BODY) {
+      EXPECT_TRUE(reader.SkipSection(section.size));
+      continue;
+    }
+    ChunkBody chunk_body;
+    EXPECT_TRUE(reader.ReadSection<ChunkBody>(section.size, &chunk_body));
+    for (const auto& message : chunk_body.messages()) {
+      times.push_back(message.time());
+    }
+  }
+  return times;
+}
+
+}  // namespace
+
+TEST(MessageRingBufferTest, KeepsTheLastMessages) {
+  // chunks of 10 messages, 30 kept
+  MessageRingBuffer ring_buffer(30, 9, CompressType::COMPRESS_NONE, 1 << 20);
+  ring_buffer.AddChannel("/a", "apollo.A", "");
+  for (uint64_t time = 1; time <= 100; ++time) {
+    ring_buffer.AddMessage("/a", "message", time);
+  }
+
+  ASSERT_TRUE(ring_buffer.Dump(0, 100, kRecordFile));
+  std::vector<uint64_t> times = ReadTimes(kRecordFile);
+  ASSERT_EQ(40, times.size());
+  EXPECT_EQ(61, times.front());
+  EXPECT_EQ(100, times.back());
+
+  // whole chunks around the window
+  ASSERT_TRUE(ring_buffer.Dump(75, 85, kRecordFile));
+  times = ReadTimes(kRecordFile);
+  ASSERT_EQ(20, times.size());
+  EXPECT_EQ(71, times.front());
+  EXPECT_EQ(90, times.back());
+
+  EXPECT_FALSE(ring_buffer.Dump(0, 50, kRecordFile));
+  unlink(kRecordFile);
+}
+
+TEST(MessageRingBufferTest, KeepsWithinMemory) {
+  MessageRingBuffer ring_buffer(1000, 9, CompressType::COMPRESS_NONE, 1000);
+  const std::string content(100, 'm');
+  for (uint64_t time = 1; time <= 100; ++time) {
+    ring_buffer.AddMessage("/a", content, time);
+  }
+  // a chunk of 10 messages takes more than 1000 bytes, only the last is kept
+  EXPECT_GT(ring_buffer.bytes(), 1000);
+  EXPECT_LT(ring_buffer.bytes(), 2000);
+}
+
+}  // namespace data
+}  // namespace apollo
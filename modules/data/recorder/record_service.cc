@@ -26,9 +26,12 @@ namespace data {
 RecordService::RecordService() = default;
 
 bool RecordService::Init(
-    const std::shared_ptr<apollo::cyber::Node>& node) {
+    const std::shared_ptr<apollo::cyber::Node>& node,
+    const std::shared_ptr<SmartRecorder>& smart_recorder) {
   AINFO << "RecordService::Init(), starting...";
 
+  Instance()->smart_recorder_ = smart_recorder;
+
   Instance()->server_ = node->CreateService<RecordRequest, RecordResponse>(
       FLAGS_data_record_service_name,
       RecordService::OnRecordRequest);
@@ -44,7 +47,11 @@ void RecordService::OnRecordRequest(
     const std::shared_ptr<RecordRequest> &request,
     const std::shared_ptr<RecordResponse> &response) {
   ADEBUG << "Received data record request: " << request->DebugString();
-  // TODO(michael): do recording
+  const auto& smart_recorder = Instance()->smart_recorder_;
+  if (request->record_switch() == RecordRequest::START &&
+      smart_recorder != nullptr) {
+    smart_recorder->Trigger("record_request");
+  }
   response->set_record_result(RecordResponse::PASS);
 }
 
@@ -23,6 +23,7 @@
 #include "cyber/service/service.h"
 #include "modules/data/proto/record_request.pb.h"
 #include "modules/data/proto/record_response.pb.h"
+#include "modules/data/recorder/smart_recorder.h"
 
 /**
  * @namespace apollo::data
@@ -33,7 +34,11 @@ namespace data {
 
 class RecordService {
  public:
-  static bool Init(const std::shared_ptr<apollo::cyber::Node>& node);
+  // A START request records the window around it with smart_recorder, if
+  // there is one.
+  static bool Init(const std::shared_ptr<apollo::cyber::Node>& node,
+                   const std::shared_ptr<SmartRecorder>& smart_recorder =
+                       nullptr);
  private:
   static void OnRecordRequest(
       const std::shared_ptr<RecordRequest> &request,
@@ -41,6 +46,7 @@ class RecordService {
  private:
   std::shared_ptr<apollo::cyber::Service<RecordRequest, RecordResponse>>
       server_;
+  std::shared_ptr<SmartRecorder> smart_recorder_;
   DECLARE_SINGLETON(RecordService)
 };
 
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/smart_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/common/time_conversion.h"
+#include "modules/common/adapters/adapter_gflags.h"
+
+namespace apollo {
+namespace data {
+
+using apollo::canbus::Chassis;
+using apollo::cyber::ReaderConfig;
+using apollo::cyber::Time;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::ChangeMsg;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::service_discovery::TopologyManager;
+using apollo::planning::ADCTrajectory;
+
+namespace {
+
+uint64_t SecondsToNanoseconds(double seconds) {
+  return static_cast<uint64_t>(seconds * 1e9);
+}
+
+}  // namespace
+
+SmartRecorder::SmartRecorder(const SmartRecordConf& conf)
+    : conf_(conf),
+      // the window before an event is still kept when it is written, once
+      // the window after it is over
+      ring_buffer_(SecondsToNanoseconds(conf.pre_trigger_seconds() +
+                                        conf.post_trigger_seconds() +
+                                        conf.chunk_seconds()),
+                   SecondsToNanoseconds(conf.chunk_seconds()), conf.compress(),
+                   static_cast<uint64_t>(conf.max_memory_mb()) << 20),
+      trigger_detector_(conf) {}
+
+SmartRecorder::~SmartRecorder() { Stop(); }
+
+bool SmartRecorder::Start() {
+  node_ = apollo::cyber::CreateNode("data_smart_recorder");
+  if (node_ == nullptr) {
+    AERROR << "Create smart recorder node failed.";
+    return false;
+  }
+  std::weak_ptr<SmartRecorder> weak_this = shared_from_this();
+  chassis_reader_ = node_->CreateReader<Chassis>(
+      FLAGS_chassis_topic,
+      [weak_this](const std::shared_ptr<Chassis>& chassis) {
+        auto recorder = weak_this.lock();
+        if (recorder != nullptr) {
+          recorder->OnChassis(chassis);
+        }
+      });
+  planning_reader_ = node_->CreateReader<ADCTrajectory>(
+      FLAGS_planning_trajectory_topic,
+      [weak_this](const std::shared_ptr<ADCTrajectory>& trajectory) {
+        auto recorder = weak_this.lock();
+        if (recorder != nullptr) {
+          recorder->OnPlanning(trajectory);
+        }
+      });
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_running_ = true;
+  }
+  dump_thread_ = std::thread(&SmartRecorder::RunDumps, this);
+
+  // the channels written already, and those to come
+  auto channel_manager = TopologyManager::Instance()->channel_manager();
+  std::vector<RoleAttributes> writers;
+  channel_manager->GetWriters(&writers);
+  for (const auto& role_attr : writers) {
+    FindNewChannel(role_attr);
+  }
+  change_conn_ = channel_manager->AddChangeListener(
+      std::bind(&SmartRecorder::OnChangeMessage, this, std::placeholders::_1));
+  if (!change_conn_.IsConnected()) {
+    AERROR << "Listen to the topology changes failed.";
+    return false;
+  }
+  AINFO << "Smart recorder started, writing to " << conf_.output_dir();
+  return true;
+}
+
+void SmartRecorder::Stop() {
+  if (node_ == nullptr) {
+    return;
+  }
+  TopologyManager::Instance()->channel_manager()->RemoveChangeListener(
+      change_conn_);
+  {
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    channel_readers_.clear();
+    chassis_reader_.reset();
+    planning_reader_.reset();
+    node_.reset();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_running_ = false;
+    cv_.notify_all();
+  }
+  if (dump_thread_.joinable()) {
+    dump_thread_.join();
+  }
+}
+
+void SmartRecorder::Trigger(const std::string& reason) {
+  const uint64_t now = Time::Now().ToNanosecond();
+  const uint64_t pre = SecondsToNanoseconds(conf_.pre_trigger_seconds());
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (window_end_ == 0) {
+    window_begin_ = now > pre ? now - pre : 0;
+    window_reason_ = reason;
+  } else if (window_reason_.find(reason) == std::string::npos) {
+    window_reason_ += "+" + reason;
+  }
+  window_end_ = std::max(
+      window_end_, now + SecondsToNanoseconds(conf_.post_trigger_seconds()));
+  AINFO << "Smart recording triggered by " << reason;
+  cv_.notify_all();
+}
+
+void SmartRecorder::OnChangeMessage(const ChangeMsg& change_message) {
+  if (change_message.role_type() == apollo::cyber::proto::ROLE_WRITER) {
+    FindNewChannel(change_message.role_attr());
+  }
+}
+
+void SmartRecorder::FindNewChannel(const RoleAttributes& role_attr) {
+  const std::string& channel_name = role_attr.channel_name();
+  if (channel_name.empty() || role_attr.message_type().empty()) {
+    return;
+  }
+  if (std::find(conf_.blacklist_channels().begin(),
+                conf_.blacklist_channels().end(),
+                channel_name) != conf_.blacklist_channels().end()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  if (node_ == nullptr || channel_readers_.count(channel_name) > 0) {
+    return;
+  }
+  ring_buffer_.AddChannel(channel_name, role_attr.message_type(),
+                          role_attr.proto_desc());
+  std::weak_ptr<SmartRecorder> weak_this = shared_from_this();
+  ReaderConfig config;
+  config.channel_name = channel_name;
+  auto reader = node_->CreateReader<RawMessage>(
+      config, [weak_this,
+               channel_name](const std::shared_ptr<RawMessage>& message) {
+        auto recorder = weak_this.lock();
+        if (recorder != nullptr) {
+          recorder->OnMessage(message, channel_name);
+        }
+      });
+  if (reader == nullptr) {
+    AERROR << "Create reader failed, channel: " << channel_name;
+    return;
+  }
+  channel_readers_[channel_name] = reader;
+}
+
+void SmartRecorder::OnMessage(const std::shared_ptr<RawMessage>& message,
+                              const std::string& channel_name) {
+  ring_buffer_.AddMessage(channel_name, message->message,
+                          Time::Now().ToNanosecond());
+}
+
+void SmartRecorder::OnChassis(const std::shared_ptr<Chassis>& chassis) {
+  std::string reason;
+  if (trigger_detector_.OnChassis(*chassis, &reason)) {
+    Trigger(reason);
+  }
+}
+
+void SmartRecorder::OnPlanning(
+    const std::shared_ptr<ADCTrajectory>& trajectory) {
+  std::string reason;
+  if (trigger_detector_.OnPlanning(*trajectory, &reason)) {
+    Trigger(reason);
+  }
+}
+
+void SmartRecorder::RunDumps() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (is_running_ && window_end_ == 0) {
+      cv_.wait(lock);
+      continue;
+    }
+    const uint64_t now = Time::Now().ToNanosecond();
+    if (is_running_ && now < window_end_) {
+      cv_.wait_for(lock, std::chrono::nanoseconds(window_end_ - now));
+      continue;
+    }
+    // the window is over, or is written as far as it goes on stop
+    if (window_end_ != 0) {
+      const uint64_t begin_time = window_begin_;
+      const uint64_t end_time = window_end_;
+      const std::string reason = window_reason_;
+      window_end_ = 0;
+      lock.unlock();
+      Dump(begin_time, end_time, reason);
+      lock.lock();
+    }
+    if (!is_running_) {
+      return;
+    }
+  }
+}
+
+void SmartRecorder::Dump(uint64_t begin_time, uint64_t end_time,
+                         const std::string& reason) {
+  if (!apollo::cyber::common::EnsureDirectory(conf_.output_dir())) {
+    AERROR << "Create directory failed: " << conf_.output_dir();
+    return;
+  }
+  const std::string path =
+      conf_.output_dir() + "/" +
+      apollo::cyber::common::UnixSecondsToString(begin_time / 1000000000,
+                                                 "%Y%m%d%H%M%S") +
+      "." + reason + ".record";
+  if (ring_buffer_.Dump(begin_time, end_time, path)) {
+    AINFO << "Smart record written: " << path;
+  }
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "cyber/base/signal.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/role_attributes.pb.h"
+#include "cyber/proto/topology_change.pb.h"
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/data/proto/data_conf.pb.h"
+#include "modules/data/recorder/message_ring_buffer.h"
+#include "modules/data/recorder/trigger_detector.h"
+#include "modules/planning/proto/planning.pb.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class SmartRecorder
+ * @brief Always records all channels, but into a MessageRingBuffer, and
+ * writes a record to disk only for the window around an event: hard braking,
+ * disengagement, a planning fallback or a request. Events within the window
+ * of another one extend it.
+ */
+class SmartRecorder : public std::enable_shared_from_this<SmartRecorder> {
+ public:
+  explicit SmartRecorder(const SmartRecordConf& conf);
+  ~SmartRecorder();
+
+  bool Start();
+  void Stop();
+
+  /**
+   * @brief Records the window around now.
+   */
+  void Trigger(const std::string& reason);
+
+ private:
+  void OnChangeMessage(const apollo::cyber::proto::ChangeMsg& change_message);
+  void FindNewChannel(const apollo::cyber::proto::RoleAttributes& role_attr);
+  void OnMessage(
+      const std::shared_ptr<apollo::cyber::message::RawMessage>& message,
+      const std::string& channel_name);
+  void OnChassis(const std::shared_ptr<apollo::canbus::Chassis>& chassis);
+  void OnPlanning(
+      const std::shared_ptr<apollo::planning::ADCTrajectory>& trajectory);
+  void RunDumps();
+  void Dump(uint64_t begin_time, uint64_t end_time,
+            const std::string& reason);
+
+  const SmartRecordConf conf_;
+  MessageRingBuffer ring_buffer_;
+  // chassis and planning are each detected on their own reader
+  TriggerDetector trigger_detector_;
+
+  std::shared_ptr<apollo::cyber::Node> node_;
+  apollo::cyber::base::Connection<const apollo::cyber::proto::ChangeMsg&>
+      change_conn_;
+  std::mutex readers_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<apollo::cyber::ReaderBase>>
+      channel_readers_;
+  std::shared_ptr<apollo::cyber::Reader<apollo::canbus::Chassis>>
+      chassis_reader_;
+  std::shared_ptr<apollo::cyber::Reader<apollo::planning::ADCTrajectory>>
+      planning_reader_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool is_running_ = false;
+  // the window to write, none while window_end_ is 0
+  uint64_t window_begin_ = 0;
+  uint64_t window_end_ = 0;
+  std::string window_reason_;
+  std::thread dump_thread_;
+};
+
+}  // namespace data
+}  // namespace apollo
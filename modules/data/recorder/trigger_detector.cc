@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/trigger_detector.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace data {
+
+using apollo::canbus::Chassis;
+using apollo::planning::ADCTrajectory;
+
+namespace {
+
+// The chassis speed is noisy, the deceleration is measured over this long.
+constexpr double kDecelerationWindowSec = 0.2;
+
+void AddReason(const std::string& event, std::string* reason) {
+  if (!reason->empty()) {
+    reason->append("+");
+  }
+  reason->append(event);
+}
+
+}  // namespace
+
+TriggerDetector::TriggerDetector(const SmartRecordConf& conf) : conf_(conf) {}
+
+bool TriggerDetector::OnChassis(const Chassis& chassis, std::string* reason) {
+  reason->clear();
+  const bool is_auto_driving =
+      chassis.driving_mode() == Chassis::COMPLETE_AUTO_DRIVE;
+  if (conf_.trigger_on_disengagement() && is_auto_driving_ &&
+      !is_auto_driving) {
+    AddReason("disengagement", reason);
+  }
+  is_auto_driving_ = is_auto_driving;
+
+  if (conf_.hard_brake_deceleration() > 0.0 && chassis.has_speed_mps() &&
+      !std::isnan(chassis.speed_mps())) {
+    const double time = chassis.header().timestamp_sec();
+    const double speed = chassis.speed_mps();
+    if (speed_time_ == 0.0 || time < speed_time_) {
+      speed_time_ = time;
+      speed_ = speed;
+    } else if (time - speed_time_ >= kDecelerationWindowSec) {
+      const bool is_hard_braking = (speed_ - speed) / (time - speed_time_) >=
+                                   conf_.hard_brake_deceleration();
+      if (is_hard_braking && !is_hard_braking_) {
+        AddReason("hard_brake", reason);
+      }
+      is_hard_braking_ = is_hard_braking;
+      speed_time_ = time;
+      speed_ = speed;
+    }
+  }
+  return !reason->empty();
+}
+
+bool TriggerDetector::OnPlanning(const ADCTrajectory& trajectory,
+                                 std::string* reason) {
+  reason->clear();
+  const bool is_fallback =
+      trajectory.trajectory_type() == ADCTrajectory::PATH_FALLBACK ||
+      trajectory.trajectory_type() == ADCTrajectory::SPEED_FALLBACK;
+  if (conf_.trigger_on_planning_fallback() && is_fallback && !is_fallback_) {
+    AddReason(trajectory.trajectory_type() == ADCTrajectory::PATH_FALLBACK
+                  ? "planning_path_fallback"
+                  : "planning_speed_fallback",
+              reason);
+  }
+  is_fallback_ = is_fallback;
+  return !reason->empty();
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <string>
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/data/proto/data_conf.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class TriggerDetector
+ * @brief Tells the events a smart recording is made for from the chassis and
+ * planning messages, once when they start.
+ */
+class TriggerDetector {
+ public:
+  explicit TriggerDetector(const SmartRecordConf& conf);
+
+  /**
+   * @return true on hard braking or disengagement, described in reason.
+   */
+  bool OnChassis(const apollo::canbus::Chassis& chassis, std::string* reason);
+
+  /**
+   * @return true on a switch to a fallback trajectory, described in reason.
+   */
+  bool OnPlanning(const apollo::planning::ADCTrajectory& trajectory,
+                  std::string* reason);
+
+ private:
+  const SmartRecordConf conf_;
+
+  bool is_auto_driving_ = false;
+  // the speed the deceleration is measured from
+  double speed_time_ = 0.0;
+  double speed_ = 0.0;
+  bool is_hard_braking_ = false;
+  bool is_fallback_ = false;
+};
+
+}  // namespace data
+}  // namespace apollo
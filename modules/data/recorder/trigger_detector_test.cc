@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/recorder/trigger_detector.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace data {
+
+using apollo::canbus::Chassis;
+using apollo::planning::ADCTrajectory;
+
+namespace {
+
+Chassis MakeChassis(double time, double speed, Chassis::DrivingMode mode) {
+  Chassis chassis;
+  chassis.mutable_header()->set_timestamp_sec(time);
+  chassis.set_speed_mps(static_cast<float>(speed));
+  chassis.set_driving_mode(mode);
+  return chassis;
+}
+
+}  // namespace
+
+TEST(TriggerDetectorTest, HardBrake) {
+  TriggerDetector detector{SmartRecordConf()};
+  std::string reason;
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.0, 10.0, Chassis::COMPLETE_MANUAL), &reason));
+  // 2 m/s^2
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.5, 9.0, Chassis::COMPLETE_MANUAL), &reason));
+  // 6 m/s^2, measured over 0.2s at least
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.625, 8.25, Chassis::COMPLETE_MANUAL), &reason));
+  EXPECT_TRUE(detector.OnChassis(
+      MakeChassis(1.75, 7.5, Chassis::COMPLETE_MANUAL), &reason));
+  EXPECT_EQ("hard_brake", reason);
+  // still braking hard, triggered once
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(2.0, 6.0, Chassis::COMPLETE_MANUAL), &reason));
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(2.25, 5.75, Chassis::COMPLETE_MANUAL), &reason));
+  EXPECT_TRUE(detector.OnChassis(
+      MakeChassis(2.5, 4.25, Chassis::COMPLETE_MANUAL), &reason));
+}
+
+TEST(TriggerDetectorTest, Disengagement) {
+  TriggerDetector detector{SmartRecordConf()};
+  std::string reason;
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.0, 5.0, Chassis::COMPLETE_AUTO_DRIVE), &reason));
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.1, 5.0, Chassis::COMPLETE_AUTO_DRIVE), &reason));
+  EXPECT_TRUE(detector.OnChassis(
+      MakeChassis(1.2, 5.0, Chassis::COMPLETE_MANUAL), &reason));
+  EXPECT_EQ("disengagement", reason);
+  EXPECT_FALSE(detector.OnChassis(
+      MakeChassis(1.3, 5.0, Chassis::COMPLETE_MANUAL), &reason));
+
+  SmartRecordConf conf;
+  conf.set_trigger_on_disengagement(false);
+  TriggerDetector disabled(conf);
+  EXPECT_FALSE(disabled.OnChassis(
+      MakeChassis(1.0, 5.0, Chassis::COMPLETE_AUTO_DRIVE), &reason));
+  EXPECT_FALSE(disabled.OnChassis(
+      MakeChassis(1.1, 5.0, Chassis::COMPLETE_MANUAL), &reason));
+}
+
+TEST(TriggerDetectorTest, PlanningFallback) {
+  TriggerDetector detector{SmartRecordConf()};
+  std::string reason;
+  ADCTrajectory trajectory;
+  trajectory.set_trajectory_type(ADCTrajectory::NORMAL);
+  EXPECT_FALSE(detector.OnPlanning(trajectory, &reason));
+  trajectory.set_trajectory_type(ADCTrajectory::SPEED_FALLBACK);
+  EXPECT_TRUE(detector.OnPlanning(trajectory, &reason));
+  EXPECT_EQ("planning_speed_fallback", reason);
+  trajectory.set_trajectory_type(ADCTrajectory::PATH_FALLBACK);
+  EXPECT_FALSE(detector.OnPlanning(trajectory, &reason));
+  trajectory.set_trajectory_type(ADCTrajectory::NORMAL);
+  EXPECT_FALSE(detector.OnPlanning(trajectory, &reason));
+  trajectory.set_trajectory_type(ADCTrajectory::PATH_FALLBACK);
+  EXPECT_TRUE(detector.OnPlanning(trajectory, &reason));
+  EXPECT_EQ("planning_path_fallback", reason);
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -44,6 +44,14 @@ DEFINE_string(routing_response_file,
               "take the RoutingResponse from external to determine the start "
               "point.");
 
+DEFINE_bool(sim_control_stepped, false,
+            "Whether SimControl steps a virtual clock, which moves on as soon "
+            "as planning answers each cycle, instead of running in real time.");
+
+DEFINE_int32(sim_control_step_timeout_ms, 1000,
+             "How long in real time a stepped SimControl waits for planning "
+             "before it moves on anyway. Not waiting at all if not positive.");
+
 DEFINE_string(websocket_timeout_ms, "36000000",
               "Time span that CivetServer keeps the websocket connection alive "
               "without dropping it.");
@@ -58,6 +66,9 @@ DEFINE_double(sim_map_radius, 200.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(map_tile_size, 100.0,
+              "The edge in meters of the map tiles Dreamview serves.");
+
 DEFINE_bool(enable_update_size_check, true,
             "True to check if the update byte number is less than threshold");
 
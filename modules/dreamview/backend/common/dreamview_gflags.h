@@ -32,12 +32,18 @@ DECLARE_bool(routing_from_file);
 
 DECLARE_string(routing_response_file);
 
+DECLARE_bool(sim_control_stepped);
+
+DECLARE_int32(sim_control_step_timeout_ms);
+
 DECLARE_string(websocket_timeout_ms);
 
 DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(map_tile_size);
+
 DECLARE_int32(dreamview_worker_num);
 
 DECLARE_bool(enable_update_size_check);
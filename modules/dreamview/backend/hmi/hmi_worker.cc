@@ -505,7 +505,7 @@ void HMIWorker::ChangeMode(const std::string& mode_name) {
     }
     status_changed_ = true;
   }
-  KVDB::Put(FLAGS_current_mode_db_key, mode_name);
+  KVDB::PutAsync(FLAGS_current_mode_db_key, mode_name);
 }
 
 void HMIWorker::StartModule(const std::string& module) const {
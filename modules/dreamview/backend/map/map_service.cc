@@ -21,6 +21,7 @@
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -82,7 +83,8 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
 
-MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
+MapService::MapService(bool use_sim_map)
+    : use_sim_map_(use_sim_map), tile_cache_(FLAGS_map_tile_size) {
   ReloadMap(false);
 }
 
@@ -95,6 +97,8 @@ bool MapService::ReloadMap(bool force_reload) {
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
+  tile_cache_.Clear();
+  ++map_version_;
   return ret;
 }
 
@@ -223,6 +227,52 @@ void MapService::CollectMapElementIds(const PointENU &point, double radius,
   ExtractIds(yield_signs, ids->mutable_yield());
 }
 
+void MapService::CollectMapTileIds(const PointENU &point, double radius,
+                                   std::vector<std::string> *tile_ids) const {
+  tile_cache_.CollectTileIds(point.x(), point.y(),
+                             radius + tile_cache_.tile_size() / 2.0, tile_ids);
+}
+
+void MapService::CollectMapElementIdsInTiles(
+    const std::vector<std::string> &tile_ids, MapElementIds *ids) const {
+  if (!MapReady()) {
+    return;
+  }
+  boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+  for (const auto &tile_id : tile_ids) {
+    const auto tile = tile_cache_.GetTile(*SimMap(), tile_id);
+    if (tile != nullptr) {
+      ids->MergeFrom(tile->ids);
+    }
+  }
+}
+
+bool MapService::RetrieveMapTiles(const std::vector<std::string> &tile_ids,
+                                  const int level, std::string *data) const {
+  if (level < 0 || level >= MapTileCache::kNumLevels || !MapReady()) {
+    return false;
+  }
+  boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+  std::vector<std::shared_ptr<const MapTileCache::Tile>> tiles;
+  size_t size = 0;
+  for (const auto &tile_id : tile_ids) {
+    auto tile = tile_cache_.GetTile(*SimMap(), tile_id);
+    if (tile == nullptr) {
+      AERROR << "Malformed map tile id: " << tile_id;
+      return false;
+    }
+    size += tile->data[level].size();
+    tiles.push_back(std::move(tile));
+  }
+  // Concatenated Maps parse as the Map of all their elements.
+  data->clear();
+  data->reserve(size);
+  for (const auto &tile : tiles) {
+    data->append(tile->data[level]);
+  }
+  return true;
+}
+
 Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
@@ -515,5 +565,17 @@ size_t MapService::CalculateMapHash(const MapElementIds &ids) const {
   return hash_function(ids.DebugString());
 }
 
+size_t MapService::CalculateMapHash(
+    const std::vector<std::string> &tile_ids) const {
+  static std::hash<std::string> hash_function;
+  boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+  std::string key = std::to_string(map_version_);
+  for (const auto &tile_id : tile_ids) {
+    key += ",";
+    key += tile_id;
+  }
+  return hash_function(key);
+}
+
 }  // namespace dreamview
 }  // namespace apollo
@@ -26,6 +26,7 @@
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
 
+#include "modules/dreamview/backend/map/map_tile_cache.h"
 #include "modules/dreamview/proto/simulation_world.pb.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "third_party/json/json.hpp"
@@ -51,6 +52,16 @@ class MapService {
   void CollectMapElementIds(const apollo::common::PointENU &point,
                             double raidus, MapElementIds *ids) const;
 
+  // Collects the ids of the map tiles within the radius of the point, grown
+  // by half a tile for the elements which start in a tile further away.
+  void CollectMapTileIds(const apollo::common::PointENU &point, double radius,
+                         std::vector<std::string> *tile_ids) const;
+
+  // Unlike CollectMapElementIds(), only queries the map for the tiles which
+  // are not cached yet.
+  void CollectMapElementIdsInTiles(const std::vector<std::string> &tile_ids,
+                                   MapElementIds *ids) const;
+
   bool GetPathsFromRouting(const apollo::routing::RoutingResponse &routing,
                            std::vector<apollo::hdmap::Path> *paths) const;
 
@@ -59,6 +70,14 @@ class MapService {
   // javascript clients.
   hdmap::Map RetrieveMapElements(const MapElementIds &ids) const;
 
+  /**
+   * @brief Gets the map tiles as a serialized hdmap::Map, simplified at the
+   * level of detail, from 0 up to MapTileCache::kNumLevels - 1.
+   * @return False if the map is not ready or a tile id is malformed.
+   */
+  bool RetrieveMapTiles(const std::vector<std::string> &tile_ids,
+                        const int level, std::string *data) const;
+
   bool GetPoseWithRegardToLane(const double x, const double y, double *theta,
                                double *s) const;
 
@@ -89,6 +108,10 @@ class MapService {
 
   size_t CalculateMapHash(const MapElementIds &ids) const;
 
+  // The hash of the elements in the tiles, which changes with the tiles or
+  // when the map is reloaded.
+  size_t CalculateMapHash(const std::vector<std::string> &tile_ids) const;
+
  private:
   void UpdateOffsets();
   bool GetNearestLane(const double x, const double y,
@@ -117,6 +140,11 @@ class MapService {
   double x_offset_ = 0.0;
   double y_offset_ = 0.0;
 
+  // Tiles of the sim map, built as they are asked for.
+  mutable MapTileCache tile_cache_;
+  // Counts the reloads of the map.
+  size_t map_version_ = 0;
+
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
 };
@@ -62,6 +62,30 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, RetrieveMapTiles) {
+  PointENU p;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  std::vector<std::string> tile_ids;
+  map_service->CollectMapTileIds(p, 200.0, &tile_ids);
+  EXPECT_FALSE(tile_ids.empty());
+
+  MapElementIds map_element_ids;
+  map_service->CollectMapElementIdsInTiles(tile_ids, &map_element_ids);
+  ASSERT_EQ(1, map_element_ids.lane_size());
+  EXPECT_EQ("l1", map_element_ids.lane(0));
+
+  std::string data;
+  ASSERT_TRUE(map_service->RetrieveMapTiles(tile_ids, 1, &data));
+  Map map;
+  ASSERT_TRUE(map.ParseFromString(data));
+  ASSERT_EQ(1, map.lane_size());
+  EXPECT_EQ("l1", map.lane(0).id().id());
+
+  EXPECT_FALSE(map_service->RetrieveMapTiles(tile_ids, 3, &data));
+  EXPECT_FALSE(map_service->RetrieveMapTiles({"1"}, 0, &data));
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
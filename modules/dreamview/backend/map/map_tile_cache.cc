@@ -0,0 +1,395 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/map/map_tile_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <utility>
+
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace dreamview {
+
+using apollo::common::PointENU;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+using apollo::hdmap::Curve;
+using apollo::hdmap::Map;
+using google::protobuf::RepeatedPtrField;
+
+constexpr double MapTileCache::kLevelTolerances[];
+constexpr int MapTileCache::kNumLevels;
+
+namespace {
+
+std::string MakeTileId(const int64_t ix, const int64_t iy) {
+  return std::to_string(ix) + "_" + std::to_string(iy);
+}
+
+bool ParseTileId(const std::string &tile_id, int64_t *ix, int64_t *iy) {
+  const size_t separator = tile_id.find('_');
+  if (separator == std::string::npos) {
+    return false;
+  }
+  try {
+    size_t x_end = 0;
+    size_t y_end = 0;
+    *ix = std::stoll(tile_id.substr(0, separator), &x_end);
+    *iy = std::stoll(tile_id.substr(separator + 1), &y_end);
+    return x_end == separator && separator + 1 + y_end == tile_id.size();
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+// The first point of an element, which decides the tile it belongs to.
+bool LaneAnchor(const hdmap::LaneInfo &lane, Vec2d *anchor) {
+  if (lane.points().empty()) {
+    return false;
+  }
+  *anchor = lane.points().front();
+  return true;
+}
+
+template <typename Info>
+bool PolygonAnchor(const Info &info, Vec2d *anchor) {
+  if (info.polygon().points().empty()) {
+    return false;
+  }
+  *anchor = info.polygon().points().front();
+  return true;
+}
+
+template <typename Info>
+bool SegmentsAnchor(const Info &info, Vec2d *anchor) {
+  if (info.segments().empty()) {
+    return false;
+  }
+  *anchor = info.segments().front().start();
+  return true;
+}
+
+void SimplifyCurve(const double tolerance, Curve *curve) {
+  for (auto &segment : *curve->mutable_segment()) {
+    if (segment.has_line_segment()) {
+      MapTileCache::SimplifyPoints(
+          tolerance, segment.mutable_line_segment()->mutable_point());
+    }
+  }
+}
+
+void SimplifyCurves(const double tolerance, RepeatedPtrField<Curve> *curves) {
+  for (auto &curve : *curves) {
+    SimplifyCurve(tolerance, &curve);
+  }
+}
+
+void SimplifyMap(const double tolerance, Map *map) {
+  for (auto &lane : *map->mutable_lane()) {
+    SimplifyCurve(tolerance, lane.mutable_central_curve());
+    SimplifyCurve(tolerance, lane.mutable_left_boundary()->mutable_curve());
+    SimplifyCurve(tolerance, lane.mutable_right_boundary()->mutable_curve());
+  }
+  for (auto &road : *map->mutable_road()) {
+    for (auto &section : *road.mutable_section()) {
+      for (auto &edge : *section.mutable_boundary()
+                             ->mutable_outer_polygon()
+                             ->mutable_edge()) {
+        SimplifyCurve(tolerance, edge.mutable_curve());
+      }
+    }
+  }
+  for (auto &crosswalk : *map->mutable_crosswalk()) {
+    MapTileCache::SimplifyPoints(tolerance,
+                                 crosswalk.mutable_polygon()->mutable_point());
+  }
+  for (auto &clear_area : *map->mutable_clear_area()) {
+    MapTileCache::SimplifyPoints(
+        tolerance, clear_area.mutable_polygon()->mutable_point());
+  }
+  for (auto &junction : *map->mutable_junction()) {
+    MapTileCache::SimplifyPoints(tolerance,
+                                 junction.mutable_polygon()->mutable_point());
+  }
+  for (auto &pnc_junction : *map->mutable_pnc_junction()) {
+    MapTileCache::SimplifyPoints(
+        tolerance, pnc_junction.mutable_polygon()->mutable_point());
+  }
+  for (auto &parking_space : *map->mutable_parking_space()) {
+    MapTileCache::SimplifyPoints(
+        tolerance, parking_space.mutable_polygon()->mutable_point());
+  }
+  for (auto &signal : *map->mutable_signal()) {
+    SimplifyCurves(tolerance, signal.mutable_stop_line());
+  }
+  for (auto &stop_sign : *map->mutable_stop_sign()) {
+    SimplifyCurves(tolerance, stop_sign.mutable_stop_line());
+  }
+  for (auto &yield : *map->mutable_yield()) {
+    SimplifyCurves(tolerance, yield.mutable_stop_line());
+  }
+  for (auto &speed_bump : *map->mutable_speed_bump()) {
+    SimplifyCurves(tolerance, speed_bump.mutable_position());
+  }
+}
+
+}  // namespace
+
+MapTileCache::MapTileCache(const double tile_size) : tile_size_(tile_size) {}
+
+int64_t MapTileCache::TileIndex(const double coordinate) const {
+  return static_cast<int64_t>(std::floor(coordinate / tile_size_));
+}
+
+void MapTileCache::CollectTileIds(const double x, const double y,
+                                  const double radius,
+                                  std::vector<std::string> *tile_ids) const {
+  const Vec2d center(x, y);
+  for (int64_t ix = TileIndex(x - radius); ix <= TileIndex(x + radius);
+       ++ix) {
+    for (int64_t iy = TileIndex(y - radius); iy <= TileIndex(y + radius);
+         ++iy) {
+      // the nearest point of the tile to the center
+      const Vec2d nearest(
+          std::max(ix * tile_size_, std::min(x, (ix + 1) * tile_size_)),
+          std::max(iy * tile_size_, std::min(y, (iy + 1) * tile_size_)));
+      if (nearest.DistanceTo(center) <= radius) {
+        tile_ids->push_back(MakeTileId(ix, iy));
+      }
+    }
+  }
+}
+
+std::shared_ptr<const MapTileCache::Tile> MapTileCache::GetTile(
+    const hdmap::HDMap &map, const std::string &tile_id) {
+  int64_t ix = 0;
+  int64_t iy = 0;
+  if (!ParseTileId(tile_id, &ix, &iy)) {
+    return nullptr;
+  }
+  // Tiles are built under the lock, so each is built once however many
+  // clients ask for it at the same time.
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &tile = tiles_[tile_id];
+  if (tile == nullptr) {
+    tile = BuildTile(map, ix, iy);
+  }
+  return tile;
+}
+
+void MapTileCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tiles_.clear();
+}
+
+std::unique_ptr<MapTileCache::Tile> MapTileCache::BuildTile(
+    const hdmap::HDMap &map, const int64_t ix, const int64_t iy) const {
+  std::unique_ptr<Tile> tile(new Tile());
+  PointENU center;
+  center.set_x((static_cast<double>(ix) + 0.5) * tile_size_);
+  center.set_y((static_cast<double>(iy) + 0.5) * tile_size_);
+  // Every element with a point in the tile is within the half diagonal.
+  const double radius = tile_size_ * M_SQRT1_2 + 1e-3;
+  auto in_tile = [this, ix, iy](const Vec2d &point) {
+    return TileIndex(point.x()) == ix && TileIndex(point.y()) == iy;
+  };
+  Map map_pb;
+
+  std::vector<hdmap::LaneInfoConstPtr> lanes;
+  map.GetLanes(center, radius, &lanes);
+  for (const auto &lane : lanes) {
+    Vec2d anchor;
+    if (!LaneAnchor(*lane, &anchor) || !in_tile(anchor)) {
+      continue;
+    }
+    tile->ids.add_lane(lane->id().id());
+    auto *lane_pb = map_pb.add_lane();
+    *lane_pb = lane->lane();
+    lane_pb->clear_left_sample();
+    lane_pb->clear_right_sample();
+    lane_pb->clear_left_road_sample();
+    lane_pb->clear_right_road_sample();
+    lane_pb->clear_overlap_id();
+
+    // A road belongs to the tile of its first lane.
+    if (lane->road_id().id().empty()) {
+      continue;
+    }
+    const auto road = map.GetRoadById(lane->road_id());
+    if (road != nullptr && !road->sections().empty() &&
+        road->sections().front().lane_id_size() > 0 &&
+        road->sections().front().lane_id(0).id() == lane->id().id()) {
+      tile->ids.add_road(road->id().id());
+      *map_pb.add_road() = road->road();
+    }
+  }
+
+  std::vector<hdmap::ClearAreaInfoConstPtr> clear_areas;
+  map.GetClearAreas(center, radius, &clear_areas);
+  for (const auto &clear_area : clear_areas) {
+    Vec2d anchor;
+    if (PolygonAnchor(*clear_area, &anchor) && in_tile(anchor)) {
+      tile->ids.add_clear_area(clear_area->id().id());
+      *map_pb.add_clear_area() = clear_area->clear_area();
+      map_pb.mutable_clear_area()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::CrosswalkInfoConstPtr> crosswalks;
+  map.GetCrosswalks(center, radius, &crosswalks);
+  for (const auto &crosswalk : crosswalks) {
+    Vec2d anchor;
+    if (PolygonAnchor(*crosswalk, &anchor) && in_tile(anchor)) {
+      tile->ids.add_crosswalk(crosswalk->id().id());
+      *map_pb.add_crosswalk() = crosswalk->crosswalk();
+      map_pb.mutable_crosswalk()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::JunctionInfoConstPtr> junctions;
+  map.GetJunctions(center, radius, &junctions);
+  for (const auto &junction : junctions) {
+    Vec2d anchor;
+    if (PolygonAnchor(*junction, &anchor) && in_tile(anchor)) {
+      tile->ids.add_junction(junction->id().id());
+      *map_pb.add_junction() = junction->junction();
+      map_pb.mutable_junction()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::PNCJunctionInfoConstPtr> pnc_junctions;
+  map.GetPNCJunctions(center, radius, &pnc_junctions);
+  for (const auto &pnc_junction : pnc_junctions) {
+    Vec2d anchor;
+    if (PolygonAnchor(*pnc_junction, &anchor) && in_tile(anchor)) {
+      tile->ids.add_pnc_junction(pnc_junction->id().id());
+      *map_pb.add_pnc_junction() = pnc_junction->pnc_junction();
+      map_pb.mutable_pnc_junction()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::ParkingSpaceInfoConstPtr> parking_spaces;
+  map.GetParkingSpaces(center, radius, &parking_spaces);
+  for (const auto &parking_space : parking_spaces) {
+    Vec2d anchor;
+    if (PolygonAnchor(*parking_space, &anchor) && in_tile(anchor)) {
+      tile->ids.add_parking_space(parking_space->id().id());
+      *map_pb.add_parking_space() = parking_space->parking_space();
+      map_pb.mutable_parking_space()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::SpeedBumpInfoConstPtr> speed_bumps;
+  map.GetSpeedBumps(center, radius, &speed_bumps);
+  for (const auto &speed_bump : speed_bumps) {
+    Vec2d anchor;
+    if (SegmentsAnchor(*speed_bump, &anchor) && in_tile(anchor)) {
+      tile->ids.add_speed_bump(speed_bump->id().id());
+      *map_pb.add_speed_bump() = speed_bump->speed_bump();
+      map_pb.mutable_speed_bump()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::SignalInfoConstPtr> signals;
+  map.GetSignals(center, radius, &signals);
+  for (const auto &signal : signals) {
+    Vec2d anchor;
+    if (SegmentsAnchor(*signal, &anchor) && in_tile(anchor)) {
+      tile->ids.add_signal(signal->id().id());
+      *map_pb.add_signal() = signal->signal();
+      map_pb.mutable_signal()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::StopSignInfoConstPtr> stop_signs;
+  map.GetStopSigns(center, radius, &stop_signs);
+  for (const auto &stop_sign : stop_signs) {
+    Vec2d anchor;
+    if (SegmentsAnchor(*stop_sign, &anchor) && in_tile(anchor)) {
+      tile->ids.add_stop_sign(stop_sign->id().id());
+      *map_pb.add_stop_sign() = stop_sign->stop_sign();
+      map_pb.mutable_stop_sign()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  std::vector<hdmap::YieldSignInfoConstPtr> yield_signs;
+  map.GetYieldSigns(center, radius, &yield_signs);
+  for (const auto &yield_sign : yield_signs) {
+    Vec2d anchor;
+    if (SegmentsAnchor(*yield_sign, &anchor) && in_tile(anchor)) {
+      tile->ids.add_yield(yield_sign->id().id());
+      *map_pb.add_yield() = yield_sign->yield_sign();
+      map_pb.mutable_yield()->rbegin()->clear_overlap_id();
+    }
+  }
+
+  for (int level = 0; level < kNumLevels; ++level) {
+    Map simplified = map_pb;
+    SimplifyMap(kLevelTolerances[level], &simplified);
+    simplified.SerializeToString(&tile->data[level]);
+  }
+  return tile;
+}
+
+void MapTileCache::SimplifyPoints(const double tolerance,
+                                  RepeatedPtrField<PointENU> *points) {
+  const int num_points = points->size();
+  if (num_points <= 2) {
+    return;
+  }
+  auto to_vec2d = [points](const int i) {
+    return Vec2d(points->Get(i).x(), points->Get(i).y());
+  };
+  std::vector<bool> keep(num_points, false);
+  keep.front() = true;
+  keep.back() = true;
+  // the ranges of points left to check, ends excluded
+  std::vector<std::pair<int, int>> ranges = {{0, num_points - 1}};
+  while (!ranges.empty()) {
+    const int first = ranges.back().first;
+    const int last = ranges.back().second;
+    ranges.pop_back();
+    const LineSegment2d chord(to_vec2d(first), to_vec2d(last));
+    double max_distance = tolerance;
+    int farthest = -1;
+    for (int i = first + 1; i < last; ++i) {
+      const double distance = chord.DistanceTo(to_vec2d(i));
+      if (distance > max_distance) {
+        max_distance = distance;
+        farthest = i;
+      }
+    }
+    if (farthest >= 0) {
+      keep[farthest] = true;
+      ranges.emplace_back(first, farthest);
+      ranges.emplace_back(farthest, last);
+    }
+  }
+
+  int num_kept = 0;
+  for (int i = 0; i < num_points; ++i) {
+    if (keep[i]) {
+      points->SwapElements(i, num_kept++);
+    }
+  }
+  points->DeleteSubrange(num_kept, num_points - num_kept);
+}
+
+}  // namespace dreamview
+}  // namespace apollo
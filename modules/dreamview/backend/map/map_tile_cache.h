@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/dreamview/proto/simulation_world.pb.h"
+#include "modules/map/hdmap/hdmap.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class MapTileCache
+ * @brief Splits the map into square tiles, and keeps for each tile that has
+ * been asked for the ids of its elements and their geometry, ready to send.
+ *
+ * Each element belongs to the one tile which its first point falls in, so
+ * that the tiles never overlap. The geometry is kept at a few levels of
+ * detail, simplified within a tolerance that grows with the level, and
+ * without the samples and overlaps the frontend does not draw.
+ */
+class MapTileCache {
+ public:
+  // Tolerances of the levels of detail in meters.
+  static constexpr double kLevelTolerances[] = {0.05, 0.5, 2.0};
+  static constexpr int kNumLevels = 3;
+
+  struct Tile {
+    MapElementIds ids;
+    // A serialized hdmap::Map per level of detail. Concatenating the data
+    // of several tiles gives the Map of them all.
+    std::string data[kNumLevels];
+  };
+
+  explicit MapTileCache(const double tile_size);
+
+  double tile_size() const { return tile_size_; }
+
+  /**
+   * @brief Gets the ids of the tiles which overlap the circle, in a stable
+   * order.
+   */
+  void CollectTileIds(const double x, const double y, const double radius,
+                      std::vector<std::string> *tile_ids) const;
+
+  /**
+   * @brief Gets the tile, building it from the map the first time.
+   * @return nullptr if the tile id is malformed.
+   */
+  std::shared_ptr<const Tile> GetTile(const hdmap::HDMap &map,
+                                      const std::string &tile_id);
+
+  /**
+   * @brief Drops all the tiles, e.g. after the map is reloaded.
+   */
+  void Clear();
+
+  /**
+   * @brief Drops the points of a polyline which are within tolerance of the
+   * simplified polyline (Douglas-Peucker), keeping both ends.
+   */
+  static void SimplifyPoints(
+      const double tolerance,
+      google::protobuf::RepeatedPtrField<common::PointENU> *points);
+
+ private:
+  std::unique_ptr<Tile> BuildTile(const hdmap::HDMap &map, const int64_t ix,
+                                  const int64_t iy) const;
+
+  int64_t TileIndex(const double coordinate) const;
+
+  const double tile_size_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const Tile>> tiles_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
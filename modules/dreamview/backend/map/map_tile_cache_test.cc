@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/map/map_tile_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/map/hdmap/hdmap_util.h"
+
+namespace apollo {
+namespace dreamview {
+
+using apollo::common::PointENU;
+using google::protobuf::RepeatedPtrField;
+
+TEST(MapTileCacheTest, SimplifyPoints) {
+  RepeatedPtrField<PointENU> points;
+  // a straight line, then a corner
+  for (int i = 0; i <= 10; ++i) {
+    auto *point = points.Add();
+    point->set_x(i);
+    point->set_y(0.01 * (i % 2));
+  }
+  auto *corner = points.Add();
+  corner->set_x(10.0);
+  corner->set_y(10.0);
+
+  MapTileCache::SimplifyPoints(0.05, &points);
+  ASSERT_EQ(3, points.size());
+  EXPECT_DOUBLE_EQ(0.0, points.Get(0).x());
+  EXPECT_DOUBLE_EQ(10.0, points.Get(1).x());
+  EXPECT_DOUBLE_EQ(0.0, points.Get(1).y());
+  EXPECT_DOUBLE_EQ(10.0, points.Get(2).y());
+}
+
+TEST(MapTileCacheTest, CollectTileIds) {
+  MapTileCache cache(100.0);
+  std::vector<std::string> tile_ids;
+  cache.CollectTileIds(50.0, 50.0, 10.0, &tile_ids);
+  EXPECT_EQ(std::vector<std::string>({"0_0"}), tile_ids);
+
+  // the corner tiles are farther than the radius
+  tile_ids.clear();
+  cache.CollectTileIds(50.0, 50.0, 60.0, &tile_ids);
+  EXPECT_EQ(std::vector<std::string>({"-1_0", "0_-1", "0_0", "0_1", "1_0"}),
+            tile_ids);
+}
+
+TEST(MapTileCacheTest, GetTile) {
+  FLAGS_map_dir = "modules/dreamview/backend/testdata";
+  FLAGS_base_map_filename = "garage.bin";
+  const hdmap::HDMap *map = hdmap::HDMapUtil::BaseMapPtr();
+  ASSERT_NE(nullptr, map);
+
+  MapTileCache cache(100.0);
+  EXPECT_EQ(nullptr, cache.GetTile(*map, "0"));
+  EXPECT_EQ(nullptr, cache.GetTile(*map, "0_x"));
+
+  std::vector<std::string> tile_ids;
+  cache.CollectTileIds(-1826.0, -3027.0, 500.0, &tile_ids);
+  MapElementIds ids;
+  hdmap::Map map_pb;
+  for (const auto &tile_id : tile_ids) {
+    const auto tile = cache.GetTile(*map, tile_id);
+    ASSERT_NE(nullptr, tile);
+    EXPECT_EQ(tile, cache.GetTile(*map, tile_id));
+    EXPECT_LE(tile->data[2].size(), tile->data[0].size());
+    ids.MergeFrom(tile->ids);
+    hdmap::Map tile_map;
+    ASSERT_TRUE(tile_map.ParseFromString(tile->data[0]));
+    map_pb.MergeFrom(tile_map);
+  }
+  // The lane belongs to a single tile.
+  ASSERT_EQ(1, ids.lane_size());
+  EXPECT_EQ("l1", ids.lane(0));
+  ASSERT_EQ(1, map_pb.lane_size());
+  EXPECT_EQ("l1", map_pb.lane(0).id().id());
+  EXPECT_EQ(0, map_pb.lane(0).left_sample_size());
+  EXPECT_EQ(0, map_pb.lane(0).overlap_id_size());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
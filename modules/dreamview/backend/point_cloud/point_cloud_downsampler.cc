@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+// Each voxel index takes 21 bits of the key, offset to be non-negative.
+constexpr int kIndexBits = 21;
+constexpr int64_t kIndexOffset = int64_t{1} << (kIndexBits - 1);
+
+bool VoxelIndex(const float value, const float inverse_leaf, uint64_t *index) {
+  const int64_t i =
+      static_cast<int64_t>(std::floor(value * inverse_leaf)) + kIndexOffset;
+  if (i < 0 || i >= (int64_t{1} << kIndexBits)) {
+    return false;
+  }
+  *index = static_cast<uint64_t>(i);
+  return true;
+}
+
+bool Quantize(const float value, char *bytes) {
+  const float q = std::round(value / PointCloudDownsampler::kQuantizationStep);
+  if (q < std::numeric_limits<int16_t>::min() ||
+      q > std::numeric_limits<int16_t>::max()) {
+    return false;
+  }
+  // little endian, whatever the host is
+  const uint16_t u = static_cast<uint16_t>(static_cast<int16_t>(q));
+  bytes[0] = static_cast<char>(u & 0xFF);
+  bytes[1] = static_cast<char>(u >> 8);
+  return true;
+}
+
+}  // namespace
+
+PointCloudDownsampler::PointCloudDownsampler() : voxels_(1024) {}
+
+void PointCloudDownsampler::Downsample(const drivers::PointCloud &cloud,
+                                       const float leaf_size,
+                                       const float leaf_height,
+                                       const float z_offset,
+                                       const bool quantized,
+                                       PointCloud *output) {
+  output->Clear();
+  voxels_.clear();
+  const float inverse_leaf_size = 1.0f / leaf_size;
+  const float inverse_leaf_height = 1.0f / leaf_height;
+
+  for (const auto &point : cloud.point()) {
+    const float x = point.x();
+    const float y = point.y();
+    const float z = point.z();
+    uint64_t ix = 0;
+    uint64_t iy = 0;
+    uint64_t iz = 0;
+    // NaN and far away points fail here as well.
+    if (!VoxelIndex(x, inverse_leaf_size, &ix) ||
+        !VoxelIndex(y, inverse_leaf_size, &iy) ||
+        !VoxelIndex(z, inverse_leaf_height, &iz)) {
+      continue;
+    }
+    const uint64_t key = (ix << (2 * kIndexBits)) | (iy << kIndexBits) | iz;
+    auto result = voxels_.emplace(key);
+    if (result.first == voxels_.end()) {
+      voxels_.reserve(voxels_.capacity() * 2);
+      result = voxels_.emplace(key);
+    }
+    Voxel &voxel = result.first->second;
+    voxel.x += x;
+    voxel.y += y;
+    voxel.z += z;
+    ++voxel.count;
+  }
+
+  if (quantized) {
+    output->set_quantization_step(kQuantizationStep);
+    std::string *bytes = output->mutable_quantized_point();
+    bytes->resize(voxels_.size() * 3 * sizeof(int16_t));
+    size_t size = 0;
+    for (const auto &entry : voxels_) {
+      const Voxel &voxel = entry.second;
+      char *point = &(*bytes)[size];
+      if (Quantize(voxel.x / voxel.count, point) &&
+          Quantize(voxel.y / voxel.count, point + 2) &&
+          Quantize(voxel.z / voxel.count + z_offset, point + 4)) {
+        size += 3 * sizeof(int16_t);
+      }
+    }
+    bytes->resize(size);
+  } else {
+    output->mutable_num()->Reserve(static_cast<int>(voxels_.size() * 3));
+    for (const auto &entry : voxels_) {
+      const Voxel &voxel = entry.second;
+      output->add_num(voxel.x / voxel.count);
+      output->add_num(voxel.y / voxel.count);
+      output->add_num(voxel.z / voxel.count + z_offset);
+    }
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "modules/common/util/flat_hash_map.h"
+#include "modules/dreamview/proto/point_cloud.pb.h"
+#include "modules/drivers/proto/pointcloud.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class PointCloudDownsampler
+ * @brief Reduces a lidar PointCloud to the centroids of the voxels its points
+ * fall in, in a single pass over the points, and writes them either as
+ * floats or as int16 coordinates in centimeters, a third of the size.
+ *
+ * The voxels are kept in a table which is reused across the clouds, so that
+ * a downsampler allocates only while the clouds grow.
+ */
+class PointCloudDownsampler {
+ public:
+  // 1 cm keeps the int16 coordinates within 327 m of the lidar.
+  static constexpr float kQuantizationStep = 0.01f;
+
+  PointCloudDownsampler();
+
+  /**
+   * @brief Downsamples the cloud into output, which is cleared first.
+   * @param leaf_size the edge of the voxels on the ground.
+   * @param leaf_height the height of the voxels.
+   * @param z_offset added to z, e.g. the height of the lidar.
+   * @param quantized whether to write quantized_point instead of num.
+   * Points out of its range are dropped.
+   */
+  void Downsample(const drivers::PointCloud &cloud, const float leaf_size,
+                  const float leaf_height, const float z_offset,
+                  const bool quantized, PointCloud *output);
+
+ private:
+  struct Voxel {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    uint32_t count = 0;
+  };
+
+  common::util::FlatHashMap<uint64_t, Voxel> voxels_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
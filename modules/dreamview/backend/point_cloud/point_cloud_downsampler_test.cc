@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+void AddPoint(const float x, const float y, const float z,
+              drivers::PointCloud *cloud) {
+  auto *point = cloud->add_point();
+  point->set_x(x);
+  point->set_y(y);
+  point->set_z(z);
+}
+
+int16_t DecodeInt16(const std::string &bytes, const size_t i) {
+  return static_cast<int16_t>(static_cast<uint8_t>(bytes[i]) |
+                              static_cast<uint8_t>(bytes[i + 1]) << 8);
+}
+
+}  // namespace
+
+TEST(PointCloudDownsamplerTest, AveragesPointsOfEachVoxel) {
+  drivers::PointCloud cloud;
+  AddPoint(0.1f, 0.1f, 0.1f, &cloud);
+  AddPoint(0.3f, 0.3f, 0.3f, &cloud);
+  AddPoint(-0.2f, 0.2f, 0.2f, &cloud);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  AddPoint(nan, nan, nan, &cloud);
+  cloud.add_point();  // defaults to NaN as well
+
+  PointCloudDownsampler downsampler;
+  PointCloud output;
+  downsampler.Downsample(cloud, 0.5f, 0.5f, 1.0f, false, &output);
+  ASSERT_EQ(output.num_size(), 6);
+  EXPECT_FALSE(output.has_quantized_point());
+
+  bool found_average = false;
+  bool found_single = false;
+  for (int i = 0; i < output.num_size(); i += 3) {
+    if (output.num(i) > 0.0f) {
+      EXPECT_FLOAT_EQ(output.num(i), 0.2f);
+      EXPECT_FLOAT_EQ(output.num(i + 1), 0.2f);
+      EXPECT_FLOAT_EQ(output.num(i + 2), 1.2f);
+      found_average = true;
+    } else {
+      EXPECT_FLOAT_EQ(output.num(i), -0.2f);
+      EXPECT_FLOAT_EQ(output.num(i + 1), 0.2f);
+      EXPECT_FLOAT_EQ(output.num(i + 2), 1.2f);
+      found_single = true;
+    }
+  }
+  EXPECT_TRUE(found_average);
+  EXPECT_TRUE(found_single);
+}
+
+TEST(PointCloudDownsamplerTest, QuantizesPoints) {
+  drivers::PointCloud cloud;
+  AddPoint(12.345f, -6.789f, 0.5f, &cloud);
+  // out of the int16 range
+  AddPoint(400.0f, 0.0f, 0.0f, &cloud);
+
+  PointCloudDownsampler downsampler;
+  PointCloud output;
+  downsampler.Downsample(cloud, 0.1f, 0.1f, 1.0f, true, &output);
+  EXPECT_EQ(output.num_size(), 0);
+  EXPECT_FLOAT_EQ(output.quantization_step(),
+                  PointCloudDownsampler::kQuantizationStep);
+  const std::string &bytes = output.quantized_point();
+  ASSERT_EQ(bytes.size(), 6);
+  EXPECT_EQ(DecodeInt16(bytes, 0), 1235);
+  EXPECT_EQ(DecodeInt16(bytes, 2), -679);
+  EXPECT_EQ(DecodeInt16(bytes, 4), 150);
+}
+
+TEST(PointCloudDownsamplerTest, ReusesVoxelsAcrossClouds) {
+  drivers::PointCloud cloud;
+  // more voxels than the initial table holds
+  for (int i = 0; i < 5000; ++i) {
+    AddPoint(static_cast<float>(i), 0.0f, 0.0f, &cloud);
+  }
+  PointCloudDownsampler downsampler;
+  PointCloud output;
+  downsampler.Downsample(cloud, 0.5f, 0.5f, 0.0f, false, &output);
+  EXPECT_EQ(output.num_size(), 15000);
+
+  cloud.Clear();
+  AddPoint(1.0f, 1.0f, 1.0f, &cloud);
+  downsampler.Downsample(cloud, 0.5f, 0.5f, 0.0f, false, &output);
+  EXPECT_EQ(output.num_size(), 3);
+}
+
+}  // namespace dreamview
+}  // namespace apollo
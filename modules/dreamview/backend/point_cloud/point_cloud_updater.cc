@@ -16,7 +16,8 @@
 
 #include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
 
-#include <utility>
+#include <cmath>
+#include <string>
 
 #include "cyber/common/log.h"
 #include "modules/common/adapters/adapter_gflags.h"
@@ -24,7 +25,6 @@
 #include "modules/common/util/file.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/dreamview/proto/point_cloud.pb.h"
-#include "pcl/filters/voxel_grid.h"
 #include "third_party/json/json.hpp"
 #include "yaml-cpp/yaml.h"
 
@@ -34,14 +34,18 @@ namespace dreamview {
 using apollo::localization::LocalizationEstimate;
 using Json = nlohmann::json;
 
+namespace {
+
+// Scale of the voxels at each density.
+constexpr float kVoxelScale[] = {2.0f, 1.0f, 0.5f};
+
+}  // namespace
+
 float PointCloudUpdater::lidar_height_ = kDefaultLidarHeight;
 boost::shared_mutex PointCloudUpdater::mutex_;
 
 PointCloudUpdater::PointCloudUpdater(WebSocketHandler *websocket)
-    : node_(cyber::CreateNode("point_cloud")),
-      websocket_(websocket),
-      point_cloud_str_(""),
-      future_ready_(true) {
+    : node_(cyber::CreateNode("point_cloud")), websocket_(websocket) {
   RegisterMessageHandlers();
 }
 
@@ -83,18 +87,32 @@ void PointCloudUpdater::RegisterMessageHandlers() {
   websocket_->RegisterMessageHandler(
       "RequestPointCloud",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
-        std::string to_send;
-        // If there is no point_cloud data for more than 2 seconds, reset.
-        if (point_cloud_str_ != "" &&
-            std::fabs(last_localization_time_ - last_point_cloud_time_) > 2.0) {
-          boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-          point_cloud_str_ = "";
+        // Clients which send neither get the default density in floats.
+        Density density = MEDIUM;
+        auto iter = json.find("density");
+        if (iter != json.end() && iter->is_string()) {
+          const std::string value = *iter;
+          if (value == "LOW") {
+            density = LOW;
+          } else if (value == "HIGH") {
+            density = HIGH;
+          }
         }
-        {
-          boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = point_cloud_str_;
+        iter = json.find("quantized");
+        const bool quantized =
+            iter != json.end() && iter->is_boolean() && iter->get<bool>();
+
+        // If there is no point_cloud data for more than 2 seconds, reset.
+        if (std::fabs(last_localization_time_ - last_point_cloud_time_) >
+            2.0) {
+          std::lock_guard<std::mutex> lock(cloud_mutex_);
+          if (point_cloud_ != nullptr) {
+            point_cloud_.reset();
+            ++cloud_version_;
+          }
         }
-        websocket_->SendBinaryData(conn, to_send, true);
+        websocket_->SendBinaryData(conn, GetPointCloud(density, quantized),
+                                   true);
       });
   websocket_->RegisterMessageHandler(
       "TogglePointCloud",
@@ -133,9 +151,9 @@ void PointCloudUpdater::Start() {
 }
 
 void PointCloudUpdater::Stop() {
-  if (enabled_) {
-    async_future_.wait();
-  }
+  std::lock_guard<std::mutex> lock(cloud_mutex_);
+  point_cloud_.reset();
+  ++cloud_version_;
 }
 
 void PointCloudUpdater::UpdatePointCloud(
@@ -144,69 +162,50 @@ void PointCloudUpdater::UpdatePointCloud(
     return;
   }
 
+  // Only keep the latest cloud; it is downsampled once a client asks.
   last_point_cloud_time_ = point_cloud->header().timestamp_sec();
-  // Check if last filter process has finished before processing new data.
-  if (future_ready_) {
-    future_ready_ = false;
-    // transform from drivers::PointCloud to pcl::PointCloud
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-    pcl_ptr->width = point_cloud->width();
-    pcl_ptr->height = point_cloud->height();
-    pcl_ptr->is_dense = false;
-    pcl_ptr->points.resize(pcl_ptr->width * pcl_ptr->height);
-
-    if (pcl_ptr->width == 0 || pcl_ptr->height == 0) {
-      pcl_ptr->width = 1;
-      pcl_ptr->height = point_cloud->point_size();
-      pcl_ptr->points.resize(point_cloud->point_size());
-    }
-
-    for (size_t i = 0; i < pcl_ptr->points.size(); ++i) {
-      const auto& point = point_cloud->point(static_cast<int>(i));
-      pcl_ptr->points[i].x = point.x();
-      pcl_ptr->points[i].y = point.y();
-      pcl_ptr->points[i].z = point.z();
-    }
-    std::future<void> f =
-        cyber::Async(&PointCloudUpdater::FilterPointCloud,
-                         this, pcl_ptr);
-    async_future_ = std::move(f);
-  }
+  std::lock_guard<std::mutex> lock(cloud_mutex_);
+  point_cloud_ = point_cloud;
+  ++cloud_version_;
 }
 
-void PointCloudUpdater::FilterPointCloud(
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr) {
-  pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
-  voxel_grid.setInputCloud(pcl_ptr);
-  voxel_grid.setLeafSize(
-      static_cast<float>(FLAGS_voxel_filter_size),
-      static_cast<float>(FLAGS_voxel_filter_size),
-      static_cast<float>(FLAGS_voxel_filter_height));
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_filtered_ptr(
-    new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid.filter(*pcl_filtered_ptr);
-  AINFO << "filtered point cloud data size: " << pcl_filtered_ptr->size();
+std::string PointCloudUpdater::GetPointCloud(const Density density,
+                                             const bool quantized) {
+  std::lock_guard<std::mutex> encode_lock(encode_mutex_);
+  std::shared_ptr<drivers::PointCloud> point_cloud;
+  uint64_t cloud_version = 0;
+  {
+    std::lock_guard<std::mutex> lock(cloud_mutex_);
+    point_cloud = point_cloud_;
+    cloud_version = cloud_version_;
+  }
+
+  Encoded &encoded = encoded_[density][quantized ? 1 : 0];
+  if (encoded.cloud_version == cloud_version) {
+    return encoded.data;
+  }
+  encoded.cloud_version = cloud_version;
+  encoded.data.clear();
+  if (point_cloud == nullptr) {
+    return encoded.data;
+  }
 
   float z_offset;
   {
     boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
     z_offset = lidar_height_;
   }
+  const float scale = kVoxelScale[density];
   apollo::dreamview::PointCloud point_cloud_pb;
-  for (size_t idx = 0; idx < pcl_filtered_ptr->size(); ++idx) {
-    pcl::PointXYZ &pt = pcl_filtered_ptr->points[idx];
-    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
-      point_cloud_pb.add_num(pt.x);
-      point_cloud_pb.add_num(pt.y);
-      point_cloud_pb.add_num(pt.z + z_offset);
-    }
-  }
-  {
-    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    point_cloud_pb.SerializeToString(&point_cloud_str_);
-    future_ready_ = true;
-  }
+  downsampler_.Downsample(
+      *point_cloud, static_cast<float>(FLAGS_voxel_filter_size) * scale,
+      static_cast<float>(FLAGS_voxel_filter_height) * scale, z_offset,
+      quantized, &point_cloud_pb);
+  ADEBUG << "Downsampled point cloud of " << point_cloud->point_size()
+         << " points to " << point_cloud_pb.num_size() / 3 +
+                                 point_cloud_pb.quantized_point().size() / 6;
+  point_cloud_pb.SerializeToString(&encoded.data);
+  return encoded.data;
 }
 
 void PointCloudUpdater::UpdateLocalizationTime(
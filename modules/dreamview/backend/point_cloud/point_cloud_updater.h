@@ -20,7 +20,10 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "boost/thread/locks.hpp"
@@ -30,10 +33,9 @@
 #include "cyber/cyber.h"
 #include "modules/common/util/string_util.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/localization/proto/localization.pb.h"
-#include "pcl/point_cloud.h"
-#include "pcl/point_types.h"
 
 /**
  * @namespace apollo::dreamview
@@ -46,6 +48,10 @@ namespace dreamview {
  * @class PointCloudUpdater
  * @brief A wrapper around WebSocketHandler to keep pushing PointCloud to
  * frontend via websocket while handling the response from frontend.
+ *
+ * The reader only keeps the latest cloud. It is downsampled when a client
+ * requests it, at the density the client asks for, and the result is shared
+ * by the clients asking for the same until a newer cloud arrives.
  */
 class PointCloudUpdater {
  public:
@@ -68,17 +74,30 @@ class PointCloudUpdater {
   // The height of lidar w.r.t the ground.
   static float lidar_height_;
 
-  // Mutex to protect concurrent access to point_cloud_str_ and lidar_height_.
+  // Mutex to protect concurrent access to lidar_height_.
   // NOTE: Use boost until we have std version of rwlock support.
   static boost::shared_mutex mutex_;
 
  private:
+  // The voxel sizes of the densities are FLAGS_voxel_filter_size and
+  // FLAGS_voxel_filter_height times the scale.
+  enum Density { LOW = 0, MEDIUM, HIGH, NUM_DENSITIES };
+
+  struct Encoded {
+    uint64_t cloud_version = 0;
+    std::string data;
+  };
+
   void RegisterMessageHandlers();
 
   void UpdatePointCloud(
       const std::shared_ptr<drivers::PointCloud> &point_cloud);
 
-  void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
+  /**
+   * @brief Gets the latest cloud serialized for the frontend, downsampling
+   * it unless it has been at the same density before.
+   */
+  std::string GetPointCloud(const Density density, const bool quantized);
 
   void UpdateLocalizationTime(
       const std::shared_ptr<apollo::localization::LocalizationEstimate>
@@ -92,11 +111,17 @@ class PointCloudUpdater {
 
   bool enabled_ = false;
 
-  // The PointCloud to be pushed to frontend.
-  std::string point_cloud_str_;
-
-  std::future<void> async_future_;
-  std::atomic<bool> future_ready_;
+  // The latest cloud from the reader, and its version starting from 1.
+  std::mutex cloud_mutex_;
+  std::shared_ptr<drivers::PointCloud> point_cloud_;
+  uint64_t cloud_version_ = 0;
+
+  // Guards the downsampler and the encoded clouds, so that the clients
+  // requesting at once share a single downsampling.
+  std::mutex encode_mutex_;
+  PointCloudDownsampler downsampler_;
+  // by density, then float and quantized
+  std::array<std::array<Encoded, 2>, NUM_DENSITIES> encoded_;
 
   // Cyber messsage readers.
   std::shared_ptr<cyber::Reader<apollo::localization::LocalizationEstimate>>
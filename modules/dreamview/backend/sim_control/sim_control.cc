@@ -69,6 +69,8 @@ SimControl::SimControl(const MapService* map_service)
   InitTimerAndIO();
 }
 
+SimControl::~SimControl() { Stop(); }
+
 void SimControl::InitTimerAndIO() {
   localization_reader_ =
       node_->CreateReader<LocalizationEstimate>(FLAGS_localization_topic);
@@ -183,6 +185,7 @@ void SimControl::InternalReset() {
 
 void SimControl::ClearPlanning() {
   current_trajectory_->Clear();
+  trajectory_start_time_ = 0.0;
   received_planning_ = false;
 }
 
@@ -257,20 +260,79 @@ void SimControl::Start() {
          next_point_.has_a() ? next_point_.a() : 0.0);
 
     InternalReset();
-    sim_control_timer_->Start();
-    sim_prediction_timer_->Start();
     enabled_ = true;
+    if (FLAGS_sim_control_stepped) {
+      // Start the virtual clock from the current time, so that timestamps
+      // stay plausible for the other modules.
+      const double now = Clock::NowInSeconds();
+      clock_mode_ = Clock::mode();
+      Clock::SetMode(Clock::MOCK);
+      Clock::SetNowInSeconds(now);
+      step_thread_ = std::thread(&SimControl::RunSteps, this);
+    } else {
+      sim_control_timer_->Start();
+      sim_prediction_timer_->Start();
+    }
   }
 }
 
 void SimControl::Stop() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (enabled_) {
-    sim_control_timer_->Stop();
-    sim_prediction_timer_->Stop();
+  std::thread step_thread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+      return;
+    }
+    if (step_thread_.joinable()) {
+      step_thread = std::move(step_thread_);
+    } else {
+      sim_control_timer_->Stop();
+      sim_prediction_timer_->Stop();
+    }
     enabled_ = false;
   }
+  planning_cv_.notify_all();
+
+  // The stepping thread takes the mutex, so join it outside.
+  if (step_thread.joinable()) {
+    step_thread.join();
+    Clock::SetMode(clock_mode_);
+  }
+}
+
+void SimControl::RunSteps() {
+  static constexpr int kNumStepsPerCycle =
+      static_cast<int>(kSimPredictionIntervalMs / kSimControlIntervalMs);
+  while (true) {
+    uint64_t num_planning_received = 0;
+    for (int i = 0; i < kNumStepsPerCycle; ++i) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_) {
+          return;
+        }
+        if (i == 0) {
+          num_planning_received = num_planning_received_;
+        }
+        Clock::SetNowInSeconds(Clock::NowInSeconds() +
+                               kSimControlIntervalMs / 1000.0);
+      }
+      RunOnce();
+    }
+    PublishDummyPrediction();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (FLAGS_sim_control_step_timeout_ms > 0) {
+      planning_cv_.wait_for(
+          lock, std::chrono::milliseconds(FLAGS_sim_control_step_timeout_ms),
+          [this, num_planning_received]() {
+            return !enabled_ || num_planning_received_ > num_planning_received;
+          });
+    }
+    if (!enabled_) {
+      return;
+    }
+  }
 }
 
 void SimControl::OnPlanning(const std::shared_ptr<ADCTrajectory>& trajectory) {
@@ -280,11 +342,18 @@ void SimControl::OnPlanning(const std::shared_ptr<ADCTrajectory>& trajectory) {
     return;
   }
 
+  // Any answer lets the stepping thread go on.
+  ++num_planning_received_;
+  planning_cv_.notify_all();
+
   // Reset current trajectory and the indices upon receiving a new trajectory.
   // The routing SimControl owns must match with the one Planning has.
   if (re_routing_triggered_ ||
       IsSameHeader(trajectory->routing_header(), current_routing_header_)) {
     current_trajectory_ = trajectory;
+    trajectory_start_time_ = FLAGS_sim_control_stepped
+                                 ? Clock::NowInSeconds()
+                                 : trajectory->header().timestamp_sec();
     prev_point_index_ = 0;
     next_point_index_ = 0;
     received_planning_ = true;
@@ -332,7 +401,7 @@ bool SimControl::PerfectControlModel(TrajectoryPoint* point,
       // Determine the status of the car based on received planning message.
       while (next_point_index_ < trajectory.size() &&
              current_time > trajectory.Get(next_point_index_).relative_time() +
-                                current_trajectory_->header().timestamp_sec()) {
+                                trajectory_start_time_) {
         ++next_point_index_;
       }
 
@@ -352,14 +421,13 @@ bool SimControl::PerfectControlModel(TrajectoryPoint* point,
     }
   }
 
-  if (current_time > next_point_.relative_time() +
-                         current_trajectory_->header().timestamp_sec()) {
+  if (current_time > next_point_.relative_time() + trajectory_start_time_) {
     // Don't try to extrapolate if relative_time passes last point
     *point = next_point_;
   } else {
     *point = InterpolateUsingLinearApproximation(
         prev_point_, next_point_,
-        current_time - current_trajectory_->header().timestamp_sec());
+        current_time - trajectory_start_time_);
   }
   return true;
 }
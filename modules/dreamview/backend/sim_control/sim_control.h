@@ -20,12 +20,15 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <thread>
 
 #include "cyber/cyber.h"
 
 #include "gtest/gtest_prod.h"
 
+#include "modules/common/time/time.h"
 #include "modules/localization/proto/localization.pb.h"
 #include "modules/map/relative_map/proto/navigation.pb.h"
 #include "modules/planning/proto/planning.pb.h"
@@ -56,6 +59,8 @@ class SimControl : SimControlInterface {
    */
   explicit SimControl(const MapService *map_service);
 
+  ~SimControl();
+
   bool IsEnabled() const { return enabled_; }
 
   /**
@@ -67,12 +72,13 @@ class SimControl : SimControlInterface {
 
   /**
    * @brief Starts the timer to publish simulated localization and chassis
-   * messages.
+   * messages. With --sim_control_stepped, starts a thread stepping a virtual
+   * clock instead, see RunSteps().
    */
   void Start() override;
 
   /**
-   * @brief Stops the timer.
+   * @brief Stops the timer, or the stepping thread.
    */
   void Stop() override;
 
@@ -111,6 +117,15 @@ class SimControl : SimControlInterface {
 
   void InitTimerAndIO();
 
+  /**
+   * @brief The loop of the stepping thread. Each cycle advances the virtual
+   * clock by one prediction interval, publishing localization and chassis at
+   * every control interval of it, then waits for planning to answer, up to
+   * --sim_control_step_timeout_ms in real time. The simulation thus runs as
+   * fast as planning does, and no slower than real time on timeouts.
+   */
+  void RunSteps();
+
   void InitStartPoint(double start_velocity, double start_acceleration);
 
   // Reset the start point, which can be a dummy point on the map, a current
@@ -154,8 +169,22 @@ class SimControl : SimControlInterface {
   static constexpr double kSimControlIntervalMs = 10;
   static constexpr double kSimPredictionIntervalMs = 100;
 
+  // The thread stepping the virtual clock, when running stepped.
+  std::thread step_thread_;
+  // The clock mode to restore when the stepping stops.
+  apollo::common::time::Clock::ClockMode clock_mode_ =
+      apollo::common::time::Clock::SYSTEM;
+  // Notified upon planning trajectories and stops, for the stepping thread.
+  std::condition_variable planning_cv_;
+  // The number of planning trajectories received while enabled.
+  uint64_t num_planning_received_ = 0;
+
   // The latest received planning trajectory.
   std::shared_ptr<apollo::planning::ADCTrajectory> current_trajectory_;
+  // The time the relative times of current_trajectory_ count from. It is the
+  // header timestamp, or the virtual time of arrival when running stepped, as
+  // planning stamps trajectories with its own clock.
+  double trajectory_start_time_ = 0.0;
   // The index of the previous and next point with regard to the
   // current_trajectory.
   int prev_point_index_ = 0;
@@ -189,6 +218,7 @@ class SimControl : SimControlInterface {
 
   FRIEND_TEST(SimControlTest, Test);
   FRIEND_TEST(SimControlTest, TestDummyPrediction);
+  FRIEND_TEST(SimControlTest, TestSteppedWaitsForPlanning);
 };
 
 }  // namespace dreamview
@@ -16,6 +16,9 @@
 
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 
+#include <chrono>
+#include <thread>
+
 #include "cyber/blocker/blocker_manager.h"
 
 #include "gmock/gmock.h"
@@ -211,5 +214,44 @@ TEST_F(SimControlTest, TestDummyPrediction) {
     EXPECT_DOUBLE_EQ(prediction->header().timestamp_sec(), timestamp);
   }
 }
+
+TEST_F(SimControlTest, TestSteppedRunsFasterThanRealTime) {
+  FLAGS_sim_control_stepped = true;
+  FLAGS_sim_control_step_timeout_ms = 0;
+  Clock::SetMode(Clock::SYSTEM);
+
+  const double start_time = Clock::NowInSeconds();
+  sim_control_->Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const double virtual_time = Clock::NowInSeconds();
+  sim_control_->Stop();
+
+  // Not waiting for planning, 100ms takes well over a second of simulation.
+  EXPECT_GT(virtual_time - start_time, 1.0);
+  EXPECT_EQ(Clock::SYSTEM, Clock::mode());
+  FLAGS_sim_control_stepped = false;
+}
+
+TEST_F(SimControlTest, TestSteppedWaitsForPlanning) {
+  FLAGS_sim_control_stepped = true;
+  FLAGS_sim_control_step_timeout_ms = 60000;
+  Clock::SetMode(Clock::SYSTEM);
+
+  const double start_time = Clock::NowInSeconds();
+  sim_control_->Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // one cycle, then waiting
+  EXPECT_NEAR(Clock::NowInSeconds() - start_time, 0.1, 0.01);
+
+  sim_control_->OnPlanning(std::make_shared<ADCTrajectory>());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_NEAR(Clock::NowInSeconds() - start_time, 0.2, 0.01);
+
+  // stopping does not wait for the timeout
+  sim_control_->Stop();
+  EXPECT_EQ(Clock::SYSTEM, Clock::mode());
+  FLAGS_sim_control_stepped = false;
+  FLAGS_sim_control_step_timeout_ms = 1000;
+}
 }  // namespace dreamview
 }  // namespace apollo
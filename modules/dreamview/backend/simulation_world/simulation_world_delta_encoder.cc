@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <cmath>
+#include <functional>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::RepeatedPtrField;
+
+namespace {
+
+// Steps finer than the frontend renders.
+constexpr double kPositionStep = 0.01;
+constexpr double kAngleStep = 0.001;
+constexpr double kSpeedStep = 0.01;
+
+double Quantize(const double value, const double step) {
+  return std::round(value / step) * step;
+}
+
+void QuantizePoints(RepeatedPtrField<PolygonPoint> *points) {
+  for (auto &point : *points) {
+    point.set_x(Quantize(point.x(), kPositionStep));
+    point.set_y(Quantize(point.y(), kPositionStep));
+    if (point.has_z()) {
+      point.set_z(Quantize(point.z(), kPositionStep));
+    }
+  }
+}
+
+void QuantizeObject(Object *object) {
+  if (object->has_position_x()) {
+    object->set_position_x(Quantize(object->position_x(), kPositionStep));
+  }
+  if (object->has_position_y()) {
+    object->set_position_y(Quantize(object->position_y(), kPositionStep));
+  }
+  if (object->has_heading()) {
+    object->set_heading(Quantize(object->heading(), kAngleStep));
+  }
+  if (object->has_speed_heading()) {
+    object->set_speed_heading(Quantize(object->speed_heading(), kAngleStep));
+  }
+  if (object->has_speed()) {
+    object->set_speed(Quantize(object->speed(), kSpeedStep));
+  }
+  QuantizePoints(object->mutable_polygon_point());
+  for (auto &prediction : *object->mutable_prediction()) {
+    QuantizePoints(prediction.mutable_predicted_trajectory());
+  }
+}
+
+// Appends the object, serialized, as the object field of a SimulationWorld.
+void AppendObjectField(const std::string &object, std::string *output) {
+  // a length delimited field
+  constexpr uint32_t kWireType = 2;
+  google::protobuf::io::StringOutputStream stream(output);
+  google::protobuf::io::CodedOutputStream coded(&stream);
+  coded.WriteTag((SimulationWorld::kObjectFieldNumber << 3) | kWireType);
+  coded.WriteVarint32(static_cast<uint32_t>(object.size()));
+  coded.WriteRaw(object.data(), static_cast<int>(object.size()));
+}
+
+}  // namespace
+
+SimulationWorldDeltaEncoder::SimulationWorldDeltaEncoder(
+    const size_t history_size)
+    : history_size_(history_size) {}
+
+void SimulationWorldDeltaEncoder::AddFrame(SimulationWorld *world) {
+  if (!history_.empty() &&
+      world->sequence_num() <= history_.back().sequence_num) {
+    history_.clear();
+  }
+  if (history_.size() == history_size_ + 1) {
+    history_.pop_front();
+  }
+  history_.emplace_back();
+  Frame &frame = history_.back();
+  frame.sequence_num = world->sequence_num();
+
+  objects_.clear();
+  objects_.reserve(world->object_size());
+  std::string bytes;
+  for (auto &object : *world->mutable_object()) {
+    QuantizeObject(&object);
+
+    // The timestamp changes with every perception message, even for the
+    // objects standing still.
+    const bool has_timestamp = object.has_timestamp_sec();
+    const double timestamp = object.timestamp_sec();
+    object.clear_timestamp_sec();
+    object.SerializeToString(&bytes);
+    frame.object_hashes[object.id()] = std::hash<std::string>()(bytes);
+    if (has_timestamp) {
+      object.set_timestamp_sec(timestamp);
+      Object timestamp_only;
+      timestamp_only.set_timestamp_sec(timestamp);
+      timestamp_only.AppendToString(&bytes);
+    }
+
+    objects_.emplace_back(object.id(), std::string());
+    AppendObjectField(bytes, &objects_.back().second);
+  }
+
+  // Serialize the rest without copying the objects and the planning data.
+  RepeatedPtrField<Object> objects;
+  objects.Swap(world->mutable_object());
+  const bool has_planning_data = world->has_planning_data();
+  SimulationWorld planning_data;
+  if (has_planning_data) {
+    planning_data.mutable_planning_data()->Swap(
+        world->mutable_planning_data());
+    world->clear_planning_data();
+  }
+  world->SerializeToString(&header_);
+  planning_data.SerializeToString(&planning_data_);
+  objects.Swap(world->mutable_object());
+  if (has_planning_data) {
+    world->mutable_planning_data()->Swap(
+        planning_data.mutable_planning_data());
+  }
+}
+
+bool SimulationWorldDeltaEncoder::GetDelta(const uint32_t base_sequence_num,
+                                           const bool with_planning_data,
+                                           std::string *delta) const {
+  if (history_.empty()) {
+    return false;
+  }
+  const Frame *base = nullptr;
+  for (const auto &frame : history_) {
+    if (frame.sequence_num == base_sequence_num) {
+      base = &frame;
+      break;
+    }
+  }
+  if (base == nullptr) {
+    return false;
+  }
+
+  const Frame &latest = history_.back();
+  SimulationWorld trailer;
+  trailer.set_delta_base_sequence_num(base_sequence_num);
+  for (const auto &entry : base->object_hashes) {
+    if (latest.object_hashes.count(entry.first) == 0) {
+      trailer.add_removed_object_id(entry.first);
+    }
+  }
+
+  *delta = header_;
+  for (const auto &object : objects_) {
+    auto iter = base->object_hashes.find(object.first);
+    if (iter == base->object_hashes.end() ||
+        iter->second != latest.object_hashes.at(object.first)) {
+      delta->append(object.second);
+    }
+  }
+  trailer.AppendToString(delta);
+  if (with_planning_data) {
+    delta->append(planning_data_);
+  }
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
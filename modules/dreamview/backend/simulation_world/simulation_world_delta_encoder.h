@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldDeltaEncoder
+ * @brief Encodes the latest SimulationWorld as a delta against one of the
+ * few before it, so that a client which has that one only receives the
+ * objects which changed. The coordinates of the objects are quantized first,
+ * so that noise below what the frontend renders does not count as a change.
+ *
+ * A delta is assembled from pieces serialized once per frame, and costs
+ * about a memory copy per client. A client whose world is too old, or a new
+ * one, gets the full world instead, which becomes its base for the next
+ * delta.
+ */
+class SimulationWorldDeltaEncoder {
+ public:
+  static constexpr size_t kDefaultHistorySize = 10;
+
+  explicit SimulationWorldDeltaEncoder(
+      const size_t history_size = kDefaultHistorySize);
+
+  /**
+   * @brief Quantizes the objects of the world, then takes it as the latest
+   * frame. A sequence number which does not increase, e.g. after the world
+   * is reset, drops the former frames.
+   * @param world the world about to be serialized in full.
+   */
+  void AddFrame(SimulationWorld *world);
+
+  /**
+   * @brief Serializes the latest frame as a delta against the one with the
+   * given sequence number.
+   * @return False if the base frame is not known.
+   */
+  bool GetDelta(const uint32_t base_sequence_num, const bool with_planning_data,
+                std::string *delta) const;
+
+ private:
+  struct Frame {
+    uint32_t sequence_num = 0;
+    // hash of each object, timestamp aside
+    std::unordered_map<std::string, size_t> object_hashes;
+  };
+
+  const size_t history_size_;
+  // the latest frame at the back
+  std::deque<Frame> history_;
+
+  // The latest frame in wire format: all the fields but the objects and the
+  // planning data, each object as a field of SimulationWorld, and the
+  // planning data as a SimulationWorld of its own. Any concatenation of
+  // them parses as a SimulationWorld.
+  std::string header_;
+  std::vector<std::pair<std::string, std::string>> objects_;
+  std::string planning_data_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+void AddObject(const std::string &id, double x, double timestamp_sec,
+               SimulationWorld *world) {
+  Object *object = world->add_object();
+  object->set_id(id);
+  object->set_position_x(x);
+  object->set_position_y(1.0);
+  object->set_timestamp_sec(timestamp_sec);
+}
+
+SimulationWorld ParseDelta(const SimulationWorldDeltaEncoder &encoder,
+                           uint32_t base_sequence_num,
+                           bool with_planning_data = false) {
+  std::string delta;
+  SimulationWorld world;
+  EXPECT_TRUE(
+      encoder.GetDelta(base_sequence_num, with_planning_data, &delta));
+  EXPECT_TRUE(world.ParseFromString(delta));
+  return world;
+}
+
+}  // namespace
+
+TEST(SimulationWorldDeltaEncoderTest, SendsChangedObjects) {
+  SimulationWorldDeltaEncoder encoder;
+  std::string delta;
+  EXPECT_FALSE(encoder.GetDelta(1, false, &delta));
+
+  SimulationWorld world;
+  world.set_sequence_num(1);
+  AddObject("moving", 0.0, 1.0, &world);
+  AddObject("standing", 10.0, 1.0, &world);
+  AddObject("leaving", 20.0, 1.0, &world);
+  encoder.AddFrame(&world);
+  EXPECT_FALSE(encoder.GetDelta(0, false, &delta));
+
+  world.Clear();
+  world.set_sequence_num(2);
+  world.set_speed_limit(10.0);
+  AddObject("moving", 1.0, 2.0, &world);
+  // below the quantization step
+  AddObject("standing", 10.001, 2.0, &world);
+  AddObject("coming", 30.0, 2.0, &world);
+  encoder.AddFrame(&world);
+  EXPECT_DOUBLE_EQ(10.0, world.object(1).position_x());
+
+  const SimulationWorld update = ParseDelta(encoder, 1);
+  EXPECT_EQ(2, update.sequence_num());
+  EXPECT_EQ(1, update.delta_base_sequence_num());
+  EXPECT_DOUBLE_EQ(10.0, update.speed_limit());
+  ASSERT_EQ(2, update.object_size());
+  EXPECT_EQ("moving", update.object(0).id());
+  EXPECT_DOUBLE_EQ(1.0, update.object(0).position_x());
+  EXPECT_DOUBLE_EQ(2.0, update.object(0).timestamp_sec());
+  EXPECT_EQ("coming", update.object(1).id());
+  ASSERT_EQ(1, update.removed_object_id_size());
+  EXPECT_EQ("leaving", update.removed_object_id(0));
+
+  // nothing changed since the latest frame
+  const SimulationWorld same = ParseDelta(encoder, 2);
+  EXPECT_EQ(0, same.object_size());
+  EXPECT_EQ(0, same.removed_object_id_size());
+}
+
+TEST(SimulationWorldDeltaEncoderTest, KeepsPlanningData) {
+  SimulationWorldDeltaEncoder encoder;
+  SimulationWorld world;
+  world.set_sequence_num(1);
+  encoder.AddFrame(&world);
+
+  world.set_sequence_num(2);
+  AddObject("object", 0.0, 1.0, &world);
+  world.mutable_planning_data()->mutable_init_point()->set_relative_time(
+      1.0);
+  encoder.AddFrame(&world);
+  // the world is left as it was
+  EXPECT_TRUE(world.has_planning_data());
+  EXPECT_EQ(1, world.object_size());
+
+  EXPECT_FALSE(ParseDelta(encoder, 1).has_planning_data());
+  const SimulationWorld update = ParseDelta(encoder, 1, true);
+  EXPECT_TRUE(update.has_planning_data());
+  EXPECT_EQ(1, update.object_size());
+}
+
+TEST(SimulationWorldDeltaEncoderTest, ForgetsOldFrames) {
+  SimulationWorldDeltaEncoder encoder(2);
+  SimulationWorld world;
+  for (uint32_t i = 1; i <= 4; ++i) {
+    world.set_sequence_num(i);
+    encoder.AddFrame(&world);
+  }
+  std::string delta;
+  EXPECT_FALSE(encoder.GetDelta(1, false, &delta));
+  EXPECT_TRUE(encoder.GetDelta(2, false, &delta));
+
+  // reset
+  world.set_sequence_num(1);
+  encoder.AddFrame(&world);
+  EXPECT_FALSE(encoder.GetDelta(2, false, &delta));
+  EXPECT_TRUE(encoder.GetDelta(1, false, &delta));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -22,6 +22,7 @@
 #include "modules/canbus/proto/chassis.pb.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/fast_math.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/common/proto/vehicle_signal.pb.h"
@@ -45,6 +46,7 @@ using apollo::common::Point3D;
 using apollo::common::PointENU;
 using apollo::common::TrajectoryPoint;
 using apollo::common::VehicleConfigHelper;
+using apollo::common::math::RelaxedAtan2;
 using apollo::common::monitor::MonitorMessage;
 using apollo::common::monitor::MonitorMessageItem;
 using apollo::common::time::Clock;
@@ -383,6 +385,7 @@ void SimulationWorldService::GetWireFormatString(
     double radius, std::string *sim_world,
     std::string *sim_world_with_planning_data) {
   PopulateMapInfo(radius);
+  delta_encoder_.AddFrame(&world_);
 
   world_.SerializeToString(sim_world_with_planning_data);
 
@@ -413,9 +416,28 @@ void SimulationWorldService::GetMapElementIds(double radius,
 }
 
 void SimulationWorldService::PopulateMapInfo(double radius) {
+  apollo::common::PointENU point;
+  const auto &adc = world_.auto_driving_car();
+  point.set_x(adc.position_x());
+  point.set_y(adc.position_y());
+  std::vector<std::string> tile_ids;
+  map_service_->CollectMapTileIds(point, radius, &tile_ids);
+  const size_t map_hash = map_service_->CalculateMapHash(tile_ids);
+  // The elements only change with the tiles, which the car stays in for a
+  // while.
+  if (world_.has_map_hash() && world_.map_hash() == map_hash &&
+      world_.map_radius() == radius) {
+    return;
+  }
+
   world_.clear_map_element_ids();
-  GetMapElementIds(radius, world_.mutable_map_element_ids());
-  world_.set_map_hash(map_service_->CalculateMapHash(world_.map_element_ids()));
+  map_service_->CollectMapElementIdsInTiles(tile_ids,
+                                            world_.mutable_map_element_ids());
+  world_.clear_map_tile_id();
+  for (auto &tile_id : tile_ids) {
+    world_.add_map_tile_id(std::move(tile_id));
+  }
+  world_.set_map_hash(map_hash);
   world_.set_map_radius(radius);
 }
 
@@ -530,7 +552,7 @@ void SimulationWorldService::SetObstacleInfo(const PerceptionObstacle &obstacle,
   world_object->set_speed(
       std::hypot(obstacle.velocity().x(), obstacle.velocity().y()));
   world_object->set_speed_heading(
-      std::atan2(obstacle.velocity().y(), obstacle.velocity().x()));
+      RelaxedAtan2(obstacle.velocity().y(), obstacle.velocity().x()));
   world_object->set_timestamp_sec(obstacle.timestamp());
   world_object->set_confidence(obstacle.has_confidence() ? obstacle.confidence()
                                                          : 1);
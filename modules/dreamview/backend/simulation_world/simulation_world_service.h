@@ -35,6 +35,7 @@
 #include "third_party/json/json.hpp"
 
 #include "modules/dreamview/backend/map/map_service.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
 #include "modules/dreamview/proto/simulation_world.pb.h"
 
 #include "modules/common/monitor_log/monitor_log_buffer.h"
@@ -101,6 +102,23 @@ class SimulationWorldService {
   void GetWireFormatString(double radius, std::string *sim_world,
                            std::string *sim_world_with_planning_data);
 
+  /**
+   * @brief Returns the binary representation of the SimulationWorld object
+   * last taken by GetWireFormatString(), as a delta against the one with the
+   * given sequence number.
+   * @param base_sequence_num sequence number of the world the client has.
+   * @param with_planning_data whether to include the planning_data.
+   * @param delta output of binary format delta sim_world string.
+   * @return False if the base world is too old, in which case the full
+   * world has to be sent.
+   */
+  bool GetDeltaWireFormatString(uint32_t base_sequence_num,
+                                bool with_planning_data,
+                                std::string *delta) const {
+    return delta_encoder_.GetDelta(base_sequence_num, with_planning_data,
+                                   delta);
+  }
+
   /**
    * @brief Returns the json representation of the map element Ids and hash
    * within the given radius from the car.
@@ -316,6 +334,9 @@ class SimulationWorldService {
   // The map holding obstacle string id to the actual object
   std::unordered_map<std::string, Object> obj_map_;
 
+  // Encodes the world in wire format as deltas for the clients.
+  SimulationWorldDeltaEncoder delta_encoder_;
+
   // A temporary cache for all the monitor messages coming in.
   std::mutex monitor_msgs_mutex_;
   std::list<std::shared_ptr<common::monitor::MonitorMessage>> monitor_msgs_;
@@ -78,6 +78,33 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         }
       });
 
+  map_ws_->RegisterMessageHandler(
+      "RetrieveMapTiles",
+      [this](const Json &json, WebSocketHandler::Connection *conn) {
+        auto tiles = json.find("tiles");
+        if (tiles == json.end() || !tiles->is_array()) {
+          AERROR << "No map tiles to retrieve";
+          return;
+        }
+        std::vector<std::string> tile_ids;
+        for (const auto &tile : *tiles) {
+          if (tile.is_string()) {
+            tile_ids.push_back(tile);
+          }
+        }
+        auto level = json.find("level");
+        const int detail_level =
+            level != json.end() && level->is_number_integer() ? *level : 0;
+
+        std::string to_send;
+        if (map_service_->RetrieveMapTiles(tile_ids, detail_level,
+                                           &to_send)) {
+          map_ws_->SendBinaryData(conn, to_send, true);
+        } else {
+          AERROR << "Failed to retrieve map tiles at level " << detail_level;
+        }
+      });
+
   map_ws_->RegisterMessageHandler(
       "RetrieveRelativeMapData",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
@@ -168,13 +195,29 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
+        // The sequence number of the world the client has, if it takes
+        // deltas.
+        auto delta_base = json.find("deltaBase");
+        const bool take_delta =
+            delta_base != json.end() && delta_base->is_number_unsigned();
+        const uint32_t base_sequence_num =
+            take_delta ? delta_base->get<uint32_t>() : 0;
         std::string to_send;
         {
           // Pay the price to copy the data instead of sending data over the
           // wire while holding the lock.
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = enable_pnc_monitor ? simulation_world_with_planning_data_
-                                       : simulation_world_;
+          if (take_delta && base_sequence_num == sequence_num_) {
+            // The client polls faster than the world updates.
+            return;
+          }
+          if (!take_delta ||
+              !GetSimulationWorldDelta(base_sequence_num,
+                                       enable_pnc_monitor, &to_send)) {
+            to_send = enable_pnc_monitor
+                          ? simulation_world_with_planning_data_
+                          : simulation_world_;
+          }
         }
         if (FLAGS_enable_update_size_check && !enable_pnc_monitor &&
             to_send.size() > FLAGS_max_update_size) {
@@ -378,11 +421,34 @@ void SimulationWorldUpdater::OnTimer() {
     sim_world_service_.GetWireFormatString(
         FLAGS_sim_map_radius, &simulation_world_,
         &simulation_world_with_planning_data_);
+    sequence_num_ = sim_world_service_.world().sequence_num();
+    {
+      std::lock_guard<std::mutex> lock(delta_mutex_);
+      deltas_.clear();
+    }
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
 }
 
+bool SimulationWorldUpdater::GetSimulationWorldDelta(
+    uint32_t base_sequence_num, bool with_planning_data, std::string *delta) {
+  const uint64_t key =
+      (static_cast<uint64_t>(base_sequence_num) << 1) | with_planning_data;
+  std::lock_guard<std::mutex> lock(delta_mutex_);
+  auto iter = deltas_.find(key);
+  if (iter == deltas_.end()) {
+    std::string encoded;
+    if (!sim_world_service_.GetDeltaWireFormatString(
+            base_sequence_num, with_planning_data, &encoded)) {
+      return false;
+    }
+    iter = deltas_.emplace(key, std::move(encoded)).first;
+  }
+  *delta = iter->second;
+  return true;
+}
+
 bool SimulationWorldUpdater::LoadPOI() {
   if (GetProtoFromASCIIFile(EndWayPointFile(), &poi_)) {
     return true;
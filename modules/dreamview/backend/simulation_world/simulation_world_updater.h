@@ -21,7 +21,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
@@ -129,6 +131,15 @@ class SimulationWorldUpdater {
 
   void RegisterMessageHandlers();
 
+  /**
+   * @brief Gets the latest simulation world in wire format as a delta
+   * against the one the client has, serializing it only for the first client
+   * with that base. Must be called with mutex_ held.
+   * @return False if the full world has to be sent instead.
+   */
+  bool GetSimulationWorldDelta(uint32_t base_sequence_num,
+                               bool with_planning_data, std::string *delta);
+
   std::unique_ptr<cyber::Timer> timer_;
 
   SimulationWorldService sim_world_service_;
@@ -144,6 +155,12 @@ class SimulationWorldUpdater {
   // updated by timer.
   std::string simulation_world_;
   std::string simulation_world_with_planning_data_;
+  uint32_t sequence_num_ = 0;
+
+  // Deltas of the latest simulation world, keyed by their base sequence
+  // number and whether they carry the planning data.
+  std::mutex delta_mutex_;
+  std::unordered_map<uint64_t, std::string> deltas_;
 
   // Received relative map data in wire format.
   std::string relative_map_string_;
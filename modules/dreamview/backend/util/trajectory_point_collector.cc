@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/util/trajectory_point_collector.h"
 
+#include "modules/common/math/fast_math.h"
+
 using apollo::common::TrajectoryPoint;
 
 namespace apollo {
@@ -33,8 +35,9 @@ void TrajectoryPointCollector::Collect(const TrajectoryPoint &point,
     trajectory_point->set_speed_acceleration(previous_.a());
     trajectory_point->set_kappa(previous_.path_point().kappa());
     trajectory_point->set_heading(
-        std::atan2(point.path_point().y() - previous_.path_point().y(),
-                   point.path_point().x() - previous_.path_point().x()));
+        common::math::RelaxedAtan2(
+            point.path_point().y() - previous_.path_point().y(),
+            point.path_point().x() - previous_.path_point().x()));
   }
   previous_ = point;
   has_previous_ = true;
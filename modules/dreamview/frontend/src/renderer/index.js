@@ -392,10 +392,10 @@ class Renderer {
         this.pointCloud.update(pointCloud, this.adc.mesh);
     }
 
-    updateMapIndex(hash, elementIds, radius) {
+    updateMapIndex(hash, elementIds, radius, tileIds) {
         if (!this.routingEditor.isInEditingMode() ||
             PARAMETERS.routingEditor.radiusOfMapRequest === radius) {
-            this.map.updateIndex(hash, elementIds, this.scene);
+            this.map.updateIndex(hash, elementIds, this.scene, tileIds);
         }
     }
 
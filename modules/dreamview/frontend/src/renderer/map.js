@@ -50,6 +50,10 @@ export default class Map {
         this.data = {};
         this.initialized = false;
         this.elementKindsDrawn = '';
+        // The map tiles requested from the server, if it serves tiles.
+        this.tileIds = new Set();
+        // The level of detail of the tiles, from 0, the finest, to 2.
+        this.tileLevel = 0;
     }
 
     // The result will be the all the elements in current but not in data.
@@ -418,6 +422,17 @@ export default class Map {
                 this.data[kind] = [];
             }
 
+            // Map tiles come with all the kinds, and may hold elements which
+            // were drawn already.
+            if (Array.isArray(newData[kind])) {
+                if (!this.shouldDrawThisElementKind(kind)) {
+                    continue;
+                }
+                const drawnIds = new Set(this.data[kind].map(element => element.id.id));
+                newData[kind] = newData[kind].filter(
+                    element => !drawnIds.has(element.id.id));
+            }
+
             for (let i = 0; i < newData[kind].length; ++i) {
                 switch (kind) {
                     case "lane":
@@ -496,7 +511,7 @@ export default class Map {
         return STORE.options[optionName] !== false;
     }
 
-    updateIndex(hash, elementIds, scene) {
+    updateIndex(hash, elementIds, scene, tileIds) {
         if (STORE.hmi.inNavigationMode) {
             MAP_WS.requestRelativeMapData();
         } else {
@@ -509,15 +524,30 @@ export default class Map {
 
             if (hash !== this.hash || this.elementKindsDrawn !== newElementKindsDrawn) {
                 this.hash = hash;
+                const kindsChanged = this.elementKindsDrawn !== newElementKindsDrawn;
                 this.elementKindsDrawn = newElementKindsDrawn;
                 const diff = this.diffMapElements(elementIds, this.data);
                 this.removeExpiredElements(elementIds, scene);
-                if (!_.isEmpty(diff) || !this.initialized) {
+                if (tileIds && tileIds.length > 0) {
+                    this.requestMapTiles(tileIds, diff, kindsChanged);
+                } else if (!_.isEmpty(diff) || !this.initialized) {
                     MAP_WS.requestMapData(diff);
                     this.initialized = true;
                 }
             }
         }
     }
+
+    // Requests the tiles which are new, or all of them when other kinds of
+    // elements are to be drawn, instead of the missing elements one by one.
+    requestMapTiles(tileIds, diff, kindsChanged) {
+        const newTileIds = kindsChanged ?
+            tileIds : tileIds.filter(id => !this.tileIds.has(id));
+        this.tileIds = new Set(tileIds);
+        if ((!_.isEmpty(diff) || !this.initialized) && newTileIds.length > 0) {
+            MAP_WS.requestMapTiles(newTileIds, this.tileLevel);
+            this.initialized = true;
+        }
+    }
 }
 
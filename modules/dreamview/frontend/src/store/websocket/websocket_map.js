@@ -47,6 +47,14 @@ export default class MapDataWebSocketEndpoint {
         }));
     }
 
+    requestMapTiles(tiles, level) {
+        this.websocket.send(JSON.stringify({
+            type: "RetrieveMapTiles",
+            tiles: tiles,
+            level: level,
+        }));
+    }
+
     requestRelativeMapData(elements) {
         this.websocket.send(JSON.stringify({
             type: "RetrieveRelativeMapData",
@@ -7,6 +7,8 @@ export default class PointCloudWebSocketEndpoint {
         this.serverAddr = serverAddr;
         this.websocket = null;
         this.worker = new Worker();
+        // One of "LOW", "MEDIUM" and "HIGH".
+        this.density = "MEDIUM";
     }
 
     initialize() {
@@ -46,12 +48,18 @@ export default class PointCloudWebSocketEndpoint {
             if (this.websocket.readyState === this.websocket.OPEN
                 && STORE.options.showPointCloud === true) {
                 this.websocket.send(JSON.stringify({
-                    type : "RequestPointCloud"
+                    type : "RequestPointCloud",
+                    density: this.density,
+                    quantized: true,
                 }));
             }
         }, 200);
     }
 
+    setDensity(density) {
+        this.density = density;
+    }
+
     togglePointCloud(enable) {
         this.websocket.send(JSON.stringify({
             type: "TogglePointCloud",
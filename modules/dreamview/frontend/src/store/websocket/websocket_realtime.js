@@ -15,10 +15,16 @@ export default class RealtimeWebSocketEndpoint {
         this.updatePOI = true;
         this.routingTime = undefined;
         this.currentMode = null;
+        // The objects of the latest simulation world by id, which the next
+        // delta update is applied to.
+        this.worldObjects = null;
+        this.worldSeqNum = undefined;
         this.worker = new Worker();
     }
 
     initialize() {
+        // A new connection starts over with a full simulation world.
+        this.worldSeqNum = undefined;
         try {
             this.websocket = new WebSocket(this.serverAddr);
             this.websocket.binaryType = "arraybuffer";
@@ -49,6 +55,9 @@ export default class RealtimeWebSocketEndpoint {
                     STORE.setOptionStatus('enableSimControl', message.enabled);
                     break;
                 case "SimWorldUpdate":
+                    if (!this.applyDelta(message)) {
+                        break;
+                    }
                     this.checkMessage(message);
 
                     const updateCoordination = (this.currentMode !== STORE.hmi.currentMode);
@@ -134,6 +143,7 @@ export default class RealtimeWebSocketEndpoint {
                 this.websocket.send(JSON.stringify({
                     type : "RequestSimulationWorld",
                     planning : requestPlanningData,
+                    deltaBase : this.worldSeqNum,
                 }));
             }
         }, this.simWorldUpdatePeriodMs);
@@ -143,11 +153,31 @@ export default class RealtimeWebSocketEndpoint {
         const now = new Date();
         const duration = now - this.mapLastUpdateTimestamp;
         if (message.mapHash && duration >= this.mapUpdatePeriodMs) {
-            RENDERER.updateMapIndex(message.mapHash, message.mapElementIds, message.mapRadius);
+            RENDERER.updateMapIndex(message.mapHash, message.mapElementIds,
+                message.mapRadius, message.mapTileId);
             this.mapLastUpdateTimestamp = now;
         }
     }
 
+    // Completes the objects of a delta update with the ones of the world it
+    // is based on. Returns false if that is not the latest world we have.
+    applyDelta(world) {
+        if (world.deltaBaseSequenceNum === undefined) {
+            this.worldObjects = new Map();
+        } else if (world.deltaBaseSequenceNum !== this.worldSeqNum) {
+            return false;
+        }
+        (world.removedObjectId || []).forEach(id => {
+            this.worldObjects.delete(id);
+        });
+        (world.object || []).forEach(object => {
+            this.worldObjects.set(object.id, object);
+        });
+        world.object = Array.from(this.worldObjects.values());
+        this.worldSeqNum = world.sequenceNum;
+        return true;
+    }
+
     checkMessage(world) {
         const now = new Date().getTime();
         const duration = now - this.simWorldLastUpdateTimestamp;
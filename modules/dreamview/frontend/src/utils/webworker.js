@@ -9,6 +9,16 @@ const pointCloudRoot = protobuf.Root.fromJSON(
 );
 const pointCloudMessage = pointCloudRoot.lookupType("apollo.dreamview.PointCloud");
 
+// Decodes the little endian int16 coordinates into meters.
+function dequantizePoints(bytes, step) {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const num = new Float32Array(bytes.byteLength / 2);
+    for (let i = 0; i < num.length; i++) {
+        num[i] = view.getInt16(i * 2, true) * step;
+    }
+    return num;
+}
+
 self.addEventListener("message", event => {
     let message = null;
     const data = event.data.data;
@@ -35,6 +45,11 @@ self.addEventListener("message", event => {
             } else {
                 message = pointCloudMessage.toObject(
                     pointCloudMessage.decode(new Uint8Array(data)), {arrays: true});
+                if (message.quantizedPoint && message.quantizedPoint.length > 0) {
+                    message.num = dequantizePoints(
+                        message.quantizedPoint, message.quantizationStep);
+                    delete message.quantizedPoint;
+                }
             }
             break;
     }
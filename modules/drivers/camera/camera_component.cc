@@ -90,20 +90,26 @@ void CameraComponent::run() {
       continue;
     }
 
+    if (index_ >= buffer_size_) {
+      index_ = 0;
+    }
+    auto pb_image = pb_image_buffer_.at(index_);
+    if (camera_config_->capture_into_message()) {
+      raw_image_->output = pb_image->mutable_data();
+    }
     if (!camera_device_->poll(raw_image_)) {
       AERROR << "camera device poll failed";
       continue;
     }
+    ++index_;
 
     cyber::Time image_time(raw_image_->tv_sec, 1000 * raw_image_->tv_usec);
-    if (index_ >= buffer_size_) {
-      index_ = 0;
-    }
-    auto pb_image = pb_image_buffer_.at(index_++);
     pb_image->mutable_header()->set_timestamp_sec(
         cyber::Time::Now().ToSecond());
     pb_image->set_measurement_time(image_time.ToSecond());
-    pb_image->set_data(raw_image_->image, raw_image_->image_size);
+    if (!camera_config_->capture_into_message()) {
+      pb_image->set_data(raw_image_->image, raw_image_->image_size);
+    }
     writer_->Write(pb_image);
 
     cyber::SleepFor(std::chrono::microseconds(spin_rate_));
@@ -16,17 +16,25 @@
 
 #include "modules/drivers/camera/compress_component.h"
 
-#include <exception>
-#include <vector>
-
-#include "opencv2/core/core.hpp"
-#include "opencv2/highgui/highgui.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
+#include <algorithm>
+#include <new>
+#include <utility>
 
 namespace apollo {
 namespace drivers {
 namespace camera {
 
+CompressComponent::~CompressComponent() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : encoder_threads_) {
+    thread.join();
+  }
+}
+
 bool CompressComponent::Init() {
   if (!GetProtoConfig(&config_)) {
     AERROR << "Parse config file failed: " << ConfigFilePath();
@@ -42,43 +50,91 @@ bool CompressComponent::Init() {
     return false;
   }
 
+  const uint32_t encoder_num =
+      std::max(1u, config_.compress_conf().encoder_thread_num());
+  for (uint32_t i = 0; i < encoder_num; ++i) {
+    auto encoder = ImageEncoder::Create(config_.compress_conf().encoder());
+    if (encoder == nullptr || !encoder->Init(config_.compress_conf())) {
+      AERROR << "Failed to create encoder "
+             << config_.compress_conf().encoder();
+      return false;
+    }
+    encoders_.push_back(std::move(encoder));
+  }
+
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
+  if (encoders_.size() > 1) {
+    for (auto& encoder : encoders_) {
+      encoder_threads_.emplace_back(&CompressComponent::EncoderLoop, this,
+                                    encoder.get());
+    }
+  }
   return true;
 }
 
 bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   ADEBUG << "procing compressed";
-  auto compressed_image = image_pool_->GetObject();
-  compressed_image->mutable_header()->CopyFrom(image->header());
-  compressed_image->set_frame_id(image->frame_id());
-  compressed_image->set_measurement_time(image->measurement_time());
-  compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
-
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = CV_IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
-  try {
-    cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
-                      const_cast<char*>(image->data().data()), image->step());
-    cv::Mat tmp_mat;
-    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
-      AERROR << "cv::imencode (jpeg) failed on input image";
+  if (encoders_.size() == 1) {
+    auto compressed_image = image_pool_->GetObject();
+    if (!Compress(*image, encoders_.front().get(), compressed_image.get())) {
       return false;
     }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
     writer_->Write(compressed_image);
-  } catch(std::exception &e) {
-    AERROR << "cv::imencode (jpeg) exception :" << e.what();
-    return false;
+    return true;
   }
+
+  // hand the image to the encoder threads, waiting while they are all busy
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] {
+    return stopped_ || pending_images_.size() < encoders_.size();
+  });
+  pending_images_.emplace_back(next_sequence_++, image);
+  cv_.notify_all();
   return true;
 }
 
+bool CompressComponent::Compress(const Image& image, ImageEncoder* encoder,
+                                 CompressedImage* compressed_image) {
+  compressed_image->mutable_header()->CopyFrom(image.header());
+  compressed_image->set_frame_id(image.frame_id());
+  compressed_image->set_measurement_time(image.measurement_time());
+  return encoder->Encode(image, compressed_image);
+}
+
+void CompressComponent::EncoderLoop(ImageEncoder* encoder) {
+  while (true) {
+    std::pair<uint64_t, std::shared_ptr<Image>> pending_image;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopped_ || !pending_images_.empty(); });
+      if (stopped_) {
+        return;
+      }
+      pending_image = std::move(pending_images_.front());
+      pending_images_.pop_front();
+      cv_.notify_all();
+    }
+
+    auto compressed_image = image_pool_->GetObject();
+    const bool compressed =
+        Compress(*pending_image.second, encoder, compressed_image.get());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this, &pending_image] {
+      return stopped_ || next_write_sequence_ == pending_image.first;
+    });
+    if (stopped_) {
+      return;
+    }
+    if (compressed) {
+      writer_->Write(compressed_image);
+    }
+    ++next_write_sequence_;
+    cv_.notify_all();
+  }
+}
+
 }  // namespace camera
 }  // namespace drivers
 }  // namespace apollo
@@ -16,10 +16,17 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/drivers/camera/image_encoder.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 
@@ -35,13 +42,29 @@ using apollo::drivers::camera::config::Config;
 
 class CompressComponent : public Component<Image> {
  public:
+  ~CompressComponent();
   bool Init() override;
   bool Proc(const std::shared_ptr<Image>& image) override;
 
  private:
+  bool Compress(const Image& image, ImageEncoder* encoder,
+                CompressedImage* compressed_image);
+  void EncoderLoop(ImageEncoder* encoder);
+
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
   Config config_;
+
+  std::vector<std::unique_ptr<ImageEncoder>> encoders_;
+  // with several encoders, the images wait for the encoder threads with
+  // their sequence number, and are written in sequence
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::pair<uint64_t, std::shared_ptr<Image>>> pending_images_;
+  uint64_t next_sequence_ = 0;
+  uint64_t next_write_sequence_ = 0;
+  bool stopped_ = false;
+  std::vector<std::thread> encoder_threads_;
 };
 
 CYBER_REGISTER_COMPONENT(CompressComponent)
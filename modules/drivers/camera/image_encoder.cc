@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/drivers/camera/image_encoder.h"
+
+#include <exception>
+
+#include "opencv2/highgui/highgui.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "cyber/common/log.h"
+#include "modules/common/util/factory.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+namespace {
+
+using EncoderFactory =
+    apollo::common::util::Factory<std::string, ImageEncoder>;
+
+EncoderFactory* GetEncoderFactory() {
+  static EncoderFactory* factory = [] {
+    auto* encoder_factory = new EncoderFactory();
+    encoder_factory->Register(
+        "jpeg", []() -> ImageEncoder* { return new JpegImageEncoder(); });
+    return encoder_factory;
+  }();
+  return factory;
+}
+
+}  // namespace
+
+std::unique_ptr<ImageEncoder> ImageEncoder::Create(const std::string& name) {
+  return GetEncoderFactory()->CreateObject(name);
+}
+
+bool ImageEncoder::Register(const std::string& name,
+                            ImageEncoder* (*creator)()) {
+  return GetEncoderFactory()->Register(name, creator);
+}
+
+bool JpegImageEncoder::Init(const config::Config::CompressConfig& config) {
+  params_ = {CV_IMWRITE_JPEG_QUALITY,
+             static_cast<int>(config.jpeg_quality())};
+  return true;
+}
+
+bool JpegImageEncoder::Encode(const Image& image,
+                              CompressedImage* compressed_image) {
+  try {
+    cv::Mat mat_image(image.height(), image.width(), CV_8UC3,
+                      const_cast<char*>(image.data().data()), image.step());
+    // OpenCV encodes bgr images, the other ones are converted into a buffer
+    // kept from one image to the next
+    const cv::Mat* bgr_image = &mat_image;
+    if (image.encoding() != "bgr8") {
+      cv::cvtColor(mat_image, bgr_image_, cv::COLOR_RGB2BGR);
+      bgr_image = &bgr_image_;
+    }
+    if (!cv::imencode(".jpg", *bgr_image, buffer_, params_)) {
+      AERROR << "cv::imencode (jpeg) failed on input image";
+      return false;
+    }
+  } catch (std::exception& e) {
+    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+    return false;
+  }
+  compressed_image->set_format(image.encoding() + "; jpeg compressed bgr8");
+  compressed_image->mutable_data()->assign(
+      reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+  return true;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "modules/drivers/camera/proto/config.pb.h"
+#include "modules/drivers/proto/sensor_image.pb.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @class ImageEncoder
+ * @brief Compresses the raw images of a camera. An encoder is used by one
+ * thread at a time and keeps its buffers from one image to the next.
+ */
+class ImageEncoder {
+ public:
+  virtual ~ImageEncoder() = default;
+
+  virtual bool Init(const config::Config::CompressConfig& config) = 0;
+
+  /**
+   * @brief compress image into the data and format of compressed_image
+   */
+  virtual bool Encode(const Image& image,
+                      CompressedImage* compressed_image) = 0;
+
+  /**
+   * @brief create the encoder registered as name, nullptr if none is
+   */
+  static std::unique_ptr<ImageEncoder> Create(const std::string& name);
+
+  /**
+   * @brief register an encoder backend, e.g. a hardware one
+   * @return false if name is already registered
+   */
+  static bool Register(const std::string& name,
+                       ImageEncoder* (*creator)());
+};
+
+/**
+ * @class JpegImageEncoder
+ * @brief JPEG encoding by OpenCV on the CPU, registered as "jpeg".
+ */
+class JpegImageEncoder : public ImageEncoder {
+ public:
+  bool Init(const config::Config::CompressConfig& config) override;
+
+  bool Encode(const Image& image, CompressedImage* compressed_image) override;
+
+ private:
+  std::vector<int> params_;
+  cv::Mat bgr_image_;
+  std::vector<uint8_t> buffer_;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -194,7 +194,9 @@ void UsbCam::mjpeg2rgb(char* mjpeg_buffer, int len, char* rgb_buffer,
 bool UsbCam::poll(const CameraImagePtr& raw_image) {
   raw_image->is_new = 0;
   // free memory in this struct desturctor
-  memset(raw_image->image, 0, raw_image->image_size * sizeof(char));
+  if (raw_image->output == nullptr) {
+    memset(raw_image->image, 0, raw_image->image_size * sizeof(char));
+  }
 
   fd_set fds;
   struct timeval tv;
@@ -828,6 +830,10 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
       if (len < raw_image->width * raw_image->height) {
         AERROR << "Wrong Buffer Len: " << len
                << ", dev: " << config_->camera_dev();
+        if (raw_image->output != nullptr) {
+          // blank as the intermediate buffer would be
+          raw_image->output->assign(raw_image->image_size, 0);
+        }
       } else {
         process_image(buffers_[buf.index].start, len, raw_image);
       }
@@ -894,12 +900,17 @@ bool UsbCam::process_image(const void* src, int len, CameraImagePtr dest) {
     AERROR << "process image error. src or dest is null";
     return false;
   }
+  char* image = dest->image;
+  if (dest->output != nullptr) {
+    dest->output->resize(dest->image_size);
+    image = &(*dest->output)[0];
+  }
   if (pixel_format_ == V4L2_PIX_FMT_YUYV ||
       pixel_format_ == V4L2_PIX_FMT_UYVY) {
     if (config_->output_type() == YUYV) {
-      memcpy(dest->image, src, dest->width * dest->height * 2);
+      memcpy(image, src, dest->width * dest->height * 2);
     } else if (config_->output_type() == RGB) {
-      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)dest->image,
+      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)image,
                    dest->width * dest->height);
     } else {
       AERROR << "unsupported output format:" << config_->output_type();
@@ -86,6 +86,8 @@ struct CameraImage {
   int tv_sec;
   int tv_usec;
   char* image;
+  // when set, the frames are written into it instead of image
+  std::string* output = nullptr;
 
   ~CameraImage() {
     if (image != nullptr) {
@@ -153,6 +153,13 @@ class CanClient {
   virtual apollo::common::ErrorCode Receive(std::vector<CanFrame> *const frames,
                                             int32_t *const frame_num) = 0;
 
+  /**
+   * @brief If Receive waits for the frames to arrive.
+   * @return True if Receive blocks until a frame arrives or a timeout expires,
+   *         so that the caller does not need to sleep between empty receives.
+   */
+  virtual bool IsReceiveBlocking() const { return false; }
+
   /**
    * @brief Get the error string.
    * @param status The status to get the error string.
@@ -157,6 +157,7 @@ ErrorCode EsdCanClient::Receive(std::vector<CanFrame> *const frames,
   const int32_t ret = canRead(dev_handler_, recv_frames_, frame_num, nullptr);
   // rx timeout not log
   if (ret == NTCAN_RX_TIMEOUT) {
+    *frame_num = 0;
     return ErrorCode::OK;
   }
   if (ret != NTCAN_SUCCESS) {
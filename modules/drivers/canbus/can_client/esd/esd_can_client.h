@@ -90,6 +90,11 @@ class EsdCanClient : public CanClient {
   apollo::common::ErrorCode Receive(std::vector<CanFrame> *const frames,
                                     int32_t *const frame_num) override;
 
+  /**
+   * @brief canRead waits for the frames up to the rx timeout of the handle.
+   */
+  bool IsReceiveBlocking() const override { return true; }
+
   /**
    * @brief Get the error string.
    * @param status The status to get the error string.
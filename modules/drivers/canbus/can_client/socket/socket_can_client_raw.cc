@@ -38,6 +38,15 @@ bool SocketCanClientRaw::Init(const CANCardParameter &parameter) {
   }
 
   port_ = parameter.channel_id();
+  batch_receive_ = parameter.batch_receive();
+  receive_timeout_ms_ = static_cast<int>(parameter.receive_timeout_ms());
+  std::memset(recv_msgs_, 0, sizeof(recv_msgs_));
+  for (int32_t i = 0; i < MAX_CAN_RECV_FRAME_LEN; ++i) {
+    recv_iovecs_[i].iov_base = &recv_frames_[i];
+    recv_iovecs_[i].iov_len = sizeof(recv_frames_[i]);
+    recv_msgs_[i].msg_hdr.msg_iov = &recv_iovecs_[i];
+    recv_msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
   return true;
 }
 
@@ -179,6 +188,10 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
   }
 
+  if (batch_receive_) {
+    return ReceiveBatch(frames, frame_num);
+  }
+
   for (int32_t i = 0; i < *frame_num && i < MAX_CAN_RECV_FRAME_LEN; ++i) {
     CanFrame cf;
     auto ret = read(dev_handler_, &recv_frames_[i], sizeof(recv_frames_[i]));
@@ -202,6 +215,61 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
   return ErrorCode::OK;
 }
 
+// Waits for the first frame, then takes all the pending ones in one call
+ErrorCode SocketCanClientRaw::ReceiveBatch(std::vector<CanFrame> *const frames,
+                                           int32_t *const frame_num) {
+  const int32_t max_frame_num = *frame_num;
+  *frame_num = 0;
+  if (max_frame_num == 0) {
+    return ErrorCode::OK;
+  }
+
+  struct pollfd poll_fd;
+  poll_fd.fd = dev_handler_;
+  poll_fd.events = POLLIN;
+  poll_fd.revents = 0;
+  const int poll_ret = poll(&poll_fd, 1, receive_timeout_ms_);
+  if (poll_ret < 0) {
+    if (errno == EINTR) {
+      return ErrorCode::OK;
+    }
+    AERROR << "poll can socket failed, errno: " << errno;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
+  if (poll_ret == 0) {
+    // rx timeout, no frame
+    return ErrorCode::OK;
+  }
+
+  const int ret = recvmmsg(dev_handler_, recv_msgs_,
+                           static_cast<unsigned int>(max_frame_num),
+                           MSG_DONTWAIT, nullptr);
+  if (ret < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return ErrorCode::OK;
+    }
+    AERROR << "receive message failed, errno: " << errno;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
+
+  for (int i = 0; i < ret; ++i) {
+    if (recv_frames_[i].can_dlc != CANBUS_MESSAGE_LENGTH) {
+      AERROR << "recv_frames_[" << i
+             << "].can_dlc = " << recv_frames_[i].can_dlc
+             << ", which is not equal to can message data length ("
+             << CANBUS_MESSAGE_LENGTH << ").";
+      continue;
+    }
+    CanFrame cf;
+    cf.id = recv_frames_[i].can_id;
+    cf.len = recv_frames_[i].can_dlc;
+    std::memcpy(cf.data, recv_frames_[i].data, recv_frames_[i].can_dlc);
+    frames->push_back(cf);
+    ++(*frame_num);
+  }
+  return ErrorCode::OK;
+}
+
 std::string SocketCanClientRaw::GetErrorString(const int32_t /*status*/) {
   return "";
 }
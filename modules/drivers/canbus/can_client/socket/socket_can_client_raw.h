@@ -21,12 +21,14 @@
 
 #pragma once
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <net/if.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -103,6 +105,11 @@ class SocketCanClientRaw : public CanClient {
   apollo::common::ErrorCode Receive(std::vector<CanFrame> *const frames,
                                     int32_t *const frame_num) override;
 
+  /**
+   * @brief The batched receive waits for the frames with a timeout.
+   */
+  bool IsReceiveBlocking() const override { return batch_receive_; }
+
   /**
    * @brief Get the error string.
    * @param status The status to get the error string.
@@ -110,10 +117,17 @@ class SocketCanClientRaw : public CanClient {
   std::string GetErrorString(const int32_t status) override;
 
  private:
+  apollo::common::ErrorCode ReceiveBatch(std::vector<CanFrame> *const frames,
+                                         int32_t *const frame_num);
+
   int dev_handler_ = 0;
   CANCardParameter::CANChannelId port_;
   can_frame send_frames_[MAX_CAN_SEND_FRAME_LEN];
   can_frame recv_frames_[MAX_CAN_RECV_FRAME_LEN];
+  bool batch_receive_ = false;
+  int receive_timeout_ms_ = 0;
+  struct iovec recv_iovecs_[MAX_CAN_RECV_FRAME_LEN];
+  struct mmsghdr recv_msgs_[MAX_CAN_RECV_FRAME_LEN];
 };
 
 }  // namespace can
@@ -141,8 +141,13 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
   const int32_t ERROR_COUNT_MAX = 10;
   auto default_period = 10 * 1000;
 
+  // a blocking client waits for the frames itself, no need to sleep
+  const bool is_receive_blocking = can_client_->IsReceiveBlocking();
+  std::vector<CanFrame> buf;
+  buf.reserve(MAX_CAN_RECV_FRAME_LEN);
+
   while (IsRunning()) {
-    std::vector<CanFrame> buf;
+    buf.clear();
     int32_t frame_num = MAX_CAN_RECV_FRAME_LEN;
     if (can_client_->Receive(&buf, &frame_num) !=
         ::apollo::common::ErrorCode::OK) {
@@ -161,6 +166,9 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
     }
 
     if (frame_num == 0) {
+      if (is_receive_blocking) {
+        continue;
+      }
       LOG_IF_EVERY_N(ERROR, receive_none_count++ > ERROR_COUNT_MAX,
                      ERROR_COUNT_MAX)
           << "Received " << receive_none_count << " empty messages.";
@@ -169,12 +177,9 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
     }
     receive_none_count = 0;
 
-    for (const auto &frame : buf) {
-      uint8_t len = frame.len;
-      uint32_t uid = frame.id;
-      const uint8_t *data = frame.data;
-      pt_manager_->Parse(uid, data, len);
-      if (enable_log_) {
+    pt_manager_->ParseFrames(buf);
+    if (enable_log_) {
+      for (const auto &frame : buf) {
         ADEBUG << "recv_can_frame#" << frame.CanFrameString();
       }
     }
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -184,6 +185,12 @@ class CanSender {
   bool IsRunning() const;
   bool enable_log() const;
 
+  /**
+   * @brief Get the time of the first send following the last update.
+   * @return The timestamp in microseconds, 0 if nothing was sent since.
+   */
+  int64_t update_send_timestamp() const;
+
   FRIEND_TEST(CanSenderTest, OneRunCase);
 
  private:
@@ -199,6 +206,10 @@ class CanSender {
   std::unique_ptr<std::thread> thread_;
   bool enable_log_ = false;
 
+  // time of the last update and of the first send following it
+  std::atomic<int64_t> update_timestamp_{0};
+  std::atomic<int64_t> update_send_timestamp_{0};
+
   DISALLOW_COPY_AND_ASSIGN(CanSender);
 };
 
@@ -308,6 +319,10 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
       if (enable_log()) {
         ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
       }
+      if (update_send_timestamp_ < update_timestamp_) {
+        update_send_timestamp_ = common::time::AsInt64<common::time::micros>(
+            common::time::Clock::Now());
+      }
     }
     delta_period = new_delta_period;
     tm_end =
@@ -372,6 +387,9 @@ void CanSender<SensorType>::Update() {
   for (auto &message : send_messages_) {
     message.Update();
   }
+  update_send_timestamp_ = 0;
+  update_timestamp_ =
+      common::time::AsInt64<common::time::micros>(common::time::Clock::Now());
 }
 
 template <typename SensorType>
@@ -400,6 +418,11 @@ bool CanSender<SensorType>::enable_log() const {
   return enable_log_;
 }
 
+template <typename SensorType>
+int64_t CanSender<SensorType>::update_send_timestamp() const {
+  return update_send_timestamp_;
+}
+
 template <typename SensorType>
 bool CanSender<SensorType>::NeedSend(const SenderMessage<SensorType> &msg,
                                      const int32_t delta_period) {
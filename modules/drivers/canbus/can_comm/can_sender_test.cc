@@ -51,6 +51,24 @@ TEST(CanSenderTest, OneRunCase) {
   EXPECT_FALSE(sender.IsRunning());
 }
 
+TEST(CanSenderTest, UpdateSendTimestamp) {
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  can::FakeCanClient can_client;
+  sender.Init(&can_client, false);
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd);
+  EXPECT_EQ(0, sender.update_send_timestamp());
+
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  const int64_t update_timestamp =
+      common::time::AsInt64<common::time::micros>(common::time::Clock::Now());
+  sender.Update();
+  // the message is sent every 100 ms
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  sender.Stop();
+  EXPECT_GE(sender.update_send_timestamp(), update_timestamp);
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -31,8 +31,10 @@
 #include "cyber/common/log.h"
 #include "modules/common/proto/error_code.pb.h"
 #include "modules/common/time/time.h"
+#include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
 #include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/canbus_consts.h"
 
 /**
  * @namespace apollo::drivers::canbus
@@ -70,7 +72,7 @@ class MessageManager {
   /*
   * @brief constructor function
   */
-  MessageManager() {}
+  MessageManager() : dispatch_table_(STANDARD_CAN_ID_NUM) {}
   /*
    * @brief destructor function
    */
@@ -85,6 +87,14 @@ class MessageManager {
   virtual void Parse(const uint32_t message_id, const uint8_t *data,
                      int32_t length);
 
+  /**
+   * @brief parse a batch of received frames, locking the sensor data once
+   * for the whole batch. Managers overriding Parse with extra logic should
+   * override this one as well.
+   * @param frames the received frames
+   */
+  virtual void ParseFrames(const std::vector<CanFrame> &frames);
+
   void ClearSensorData();
 
   std::condition_variable* GetMutableCVar();
@@ -104,6 +114,15 @@ class MessageManager {
    */
   common::ErrorCode GetSensorData(SensorType *const sensor_data);
 
+  /**
+   * @brief get a snapshot of the sensor data, shared by all readers until new
+   * data is parsed, so readers look into it instead of copying it each. The
+   * snapshots are double buffered: a new one is copied into the previous one
+   * once no reader holds it any more.
+   * @return the snapshot, never changed while it is held.
+   */
+  std::shared_ptr<const SensorType> GetSensorDataSnapshot();
+
   /*
    * @brief reset send messages
    */
@@ -116,6 +135,8 @@ class MessageManager {
   template <class T, bool need_check>
   void AddSendProtocolData();
 
+  void UpdateCheckId(const int64_t time, CheckIdArg *check_id);
+
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> send_protocol_data_;
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> recv_protocol_data_;
 
@@ -125,9 +146,37 @@ class MessageManager {
 
   std::mutex sensor_data_mutex_;
   SensorType sensor_data_;
+  // bumped on every change of sensor_data_, under sensor_data_mutex_
+  uint64_t sensor_data_version_ = 0;
   bool is_received_on_time_ = false;
 
   std::condition_variable cvar_;
+
+ private:
+  // what a received frame needs, looked up by the standard id of the frame
+  // instead of hashing it into protocol_data_map_ and check_ids_
+  struct DispatchEntry {
+    ProtocolData<SensorType> *protocol_data = nullptr;
+    CheckIdArg *check_id = nullptr;
+    bool received = false;
+  };
+
+  void RegisterProtocolData(const uint32_t message_id,
+                            ProtocolData<SensorType> *protocol_data,
+                            const bool need_check);
+
+  ProtocolData<SensorType> *FindProtocolData(const uint32_t message_id);
+
+  CheckIdArg *FindCheckId(const uint32_t message_id);
+
+  void MarkReceived(const uint32_t message_id);
+
+  std::vector<DispatchEntry> dispatch_table_;
+
+  // under sensor_data_mutex_, the latest snapshot and the one before it
+  std::shared_ptr<SensorType> snapshot_;
+  std::shared_ptr<SensorType> spare_snapshot_;
+  uint64_t snapshot_version_ = 0;
 };
 
 template <typename SensorType>
@@ -138,13 +187,7 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
-  if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
-  }
+  RegisterProtocolData(T::ID, dt, need_check);
 }
 
 template <typename SensorType>
@@ -155,25 +198,76 @@ void MessageManager<SensorType>::AddSendProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
+  RegisterProtocolData(T::ID, dt, need_check);
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::RegisterProtocolData(
+    const uint32_t message_id, ProtocolData<SensorType> *protocol_data,
+    const bool need_check) {
+  protocol_data_map_[message_id] = protocol_data;
+  CheckIdArg *check_id = nullptr;
   if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
+    // the elements of an unordered_map keep their address on rehash
+    check_id = &check_ids_[message_id];
+    check_id->period = protocol_data->GetPeriod();
+    check_id->real_period = 0;
+    check_id->last_time = 0;
+    check_id->error_count = 0;
+  }
+  if (message_id < STANDARD_CAN_ID_NUM) {
+    DispatchEntry &entry = dispatch_table_[message_id];
+    entry.protocol_data = protocol_data;
+    if (check_id != nullptr) {
+      entry.check_id = check_id;
+    }
+  }
+}
+
+template <typename SensorType>
+ProtocolData<SensorType> *MessageManager<SensorType>::FindProtocolData(
+    const uint32_t message_id) {
+  if (message_id < STANDARD_CAN_ID_NUM) {
+    return dispatch_table_[message_id].protocol_data;
+  }
+  const auto it = protocol_data_map_.find(message_id);
+  return it == protocol_data_map_.end() ? nullptr : it->second;
+}
+
+template <typename SensorType>
+CheckIdArg *MessageManager<SensorType>::FindCheckId(
+    const uint32_t message_id) {
+  if (message_id < STANDARD_CAN_ID_NUM) {
+    return dispatch_table_[message_id].check_id;
+  }
+  const auto it = check_ids_.find(message_id);
+  return it == check_ids_.end() ? nullptr : &it->second;
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::MarkReceived(const uint32_t message_id) {
+  if (message_id < STANDARD_CAN_ID_NUM) {
+    // only the first frame of an id goes into the set
+    DispatchEntry &entry = dispatch_table_[message_id];
+    if (!entry.received) {
+      received_ids_.insert(message_id);
+      entry.received = true;
+    }
+    return;
   }
+  received_ids_.insert(message_id);
 }
 
 template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
-  if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
+  ProtocolData<SensorType> *protocol_data = FindProtocolData(message_id);
+  if (protocol_data == nullptr) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
-    return nullptr;
   }
-  return protocol_data_map_[message_id];
+  return protocol_data;
 }
 
 template <typename SensorType>
@@ -187,28 +281,59 @@ void MessageManager<SensorType>::Parse(const uint32_t message_id,
   {
     std::lock_guard<std::mutex> lock(sensor_data_mutex_);
     protocol_data->Parse(data, length, &sensor_data_);
+    ++sensor_data_version_;
   }
-  received_ids_.insert(message_id);
-  // check if need to check period
-  const auto it = check_ids_.find(message_id);
-  if (it != check_ids_.end()) {
-    const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
-    it->second.real_period = time - it->second.last_time;
-    // if period 1.5 large than base period, inc error_count
-    const double period_multiplier = 1.5;
-    if (it->second.real_period > (it->second.period * period_multiplier)) {
-      it->second.error_count += 1;
-    } else {
-      it->second.error_count = 0;
+  MarkReceived(message_id);
+  CheckIdArg *check_id = FindCheckId(message_id);
+  if (check_id != nullptr) {
+    UpdateCheckId(apollo::common::time::AsInt64<micros>(Clock::Now()),
+                  check_id);
+  }
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  if (frames.empty()) {
+    return;
+  }
+  // the frames of a batch arrive together, they share one receive time
+  const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  ++sensor_data_version_;
+  for (const auto &frame : frames) {
+    ProtocolData<SensorType> *protocol_data = FindProtocolData(frame.id);
+    if (protocol_data == nullptr) {
+      continue;
+    }
+    protocol_data->Parse(frame.data, frame.len, &sensor_data_);
+    MarkReceived(frame.id);
+    CheckIdArg *check_id = FindCheckId(frame.id);
+    if (check_id != nullptr) {
+      UpdateCheckId(time, check_id);
     }
-    it->second.last_time = time;
   }
 }
 
+template <typename SensorType>
+void MessageManager<SensorType>::UpdateCheckId(const int64_t time,
+                                               CheckIdArg *check_id) {
+  check_id->real_period = time - check_id->last_time;
+  // if period 1.5 large than base period, inc error_count
+  const double period_multiplier = 1.5;
+  if (check_id->real_period > (check_id->period * period_multiplier)) {
+    check_id->error_count += 1;
+  } else {
+    check_id->error_count = 0;
+  }
+  check_id->last_time = time;
+}
+
 template <typename SensorType>
 void MessageManager<SensorType>::ClearSensorData() {
   std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   sensor_data_.Clear();
+  ++sensor_data_version_;
 }
 
 template <typename SensorType>
@@ -228,6 +353,23 @@ ErrorCode MessageManager<SensorType>::GetSensorData(
   return ErrorCode::OK;
 }
 
+template <typename SensorType>
+std::shared_ptr<const SensorType>
+MessageManager<SensorType>::GetSensorDataSnapshot() {
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  if (snapshot_ != nullptr && snapshot_version_ == sensor_data_version_) {
+    return snapshot_;
+  }
+  // the previous buffer is reused unless a reader still holds it
+  if (spare_snapshot_ == nullptr || spare_snapshot_.use_count() > 1) {
+    spare_snapshot_ = std::make_shared<SensorType>();
+  }
+  spare_snapshot_->CopyFrom(sensor_data_);
+  snapshot_.swap(spare_snapshot_);
+  snapshot_version_ = sensor_data_version_;
+  return snapshot_;
+}
+
 template <typename SensorType>
 void MessageManager<SensorType>::ResetSendMessages() {
   for (auto &protocol_data : send_protocol_data_) {
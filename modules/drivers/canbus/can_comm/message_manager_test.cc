@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -28,6 +29,7 @@ namespace apollo {
 namespace drivers {
 namespace canbus {
 
+using apollo::canbus::ChassisDetail;
 using apollo::common::ErrorCode;
 
 class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
@@ -36,12 +38,36 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockExtendedProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x18FEF100;
+  MockExtendedProtocolData() {}
+};
+
+class MockCarTypeProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x112;
+  MockCarTypeProtocolData() {}
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->set_car_type(
+        static_cast<::apollo::canbus::ChassisDetail::Type>(bytes[0]));
+  }
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockExtendedProtocolData, false>();
+    AddRecvProtocolData<MockCarTypeProtocolData, false>();
+  }
+  bool IsReceived(const uint32_t message_id) const {
+    return received_ids_.count(message_id) > 0;
   }
 };
 
@@ -59,6 +85,72 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, ExtendedId) {
+  uint8_t mock_data[8] = {0};
+  MockMessageManager manager;
+  EXPECT_TRUE(manager.GetMutableProtocolDataById(
+                  MockExtendedProtocolData::ID) != nullptr);
+  EXPECT_TRUE(manager.GetMutableProtocolDataById(0x18FEF101) == nullptr);
+  EXPECT_TRUE(manager.GetMutableProtocolDataById(0x7FF) == nullptr);
+  manager.Parse(MockExtendedProtocolData::ID, mock_data, 8);
+  EXPECT_TRUE(manager.IsReceived(MockExtendedProtocolData::ID));
+  EXPECT_FALSE(manager.IsReceived(MockProtocolData::ID));
+}
+
+TEST(MessageManagerTest, ParseFrames) {
+  MockMessageManager manager;
+  std::vector<CanFrame> frames(3);
+  frames[0].id = MockProtocolData::ID;
+  frames[1].id = 0x222;
+  frames[2].id = MockProtocolData::ID;
+  for (auto &frame : frames) {
+    frame.len = 8;
+  }
+  manager.ParseFrames(std::vector<CanFrame>());
+  EXPECT_FALSE(manager.IsReceived(MockProtocolData::ID));
+  manager.ParseFrames(frames);
+  EXPECT_TRUE(manager.IsReceived(MockProtocolData::ID));
+  EXPECT_FALSE(manager.IsReceived(0x222));
+
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+}
+
+TEST(MessageManagerTest, GetSensorDataSnapshot) {
+  MockMessageManager manager;
+  uint8_t car_type = ChassisDetail::QIRUI_EQ_15;
+  manager.Parse(MockCarTypeProtocolData::ID, &car_type, 8);
+  auto snapshot = manager.GetSensorDataSnapshot();
+  ASSERT_TRUE(snapshot != nullptr);
+  EXPECT_EQ(snapshot->car_type(), ChassisDetail::QIRUI_EQ_15);
+  // shared until new data is parsed
+  EXPECT_EQ(manager.GetSensorDataSnapshot(), snapshot);
+
+  car_type = ChassisDetail::CHANGAN_RUICHENG;
+  manager.Parse(MockCarTypeProtocolData::ID, &car_type, 8);
+  auto next = manager.GetSensorDataSnapshot();
+  EXPECT_NE(next, snapshot);
+  EXPECT_EQ(next->car_type(), ChassisDetail::CHANGAN_RUICHENG);
+  // the one still held is left as it was
+  EXPECT_EQ(snapshot->car_type(), ChassisDetail::QIRUI_EQ_15);
+
+  // once released, its buffer takes the next snapshot
+  const auto *released = snapshot.get();
+  snapshot.reset();
+  std::vector<CanFrame> frames(1);
+  frames[0].id = MockCarTypeProtocolData::ID;
+  frames[0].len = 8;
+  frames[0].data[0] = ChassisDetail::QIRUI_EQ_15;
+  manager.ParseFrames(frames);
+  auto last = manager.GetSensorDataSnapshot();
+  EXPECT_EQ(last.get(), released);
+  EXPECT_EQ(last->car_type(), ChassisDetail::QIRUI_EQ_15);
+  EXPECT_EQ(next->car_type(), ChassisDetail::CHANGAN_RUICHENG);
+
+  manager.ClearSensorData();
+  EXPECT_FALSE(manager.GetSensorDataSnapshot()->has_car_type());
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
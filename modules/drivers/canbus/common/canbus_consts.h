@@ -36,6 +36,7 @@ const int32_t MAX_CAN_RECV_FRAME_LEN = 10;
 
 const int32_t CANBUS_MESSAGE_LENGTH = 8;  // according to ISO-11891-1
 const int32_t MAX_CAN_PORT = 3;
+const uint32_t STANDARD_CAN_ID_NUM = 0x800;  // 11 bit identifiers
 
 }  // namespace canbus
 }  // namespace drivers
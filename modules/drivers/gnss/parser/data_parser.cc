@@ -52,6 +52,19 @@ static const boost::array<double, 36> POSE_COVAR = {
     2, 0, 0, 0,    0, 0, 0, 2, 0, 0, 0,    0, 0, 0, 2, 0, 0, 0,
     0, 0, 0, 0.01, 0, 0, 0, 0, 0, 0, 0.01, 0, 0, 0, 0, 0, 0, 0.01};
 
+// Returns the message last published through *msg, cleared, once no reader
+// holds it any more, a new one otherwise, so that publishing at IMU rate
+// does not allocate in the steady state.
+template <typename T>
+std::shared_ptr<T> ReuseMessage(std::shared_ptr<T> *msg) {
+  if (*msg == nullptr || msg->use_count() > 1) {
+    *msg = std::make_shared<T>();
+  } else {
+    (*msg)->Clear();
+  }
+  return *msg;
+}
+
 Parser *CreateParser(config::Config config, bool is_base_station = false) {
   switch (config.data().format()) {
     case config::Stream::NOVATEL_BINARY:
@@ -129,6 +142,15 @@ void DataParser::ParseRawData(const std::string &msg) {
     if (type == Parser::MessageType::NONE) break;
     DispatchMessage(type, msg_ptr);
   }
+
+  // the gnss status only tells the latest solution, so a burst of data
+  // publishes it once
+  if (gnss_status_updated_) {
+    gnss_status_updated_ = false;
+    auto gnss_status = ReuseMessage(&gnss_status_msg_);
+    gnss_status->CopyFrom(gnss_status_);
+    gnssstatus_writer_->Write(gnss_status);
+  }
 }
 
 void DataParser::CheckInsStatus(::apollo::drivers::gnss::Ins *ins) {
@@ -154,7 +176,9 @@ void DataParser::CheckInsStatus(::apollo::drivers::gnss::Ins *ins) {
     }
 
     common::util::FillHeader("gnss", &ins_status_);
-    insstatus_writer_->Write(std::make_shared<InsStatus>(ins_status_));
+    auto ins_status = ReuseMessage(&ins_status_msg_);
+    ins_status->CopyFrom(ins_status_);
+    insstatus_writer_->Write(ins_status);
   }
 }
 
@@ -170,7 +194,7 @@ void DataParser::CheckGnssStatus(::apollo::drivers::gnss::Gnss *gnss) {
     gnss_status_.set_solution_completed(false);
   }
   common::util::FillHeader("gnss", &gnss_status_);
-  gnssstatus_writer_->Write(std::make_shared<GnssStatus>(gnss_status_));
+  gnss_status_updated_ = true;
 }
 
 void DataParser::DispatchMessage(Parser::MessageType type, MessagePtr message) {
@@ -217,20 +241,23 @@ void DataParser::DispatchMessage(Parser::MessageType type, MessagePtr message) {
 }
 
 void DataParser::PublishInsStat(const MessagePtr message) {
-  auto ins_stat = std::make_shared<InsStat>(*As<InsStat>(message));
+  auto ins_stat = ReuseMessage(&ins_stat_msg_);
+  ins_stat->CopyFrom(*As<InsStat>(message));
   common::util::FillHeader("gnss", ins_stat.get());
   insstat_writer_->Write(ins_stat);
 }
 
 void DataParser::PublishBestpos(const MessagePtr message) {
-  auto bestpos = std::make_shared<GnssBestPose>(*As<GnssBestPose>(message));
+  auto bestpos = ReuseMessage(&bestpos_msg_);
+  bestpos->CopyFrom(*As<GnssBestPose>(message));
   common::util::FillHeader("gnss", bestpos.get());
   gnssbestpose_writer_->Write(bestpos);
 }
 
 void DataParser::PublishImu(const MessagePtr message) {
-  auto raw_imu = std::make_shared<Imu>(*As<Imu>(message));
   Imu *imu = As<Imu>(message);
+  auto raw_imu = ReuseMessage(&raw_imu_msg_);
+  raw_imu->CopyFrom(*imu);
 
   raw_imu->mutable_linear_acceleration()->set_x(
       -imu->linear_acceleration().y());
@@ -247,7 +274,7 @@ void DataParser::PublishImu(const MessagePtr message) {
 
 void DataParser::PublishOdometry(const MessagePtr message) {
   Ins *ins = As<Ins>(message);
-  auto gps = std::make_shared<Gps>();
+  auto gps = ReuseMessage(&gps_msg_);
 
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   gps->mutable_header()->set_timestamp_sec(unix_sec);
@@ -291,7 +318,7 @@ void DataParser::PublishOdometry(const MessagePtr message) {
 
 void DataParser::PublishCorrimu(const MessagePtr message) {
   Ins *ins = As<Ins>(message);
-  auto imu = std::make_shared<CorrectedImu>();
+  auto imu = ReuseMessage(&corrimu_msg_);
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   imu->mutable_header()->set_timestamp_sec(unix_sec);
 
@@ -314,18 +341,20 @@ void DataParser::PublishCorrimu(const MessagePtr message) {
 }
 
 void DataParser::PublishEphemeris(const MessagePtr message) {
-  auto eph = std::make_shared<GnssEphemeris>(*As<GnssEphemeris>(message));
+  auto eph = ReuseMessage(&gnssephemeris_msg_);
+  eph->CopyFrom(*As<GnssEphemeris>(message));
   gnssephemeris_writer_->Write(eph);
 }
 
 void DataParser::PublishObservation(const MessagePtr message) {
-  auto observation =
-      std::make_shared<EpochObservation>(*As<EpochObservation>(message));
+  auto observation = ReuseMessage(&epochobservation_msg_);
+  observation->CopyFrom(*As<EpochObservation>(message));
   epochobservation_writer_->Write(observation);
 }
 
 void DataParser::PublishHeading(const MessagePtr message) {
-  auto heading = std::make_shared<Heading>(*As<Heading>(message));
+  auto heading = ReuseMessage(&heading_msg_);
+  heading->CopyFrom(*As<Heading>(message));
   heading_writer_->Write(heading);
 }
 
@@ -71,6 +71,7 @@ class DataParser {
   apollo::transform::TransformBroadcaster tf_broadcaster_;
 
   GnssStatus gnss_status_;
+  bool gnss_status_updated_ = false;
   InsStatus ins_status_;
   uint32_t ins_status_record_ = static_cast<uint32_t>(0);
   projPJ wgs84pj_source_;
@@ -94,6 +95,18 @@ class DataParser {
   std::shared_ptr<apollo::cyber::Writer<EpochObservation>>
       epochobservation_writer_ = nullptr;
   std::shared_ptr<apollo::cyber::Writer<Heading>> heading_writer_ = nullptr;
+
+  // the messages last published, reused once their readers are done
+  std::shared_ptr<GnssStatus> gnss_status_msg_ = nullptr;
+  std::shared_ptr<InsStatus> ins_status_msg_ = nullptr;
+  std::shared_ptr<GnssBestPose> bestpos_msg_ = nullptr;
+  std::shared_ptr<apollo::localization::CorrectedImu> corrimu_msg_ = nullptr;
+  std::shared_ptr<Imu> raw_imu_msg_ = nullptr;
+  std::shared_ptr<apollo::localization::Gps> gps_msg_ = nullptr;
+  std::shared_ptr<InsStat> ins_stat_msg_ = nullptr;
+  std::shared_ptr<GnssEphemeris> gnssephemeris_msg_ = nullptr;
+  std::shared_ptr<EpochObservation> epochobservation_msg_ = nullptr;
+  std::shared_ptr<Heading> heading_msg_ = nullptr;
 };
 
 }  // namespace gnss
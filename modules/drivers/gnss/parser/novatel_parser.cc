@@ -18,7 +18,9 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -76,12 +78,22 @@ inline uint32_t crc32_word(uint32_t word) {
   return word;
 }
 
+// crc32_word of every byte, so that the CRC of a block takes one lookup per
+// byte.
+struct Crc32Table {
+  Crc32Table() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      words[i] = crc32_word(i);
+    }
+  }
+  uint32_t words[256];
+};
+
 inline uint32_t crc32_block(const uint8_t* buffer, size_t length) {
+  static const Crc32Table table;
   uint32_t word = 0;
   while (length--) {
-    uint32_t t1 = (word >> 8) & 0xFFFFFF;
-    uint32_t t2 = crc32_word((word ^ *buffer++) & 0xFF);
-    word = t1 ^ t2;
+    word = (word >> 8) ^ table.words[(word ^ *buffer++) & 0xFF];
   }
   return word;
 }
@@ -113,6 +125,9 @@ class NovatelParser : public Parser {
  private:
   bool check_crc();
 
+  // Appends the available data to buffer_, up to length bytes in total.
+  void AppendData(size_t length);
+
   Parser::MessageType PrepareMessage(MessagePtr* message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
@@ -229,10 +244,14 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
 
   while (data_ < data_end_) {
     if (buffer_.size() == 0) {  // Looking for SYNC0
-      if (*data_ == novatel::SYNC_0) {
-        buffer_.push_back(*data_);
+      auto sync = static_cast<const uint8_t*>(
+          std::memchr(data_, novatel::SYNC_0, data_end_ - data_));
+      if (sync == nullptr) {
+        data_ = data_end_;
+        break;
       }
-      ++data_;
+      buffer_.push_back(*sync);
+      data_ = sync + 1;
     } else if (buffer_.size() == 1) {  // Looking for SYNC1
       if (*data_ == novatel::SYNC_1) {
         buffer_.push_back(*data_++);
@@ -253,27 +272,29 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
           buffer_.clear();
       }
     } else if (header_length_ > 0) {  // Working on header.
+      AppendData(header_length_);
       if (buffer_.size() < header_length_) {
-        buffer_.push_back(*data_++);
+        continue;
+      }
+      if (header_length_ == sizeof(novatel::LongHeader)) {
+        total_length_ = header_length_ + novatel::CRC_LENGTH +
+                        reinterpret_cast<novatel::LongHeader*>(buffer_.data())
+                            ->message_length;
+      } else if (header_length_ == sizeof(novatel::ShortHeader)) {
+        total_length_ =
+            header_length_ + novatel::CRC_LENGTH +
+            reinterpret_cast<novatel::ShortHeader*>(buffer_.data())
+                ->message_length;
       } else {
-        if (header_length_ == sizeof(novatel::LongHeader)) {
-          total_length_ = header_length_ + novatel::CRC_LENGTH +
-                          reinterpret_cast<novatel::LongHeader*>(buffer_.data())
-                              ->message_length;
-        } else if (header_length_ == sizeof(novatel::ShortHeader)) {
-          total_length_ =
-              header_length_ + novatel::CRC_LENGTH +
-              reinterpret_cast<novatel::ShortHeader*>(buffer_.data())
-                  ->message_length;
-        } else {
-          AERROR << "Incorrect header_length_. Should never reach here.";
-          buffer_.clear();
-        }
-        header_length_ = 0;
+        AERROR << "Incorrect header_length_. Should never reach here.";
+        buffer_.clear();
       }
+      header_length_ = 0;
     } else if (total_length_ > 0) {
-      if (buffer_.size() < total_length_) {  // Working on body.
-        buffer_.push_back(*data_++);
+      // Working on body, a message completed by the last bytes of data is
+      // handled right away rather than with the next data.
+      AppendData(total_length_);
+      if (buffer_.size() < total_length_) {
         continue;
       }
       MessageType type = PrepareMessage(message_ptr);
@@ -287,6 +308,13 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
   return MessageType::NONE;
 }
 
+void NovatelParser::AppendData(size_t length) {
+  size_t count = std::min(length - buffer_.size(),
+                          static_cast<size_t>(data_end_ - data_));
+  buffer_.insert(buffer_.end(), data_, data_ + count);
+  data_ += count;
+}
+
 bool NovatelParser::check_crc() {
   size_t l = buffer_.size() - novatel::CRC_LENGTH;
   return crc32_block(buffer_.data(), l) ==
@@ -477,14 +477,14 @@ void RawStream::DataSpin() {
   while (cyber::OK()) {
     size_t length = data_stream_->read(buffer_, BUFFER_SIZE);
     if (length > 0) {
-      std::shared_ptr<RawData> msg_pub = std::make_shared<RawData>();
-      if (!msg_pub) {
-        AERROR << "New data sting msg failed.";
-        continue;
+      // the message of the last read is reused once its readers are done,
+      // keeping the capacity of its data
+      if (raw_data_ == nullptr || raw_data_.use_count() > 1) {
+        raw_data_ = std::make_shared<RawData>();
       }
-      msg_pub->set_data(reinterpret_cast<const char *>(buffer_), length);
-      raw_writer_->Write(msg_pub);
-      data_parser_ptr_->ParseRawData(msg_pub->data());
+      raw_data_->set_data(reinterpret_cast<const char *>(buffer_), length);
+      raw_writer_->Write(raw_data_);
+      data_parser_ptr_->ParseRawData(raw_data_->data());
       if (push_location_) {
         PushGpgga(length);
       }
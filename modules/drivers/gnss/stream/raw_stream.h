@@ -99,6 +99,7 @@ class RawStream {
   std::shared_ptr<apollo::cyber::Writer<StreamStatus>> stream_writer_ =
       nullptr;
   std::shared_ptr<apollo::cyber::Writer<RawData>> raw_writer_ = nullptr;
+  std::shared_ptr<RawData> raw_data_ = nullptr;
   std::shared_ptr<apollo::cyber::Writer<RawData>> rtcm_writer_ = nullptr;
   std::shared_ptr<apollo::cyber::Reader<RawData>> gpsbin_reader_ = nullptr;
   std::shared_ptr<apollo::cyber::Reader<apollo::canbus::Chassis>>
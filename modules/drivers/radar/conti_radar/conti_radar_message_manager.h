@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "cyber/cyber.h"
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
@@ -40,6 +41,7 @@ using Clock = ::apollo::common::time::Clock;
 using micros = std::chrono::microseconds;
 using ::apollo::common::ErrorCode;
 using apollo::drivers::canbus::CanClient;
+using apollo::drivers::canbus::CanFrame;
 using apollo::drivers::canbus::SenderMessage;
 using apollo::drivers::conti_radar::RadarConfig200;
 template<typename T>
@@ -54,6 +56,7 @@ class ContiRadarMessageManager : public MessageManager<ContiRadar> {
   ProtocolData<ContiRadar> *GetMutableProtocolDataById(
       const uint32_t message_id);
   void Parse(const uint32_t message_id, const uint8_t *data, int32_t length);
+  void ParseFrames(const std::vector<CanFrame> &frames) override;
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
  private:
@@ -54,6 +54,14 @@ void RacobitRadarMessageManager::set_radar_conf(RadarConf radar_conf) {
   radar_config_.set_radar_conf(radar_conf);
 }
 
+// the frames go through Parse one by one, in their order of arrival
+void RacobitRadarMessageManager::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  for (const auto &frame : frames) {
+    Parse(frame.id, frame.data, frame.len);
+  }
+}
+
 void RacobitRadarMessageManager::set_can_client(
     std::shared_ptr<CanClient> can_client) {
   can_client_ = can_client;
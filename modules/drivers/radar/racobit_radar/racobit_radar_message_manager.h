@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "cyber/cyber.h"
 
@@ -42,6 +43,7 @@ using Clock = ::apollo::common::time::Clock;
 using micros = std::chrono::microseconds;
 using ::apollo::common::ErrorCode;
 using apollo::drivers::canbus::CanClient;
+using apollo::drivers::canbus::CanFrame;
 using apollo::drivers::canbus::SenderMessage;
 using apollo::drivers::racobit_radar::RadarConfig200;
 
@@ -54,6 +56,7 @@ class RacobitRadarMessageManager : public MessageManager<RacobitRadar> {
   ProtocolData<RacobitRadar> *GetMutableProtocolDataById(
       const uint32_t message_id);
   void Parse(const uint32_t message_id, const uint8_t *data, int32_t length);
+  void ParseFrames(const std::vector<CanFrame> &frames) override;
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
  private:
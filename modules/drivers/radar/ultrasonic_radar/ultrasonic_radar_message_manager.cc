@@ -33,6 +33,14 @@ UltrasonicRadarMessageManager::UltrasonicRadarMessageManager(
   sensor_data_.mutable_ranges()->Resize(entrance_num_, 0.0);
 }
 
+// the frames go through Parse one by one, in their order of arrival
+void UltrasonicRadarMessageManager::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  for (const auto &frame : frames) {
+    Parse(frame.id, frame.data, frame.len);
+  }
+}
+
 void UltrasonicRadarMessageManager::set_can_client(
     std::shared_ptr<CanClient> can_client) {
   can_client_ = can_client;
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "cyber/cyber.h"
 
@@ -41,6 +42,7 @@ using Clock = ::apollo::common::time::Clock;
 using micros = std::chrono::microseconds;
 using ::apollo::common::ErrorCode;
 using apollo::drivers::canbus::CanClient;
+using apollo::drivers::canbus::CanFrame;
 using apollo::drivers::canbus::SenderMessage;
 
 class UltrasonicRadarMessageManager : public MessageManager<Ultrasonic> {
@@ -49,6 +51,7 @@ class UltrasonicRadarMessageManager : public MessageManager<Ultrasonic> {
       const std::shared_ptr<::apollo::cyber::Writer<Ultrasonic>> &writer);
   virtual ~UltrasonicRadarMessageManager() = default;
   void Parse(const uint32_t message_id, const uint8_t *data, int32_t length);
+  void ParseFrames(const std::vector<CanFrame> &frames) override;
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
  private:
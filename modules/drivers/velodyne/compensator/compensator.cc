@@ -16,14 +16,118 @@
 
 #include "modules/drivers/velodyne/compensator/compensator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <future>
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace apollo {
 namespace drivers {
 namespace velodyne {
 
+namespace {
+
+// Runs fn(begin, end) on up to thread_num consecutive ranges of [0, size).
+template <typename Function>
+void ParallelFor(const int size, const int thread_num, const Function& fn) {
+  const int num_workers = std::max(1, std::min(thread_num, size));
+  const int chunk = (size + num_workers - 1) / std::max(1, num_workers);
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, fn, worker * chunk,
+                                 std::min(size, (worker + 1) * chunk)));
+  }
+  fn(0, std::min(size, chunk));
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+// The motion of the lidar between the time of a point and the end of the
+// scan, t being the fraction of the scan time from the point to the end.
+class PointMotion {
+ public:
+  PointMotion(const uint64_t timestamp_min, const uint64_t timestamp_max,
+              const Eigen::Affine3d& pose_min_time,
+              const Eigen::Affine3d& pose_max_time,
+              const uint32_t grid_size) {
+    translation_ = pose_min_time.translation() - pose_max_time.translation();
+    Eigen::Quaterniond q_max(pose_max_time.linear());
+    Eigen::Quaterniond q_min(pose_min_time.linear());
+    q1_ = q_max.conjugate() * q_min;
+    q1_.normalize();
+    translation_ = q_max.conjugate() * translation_;
+
+    const double d = q0_.dot(q1_);
+    const double abs_d = std::abs(d);
+    // Threshold for a "significant" rotation from min_time to max_time:
+    // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an
+    // angle of 0.02 / 70 = 0.0003 rad. So, we consider a rotation
+    // "significant" only if the scalar part of quaternion is less than
+    // cos(0.0003 / 2) = 1 - 1e-8.
+    has_rotation_ = abs_d < 1.0 - 1.0e-8;
+    if (has_rotation_) {
+      theta_ = std::acos(abs_d);
+      sin_theta_ = std::sin(theta_);
+      c1_sign_ = (d > 0) ? 1 : -1;
+    }
+
+    if (grid_size > 0) {
+      grid_size_ = grid_size;
+      grid_rotations_.resize(grid_size + 1);
+      grid_translations_.resize(grid_size + 1);
+      for (uint32_t i = 0; i <= grid_size; ++i) {
+        const double t = static_cast<double>(i) / grid_size;
+        grid_rotations_[i] = has_rotation_
+                                 ? Rotation(t).toRotationMatrix()
+                                 : Eigen::Matrix3d::Identity();
+        grid_translations_[i] = t * translation_;
+      }
+    }
+  }
+
+  bool has_rotation() const { return has_rotation_; }
+
+  Eigen::Vector3d Compensate(const Eigen::Vector3d& p, const double t) const {
+    if (grid_size_ > 0) {
+      const int i = std::max(
+          0, std::min(static_cast<int>(std::lround(t * grid_size_)),
+                      static_cast<int>(grid_size_)));
+      return grid_rotations_[i] * p + grid_translations_[i];
+    }
+    if (has_rotation_) {
+      return Eigen::Translation3d(t * translation_) * Rotation(t) * p;
+    }
+    // Not a "significant" rotation. Do translation only.
+    return p + t * translation_;
+  }
+
+ private:
+  Eigen::Quaterniond Rotation(const double t) const {
+    const double c0 = std::sin((1 - t) * theta_) / sin_theta_;
+    const double c1 = std::sin(t * theta_) / sin_theta_ * c1_sign_;
+    return Eigen::Quaterniond(c0 * q0_.coeffs() + c1 * q1_.coeffs());
+  }
+
+  Eigen::Vector3d translation_;
+  const Eigen::Quaterniond q0_ = Eigen::Quaterniond::Identity();
+  Eigen::Quaterniond q1_;
+  bool has_rotation_ = false;
+  double theta_ = 0.0;
+  double sin_theta_ = 0.0;
+  double c1_sign_ = 1.0;
+
+  uint32_t grid_size_ = 0;
+  std::vector<Eigen::Matrix3d> grid_rotations_;
+  std::vector<Eigen::Vector3d> grid_translations_;
+};
+
+}  // namespace
+
 bool Compensator::QueryPoseAffineFromTF2(const uint64_t& timestamp, void* pose,
                                          const std::string& child_frame_id) {
   cyber::Time query_time(timestamp);
@@ -105,6 +209,49 @@ bool Compensator::MotionCompensation(
   return false;
 }
 
+bool Compensator::MotionCompensation(
+    const std::shared_ptr<const PointCloud>& msg,
+    perception::base::SoaPointFCloud* cloud_compensated) {
+  if (msg->height() == 0 || msg->width() == 0) {
+    AERROR << "PointCloud width & height should not be 0";
+    return false;
+  }
+  Eigen::Affine3d pose_min_time;
+  Eigen::Affine3d pose_max_time;
+
+  uint64_t timestamp_min = 0;
+  uint64_t timestamp_max = 0;
+  const std::string& frame_id = msg->header().frame_id();
+  GetTimestampInterval(msg, &timestamp_min, &timestamp_max);
+  if (!QueryPoseAffineFromTF2(timestamp_min, &pose_min_time, frame_id) ||
+      !QueryPoseAffineFromTF2(timestamp_max, &pose_max_time, frame_id)) {
+    return false;
+  }
+
+  const int size = msg->point_size();
+  cloud_compensated->clear();
+  cloud_compensated->resize(size);
+  auto* x = cloud_compensated->mutable_points_x();
+  auto* y = cloud_compensated->mutable_points_y();
+  auto* z = cloud_compensated->mutable_points_z();
+  auto* intensity = cloud_compensated->mutable_points_intensity();
+  auto* timestamp = cloud_compensated->mutable_points_timestamp();
+  auto* beam_id = cloud_compensated->mutable_points_beam_id();
+  for (int i = 0; i < size; ++i) {
+    const auto& point = msg->point(i);
+    (*x)[i] = point.x();
+    (*y)[i] = point.y();
+    (*z)[i] = point.z();
+    (*intensity)[i] = static_cast<float>(point.intensity());
+    (*timestamp)[i] = static_cast<double>(point.timestamp()) * 1e-9;
+    (*beam_id)[i] = i;
+  }
+  cloud_compensated->set_timestamp(msg->measurement_time());
+  MotionCompensation(cloud_compensated, timestamp_min, timestamp_max,
+                     pose_min_time, pose_max_time);
+  return true;
+}
+
 inline void Compensator::GetTimestampInterval(
     const std::shared_ptr<const PointCloud>& msg, uint64_t* timestamp_min,
     uint64_t* timestamp_max) {
@@ -128,95 +275,77 @@ void Compensator::MotionCompensation(
     std::shared_ptr<PointCloud> msg_compensated, const uint64_t timestamp_min,
     const uint64_t timestamp_max, const Eigen::Affine3d& pose_min_time,
     const Eigen::Affine3d& pose_max_time) {
-  using std::abs;
-  using std::acos;
-  using std::sin;
-
-  Eigen::Vector3d translation =
-      pose_min_time.translation() - pose_max_time.translation();
-  Eigen::Quaterniond q_max(pose_max_time.linear());
-  Eigen::Quaterniond q_min(pose_min_time.linear());
-  Eigen::Quaterniond q1(q_max.conjugate() * q_min);
-  Eigen::Quaterniond q0(Eigen::Quaterniond::Identity());
-  q1.normalize();
-  translation = q_max.conjugate() * translation;
-
-  // int total = msg->width * msg->height;
-
-  double d = q0.dot(q1);
-  double abs_d = abs(d);
-  double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
-
-  // Threshold for a "significant" rotation from min_time to max_time:
-  // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an angle
-  // of 0.02 / 70 =
-  // 0.0003 rad. So, we consider a rotation "significant" only if the scalar
-  // part of quaternion is
-  // less than cos(0.0003 / 2) = 1 - 1e-8.
-  if (abs_d < 1.0 - 1.0e-8) {
-    double theta = acos(abs_d);
-    double sin_theta = sin(theta);
-    double c1_sign = (d > 0) ? 1 : -1;
-    for (const auto& point : msg->point()) {
-      float x_scalar = point.x();
-      if (std::isnan(x_scalar)) {
-        // if (config_.organized()) {
-        auto* point_new = msg_compensated->add_point();
-        point_new->CopyFrom(point);
-        // } else {
-        //   AERROR << "nan point do not need motion compensation";
-        // }
-        continue;
-      }
-      float y_scalar = point.y();
-      float z_scalar = point.z();
-      Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-      uint64_t tp = point.timestamp();
-      double t = static_cast<double>(timestamp_max - tp) * f;
-
-      Eigen::Translation3d ti(t * translation);
-
-      double c0 = sin((1 - t) * theta) / sin_theta;
-      double c1 = sin(t * theta) / sin_theta * c1_sign;
-      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
+  const PointMotion motion(timestamp_min, timestamp_max, pose_min_time,
+                           pose_max_time, config_.pose_grid_size());
+  const double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
 
-      Eigen::Affine3d trans = ti * qi;
-      p = trans * p;
-
-      auto* point_new = msg_compensated->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
-      point_new->set_x(static_cast<float>(p.x()));
-      point_new->set_y(static_cast<float>(p.y()));
-      point_new->set_z(static_cast<float>(p.z()));
-    }
-    return;
-  }
-  // Not a "significant" rotation. Do translation only.
-  for (auto& point : msg->point()) {
-    float x_scalar = point.x();
-    if (std::isnan(x_scalar)) {
+  // the output points are added first, so that they are filled on threads
+  std::vector<std::pair<const PointXYZIT*, PointXYZIT*>> points;
+  points.reserve(msg->point_size());
+  for (const auto& point : msg->point()) {
+    if (std::isnan(point.x()) && !motion.has_rotation()) {
       AERROR << "nan point do not need motion compensation";
       continue;
     }
-    float y_scalar = point.y();
-    float z_scalar = point.z();
-    Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-    uint64_t tp = point.timestamp();
-    double t = static_cast<double>(timestamp_max - tp) * f;
-    Eigen::Translation3d ti(t * translation);
-
-    p = ti * p;
-
-    auto* point_new = msg_compensated->add_point();
-    point_new->set_intensity(point.intensity());
-    point_new->set_timestamp(point.timestamp());
-    point_new->set_x(static_cast<float>(p.x()));
-    point_new->set_y(static_cast<float>(p.y()));
-    point_new->set_z(static_cast<float>(p.z()));
+    points.emplace_back(&point, msg_compensated->add_point());
   }
+
+  ParallelFor(static_cast<int>(points.size()),
+              static_cast<int>(config_.thread_num()),
+              [&](const int begin, const int end) {
+                for (int i = begin; i < end; ++i) {
+                  const PointXYZIT& point = *points[i].first;
+                  PointXYZIT* point_new = points[i].second;
+                  if (std::isnan(point.x())) {
+                    point_new->CopyFrom(point);
+                    continue;
+                  }
+                  const double t =
+                      static_cast<double>(timestamp_max - point.timestamp()) *
+                      f;
+                  const Eigen::Vector3d p = motion.Compensate(
+                      Eigen::Vector3d(point.x(), point.y(), point.z()), t);
+                  point_new->set_intensity(point.intensity());
+                  point_new->set_timestamp(point.timestamp());
+                  point_new->set_x(static_cast<float>(p.x()));
+                  point_new->set_y(static_cast<float>(p.y()));
+                  point_new->set_z(static_cast<float>(p.z()));
+                }
+              });
+}
+
+void Compensator::MotionCompensation(perception::base::SoaPointFCloud* cloud,
+                                     const uint64_t timestamp_min,
+                                     const uint64_t timestamp_max,
+                                     const Eigen::Affine3d& pose_min_time,
+                                     const Eigen::Affine3d& pose_max_time) {
+  const PointMotion motion(timestamp_min, timestamp_max, pose_min_time,
+                           pose_max_time, config_.pose_grid_size());
+  // the point timestamps are in seconds here
+  const double timestamp_max_sec = static_cast<double>(timestamp_max) * 1e-9;
+  const double f =
+      1.0e9 / static_cast<double>(timestamp_max - timestamp_min);
+
+  float* x = cloud->mutable_points_x()->data();
+  float* y = cloud->mutable_points_y()->data();
+  float* z = cloud->mutable_points_z()->data();
+  const double* timestamp = cloud->points_timestamp().data();
+
+  ParallelFor(static_cast<int>(cloud->size()),
+              static_cast<int>(config_.thread_num()),
+              [&](const int begin, const int end) {
+                for (int i = begin; i < end; ++i) {
+                  if (std::isnan(x[i])) {
+                    continue;
+                  }
+                  const double t = (timestamp_max_sec - timestamp[i]) * f;
+                  const Eigen::Vector3d p = motion.Compensate(
+                      Eigen::Vector3d(x[i], y[i], z[i]), t);
+                  x[i] = static_cast<float>(p.x());
+                  y[i] = static_cast<float>(p.y());
+                  z[i] = static_cast<float>(p.z());
+                }
+              });
 }
 
 }  // namespace velodyne
@@ -25,6 +25,8 @@
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/drivers/velodyne/proto/config.pb.h"
 
+#include "modules/perception/base/soa_point_cloud.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -40,6 +42,13 @@ class Compensator {
   bool MotionCompensation(const std::shared_ptr<const PointCloud>& msg,
                           std::shared_ptr<PointCloud> msg_compensated);
 
+  /**
+   * @brief motion compensation into structure-of-arrays buffers, the points
+   *   are copied once and compensated in place, nan points are kept as is
+   */
+  bool MotionCompensation(const std::shared_ptr<const PointCloud>& msg,
+                          perception::base::SoaPointFCloud* cloud_compensated);
+
  private:
   /**
    * @brief get pose affine from tf2 by gps timestamp
@@ -57,6 +66,12 @@ class Compensator {
                           const uint64_t timestamp_max,
                           const Eigen::Affine3d& pose_min_time,
                           const Eigen::Affine3d& pose_max_time);
+
+  void MotionCompensation(perception::base::SoaPointFCloud* cloud,
+                          const uint64_t timestamp_min,
+                          const uint64_t timestamp_max,
+                          const Eigen::Affine3d& pose_min_time,
+                          const Eigen::Affine3d& pose_max_time);
   /**
    * @brief get min timestamp and max timestamp from points in pointcloud2
    */
@@ -43,11 +43,37 @@ bool CompensatorComponent::Init() {
     }
     point_cloud->mutable_point()->Reserve(140000);
   }
+
+  if (config.has_shared_output_channel()) {
+    shared_writer_ = node_->CreateWriter<SharedPointCloudMessage>(
+        config.shared_output_channel());
+    shared_pool_.reset(new CCObjectPool<SharedPointCloudMessage>(pool_size_));
+    shared_pool_->ConstructAll();
+    for (int i = 0; i < pool_size_; ++i) {
+      auto message = shared_pool_->GetObject();
+      if (message == nullptr) {
+        AERROR << "fail to getobject:" << i;
+        return false;
+      }
+      message->cloud_.reserve(140000);
+    }
+  }
   return true;
 }
 
 bool CompensatorComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
+  if (shared_writer_ != nullptr) {
+    const bool shared = ProcShared(point_cloud);
+    // the protobuf is only built for remote subscribers
+    if (!writer_->HasReader()) {
+      if (shared) {
+        seq_++;
+      }
+      return true;
+    }
+  }
+
   uint64_t start = cyber::Time().Now().ToNanosecond();
   std::shared_ptr<PointCloud> point_cloud_compensated =
       compensator_pool_->GetObject();
@@ -73,6 +99,31 @@ bool CompensatorComponent::Proc(
   return true;
 }
 
+bool CompensatorComponent::ProcShared(
+    const std::shared_ptr<PointCloud>& point_cloud) {
+  uint64_t start = cyber::Time().Now().ToNanosecond();
+  std::shared_ptr<SharedPointCloudMessage> message = shared_pool_->GetObject();
+  if (message == nullptr) {
+    AWARN << "compensator fail to get shared message, will be new";
+    message = std::make_shared<SharedPointCloudMessage>();
+  }
+  message->Clear();
+  if (!compensator_->MotionCompensation(point_cloud, &message->cloud_)) {
+    return false;
+  }
+  message->header_.set_timestamp_sec(cyber::Time::Now().ToSecond());
+  message->header_.set_frame_id(point_cloud->header().frame_id());
+  message->header_.set_lidar_timestamp(point_cloud->header().lidar_timestamp());
+  message->header_.set_sequence_num(seq_);
+  message->frame_id_ = point_cloud->header().frame_id();
+  message->measurement_time_ = point_cloud->measurement_time();
+  uint64_t diff = cyber::Time().Now().ToNanosecond() - start;
+  AINFO << "compenstator shared diff:" << diff
+        << ";meta:" << point_cloud->header().lidar_timestamp();
+  shared_writer_->Write(message);
+  return true;
+}
+
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
@@ -24,6 +24,7 @@
 
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/drivers/velodyne/compensator/compensator.h"
+#include "modules/drivers/velodyne/compensator/shared_point_cloud_message.h"
 
 namespace apollo {
 namespace drivers {
@@ -41,11 +42,17 @@ class CompensatorComponent : public Component<PointCloud> {
   bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
 
  private:
+  // compensates into a SharedPointCloudMessage for in-process readers
+  bool ProcShared(const std::shared_ptr<PointCloud>& point_cloud);
+
   std::unique_ptr<Compensator> compensator_ = nullptr;
   int pool_size_ = 8;
   int seq_ = 0;
   std::shared_ptr<Writer<PointCloud>> writer_ = nullptr;
   std::shared_ptr<CCObjectPool<PointCloud>> compensator_pool_ = nullptr;
+  std::shared_ptr<Writer<SharedPointCloudMessage>> shared_writer_ = nullptr;
+  std::shared_ptr<CCObjectPool<SharedPointCloudMessage>> shared_pool_ =
+      nullptr;
 };
 
 CYBER_REGISTER_COMPONENT(CompensatorComponent)
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include "modules/common/proto/header.pb.h"
+
+#include "modules/perception/base/soa_point_cloud.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+/**
+ * @brief Compensated point cloud handed to the components of the same
+ * process by shared pointer, the points are kept in structure-of-arrays
+ * buffers and never serialized. It is not a protobuf, so it only reaches
+ * readers in the writer's process, remote readers subscribe to the
+ * drivers::PointCloud channel of the compensator instead.
+ */
+class SharedPointCloudMessage {
+ public:
+  SharedPointCloudMessage() : type_name_("SharedPointCloudMessage") {}
+  ~SharedPointCloudMessage() = default;
+
+  std::string GetTypeName() const { return type_name_; }
+
+  SharedPointCloudMessage* New() const { return new SharedPointCloudMessage; }
+
+  // keeps the capacity of the point buffers for the next frame
+  void Clear() {
+    header_.Clear();
+    frame_id_.clear();
+    measurement_time_ = 0.0;
+    cloud_.clear();
+  }
+
+ public:
+  std::string type_name_;
+  apollo::common::Header header_;
+  std::string frame_id_;
+  double measurement_time_ = 0.0;
+  // points in the lidar frame, timestamps in seconds and the index of the
+  // point in the driver message as beam id
+  perception::base::SoaPointFCloud cloud_;
+};
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
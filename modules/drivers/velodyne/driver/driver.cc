@@ -46,7 +46,8 @@ void VelodyneDriver::Init() {
 
   // open Velodyne input device
 
-  input_.reset(new SocketInput());
+  input_.reset(new SocketInput(config_.socket_batch_size(),
+                               config_.use_kernel_timestamp()));
   positioning_input_.reset(new SocketInput());
   input_->init(config_.firing_data_port());
   positioning_input_->init(config_.positioning_data_port());
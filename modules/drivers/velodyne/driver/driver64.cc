@@ -33,7 +33,8 @@ void Velodyne64Driver::Init() {
   config_.set_npackets(static_cast<int>(ceil(packet_rate_ / frequency)));
   AINFO << "publishing " << config_.npackets() << " packets per scan";
 
-  input_.reset(new SocketInput());
+  input_.reset(new SocketInput(config_.socket_batch_size(),
+                               config_.use_kernel_timestamp()));
   input_->init(config_.firing_data_port());
 }
 
@@ -31,8 +31,11 @@
 #include <poll.h>
 #include <sys/file.h>
 #include <sys/socket.h>
+#include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "modules/drivers/velodyne/driver/socket_input.h"
 
 namespace apollo {
@@ -50,6 +53,32 @@ namespace velodyne {
  */
 SocketInput::SocketInput() : sockfd_(-1), port_(0) {}
 
+SocketInput::SocketInput(const int batch_size, const bool use_kernel_timestamp)
+    : sockfd_(-1),
+      port_(0),
+      batch_size_(std::max(1, batch_size)),
+      use_kernel_timestamp_(use_kernel_timestamp) {
+  if (batch_size_ == 1 && !use_kernel_timestamp_) {
+    return;
+  }
+  // the buffers are allocated once, recvmmsg() fills them in place
+  const size_t control_size = CMSG_SPACE(sizeof(timespec));
+  batch_data_.resize(batch_size_ * FIRING_DATA_PACKET_SIZE);
+  batch_control_.resize(batch_size_ * control_size);
+  batch_iovecs_.resize(batch_size_);
+  batch_msgs_.resize(batch_size_);
+  for (int i = 0; i < batch_size_; ++i) {
+    batch_iovecs_[i].iov_base = &batch_data_[i * FIRING_DATA_PACKET_SIZE];
+    batch_iovecs_[i].iov_len = FIRING_DATA_PACKET_SIZE;
+    memset(&batch_msgs_[i], 0, sizeof(mmsghdr));
+    batch_msgs_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+    batch_msgs_[i].msg_hdr.msg_iovlen = 1;
+    if (use_kernel_timestamp_) {
+      batch_msgs_[i].msg_hdr.msg_control = &batch_control_[i * control_size];
+    }
+  }
+}
+
 /** @brief destructor */
 SocketInput::~SocketInput(void) { (void)close(sockfd_); }
 
@@ -86,11 +115,24 @@ void SocketInput::init(const int &port) {
     return;
   }
 
+  if (use_kernel_timestamp_) {
+    const int enable = 1;
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                   sizeof(enable)) < 0) {
+      AWARN << "Kernel timestamps unavailable on port " << port_
+            << ", the packets are stamped on receipt";
+      use_kernel_timestamp_ = false;
+    }
+  }
+
   AINFO << "Velodyne socket fd is " << sockfd_ << ", port " << port_;
 }
 
 /** @brief Get one velodyne packet. */
 int SocketInput::get_firing_data_packet(VelodynePacket *pkt) {
+  if (!batch_msgs_.empty()) {
+    return get_batched_firing_data_packet(pkt);
+  }
   // double time1 = ros::Time::now().toSec();
   double time1 = apollo::cyber::Time().Now().ToSecond();
   while (true) {
@@ -125,6 +167,79 @@ int SocketInput::get_firing_data_packet(VelodynePacket *pkt) {
   return 0;
 }
 
+/** @brief Get one velodyne packet out of the last batch, receiving the next
+ *  batch when it is used up. */
+int SocketInput::get_batched_firing_data_packet(VelodynePacket *pkt) {
+  while (true) {
+    while (batch_index_ < batch_num_) {
+      const int index = batch_index_++;
+      const size_t nbytes = batch_msgs_[index].msg_len;
+      if (nbytes != FIRING_DATA_PACKET_SIZE) {
+        AERROR << "Incomplete Velodyne rising data packet read: " << nbytes
+               << " bytes from port " << port_;
+        continue;
+      }
+      pkt->set_data(&batch_data_[index * FIRING_DATA_PACKET_SIZE],
+                    FIRING_DATA_PACKET_SIZE);
+      pkt->set_stamp(batch_packet_stamp(index));
+      return 0;
+    }
+    const int ret = receive_batch();
+    if (ret != 0) {
+      return ret;
+    }
+  }
+}
+
+/** @brief Receive the packets waiting on the socket with one system call. */
+int SocketInput::receive_batch() {
+  batch_num_ = 0;
+  batch_index_ = 0;
+  const uint64_t time1 = apollo::cyber::Time::Now().ToNanosecond();
+  if (!input_available(POLL_TIMEOUT)) {
+    return SOCKET_TIMEOUT;
+  }
+  const size_t control_size = CMSG_SPACE(sizeof(timespec));
+  for (auto &msg : batch_msgs_) {
+    // the kernel shrinks the control length to what it wrote
+    msg.msg_hdr.msg_controllen = use_kernel_timestamp_ ? control_size : 0;
+    msg.msg_hdr.msg_flags = 0;
+    msg.msg_len = 0;
+  }
+  const int num = recvmmsg(sockfd_, batch_msgs_.data(), batch_size_,
+                           MSG_DONTWAIT, nullptr);
+  if (num < 0) {
+    if (errno != EWOULDBLOCK && errno != EAGAIN && errno != EINTR) {
+      AERROR << "recvfail from port " << port_;
+      return RECIEVE_FAIL;
+    }
+    return 0;
+  }
+  const uint64_t time2 = apollo::cyber::Time::Now().ToNanosecond();
+  batch_stamp_ = time1 + (time2 - time1) / 2;
+  batch_num_ = num;
+  return 0;
+}
+
+/** @brief The kernel receive time of a packet of the batch, or the time of
+ *  the batch when the kernel did not stamp it. */
+uint64_t SocketInput::batch_packet_stamp(const int index) {
+  if (use_kernel_timestamp_) {
+    msghdr *hdr = &batch_msgs_[index].msg_hdr;
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET &&
+          cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+        timespec stamp;
+        memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+        return static_cast<uint64_t>(stamp.tv_sec) * 1000000000UL +
+               static_cast<uint64_t>(stamp.tv_nsec);
+      }
+    }
+  }
+  return batch_stamp_;
+}
+
 int SocketInput::get_positioning_data_packet(NMEATimePtr nmea_time) {
   while (true) {
     if (!input_available(POLL_TIMEOUT)) {
@@ -17,8 +17,11 @@
 #pragma once
 
 #include <stdio.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include "modules/drivers/velodyne/driver/input.h"
 
 namespace apollo {
@@ -35,6 +38,14 @@ static const int POLL_TIMEOUT = 1000;  // one second (in msec)
 class SocketInput : public Input {
  public:
   SocketInput();
+  /** @brief constructor of a firing data input
+   *
+   *  @param batch_size number of packets received by one recvmmsg() call,
+   *         1 receives the packets one by one with recvfrom()
+   *  @param use_kernel_timestamp stamp the packets with the time they were
+   *         received by the kernel (SO_TIMESTAMPNS)
+   */
+  SocketInput(const int batch_size, const bool use_kernel_timestamp);
   virtual ~SocketInput();
   void init(const int& port) override;
   int get_firing_data_packet(VelodynePacket* pkt);
@@ -44,6 +55,21 @@ class SocketInput : public Input {
   int sockfd_;
   int port_;
   bool input_available(int timeout);
+
+  int get_batched_firing_data_packet(VelodynePacket* pkt);
+  int receive_batch();
+  uint64_t batch_packet_stamp(const int index);
+
+  int batch_size_ = 1;
+  bool use_kernel_timestamp_ = false;
+  // the packets of the last recvmmsg() call, handed out one by one
+  std::vector<uint8_t> batch_data_;
+  std::vector<char> batch_control_;
+  std::vector<iovec> batch_iovecs_;
+  std::vector<mmsghdr> batch_msgs_;
+  int batch_num_ = 0;
+  int batch_index_ = 0;
+  uint64_t batch_stamp_ = 0;
 };
 
 }  // namespace velodyne
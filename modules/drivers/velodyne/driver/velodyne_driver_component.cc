@@ -53,9 +53,15 @@ bool VelodyneDriverComponent::Init() {
 
 /** @brief Device poll thread main loop. */
 void VelodyneDriverComponent::device_poll() {
+  std::shared_ptr<VelodyneScan> scan;
   while (!apollo::cyber::IsShutdown()) {
-    // poll device until end of file
-    std::shared_ptr<VelodyneScan> scan = std::make_shared<VelodyneScan>();
+    // poll device until end of file, reusing the scan and its packets once
+    // the readers released it
+    if (scan == nullptr || scan.use_count() > 1) {
+      scan = std::make_shared<VelodyneScan>();
+    } else {
+      scan->Clear();
+    }
     bool ret = dvr_->Poll(scan);
     if (ret) {
       common::util::FillHeader("velodyne", scan.get());
@@ -14,7 +14,10 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <future>
 #include <memory>
+#include <vector>
 
 #include "modules/drivers/velodyne/fusion/pri_sec_fusion_component.h"
 
@@ -44,6 +47,7 @@ bool PriSecFusionComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
   auto target = point_cloud;
   auto fusion_readers = readers_;
+  std::vector<std::shared_ptr<PointCloud>> sources;
   auto start_time = Time::Now().ToSecond();
   while ((Time::Now().ToSecond() - start_time) < conf_.wait_time_s() &&
          fusion_readers.size() > 0) {
@@ -54,7 +58,11 @@ bool PriSecFusionComponent::Proc(
         if (conf_.drop_expired_data() && IsExpired(target, source)) {
           ++itr;
         } else {
-          Fusion(target, source);
+          if (conf_.thread_num() > 1) {
+            sources.push_back(source);
+          } else {
+            Fusion(target, source);
+          }
           itr = fusion_readers.erase(itr);
         }
       } else {
@@ -63,6 +71,9 @@ bool PriSecFusionComponent::Proc(
     }
     usleep(USLEEP_INTERVAL);
   }
+  if (!sources.empty()) {
+    ParallelFusion(target, sources);
+  }
   fusion_writer_->Write(target);
 
   return true;
@@ -108,44 +119,87 @@ bool PriSecFusionComponent::QueryPoseAffine(const std::string& target_frame_id,
 void PriSecFusionComponent::AppendPointCloud(
     std::shared_ptr<PointCloud> point_cloud,
     std::shared_ptr<PointCloud> point_cloud_add, const Eigen::Affine3d& pose) {
-  if (std::isnan(pose(0, 0))) {
-    for (auto& point : point_cloud_add->point()) {
-      PointXYZIT* point_new = point_cloud->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
+  const int offset = point_cloud->point_size();
+  for (int i = 0; i < point_cloud_add->point_size(); ++i) {
+    point_cloud->add_point();
+  }
+  TransformPointCloud(*point_cloud_add, pose, offset, point_cloud.get());
+
+  int new_width = point_cloud->point_size() / point_cloud->height();
+  point_cloud->set_width(new_width);
+}
+
+void PriSecFusionComponent::TransformPointCloud(const PointCloud& source,
+                                                const Eigen::Affine3d& pose,
+                                                const int offset,
+                                                PointCloud* target) {
+  const bool has_pose = !std::isnan(pose(0, 0));
+  for (int i = 0; i < source.point_size(); ++i) {
+    const auto& point = source.point(i);
+    PointXYZIT* point_new = target->mutable_point(offset + i);
+    point_new->set_intensity(point.intensity());
+    point_new->set_timestamp(point.timestamp());
+    if (!has_pose || std::isnan(point.x())) {
       point_new->set_x(point.x());
       point_new->set_y(point.y());
       point_new->set_z(point.z());
+      continue;
     }
-  } else {
-    for (auto& point : point_cloud_add->point()) {
-      if (std::isnan(point.x())) {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(point.timestamp());
-        point_new->set_x(point.x());
-        point_new->set_y(point.y());
-        point_new->set_z(point.z());
-      } else {
-        PointXYZIT* point_new = point_cloud->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(point.timestamp());
-        Eigen::Matrix<float, 3, 1> pt(point.x(), point.y(), point.z());
-        point_new->set_x(static_cast<float>(
-            pose(0, 0) * pt.coeffRef(0) + pose(0, 1) * pt.coeffRef(1) +
-            pose(0, 2) * pt.coeffRef(2) + pose(0, 3)));
-        point_new->set_y(static_cast<float>(
-            pose(1, 0) * pt.coeffRef(0) + pose(1, 1) * pt.coeffRef(1) +
-            pose(1, 2) * pt.coeffRef(2) + pose(1, 3)));
-        point_new->set_z(static_cast<float>(
-            pose(2, 0) * pt.coeffRef(0) + pose(2, 1) * pt.coeffRef(1) +
-            pose(2, 2) * pt.coeffRef(2) + pose(2, 3)));
-      }
+    Eigen::Matrix<float, 3, 1> pt(point.x(), point.y(), point.z());
+    point_new->set_x(static_cast<float>(
+        pose(0, 0) * pt.coeffRef(0) + pose(0, 1) * pt.coeffRef(1) +
+        pose(0, 2) * pt.coeffRef(2) + pose(0, 3)));
+    point_new->set_y(static_cast<float>(
+        pose(1, 0) * pt.coeffRef(0) + pose(1, 1) * pt.coeffRef(1) +
+        pose(1, 2) * pt.coeffRef(2) + pose(1, 3)));
+    point_new->set_z(static_cast<float>(
+        pose(2, 0) * pt.coeffRef(0) + pose(2, 1) * pt.coeffRef(1) +
+        pose(2, 2) * pt.coeffRef(2) + pose(2, 3)));
+  }
+}
+
+void PriSecFusionComponent::ParallelFusion(
+    std::shared_ptr<PointCloud> target,
+    const std::vector<std::shared_ptr<PointCloud>>& sources) {
+  std::vector<std::shared_ptr<PointCloud>> fused_sources;
+  std::vector<Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d>>
+      poses;
+  std::vector<int> offsets;
+  int size = target->point_size();
+  for (const auto& source : sources) {
+    Eigen::Affine3d pose;
+    if (QueryPoseAffine(target->header().frame_id(),
+                        source->header().frame_id(), &pose)) {
+      fused_sources.push_back(source);
+      poses.push_back(pose);
+      offsets.push_back(size);
+      size += source->point_size();
     }
   }
+  target->mutable_point()->Reserve(size);
+  while (target->point_size() < size) {
+    target->add_point();
+  }
 
-  int new_width = point_cloud->point_size() / point_cloud->height();
-  point_cloud->set_width(new_width);
+  const int num_sources = static_cast<int>(fused_sources.size());
+  const int num_workers =
+      std::max(1, std::min(static_cast<int>(conf_.thread_num()), num_sources));
+  auto transform = [&](const int worker) {
+    for (int i = worker; i < num_sources; i += num_workers) {
+      TransformPointCloud(*fused_sources[i], poses[i], offsets[i],
+                          target.get());
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, transform, worker));
+  }
+  transform(0);
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  target->set_width(target->point_size() / target->height());
 }
 
 bool PriSecFusionComponent::Fusion(std::shared_ptr<PointCloud> target,
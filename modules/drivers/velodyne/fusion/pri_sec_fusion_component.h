@@ -53,6 +53,19 @@ class PriSecFusionComponent : public Component<PointCloud> {
   void AppendPointCloud(std::shared_ptr<PointCloud> point_cloud,
                         std::shared_ptr<PointCloud> point_cloud_add,
                         const Eigen::Affine3d& pose);
+  /**
+   * @brief append the sources on threads, the points of the target are added
+   *   at once and each source fills its own range of them
+   */
+  void ParallelFusion(std::shared_ptr<PointCloud> target,
+                      const std::vector<std::shared_ptr<PointCloud>>& sources);
+  /**
+   * @brief transform the points of source into the points of target from
+   *   offset on, which must exist
+   */
+  void TransformPointCloud(const PointCloud& source,
+                           const Eigen::Affine3d& pose, const int offset,
+                           PointCloud* target);
 
   FusionConfig conf_;
   apollo::transform::Buffer* buffer_ptr_ = nullptr;
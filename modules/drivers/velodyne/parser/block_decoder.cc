@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/drivers/velodyne/parser/block_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/drivers/velodyne/parser/velodyne_parser.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+static_assert(DecodedBlock::kScans == SCANS_PER_BLOCK,
+              "a decoded block holds the scans of a raw block");
+
+void BlockDecoder::Init(const Calibration& calibration,
+                        const Options& options) {
+  options_ = options;
+  int num_lasers = 0;
+  for (const auto& laser : calibration.laser_corrections_) {
+    num_lasers = std::max(num_lasers, laser.first + 1);
+  }
+  rot_cos_.assign(num_lasers, 0.0f);
+  rot_sin_.assign(num_lasers, 0.0f);
+  vert_cos_.assign(num_lasers, 0.0f);
+  vert_sin_.assign(num_lasers, 0.0f);
+  dist_.assign(num_lasers, 0.0f);
+  dist_x_.assign(num_lasers, 0.0f);
+  dist_y_.assign(num_lasers, 0.0f);
+  vert_offset_.assign(num_lasers, 0.0f);
+  horiz_offset_.assign(num_lasers, 0.0f);
+  focal_slope_.assign(num_lasers, 0.0f);
+  focal_offset_.assign(num_lasers, 0.0f);
+  min_intensity_.assign(num_lasers, 0);
+  max_intensity_.assign(num_lasers, 0);
+  for (const auto& laser : calibration.laser_corrections_) {
+    const int id = laser.first;
+    const LaserCorrection& corrections = laser.second;
+    if (id < 0) {
+      continue;
+    }
+    rot_cos_[id] = corrections.cos_rot_correction;
+    rot_sin_[id] = corrections.sin_rot_correction;
+    vert_cos_[id] = corrections.cos_vert_correction;
+    vert_sin_[id] = corrections.sin_vert_correction;
+    dist_[id] = corrections.dist_correction;
+    dist_x_[id] = corrections.dist_correction_x;
+    dist_y_[id] = corrections.dist_correction_y;
+    vert_offset_[id] = corrections.vert_offset_correction;
+    horiz_offset_[id] = corrections.horiz_offset_correction;
+    focal_slope_[id] = corrections.focal_slope;
+    focal_offset_[id] = corrections.focal_offset;
+    min_intensity_[id] = corrections.min_intensity;
+    max_intensity_[id] = corrections.max_intensity;
+  }
+}
+
+void BlockDecoder::Decode(const uint8_t* data, const uint16_t* rotations,
+                          const int laser_origin, const int lasers_per_firing,
+                          const float* sin_rot_table,
+                          const float* cos_rot_table,
+                          DecodedBlock* decoded) const {
+  constexpr int kScans = DecodedBlock::kScans;
+  const int num_lasers = static_cast<int>(rot_cos_.size());
+
+  // gather the values of the scans, the only loop with indirect accesses
+  int lasers[kScans];
+  float rot_sin[kScans];
+  float rot_cos[kScans];
+  float raw_distance[kScans];
+  float raw_intensity[kScans];
+  for (int j = 0; j < kScans; ++j) {
+    const int laser = laser_origin + j % lasers_per_firing;
+    lasers[j] = laser < num_lasers ? laser : 0;
+    rot_sin[j] = sin_rot_table[rotations[j]];
+    rot_cos[j] = cos_rot_table[rotations[j]];
+    raw_distance[j] = static_cast<float>(
+        static_cast<uint16_t>(data[3 * j] | (data[3 * j + 1] << 8)));
+    raw_intensity[j] = static_cast<float>(data[3 * j + 2]);
+    decoded->valid[j] = laser < num_lasers;
+  }
+  float cos_rot_correction[kScans];
+  float sin_rot_correction[kScans];
+  float cos_vert_correction[kScans];
+  float sin_vert_correction[kScans];
+  float dist_correction[kScans];
+  float dist_correction_x[kScans];
+  float dist_correction_y[kScans];
+  float vert_offset_correction[kScans];
+  float horiz_offset_correction[kScans];
+  for (int j = 0; j < kScans; ++j) {
+    const int laser = lasers[j];
+    cos_rot_correction[j] = rot_cos_[laser];
+    sin_rot_correction[j] = rot_sin_[laser];
+    cos_vert_correction[j] = vert_cos_[laser];
+    sin_vert_correction[j] = vert_sin_[laser];
+    dist_correction[j] = dist_[laser];
+    dist_correction_x[j] = dist_x_[laser];
+    dist_correction_y[j] = dist_y_[laser];
+    vert_offset_correction[j] = vert_offset_[laser];
+    horiz_offset_correction[j] = horiz_offset_[laser];
+  }
+
+  // the arithmetic of ComputeCoords() on all the scans
+  const double min_range = options_.min_range;
+  const double max_range = options_.max_range;
+  const bool two_pt_correction = options_.need_two_pt_correction;
+  for (int j = 0; j < kScans; ++j) {
+    const float real_distance =
+        raw_distance[j] * options_.distance_resolution;
+    const float range = real_distance + dist_correction[j];
+    const bool in_range = range >= min_range && range <= max_range;
+    const bool has_distance =
+        !options_.drop_zero_distance || raw_distance[j] != 0.0f;
+    decoded->valid[j] = decoded->valid[j] && in_range && has_distance;
+
+    const double distance = real_distance + dist_correction[j];
+    const double cos_rot_angle = rot_cos[j] * cos_rot_correction[j] +
+                                 rot_sin[j] * sin_rot_correction[j];
+    const double sin_rot_angle = rot_sin[j] * cos_rot_correction[j] -
+                                 rot_cos[j] * sin_rot_correction[j];
+    const double horiz_offset = horiz_offset_correction[j];
+    double xy_distance = distance * cos_vert_correction[j];
+    const double xx =
+        std::fabs(xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle);
+    const double yy =
+        std::fabs(xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle);
+
+    const bool two_pt = two_pt_correction && real_distance <= 2500;
+    const double distance_corr_x =
+        two_pt ? (dist_correction[j] - dist_correction_x[j]) * (xx - 2.4) /
+                         22.64 +
+                     dist_correction_x[j]
+               : dist_correction[j];
+    const double distance_corr_y =
+        two_pt ? (dist_correction[j] - dist_correction_y[j]) * (yy - 1.93) /
+                         23.11 +
+                     dist_correction_y[j]
+               : dist_correction[j];
+
+    xy_distance = (real_distance + distance_corr_x) * cos_vert_correction[j];
+    const double x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+    xy_distance = (real_distance + distance_corr_y) * cos_vert_correction[j];
+    const double y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+    const double z =
+        distance * sin_vert_correction[j] + vert_offset_correction[j];
+
+    decoded->x[j] = static_cast<float>(y);
+    decoded->y[j] = static_cast<float>(-x);
+    decoded->z[j] = static_cast<float>(z);
+  }
+
+  if (!options_.compensate_intensity) {
+    for (int j = 0; j < kScans; ++j) {
+      decoded->intensity[j] = static_cast<int>(raw_intensity[j]);
+    }
+    return;
+  }
+  for (int j = 0; j < kScans; ++j) {
+    const int laser = lasers[j];
+    const float tmp = 1.0f - raw_distance[j] / 65535.0f;
+    int intensity = static_cast<int>(raw_intensity[j]);
+    intensity += static_cast<int>(
+        focal_slope_[laser] *
+        std::fabs(focal_offset_[laser] - 256 * tmp * tmp));
+    intensity = std::max(intensity, min_intensity_[laser]);
+    decoded->intensity[j] = std::min(intensity, max_intensity_[laser]);
+  }
+}
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "modules/drivers/velodyne/parser/calibration.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+/** \brief Scans of one block decoded into separate arrays. */
+struct DecodedBlock {
+  static constexpr int kScans = 32;
+
+  float x[kScans];
+  float y[kScans];
+  float z[kScans];
+  int intensity[kScans];
+  uint8_t valid[kScans];
+};
+
+/** \brief Decodes the scans of a block together.
+ *
+ *  The calibration of the lasers is copied into one array per value, so that
+ *  the scans of a block are decoded by straight loops without the map lookup
+ *  of every scan, which the compiler vectorizes. The results are the ones of
+ *  VelodyneParser::ComputeCoords().
+ */
+class BlockDecoder {
+ public:
+  struct Options {
+    float distance_resolution = 0.002f;
+    float min_range = 0.0f;
+    float max_range = 0.0f;
+    bool need_two_pt_correction = false;
+    // drop the scans of which the raw distance is 0
+    bool drop_zero_distance = true;
+    // apply the focal intensity compensation of the 64 and 128 lasers
+    bool compensate_intensity = false;
+  };
+
+  BlockDecoder() = default;
+
+  /** \brief Copy the laser calibration, to be called again when it changes */
+  void Init(const Calibration& calibration, const Options& options);
+
+  bool initialized() const { return !rot_cos_.empty(); }
+
+  /** \brief Decode the scans of a block.
+   *
+   *  @param data the raw scans of the block, 3 bytes each
+   *  @param rotations the rotation of every scan, in hundredths of degrees
+   *  @param laser_origin the laser of the first scan
+   *  @param lasers_per_firing the scans of a firing, laser_origin + j %
+   *         lasers_per_firing is the laser of the scan j
+   *  @param sin_rot_table sines of the rotations
+   *  @param cos_rot_table cosines of the rotations
+   *  @param decoded the decoded scans
+   */
+  void Decode(const uint8_t* data, const uint16_t* rotations,
+              const int laser_origin, const int lasers_per_firing,
+              const float* sin_rot_table, const float* cos_rot_table,
+              DecodedBlock* decoded) const;
+
+ private:
+  Options options_;
+  std::vector<float> rot_cos_;
+  std::vector<float> rot_sin_;
+  std::vector<float> vert_cos_;
+  std::vector<float> vert_sin_;
+  std::vector<float> dist_;
+  std::vector<float> dist_x_;
+  std::vector<float> dist_y_;
+  std::vector<float> vert_offset_;
+  std::vector<float> horiz_offset_;
+  std::vector<float> focal_slope_;
+  std::vector<float> focal_offset_;
+  std::vector<int> min_intensity_;
+  std::vector<int> max_intensity_;
+};
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
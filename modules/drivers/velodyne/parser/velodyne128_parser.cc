@@ -24,6 +24,9 @@ Velodyne128Parser::Velodyne128Parser(const Config& config)
     : VelodyneParser(config), previous_packet_stamp_(0), gps_base_usec_(0) {
   inner_time_ = &velodyne::INNER_TIME_128;
   need_two_pt_correction_ = false;
+  decoder_options_.distance_resolution = VSL128_DISTANCE_RESOLUTION;
+  decoder_options_.drop_zero_distance = false;
+  decoder_options_.compensate_intensity = true;
 }
 
 void Velodyne128Parser::GeneratePointcloud(
@@ -77,6 +80,7 @@ void Velodyne128Parser::Unpack(const VelodynePacket& pkt,
   uint16_t azimuth_corrected = 0;
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;
+  DecodedBlock decoded;
 
   for (int block = 0; block < BLOCKS_PER_PACKET; block++) {
     // Calculate difference between current and next block's azimuth angle.
@@ -94,6 +98,23 @@ void Velodyne128Parser::Unpack(const VelodynePacket& pkt,
       azimuth_diff = last_azimuth_diff;
     }
 
+    if (block_decoder_.initialized()) {
+      // the firing order is 0, all the scans are at the block azimuth
+      uint16_t rotations[SCANS_PER_BLOCK];
+      uint64_t timestamps[SCANS_PER_BLOCK];
+      for (int j = 0; j < SCANS_PER_BLOCK; ++j) {
+        rotations[j] = static_cast<uint16_t>(azimuth % 36000);
+        timestamps[j] = static_cast<uint64_t>(
+            GetTimestamp(basetime, (*inner_time_)[block][j],
+                         static_cast<uint16_t>(block)));
+      }
+      block_decoder_.Decode(raw->blocks[block].data, rotations,
+                            (block % 4) * 32, SCANS_PER_BLOCK, sin_rot_table_,
+                            cos_rot_table_, &decoded);
+      AppendDecodedBlock(decoded, timestamps, pc.get());
+      continue;
+    }
+
     /*condition added to avoid calculating points which are not
       in the interesting defined area (min_angle < area < max_angle)*/
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK; j++, k += RAW_SCAN_SIZE) {
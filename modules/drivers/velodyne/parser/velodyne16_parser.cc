@@ -24,6 +24,7 @@ Velodyne16Parser::Velodyne16Parser(const Config& config)
     : VelodyneParser(config), previous_packet_stamp_(0), gps_base_usec_(0) {
   inner_time_ = &velodyne::INNER_TIME_16;
   need_two_pt_correction_ = false;
+  decoder_options_.distance_resolution = DISTANCE_RESOLUTION;
 }
 
 void Velodyne16Parser::GeneratePointcloud(
@@ -75,6 +76,7 @@ void Velodyne16Parser::Unpack(const VelodynePacket& pkt,
   // const RawPacket* raw = (const RawPacket*)&pkt.data[0];
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
+  DecodedBlock decoded;
 
   for (int block = 0; block < BLOCKS_PER_PACKET; block++) {
     float azimuth = static_cast<float>(raw->blocks[block].rotation);
@@ -88,6 +90,35 @@ void Velodyne16Parser::Unpack(const VelodynePacket& pkt,
       azimuth_diff = last_azimuth_diff;
     }
 
+    if (block_decoder_.initialized()) {
+      uint16_t rotations[SCANS_PER_BLOCK];
+      uint64_t timestamps[SCANS_PER_BLOCK];
+      for (int firing = 0, j = 0; firing < VLP16_FIRINGS_PER_BLOCK; ++firing) {
+        for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING; ++dsr, ++j) {
+          azimuth_corrected_f =
+              azimuth +
+              (azimuth_diff *
+               ((static_cast<float>(dsr) * VLP16_DSR_TOFFSET) +
+                (static_cast<float>(firing) * VLP16_FIRING_TOFFSET)) /
+               VLP16_BLOCK_TDURATION);
+          rotations[j] = static_cast<uint16_t>(
+              round(fmod(azimuth_corrected_f, 36000.0)));
+          timestamps[j] = GetTimestamp(basetime, (*inner_time_)[block][j],
+                                       LOWER_BANK);
+        }
+      }
+      if (block == BLOCKS_PER_PACKET - 1) {
+        // set header stamp before organize the point cloud
+        pc->set_measurement_time(
+            static_cast<double>(timestamps[SCANS_PER_BLOCK - 1]) / 1e9);
+      }
+      block_decoder_.Decode(raw->blocks[block].data, rotations, 0,
+                            VLP16_SCANS_PER_FIRING, sin_rot_table_,
+                            cos_rot_table_, &decoded);
+      AppendDecodedBlock(decoded, timestamps, pc.get());
+      continue;
+    }
+
     for (int firing = 0, k = 0; firing < VLP16_FIRINGS_PER_BLOCK; ++firing) {
       for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING;
            ++dsr, k += RAW_SCAN_SIZE) {
@@ -24,6 +24,7 @@ Velodyne32Parser::Velodyne32Parser(const Config& config)
     : VelodyneParser(config), previous_packet_stamp_(0), gps_base_usec_(0) {
   inner_time_ = &velodyne::INNER_TIME_HDL32E;
   need_two_pt_correction_ = false;
+  decoder_options_.distance_resolution = DISTANCE_RESOLUTION;
 }
 
 void Velodyne32Parser::GeneratePointcloud(
@@ -63,8 +64,27 @@ void Velodyne32Parser::Unpack(const VelodynePacket& pkt,
   // const RawPacket* raw = (const RawPacket*)&pkt.data[0];
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
+  DecodedBlock decoded;
 
   for (int i = 0; i < BLOCKS_PER_PACKET; i++) {  // 12
+    if (block_decoder_.initialized()) {
+      uint16_t rotations[SCANS_PER_BLOCK];
+      uint64_t timestamps[SCANS_PER_BLOCK];
+      for (int j = 0; j < SCANS_PER_BLOCK; ++j) {
+        rotations[j] = raw->blocks[i].rotation;
+        timestamps[j] = static_cast<uint64_t>(GetTimestamp(
+            basetime, (*inner_time_)[i][j], static_cast<uint16_t>(i)));
+      }
+      // set header stamp before organize the point cloud
+      pc->set_measurement_time(
+          static_cast<double>(timestamps[SCANS_PER_BLOCK - 1]) / 1e9);
+      block_decoder_.Decode(raw->blocks[i].data, rotations, 0,
+                            SCANS_PER_BLOCK, sin_rot_table_, cos_rot_table_,
+                            &decoded);
+      AppendDecodedBlock(decoded, timestamps, pc.get());
+      continue;
+    }
+
     for (int laser_id = 0, k = 0; laser_id < SCANS_PER_BLOCK;
          ++laser_id, k += RAW_SCAN_SIZE) {  // 32, 3
       LaserCorrection& corrections = calibration_.laser_corrections_[laser_id];
@@ -27,6 +27,8 @@ Velodyne64Parser::Velodyne64Parser(const Config& config)
     previous_packet_stamp_[i] = 0;
   }
   need_two_pt_correction_ = true;
+  decoder_options_.distance_resolution = DISTANCE_RESOLUTION;
+  decoder_options_.compensate_intensity = true;
   // init Unpack function and order function by model.
   if (config_.model() == HDL64E_S2) {
     inner_time_ = &velodyne::INNER_TIME_64;
@@ -157,6 +159,7 @@ void Velodyne64Parser::GeneratePointcloud(
     if (config_.organized()) {
       InitOffsets();
     }
+    InitBlockDecoder();
   }
 
   // allocate a point cloud with same time and frame ID as raw data
@@ -244,6 +247,7 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
   // const RawPacket* raw = (const RawPacket*)&pkt.data[0];
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
+  DecodedBlock decoded;
 
   for (int i = 0; i < BLOCKS_PER_PACKET; ++i) {  // 12
     if (mode_ != DUAL && !is_s2_ && ((i & 3) >> 1) > 0) {
@@ -255,6 +259,24 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
     // NOTE: this is a change from the old velodyne_common implementation
     int bank_origin = (raw->blocks[i].laser_block_id == LOWER_BANK) ? 32 : 0;
 
+    if (block_decoder_.initialized()) {
+      uint16_t rotations[SCANS_PER_BLOCK];
+      uint64_t timestamps[SCANS_PER_BLOCK];
+      for (int j = 0; j < SCANS_PER_BLOCK; ++j) {
+        rotations[j] = raw->blocks[i].rotation;
+        timestamps[j] = GetTimestamp(basetime, (*inner_time_)[i][j],
+                                     static_cast<uint16_t>(i));
+      }
+      // set header stamp before organize the point cloud
+      pc->set_measurement_time(
+          static_cast<double>(timestamps[SCANS_PER_BLOCK - 1]) / 1e9);
+      block_decoder_.Decode(raw->blocks[i].data, rotations, bank_origin,
+                            SCANS_PER_BLOCK, sin_rot_table_, cos_rot_table_,
+                            &decoded);
+      AppendDecodedBlock(decoded, timestamps, pc.get());
+      continue;
+    }
+
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK;
          ++j, k += RAW_SCAN_SIZE) {  // 32, 3
       // One point
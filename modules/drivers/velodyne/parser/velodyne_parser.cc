@@ -103,6 +103,39 @@ void VelodyneParser::setup() {
   init_angle_params(config_.view_direction(), config_.view_width());
   init_sin_cos_rot_table(sin_rot_table_, cos_rot_table_, ROTATION_MAX_UNITS,
                          ROTATION_RESOLUTION);
+  if (calibration_.initialized_) {
+    InitBlockDecoder();
+  }
+}
+
+void VelodyneParser::InitBlockDecoder() {
+  if (!config_.use_block_decoder()) {
+    return;
+  }
+  decoder_options_.min_range = static_cast<float>(config_.min_range());
+  decoder_options_.max_range = static_cast<float>(config_.max_range());
+  decoder_options_.need_two_pt_correction = need_two_pt_correction_;
+  block_decoder_.Init(calibration_, decoder_options_);
+}
+
+void VelodyneParser::AppendDecodedBlock(const DecodedBlock &decoded,
+                                        const uint64_t *timestamps,
+                                        PointCloud *pc) {
+  for (int j = 0; j < DecodedBlock::kScans; ++j) {
+    if (!decoded.valid[j]) {
+      // if organized append a nan point to the cloud
+      if (config_.organized()) {
+        *pc->add_point() = get_nan_point(timestamps[j]);
+      }
+      continue;
+    }
+    PointXYZIT *point = pc->add_point();
+    point->set_x(decoded.x[j]);
+    point->set_y(decoded.y[j]);
+    point->set_z(decoded.z[j]);
+    point->set_intensity(decoded.intensity[j]);
+    point->set_timestamp(timestamps[j]);
+  }
 }
 
 bool VelodyneParser::is_scan_valid(int rotation, float range) {
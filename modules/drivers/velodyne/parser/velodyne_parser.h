@@ -58,6 +58,7 @@
 #include <memory>
 #include <string>
 
+#include "modules/drivers/velodyne/parser/block_decoder.h"
 #include "modules/drivers/velodyne/parser/calibration.h"
 #include "modules/drivers/velodyne/parser/const_variables.h"
 #include "modules/drivers/velodyne/parser/online_calibration.h"
@@ -273,6 +274,25 @@ class VelodyneParser {
 
   bool is_scan_valid(int rotation, float distance);
 
+  /**
+   * \brief Copy the calibration into the block decoder when it is enabled,
+   * to be called again when the calibration changes
+   */
+  void InitBlockDecoder();
+
+  /**
+   * \brief Append the scans of a decoded block to the cloud
+   *
+   * @param decoded The decoded scans
+   * @param timestamps The timestamp of every scan
+   */
+  void AppendDecodedBlock(const DecodedBlock& decoded,
+                          const uint64_t* timestamps, PointCloud* pc);
+
+  // decoding options of the model, the ranges are filled from the config
+  BlockDecoder::Options decoder_options_;
+  BlockDecoder block_decoder_;
+
   /**
    * \brief Unpack velodyne packet
    *
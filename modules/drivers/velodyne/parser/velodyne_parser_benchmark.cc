@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file velodyne_parser_benchmark.cc
+ * @brief Compares the point by point and the block decoding of a scan.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/drivers/velodyne/parser/velodyne_parser.h"
+
+DEFINE_string(velodyne_parser_benchmark_scan, "",
+              "VelodyneScan recorded from the driver, random HDL-64E S3 "
+              "packets when empty");
+DEFINE_string(velodyne_parser_benchmark_calibration,
+              "modules/drivers/velodyne/params/64E_S3_calibration_example.yaml",
+              "Calibration of the lidar of the scan");
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+namespace {
+
+// one revolution of a HDL-64E S3 at 10Hz
+constexpr int kNumRandomPackets = 580;
+
+std::shared_ptr<VelodyneScan> MakeRandomScan() {
+  auto scan = std::make_shared<VelodyneScan>();
+  scan->set_model(HDL64E_S3S);
+  scan->set_mode(STRONGEST);
+  // the status cycle giving the base time
+  const StatusType kStatusTypes[] = {YEAR,    MONTH,   DATE,      HOURS,
+                                     MINUTES, SECONDS, GPS_STATUS};
+  const unsigned char kStatusValues[] = {19, 1, 1, 0, 0, 0, 65};
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> distance(0, 40000);
+  std::uniform_int_distribution<int> intensity(0, 255);
+  for (int p = 0; p < kNumRandomPackets; ++p) {
+    RawPacket raw;
+    for (int i = 0; i < BLOCKS_PER_PACKET; ++i) {
+      RawBlock& block = raw.blocks[i];
+      block.laser_block_id = (i & 1) ? LOWER_BANK : UPPER_BANK;
+      block.rotation = static_cast<uint16_t>((p * 6 + i / 2) * 10 % 36000);
+      for (int k = 0; k < BLOCK_DATA_SIZE; k += RAW_SCAN_SIZE) {
+        const int raw_distance = distance(generator);
+        block.data[k] = static_cast<uint8_t>(raw_distance & 0xff);
+        block.data[k + 1] = static_cast<uint8_t>(raw_distance >> 8);
+        block.data[k + 2] = static_cast<uint8_t>(intensity(generator));
+      }
+    }
+    raw.gps_timestamp = 1000 + p * 172;
+    raw.status_type = kStatusTypes[p % 7];
+    raw.status_value = kStatusValues[p % 7];
+    auto* packet = scan->add_firing_pkts();
+    packet->set_data(&raw, PACKET_SIZE);
+  }
+  return scan;
+}
+
+const std::shared_ptr<VelodyneScan>& GetScan() {
+  static const std::shared_ptr<VelodyneScan> scan = [] {
+    if (FLAGS_velodyne_parser_benchmark_scan.empty()) {
+      return MakeRandomScan();
+    }
+    auto recorded_scan = std::make_shared<VelodyneScan>();
+    CHECK(cyber::common::GetProtoFromFile(FLAGS_velodyne_parser_benchmark_scan,
+                                          recorded_scan.get()))
+        << "failed to load scan " << FLAGS_velodyne_parser_benchmark_scan;
+    return recorded_scan;
+  }();
+  return scan;
+}
+
+std::unique_ptr<VelodyneParser> MakeParser(const bool use_block_decoder) {
+  const auto& scan = GetScan();
+  Config config;
+  config.set_model(scan->model());
+  config.set_mode(scan->mode());
+  config.set_calibration_file(FLAGS_velodyne_parser_benchmark_calibration);
+  config.set_calibration_online(false);
+  config.set_min_range(0.9);
+  config.set_max_range(100.0);
+  config.set_use_block_decoder(use_block_decoder);
+  std::unique_ptr<VelodyneParser> parser(
+      VelodyneParserFactory::CreateParser(config));
+  CHECK(parser != nullptr);
+  parser->setup();
+  // the first scan only gives the base time to the 64 lasers
+  auto cloud = std::make_shared<PointCloud>();
+  parser->GeneratePointcloud(scan, cloud);
+  return parser;
+}
+
+// both decodings give the same cloud
+void CheckClouds() {
+  auto parser = MakeParser(false);
+  auto block_parser = MakeParser(true);
+  auto cloud = std::make_shared<PointCloud>();
+  auto block_cloud = std::make_shared<PointCloud>();
+  parser->GeneratePointcloud(GetScan(), cloud);
+  block_parser->GeneratePointcloud(GetScan(), block_cloud);
+  CHECK_EQ(cloud->point_size(), block_cloud->point_size());
+  for (int i = 0; i < cloud->point_size(); ++i) {
+    const auto& point = cloud->point(i);
+    const auto& block_point = block_cloud->point(i);
+    CHECK_EQ(point.timestamp(), block_point.timestamp());
+    if (std::isnan(point.x())) {
+      CHECK(std::isnan(block_point.x()));
+      continue;
+    }
+    CHECK_LT(std::abs(point.x() - block_point.x()), 1e-4);
+    CHECK_LT(std::abs(point.y() - block_point.y()), 1e-4);
+    CHECK_LT(std::abs(point.z() - block_point.z()), 1e-4);
+    CHECK_EQ(point.intensity(), block_point.intensity());
+  }
+}
+
+void GeneratePointcloud(const bool use_block_decoder,
+                        benchmark::State* state) {
+  auto parser = MakeParser(use_block_decoder);
+  const auto& scan = GetScan();
+  for (auto _ : *state) {
+    auto cloud = std::make_shared<PointCloud>();
+    parser->GeneratePointcloud(scan, cloud);
+    benchmark::DoNotOptimize(cloud->point_size());
+  }
+  state->SetItemsProcessed(state->iterations() * scan->firing_pkts_size());
+}
+
+}  // namespace
+
+static void BM_PointDecoding(benchmark::State& state) {  // NOLINT
+  GeneratePointcloud(false, &state);
+}
+BENCHMARK(BM_PointDecoding);
+
+static void BM_BlockDecoding(benchmark::State& state) {  // NOLINT
+  GeneratePointcloud(true, &state);
+}
+BENCHMARK(BM_BlockDecoding);
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  // the replayed scan goes back in time, which the parsers warn about
+  FLAGS_minloglevel = google::ERROR;
+  apollo::drivers::velodyne::CheckClouds();
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
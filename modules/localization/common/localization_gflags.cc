@@ -87,6 +87,23 @@ DEFINE_double(lidar_imu_max_delay_time, 0.4,
               "Lidar msg and imu msg max delay time");
 DEFINE_double(lidar_map_coverage_theshold, 0.9,
               "Threshold to detect wether vehicle is out of map");
+DEFINE_double(lidar_map_preload_time, 0.0,
+              "Seconds of the path predicted from the velocity along which "
+              "the map nodes are preloaded, 0 to only preload around the "
+              "vehicle");
+DEFINE_bool(lidar_map_planar_layers, false,
+            "Keep the cached map nodes as their quantized layers instead of "
+            "decoding the cells, which takes a third of the memory");
+DEFINE_double(lidar_voxel_size, 0.0,
+              "Size of the voxels in which the lidar points are averaged "
+              "before the matching, 0 to keep every point");
+DEFINE_bool(lidar_use_open_matcher, false,
+            "Match the lidar to the map with LidarMapMatcher instead of the "
+            "prebuilt locator, which does not search the heading");
+DEFINE_int32(lidar_matcher_thread_num, 4,
+             "Threads evaluating the offsets of the search window");
+DEFINE_bool(lidar_matcher_coarse_to_fine, false,
+            "Evaluate every other offset, then the ones around the best");
 DEFINE_bool(lidar_debug_log_flag, false, "Lidar Debug switch.");
 DEFINE_int32(point_cloud_step, 2, "Point cloud step");
 DEFINE_bool(if_use_avx, false,
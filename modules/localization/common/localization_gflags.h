@@ -59,6 +59,12 @@ DECLARE_int32(lidar_yaw_align_mode);
 DECLARE_int32(lidar_filter_size);
 DECLARE_double(lidar_imu_max_delay_time);
 DECLARE_double(lidar_map_coverage_theshold);
+DECLARE_double(lidar_map_preload_time);
+DECLARE_bool(lidar_map_planar_layers);
+DECLARE_double(lidar_voxel_size);
+DECLARE_bool(lidar_use_open_matcher);
+DECLARE_int32(lidar_matcher_thread_num);
+DECLARE_bool(lidar_matcher_coarse_to_fine);
 DECLARE_bool(lidar_debug_log_flag);
 DECLARE_int32(point_cloud_step);
 DECLARE_bool(if_use_avx);
@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/common/io/pcd_archive.h"
+
+#include <cinttypes>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace velodyne {
+
+namespace {
+
+const char kArchiveFile[] = "/pcd_archive.bin";
+const char kIndexFile[] = "/pcd_archive.idx";
+
+}  // namespace
+
+PcdArchiveWriter::PcdArchiveWriter() {}
+
+PcdArchiveWriter::~PcdArchiveWriter() { Close(); }
+
+bool PcdArchiveWriter::Open(const std::string& folder_path) {
+  Close();
+  const std::string archive_path = folder_path + kArchiveFile;
+  const std::string index_path = folder_path + kIndexFile;
+  archive_file_ = fopen(archive_path.c_str(), "wb");
+  index_file_ = fopen(index_path.c_str(), "w");
+  if (archive_file_ == nullptr || index_file_ == nullptr) {
+    AERROR << "Can't open the pcd archive to write: " << archive_path;
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void PcdArchiveWriter::Close() {
+  if (archive_file_ != nullptr) {
+    fclose(archive_file_);
+    archive_file_ = nullptr;
+  }
+  if (index_file_ != nullptr) {
+    fclose(index_file_);
+    index_file_ = nullptr;
+  }
+}
+
+bool PcdArchiveWriter::Write(unsigned int frame_index,
+                             const std::vector<float>& xyzs,
+                             const std::vector<unsigned char>& intensities) {
+  if (archive_file_ == nullptr) {
+    return false;
+  }
+  CHECK_EQ(xyzs.size(), intensities.size() * 3);
+  const int64_t offset = ftello(archive_file_);
+  const uint32_t header[2] = {frame_index,
+                              static_cast<uint32_t>(intensities.size())};
+  if (fwrite(header, sizeof(header), 1, archive_file_) != 1 ||
+      fwrite(xyzs.data(), sizeof(float), xyzs.size(), archive_file_) !=
+          xyzs.size() ||
+      fwrite(intensities.data(), 1, intensities.size(), archive_file_) !=
+          intensities.size()) {
+    AERROR << "Failed to write frame " << frame_index << " to pcd archive.";
+    return false;
+  }
+  fprintf(index_file_, "%u %" PRId64 "\n", frame_index, offset);
+  return true;
+}
+
+PcdArchiveReader::PcdArchiveReader() {}
+
+PcdArchiveReader::~PcdArchiveReader() { Close(); }
+
+bool PcdArchiveReader::IsArchive(const std::string& folder_path) {
+  const std::string index_path = folder_path + kIndexFile;
+  FILE* file = fopen(index_path.c_str(), "r");
+  if (file == nullptr) {
+    return false;
+  }
+  fclose(file);
+  return true;
+}
+
+bool PcdArchiveReader::Open(const std::string& folder_path) {
+  Close();
+  const std::string index_path = folder_path + kIndexFile;
+  FILE* file = fopen(index_path.c_str(), "r");
+  if (file == nullptr) {
+    AERROR << "Can't open file to read: " << index_path;
+    return false;
+  }
+  unsigned int frame_index = 0;
+  int64_t offset = 0;
+  constexpr int kSize = 2;
+  while (fscanf(file, "%u %" SCNd64 "\n", &frame_index, &offset) == kSize) {
+    frame_offsets_[frame_index] = offset;
+  }
+  fclose(file);
+
+  const std::string archive_path = folder_path + kArchiveFile;
+  archive_file_ = fopen(archive_path.c_str(), "rb");
+  if (archive_file_ == nullptr) {
+    AERROR << "Can't open file to read: " << archive_path;
+    return false;
+  }
+  return true;
+}
+
+void PcdArchiveReader::Close() {
+  if (archive_file_ != nullptr) {
+    fclose(archive_file_);
+    archive_file_ = nullptr;
+  }
+  frame_offsets_.clear();
+}
+
+bool PcdArchiveReader::Read(unsigned int frame_index,
+                            const Eigen::Affine3d& pose,
+                            std::vector<Eigen::Vector3d>* pt3ds,
+                            std::vector<unsigned char>* intensities,
+                            bool is_global) {
+  auto itr = frame_offsets_.find(frame_index);
+  if (archive_file_ == nullptr || itr == frame_offsets_.end()) {
+    AERROR << "Frame " << frame_index << " is not in the pcd archive.";
+    return false;
+  }
+  uint32_t header[2] = {0, 0};
+  if (fseeko(archive_file_, static_cast<off_t>(itr->second), SEEK_SET) != 0 ||
+      fread(header, sizeof(header), 1, archive_file_) != 1 ||
+      header[0] != frame_index) {
+    AERROR << "Failed to read frame " << frame_index << " in pcd archive.";
+    return false;
+  }
+  const size_t point_num = header[1];
+  xyzs_.resize(point_num * 3);
+  const size_t intensity_begin = intensities->size();
+  intensities->resize(intensity_begin + point_num);
+  if (fread(xyzs_.data(), sizeof(float), xyzs_.size(), archive_file_) !=
+          xyzs_.size() ||
+      fread(intensities->data() + intensity_begin, 1, point_num,
+            archive_file_) != point_num) {
+    AERROR << "Failed to read frame " << frame_index << " in pcd archive.";
+    intensities->resize(intensity_begin);
+    return false;
+  }
+
+  const Eigen::Affine3d pose_inv = pose.inverse();
+  size_t valid_num = intensity_begin;
+  pt3ds->reserve(pt3ds->size() + point_num);
+  for (size_t i = 0; i < point_num; ++i) {
+    Eigen::Vector3d pt3d(xyzs_[i * 3], xyzs_[i * 3 + 1], xyzs_[i * 3 + 2]);
+    if (pt3d[0] == pt3d[0] && pt3d[1] == pt3d[1] && pt3d[2] == pt3d[2]) {
+      pt3ds->push_back(is_global ? Eigen::Vector3d(pose_inv * pt3d) : pt3d);
+      (*intensities)[valid_num++] = (*intensities)[intensity_begin + i];
+    }
+  }
+  intensities->resize(valid_num);
+  return true;
+}
+
+}  // namespace velodyne
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
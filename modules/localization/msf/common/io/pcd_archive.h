@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file pcd_archive.h
+ * @brief The indexed binary archive of the point cloud frames of a drive,
+ *        written instead of one PCD file per frame.
+ */
+
+#pragma once
+
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace velodyne {
+
+/**@brief The frames are appended to pcd_archive.bin as the frame index, the
+ * point number, the x y z floats of the points and their intensities. Each
+ * line of pcd_archive.idx holds a frame index and its offset in the archive.
+ */
+class PcdArchiveWriter {
+ public:
+  PcdArchiveWriter();
+  ~PcdArchiveWriter();
+
+  bool Open(const std::string& folder_path);
+  void Close();
+  /**@brief Append a frame, the xyzs hold 3 floats per point. */
+  bool Write(unsigned int frame_index, const std::vector<float>& xyzs,
+             const std::vector<unsigned char>& intensities);
+
+ private:
+  FILE* archive_file_ = nullptr;
+  FILE* index_file_ = nullptr;
+};
+
+class PcdArchiveReader {
+ public:
+  PcdArchiveReader();
+  ~PcdArchiveReader();
+
+  /**@brief Check if there is an archive in a folder. */
+  static bool IsArchive(const std::string& folder_path);
+
+  bool Open(const std::string& folder_path);
+  void Close();
+  /**@brief Load a frame as LoadPcds(). */
+  bool Read(unsigned int frame_index, const Eigen::Affine3d& pose,
+            std::vector<Eigen::Vector3d>* pt3ds,
+            std::vector<unsigned char>* intensities, bool is_global = false);
+
+ private:
+  FILE* archive_file_ = nullptr;
+  std::unordered_map<unsigned int, int64_t> frame_offsets_;
+  std::vector<float> xyzs_;
+};
+
+}  // namespace velodyne
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
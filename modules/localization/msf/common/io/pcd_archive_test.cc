@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/common/io/pcd_archive.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace velodyne {
+
+TEST(PcdArchiveTestSuite, WriteRead) {
+  const std::string folder = "/tmp";
+  std::vector<float> xyzs = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f,
+                             std::numeric_limits<float>::quiet_NaN(),
+                             0.0f, 0.0f};
+  std::vector<unsigned char> intensities = {10, 20, 30};
+
+  PcdArchiveWriter writer;
+  ASSERT_TRUE(writer.Open(folder));
+  EXPECT_TRUE(writer.Write(1, xyzs, intensities));
+  xyzs.resize(3);
+  intensities.resize(1);
+  xyzs[0] = 7.0f;
+  intensities[0] = 70;
+  EXPECT_TRUE(writer.Write(2, xyzs, intensities));
+  writer.Close();
+
+  ASSERT_TRUE(PcdArchiveReader::IsArchive(folder));
+  PcdArchiveReader reader;
+  ASSERT_TRUE(reader.Open(folder));
+  std::vector<Eigen::Vector3d> pt3ds;
+  std::vector<unsigned char> read_intensities;
+  const Eigen::Affine3d pose(Eigen::Translation3d(1.0, 0.0, 0.0));
+  ASSERT_TRUE(reader.Read(2, pose, &pt3ds, &read_intensities));
+  ASSERT_EQ(1, pt3ds.size());
+  EXPECT_DOUBLE_EQ(7.0, pt3ds[0][0]);
+  EXPECT_EQ(70, read_intensities[0]);
+
+  // the nan points are dropped, the global points moved to the frame
+  pt3ds.clear();
+  read_intensities.clear();
+  ASSERT_TRUE(reader.Read(1, pose, &pt3ds, &read_intensities, true));
+  ASSERT_EQ(2, pt3ds.size());
+  ASSERT_EQ(2, read_intensities.size());
+  EXPECT_DOUBLE_EQ(3.0, pt3ds[1][0]);
+  EXPECT_DOUBLE_EQ(6.0, pt3ds[1][2]);
+  EXPECT_EQ(20, read_intensities[1]);
+
+  EXPECT_FALSE(reader.Read(3, pose, &pt3ds, &read_intensities));
+}
+
+}  // namespace velodyne
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
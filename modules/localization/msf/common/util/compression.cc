@@ -16,7 +16,9 @@
 
 #include "modules/localization/msf/common/util/compression.h"
 
+#include <lz4frame.h>
 #include <zlib.h>
+#include <zstd.h>
 
 #include "cyber/common/log.h"
 
@@ -24,13 +26,37 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+
+bool HasMagicNumber(const std::vector<unsigned char>& buf,
+                    const unsigned int magic_number) {
+  // the frame magic numbers are little endian
+  return buf.size() >= 4 &&
+         (static_cast<unsigned int>(buf[0]) |
+          static_cast<unsigned int>(buf[1]) << 8 |
+          static_cast<unsigned int>(buf[2]) << 16 |
+          static_cast<unsigned int>(buf[3]) << 24) == magic_number;
+}
+
+const unsigned int kLz4MagicNumber = 0x184D2204;
+const unsigned int kZstdMagicNumber = 0xFD2FB528;
+
+}  // namespace
+
 const unsigned int ZlibStrategy::zlib_chunk = 16384;
+const int ZstdStrategy::zstd_level = 19;
 
 unsigned int ZlibStrategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
   return ZlibCompress(buf, buf_compressed);
 }
 
 unsigned int ZlibStrategy::Decode(BufferStr* buf, BufferStr* buf_uncompressed) {
+  if (HasMagicNumber(*buf, kLz4MagicNumber)) {
+    return Lz4Uncompress(buf, buf_uncompressed);
+  }
+  if (HasMagicNumber(*buf, kZstdMagicNumber)) {
+    return ZstdUncompress(buf, buf_uncompressed);
+  }
   return ZlibUncompress(buf, buf_uncompressed);
 }
 
@@ -152,6 +178,91 @@ unsigned int ZlibStrategy::ZlibUncompress(BufferStr* src, BufferStr* dst) {
   return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
 }
 
+unsigned int ZlibStrategy::Lz4Uncompress(BufferStr* src, BufferStr* dst) {
+  LZ4F_dctx* dctx = nullptr;
+  size_t ret = LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+  if (LZ4F_isError(ret)) {
+    return Z_MEM_ERROR;
+  }
+  LZ4F_frameInfo_t frame_info;
+  size_t src_size = src->size();
+  ret = LZ4F_getFrameInfo(dctx, &frame_info, &((*src)[0]), &src_size);
+  if (LZ4F_isError(ret) || frame_info.contentSize == 0) {
+    LZ4F_freeDecompressionContext(dctx);
+    return Z_DATA_ERROR;
+  }
+  // the whole node is decoded in one call into its final buffer
+  dst->resize(frame_info.contentSize);
+  size_t dst_size = dst->size();
+  size_t rest_size = src->size() - src_size;
+  ret = LZ4F_decompress(dctx, &((*dst)[0]), &dst_size, &((*src)[src_size]),
+                        &rest_size, nullptr);
+  LZ4F_freeDecompressionContext(dctx);
+  if (LZ4F_isError(ret) || ret != 0 || dst_size != dst->size()) {
+    dst->clear();
+    return Z_DATA_ERROR;
+  }
+  return Z_OK;
+}
+
+unsigned int ZlibStrategy::ZstdUncompress(BufferStr* src, BufferStr* dst) {
+  const unsigned long long content_size =  // NOLINT
+      ZSTD_getFrameContentSize(&((*src)[0]), src->size());
+  if (content_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+      content_size == ZSTD_CONTENTSIZE_ERROR || content_size == 0) {
+    return Z_DATA_ERROR;
+  }
+  dst->resize(content_size);
+  const size_t ret =
+      ZSTD_decompress(&((*dst)[0]), dst->size(), &((*src)[0]), src->size());
+  if (ZSTD_isError(ret) || ret != dst->size()) {
+    dst->clear();
+    return Z_DATA_ERROR;
+  }
+  return Z_OK;
+}
+
+unsigned int Lz4Strategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
+  LZ4F_preferences_t prefs = {};
+  prefs.frameInfo.contentSize = buf->size();
+  buf_compressed->resize(LZ4F_compressFrameBound(buf->size(), &prefs));
+  const size_t ret =
+      LZ4F_compressFrame(&((*buf_compressed)[0]), buf_compressed->size(),
+                         &((*buf)[0]), buf->size(), &prefs);
+  if (LZ4F_isError(ret)) {
+    AERROR << "LZ4 compress failed: " << LZ4F_getErrorName(ret);
+    return Z_DATA_ERROR;
+  }
+  buf_compressed->resize(ret);
+  return Z_OK;
+}
+
+unsigned int ZstdStrategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
+  buf_compressed->resize(ZSTD_compressBound(buf->size()));
+  const size_t ret =
+      ZSTD_compress(&((*buf_compressed)[0]), buf_compressed->size(),
+                    &((*buf)[0]), buf->size(), zstd_level);
+  if (ZSTD_isError(ret)) {
+    AERROR << "ZSTD compress failed: " << ZSTD_getErrorName(ret);
+    return Z_DATA_ERROR;
+  }
+  buf_compressed->resize(ret);
+  return Z_OK;
+}
+
+CompressionStrategy* CreateCompressionStrategy(const std::string& codec) {
+  if (codec == "lz4") {
+    return new Lz4Strategy();
+  }
+  if (codec == "zstd") {
+    return new ZstdStrategy();
+  }
+  if (codec != "zlib") {
+    AERROR << "Unknown map node codec " << codec << ", use zlib.";
+  }
+  return new ZlibStrategy();
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
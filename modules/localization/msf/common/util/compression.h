@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
 namespace apollo {
@@ -32,6 +33,8 @@ class CompressionStrategy {
  protected:
 };
 
+/**@brief Encodes with zlib. Decodes zlib, LZ4 and ZSTD, the codec being
+ * told by the first bytes, so that maps mixing codecs can be read. */
 class ZlibStrategy : public CompressionStrategy {
  public:
   virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
@@ -41,8 +44,31 @@ class ZlibStrategy : public CompressionStrategy {
   static const unsigned int zlib_chunk;
   unsigned int ZlibCompress(BufferStr* src, BufferStr* dst);
   unsigned int ZlibUncompress(BufferStr* src, BufferStr* dst);
+  unsigned int Lz4Uncompress(BufferStr* src, BufferStr* dst);
+  unsigned int ZstdUncompress(BufferStr* src, BufferStr* dst);
 };
 
+/**@brief Encodes with LZ4 frames, which decode several times faster. */
+class Lz4Strategy : public ZlibStrategy {
+ public:
+  virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
+};
+
+/**@brief Encodes with ZSTD frames, smaller than zlib and faster to decode. */
+class ZstdStrategy : public ZlibStrategy {
+ public:
+  virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
+
+ protected:
+  /**@brief The nodes are written once and read constantly, the level only
+   * slows down the encoding. */
+  static const int zstd_level;
+};
+
+/**@brief Create the strategy encoding with the codec "zlib", "lz4" or
+ * "zstd". */
+CompressionStrategy* CreateCompressionStrategy(const std::string& codec);
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -18,6 +18,10 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace apollo {
 namespace localization {
 namespace msf {
@@ -48,6 +52,34 @@ TEST_F(CompressionTestSuite, ZlibStrategyTest) {
   }
 }
 
+/**@brief Lz4StrategyTest and ZstdStrategyTest. */
+TEST_F(CompressionTestSuite, FastCodecStrategyTest) {
+  std::vector<unsigned char> buf_uncompressed;
+  for (int i = 0; i < 100000; i++) {
+    buf_uncompressed.push_back(static_cast<unsigned char>(i % 7 * i % 251));
+  }
+
+  ZlibStrategy zlib;
+  for (const std::string codec : {"lz4", "zstd", "zlib"}) {
+    std::unique_ptr<CompressionStrategy> strategy(
+        CreateCompressionStrategy(codec));
+    std::vector<unsigned char> buf_compressed;
+    ASSERT_EQ(0, strategy->Encode(&buf_uncompressed, &buf_compressed));
+    EXPECT_LT(buf_compressed.size(), buf_uncompressed.size());
+
+    std::vector<unsigned char> buf_uncompressed2;
+    ASSERT_EQ(0, strategy->Decode(&buf_compressed, &buf_uncompressed2));
+    EXPECT_EQ(buf_uncompressed, buf_uncompressed2);
+    // any strategy reads the nodes of the other codecs
+    buf_uncompressed2.clear();
+    ASSERT_EQ(0, zlib.Decode(&buf_compressed, &buf_uncompressed2));
+    EXPECT_EQ(buf_uncompressed, buf_uncompressed2);
+
+    buf_compressed.resize(buf_compressed.size() / 2);
+    EXPECT_NE(0, strategy->Decode(&buf_compressed, &buf_uncompressed2));
+  }
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
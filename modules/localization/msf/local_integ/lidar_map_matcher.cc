@@ -0,0 +1,317 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_integ/lidar_map_matcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <utility>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+namespace {
+// the partial sums of the cells, so that the loop over the cells is
+// vectorized without reordering the float additions
+constexpr int kLaneNum = 8;
+// the intensity noise added to the variance of the map cells
+constexpr float kIntensityVarPrior = 25.0f;
+// the variance of the altitude of the map cells, in square meters
+constexpr float kAltitudeVar = 0.04f;
+// sharpens the distribution of the offsets, as the alpha of the
+// exp(-SSD / 2N) likelihood
+constexpr double kLikelihoodScale = 20.0;
+// the refined offsets around the best coarse one
+constexpr int kFineRadius = 2;
+}  // namespace
+
+void LidarMapMatcher::Init(int search_range_x, int search_range_y,
+                           float resolution) {
+  search_half_x_ = search_range_x / 2;
+  search_half_y_ = search_range_y / 2;
+  resolution_ = resolution;
+  const int offset_num = (2 * search_half_x_ + 1) * (2 * search_half_y_ + 1);
+  log_likelihoods_.resize(offset_num);
+  matched_nums_.resize(offset_num);
+}
+
+void LidarMapMatcher::SetVelodyneExtrinsic(const Eigen::Affine3d& extrinsic) {
+  velodyne_extrinsic_ = extrinsic;
+}
+
+void LidarMapMatcher::SetValidThreshold(float valid_threshold) {
+  valid_threshold_ = valid_threshold;
+}
+
+void LidarMapMatcher::SetLocalizationMode(int mode) {
+  if (mode == 0) {
+    intensity_weight_ = 1.0f;
+  } else if (mode == 1) {
+    intensity_weight_ = 0.0f;
+  } else {
+    intensity_weight_ = 0.5f;
+  }
+}
+
+void LidarMapMatcher::SetThreadNum(int thread_num) {
+  thread_num_ = std::max(1, thread_num);
+}
+
+void LidarMapMatcher::SetCoarseToFine(bool coarse_to_fine) {
+  coarse_to_fine_ = coarse_to_fine;
+}
+
+void LidarMapMatcher::SetMapNodeData(int width, int height,
+                                     const float* intensities,
+                                     const float* intensities_var,
+                                     const float* altitudes,
+                                     const unsigned int* counts) {
+  map_width_ = width;
+  map_height_ = height;
+  map_intensities_ = intensities;
+  map_intensities_var_ = intensities_var;
+  map_altitudes_ = altitudes;
+  map_counts_ = counts;
+  const size_t cell_num = static_cast<size_t>(width) * height;
+  if (point_nums_.size() != cell_num) {
+    intensity_sums_.assign(cell_num, 0.0f);
+    altitude_sums_.assign(cell_num, 0.0f);
+    point_nums_.assign(cell_num, 0);
+  }
+}
+
+void LidarMapMatcher::SetMapNodeLeftTopCorner(double x, double y) {
+  map_left_top_x_ = x;
+  map_left_top_y_ = y;
+}
+
+int LidarMapMatcher::Compute(const Eigen::Affine3d& pose,
+                             const std::vector<double>& pt_xs,
+                             const std::vector<double>& pt_ys,
+                             const std::vector<double>& pt_zs,
+                             const std::vector<unsigned char>& intensities) {
+  if (map_counts_ == nullptr) {
+    return -1;
+  }
+  RasterizePoints(pose * velodyne_extrinsic_, pt_xs, pt_ys, pt_zs,
+                  intensities);
+  if (cell_ids_.empty()) {
+    return -1;
+  }
+
+  std::fill(log_likelihoods_.begin(), log_likelihoods_.end(),
+            -std::numeric_limits<double>::infinity());
+  std::fill(matched_nums_.begin(), matched_nums_.end(), 0);
+  int best_dx = 0;
+  int best_dy = 0;
+  if (coarse_to_fine_) {
+    EvaluateOffsets(2, -search_half_x_, search_half_x_, -search_half_y_,
+                    search_half_y_);
+    FindBestOffset(&best_dx, &best_dy);
+    EvaluateOffsets(1, std::max(-search_half_x_, best_dx - kFineRadius),
+                    std::min(search_half_x_, best_dx + kFineRadius),
+                    std::max(-search_half_y_, best_dy - kFineRadius),
+                    std::min(search_half_y_, best_dy + kFineRadius));
+  } else {
+    EvaluateOffsets(1, -search_half_x_, search_half_x_, -search_half_y_,
+                    search_half_y_);
+  }
+  FindBestOffset(&best_dx, &best_dy);
+
+  const int range_x = 2 * search_half_x_ + 1;
+  const int range_y = 2 * search_half_y_ + 1;
+  const int best_index =
+      (best_dy + search_half_y_) * range_x + best_dx + search_half_x_;
+  const double max_log_likelihood = log_likelihoods_[best_index];
+  if (std::isinf(max_log_likelihood)) {
+    return -1;
+  }
+
+  distribution_ = Eigen::MatrixXd::Zero(range_y, range_x);
+  double sum = 0.0;
+  double sum_x = 0.0;
+  double sum_y = 0.0;
+  double sum_xx = 0.0;
+  double sum_xy = 0.0;
+  double sum_yy = 0.0;
+  for (int row = 0; row < range_y; ++row) {
+    for (int col = 0; col < range_x; ++col) {
+      const double p =
+          std::exp(log_likelihoods_[row * range_x + col] - max_log_likelihood);
+      const double dx = col - search_half_x_;
+      const double dy = row - search_half_y_;
+      distribution_(row, col) = p;
+      sum += p;
+      sum_x += p * dx;
+      sum_y += p * dy;
+      sum_xx += p * dx * dx;
+      sum_xy += p * dx * dy;
+      sum_yy += p * dy * dy;
+    }
+  }
+  distribution_ /= sum;
+  const double mean_x = sum_x / sum;
+  const double mean_y = sum_y / sum;
+  const double resolution2 = resolution_ * resolution_;
+  covariance_ = Eigen::Matrix3d::Zero();
+  covariance_(0, 0) = (sum_xx / sum - mean_x * mean_x) * resolution2;
+  covariance_(0, 1) = (sum_xy / sum - mean_x * mean_y) * resolution2;
+  covariance_(1, 0) = covariance_(0, 1);
+  covariance_(1, 1) = (sum_yy / sum - mean_y * mean_y) * resolution2;
+
+  location_ = pose;
+  location_.translation()(0) += mean_x * resolution_;
+  location_.translation()(1) += mean_y * resolution_;
+  location_score_ = static_cast<double>(matched_nums_[best_index]) /
+                    static_cast<double>(cell_ids_.size());
+  return 0;
+}
+
+void LidarMapMatcher::RasterizePoints(
+    const Eigen::Affine3d& lidar_pose, const std::vector<double>& pt_xs,
+    const std::vector<double>& pt_ys, const std::vector<double>& pt_zs,
+    const std::vector<unsigned char>& intensities) {
+  cell_ids_.clear();
+  // only the cells which stay in the map for every offset
+  const int min_col = search_half_x_;
+  const int max_col = map_width_ - search_half_x_;
+  const int min_row = search_half_y_;
+  const int max_row = map_height_ - search_half_y_;
+  for (size_t i = 0; i < pt_xs.size(); ++i) {
+    const Eigen::Vector3d point =
+        lidar_pose * Eigen::Vector3d(pt_xs[i], pt_ys[i], pt_zs[i]);
+    const int col = static_cast<int>(
+        std::floor((point(0) - map_left_top_x_) / resolution_));
+    const int row = static_cast<int>(
+        std::floor((point(1) - map_left_top_y_) / resolution_));
+    if (col < min_col || col >= max_col || row < min_row || row >= max_row) {
+      continue;
+    }
+    const int id = row * map_width_ + col;
+    if (point_nums_[id] == 0) {
+      cell_ids_.push_back(id);
+    }
+    ++point_nums_[id];
+    intensity_sums_[id] += intensities[i];
+    altitude_sums_[id] += static_cast<float>(point(2));
+  }
+
+  cell_intensities_.resize(cell_ids_.size());
+  cell_altitudes_.resize(cell_ids_.size());
+  for (size_t i = 0; i < cell_ids_.size(); ++i) {
+    const int id = cell_ids_[i];
+    const float point_num = static_cast<float>(point_nums_[id]);
+    cell_intensities_[i] = intensity_sums_[id] / point_num;
+    cell_altitudes_[i] = altitude_sums_[id] / point_num;
+    intensity_sums_[id] = 0.0f;
+    altitude_sums_[id] = 0.0f;
+    point_nums_[id] = 0;
+  }
+}
+
+void LidarMapMatcher::EvaluateOffsets(int step, int min_dx, int max_dx,
+                                      int min_dy, int max_dy) {
+  std::vector<std::pair<int, int>> offsets;
+  for (int dy = min_dy; dy <= max_dy; dy += step) {
+    for (int dx = min_dx; dx <= max_dx; dx += step) {
+      offsets.emplace_back(dx, dy);
+    }
+  }
+
+  const int range_x = 2 * search_half_x_ + 1;
+  const int offset_num = static_cast<int>(offsets.size());
+  const int num_workers = std::max(1, std::min(thread_num_, offset_num));
+  auto evaluate = [&](const int worker) {
+    for (int i = worker; i < offset_num; i += num_workers) {
+      const int dx = offsets[i].first;
+      const int dy = offsets[i].second;
+      const int index = (dy + search_half_y_) * range_x + dx + search_half_x_;
+      log_likelihoods_[index] = EvaluateOffset(dx, dy, &matched_nums_[index]);
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, evaluate, worker));
+  }
+  evaluate(0);
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+double LidarMapMatcher::EvaluateOffset(int dx, int dy,
+                                       int* matched_num) const {
+  const int shift = dy * map_width_ + dx;
+  const int cell_num = static_cast<int>(cell_ids_.size());
+  float intensity_sums[kLaneNum] = {0.0f};
+  float altitude_sums[kLaneNum] = {0.0f};
+  int matched_nums[kLaneNum] = {0};
+  auto accumulate = [&](const int i, const int lane) {
+    const int id = cell_ids_[i] + shift;
+    const bool is_matched = map_counts_[id] > 0;
+    const float valid = is_matched ? 1.0f : 0.0f;
+    const float intensity_diff = cell_intensities_[i] - map_intensities_[id];
+    intensity_sums[lane] += valid * intensity_diff * intensity_diff /
+                            (map_intensities_var_[id] + kIntensityVarPrior);
+    const float altitude_diff = cell_altitudes_[i] - map_altitudes_[id];
+    altitude_sums[lane] += valid * altitude_diff * altitude_diff;
+    matched_nums[lane] += is_matched;
+  };
+  int i = 0;
+  for (; i + kLaneNum <= cell_num; i += kLaneNum) {
+    for (int lane = 0; lane < kLaneNum; ++lane) {
+      accumulate(i + lane, lane);
+    }
+  }
+  for (; i < cell_num; ++i) {
+    accumulate(i, 0);
+  }
+
+  double intensity_sum = 0.0;
+  double altitude_sum = 0.0;
+  *matched_num = 0;
+  for (int lane = 0; lane < kLaneNum; ++lane) {
+    intensity_sum += intensity_sums[lane];
+    altitude_sum += altitude_sums[lane];
+    *matched_num += matched_nums[lane];
+  }
+  if (*matched_num == 0 ||
+      *matched_num < valid_threshold_ * static_cast<float>(cell_num)) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  const double cost =
+      (intensity_weight_ * intensity_sum +
+       (1.0 - intensity_weight_) * altitude_sum / kAltitudeVar) /
+      *matched_num;
+  return -0.5 * kLikelihoodScale * cost;
+}
+
+void LidarMapMatcher::FindBestOffset(int* best_dx, int* best_dy) const {
+  const int range_x = 2 * search_half_x_ + 1;
+  const int best_index = static_cast<int>(
+      std::max_element(log_likelihoods_.begin(), log_likelihoods_.end()) -
+      log_likelihoods_.begin());
+  *best_dx = best_index % range_x - search_half_x_;
+  *best_dy = best_index / range_x - search_half_y_;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file lidar_map_matcher.h
+ * @brief The open implementation of the lidar to map matching.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**
+ * @class LidarMapMatcher
+ *
+ * @brief Matches a point cloud to the composed map node over a search window
+ * of horizontal offsets, as the prebuilt LidarLocator does. The points are
+ * rasterized into map cells and, for every offset, the intensity and altitude
+ * differences with the map cells give the matching probability. The offsets
+ * are evaluated on several threads, optionally coarse-to-fine: every other
+ * offset of the window first, then every offset around the best one. The
+ * heading is not searched.
+ */
+class LidarMapMatcher {
+ public:
+  LidarMapMatcher() = default;
+
+  void Init(int search_range_x, int search_range_y, float resolution);
+
+  void SetVelodyneExtrinsic(const Eigen::Affine3d& extrinsic);
+
+  /**@brief The minimum ratio of the rasterized points matched to map cells. */
+  void SetValidThreshold(float valid_threshold);
+
+  /**@brief 0: intensity, 1: altitude, 2: fused. */
+  void SetLocalizationMode(int mode);
+
+  void SetThreadNum(int thread_num);
+
+  void SetCoarseToFine(bool coarse_to_fine);
+
+  /**@brief Set the composed map node, the arrays are not copied. */
+  void SetMapNodeData(int width, int height, const float* intensities,
+                      const float* intensities_var, const float* altitudes,
+                      const unsigned int* counts);
+
+  void SetMapNodeLeftTopCorner(double x, double y);
+
+  /**@brief Match the point cloud in the lidar frame around the predicted
+   * pose of the imu.
+   * @return 0:success, otherwise failed
+   */
+  int Compute(const Eigen::Affine3d& pose, const std::vector<double>& pt_xs,
+              const std::vector<double>& pt_ys,
+              const std::vector<double>& pt_zs,
+              const std::vector<unsigned char>& intensities);
+
+  const Eigen::Affine3d& GetLocationPose() const { return location_; }
+
+  const Eigen::Matrix3d& GetLocationCovariance() const { return covariance_; }
+
+  /**@brief The ratio of the rasterized points matched at the best offset. */
+  double GetLocationScore() const { return location_score_; }
+
+  /**@brief The probability of the offsets, search_range_y rows by
+   * search_range_x cols. */
+  const Eigen::MatrixXd& GetSSDDistribution() const { return distribution_; }
+
+ private:
+  void RasterizePoints(const Eigen::Affine3d& lidar_pose,
+                       const std::vector<double>& pt_xs,
+                       const std::vector<double>& pt_ys,
+                       const std::vector<double>& pt_zs,
+                       const std::vector<unsigned char>& intensities);
+
+  /**@brief Evaluate every step-th offset of the window part. */
+  void EvaluateOffsets(int step, int min_dx, int max_dx, int min_dy,
+                       int max_dy);
+
+  /**@brief The log likelihood of an offset, -inf when not enough cells are
+   * matched. */
+  double EvaluateOffset(int dx, int dy, int* matched_num) const;
+
+  void FindBestOffset(int* best_dx, int* best_dy) const;
+
+  int search_half_x_ = 10;
+  int search_half_y_ = 10;
+  float resolution_ = 0.125f;
+  Eigen::Affine3d velodyne_extrinsic_ = Eigen::Affine3d::Identity();
+  float valid_threshold_ = 0.0f;
+  float intensity_weight_ = 0.5f;
+  int thread_num_ = 1;
+  bool coarse_to_fine_ = false;
+
+  int map_width_ = 0;
+  int map_height_ = 0;
+  const float* map_intensities_ = nullptr;
+  const float* map_intensities_var_ = nullptr;
+  const float* map_altitudes_ = nullptr;
+  const unsigned int* map_counts_ = nullptr;
+  double map_left_top_x_ = 0.0;
+  double map_left_top_y_ = 0.0;
+
+  // the accumulation of the points, one entry per map cell
+  std::vector<float> intensity_sums_;
+  std::vector<float> altitude_sums_;
+  std::vector<unsigned int> point_nums_;
+
+  // the rasterized points, one entry per occupied cell
+  std::vector<int> cell_ids_;
+  std::vector<float> cell_intensities_;
+  std::vector<float> cell_altitudes_;
+
+  // indexed by (dy + search_half_y_) * search range x + dx + search_half_x_
+  std::vector<double> log_likelihoods_;
+  std::vector<int> matched_nums_;
+
+  Eigen::Affine3d location_ = Eigen::Affine3d::Identity();
+  Eigen::Matrix3d covariance_ = Eigen::Matrix3d::Zero();
+  double location_score_ = 0.0;
+  Eigen::MatrixXd distribution_;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
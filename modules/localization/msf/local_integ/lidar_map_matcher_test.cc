@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_integ/lidar_map_matcher.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LidarMapMatcherTestSuite : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const int cell_num = kMapSize * kMapSize;
+    intensities_.resize(cell_num);
+    intensities_var_.assign(cell_num, 1.0f);
+    altitudes_.assign(cell_num, 0.0f);
+    counts_.assign(cell_num, 1);
+    for (int row = 0; row < kMapSize; ++row) {
+      for (int col = 0; col < kMapSize; ++col) {
+        intensities_[row * kMapSize + col] = static_cast<float>(
+            128.0 + 100.0 * std::sin(col / 6.0) * std::cos(row / 9.0));
+      }
+    }
+
+    // the points seen from a pose which is off by the offset
+    for (int row = 20; row < kMapSize - 20; ++row) {
+      for (int col = 20; col < kMapSize - 20; ++col) {
+        pt_xs_.push_back((col - kOffsetX + 0.5) * kResolution);
+        pt_ys_.push_back((row - kOffsetY + 0.5) * kResolution);
+        pt_zs_.push_back(0.0);
+        point_intensities_.push_back(static_cast<unsigned char>(
+            std::round(intensities_[row * kMapSize + col])));
+      }
+    }
+
+    matcher_.Init(21, 21, kResolution);
+    matcher_.SetValidThreshold(0.5f);
+    matcher_.SetLocalizationMode(2);
+    matcher_.SetMapNodeData(kMapSize, kMapSize, intensities_.data(),
+                            intensities_var_.data(), altitudes_.data(),
+                            counts_.data());
+    matcher_.SetMapNodeLeftTopCorner(0.0, 0.0);
+  }
+
+  void ExpectOffsetFound() {
+    ASSERT_EQ(0, matcher_.Compute(Eigen::Affine3d::Identity(), pt_xs_, pt_ys_,
+                                  pt_zs_, point_intensities_));
+    const Eigen::Vector3d location =
+        matcher_.GetLocationPose().translation();
+    EXPECT_NEAR(kOffsetX * kResolution, location(0), 1e-3);
+    EXPECT_NEAR(kOffsetY * kResolution, location(1), 1e-3);
+    EXPECT_NEAR(1.0, matcher_.GetLocationScore(), 1e-6);
+    EXPECT_LT(matcher_.GetLocationCovariance()(0, 0), 1e-4);
+    const Eigen::MatrixXd& distribution = matcher_.GetSSDDistribution();
+    ASSERT_EQ(21, distribution.rows());
+    ASSERT_EQ(21, distribution.cols());
+    EXPECT_NEAR(1.0, distribution.sum(), 1e-6);
+    EXPECT_GT(distribution(10 + kOffsetY, 10 + kOffsetX), 0.99);
+  }
+
+  static constexpr int kMapSize = 128;
+  static constexpr int kOffsetX = 3;
+  static constexpr int kOffsetY = -2;
+  static constexpr float kResolution = 0.125f;
+
+  LidarMapMatcher matcher_;
+  std::vector<float> intensities_;
+  std::vector<float> intensities_var_;
+  std::vector<float> altitudes_;
+  std::vector<unsigned int> counts_;
+  std::vector<double> pt_xs_;
+  std::vector<double> pt_ys_;
+  std::vector<double> pt_zs_;
+  std::vector<unsigned char> point_intensities_;
+};
+
+constexpr int LidarMapMatcherTestSuite::kMapSize;
+constexpr int LidarMapMatcherTestSuite::kOffsetX;
+constexpr int LidarMapMatcherTestSuite::kOffsetY;
+constexpr float LidarMapMatcherTestSuite::kResolution;
+
+TEST_F(LidarMapMatcherTestSuite, Compute) { ExpectOffsetFound(); }
+
+TEST_F(LidarMapMatcherTestSuite, ComputeOnThreads) {
+  matcher_.SetThreadNum(4);
+  ExpectOffsetFound();
+}
+
+TEST_F(LidarMapMatcherTestSuite, ComputeCoarseToFine) {
+  matcher_.SetThreadNum(4);
+  matcher_.SetCoarseToFine(true);
+  ExpectOffsetFound();
+}
+
+TEST_F(LidarMapMatcherTestSuite, OutOfMap) {
+  matcher_.SetMapNodeLeftTopCorner(1000.0, 1000.0);
+  EXPECT_NE(0, matcher_.Compute(Eigen::Affine3d::Identity(), pt_xs_, pt_ys_,
+                                pt_zs_, point_intensities_));
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
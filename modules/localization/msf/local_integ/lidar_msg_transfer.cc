@@ -16,8 +16,8 @@
 
 #include "modules/localization/msf/local_integ/lidar_msg_transfer.h"
 
-#include "Eigen/Core"
-#include "Eigen/Geometry"
+#include <algorithm>
+#include <cmath>
 
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
@@ -27,53 +27,94 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+// 21 bits per axis, which covers the lidar range for any voxel size above a
+// millimeter
+uint64_t VoxelKey(const double x, const double y, const double z,
+                  const double voxel_size) {
+  auto coord = [voxel_size](const double value) {
+    return static_cast<uint64_t>(
+               static_cast<int64_t>(std::floor(value / voxel_size))) &
+           0x1fffff;
+  };
+  return coord(x) << 42 | coord(y) << 21 | coord(z);
+}
+}  // namespace
+
 void LidarMsgTransfer::Transfer(const drivers::PointCloud &msg,
                                 LidarFrame *lidar_frame) {
   CHECK_NOTNULL(lidar_frame);
 
+  int point_num = msg.point_size();
   if (msg.height() > 1 && msg.width() > 1) {
-    for (unsigned int i = 0; i < msg.height(); ++i) {
-      for (unsigned int j = 0; j < msg.width(); ++j) {
-        Eigen::Vector3d pt3d;
-        pt3d[0] = static_cast<double>(msg.point(i * msg.width() + j).x());
-        pt3d[1] = static_cast<double>(msg.point(i * msg.width() + j).y());
-        pt3d[2] = static_cast<double>(msg.point(i * msg.width() + j).z());
-        if (!std::isnan(pt3d[0])) {
-          Eigen::Vector3d pt3d_tem = pt3d;
-
-          if (pt3d_tem[2] > max_height_) {
-            continue;
-          }
-          unsigned char intensity = static_cast<unsigned char>(
-              msg.point(i * msg.width() + j).intensity());
-          lidar_frame->pt_xs.push_back(pt3d[0]);
-          lidar_frame->pt_ys.push_back(pt3d[1]);
-          lidar_frame->pt_zs.push_back(pt3d[2]);
-          lidar_frame->intensities.push_back(intensity);
-        }
-      }
-    }
+    point_num = std::min(point_num,
+                         static_cast<int>(msg.height() * msg.width()));
   } else {
     AINFO << "Receiving un-origanized-point-cloud, width " << msg.width()
           << " height " << msg.height() << "size " << msg.point_size();
-    for (int i = 0; i < msg.point_size(); ++i) {
-      Eigen::Vector3d pt3d;
-      pt3d[0] = static_cast<double>(msg.point(i).x());
-      pt3d[1] = static_cast<double>(msg.point(i).y());
-      pt3d[2] = static_cast<double>(msg.point(i).z());
-      if (!std::isnan(pt3d[0])) {
-        Eigen::Vector3d pt3d_tem = pt3d;
+  }
+
+  const double voxel_size = FLAGS_lidar_voxel_size;
+  const bool downsample = voxel_size > 0.0;
+  if (downsample) {
+    voxel_indices_.clear();
+    voxel_intensity_sums_.clear();
+    voxel_point_nums_.clear();
+  } else {
+    lidar_frame->pt_xs.reserve(point_num);
+    lidar_frame->pt_ys.reserve(point_num);
+    lidar_frame->pt_zs.reserve(point_num);
+    lidar_frame->intensities.reserve(point_num);
+  }
+
+  for (int i = 0; i < point_num; ++i) {
+    const auto &point = msg.point(i);
+    const double x = static_cast<double>(point.x());
+    const double y = static_cast<double>(point.y());
+    const double z = static_cast<double>(point.z());
+    if (std::isnan(x) || z > max_height_) {
+      continue;
+    }
+    if (!downsample) {
+      lidar_frame->pt_xs.push_back(x);
+      lidar_frame->pt_ys.push_back(y);
+      lidar_frame->pt_zs.push_back(z);
+      lidar_frame->intensities.push_back(
+          static_cast<unsigned char>(point.intensity()));
+      continue;
+    }
+
+    const uint64_t key = VoxelKey(x, y, z, voxel_size);
+    const auto result = voxel_indices_.emplace(
+        key, static_cast<int>(voxel_point_nums_.size()));
+    if (result.second) {
+      lidar_frame->pt_xs.push_back(x);
+      lidar_frame->pt_ys.push_back(y);
+      lidar_frame->pt_zs.push_back(z);
+      voxel_intensity_sums_.push_back(
+          static_cast<unsigned char>(point.intensity()));
+      voxel_point_nums_.push_back(1);
+    } else {
+      const int index = result.first->second;
+      lidar_frame->pt_xs[index] += x;
+      lidar_frame->pt_ys[index] += y;
+      lidar_frame->pt_zs[index] += z;
+      voxel_intensity_sums_[index] +=
+          static_cast<unsigned char>(point.intensity());
+      ++voxel_point_nums_[index];
+    }
+  }
 
-        if (pt3d_tem[2] > max_height_) {
-          continue;
-        }
-        unsigned char intensity =
-            static_cast<unsigned char>(msg.point(i).intensity());
-        lidar_frame->pt_xs.push_back(pt3d[0]);
-        lidar_frame->pt_ys.push_back(pt3d[1]);
-        lidar_frame->pt_zs.push_back(pt3d[2]);
-        lidar_frame->intensities.push_back(intensity);
-      }
+  if (downsample) {
+    const size_t voxel_num = voxel_point_nums_.size();
+    lidar_frame->intensities.resize(voxel_num);
+    for (size_t i = 0; i < voxel_num; ++i) {
+      const double point_num_inv = 1.0 / voxel_point_nums_[i];
+      lidar_frame->pt_xs[i] *= point_num_inv;
+      lidar_frame->pt_ys[i] *= point_num_inv;
+      lidar_frame->pt_zs[i] *= point_num_inv;
+      lidar_frame->intensities[i] = static_cast<unsigned char>(
+          voxel_intensity_sums_[i] / voxel_point_nums_[i]);
     }
   }
 
@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
@@ -36,11 +39,20 @@ class LidarMsgTransfer {
  public:
   LidarMsgTransfer() = default;
 
+  /**
+   * @brief convert the point cloud, and average the points falling in the
+   *        same voxel when FLAGS_lidar_voxel_size is positive
+   */
   void Transfer(
       const drivers::PointCloud &message, LidarFrame *lidar_frame);
 
  protected:
   double max_height_ = 100.0;
+
+  // reused across the frames, the index of the point of each voxel
+  std::unordered_map<uint64_t, int> voxel_indices_;
+  std::vector<unsigned int> voxel_intensity_sums_;
+  std::vector<unsigned int> voxel_point_nums_;
 };
 
 }  // namespace msf
@@ -42,8 +42,7 @@ Status LocalizationInteg::Init(const LocalizationIntegParam &params) {
 
 void LocalizationInteg::PcdProcess(const drivers::PointCloud &message) {
   LidarFrame lidar_frame;
-  LidarMsgTransfer transfer;
-  transfer.Transfer(message, &lidar_frame);
+  lidar_msg_transfer_.Transfer(message, &lidar_frame);
   localization_integ_impl_->PcdProcess(lidar_frame);
   return;
 }
@@ -101,6 +100,10 @@ const LocalizationResult& LocalizationInteg::
   return localization_integ_impl_->GetLastestGnssLocalization();
 }
 
+MapNodeLoadStats LocalizationInteg::GetMapNodeLoadStats() const {
+  return localization_integ_impl_->GetMapNodeLoadStats();
+}
+
 void LocalizationInteg::TransferImuRfu(const drivers::gnss::Imu &imu_msg,
                                        ImuData *imu_rfu) {
   CHECK_NOTNULL(imu_rfu);
@@ -29,6 +29,7 @@
 #include "modules/drivers/gnss/proto/heading.pb.h"
 #include "modules/drivers/gnss/proto/imu.pb.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/localization/msf/local_integ/lidar_msg_transfer.h"
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 #include "modules/localization/msf/local_integ/localization_params.h"
 #include "modules/localization/proto/localization.pb.h"
@@ -75,6 +76,10 @@ class LocalizationInteg {
   const LocalizationResult& GetLastestIntegLocalization() const;
   const LocalizationResult& GetLastestGnssLocalization() const;
 
+  /**@brief The map nodes the lidar localization loaded since the start, and
+   * the time it waited for them. */
+  MapNodeLoadStats GetMapNodeLoadStats() const;
+
  protected:
   void TransferImuFlu(const drivers::gnss::Imu &imu_msg, ImuData *imu_data);
 
@@ -82,6 +87,7 @@ class LocalizationInteg {
 
  private:
   LocalizationIntegImpl *localization_integ_impl_;
+  LidarMsgTransfer lidar_msg_transfer_;
 };
 
 }  // namespace msf
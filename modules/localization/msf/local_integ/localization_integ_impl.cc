@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_integ_impl.h"
 
+#include <chrono>
+
 #include "cyber/common/log.h"
 #include "modules/common/time/timer.h"
 #include "modules/localization/msf/common/util/frame_transform.h"
@@ -26,6 +28,11 @@ namespace msf {
 
 using common::Status;
 
+namespace {
+// log the imu to pose latency every kLatencyLogInterval imu messages
+constexpr uint64_t kLatencyLogInterval = 2000;
+}  // namespace
+
 LocalizationIntegImpl::LocalizationIntegImpl()
     : republish_process_(new MeasureRepublishProcess()),
       integ_process_(new LocalizationIntegProcess()),
@@ -133,7 +140,7 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   // imu -> lidar
   // imu -> integ -> republish -> lidar -> publish
 
-  // start_time = boost::posix_time::microsec_clock::local_time();
+  const auto start_time = std::chrono::steady_clock::now();
   if (enable_lidar_localization_) {
     lidar_process_->RawImuProcess(imu_data);
   }
@@ -203,6 +210,14 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
       LocalizationMeasureState(static_cast<int>(state)),
       integ_localization, integ_status);
 
+  imu_to_pose_latency_.Record(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_time)
+          .count());
+  if (imu_to_pose_latency_.Count() % kLatencyLogInterval == 0) {
+    ADEBUG << "Imu to pose latency (us): " << imu_to_pose_latency_.ToString();
+  }
+
   InsPva integ_sins_pva;
   double covariance[9][9];
   integ_process_->GetResult(&state, &integ_sins_pva, covariance);
@@ -384,6 +399,10 @@ const LocalizationResult& LocalizationIntegImpl::
   return lastest_gnss_localization_;
 }
 
+MapNodeLoadStats LocalizationIntegImpl::GetMapNodeLoadStats() const {
+  return lidar_process_->GetMapNodeLoadStats();
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
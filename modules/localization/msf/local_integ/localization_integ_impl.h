@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "cyber/base/histogram.h"
 #include "modules/common/status/status.h"
 #include "modules/localization/msf/local_integ/localization_gnss_process.h"
 #include "modules/localization/msf/local_integ/localization_integ.h"
@@ -77,6 +78,8 @@ class LocalizationIntegImpl {
 
   const LocalizationResult& GetLastestGnssLocalization() const;
 
+  MapNodeLoadStats GetMapNodeLoadStats() const;
+
  protected:
   void PcdProcessImpl(const LidarFrame& pcd_data);
 
@@ -112,6 +115,9 @@ class LocalizationIntegImpl {
   bool enable_lidar_localization_ = true;
   Eigen::Affine3d gnss_antenna_extrinsic_;
   OnlineLocalizationExpert expert_;
+
+  // time from an imu message to its pose, in microseconds
+  cyber::base::Histogram imu_to_pose_latency_;
 };
 
 }  // namespace msf
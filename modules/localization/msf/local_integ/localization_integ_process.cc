@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_integ_process.h"
 
+#include <chrono>
+
 #include "yaml-cpp/yaml.h"
 
 #include "cyber/common/log.h"
@@ -29,6 +31,17 @@ namespace msf {
 
 using apollo::common::Status;
 
+namespace {
+// log the measure wait time every kWaitTimeLogInterval measures
+constexpr uint64_t kWaitTimeLogInterval = 1000;
+
+uint64_t SteadyTimeInMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 LocalizationIntegProcess::LocalizationIntegProcess()
     : sins_(new Sins()),
       gnss_antenna_extrinsic_(TransformD::Identity()),
@@ -37,7 +50,9 @@ LocalizationIntegProcess::LocalizationIntegProcess()
       pva_covariance_{0.0},
       keep_running_(false),
       measure_data_queue_size_(150),
-      delay_output_counter_(0) {}
+      delay_output_counter_(0) {
+  measure_data_queue_.Init(measure_data_queue_size_);
+}
 
 LocalizationIntegProcess::~LocalizationIntegProcess() {
   StopThreadLoop();
@@ -243,9 +258,14 @@ void LocalizationIntegProcess::GetResult(IntegState *state, InsPva *sins_pva,
 
 void LocalizationIntegProcess::MeasureDataProcess(
     const MeasureData &measure_msg) {
-  measure_data_queue_mutex_.lock();
-  measure_data_queue_.push(measure_msg);
-  measure_data_queue_mutex_.unlock();
+  QueuedMeasureData queued_measure;
+  queued_measure.measure = measure_msg;
+  queued_measure.enqueue_time = SteadyTimeInMicroseconds();
+  // the oldest measures are dropped when the queue is full
+  QueuedMeasureData dropped_measure;
+  while (!measure_data_queue_.Enqueue(queued_measure)) {
+    measure_data_queue_.Dequeue(&dropped_measure);
+  }
 }
 
 void LocalizationIntegProcess::StartThreadLoop() {
@@ -263,34 +283,29 @@ void LocalizationIntegProcess::StopThreadLoop() {
 void LocalizationIntegProcess::MeasureDataThreadLoop() {
   AINFO << "Started measure data process thread";
   while (keep_running_.load()) {
-    {
-      std::unique_lock<std::mutex> lock(measure_data_queue_mutex_);
-      int size = static_cast<int>(measure_data_queue_.size());
-      while (size > measure_data_queue_size_) {
-        measure_data_queue_.pop();
-        --size;
-      }
-      if (measure_data_queue_.size() == 0) {
-        lock.unlock();
-        cyber::Yield();
-        continue;
-      }
+    QueuedMeasureData queued_measure;
+    int size = static_cast<int>(measure_data_queue_.Size());
+    while (size > measure_data_queue_size_ &&
+           measure_data_queue_.Dequeue(&queued_measure)) {
+      --size;
     }
-
-    MeasureData measure;
-    int waiting_num = 0;
-    {
-      std::unique_lock<std::mutex> lock(measure_data_queue_mutex_);
-      measure = measure_data_queue_.front();
-      measure_data_queue_.pop();
-      waiting_num = static_cast<int>(measure_data_queue_.size());
+    if (!measure_data_queue_.Dequeue(&queued_measure)) {
+      cyber::Yield();
+      continue;
     }
+    int waiting_num = static_cast<int>(measure_data_queue_.Size());
 
     if (waiting_num > measure_data_queue_size_ / 4) {
       AWARN << waiting_num << " measure are waiting to process.";
     }
 
-    MeasureDataProcessImpl(measure);
+    measure_wait_time_.Record(SteadyTimeInMicroseconds() -
+                              queued_measure.enqueue_time);
+    if (measure_wait_time_.Count() % kWaitTimeLogInterval == 0) {
+      ADEBUG << "Measure wait time (us): " << measure_wait_time_.ToString();
+    }
+
+    MeasureDataProcessImpl(queued_measure.measure);
   }
   AINFO << "Exited measure data process thread";
 }
@@ -16,11 +16,12 @@
 
 #pragma once
 
-#include <queue>
 #include <string>
 
 #include "Eigen/Core"
 #include "Eigen/Geometry"
+#include "cyber/base/histogram.h"
+#include "cyber/base/mpmc_queue.h"
 #include "cyber/cyber.h"
 
 #include "include/sins.h"
@@ -89,10 +90,18 @@ class LocalizationIntegProcess {
   InsPva ins_pva_;
   double pva_covariance_[9][9];
 
+  struct QueuedMeasureData {
+    MeasureData measure;
+    // steady clock, in microseconds
+    uint64_t enqueue_time = 0;
+  };
+
   std::atomic<bool> keep_running_;
-  std::queue<MeasureData> measure_data_queue_;
+  // filled by the lidar and gnss threads, drained by the measure thread
+  cyber::base::MPMCQueue<QueuedMeasureData> measure_data_queue_;
   int measure_data_queue_size_ = 150;
-  std::mutex measure_data_queue_mutex_;
+  // time the measures wait in the queue, in microseconds
+  cyber::base::Histogram measure_wait_time_;
 
   int delay_output_counter_ = 0;
 };
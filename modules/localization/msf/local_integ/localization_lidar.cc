@@ -78,6 +78,8 @@ bool LocalizationLidar::Init(const std::string& map_path,
   lidar_locator_->Init(search_range_x_, search_range_y_,
                        static_cast<float>(resolution_), node_size_x_,
                        node_size_y_);
+  lidar_matcher_.Init(search_range_x_, search_range_y_,
+                      static_cast<float>(resolution_));
   return true;
 }
 
@@ -88,6 +90,7 @@ void LocalizationLidar::SetVelodyneExtrinsic(const Eigen::Affine3d& pose) {
 
   lidar_locator_->SetVelodyneExtrinsic(trans.x(), trans.y(), trans.z(),
                                        quat.x(), quat.y(), quat.z(), quat.w());
+  lidar_matcher_.SetVelodyneExtrinsic(pose);
   return;
 }
 
@@ -99,6 +102,7 @@ void LocalizationLidar::SetVehicleHeight(double height) {
 
 void LocalizationLidar::SetValidThreshold(float valid_threashold) {
   lidar_locator_->SetValidThreshold(valid_threashold);
+  lidar_matcher_.SetValidThreshold(valid_threashold);
   return;
 }
 
@@ -109,6 +113,7 @@ void LocalizationLidar::SetImageAlignMode(int mode) {
 
 void LocalizationLidar::SetLocalizationMode(int mode) {
   lidar_locator_->SetLocalizationMode(mode);
+  lidar_matcher_.SetLocalizationMode(mode);
   return;
 }
 
@@ -120,6 +125,21 @@ void LocalizationLidar::SetDeltaPitchRollLimit(double limit) {
   lidar_locator_->SetDeltaPitchRollLimit(limit);
 }
 
+void LocalizationLidar::SetMapPreloadTime(double preload_time) {
+  map_.SetPreloadTimeHorizon(preload_time);
+}
+
+void LocalizationLidar::SetPlanarMapLayers(bool planar_layers) {
+  map_node_pool_.SetPlanarLayers(planar_layers);
+}
+
+void LocalizationLidar::SetOpenMatcher(bool use_open_matcher, int thread_num,
+                                       bool coarse_to_fine) {
+  use_open_matcher_ = use_open_matcher;
+  lidar_matcher_.SetThreadNum(thread_num);
+  lidar_matcher_.SetCoarseToFine(coarse_to_fine);
+}
+
 int LocalizationLidar::Update(const unsigned int frame_idx,
                               const Eigen::Affine3d& pose,
                               const Eigen::Vector3d velocity,
@@ -140,6 +160,11 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   Eigen::Quaterniond pose_quat(imu_pose.linear());
   pose_quat.normalize();
   map_.LoadMapArea(pose_trans, resolution_id_, zone_id_, 0, 0);
+  const auto load_stats = map_.GetMapNodeLoadStats();
+  ADEBUG << "Map node loads, l1 hit: " << load_stats.l1_hit_num
+         << ", l2 hit: " << load_stats.l2_hit_num
+         << ", miss: " << load_stats.miss_num
+         << ", stall time: " << load_stats.stall_time;
 
   // preload map for next locate
   map_.PreloadMapArea(pose_trans, velocity, resolution_id_, zone_id_);
@@ -147,6 +172,19 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   // generate composed map for compare
   ComposeMapNode(pose_trans);
 
+  if (use_open_matcher_) {
+    lidar_matcher_.SetMapNodeData(
+        lidar_map_node_->width, lidar_map_node_->height,
+        lidar_map_node_->intensities, lidar_map_node_->intensities_var,
+        lidar_map_node_->altitudes, lidar_map_node_->count);
+    lidar_matcher_.SetMapNodeLeftTopCorner(map_left_top_corner_(0),
+                                           map_left_top_corner_(1));
+    Eigen::Affine3d matcher_pose = Eigen::Translation3d(pose_trans) * pose_quat;
+    return lidar_matcher_.Compute(matcher_pose, lidar_frame.pt_xs,
+                                  lidar_frame.pt_ys, lidar_frame.pt_zs,
+                                  lidar_frame.intensities);
+  }
+
   // pass map node to locator
   int node_width = lidar_map_node_->width;
   int node_height = lidar_map_node_->height;
@@ -178,6 +216,13 @@ void LocalizationLidar::GetResult(Eigen::Affine3d* location,
   if (!location || !covariance) {
     return;
   }
+  if (use_open_matcher_) {
+    *location = lidar_matcher_.GetLocationPose();
+    RefineAltitudeFromMap(location);
+    *covariance = lidar_matcher_.GetLocationCovariance();
+    *location_score = lidar_matcher_.GetLocationScore();
+    return;
+  }
   double x = 0.0;
   double y = 0.0;
   double z = 0.0;
@@ -214,6 +259,11 @@ void LocalizationLidar::GetLocalizationDistribution(
     Eigen::MatrixXd* distribution) {
   CHECK_NOTNULL(distribution);
 
+  if (use_open_matcher_) {
+    *distribution = lidar_matcher_.GetSSDDistribution();
+    return;
+  }
+
   int width = 0;
   int height = 0;
   const double* data = nullptr;
@@ -230,6 +280,10 @@ void LocalizationLidar::GetLocalizationDistribution(
   return;
 }
 
+MapNodeLoadStats LocalizationLidar::GetMapNodeLoadStats() {
+  return map_.GetMapNodeLoadStats();
+}
+
 void LocalizationLidar::RefineAltitudeFromMap(Eigen::Affine3d* pose) {
   CHECK_NOTNULL(pose);
 
@@ -254,12 +308,13 @@ void LocalizationLidar::RefineAltitudeFromMap(Eigen::Affine3d* pose) {
   unsigned int x = 0;
   unsigned int y = 0;
   if (node->GetCoordinate(lidar_trans, &x, &y)) {
-    unsigned int count = matrix[y][x].count;
-    if (count > 0) {
-      if (matrix[y][x].is_ground_useful) {
-        vehicle_ground_alt = matrix[y][x].altitude_ground;
+    LossyMapCell cell;
+    matrix.GetCell(y, x, &cell);
+    if (cell.count > 0) {
+      if (cell.is_ground_useful) {
+        vehicle_ground_alt = cell.altitude_ground;
       } else {
-        vehicle_ground_alt = matrix[y][x].altitude;
+        vehicle_ground_alt = cell.altitude;
       }
     } else {
       vehicle_ground_alt = static_cast<float>(pre_vehicle_ground_height_);
@@ -355,14 +410,11 @@ void LocalizationLidar::ComposeMapNode(const Eigen::Vector3d& trans) {
           static_cast<LossyMapMatrix&>(map_node[i][j]->GetMapCellMatrix());
       for (int y = 0; y < range_y; ++y) {
         int dst_base_x = (dst_y + y) * node_size_x_ + dst_x;
-        for (int x = 0; x < range_x; ++x) {
-          auto& cell = map_cells[src_y + y][src_x + x];
-          int dst_idx = dst_base_x + x;
-          lidar_map_node_->intensities[dst_idx] = cell.intensity;
-          lidar_map_node_->intensities_var[dst_idx] = cell.intensity_var;
-          lidar_map_node_->altitudes[dst_idx] = cell.altitude;
-          lidar_map_node_->count[dst_idx] = cell.count;
-        }
+        map_cells.GetCellsInRow(src_y + y, src_x, range_x,
+                                lidar_map_node_->intensities + dst_base_x,
+                                lidar_map_node_->intensities_var + dst_base_x,
+                                lidar_map_node_->altitudes + dst_base_x,
+                                lidar_map_node_->count + dst_base_x);
       }
     }
   }
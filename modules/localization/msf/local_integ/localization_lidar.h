@@ -21,6 +21,7 @@
 
 #include "cyber/common/log.h"
 #include "include/lidar_locator.h"
+#include "modules/localization/msf/local_integ/lidar_map_matcher.h"
 #include "modules/localization/msf/local_integ/localization_params.h"
 #include "modules/localization/msf/local_map/base_map/base_map_node_index.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_2d.h"
@@ -101,6 +102,17 @@ class LocalizationLidar {
 
   void SetDeltaPitchRollLimit(double limit);
 
+  void SetMapPreloadTime(double preload_time);
+
+  /**@brief Keep the map nodes as planar quantized layers, to be set before
+   * Init(). */
+  void SetPlanarMapLayers(bool planar_layers);
+
+  /**@brief Match with LidarMapMatcher instead of the prebuilt LidarLocator.
+   */
+  void SetOpenMatcher(bool use_open_matcher, int thread_num,
+                      bool coarse_to_fine);
+
   int Update(const unsigned int frame_idx, const Eigen::Affine3d& pose,
              const Eigen::Vector3d velocity, const LidarFrame& lidar_frame,
              bool use_avx = false);
@@ -110,6 +122,8 @@ class LocalizationLidar {
 
   void GetLocalizationDistribution(Eigen::MatrixXd* distribution);
 
+  MapNodeLoadStats GetMapNodeLoadStats();
+
  protected:
   void ComposeMapNode(const Eigen::Vector3d& trans);
 
@@ -117,6 +131,8 @@ class LocalizationLidar {
 
  protected:
   LidarLocator* lidar_locator_;
+  LidarMapMatcher lidar_matcher_;
+  bool use_open_matcher_ = false;
   int search_range_x_ = 0;
   int search_range_y_ = 0;
   int node_size_x_ = 0;
@@ -81,6 +81,11 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   yaw_align_mode_ = params.lidar_yaw_align_mode;
   utm_zone_id_ = params.utm_zone_id;
   map_coverage_theshold_ = params.map_coverage_theshold;
+  map_preload_time_ = params.map_preload_time;
+  map_planar_layers_ = params.map_planar_layers;
+  use_open_lidar_matcher_ = params.use_open_lidar_matcher;
+  lidar_matcher_thread_num_ = params.lidar_matcher_thread_num;
+  lidar_matcher_coarse_to_fine_ = params.lidar_matcher_coarse_to_fine;
   imu_lidar_max_delay_time_ = params.imu_lidar_max_delay_time;
 
   lidar_filter_size_ = params.lidar_filter_size;
@@ -124,6 +129,7 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
     lidar_height_.height = params.lidar_height_default;
   }
 
+  locator_->SetPlanarMapLayers(map_planar_layers_);
   if (!locator_->Init(map_path_, lidar_filter_size_, lidar_filter_size_,
                       utm_zone_id_)) {
     local_lidar_status_ = LocalLidarStatus::MSF_LOCAL_LIDAR_MAP_LOADING_FAILED;
@@ -132,6 +138,9 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   }
 
   locator_->SetVelodyneExtrinsic(lidar_extrinsic_);
+  locator_->SetMapPreloadTime(map_preload_time_);
+  locator_->SetOpenMatcher(use_open_lidar_matcher_, lidar_matcher_thread_num_,
+                           lidar_matcher_coarse_to_fine_);
   locator_->SetLocalizationMode(localization_mode_);
   locator_->SetImageAlignMode(yaw_align_mode_);
   locator_->SetValidThreshold(static_cast<float>(map_coverage_theshold_));
@@ -274,6 +283,10 @@ void LocalizationLidarProcess::RawImuProcess(const ImuData& imu_msg) {
   return;
 }
 
+MapNodeLoadStats LocalizationLidarProcess::GetMapNodeLoadStats() const {
+  return locator_->GetMapNodeLoadStats();
+}
+
 bool LocalizationLidarProcess::GetPredictPose(const double lidar_time,
                                               TransformD* predict_pose,
                                               ForcastState* forcast_state) {
@@ -86,6 +86,8 @@ class LocalizationLidarProcess {
   void IntegPvaProcess(const InsPva &sins_pva_msg);
   // Raw Imu process.
   void RawImuProcess(const ImuData &imu_msg);
+  // The map nodes loaded since the start.
+  MapNodeLoadStats GetMapNodeLoadStats() const;
 
  private:
   // Sub-functions for process.
@@ -121,6 +123,11 @@ class LocalizationLidarProcess {
   double compensate_pitch_roll_limit_ = 0.035;
   int utm_zone_id_ = 50;
   double map_coverage_theshold_ = 0.8;
+  double map_preload_time_ = 0.0;
+  bool map_planar_layers_ = false;
+  bool use_open_lidar_matcher_ = false;
+  int lidar_matcher_thread_num_ = 1;
+  bool lidar_matcher_coarse_to_fine_ = false;
   TransformD lidar_extrinsic_;
   LidarHeight lidar_height_;
 
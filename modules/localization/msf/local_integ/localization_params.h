@@ -85,6 +85,11 @@ struct LocalizationIntegParam {
   int lidar_yaw_align_mode = 2;
   int lidar_filter_size = 17;
   double map_coverage_theshold = 0.8;
+  double map_preload_time = 0.0;
+  bool map_planar_layers = false;
+  bool use_open_lidar_matcher = false;
+  int lidar_matcher_thread_num = 1;
+  bool lidar_matcher_coarse_to_fine = false;
   double imu_lidar_max_delay_time = 0.4;
   int utm_zone_id = 50;
   bool is_lidar_unstable_reset = true;
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_map/base_map/base_map.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -113,6 +115,7 @@ void BaseMap::AddDataset(const std::string dataset_path) {
 
 void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   CHECK_LE(static_cast<int>(map_ids->size()), map_node_cache_lvl1_->Capacity());
+  const unsigned int node_num = static_cast<unsigned int>(map_ids->size());
   // check in cacheL1
   typename std::set<MapNodeIndex>::iterator itr = map_ids->begin();
   while (itr != map_ids->end()) {
@@ -128,6 +131,8 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   }
 
   // check in cacheL2
+  const unsigned int l1_hit_num =
+      node_num - static_cast<unsigned int>(map_ids->size());
   itr = map_ids->begin();
   BaseMapNode* node = nullptr;
   boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
@@ -141,9 +146,14 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
       ++itr;
     }
   }
+  map_node_load_stats_.l1_hit_num += l1_hit_num;
+  map_node_load_stats_.l2_hit_num +=
+      node_num - l1_hit_num - static_cast<unsigned int>(map_ids->size());
+  map_node_load_stats_.miss_num += static_cast<unsigned int>(map_ids->size());
   lock.unlock();
 
   // load from disk sync
+  const auto stall_start_time = std::chrono::steady_clock::now();
   std::vector<std::future<void>> load_futures;
   itr = map_ids->begin();
   while (itr != map_ids->end()) {
@@ -158,10 +168,15 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
       future.get();
     }
   }
+  const std::chrono::duration<double> stall_time =
+      std::chrono::steady_clock::now() - stall_start_time;
   // check in cacheL2 again
   itr = map_ids->begin();
   node = nullptr;
   boost::unique_lock<boost::recursive_mutex> lock2(map_load_mutex_);
+  if (!load_futures.empty()) {
+    map_node_load_stats_.stall_time += stall_time.count();
+  }
   while (itr != map_ids->end()) {
     if (map_node_cache_lvl2_->Get(*itr, &node)) {
       AINFO << "LoadMapNodes: preload missed, load this node in main thread.\n"
@@ -226,6 +241,49 @@ void BaseMap::PreloadMapNodes(std::set<MapNodeIndex>* map_ids) {
   return;
 }
 
+void BaseMap::PreloadPredictedMapNodes(const Eigen::Vector3d& location,
+                                       const Eigen::Vector3d& velocity,
+                                       unsigned int resolution_id,
+                                       unsigned int zone_id,
+                                       const std::set<MapNodeIndex>& area_ids,
+                                       int max_node_num) {
+  const double map_pixel_resolution =
+      this->map_config_->map_resolutions_[resolution_id];
+  const double node_length =
+      std::min(this->map_config_->map_node_size_x_,
+               this->map_config_->map_node_size_y_) *
+      map_pixel_resolution;
+  const Eigen::Vector3d displacement =
+      Eigen::Vector3d(velocity[0], velocity[1], 0.0) * preload_time_horizon_;
+  const double distance = displacement.norm();
+  if (distance < node_length || max_node_num <= 0) {
+    return;
+  }
+  // sampled every half node so that no node on the path is skipped, and
+  // preloaded one at a time so that the loaders take the nearest first
+  std::set<MapNodeIndex> predicted_ids;
+  const int sample_num = static_cast<int>(distance / (node_length * 0.5));
+  for (int i = 1; i <= sample_num &&
+                  static_cast<int>(predicted_ids.size()) < max_node_num;
+       ++i) {
+    Eigen::Vector3d pt =
+        location + displacement * (static_cast<double>(i) / sample_num);
+    pt[2] = 0;
+    const MapNodeIndex map_id = MapNodeIndex::GetMapNodeIndex(
+        *(this->map_config_), pt, resolution_id, zone_id);
+    if (area_ids.count(map_id) > 0 || !predicted_ids.insert(map_id).second) {
+      continue;
+    }
+    std::set<MapNodeIndex> map_ids = {map_id};
+    this->PreloadMapNodes(&map_ids);
+  }
+}
+
+MapNodeLoadStats BaseMap::GetMapNodeLoadStats() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  return map_node_load_stats_;
+}
+
 void BaseMap::AttachMapNodePool(BaseMapNodePool* map_node_pool) {
   map_node_pool_ = map_node_pool;
 }
@@ -399,7 +457,13 @@ void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
     map_ids.insert(map_id);
   }
 
+  const std::set<MapNodeIndex> area_ids = map_ids;
   this->PreloadMapNodes(&map_ids);
+  if (preload_time_horizon_ > 0.0) {
+    PreloadPredictedMapNodes(
+        location, trans_diff, resolution_id, zone_id, area_ids,
+        map_node_cache_lvl2_->Capacity() - static_cast<int>(area_ids.size()));
+  }
   return;
 }
 
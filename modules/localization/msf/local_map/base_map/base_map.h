@@ -31,6 +31,18 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
+/**@brief The statistics of the map nodes needed by LoadMapArea. */
+struct MapNodeLoadStats {
+  /**@brief The nodes already used by the last frame. */
+  unsigned int l1_hit_num = 0;
+  /**@brief The nodes found preloaded. */
+  unsigned int l2_hit_num = 0;
+  /**@brief The nodes loaded from the disk while the frame waits. */
+  unsigned int miss_num = 0;
+  /**@brief The time in seconds the frames waited for the disk. */
+  double stall_time = 0.0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -63,6 +75,12 @@ class BaseMap {
   virtual void PreloadMapArea(const Eigen::Vector3d& location,
                               const Eigen::Vector3d& trans_diff,
                               unsigned int resolution_id, unsigned int zone_id);
+  /**@brief Set how many seconds ahead PreloadMapArea also preloads the nodes
+   * along the path predicted from the velocity given as its trans_diff, the
+   * nearest nodes first. 0 disables the prediction. */
+  void SetPreloadTimeHorizon(double time_horizon) {
+    preload_time_horizon_ = time_horizon;
+  }
   /**@brief Load map nodes for the location calculate of this frame.
    * If the forecasts are correct in last frame, these nodes will be all in
    * cache, if not, then need to create loading tasks, and wait for the loading
@@ -72,6 +90,9 @@ class BaseMap {
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
 
+  /**@brief Get the statistics of the map nodes needed by LoadMapArea. */
+  MapNodeLoadStats GetMapNodeLoadStats();
+
   /**@brief Attach map node pointer. */
   void AttachMapNodePool(BaseMapNodePool* p_map_node_pool);
 
@@ -98,6 +119,14 @@ class BaseMap {
   void LoadMapNodes(std::set<MapNodeIndex>* map_ids);
   /**@brief Load map node by index.*/
   void PreloadMapNodes(std::set<MapNodeIndex>* map_ids);
+  /**@brief Preload the nodes along the path predicted from the velocity,
+   * with at most max_node_num nodes. */
+  void PreloadPredictedMapNodes(const Eigen::Vector3d& location,
+                                const Eigen::Vector3d& velocity,
+                                unsigned int resolution_id,
+                                unsigned int zone_id,
+                                const std::set<MapNodeIndex>& area_ids,
+                                int max_node_num);
   /**@brief Load map node by index, thread_safety. */
   void LoadMapNodeThreadSafety(MapNodeIndex index, bool is_reserved = false);
 
@@ -116,6 +145,10 @@ class BaseMap {
   std::set<MapNodeIndex> map_preloading_task_index_;
   /**@brief The mutex for preload map node. **/
   boost::recursive_mutex map_load_mutex_;
+  /**@brief The seconds of the predicted path preloaded. */
+  double preload_time_horizon_ = 0.0;
+  /**@brief The load statistics, guarded by map_load_mutex_. */
+  MapNodeLoadStats map_node_load_stats_;
 };
 
 }  // namespace msf
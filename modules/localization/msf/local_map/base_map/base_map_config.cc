@@ -31,6 +31,7 @@ BaseMapConfig::BaseMapConfig(std::string map_version) {
   map_range_ = Rect2D<double>(0, 0, 1000448.0, 10000384.0);  // in meters
 
   map_version_ = map_version;
+  map_compression_codec_ = "zlib";
   map_folder_path_ = ".";
 }
 
@@ -67,6 +68,7 @@ void BaseMapConfig::CreateXml(boost::property_tree::ptree* config) const {
   config->put("map.map_config.range.max_x", map_range_.GetMaxX());
   config->put("map.map_config.range.max_y", map_range_.GetMaxY());
   config->put("map.map_config.compression", map_is_compression_);
+  config->put("map.map_config.compression_codec", map_compression_codec_);
   config->put("map.map_runtime.map_ground_height_offset",
               map_ground_height_offset_);
   for (size_t i = 0; i < map_resolutions_.size(); ++i) {
@@ -90,6 +92,9 @@ void BaseMapConfig::LoadXml(const boost::property_tree::ptree& config) {
   double max_y = config.get<double>("map.map_config.range.max_y");
   map_range_ = Rect2D<double>(min_x, min_y, max_x, max_y);
   map_is_compression_ = config.get<bool>("map.map_config.compression");
+  // the maps written before the codec was configurable are zlib maps
+  map_compression_codec_ =
+      config.get<std::string>("map.map_config.compression_codec", "zlib");
   map_ground_height_offset_ =
       config.get<float>("map.map_runtime.map_ground_height_offset");
   BOOST_FOREACH (const boost::property_tree::ptree::value_type& v,  // NOLINT
@@ -63,6 +63,9 @@ class BaseMapConfig {
   float map_ground_height_offset_;
   /**@brief Enable the compression. */
   bool map_is_compression_;
+  /**@brief The codec the compressed nodes are written with, "zlib", "lz4"
+   * or "zstd". The nodes of any codec are read. */
+  std::string map_compression_codec_;
 
   /**@brief The map folder path. */
   std::string map_folder_path_;
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_map/base_map/base_map_node.h"
 
+#include <chrono>
+
 #include "cyber/common/log.h"
 #include "modules/common/util/file.h"
 #include "modules/localization/msf/local_map/base_map/base_map_matrix.h"
@@ -47,6 +49,13 @@ void BaseMapNode::Init(const BaseMapConfig* map_config,
   is_reserved_ = false;
   data_is_ready_ = false;
   is_changed_ = false;
+  if (compression_strategy_ != nullptr &&
+      compression_codec_ != map_config_->map_compression_codec_) {
+    delete compression_strategy_;
+    compression_strategy_ =
+        CreateCompressionStrategy(map_config_->map_compression_codec_);
+    compression_codec_ = map_config_->map_compression_codec_;
+  }
   if (create_map_cells) {
     InitMapMatrix(map_config_);
   }
@@ -297,10 +306,18 @@ unsigned int BaseMapNode::LoadBodyBinary(std::vector<unsigned char>* buf) {
     return map_matrix_->LoadBinary(&((*buf)[0]));
   }
   std::vector<unsigned char> buf_uncompressed;
-  compression_strategy_->Decode(buf, &buf_uncompressed);
-  AERROR << "map node compress ratio: "
+  const auto decode_start_time = std::chrono::steady_clock::now();
+  if (compression_strategy_->Decode(buf, &buf_uncompressed) != 0 ||
+      buf_uncompressed.empty()) {
+    AERROR << "Failed to decode map node: " << index_;
+    return 0;
+  }
+  const std::chrono::duration<double, std::milli> decode_time =
+      std::chrono::steady_clock::now() - decode_start_time;
+  ADEBUG << "map node " << index_ << " compress ratio: "
          << static_cast<float>(buf->size()) /
-                static_cast<float>(buf_uncompressed.size());
+                static_cast<float>(buf_uncompressed.size())
+         << ", decode time: " << decode_time.count() << " ms";
   return map_matrix_->LoadBinary(&buf_uncompressed[0]);
 }
 
@@ -185,6 +185,8 @@ class BaseMapNode {
   mutable unsigned int file_body_binary_size_ = 0;
   /**@bried The compression strategy. */
   CompressionStrategy* compression_strategy_ = nullptr;
+  /**@brief The codec of compression_strategy_. */
+  std::string compression_codec_ = "zlib";
   /**@brief The min altitude of point cloud in the node. */
   float min_altitude_ = 1e6;
 };
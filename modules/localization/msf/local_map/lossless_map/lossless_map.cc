@@ -16,6 +16,11 @@
 
 #include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
 
+#include <algorithm>
+#include <future>
+#include <map>
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
 
@@ -48,6 +53,75 @@ void LosslessMap::SetValueLayer(const Eigen::Vector3d& coordinate, int zone_id,
   }
 }
 
+void LosslessMap::SetValues(const std::vector<Eigen::Vector3d>& coordinates,
+                            const std::vector<unsigned char>& intensities,
+                            int zone_id, int thread_num) {
+  SetValuesImpl(coordinates, intensities, zone_id, thread_num, false);
+}
+
+void LosslessMap::SetValuesLayer(
+    const std::vector<Eigen::Vector3d>& coordinates,
+    const std::vector<unsigned char>& intensities, int zone_id,
+    int thread_num) {
+  SetValuesImpl(coordinates, intensities, zone_id, thread_num, true);
+}
+
+void LosslessMap::SetValuesImpl(
+    const std::vector<Eigen::Vector3d>& coordinates,
+    const std::vector<unsigned char>& intensities, int zone_id,
+    int thread_num, bool is_layer) {
+  std::map<MapNodeIndex, std::vector<size_t>> node_points;
+  for (size_t i = 0; i < map_config_->map_resolutions_.size(); ++i) {
+    for (size_t j = 0; j < coordinates.size(); ++j) {
+      MapNodeIndex index = MapNodeIndex::GetMapNodeIndex(
+          *map_config_, coordinates[j], static_cast<unsigned int>(i), zone_id);
+      node_points[index].push_back(j);
+    }
+  }
+
+  // the nodes of a batch are kept in the level 1 cache while filled, so
+  // that none of them is released
+  const size_t batch_size =
+      static_cast<size_t>(std::max(1, map_node_cache_lvl1_->Capacity()));
+  std::vector<std::pair<LosslessMapNode*, const std::vector<size_t>*>> batch;
+  auto fill_batch = [&]() {
+    const int batch_num = static_cast<int>(batch.size());
+    const int num_workers = std::max(1, std::min(thread_num, batch_num));
+    auto fill_nodes = [&](const int worker) {
+      for (int i = worker; i < batch_num; i += num_workers) {
+        LosslessMapNode* node = batch[i].first;
+        for (const size_t j : *batch[i].second) {
+          if (is_layer) {
+            node->SetValueLayer(coordinates[j], intensities[j]);
+          } else {
+            node->SetValue(coordinates[j], intensities[j]);
+          }
+        }
+      }
+    };
+    std::vector<std::future<void>> futures;
+    for (int worker = 1; worker < num_workers; ++worker) {
+      futures.push_back(std::async(std::launch::async, fill_nodes, worker));
+    }
+    fill_nodes(0);
+    for (auto& future : futures) {
+      future.get();
+    }
+    batch.clear();
+  };
+  for (const auto& node_point : node_points) {
+    batch.emplace_back(
+        static_cast<LosslessMapNode*>(GetMapNodeSafe(node_point.first)),
+        &node_point.second);
+    if (batch.size() == batch_size) {
+      fill_batch();
+    }
+  }
+  if (!batch.empty()) {
+    fill_batch();
+  }
+}
+
 void LosslessMap::GetValue(const Eigen::Vector3d& coordinate, int zone_id,
                            unsigned int resolution_id,
                            std::vector<unsigned char>* values) {
@@ -45,6 +45,19 @@ class LosslessMap : public BaseMap {
    */
   void SetValueLayer(const Eigen::Vector3d& coordinate, int zone_id,
                      unsigned char intensity);
+  /**@brief Set the values of many pixels, as SetValue(). The points of a map
+   * node are inserted in order by one thread, the different map nodes in
+   * parallel on thread_num threads.
+   */
+  void SetValues(const std::vector<Eigen::Vector3d>& coordinates,
+                 const std::vector<unsigned char>& intensities, int zone_id,
+                 int thread_num);
+  /**@brief Set the values of many pixels in the layers, as SetValueLayer()
+   * and on threads as SetValues().
+   */
+  void SetValuesLayer(const std::vector<Eigen::Vector3d>& coordinates,
+                      const std::vector<unsigned char>& intensities,
+                      int zone_id, int thread_num);
   /**@brief Given the 3D global coordinate, this function loads the
    * corresponding map node in the cache and return the value, if necessary.
    * This function returns the value of each layer in the map cell. */
@@ -158,6 +171,11 @@ class LosslessMap : public BaseMap {
   virtual bool LoadMapArea(const Eigen::Vector3d& seed_pt3d,
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
+
+ protected:
+  void SetValuesImpl(const std::vector<Eigen::Vector3d>& coordinates,
+                     const std::vector<unsigned char>& intensities,
+                     int zone_id, int thread_num, bool is_layer);
 };
 
 }  // namespace msf
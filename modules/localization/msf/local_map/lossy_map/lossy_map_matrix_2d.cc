@@ -16,10 +16,18 @@
 
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
 
+#include <cstring>
+
 namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+// count, intensity, intensity_var, altitude_avg and altitude_ground, the
+// last three split in high and low bytes
+constexpr unsigned int kNumLayers = 8;
+}  // namespace
+
 LossyMapCell2D::LossyMapCell2D()
     : count(0),
       intensity(0.0),
@@ -47,32 +55,46 @@ LossyMapCell2D& LossyMapCell2D::operator=(const LossyMapCell2D& ref) {
   return *this;
 }
 
-LossyMapMatrix2D::LossyMapMatrix2D() {
+LossyMapMatrix2D::LossyMapMatrix2D() : LossyMapMatrix2D(false) {}
+
+LossyMapMatrix2D::LossyMapMatrix2D(bool planar_layers) {
   rows_ = 0;
   cols_ = 0;
   map_cells_ = nullptr;
+  planar_layers_ = planar_layers;
+  layers_ = nullptr;
 }
 
 LossyMapMatrix2D::~LossyMapMatrix2D() {
   if (map_cells_) {
     delete[] map_cells_;
   }
+  if (layers_) {
+    delete[] layers_;
+  }
   rows_ = 0;
   cols_ = 0;
 }
 
 LossyMapMatrix2D::LossyMapMatrix2D(const LossyMapMatrix2D& matrix)
-    : BaseMapMatrix(matrix), map_cells_(NULL) {
-  Init(matrix.rows_, matrix.cols_);
-  for (unsigned int y = 0; y < rows_; ++y) {
-    for (unsigned int x = 0; x < cols_; ++x) {
-      map_cells_[y * cols_ + x] = matrix[y][x];
-    }
-  }
+    : BaseMapMatrix(matrix),
+      map_cells_(NULL),
+      planar_layers_(matrix.planar_layers_),
+      layers_(nullptr) {
+  *this = matrix;
 }
 
 LossyMapMatrix2D& LossyMapMatrix2D::operator=(const LossyMapMatrix2D& matrix) {
+  planar_layers_ = matrix.planar_layers_;
   Init(matrix.rows_, matrix.cols_);
+  if (planar_layers_) {
+    alt_avg_min_ = matrix.alt_avg_min_;
+    alt_avg_max_ = matrix.alt_avg_max_;
+    alt_ground_min_ = matrix.alt_ground_min_;
+    alt_ground_max_ = matrix.alt_ground_max_;
+    std::memcpy(layers_, matrix.layers_, rows_ * cols_ * kNumLayers);
+    return *this;
+  }
   for (unsigned int y = 0; y < rows_; ++y) {
     for (unsigned int x = 0; x < cols_; ++x) {
       map_cells_[y * cols_ + x] = matrix[y][x];
@@ -96,9 +118,18 @@ void LossyMapMatrix2D::Init(unsigned int rows, unsigned int cols) {
     delete[] map_cells_;
     map_cells_ = nullptr;
   }
-  map_cells_ = new LossyMapCell2D[rows * cols];
+  if (layers_) {
+    delete[] layers_;
+    layers_ = nullptr;
+  }
   rows_ = rows;
   cols_ = cols;
+  if (planar_layers_) {
+    layers_ = new unsigned char[rows * cols * kNumLayers];
+    ResetLayers();
+  } else {
+    map_cells_ = new LossyMapCell2D[rows * cols];
+  }
 }
 
 void LossyMapMatrix2D::Reset(const BaseMapConfig* config) {
@@ -107,12 +138,100 @@ void LossyMapMatrix2D::Reset(const BaseMapConfig* config) {
 }
 
 void LossyMapMatrix2D::Reset(unsigned int rows, unsigned int cols) {
+  if (planar_layers_) {
+    ResetLayers();
+    return;
+  }
   unsigned int length = rows * cols;
   for (unsigned int i = 0; i < length; ++i) {
     map_cells_[i].Reset();
   }
 }
 
+void LossyMapMatrix2D::ResetLayers() {
+  const unsigned int size = rows_ * cols_;
+  const uint16_t var = EncodeVar(LossyMapCell2D());
+  // zero count, intensity and average altitude
+  std::memset(layers_, 0, size * kNumLayers);
+  std::memset(layers_ + 2 * size, var / 256, size);
+  std::memset(layers_ + 3 * size, var % 256, size);
+  std::memset(layers_ + 6 * size, ground_void_flag_ / 256, size);
+  std::memset(layers_ + 7 * size, ground_void_flag_ % 256, size);
+}
+
+void LossyMapMatrix2D::GetCell(unsigned int row, unsigned int col,
+                               LossyMapCell2D* cell) const {
+  const unsigned int id = row * cols_ + col;
+  if (!planar_layers_) {
+    *cell = map_cells_[id];
+    return;
+  }
+  const unsigned int size = rows_ * cols_;
+  const unsigned char* pp = layers_ + id;
+  DecodeCount(pp[0], cell);
+  DecodeIntensity(pp[size], cell);
+  DecodeVar(static_cast<uint16_t>(pp[2 * size] * 256 + pp[3 * size]), cell);
+  if (cell->count > 0) {
+    DecodeAltitudeAvg(static_cast<uint16_t>(pp[4 * size] * 256 + pp[5 * size]),
+                      cell);
+  } else {
+    cell->altitude = 0.0;
+  }
+  const uint16_t alt =
+      static_cast<uint16_t>(pp[6 * size] * 256 + pp[7 * size]);
+  if (alt == ground_void_flag_) {
+    cell->is_ground_useful = false;
+    cell->altitude_ground = 0.0;
+  } else {
+    cell->is_ground_useful = true;
+    DecodeAltitudeGround(alt, cell);
+  }
+}
+
+void LossyMapMatrix2D::GetCellsInRow(unsigned int row, unsigned int col,
+                                     unsigned int num, float* intensities,
+                                     float* intensities_var, float* altitudes,
+                                     unsigned int* counts) const {
+  const unsigned int begin = row * cols_ + col;
+  if (!planar_layers_) {
+    for (unsigned int i = 0; i < num; ++i) {
+      const LossyMapCell2D& cell = map_cells_[begin + i];
+      intensities[i] = cell.intensity;
+      intensities_var[i] = cell.intensity_var;
+      altitudes[i] = cell.altitude;
+      counts[i] = cell.count;
+    }
+    return;
+  }
+
+  // one loop per layer, so that they are vectorized
+  const unsigned int size = rows_ * cols_;
+  const unsigned char* count_layer = layers_ + begin;
+  for (unsigned int i = 0; i < num; ++i) {
+    counts[i] = count_layer[i] == 0 ? 0 : 1u << (count_layer[i] - 1);
+  }
+  const unsigned char* intensity_layer = count_layer + size;
+  for (unsigned int i = 0; i < num; ++i) {
+    intensities[i] = intensity_layer[i];
+  }
+  const unsigned char* var_high = intensity_layer + size;
+  const unsigned char* var_low = var_high + size;
+  for (unsigned int i = 0; i < num; ++i) {
+    float var = static_cast<float>(var_high[i] * 256 + var_low[i]);
+    var = static_cast<float>(
+        (static_cast<const float>(var_range_) / var - 1.0) /
+        static_cast<const float>(var_ratio_));
+    intensities_var[i] = var * var;
+  }
+  const unsigned char* alt_high = var_low + size;
+  const unsigned char* alt_low = alt_high + size;
+  for (unsigned int i = 0; i < num; ++i) {
+    const float ratio = static_cast<float>(alt_high[i] * 256 + alt_low[i]);
+    altitudes[i] =
+        count_layer[i] > 0 ? alt_avg_min_ + ratio * alt_avg_interval_ : 0.0f;
+  }
+}
+
 unsigned char LossyMapMatrix2D::EncodeIntensity(
     const LossyMapCell2D& cell) const {
   int intensity = static_cast<int>(cell.intensity);
@@ -239,6 +358,10 @@ unsigned int LossyMapMatrix2D::LoadBinary(unsigned char* buf) {
   Init(rows_, cols_);
 
   unsigned char* pp = reinterpret_cast<unsigned char*>(pf);
+  if (planar_layers_) {
+    std::memcpy(layers_, pp, rows_ * cols_ * kNumLayers);
+    return GetBinarySize();
+  }
   // count
   for (unsigned int row = 0; row < rows_; ++row) {
     for (unsigned int col = 0; col < cols_; ++col) {
@@ -317,6 +440,16 @@ unsigned int LossyMapMatrix2D::CreateBinary(unsigned char* buf,
     ++p;
     buf_size -= static_cast<unsigned int>(sizeof(unsigned int) * 2);
 
+    if (planar_layers_) {
+      float* pf = reinterpret_cast<float*>(reinterpret_cast<void*>(p));
+      pf[0] = alt_avg_min_;
+      pf[1] = alt_avg_max_;
+      pf[2] = alt_ground_min_;
+      pf[3] = alt_ground_max_;
+      std::memcpy(pf + 4, layers_, rows_ * cols_ * kNumLayers);
+      return target_size;
+    }
+
     float* pf = reinterpret_cast<float*>(reinterpret_cast<void*>(p));
     alt_avg_min_ = 1e8;
     alt_avg_max_ = -1e8;
@@ -444,7 +577,8 @@ void LossyMapMatrix2D::GetIntensityImg(cv::Mat* intensity_img) const {
     for (unsigned int x = 0; x < cols_; ++x) {
       unsigned int id = y * cols_ + x;
       intensity_img->at<unsigned char>(y, x) =
-          (unsigned char)(map_cells_[id].intensity);
+          planar_layers_ ? layers_[rows_ * cols_ + id]
+                         : (unsigned char)(map_cells_[id].intensity);
     }
   }
 }
@@ -59,6 +59,12 @@ struct LossyMapCell2D {
 class LossyMapMatrix2D : public BaseMapMatrix {
  public:
   LossyMapMatrix2D();
+  /**@brief When planar_layers is true, the cells are not decoded but kept as
+   * the quantized layers of the binary (count and intensity in 8 bits,
+   * intensity variance and altitudes in 16 bits), which takes a third of the
+   * memory of the decoded cells and is loaded with a copy. The cells are then
+   * read with GetCell() and GetCellsInRow(), not with operator[]. */
+  explicit LossyMapMatrix2D(bool planar_layers);
   ~LossyMapMatrix2D();
   LossyMapMatrix2D(const LossyMapMatrix2D& matrix);
 
@@ -84,6 +90,17 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   /**@brief get intensity image of node. */
   virtual void GetIntensityImg(cv::Mat* intensity_img) const;
 
+  /**@brief Whether the cells are kept as the quantized layers. */
+  inline bool IsPlanar() const { return planar_layers_; }
+  /**@brief Get a decoded cell, in both layouts. */
+  void GetCell(unsigned int row, unsigned int col, LossyMapCell2D* cell) const;
+  /**@brief Decode num consecutive cells of a row into separate arrays, in
+   * both layouts. */
+  void GetCellsInRow(unsigned int row, unsigned int col, unsigned int num,
+                     float* intensities, float* intensities_var,
+                     float* altitudes, unsigned int* counts) const;
+
+  /**@brief Access the decoded cells, not valid with the planar layers. */
   inline LossyMapCell2D* operator[](int row) {
     return map_cells_ + row * cols_;
   }
@@ -100,6 +117,12 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   unsigned int cols_;
   /**@brief The matrix data structure. */
   LossyMapCell2D* map_cells_;
+  /**@brief Keep the quantized layers instead of the decoded cells. */
+  bool planar_layers_;
+  /**@brief The quantized layers with the layout of the binary: count,
+   * intensity, then the high and low bytes of the intensity variance, the
+   * average altitude and the ground altitude, rows_ * cols_ bytes each. */
+  unsigned char* layers_;
 
  protected:
   inline unsigned char EncodeIntensity(const LossyMapCell2D& cell) const;
@@ -112,6 +135,8 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   inline void DecodeAltitudeAvg(uint16_t data, LossyMapCell2D* cell) const;
   inline unsigned char EncodeCount(const LossyMapCell2D& cell) const;
   inline void DecodeCount(unsigned char data, LossyMapCell2D* cell) const;
+  /**@brief Fill the layers with the encoding of empty cells. */
+  void ResetLayers();
   const int var_range_ = 1023;  // 65535;
   const int var_ratio_ = 4;     // 256;
   // const unsigned int _alt_range = 1023;//65535;
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LossyMapMatrix2DTestSuite : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    matrix_.Init(kRows, kCols);
+    for (unsigned int y = 0; y < kRows; ++y) {
+      for (unsigned int x = 0; x < kCols; ++x) {
+        LossyMapCell2D& cell = matrix_[y][x];
+        cell.count = (y * kCols + x) % 5;
+        cell.intensity = static_cast<float>((y * 7 + x * 13) % 256);
+        cell.intensity_var = static_cast<float>(x % 20) * 0.5f;
+        cell.altitude = 10.0f + static_cast<float>(y) * 0.1f;
+        cell.altitude_ground = 9.0f + static_cast<float>(x) * 0.1f;
+        cell.is_ground_useful = (x + y) % 3 != 0;
+      }
+    }
+    binary_.resize(matrix_.GetBinarySize());
+    ASSERT_EQ(binary_.size(),
+              matrix_.CreateBinary(binary_.data(), matrix_.GetBinarySize()));
+  }
+
+  static constexpr unsigned int kRows = 16;
+  static constexpr unsigned int kCols = 24;
+  LossyMapMatrix2D matrix_;
+  std::vector<unsigned char> binary_;
+};
+
+constexpr unsigned int LossyMapMatrix2DTestSuite::kRows;
+constexpr unsigned int LossyMapMatrix2DTestSuite::kCols;
+
+TEST_F(LossyMapMatrix2DTestSuite, PlanarLayers) {
+  LossyMapMatrix2D decoded;
+  LossyMapMatrix2D planar(true);
+  EXPECT_EQ(binary_.size(), decoded.LoadBinary(binary_.data()));
+  EXPECT_EQ(binary_.size(), planar.LoadBinary(binary_.data()));
+  EXPECT_FALSE(decoded.IsPlanar());
+  EXPECT_TRUE(planar.IsPlanar());
+
+  // both layouts decode the same cells
+  for (unsigned int y = 0; y < kRows; ++y) {
+    for (unsigned int x = 0; x < kCols; ++x) {
+      LossyMapCell2D cell;
+      planar.GetCell(y, x, &cell);
+      const LossyMapCell2D& expected = decoded[y][x];
+      EXPECT_EQ(expected.count, cell.count);
+      EXPECT_FLOAT_EQ(expected.intensity, cell.intensity);
+      EXPECT_FLOAT_EQ(expected.intensity_var, cell.intensity_var);
+      EXPECT_FLOAT_EQ(expected.altitude, cell.altitude);
+      EXPECT_EQ(expected.is_ground_useful, cell.is_ground_useful);
+      EXPECT_FLOAT_EQ(expected.altitude_ground, cell.altitude_ground);
+    }
+  }
+
+  const unsigned int col = 3;
+  const unsigned int num = kCols - col;
+  std::vector<float> intensities(num);
+  std::vector<float> intensities_var(num);
+  std::vector<float> altitudes(num);
+  std::vector<unsigned int> counts(num);
+  for (unsigned int y = 0; y < kRows; ++y) {
+    planar.GetCellsInRow(y, col, num, intensities.data(),
+                         intensities_var.data(), altitudes.data(),
+                         counts.data());
+    for (unsigned int i = 0; i < num; ++i) {
+      const LossyMapCell2D& expected = decoded[y][col + i];
+      EXPECT_EQ(expected.count, counts[i]);
+      EXPECT_FLOAT_EQ(expected.intensity, intensities[i]);
+      EXPECT_FLOAT_EQ(expected.intensity_var, intensities_var[i]);
+      EXPECT_FLOAT_EQ(expected.altitude, altitudes[i]);
+    }
+  }
+
+  // the layers are written back unchanged
+  std::vector<unsigned char> planar_binary(planar.GetBinarySize());
+  EXPECT_EQ(binary_.size(), planar.CreateBinary(planar_binary.data(),
+                                                planar.GetBinarySize()));
+  EXPECT_EQ(binary_, planar_binary);
+  LossyMapMatrix2D copy(planar);
+  EXPECT_TRUE(copy.IsPlanar());
+  copy.CreateBinary(planar_binary.data(), copy.GetBinarySize());
+  EXPECT_EQ(binary_, planar_binary);
+}
+
+TEST_F(LossyMapMatrix2DTestSuite, ResetPlanarLayers) {
+  LossyMapMatrix2D planar(true);
+  planar.LoadBinary(binary_.data());
+  planar.Reset(kRows, kCols);
+  for (unsigned int y = 0; y < kRows; ++y) {
+    for (unsigned int x = 0; x < kCols; ++x) {
+      LossyMapCell2D cell;
+      planar.GetCell(y, x, &cell);
+      EXPECT_EQ(0, cell.count);
+      EXPECT_FLOAT_EQ(0.0f, cell.intensity);
+      EXPECT_FALSE(cell.is_ground_useful);
+    }
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -26,6 +26,9 @@ namespace msf {
 class LossyMapNode2D : public BaseMapNode {
  public:
   LossyMapNode2D() : BaseMapNode(new LossyMapMatrix2D(), new ZlibStrategy()) {}
+  /**@brief The node with the planar quantized layers of LossyMapMatrix2D. */
+  explicit LossyMapNode2D(bool planar_layers)
+      : BaseMapNode(new LossyMapMatrix2D(planar_layers), new ZlibStrategy()) {}
   ~LossyMapNode2D() {}
 };
 
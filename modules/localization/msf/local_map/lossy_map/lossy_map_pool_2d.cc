@@ -25,7 +25,7 @@ LossyMapNodePool2D::LossyMapNodePool2D(unsigned int pool_size,
     : BaseMapNodePool(pool_size, thread_size) {}
 
 BaseMapNode* LossyMapNodePool2D::AllocNewMapNode() {
-  return new LossyMapNode2D();
+  return new LossyMapNode2D(planar_layers_);
 }
 
 }  // namespace msf
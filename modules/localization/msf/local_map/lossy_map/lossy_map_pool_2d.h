@@ -36,9 +36,14 @@ class LossyMapNodePool2D : public BaseMapNodePool {
   LossyMapNodePool2D(unsigned int pool_size, unsigned int thread_size);
   /**@brief Destructor */
   virtual ~LossyMapNodePool2D() {}
+  /**@brief Keep the nodes as planar quantized layers, to be set before
+   * Initial(). */
+  void SetPlanarLayers(bool planar_layers) { planar_layers_ = planar_layers; }
 
  private:
   virtual BaseMapNode* AllocNewMapNode();
+
+  bool planar_layers_ = false;
 };
 
 }  // namespace msf
@@ -52,7 +52,12 @@ int main(int argc, char **argv) {
       "odometry_loc_topic",
       boost::program_options::value<std::string>()->default_value(
           "/apollo/sensor/gnss/odometry"),
-      "provide odometry localization topic");
+      "provide odometry localization topic")(
+      "use_pcd_archive",
+      boost::program_options::value<bool>()->default_value(false),
+      "write the point clouds to one pcd archive instead of pcd files")(
+      "thread_num", boost::program_options::value<int>()->default_value(1),
+      "provide the threads decoding the point clouds");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -83,7 +88,11 @@ int main(int argc, char **argv) {
   const std::string odometry_loc_topic =
       boost_args["odometry_loc_topic"].as<std::string>();
 
-  std::unique_ptr<PCDExporter> pcd_exporter(new PCDExporter(pcd_folder));
+  const bool use_pcd_archive = boost_args["use_pcd_archive"].as<bool>();
+  const int thread_num = boost_args["thread_num"].as<int>();
+
+  std::unique_ptr<PCDExporter> pcd_exporter(
+      new PCDExporter(pcd_folder, use_pcd_archive, thread_num));
   std::unique_ptr<LocationExporter> loc_exporter(
       new LocationExporter(pcd_folder));
 
@@ -109,6 +118,7 @@ int main(int argc, char **argv) {
   });
 
   reader.Read(bag_file);
+  pcd_exporter->Flush();
 
   return 0;
 }
@@ -16,25 +16,31 @@
 
 #include "modules/localization/msf/local_tool/data_extraction/pcd_exporter.h"
 
+#include <algorithm>
+#include <future>
+
 #include "cyber/cyber.h"
 #include "modules/localization/msf/common/io/pcl_point_types.h"
 #include "pcl/io/pcd_io.h"
 #include "pcl/point_types.h"
 
 namespace apollo {
-namespace localization {
-namespace msf {
-
-PCDExporter::PCDExporter(const std::string &pcd_folder) {
+naPCDExporter::PCDExporter(const std::string &pcd_folder, bool use_archive,
+                         int thread_num)
+    : use_archive_(use_archive), thread_num_(std::max(1, thread_num)) {
   pcd_folder_ = pcd_folder;
   std::string stamp_file = pcd_folder_ + "/pcd_timestamp.txt";
 
   if ((stamp_file_handle_ = fopen(stamp_file.c_str(), "a")) == nullptr) {
     AERROR << "Cannot open stamp file!";
   }
+  if (use_archive_ && !archive_writer_.Open(pcd_folder_)) {
+    AERROR << "Cannot open pcd archive!";
+  }
 }
 
 PCDExporter::~PCDExporter() {
+  Flush();
   if (stamp_file_handle_ != nullptr) {
     fclose(stamp_file_handle_);
   }
@@ -42,49 +48,102 @@ PCDExporter::~PCDExporter() {
 
 void PCDExporter::CompensatedPcdCallback(const std::string &msg_string) {
   AINFO << "Compensated pcd callback.";
-  drivers::PointCloud msg;
-  msg.ParseFromString(msg_string);
+  queued_msgs_.push_back(msg_string);
+  // a few frames per thread, so that the threads are kept busy
+  constexpr int kFramesPerThread = 4;
+  if (thread_num_ == 1 ||
+      static_cast<int>(queued_msgs_.size()) >= thread_num_ * kFramesPerThread) {
+    Flush();
+  }
+}
 
-  static unsigned int index = 1;
+void PCDExporter::Flush() {
+  const int frame_num = static_cast<int>(queued_msgs_.size());
+  if (frame_num == 0) {
+    return;
+  }
+  frames_.resize(frame_num);
+  const int num_workers = std::max(1, std::min(thread_num_, frame_num));
+  auto decode_frames = [&](const int worker) {
+    for (int i = worker; i < frame_num; i += num_workers) {
+      DecodeFrame(queued_msgs_[i], &frames_[i]);
+      if (!use_archive_) {
+        std::stringstream ss_pcd;
+        ss_pcd << pcd_folder_ << "/" << index_ + i << ".pcd";
+        WritePcdFile(ss_pcd.str(), frames_[i]);
+      }
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, decode_frames, worker));
+  }
+  decode_frames(0);
+  for (auto &future : futures) {
+    future.get();
+  }
 
-  std::stringstream ss_pcd;
-  ss_pcd << pcd_folder_ << "/" << index << ".pcd";
-  std::string pcd_filename = ss_pcd.str();
+  for (int i = 0; i < frame_num; ++i) {
+    if (use_archive_) {
+      archive_writer_.Write(index_, frames_[i].xyzs, frames_[i].intensities);
+    }
+    if (stamp_file_handle_ != nullptr) {
+      fprintf(stamp_file_handle_, "%u %lf\n", index_, frames_[i].timestamp);
+    }
+    ++index_;
+  }
+  queued_msgs_.clear();
+}
 
-  WritePcdFile(pcd_filename, msg);
-  double timestamp = cyber::Time(msg.measurement_time()).ToSecond();
-  fprintf(stamp_file_handle_, "%u %lf\n", index, timestamp);
+void PCDExporter::DecodeFrame(const std::string &msg_string, Frame *frame) {
+  drivers::PointCloud msg;
+  msg.ParseFromString(msg_string);
+  frame->timestamp = cyber::Time(msg.measurement_time()).ToSecond();
+  frame->width = msg.width();
+  frame->height = msg.height();
+  if (frame->width == 0 || frame->height == 0) {
+    frame->width = 1;
+    frame->height = msg.point_size();
+  }
 
-  ++index;
+  const int point_num =
+      std::min(static_cast<int>(frame->width * frame->height),
+               msg.point_size());
+  frame->xyzs.resize(frame->width * frame->height * 3, 0.0f);
+  frame->intensities.resize(frame->width * frame->height, 0);
+  for (int i = 0; i < point_num; ++i) {
+    const auto &point = msg.point(i);
+    frame->xyzs[i * 3] = point.x();
+    frame->xyzs[i * 3 + 1] = point.y();
+    frame->xyzs[i * 3 + 2] = point.z();
+    frame->intensities[i] = static_cast<unsigned char>(point.intensity());
+  }
 }
 
 void PCDExporter::WritePcdFile(const std::string &filename,
-                               const drivers::PointCloud &msg) {
+                               const Frame &frame) {
   pcl::PointCloud<velodyne::PointXYZIT> cloud;
-  cloud.width = msg.width();
-  cloud.height = msg.height();
+  cloud.width = frame.width;
+  cloud.height = frame.height;
   cloud.is_dense = false;
   cloud.points.resize(cloud.width * cloud.height);
 
-  if (cloud.width == 0 || cloud.height == 0) {
-    cloud.width = 1;
-    cloud.height = msg.point_size();
-    cloud.points.resize(msg.point_size());
-  }
-
   for (unsigned int i = 0; i < static_cast<unsigned int>(cloud.points.size());
        ++i) {
-    cloud.points[i].x = msg.point(i).x();
-    cloud.points[i].y = msg.point(i).y();
-    cloud.points[i].z = msg.point(i).z();
-    cloud.points[i].intensity =
-        static_cast<unsigned char>(msg.point(i).intensity());
+    cloud.points[i].x = frame.xyzs[i * 3];
+    cloud.points[i].y = frame.xyzs[i * 3 + 1];
+    cloud.points[i].z = frame.xyzs[i * 3 + 2];
+    cloud.points[i].intensity = frame.intensities[i];
   }
 
   pcl::io::savePCDFileBinaryCompressed(filename, cloud);
   return;
 }
 
+mpressed(filename, cloud);
+  return;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/localization/msf/common/io/pcd_archive.h"
 
 namespace apollo {
 namespace localization {
@@ -30,17 +32,39 @@ namespace msf {
  */
 class PCDExporter {
  public:
-  explicit PCDExporter(const std::string &pcd_folder);
+  /**@param use_archive write the frames to one pcd archive instead of one
+   * pcd file per frame.
+   * @param thread_num the threads decoding the messages, which are then
+   * queued and decoded in batches.
+   */
+  explicit PCDExporter(const std::string &pcd_folder,
+                       bool use_archive = false, int thread_num = 1);
   ~PCDExporter();
 
   void CompensatedPcdCallback(const std::string &msg);
+  /**@brief Decode and write the queued messages. */
+  void Flush();
 
  private:
-  void WritePcdFile(const std::string &filename,
-                    const drivers::PointCloud &msg);
+  struct Frame {
+    double timestamp = 0.0;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<float> xyzs;
+    std::vector<unsigned char> intensities;
+  };
+
+  void DecodeFrame(const std::string &msg_string, Frame *frame);
+  void WritePcdFile(const std::string &filename, const Frame &frame);
 
   std::string pcd_folder_;
   FILE *stamp_file_handle_;
+  bool use_archive_ = false;
+  int thread_num_ = 1;
+  unsigned int index_ = 1;
+  std::vector<std::string> queued_msgs_;
+  std::vector<Frame> frames_;
+  velodyne::PcdArchiveWriter archive_writer_;
 };
 
 }  // namespace msf
@@ -0,0 +1,306 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+
+/**
+ * @file localization_benchmark.cc
+ * @brief Replays the IMU, GNSS and lidar messages of records into the MSF
+ *        localization as fast as possible, and reports the processing time
+ *        per measurement, the lag of the poses, the time waited for the map
+ *        nodes and the position error against a reference trajectory.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/base/histogram.h"
+#include "cyber/common/log.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/util/string_util.h"
+#include "modules/localization/common/localization_gflags.h"
+#include "modules/localization/msf/common/io/velodyne_utility.h"
+#include "modules/localization/msf/local_integ/localization_integ.h"
+#include "modules/localization/msf/local_tool/data_extraction/cyber_record_reader.h"
+#include "modules/localization/msf/msf_localization.h"
+
+DEFINE_string(benchmark_records, "",
+              "Comma separated records replayed one after the other");
+DEFINE_string(benchmark_imu_topic, "/apollo/sensor/gnss/imu",
+              "Topic of the raw IMU messages");
+DEFINE_string(benchmark_reference_poses, "",
+              "Reference poses with their stds, as the fusion_loc.txt "
+              "exported by cyber_record_parser, empty to skip the errors");
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace {
+
+using apollo::cyber::base::Histogram;
+using SteadyClock = std::chrono::steady_clock;
+
+// the reference poses farther in time are not interpolated
+constexpr double kMaxReferenceGap = 0.1;
+
+uint64_t MicrosecondsSince(const SteadyClock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             SteadyClock::now() - start)
+      .count();
+}
+
+bool IsValid(const LocalizationResult &result) {
+  return result.state() == LocalizationMeasureState::OK ||
+         result.state() == LocalizationMeasureState::VALID;
+}
+
+void PrintHistogram(const std::string &name, const Histogram &histogram) {
+  std::cout << std::left << std::setw(20) << name << std::right
+            << " count: " << std::setw(8) << histogram.Count()
+            << " mean: " << std::setw(8) << histogram.Mean()
+            << " p50: " << std::setw(8) << histogram.Percentile(50.0)
+            << " p99: " << std::setw(8) << histogram.Percentile(99.0)
+            << " max: " << std::setw(8) << histogram.Max() << std::endl;
+}
+
+void PrintErrors(const std::string &name, std::vector<double> errors) {
+  if (errors.empty()) {
+    return;
+  }
+  std::sort(errors.begin(), errors.end());
+  double square_sum = 0.0;
+  for (const double error : errors) {
+    square_sum += error * error;
+  }
+  const size_t p95 = std::min(errors.size() - 1, errors.size() * 95 / 100);
+  std::cout << std::left << std::setw(20) << name << std::right
+            << " count: " << std::setw(8) << errors.size()
+            << " rms: " << std::setw(8)
+            << std::sqrt(square_sum / static_cast<double>(errors.size()))
+            << " p95: " << std::setw(8) << errors[p95]
+            << " max: " << std::setw(8) << errors.back() << std::endl;
+}
+
+class LocalizationBenchmark {
+ public:
+  bool Init() {
+    msf_localization_.InitParams();
+    if (!localization_integ_.Init(msf_localization_.GetParams()).ok()) {
+      AERROR << "Failed to init the localization.";
+      return false;
+    }
+    if (!FLAGS_benchmark_reference_poses.empty()) {
+      std::vector<Eigen::Vector3d> stds;
+      velodyne::LoadPosesAndStds(FLAGS_benchmark_reference_poses,
+                                 &reference_poses_, &stds,
+                                 &reference_timestamps_);
+      if (reference_poses_.empty()) {
+        AERROR << "No reference pose in " << FLAGS_benchmark_reference_poses;
+        return false;
+      }
+    }
+
+    reader_.Subscribe(FLAGS_benchmark_imu_topic,
+                      [this](const std::string &msg) { OnImu(msg); });
+    reader_.Subscribe(FLAGS_lidar_topic,
+                      [this](const std::string &msg) { OnPointCloud(msg); });
+    reader_.Subscribe(FLAGS_gnss_best_pose_topic,
+                      [this](const std::string &msg) { OnGnssBestPose(msg); });
+    reader_.Subscribe(FLAGS_heading_topic,
+                      [this](const std::string &msg) { OnGnssHeading(msg); });
+    return true;
+  }
+
+  void Replay(const std::string &record) {
+    AINFO << "Replay " << record;
+    const auto start = SteadyClock::now();
+    reader_.Read(record);
+    replay_time_ += static_cast<double>(MicrosecondsSince(start)) * 1e-6;
+  }
+
+  void Report() const {
+    const double data_time = last_imu_time_ - first_imu_time_;
+    std::cout << "Replayed " << data_time << " s of data in " << replay_time_
+              << " s, " << data_time / std::max(replay_time_, 1e-6)
+              << " times the real time." << std::endl;
+
+    std::cout << "Processing time per message (us):" << std::endl;
+    PrintHistogram("imu", imu_time_);
+    PrintHistogram("lidar", lidar_time_);
+    PrintHistogram("gnss best pose", gnss_best_pose_time_);
+    PrintHistogram("gnss heading", gnss_heading_time_);
+
+    std::cout << "Lag of the poses behind the IMU (us):" << std::endl;
+    PrintHistogram("pose lag", pose_lag_);
+
+    const auto load_stats = localization_integ_.GetMapNodeLoadStats();
+    std::cout << "Map nodes, l1 hit: " << load_stats.l1_hit_num
+              << ", l2 hit: " << load_stats.l2_hit_num
+              << ", miss: " << load_stats.miss_num
+              << ", stall time: " << load_stats.stall_time << " s, "
+              << load_stats.stall_time * 1e3 /
+                     static_cast<double>(std::max<uint64_t>(
+                         1, lidar_time_.Count()))
+              << " ms per frame." << std::endl;
+
+    if (!reference_poses_.empty()) {
+      std::cout << "Position error against the reference (m):" << std::endl;
+      PrintErrors("horizontal", horizontal_errors_);
+      PrintErrors("vertical", vertical_errors_);
+    }
+  }
+
+ private:
+  void OnImu(const std::string &msg_string) {
+    drivers::gnss::Imu imu_msg;
+    imu_msg.ParseFromString(msg_string);
+    const double imu_time = imu_msg.measurement_time();
+    if (first_imu_time_ == 0.0) {
+      first_imu_time_ = imu_time;
+    }
+    last_imu_time_ = imu_time;
+
+    const auto start = SteadyClock::now();
+    if (FLAGS_imu_coord_rfu) {
+      localization_integ_.RawImuProcessRfu(imu_msg);
+    } else {
+      localization_integ_.RawImuProcessFlu(imu_msg);
+    }
+    imu_time_.Record(MicrosecondsSince(start));
+
+    const auto &result = localization_integ_.GetLastestIntegLocalization();
+    if (!IsValid(result)) {
+      return;
+    }
+    const LocalizationEstimate localization = result.localization();
+    const double pose_time = localization.measurement_time();
+    if (pose_time <= last_pose_time_) {
+      return;
+    }
+    last_pose_time_ = pose_time;
+    if (imu_time >= pose_time) {
+      pose_lag_.Record(static_cast<uint64_t>((imu_time - pose_time) * 1e6));
+    }
+    AddPoseError(localization);
+  }
+
+  void OnPointCloud(const std::string &msg_string) {
+    if (pcd_msg_index_++ % FLAGS_point_cloud_step != 0) {
+      return;
+    }
+    drivers::PointCloud msg;
+    msg.ParseFromString(msg_string);
+    const auto start = SteadyClock::now();
+    localization_integ_.PcdProcess(msg);
+    lidar_time_.Record(MicrosecondsSince(start));
+  }
+
+  void OnGnssBestPose(const std::string &msg_string) {
+    drivers::gnss::GnssBestPose msg;
+    msg.ParseFromString(msg_string);
+    const auto start = SteadyClock::now();
+    localization_integ_.GnssBestPoseProcess(msg);
+    gnss_best_pose_time_.Record(MicrosecondsSince(start));
+  }
+
+  void OnGnssHeading(const std::string &msg_string) {
+    drivers::gnss::Heading msg;
+    msg.ParseFromString(msg_string);
+    const auto start = SteadyClock::now();
+    localization_integ_.GnssHeadingProcess(msg);
+    gnss_heading_time_.Record(MicrosecondsSince(start));
+  }
+
+  void AddPoseError(const LocalizationEstimate &localization) {
+    if (reference_poses_.empty()) {
+      return;
+    }
+    const double time = localization.measurement_time();
+    const auto next = std::lower_bound(reference_timestamps_.begin(),
+                                       reference_timestamps_.end(), time);
+    if (next == reference_timestamps_.begin() ||
+        next == reference_timestamps_.end()) {
+      return;
+    }
+    const size_t i = next - reference_timestamps_.begin();
+    const double time_diff = reference_timestamps_[i] -
+                             reference_timestamps_[i - 1];
+    if (time_diff > kMaxReferenceGap || time_diff <= 0.0) {
+      return;
+    }
+    const double ratio = (time - reference_timestamps_[i - 1]) / time_diff;
+    const Eigen::Vector3d reference =
+        reference_poses_[i - 1].translation() * (1.0 - ratio) +
+        reference_poses_[i].translation() * ratio;
+
+    const auto &position = localization.pose().position();
+    horizontal_errors_.push_back(
+        std::hypot(position.x() - reference.x(), position.y() - reference.y()));
+    vertical_errors_.push_back(std::abs(position.z() - reference.z()));
+  }
+
+  MSFLocalization msf_localization_;
+  LocalizationInteg localization_integ_;
+  CyberRecordReader reader_;
+
+  Histogram imu_time_;
+  Histogram lidar_time_;
+  Histogram gnss_best_pose_time_;
+  Histogram gnss_heading_time_;
+  Histogram pose_lag_;
+  uint64_t pcd_msg_index_ = 0;
+  double first_imu_time_ = 0.0;
+  double last_imu_time_ = 0.0;
+  double last_pose_time_ = 0.0;
+  double replay_time_ = 0.0;
+
+  std::vector<Eigen::Affine3d> reference_poses_;
+  std::vector<double> reference_timestamps_;
+  std::vector<double> horizontal_errors_;
+  std::vector<double> vertical_errors_;
+};
+
+}  // namespace
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  std::vector<std::string> records;
+  apollo::common::util::Split(FLAGS_benchmark_records, ',', &records);
+  if (records.empty()) {
+    AERROR << "No record to replay, set --benchmark_records.";
+    return -1;
+  }
+
+  apollo::localization::msf::LocalizationBenchmark benchmark;
+  if (!benchmark.Init()) {
+    return -1;
+  }
+  for (const auto &record : records) {
+    benchmark.Replay(record);
+  }
+  benchmark.Report();
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include "boost/filesystem.hpp"
 #include "boost/program_options.hpp"
 
+#include "modules/localization/msf/common/io/pcd_archive.h"
 #include "modules/localization/msf/common/io/velodyne_utility.h"
 #include "modules/localization/msf/common/util/extract_ground_plane.h"
 #include "modules/localization/msf/common/util/system_utility.h"
@@ -30,6 +31,7 @@ using apollo::localization::msf::LosslessMap;
 using apollo::localization::msf::LosslessMapConfig;
 using apollo::localization::msf::LosslessMapNodePool;
 using apollo::localization::msf::MapNodeIndex;
+using apollo::localization::msf::velodyne::PcdArchiveReader;
 typedef apollo::localization::msf::FeatureXYPlane::PointT PclPointT;
 typedef apollo::localization::msf::FeatureXYPlane::PointCloudT PclPointCloudT;
 typedef apollo::localization::msf::FeatureXYPlane::PointCloudPtrT
@@ -69,7 +71,13 @@ bool ParseCommandLine(int argc, char* argv[],
           "resolution",
           boost::program_options::value<float>()->default_value(0.125),
           "optional: resolution for single resolution generation, default: "
-          "0.125");
+          "0.125")(
+          "thread_num", boost::program_options::value<int>()->default_value(1),
+          "optional: threads filling the map nodes, default: 1")(
+          "update_existing_map",
+          boost::program_options::value<bool>()->default_value(false),
+          "optional: add the pcd folders to the map in map_folder instead "
+          "of creating a new map, default: false");
   try {
     boost::program_options::store(
         boost::program_options::parse_command_line(argc, argv, desc), *vm);
@@ -154,6 +162,9 @@ int main(int argc, char** argv) {
               << "4.0, 8.0 or 16.0." << std::endl;
   }
 
+  const int thread_num = boost_args["thread_num"].as<int>();
+  const bool update_existing_map = boost_args["update_existing_map"].as<bool>();
+
   const size_t num_trials = pcd_folder_pathes.size();
 
   // load all poses
@@ -177,22 +188,32 @@ int main(int argc, char** argv) {
   if (!apollo::localization::msf::system::IsExists(map_folder_path)) {
     apollo::localization::msf::system::CreateDirectory(map_folder_path);
   }
-  map.SetMapFolderPath(map_folder_path);
+  // the config of an existing map is kept, its nodes are loaded when touched
+  // and the new points are added to them
+  const bool map_exists =
+      map.SetMapFolderPath(map_folder_path) && update_existing_map;
+  if (update_existing_map && !map_exists) {
+    std::cerr << "No map to update in " << map_folder_path
+              << ", create a new one." << std::endl;
+  }
   for (size_t i = 0; i < pcd_folder_pathes.size(); ++i) {
     map.AddDataset(pcd_folder_pathes[i]);
   }
-  if (strcasecmp(map_resolution_type.c_str(), "single") == 0) {
-    loss_less_config.SetSingleResolutions(single_resolution_map);
-  } else {
-    loss_less_config.SetMultiResolutions();
-  }
+  // an existing map keeps its resolutions and coordinate type
+  if (!map_exists) {
+    if (strcasecmp(map_resolution_type.c_str(), "single") == 0) {
+      loss_less_config.SetSingleResolutions(single_resolution_map);
+    } else {
+      loss_less_config.SetMultiResolutions();
+    }
 
-  if (strcasecmp(coordinate_type.c_str(), "UTM") == 0) {
-    loss_less_config.coordinate_type_ = "UTM";
-  } else {
-    loss_less_config.coordinate_type_ = "LTM";
-    loss_less_config.map_range_ = apollo::localization::msf::Rect2D<double>(
-        -1638400.0, -1638400.0, 1638400.0, 1638400.0);
+    if (strcasecmp(coordinate_type.c_str(), "UTM") == 0) {
+      loss_less_config.coordinate_type_ = "UTM";
+    } else {
+      loss_less_config.coordinate_type_ = "LTM";
+      loss_less_config.map_range_ = apollo::localization::msf::Rect2D<double>(
+          -1638400.0, -1638400.0, 1638400.0, 1638400.0);
+    }
   }
 
   // Output Config file
@@ -254,7 +275,14 @@ int main(int argc, char** argv) {
   map.InitMapNodeCaches(12, 24);
   map.AttachMapNodePool(&lossless_map_node_pool);
 
+  std::vector<Eigen::Vector3d> pt3ds_global;
+  std::vector<unsigned char> intensities;
   for (unsigned int trial = 0; trial < num_trials; ++trial) {
+    // the frames of a pcd folder may be exported in one pcd archive
+    PcdArchiveReader pcd_archive;
+    const bool use_pcd_archive =
+        PcdArchiveReader::IsArchive(pcd_folder_pathes[trial]) &&
+        pcd_archive.Open(pcd_folder_pathes[trial]);
     for (unsigned int frame_idx = 0; frame_idx < ieout_poses[trial].size();
          ++frame_idx) {
       unsigned int trial_frame_idx = frame_idx;
@@ -265,18 +293,25 @@ int main(int argc, char** argv) {
       ss << pcd_indices[trial][frame_idx];
       pcd_file_path = pcd_folder_pathes[trial] + "/" + ss.str() + ".pcd";
       const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
+      if (use_pcd_archive) {
+        velodyne_frame.frame_index = trial_frame_idx;
+        velodyne_frame.pose = pcd_pose;
+        pcd_archive.Read(pcd_indices[trial][frame_idx], pcd_pose,
+                         &velodyne_frame.pt3ds, &velodyne_frame.intensities);
+      } else {
+        apollo::localization::msf::velodyne::LoadPcds(
+            pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
+      }
       AERROR << "Loaded " << velodyne_frame.pt3ds.size()
              << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
              << ".";
 
+      pt3ds_global.clear();
       for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[i];
-        unsigned char intensity = velodyne_frame.intensities[i];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-        map.SetValue(pt3d_global, zone_id, intensity);
+        pt3ds_global.push_back(velodyne_frame.pose * velodyne_frame.pt3ds[i]);
       }
+      map.SetValues(pt3ds_global, velodyne_frame.intensities, zone_id,
+                    thread_num);
 
       if (use_plane_inliers_only) {
         PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
@@ -292,17 +327,18 @@ int main(int argc, char** argv) {
         plane_extractor.ExtractXYPlane(pcl_pc);
         PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
 
+        pt3ds_global.clear();
+        intensities.clear();
         for (unsigned int k = 0; k < plane_pc->size(); ++k) {
           const PclPointT& plane_pt = plane_pc->at(k);
           Eigen::Vector3d pt3d_local_double;
           pt3d_local_double[0] = plane_pt.x;
           pt3d_local_double[1] = plane_pt.y;
           pt3d_local_double[2] = plane_pt.z;
-          unsigned char intensity =
-              static_cast<unsigned char>(plane_pt.intensity);
-          Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
-          map.SetValueLayer(pt3d_global, zone_id, intensity);
+          intensities.push_back(static_cast<unsigned char>(plane_pt.intensity));
+          pt3ds_global.push_back(velodyne_frame.pose * pt3d_local_double);
         }
+        map.SetValuesLayer(pt3ds_global, intensities, zone_id, thread_num);
       }
     }
   }
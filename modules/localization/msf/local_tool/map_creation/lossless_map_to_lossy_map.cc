@@ -17,6 +17,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <future>
+#include <vector>
+
 #include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_matrix.h"
@@ -113,7 +117,9 @@ int main(int argc, char** argv) {
       "srcdir", boost::program_options::value<std::string>(),
       "provide the data base dir")("dstdir",
                                    boost::program_options::value<std::string>(),
-                                   "provide the lossy map destination dir");
+                                   "provide the lossy map destination dir")(
+      "thread_num", boost::program_options::value<int>()->default_value(1),
+      "threads converting the rows of a map node");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -129,6 +135,7 @@ int main(int argc, char** argv) {
 
   const std::string src_path = boost_args["srcdir"].as<std::string>();
   const std::string dst_path = boost_args["dstdir"].as<std::string>();
+  const int thread_num = boost_args["thread_num"].as<int>();
   std::string src_map_folder = src_path + "/";
 
   LosslessMapConfig lossless_config("lossless_map");
@@ -197,36 +204,47 @@ int main(int argc, char** argv) {
 
     int rows = lossless_config.map_node_size_y_;
     int cols = lossless_config.map_node_size_x_;
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        float intensity = lossless_node->GetValue(row, col);
-        float intensity_var = lossless_node->GetVar(row, col);
-        unsigned int count = lossless_node->GetCount(row, col);
-
-        // Read altitude
-        float altitude_ground = 0.0f;
-        float altitude_avg = 0.0f;
-        bool is_ground_useful = false;
-        std::vector<float> layer_alts;
-        std::vector<unsigned int> layer_counts;
-        lossless_matrix.GetMapCell(row, col).GetCount(&layer_counts);
-        lossless_matrix.GetMapCell(row, col).GetAlt(&layer_alts);
-        if (layer_counts.size() == 0 || layer_alts.size() == 0) {
-          altitude_avg = lossless_node->GetAlt(row, col);
-          is_ground_useful = false;
-        } else {
-          altitude_avg = lossless_node->GetAlt(row, col);
-          altitude_ground = layer_alts[0];
-          is_ground_useful = true;
+    const int num_workers = std::max(1, std::min(thread_num, rows));
+    auto convert_rows = [&](const int worker) {
+      for (int row = worker; row < rows; row += num_workers) {
+        for (int col = 0; col < cols; ++col) {
+          float intensity = lossless_node->GetValue(row, col);
+          float intensity_var = lossless_node->GetVar(row, col);
+          unsigned int count = lossless_node->GetCount(row, col);
+
+          // Read altitude
+          float altitude_ground = 0.0f;
+          float altitude_avg = 0.0f;
+          bool is_ground_useful = false;
+          std::vector<float> layer_alts;
+          std::vector<unsigned int> layer_counts;
+          lossless_matrix.GetMapCell(row, col).GetCount(&layer_counts);
+          lossless_matrix.GetMapCell(row, col).GetAlt(&layer_alts);
+          if (layer_counts.size() == 0 || layer_alts.size() == 0) {
+            altitude_avg = lossless_node->GetAlt(row, col);
+            is_ground_useful = false;
+          } else {
+            altitude_avg = lossless_node->GetAlt(row, col);
+            altitude_ground = layer_alts[0];
+            is_ground_useful = true;
+          }
+
+          lossy_matrix[row][col].intensity = intensity;
+          lossy_matrix[row][col].intensity_var = intensity_var;
+          lossy_matrix[row][col].count = count;
+          lossy_matrix[row][col].altitude = altitude_avg;
+          lossy_matrix[row][col].altitude_ground = altitude_ground;
+          lossy_matrix[row][col].is_ground_useful = is_ground_useful;
         }
-
-        lossy_matrix[row][col].intensity = intensity;
-        lossy_matrix[row][col].intensity_var = intensity_var;
-        lossy_matrix[row][col].count = count;
-        lossy_matrix[row][col].altitude = altitude_avg;
-        lossy_matrix[row][col].altitude_ground = altitude_ground;
-        lossy_matrix[row][col].is_ground_useful = is_ground_useful;
       }
+    };
+    std::vector<std::future<void>> futures;
+    for (int worker = 1; worker < num_workers; ++worker) {
+      futures.push_back(std::async(std::launch::async, convert_rows, worker));
+    }
+    convert_rows(0);
+    for (auto& future : futures) {
+      future.get();
     }
     lossy_node->SetIsChanged(true);
   }
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <string>
+
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+MapNodeIndex GetMapIndexFromMapFolder(const std::string& map_folder) {
+  MapNodeIndex index;
+  char buf[100];
+  sscanf(map_folder.c_str(), "/%03u/%05s/%02d/%08u/%08u", &index.resolution_id_,
+         buf, &index.zone_id_, &index.m_, &index.n_);
+  std::string zone = buf;
+  if (zone == "south") {
+    index.zone_id_ = -index.zone_id_;
+  }
+  return index;
+}
+
+void GetAllMapIndex(const std::string& map_folder,
+                    std::list<MapNodeIndex>* buf) {
+  std::string map_path = map_folder + "/map";
+  buf->clear();
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_path);
+  for (; iter != end_iter; ++iter) {
+    if (!boost::filesystem::is_directory(*iter) &&
+        iter->path().extension() == "") {
+      std::string tmp = iter->path().string();
+      tmp = tmp.substr(map_path.length(), tmp.length());
+      buf->push_back(GetMapIndexFromMapFolder(tmp));
+    }
+  }
+}
+
+// Rewrites the nodes of the map in place with the codec, the nodes are
+// decoded whatever codec they were written with.
+template <class MapConfig, class MapNode>
+int ConvertMapNodes(const std::string& map_folder, const std::string& codec) {
+  MapConfig config;
+  if (!boost::filesystem::exists(map_folder + "/config.xml") ||
+      !config.Load(map_folder + "/config.xml")) {
+    std::cerr << "Map config is invalid!" << std::endl;
+    return -1;
+  }
+  config.map_folder_path_ = map_folder;
+  if (!config.map_is_compression_) {
+    std::cerr << "The nodes of the map are not compressed." << std::endl;
+    return -1;
+  }
+  config.map_compression_codec_ = codec;
+
+  std::list<MapNodeIndex> indices;
+  GetAllMapIndex(map_folder, &indices);
+  std::cout << "index size: " << indices.size() << std::endl;
+
+  double load_time = 0.0;
+  for (const auto& index : indices) {
+    MapNode node;
+    node.Init(&config, index, false);
+    const auto start_time = std::chrono::steady_clock::now();
+    if (!node.Load()) {
+      std::cerr << "Failed to load node " << index << std::endl;
+      return -1;
+    }
+    const std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start_time;
+    load_time += time.count();
+    if (!node.Save()) {
+      std::cerr << "Failed to save node " << index << std::endl;
+      return -1;
+    }
+  }
+  config.Save(map_folder + "/config.xml");
+  if (!indices.empty()) {
+    std::cout << "average load time of the original nodes: "
+              << load_time / static_cast<double>(indices.size()) * 1000.0
+              << " ms" << std::endl;
+  }
+  return 0;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+using apollo::localization::msf::ConvertMapNodes;
+using apollo::localization::msf::LosslessMapConfig;
+using apollo::localization::msf::LosslessMapNode;
+using apollo::localization::msf::LossyMapConfig2D;
+using apollo::localization::msf::LossyMapNode2D;
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "mapdir", boost::program_options::value<std::string>(),
+      "provide the map dir, the nodes are rewritten in place")(
+      "codec", boost::program_options::value<std::string>(),
+      "provide the codec: zlib, lz4 or zstd")(
+      "lossless", "the map is a lossless map instead of a lossy map");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("mapdir") ||
+      !boost_args.count("codec")) {
+    std::cout << boost_desc << std::endl;
+    return 0;
+  }
+
+  const std::string map_folder = boost_args["mapdir"].as<std::string>();
+  const std::string codec = boost_args["codec"].as<std::string>();
+  if (codec != "zlib" && codec != "lz4" && codec != "zstd") {
+    std::cerr << "Unknown codec " << codec << std::endl;
+    return -1;
+  }
+  if (boost_args.count("lossless")) {
+    return ConvertMapNodes<LosslessMapConfig, LosslessMapNode>(map_folder,
+                                                               codec);
+  }
+  return ConvertMapNodes<LossyMapConfig2D, LossyMapNode2D>(map_folder, codec);
+}
@@ -14,7 +14,9 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 
 #include "modules/localization/msf/common/io/velodyne_utility.h"
 #include "modules/localization/msf/local_tool/map_creation/poses_interpolation/poses_interpolation.h"
@@ -27,11 +29,13 @@ PosesInterpolation::PosesInterpolation() {}
 bool PosesInterpolation::Init(const std::string &input_poses_path,
                               const std::string &ref_timestamps_path,
                               const std::string &out_poses_path,
-                              const std::string &extrinsic_path) {
+                              const std::string &extrinsic_path,
+                              int thread_num) {
   this->input_poses_path_ = input_poses_path;
   this->ref_timestamps_path_ = ref_timestamps_path;
   this->out_poses_path_ = out_poses_path;
   this->extrinsic_path_ = extrinsic_path;
+  this->thread_num_ = std::max(1, thread_num);
 
   bool success = velodyne::LoadExtrinsic(extrinsic_path_, &velodyne_extrinsic_);
   if (!success) {
@@ -116,6 +120,9 @@ void PosesInterpolation::PoseInterpolationByTime(
   out_timestamps->clear();
   out_poses->clear();
 
+  // find the input poses around the reference timestamps, then interpolate
+  // the poses on threads
+  std::vector<unsigned int> cur_indexes;
   unsigned int index = 0;
   for (size_t i = 0; i < ref_timestamps.size(); i++) {
     double ref_timestamp = ref_timestamps[i];
@@ -128,30 +135,7 @@ void PosesInterpolation::PoseInterpolationByTime(
 
     if (index < in_timestamps.size()) {
       if (index >= 1) {
-        double cur_timestamp = in_timestamps[index];
-        double pre_timestamp = in_timestamps[index - 1];
-        assert(cur_timestamp != pre_timestamp);
-
-        double t =
-            (cur_timestamp - ref_timestamp) / (cur_timestamp - pre_timestamp);
-        assert(t >= 0.0);
-        assert(t <= 1.0);
-
-        Eigen::Affine3d pre_pose = in_poses[index - 1];
-        Eigen::Affine3d cur_pose = in_poses[index];
-        Eigen::Quaterniond pre_quatd(pre_pose.linear());
-        Eigen::Translation3d pre_transd(pre_pose.translation());
-        Eigen::Quaterniond cur_quatd(cur_pose.linear());
-        Eigen::Translation3d cur_transd(cur_pose.translation());
-
-        Eigen::Quaterniond res_quatd = pre_quatd.slerp(1 - t, cur_quatd);
-
-        Eigen::Translation3d re_transd;
-        re_transd.x() = pre_transd.x() * t + cur_transd.x() * (1 - t);
-        re_transd.y() = pre_transd.y() * t + cur_transd.y() * (1 - t);
-        re_transd.z() = pre_transd.z() * t + cur_transd.z() * (1 - t);
-
-        out_poses->push_back(re_transd * res_quatd);
+        cur_indexes.push_back(index);
         out_indexes->push_back(ref_index);
         out_timestamps->push_back(ref_timestamp);
       }
@@ -159,8 +143,44 @@ void PosesInterpolation::PoseInterpolationByTime(
       std::cerr << "[ERROR] No more poses. Exit now." << std::endl;
       break;
     }
-    std::cout << "Frame_id: " << i << std::endl;
   }
+
+  const int pose_num = static_cast<int>(cur_indexes.size());
+  out_poses->resize(pose_num);
+  const int num_workers = std::max(1, std::min(thread_num_, pose_num));
+  auto interpolate_poses = [&](const int worker) {
+    for (int i = worker; i < pose_num; i += num_workers) {
+      const unsigned int cur_index = cur_indexes[i];
+      double ref_timestamp = (*out_timestamps)[i];
+      double cur_timestamp = in_timestamps[cur_index];
+      double pre_timestamp = in_timestamps[cur_index - 1];
+      assert(cur_timestamp != pre_timestamp);
+
+      double t =
+          (cur_timestamp - ref_timestamp) / (cur_timestamp - pre_timestamp);
+      assert(t >= 0.0);
+      assert(t <= 1.0);
+
+      const Eigen::Affine3d &pre_pose = in_poses[cur_index - 1];
+      const Eigen::Affine3d &cur_pose = in_poses[cur_index];
+      Eigen::Quaterniond pre_quatd(pre_pose.linear());
+      Eigen::Quaterniond cur_quatd(cur_pose.linear());
+      Eigen::Quaterniond res_quatd = pre_quatd.slerp(1 - t, cur_quatd);
+      Eigen::Translation3d re_transd(pre_pose.translation() * t +
+                                     cur_pose.translation() * (1 - t));
+      (*out_poses)[i] = re_transd * res_quatd;
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(
+        std::async(std::launch::async, interpolate_poses, worker));
+  }
+  interpolate_poses(0);
+  for (auto &future : futures) {
+    future.get();
+  }
+  std::cout << "Interpolated poses: " << pose_num << std::endl;
 }
 
 }  // namespace msf
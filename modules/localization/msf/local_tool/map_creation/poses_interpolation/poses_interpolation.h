@@ -40,7 +40,7 @@ class PosesInterpolation {
   bool Init(const std::string &input_poses_path,
             const std::string &ref_timestamps_path,
             const std::string &out_poses_path,
-            const std::string &extrinsic_path);
+            const std::string &extrinsic_path, int thread_num = 1);
   void DoInterpolation();
 
  private:
@@ -59,6 +59,7 @@ class PosesInterpolation {
   std::string ref_timestamps_path_;
   std::string out_poses_path_;
   std::string extrinsic_path_;
+  int thread_num_ = 1;
 
   Eigen::Affine3d velodyne_extrinsic_;
 
@@ -28,7 +28,9 @@ int main(int argc, char **argv) {
       "extrinsic_path", boost::program_options::value<std::string>(),
       "provide velodyne extrinsic path")(
       "output_poses_path", boost::program_options::value<std::string>(),
-      "provide output poses path");
+      "provide output poses path")(
+      "thread_num", boost::program_options::value<int>()->default_value(1),
+      "provide the threads interpolating the poses");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -53,8 +55,9 @@ int main(int argc, char **argv) {
       boost_args["output_poses_path"].as<std::string>();
 
   apollo::localization::msf::PosesInterpolation pose_interpolation;
-  bool success = pose_interpolation.Init(input_poses_path, ref_timestamps_path,
-                                         out_poses_path, extrinsic_path);
+  bool success = pose_interpolation.Init(
+      input_poses_path, ref_timestamps_path, out_poses_path, extrinsic_path,
+      boost_args["thread_num"].as<int>());
 
   if (success) {
     pose_interpolation.DoInterpolation();
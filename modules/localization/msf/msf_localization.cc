@@ -71,6 +71,12 @@ void MSFLocalization::InitParams() {
   localization_param_.lidar_yaw_align_mode = FLAGS_lidar_yaw_align_mode;
   localization_param_.lidar_filter_size = FLAGS_lidar_filter_size;
   localization_param_.map_coverage_theshold = FLAGS_lidar_map_coverage_theshold;
+  localization_param_.map_preload_time = FLAGS_lidar_map_preload_time;
+  localization_param_.map_planar_layers = FLAGS_lidar_map_planar_layers;
+  localization_param_.use_open_lidar_matcher = FLAGS_lidar_use_open_matcher;
+  localization_param_.lidar_matcher_thread_num = FLAGS_lidar_matcher_thread_num;
+  localization_param_.lidar_matcher_coarse_to_fine =
+      FLAGS_lidar_matcher_coarse_to_fine;
   localization_param_.imu_lidar_max_delay_time = FLAGS_lidar_imu_max_delay_time;
   localization_param_.if_use_avx = FLAGS_if_use_avx;
 
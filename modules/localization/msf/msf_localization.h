@@ -73,6 +73,10 @@ class MSFLocalization {
 
   void SetPublisher(const std::shared_ptr<LocalizationMsgPublisher> &publisher);
 
+  const msf::LocalizationIntegParam &GetParams() const {
+    return localization_param_;
+  }
+
  private:
   bool LoadGnssAntennaExtrinsic(const std::string &file_path, double *offset_x,
                                 double *offset_y, double *offset_z,
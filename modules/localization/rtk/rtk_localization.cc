@@ -16,6 +16,7 @@
 
 #include "modules/localization/rtk/rtk_localization.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "modules/common/math/quaternion.h"
@@ -31,10 +32,22 @@ using ::Eigen::Vector3d;
 RTKLocalization::RTKLocalization()
     : map_offset_{0.0, 0.0, 0.0},
       monitor_logger_(
-          apollo::common::monitor::MonitorMessageItem::LOCALIZATION) {}
+          apollo::common::monitor::MonitorMessageItem::LOCALIZATION) {
+  imu_ring_.resize(imu_list_max_size_);
+  imu_ring_timestamps_.resize(imu_list_max_size_);
+}
 
 void RTKLocalization::InitConfig(const rtk_config::Config &config) {
-  imu_list_max_size_ = config.imu_list_max_size();
+  imu_list_max_size_ =
+      std::max(1, static_cast<int>(config.imu_list_max_size()));
+  {
+    std::unique_lock<std::mutex> lock(imu_list_mutex_);
+    imu_ring_.clear();
+    imu_ring_.resize(imu_list_max_size_);
+    imu_ring_timestamps_.assign(imu_list_max_size_, 0.0);
+    imu_ring_begin_ = 0;
+    imu_ring_size_ = 0;
+  }
   gps_imu_time_diff_threshold_ = config.gps_imu_time_diff_threshold();
   map_offset_[0] = config.map_offset_x();
   map_offset_[1] = config.map_offset_y();
@@ -55,7 +68,7 @@ void RTKLocalization::GpsCallback(
   {
     std::unique_lock<std::mutex> lock(imu_list_mutex_);
 
-    if (imu_list_.empty()) {
+    if (imu_ring_size_ == 0) {
       AERROR << "IMU message buffer is empty.";
       if (service_started_) {
         monitor_logger_.ERROR("IMU message buffer is empty.");
@@ -79,6 +92,10 @@ void RTKLocalization::GpsCallback(
   // publish localization messages
   PrepareLocalizationMsg(*gps_msg, &last_localization_result_,
                          &last_localization_status_result_);
+  {
+    std::unique_lock<std::mutex> lock(last_gps_msg_mutex_);
+    last_gps_msg_.CopyFrom(*gps_msg);
+  }
   service_started_ = true;
 
   // watch dog
@@ -102,15 +119,25 @@ void RTKLocalization::GpsStatusCallback(
 void RTKLocalization::ImuCallback(
     const std::shared_ptr<localization::CorrectedImu> &imu_msg) {
   std::unique_lock<std::mutex> lock(imu_list_mutex_);
-  if (imu_list_.size() < imu_list_max_size_) {
-    imu_list_.push_back(*imu_msg);
+  // the oldest message is overwritten once the ring is full, copying into
+  // the kept message reuses its fields
+  size_t slot = 0;
+  if (imu_ring_size_ < imu_ring_.size()) {
+    slot = (imu_ring_begin_ + imu_ring_size_) % imu_ring_.size();
+    ++imu_ring_size_;
   } else {
-    imu_list_.pop_front();
-    imu_list_.push_back(*imu_msg);
+    slot = imu_ring_begin_;
+    imu_ring_begin_ = (imu_ring_begin_ + 1) % imu_ring_.size();
   }
+  imu_ring_[slot].CopyFrom(*imu_msg);
+  imu_ring_timestamps_[slot] = imu_msg->header().timestamp_sec();
   return;
 }
 
+const CorrectedImu &RTKLocalization::ImuAt(const size_t i) const {
+  return imu_ring_[(imu_ring_begin_ + i) % imu_ring_.size()];
+}
+
 bool RTKLocalization::IsServiceStarted() { return service_started_; }
 
 void RTKLocalization::GetLocalization(LocalizationEstimate *localization) {
@@ -123,6 +150,30 @@ void RTKLocalization::GetLocalizationStatus(
   *localization_status = last_localization_status_result_;
 }
 
+bool RTKLocalization::GetImuRateLocalization(
+    const localization::CorrectedImu &imu_msg,
+    LocalizationEstimate *localization) {
+  if (!service_started_) {
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(last_gps_msg_mutex_);
+  ComposeLocalizationMsg(last_gps_msg_, imu_msg, localization);
+  const double time_diff =
+      imu_msg.header().timestamp_sec() - last_gps_msg_.header().timestamp_sec();
+  lock.unlock();
+
+  auto *mutable_pose = localization->mutable_pose();
+  if (mutable_pose->has_position() && mutable_pose->has_linear_velocity()) {
+    auto *position = mutable_pose->mutable_position();
+    const auto &velocity = mutable_pose->linear_velocity();
+    position->set_x(position->x() + velocity.x() * time_diff);
+    position->set_y(position->y() + velocity.y() * time_diff);
+    position->set_z(position->z() + velocity.z() * time_diff);
+  }
+  localization->set_measurement_time(imu_msg.header().timestamp_sec());
+  return true;
+}
+
 void RTKLocalization::RunWatchDog(double gps_timestamp) {
   if (!enable_watch_dog_) {
     return;
@@ -144,10 +195,11 @@ void RTKLocalization::RunWatchDog(double gps_timestamp) {
 
   // check IMU time stamp against system time
   std::unique_lock<std::mutex> lock(imu_list_mutex_);
-  auto imu_msg = imu_list_.back();
+  const double imu_timestamp_sec = imu_ring_timestamps_[
+      (imu_ring_begin_ + imu_ring_size_ - 1) % imu_ring_.size()];
   lock.unlock();
   double imu_delay_sec =
-      common::time::ToSecond(Clock::Now()) - imu_msg.header().timestamp_sec();
+      common::time::ToSecond(Clock::Now()) - imu_timestamp_sec;
   int64_t imu_delay_cycle_cnt =
       static_cast<int64_t>(imu_delay_sec * localization_publish_freq_);
   if (imu_delay_cycle_cnt > report_threshold_err_num_) {
@@ -334,54 +386,55 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
   }
 
   std::unique_lock<std::mutex> lock(imu_list_mutex_);
-  auto imu_list = imu_list_;
-  lock.unlock();
-
-  if (imu_list.empty()) {
+  if (imu_ring_size_ == 0) {
     AERROR << "Cannot find Matching IMU. "
            << "IMU message Queue is empty! GPS timestamp[" << gps_timestamp_sec
            << "]";
     return false;
   }
 
-  // scan imu buffer, find first imu message that is newer than the given
+  // binary search of the first imu message that is newer than the given
   // timestamp
-  auto imu_it = imu_list.begin();
-  for (; imu_it != imu_list.end(); ++imu_it) {
-    if ((*imu_it).header().timestamp_sec() - gps_timestamp_sec >
+  size_t first = 0;
+  size_t count = imu_ring_size_;
+  while (count > 0) {
+    const size_t step = count / 2;
+    const size_t i = first + step;
+    if (imu_ring_timestamps_[(imu_ring_begin_ + i) % imu_ring_.size()] -
+            gps_timestamp_sec >
         std::numeric_limits<double>::min()) {
-      break;
+      count = step;
+    } else {
+      first = i + 1;
+      count -= step + 1;
     }
   }
 
-  if (imu_it != imu_list.end()) {  // found one
-    if (imu_it == imu_list.begin()) {
+  const auto &oldest_imu = ImuAt(0);
+  const auto &newest_imu = ImuAt(imu_ring_size_ - 1);
+  if (first < imu_ring_size_) {  // found one
+    if (first == 0) {
       AERROR << "IMU queue too short or request too old. "
-             << "Oldest timestamp[" << imu_list.front().header().timestamp_sec()
-             << "], Newest timestamp["
-             << imu_list.back().header().timestamp_sec() << "], GPS timestamp["
-             << gps_timestamp_sec << "]";
-      *imu_msg = imu_list.front();  // the oldest imu
+             << "Oldest timestamp[" << oldest_imu.header().timestamp_sec()
+             << "], Newest timestamp[" << newest_imu.header().timestamp_sec()
+             << "], GPS timestamp[" << gps_timestamp_sec << "]";
+      *imu_msg = oldest_imu;  // the oldest imu
     } else {
       // here is the normal case
-      auto imu_it_1 = imu_it;
-      imu_it_1--;
-      if (!(*imu_it).has_header() || !(*imu_it_1).has_header()) {
+      const auto &imu = ImuAt(first);
+      const auto &imu_1 = ImuAt(first - 1);
+      if (!imu.has_header() || !imu_1.has_header()) {
         AERROR << "imu1 and imu_it_1 must both have header.";
         return false;
       }
-      if (!InterpolateIMU(*imu_it_1, *imu_it, gps_timestamp_sec, imu_msg)) {
+      if (!InterpolateIMU(imu_1, imu, gps_timestamp_sec, imu_msg)) {
         AERROR << "failed to interpolate IMU";
         return false;
       }
     }
   } else {
     // give the newest imu, without extrapolation
-    *imu_msg = imu_list.back();
-    if (imu_msg == nullptr) {
-      AERROR << "Fail to get latest observed imu_msg.";
-      return false;
-    }
+    *imu_msg = newest_imu;
 
     if (!imu_msg->has_header()) {
       AERROR << "imu_msg must have header.";
@@ -393,7 +446,7 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
       // 20ms threshold to report error
       AERROR << "Cannot find Matching IMU. "
              << "IMU messages too old"
-             << "Newest timestamp[" << imu_list.back().header().timestamp_sec()
+             << "Newest timestamp[" << newest_imu.header().timestamp_sec()
              << "], GPS timestamp[" << gps_timestamp_sec << "]";
     }
   }
@@ -480,8 +533,7 @@ bool RTKLocalization::FindNearestGpsStatus(
   CHECK_NOTNULL(status);
 
   std::unique_lock<std::mutex> lock(gps_status_list_mutex_);
-  auto gps_status_list = gps_status_list_;
-  lock.unlock();
+  const auto &gps_status_list = gps_status_list_;
 
   double timestamp_diff_sec = 1e8;
   auto nearest_itr = gps_status_list.end();
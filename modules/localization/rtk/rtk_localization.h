@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,6 +50,13 @@ class RTKLocalization {
   bool IsServiceStarted();
   void GetLocalization(LocalizationEstimate *localization);
   void GetLocalizationStatus(LocalizationStatus *localization_status);
+  /**
+   * @brief compose the localization at the time of an IMU message, from the
+   *        latest GPS pose moved with its velocity
+   * @return false before the service is started
+   */
+  bool GetImuRateLocalization(const localization::CorrectedImu &imu_msg,
+                              LocalizationEstimate *localization);
 
  private:
   void RunWatchDog(double gps_timestamp);
@@ -71,10 +80,18 @@ class RTKLocalization {
   bool FindNearestGpsStatus(const double gps_timestamp_sec,
                             drivers::gnss::InsStat *status);
 
+  // the i-th oldest IMU message of the ring, imu_list_mutex_ must be held
+  const localization::CorrectedImu &ImuAt(const size_t i) const;
+
  private:
   std::string module_name_ = "localization";
 
-  std::list<localization::CorrectedImu> imu_list_;
+  // the IMU messages in a ring allocated once, their timestamps are kept
+  // apart for the binary search of the matching IMU
+  std::vector<localization::CorrectedImu> imu_ring_;
+  std::vector<double> imu_ring_timestamps_;
+  size_t imu_ring_begin_ = 0;
+  size_t imu_ring_size_ = 0;
   size_t imu_list_max_size_ = 50;
   std::mutex imu_list_mutex_;
 
@@ -92,10 +109,12 @@ class RTKLocalization {
   double last_reported_timestamp_sec_ = 0.0;
 
   bool enable_watch_dog_ = true;
-  bool service_started_ = false;
+  std::atomic<bool> service_started_{false};
 
-  int64_t localization_seq_num_ = 0;
+  std::atomic<int64_t> localization_seq_num_{0};
   LocalizationEstimate last_localization_result_;
+  localization::Gps last_gps_msg_;
+  std::mutex last_gps_msg_mutex_;
   LocalizationStatus last_localization_status_result_;
 
   int localization_publish_freq_ = 100;
@@ -104,6 +123,8 @@ class RTKLocalization {
 
   FRIEND_TEST(RTKLocalizationTest, InterpolateIMU);
   FRIEND_TEST(RTKLocalizationTest, ComposeLocalizationMsg);
+  FRIEND_TEST(RTKLocalizationTest, FindMatchingIMU);
+  FRIEND_TEST(RTKLocalizationTest, GetImuRateLocalization);
 };
 
 }  // namespace localization
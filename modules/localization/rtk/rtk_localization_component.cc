@@ -22,6 +22,19 @@ namespace localization {
 
 using apollo::common::time::Clock;
 
+namespace {
+
+// the message is reused when the readers hold no reference to it, so that
+// its fields are not allocated again
+template <typename T>
+void ReuseMessage(std::shared_ptr<T> *msg) {
+  if (*msg == nullptr || msg->use_count() > 1) {
+    msg->reset(new T());
+  }
+}
+
+}  // namespace
+
 RTKLocalizationComponent::RTKLocalizationComponent()
     : localization_(new RTKLocalization()) {}
 
@@ -56,6 +69,7 @@ bool RTKLocalizationComponent::InitConfig() {
   gps_status_topic_ = rtk_config.gps_status_topic();
   broadcast_tf_frame_id_ = rtk_config.broadcast_tf_frame_id();
   broadcast_tf_child_frame_id_ = rtk_config.broadcast_tf_child_frame_id();
+  publish_imu_rate_pose_ = rtk_config.publish_imu_rate_pose();
 
   localization_->InitConfig(rtk_config);
 
@@ -65,10 +79,8 @@ bool RTKLocalizationComponent::InitConfig() {
 bool RTKLocalizationComponent::InitIO() {
   corrected_imu_listener_ = node_->CreateReader<localization::CorrectedImu>(
       imu_topic_,
-      std::bind(
-          &RTKLocalization::ImuCallback,
-          localization_.get(),
-          std::placeholders::_1));
+      std::bind(&RTKLocalizationComponent::ImuCallback, this,
+                std::placeholders::_1));
   DCHECK_NOTNULL(corrected_imu_listener_);
 
   gps_status_listener_ = node_->CreateReader<drivers::gnss::InsStat>(
@@ -94,21 +106,39 @@ bool RTKLocalizationComponent::Proc(
   localization_->GpsCallback(gps_msg);
 
   if (localization_->IsServiceStarted()) {
-    LocalizationEstimate localization;
-    localization_->GetLocalization(&localization);
-    LocalizationStatus localization_status;
-    localization_->GetLocalizationStatus(&localization_status);
-
-    // publish localization messages
-    PublishPoseBroadcastTopic(localization);
-    PublishPoseBroadcastTF(localization);
-    PublishLocalizationStatus(localization_status);
+    ReuseMessage(&localization_status_msg_);
+    localization_->GetLocalizationStatus(localization_status_msg_.get());
+
+    // publish localization messages, the poses are published by
+    // ImuCallback() at the IMU rate
+    if (!publish_imu_rate_pose_) {
+      ReuseMessage(&localization_msg_);
+      localization_->GetLocalization(localization_msg_.get());
+      PublishPoseBroadcastTopic(localization_msg_);
+      PublishPoseBroadcastTF(*localization_msg_);
+    }
+    PublishLocalizationStatus(localization_status_msg_);
     ADEBUG << "[OnTimer]: Localization message publish success!";
   }
 
   return true;
 }
 
+void RTKLocalizationComponent::ImuCallback(
+    const std::shared_ptr<localization::CorrectedImu>& imu_msg) {
+  localization_->ImuCallback(imu_msg);
+  if (!publish_imu_rate_pose_) {
+    return;
+  }
+
+  ReuseMessage(&imu_rate_localization_msg_);
+  if (localization_->GetImuRateLocalization(
+          *imu_msg, imu_rate_localization_msg_.get())) {
+    PublishPoseBroadcastTopic(imu_rate_localization_msg_);
+    PublishPoseBroadcastTF(*imu_rate_localization_msg_);
+  }
+}
+
 void RTKLocalizationComponent::PublishPoseBroadcastTF(
     const LocalizationEstimate& localization) {
   // broadcast tf message
@@ -135,13 +165,13 @@ void RTKLocalizationComponent::PublishPoseBroadcastTF(
 }
 
 void RTKLocalizationComponent::PublishPoseBroadcastTopic(
-    const LocalizationEstimate& localization) {
+    const std::shared_ptr<LocalizationEstimate>& localization) {
   localization_talker_->Write(localization);
   return;
 }
 
 void RTKLocalizationComponent::PublishLocalizationStatus(
-    const LocalizationStatus& localization_status) {
+    const std::shared_ptr<LocalizationStatus>& localization_status) {
   localization_status_talker_->Write(localization_status);
   return;
 }
@@ -49,10 +49,14 @@ class RTKLocalizationComponent final
   bool InitConfig();
   bool InitIO();
 
+  void ImuCallback(
+      const std::shared_ptr<localization::CorrectedImu> &imu_msg);
+
   void PublishPoseBroadcastTF(const LocalizationEstimate &localization);
-  void PublishPoseBroadcastTopic(const LocalizationEstimate &localization);
+  void PublishPoseBroadcastTopic(
+      const std::shared_ptr<LocalizationEstimate> &localization);
   void PublishLocalizationStatus(
-      const LocalizationStatus& localization_status);
+      const std::shared_ptr<LocalizationStatus> &localization_status);
 
  private:
   std::shared_ptr<cyber::Reader<localization::CorrectedImu>>
@@ -71,6 +75,13 @@ class RTKLocalizationComponent final
   std::string gps_status_topic_ = "";
   std::string imu_topic_ = "";
 
+  bool publish_imu_rate_pose_ = false;
+
+  // the published messages, reused once their readers released them
+  std::shared_ptr<LocalizationEstimate> localization_msg_;
+  std::shared_ptr<LocalizationEstimate> imu_rate_localization_msg_;
+  std::shared_ptr<LocalizationStatus> localization_status_msg_;
+
   std::string broadcast_tf_frame_id_ = "";
   std::string broadcast_tf_child_frame_id_ = "";
   std::unique_ptr<apollo::transform::TransformBroadcaster> tf2_broadcaster_;
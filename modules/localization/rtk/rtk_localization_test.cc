@@ -16,6 +16,8 @@
 
 #include "modules/localization/rtk/rtk_localization.h"
 
+#include <memory>
+
 #include "google/protobuf/text_format.h"
 #include "gtest/gtest.h"
 
@@ -139,5 +141,56 @@ TEST_F(RTKLocalizationTest, ComposeLocalizationMsg) {
   // TODO(Qi Luo) Update test once got new imu data for euler angle.
 }
 
+TEST_F(RTKLocalizationTest, FindMatchingIMU) {
+  rtk_config::Config config;
+  config.set_imu_list_max_size(4);
+  rtk_localizatoin_->InitConfig(config);
+
+  apollo::localization::CorrectedImu imu;
+  EXPECT_FALSE(rtk_localizatoin_->FindMatchingIMU(1.0, &imu));
+
+  // the two oldest messages are overwritten
+  for (int i = 1; i <= 6; ++i) {
+    auto imu_msg = std::make_shared<apollo::localization::CorrectedImu>();
+    imu_msg->mutable_header()->set_timestamp_sec(i);
+    imu_msg->mutable_imu()->mutable_angular_velocity()->set_x(i * 10.0);
+    rtk_localizatoin_->ImuCallback(imu_msg);
+  }
+
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(4.5, &imu));
+  EXPECT_DOUBLE_EQ(4.5, imu.header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(45.0, imu.imu().angular_velocity().x());
+
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(1.0, &imu));
+  EXPECT_DOUBLE_EQ(3.0, imu.header().timestamp_sec());
+
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(10.0, &imu));
+  EXPECT_DOUBLE_EQ(6.0, imu.header().timestamp_sec());
+}
+
+TEST_F(RTKLocalizationTest, GetImuRateLocalization) {
+  apollo::localization::CorrectedImu imu;
+  load_data("modules/localization/testdata/3_imu_1.pb.txt", &imu);
+  apollo::localization::LocalizationEstimate localization;
+  EXPECT_FALSE(rtk_localizatoin_->GetImuRateLocalization(imu, &localization));
+
+  apollo::localization::Gps gps;
+  load_data("modules/localization/testdata/3_gps_1.pb.txt", &gps);
+  gps.mutable_header()->set_timestamp_sec(100.0);
+  auto *pose = gps.mutable_localization();
+  pose->mutable_linear_velocity()->set_x(10.0);
+  pose->mutable_linear_velocity()->set_y(0.0);
+  pose->mutable_linear_velocity()->set_z(0.0);
+  rtk_localizatoin_->last_gps_msg_ = gps;
+  rtk_localizatoin_->service_started_ = true;
+
+  imu.mutable_header()->set_timestamp_sec(100.01);
+  EXPECT_TRUE(rtk_localizatoin_->GetImuRateLocalization(imu, &localization));
+  EXPECT_DOUBLE_EQ(100.01, localization.measurement_time());
+  EXPECT_NEAR(pose->position().x() + 0.1, localization.pose().position().x(),
+              1e-6);
+  EXPECT_DOUBLE_EQ(pose->position().y(), localization.pose().position().y());
+}
+
 }  // namespace localization
 }  // namespace apollo
@@ -20,6 +20,35 @@ namespace apollo {
 namespace hdmap {
 namespace adapter {
 
+namespace {
+
+// Projections of a thread, proj4 projections can not be shared by threads.
+struct ThreadProjections {
+  ~ThreadProjections() { Reset(); }
+
+  void Reset() {
+    if (pj_from) {
+      pj_free(pj_from);
+      pj_from = nullptr;
+    }
+    if (pj_to) {
+      pj_free(pj_to);
+      pj_to = nullptr;
+    }
+    if (ctx) {
+      pj_ctx_free(ctx);
+      ctx = nullptr;
+    }
+  }
+
+  int param_version = 0;
+  projCtx ctx = nullptr;
+  projPJ pj_from = nullptr;
+  projPJ pj_to = nullptr;
+};
+
+}  // namespace
+
 CoordinateConvertTool::CoordinateConvertTool()
   : pj_from_(nullptr), pj_to_(nullptr) {}
 
@@ -42,6 +71,8 @@ CoordinateConvertTool* CoordinateConvertTool::GetInstance() {
 
 Status CoordinateConvertTool::SetConvertParam(const std::string &source_param,
                                              const std::string &dst_param) {
+  std::lock_guard<std::mutex> lock(param_mutex_);
+  ++param_version_;
   source_convert_param_ = source_param;
   dst_convert_param_ = dst_param;
   if (pj_from_) {
@@ -77,7 +108,23 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
   CHECK_NOTNULL(utm_x);
   CHECK_NOTNULL(utm_y);
   CHECK_NOTNULL(utm_z);
-  if (!pj_from_ || !pj_to_) {
+  thread_local ThreadProjections projections;
+  const int param_version = param_version_.load();
+  if (projections.param_version != param_version) {
+    projections.Reset();
+    projections.param_version = param_version;
+    std::lock_guard<std::mutex> lock(param_mutex_);
+    if (pj_from_ && pj_to_) {
+      projections.ctx = pj_ctx_alloc();
+      projections.pj_from =
+          pj_init_plus_ctx(projections.ctx, source_convert_param_.c_str());
+      projections.pj_to =
+          pj_init_plus_ctx(projections.ctx, dst_convert_param_.c_str());
+    }
+  }
+  projPJ pj_from = projections.pj_from;
+  projPJ pj_to = projections.pj_to;
+  if (!pj_from || !pj_to) {
       std::string err_msg = "no transform param";
       return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
@@ -86,19 +133,19 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
   double gps_latitude = latitude;
   double gps_alt = height_ellipsoid;
 
-  if (pj_is_latlong(pj_from_)) {
+  if (pj_is_latlong(pj_from)) {
     gps_longitude *= DEG_TO_RAD;
     gps_latitude *= DEG_TO_RAD;
     gps_alt = height_ellipsoid;
   }
 
-  if (0 != pj_transform(pj_from_, pj_to_, 1, 1, &gps_longitude,
+  if (0 != pj_transform(pj_from, pj_to, 1, 1, &gps_longitude,
                           &gps_latitude, &gps_alt)) {
     std::string err_msg = "fail to transform coordinate";
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
-  if (pj_is_latlong(pj_to_)) {
+  if (pj_is_latlong(pj_to)) {
     gps_longitude *= RAD_TO_DEG;
     gps_latitude *= RAD_TO_DEG;
   }
@@ -15,6 +15,8 @@ limitations under the License.
 #pragma once
 
 #include <proj_api.h>
+#include <atomic>
+#include <mutex>
 #include <string>
 
 #include "modules/map/hdmap/adapter/xml_parser/status.h"
@@ -34,13 +36,18 @@ class CoordinateConvertTool {
  public:
   Status SetConvertParam(const std::string &source_param,
                         const std::string &dst_param);
+  // Thread safe, every thread converts with its own projections created
+  // from the latest convert params.
   Status CoordiateConvert(const double longitude, const double latitude,
                           const double height_ellipsoid, double* utm_x,
                           double* utm_y, double* utm_z);
 
  private:
+  // guards the convert params
+  std::mutex param_mutex_;
   std::string source_convert_param_;
   std::string dst_convert_param_;
+  std::atomic<int> param_version_{0};
 
   projPJ pj_from_;
   projPJ pj_to_;
@@ -12,8 +12,14 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 =========================================================================*/
+#include <algorithm>
+#include <future>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/map/hdmap/adapter/xml_parser/lanes_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/objects_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/roads_xml_parser.h"
@@ -35,61 +41,99 @@ Status RoadsXmlParser::Parse(const tinyxml2::XMLElement& xml_node,
                              std::vector<RoadInternal>* roads) {
   CHECK_NOTNULL(roads);
 
+  std::vector<const tinyxml2::XMLElement*> road_nodes;
   auto road_node = xml_node.FirstChildElement("road");
   while (road_node) {
-    // road attributes
-    std::string id;
-    std::string junction_id;
-    int checker = UtilXmlParser::QueryStringAttribute(*road_node, "id", &id);
-    checker += UtilXmlParser::QueryStringAttribute(*road_node, "junction",
-                                                   &junction_id);
-    if (checker != tinyxml2::XML_SUCCESS) {
-      std::string err_msg = "Error parsing road attributes";
-      return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
-    }
-    RoadInternal road_internal;
-    road_internal.id = id;
-    road_internal.road.mutable_id()->set_id(id);
-    if (IsRoadBelongToJunction(junction_id)) {
-      road_internal.road.mutable_junction_id()->set_id(junction_id);
-    }
-    // lanes
-    RETURN_IF_ERROR(LanesXmlParser::Parse(*road_node, road_internal.id,
-                                          &road_internal.sections));
-
-    // objects
-    auto sub_node = road_node->FirstChildElement("objects");
-    if (sub_node != nullptr) {
-      // stop line
-      ObjectsXmlParser::ParseStopLines(*sub_node, &road_internal.stop_lines);
-      // crosswalks
-      ObjectsXmlParser::ParseCrosswalks(*sub_node, &road_internal.crosswalks);
-      // clearareas
-      ObjectsXmlParser::ParseClearAreas(*sub_node, &road_internal.clear_areas);
-      // speed_bumps
-      ObjectsXmlParser::ParseSpeedBumps(*sub_node, &road_internal.speed_bumps);
-      // parking_spaces
-      ObjectsXmlParser::ParseParkingSpaces(
-                                    *sub_node, &road_internal.parking_spaces);
-      // pnc_junctions
-      ObjectsXmlParser::ParsePNCJunctions(
-                                    *sub_node, &road_internal.pnc_junctions);
+    road_nodes.push_back(road_node);
+    road_node = road_node->NextSiblingElement("road");
+  }
+
+  const int num_roads = static_cast<int>(road_nodes.size());
+  std::vector<RoadInternal> road_internals(num_roads);
+  std::vector<Status> statuses(num_roads, Status::OK());
+  // the roads are independent of each other and only read the document, so
+  // they are parsed on all the cores with use_parallel_map_compiling
+  const int num_workers =
+      FLAGS_use_parallel_map_compiling
+          ? std::max(1, std::min(static_cast<int>(
+                                     std::thread::hardware_concurrency()),
+                                 num_roads))
+          : 1;
+  auto parse_roads = [&road_nodes, &road_internals, &statuses, num_workers,
+                      num_roads](const int worker) {
+    for (int i = worker; i < num_roads; i += num_workers) {
+      statuses[i] = ParseRoad(*road_nodes[i], &road_internals[i]);
     }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, parse_roads, worker));
+  }
+  parse_roads(0);
+  for (auto& future : futures) {
+    future.get();
+  }
 
-    // signals
-    sub_node = road_node->FirstChildElement("signals");
-    if (sub_node != nullptr) {
-      // traffic lights
-      SignalsXmlParser::ParseTrafficLights(*sub_node,
-                                           &road_internal.traffic_lights);
-      // stop signs
-      SignalsXmlParser::ParseStopSigns(*sub_node, &road_internal.stop_signs);
-      // yield signs
-      SignalsXmlParser::ParseYieldSigns(*sub_node, &road_internal.yield_signs);
+  for (int i = 0; i < num_roads; ++i) {
+    if (!statuses[i].ok()) {
+      return statuses[i];
     }
+    roads->push_back(std::move(road_internals[i]));
+  }
 
-    roads->push_back(road_internal);
-    road_node = road_node->NextSiblingElement("road");
+  return Status::OK();
+}
+
+Status RoadsXmlParser::ParseRoad(const tinyxml2::XMLElement& road_node,
+                                 RoadInternal* road_internal) {
+  // road attributes
+  std::string id;
+  std::string junction_id;
+  int checker = UtilXmlParser::QueryStringAttribute(road_node, "id", &id);
+  checker += UtilXmlParser::QueryStringAttribute(road_node, "junction",
+                                                 &junction_id);
+  if (checker != tinyxml2::XML_SUCCESS) {
+    std::string err_msg = "Error parsing road attributes";
+    return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
+  }
+  road_internal->id = id;
+  road_internal->road.mutable_id()->set_id(id);
+  if (IsRoadBelongToJunction(junction_id)) {
+    road_internal->road.mutable_junction_id()->set_id(junction_id);
+  }
+  // lanes
+  RETURN_IF_ERROR(LanesXmlParser::Parse(road_node, road_internal->id,
+                                        &road_internal->sections));
+
+  // objects
+  auto sub_node = road_node.FirstChildElement("objects");
+  if (sub_node != nullptr) {
+    // stop line
+    ObjectsXmlParser::ParseStopLines(*sub_node, &road_internal->stop_lines);
+    // crosswalks
+    ObjectsXmlParser::ParseCrosswalks(*sub_node, &road_internal->crosswalks);
+    // clearareas
+    ObjectsXmlParser::ParseClearAreas(*sub_node, &road_internal->clear_areas);
+    // speed_bumps
+    ObjectsXmlParser::ParseSpeedBumps(*sub_node, &road_internal->speed_bumps);
+    // parking_spaces
+    ObjectsXmlParser::ParseParkingSpaces(*sub_node,
+                                         &road_internal->parking_spaces);
+    // pnc_junctions
+    ObjectsXmlParser::ParsePNCJunctions(*sub_node,
+                                        &road_internal->pnc_junctions);
+  }
+
+  // signals
+  sub_node = road_node.FirstChildElement("signals");
+  if (sub_node != nullptr) {
+    // traffic lights
+    SignalsXmlParser::ParseTrafficLights(*sub_node,
+                                         &road_internal->traffic_lights);
+    // stop signs
+    SignalsXmlParser::ParseStopSigns(*sub_node, &road_internal->stop_signs);
+    // yield signs
+    SignalsXmlParser::ParseYieldSigns(*sub_node, &road_internal->yield_signs);
   }
 
   return Status::OK();
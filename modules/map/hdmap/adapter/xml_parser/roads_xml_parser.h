@@ -29,6 +29,10 @@ class RoadsXmlParser {
  public:
   static Status Parse(const tinyxml2::XMLElement& xml_node,
                       std::vector<RoadInternal>* roads);
+
+ private:
+  static Status ParseRoad(const tinyxml2::XMLElement& road_node,
+                          RoadInternal* road_internal);
 };
 
 }  // namespace adapter
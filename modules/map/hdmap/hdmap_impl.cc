@@ -15,11 +15,25 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap_impl.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <future>
 #include <limits>
 #include <set>
+#include <thread>
 #include <unordered_set>
 
+#include "google/protobuf/io/coded_stream.h"
+
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
@@ -38,11 +52,109 @@ Id CreateHDMapId(const std::string& string_id) {
   return id;
 }
 
+// A lane query cache entry, holding the lane segments which may be within
+// the queried distance of any point of a cell of the quantized positions.
+struct LaneQueryCacheEntry {
+  // 0 for an empty entry
+  uint64_t map_generation = 0;
+  int64_t cell_x = 0;
+  int64_t cell_y = 0;
+  int64_t radius_steps = 0;
+  std::vector<const LaneSegmentBox*> segments;
+};
+
+// entries of the direct mapped lane query cache of every thread
+constexpr size_t kLaneQueryCacheSize = 64;
+
+// numbers the loaded maps so that the cache entries of a map are never
+// returned for another one
+std::atomic<uint64_t> map_generation_counter(0);
+
 // default lanes search radius in GetForwardNearestSignalsOnLane
 constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
 constexpr int kBackwardDistance = 4;
 
+// Parses a binary map from a read only mapping of the file, so the bytes are
+// read from the page cache shared by all the processes loading the map
+// instead of being copied through a stream. Maps larger than the default
+// protobuf limit of 64MB are accepted.
+bool LoadBinaryMap(const std::string& map_filename, Map* map) {
+  const int fd = open(map_filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0 || file_stat.st_size == 0 ||
+      file_stat.st_size > INT_MAX) {
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  madvise(addr, size, MADV_SEQUENTIAL);
+  google::protobuf::io::CodedInputStream coded_input(
+      static_cast<const uint8_t*>(addr), static_cast<int>(size));
+  coded_input.SetTotalBytesLimit(INT_MAX, INT_MAX);
+  const bool success = map->ParseFromCodedStream(&coded_input);
+  munmap(addr, size);
+  return success;
+}
+
+// Runs the tasks on their own threads with use_parallel_map_loading, or one
+// after another.
+void RunTasks(const std::vector<std::function<void()>>& tasks) {
+  if (!FLAGS_use_parallel_map_loading) {
+    for (const auto& task : tasks) {
+      task();
+    }
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  futures.reserve(tasks.size());
+  for (const auto& task : tasks) {
+    futures.push_back(std::async(std::launch::async, task));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+// Fills the table with the infos of the elements. The infos are constructed
+// on all the cores with use_parallel_map_loading and inserted in the order
+// of the elements, so a duplicated id keeps the last element either way.
+template <class Info, class Elements, class Table>
+void BuildTable(const Elements& elements, Table* table) {
+  if (!FLAGS_use_parallel_map_loading) {
+    for (const auto& element : elements) {
+      (*table)[element.id().id()].reset(new Info(element));
+    }
+    return;
+  }
+  const int num_elements = elements.size();
+  std::vector<std::shared_ptr<Info>> infos(num_elements);
+  const int num_workers = std::max(
+      1, std::min(static_cast<int>(std::thread::hardware_concurrency()),
+                  num_elements));
+  std::vector<std::function<void()>> tasks;
+  for (int worker = 0; worker < num_workers; ++worker) {
+    tasks.push_back([&elements, &infos, worker, num_workers, num_elements] {
+      for (int i = worker; i < num_elements; i += num_workers) {
+        infos[i].reset(new Info(elements.Get(i)));
+      }
+    });
+  }
+  RunTasks(tasks);
+  table->reserve(table->size() + num_elements);
+  for (int i = 0; i < num_elements; ++i) {
+    (*table)[elements.Get(i).id().id()] = std::move(infos[i]);
+  }
+}
+
 }  // namespace
 
 int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
@@ -53,7 +165,9 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
     if (!adapter::OpendriveAdapter::LoadData(map_filename, &map_)) {
       return -1;
     }
-  } else if (!apollo::common::util::GetProtoFromFile(map_filename, &map_)) {
+  } else if (!(apollo::common::util::EndWith(map_filename, ".bin") &&
+                 LoadBinaryMap(map_filename, &map_)) &&
+             !apollo::common::util::GetProtoFromFile(map_filename, &map_)) {
     return -1;
   }
 
@@ -65,48 +179,18 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
     Clear();
     map_ = map_proto;
   }
-  for (const auto& lane : map_.lane()) {
-    lane_table_[lane.id().id()].reset(new LaneInfo(lane));
-  }
-  for (const auto& junction : map_.junction()) {
-    junction_table_[junction.id().id()].reset(new JunctionInfo(junction));
-  }
-  for (const auto& signal : map_.signal()) {
-    signal_table_[signal.id().id()].reset(new SignalInfo(signal));
-  }
-  for (const auto& crosswalk : map_.crosswalk()) {
-    crosswalk_table_[crosswalk.id().id()].reset(new CrosswalkInfo(crosswalk));
-  }
-  for (const auto& stop_sign : map_.stop_sign()) {
-    stop_sign_table_[stop_sign.id().id()].reset(new StopSignInfo(stop_sign));
-  }
-  for (const auto& yield_sign : map_.yield()) {
-    yield_sign_table_[yield_sign.id().id()].reset(
-        new YieldSignInfo(yield_sign));
-  }
-  for (const auto& clear_area : map_.clear_area()) {
-    clear_area_table_[clear_area.id().id()].reset(
-        new ClearAreaInfo(clear_area));
-  }
-  for (const auto& speed_bump : map_.speed_bump()) {
-    speed_bump_table_[speed_bump.id().id()].reset(
-        new SpeedBumpInfo(speed_bump));
-  }
-  for (const auto& parking_space : map_.parking_space()) {
-    parking_space_table_[parking_space.id().id()].reset(
-        new ParkingSpaceInfo(parking_space));
-  }
-  for (const auto& pnc_junction : map_.pnc_junction()) {
-    pnc_junction_table_[pnc_junction.id().id()].reset(
-        new PNCJunctionInfo(pnc_junction));
-  }
-  for (const auto& overlap : map_.overlap()) {
-    overlap_table_[overlap.id().id()].reset(new OverlapInfo(overlap));
-  }
-
-  for (const auto& road : map_.road()) {
-    road_table_[road.id().id()].reset(new RoadInfo(road));
-  }
+  BuildTable<LaneInfo>(map_.lane(), &lane_table_);
+  BuildTable<JunctionInfo>(map_.junction(), &junction_table_);
+  BuildTable<SignalInfo>(map_.signal(), &signal_table_);
+  BuildTable<CrosswalkInfo>(map_.crosswalk(), &crosswalk_table_);
+  BuildTable<StopSignInfo>(map_.stop_sign(), &stop_sign_table_);
+  BuildTable<YieldSignInfo>(map_.yield(), &yield_sign_table_);
+  BuildTable<ClearAreaInfo>(map_.clear_area(), &clear_area_table_);
+  BuildTable<SpeedBumpInfo>(map_.speed_bump(), &speed_bump_table_);
+  BuildTable<ParkingSpaceInfo>(map_.parking_space(), &parking_space_table_);
+  BuildTable<PNCJunctionInfo>(map_.pnc_junction(), &pnc_junction_table_);
+  BuildTable<OverlapInfo>(map_.overlap(), &overlap_table_);
+  BuildTable<RoadInfo>(map_.road(), &road_table_);
   for (const auto& road_ptr_pair : road_table_) {
     const auto& road_id = road_ptr_pair.second->id();
     for (const auto& road_section : road_ptr_pair.second->sections()) {
@@ -131,16 +215,18 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   for (const auto& stop_sign_ptr_pair : stop_sign_table_) {
     stop_sign_ptr_pair.second->PostProcess(*this);
   }
-  BuildLaneSegmentKDTree();
-  BuildJunctionPolygonKDTree();
-  BuildSignalSegmentKDTree();
-  BuildCrosswalkPolygonKDTree();
-  BuildStopSignSegmentKDTree();
-  BuildYieldSignSegmentKDTree();
-  BuildClearAreaPolygonKDTree();
-  BuildSpeedBumpSegmentKDTree();
-  BuildParkingSpacePolygonKDTree();
-  BuildPNCJunctionPolygonKDTree();
+  // the kd-trees of the element types are independent
+  RunTasks({[this] { BuildLaneSegmentKDTree(); },
+            [this] { BuildJunctionPolygonKDTree(); },
+            [this] { BuildSignalSegmentKDTree(); },
+            [this] { BuildCrosswalkPolygonKDTree(); },
+            [this] { BuildStopSignSegmentKDTree(); },
+            [this] { BuildYieldSignSegmentKDTree(); },
+            [this] { BuildClearAreaPolygonKDTree(); },
+            [this] { BuildSpeedBumpSegmentKDTree(); },
+            [this] { BuildParkingSpacePolygonKDTree(); },
+            [this] { BuildPNCJunctionPolygonKDTree(); }});
+  map_generation_ = ++map_generation_counter;
   return 0;
 }
 
@@ -215,15 +301,51 @@ int HDMapImpl::GetLanes(const Vec2d& point, double distance,
     return -1;
   }
   lanes->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *lane_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    lanes->emplace_back(GetLaneById(CreateHDMapId(id)));
+  if (FLAGS_use_hdmap_query_cache && distance >= 0.0) {
+    return GetLanesFromCache(point, distance, lanes);
+  }
+  return SearchObjects(point, distance, *lane_segment_kdtree_,
+                       lane_segment_boxes_, lane_segment_objects_, lanes);
+}
+
+int HDMapImpl::GetLanesFromCache(const Vec2d& point, const double distance,
+                                 std::vector<LaneInfoConstPtr>* lanes) const {
+  const double resolution = FLAGS_hdmap_query_cache_resolution;
+  const int64_t cell_x =
+      static_cast<int64_t>(std::floor(point.x() / resolution));
+  const int64_t cell_y =
+      static_cast<int64_t>(std::floor(point.y() / resolution));
+  const int64_t radius_steps =
+      static_cast<int64_t>(std::ceil(distance / resolution));
+  const uint64_t hash = static_cast<uint64_t>(cell_x) * 73856093u ^
+                        static_cast<uint64_t>(cell_y) * 19349663u ^
+                        static_cast<uint64_t>(radius_steps) * 83492791u;
+
+  thread_local std::vector<LaneQueryCacheEntry> cache(kLaneQueryCacheSize);
+  LaneQueryCacheEntry& entry = cache[hash % kLaneQueryCacheSize];
+  if (entry.map_generation != map_generation_ || entry.cell_x != cell_x ||
+      entry.cell_y != cell_y || entry.radius_steps != radius_steps) {
+    // every segment within the distance of a point of the cell is within
+    // this radius of the cell center
+    const Vec2d cell_center((static_cast<double>(cell_x) + 0.5) * resolution,
+                            (static_cast<double>(cell_y) + 0.5) * resolution);
+    const double radius = static_cast<double>(radius_steps) * resolution +
+                          resolution * std::sqrt(0.5);
+    entry.map_generation = map_generation_;
+    entry.cell_x = cell_x;
+    entry.cell_y = cell_y;
+    entry.radius_steps = radius_steps;
+    entry.segments = lane_segment_kdtree_->GetObjects(cell_center, radius);
+  }
+
+  std::vector<const LaneSegmentBox*> segments;
+  const double distance_sqr = distance * distance;
+  for (const auto* segment : entry.segments) {
+    if (segment->DistanceSquareTo(point) <= distance_sqr) {
+      segments.push_back(segment);
+    }
   }
+  CollectObjects(segments, lane_segment_boxes_, lane_segment_objects_, lanes);
   return 0;
 }
 
@@ -267,16 +389,9 @@ int HDMapImpl::GetJunctions(
     return -1;
   }
   junctions->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *junction_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    junctions->emplace_back(GetJunctionById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *junction_polygon_kdtree_,
+                       junction_polygon_boxes_, junction_polygon_objects_,
+                       junctions);
 }
 
 int HDMapImpl::GetSignals(const PointENU& point, double distance,
@@ -290,16 +405,8 @@ int HDMapImpl::GetSignals(const Vec2d& point, double distance,
     return -1;
   }
   signals->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *signal_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    signals->emplace_back(GetSignalById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *signal_segment_kdtree_,
+                       signal_segment_boxes_, signal_segment_objects_, signals);
 }
 
 int HDMapImpl::GetCrosswalks(
@@ -315,16 +422,9 @@ int HDMapImpl::GetCrosswalks(
     return -1;
   }
   crosswalks->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *crosswalk_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    crosswalks->emplace_back(GetCrosswalkById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *crosswalk_polygon_kdtree_,
+                       crosswalk_polygon_boxes_, crosswalk_polygon_objects_,
+                       crosswalks);
 }
 
 int HDMapImpl::GetStopSigns(
@@ -340,16 +440,9 @@ int HDMapImpl::GetStopSigns(
     return -1;
   }
   stop_signs->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *stop_sign_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    stop_signs->emplace_back(GetStopSignById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *stop_sign_segment_kdtree_,
+                       stop_sign_segment_boxes_, stop_sign_segment_objects_,
+                       stop_signs);
 }
 
 int HDMapImpl::GetYieldSigns(
@@ -365,17 +458,9 @@ int HDMapImpl::GetYieldSigns(
     return -1;
   }
   yield_signs->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *yield_sign_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    yield_signs->emplace_back(GetYieldSignById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *yield_sign_segment_kdtree_,
+                       yield_sign_segment_boxes_, yield_sign_segment_objects_,
+                       yield_signs);
 }
 
 int HDMapImpl::GetClearAreas(
@@ -391,17 +476,9 @@ int HDMapImpl::GetClearAreas(
     return -1;
   }
   clear_areas->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *clear_area_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    clear_areas->emplace_back(GetClearAreaById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *clear_area_polygon_kdtree_,
+                       clear_area_polygon_boxes_, clear_area_polygon_objects_,
+                       clear_areas);
 }
 
 int HDMapImpl::GetSpeedBumps(
@@ -417,17 +494,9 @@ int HDMapImpl::GetSpeedBumps(
     return -1;
   }
   speed_bumps->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *speed_bump_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    speed_bumps->emplace_back(GetSpeedBumpById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *speed_bump_segment_kdtree_,
+                       speed_bump_segment_boxes_, speed_bump_segment_objects_,
+                       speed_bumps);
 }
 
 int HDMapImpl::GetParkingSpaces(
@@ -443,17 +512,9 @@ int HDMapImpl::GetParkingSpaces(
     return -1;
   }
   parking_spaces->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *parking_space_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    parking_spaces->emplace_back(GetParkingSpaceById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *parking_space_polygon_kdtree_,
+                       parking_space_polygon_boxes_,
+                       parking_space_polygon_objects_, parking_spaces);
 }
 
 int HDMapImpl::GetPNCJunctions(
@@ -470,18 +531,9 @@ int HDMapImpl::GetPNCJunctions(
   }
   pnc_junctions->clear();
 
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *pnc_junction_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-
-  for (const auto& id : ids) {
-    pnc_junctions->emplace_back(GetPNCJunctionById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *pnc_junction_polygon_kdtree_,
+                       pnc_junction_polygon_boxes_,
+                       pnc_junction_polygon_objects_, pnc_junctions);
 }
 
 int HDMapImpl::GetNearestLane(const PointENU& point,
@@ -1170,34 +1222,46 @@ int HDMapImpl::GetLocalMap(const apollo::common::PointENU& point,
   return 0;
 }
 
-template <class Table, class BoxTable, class KDTree>
+template <class Table, class BoxTable, class KDTree, class Info>
 void HDMapImpl::BuildSegmentKDTree(const Table& table,
                                    const AABoxKDTreeParams& params,
                                    BoxTable* const box_table,
+                                   BoxObjects<Info>* const box_objects,
                                    std::unique_ptr<KDTree>* const kdtree) {
   box_table->clear();
+  box_objects->infos.clear();
+  box_objects->object_ids.clear();
   for (const auto& info_with_id : table) {
     const auto* info = info_with_id.second.get();
+    const int object_id = static_cast<int>(box_objects->infos.size());
+    box_objects->infos.push_back(info_with_id.second);
     for (size_t id = 0; id < info->segments().size(); ++id) {
       const auto& segment = info->segments()[id];
       box_table->emplace_back(
           apollo::common::math::AABox2d(segment.start(), segment.end()), info,
           &segment, id);
+      box_objects->object_ids.push_back(object_id);
     }
   }
   kdtree->reset(new KDTree(*box_table, params));
 }
 
-template <class Table, class BoxTable, class KDTree>
+template <class Table, class BoxTable, class KDTree, class Info>
 void HDMapImpl::BuildPolygonKDTree(const Table& table,
                                    const AABoxKDTreeParams& params,
                                    BoxTable* const box_table,
+                                   BoxObjects<Info>* const box_objects,
                                    std::unique_ptr<KDTree>* const kdtree) {
   box_table->clear();
+  box_objects->infos.clear();
+  box_objects->object_ids.clear();
   for (const auto& info_with_id : table) {
     const auto* info = info_with_id.second.get();
     const auto& polygon = info->polygon();
     box_table->emplace_back(polygon.AABoundingBox(), info, &polygon, 0);
+    box_objects->object_ids.push_back(
+        static_cast<int>(box_objects->infos.size()));
+    box_objects->infos.push_back(info_with_id.second);
   }
   kdtree->reset(new KDTree(*box_table, params));
 }
@@ -1207,7 +1271,7 @@ void HDMapImpl::BuildLaneSegmentKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 16;
   BuildSegmentKDTree(lane_table_, params, &lane_segment_boxes_,
-                     &lane_segment_kdtree_);
+                     &lane_segment_objects_, &lane_segment_kdtree_);
 }
 
 void HDMapImpl::BuildJunctionPolygonKDTree() {
@@ -1215,7 +1279,7 @@ void HDMapImpl::BuildJunctionPolygonKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 1;
   BuildPolygonKDTree(junction_table_, params, &junction_polygon_boxes_,
-                     &junction_polygon_kdtree_);
+                     &junction_polygon_objects_, &junction_polygon_kdtree_);
 }
 
 void HDMapImpl::BuildCrosswalkPolygonKDTree() {
@@ -1223,7 +1287,7 @@ void HDMapImpl::BuildCrosswalkPolygonKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 1;
   BuildPolygonKDTree(crosswalk_table_, params, &crosswalk_polygon_boxes_,
-                     &crosswalk_polygon_kdtree_);
+                     &crosswalk_polygon_objects_, &crosswalk_polygon_kdtree_);
 }
 
 void HDMapImpl::BuildSignalSegmentKDTree() {
@@ -1231,7 +1295,7 @@ void HDMapImpl::BuildSignalSegmentKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 4;
   BuildSegmentKDTree(signal_table_, params, &signal_segment_boxes_,
-                     &signal_segment_kdtree_);
+                     &signal_segment_objects_, &signal_segment_kdtree_);
 }
 
 void HDMapImpl::BuildStopSignSegmentKDTree() {
@@ -1239,7 +1303,7 @@ void HDMapImpl::BuildStopSignSegmentKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 4;
   BuildSegmentKDTree(stop_sign_table_, params, &stop_sign_segment_boxes_,
-                     &stop_sign_segment_kdtree_);
+                     &stop_sign_segment_objects_, &stop_sign_segment_kdtree_);
 }
 
 void HDMapImpl::BuildYieldSignSegmentKDTree() {
@@ -1247,7 +1311,7 @@ void HDMapImpl::BuildYieldSignSegmentKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 4;
   BuildSegmentKDTree(yield_sign_table_, params, &yield_sign_segment_boxes_,
-                     &yield_sign_segment_kdtree_);
+                     &yield_sign_segment_objects_, &yield_sign_segment_kdtree_);
 }
 
 void HDMapImpl::BuildClearAreaPolygonKDTree() {
@@ -1255,7 +1319,7 @@ void HDMapImpl::BuildClearAreaPolygonKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 4;
   BuildPolygonKDTree(clear_area_table_, params, &clear_area_polygon_boxes_,
-                     &clear_area_polygon_kdtree_);
+                     &clear_area_polygon_objects_, &clear_area_polygon_kdtree_);
 }
 
 void HDMapImpl::BuildSpeedBumpSegmentKDTree() {
@@ -1263,7 +1327,7 @@ void HDMapImpl::BuildSpeedBumpSegmentKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 4;
   BuildSegmentKDTree(speed_bump_table_, params, &speed_bump_segment_boxes_,
-                     &speed_bump_segment_kdtree_);
+                     &speed_bump_segment_objects_, &speed_bump_segment_kdtree_);
 }
 
 void HDMapImpl::BuildParkingSpacePolygonKDTree() {
@@ -1272,6 +1336,7 @@ void HDMapImpl::BuildParkingSpacePolygonKDTree() {
   params.max_leaf_size = 4;
   BuildPolygonKDTree(parking_space_table_, params,
                      &parking_space_polygon_boxes_,
+                     &parking_space_polygon_objects_,
                      &parking_space_polygon_kdtree_);
 }
 
@@ -1280,28 +1345,42 @@ void HDMapImpl::BuildPNCJunctionPolygonKDTree() {
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 1;
   BuildPolygonKDTree(pnc_junction_table_, params, &pnc_junction_polygon_boxes_,
+                     &pnc_junction_polygon_objects_,
                      &pnc_junction_polygon_kdtree_);
 }
 
-template <class KDTree>
-int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
-                             const KDTree& kdtree,
-                             std::vector<std::string>* const results) {
+template <class KDTree, class Box, class Info>
+int HDMapImpl::SearchObjects(
+    const Vec2d& center, const double radius, const KDTree& kdtree,
+    const std::vector<Box>& box_table, const BoxObjects<Info>& box_objects,
+    std::vector<std::shared_ptr<const Info>>* const results) {
   if (results == nullptr) {
     return -1;
   }
-  auto objects = kdtree.GetObjects(center, radius);
-  std::unordered_set<std::string> result_ids;
-  result_ids.reserve(objects.size());
-  for (const auto* object_ptr : objects) {
-    result_ids.insert(object_ptr->object()->id().id());
-  }
-
-  results->reserve(result_ids.size());
-  results->assign(result_ids.begin(), result_ids.end());
+  CollectObjects(kdtree.GetObjects(center, radius), box_table, box_objects,
+                 results);
   return 0;
 }
 
+template <class Box, class Info>
+void HDMapImpl::CollectObjects(
+    const std::vector<const Box*>& boxes, const std::vector<Box>& box_table,
+    const BoxObjects<Info>& box_objects,
+    std::vector<std::shared_ptr<const Info>>* const results) {
+  std::vector<int> object_ids;
+  object_ids.reserve(boxes.size());
+  for (const Box* box : boxes) {
+    object_ids.push_back(box_objects.object_ids[box - box_table.data()]);
+  }
+  std::sort(object_ids.begin(), object_ids.end());
+  object_ids.erase(std::unique(object_ids.begin(), object_ids.end()),
+                   object_ids.end());
+  results->reserve(results->size() + object_ids.size());
+  for (const int object_id : object_ids) {
+    results->emplace_back(box_objects.infos[object_id]);
+  }
+}
+
 void HDMapImpl::Clear() {
   map_.Clear();
   lane_table_.clear();
@@ -1312,25 +1391,36 @@ void HDMapImpl::Clear() {
   yield_sign_table_.clear();
   overlap_table_.clear();
   lane_segment_boxes_.clear();
+  lane_segment_objects_ = {};
   lane_segment_kdtree_.reset(nullptr);
   junction_polygon_boxes_.clear();
+  junction_polygon_objects_ = {};
   junction_polygon_kdtree_.reset(nullptr);
   crosswalk_polygon_boxes_.clear();
+  crosswalk_polygon_objects_ = {};
   crosswalk_polygon_kdtree_.reset(nullptr);
   signal_segment_boxes_.clear();
+  signal_segment_objects_ = {};
   signal_segment_kdtree_.reset(nullptr);
   stop_sign_segment_boxes_.clear();
+  stop_sign_segment_objects_ = {};
   stop_sign_segment_kdtree_.reset(nullptr);
   yield_sign_segment_boxes_.clear();
+  yield_sign_segment_objects_ = {};
   yield_sign_segment_kdtree_.reset(nullptr);
   clear_area_polygon_boxes_.clear();
+  clear_area_polygon_objects_ = {};
   clear_area_polygon_kdtree_.reset(nullptr);
   speed_bump_segment_boxes_.clear();
+  speed_bump_segment_objects_ = {};
   speed_bump_segment_kdtree_.reset(nullptr);
   parking_space_polygon_boxes_.clear();
+  parking_space_polygon_objects_ = {};
   parking_space_polygon_kdtree_.reset(nullptr);
   pnc_junction_polygon_boxes_.clear();
+  pnc_junction_polygon_objects_ = {};
   pnc_junction_polygon_kdtree_.reset(nullptr);
+  map_generation_ = 0;
 }
 
 }  // namespace hdmap
@@ -15,6 +15,7 @@ limitations under the License.
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -366,15 +367,27 @@ class HDMapImpl {
   int GetRoads(const apollo::common::math::Vec2d& point, double distance,
                std::vector<RoadInfoConstPtr>* roads) const;
 
-  template <class Table, class BoxTable, class KDTree>
+  // The objects of the boxes of a kd-tree, numbered with dense integer ids
+  // so that searches dedupe their results without hashing string ids.
+  template <class Info>
+  struct BoxObjects {
+    // the object of every id
+    std::vector<std::shared_ptr<Info>> infos;
+    // the object id of every box, in the order of the box table
+    std::vector<int> object_ids;
+  };
+
+  template <class Table, class BoxTable, class KDTree, class Info>
   static void BuildSegmentKDTree(
       const Table& table, const apollo::common::math::AABoxKDTreeParams& params,
-      BoxTable* const box_table, std::unique_ptr<KDTree>* const kdtree);
+      BoxTable* const box_table, BoxObjects<Info>* const box_objects,
+      std::unique_ptr<KDTree>* const kdtree);
 
-  template <class Table, class BoxTable, class KDTree>
+  template <class Table, class BoxTable, class KDTree, class Info>
   static void BuildPolygonKDTree(
       const Table& table, const apollo::common::math::AABoxKDTreeParams& params,
-      BoxTable* const box_table, std::unique_ptr<KDTree>* const kdtree);
+      BoxTable* const box_table, BoxObjects<Info>* const box_objects,
+      std::unique_ptr<KDTree>* const kdtree);
 
   void BuildLaneSegmentKDTree();
   void BuildJunctionPolygonKDTree();
@@ -387,10 +400,24 @@ class HDMapImpl {
   void BuildParkingSpacePolygonKDTree();
   void BuildPNCJunctionPolygonKDTree();
 
-  template <class KDTree>
-  static int SearchObjects(const apollo::common::math::Vec2d& center,
-                           const double radius, const KDTree& kdtree,
-                           std::vector<std::string>* const results);
+  template <class KDTree, class Box, class Info>
+  static int SearchObjects(
+      const apollo::common::math::Vec2d& center, const double radius,
+      const KDTree& kdtree, const std::vector<Box>& box_table,
+      const BoxObjects<Info>& box_objects,
+      std::vector<std::shared_ptr<const Info>>* const results);
+
+  // Appends the distinct objects of the boxes to the results.
+  template <class Box, class Info>
+  static void CollectObjects(
+      const std::vector<const Box*>& boxes, const std::vector<Box>& box_table,
+      const BoxObjects<Info>& box_objects,
+      std::vector<std::shared_ptr<const Info>>* const results);
+
+  // Searches the lanes through the query cache of the calling thread.
+  int GetLanesFromCache(const apollo::common::math::Vec2d& point,
+                        const double distance,
+                        std::vector<LaneInfoConstPtr>* lanes) const;
 
   void Clear();
 
@@ -410,34 +437,47 @@ class HDMapImpl {
   PNCJunctionTable pnc_junction_table_;
 
   std::vector<LaneSegmentBox> lane_segment_boxes_;
+  BoxObjects<LaneInfo> lane_segment_objects_;
   std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
 
   std::vector<JunctionPolygonBox> junction_polygon_boxes_;
+  BoxObjects<JunctionInfo> junction_polygon_objects_;
   std::unique_ptr<JunctionPolygonKDTree> junction_polygon_kdtree_;
 
   std::vector<CrosswalkPolygonBox> crosswalk_polygon_boxes_;
+  BoxObjects<CrosswalkInfo> crosswalk_polygon_objects_;
   std::unique_ptr<CrosswalkPolygonKDTree> crosswalk_polygon_kdtree_;
 
   std::vector<SignalSegmentBox> signal_segment_boxes_;
+  BoxObjects<SignalInfo> signal_segment_objects_;
   std::unique_ptr<SignalSegmentKDTree> signal_segment_kdtree_;
 
   std::vector<StopSignSegmentBox> stop_sign_segment_boxes_;
+  BoxObjects<StopSignInfo> stop_sign_segment_objects_;
   std::unique_ptr<StopSignSegmentKDTree> stop_sign_segment_kdtree_;
 
   std::vector<YieldSignSegmentBox> yield_sign_segment_boxes_;
+  BoxObjects<YieldSignInfo> yield_sign_segment_objects_;
   std::unique_ptr<YieldSignSegmentKDTree> yield_sign_segment_kdtree_;
 
   std::vector<ClearAreaPolygonBox> clear_area_polygon_boxes_;
+  BoxObjects<ClearAreaInfo> clear_area_polygon_objects_;
   std::unique_ptr<ClearAreaPolygonKDTree> clear_area_polygon_kdtree_;
 
   std::vector<SpeedBumpSegmentBox> speed_bump_segment_boxes_;
+  BoxObjects<SpeedBumpInfo> speed_bump_segment_objects_;
   std::unique_ptr<SpeedBumpSegmentKDTree> speed_bump_segment_kdtree_;
 
   std::vector<ParkingSpacePolygonBox> parking_space_polygon_boxes_;
+  BoxObjects<ParkingSpaceInfo> parking_space_polygon_objects_;
   std::unique_ptr<ParkingSpacePolygonKDTree> parking_space_polygon_kdtree_;
 
   std::vector<PNCJunctionPolygonBox> pnc_junction_polygon_boxes_;
+  BoxObjects<PNCJunctionInfo> pnc_junction_polygon_objects_;
   std::unique_ptr<PNCJunctionPolygonKDTree> pnc_junction_polygon_kdtree_;
+
+  // identifies the loaded map in the query caches, 0 before loading
+  uint64_t map_generation_ = 0;
 };
 
 }  // namespace hdmap
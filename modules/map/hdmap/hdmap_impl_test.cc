@@ -14,6 +14,7 @@ limitations under the License.
 =========================================================================*/
 
 #include "gtest/gtest.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/file.h"
 #include "modules/map/hdmap/hdmap_impl.h"
 
@@ -156,6 +157,59 @@ TEST_F(HDMapImplTestSuite, GetLanes) {
   EXPECT_EQ("773_1_-2", ids[0]);
 }
 
+TEST_F(HDMapImplTestSuite, GetLanesFromQueryCache) {
+  const std::vector<std::pair<double, double>> offsets = {
+      {0.0, 0.0}, {0.3, -0.2}, {-0.45, 0.1}, {2.5, 3.0}, {0.3, -0.2}};
+  const std::vector<double> distances = {1e-6, 1.0, 5.0, 20.0};
+  for (const auto& offset : offsets) {
+    for (const double distance : distances) {
+      apollo::common::PointENU point;
+      point.set_x(586424.09 + offset.first);
+      point.set_y(4140727.02 + offset.second);
+      std::vector<LaneInfoConstPtr> expected_lanes;
+      FLAGS_use_hdmap_query_cache = false;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(point, distance, &expected_lanes));
+      std::vector<LaneInfoConstPtr> lanes;
+      FLAGS_use_hdmap_query_cache = true;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(point, distance, &lanes));
+      EXPECT_EQ(expected_lanes, lanes);
+    }
+  }
+  FLAGS_use_hdmap_query_cache = false;
+}
+
+TEST_F(HDMapImplTestSuite, ParallelLoading) {
+  FLAGS_use_parallel_map_loading = true;
+  HDMapImpl parallel_hdmap_impl;
+  EXPECT_EQ(0, parallel_hdmap_impl.LoadMapFromFile(kMapFilename));
+  FLAGS_use_parallel_map_loading = false;
+
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  LaneInfoConstPtr lane_ptr = parallel_hdmap_impl.GetLaneById(lane_id);
+  ASSERT_TRUE(nullptr != lane_ptr);
+  EXPECT_DOUBLE_EQ(hdmap_impl_.GetLaneById(lane_id)->total_length(),
+                   lane_ptr->total_length());
+  EXPECT_EQ(hdmap_impl_.GetLaneById(lane_id)->overlaps().size(),
+            lane_ptr->overlaps().size());
+
+  apollo::common::PointENU point;
+  point.set_x(586424.09);
+  point.set_y(4140727.02);
+  point.set_z(0.0);
+  std::vector<LaneInfoConstPtr> lanes;
+  EXPECT_EQ(0, parallel_hdmap_impl.GetLanes(point, 5, &lanes));
+  ASSERT_EQ(1, lanes.size());
+  EXPECT_EQ("773_1_-2", lanes[0]->id().id());
+
+  point.set_x(586441.61);
+  point.set_y(4140746.48);
+  std::vector<JunctionInfoConstPtr> junctions;
+  EXPECT_EQ(0, parallel_hdmap_impl.GetJunctions(point, 3, &junctions));
+  ASSERT_EQ(1, junctions.size());
+  EXPECT_EQ("1183", junctions[0]->id().id());
+}
+
 TEST_F(HDMapImplTestSuite, GetNearestLaneWithHeading) {
   apollo::common::PointENU point;
   point.set_x(586424.09);
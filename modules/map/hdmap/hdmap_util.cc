@@ -14,6 +14,8 @@ limitations under the License.
 =========================================================================*/
 #include "modules/map/hdmap/hdmap_util.h"
 
+#include <utility>
+
 #include "modules/map/relative_map/proto/navigation.pb.h"
 
 #include "modules/common/util/file.h"
@@ -92,6 +94,8 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
 uint64_t HDMapUtil::base_map_seq_ = 0;
 std::mutex HDMapUtil::base_map_mutex_;
+std::unique_ptr<HDMap> HDMapUtil::prebuilt_base_map_ = nullptr;
+uint64_t HDMapUtil::prebuilt_base_map_seq_ = 0;
 
 std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
 std::mutex HDMapUtil::sim_map_mutex_;
@@ -102,6 +106,10 @@ const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
       base_map_seq_ == map_msg.header().sequence_num()) {
     // avoid re-create map in the same cycle.
     return base_map_.get();
+  } else if (prebuilt_base_map_ != nullptr &&
+             prebuilt_base_map_seq_ == map_msg.header().sequence_num()) {
+    base_map_ = std::move(prebuilt_base_map_);
+    base_map_seq_ = prebuilt_base_map_seq_;
   } else {
     base_map_ = CreateMap(map_msg);
     base_map_seq_ = map_msg.header().sequence_num();
@@ -109,6 +117,13 @@ const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
   return base_map_.get();
 }
 
+void HDMapUtil::SetPrebuiltBaseMap(const uint64_t sequence_num,
+                                   std::unique_ptr<HDMap> map) {
+  std::lock_guard<std::mutex> lock(base_map_mutex_);
+  prebuilt_base_map_ = std::move(map);
+  prebuilt_base_map_seq_ = sequence_num;
+}
+
 const HDMap* HDMapUtil::BaseMapPtr() {
   // TODO(all) Those logics should be removed to planning
   /*if (FLAGS_use_navigation_mode) {
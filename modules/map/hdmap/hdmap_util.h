@@ -84,6 +84,11 @@ class HDMapUtil {
   // Return nullptr if failed to load.
   static const HDMap* BaseMapPtr();
   static const HDMap* BaseMapPtr(const relative_map::MapMsg& map_msg);
+  // Hand over the map of a relative map message built by the relative map
+  // in the same process, BaseMapPtr(map_msg) then takes it instead of
+  // building the same map again.
+  static void SetPrebuiltBaseMap(const uint64_t sequence_num,
+                                 std::unique_ptr<HDMap> map);
   // Guarantee to return a valid base_map, or else raise fatal error.
   static const HDMap& BaseMap();
 
@@ -104,6 +109,10 @@ class HDMapUtil {
   static uint64_t base_map_seq_;
   static std::mutex base_map_mutex_;
 
+  // guarded by base_map_mutex_
+  static std::unique_ptr<HDMap> prebuilt_base_map_;
+  static uint64_t prebuilt_base_map_seq_;
+
   static std::unique_ptr<HDMap> sim_map_;
   static std::mutex sim_map_mutex_;
 };
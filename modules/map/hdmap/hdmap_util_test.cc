@@ -21,6 +21,8 @@ limitations under the License.
 namespace apollo {
 namespace hdmap {
 
+using apollo::relative_map::MapMsg;
+
 class HDMapUtilTestSuite : public ::testing::Test {
  protected:
   HDMapUtilTestSuite() {}
@@ -80,5 +82,29 @@ void HDMapUtilTestSuite::InitMapProto(Map* map_proto) {
 //  EXPECT_NE(hdmap2, hdmap1);  // hdmap should be updated.
 //}
 
+TEST_F(HDMapUtilTestSuite, PrebuiltBaseMap) {
+  MapMsg map_msg;
+  InitMapProto(map_msg.mutable_hdmap());
+  map_msg.mutable_header()->set_sequence_num(1);
+
+  std::unique_ptr<HDMap> prebuilt_map(new HDMap());
+  ASSERT_EQ(0, prebuilt_map->LoadMapFromProto(map_msg.hdmap()));
+  const HDMap* prebuilt_map_ptr = prebuilt_map.get();
+  HDMapUtil::SetPrebuiltBaseMap(1, std::move(prebuilt_map));
+  const HDMap* hdmap = HDMapUtil::BaseMapPtr(map_msg);
+  EXPECT_EQ(prebuilt_map_ptr, hdmap);
+  EXPECT_NE(nullptr, hdmap->GetLaneById(MakeMapId("lane_1")));
+
+  // a map prebuilt for another message is not taken
+  prebuilt_map.reset(new HDMap());
+  prebuilt_map_ptr = prebuilt_map.get();
+  HDMapUtil::SetPrebuiltBaseMap(3, std::move(prebuilt_map));
+  map_msg.mutable_header()->set_sequence_num(2);
+  hdmap = HDMapUtil::BaseMapPtr(map_msg);
+  ASSERT_NE(nullptr, hdmap);
+  EXPECT_NE(prebuilt_map_ptr, hdmap);
+  EXPECT_NE(nullptr, hdmap->GetLaneById(MakeMapId("lane_1")));
+}
+
 }  // namespace hdmap
 }  // namespace apollo
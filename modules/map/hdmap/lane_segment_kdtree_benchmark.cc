@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file lane_segment_kdtree_benchmark.cc
+ * @brief Compares the AABoxKDTree2d and the FlatAABoxKDTree2d on the lane
+ *        segments of a map, with the parameters of HDMapImpl.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/flat_aaboxkdtree2d.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/proto/map.pb.h"
+
+DEFINE_string(lane_segment_kdtree_benchmark_map,
+              "modules/map/hdmap/test-data/base_map.bin",
+              "Map of which the lane segments are indexed");
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::FlatAABoxKDTree2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// queries around the lanes as done by the planning and prediction modules
+constexpr int kNumQueries = 4096;
+constexpr double kQueryNoise = 3.0;
+constexpr double kSearchRadius = 5.0;
+// points of a trajectory queried together
+constexpr int kBatchSize = 50;
+
+using FlatLaneSegmentKDTree = FlatAABoxKDTree2d<LaneSegmentBox>;
+
+// Holds the lanes the kd-trees keep pointers to.
+class LaneSegments {
+ public:
+  LaneSegments() {
+    CHECK(apollo::common::util::GetProtoFromFile(
+        FLAGS_lane_segment_kdtree_benchmark_map, &map_))
+        << "failed to load map " << FLAGS_lane_segment_kdtree_benchmark_map;
+    std::vector<Vec2d> lane_points;
+    for (const auto& lane : map_.lane()) {
+      lanes_.emplace_back(new LaneInfo(lane));
+      const LaneInfo* lane_info = lanes_.back().get();
+      for (size_t id = 0; id < lane_info->segments().size(); ++id) {
+        const auto& segment = lane_info->segments()[id];
+        boxes_.emplace_back(AABox2d(segment.start(), segment.end()),
+                            lane_info, &segment, id);
+      }
+      lane_points.insert(lane_points.end(), lane_info->points().begin(),
+                         lane_info->points().end());
+    }
+    CHECK(!lane_points.empty()) << "no lane in the map";
+
+    AABoxKDTreeParams params;
+    params.max_leaf_dimension = 5.0;  // meters.
+    params.max_leaf_size = 16;
+    node_kdtree_.reset(new LaneSegmentKDTree(boxes_, params));
+    flat_kdtree_.reset(new FlatLaneSegmentKDTree(boxes_, params));
+
+    // consecutive lane points, so that every batch follows a lane
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> start(0, lane_points.size() - 1);
+    std::uniform_real_distribution<double> noise(-kQueryNoise, kQueryNoise);
+    while (query_points_.size() < static_cast<size_t>(kNumQueries)) {
+      const size_t begin = start(generator);
+      for (size_t i = begin;
+           i < lane_points.size() && i < begin + kBatchSize; ++i) {
+        query_points_.emplace_back(lane_points[i].x() + noise(generator),
+                                   lane_points[i].y() + noise(generator));
+      }
+    }
+    query_points_.resize(kNumQueries);
+  }
+
+  const LaneSegmentKDTree& node_kdtree() const { return *node_kdtree_; }
+  const FlatLaneSegmentKDTree& flat_kdtree() const { return *flat_kdtree_; }
+  const std::vector<Vec2d>& query_points() const { return query_points_; }
+
+ private:
+  Map map_;
+  std::vector<std::unique_ptr<LaneInfo>> lanes_;
+  std::vector<LaneSegmentBox> boxes_;
+  std::unique_ptr<LaneSegmentKDTree> node_kdtree_;
+  std::unique_ptr<FlatLaneSegmentKDTree> flat_kdtree_;
+  std::vector<Vec2d> query_points_;
+};
+
+const LaneSegments& GetLaneSegments() {
+  static const LaneSegments lane_segments;
+  return lane_segments;
+}
+
+}  // namespace
+
+static void BM_NodeNearestObject(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  for (auto _ : state) {
+    for (const auto& point : lane_segments.query_points()) {
+      benchmark::DoNotOptimize(
+          lane_segments.node_kdtree().GetNearestObject(point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_NodeNearestObject);
+
+static void BM_FlatNearestObject(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  for (auto _ : state) {
+    for (const auto& point : lane_segments.query_points()) {
+      benchmark::DoNotOptimize(
+          lane_segments.flat_kdtree().GetNearestObject(point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_FlatNearestObject);
+
+static void BM_FlatNearestObjects(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  const auto& query_points = lane_segments.query_points();
+  for (auto _ : state) {
+    for (size_t i = 0; i < query_points.size(); i += kBatchSize) {
+      const std::vector<Vec2d> batch(
+          query_points.begin() + i,
+          query_points.begin() + std::min(i + kBatchSize, query_points.size()));
+      benchmark::DoNotOptimize(
+          lane_segments.flat_kdtree().GetNearestObjects(batch));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_FlatNearestObjects);
+
+static void BM_NodeObjects(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  for (auto _ : state) {
+    for (const auto& point : lane_segments.query_points()) {
+      benchmark::DoNotOptimize(
+          lane_segments.node_kdtree().GetObjects(point, kSearchRadius));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_NodeObjects);
+
+static void BM_FlatObjects(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  for (auto _ : state) {
+    for (const auto& point : lane_segments.query_points()) {
+      benchmark::DoNotOptimize(
+          lane_segments.flat_kdtree().GetObjects(point, kSearchRadius));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_FlatObjects);
+
+static void BM_FlatBatchObjects(benchmark::State& state) {  // NOLINT
+  const auto& lane_segments = GetLaneSegments();
+  const auto& query_points = lane_segments.query_points();
+  for (auto _ : state) {
+    for (size_t i = 0; i < query_points.size(); i += kBatchSize) {
+      const std::vector<Vec2d> batch(
+          query_points.begin() + i,
+          query_points.begin() + std::min(i + kBatchSize, query_points.size()));
+      benchmark::DoNotOptimize(
+          lane_segments.flat_kdtree().GetObjects(batch, kSearchRadius));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+BENCHMARK(BM_FlatBatchObjects);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,544 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_hdmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+using google::protobuf::RepeatedPtrField;
+using TileIndex = TiledHDMap::TileIndex;
+
+// the bounding box of the geometry of a map element
+class ElementBox {
+ public:
+  void Add(const PointENU& point) {
+    min_x_ = std::min(min_x_, point.x());
+    min_y_ = std::min(min_y_, point.y());
+    max_x_ = std::max(max_x_, point.x());
+    max_y_ = std::max(max_y_, point.y());
+  }
+
+  void Add(const Polygon& polygon) {
+    for (const auto& point : polygon.point()) {
+      Add(point);
+    }
+  }
+
+  void Add(const Curve& curve) {
+    for (const auto& segment : curve.segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        Add(point);
+      }
+    }
+  }
+
+  void Add(const RepeatedPtrField<Curve>& curves) {
+    for (const auto& curve : curves) {
+      Add(curve);
+    }
+  }
+
+  void Add(const ElementBox& box) {
+    min_x_ = std::min(min_x_, box.min_x_);
+    min_y_ = std::min(min_y_, box.min_y_);
+    max_x_ = std::max(max_x_, box.max_x_);
+    max_y_ = std::max(max_y_, box.max_y_);
+  }
+
+  bool empty() const { return min_x_ > max_x_; }
+
+  // the tiles overlapping the box
+  std::vector<TileIndex> Tiles(const double tile_size) const {
+    std::vector<TileIndex> tile_indices;
+    if (empty()) {
+      return tile_indices;
+    }
+    const int min_ix = static_cast<int>(std::floor(min_x_ / tile_size));
+    const int max_ix = static_cast<int>(std::floor(max_x_ / tile_size));
+    const int min_iy = static_cast<int>(std::floor(min_y_ / tile_size));
+    const int max_iy = static_cast<int>(std::floor(max_y_ / tile_size));
+    for (int ix = min_ix; ix <= max_ix; ++ix) {
+      for (int iy = min_iy; iy <= max_iy; ++iy) {
+        tile_indices.emplace_back(ix, iy);
+      }
+    }
+    return tile_indices;
+  }
+
+ private:
+  double min_x_ = std::numeric_limits<double>::max();
+  double min_y_ = std::numeric_limits<double>::max();
+  double max_x_ = std::numeric_limits<double>::lowest();
+  double max_y_ = std::numeric_limits<double>::lowest();
+};
+
+class TileSplitter {
+ public:
+  TileSplitter(const Map& map_proto, const double tile_size)
+      : map_proto_(map_proto), tile_size_(tile_size) {}
+
+  // adds an element to every tile its box overlaps
+  template <class Element>
+  void AddElement(const Element& element, const ElementBox& box,
+                  Element* (Map::*add_element)()) {
+    auto& element_tiles = element_tiles_[element.id().id()];
+    for (const auto& tile_index : box.Tiles(tile_size_)) {
+      *(Tile(tile_index)->*add_element)() = element;
+      element_tiles.push_back(tile_index);
+    }
+  }
+
+  // adds an overlap to every tile of its objects
+  void AddOverlap(const Overlap& overlap) {
+    std::set<TileIndex> overlap_tiles;
+    for (const auto& object : overlap.object()) {
+      const auto iter = element_tiles_.find(object.id().id());
+      if (iter != element_tiles_.end()) {
+        overlap_tiles.insert(iter->second.begin(), iter->second.end());
+      }
+    }
+    for (const auto& tile_index : overlap_tiles) {
+      *Tile(tile_index)->add_overlap() = overlap;
+    }
+  }
+
+  const std::map<TileIndex, Map>& tiles() const { return tiles_; }
+
+ private:
+  Map* Tile(const TileIndex& tile_index) {
+    auto iter = tiles_.find(tile_index);
+    if (iter == tiles_.end()) {
+      iter = tiles_.emplace(tile_index, Map()).first;
+      *iter->second.mutable_header() = map_proto_.header();
+    }
+    return &iter->second;
+  }
+
+ private:
+  const Map& map_proto_;
+  const double tile_size_;
+  std::map<TileIndex, Map> tiles_;
+  std::unordered_map<std::string, std::vector<TileIndex>> element_tiles_;
+};
+
+// keeps the first element of every id
+template <class Element>
+void MergeElements(const std::vector<std::shared_ptr<const Map>>& tiles,
+                   const RepeatedPtrField<Element>& (Map::*elements)() const,
+                   RepeatedPtrField<Element>* merged_elements,
+                   std::unordered_set<std::string>* merged_ids) {
+  std::unordered_set<std::string> ids;
+  for (const auto& tile : tiles) {
+    for (const auto& element : ((*tile).*elements)()) {
+      if (ids.insert(element.id().id()).second) {
+        *merged_elements->Add() = element;
+      }
+    }
+  }
+  merged_ids->insert(ids.begin(), ids.end());
+}
+
+template <class Element>
+void RemoveMissingOverlaps(const std::unordered_set<std::string>& overlap_ids,
+                           RepeatedPtrField<Element>* elements) {
+  for (auto& element : *elements) {
+    auto* element_overlap_ids = element.mutable_overlap_id();
+    element_overlap_ids->erase(
+        std::remove_if(element_overlap_ids->begin(),
+                       element_overlap_ids->end(),
+                       [&overlap_ids](const Id& id) {
+                         return overlap_ids.count(id.id()) == 0;
+                       }),
+        element_overlap_ids->end());
+  }
+}
+
+std::string TileFileName(const std::string& tile_dir,
+                         const TileIndex& tile_index) {
+  return apollo::common::util::StrCat(tile_dir, "/", tile_index.first, "_",
+                                      tile_index.second, ".bin");
+}
+
+}  // namespace
+
+int TiledHDMap::BuildTiles(const Map& map_proto, const double tile_size,
+                           const std::string& tile_dir) {
+  CHECK_GT(tile_size, 0.0);
+  TileSplitter splitter(map_proto, tile_size);
+
+  // the roads follow the boxes of their lanes
+  std::unordered_map<std::string, ElementBox> lane_boxes;
+  for (const auto& lane : map_proto.lane()) {
+    ElementBox box;
+    box.Add(lane.central_curve());
+    box.Add(lane.left_boundary().curve());
+    box.Add(lane.right_boundary().curve());
+    lane_boxes[lane.id().id()] = box;
+    splitter.AddElement(lane, box, &Map::add_lane);
+  }
+  for (const auto& road : map_proto.road()) {
+    ElementBox box;
+    for (const auto& section : road.section()) {
+      for (const auto& edge : section.boundary().outer_polygon().edge()) {
+        box.Add(edge.curve());
+      }
+      for (const auto& lane_id : section.lane_id()) {
+        const auto iter = lane_boxes.find(lane_id.id());
+        if (iter != lane_boxes.end()) {
+          box.Add(iter->second);
+        }
+      }
+    }
+    splitter.AddElement(road, box, &Map::add_road);
+  }
+  for (const auto& junction : map_proto.junction()) {
+    ElementBox box;
+    box.Add(junction.polygon());
+    splitter.AddElement(junction, box, &Map::add_junction);
+  }
+  for (const auto& signal : map_proto.signal()) {
+    ElementBox box;
+    box.Add(signal.boundary());
+    box.Add(signal.stop_line());
+    splitter.AddElement(signal, box, &Map::add_signal);
+  }
+  for (const auto& crosswalk : map_proto.crosswalk()) {
+    ElementBox box;
+    box.Add(crosswalk.polygon());
+    splitter.AddElement(crosswalk, box, &Map::add_crosswalk);
+  }
+  for (const auto& stop_sign : map_proto.stop_sign()) {
+    ElementBox box;
+    box.Add(stop_sign.stop_line());
+    splitter.AddElement(stop_sign, box, &Map::add_stop_sign);
+  }
+  for (const auto& yield_sign : map_proto.yield()) {
+    ElementBox box;
+    box.Add(yield_sign.stop_line());
+    splitter.AddElement(yield_sign, box, &Map::add_yield);
+  }
+  for (const auto& clear_area : map_proto.clear_area()) {
+    ElementBox box;
+    box.Add(clear_area.polygon());
+    splitter.AddElement(clear_area, box, &Map::add_clear_area);
+  }
+  for (const auto& speed_bump : map_proto.speed_bump()) {
+    ElementBox box;
+    box.Add(speed_bump.position());
+    splitter.AddElement(speed_bump, box, &Map::add_speed_bump);
+  }
+  for (const auto& parking_space : map_proto.parking_space()) {
+    ElementBox box;
+    box.Add(parking_space.polygon());
+    splitter.AddElement(parking_space, box, &Map::add_parking_space);
+  }
+  for (const auto& pnc_junction : map_proto.pnc_junction()) {
+    ElementBox box;
+    box.Add(pnc_junction.polygon());
+    splitter.AddElement(pnc_junction, box, &Map::add_pnc_junction);
+  }
+  for (const auto& overlap : map_proto.overlap()) {
+    splitter.AddOverlap(overlap);
+  }
+
+  if (!apollo::common::util::EnsureDirectory(tile_dir)) {
+    AERROR << "Failed to create tile directory " << tile_dir;
+    return -1;
+  }
+  for (const auto& tile : splitter.tiles()) {
+    const std::string tile_file = TileFileName(tile_dir, tile.first);
+    if (!apollo::common::util::SetProtoToBinaryFile(tile.second, tile_file)) {
+      AERROR << "Failed to write map tile " << tile_file;
+      return -1;
+    }
+  }
+  AINFO << "Split the map into " << splitter.tiles().size() << " tiles.";
+  return 0;
+}
+
+void TiledHDMap::MergeTiles(
+    const std::vector<std::shared_ptr<const Map>>& tiles, Map* merged_map) {
+  CHECK_NOTNULL(merged_map);
+  merged_map->Clear();
+  if (tiles.empty()) {
+    return;
+  }
+  *merged_map->mutable_header() = tiles.front()->header();
+
+  std::unordered_set<std::string> element_ids;
+  MergeElements(tiles, &Map::lane, merged_map->mutable_lane(), &element_ids);
+  MergeElements(tiles, &Map::road, merged_map->mutable_road(), &element_ids);
+  MergeElements(tiles, &Map::junction, merged_map->mutable_junction(),
+                &element_ids);
+  MergeElements(tiles, &Map::signal, merged_map->mutable_signal(),
+                &element_ids);
+  MergeElements(tiles, &Map::crosswalk, merged_map->mutable_crosswalk(),
+                &element_ids);
+  MergeElements(tiles, &Map::stop_sign, merged_map->mutable_stop_sign(),
+                &element_ids);
+  MergeElements(tiles, &Map::yield, merged_map->mutable_yield(),
+                &element_ids);
+  MergeElements(tiles, &Map::clear_area, merged_map->mutable_clear_area(),
+                &element_ids);
+  MergeElements(tiles, &Map::speed_bump, merged_map->mutable_speed_bump(),
+                &element_ids);
+  MergeElements(tiles, &Map::parking_space,
+                merged_map->mutable_parking_space(), &element_ids);
+  MergeElements(tiles, &Map::pnc_junction, merged_map->mutable_pnc_junction(),
+                &element_ids);
+
+  // an overlap is kept only if all of its objects are loaded
+  std::unordered_set<std::string> overlap_ids;
+  for (const auto& tile : tiles) {
+    for (const auto& overlap : tile->overlap()) {
+      if (overlap_ids.count(overlap.id().id()) > 0) {
+        continue;
+      }
+      const bool is_complete =
+          std::all_of(overlap.object().begin(), overlap.object().end(),
+                      [&element_ids](const ObjectOverlapInfo& object) {
+                        return element_ids.count(object.id().id()) > 0;
+                      });
+      if (is_complete) {
+        overlap_ids.insert(overlap.id().id());
+        *merged_map->add_overlap() = overlap;
+      }
+    }
+  }
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_lane());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_junction());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_signal());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_crosswalk());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_stop_sign());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_yield());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_clear_area());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_speed_bump());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_parking_space());
+  RemoveMissingOverlaps(overlap_ids, merged_map->mutable_pnc_junction());
+
+  // a road may span more tiles than some of its lanes
+  std::unordered_set<std::string> lane_ids;
+  for (const auto& lane : merged_map->lane()) {
+    lane_ids.insert(lane.id().id());
+  }
+  for (auto& road : *merged_map->mutable_road()) {
+    for (auto& section : *road.mutable_section()) {
+      auto* section_lane_ids = section.mutable_lane_id();
+      section_lane_ids->erase(
+          std::remove_if(section_lane_ids->begin(), section_lane_ids->end(),
+                         [&lane_ids](const Id& id) {
+                           return lane_ids.count(id.id()) == 0;
+                         }),
+          section_lane_ids->end());
+    }
+  }
+}
+
+TiledHDMap::TiledHDMap(const std::string& tile_dir, const double tile_size)
+    : tile_dir_(tile_dir), tile_size_(tile_size) {
+  CHECK_GT(tile_size_, 0.0);
+}
+
+TiledHDMap::~TiledHDMap() { Stop(); }
+
+void TiledHDMap::Start() {
+  std::lock_guard<std::mutex> lock(request_mutex_);
+  if (!stopped_) {
+    return;
+  }
+  stopped_ = false;
+  loader_thread_ = std::thread(&TiledHDMap::LoaderLoop, this);
+}
+
+void TiledHDMap::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  request_cv_.notify_all();
+  loader_thread_.join();
+}
+
+void TiledHDMap::UpdateVehiclePosition(const PointENU& point) {
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    position_ = point;
+    has_position_ = true;
+    has_request_ = true;
+  }
+  request_cv_.notify_one();
+}
+
+void TiledHDMap::UpdateRoutingCorridor(const std::vector<PointENU>& corridor) {
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    corridor_ = corridor;
+    has_request_ = true;
+  }
+  request_cv_.notify_one();
+}
+
+int TiledHDMap::LoadTiles() {
+  PointENU position;
+  std::vector<PointENU> corridor;
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    has_request_ = false;
+    if (!has_position_) {
+      return 0;
+    }
+    position = position_;
+    corridor = corridor_;
+  }
+
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  std::set<TileIndex> wanted_tiles;
+  AddTilesInRadius(position, FLAGS_map_tile_load_radius, &wanted_tiles);
+  for (const auto& point : corridor) {
+    AddTilesInRadius(point, FLAGS_map_tile_corridor_radius, &wanted_tiles);
+  }
+  // the loaded tiles stay until they are beyond the evict radius
+  std::set<TileIndex> kept_tiles;
+  AddTilesInRadius(position, FLAGS_map_tile_evict_radius, &kept_tiles);
+
+  bool is_changed = false;
+  std::map<TileIndex, std::shared_ptr<const Map>> tiles;
+  for (const auto& tile : tiles_) {
+    if (wanted_tiles.count(tile.first) > 0 ||
+        kept_tiles.count(tile.first) > 0) {
+      tiles.insert(tile);
+    } else {
+      is_changed = true;
+    }
+  }
+  for (const auto& tile_index : wanted_tiles) {
+    if (tiles.count(tile_index) > 0) {
+      continue;
+    }
+    is_changed = true;
+    auto tile = std::make_shared<Map>();
+    // tiles without any map element are not written
+    const std::string tile_file = TileFile(tile_index);
+    if (apollo::common::util::PathExists(tile_file) &&
+        !apollo::common::util::GetProtoFromFile(tile_file, tile.get())) {
+      AERROR << "Failed to load map tile " << tile_file;
+      return -1;
+    }
+    tiles.emplace(tile_index, tile);
+  }
+  if (!is_changed) {
+    return 0;
+  }
+
+  std::vector<std::shared_ptr<const Map>> tile_maps;
+  std::set<TileIndex> loaded_tiles;
+  for (const auto& tile : tiles) {
+    tile_maps.push_back(tile.second);
+    loaded_tiles.insert(tile.first);
+  }
+  Map merged_map;
+  MergeTiles(tile_maps, &merged_map);
+  auto map = std::make_shared<HDMap>();
+  if (map->LoadMapFromProto(merged_map) != 0) {
+    AERROR << "Failed to build the map of " << tiles.size() << " tiles.";
+    return -1;
+  }
+  tiles_.swap(tiles);
+  {
+    std::lock_guard<std::mutex> lock(map_mutex_);
+    map_ = map;
+    loaded_tiles_.swap(loaded_tiles);
+  }
+  ADEBUG << "Loaded " << tiles_.size() << " map tiles with "
+         << merged_map.lane_size() << " lanes.";
+  return 0;
+}
+
+std::shared_ptr<const HDMap> TiledHDMap::GetMap() const {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  return map_;
+}
+
+std::set<TiledHDMap::TileIndex> TiledHDMap::GetLoadedTiles() const {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  return loaded_tiles_;
+}
+
+TiledHDMap::TileIndex TiledHDMap::GetTileIndex(const double x,
+                                               const double y) const {
+  return {static_cast<int>(std::floor(x / tile_size_)),
+          static_cast<int>(std::floor(y / tile_size_))};
+}
+
+void TiledHDMap::AddTilesInRadius(const PointENU& point, const double radius,
+                                  std::set<TileIndex>* tile_indices) const {
+  const TileIndex min_index =
+      GetTileIndex(point.x() - radius, point.y() - radius);
+  const TileIndex max_index =
+      GetTileIndex(point.x() + radius, point.y() + radius);
+  for (int ix = min_index.first; ix <= max_index.first; ++ix) {
+    for (int iy = min_index.second; iy <= max_index.second; ++iy) {
+      // distance from the point to the nearest point of the tile
+      const double dx = std::max(
+          {ix * tile_size_ - point.x(), point.x() - (ix + 1) * tile_size_,
+           0.0});
+      const double dy = std::max(
+          {iy * tile_size_ - point.y(), point.y() - (iy + 1) * tile_size_,
+           0.0});
+      if (std::hypot(dx, dy) <= radius) {
+        tile_indices->emplace(ix, iy);
+      }
+    }
+  }
+}
+
+std::string TiledHDMap::TileFile(const TileIndex& tile_index) const {
+  return TileFileName(tile_dir_, tile_index);
+}
+
+void TiledHDMap::LoaderLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(request_mutex_);
+      request_cv_.wait(lock, [this] { return stopped_ || has_request_; });
+      if (stopped_) {
+        return;
+      }
+    }
+    if (LoadTiles() != 0) {
+      AERROR << "Failed to load the map tiles around the vehicle.";
+    }
+  }
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/map/proto/map.pb.h"
+
+#include "modules/map/hdmap/hdmap.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class TiledHDMap
+ *
+ * @brief HDMap backend for maps too large to be kept in memory. The map is
+ * split offline into square tiles, each tile holding every element which
+ * touches it, and only the tiles around the vehicle and along the routing
+ * corridor are loaded. The loaded tiles are merged into an HDMap which is
+ * queried with the usual HDMap API.
+ */
+class TiledHDMap {
+ public:
+  using TileIndex = std::pair<int, int>;
+
+  /**
+   * @brief split a map into tiles
+   * @param map_proto the whole map
+   * @param tile_size side length of the tiles in meters
+   * @param tile_dir directory where the tiles are written
+   * @return 0:success, otherwise failed
+   */
+  static int BuildTiles(const Map& map_proto, const double tile_size,
+                        const std::string& tile_dir);
+
+  /**
+   * @brief merge tiles into one map, objects spanning several tiles are
+   *        kept once and the references to objects out of the tiles are
+   *        dropped
+   * @param tiles the tiles to merge
+   * @param merged_map the merged map
+   */
+  static void MergeTiles(const std::vector<std::shared_ptr<const Map>>& tiles,
+                         Map* merged_map);
+
+  TiledHDMap(const std::string& tile_dir, const double tile_size);
+
+  ~TiledHDMap();
+
+  /**
+   * @brief start loading the tiles on a background thread
+   */
+  void Start();
+
+  /**
+   * @brief stop the background thread
+   */
+  void Stop();
+
+  void UpdateVehiclePosition(const apollo::common::PointENU& point);
+
+  void UpdateRoutingCorridor(
+      const std::vector<apollo::common::PointENU>& corridor);
+
+  /**
+   * @brief load and evict tiles for the latest vehicle position and routing
+   *        corridor, and publish the map of the loaded tiles if they changed
+   * @return 0:success, otherwise failed
+   */
+  int LoadTiles();
+
+  /**
+   * @brief get the map of the loaded tiles, which stays valid while held
+   * @return the map, nullptr before the first tiles are loaded
+   */
+  std::shared_ptr<const HDMap> GetMap() const;
+
+  /**
+   * @brief get the indices of the loaded tiles
+   */
+  std::set<TileIndex> GetLoadedTiles() const;
+
+ private:
+  TileIndex GetTileIndex(const double x, const double y) const;
+
+  void AddTilesInRadius(const apollo::common::PointENU& point,
+                        const double radius,
+                        std::set<TileIndex>* tile_indices) const;
+
+  std::string TileFile(const TileIndex& tile_index) const;
+
+  void LoaderLoop();
+
+ private:
+  const std::string tile_dir_;
+  const double tile_size_;
+
+  // the latest position and corridor, guarded by request_mutex_
+  mutable std::mutex request_mutex_;
+  std::condition_variable request_cv_;
+  bool has_position_ = false;
+  apollo::common::PointENU position_;
+  std::vector<apollo::common::PointENU> corridor_;
+  bool has_request_ = false;
+  bool stopped_ = true;
+
+  // the loaded tiles, only accessed by LoadTiles()
+  std::mutex tiles_mutex_;
+  std::map<TileIndex, std::shared_ptr<const Map>> tiles_;
+
+  mutable std::mutex map_mutex_;
+  std::shared_ptr<const HDMap> map_;
+  std::set<TileIndex> loaded_tiles_;
+
+  std::thread loader_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(TiledHDMap);
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_hdmap.h"
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_util.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+constexpr char kTileDir[] = "/tmp/tiled_hdmap_test";
+constexpr double kTileSize = 50.0;
+
+apollo::common::PointENU MakePoint(const double x, const double y) {
+  apollo::common::PointENU point;
+  point.set_x(x);
+  point.set_y(y);
+  return point;
+}
+
+std::set<std::string> GetLaneIds(const HDMap& map,
+                                 const apollo::common::PointENU& point,
+                                 const double distance) {
+  std::vector<LaneInfoConstPtr> lanes;
+  map.GetLanes(point, distance, &lanes);
+  std::set<std::string> lane_ids;
+  for (const auto& lane : lanes) {
+    lane_ids.insert(lane->id().id());
+  }
+  return lane_ids;
+}
+
+}  // namespace
+
+class TiledHDMapTestSuite : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_map_tile_load_radius = 30.0;
+    FLAGS_map_tile_evict_radius = 60.0;
+    FLAGS_map_tile_corridor_radius = 10.0;
+    Map map_proto;
+    ASSERT_TRUE(apollo::common::util::GetProtoFromFile(kMapFilename,
+                                                       &map_proto));
+    ASSERT_EQ(0, TiledHDMap::BuildTiles(map_proto, kTileSize, kTileDir));
+    ASSERT_EQ(0, hdmap_.LoadMapFromProto(map_proto));
+  }
+
+ public:
+  HDMap hdmap_;
+};
+
+TEST_F(TiledHDMapTestSuite, LoadTiles) {
+  TiledHDMap tiled_hdmap(kTileDir, kTileSize);
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  EXPECT_EQ(nullptr, tiled_hdmap.GetMap());
+
+  const auto point = MakePoint(586424.09, 4140727.02);
+  tiled_hdmap.UpdateVehiclePosition(point);
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  auto map = tiled_hdmap.GetMap();
+  ASSERT_NE(nullptr, map);
+  EXPECT_EQ(GetLaneIds(hdmap_, point, 5.0), GetLaneIds(*map, point, 5.0));
+  EXPECT_EQ(1, GetLaneIds(*map, point, 5.0).count("773_1_-2"));
+
+  // the lanes spanning several tiles are loaded once and whole
+  const auto lane = map->GetLaneById(MakeMapId("773_1_-2"));
+  ASSERT_NE(nullptr, lane);
+  EXPECT_DOUBLE_EQ(hdmap_.GetLaneById(MakeMapId("773_1_-2"))->total_length(),
+                   lane->total_length());
+
+  // the same position does not rebuild the map
+  tiled_hdmap.UpdateVehiclePosition(point);
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  EXPECT_EQ(map, tiled_hdmap.GetMap());
+}
+
+TEST_F(TiledHDMapTestSuite, EvictTiles) {
+  TiledHDMap tiled_hdmap(kTileDir, kTileSize);
+  const auto point = MakePoint(586424.09, 4140727.02);
+  tiled_hdmap.UpdateVehiclePosition(point);
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  auto map = tiled_hdmap.GetMap();
+  ASSERT_NE(nullptr, map);
+
+  // tiles within the evict radius are kept
+  tiled_hdmap.UpdateVehiclePosition(MakePoint(point.x() + 40.0, point.y()));
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  EXPECT_NE(nullptr,
+            tiled_hdmap.GetMap()->GetLaneById(MakeMapId("773_1_-2")));
+
+  const auto far_point = MakePoint(point.x() + 1000.0, point.y());
+  tiled_hdmap.UpdateVehiclePosition(far_point);
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  EXPECT_EQ(nullptr, tiled_hdmap.GetMap()->GetLaneById(MakeMapId("773_1_-2")));
+  for (const auto& tile_index : tiled_hdmap.GetLoadedTiles()) {
+    EXPECT_GT(tile_index.first * kTileSize, point.x());
+  }
+  // a map still held keeps its lanes
+  EXPECT_NE(nullptr, map->GetLaneById(MakeMapId("773_1_-2")));
+
+  // the tiles along the routing corridor are loaded
+  tiled_hdmap.UpdateRoutingCorridor({point});
+  EXPECT_EQ(0, tiled_hdmap.LoadTiles());
+  EXPECT_NE(nullptr,
+            tiled_hdmap.GetMap()->GetLaneById(MakeMapId("773_1_-2")));
+}
+
+TEST_F(TiledHDMapTestSuite, LoadTilesInBackground) {
+  TiledHDMap tiled_hdmap(kTileDir, kTileSize);
+  tiled_hdmap.Start();
+  tiled_hdmap.UpdateVehiclePosition(MakePoint(586424.09, 4140727.02));
+  for (int i = 0; i < 100 && tiled_hdmap.GetMap() == nullptr; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  tiled_hdmap.Stop();
+  ASSERT_NE(nullptr, tiled_hdmap.GetMap());
+  EXPECT_NE(nullptr,
+            tiled_hdmap.GetMap()->GetLaneById(MakeMapId("773_1_-2")));
+}
+
+TEST(TiledHDMapTest, MergeTiles) {
+  auto tile = std::make_shared<Map>();
+  auto* lane = tile->add_lane();
+  lane->mutable_id()->set_id("lane_1");
+  lane->add_overlap_id()->set_id("overlap_1");
+  lane->add_overlap_id()->set_id("overlap_2");
+  auto* overlap = tile->add_overlap();
+  overlap->mutable_id()->set_id("overlap_1");
+  overlap->add_object()->mutable_id()->set_id("lane_1");
+  overlap = tile->add_overlap();
+  overlap->mutable_id()->set_id("overlap_2");
+  overlap->add_object()->mutable_id()->set_id("lane_1");
+  overlap->add_object()->mutable_id()->set_id("lane_2");
+  auto* section = tile->add_road()->add_section();
+  section->add_lane_id()->set_id("lane_1");
+  section->add_lane_id()->set_id("lane_2");
+
+  Map merged_map;
+  TiledHDMap::MergeTiles({tile, tile}, &merged_map);
+  ASSERT_EQ(1, merged_map.lane_size());
+  ASSERT_EQ(1, merged_map.overlap_size());
+  EXPECT_EQ("overlap_1", merged_map.overlap(0).id().id());
+  ASSERT_EQ(1, merged_map.lane(0).overlap_id_size());
+  EXPECT_EQ("overlap_1", merged_map.lane(0).overlap_id(0).id());
+  ASSERT_EQ(1, merged_map.road_size());
+  ASSERT_EQ(1, merged_map.road(0).section(0).lane_id_size());
+  EXPECT_EQ("lane_1", merged_map.road(0).section(0).lane_id(0).id());
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -16,6 +16,9 @@
 
 #include "modules/map/pnc_map/cuda_util.h"
 
+#include <cfloat>
+#include <cmath>
+
 #include "cyber/common/log.h"
 
 #include <cuda_runtime_api.h>
@@ -118,5 +121,199 @@ int CudaNearestSegment::FindNearestSegment(double x, double y) {
   }
   return min_index - 1;
 }
+
+namespace {
+
+constexpr int kBatchBlockSize = 256;
+
+__host__ __device__ void ProjectToSegmentGroup(
+    const CudaPoint2d point, const CudaLineSegment2d* segs, const int begin,
+    const int end, CudaSegmentProjection* projection) {
+  projection->segment_index = -1;
+  projection->distance_square = DBL_MAX;
+  projection->longitudinal = 0.0;
+  projection->lateral = 0.0;
+  for (int i = begin; i < end; ++i) {
+    const CudaLineSegment2d& seg = segs[i];
+    const double x1x = point.x - seg.x1;
+    const double y1y = point.y - seg.y1;
+    const double x1x2 = seg.x2 - seg.x1;
+    const double y1y2 = seg.y2 - seg.y1;
+    const double length_square = x1x2 * x1x2 + y1y2 * y1y2;
+    const double dot = x1x * x1x2 + y1y * y1y2;
+    double distance_square = 0.0;
+    if (dot <= 0.0 || length_square <= 0.0) {
+      distance_square = x1x * x1x + y1y * y1y;
+    } else if (dot >= length_square) {
+      const double x2x = point.x - seg.x2;
+      const double y2y = point.y - seg.y2;
+      distance_square = x2x * x2x + y2y * y2y;
+    } else {
+      const double prod = x1x2 * y1y - y1y2 * x1x;
+      distance_square = prod * prod / length_square;
+    }
+    if (distance_square >= projection->distance_square) {
+      continue;
+    }
+    projection->segment_index = i - begin;
+    projection->distance_square = distance_square;
+    if (length_square <= 0.0) {
+      projection->longitudinal = 0.0;
+      projection->lateral = sqrt(distance_square);
+    } else {
+      const double length = sqrt(length_square);
+      projection->longitudinal = fmin(fmax(dot / length, 0.0), length);
+      projection->lateral = (x1x2 * y1y - y1y2 * x1x) / length;
+    }
+  }
+}
+
+__global__ void NearestSegments(const CudaPoint2d* points,
+                                const int num_points,
+                                const CudaLineSegment2d* segs,
+                                const int* group_offsets, const int num_groups,
+                                CudaSegmentProjection* projections) {
+  const int index = blockDim.x * blockIdx.x + threadIdx.x;
+  if (index >= num_points * num_groups) {
+    return;
+  }
+  const int group = index % num_groups;
+  ProjectToSegmentGroup(points[index / num_groups], segs,
+                        group_offsets[group], group_offsets[group + 1],
+                        &projections[index]);
+}
+
+}  // namespace
+
+CudaBatchNearestSegment::CudaBatchNearestSegment(
+    const std::size_t min_gpu_work)
+    : min_gpu_work_(min_gpu_work) {
+  int device_count = 0;
+  gpu_available_ =
+      cudaGetDeviceCount(&device_count) == cudaSuccess && device_count > 0;
+  if (!gpu_available_) {
+    AWARN << "No cuda device, segments are projected on the host";
+  }
+  host_group_offsets_.push_back(0);
+}
+
+CudaBatchNearestSegment::~CudaBatchNearestSegment() {
+  cudaFree(dev_segs_);
+  cudaFree(dev_group_offsets_);
+  cudaFree(dev_points_);
+  cudaFree(dev_projections_);
+}
+
+template <class T>
+bool CudaBatchNearestSegment::ReserveDeviceArray(const std::size_t size,
+                                                 T** array,
+                                                 std::size_t* capacity) {
+  if (size <= *capacity) {
+    return true;
+  }
+  cudaFree(*array);
+  *array = nullptr;
+  *capacity = 0;
+  if (cudaMalloc(reinterpret_cast<void**>(array), sizeof(T) * size) !=
+      cudaSuccess) {
+    return false;
+  }
+  *capacity = size;
+  return true;
+}
+
+bool CudaBatchNearestSegment::UpdateLineSegments(
+    const std::vector<std::vector<apollo::common::math::LineSegment2d>>&
+        segment_groups) {
+  host_segs_.clear();
+  host_group_offsets_.assign(1, 0);
+  for (const auto& segments : segment_groups) {
+    for (const auto& segment : segments) {
+      CudaLineSegment2d seg;
+      seg.x1 = segment.start().x();
+      seg.y1 = segment.start().y();
+      seg.x2 = segment.end().x();
+      seg.y2 = segment.end().y();
+      host_segs_.push_back(seg);
+    }
+    host_group_offsets_.push_back(static_cast<int>(host_segs_.size()));
+  }
+  if (!gpu_available_ || host_segs_.empty()) {
+    return true;
+  }
+  if (!ReserveDeviceArray(host_segs_.size(), &dev_segs_,
+                          &dev_segs_capacity_) ||
+      !ReserveDeviceArray(host_group_offsets_.size(), &dev_group_offsets_,
+                          &dev_group_offsets_capacity_)) {
+    AERROR << "Failed to allocate the segments on the cuda device";
+    return false;
+  }
+  if (cudaMemcpy(dev_segs_, host_segs_.data(),
+                 host_segs_.size() * sizeof(CudaLineSegment2d),
+                 cudaMemcpyHostToDevice) != cudaSuccess ||
+      cudaMemcpy(dev_group_offsets_, host_group_offsets_.data(),
+                 host_group_offsets_.size() * sizeof(int),
+                 cudaMemcpyHostToDevice) != cudaSuccess) {
+    AERROR << "Failed to copy the segments to the cuda device";
+    return false;
+  }
+  return true;
+}
+
+bool CudaBatchNearestSegment::FindNearestSegments(
+    const std::vector<apollo::common::math::Vec2d>& points,
+    std::vector<CudaSegmentProjection>* projections) {
+  CHECK_NOTNULL(projections);
+  const int num_groups = static_cast<int>(host_group_offsets_.size()) - 1;
+  const std::size_t num_projections = points.size() * num_groups;
+  projections->resize(num_projections);
+  if (num_projections == 0) {
+    return true;
+  }
+  host_points_.resize(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    host_points_[i].x = points[i].x();
+    host_points_[i].y = points[i].y();
+  }
+
+  if (!gpu_available_ || host_segs_.empty() ||
+      points.size() * host_segs_.size() < min_gpu_work_) {
+    for (std::size_t i = 0; i < num_projections; ++i) {
+      const int group = static_cast<int>(i % num_groups);
+      ProjectToSegmentGroup(host_points_[i / num_groups], host_segs_.data(),
+                            host_group_offsets_[group],
+                            host_group_offsets_[group + 1],
+                            &(*projections)[i]);
+    }
+    return true;
+  }
+
+  if (!ReserveDeviceArray(points.size(), &dev_points_,
+                          &dev_points_capacity_) ||
+      !ReserveDeviceArray(num_projections, &dev_projections_,
+                          &dev_projections_capacity_)) {
+    AERROR << "Failed to allocate the points on the cuda device";
+    return false;
+  }
+  if (cudaMemcpy(dev_points_, host_points_.data(),
+                 points.size() * sizeof(CudaPoint2d),
+                 cudaMemcpyHostToDevice) != cudaSuccess) {
+    AERROR << "Failed to copy the points to the cuda device";
+    return false;
+  }
+  const int num_blocks = static_cast<int>(
+      (num_projections + kBatchBlockSize - 1) / kBatchBlockSize);
+  NearestSegments<<<num_blocks, kBatchBlockSize>>>(
+      dev_points_, static_cast<int>(points.size()), dev_segs_,
+      dev_group_offsets_, num_groups, dev_projections_);
+  if (cudaMemcpy(projections->data(), dev_projections_,
+                 num_projections * sizeof(CudaSegmentProjection),
+                 cudaMemcpyDeviceToHost) != cudaSuccess) {
+    AERROR << "Failed to copy the projections from the cuda device";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace pnc_map
 }  // namespace apollo
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include <cublas_v2.h>
+#include <cstddef>
 #include <vector>
 
 #include "modules/common/math/line_segment2d.h"
@@ -49,5 +50,78 @@ class CudaNearestSegment {
   cublasHandle_t handle_;
 };
 
+struct CudaPoint2d {
+  double x;
+  double y;
+};
+
+struct CudaSegmentProjection {
+  // index of the nearest segment in its group, -1 for an empty group
+  int segment_index;
+  double distance_square;
+  // distance from the start of the segment to the projection of the point,
+  // clamped to the segment
+  double longitudinal;
+  // signed distance to the line of the segment, positive on the left
+  double lateral;
+};
+
+/**
+ * @class CudaBatchNearestSegment
+ *
+ * @brief Finds the nearest segment of every group of segments, e.g. the
+ * segments of a reference line, to every point of a batch with a single
+ * kernel launch. Small batches, and all batches when no device is
+ * available, are projected on the host.
+ */
+class CudaBatchNearestSegment {
+ public:
+  /**
+   * @param min_gpu_work batches of fewer point to segment distances are
+   *        projected on the host
+   */
+  explicit CudaBatchNearestSegment(std::size_t min_gpu_work = 1 << 16);
+
+  ~CudaBatchNearestSegment();
+
+  bool UpdateLineSegments(
+      const std::vector<std::vector<apollo::common::math::LineSegment2d>>&
+          segment_groups);
+
+  /**
+   * @brief project every point onto every group of segments
+   * @param points the points
+   * @param projections the projection of point i onto group g at
+   *        i * number of groups + g
+   * @return false if the device failed
+   */
+  bool FindNearestSegments(
+      const std::vector<apollo::common::math::Vec2d>& points,
+      std::vector<CudaSegmentProjection>* projections);
+
+ private:
+  template <class T>
+  bool ReserveDeviceArray(const std::size_t size, T** array,
+                          std::size_t* capacity);
+
+ private:
+  const std::size_t min_gpu_work_;
+  bool gpu_available_ = false;
+
+  std::vector<CudaLineSegment2d> host_segs_;
+  // the segments of group g are [group_offsets_[g], group_offsets_[g + 1])
+  std::vector<int> host_group_offsets_;
+  std::vector<CudaPoint2d> host_points_;
+
+  CudaLineSegment2d* dev_segs_ = nullptr;
+  std::size_t dev_segs_capacity_ = 0;
+  int* dev_group_offsets_ = nullptr;
+  std::size_t dev_group_offsets_capacity_ = 0;
+  CudaPoint2d* dev_points_ = nullptr;
+  std::size_t dev_points_capacity_ = 0;
+  CudaSegmentProjection* dev_projections_ = nullptr;
+  std::size_t dev_projections_capacity_ = 0;
+};
+
 }  // namespace pnc_map
 }  // namespace apollo
@@ -16,6 +16,11 @@
 
 #include "modules/map/pnc_map/cuda_util.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace apollo {
@@ -43,5 +48,56 @@ TEST(CudaUtil, CudaNearestSegment) {
   EXPECT_EQ(1, nearest_index);
 }
 
+TEST(CudaUtil, CudaBatchNearestSegment) {
+  std::vector<std::vector<LineSegment2d>> segment_groups(3);
+  for (int i = 0; i < 100; ++i) {
+    segment_groups[0].emplace_back(Vec2d(i, 0.0), Vec2d(i + 1.0, 0.0));
+    segment_groups[1].emplace_back(Vec2d(i, 10.0 + 0.1 * i),
+                                   Vec2d(i + 1.0, 10.1 + 0.1 * i));
+  }
+  segment_groups[2].emplace_back(Vec2d(50.0, -5.0), Vec2d(50.0, -5.0));
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(0.1 * i - 2.0, 0.013 * i - 3.0);
+  }
+
+  // every batch on the device, then every batch on the host
+  CudaBatchNearestSegment gpu_tool(0);
+  CudaBatchNearestSegment cpu_tool(points.size() * 1000);
+  ASSERT_TRUE(gpu_tool.UpdateLineSegments(segment_groups));
+  ASSERT_TRUE(cpu_tool.UpdateLineSegments(segment_groups));
+  std::vector<CudaSegmentProjection> gpu_projections;
+  std::vector<CudaSegmentProjection> cpu_projections;
+  ASSERT_TRUE(gpu_tool.FindNearestSegments(points, &gpu_projections));
+  ASSERT_TRUE(cpu_tool.FindNearestSegments(points, &cpu_projections));
+  ASSERT_EQ(points.size() * segment_groups.size(), gpu_projections.size());
+  ASSERT_EQ(gpu_projections.size(), cpu_projections.size());
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t g = 0; g < segment_groups.size(); ++g) {
+      double min_distance = std::numeric_limits<double>::infinity();
+      for (const auto& segment : segment_groups[g]) {
+        min_distance = std::min(min_distance, segment.DistanceTo(points[i]));
+      }
+      const auto& gpu = gpu_projections[i * segment_groups.size() + g];
+      const auto& cpu = cpu_projections[i * segment_groups.size() + g];
+      EXPECT_NEAR(min_distance, std::sqrt(gpu.distance_square), 1e-6);
+      EXPECT_NEAR(min_distance,
+                  segment_groups[g][gpu.segment_index].DistanceTo(points[i]),
+                  1e-6);
+      EXPECT_NEAR(min_distance,
+                  segment_groups[g][cpu.segment_index].DistanceTo(points[i]),
+                  1e-6);
+      EXPECT_NEAR(gpu.distance_square, cpu.distance_square, 1e-6);
+    }
+  }
+
+  // the first group is the x axis
+  const auto& projection = cpu_projections[505 * segment_groups.size()];
+  EXPECT_EQ(48, projection.segment_index);
+  EXPECT_NEAR(0.5, projection.longitudinal, 1e-9);
+  EXPECT_NEAR(3.565, projection.lateral, 1e-9);
+}
+
 }  // namespace pnc_map
 }  // namespace apollo
@@ -28,10 +28,15 @@
 
 // https://nacto.org/publication/urban-street-design-guide/street-design-elements/lane-width/
 DEFINE_double(default_lane_width, 3.048, "default lane width is about 10 feet");
+DEFINE_int32(path_segment_index_min_segments, 64,
+             "Paths with at least this many segments are projected onto with "
+             "a kd-tree of their segments, 0 to always search linearly.");
 
 namespace apollo {
 namespace hdmap {
 
+using common::math::AABoxKDTree2d;
+using common::math::AABoxKDTreeParams;
 using common::math::Box2d;
 using common::math::kMathEpsilon;
 using common::math::LineSegment2d;
@@ -279,6 +284,42 @@ std::string PathOverlap::DebugString() const {
   return common::util::StrCat(object_id, " ", start_s, " ", end_s);
 }
 
+PathSegmentIndex::PathSegmentIndex(const std::vector<LineSegment2d>& segments)
+    : segments_(segments) {
+  boxes_.reserve(segments_.size());
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const auto& segment = segments_[i];
+    boxes_.emplace_back(
+        common::math::AABox2d(segment.start(), segment.end()), &segment,
+        &segment, static_cast<int>(i));
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 16;
+  kdtree_.reset(new AABoxKDTree2d<SegmentBox>(boxes_, params));
+}
+
+int PathSegmentIndex::GetNearestSegment(const Vec2d& point,
+                                        const int hint_index) const {
+  const SegmentBox* hint =
+      hint_index >= 0 && hint_index < static_cast<int>(boxes_.size())
+          ? &boxes_[hint_index]
+          : nullptr;
+  const SegmentBox* nearest = kdtree_->GetNearestObject(point, hint);
+  if (nearest == nullptr) {
+    return 0;
+  }
+  // a point projected onto a shared end point is equally close to the
+  // segments before it
+  int index = nearest->id();
+  const double min_distance_sqr = nearest->DistanceSquareTo(point);
+  while (index > 0 &&
+         segments_[index - 1].DistanceSquareTo(point) <= min_distance_sqr) {
+    --index;
+  }
+  return index;
+}
+
 Path::Path(const std::vector<MapPathPoint>& path_points)
     : path_points_(path_points) {
   Init();
@@ -391,6 +432,11 @@ void Path::InitPoints() {
   CHECK_EQ(accumulated_s_.size(), num_points_);
   CHECK_EQ(unit_directions_.size(), num_points_);
   CHECK_EQ(segments_.size(), num_segments_);
+
+  if (FLAGS_path_segment_index_min_segments > 0 &&
+      num_segments_ >= FLAGS_path_segment_index_min_segments) {
+    segment_index_ = std::make_shared<LazySegmentIndex>();
+  }
 }
 
 void Path::InitLaneSegments() {
@@ -758,28 +804,8 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
   return true;
 }
 
@@ -797,6 +823,61 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
+  const int min_index = GetNearestSegment(point, -1, min_distance);
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr) {
+    return false;
+  }
+  accumulate_s->resize(points.size());
+  lateral->resize(points.size());
+  double min_distance = 0.0;
+  if (use_path_approximation_) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (!approximation_.GetProjection(*this, points[i], &(*accumulate_s)[i],
+                                        &(*lateral)[i], &min_distance)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  CHECK_GE(num_points_, 2);
+  int min_index = -1;
+  for (size_t i = 0; i < points.size(); ++i) {
+    min_index = GetNearestSegment(points[i], min_index, &min_distance);
+    GetProjectionOnSegment(points[i], min_index, min_distance,
+                           &(*accumulate_s)[i], &(*lateral)[i]);
+  }
+  return true;
+}
+
+const PathSegmentIndex* Path::segment_index() const {
+  if (segment_index_ == nullptr) {
+    return nullptr;
+  }
+  std::call_once(segment_index_->once, [this]() {
+    segment_index_->index.reset(new PathSegmentIndex(segments_));
+  });
+  return segment_index_->index.get();
+}
+
+int Path::GetNearestSegment(const Vec2d& point, const int hint_index,
+                            double* min_distance) const {
+  const auto* index = segment_index();
+  if (index != nullptr) {
+    const int min_index = index->GetNearestSegment(point, hint_index);
+    *min_distance = segments_[min_index].DistanceTo(point);
+    return min_index;
+  }
   *min_distance = std::numeric_limits<double>::infinity();
   int min_index = 0;
   for (int i = 0; i < num_segments_; ++i) {
@@ -807,6 +888,12 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
     }
   }
   *min_distance = std::sqrt(*min_distance);
+  return min_index;
+}
+
+void Path::GetProjectionOnSegment(const Vec2d& point, const int min_index,
+                                  const double min_distance,
+                                  double* accumulate_s, double* lateral) const {
   const auto& nearest_seg = segments_[min_index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
@@ -815,21 +902,20 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
   } else if (min_index == num_segments_ - 1) {
     *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
   } else {
     *accumulate_s = accumulated_s_[min_index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
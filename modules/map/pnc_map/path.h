@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "modules/map/proto/map_lane.pb.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/math/aaboxkdtree2d.h"
 #include "modules/common/math/box2d.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -205,6 +208,33 @@ class PathApproximation {
   std::vector<int> sampled_max_original_projections_to_left_;
 };
 
+/**
+ * @class PathSegmentIndex
+ * @brief A kd-tree of the segments of a path, to find the segment nearest to
+ * a point without checking all of them.
+ */
+class PathSegmentIndex {
+ public:
+  explicit PathSegmentIndex(
+      const std::vector<common::math::LineSegment2d>& segments);
+
+  /**
+   * @brief Gets the index of the segment nearest to the point, the lowest one
+   * on a tie as a linear search does.
+   * @param hint_index the nearest segment of a point close by, -1 if unknown
+   */
+  int GetNearestSegment(const common::math::Vec2d& point,
+                        const int hint_index) const;
+
+ private:
+  using SegmentBox =
+      ObjectWithAABox<common::math::LineSegment2d, common::math::LineSegment2d>;
+
+  std::vector<common::math::LineSegment2d> segments_;
+  std::vector<SegmentBox> boxes_;
+  std::unique_ptr<common::math::AABoxKDTree2d<SegmentBox>> kdtree_;
+};
+
 class InterpolatedIndex {
  public:
   InterpolatedIndex(int id, double offset) : id(id), offset(offset) {}
@@ -261,6 +291,13 @@ class Path {
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
 
+  // Projects the points in order, starting the search of each point from the
+  // nearest segment of the previous one, which is cheap for points close to
+  // each other such as the corners of a box.
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral) const;
+
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
 
@@ -341,6 +378,15 @@ class Path {
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
+  const PathSegmentIndex* segment_index() const;
+
+  int GetNearestSegment(const common::math::Vec2d& point, const int hint_index,
+                        double* min_distance) const;
+
+  void GetProjectionOnSegment(const common::math::Vec2d& point,
+                              const int min_index, const double min_distance,
+                              double* accumulate_s, double* lateral) const;
+
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
   void GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
@@ -360,6 +406,14 @@ class Path {
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
 
+  // Built on the first projection and shared by the copies of the path, null
+  // for short paths which are searched linearly.
+  struct LazySegmentIndex {
+    std::once_flag once;
+    std::unique_ptr<PathSegmentIndex> index;
+  };
+  std::shared_ptr<LazySegmentIndex> segment_index_;
+
   // Sampled every fixed length.
   int num_sample_points_ = 0;
   std::vector<double> lane_left_width_;
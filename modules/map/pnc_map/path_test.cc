@@ -24,6 +24,8 @@
 
 #include "modules/map/hdmap/hdmap.h"
 
+DECLARE_int32(path_segment_index_min_segments);
+
 using Point = apollo::common::PointENU;
 using AABox2d = apollo::common::math::AABox2d;
 using Vec2d = apollo::common::math::Vec2d;
@@ -578,6 +580,62 @@ TEST(TestSuite, hdmap_jerky_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_segment_index) {
+  const int kNumPaths = 20;
+  const int kCasesPerPath = 1000;
+  const int min_segments = FLAGS_path_segment_index_min_segments;
+  for (int path_id = 0; path_id < kNumPaths; ++path_id) {
+    const int num_segments = RandomInt(50, 200);
+    const double max_y = RandomDouble(0.5, 10.0);
+    std::vector<MapPathPoint> points;
+    double sum_x = 0;
+    for (int i = 0; i <= num_segments; ++i) {
+      points.push_back(MakeMapPathPoint(sum_x, RandomDouble(-max_y, max_y)));
+      sum_x += RandomDouble(0.1, 2.0);
+    }
+    FLAGS_path_segment_index_min_segments = 0;
+    const Path linear_path(points, {});
+    FLAGS_path_segment_index_min_segments = 1;
+    const Path indexed_path(points, {});
+    // copies share the index
+    const Path copied_path = indexed_path;
+
+    const AABox2d box({0.0, -max_y}, {sum_x, max_y});
+    for (int case_id = 0; case_id < kCasesPerPath; ++case_id) {
+      const Vec2d point(RandomDouble(box.min_x() - 5.0, box.max_x() + 5.0),
+                        RandomDouble(box.min_y() - 5.0, box.max_y() + 5.0));
+      double s = 0.0;
+      double l = 0.0;
+      double distance = 0.0;
+      EXPECT_TRUE(linear_path.GetProjection(point, &s, &l, &distance));
+      double indexed_s = 0.0;
+      double indexed_l = 0.0;
+      double indexed_distance = 0.0;
+      EXPECT_TRUE(copied_path.GetProjection(point, &indexed_s, &indexed_l,
+                                            &indexed_distance));
+      EXPECT_NEAR(distance, indexed_distance, 1e-6);
+      EXPECT_NEAR(s, indexed_s, 1e-6);
+      EXPECT_NEAR(l, indexed_l, 1e-6);
+    }
+
+    const common::math::Box2d vehicle({sum_x / 2.0, 0.0}, 0.3, 5.0, 2.0);
+    const auto corners = vehicle.GetAllCorners();
+    std::vector<double> batch_s;
+    std::vector<double> batch_l;
+    EXPECT_TRUE(indexed_path.GetProjections(corners, &batch_s, &batch_l));
+    ASSERT_EQ(corners.size(), batch_s.size());
+    ASSERT_EQ(corners.size(), batch_l.size());
+    for (size_t i = 0; i < corners.size(); ++i) {
+      double s = 0.0;
+      double l = 0.0;
+      EXPECT_TRUE(linear_path.GetProjection(corners[i], &s, &l));
+      EXPECT_NEAR(s, batch_s[i], 1e-6);
+      EXPECT_NEAR(l, batch_l[i], 1e-6);
+    }
+  }
+  FLAGS_path_segment_index_min_segments = min_segments;
+}
+
 TEST(TestSuite, hdmap_s_path) {
   std::vector<MapPathPoint> points;
   const double kRadius = 50.0;
@@ -46,6 +46,14 @@ DEFINE_double(
     look_forward_long_distance, 250,
     "look forward this distance when creating reference line from routing");
 
+DEFINE_bool(enable_incremental_route_segments, false,
+            "Keep the route segments of the last cycle and trim them while "
+            "the vehicle moves along, instead of rebuilding them from the "
+            "routing every cycle");
+DEFINE_double(incremental_route_segments_margin, 50.0,
+              "Route segments are extended this further forward in the "
+              "incremental mode so that they are reused for the next cycles");
+
 namespace apollo {
 namespace hdmap {
 
@@ -223,6 +231,9 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
   range_lane_ids_.clear();
   route_indices_.clear();
   all_lane_ids_.clear();
+  extended_road_index_ = -1;
+  extended_passages_.clear();
+  neighbor_passages_.clear();
   for (int road_index = 0; road_index < routing.road_size(); ++road_index) {
     const auto &road_segment = routing.road(road_index);
     for (int passage_index = 0; passage_index < road_segment.passage_size();
@@ -451,14 +462,39 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
   const int road_index = route_index[0];
   const int passage_index = route_index[1];
   const auto &road = routing_.road(road_index);
+  const bool incremental = FLAGS_enable_incremental_route_segments;
+  if (incremental && extended_road_index_ != road_index) {
+    extended_road_index_ = road_index;
+    extended_passages_.clear();
+    neighbor_passages_.clear();
+  }
   // raw filter to find all neighboring passages
-  auto drive_passages = GetNeighborPassages(road, passage_index);
+  std::vector<int> drive_passages;
+  if (incremental) {
+    const std::array<int, 3> key = {
+        {road_index, passage_index,
+         static_cast<int>(next_routing_waypoint_index_)}};
+    auto iter = neighbor_passages_.find(key);
+    if (iter == neighbor_passages_.end()) {
+      iter = neighbor_passages_
+                 .emplace(key, GetNeighborPassages(road, passage_index))
+                 .first;
+    }
+    drive_passages = iter->second;
+  } else {
+    drive_passages = GetNeighborPassages(road, passage_index);
+  }
   for (const int index : drive_passages) {
     const auto &passage = road.passage(index);
+    ExtendedPassage *cache = incremental ? &extended_passages_[index] : nullptr;
     RouteSegments segments;
-    if (!PassageToSegments(passage, &segments)) {
+    if (cache != nullptr && !cache->segments.empty()) {
+      segments = cache->segments;
+    } else if (!PassageToSegments(passage, &segments)) {
       ADEBUG << "Failed to convert passage to lane segments.";
       continue;
+    } else if (cache != nullptr) {
+      cache->segments = segments;
     }
     PointENU nearest_point =
         MakePointENU(adc_state_.x(), adc_state_.y(), adc_state_.z());
@@ -481,8 +517,9 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
     }
     route_segments->emplace_back();
     const auto last_waypoint = segments.LastWaypoint();
-    if (!ExtendSegments(segments, sl.s() - backward_length,
-                        sl.s() + forward_length, &route_segments->back())) {
+    if (!ExtendPassageSegments(segments, sl.s() - backward_length,
+                               sl.s() + forward_length, cache,
+                               &route_segments->back())) {
       AERROR << "Failed to extend segments with s=" << sl.s()
              << ", backward: " << backward_length
              << ", forward: " << forward_length;
@@ -620,9 +657,53 @@ bool PncMap::ExtendSegments(const RouteSegments &segments,
                         extended_segments);
 }
 
+bool PncMap::ExtendPassageSegments(
+    const RouteSegments &segments, const double start_s, const double end_s,
+    ExtendedPassage *const cache,
+    RouteSegments *const extended_segments) const {
+  if (cache == nullptr) {
+    return ExtendSegments(segments, start_s, end_s, extended_segments);
+  }
+  if (cache->extended.empty() || cache->range_start != range_start_ ||
+      cache->range_end != range_end_ || start_s < cache->start_s ||
+      end_s > cache->end_s) {
+    double backward_length = 0.0;
+    const double cache_end_s = end_s + FLAGS_incremental_route_segments_margin;
+    cache->extended.clear();
+    if (!ExtendSegments(segments, start_s, cache_end_s, &cache->extended,
+                        &backward_length)) {
+      cache->extended.clear();
+      return false;
+    }
+    cache->range_start = range_start_;
+    cache->range_end = range_end_;
+    cache->start_s = start_s;
+    cache->end_s = cache_end_s;
+    cache->begin_s = start_s < 0.0 ? -backward_length : start_s;
+  }
+  // The extension stops where the route has no predecessor or successor, or
+  // loops, which would stop the extension from the passage at the same
+  // place. Trimming within the extension keeps it from being extended again.
+  const double length = RouteSegments::Length(cache->extended);
+  return ExtendSegments(cache->extended,
+                        std::max(start_s - cache->begin_s, 0.0),
+                        std::min(end_s - cache->begin_s, length),
+                        extended_segments);
+}
+
 bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
                             double end_s,
                             RouteSegments *const truncated_segments) const {
+  return ExtendSegments(segments, start_s, end_s, truncated_segments, nullptr);
+}
+
+bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
+                            double end_s,
+                            RouteSegments *const truncated_segments,
+                            double *const backward_length) const {
+  if (backward_length != nullptr) {
+    *backward_length = 0.0;
+  }
   if (segments.empty()) {
     AERROR << "The input segments is empty";
     return false;
@@ -662,6 +743,9 @@ bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
     truncated_segments->insert(truncated_segments->begin(),
                                extended_lane_segments.rbegin(),
                                extended_lane_segments.rend());
+    if (backward_length != nullptr) {
+      *backward_length = -start_s - extend_s;
+    }
   }
   bool found_loop = false;
   double router_s = 0;
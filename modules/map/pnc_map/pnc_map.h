@@ -20,9 +20,12 @@
 
 #pragma once
 
+#include <array>
 #include <list>
+#include <map>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "gflags/gflags.h"
@@ -38,6 +41,8 @@
 DECLARE_double(look_backward_distance);
 DECLARE_double(look_forward_short_distance);
 DECLARE_double(look_forward_long_distance);
+DECLARE_bool(enable_incremental_route_segments);
+DECLARE_double(incremental_route_segments_margin);
 
 namespace apollo {
 namespace hdmap {
@@ -83,6 +88,40 @@ class PncMap {
   std::vector<routing::LaneWaypoint> FutureRouteWaypoints() const;
 
  private:
+  /**
+   * The segments of a passage extended around the adc, kept between
+   * planning cycles in the incremental mode.
+   */
+  struct ExtendedPassage {
+    // the segments of the passage
+    RouteSegments segments;
+    // the routing range the extension was made with, which decides the
+    // route predecessors and successors
+    int range_start = 0;
+    int range_end = 0;
+    // the requested extension range, in passage s
+    double start_s = 0.0;
+    double end_s = 0.0;
+    // the passage s of the beginning of the extended segments
+    double begin_s = 0.0;
+    RouteSegments extended;
+  };
+
+  bool ExtendSegments(const RouteSegments &segments, double start_s,
+                      double end_s, RouteSegments *const truncated_segments,
+                      double *const backward_length) const;
+
+  /**
+   * @brief extend the segments of a passage to [start_s, end_s]. The
+   * extension of the last cycle is trimmed instead when it covers the range
+   * and the routing range is unchanged.
+   * @param cache the extension of the last cycle, nullptr to always extend
+   */
+  bool ExtendPassageSegments(const RouteSegments &segments,
+                             const double start_s, const double end_s,
+                             ExtendedPassage *const cache,
+                             RouteSegments *const extended_segments) const;
+
   bool UpdateVehicleState(const common::VehicleState &vehicle_state);
   /**
    * @brief Find the waypoint index of a routing waypoint. It updates
@@ -170,6 +209,14 @@ class PncMap {
   std::unordered_set<std::string> range_lane_ids_;
   std::unordered_set<std::string> all_lane_ids_;
 
+  // the passages of the current road by passage index, in the incremental
+  // mode
+  int extended_road_index_ = -1;
+  std::map<int, ExtendedPassage> extended_passages_;
+  // the neighbor passages by {road_index, passage_index, next routing
+  // waypoint index}, in the incremental mode
+  std::map<std::array<int, 3>, std::vector<int>> neighbor_passages_;
+
   /**
    * The routing request waypoints
    */
@@ -174,6 +174,43 @@ TEST_F(PncMapTest, GetRouteSegments_ChangeLane) {
   EXPECT_FALSE(second.IsOnSegment());
 }
 
+TEST_F(PncMapTest, GetRouteSegments_Incremental) {
+  PncMap pnc_map(&hdmap_);
+  ASSERT_TRUE(pnc_map.UpdateRoutingResponse(routing_));
+  PncMap incremental_pnc_map(&hdmap_);
+  ASSERT_TRUE(incremental_pnc_map.UpdateRoutingResponse(routing_));
+  auto lane = hdmap_.GetLaneById(hdmap::MakeMapId("9_1_-2"));
+  ASSERT_TRUE(lane);
+  for (double s = 0.0; s < lane->total_length(); s += 2.0) {
+    const auto point = lane->GetSmoothPoint(s);
+    common::VehicleState state;
+    state.set_x(point.x());
+    state.set_y(point.y());
+    state.set_z(point.z());
+    state.set_heading(lane->Heading(s));
+    std::list<RouteSegments> expected_segments;
+    FLAGS_enable_incremental_route_segments = false;
+    ASSERT_TRUE(pnc_map.GetRouteSegments(state, 10, 30, &expected_segments));
+    std::list<RouteSegments> segments;
+    FLAGS_enable_incremental_route_segments = true;
+    ASSERT_TRUE(incremental_pnc_map.GetRouteSegments(state, 10, 30, &segments));
+    ASSERT_EQ(expected_segments.size(), segments.size());
+    auto iter = segments.begin();
+    for (const auto& expected : expected_segments) {
+      EXPECT_EQ(expected.Id(), iter->Id());
+      EXPECT_EQ(expected.NextAction(), iter->NextAction());
+      ASSERT_EQ(expected.size(), iter->size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].lane->id().id(), (*iter)[i].lane->id().id());
+        EXPECT_NEAR(expected[i].start_s, (*iter)[i].start_s, 1e-6);
+        EXPECT_NEAR(expected[i].end_s, (*iter)[i].end_s, 1e-6);
+      }
+      ++iter;
+    }
+  }
+  FLAGS_enable_incremental_route_segments = false;
+}
+
 TEST_F(PncMapTest, NextWaypointIndex) {
   EXPECT_EQ(0, pnc_map_->NextWaypointIndex(-2));
   EXPECT_EQ(0, pnc_map_->NextWaypointIndex(-1));
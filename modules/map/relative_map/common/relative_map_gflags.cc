@@ -34,3 +34,7 @@ DEFINE_bool(relative_map_generate_left_boundray, true,
 DEFINE_bool(navigator_down_sample, true,
             "When a navigation line is sent, the original data is downsampled "
             "to reduce unnecessary memory consumption.");
+
+DEFINE_bool(relative_map_prebuild_hdmap, false,
+            "Build the HDMap of every relative map before publishing it, to "
+            "be taken by a navi planning running in the same process.");
@@ -24,3 +24,4 @@ DECLARE_int32(relative_map_loop_rate);
 DECLARE_bool(enable_cyclic_rerouting);
 DECLARE_bool(relative_map_generate_left_boundray);
 DECLARE_bool(navigator_down_sample);
+DECLARE_bool(relative_map_prebuild_hdmap);
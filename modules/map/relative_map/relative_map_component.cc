@@ -16,7 +16,11 @@
 
 #include "modules/map/relative_map/relative_map_component.h"
 
+#include <utility>
+
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/relative_map/common/relative_map_gflags.h"
 
 namespace apollo {
 namespace relative_map {
@@ -36,6 +40,14 @@ bool RelativeMapComponent::Proc() {
     return false;
   }
   common::util::FillHeader(node_->Name(), map_msg.get());
+  if (FLAGS_relative_map_prebuild_hdmap) {
+    // built here, off the critical path of the planning cycle
+    std::unique_ptr<hdmap::HDMap> hdmap(new hdmap::HDMap());
+    if (hdmap->LoadMapFromProto(map_msg->hdmap()) == 0) {
+      hdmap::HDMapUtil::SetPrebuiltBaseMap(map_msg->header().sequence_num(),
+                                           std::move(hdmap));
+    }
+  }
   relative_map_writer_->Write(map_msg);
   return true;
 }
@@ -25,6 +25,7 @@
 #include "modules/dreamview/proto/hmi_config.pb.h"
 #include "modules/dreamview/proto/hmi_mode.pb.h"
 #include "modules/dreamview/proto/hmi_status.pb.h"
+#include "modules/monitor/common/process_table.h"
 #include "modules/monitor/proto/system_status.pb.h"
 
 /**
@@ -48,6 +49,8 @@ class MonitorManager {
   bool IsInAutonomousMode() const { return in_autonomous_driving_; }
   SystemStatus* GetStatus() { return &status_; }
   apollo::common::monitor::MonitorLogBuffer& LogBuffer() { return log_buffer_; }
+  // The running processes, shared by the monitors. Refresh before use.
+  ProcessTable* GetProcessTable() { return &process_table_; }
 
   // Cyber reader / writer creater.
   template <class T>
@@ -74,6 +77,7 @@ class MonitorManager {
   bool CheckAutonomousDriving(const double current_time);
 
   apollo::common::monitor::MonitorLogBuffer log_buffer_;
+  ProcessTable process_table_;
   std::shared_ptr<apollo::cyber::Node> node_;
   std::unordered_map<std::string, std::shared_ptr<cyber::ReaderBase>> readers_;
 
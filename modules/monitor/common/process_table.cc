@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/process_table.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+// Command lines are read again while processes are younger than this many
+// refreshes.
+constexpr int kCommandSettleAge = 2;
+
+// Reads up to size - 1 bytes of the file, returning the length read or -1.
+int ReadFile(const char* path, char* buffer, const size_t size) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  size_t length = 0;
+  while (length + 1 < size) {
+    const ssize_t n = read(fd, buffer + length, size - 1 - length);
+    if (n <= 0) {
+      break;
+    }
+    length += n;
+  }
+  close(fd);
+  buffer[length] = '\0';
+  return static_cast<int>(length);
+}
+
+}  // namespace
+
+ProcessTable::ProcessTable()
+    : ticks_per_second_(static_cast<double>(sysconf(_SC_CLK_TCK))),
+      page_size_(static_cast<uint64_t>(sysconf(_SC_PAGESIZE))) {}
+
+void ProcessTable::Refresh(const double current_time,
+                           const double min_interval) {
+  if (last_refresh_time_ >= 0 &&
+      current_time - last_refresh_time_ < min_interval) {
+    return;
+  }
+  const double elapsed =
+      last_refresh_time_ >= 0 ? current_time - last_refresh_time_ : 0.0;
+  last_refresh_time_ = current_time;
+
+  DIR* dir = opendir("/proc");
+  if (dir == nullptr) {
+    return;
+  }
+  // Processes not listed this time have exited.
+  for (auto& entry : processes_) {
+    entry.second.age = -entry.second.age;
+  }
+  while (const dirent* entry = readdir(dir)) {
+    char* end = nullptr;
+    const long pid = std::strtol(entry->d_name, &end, 10);  // NOLINT
+    if (pid <= 0 || *end != '\0') {
+      continue;
+    }
+    auto iter = processes_.find(static_cast<int>(pid));
+    const bool is_new = iter == processes_.end();
+    Process& process =
+        is_new ? processes_[static_cast<int>(pid)] : iter->second;
+    const uint64_t prev_cpu_ticks = process.cpu_ticks;
+    process.age = is_new ? 1 : 1 - process.age;
+    if (process.age <= kCommandSettleAge) {
+      ReadCommand(static_cast<int>(pid), &process.command);
+    }
+    // Kernel threads and zombies have no command line, nothing to sample.
+    if (process.command.empty()) {
+      continue;
+    }
+    if (!ReadStat(static_cast<int>(pid), &process)) {
+      // Gone meanwhile.
+      process.age = 0;
+      continue;
+    }
+    process.cpu_usage =
+        is_new || elapsed <= 0 || process.cpu_ticks < prev_cpu_ticks
+            ? 0.0
+            : 100.0 * static_cast<double>(process.cpu_ticks - prev_cpu_ticks) /
+                  ticks_per_second_ / elapsed;
+  }
+  closedir(dir);
+
+  for (auto iter = processes_.begin(); iter != processes_.end();) {
+    if (iter->second.age <= 0) {
+      iter = processes_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+const ProcessTable::Process* ProcessTable::Find(
+    const google::protobuf::RepeatedPtrField<std::string>& keywords) const {
+  for (const auto& entry : processes_) {
+    const std::string& command = entry.second.command;
+    if (!command.empty() &&
+        std::all_of(keywords.begin(), keywords.end(),
+                    [&command](const std::string& keyword) {
+                      return command.find(keyword) != std::string::npos;
+                    })) {
+      return &entry.second;
+    }
+  }
+  return nullptr;
+}
+
+bool ProcessTable::ReadCommand(const int pid, std::string* command) {
+  snprintf(path_, sizeof(path_), "/proc/%d/cmdline", pid);
+  const int length = ReadFile(path_, buffer_, sizeof(buffer_));
+  if (length <= 0) {
+    command->clear();
+    return false;
+  }
+  // In /proc/<PID>/cmdline, the parts are seperated with \0, which will be
+  // converted back to whitespaces here.
+  std::replace(buffer_, buffer_ + length, '\0', ' ');
+  command->assign(buffer_, length);
+  return true;
+}
+
+bool ProcessTable::ReadStat(const int pid, Process* process) {
+  snprintf(path_, sizeof(path_), "/proc/%d/stat", pid);
+  if (ReadFile(path_, buffer_, sizeof(buffer_)) <= 0) {
+    return false;
+  }
+  // The command name in parentheses may contain anything, the fields
+  // counted from 3 on follow the last ')'.
+  const char* fields = std::strrchr(buffer_, ')');
+  if (fields == nullptr) {
+    return false;
+  }
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  int64_t rss_pages = 0;
+  // state(3) ... utime(14) stime(15) ... rss(24)
+  if (std::sscanf(fields + 1,
+                  " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu "
+                  "%*d %*d %*d %*d %*d %*d %*u %*u %ld",
+                  &utime, &stime, &rss_pages) != 3) {
+    return false;
+  }
+  process->cpu_ticks = utime + stime;
+  process->rss_bytes =
+      rss_pages > 0 ? static_cast<uint64_t>(rss_pages) * page_size_ : 0;
+  return true;
+}
+
+}  // namespace monitor
+}  // namespace apollo
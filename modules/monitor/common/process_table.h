@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "google/protobuf/repeated_field.h"
+
+namespace apollo {
+namespace monitor {
+
+// The running processes, sampled from /proc for the monitors to share.
+//
+// A refresh lists /proc and reads the stat of every process into a fixed
+// buffer. Command lines are only read for new processes, and a few more
+// times while they are young, as a forked child may not have exec'ed yet.
+class ProcessTable {
+ public:
+  struct Process {
+    // The command line, its parts separated by spaces. Empty for kernel
+    // threads and zombies, which are not sampled.
+    std::string command;
+    // utime + stime, in clock ticks.
+    uint64_t cpu_ticks = 0;
+    // Since the previous refresh, in percent of one core.
+    double cpu_usage = 0.0;
+    uint64_t rss_bytes = 0;
+    // The refreshes which have seen the process.
+    int age = 0;
+  };
+
+  ProcessTable();
+
+  // Samples /proc unless the last sample is less than min_interval old, so
+  // that monitors running at about the same time share it.
+  void Refresh(double current_time, double min_interval = 1.0);
+
+  const std::unordered_map<int, Process>& processes() const {
+    return processes_;
+  }
+
+  // A process whose command contains all the keywords, or nullptr.
+  const Process* Find(
+      const google::protobuf::RepeatedPtrField<std::string>& keywords) const;
+
+ private:
+  bool ReadCommand(int pid, std::string* command);
+  bool ReadStat(int pid, Process* process);
+
+  std::unordered_map<int, Process> processes_;
+  double last_refresh_time_ = -1.0;
+  // Clock ticks per second and bytes per page.
+  double ticks_per_second_;
+  uint64_t page_size_;
+  char path_[64];
+  char buffer_[4096];
+};
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/process_table.h"
+
+#include <unistd.h>
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+TEST(ProcessTableTest, FindsSelf) {
+  ProcessTable table;
+  table.Refresh(0.0);
+  const auto& processes = table.processes();
+  ASSERT_EQ(1, processes.count(getpid()));
+  const auto& self = processes.at(getpid());
+  EXPECT_NE(std::string::npos, self.command.find("process_table_test"));
+  EXPECT_GT(self.rss_bytes, 0);
+  EXPECT_EQ(1, self.age);
+
+  google::protobuf::RepeatedPtrField<std::string> keywords;
+  *keywords.Add() = "process_table_test";
+  const auto* found = table.Find(keywords);
+  ASSERT_NE(nullptr, found);
+  EXPECT_NE(std::string::npos, found->command.find("process_table_test"));
+  *keywords.Add() = "no_such_keyword";
+  EXPECT_EQ(nullptr, table.Find(keywords));
+}
+
+TEST(ProcessTableTest, SamplesCpuUsage) {
+  ProcessTable table;
+  table.Refresh(0.0);
+  // too soon, skipped
+  table.Refresh(0.5);
+  EXPECT_EQ(1, table.processes().at(getpid()).age);
+
+  // keep a core busy for a while
+  const auto start = std::chrono::steady_clock::now();
+  volatile uint64_t sum = 0;
+  while (std::chrono::steady_clock::now() - start <
+         std::chrono::milliseconds(200)) {
+    ++sum;
+  }
+  table.Refresh(1.0, 0.0);
+  const auto& self = table.processes().at(getpid());
+  EXPECT_EQ(2, self.age);
+  // 0.2s of cpu time in 1s of table time
+  EXPECT_GT(self.cpu_usage, 10.0);
+  EXPECT_LT(self.cpu_usage, 40.0);
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -52,7 +52,16 @@ void ResourceMonitor::RunOnce(const double current_time) {
     const std::string& name = iter.first;
     const auto& config = iter.second;
     if (config.has_resource()) {
-      UpdateStatus(config.resource(),
+      const auto& resource = config.resource();
+      const ProcessTable::Process* process = nullptr;
+      if (config.has_process() && (resource.has_cpu_usage_warning() ||
+                                   resource.has_memory_usage_warning())) {
+        // Shares the sample of the process monitor when it is recent.
+        auto* running_processes = manager->GetProcessTable();
+        running_processes->Refresh(current_time);
+        process = running_processes->Find(config.process().command_keywords());
+      }
+      UpdateStatus(resource, process,
                    components->at(name).mutable_resource_status());
     }
   }
@@ -60,8 +69,26 @@ void ResourceMonitor::RunOnce(const double current_time) {
 
 void ResourceMonitor::UpdateStatus(
     const apollo::dreamview::ResourceMonitorConfig& config,
-    ComponentStatus* status) {
+    const ProcessTable::Process* process, ComponentStatus* status) {
   status->clear_status();
+  // Monitor the usage of the process.
+  if (process != nullptr) {
+    const int memory_mb = static_cast<int>(process->rss_bytes >> 20);
+    if (config.has_cpu_usage_warning() &&
+        process->cpu_usage > config.cpu_usage_warning()) {
+      const std::string err = StrCat("CPU usage is too high: ",
+                                     static_cast<int>(process->cpu_usage),
+                                     "% > ", config.cpu_usage_warning(), "%");
+      SummaryMonitor::EscalateStatus(ComponentStatus::WARN, err, status);
+    }
+    if (config.has_memory_usage_warning() &&
+        memory_mb > config.memory_usage_warning()) {
+      const std::string err =
+          StrCat("Memory usage is too high: ", memory_mb, "MB > ",
+                 config.memory_usage_warning(), "MB");
+      SummaryMonitor::EscalateStatus(ComponentStatus::WARN, err, status);
+    }
+  }
   // Monitor available disk space.
   for (const auto& disk_space : config.disk_spaces()) {
     for (const auto& path : apollo::common::util::Glob(disk_space.path())) {
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "modules/dreamview/proto/hmi_mode.pb.h"
+#include "modules/monitor/common/process_table.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/system_status.pb.h"
 
@@ -30,7 +31,7 @@ class ResourceMonitor : public RecurrentRunner {
  private:
   static void UpdateStatus(
       const apollo::dreamview::ResourceMonitorConfig& config,
-      ComponentStatus* status);
+      const ProcessTable::Process* process, ComponentStatus* status);
 };
 
 }  // namespace monitor
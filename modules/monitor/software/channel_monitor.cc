@@ -16,24 +16,15 @@
 
 #include "modules/monitor/software/channel_monitor.h"
 
-#include <memory>
+#include <algorithm>
 #include <string>
 
 #include "cyber/common/log.h"
 #include "cyber/cyber.h"
-#include "modules/common/adapters/adapter_gflags.h"
-#include "modules/common/util/map_util.h"
+#include "cyber/node/channel_stats_reporter.h"
 #include "modules/common/util/string_util.h"
-#include "modules/control/proto/control_cmd.pb.h"
-#include "modules/drivers/proto/conti_radar.pb.h"
-#include "modules/drivers/proto/pointcloud.pb.h"
-#include "modules/localization/proto/pose.pb.h"
-#include "modules/map/relative_map/proto/navigation.pb.h"
 #include "modules/monitor/common/monitor_manager.h"
 #include "modules/monitor/software/summary_monitor.h"
-#include "modules/perception/proto/perception_obstacle.pb.h"
-#include "modules/planning/proto/planning.pb.h"
-#include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 DEFINE_string(channel_monitor_name, "ChannelMonitor",
               "Name of the channel monitor.");
@@ -45,33 +36,11 @@ namespace apollo {
 namespace monitor {
 namespace {
 using apollo::common::util::StrCat;
+using apollo::cyber::ChannelStatsReporter;
+using apollo::cyber::proto::ChannelStatsReport;
 
-// We have to specify exact type of each channel. This function is a wrapper for
-// those only need a ReaderBase.
-std::shared_ptr<cyber::ReaderBase> GetReader(const std::string& channel) {
-  auto manager = MonitorManager::Instance();
-  if (channel == FLAGS_control_command_topic) {
-    return manager->CreateReader<control::ControlCommand>(channel);
-  } else if (channel == FLAGS_localization_topic) {
-    return manager->CreateReader<localization::LocalizationEstimate>(channel);
-  } else if (channel == FLAGS_perception_obstacle_topic) {
-    return manager->CreateReader<perception::PerceptionObstacles>(channel);
-  } else if (channel == FLAGS_prediction_topic) {
-    return manager->CreateReader<prediction::PredictionObstacles>(channel);
-  } else if (channel == FLAGS_planning_trajectory_topic) {
-    return manager->CreateReader<planning::ADCTrajectory>(channel);
-  } else if (channel == FLAGS_conti_radar_topic) {
-    return manager->CreateReader<drivers::ContiRadar>(channel);
-  } else if (channel == FLAGS_relative_map_topic) {
-    return manager->CreateReader<relative_map::MapMsg>(channel);
-  } else if (channel == FLAGS_pointcloud_topic ||
-             channel == FLAGS_pointcloud_128_topic) {
-    return manager->CreateReader<drivers::PointCloud>(channel);
-  }
-  // Add more channels here if you want to monitor.
-  AFATAL << "Channel is not handled by ChannelMonitor: " << channel;
-  return nullptr;
-}
+// Every process reports once per second, keep a few runs of them.
+constexpr uint32_t kReportHistoryDepth = 1024;
 
 }  // namespace
 
@@ -81,6 +50,7 @@ ChannelMonitor::ChannelMonitor()
 }
 
 void ChannelMonitor::RunOnce(const double current_time) {
+  UpdateReports();
   auto manager = MonitorManager::Instance();
   const auto& mode = manager->GetHMIMode();
   auto* components = manager->GetStatus()->mutable_components();
@@ -94,11 +64,49 @@ void ChannelMonitor::RunOnce(const double current_time) {
   }
 }
 
+void ChannelMonitor::UpdateReports() {
+  static auto reader = MonitorManager::Instance()->CreateReader<
+      ChannelStatsReport>(ChannelStatsReporter::kChannelName);
+  reader->SetHistoryDepth(kReportHistoryDepth);
+  reader->Observe();
+  for (auto it = reader->Begin(); it != reader->End(); ++it) {
+    const auto& report = **it;
+    auto& latest = reports_[report.process_name()];
+    if (report.timestamp() > latest.timestamp()) {
+      latest = report;
+    }
+  }
+}
+
+double ChannelMonitor::GetDelaySec(const std::string& channel) const {
+  // Like cyber::Reader::GetDelaySec(), the delay is at least the interval
+  // between the latest two messages.
+  uint64_t last_send_time = 0;
+  uint64_t last_send_interval = 0;
+  for (const auto& entry : reports_) {
+    for (const auto& counters : entry.second.channel()) {
+      if (counters.channel_name() == channel &&
+          counters.last_send_time() > last_send_time) {
+        last_send_time = counters.last_send_time();
+        last_send_interval = counters.last_send_interval();
+      }
+    }
+  }
+  if (last_send_time == 0) {
+    return -1.0;
+  }
+  const uint64_t now = cyber::Time::Now().ToNanosecond();
+  const uint64_t delay =
+      std::max(now > last_send_time ? now - last_send_time : 0,
+               last_send_interval);
+  return static_cast<double>(delay) * 1e-9;
+}
+
 void ChannelMonitor::UpdateStatus(
     const apollo::dreamview::ChannelMonitorConfig& config,
-    ComponentStatus* status) {
+    ComponentStatus* status) const {
   status->clear_status();
-  const double delay = GetReader(config.name())->GetDelaySec();
+  const double delay = GetDelaySec(config.name());
   if (delay < 0 || delay > config.delay_fatal()) {
     SummaryMonitor::EscalateStatus(
         ComponentStatus::FATAL,
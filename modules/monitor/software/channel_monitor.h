@@ -15,6 +15,10 @@
  *****************************************************************************/
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
+#include "cyber/proto/channel_stats.pb.h"
 #include "modules/dreamview/proto/hmi_mode.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/system_status.pb.h"
@@ -28,9 +32,17 @@ class ChannelMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
-  static void UpdateStatus(
-      const apollo::dreamview::ChannelMonitorConfig& config,
-      ComponentStatus* status);
+  // Takes in the channel stats reported since the last run.
+  void UpdateReports();
+  // Seconds since the channel was last written by any process, or -1 if it
+  // never was.
+  double GetDelaySec(const std::string& channel) const;
+  void UpdateStatus(const apollo::dreamview::ChannelMonitorConfig& config,
+                    ComponentStatus* status) const;
+
+  // The latest stats of each process, by process name.
+  std::unordered_map<std::string, apollo::cyber::proto::ChannelStatsReport>
+      reports_;
 };
 
 }  // namespace monitor
@@ -18,7 +18,6 @@
 
 #include "cyber/common/log.h"
 #include "gflags/gflags.h"
-#include "modules/common/util/file.h"
 #include "modules/common/util/map_util.h"
 #include "modules/monitor/common/monitor_manager.h"
 #include "modules/monitor/software/summary_monitor.h"
@@ -38,21 +37,10 @@ ProcessMonitor::ProcessMonitor()
 }
 
 void ProcessMonitor::RunOnce(const double current_time) {
-  // Get running processes.
-  std::vector<std::string> running_processes;
-  for (const auto& cmd_file : apollo::common::util::Glob("/proc/*/cmdline")) {
-    // Get process command string.
-    std::string cmd_string;
-    if (apollo::common::util::GetContent(cmd_file, &cmd_string) &&
-        !cmd_string.empty()) {
-      // In /proc/<PID>/cmdline, the parts are seperated with \0, which will be
-      // converted back to whitespaces here.
-      std::replace(cmd_string.begin(), cmd_string.end(), '\0', ' ');
-      running_processes.push_back(cmd_string);
-    }
-  }
-
   auto manager = MonitorManager::Instance();
+  // Get running processes.
+  auto* running_processes = manager->GetProcessTable();
+  running_processes->Refresh(current_time);
   const auto& mode = manager->GetHMIMode();
 
   // Check HMI modules.
@@ -60,7 +48,7 @@ void ProcessMonitor::RunOnce(const double current_time) {
   for (const auto& iter : mode.modules()) {
     const std::string& module_name = iter.first;
     const auto& config = iter.second.process_monitor_config();
-    UpdateStatus(running_processes, config, &hmi_modules->at(module_name));
+    UpdateStatus(*running_processes, config, &hmi_modules->at(module_name));
   }
 
   // Check monitored components.
@@ -71,29 +59,22 @@ void ProcessMonitor::RunOnce(const double current_time) {
         apollo::common::util::ContainsKey(*components, name)) {
       const auto& config = iter.second.process();
       auto* status = components->at(name).mutable_process_status();
-      UpdateStatus(running_processes, config, status);
+      UpdateStatus(*running_processes, config, status);
     }
   }
 }
 
 void ProcessMonitor::UpdateStatus(
-    const std::vector<std::string>& running_processes,
+    const ProcessTable& running_processes,
     const apollo::dreamview::ProcessMonitorConfig& config,
     ComponentStatus* status) {
   status->clear_status();
-  for (const std::string& command : running_processes) {
-    bool all_keywords_matched = true;
-    for (const std::string& keyword : config.command_keywords()) {
-      if (command.find(keyword) == std::string::npos) {
-        all_keywords_matched = false;
-        break;
-      }
-    }
-    if (all_keywords_matched) {
-      // Process command keywords are all matched. The process is running.
-      SummaryMonitor::EscalateStatus(ComponentStatus::OK, command, status);
-      return;
-    }
+  const auto* process = running_processes.Find(config.command_keywords());
+  if (process != nullptr) {
+    // Process command keywords are all matched. The process is running.
+    SummaryMonitor::EscalateStatus(ComponentStatus::OK, process->command,
+                                   status);
+    return;
   }
   SummaryMonitor::EscalateStatus(ComponentStatus::FATAL, "", status);
 }
@@ -15,10 +15,8 @@
  *****************************************************************************/
 #pragma once
 
-#include <string>
-#include <vector>
-
 #include "modules/dreamview/proto/hmi_mode.pb.h"
+#include "modules/monitor/common/process_table.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/system_status.pb.h"
 
@@ -32,7 +30,7 @@ class ProcessMonitor : public RecurrentRunner {
 
  private:
   static void UpdateStatus(
-      const std::vector<std::string>& running_processes,
+      const ProcessTable& running_processes,
       const apollo::dreamview::ProcessMonitorConfig& config,
       ComponentStatus* status);
 };
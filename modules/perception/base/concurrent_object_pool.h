@@ -15,22 +15,31 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 #include "modules/perception/base/object_pool.h"
 
+// The pool is opt-in, build with -DPERCEPTION_BASE_ENABLE_POOL to recycle the
+// objects across frames instead of allocating them on every Get.
+#ifndef PERCEPTION_BASE_ENABLE_POOL
 #define PERCEPTION_BASE_DISABLE_POOL
+#endif
+
 namespace apollo {
 namespace perception {
 namespace base {
 
 static const size_t kPoolDefaultExtendNum = 10;
 static const size_t kPoolDefaultSize = 100;
+// objects cached by every thread, and moved at once from or to the shared list
+static const size_t kPoolThreadCacheSize = 32;
+static const size_t kPoolThreadCacheBatch = kPoolThreadCacheSize / 2;
 
 // @brief default initializer used in concurrent object pool
 template <class T>
@@ -38,6 +47,9 @@ struct ObjectPoolDefaultInitializer {
   void operator()(T* t) const {}
 };
 // @brief concurrent object pool with dynamic size
+// The free objects are kept in a lock-free stack shared by all threads, with a
+// small cache in front of it for every thread, so Get and release mostly touch
+// thread local memory. Only extending the pool takes a lock.
 template <class ObjectType, size_t N = kPoolDefaultSize,
           class Initializer = ObjectPoolDefaultInitializer<ObjectType>>
 class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
@@ -45,30 +57,19 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   // using ObjectTypePtr = typename BaseObjectPool<ObjectType>::ObjectTypePtr;
   using BaseObjectPool<ObjectType>::capacity_;
   // @brief Only allow accessing from global instance
+  // The instance is never destroyed, so objects released by other static
+  // objects at exit still find their pool.
   static ConcurrentObjectPool& Instance() {
-    static ConcurrentObjectPool pool(N);
-    return pool;
+    static ConcurrentObjectPool* pool = new ConcurrentObjectPool(N);
+    return *pool;
   }
   // @brief overrided function to get object smart pointer
   std::shared_ptr<ObjectType> Get() override {
 // TODO(All): remove conditional build
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    ObjectType* ptr = nullptr;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        Add(1 + kPoolDefaultExtendNum);
-      }
-      ptr = queue_.front();
-      queue_.pop();
-    }
-    // For efficiency consideration, intialization should be invoked
-    // after releasing the mutex
-    kInitializer(ptr);
-    return std::shared_ptr<ObjectType>(ptr, [&](ObjectType* obj_ptr) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(obj_ptr);
-    });
+    Node* node = Acquire();
+    kInitializer(&node->object);
+    return Wrap(node);
 #else
     return std::shared_ptr<ObjectType>(new ObjectType);
 #endif
@@ -79,26 +80,10 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num,
                 std::vector<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, intialization should be invoked
-    // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      data->emplace_back(
-          std::shared_ptr<ObjectType>(buffer[i], [&](ObjectType* obj_ptr) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(obj_ptr);
-          }));
+      Node* node = Acquire();
+      kInitializer(&node->object);
+      data->emplace_back(Wrap(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -113,33 +98,11 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::list<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, intialization should be invoked
-    // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front
-          ? data->emplace_front(std::shared_ptr<ObjectType>(
-                buffer[i],
-                [&](ObjectType* obj_ptr) {
-                  std::lock_guard<std::mutex> lock(mutex_);
-                  queue_.push(obj_ptr);
-                }))
-          : data->emplace_back(std::shared_ptr<ObjectType>(
-                buffer[i], [&](ObjectType* obj_ptr) {
-                  std::lock_guard<std::mutex> lock(mutex_);
-                  queue_.push(obj_ptr);
-                }));
+      Node* node = Acquire();
+      kInitializer(&node->object);
+      is_front ? data->emplace_front(Wrap(node))
+               : data->emplace_back(Wrap(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -156,31 +119,11 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::deque<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front
-          ? data->emplace_front(std::shared_ptr<ObjectType>(
-                buffer[i],
-                [&](ObjectType* obj_ptr) {
-                  std::lock_guard<std::mutex> lock(mutex_);
-                  queue_.push(obj_ptr);
-                }))
-          : data->emplace_back(std::shared_ptr<ObjectType>(
-                buffer[i], [&](ObjectType* obj_ptr) {
-                  std::lock_guard<std::mutex> lock(mutex_);
-                  queue_.push(obj_ptr);
-                }));
+      Node* node = Acquire();
+      kInitializer(&node->object);
+      is_front ? data->emplace_front(Wrap(node))
+               : data->emplace_back(Wrap(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -193,13 +136,16 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
   // @brief overrided function to set capacity
   void set_capacity(size_t capacity) override {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(extend_mutex_);
     if (capacity_ < capacity) {
       Add(capacity - capacity_);
     }
   }
-  // @brief get remained object number
-  size_t RemainedNum() override { return queue_.size(); }
+  // @brief get remained object number, the objects cached by the threads
+  // included
+  size_t RemainedNum() override {
+    return num_free_.load(std::memory_order_relaxed);
+  }
 #endif
   // @brief destructor to release the cached memory
   ~ConcurrentObjectPool() override {
@@ -208,44 +154,176 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
       cache_ = nullptr;
     }
     for (auto& ptr : extended_cache_) {
-      delete ptr;
+      delete[] ptr;
     }
     extended_cache_.clear();
   }
 
  protected:
-// @brief add num objects, should add lock before invoke this function
+  struct Node {
+    ObjectType object;
+    Node* next = nullptr;
+  };
+
+  // the count is bumped on every change, so a node popped and pushed back
+  // in between does not fool the compare-and-swap (the aba problem)
+  struct alignas(2 * sizeof(Node*)) Head {
+    uintptr_t count;
+    Node* node;
+  };
+
 #ifndef PERCEPTION_BASE_DISABLE_POOL
+  struct ThreadCache {
+    ~ThreadCache() {
+      if (pool != nullptr && size > 0) {
+        pool->Push(nodes, size);
+      }
+      size = 0;
+      closed = true;
+    }
+    ConcurrentObjectPool* pool = nullptr;
+    Node* nodes[kPoolThreadCacheSize];
+    size_t size = 0;
+    bool closed = false;
+  };
+
+  ThreadCache& LocalCache() {
+    static thread_local ThreadCache cache;
+    cache.pool = this;
+    return cache;
+  }
+
+  std::shared_ptr<ObjectType> Wrap(Node* node) {
+    return std::shared_ptr<ObjectType>(
+        &node->object, [this, node](ObjectType*) { Release(node); });
+  }
+
+  Node* Acquire() {
+    ThreadCache& cache = LocalCache();
+    if (cache.closed) {
+      // only objects taken while the thread exits end up here
+      Node* node = nullptr;
+      while ((node = Pop()) == nullptr) {
+        Extend();
+      }
+      num_free_.fetch_sub(1, std::memory_order_relaxed);
+      return node;
+    }
+    while (cache.size == 0) {
+      for (Node* node = Pop(); node != nullptr; node = Pop()) {
+        cache.nodes[cache.size++] = node;
+        if (cache.size == kPoolThreadCacheBatch) {
+          break;
+        }
+      }
+      if (cache.size == 0) {
+        Extend();
+      }
+    }
+    num_free_.fetch_sub(1, std::memory_order_relaxed);
+    return cache.nodes[--cache.size];
+  }
+
+  void Release(Node* node) {
+    num_free_.fetch_add(1, std::memory_order_relaxed);
+    ThreadCache& cache = LocalCache();
+    if (cache.closed) {
+      Push(&node, 1);
+      return;
+    }
+    if (cache.size == kPoolThreadCacheSize) {
+      // hand a batch over to the other threads
+      cache.size -= kPoolThreadCacheBatch;
+      Push(cache.nodes + cache.size, kPoolThreadCacheBatch);
+    }
+    cache.nodes[cache.size++] = node;
+  }
+
+  // @brief pops one node of the shared stack, nullptr if it is empty
+  Node* Pop() {
+    Head old_head = free_head_.load(std::memory_order_acquire);
+    Head new_head;
+    do {
+      if (old_head.node == nullptr) {
+        return nullptr;
+      }
+      new_head.node = old_head.node->next;
+      new_head.count = old_head.count + 1;
+    } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+    return old_head.node;
+  }
+
+  // @brief pushes num nodes onto the shared stack with a single swap
+  void Push(Node* const* nodes, size_t num) {
+    for (size_t i = 0; i + 1 < num; ++i) {
+      nodes[i]->next = nodes[i + 1];
+    }
+    Node* last = nodes[num - 1];
+    Head old_head = free_head_.load(std::memory_order_acquire);
+    Head new_head;
+    do {
+      last->next = old_head.node;
+      new_head.node = nodes[0];
+      new_head.count = old_head.count + 1;
+    } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+  }
+
+  void Extend() {
+    std::lock_guard<std::mutex> lock(extend_mutex_);
+    Add(1 + kPoolDefaultExtendNum);
+  }
+
+  // @brief add num objects, should add lock before invoke this function
   void Add(size_t num) {
+    Node* nodes = new Node[num];
+    extended_cache_.push_back(nodes);
+    AddNodes(nodes, num);
+  }
+
+  void AddNodes(Node* nodes, size_t num) {
+    if (num == 0) {
+      return;
+    }
+    std::vector<Node*> buffer(num);
     for (size_t i = 0; i < num; ++i) {
-      ObjectType* ptr = new ObjectType;
-      extended_cache_.push_back(ptr);
-      queue_.push(ptr);
+      buffer[i] = &nodes[i];
     }
-    capacity_ = kDefaultCacheSize + extended_cache_.size();
+    Push(buffer.data(), num);
+    capacity_ += num;
+    num_free_.fetch_add(num, std::memory_order_relaxed);
   }
 #endif
+
   // @brief default constructor
   explicit ConcurrentObjectPool(const size_t default_size)
       : kDefaultCacheSize(default_size) {
+    free_head_.store({0, nullptr}, std::memory_order_relaxed);
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    cache_ = new ObjectType[kDefaultCacheSize];
-    for (size_t i = 0; i < kDefaultCacheSize; ++i) {
-      queue_.push(&cache_[i]);
-    }
-    capacity_ = kDefaultCacheSize;
+    cache_ = new Node[kDefaultCacheSize];
+    AddNodes(cache_, kDefaultCacheSize);
 #endif
   }
-  std::mutex mutex_;
-  std::queue<ObjectType*> queue_;
+  std::atomic<Head> free_head_;
+  std::atomic<size_t> num_free_ = {0};
+  // @brief guards extending the pool
+  std::mutex extend_mutex_;
   // @brief point to a continuous memory of default pool size
-  ObjectType* cache_ = nullptr;
+  Node* cache_ = nullptr;
   const size_t kDefaultCacheSize;
   // @brief list to store extended memory, not as efficient
-  std::list<ObjectType*> extended_cache_;
+  std::list<Node*> extended_cache_;
   static const Initializer kInitializer;
 };
 
+template <class ObjectType, size_t N, class Initializer>
+const Initializer
+    ConcurrentObjectPool<ObjectType, N, Initializer>::kInitializer =
+        Initializer();
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
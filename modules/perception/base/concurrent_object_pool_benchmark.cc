@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "modules/perception/base/concurrent_object_pool.h"
+#include "modules/perception/base/object.h"
+#include "modules/perception/base/object_pool_types.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+// objects taken at once, like the detections of one frame
+constexpr size_t kBatchSize = 16;
+
+// the pool as it was before, a queue guarded by a single mutex
+class MutexObjectPool {
+ public:
+  static MutexObjectPool& Instance() {
+    static MutexObjectPool* pool = new MutexObjectPool(1024);
+    return *pool;
+  }
+
+  void BatchGet(size_t num, std::vector<std::shared_ptr<Object>>* data) {
+    std::vector<Object*> buffer(num, nullptr);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < num; ++i) {
+        if (queue_.empty()) {
+          objects_.emplace_back(new Object);
+          queue_.push(objects_.back().get());
+        }
+        buffer[i] = queue_.front();
+        queue_.pop();
+      }
+    }
+    for (size_t i = 0; i < num; ++i) {
+      buffer[i]->Reset();
+      data->emplace_back(buffer[i], [this](Object* object) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(object);
+      });
+    }
+  }
+
+ private:
+  explicit MutexObjectPool(size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      objects_.emplace_back(new Object);
+      queue_.push(objects_.back().get());
+    }
+  }
+
+  std::mutex mutex_;
+  std::queue<Object*> queue_;
+  std::vector<std::unique_ptr<Object>> objects_;
+};
+
+typedef ConcurrentObjectPool<Object, 1024, ObjectInitializer> LockFreePool;
+
+template <class Pool>
+void BatchGetAndRelease(benchmark::State& state) {  // NOLINT
+  auto& pool = Pool::Instance();
+  std::vector<std::shared_ptr<Object>> objects;
+  objects.reserve(kBatchSize);
+  for (auto _ : state) {
+    pool.BatchGet(kBatchSize, &objects);
+    benchmark::DoNotOptimize(objects.data());
+    objects.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+}  // namespace
+
+void BM_MutexPool(benchmark::State& state) {  // NOLINT
+  BatchGetAndRelease<MutexObjectPool>(state);
+}
+BENCHMARK(BM_MutexPool)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_LockFreePool(benchmark::State& state) {  // NOLINT
+  BatchGetAndRelease<LockFreePool>(state);
+}
+BENCHMARK(BM_LockFreePool)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
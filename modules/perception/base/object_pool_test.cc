@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/base/object_pool.h"
 
+#include <thread>
+
 #include "modules/perception/base/light_object_pool.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -216,6 +218,56 @@ TEST(ObjectPoolTest, concurrent_object_pool_constructor_test) {
 }
 #endif
 
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+TEST(ObjectPoolTest, concurrent_object_pool_recycle_test) {
+  typedef ConcurrentObjectPool<Object, 1, ObjectInitializer> TestObjectPool;
+  Object* raw_ptr = nullptr;
+  {
+    std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
+    ptr->id = 3;
+    ptr->polygon.resize(100);
+    raw_ptr = ptr.get();
+    EXPECT_EQ(TestObjectPool::Instance().RemainedNum(), 0);
+  }
+  EXPECT_EQ(TestObjectPool::Instance().RemainedNum(), 1);
+  // the released object is handed out again, reset but with its memory kept
+  std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
+  EXPECT_EQ(ptr.get(), raw_ptr);
+  EXPECT_EQ(ptr->id, -1);
+  EXPECT_TRUE(ptr->polygon.empty());
+  EXPECT_GE(ptr->polygon.points().capacity(), 100);
+}
+#endif
+
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+TEST(ObjectPoolTest, concurrent_object_pool_multi_thread_test) {
+  typedef ConcurrentObjectPool<Object, 8, ObjectInitializer> TestObjectPool;
+  auto& pool = TestObjectPool::Instance();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&pool, t]() {
+      std::vector<std::shared_ptr<Object>> objects;
+      for (int i = 0; i < 1000; ++i) {
+        const size_t kept = objects.size();
+        pool.BatchGet(i % 7, &objects);
+        objects.push_back(pool.Get());
+        for (size_t j = kept; j < objects.size(); ++j) {
+          EXPECT_EQ(objects[j]->id, -1);
+          objects[j]->id = t;
+        }
+        // keep some of the objects, so they are released by later rounds
+        objects.resize(i % 3);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // the objects cached by the finished threads are back in the pool
+  EXPECT_EQ(pool.RemainedNum(), pool.get_capacity());
+}
+#endif
+
 struct TestObjectPoolInitializer {
   void operator()(Object* t) const { t->id = 1; }
 };
@@ -253,7 +305,9 @@ TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
   }
 #endif
   {
-    typedef ConcurrentObjectPool<Object> TestObjectPool;
+    // a pool of its own, recycled objects are not reset by the default
+    // initializer
+    typedef ConcurrentObjectPool<Object, 20> TestObjectPool;
     std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
     EXPECT_EQ(ptr->id, -1);
     {
@@ -0,0 +1,347 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "Eigen/StdVector"
+
+#include "modules/perception/base/point.h"
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+template <typename T>
+using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+// @brief Point cloud storing every field in its own aligned array, so stages
+// touching a few fields only stream those and their loops vectorize
+template <typename T>
+class SoaPointCloud {
+ public:
+  using Type = T;
+  // @brief default constructor
+  SoaPointCloud() = default;
+  // @brief construct from input point cloud and specified indices
+  SoaPointCloud(const SoaPointCloud<T>& pc, const PointIndices& indices) {
+    CopyPointCloud(pc, indices.indices);
+  }
+  SoaPointCloud(const SoaPointCloud<T>& pc, const std::vector<int>& indices) {
+    CopyPointCloud(pc, indices);
+  }
+  // @brief destructor
+  virtual ~SoaPointCloud() = default;
+
+  // @brief accessor of point size
+  inline size_t size() const { return x_.size(); }
+  // @brief whether the cloud has no point
+  inline bool empty() const { return x_.empty(); }
+  // @brief reserve all the fields
+  inline void reserve(const size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    points_timestamp_.reserve(size);
+    points_height_.reserve(size);
+    points_beam_id_.reserve(size);
+    points_label_.reserve(size);
+  }
+  // @brief resize all the fields, new points get the default attributes
+  inline void resize(const size_t size) {
+    x_.resize(size, 0);
+    y_.resize(size, 0);
+    z_.resize(size, 0);
+    intensity_.resize(size, 0);
+    points_timestamp_.resize(size, 0.0);
+    points_height_.resize(size, std::numeric_limits<float>::max());
+    points_beam_id_.resize(size, -1);
+    points_label_.resize(size, 0);
+  }
+  // @brief clear all the fields
+  inline void clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+    points_timestamp_.clear();
+    points_height_.clear();
+    points_beam_id_.clear();
+    points_label_.clear();
+  }
+  // @brief append a point with its attributes
+  template <typename PointT>
+  inline void push_back(const PointT& point, double timestamp = 0.0,
+                        float height = std::numeric_limits<float>::max(),
+                        int32_t beam_id = -1, uint8_t label = 0) {
+    x_.push_back(static_cast<T>(point.x));
+    y_.push_back(static_cast<T>(point.y));
+    z_.push_back(static_cast<T>(point.z));
+    intensity_.push_back(static_cast<T>(point.intensity));
+    points_timestamp_.push_back(timestamp);
+    points_height_.push_back(height);
+    points_beam_id_.push_back(beam_id);
+    points_label_.push_back(label);
+  }
+  // @brief gather a point as the array of structures type
+  template <typename PointT = Point<T>>
+  inline PointT GetPoint(const size_t i) const {
+    PointT point;
+    point.x = static_cast<typename PointT::Type>(x_[i]);
+    point.y = static_cast<typename PointT::Type>(y_[i]);
+    point.z = static_cast<typename PointT::Type>(z_[i]);
+    point.intensity = static_cast<typename PointT::Type>(intensity_[i]);
+    return point;
+  }
+  // @brief scatter a point of the array of structures type
+  template <typename PointT>
+  inline void SetPoint(const size_t i, const PointT& point) {
+    x_[i] = static_cast<T>(point.x);
+    y_[i] = static_cast<T>(point.y);
+    z_[i] = static_cast<T>(point.z);
+    intensity_[i] = static_cast<T>(point.intensity);
+  }
+  // @brief copy the points of the indices from another cloud
+  template <typename IndexType>
+  inline void CopyPointCloud(const SoaPointCloud<T>& rhs,
+                             const std::vector<IndexType>& indices) {
+    resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      x_[i] = rhs.x_[indices[i]];
+      y_[i] = rhs.y_[indices[i]];
+      z_[i] = rhs.z_[indices[i]];
+      intensity_[i] = rhs.intensity_[indices[i]];
+      points_timestamp_[i] = rhs.points_timestamp_[indices[i]];
+      points_height_[i] = rhs.points_height_[indices[i]];
+      points_beam_id_[i] = rhs.points_beam_id_[indices[i]];
+      points_label_[i] = rhs.points_label_[indices[i]];
+    }
+    sensor_to_world_pose_ = rhs.sensor_to_world_pose_;
+    timestamp_ = rhs.timestamp_;
+  }
+
+  // @brief adapters from and to the array of structures clouds, the
+  // attributes of a plain PointCloud are left at their defaults
+  template <typename PointT>
+  void FromPointCloud(const PointCloud<PointT>& cloud) {
+    clear();
+    reserve(cloud.size());
+    for (const auto& point : cloud) {
+      push_back(point);
+    }
+    sensor_to_world_pose_ =
+        const_cast<PointCloud<PointT>&>(cloud).sensor_to_world_pose();
+    timestamp_ = const_cast<PointCloud<PointT>&>(cloud).get_timestamp();
+  }
+  template <typename PointT>
+  void FromPointCloud(const AttributePointCloud<PointT>& cloud) {
+    FromPointCloud(static_cast<const PointCloud<PointT>&>(cloud));
+    points_timestamp_ = cloud.points_timestamp();
+    points_height_.assign(cloud.points_height().begin(),
+                          cloud.points_height().end());
+    points_beam_id_ = cloud.points_beam_id();
+    points_label_ = cloud.points_label();
+  }
+  template <typename PointT>
+  void ToPointCloud(PointCloud<PointT>* cloud) const {
+    cloud->clear();
+    cloud->reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      cloud->push_back(GetPoint<PointT>(i));
+    }
+    cloud->set_sensor_to_world_pose(sensor_to_world_pose_);
+    cloud->set_timestamp(timestamp_);
+  }
+  template <typename PointT>
+  void ToPointCloud(AttributePointCloud<PointT>* cloud) const {
+    cloud->clear();
+    cloud->reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      cloud->push_back(GetPoint<PointT>(i), points_timestamp_[i],
+                       points_height_[i], points_beam_id_[i],
+                       points_label_[i]);
+    }
+    cloud->set_sensor_to_world_pose(sensor_to_world_pose_);
+    cloud->set_timestamp(timestamp_);
+  }
+
+  // @brief transform the point cloud, set the pose to identity
+  void TransformPointCloud(bool check_nan = false) {
+    const Eigen::Matrix3d rotation = sensor_to_world_pose_.linear();
+    const Eigen::Vector3d translation = sensor_to_world_pose_.translation();
+    T* x = x_.data();
+    T* y = y_.data();
+    T* z = z_.data();
+    const size_t n = size();
+    // the loop without the nan check has no branch and vectorizes
+    if (check_nan) {
+      for (size_t i = 0; i < n; ++i) {
+        if (!std::isnan(x[i]) && !std::isnan(y[i]) && !std::isnan(z[i])) {
+          TransformPoint(rotation, translation, &x[i], &y[i], &z[i]);
+        }
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        TransformPoint(rotation, translation, &x[i], &y[i], &z[i]);
+      }
+    }
+    sensor_to_world_pose_.setIdentity();
+  }
+  // @brief check data member consistency
+  bool CheckConsistency() const {
+    const size_t n = x_.size();
+    return y_.size() == n && z_.size() == n && intensity_.size() == n &&
+           points_timestamp_.size() == n && points_height_.size() == n &&
+           points_beam_id_.size() == n && points_label_.size() == n;
+  }
+
+  // @brief field accessors
+  const AlignedVector<T>& points_x() const { return x_; }
+  AlignedVector<T>* mutable_points_x() { return &x_; }
+  const AlignedVector<T>& points_y() const { return y_; }
+  AlignedVector<T>* mutable_points_y() { return &y_; }
+  const AlignedVector<T>& points_z() const { return z_; }
+  AlignedVector<T>* mutable_points_z() { return &z_; }
+  const AlignedVector<T>& points_intensity() const { return intensity_; }
+  AlignedVector<T>* mutable_points_intensity() { return &intensity_; }
+  const std::vector<double>& points_timestamp() const {
+    return points_timestamp_;
+  }
+  std::vector<double>* mutable_points_timestamp() { return &points_timestamp_; }
+  const AlignedVector<float>& points_height() const { return points_height_; }
+  AlignedVector<float>* mutable_points_height() { return &points_height_; }
+  const std::vector<int32_t>& points_beam_id() const { return points_beam_id_; }
+  std::vector<int32_t>* mutable_points_beam_id() { return &points_beam_id_; }
+  const std::vector<uint8_t>& points_label() const { return points_label_; }
+  std::vector<uint8_t>* mutable_points_label() { return &points_label_; }
+
+  // @brief cloud timestamp setter
+  void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
+  // @brief cloud timestamp getter
+  double get_timestamp() const { return timestamp_; }
+  // @brief sensor to world pose setter
+  void set_sensor_to_world_pose(const Eigen::Affine3d& sensor_to_world_pose) {
+    sensor_to_world_pose_ = sensor_to_world_pose;
+  }
+  // @brief sensor to world pose getter
+  const Eigen::Affine3d& sensor_to_world_pose() const {
+    return sensor_to_world_pose_;
+  }
+
+ protected:
+  static inline void TransformPoint(const Eigen::Matrix3d& rotation,
+                                    const Eigen::Vector3d& translation, T* x,
+                                    T* y, T* z) {
+    const double px = *x;
+    const double py = *y;
+    const double pz = *z;
+    *x = static_cast<T>(rotation(0, 0) * px + rotation(0, 1) * py +
+                        rotation(0, 2) * pz + translation(0));
+    *y = static_cast<T>(rotation(1, 0) * px + rotation(1, 1) * py +
+                        rotation(1, 2) * pz + translation(1));
+    *z = static_cast<T>(rotation(2, 0) * px + rotation(2, 1) * py +
+                        rotation(2, 2) * pz + translation(2));
+  }
+
+ protected:
+  AlignedVector<T> x_;
+  AlignedVector<T> y_;
+  AlignedVector<T> z_;
+  AlignedVector<T> intensity_;
+  std::vector<double> points_timestamp_;
+  AlignedVector<float> points_height_;
+  std::vector<int32_t> points_beam_id_;
+  std::vector<uint8_t> points_label_;
+
+  Eigen::Affine3d sensor_to_world_pose_ = Eigen::Affine3d::Identity();
+  double timestamp_ = 0.0;
+};
+
+// @brief Subset of a SoaPointCloud given by indices, the points are read from
+// the cloud without copying, the cloud and the indices must outlive the view
+template <typename T>
+class SoaPointCloudView {
+ public:
+  SoaPointCloudView(const SoaPointCloud<T>& cloud,
+                    const std::vector<int>& indices)
+      : cloud_(&cloud), indices_(&indices) {}
+  SoaPointCloudView(const SoaPointCloud<T>& cloud,
+                    const PointIndices& indices)
+      : SoaPointCloudView(cloud, indices.indices) {}
+
+  // @brief build the indices of the points whose mask is set
+  static void MaskToIndices(const std::vector<uint8_t>& mask,
+                            std::vector<int>* indices) {
+    indices->clear();
+    for (size_t i = 0; i < mask.size(); ++i) {
+      if (mask[i]) {
+        indices->push_back(static_cast<int>(i));
+      }
+    }
+  }
+
+  inline size_t size() const { return indices_->size(); }
+  inline bool empty() const { return indices_->empty(); }
+  // @brief index of the i-th point of the view in the cloud
+  inline int index(const size_t i) const { return (*indices_)[i]; }
+
+  inline T x(const size_t i) const { return cloud_->points_x()[index(i)]; }
+  inline T y(const size_t i) const { return cloud_->points_y()[index(i)]; }
+  inline T z(const size_t i) const { return cloud_->points_z()[index(i)]; }
+  inline T intensity(const size_t i) const {
+    return cloud_->points_intensity()[index(i)];
+  }
+  inline double timestamp(const size_t i) const {
+    return cloud_->points_timestamp()[index(i)];
+  }
+  inline float height(const size_t i) const {
+    return cloud_->points_height()[index(i)];
+  }
+  inline int32_t beam_id(const size_t i) const {
+    return cloud_->points_beam_id()[index(i)];
+  }
+  inline uint8_t label(const size_t i) const {
+    return cloud_->points_label()[index(i)];
+  }
+  template <typename PointT = Point<T>>
+  inline PointT GetPoint(const size_t i) const {
+    return cloud_->template GetPoint<PointT>(index(i));
+  }
+
+  const SoaPointCloud<T>& cloud() const { return *cloud_; }
+  const std::vector<int>& indices() const { return *indices_; }
+
+ private:
+  const SoaPointCloud<T>* cloud_ = nullptr;
+  const std::vector<int>* indices_ = nullptr;
+};
+
+typedef SoaPointCloud<float> SoaPointFCloud;
+typedef SoaPointCloud<double> SoaPointDCloud;
+
+typedef std::shared_ptr<SoaPointFCloud> SoaPointFCloudPtr;
+typedef std::shared_ptr<const SoaPointFCloud> SoaPointFCloudConstPtr;
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
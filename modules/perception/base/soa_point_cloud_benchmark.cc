@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "modules/perception/base/point_cloud.h"
+#include "modules/perception/base/soa_point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+// one frame of a 128 beam lidar at 10hz
+constexpr int kNumBeams = 128;
+constexpr int kPointsPerBeam = 1800;
+
+// bev grid of the cnn segmentation feature generator
+constexpr float kRange = 60.f;
+constexpr int kGridSize = 672;
+
+void MakeFrame(PointFCloud* aos_cloud, SoaPointFCloud* soa_cloud) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> range(1.f, 120.f);
+  std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+  for (int beam = 0; beam < kNumBeams; ++beam) {
+    const float pitch =
+        static_cast<float>((-25.0 + 40.0 * beam / kNumBeams) * M_PI / 180.0);
+    for (int i = 0; i < kPointsPerBeam; ++i) {
+      const float yaw = static_cast<float>(2.0 * M_PI * i / kPointsPerBeam);
+      const float r = range(generator);
+      PointF point;
+      point.x = r * std::cos(pitch) * std::cos(yaw);
+      point.y = r * std::cos(pitch) * std::sin(yaw);
+      point.z = r * std::sin(pitch) + noise(generator);
+      point.intensity = static_cast<float>(i % 256);
+      aos_cloud->push_back(point, 0.0, point.z + 1.8f, beam, 0);
+    }
+  }
+  soa_cloud->FromPointCloud(*aos_cloud);
+}
+
+struct Frame {
+  Frame() { MakeFrame(&aos_cloud, &soa_cloud); }
+  PointFCloud aos_cloud;
+  SoaPointFCloud soa_cloud;
+};
+
+const Frame& GetFrame() {
+  static const Frame frame;
+  return frame;
+}
+
+int GridIndex(const float x, const float y) {
+  const int col = static_cast<int>((x + kRange) * kGridSize / (2.f * kRange));
+  const int row = static_cast<int>((y + kRange) * kGridSize / (2.f * kRange));
+  if (col < 0 || col >= kGridSize || row < 0 || row >= kGridSize) {
+    return -1;
+  }
+  return row * kGridSize + col;
+}
+
+}  // namespace
+
+// range filter of the roi stage, builds the mask of the points in range
+void BM_RangeMaskAos(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().aos_cloud;
+  std::vector<uint8_t> mask(cloud.size());
+  const float range2 = kRange * kRange;
+  for (auto _ : state) {
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      const auto& point = cloud[i];
+      mask[i] = point.x * point.x + point.y * point.y < range2;
+    }
+    benchmark::DoNotOptimize(mask.data());
+  }
+  state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+BENCHMARK(BM_RangeMaskAos);
+
+void BM_RangeMaskSoa(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().soa_cloud;
+  std::vector<uint8_t> mask(cloud.size());
+  const float range2 = kRange * kRange;
+  const float* x = cloud.points_x().data();
+  const float* y = cloud.points_y().data();
+  const size_t n = cloud.size();
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; ++i) {
+      mask[i] = x[i] * x[i] + y[i] * y[i] < range2;
+    }
+    benchmark::DoNotOptimize(mask.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RangeMaskSoa);
+
+// ground removal by the height above the ground plane
+void BM_HeightFilterAos(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().aos_cloud;
+  std::vector<int> indices;
+  indices.reserve(cloud.size());
+  for (auto _ : state) {
+    indices.clear();
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      if (cloud.points_height(i) > 0.25f) {
+        indices.push_back(static_cast<int>(i));
+      }
+    }
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+BENCHMARK(BM_HeightFilterAos);
+
+void BM_HeightFilterSoa(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().soa_cloud;
+  std::vector<int> indices;
+  indices.reserve(cloud.size());
+  const float* height = cloud.points_height().data();
+  const size_t n = cloud.size();
+  for (auto _ : state) {
+    indices.clear();
+    for (size_t i = 0; i < n; ++i) {
+      if (height[i] > 0.25f) {
+        indices.push_back(static_cast<int>(i));
+      }
+    }
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_HeightFilterSoa);
+
+// max height per bev cell as in the cnn segmentation feature generator
+void BM_MaxHeightAos(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().aos_cloud;
+  std::vector<float> max_height(kGridSize * kGridSize);
+  for (auto _ : state) {
+    std::fill(max_height.begin(), max_height.end(), -5.f);
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      const auto& point = cloud[i];
+      const int index = GridIndex(point.x, point.y);
+      if (index >= 0 && max_height[index] < point.z) {
+        max_height[index] = point.z;
+      }
+    }
+    benchmark::DoNotOptimize(max_height.data());
+  }
+  state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+BENCHMARK(BM_MaxHeightAos);
+
+void BM_MaxHeightSoa(benchmark::State& state) {  // NOLINT
+  const auto& cloud = GetFrame().soa_cloud;
+  std::vector<float> max_height(kGridSize * kGridSize);
+  const float* x = cloud.points_x().data();
+  const float* y = cloud.points_y().data();
+  const float* z = cloud.points_z().data();
+  const size_t n = cloud.size();
+  for (auto _ : state) {
+    std::fill(max_height.begin(), max_height.end(), -5.f);
+    for (size_t i = 0; i < n; ++i) {
+      const int index = GridIndex(x[i], y[i]);
+      if (index >= 0 && max_height[index] < z[i]) {
+        max_height[index] = z[i];
+      }
+    }
+    benchmark::DoNotOptimize(max_height.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_MaxHeightSoa);
+
+void BM_TransformAos(benchmark::State& state) {  // NOLINT
+  PointFCloud cloud = GetFrame().aos_cloud;
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.translation() = Eigen::Vector3d(1.0, 2.0, 0.0);
+  for (auto _ : state) {
+    cloud.set_sensor_to_world_pose(pose);
+    cloud.TransformPointCloud();
+    benchmark::DoNotOptimize(&cloud[0]);
+  }
+  state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+BENCHMARK(BM_TransformAos);
+
+void BM_TransformSoa(benchmark::State& state) {  // NOLINT
+  SoaPointFCloud cloud = GetFrame().soa_cloud;
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.translation() = Eigen::Vector3d(1.0, 2.0, 0.0);
+  for (auto _ : state) {
+    cloud.set_sensor_to_world_pose(pose);
+    cloud.TransformPointCloud();
+    benchmark::DoNotOptimize(cloud.points_x().data());
+  }
+  state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+BENCHMARK(BM_TransformSoa);
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
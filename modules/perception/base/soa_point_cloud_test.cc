@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/soa_point_cloud.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+TEST(SoaPointCloudTest, basic_test) {
+  SoaPointFCloud cloud;
+  EXPECT_TRUE(cloud.empty());
+  PointF point;
+  point.x = 1.f;
+  point.y = 2.f;
+  point.z = 3.f;
+  point.intensity = 4.f;
+  cloud.push_back(point, 0.5, 1.5f, 7, 2);
+  cloud.push_back(point);
+  EXPECT_EQ(cloud.size(), 2);
+  EXPECT_TRUE(cloud.CheckConsistency());
+  EXPECT_EQ(cloud.points_y()[0], 2.f);
+  EXPECT_EQ(cloud.points_timestamp()[0], 0.5);
+  EXPECT_EQ(cloud.points_height()[0], 1.5f);
+  EXPECT_EQ(cloud.points_beam_id()[0], 7);
+  EXPECT_EQ(cloud.points_label()[0], 2);
+  EXPECT_EQ(cloud.points_height()[1], std::numeric_limits<float>::max());
+  EXPECT_EQ(cloud.points_beam_id()[1], -1);
+
+  point.x = 10.f;
+  cloud.SetPoint(1, point);
+  EXPECT_EQ(cloud.GetPoint(1).x, 10.f);
+  EXPECT_EQ(cloud.GetPoint(1).intensity, 4.f);
+
+  cloud.resize(5);
+  EXPECT_EQ(cloud.size(), 5);
+  EXPECT_TRUE(cloud.CheckConsistency());
+  cloud.clear();
+  EXPECT_TRUE(cloud.empty());
+  EXPECT_TRUE(cloud.CheckConsistency());
+}
+
+TEST(SoaPointCloudTest, adapter_test) {
+  PointFCloud aos_cloud;
+  for (int i = 0; i < 4; ++i) {
+    PointF point;
+    point.x = static_cast<float>(i);
+    point.y = static_cast<float>(i) * 2.f;
+    point.z = static_cast<float>(i) * 3.f;
+    point.intensity = static_cast<float>(i) * 4.f;
+    aos_cloud.push_back(point, i * 0.1, static_cast<float>(i), i,
+                        static_cast<uint8_t>(i));
+  }
+  aos_cloud.set_timestamp(10.0);
+
+  SoaPointFCloud cloud;
+  cloud.FromPointCloud(aos_cloud);
+  EXPECT_EQ(cloud.size(), 4);
+  EXPECT_EQ(cloud.get_timestamp(), 10.0);
+  EXPECT_EQ(cloud.points_z()[3], 9.f);
+  EXPECT_EQ(cloud.points_intensity()[2], 8.f);
+  EXPECT_EQ(cloud.points_beam_id()[3], 3);
+
+  PointFCloud round_trip;
+  cloud.ToPointCloud(&round_trip);
+  EXPECT_EQ(round_trip.size(), 4);
+  EXPECT_EQ(round_trip.get_timestamp(), 10.0);
+  for (size_t i = 0; i < round_trip.size(); ++i) {
+    EXPECT_EQ(round_trip[i].x, aos_cloud[i].x);
+    EXPECT_EQ(round_trip[i].y, aos_cloud[i].y);
+    EXPECT_EQ(round_trip[i].z, aos_cloud[i].z);
+    EXPECT_EQ(round_trip[i].intensity, aos_cloud[i].intensity);
+    EXPECT_EQ(round_trip.points_timestamp()[i],
+              aos_cloud.points_timestamp()[i]);
+    EXPECT_EQ(round_trip.points_height()[i], aos_cloud.points_height()[i]);
+    EXPECT_EQ(round_trip.points_label()[i], aos_cloud.points_label()[i]);
+  }
+
+  PointCloud<PointD> plain_cloud;
+  cloud.ToPointCloud(&plain_cloud);
+  EXPECT_EQ(plain_cloud.size(), 4);
+  EXPECT_EQ(plain_cloud[1].y, 2.0);
+}
+
+TEST(SoaPointCloudTest, view_test) {
+  SoaPointFCloud cloud;
+  for (int i = 0; i < 6; ++i) {
+    PointF point;
+    point.x = static_cast<float>(i);
+    cloud.push_back(point, 0.0, static_cast<float>(i) * 0.5f);
+  }
+  const std::vector<uint8_t> mask = {0, 1, 0, 1, 1, 0};
+  std::vector<int> indices;
+  SoaPointCloudView<float>::MaskToIndices(mask, &indices);
+  ASSERT_EQ(indices.size(), 3);
+
+  SoaPointCloudView<float> view(cloud, indices);
+  EXPECT_EQ(view.size(), 3);
+  EXPECT_EQ(view.index(1), 3);
+  EXPECT_EQ(view.x(2), 4.f);
+  EXPECT_EQ(view.height(0), 0.5f);
+  EXPECT_EQ(view.GetPoint(1).x, 3.f);
+  // the view reads through to the cloud
+  (*cloud.mutable_points_x())[3] = 30.f;
+  EXPECT_EQ(view.x(1), 30.f);
+
+  SoaPointFCloud copy(cloud, indices);
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy.points_x()[1], 30.f);
+  EXPECT_EQ(copy.points_height()[2], 2.f);
+}
+
+TEST(SoaPointCloudTest, transform_test) {
+  SoaPointDCloud cloud;
+  PointD point;
+  point.x = 1.0;
+  cloud.push_back(point);
+  point.x = std::numeric_limits<double>::quiet_NaN();
+  cloud.push_back(point);
+
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.linear() =
+      Eigen::AngleAxisd(M_PI_2, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+  pose.translation() = Eigen::Vector3d(1.0, 2.0, 3.0);
+  cloud.set_sensor_to_world_pose(pose);
+  cloud.TransformPointCloud(true);
+  EXPECT_NEAR(cloud.points_x()[0], 1.0, 1e-9);
+  EXPECT_NEAR(cloud.points_y()[0], 3.0, 1e-9);
+  EXPECT_NEAR(cloud.points_z()[0], 3.0, 1e-9);
+  EXPECT_TRUE(std::isnan(cloud.points_x()[1]));
+  EXPECT_TRUE(cloud.sensor_to_world_pose().matrix().isIdentity());
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -15,9 +15,11 @@
 *****************************************************************************/
 #include "modules/perception/camera/app/obstacle_camera_perception.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/util/file.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/camera/app/debug_info.h"
@@ -282,11 +284,55 @@ bool ObstacleCameraPerception::Perception(
     const CameraPerceptionOptions &options, CameraFrame *frame) {
   PERCEPTION_PERF_FUNCTION();
   inference::CudaUtil::set_device_id(perception_param_.gpu_id());
-  ObstacleDetectorOptions detector_options;
-  ObstacleTransformerOptions transformer_options;
-  ObstaclePostprocessorOptions obstacle_postprocessor_options;
+  return Prepare(frame) && Detect(frame) && Track(frame);
+}
+
+bool ObstacleCameraPerception::Perception(
+    const CameraPerceptionOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  PERCEPTION_PERF_FUNCTION();
+  inference::CudaUtil::set_device_id(perception_param_.gpu_id());
+  // every camera has a detector of its own, so the cameras are detected in
+  // parallel, and frames of the same camera one after another
+  std::map<std::string, std::vector<CameraFrame *>> camera_frames;
+  for (auto *frame : frames) {
+    camera_frames[frame->data_provider->sensor_name()].push_back(frame);
+  }
+  std::vector<std::vector<CameraFrame *> *> cameras;
+  for (auto &camera : camera_frames) {
+    cameras.push_back(&camera.second);
+  }
+  std::vector<int> detected(cameras.size(), 1);
+  cyber::ParallelFor(0, cameras.size(), 1, [&](size_t i) {
+    inference::CudaUtil::set_device_id(perception_param_.gpu_id());
+    for (auto *frame : *cameras[i]) {
+      if (!Detect(frame)) {
+        detected[i] = 0;
+        return;
+      }
+    }
+  });
+  if (std::find(detected.begin(), detected.end(), 0) != detected.end()) {
+    return false;
+  }
+
+  // the calibration service and the tracker are shared by all cameras, they
+  // take the frames in the order of time
+  std::vector<CameraFrame *> sorted_frames(frames);
+  std::stable_sort(sorted_frames.begin(), sorted_frames.end(),
+                   [](const CameraFrame *lhs, const CameraFrame *rhs) {
+                     return lhs->timestamp < rhs->timestamp;
+                   });
+  for (auto *frame : sorted_frames) {
+    if (!Prepare(frame) || !Track(frame)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ObstacleCameraPerception::Prepare(CameraFrame *frame) {
   ObstacleTrackerOptions tracker_options;
-  FeatureExtractorOptions extractor_options;
   PERCEPTION_PERF_BLOCK_START();
   frame->camera_k_matrix = name_intrinsic_map_.at(
       frame->data_provider->sensor_name());
@@ -353,6 +399,12 @@ bool ObstacleCameraPerception::Perception(
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(
       frame->data_provider->sensor_name(), "Predict");
 
+  return true;
+}
+
+bool ObstacleCameraPerception::Detect(CameraFrame *frame) {
+  ObstacleDetectorOptions detector_options;
+  PERCEPTION_PERF_BLOCK_START();
   std::shared_ptr<BaseObstacleDetector> detector = name_detector_map_.at(
       frame->data_provider->sensor_name());
 
@@ -363,6 +415,15 @@ bool ObstacleCameraPerception::Perception(
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(
       frame->data_provider->sensor_name(), "detect");
 
+  return true;
+}
+
+bool ObstacleCameraPerception::Track(CameraFrame *frame) {
+  ObstacleTransformerOptions transformer_options;
+  ObstaclePostprocessorOptions obstacle_postprocessor_options;
+  ObstacleTrackerOptions tracker_options;
+  FeatureExtractorOptions extractor_options;
+  PERCEPTION_PERF_BLOCK_START();
   // save all detections results as kitti format
   WriteDetections(perception_param_.debug_param().has_detection_out_dir(),
                   perception_param_.debug_param().detection_out_dir()
@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/camera/app/perception.pb.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -68,11 +69,22 @@ class ObstacleCameraPerception : public BaseCameraPerception {
   bool GetCalibrationService(BaseCalibrationService** calibration_service);
   bool Perception(const CameraPerceptionOptions &options,
                   CameraFrame *frame) override;
+  // @brief: runs the frames of several cameras captured close in time, the
+  // detection of the cameras in parallel, the tracking of the frames in
+  // order of time
+  bool Perception(const CameraPerceptionOptions &options,
+                  const std::vector<CameraFrame *> &frames);
   std::string Name() const override {
     return "ObstacleCameraPerception";
   }
 
  private:
+  // lane detection, calibration and track prediction
+  bool Prepare(CameraFrame *frame);
+  bool Detect(CameraFrame *frame);
+  // feature extraction, association, 3d transform, postprocess and tracking
+  bool Track(CameraFrame *frame);
+
   std::map<std::string, Eigen::Matrix3f> name_intrinsic_map_;
   std::map<std::string,
     std::shared_ptr<BaseObstacleDetector>> name_detector_map_;
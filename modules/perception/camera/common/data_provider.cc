@@ -15,6 +15,7 @@
 *****************************************************************************/
 #include "modules/perception/camera/common/data_provider.h"
 #include "cyber/common/log.h"
+#include "modules/perception/camera/common/image_preprocess.h"
 
 namespace apollo {
 namespace perception {
@@ -25,6 +26,7 @@ bool DataProvider::Init(const DataProvider::InitOptions &options) {
   src_width_ = options.image_width;
   sensor_name_ = options.sensor_name;
   device_id_ = options.device_id;
+  fuse_preprocessing_ = options.fuse_preprocessing;
 
   if (cudaSetDevice(device_id_) != cudaSuccess) {
       AERROR << "Failed to set device to " << device_id_;
@@ -118,6 +120,7 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
   gray_ready_ = false;
   rgb_ready_ = false;
   bgr_ready_ = false;
+  undistortion_pending_ = false;
 
   bool success = false;
 
@@ -153,37 +156,58 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
       cudaMemcpy(ori_rgb_->mutable_gpu_data(), data,
                  ori_rgb_->rows() * ori_rgb_->width_step(),
                  cudaMemcpyDefault);
-      success = handler_->Handle(*ori_rgb_, rgb_.get());
+      if (fuse_preprocessing_) {
+        // undistorted on demand, or together with the resize
+        raw_color_ = base::Color::RGB;
+        undistortion_pending_ = true;
+        success = true;
+      } else {
+        success = handler_->Handle(*ori_rgb_, rgb_.get());
+      }
     } else {
       cudaMemcpy(rgb_->mutable_gpu_data(), data,
                  rgb_->rows() * rgb_->width_step(), cudaMemcpyDefault);
       success = true;
     }
-    rgb_ready_ = true;
+    rgb_ready_ = !undistortion_pending_;
   } else if (encoding == "bgr8") {
     if (handler_ != nullptr) {
       cudaMemcpy(ori_bgr_->mutable_gpu_data(), data,
                  ori_bgr_->rows() * ori_bgr_->width_step(),
                  cudaMemcpyDefault);
-      success = handler_->Handle(*ori_bgr_, bgr_.get());
+      if (fuse_preprocessing_) {
+        // undistorted on demand, or together with the resize
+        raw_color_ = base::Color::BGR;
+        undistortion_pending_ = true;
+        success = true;
+      } else {
+        success = handler_->Handle(*ori_bgr_, bgr_.get());
+      }
     } else {
       cudaMemcpy(bgr_->mutable_gpu_data(), data,
           bgr_->rows() * bgr_->width_step(), cudaMemcpyDefault);
       success = true;
     }
-    bgr_ready_ = true;
+    bgr_ready_ = !undistortion_pending_;
   } else if (encoding == "gray" || encoding == "y") {
     if (handler_ != nullptr) {
       cudaMemcpy(ori_gray_->mutable_gpu_data(), data,
                  ori_gray_->rows() * ori_gray_->width_step(),
                  cudaMemcpyDefault);
-      success = handler_->Handle(*ori_gray_, gray_.get());
+      if (fuse_preprocessing_) {
+        // undistorted on demand, or together with the resize
+        raw_color_ = base::Color::GRAY;
+        undistortion_pending_ = true;
+        success = true;
+      } else {
+        success = handler_->Handle(*ori_gray_, gray_.get());
+      }
     } else {
       cudaMemcpy(gray_->mutable_gpu_data(), data,
           gray_->rows() * gray_->width_step(), cudaMemcpyDefault);
       success = true;
     }
-    gray_ready_ = true;
+    gray_ready_ = !undistortion_pending_;
   } else {
     success = false;
     AERROR << "Unrecognized image encoding: " << encoding;
@@ -282,7 +306,110 @@ bool DataProvider::GetImage(const DataProvider::ImageOptions &options,
   return true;
 }
 
+bool DataProvider::GetResizedImageBlob(
+    const DataProvider::ImageOptions &options,
+    const DataProvider::BlobOptions &blob_options, base::Blob<float> *blob) {
+  if (blob == nullptr || blob->num_axes() != 4) {
+    AERROR << "A 4d blob is required.";
+    return false;
+  }
+  if (cudaSetDevice(device_id_) != cudaSuccess) {
+    AERROR << "Failed to set device to " << device_id_;
+    return false;
+  }
+
+  // sample the raw image if it is not undistorted yet, else any ready image,
+  // the color is converted on the way
+  const base::Image8U *src = nullptr;
+  base::Color src_color = base::Color::NONE;
+  auto select = [&](bool ready, const base::Image8U *image,
+                    base::Color color) {
+    if (src == nullptr && ready) {
+      src = image;
+      src_color = color;
+    }
+  };
+  if (undistortion_pending_) {
+    select(raw_color_ == base::Color::RGB, ori_rgb_.get(), base::Color::RGB);
+    select(raw_color_ == base::Color::BGR, ori_bgr_.get(), base::Color::BGR);
+    select(raw_color_ == base::Color::GRAY, ori_gray_.get(),
+           base::Color::GRAY);
+  } else {
+    select(bgr_ready_ && options.target_color == base::Color::BGR, bgr_.get(),
+           base::Color::BGR);
+    select(rgb_ready_ && options.target_color == base::Color::RGB, rgb_.get(),
+           base::Color::RGB);
+    select(bgr_ready_, bgr_.get(), base::Color::BGR);
+    select(rgb_ready_, rgb_.get(), base::Color::RGB);
+    select(gray_ready_, gray_.get(), base::Color::GRAY);
+  }
+  if (src == nullptr) {
+    AWARN << "No image data filled yet!";
+    return false;
+  }
+
+  const int height = blob_options.channel_axis ? blob->shape(1)
+                                               : blob->shape(2);
+  const int width = blob_options.channel_axis ? blob->shape(2)
+                                              : blob->shape(3);
+  const int channels = blob_options.channel_axis ? blob->shape(3)
+                                                 : blob->shape(1);
+  if (options.target_color == base::Color::NONE ||
+      channels != base::kChannelsMap.at(options.target_color)) {
+    AERROR << "The blob does not match the target color "
+           << static_cast<int>(options.target_color);
+    return false;
+  }
+  const base::RectI roi = options.do_crop
+                              ? options.crop_roi
+                              : base::RectI(0, 0, src_width_, src_height_);
+  if (resize_map_x_.count() == 0 || resize_map_roi_ != roi ||
+      resize_map_x_.shape(0) != height || resize_map_x_.shape(1) != width ||
+      resize_map_undistort_ != undistortion_pending_) {
+    const bool built =
+        undistortion_pending_
+            ? BuildResizeMap(roi, height, width, &handler_->map_x(),
+                             &handler_->map_y(), &resize_map_x_,
+                             &resize_map_y_)
+            : BuildResizeMap(roi, height, width, nullptr, nullptr,
+                             &resize_map_x_, &resize_map_y_);
+    if (!built) {
+      resize_map_x_.Reshape({0});
+      return false;
+    }
+    resize_map_roi_ = roi;
+    resize_map_undistort_ = undistortion_pending_;
+  }
+  return RemapNormalize(
+      *src, src_color, resize_map_x_, resize_map_y_, options.target_color,
+      blob_options.mean, blob_options.scale, blob_options.channel_axis,
+      blob->mutable_gpu_data() + blob->offset(blob_options.start_axis));
+}
+
+bool DataProvider::Undistort() {
+  if (!undistortion_pending_) {
+    return true;
+  }
+  undistortion_pending_ = false;
+  switch (raw_color_) {
+    case base::Color::RGB:
+      rgb_ready_ = handler_->Handle(*ori_rgb_, rgb_.get());
+      return rgb_ready_;
+    case base::Color::BGR:
+      bgr_ready_ = handler_->Handle(*ori_bgr_, bgr_.get());
+      return bgr_ready_;
+    case base::Color::GRAY:
+      gray_ready_ = handler_->Handle(*ori_gray_, gray_.get());
+      return gray_ready_;
+    default:
+      return false;
+  }
+}
+
 bool DataProvider::to_gray_image() {
+  if (!Undistort()) {
+    return false;
+  }
   if (!gray_ready_) {
     NppiSize roi;
     roi.height = src_height_;
@@ -312,6 +439,9 @@ bool DataProvider::to_gray_image() {
 }
 
 bool DataProvider::to_rgb_image() {
+  if (!Undistort()) {
+    return false;
+  }
   if (!rgb_ready_) {
     NppiSize roi;
     roi.height = src_height_;
@@ -341,6 +471,9 @@ bool DataProvider::to_rgb_image() {
 }
 
 bool DataProvider::to_bgr_image() {
+  if (!Undistort()) {
+    return false;
+  }
   if (!bgr_ready_) {
     NppiSize roi;
     roi.height = src_height_;
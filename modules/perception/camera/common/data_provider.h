@@ -33,12 +33,15 @@ class DataProvider {
  public:
   struct InitOptions {
     InitOptions() : image_height(0), image_width(0),
-                    device_id(-1), do_undistortion(false) {}
+                    device_id(-1), do_undistortion(false),
+                    fuse_preprocessing(false) {}
 
     int image_height;
     int image_width;
     int device_id;
     bool do_undistortion;
+    // undistort lazily, GetResizedImageBlob samples the raw image directly
+    bool fuse_preprocessing;
     std::string sensor_name;
   };
 
@@ -74,6 +77,16 @@ class DataProvider {
     base::RectI crop_roi;
   };
 
+  struct BlobOptions {
+    // of the blob channels, in the order of the target color
+    float mean[3] = {0.f, 0.f, 0.f};
+    float scale = 1.f;
+    // NHWC blob if true, NCHW otherwise
+    bool channel_axis = true;
+    // the image is written from the offset of this axis on
+    int start_axis = 0;
+  };
+
   DataProvider() = default;
   ~DataProvider() = default;
 
@@ -109,6 +122,17 @@ class DataProvider {
   // image blob with specified size should be filled, required.
   bool GetImage(const ImageOptions &options, base::Image8U *image);
 
+  // @brief: undistort, crop, resize, convert color and normalize the raw
+  // image straight into the float blob of a network, in a single pass.
+  // @param [in]: options, crop_roi in the undistorted image
+  // @param [in]: blob_options
+  // @param [in/out]: NHWC or NCHW blob, the height and width of its image
+  // are kept
+  bool GetResizedImageBlob(const ImageOptions &options,
+                           const BlobOptions &blob_options,
+                           base::Blob<float> *blob);
+
+  bool fuse_preprocessing() const { return fuse_preprocessing_; }
   int src_height() const { return src_height_; }
   int src_width() const { return src_width_; }
   const std::string &sensor_name() const { return sensor_name_; }
@@ -118,6 +142,8 @@ class DataProvider {
   bool to_bgr_image();
 
  protected:
+  bool Undistort();
+
   std::string sensor_name_;
   int src_height_ = 0;
   int src_width_ = 0;
@@ -133,6 +159,17 @@ class DataProvider {
   bool rgb_ready_ = false;
   bool bgr_ready_ = false;
 
+  // the raw image waits for undistortion, in raw_color_
+  bool undistortion_pending_ = false;
+  base::Color raw_color_ = base::Color::NONE;
+  bool fuse_preprocessing_ = false;
+  // source coordinates of the last GetResizedImageBlob, kept while the roi,
+  // the blob size and the source are unchanged
+  base::Blob<float> resize_map_x_;
+  base::Blob<float> resize_map_y_;
+  base::RectI resize_map_roi_;
+  bool resize_map_undistort_ = false;
+
   base::Blob<float> temp_float_;
   base::Blob<uint8_t> temp_uint8_;
   std::shared_ptr<UndistortionHandler> handler_ = nullptr;
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/camera/common/image_preprocess.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+namespace {
+
+constexpr int kThreadsX = 32;
+constexpr int kThreadsY = 8;
+
+int DivUp(int a, int b) { return (a + b - 1) / b; }
+
+__device__ float Bilinear(const float *map, int height, int width, float x,
+                          float y) {
+  x = fminf(fmaxf(x, 0.f), static_cast<float>(width - 1));
+  y = fminf(fmaxf(y, 0.f), static_cast<float>(height - 1));
+  const int x1 = min(__float2int_rd(x), width - 1);
+  const int y1 = min(__float2int_rd(y), height - 1);
+  const int x2 = min(x1 + 1, width - 1);
+  const int y2 = min(y1 + 1, height - 1);
+  const float dx = x - static_cast<float>(x1);
+  const float dy = y - static_cast<float>(y1);
+  return (map[y1 * width + x1] * (1.f - dx) + map[y1 * width + x2] * dx) *
+             (1.f - dy) +
+         (map[y2 * width + x1] * (1.f - dx) + map[y2 * width + x2] * dx) * dy;
+}
+
+__global__ void BuildResizeMapKernel(const float *map_x, const float *map_y,
+                                     int map_height, int map_width,
+                                     float roi_x, float roi_y, float fx,
+                                     float fy, int dst_height, int dst_width,
+                                     float *resize_map_x,
+                                     float *resize_map_y) {
+  const int x = blockDim.x * blockIdx.x + threadIdx.x;
+  const int y = blockDim.y * blockIdx.y + threadIdx.y;
+  if (x >= dst_width || y >= dst_height) {
+    return;
+  }
+  // the same pixel centers as inference::ResizeGPU
+  const float u = roi_x + (static_cast<float>(x) + 0.5f) * fx - 0.5f;
+  const float v = roi_y + (static_cast<float>(y) + 0.5f) * fy - 0.5f;
+  const int index = y * dst_width + x;
+  if (map_x == nullptr) {
+    resize_map_x[index] = u;
+    resize_map_y[index] = v;
+  } else {
+    // the undistortion maps are smooth, so interpolating them is close to
+    // resizing the undistorted image
+    resize_map_x[index] = Bilinear(map_x, map_height, map_width, u, v);
+    resize_map_y[index] = Bilinear(map_y, map_height, map_width, u, v);
+  }
+}
+
+// order: source channel of every dst channel, coeffs: gray weights of the
+// source channels
+__global__ void RemapNormalizeKernel(
+    const uint8_t *src, int src_step, int src_height, int src_width,
+    int src_channels, const float *resize_map_x, const float *resize_map_y,
+    int dst_height, int dst_width, int dst_channels, int3 order,
+    float3 coeffs, float3 mean, float scale, bool channel_axis, float *dst) {
+  const int x = blockDim.x * blockIdx.x + threadIdx.x;
+  const int y = blockDim.y * blockIdx.y + threadIdx.y;
+  if (x >= dst_width || y >= dst_height) {
+    return;
+  }
+  const int index = y * dst_width + x;
+  const float sx = resize_map_x[index];
+  const float sy = resize_map_y[index];
+  float value[3] = {0.f, 0.f, 0.f};
+  // pixels mapped outside of the source stay black, as with nppiRemap
+  if (sx > -1.f && sy > -1.f && sx < static_cast<float>(src_width) &&
+      sy < static_cast<float>(src_height)) {
+    const int x1 = __float2int_rd(sx);
+    const int y1 = __float2int_rd(sy);
+    const float dx = sx - static_cast<float>(x1);
+    const float dy = sy - static_cast<float>(y1);
+    const int x1_read = max(x1, 0);
+    const int y1_read = max(y1, 0);
+    const int x2_read = min(x1 + 1, src_width - 1);
+    const int y2_read = min(y1 + 1, src_height - 1);
+    const uint8_t *row1 = src + y1_read * src_step;
+    const uint8_t *row2 = src + y2_read * src_step;
+    for (int c = 0; c < src_channels; ++c) {
+      value[c] = (row1[x1_read * src_channels + c] * (1.f - dx) +
+                  row1[x2_read * src_channels + c] * dx) *
+                     (1.f - dy) +
+                 (row2[x1_read * src_channels + c] * (1.f - dx) +
+                  row2[x2_read * src_channels + c] * dx) *
+                     dy;
+    }
+    if (src_channels == 1) {
+      value[1] = value[0];
+      value[2] = value[0];
+    }
+  }
+
+  const float means[3] = {mean.x, mean.y, mean.z};
+  const int orders[3] = {order.x, order.y, order.z};
+  for (int c = 0; c < dst_channels; ++c) {
+    const float out =
+        dst_channels == 1
+            ? coeffs.x * value[0] + coeffs.y * value[1] + coeffs.z * value[2]
+            : value[orders[c]];
+    const int dst_index = channel_axis
+                              ? index * dst_channels + c
+                              : (c * dst_height + y) * dst_width + x;
+    dst[dst_index] = (fminf(fmaxf(out, 0.f), 255.f) - means[c]) * scale;
+  }
+}
+
+}  // namespace
+
+bool BuildResizeMap(const base::RectI &crop_roi, int dst_height, int dst_width,
+                    const base::Blob<float> *map_x,
+                    const base::Blob<float> *map_y,
+                    base::Blob<float> *resize_map_x,
+                    base::Blob<float> *resize_map_y) {
+  if (dst_height <= 0 || dst_width <= 0 || crop_roi.width <= 0 ||
+      crop_roi.height <= 0) {
+    AERROR << "Invalid resize from " << crop_roi.ToStr() << " to "
+           << dst_width << "x" << dst_height;
+    return false;
+  }
+  resize_map_x->Reshape({dst_height, dst_width});
+  resize_map_y->Reshape({dst_height, dst_width});
+  const float fx =
+      static_cast<float>(crop_roi.width) / static_cast<float>(dst_width);
+  const float fy =
+      static_cast<float>(crop_roi.height) / static_cast<float>(dst_height);
+  const bool undistort = map_x != nullptr && map_y != nullptr;
+  const dim3 block(kThreadsX, kThreadsY);
+  const dim3 grid(DivUp(dst_width, block.x), DivUp(dst_height, block.y));
+  BuildResizeMapKernel<<<grid, block>>>(
+      undistort ? map_x->gpu_data() : nullptr,
+      undistort ? map_y->gpu_data() : nullptr,
+      undistort ? map_x->shape(0) : 0, undistort ? map_x->shape(1) : 0,
+      static_cast<float>(crop_roi.x), static_cast<float>(crop_roi.y), fx, fy,
+      dst_height, dst_width, resize_map_x->mutable_gpu_data(),
+      resize_map_y->mutable_gpu_data());
+  return cudaGetLastError() == cudaSuccess;
+}
+
+bool RemapNormalize(const base::Image8U &src, base::Color src_color,
+                    const base::Blob<float> &resize_map_x,
+                    const base::Blob<float> &resize_map_y,
+                    base::Color dst_color, const float mean[3], float scale,
+                    bool channel_axis, float *dst) {
+  if (src_color == base::Color::NONE || dst_color == base::Color::NONE ||
+      src.channels() != base::kChannelsMap.at(src_color)) {
+    AERROR << "Unsupported color conversion from "
+           << static_cast<int>(src_color) << " to "
+           << static_cast<int>(dst_color);
+    return false;
+  }
+  // rgb and bgr only differ by the order of the channels
+  const bool swap = (src_color == base::Color::RGB &&
+                     dst_color == base::Color::BGR) ||
+                    (src_color == base::Color::BGR &&
+                     dst_color == base::Color::RGB);
+  const int3 order = swap ? make_int3(2, 1, 0) : make_int3(0, 1, 2);
+  const float3 coeffs = src_color == base::Color::RGB
+                            ? make_float3(0.299f, 0.587f, 0.114f)
+                            : make_float3(0.114f, 0.587f, 0.299f);
+  const int dst_height = resize_map_x.shape(0);
+  const int dst_width = resize_map_x.shape(1);
+  const dim3 block(kThreadsX, kThreadsY);
+  const dim3 grid(DivUp(dst_width, block.x), DivUp(dst_height, block.y));
+  RemapNormalizeKernel<<<grid, block>>>(
+      src.gpu_data(), src.width_step(), src.rows(), src.cols(),
+      src.channels(), resize_map_x.gpu_data(), resize_map_y.gpu_data(),
+      dst_height, dst_width, base::kChannelsMap.at(dst_color), order, coeffs,
+      make_float3(mean[0], mean[1], mean[2]), scale, channel_axis, dst);
+  return cudaGetLastError() == cudaSuccess;
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
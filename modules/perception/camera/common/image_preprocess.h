@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include "modules/perception/base/blob.h"
+#include "modules/perception/base/box.h"
+#include "modules/perception/base/image.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+// @brief: builds the source coordinates of every pixel of a dst_height x
+// dst_width image resized from crop_roi. With the undistortion maps given,
+// the coordinates point into the distorted raw image, so undistortion and
+// resize are done by a single remap.
+// @param [in]: map_x, map_y, undistortion maps of the full image, or nullptr
+// @param [out]: resize_map_x, resize_map_y, reshaped to dst_height x dst_width
+bool BuildResizeMap(const base::RectI &crop_roi, int dst_height, int dst_width,
+                    const base::Blob<float> *map_x,
+                    const base::Blob<float> *map_y,
+                    base::Blob<float> *resize_map_x,
+                    base::Blob<float> *resize_map_y);
+
+// @brief: samples src at the coordinates of the resize map (bilinear), and
+// writes (value - mean) * scale into the float blob, converting the channels
+// from src_color to dst_color on the way.
+// @param [in]: mean, of the dst channels
+// @param [in]: channel_axis, NHWC blob if true, NCHW otherwise
+bool RemapNormalize(const base::Image8U &src, base::Color src_color,
+                    const base::Blob<float> &resize_map_x,
+                    const base::Blob<float> &resize_map_y,
+                    base::Color dst_color, const float mean[3], float scale,
+                    bool channel_axis, float *dst);
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
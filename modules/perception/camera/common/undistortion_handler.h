@@ -54,6 +54,10 @@ class UndistortionHandler {
   // @brief: Release the resources
   bool Release(void);
 
+  // @brief: source coordinates of every undistorted pixel
+  const base::Blob<float> &map_x() const { return d_mapx_; }
+  const base::Blob<float> &map_y() const { return d_mapy_; }
+
  private:
   base::Blob<float> d_mapx_;
   base::Blob<float> d_mapy_;
@@ -160,8 +160,8 @@ class ConnectedComponent {
   // CC pixels
   void AddPixel(int x, int y);
   int GetPixelCount() const { return pixel_count_; }
-  base::BBox2DI GetBBox() const { return bbox_; }
-  std::vector<base::Point2DI> GetPixels() const {
+  const base::BBox2DI& GetBBox() const { return bbox_; }
+  const std::vector<base::Point2DI>& GetPixels() const {
     return pixels_;
   }
 
@@ -16,6 +16,7 @@
 #include "modules/perception/camera/lib/lane/postprocessor/denseline/denseline_lane_postprocessor.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "cyber/common/log.h"
 #include "modules/common/util/file.h"
@@ -139,6 +140,7 @@ void DenselineLanePostprocessor::ConvertImagePoint2Camera(
       lane_objects[line_index].curve_image_point_set;
     std::vector<base::Point3DF>& camera_point_set =
       lane_objects[line_index].curve_camera_point_set;
+    camera_point_set.reserve(camera_point_set.size() + image_point_set.size());
     for (int i = 0;
       i < static_cast<int>(image_point_set.size()); i++) {
       base::Point3DF camera_point;
@@ -164,55 +166,57 @@ void DenselineLanePostprocessor::CalLaneMap(
   int width, int height,
   std::vector<unsigned char>* lane_map) {
   int out_dim = width * height;
+  unsigned char* lane_map_data = lane_map->data();
+  float* dist_left_data = lane_output_.data();
+  float* dist_right_data = dist_left_data + out_dim;
+  float* score_data = dist_left_data + 2 * out_dim;
   for (int y = 0; y < height - omit_bottom_line_num_; y++) {
-    float score_channel[4];
     int row_start = y * width;
-    int channel0_pos = row_start;
-    int channel1_pos = out_dim + row_start;
-    int channel2_pos = 2 * out_dim + row_start;
-    int channel3_pos = 3 * out_dim + row_start;
-    int channel5_pos = 5 * out_dim + row_start;
-    int channel6_pos = 6 * out_dim + row_start;
+    const float* channel0 = output_data + row_start;
+    const float* channel1 = channel0 + out_dim;
+    const float* channel2 = channel1 + out_dim;
+    const float* channel3 = channel2 + out_dim;
+    const float* channel5 = channel0 + 5 * out_dim;
+    const float* channel6 = channel0 + 6 * out_dim;
 
     for (int x = 0; x < width; ++x) {
-      score_channel[0] = output_data[channel0_pos + x];
-      score_channel[1] = output_data[channel1_pos + x];
-      score_channel[2] = output_data[channel2_pos + x];
-      score_channel[3] = output_data[channel3_pos + x];
-      //  utilize softmax to get the probability
-      float sum_score = 0.0f;
-      for (int i = 0; i < 4; i++) {
-        score_channel[i] = static_cast<float>(exp(score_channel[i]));
-        sum_score += score_channel[i];
-      }
-      for (int i = 0; i < 4; i++) {
-        score_channel[i] /= sum_score;
-      }
       // 1: ego-lane; 2: adj-left lane; 3: adj-right lane
-      //  find the score with max lane map
+      //  softmax keeps the order of the scores, so the channel with the
+      //  maximum probability is found on the raw scores, and most pixels,
+      //  where the channel 0 has it, are omitted without any exp
+      float max_raw = channel0[x];
       int max_channel_idx = 0;
-      float max_score = score_channel[0];
-      for (int channel_idx = 1; channel_idx < 4; channel_idx++) {
-        if (max_score < score_channel[channel_idx]) {
-          max_score = score_channel[channel_idx];
-          max_channel_idx = channel_idx;
-        }
+      if (max_raw < channel1[x]) {
+        max_raw = channel1[x];
+        max_channel_idx = 1;
+      }
+      if (max_raw < channel2[x]) {
+        max_raw = channel2[x];
+        max_channel_idx = 2;
       }
-      //  if the channel 0 has the maximum probability
-      //  or the score is less than the setting value
-      //  omit it
-      if (max_channel_idx == 0 ||
-        max_score < laneline_map_score_thresh_) {
+      if (max_raw < channel3[x]) {
+        max_raw = channel3[x];
+        max_channel_idx = 3;
+      }
+      if (max_channel_idx == 0) {
+        continue;
+      }
+      //  probability of the maximum, exp(max) / sum(exp), taken relative to
+      //  the maximum so that large scores do not overflow
+      float sum_score = std::exp(channel0[x] - max_raw) +
+                        std::exp(channel1[x] - max_raw) +
+                        std::exp(channel2[x] - max_raw) +
+                        std::exp(channel3[x] - max_raw);
+      float max_score = 1.0f / sum_score;
+      //  omit the score less than the setting value
+      if (max_score < laneline_map_score_thresh_) {
         continue;
       }
       int pixel_pos = row_start + x;
-      (*lane_map)[pixel_pos] = 1;
-
-      float dist_left = sigmoid(output_data[channel5_pos + x]);
-      float dist_right = sigmoid(output_data[channel6_pos + x]);
-      lane_output_[pixel_pos] = dist_left;
-      lane_output_[out_dim + pixel_pos] = dist_right;
-      lane_output_[out_dim * 2 + pixel_pos] = max_score;
+      lane_map_data[pixel_pos] = 1;
+      dist_left_data[pixel_pos] = sigmoid(channel5[x]);
+      dist_right_data[pixel_pos] = sigmoid(channel6[x]);
+      score_data[pixel_pos] = max_score;
     }
   }
   return;
@@ -267,10 +271,19 @@ void DenselineLanePostprocessor::InferPointSetFromOneCC(
   int *hist_blob_head = lane_hist_blob_.mutable_cpu_data();
   int *x_left_count = hist_blob_head;
   int *x_right_count = hist_blob_head + lane_hist_blob_.offset(1);
-  memset(lane_pos_blob_.mutable_cpu_data(), 0,
-    sizeof(float) * lane_pos_blob_.count());
-  memset(lane_hist_blob_.mutable_cpu_data(), 0,
-    sizeof(int) * lane_hist_blob_.count());
+  //  only the rows of the cc are written and read, clear just those
+  const base::BBox2DI& bbox = lane_cc.GetBBox();
+  int ymax = bbox.ymax;
+  int ymin = bbox.ymin;
+  int rows_start = ymin * lane_map_width_;
+  size_t rows_size =
+    static_cast<size_t>((ymax - ymin + 1) * lane_map_width_);
+  for (float* vec : {score_left_vec, x_left_vec, score_right_vec,
+                     x_right_vec}) {
+    memset(vec + rows_start, 0, sizeof(float) * rows_size);
+  }
+  memset(x_left_count + rows_start, 0, sizeof(int) * rows_size);
+  memset(x_right_count + rows_start, 0, sizeof(int) * rows_size);
 
   int lane_map_dim = lane_map_width_ * lane_map_height_;
   for (int j = 0; j < static_cast<int>(pixels.size()); j++) {
@@ -304,9 +317,6 @@ void DenselineLanePostprocessor::InferPointSetFromOneCC(
     }
   }
 
-  const base::BBox2DI& bbox = lane_cc.GetBBox();
-  int ymax = bbox.ymax;
-  int ymin = bbox.ymin;
   for (int j = ymin; j <= ymax; j++) {
     int start_pos = j * lane_map_width_;
     //  find the position with maximum value for left side
@@ -341,15 +351,15 @@ void DenselineLanePostprocessor::InferPointSetFromOneCC(
 bool DenselineLanePostprocessor::MaxScorePoint(const float *score_pointer,
   const float *x_pointer, const int *x_count_pointer,
   int y_pos, LanePointInfo *point_info) {
-  int large_index[2];
-  bool flag = FindKLargeValue(score_pointer, lane_map_width_, 2, large_index);
-  if (!flag) {
+  if (lane_map_width_ < 2) {
     return false;
   }
-  int max_x = large_index[0];
-  float max_score = score_pointer[large_index[0]];
-  flag = (max_score > laneline_point_score_thresh_)?true:false;
-  if (!flag) {
+  //  only the largest score is used, a linear scan finds it
+  int max_x = static_cast<int>(
+    std::max_element(score_pointer, score_pointer + lane_map_width_) -
+    score_pointer);
+  float max_score = score_pointer[max_x];
+  if (max_score <= laneline_point_score_thresh_) {
     return false;
   }
   (*point_info).x = x_pointer[max_x] /
@@ -372,25 +382,30 @@ bool DenselineLanePostprocessor::SelectLanecenterCCs(
   //  select top 3 ccs with largest pixels size
   int valid_pixels_num = static_cast<int>(cc_valid_pixels_ratio_ *
                           static_cast<float>(lane_map_height_));
-  std::vector<ConnectedComponent> valid_lane_ccs;
+  //  sort pointers, the ccs are copied only once they are selected
+  std::vector<const ConnectedComponent*> valid_lane_ccs;
+  valid_lane_ccs.reserve(lane_ccs_num);
   for (int i = 0; i < lane_ccs_num; i++) {
     const std::vector<base::Point2DI>& pixels = lane_ccs[i].GetPixels();
     if (static_cast<int>(pixels.size()) < valid_pixels_num) {
       AINFO << "pixels_size < valid_pixels_num";
       continue;
     }
-    valid_lane_ccs.push_back(lane_ccs[i]);
+    valid_lane_ccs.push_back(&lane_ccs[i]);
   }
   int valid_ccs_num = static_cast<int>(valid_lane_ccs.size());
   if (valid_ccs_num == 0) {
     AINFO << "valid_ccs_num=0";
     return false;
   }
-  std::sort(valid_lane_ccs.begin(), valid_lane_ccs.end(),
-    CompareCCSize);
   int select_cc_num = std::min(valid_ccs_num, 3);
+  std::partial_sort(valid_lane_ccs.begin(),
+    valid_lane_ccs.begin() + select_cc_num, valid_lane_ccs.end(),
+    [](const ConnectedComponent* cc1, const ConnectedComponent* cc2) {
+      return CompareCCSize(*cc1, *cc2);
+    });
   for (int i = 0; i < select_cc_num; i++) {
-    select_lane_ccs->push_back(valid_lane_ccs[i]);
+    select_lane_ccs->push_back(*valid_lane_ccs[i]);
   }
   return true;
 }
@@ -417,14 +432,17 @@ bool DenselineLanePostprocessor::LocateLanelinePointSet(
       << " height=" << lane_map_height_
       << " width=" << lane_map_width_;
 
-  image_group_point_set_.clear();
+  //  the buffers of the previous frame are reused, not reallocated
   image_group_point_set_.resize(4);
+  lane_map_group_point_set_.resize(4);
+  for (int i = 0; i < 4; i++) {
+    image_group_point_set_[i].clear();
+    lane_map_group_point_set_[i].clear();
+  }
 
   int out_dim = lane_map_width_ * lane_map_height_;
-  lane_map_.clear();
-  lane_output_.clear();
-  lane_map_.resize(out_dim, 0);
-  lane_output_.resize(out_dim * 3, 0);
+  lane_map_.assign(out_dim, 0);
+  lane_output_.assign(out_dim * 3, 0);
   CalLaneMap(output_data, lane_map_width_, lane_map_height_,
     &lane_map_);
   //  2.group the lane points
@@ -455,12 +473,11 @@ bool DenselineLanePostprocessor::LocateLanelinePointSet(
   }
 
   //  5. get the lane line points
-  std::vector<std::vector<LanePointInfo> > lane_map_group_point_set(4);
   InferPointSetFromLaneCenter(select_lane_ccs_, ccs_pos_type,
-    &lane_map_group_point_set);
+    &lane_map_group_point_set_);
 
   //  6. convert to the original image
-  Convert2OriginalCoord(lane_map_group_point_set,
+  Convert2OriginalCoord(lane_map_group_point_set_,
     &image_group_point_set_);
   return true;
 }
@@ -653,6 +670,9 @@ void DenselineLanePostprocessor::Convert2OriginalCoord(
                   lane_map_height_inverse_;
   for (int i = 0; i < static_cast<int>(lane_map_group_point_set.size());
     i++) {
+    (*image_group_point_set)[i].reserve(
+      (*image_group_point_set)[i].size() +
+      lane_map_group_point_set[i].size());
     for (int j = 0; j < static_cast<int>(lane_map_group_point_set[i].size());
     j++) {
       LanePointInfo lane_map_info = lane_map_group_point_set[i][j];
@@ -763,6 +783,7 @@ void DenselineLanePostprocessor::PolyFitCameraLaneline(
     float x_end = 0.0f;
     Eigen::Matrix<float, max_poly_order + 1, 1> camera_coeff;
     std::vector<Eigen::Matrix<float, 2, 1> > camera_pos_vec;
+    camera_pos_vec.reserve(camera_point_set.size());
     for (int i = 0; i < static_cast<int>(camera_point_set.size()); i++) {
       x_end = std::max(camera_point_set[i].z, x_end);
       x_start = std::min(camera_point_set[i].z, x_start);
@@ -90,9 +90,7 @@ class DenselineLanePostprocessor : public BaseLanePostprocessor {
   // @brief: compare CC's size
   static bool CompareCCSize(const ConnectedComponent& cc1,
     const ConnectedComponent& cc2) {
-    std::vector<base::Point2DI> cc1_pixels = cc1.GetPixels();
-    std::vector<base::Point2DI> cc2_pixels = cc2.GetPixels();
-    return cc1_pixels.size() > cc2_pixels.size();
+    return cc1.GetPixels().size() > cc2.GetPixels().size();
   }
   // @brief: infer point set from lane center
   void InferPointSetFromLaneCenter(
@@ -158,6 +156,8 @@ class DenselineLanePostprocessor : public BaseLanePostprocessor {
 
  private:
   std::vector<std::vector<LanePointInfo> > image_group_point_set_;
+  //  lane line points in the lane map, before Convert2OriginalCoord
+  std::vector<std::vector<LanePointInfo> > lane_map_group_point_set_;
   std::vector<std::vector<base::Point3DF> > camera_group_point_set_;
 
   std::vector<LanePointInfo> image_laneline_point_set_;
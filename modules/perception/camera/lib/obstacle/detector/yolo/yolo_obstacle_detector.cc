@@ -277,11 +277,20 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
         static_cast<int>(base_camera_model_->get_width()),
         static_cast<int>(base_camera_model_->get_height()) - offset_y_);
   image_options.do_crop = true;
-  frame->data_provider->GetImage(image_options, image_.get());
-  AINFO << "GetImageBlob: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  inference::ResizeGPU(*image_,
-                       input_blob, frame->data_provider->src_width(), 0);
-  AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  if (frame->data_provider->fuse_preprocessing()) {
+    // undistort, crop and resize in one pass
+    frame->data_provider->GetResizedImageBlob(
+        image_options, DataProvider::BlobOptions(), input_blob.get());
+    AINFO << "GetResizedImageBlob: "
+          << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  } else {
+    frame->data_provider->GetImage(image_options, image_.get());
+    AINFO << "GetImageBlob: " << static_cast<double>(timer.Toc()) * 0.001
+          << "ms";
+    inference::ResizeGPU(*image_,
+                         input_blob, frame->data_provider->src_width(), 0);
+    AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  }
 
   /////////////////////////// detection part ///////////////////////////
   inference_->Infer();
@@ -302,10 +311,10 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
                &frame->detected_objects);
 
   // post processing
-  int left_boundary = static_cast<int>(border_ratio_ *
-                                       static_cast<float>(image_->cols()));
-  int right_boundary = static_cast<int>(
-              (1.0f - border_ratio_) * static_cast<float>(image_->cols()));
+  // width of the cropped image
+  const float image_width = static_cast<float>(image_options.crop_roi.width);
+  int left_boundary = static_cast<int>(border_ratio_ * image_width);
+  int right_boundary = static_cast<int>((1.0f - border_ratio_) * image_width);
   for (auto &obj : frame->detected_objects) {
     // recover alpha
     obj->camera_supplement.alpha /= ori_cycle_;
@@ -170,31 +170,74 @@ bool OMTObstacleTracker::CombineDuplicateTargets() {
 }
 
 void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
+  const size_t target_num = targets_.size();
+  const size_t object_num = objects.size();
+  ScoreAppearances(objects);
+
+  // the terms of the scores which depend on one side only, computed once
+  // instead of for every pair
+  target_terms_.resize(target_num);
+  for (size_t i = 0; i < target_num; ++i) {
+    BoxTerms &terms = target_terms_[i];
+    Eigen::Vector4d center = targets_[i].image_center.get_state();
+    Eigen::Vector2d wh = targets_[i].image_wh.get_state();
+    terms.center_x = static_cast<float>(center[0]);
+    terms.center_y = static_cast<float>(center[1]);
+    terms.width = wh[0];
+    terms.height = wh[1];
+    terms.box.xmin = static_cast<float>(center[0] - wh[0] * 0.5);
+    terms.box.xmax = static_cast<float>(center[0] + wh[0] * 0.5);
+    terms.box.ymin = static_cast<float>(center[1] - wh[1] * 0.5);
+    terms.box.ymax = static_cast<float>(center[1] + wh[1] * 0.5);
+  }
+  object_terms_.resize(object_num);
+  for (size_t j = 0; j < object_num; ++j) {
+    BoxTerms &terms = object_terms_[j];
+    base::Point2DF center = objects[j]->projected_box.Center();
+    base::RectF rect(objects[j]->projected_box);
+    terms.center_x = center.x;
+    terms.center_y = center.y;
+    terms.width = rect.width;
+    terms.height = rect.height;
+    terms.box = objects[j]->projected_box;
+  }
+
+  const auto &weight_diff_camera = omt_param_.weight_diff_camera();
+  const auto &weight_same_camera = omt_param_.weight_same_camera();
   std::vector<Hypothesis> score_list;
   Hypothesis hypo;
-  for (size_t i = 0; i < targets_.size(); ++i) {
+  for (size_t i = 0; i < target_num; ++i) {
     ADEBUG << "Target " << targets_[i].id;
-    for (size_t j = 0; j < objects.size(); ++j) {
+    const BoxTerms &target = target_terms_[i];
+    const float *appearance_row = &appearance_scores_[i * object_num];
+    const auto &type_costs =
+        kTypeAssociatedCost_[static_cast<int>(targets_[i].type)];
+    for (size_t j = 0; j < object_num; ++j) {
+      const BoxTerms &object = object_terms_[j];
       hypo.target = static_cast<int>(i);
       hypo.object = static_cast<int>(j);
-      float sa = ScoreAppearance(targets_[i], objects[j]);
-      float sm = ScoreMotion(targets_[i], objects[j]);
-      float ss = ScoreShape(targets_[i], objects[j]);
-      float so = ScoreOverlap(targets_[i], objects[j]);
+      // appearance, motion, shape and overlap
+      float sa = appearance_row[j];
+      float sm = gaussian(object.center_x, target.center_x,
+                          static_cast<float>(object.width)) *
+                 gaussian(object.center_y, target.center_y,
+                          static_cast<float>(object.height));
+      float ss = -std::abs(static_cast<float>(
+          (target.height - object.height) * (target.width - object.width) /
+          (target.height * target.width)));
+      float so = common::CalculateIOUBBox(target.box, object.box);
       if (sa == 0) {
-        hypo.score =
-            omt_param_.weight_diff_camera().motion() * sm
-                + omt_param_.weight_diff_camera().shape() * ss
-                + omt_param_.weight_diff_camera().overlap() * so;
+        hypo.score = weight_diff_camera.motion() * sm +
+                     weight_diff_camera.shape() * ss +
+                     weight_diff_camera.overlap() * so;
       } else {
-        hypo.score = (omt_param_.weight_same_camera().appearance() * sa +
-            omt_param_.weight_same_camera().motion() * sm +
-            omt_param_.weight_same_camera().shape() * ss +
-            omt_param_.weight_same_camera().overlap() * so);
+        hypo.score = (weight_same_camera.appearance() * sa +
+                      weight_same_camera.motion() * sm +
+                      weight_same_camera.shape() * ss +
+                      weight_same_camera.overlap() * so);
       }
-      int change_from_type = static_cast<int>(targets_[i].type);
       int change_to_type = static_cast<int>(objects[j]->object->sub_type);
-      hypo.score += -kTypeAssociatedCost_[change_from_type][change_to_type];
+      hypo.score += -type_costs[change_to_type];
       ADEBUG << "Detection " << objects[j]->indicator.frame_id << "(" << j
                 << ") sa:" << sa
                 << " sm: " << sm
@@ -232,61 +275,37 @@ void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
   }
 }
 
-float OMTObstacleTracker::ScoreMotion(const Target &target,
-                                      TrackObjectPtr track_obj) {
-  Eigen::Vector4d x = target.image_center.get_state();
-  float target_centerx = static_cast<float>(x[0]);
-  float target_centery = static_cast<float>(x[1]);
-  base::Point2DF center = track_obj->projected_box.Center();
-  base::RectF rect(track_obj->projected_box);
-  float s = gaussian(center.x, target_centerx, rect.width) *
-      gaussian(center.y, target_centery, rect.height);
-  return s;
-}
-
-float OMTObstacleTracker::ScoreShape(const Target &target,
-                                     TrackObjectPtr track_obj) {
-  Eigen::Vector2d shape = target.image_wh.get_state();
-  base::RectF rect(track_obj->projected_box);
-  float s = static_cast<float>((shape[1] - rect.height)
-      * (shape[0] - rect.width) / (shape[1] * shape[0]));
-  return -std::abs(s);
-}
-
-float OMTObstacleTracker::ScoreAppearance(const Target &target,
-                                          TrackObjectPtr track_obj) {
-  float energy = 0.0f;
-  int count = 0;
-  auto sensor_name = track_obj->indicator.sensor_name;
-  for (int i = target.Size() - 1; i >= 0; --i) {
-    if (target[i]->indicator.sensor_name != sensor_name) {
-      continue;
+void OMTObstacleTracker::ScoreAppearances(const TrackObjectPtrs &objects) {
+  const size_t object_num = objects.size();
+  appearance_scores_.assign(targets_.size() * object_num, 0.0f);
+  if (object_num == 0) {
+    return;
+  }
+  // the objects are the detections of one frame, whose similarities to the
+  // patches of every frame kept are rows of the matrices similar_ computed,
+  // so the energy of a target sums the rows of the patches it went through
+  const PatchIndicator &indicator = objects[0]->indicator;
+  for (size_t i = 0; i < targets_.size(); ++i) {
+    const Target &target = targets_[i];
+    float *energy = &appearance_scores_[i * object_num];
+    int count = 0;
+    for (int k = target.Size() - 1; k >= 0; --k) {
+      const PatchIndicator &patch = target[k]->indicator;
+      if (patch.sensor_name != indicator.sensor_name) {
+        continue;
+      }
+      auto blob = similar_map_.get(patch.frame_id, indicator.frame_id);
+      const float *sim = blob->cpu_data() + blob->offset(patch.patch_id, 0);
+      for (size_t j = 0; j < object_num; ++j) {
+        energy[j] += sim[j];
+      }
+      count += 1;
+    }
+    const float norm = 0.1f + static_cast<float>(count) * 0.9f;
+    for (size_t j = 0; j < object_num; ++j) {
+      energy[j] /= norm;
     }
-    PatchIndicator p1 = target[i]->indicator;
-    PatchIndicator p2 = track_obj->indicator;
-
-    energy += similar_map_.sim(p1, p2);
-    count += 1;
   }
-
-  return energy / (0.1f + static_cast<float>(count) * 0.9f);
-}
-
-// [new]
-float OMTObstacleTracker::ScoreOverlap(const Target &target,
-                                       TrackObjectPtr track_obj) {
-  Eigen::Vector4d center = target.image_center.get_state();
-  Eigen::VectorXd wh = target.image_wh.get_state();
-  base::BBox2DF box_target;
-  box_target.xmin = static_cast<float>(center[0] - wh[0] * 0.5);
-  box_target.xmax = static_cast<float>(center[0] + wh[0] * 0.5);
-  box_target.ymin = static_cast<float>(center[1] - wh[1] * 0.5);
-  box_target.ymax = static_cast<float>(center[1] + wh[1] * 0.5);
-
-  auto box_obj = track_obj->projected_box;
-
-  float iou = common::CalculateIOUBBox(box_target, box_obj);
-  return iou;
 }
 
 void ProjectBox(const base::BBox2DF &box_origin,
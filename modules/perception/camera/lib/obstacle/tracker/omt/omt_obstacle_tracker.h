@@ -107,15 +107,18 @@ class OMTObstacleTracker : public BaseObstacleTracker {
   std::string Name() const override;
 
  private:
-  float ScoreAppearance(const Target &target,
-                        TrackObjectPtr object);
-
-  float ScoreMotion(const Target &target,
-                    TrackObjectPtr object);
-  float ScoreShape(const Target &target,
-                   TrackObjectPtr object);
-  float ScoreOverlap(const Target &target,
-                                         TrackObjectPtr track_obj);
+  // the terms of the pairwise scores of a target or an object
+  struct BoxTerms {
+    float center_x = 0.0f;
+    float center_y = 0.0f;
+    double width = 0.0;
+    double height = 0.0;
+    base::BBox2DF box;
+  };
+
+  // fills appearance_scores_ with the appearance similarity of every target
+  // and object
+  void ScoreAppearances(const TrackObjectPtrs &objects);
   void ClearTargets();
   bool CombineDuplicateTargets();
   void GenerateHypothesis(const TrackObjectPtrs &objects);
@@ -130,6 +133,11 @@ class OMTObstacleTracker : public BaseObstacleTracker {
   std::vector<bool> used_;
   ObstacleReference reference_;
   std::vector<std::vector<float> > kTypeAssociatedCost_;
+  // buffers of GenerateHypothesis, appearance_scores_ is row major targets x
+  // objects
+  std::vector<float> appearance_scores_;
+  std::vector<BoxTerms> target_terms_;
+  std::vector<BoxTerms> object_terms_;
   int track_id_ = 0;
   int frame_num_ = 0;
   int gpu_id_ = 0;
@@ -123,37 +123,51 @@ ClassifyBySimple::Perform(const CameraFrame* frame,
   auto input_blob_recog = rt_net_->get_blob(net_inputs_[0]);
   auto output_blob_recog = rt_net_->get_blob(net_outputs_[0]);
 
+  std::vector<base::TrafficLightPtr> detected_lights;
   for (base::TrafficLightPtr light : *lights) {
-    if (!light->region.is_detected) {
-      continue;
+    if (light->region.is_detected) {
+      detected_lights.push_back(light);
     }
+  }
+  if (detected_lights.empty()) {
+    return;
+  }
 
-    data_provider_image_option_.crop_roi = light->region.detection_roi;
+  // all the lights are recognized in one batch
+  int batch_num = static_cast<int>(detected_lights.size());
+  if (input_blob_recog->num() != batch_num) {
+    input_blob_recog->Reshape(batch_num, resize_height_, resize_width_, 3);
+  }
+  const float* mean = mean_.get()->cpu_data();
+  for (int i = 0; i < batch_num; ++i) {
+    data_provider_image_option_.crop_roi =
+        detected_lights[i]->region.detection_roi;
     data_provider_image_option_.do_crop = true;
     data_provider_image_option_.target_color = base::Color::BGR;
     frame->data_provider->GetImage(data_provider_image_option_, image_.get());
 
-    AINFO << "get img done";
-
-    const float* mean = mean_.get()->cpu_data();
     inference::ResizeGPU(*image_,
               input_blob_recog,
               frame->data_provider->src_width(),
-              0,
+              i,
               mean[0],
               mean[1],
               mean[2],
               true,
               scale_);
-
-    AINFO << "resize gpu finish.";
-    cudaDeviceSynchronize();
-    rt_net_->Infer();
-    cudaDeviceSynchronize();
-    AINFO << "infer finish.";
-
-     float *out_put_data = output_blob_recog->mutable_cpu_data();
-     Prob2Color(out_put_data, unknown_threshold_, light);
+  }
+  AINFO << "resize gpu finish, batch " << batch_num;
+
+  cudaDeviceSynchronize();
+  rt_net_->Infer();
+  cudaDeviceSynchronize();
+  AINFO << "infer finish.";
+
+  const float *out_put_data = output_blob_recog->cpu_data();
+  int out_put_length = output_blob_recog->count(1);
+  for (int i = 0; i < batch_num; ++i) {
+    Prob2Color(out_put_data + i * out_put_length, unknown_threshold_,
+               detected_lights[i]);
   }
 }
 
@@ -51,6 +51,9 @@ TrafficLightRecognition::Init(const TrafficLightDetectorInitOptions& options) {
 
 bool TrafficLightRecognition::Detect(
     const TrafficLightDetectorOptions& options, CameraFrame* frame) {
+  if (recognize_param_.batch_inference()) {
+    return DetectInBatch(frame);
+  }
   std::vector<base::TrafficLightPtr> candidate(1);
 
   for (base::TrafficLightPtr light : frame->traffic_lights) {
@@ -80,6 +83,40 @@ bool TrafficLightRecognition::Detect(
   return true;
 }
 
+bool TrafficLightRecognition::DetectInBatch(CameraFrame* frame) {
+  std::vector<base::TrafficLightPtr> quadrate_lights;
+  std::vector<base::TrafficLightPtr> vertical_lights;
+  std::vector<base::TrafficLightPtr> horizontal_lights;
+
+  for (base::TrafficLightPtr light : frame->traffic_lights) {
+    if (!light->region.is_detected) {
+      light->status.color = base::TLColor::TL_UNKNOWN_COLOR;
+      light->status.confidence = 0;
+      continue;
+    }
+    if (light->region.detect_class_id ==
+        base::TLDetectionClass::TL_QUADRATE_CLASS) {
+      quadrate_lights.push_back(light);
+    } else if (light->region.detect_class_id ==
+        base::TLDetectionClass::TL_VERTICAL_CLASS) {
+      vertical_lights.push_back(light);
+    } else if (light->region.detect_class_id ==
+        base::TLDetectionClass::TL_HORIZONTAL_CLASS) {
+      horizontal_lights.push_back(light);
+    } else {
+      return false;
+    }
+  }
+
+  AINFO << "Recognize " << quadrate_lights.size() << " quadrate, "
+        << vertical_lights.size() << " vertical, "
+        << horizontal_lights.size() << " horizontal lights";
+  classify_quadrate_->Perform(frame, &quadrate_lights);
+  classify_vertical_->Perform(frame, &vertical_lights);
+  classify_horizontal_->Perform(frame, &horizontal_lights);
+  return true;
+}
+
 std::string TrafficLightRecognition::Name() const {
   return "TrafficLightRecognition";
 }
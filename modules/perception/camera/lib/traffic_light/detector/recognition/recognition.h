@@ -51,6 +51,9 @@ class TrafficLightRecognition : public BaseTrafficLightDetector {
   TrafficLightRecognition& operator=(const BaseTrafficLightDetector&) = delete;
 
  private:
+  // runs each recognition model once on all the lights of its class
+  bool DetectInBatch(CameraFrame* frame);
+
   std::shared_ptr<ClassifyBySimple> classify_vertical_;
   std::shared_ptr<ClassifyBySimple> classify_quadrate_;
   std::shared_ptr<ClassifyBySimple> classify_horizontal_;
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <numeric>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -95,6 +96,10 @@ class ConvexHull2D {
   void SetPoints(const CLOUD_IN_TYPE& in_cloud);
   // mock a polygon for some degenerate cases
   bool MockConvexHull(CLOUD_OUT_TYPE* out_polygon);
+  // indices of the points which may be hull vertices, the points strictly
+  // inside the octagon of the extreme points along x, y, x + y and x - y
+  // can not be on the hull and are dropped before sorting
+  void GetHullCandidates(std::vector<std::size_t>* candidates);
   // compute convex hull using Andrew's monotone chain algorithm
   bool GetConvexHullMonotoneChain(CLOUD_OUT_TYPE* out_polygon);
   // given 3 ordered points, return true if in counter clock wise.
@@ -108,6 +113,7 @@ class ConvexHull2D {
  private:
   std::vector<Eigen::Vector2d> points_;
   std::vector<std::size_t> polygon_indices_;
+  std::vector<unsigned char> interior_flags_;
   const CLOUD_IN_TYPE* in_cloud_;
 };
 
@@ -168,6 +174,79 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::MockConvexHull(
   return true;
 }
 
+template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
+void ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetHullCandidates(
+    std::vector<std::size_t>* candidates) {
+  const std::size_t num_points = points_.size();
+  candidates->resize(num_points);
+  std::iota(candidates->begin(), candidates->end(), 0);
+  if (num_points < 16) {
+    return;
+  }
+  // extreme points in the counter clock wise order of their directions:
+  // -x, -x-y, -y, x-y, x, x+y, y, y-x
+  std::size_t extremes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  double values[8];
+  auto directional = [this](std::size_t i, int k) {
+    static const double kDirX[8] = {-1.0, -1.0, 0.0, 1.0, 1.0, 1.0, 0.0, -1.0};
+    static const double kDirY[8] = {0.0, -1.0, -1.0, -1.0, 0.0, 1.0, 1.0, 1.0};
+    return kDirX[k] * points_[i](0) + kDirY[k] * points_[i](1);
+  };
+  for (int k = 0; k < 8; ++k) {
+    values[k] = directional(0, k);
+  }
+  for (std::size_t i = 1; i < num_points; ++i) {
+    for (int k = 0; k < 8; ++k) {
+      const double value = directional(i, k);
+      if (value > values[k]) {
+        values[k] = value;
+        extremes[k] = i;
+      }
+    }
+  }
+
+  // edges of the octagon as a * x + b * y + c >= 0 for the inner side
+  static const double kInteriorMargin = 1e-6;
+  double edge_a[8];
+  double edge_b[8];
+  double edge_c[8];
+  int num_edges = 0;
+  double area = 0.0;
+  for (int k = 0; k < 8; ++k) {
+    const Eigen::Vector2d& p1 = points_[extremes[k]];
+    const Eigen::Vector2d& p2 = points_[extremes[(k + 1) % 8]];
+    area += p1(0) * p2(1) - p2(0) * p1(1);
+    if (p1 == p2) {
+      continue;
+    }
+    edge_a[num_edges] = p1(1) - p2(1);
+    edge_b[num_edges] = p2(0) - p1(0);
+    edge_c[num_edges] = p1(0) * p2(1) - p2(0) * p1(1) - kInteriorMargin;
+    ++num_edges;
+  }
+  if (area <= kInteriorMargin || num_edges < 3) {
+    return;
+  }
+
+  // branch free over the points, so the edge tests vectorize
+  interior_flags_.assign(num_points, 1);
+  for (int e = 0; e < num_edges; ++e) {
+    const double a = edge_a[e];
+    const double b = edge_b[e];
+    const double c = edge_c[e];
+    for (std::size_t i = 0; i < num_points; ++i) {
+      interior_flags_[i] &= static_cast<unsigned char>(
+          a * points_[i](0) + b * points_[i](1) + c > 0.0);
+    }
+  }
+  std::size_t num_candidates = 0;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    (*candidates)[num_candidates] = i;
+    num_candidates += 1 - interior_flags_[i];
+  }
+  candidates->resize(num_candidates);
+}
+
 template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
 bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     CLOUD_OUT_TYPE* out_polygon) {
@@ -175,8 +254,8 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     return false;
   }
 
-  std::vector<std::size_t> sorted_indices(points_.size());
-  std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
+  std::vector<std::size_t> sorted_indices;
+  GetHullCandidates(&sorted_indices);
 
   static const double eps = 1e-9;
   std::sort(sorted_indices.begin(), sorted_indices.end(),
@@ -192,13 +271,14 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
   polygon_indices_.clear();
   polygon_indices_.reserve(points_.size());
 
-  std::size_t size2 = points_.size() * 2;
+  const std::size_t num_sorted = sorted_indices.size();
+  std::size_t size2 = num_sorted * 2;
   for (std::size_t i = 0; i < size2; ++i) {
-    if (i == points_.size()) {
+    if (i == num_sorted) {
       last_count = count;
     }
     const std::size_t& idx =
-        sorted_indices[(i < points_.size()) ? i : (size2 - 1 - i)];
+        sorted_indices[(i < num_sorted) ? i : (size2 - 1 - i)];
     const auto& point = points_[idx];
     while (count > last_count &&
            !IsCounterClockWise(points_[polygon_indices_[count - 2]],
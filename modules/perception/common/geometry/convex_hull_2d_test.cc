@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/common/geometry/convex_hull_2d.h"
 
+#include <random>
+
 #include "gtest/gtest.h"
 
 #include "modules/perception/base/point.h"
@@ -125,6 +127,49 @@ TEST(ConvexHull2DTest1, convex_hull_2d1) {
   EXPECT_EQ(pointcloud_out.size(), 4);
 }
 
+TEST(ConvexHull2DTest, convex_hull_2d_large_cloud) {
+  ConvexHull2D<PointFCloud, PointFCloud> convex_hull_2d;
+  PointFCloud pointcloud_in, pointcloud_out;
+  std::mt19937 generator(0);
+  std::normal_distribution<float> distribution(0.f, 2.f);
+  PointF pt;
+  for (size_t i = 0; i < 20000; ++i) {
+    pt.x = 10.f + 3.f * distribution(generator);
+    pt.y = 5.f + distribution(generator);
+    pt.z = 0.f;
+    pointcloud_in.push_back(pt);
+  }
+  EXPECT_TRUE(convex_hull_2d.GetConvexHull(pointcloud_in, &pointcloud_out));
+  const size_t num_vertices = pointcloud_out.size();
+  ASSERT_GE(num_vertices, 3);
+  // the hull is convex, counter clock wise and contains every point
+  for (size_t i = 0; i < num_vertices; ++i) {
+    const PointF& p1 = pointcloud_out[i];
+    const PointF& p2 = pointcloud_out[(i + 1) % num_vertices];
+    const PointF& p3 = pointcloud_out[(i + 2) % num_vertices];
+    EXPECT_GT((p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x),
+              0.f);
+    for (size_t j = 0; j < pointcloud_in.size(); ++j) {
+      const PointF& p = pointcloud_in[j];
+      ASSERT_GE((p2.x - p1.x) * (p.y - p1.y) - (p2.y - p1.y) * (p.x - p1.x),
+                -1e-3f);
+    }
+  }
+
+  // interior points do not change the hull of a square
+  pointcloud_in.clear();
+  for (size_t i = 0; i <= 100; ++i) {
+    for (size_t j = 0; j <= 100; ++j) {
+      pt.x = static_cast<float>(i) * 0.1f;
+      pt.y = static_cast<float>(j) * 0.1f;
+      pointcloud_in.push_back(pt);
+    }
+  }
+  pointcloud_out.clear();
+  EXPECT_TRUE(convex_hull_2d.GetConvexHull(pointcloud_in, &pointcloud_out));
+  EXPECT_EQ(pointcloud_out.size(), 4);
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
@@ -19,13 +19,17 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 
 #include "modules/perception/common/graph/connected_component_analysis.h"
 #include "modules/perception/common/graph/hungarian_optimizer.h"
+#include "modules/perception/common/graph/jv_optimizer.h"
 
 namespace apollo {
 namespace perception {
@@ -52,6 +56,18 @@ class GatedHungarianMatcher {
   const SecureMat<T>& global_costs() const { return global_costs_; }
   SecureMat<T>* mutable_global_costs() { return &global_costs_; }
 
+  /* @brief: solve the connected components concurrently on the task pool,
+   * with up to num_solvers optimizers. 0 or 1 solves them one by one. */
+  void set_num_parallel_solvers(size_t num_solvers) {
+    num_parallel_solvers_ = num_solvers;
+  }
+
+  /* @brief: components with at least min_size rows or cols are solved by
+   * the JVOptimizer instead of the hungarian one. 0 never uses it. */
+  void set_jv_min_component_size(size_t min_size) {
+    jv_min_component_size_ = min_size;
+  }
+
   void Match(T cost_thresh, OptimizeFlag opt_flag,
              std::vector<std::pair<size_t, size_t>>* assignments,
              std::vector<size_t>* unassigned_rows,
@@ -73,12 +89,21 @@ class GatedHungarianMatcher {
    * small sub-parts. */
   void ComputeConnectedComponents(
       std::vector<std::vector<size_t>>* row_components,
-      std::vector<std::vector<size_t>>* col_components) const;
+      std::vector<std::vector<size_t>>* col_components);
 
   /* Step 3:
-   * optimize single connected component, which is part of the global one */
-  void OptimizeConnectedComponent(const std::vector<size_t>& row_component,
-                                  const std::vector<size_t>& col_component);
+   * optimize single connected component, which is part of the global one,
+   * with the given optimizers and append its assignments. it only reads
+   * the members, so components may be optimized concurrently. */
+  void OptimizeConnectedComponent(
+      const std::vector<size_t>& row_component,
+      const std::vector<size_t>& col_component,
+      HungarianOptimizer<T>* hungarian_optimizer, JVOptimizer<T>* jv_optimizer,
+      std::vector<std::pair<size_t, size_t>>* assignments) const;
+
+  void OptimizeConnectedComponentsInParallel(
+      const std::vector<std::vector<size_t>>& row_components,
+      const std::vector<std::vector<size_t>>& col_components);
 
   /* Step 4:
    * generate the set of unassigned row or col index. */
@@ -86,19 +111,39 @@ class GatedHungarianMatcher {
                               std::vector<size_t>* unassigned_cols) const;
 
   /* @brief: core function for updating the local cost matrix from global one,
-   * we get queryed local costs and write them in the memeory of costs of
-   * optimizer directly
+   * only the gated pairs are read, the others are set to the bound value
    * @params[IN] row_component: the set of index of rows of sub-graph
    * @params[IN] col_component: the set of index of cols of sub-graph
+   * @params[OUT] local_costs: the costs of the optimizer
    * @return: nothing */
   void UpdateGatingLocalCostsMat(const std::vector<size_t>& row_component,
-                                 const std::vector<size_t>& col_component);
+                                 const std::vector<size_t>& col_component,
+                                 SecureMat<T>* local_costs) const;
 
+  template <typename Optimizer>
   void OptimizeAdapter(
-      std::vector<std::pair<size_t, size_t>>* local_assignments);
+      Optimizer* optimizer,
+      std::vector<std::pair<size_t, size_t>>* local_assignments) const;
+
+  /* optimizers of one component at a time */
+  struct Solver {
+    HungarianOptimizer<T> hungarian_optimizer;
+    JVOptimizer<T> jv_optimizer;
+  };
 
   /* hungarian optimizer */
   HungarianOptimizer<T> optimizer_;
+  JVOptimizer<T> jv_optimizer_;
+
+  /* optimizers of the parallel solving, created on demand */
+  std::vector<std::unique_ptr<Solver>> solvers_;
+  size_t num_parallel_solvers_ = 0;
+  size_t jv_min_component_size_ = 0;
+
+  /* gated pairs: the gated cols of every row, and the index of every col in
+   * its component */
+  std::vector<std::vector<size_t>> gated_cols_;
+  std::vector<size_t> local_col_index_;
 
   /* global costs matrix */
   SecureMat<T> global_costs_;
@@ -156,8 +201,15 @@ void GatedHungarianMatcher<T>::Match(
   /* compute assignments */
   assignments_ptr_->clear();
   assignments_ptr_->reserve(std::max(rows_num_, cols_num_));
-  for (size_t i = 0; i < row_components.size(); ++i) {
-    this->OptimizeConnectedComponent(row_components[i], col_components[i]);
+  if (num_parallel_solvers_ > 1 && row_components.size() > 1) {
+    this->OptimizeConnectedComponentsInParallel(row_components,
+                                                col_components);
+  } else {
+    for (size_t i = 0; i < row_components.size(); ++i) {
+      this->OptimizeConnectedComponent(row_components[i], col_components[i],
+                                       &optimizer_, &jv_optimizer_,
+                                       assignments_ptr_);
+    }
   }
 
   this->GenerateUnassignedData(unassigned_rows, unassigned_cols);
@@ -186,17 +238,20 @@ void GatedHungarianMatcher<T>::MatchInit() {
 template <typename T>
 void GatedHungarianMatcher<T>::ComputeConnectedComponents(
     std::vector<std::vector<size_t>>* row_components,
-    std::vector<std::vector<size_t>>* col_components) const {
+    std::vector<std::vector<size_t>>* col_components) {
   CHECK_NOTNULL(row_components);
   CHECK_NOTNULL(col_components);
 
   std::vector<std::vector<int>> nb_graph;
   nb_graph.resize(rows_num_ + cols_num_);
-  for (int i = 0; i < rows_num_; ++i) {
-    for (int j = 0; j < cols_num_; ++j) {
+  gated_cols_.resize(rows_num_);
+  for (size_t i = 0; i < rows_num_; ++i) {
+    gated_cols_[i].clear();
+    for (size_t j = 0; j < cols_num_; ++j) {
       if (is_valid_cost_(global_costs_(i, j))) {
-        nb_graph[i].push_back(static_cast<int>(rows_num_) + j);
-        nb_graph[j + rows_num_].push_back(i);
+        gated_cols_[i].push_back(j);
+        nb_graph[i].push_back(static_cast<int>(rows_num_ + j));
+        nb_graph[j + rows_num_].push_back(static_cast<int>(i));
       }
     }
   }
@@ -207,13 +262,15 @@ void GatedHungarianMatcher<T>::ComputeConnectedComponents(
   row_components->resize(components.size());
   col_components->clear();
   col_components->resize(components.size());
+  local_col_index_.resize(cols_num_);
   for (size_t i = 0; i < components.size(); ++i) {
     for (size_t j = 0; j < components[i].size(); ++j) {
       int id = components[i][j];
-      if (id < rows_num_) {
+      if (id < static_cast<int>(rows_num_)) {
         row_components->at(i).push_back(id);
       } else {
         id -= static_cast<int>(rows_num_);
+        local_col_index_[id] = col_components->at(i).size();
         col_components->at(i).push_back(id);
       }
     }
@@ -223,7 +280,9 @@ void GatedHungarianMatcher<T>::ComputeConnectedComponents(
 template <typename T>
 void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
+    const std::vector<size_t>& col_component,
+    HungarianOptimizer<T>* hungarian_optimizer, JVOptimizer<T>* jv_optimizer,
+    std::vector<std::pair<size_t, size_t>>* assignments) const {
   size_t local_rows_num = row_component.size();
   size_t local_cols_num = col_component.size();
 
@@ -236,17 +295,23 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     size_t idx_r = row_component[0];
     size_t idx_c = col_component[0];
     if (is_valid_cost_(global_costs_(idx_r, idx_c))) {
-      assignments_ptr_->push_back(std::make_pair(idx_r, idx_c));
+      assignments->push_back(std::make_pair(idx_r, idx_c));
     }
     return;
   }
 
-  /* update local cost matrix */
-  UpdateGatingLocalCostsMat(row_component, col_component);
-
-  /* get local assignments */
+  /* update local cost matrix and get local assignments */
   std::vector<std::pair<size_t, size_t>> local_assignments;
-  OptimizeAdapter(&local_assignments);
+  if (jv_min_component_size_ > 0 &&
+      std::max(local_rows_num, local_cols_num) >= jv_min_component_size_) {
+    UpdateGatingLocalCostsMat(row_component, col_component,
+                              jv_optimizer->costs());
+    OptimizeAdapter(jv_optimizer, &local_assignments);
+  } else {
+    UpdateGatingLocalCostsMat(row_component, col_component,
+                              hungarian_optimizer->costs());
+    OptimizeAdapter(hungarian_optimizer, &local_assignments);
+  }
 
   /* parse local assginments into global ones */
   for (size_t i = 0; i < local_assignments.size(); ++i) {
@@ -256,7 +321,43 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     if (!is_valid_cost_(global_costs_(global_row_idx, global_col_idx))) {
       continue;
     }
-    assignments_ptr_->push_back(std::make_pair(global_row_idx, global_col_idx));
+    assignments->push_back(std::make_pair(global_row_idx, global_col_idx));
+  }
+}
+
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeConnectedComponentsInParallel(
+    const std::vector<std::vector<size_t>>& row_components,
+    const std::vector<std::vector<size_t>>& col_components) {
+  const size_t components_num = row_components.size();
+  /* the largest components first, dealt round robin to the solvers */
+  std::vector<size_t> order(components_num);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return row_components[lhs].size() * col_components[lhs].size() >
+           row_components[rhs].size() * col_components[rhs].size();
+  });
+  const size_t solvers_num = std::min(num_parallel_solvers_, components_num);
+  while (solvers_.size() < solvers_num) {
+    solvers_.emplace_back(new Solver());
+  }
+
+  /* kept per component, so the result is the same as the sequential one */
+  std::vector<std::vector<std::pair<size_t, size_t>>> component_assignments(
+      components_num);
+  cyber::ParallelFor(0, solvers_num, 1, [&](size_t solver_idx) {
+    Solver* solver = solvers_[solver_idx].get();
+    for (size_t k = solver_idx; k < components_num; k += solvers_num) {
+      const size_t c = order[k];
+      OptimizeConnectedComponent(row_components[c], col_components[c],
+                                 &solver->hungarian_optimizer,
+                                 &solver->jv_optimizer,
+                                 &component_assignments[c]);
+    }
+  });
+  for (const auto& assignments : component_assignments) {
+    assignments_ptr_->insert(assignments_ptr_->end(), assignments.begin(),
+                             assignments.end());
   }
 }
 
@@ -291,31 +392,31 @@ void GatedHungarianMatcher<T>::GenerateUnassignedData(
 template <typename T>
 void GatedHungarianMatcher<T>::UpdateGatingLocalCostsMat(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
-  /* set the invalid cost to bound value */
-  SecureMat<T>* local_costs = optimizer_.costs();
+    const std::vector<size_t>& col_component,
+    SecureMat<T>* local_costs) const {
+  /* set the invalid cost to bound value, then copy the gated pairs */
   local_costs->Resize(row_component.size(), col_component.size());
   for (size_t i = 0; i < row_component.size(); ++i) {
     for (size_t j = 0; j < col_component.size(); ++j) {
-      T& current_cost = global_costs_(row_component[i], col_component[j]);
-      if (is_valid_cost_(current_cost)) {
-        (*local_costs)(i, j) = current_cost;
-      } else {
-        (*local_costs)(i, j) = bound_value_;
-      }
+      (*local_costs)(i, j) = bound_value_;
+    }
+    for (size_t col : gated_cols_[row_component[i]]) {
+      (*local_costs)(i, local_col_index_[col]) =
+          global_costs_(row_component[i], col);
     }
   }
-  return;
 }
 
 template <typename T>
+template <typename Optimizer>
 void GatedHungarianMatcher<T>::OptimizeAdapter(
-    std::vector<std::pair<size_t, size_t>>* local_assignments) {
+    Optimizer* optimizer,
+    std::vector<std::pair<size_t, size_t>>* local_assignments) const {
   CHECK_NOTNULL(local_assignments);
   if (opt_flag_ == OptimizeFlag::OPTMAX) {
-    optimizer_.Maximize(local_assignments);
+    optimizer->Maximize(local_assignments);
   } else {
-    optimizer_.Minimize(local_assignments);
+    optimizer->Minimize(local_assignments);
   }
 }
 
@@ -16,6 +16,8 @@
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 
+#include <random>
+
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 
@@ -551,6 +553,60 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+TEST_F(GatedHungarianMatcherTest, test_Match_parallel_jv) {
+  /* sparse gated costs forming many components of different sizes */
+  SecureMat<float>* global_costs = optimizer_->mutable_global_costs();
+  const size_t rows = 120;
+  const size_t cols = 100;
+  const float cost_thresh = 2.5f;
+  const float bound_value = 10.0f;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dist(0.0f, 2.4f);
+  global_costs->Resize(rows, cols);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      (*global_costs)(i, j) = bound_value;
+    }
+    /* rows of the same block of 10 gate the cols of the matching block */
+    for (size_t j = (i / 12) * 10; j < (i / 12) * 10 + 10; ++j) {
+      if ((i + j) % 3 != 0) {
+        (*global_costs)(i, j) = dist(gen);
+      }
+    }
+  }
+  auto total_cost = [&](const std::vector<std::pair<size_t, size_t>>& pairs) {
+    float sum = 0.0f;
+    for (const auto& pair : pairs) {
+      sum += (*global_costs)(pair.first, pair.second);
+    }
+    return sum;
+  };
+
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  optimizer_->Match(cost_thresh, bound_value,
+                    GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN,
+                    &assignments, &unassigned_rows, &unassigned_cols);
+
+  optimizer_->set_num_parallel_solvers(4);
+  optimizer_->set_jv_min_component_size(5);
+  std::vector<std::pair<size_t, size_t>> jv_assignments;
+  std::vector<size_t> jv_unassigned_rows;
+  std::vector<size_t> jv_unassigned_cols;
+  optimizer_->Match(cost_thresh, bound_value,
+                    GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN,
+                    &jv_assignments, &jv_unassigned_rows, &jv_unassigned_cols);
+
+  EXPECT_EQ(assignments.size(), jv_assignments.size());
+  EXPECT_EQ(unassigned_rows.size(), jv_unassigned_rows.size());
+  EXPECT_EQ(unassigned_cols.size(), jv_unassigned_cols.size());
+  EXPECT_NEAR(total_cost(assignments), total_cost(jv_assignments), 1e-3);
+  for (const auto& pair : jv_assignments) {
+    EXPECT_LT((*global_costs)(pair.first, pair.second), cost_thresh);
+  }
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
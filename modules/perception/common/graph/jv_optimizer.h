@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "modules/perception/common/graph/secure_matrix.h"
+
+namespace apollo {
+namespace perception {
+namespace common {
+
+/* Linear assignment by shortest augmenting paths with dual potentials, the
+ * core of the Jonker-Volgenant algorithm. It solves the same problems as
+ * HungarianOptimizer with the same interface, in O(n^2 * m) on an n x m
+ * matrix with n <= m, and does not pad rectangular matrices to square ones,
+ * so it is the better choice for large components. */
+template <typename T>
+class JVOptimizer {
+ public:
+  JVOptimizer() = default;
+  ~JVOptimizer() {}
+
+  SecureMat<T>* costs() { return &costs_; }
+
+  /* Every row (or col, whichever is fewer) is assigned, the assignments are
+   * sorted by row. */
+  void Maximize(std::vector<std::pair<size_t, size_t>>* assignments) {
+    Optimize(true, assignments);
+  }
+  void Minimize(std::vector<std::pair<size_t, size_t>>* assignments) {
+    Optimize(false, assignments);
+  }
+
+ private:
+  void Optimize(bool maximize,
+                std::vector<std::pair<size_t, size_t>>* assignments);
+
+  SecureMat<T> costs_;
+
+  /* dual potentials of rows and cols, index 0 is the virtual start col */
+  std::vector<double> row_potentials_;
+  std::vector<double> col_potentials_;
+  std::vector<double> min_slacks_;
+  std::vector<size_t> row_of_col_;
+  std::vector<size_t> prev_col_;
+  std::vector<bool> col_visited_;
+};  // class JVOptimizer
+
+template <typename T>
+void JVOptimizer<T>::Optimize(
+    bool maximize, std::vector<std::pair<size_t, size_t>>* assignments) {
+  assignments->clear();
+  const size_t height = costs_.height();
+  const size_t width = costs_.width();
+  if (height == 0 || width == 0) {
+    return;
+  }
+  /* the rows of the algorithm are the smaller side of the matrix */
+  const bool transposed = height > width;
+  const size_t n = transposed ? width : height;
+  const size_t m = transposed ? height : width;
+  const double sign = maximize ? -1.0 : 1.0;
+  auto cost = [&](size_t row, size_t col) {
+    return sign * static_cast<double>(transposed ? costs_(col - 1, row - 1)
+                                                 : costs_(row - 1, col - 1));
+  };
+
+  /* rows and cols are 1-based below, row 0 marks a free col */
+  const double kInf = std::numeric_limits<double>::infinity();
+  row_potentials_.assign(n + 1, 0.0);
+  col_potentials_.assign(m + 1, 0.0);
+  row_of_col_.assign(m + 1, 0);
+  prev_col_.assign(m + 1, 0);
+  for (size_t row = 1; row <= n; ++row) {
+    /* grow a shortest path tree from the new row until it reaches a free
+     * col, then flip the matching along the path */
+    row_of_col_[0] = row;
+    size_t col = 0;
+    min_slacks_.assign(m + 1, kInf);
+    col_visited_.assign(m + 1, false);
+    do {
+      col_visited_[col] = true;
+      const size_t tree_row = row_of_col_[col];
+      double delta = kInf;
+      size_t next_col = 0;
+      for (size_t j = 1; j <= m; ++j) {
+        if (col_visited_[j]) {
+          continue;
+        }
+        const double slack = cost(tree_row, j) - row_potentials_[tree_row] -
+                             col_potentials_[j];
+        if (slack < min_slacks_[j]) {
+          min_slacks_[j] = slack;
+          prev_col_[j] = col;
+        }
+        if (min_slacks_[j] < delta) {
+          delta = min_slacks_[j];
+          next_col = j;
+        }
+      }
+      for (size_t j = 0; j <= m; ++j) {
+        if (col_visited_[j]) {
+          row_potentials_[row_of_col_[j]] += delta;
+          col_potentials_[j] -= delta;
+        } else {
+          min_slacks_[j] -= delta;
+        }
+      }
+      col = next_col;
+    } while (row_of_col_[col] != 0);
+    do {
+      const size_t prev = prev_col_[col];
+      row_of_col_[col] = row_of_col_[prev];
+      col = prev;
+    } while (col != 0);
+  }
+
+  assignments->reserve(n);
+  for (size_t col = 1; col <= m; ++col) {
+    if (row_of_col_[col] == 0) {
+      continue;
+    }
+    if (transposed) {
+      assignments->emplace_back(col - 1, row_of_col_[col] - 1);
+    } else {
+      assignments->emplace_back(row_of_col_[col] - 1, col - 1);
+    }
+  }
+  std::sort(assignments->begin(), assignments->end());
+}
+
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
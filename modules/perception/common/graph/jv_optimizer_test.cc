@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/common/graph/jv_optimizer.h"
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace common {
+
+namespace {
+
+/* optimal total cost by trying every assignment of the rows to the cols,
+ * requires rows <= cols */
+float BruteForceCost(const SecureMat<float>& costs, size_t rows, size_t cols,
+                     bool maximize) {
+  std::vector<size_t> perm(cols);
+  for (size_t i = 0; i < cols; ++i) {
+    perm[i] = i;
+  }
+  float best = maximize ? -1e9f : 1e9f;
+  do {
+    float sum = 0.0f;
+    for (size_t i = 0; i < rows; ++i) {
+      sum += costs(i, perm[i]);
+    }
+    best = maximize ? std::max(best, sum) : std::min(best, sum);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+  return best;
+}
+
+}  // namespace
+
+TEST(JVOptimizerTest, test_Minimize) {
+  JVOptimizer<float> optimizer;
+  std::vector<std::pair<size_t, size_t>> assignments;
+
+  /* costs:
+   * 0.1,  1.0
+   * 1.0,  0.1 */
+  optimizer.costs()->Resize(2, 2);
+  (*optimizer.costs())(0, 0) = 0.1f;
+  (*optimizer.costs())(0, 1) = 1.0f;
+  (*optimizer.costs())(1, 0) = 1.0f;
+  (*optimizer.costs())(1, 1) = 0.1f;
+  optimizer.Minimize(&assignments);
+  ASSERT_EQ(2, assignments.size());
+  EXPECT_EQ(std::make_pair(size_t(0), size_t(0)), assignments[0]);
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(1)), assignments[1]);
+
+  optimizer.Maximize(&assignments);
+  ASSERT_EQ(2, assignments.size());
+  EXPECT_EQ(std::make_pair(size_t(0), size_t(1)), assignments[0]);
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(0)), assignments[1]);
+
+  /* more rows than cols, every col is assigned
+   * costs:
+   * 5.0
+   * 1.0
+   * 3.0 */
+  optimizer.costs()->Resize(3, 1);
+  (*optimizer.costs())(0, 0) = 5.0f;
+  (*optimizer.costs())(1, 0) = 1.0f;
+  (*optimizer.costs())(2, 0) = 3.0f;
+  optimizer.Minimize(&assignments);
+  ASSERT_EQ(1, assignments.size());
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(0)), assignments[0]);
+
+  optimizer.costs()->Resize(0, 0);
+  optimizer.Minimize(&assignments);
+  EXPECT_TRUE(assignments.empty());
+}
+
+TEST(JVOptimizerTest, test_random_against_brute_force) {
+  JVOptimizer<float> optimizer;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(0.0f, 10.0f);
+  for (int trial = 0; trial < 50; ++trial) {
+    const size_t rows = 1 + trial % 6;
+    const size_t cols = rows + trial % 3;
+    SecureMat<float>* costs = optimizer.costs();
+    costs->Resize(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        (*costs)(i, j) = dist(gen);
+      }
+    }
+    for (bool maximize : {false, true}) {
+      const float expected = BruteForceCost(*costs, rows, cols, maximize);
+      if (maximize) {
+        optimizer.Maximize(&assignments);
+      } else {
+        optimizer.Minimize(&assignments);
+      }
+      ASSERT_EQ(rows, assignments.size());
+      float sum = 0.0f;
+      std::vector<bool> col_used(cols, false);
+      for (const auto& assignment : assignments) {
+        EXPECT_FALSE(col_used[assignment.second]);
+        col_used[assignment.second] = true;
+        sum += (*costs)(assignment.first, assignment.second);
+      }
+      EXPECT_NEAR(expected, sum, 1e-4);
+    }
+  }
+}
+
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/common/i_lib/pc/i_ground.h"
 
+#include <smmintrin.h>
+
 #include <algorithm>
 #include <cfloat>
 
@@ -44,6 +46,8 @@ void PlaneFitGroundDetectorParam::SetDefault() {
   nr_ransac_iter_threshold = 32;
   candidate_filter_threshold = 1.0f;  // 1 meter
   nr_smooth_iter = 1;
+  use_temporal_prior = false;
+  prior_inlier_percen_threshold = 0.8f;  // 80%
 }
 
 bool PlaneFitGroundDetectorParam::Validate() const {
@@ -52,7 +56,7 @@ bool PlaneFitGroundDetectorParam::Validate() const {
       nr_samples_min_threshold == 0 || nr_samples_max_threshold == 0 ||
       nr_inliers_min_threshold == 0 || nr_ransac_iter_threshold == 0 ||
       roi_region_rad_x <= 0.f || roi_region_rad_y <= 0.f ||
-      roi_region_rad_z <= 0.f ||
+      roi_region_rad_z <= 0.f || prior_inlier_percen_threshold > 1.f ||
       planefit_dist_threshold_near > planefit_dist_threshold_far) {
     std::cerr << "Invalid ground detector parameters... " << std::endl;
     return false;
@@ -178,6 +182,19 @@ bool PlaneFitGroundDetector::Init() {
   if (!ground_planes_sphe_) {
     return false;
   }
+  // ground planes of the previous frame and their warm start priors:
+  prev_ground_planes_ =
+      IAlloc2<GroundPlaneLiDAR>(param_.nr_grids_coarse, param_.nr_grids_coarse);
+  if (!prev_ground_planes_) {
+    return false;
+  }
+  prior_planes_ =
+      IAlloc2<GroundPlaneLiDAR>(param_.nr_grids_coarse, param_.nr_grids_coarse);
+  if (!prior_planes_) {
+    return false;
+  }
+  has_prior_ = false;
+  IZero3(grid_translation_);
   ground_z_ = IAlloc2<std::pair<float, bool> >(param_.nr_grids_coarse,
                                                param_.nr_grids_coarse);
   if (!ground_z_) {
@@ -270,6 +287,8 @@ void PlaneFitGroundDetector::CleanUp() {
   }
   IFree2<GroundPlaneLiDAR>(&ground_planes_);
   IFree2<GroundPlaneSpherical>(&ground_planes_sphe_);
+  IFree2<GroundPlaneLiDAR>(&prev_ground_planes_);
+  IFree2<GroundPlaneLiDAR>(&prior_planes_);
   IFree2<std::pair<float, bool> >(&ground_z_);
   IFree2<PlaneFitPointCandIndices>(&local_candis_);
   IFreeAligned<float>(&pf_threeds_);
@@ -809,9 +828,44 @@ inline float calculate_two_angles(const GroundPlaneLiDAR &p1,
   return IAcos(numerator * IRec(denominator));
 }
 
+// count the points within dist_thre of the plane, four points at a time, the
+// distance is evaluated in the same order as IPlaneToPointDistanceWUnitNorm
+inline int count_plane_inliers(const float *plane, const float *threeds,
+                               int nr_samples, float dist_thre) {
+  static const int kNrBits[16] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                  1, 2, 2, 3, 2, 3, 3, 4};
+  const __m128 v_a = _mm_set_ps1(plane[0]);
+  const __m128 v_b = _mm_set_ps1(plane[1]);
+  const __m128 v_c = _mm_set_ps1(plane[2]);
+  const __m128 v_d = _mm_set_ps1(plane[3]);
+  const __m128 v_thre = _mm_set_ps1(dist_thre);
+  const __m128 v_abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const float *psrc = threeds;
+  int nr_inliers = 0;
+  int i = 0;
+  for (; i + 4 <= nr_samples; i += 4) {
+    __m128 v_x = _mm_setr_ps(psrc[0], psrc[3], psrc[6], psrc[9]);
+    __m128 v_y = _mm_setr_ps(psrc[1], psrc[4], psrc[7], psrc[10]);
+    __m128 v_z = _mm_setr_ps(psrc[2], psrc[5], psrc[8], psrc[11]);
+    __m128 v_dist = _mm_add_ps(_mm_mul_ps(v_a, v_x), _mm_mul_ps(v_b, v_y));
+    v_dist = _mm_add_ps(v_dist, _mm_mul_ps(v_c, v_z));
+    v_dist = _mm_and_ps(_mm_add_ps(v_dist, v_d), v_abs_mask);
+    nr_inliers += kNrBits[_mm_movemask_ps(_mm_cmplt_ps(v_dist, v_thre))];
+    psrc += 12;
+  }
+  for (; i < nr_samples; ++i) {
+    if (IPlaneToPointDistanceWUnitNorm(plane, psrc) < dist_thre) {
+      nr_inliers++;
+    }
+    psrc += 3;
+  }
+  return nr_inliers;
+}
+
 int PlaneFitGroundDetector::FitGridWithNeighbors(
     int r, int c, const float *point_cloud, GroundPlaneLiDAR *groundplane,
-    unsigned int nr_points, unsigned int nr_point_element, float dist_thre) {
+    unsigned int nr_points, unsigned int nr_point_element, float dist_thre,
+    const GroundPlaneLiDAR *prior) {
   // initialize the best plane
   groundplane->ForceInvalid();
   // not enough samples, failed and return
@@ -835,6 +889,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   int nr_inliers = 0;
   int nr_inliers_best = -1;
   float angle_best = FLT_MAX;
+  bool use_prior = false;
 
   int rseed = I_DEFAULT_SEED;
   int indices_trial[] = {0, 0, 0};
@@ -856,8 +911,23 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     ICopy3(point_cloud + (nr_point_element * candi[i]), pdst);
     pdst += dim_point_;
   }
+  // the plane of the previous frame still explains the cell, skip the
+  // hypotheses and only refine it
+  if (prior != nullptr && prior->IsValid()) {
+    nr_inliers = count_plane_inliers(prior->params, pf_threeds_, nr_samples,
+                                     dist_thre);
+    if (nr_inliers >= static_cast<int>(param_.nr_inliers_min_threshold) &&
+        static_cast<float>(nr_inliers) >=
+            static_cast<float>(nr_samples) *
+                param_.prior_inlier_percen_threshold) {
+      use_prior = true;
+      best = 0;
+      hypothesis[best] = *prior;
+      hypothesis[best].SetNrSupport(nr_inliers);
+    }
+  }
   // generate plane hypothesis and vote
-  for (int i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
+  for (int i = 0; i < param_.nr_ransac_iter_threshold && !use_prior; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
     ICopy3(pf_threeds_ + indices_trial[0], samples);
@@ -870,15 +940,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
-    nr_inliers = 0;
-    for (int j = 0; j < nr_samples; ++j) {
-      ptp_dist = IPlaneToPointDistanceWUnitNorm(hypothesis[i].params, psrc);
-      if (ptp_dist < dist_thre) {
-        nr_inliers++;
-      }
-      psrc += dim_point_;
-    }
+    nr_inliers = count_plane_inliers(hypothesis[i].params, pf_threeds_,
+                                     nr_samples, dist_thre);
     // Assign number of supports
     hypothesis[i].SetNrSupport(nr_inliers);
 
@@ -887,22 +950,15 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
   }
 
-  for (size_t i = 0; i < neighbors.size(); ++i) {
+  for (size_t i = 0; i < neighbors.size() && !use_prior; ++i) {
     r_n = neighbors[i].first;
     c_n = neighbors[i].second;
     if (ground_planes_[r_n][c_n].IsValid()) {
       hypothesis[i + param_.nr_ransac_iter_threshold] =
           ground_planes_[r_n][c_n];
-      psrc = pf_threeds_;
-      nr_inliers = 0;
-      for (int j = 0; j < nr_samples; ++j) {
-        ptp_dist = IPlaneToPointDistanceWUnitNorm(
-            hypothesis[i + param_.nr_ransac_iter_threshold].params, psrc);
-        if (ptp_dist < dist_thre) {
-          nr_inliers++;
-        }
-        psrc += dim_point_;
-      }
+      nr_inliers = count_plane_inliers(
+          hypothesis[i + param_.nr_ransac_iter_threshold].params, pf_threeds_,
+          nr_samples, dist_thre);
       if (nr_inliers < static_cast<int>(param_.nr_inliers_min_threshold)) {
         hypothesis[i + param_.nr_ransac_iter_threshold].ForceInvalid();
         continue;
@@ -912,7 +968,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   }
 
   nr_inliers_best = -1;
-  for (int i = 0; i < kNr_iter; ++i) {
+  for (int i = 0; i < kNr_iter && !use_prior; ++i) {
     if (!(hypothesis[i].IsValid())) {
       continue;
     }
@@ -1024,7 +1080,8 @@ int PlaneFitGroundDetector::FitInOrder() {
     c = order_table_[i].second;
     if (FitGridWithNeighbors(
             r, c, vg_coarse_->const_data(), &gp, vg_coarse_->NrPoints(),
-            vg_coarse_->NrPointElement(), pf_thresholds_[r][c]) >=
+            vg_coarse_->NrPointElement(), pf_thresholds_[r][c],
+            has_prior_ ? &prior_planes_[r][c] : nullptr) >=
         static_cast<int>(param_.nr_inliers_min_threshold)) {
       IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
       ground_planes_[r][c] = gp;
@@ -1037,6 +1094,40 @@ int PlaneFitGroundDetector::FitInOrder() {
   return nr_grids;
 }
 
+// Move the ground planes of the previous frame into the current grid. The grid
+// is axis aligned and only translates, a point p of the current grid is at
+// p + t in the previous one, so the plane n * p + d = 0 becomes
+// n * p + (d + n * t) = 0
+void PlaneFitGroundDetector::ComputePriorPlanes() {
+  unsigned int r = 0;
+  unsigned int c = 0;
+  int r_prev = 0;
+  int c_prev = 0;
+  float radius = 0.f;
+  float cx = 0.f;
+  float cy = 0.f;
+  for (r = 0; r < param_.nr_grids_coarse; ++r) {
+    for (c = 0; c < param_.nr_grids_coarse; ++c) {
+      GroundPlaneLiDAR &prior = prior_planes_[r][c];
+      prior.ForceInvalid();
+      const auto &voxel = (*vg_coarse_)(r, c);
+      radius = voxel.dim_x_ * 0.5f;
+      cx = voxel.v_[0] + radius + grid_translation_[0];
+      cy = voxel.v_[1] + radius + grid_translation_[1];
+      if (!vg_coarse_->GetVoxelCoordinateXY(cx, cy, &r_prev, &c_prev) ||
+          r_prev >= static_cast<int>(param_.nr_grids_coarse) ||
+          c_prev >= static_cast<int>(param_.nr_grids_coarse)) {
+        continue;
+      }
+      if (!prev_ground_planes_[r_prev][c_prev].IsValid()) {
+        continue;
+      }
+      prior = prev_ground_planes_[r_prev][c_prev];
+      prior.params[3] += IDot3(prior.params, grid_translation_);
+    }
+  }
+}
+
 void PlaneFitGroundDetector::GetNeighbors(
     int r, int c, int rows, int cols,
     std::vector<std::pair<int, int> > *neighbors) {
@@ -1239,24 +1330,24 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
   assert(nr_point_elements >= 3);
   // setup the fine voxel grid
   if (!vg_fine_->SetS(point_cloud, nr_points, nr_point_elements)) {
+    has_prior_ = false;
     return false;
   }
   // setup the coarse voxel grid
   if (!vg_coarse_->SetS(point_cloud, nr_points, nr_point_elements)) {
+    has_prior_ = false;
     return false;
   }
-  // int nr_candis = 0;
-  // int nr_valid_grid = 0;
   unsigned int r = 0;
   unsigned int c = 0;
   // Filter to generate plane fitting candidates
-  // int nr_candis = Filter();
-  // std::cout << "# of plane candidates: " << nr_candis << std::endl;
+  Filter();
+  // warm start the cells from the ground planes of the previous frame
+  if (param_.use_temporal_prior && has_prior_) {
+    ComputePriorPlanes();
+  }
   //  Fit local plane using ransac
-  // nr_valid_grid = Fit();
-  // int nr_valid_grid = FitInOrder();
-  // std::cout << "# of valid plane geometry (fitting): " << nr_valid_grid <<
-  // std::endl;
+  FitInOrder();
   // Smooth plane using neighborhood information:
   for (int iter = 0; iter < param_.nr_smooth_iter; ++iter) {
     Smooth();
@@ -1267,11 +1358,14 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
       if ((*vg_coarse_)(r, c).Empty()) {
         ground_planes_[r][c].ForceInvalid();
       }
+      if (param_.use_temporal_prior) {
+        prev_ground_planes_[r][c] = ground_planes_[r][c];
+      }
     }
   }
+  has_prior_ = param_.use_temporal_prior;
+  IZero3(grid_translation_);
 
-  // std::cout << "# of valid plane geometry (Smooth): " << nr_valid_grid <<
-  // std::endl;
   // compute point to ground distance
   ComputeSignedGroundHeight(point_cloud, height_above_ground, nr_points,
                             nr_point_elements);
@@ -1301,6 +1395,10 @@ const unsigned int PlaneFitGroundDetector::GetGridDimY() const {
 
 float PlaneFitGroundDetector::GetUnknownHeight() { return (FLT_MAX); }
 
+void PlaneFitGroundDetector::SetGridTranslation(const float *translation) {
+  ICopy3(translation, grid_translation_);
+}
+
 PlaneFitPointCandIndices **PlaneFitGroundDetector::GetCandis() const {
   return local_candis_;
 }
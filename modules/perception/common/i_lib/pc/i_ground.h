@@ -192,6 +192,9 @@ struct PlaneFitGroundDetectorParam {
   float candidate_filter_threshold;
   int nr_ransac_iter_threshold;
   int nr_smooth_iter;
+  // warm start each cell from the plane of the previous frame
+  bool use_temporal_prior;
+  float prior_inlier_percen_threshold;
 };
 
 struct PlaneFitPointCandIndices {
@@ -256,6 +259,10 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   const unsigned int GetGridDimY() const;
   float GetUnknownHeight();
   PlaneFitPointCandIndices **GetCandis() const;
+  // translation of the grid center since the previous Detect call, i.e. the
+  // current center minus the previous one, used to move the previous ground
+  // planes into the current grid
+  void SetGridTranslation(const float *translation);
 
  protected:
   void CleanUp();
@@ -273,7 +280,9 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   int FitGridWithNeighbors(int r, int c, const float *point_cloud,
                            GroundPlaneLiDAR *groundplane,
                            unsigned int nr_points,
-                           unsigned int nr_point_element, float dist_thre);
+                           unsigned int nr_point_element, float dist_thre,
+                           const GroundPlaneLiDAR *prior = nullptr);
+  void ComputePriorPlanes();
   void GetNeighbors(int r, int c, int rows, int cols,
                     std::vector<std::pair<int, int> > *neighbors);
   float CalculateAngleDist(const GroundPlaneLiDAR &plane,
@@ -314,6 +323,10 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   VoxelGridXY<float> *vg_coarse_;
   GroundPlaneLiDAR **ground_planes_;
   GroundPlaneSpherical **ground_planes_sphe_;
+  GroundPlaneLiDAR **prev_ground_planes_;
+  GroundPlaneLiDAR **prior_planes_;
+  bool has_prior_;
+  float grid_translation_[3];
   PlaneFitPointCandIndices **local_candis_;
   std::pair<float, bool> **ground_z_;
   float **pf_thresholds_;
@@ -34,5 +34,33 @@ DEFINE_string(config_manager_path, "./conf", "The ModelConfig config paths.");
 DEFINE_string(work_root, "",
               "Project work root direcotry.");
 
+// inference
+DEFINE_string(rt_engine_cache_dir, "",
+              "Directory of the serialized TensorRT engines, which are loaded "
+              "instead of being built again when the model, gpu and TensorRT "
+              "version match. Empty to always build the engines.");
+
+// association
+DEFINE_int32(association_parallel_solvers, 0,
+             "Number of solvers the independent components of the "
+             "track-object association are solved with concurrently, 0 or 1 "
+             "to solve them one by one.");
+DEFINE_int32(association_jv_min_component_size, 0,
+             "Association components with at least this many tracks or "
+             "objects are solved with the Jonker-Volgenant optimizer instead "
+             "of the hungarian one, 0 to never use it.");
+DEFINE_bool(association_enable_grid_gating, false,
+            "Gate the fusion track-object pairs on a spatial grid of the "
+            "object centers before computing their distances.");
+DEFINE_double(association_lidar_gate_radius, 30.0,
+              "Center distance in meters within which a fusion track is "
+              "compared with a lidar object when grid gating is enabled.");
+DEFINE_double(association_radar_gate_radius, 30.0,
+              "Center distance in meters within which a fusion track is "
+              "compared with a radar object when grid gating is enabled.");
+DEFINE_double(association_camera_gate_radius, 30.0,
+              "Center distance in meters within which a fusion track is "
+              "compared with a camera object when grid gating is enabled.");
+
 }  // namespace perception
 }  // namespace apollo
@@ -32,5 +32,16 @@ DECLARE_bool(enable_base_object_pool);
 DECLARE_string(config_manager_path);
 DECLARE_string(work_root);
 
+// inference
+DECLARE_string(rt_engine_cache_dir);
+
+// association
+DECLARE_int32(association_parallel_solvers);
+DECLARE_int32(association_jv_min_component_size);
+DECLARE_bool(association_enable_grid_gating);
+DECLARE_double(association_lidar_gate_radius);
+DECLARE_double(association_radar_gate_radius);
+DECLARE_double(association_camera_gate_radius);
+
 }  // namespace perception
 }  // namespace apollo
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/fusion/base/sensor.h"
 
+#include <algorithm>
+#include <utility>
 
 #include "cyber/common/log.h"
 
@@ -24,39 +26,54 @@ namespace fusion {
 
 size_t Sensor::kMaxCachedFrameNum = 10;
 
+const SensorFramePtr& SensorFrameView::operator[](size_t index) const {
+  return sensor_->frames_[sensor_->SlotIndex(first_ + index)];
+}
+
 void Sensor::QueryLatestFrames(double timestamp,
                                std::vector<SensorFramePtr>* frames) {
   CHECK_NOTNULL(frames);
 
+  SensorFrameView view;
+  QueryLatestFrames(timestamp, &view);
   frames->clear();
-  for (size_t i = 0; i < frames_.size(); i++) {
-    if (frames_[i]->GetTimestamp() > latest_query_timestamp_ &&
-        frames_[i]->GetTimestamp() <= timestamp) {
-      frames->push_back(frames_[i]);
-    }
+  for (size_t i = 0; i < view.size(); ++i) {
+    frames->push_back(view[i]);
   }
+}
+
+void Sensor::QueryLatestFrames(double timestamp, SensorFrameView* frames) {
+  CHECK_NOTNULL(frames);
+
+  const size_t begin = CountFramesUntil(latest_query_timestamp_);
+  const size_t end = CountFramesUntil(timestamp);
+  *frames = SensorFrameView(this, begin, end > begin ? end - begin : 0);
   latest_query_timestamp_ = timestamp;
 }
 
 SensorFramePtr Sensor::QueryLatestFrame(double timestamp) {
-  SensorFramePtr latest_frame = nullptr;
-  for (size_t i = 0; i < frames_.size(); i++) {
-    if (frames_[i]->GetTimestamp() > latest_query_timestamp_ &&
-        frames_[i]->GetTimestamp() <= timestamp) {
-      latest_frame = frames_[i];
-      latest_query_timestamp_ = frames_[i]->GetTimestamp();
-    }
+  const size_t begin = CountFramesUntil(latest_query_timestamp_);
+  const size_t end = CountFramesUntil(timestamp);
+  if (end <= begin) {
+    return nullptr;
   }
+  const SensorFramePtr& latest_frame = frames_[SlotIndex(end - 1)];
+  latest_query_timestamp_ = latest_frame->GetTimestamp();
   return latest_frame;
 }
 
 bool Sensor::GetPose(double timestamp, Eigen::Affine3d* pose) const {
   CHECK_NOTNULL(pose);
 
-  for (int i = static_cast<int>(frames_.size()) - 1; i >= 0; --i) {
-    double time_diff = timestamp - frames_[i]->GetTimestamp();
-    if (fabs(time_diff) < 1.0e-3) {  // > ?
-      return frames_[i]->GetPose(pose);
+  // the latest frame within 1 ms of timestamp
+  for (size_t i = CountFramesUntil(timestamp + 1.0e-3); i > 0; --i) {
+    const size_t slot = SlotIndex(i - 1);
+    double time_diff = timestamp - frame_timestamps_[slot];
+    if (time_diff >= 1.0e-3) {
+      break;
+    }
+    if (fabs(time_diff) < 1.0e-3) {
+      return frames_[slot]->GetPose(pose);
     }
   }
 
@@ -65,11 +82,66 @@ bool Sensor::GetPose(double timestamp, Eigen::Affine3d* pose) const {
 }
 
 void Sensor::AddFrame(const base::FrameConstPtr& frame_ptr) {
-  SensorFramePtr frame = std::make_shared<SensorFrame>(frame_ptr);
-  if (frames_.size() == kMaxCachedFrameNum) {
-    frames_.pop_front();
+  if (frames_.size() != kMaxCachedFrameNum) {
+    ResizeFrameSlots();
+  }
+  if (frames_.empty()) {
+    return;
+  }
+  if (frame_num_ == frames_.size()) {
+    // the slot of the oldest frame takes the new one
+    first_slot_ = SlotIndex(1);
+    --frame_num_;
+  }
+  size_t slot = SlotIndex(frame_num_);
+  SensorFramePtr& frame = frames_[slot];
+  if (frame == nullptr || frame.use_count() > 1) {
+    frame = std::make_shared<SensorFrame>();
+  }
+  frame->Initialize(frame_ptr);
+  frame_timestamps_[slot] = frame->GetTimestamp();
+
+  // frames mostly come in time order, an earlier one moves back into place
+  for (size_t i = frame_num_; i > 0; --i) {
+    const size_t prev_slot = SlotIndex(i - 1);
+    if (frame_timestamps_[prev_slot] <= frame_timestamps_[slot]) {
+      break;
+    }
+    std::swap(frames_[prev_slot], frames_[slot]);
+    std::swap(frame_timestamps_[prev_slot], frame_timestamps_[slot]);
+    slot = prev_slot;
+  }
+  ++frame_num_;
+}
+
+size_t Sensor::CountFramesUntil(double timestamp) const {
+  size_t low = 0;
+  size_t high = frame_num_;
+  while (low < high) {
+    const size_t mid = low + (high - low) / 2;
+    if (frame_timestamps_[SlotIndex(mid)] <= timestamp) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+void Sensor::ResizeFrameSlots() {
+  // keeps the latest frames which still fit
+  const size_t kept_num = std::min(frame_num_, kMaxCachedFrameNum);
+  std::vector<SensorFramePtr> frames(kMaxCachedFrameNum);
+  std::vector<double> frame_timestamps(kMaxCachedFrameNum, 0.0);
+  for (size_t i = 0; i < kept_num; ++i) {
+    const size_t slot = SlotIndex(frame_num_ - kept_num + i);
+    frames[i] = std::move(frames_[slot]);
+    frame_timestamps[i] = frame_timestamps_[slot];
   }
-  frames_.emplace_back(frame);
+  frames_.swap(frames);
+  frame_timestamps_.swap(frame_timestamps);
+  first_slot_ = 0;
+  frame_num_ = kept_num;
 }
 
 }  // namespace fusion
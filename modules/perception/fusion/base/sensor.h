@@ -16,7 +16,6 @@
 
 #pragma once
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +30,28 @@ namespace apollo {
 namespace perception {
 namespace fusion {
 
+// A view of consecutive cached frames of a sensor, oldest first, without
+// copying their pointers. It is valid until the next AddFrame of the sensor.
+class SensorFrameView {
+ public:
+  SensorFrameView() = default;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const SensorFramePtr& operator[](size_t index) const;
+
+ private:
+  friend class Sensor;
+
+  SensorFrameView(const Sensor* sensor, size_t first, size_t size)
+      : sensor_(sensor), first_(first), size_(size) {}
+
+  const Sensor* sensor_ = nullptr;
+  size_t first_ = 0;
+  size_t size_ = 0;
+};
+
 class Sensor {
  public:
   Sensor() = delete;
@@ -44,6 +65,7 @@ class Sensor {
   // query frames whose time stamp is in range
   // (_latest_fused_time_stamp, time_stamp]
   void QueryLatestFrames(double timestamp, std::vector<SensorFramePtr>* frames);
+  void QueryLatestFrames(double timestamp, SensorFrameView* frames);
 
   // query latest frame whose time stamp is in range
   // (_latest_fused_time_stamp, time_stamp]
@@ -59,6 +81,8 @@ class Sensor {
 
   void AddFrame(const base::FrameConstPtr& frame_ptr);
 
+  inline size_t GetCachedFrameNum() const { return frame_num_; }
+
   static void SetMaxCachedFrameNumber(size_t number) {
     kMaxCachedFrameNum = number;
   }
@@ -69,12 +93,29 @@ class Sensor {
 
  private:
   FRIEND_TEST(SensorTest, test);
+  friend class SensorFrameView;
+
+  // slot of the index-th oldest cached frame
+  inline size_t SlotIndex(size_t index) const {
+    return (first_slot_ + index) % frames_.size();
+  }
+
+  // number of cached frames not later than timestamp
+  size_t CountFramesUntil(double timestamp) const;
+
+  void ResizeFrameSlots();
 
   base::SensorInfo sensor_info_;
 
   double latest_query_timestamp_ = 0.0;
 
-  std::deque<SensorFramePtr> frames_;
+  // a ring of kMaxCachedFrameNum slots holding the cached frames in time
+  // order, with their timestamps beside them for the binary search; frames
+  // no one else holds are initialized again in place
+  std::vector<SensorFramePtr> frames_;
+  std::vector<double> frame_timestamps_;
+  size_t first_slot_ = 0;
+  size_t frame_num_ = 0;
 
   static size_t kMaxCachedFrameNum;
 };
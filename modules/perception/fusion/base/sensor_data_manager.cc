@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/fusion/base/sensor_data_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -91,6 +92,21 @@ void SensorDataManager::GetLatestSensorFrames(
   return it->second->QueryLatestFrames(timestamp, frames);
 }
 
+void SensorDataManager::GetLatestSensorFrames(double timestamp,
+                                              const std::string& sensor_id,
+                                              SensorFrameView* frames) const {
+  if (frames == nullptr) {
+    AERROR << "Nullptr error.";
+    return;
+  }
+  *frames = SensorFrameView();
+  const auto& it = sensors_.find(sensor_id);
+  if (it == sensors_.end()) {
+    return;
+  }
+  it->second->QueryLatestFrames(timestamp, frames);
+}
+
 void SensorDataManager::GetLatestFrames(
     double timestamp, std::vector<SensorFramePtr>* frames) const {
   if (frames == nullptr) {
@@ -99,6 +115,7 @@ void SensorDataManager::GetLatestFrames(
   }
 
   frames->clear();
+  frames->reserve(sensors_.size());
   for (auto it = sensors_.begin(); it != sensors_.end(); ++it) {
     SensorFramePtr frame = it->second->QueryLatestFrame(timestamp);
     if (frame != nullptr) {
@@ -106,17 +123,10 @@ void SensorDataManager::GetLatestFrames(
     }
   }
 
-  if (frames->empty()) {
-    return;
-  }
-
-  for (size_t i = 0; i < frames->size() - 1; ++i) {
-    for (size_t j = i + 1; j < frames->size(); ++j) {
-      if ((*frames)[j]->GetTimestamp() < (*frames)[i]->GetTimestamp()) {
-        std::swap((*frames)[j], (*frames)[i]);
-      }
-    }
-  }
+  std::sort(frames->begin(), frames->end(),
+            [](const SensorFramePtr& lhs, const SensorFramePtr& rhs) {
+              return lhs->GetTimestamp() < rhs->GetTimestamp();
+            });
 }
 
 bool SensorDataManager::GetPose(const std::string& sensor_id, double timestamp,
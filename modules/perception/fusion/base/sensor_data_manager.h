@@ -48,6 +48,8 @@ class SensorDataManager {
   // Getter
   void GetLatestSensorFrames(double timestamp, const std::string& sensor_id,
                              std::vector<SensorFramePtr>* frames) const;
+  void GetLatestSensorFrames(double timestamp, const std::string& sensor_id,
+                             SensorFrameView* frames) const;
 
   void GetLatestFrames(double timestamp,
                        std::vector<SensorFramePtr>* frames) const;
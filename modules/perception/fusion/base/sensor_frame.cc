@@ -39,6 +39,8 @@ void SensorFrame::Initialize(const base::FrameConstPtr& base_frame_ptr) {
   camera_frame_supplement_ = base_frame_ptr->camera_frame_supplement;
 
   const auto& base_objects = base_frame_ptr->objects;
+  foreground_objects_.clear();
+  background_objects_.clear();
   foreground_objects_.reserve(base_objects.size());
 
   for (const auto& base_obj : base_objects) {
@@ -46,11 +46,11 @@ TEST(SensorTest, test) {
   base_frame_2->objects.emplace_back(base_object_2);
 
   sensor_ptr->AddFrame(base_frame);
-  EXPECT_EQ(sensor_ptr->frames_.size(), 1);
+  EXPECT_EQ(sensor_ptr->GetCachedFrameNum(), 1);
   sensor_ptr->AddFrame(base_frame_2);
-  EXPECT_EQ(sensor_ptr->frames_.size(), 2);
+  EXPECT_EQ(sensor_ptr->GetCachedFrameNum(), 2);
   sensor_ptr->AddFrame(base_frame);
-  EXPECT_EQ(sensor_ptr->frames_.size(), 2);
+  EXPECT_EQ(sensor_ptr->GetCachedFrameNum(), 2);
 
   std::vector<SensorFramePtr> frame_vec;
   double query_timestamp = 7013;
@@ -83,6 +83,64 @@ TEST(SensorTest, test) {
   EXPECT_EQ(sensor_ptr->GetSensorType(), base::SensorType::VELODYNE_64);
 }
 
+TEST(SensorTest, frame_view) {
+  base::SensorInfo sensor_info;
+  sensor_info.name = "test";
+  sensor_info.type = base::SensorType::VELODYNE_64;
+  Sensor sensor(sensor_info);
+  Sensor::SetMaxCachedFrameNumber(3);
+
+  auto add_frame = [&sensor](double timestamp) {
+    base::FramePtr base_frame(new base::Frame());
+    base_frame->timestamp = timestamp;
+    base_frame->sensor2world_pose = Eigen::Affine3d::Identity();
+    base_frame->objects.emplace_back(new base::Object());
+    sensor.AddFrame(base_frame);
+  };
+  // an earlier frame is kept in time order
+  add_frame(1.0);
+  add_frame(3.0);
+  add_frame(2.0);
+  SensorFrameView view;
+  sensor.QueryLatestFrames(2.5, &view);
+  ASSERT_EQ(view.size(), 2);
+  EXPECT_DOUBLE_EQ(view[0]->GetTimestamp(), 1.0);
+  EXPECT_DOUBLE_EQ(view[1]->GetTimestamp(), 2.0);
+
+  // the oldest frame gives its slot to the new one, a frame no one else
+  // holds is initialized in place
+  const SensorFrame* oldest_frame = view[0].get();
+  add_frame(4.0);
+  EXPECT_EQ(sensor.GetCachedFrameNum(), 3);
+  sensor.QueryLatestFrames(5.0, &view);
+  ASSERT_EQ(view.size(), 2);
+  EXPECT_DOUBLE_EQ(view[0]->GetTimestamp(), 3.0);
+  EXPECT_DOUBLE_EQ(view[1]->GetTimestamp(), 4.0);
+  EXPECT_EQ(view[1].get(), oldest_frame);
+  EXPECT_EQ(view[1]->GetForegroundObjects().size(), 1);
+
+  // a frame still held is left alone
+  SensorFramePtr held_frame = view[0];
+  add_frame(5.0);
+  add_frame(6.0);
+  EXPECT_DOUBLE_EQ(held_frame->GetTimestamp(), 3.0);
+  sensor.SetLatestQueryTimestamp(0.0);
+  sensor.QueryLatestFrames(10.0, &view);
+  ASSERT_EQ(view.size(), 3);
+  EXPECT_DOUBLE_EQ(view[0]->GetTimestamp(), 4.0);
+  EXPECT_DOUBLE_EQ(view[2]->GetTimestamp(), 6.0);
+  EXPECT_NE(view[2].get(), held_frame.get());
+
+  Eigen::Affine3d pose;
+  EXPECT_TRUE(sensor.GetPose(5.0005, &pose));
+  EXPECT_FALSE(sensor.GetPose(5.5, &pose));
+  Sensor::SetMaxCachedFrameNumber(2);
+  add_frame(7.0);
+  EXPECT_EQ(sensor.GetCachedFrameNum(), 2);
+  EXPECT_FALSE(sensor.GetPose(5.0, &pose));
+  EXPECT_TRUE(sensor.GetPose(6.0, &pose));
+}
+
 }  // namespace fusion
 }  // namespace perception
 }  // namespace apollo
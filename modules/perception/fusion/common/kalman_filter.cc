@@ -113,10 +113,14 @@ bool KalmanFilter::Correct(const Eigen::VectorXd &cur_observation,
 
   cur_observation_ = cur_observation;
   cur_observation_uncertainty_ = cur_observation_uncertainty;
-  kalman_gain_ = global_uncertainty_ * c_matrix_.transpose() *
-                 (c_matrix_ * global_uncertainty_ * c_matrix_.transpose() +
-                  cur_observation_uncertainty_)
-                     .inverse();
+  // the innovation covariance is symmetric, so the gain is solved for with
+  // a decomposition of it rather than multiplied by its inverse
+  const Eigen::MatrixXd innovation_uncertainty =
+      c_matrix_ * global_uncertainty_ * c_matrix_.transpose() +
+      cur_observation_uncertainty_;
+  kalman_gain_ = innovation_uncertainty.ldlt()
+                     .solve(c_matrix_ * global_uncertainty_.transpose())
+                     .transpose();
   global_states_ = global_states_ + kalman_gain_ * (cur_observation_ -
                                                     c_matrix_ * global_states_);
   Eigen::MatrixXd tmp_identity;
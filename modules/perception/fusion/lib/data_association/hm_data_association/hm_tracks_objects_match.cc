@@ -15,7 +15,12 @@
  *****************************************************************************/
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <unordered_map>
 #include <utility>
 
 #include "modules/perception/common/graph/secure_matrix.h"
@@ -32,6 +37,28 @@ double HMTrackersObjectsAssociation::s_match_distance_bound_ = 100.0;
 double HMTrackersObjectsAssociation::s_association_center_dist_threshold_ =
     30.0;
 
+namespace {
+
+// gate radius of the association grid for the sensor of the objects
+double GateRadius(const SensorObjectConstPtr& sensor_object) {
+  if (IsLidar(sensor_object)) {
+    return FLAGS_association_lidar_gate_radius;
+  }
+  if (IsRadar(sensor_object)) {
+    return FLAGS_association_radar_gate_radius;
+  }
+  if (IsCamera(sensor_object)) {
+    return FLAGS_association_camera_gate_radius;
+  }
+  return std::numeric_limits<double>::max();
+}
+
+int64_t GridCellKey(int64_t cell_x, int64_t cell_y) {
+  return (cell_x << 32) ^ (cell_y & 0xffffffff);
+}
+
+}  // namespace
+
 template <typename T>
 void extract_vector(const std::vector<T>& vec,
                     const std::vector<size_t>& subset_inds,
@@ -305,32 +332,80 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
   Eigen::Vector3d tmp = Eigen::Vector3d::Zero();
   opt.ref_point = &tmp;
   association_mat->resize(unassigned_tracks.size());
+  for (auto& row : *association_mat) {
+    row.assign(unassigned_measurements.size(), s_match_distance_thresh_);
+  }
+  double center_dist_threshold = s_association_center_dist_threshold_;
+  auto compute_distance = [&](size_t i, size_t j) {
+    const TrackPtr& fusion_track = fusion_tracks[unassigned_tracks[i]];
+    const SensorObjectPtr& sensor_object =
+        sensor_objects[unassigned_measurements[j]];
+    double distance = s_match_distance_thresh_;
+    double center_dist =
+        (sensor_object->GetBaseObject()->center -
+         fusion_track->GetFusedObject()->GetBaseObject()->center)
+            .norm();
+    if (center_dist < center_dist_threshold) {
+      distance =
+          track_object_distance_.Compute(fusion_track, sensor_object, opt);
+    } else {
+      ADEBUG << "center_distance " << center_dist
+             << " exceeds slack threshold " << center_dist_threshold
+             << ", track_id: " << fusion_track->GetTrackId()
+             << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
+    }
+    (*association_mat)[i][j] = distance;
+    ADEBUG << "track_id: " << fusion_track->GetTrackId()
+           << ", obs_id: " << sensor_object->GetBaseObject()->track_id
+           << ", distance: " << distance;
+  };
+
+  if (FLAGS_association_enable_grid_gating &&
+      !unassigned_measurements.empty()) {
+    center_dist_threshold =
+        std::min(center_dist_threshold,
+                 GateRadius(sensor_objects[unassigned_measurements[0]]));
+  }
+  if (!FLAGS_association_enable_grid_gating || center_dist_threshold <= 0.0 ||
+      unassigned_tracks.empty() || unassigned_measurements.empty()) {
+    for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
+      for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
+        compute_distance(i, j);
+      }
+    }
+    return;
+  }
+
+  // a pair whose centers are closer than the gate radius lies in the same
+  // or a neighboring cell of a grid with cells of that size, the other
+  // pairs keep the default distance without being computed
+  const double cell_size = center_dist_threshold;
+  auto to_cell = [cell_size](double value) {
+    return static_cast<int64_t>(std::floor(value / cell_size));
+  };
+  std::unordered_map<int64_t, std::vector<size_t>> grid;
+  for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
+    const Eigen::Vector3d& center =
+        sensor_objects[unassigned_measurements[j]]->GetBaseObject()->center;
+    grid[GridCellKey(to_cell(center.x()), to_cell(center.y()))].push_back(j);
+  }
   for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
-    int fusion_idx = static_cast<int>(unassigned_tracks[i]);
-    (*association_mat)[i].resize(unassigned_measurements.size());
-    const TrackPtr& fusion_track = fusion_tracks[fusion_idx];
-    for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
-      int sensor_idx = static_cast<int>(unassigned_measurements[j]);
-      const SensorObjectPtr& sensor_object = sensor_objects[sensor_idx];
-      double distance = s_match_distance_thresh_;
-      double center_dist =
-          (sensor_object->GetBaseObject()->center -
-           fusion_track->GetFusedObject()->GetBaseObject()->center)
-              .norm();
-      if (center_dist < s_association_center_dist_threshold_) {
-        distance =
-            track_object_distance_.Compute(fusion_track, sensor_object, opt);
-      } else {
-        ADEBUG << "center_distance " << center_dist
-               << " exceeds slack threshold "
-               << s_association_center_dist_threshold_
-               << ", track_id: " << fusion_track->GetTrackId()
-               << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
+    const Eigen::Vector3d& center = fusion_tracks[unassigned_tracks[i]]
+                                        ->GetFusedObject()
+                                        ->GetBaseObject()
+                                        ->center;
+    const int64_t cell_x = to_cell(center.x());
+    const int64_t cell_y = to_cell(center.y());
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        auto cell = grid.find(GridCellKey(cell_x + dx, cell_y + dy));
+        if (cell == grid.end()) {
+          continue;
+        }
+        for (size_t j : cell->second) {
+          compute_distance(i, j);
+        }
       }
-      (*association_mat)[i][j] = distance;
-      ADEBUG << "track_id: " << fusion_track->GetTrackId()
-             << ", obs_id: " << sensor_object->GetBaseObject()->track_id
-             << ", distance: " << distance;
     }
   }
 }
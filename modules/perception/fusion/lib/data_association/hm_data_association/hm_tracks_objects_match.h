@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/track_object_distance.h"
 #include "modules/perception/fusion/lib/interface/base_data_association.h"
 
@@ -37,6 +38,9 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
   bool Init() override {
     track_object_distance_.set_distance_thresh(
       static_cast<float>(s_match_distance_thresh_));
+    optimizer_.set_num_parallel_solvers(FLAGS_association_parallel_solvers);
+    optimizer_.set_jv_min_component_size(
+        FLAGS_association_jv_min_component_size);
     return true;
   }
 
@@ -18,6 +18,7 @@
 #include <map>
 #include <utility>
 
+#include "cyber/task/task.h"
 #include "modules/common/time/time_util.h"
 #include "modules/common/util/file.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -38,6 +39,13 @@ namespace fusion {
 
 using apollo::common::util::GetAbsolutePath;
 
+namespace {
+
+// tracks updated by one task of the parallel track update
+constexpr size_t kTrackUpdateGrainSize = 8;
+
+}  // namespace
+
 ProbabilisticFusion::ProbabilisticFusion() {}
 
 ProbabilisticFusion::~ProbabilisticFusion() {}
@@ -69,6 +77,7 @@ bool ProbabilisticFusion::Init(const FusionInitOptions& init_options) {
   for (int i = 0; i < params.prohibition_sensors_size(); ++i) {
     params_.prohibition_sensors.push_back(params.prohibition_sensors(i));
   }
+  params_.parallel_fusion = params.parallel_fusion();
 
   // static member initialization from PB config
   Track::SetMaxLidarInvisiblePeriod(params.max_lidar_invisible_period());
@@ -148,14 +157,15 @@ bool ProbabilisticFusion::Fuse(const FusionOptions& options,
   // 2. query related sensor_frames for fusion
   fuse_mutex_.lock();
   double fusion_time = sensor_frame->timestamp;
-  std::vector<SensorFramePtr> frames;
-  sensor_data_manager->GetLatestFrames(fusion_time, &frames);
-  AINFO << "Get " << frames.size() << " related frames for fusion";
+  sensor_data_manager->GetLatestFrames(fusion_time, &frames_);
+  AINFO << "Get " << frames_.size() << " related frames for fusion";
 
   // 3. peform fusion on related frames
-  for (size_t i = 0; i < frames.size(); ++i) {
-    this->FuseFrame(frames[i]);
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    this->FuseFrame(frames_[i]);
   }
+  // released for the sensors to reuse
+  frames_.clear();
 
   // 4. collect fused objects
   this->CollectFusedObjects(fusion_time, fused_objects);
@@ -188,35 +198,53 @@ void ProbabilisticFusion::FuseFrame(const SensorFramePtr& frame) {
            << ", background_object_number: "
            << frame->GetBackgroundObjects().size()
            << ", timestamp: " << GLOG_TIMESTAMP(frame->GetTimestamp());
-  this->FuseForegroundTrack(frame);
-  this->FusebackgroundTrack(frame);
+  if (params_.parallel_fusion) {
+    // the foreground and the background tracks are disjoint, their update
+    // overlaps. New tracks are created afterwards in the serial order, so
+    // the track ids do not depend on the scheduling.
+    AssociationResult association_result;
+    std::vector<size_t> unassigned_background_obj_inds;
+    cyber::ParallelFor(0, 2, 1, [&](size_t i) {
+      if (i == 0) {
+        this->UpdateForegroundTracks(frame, &association_result);
+      } else {
+        this->UpdateBackgroundTracks(frame, &unassigned_background_obj_inds);
+      }
+    });
+    this->CreateNewTracks(frame, association_result.unassigned_measurements);
+    this->CreateBackgroundTracks(frame, unassigned_background_obj_inds);
+  } else {
+    this->FuseForegroundTrack(frame);
+    this->FusebackgroundTrack(frame);
+  }
   this->RemoveLostTrack();
 }
 
 void ProbabilisticFusion::FuseForegroundTrack(const SensorFramePtr& frame) {
+  AssociationResult association_result;
+  this->UpdateForegroundTracks(frame, &association_result);
+  this->CreateNewTracks(frame, association_result.unassigned_measurements);
+}
+
+void ProbabilisticFusion::UpdateForegroundTracks(
+    const SensorFramePtr& frame, AssociationResult* association_result) {
   PERCEPTION_PERF_BLOCK_START();
   std::string indicator = "fusion_" + frame->GetSensorId();
 
   AssociationOptions options;
-  AssociationResult association_result;
-  matcher_->Associate(options, frame, scenes_, &association_result);
+  matcher_->Associate(options, frame, scenes_, association_result);
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "association");
 
   const std::vector<TrackMeasurmentPair>& assignments =
-      association_result.assignments;
+      association_result->assignments;
   this->UpdateAssignedTracks(frame, assignments);
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "update_assigned_track");
 
   const std::vector<size_t>& unassigned_track_inds =
-      association_result.unassigned_tracks;
+      association_result->unassigned_tracks;
   this->UpdateUnassignedTracks(frame, unassigned_track_inds);
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator,
                                            "update_unassigned_track");
-
-  const std::vector<size_t>& unassigned_obj_inds =
-      association_result.unassigned_measurements;
-  this->CreateNewTracks(frame, unassigned_obj_inds);
-  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(indicator, "create_track");
 }
 
 void ProbabilisticFusion::UpdateAssignedTracks(
@@ -228,11 +256,20 @@ void ProbabilisticFusion::UpdateAssignedTracks(
   // which only has a small difference compared with actural match_distance
   TrackerOptions options;
   options.match_distance = 0;
-  for (size_t i = 0; i < assignments.size(); ++i) {
+  // every track is assigned at most once and owns its tracker, so the
+  // updates are independent
+  auto update = [&](size_t i) {
     size_t track_ind = assignments[i].first;
     size_t obj_ind = assignments[i].second;
     trackers_[track_ind]->UpdateWithMeasurement(
         options, frame->GetForegroundObjects()[obj_ind], frame->GetTimestamp());
+  };
+  if (params_.parallel_fusion) {
+    cyber::ParallelFor(0, assignments.size(), kTrackUpdateGrainSize, update);
+  } else {
+    for (size_t i = 0; i < assignments.size(); ++i) {
+      update(i);
+    }
   }
 }
 
@@ -247,10 +284,18 @@ void ProbabilisticFusion::UpdateUnassignedTracks(
   TrackerOptions options;
   options.match_distance = 0;
   std::string sensor_id = frame->GetSensorId();
-  for (size_t i = 0; i < unassigned_track_inds.size(); ++i) {
+  auto update = [&](size_t i) {
     size_t track_ind = unassigned_track_inds[i];
     trackers_[track_ind]->UpdateWithoutMeasurement(
         options, sensor_id, frame->GetTimestamp(), frame->GetTimestamp());
+  };
+  if (params_.parallel_fusion) {
+    cyber::ParallelFor(0, unassigned_track_inds.size(), kTrackUpdateGrainSize,
+                       update);
+  } else {
+    for (size_t i = 0; i < unassigned_track_inds.size(); ++i) {
+      update(i);
+    }
   }
 }
 
@@ -288,6 +333,13 @@ void ProbabilisticFusion::CreateNewTracks(
 }
 
 void ProbabilisticFusion::FusebackgroundTrack(const SensorFramePtr& frame) {
+  std::vector<size_t> unassigned_obj_inds;
+  this->UpdateBackgroundTracks(frame, &unassigned_obj_inds);
+  this->CreateBackgroundTracks(frame, unassigned_obj_inds);
+}
+
+void ProbabilisticFusion::UpdateBackgroundTracks(
+    const SensorFramePtr& frame, std::vector<size_t>* unassigned_obj_inds) {
   // 1. association
   size_t track_size = scenes_->GetBackgroundTracks().size();
   size_t obj_size = frame->GetBackgroundObjects().size();
@@ -332,16 +384,26 @@ void ProbabilisticFusion::FusebackgroundTrack(const SensorFramePtr& frame) {
     }
   }
 
-  // 4. create new track
+  unassigned_obj_inds->clear();
   for (size_t i = 0; i < object_tag.size(); ++i) {
     if (!object_tag[i]) {
-      TrackPtr track = TrackPool::Instance().Get();
-      track->Initialize(frame->GetBackgroundObjects()[i], true);
-      scenes_->AddBackgroundTrack(track);
+      unassigned_obj_inds->push_back(i);
     }
   }
 }
 
+void ProbabilisticFusion::CreateBackgroundTracks(
+    const SensorFramePtr& frame,
+    const std::vector<size_t>& unassigned_obj_inds) {
+  // 4. create new track
+  for (size_t i = 0; i < unassigned_obj_inds.size(); ++i) {
+    TrackPtr track = TrackPool::Instance().Get();
+    track->Initialize(frame->GetBackgroundObjects()[unassigned_obj_inds[i]],
+                      true);
+    scenes_->AddBackgroundTrack(track);
+  }
+}
+
 void ProbabilisticFusion::RemoveLostTrack() {
   // need to remove tracker at the same time
   size_t foreground_track_count = 0;
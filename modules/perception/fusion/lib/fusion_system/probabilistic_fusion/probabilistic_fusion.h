@@ -37,6 +37,8 @@ struct FusionParams {
   std::string data_association_method;
   std::string gate_keeper_method;
   std::vector<std::string> prohibition_sensors;
+  // update the tracks of a frame on the cyber task pool
+  bool parallel_fusion = false;
 };
 
 class ProbabilisticFusion : public BaseFusionSystem {
@@ -66,6 +68,15 @@ class ProbabilisticFusion : public BaseFusionSystem {
   void FuseForegroundTrack(const SensorFramePtr& frame);
   void FusebackgroundTrack(const SensorFramePtr& frame);
 
+  // association and update of the existing tracks, the unassigned objects
+  // are left for the track creation
+  void UpdateForegroundTracks(const SensorFramePtr& frame,
+                              AssociationResult* association_result);
+  void UpdateBackgroundTracks(const SensorFramePtr& frame,
+                              std::vector<size_t>* unassigned_obj_inds);
+  void CreateBackgroundTracks(const SensorFramePtr& frame,
+                              const std::vector<size_t>& unassigned_obj_inds);
+
   void RemoveLostTrack();
 
   void UpdateAssignedTracks(
@@ -91,6 +102,9 @@ class ProbabilisticFusion : public BaseFusionSystem {
 
   bool started_ = false;
 
+  // the frames of a fusion, under fuse_mutex_, kept for their capacity
+  std::vector<SensorFramePtr> frames_;
+
   ScenePtr scenes_ = nullptr;
   std::vector<std::shared_ptr<BaseTracker>> trackers_;  // for foreground
 
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #define private public
 #define protected public
 #include "modules/perception/base/sensor_meta.h"
@@ -244,6 +246,72 @@ TEST(ProbabliticFusionTest, test_update) {
   // EXPECT_EQ(pf.scenes_->GetBackgroundTracks().size(), 1);
 }
 
+TEST(ProbabliticFusionTest, test_parallel_update) {
+  FLAGS_work_root = "/apollo/modules/perception/testdata/"
+      "fusion/probabilistic_fusion";
+  FLAGS_obs_sensor_meta_path = "./data/sensor_meta.pt";
+  FLAGS_obs_sensor_intrinsic_path =
+      "/apollo/modules/perception/testdata/fusion/probabilistic_fusion/params";
+  SensorDataManager* sensor_manager = SensorDataManager::Instance();
+  sensor_manager->Reset();
+  sensor_manager->Init();
+  FusionInitOptions init_options;
+  init_options.main_sensor = "velodyne64";
+  ProbabilisticFusion pf;
+  EXPECT_TRUE(pf.Init(init_options));
+  pf.params_.parallel_fusion = true;
+
+  base::SensorInfo sensor_info;
+  sensor_info.type = base::SensorType::VELODYNE_64;
+  sensor_info.name = "velodyne64";
+
+  // enough foreground tracks to be split over several tasks
+  const int kNumForeground = 20;
+  const int kNumBackground = 5;
+  FusionOptions options;
+  std::vector<base::ObjectPtr> fused_objects;
+  for (int frame_id = 0; frame_id < 2; ++frame_id) {
+    base::FramePtr frame(new base::Frame);
+    frame->sensor_info = sensor_info;
+    frame->timestamp = 151192277.124567989 + 0.1 * frame_id;
+    frame->sensor2world_pose = Eigen::Matrix4d::Identity();
+    for (int i = 0; i < kNumForeground + kNumBackground; ++i) {
+      base::ObjectPtr object(new base::Object);
+      object->center = Eigen::Vector3d(10, 5.0 * i, 0);
+      object->anchor_point = object->center;
+      object->track_id = i;
+      object->polygon.resize(3);
+      for (size_t k = 0; k < 3; ++k) {
+        object->polygon[k].x = 10;
+        object->polygon[k].y = 5.0 * i;
+        object->polygon[k].z = 0;
+      }
+      if (i >= kNumForeground) {
+        object->lidar_supplement.on_use = true;
+        object->lidar_supplement.is_background = true;
+      }
+      frame->objects.push_back(object);
+    }
+    fused_objects.clear();
+    EXPECT_TRUE(pf.Fuse(options, frame, &fused_objects));
+    EXPECT_EQ(pf.trackers_.size(), kNumForeground);
+    EXPECT_EQ(pf.scenes_->GetBackgroundTracks().size(), kNumBackground);
+    EXPECT_EQ(fused_objects.size(), kNumForeground + kNumBackground);
+  }
+  // every foreground track follows its own object
+  std::vector<double> track_y;
+  for (const auto& tracker : pf.trackers_) {
+    const auto& anchor_point =
+        tracker->track_->GetFusedObject()->GetBaseObject()->anchor_point;
+    EXPECT_FLOAT_EQ(anchor_point[0], 10.0);
+    track_y.push_back(anchor_point[1]);
+  }
+  std::sort(track_y.begin(), track_y.end());
+  for (int i = 0; i < kNumForeground; ++i) {
+    EXPECT_FLOAT_EQ(track_y[i], 5.0 * i);
+  }
+}
+
 TEST(ProbabilisticFusionTest, test_collect_sensor_measurement) {
   FLAGS_work_root = "/apollo/modules/perception/testdata/"
       "fusion/probabilistic_fusion";
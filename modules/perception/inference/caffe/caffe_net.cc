@@ -16,7 +16,11 @@
 
 #include "modules/perception/inference/caffe/caffe_net.h"
 
+#include <algorithm>
+#include <set>
+
 #include "cyber/common/log.h"
+#include "modules/perception/inference/utils/memory_planner.h"
 
 namespace apollo {
 namespace perception {
@@ -26,11 +30,30 @@ CaffeNet::CaffeNet(const std::string &net_file, const std::string &model_file,
                    const std::vector<std::string> &outputs)
     : net_file_(net_file), model_file_(model_file), output_names_(outputs) {}
 
+CaffeNet::~CaffeNet() {
+  if (done_ != nullptr) {
+    cudaEventDestroy(done_);
+  }
+  if (stream_ != nullptr) {
+    cudaStreamDestroy(stream_);
+  }
+}
+
 bool CaffeNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
   if (gpu_id_ >= 0) {
     caffe::Caffe::SetDevice(gpu_id_);
     caffe::Caffe::set_mode(caffe::Caffe::GPU);
     caffe::Caffe::DeviceQuery();
+    // a blocking stream, ordered with the layers caffe launches on the
+    // default stream
+    if (stream_ == nullptr && cudaStreamCreate(&stream_) != cudaSuccess) {
+      stream_ = nullptr;
+    }
+    if (done_ == nullptr &&
+        cudaEventCreateWithFlags(&done_, cudaEventDisableTiming) !=
+            cudaSuccess) {
+      done_ = nullptr;
+    }
   } else {
     caffe::Caffe::set_mode(caffe::Caffe::CPU);
   }
@@ -92,16 +115,124 @@ bool CaffeNet::reshape() {
     auto caffe_blob = net_->blob_by_name(name);
     if (caffe_blob != nullptr && blob != nullptr) {
       caffe_blob->Reshape(blob->shape());
-      cudaMemcpy(caffe_blob->mutable_gpu_data(), blob->gpu_data(),
-                 caffe_blob->count() * sizeof(float), cudaMemcpyDeviceToDevice);
+      cudaMemcpyAsync(caffe_blob->mutable_gpu_data(), blob->gpu_data(),
+                      caffe_blob->count() * sizeof(float),
+                      cudaMemcpyDeviceToDevice, stream_);
     }
   }
   net_->Reshape();
+  if (gpu_id_ >= 0 && reuse_memory_) {
+    PlanMemory();
+  }
 
   return true;
 }
 
+void CaffeNet::PlanMemory() {
+  const auto &net_blobs = net_->blobs();
+  std::vector<int> counts(net_blobs.size());
+  for (size_t i = 0; i < net_blobs.size(); ++i) {
+    counts[i] = net_blobs[i]->count();
+  }
+  if (counts == planned_counts_) {
+    return;
+  }
+
+  // blobs read or written outside of the net keep their own memory
+  const int num_blobs = static_cast<int>(net_blobs.size());
+  std::vector<bool> excluded(num_blobs, false);
+  for (int id : net_->input_blob_indices()) {
+    excluded[id] = true;
+  }
+  for (int id : net_->output_blob_indices()) {
+    excluded[id] = true;
+  }
+  for (int id = 0; id < num_blobs; ++id) {
+    const std::string &name = net_->blob_names()[id];
+    if (std::find(input_names_.begin(), input_names_.end(), name) !=
+            input_names_.end() ||
+        std::find(output_names_.begin(), output_names_.end(), name) !=
+            output_names_.end()) {
+      excluded[id] = true;
+    }
+  }
+
+  // the tops of these layers share the data of their bottom, all of them
+  // live on the memory of the root
+  static const std::set<std::string> kSharingLayers = {"Flatten", "Reshape",
+                                                       "Split"};
+  std::vector<int> root(num_blobs);
+  std::vector<BlobLifetime> lifetimes(num_blobs);
+  for (int id = 0; id < num_blobs; ++id) {
+    root[id] = id;
+    lifetimes[id].first_layer = -1;
+    lifetimes[id].last_layer = -1;
+  }
+  const auto &layers = net_->layers();
+  for (int i = 0; i < static_cast<int>(layers.size()); ++i) {
+    const auto &bottoms = net_->bottom_ids(i);
+    bool sharing = !bottoms.empty() &&
+                   kSharingLayers.count(layers[i]->type()) > 0;
+    for (int id : bottoms) {
+      BlobLifetime &lifetime = lifetimes[root[id]];
+      lifetime.last_layer = std::max(lifetime.last_layer, i);
+    }
+    for (int id : net_->top_ids(i)) {
+      if (sharing && id != bottoms[0]) {
+        root[id] = root[bottoms[0]];
+        excluded[root[id]] = excluded[root[id]] || excluded[id];
+      }
+      BlobLifetime &lifetime = lifetimes[root[id]];
+      if (lifetime.first_layer == -1) {
+        lifetime.first_layer = i;
+      }
+      lifetime.last_layer = std::max(lifetime.last_layer, i);
+      lifetime.bytes = std::max(lifetime.bytes,
+                                counts[id] * sizeof(float));
+    }
+  }
+
+  std::vector<int> planned;
+  std::vector<BlobLifetime> planned_lifetimes;
+  size_t total_bytes = 0;
+  for (int id = 0; id < num_blobs; ++id) {
+    if (root[id] == id && !excluded[id] && lifetimes[id].first_layer != -1 &&
+        lifetimes[id].bytes > 0) {
+      planned.push_back(id);
+      planned_lifetimes.push_back(lifetimes[id]);
+      total_bytes += lifetimes[id].bytes;
+    }
+  }
+  std::vector<size_t> buffer_bytes;
+  std::vector<int> assignment =
+      inference::PlanMemory(planned_lifetimes, &buffer_bytes);
+
+  // the blobs point at the new buffers before the old ones are freed
+  std::vector<std::shared_ptr<caffe::SyncedMemory>> buffers;
+  size_t planned_bytes = 0;
+  for (size_t bytes : buffer_bytes) {
+    buffers.emplace_back(new caffe::SyncedMemory(bytes));
+    planned_bytes += bytes;
+  }
+  for (size_t i = 0; i < planned.size(); ++i) {
+    net_blobs[planned[i]]->set_gpu_data(
+        static_cast<float *>(buffers[assignment[i]]->mutable_gpu_data()));
+  }
+  buffers_.swap(buffers);
+  // sharing layers take the data of their bottom again
+  net_->Reshape();
+  planned_counts_.swap(counts);
+  AINFO << "CaffeNet planned " << planned.size() << " blobs of "
+        << total_bytes << " bytes on " << buffers_.size() << " buffers of "
+        << planned_bytes << " bytes";
+}
+
 void CaffeNet::Infer() {
+  Enqueue();
+  Wait();
+}
+
+void CaffeNet::Enqueue() {
   if (gpu_id_ >= 0) {
     caffe::Caffe::SetDevice(gpu_id_);
     caffe::Caffe::set_mode(caffe::Caffe::GPU);
@@ -126,10 +257,22 @@ void CaffeNet::Infer() {
     auto caffe_blob = net_->blob_by_name(name);
     if (caffe_blob != nullptr && blob != nullptr) {
       blob->Reshape(caffe_blob->shape());
-      cudaMemcpy(blob->mutable_gpu_data(), caffe_blob->gpu_data(),
-                 caffe_blob->count() * sizeof(float), cudaMemcpyDeviceToDevice);
+      cudaMemcpyAsync(blob->mutable_gpu_data(), caffe_blob->gpu_data(),
+                      caffe_blob->count() * sizeof(float),
+                      cudaMemcpyDeviceToDevice, stream_);
     }
   }
+  if (done_ != nullptr) {
+    cudaEventRecord(done_, stream_);
+  }
+}
+
+void CaffeNet::Wait() {
+  if (done_ != nullptr) {
+    cudaEventSynchronize(done_);
+  } else if (gpu_id_ >= 0) {
+    cudaStreamSynchronize(stream_);
+  }
 }
 
 bool CaffeNet::shape(const std::string &name, std::vector<int> *res) {
@@ -41,24 +41,42 @@ class CaffeNet : public Inference {
            const std::vector<std::string> &outputs,
            const std::vector<std::string> &inputs);
 
-  virtual ~CaffeNet() {}
+  virtual ~CaffeNet();
 
   bool Init(const std::map<std::string, std::vector<int>> &shapes) override;
 
   void Infer() override;
+  // Runs the net on the stream of this CaffeNet, the outputs are copied back
+  // once Wait() returns.
+  void Enqueue() override;
+  void Wait() override;
   BlobPtr get_blob(const std::string &name) override;
 
+  // On GPU, intermediate blobs whose layers do not overlap share memory,
+  // planned again whenever the shapes change. On by default.
+  void set_reuse_memory(bool reuse_memory) { reuse_memory_ = reuse_memory; }
+
  protected:
   bool reshape();
   bool shape(const std::string &name, std::vector<int> *res);
   std::shared_ptr<caffe::Net<float>> net_ = nullptr;
 
  private:
+  void PlanMemory();
+
   std::string net_file_;
   std::string model_file_;
   std::vector<std::string> output_names_;
   std::vector<std::string> input_names_;
   BlobMap blobs_;
+
+  cudaStream_t stream_ = nullptr;
+  cudaEvent_t done_ = nullptr;
+
+  bool reuse_memory_ = true;
+  // counts of the net blobs the memory was planned for
+  std::vector<int> planned_counts_;
+  std::vector<std::shared_ptr<caffe::SyncedMemory>> buffers_;
 };
 
 }  // namespace inference
@@ -38,6 +38,11 @@ class Inference {
   virtual void Infer() = 0;
   Inference() = default;
 
+  // Starts the inference without waiting for it, the outputs are valid once
+  // Wait() returns. Engines without asynchronous support run it right away.
+  virtual void Enqueue() { Infer(); }
+  virtual void Wait() {}
+
   virtual ~Inference() = default;
 
   virtual bool Init(const std::map<std::string, std::vector<int>> &shapes) = 0;
@@ -22,8 +22,34 @@ namespace apollo {
 namespace perception {
 namespace inference {
 
+namespace {
+
+class CountingInference : public Inference {
+ public:
+  void Infer() override { ++num_infer_; }
+  bool Init(const std::map<std::string, std::vector<int>> &shapes) override {
+    return true;
+  }
+  std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
+      const std::string &name) override {
+    return nullptr;
+  }
+
+  int num_infer_ = 0;
+};
+
+}  // namespace
+
 TEST(Inference, default) {}
 
+TEST(Inference, enqueue_without_async_support) {
+  CountingInference inference;
+  inference.Enqueue();
+  EXPECT_EQ(1, inference.num_infer_);
+  inference.Wait();
+  EXPECT_EQ(1, inference.num_infer_);
+}
+
 }  // namespace inference
 }  // namespace perception
 }  // namespace apollo
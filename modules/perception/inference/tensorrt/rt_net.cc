@@ -17,9 +17,15 @@
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
 #include <utility>
 
+#include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/tensorrt/plugins/argmax_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/slice_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/softmax_plugin.h"
@@ -533,6 +539,8 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs)
     : output_names_(outputs), input_names_(inputs) {
+  net_file_ = net_file;
+  model_file_ = model_file;
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -542,6 +550,8 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &inputs,
              nvinfer1::Int8EntropyCalibrator *calibrator)
     : output_names_(outputs), input_names_(inputs) {
+  net_file_ = net_file;
+  model_file_ = model_file;
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -553,6 +563,8 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &inputs,
              const std::string &model_root)
     : output_names_(outputs), input_names_(inputs), is_own_calibrator_(true) {
+  net_file_ = net_file;
+  model_file_ = model_file;
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -564,13 +576,14 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
 }
 
 bool RTNet::shape(const std::string &name, std::vector<int> *res) {
-  auto engine = &(context_->getEngine());
+  auto engine = engine_;
   if (tensor_modify_map_.find(name) == tensor_modify_map_.end()) {
     AINFO << "can't get the shape of " << name;
     return false;
   }
   int bindingIndex = engine->getBindingIndex(tensor_modify_map_[name].c_str());
-  if (bindingIndex > static_cast<int>(buffers_.size())) {
+  if (bindingIndex >
+      static_cast<int>(input_names_.size() + output_names_.size())) {
     return false;
   }
   nvinfer1::DimsCHW dims = static_cast<nvinfer1::DimsCHW &&>(
@@ -582,24 +595,31 @@ bool RTNet::shape(const std::string &name, std::vector<int> *res) {
   (*res)[3] = dims.w();
   return true;
 }
-void RTNet::init_blob(std::vector<std::string> *names) {
-  auto engine = &(context_->getEngine());
+void RTNet::init_blob(std::vector<std::string> *names, ExecutionSlot *slot) {
+  auto engine = engine_;
 
   for (auto name : *names) {
     int bindingIndex =
         engine->getBindingIndex(tensor_modify_map_[name].c_str());
-    CHECK_LT(bindingIndex, buffers_.size());
+    CHECK_LT(bindingIndex, slot->buffers.size());
     CHECK_GE(bindingIndex, 0);
     nvinfer1::DimsCHW dims = static_cast<nvinfer1::DimsCHW &&>(
         engine->getBindingDimensions(bindingIndex));
     int count = dims.c() * dims.h() * dims.w() * max_batch_size_;
-    cudaMalloc(&buffers_[bindingIndex], count * sizeof(float));
+    cudaMalloc(&slot->buffers[bindingIndex], count * sizeof(float));
     std::vector<int> shape;
     CHECK(this->shape(name, &shape));
     std::shared_ptr<apollo::perception::base::Blob<float>> blob;
-    blob.reset(new apollo::perception::base::Blob<float>(shape));
-    blob->set_gpu_data(reinterpret_cast<float *>(buffers_[bindingIndex]));
-    blobs_.insert(std::make_pair(name, blob));
+    blob.reset(new apollo::perception::base::Blob<float>(
+        shape, use_pinned_host_memory_));
+    blob->set_gpu_data(
+        reinterpret_cast<float *>(slot->buffers[bindingIndex]));
+    if (use_pinned_host_memory_) {
+      // allocate the host side once, the asynchronous copies target it
+      slot->host_buffers[bindingIndex] = blob->mutable_cpu_data();
+      blob->data()->set_head_gpu();
+    }
+    slot->blobs.insert(std::make_pair(name, blob));
   }
 }
 
@@ -609,8 +629,6 @@ bool RTNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
     return false;
   }
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
-  // stream will only be destoried for gpu_id_ >= 0
-  cudaStreamCreate(&stream_);
 
   builder_ = nvinfer1::createInferBuilder(rt_gLogger);
   network_ = builder_->createNetwork();
@@ -625,18 +643,141 @@ bool RTNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
   cudaGetDeviceProperties(&prop, gpu_id_);
   bool int8_mode = checkInt8(prop.name, calibrator_);
 
-  builder_->setInt8Mode(int8_mode);
-  builder_->setInt8Calibrator(calibrator_);
+  std::string cache_file;
+  std::string cache_key;
+  if (!FLAGS_rt_engine_cache_dir.empty()) {
+    cache_key = EngineCacheKey(prop.name, int8_mode, shapes);
+  }
+  if (!cache_key.empty()) {
+    cache_file = FLAGS_rt_engine_cache_dir + "/" +
+                 std::to_string(std::hash<std::string>()(cache_key)) +
+                 ".engine";
+    LoadEngine(cache_file, cache_key);
+  }
+
+  if (engine_ == nullptr) {
+    builder_->setInt8Mode(int8_mode);
+    builder_->setInt8Calibrator(calibrator_);
+
+    builder_->setDebugSync(true);
+
+    engine_ = builder_->buildCudaEngine(*network_);
+    if (engine_ != nullptr && !cache_file.empty()) {
+      SaveEngine(cache_file, cache_key);
+    }
+  }
+  CHECK_NOTNULL(engine_);
+  // the contexts share the weights of the engine
+  slots_.resize(num_contexts_);
+  for (auto &slot : slots_) {
+    // streams will only be destoried for gpu_id_ >= 0
+    cudaStreamCreate(&slot.stream);
+    slot.context = engine_->createExecutionContext();
+    slot.buffers.resize(input_names_.size() + output_names_.size());
+    slot.host_buffers.resize(slot.buffers.size(), nullptr);
+    init_blob(&input_names_, &slot);
+    init_blob(&output_names_, &slot);
+  }
+  return true;
+}
 
-  builder_->setDebugSync(true);
+std::string RTNet::EngineCacheKey(
+    const std::string &gpu_name, bool int8_mode,
+    const std::map<std::string, std::vector<int>> &shapes) {
+  // the plugins do not serialize their parameters, so networks using them
+  // can not be deserialized
+  for (int i = 0; i < network_->getNbLayers(); ++i) {
+    if (network_->getLayer(i)->getType() == nvinfer1::LayerType::kPLUGIN) {
+      AINFO << "Network with plugin layers, the engine is not cached.";
+      return "";
+    }
+  }
+  std::string net_content;
+  std::string model_content;
+  if (!cyber::common::GetContent(net_file_, &net_content) ||
+      !cyber::common::GetContent(model_file_, &model_content)) {
+    AWARN << "Failed to read " << net_file_ << " or " << model_file_
+          << ", the engine is not cached.";
+    return "";
+  }
+  std::hash<std::string> hasher;
+  std::ostringstream key;
+  key << "net:" << hasher(net_content) << " model:" << hasher(model_content)
+      << " gpu:" << gpu_name << " tensorrt:" << NV_TENSORRT_MAJOR << "."
+      << NV_TENSORRT_MINOR << "." << NV_TENSORRT_PATCH
+      << " batch:" << max_batch_size_ << " int8:" << int8_mode
+      << " calibration:" << model_root_;
+  for (const auto &shape : shapes) {
+    key << " " << shape.first << ":";
+    for (int dim : shape.second) {
+      key << dim << ",";
+    }
+  }
+  for (const auto &name : output_names_) {
+    key << " output:" << name;
+  }
+  return key.str();
+}
 
-  nvinfer1::ICudaEngine *engine = builder_->buildCudaEngine(*network_);
-  context_ = engine->createExecutionContext();
-  buffers_.resize(input_names_.size() + output_names_.size());
-  init_blob(&input_names_);
-  init_blob(&output_names_);
+bool RTNet::LoadEngine(const std::string &cache_file, const std::string &key) {
+  std::string content;
+  if (!cyber::common::GetContent(cache_file, &content)) {
+    return false;
+  }
+  // the first line holds the key the engine was built for
+  size_t pos = content.find('\n');
+  if (pos == std::string::npos || content.compare(0, pos, key) != 0) {
+    AWARN << "Stale engine cache " << cache_file;
+    return false;
+  }
+  if (runtime_ == nullptr) {
+    runtime_ = nvinfer1::createInferRuntime(rt_gLogger);
+  }
+  engine_ = runtime_->deserializeCudaEngine(content.data() + pos + 1,
+                                            content.size() - pos - 1, nullptr);
+  if (engine_ == nullptr) {
+    AWARN << "Failed to deserialize the engine cache " << cache_file;
+    return false;
+  }
+  AINFO << "Loaded engine cache " << cache_file;
   return true;
 }
+
+void RTNet::SaveEngine(const std::string &cache_file, const std::string &key) {
+  if (!cyber::common::EnsureDirectory(FLAGS_rt_engine_cache_dir)) {
+    AWARN << "Failed to create " << FLAGS_rt_engine_cache_dir;
+    return;
+  }
+  nvinfer1::IHostMemory *serialized = engine_->serialize();
+  if (serialized == nullptr) {
+    AWARN << "Failed to serialize the engine";
+    return;
+  }
+  // written aside and renamed, so a crash never leaves a truncated cache
+  const std::string tmp_file = cache_file + ".tmp";
+  std::ofstream fout(tmp_file, std::ios::binary);
+  fout << key << '\n';
+  fout.write(reinterpret_cast<const char *>(serialized->data()),
+             serialized->size());
+  fout.close();
+  serialized->destroy();
+  if (!fout || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+    AWARN << "Failed to write the engine cache " << cache_file;
+    std::remove(tmp_file.c_str());
+    return;
+  }
+  AINFO << "Saved engine cache " << cache_file;
+}
+
+void RTNet::set_num_contexts(int num_contexts) {
+  CHECK_GT(num_contexts, 0);
+  num_contexts_ = num_contexts;
+}
+
+void RTNet::set_use_pinned_host_memory(bool use_pinned_host_memory) {
+  use_pinned_host_memory_ = use_pinned_host_memory;
+}
+
 bool RTNet::checkInt8(const std::string &gpu_name,
                       nvinfer1::IInt8Calibrator *calibrator) {
   if (calibrator == nullptr) {
@@ -716,22 +857,51 @@ RTNet::~RTNet() {
     delete calibrator_;
   }
   if (gpu_id_ >= 0) {
-    BASE_CUDA_CHECK(cudaStreamDestroy(stream_));
     network_->destroy();
     builder_->destroy();
-    context_->destroy();
-    for (auto buf : buffers_) {
-      cudaFree(buf);
+    for (auto &slot : slots_) {
+      // blobs release their pinned host memory themselves
+      slot.blobs.clear();
+      BASE_CUDA_CHECK(cudaStreamDestroy(slot.stream));
+      slot.context->destroy();
+      for (auto buf : slot.buffers) {
+        cudaFree(buf);
+      }
+    }
+    if (engine_ != nullptr) {
+      engine_->destroy();
+    }
+    if (runtime_ != nullptr) {
+      runtime_->destroy();
     }
   }
 }
 
 void RTNet::Infer() {
+  Enqueue();
+  Wait();
+}
+
+void RTNet::Enqueue() { Enqueue(0, max_batch_size_); }
+
+void RTNet::Wait() { Wait(0); }
+
+void RTNet::Enqueue(int context_id, int batch_size) {
+  CHECK_GE(context_id, 0);
+  CHECK_LT(context_id, num_contexts());
+  CHECK_GT(batch_size, 0);
+  CHECK_LE(batch_size, max_batch_size_);
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
-  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+  auto &slot = slots_[context_id];
   for (auto name : input_names_) {
-    auto blob = get_blob(name);
-    if (blob != nullptr) {
+    auto blob = get_blob(name, context_id);
+    if (blob == nullptr) {
+      continue;
+    }
+    if (use_pinned_host_memory_ &&
+        blob->data()->head() == base::SyncedMemory::HEAD_AT_CPU) {
+      blob->data()->async_gpu_push(slot.stream);
+    } else {
       blob->gpu_data();
     }
   }
@@ -742,25 +912,63 @@ void RTNet::Infer() {
   // `out_blob->gpu_data()` will set HEAD to SYNCED,
   // then no copy happends after `enqueue`.
   for (auto name : output_names_) {
-    auto blob = get_blob(name);
+    auto blob = get_blob(name, context_id);
     if (blob != nullptr) {
       blob->gpu_data();
     }
   }
-  context_->enqueue(max_batch_size_, &buffers_[0], stream_, nullptr);
-  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+  slot.context->enqueue(batch_size, &slot.buffers[0], slot.stream, nullptr);
 
+  if (!use_pinned_host_memory_) {
+    return;
+  }
   for (auto name : output_names_) {
-    auto blob = get_blob(name);
-    if (blob != nullptr) {
+    auto blob = get_blob(name, context_id);
+    if (blob == nullptr) {
+      continue;
+    }
+    int bindingIndex =
+        engine_->getBindingIndex(tensor_modify_map_[name].c_str());
+    size_t size = blob->count() / max_batch_size_ * batch_size;
+    BASE_CUDA_CHECK(cudaMemcpyAsync(
+        slot.host_buffers[bindingIndex], slot.buffers[bindingIndex],
+        size * sizeof(float), cudaMemcpyDeviceToHost, slot.stream));
+  }
+}
+
+void RTNet::Wait(int context_id) {
+  CHECK_GE(context_id, 0);
+  CHECK_LT(context_id, num_contexts());
+  BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
+  BASE_CUDA_CHECK(cudaStreamSynchronize(slots_[context_id].stream));
+
+  for (auto name : output_names_) {
+    auto blob = get_blob(name, context_id);
+    if (blob == nullptr) {
+      continue;
+    }
+    if (use_pinned_host_memory_) {
+      // the outputs were copied back by Enqueue
+      blob->data()->set_head(base::SyncedMemory::SYNCED);
+    } else {
       blob->mutable_gpu_data();
     }
   }
 }
+
 std::shared_ptr<apollo::perception::base::Blob<float>> RTNet::get_blob(
     const std::string &name) {
-  auto iter = blobs_.find(name);
-  if (iter == blobs_.end()) {
+  return get_blob(name, 0);
+}
+
+std::shared_ptr<apollo::perception::base::Blob<float>> RTNet::get_blob(
+    const std::string &name, int context_id) {
+  if (context_id < 0 || context_id >= num_contexts()) {
+    return nullptr;
+  }
+  const auto &blobs = slots_[context_id].blobs;
+  auto iter = blobs.find(name);
+  if (iter == blobs.end()) {
     return nullptr;
   }
   return iter->second;
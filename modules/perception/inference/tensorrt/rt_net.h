@@ -71,10 +71,43 @@ class RTNet : public Inference {
 
   void Infer() override;
 
+  void Enqueue() override;
+
+  void Wait() override;
+
+  // Queues the inference of the first batch_size frames of the inputs of
+  // the given context on its own stream. The input blobs must not be written
+  // before the matching Wait().
+  void Enqueue(int context_id, int batch_size);
+
+  void Wait(int context_id);
+
   std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
       const std::string &name) override;
 
+  std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
+      const std::string &name, int context_id);
+
+  // Number of execution contexts sharing the engine, each with its own
+  // stream and blobs so they run concurrently. Must be set before Init.
+  void set_num_contexts(int num_contexts);
+
+  int num_contexts() const { return static_cast<int>(slots_.size()); }
+
+  // Allocates the host side of the blobs in pinned memory and copies the
+  // inputs and outputs asynchronously on the stream of the context. Must be
+  // set before Init.
+  void set_use_pinned_host_memory(bool use_pinned_host_memory);
+
  protected:
+  struct ExecutionSlot {
+    nvinfer1::IExecutionContext *context = nullptr;
+    cudaStream_t stream = 0;
+    std::vector<void *> buffers;
+    std::vector<void *> host_buffers;
+    BlobMap blobs;
+  };
+
   bool addInput(const TensorDimsMap &tensor_dims_map,
                 const std::map<std::string, std::vector<int>> &shapes,
                 TensorMap *tensor_map);
@@ -172,11 +205,23 @@ class RTNet : public Inference {
   nvinfer1::Weights loadLayerWeights(float data, int size);
 
   bool loadWeights(const std::string &model_file, WeightMap *weight_map);
-  void init_blob(std::vector<std::string> *names);
+  void init_blob(std::vector<std::string> *names, ExecutionSlot *slot);
+
+  // Key of the serialized engine, empty if the network can not be cached.
+  std::string EngineCacheKey(
+      const std::string &gpu_name, bool int8_mode,
+      const std::map<std::string, std::vector<int>> &shapes);
+  bool LoadEngine(const std::string &cache_file, const std::string &key);
+  void SaveEngine(const std::string &cache_file, const std::string &key);
 
  private:
-  nvinfer1::IExecutionContext *context_ = nullptr;
-  cudaStream_t stream_ = 0;
+  std::string net_file_;
+  std::string model_file_;
+  nvinfer1::IRuntime *runtime_ = nullptr;
+  nvinfer1::ICudaEngine *engine_ = nullptr;
+  std::vector<ExecutionSlot> slots_;
+  int num_contexts_ = 1;
+  bool use_pinned_host_memory_ = false;
   std::vector<std::shared_ptr<ArgMax1Plugin>> argmax_plugins_;
   std::vector<std::shared_ptr<SoftmaxPlugin>> softmax_plugins_;
   std::vector<std::shared_ptr<SLICEPlugin>> slice_plugins_;
@@ -186,7 +231,6 @@ class RTNet : public Inference {
 
   std::shared_ptr<NetParameter> net_param_;
   WeightMap weight_map_;
-  std::vector<void *> buffers_;
   int workspaceSize_ = 1;
   nvinfer1::Int8EntropyCalibrator *calibrator_ = nullptr;
   bool is_own_calibrator_ = true;
@@ -194,7 +238,6 @@ class RTNet : public Inference {
   nvinfer1::IBuilder *builder_ = nullptr;
   nvinfer1::INetworkDefinition *network_ = nullptr;
   std::vector<std::shared_ptr<float>> weights_mem_;
-  BlobMap blobs_;
 };
 
 }  // namespace inference
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/utils/memory_planner.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+std::vector<int> PlanMemory(const std::vector<BlobLifetime> &lifetimes,
+                            std::vector<size_t> *buffer_bytes) {
+  buffer_bytes->clear();
+  std::vector<int> buffers(lifetimes.size(), -1);
+  std::vector<size_t> order(lifetimes.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return lifetimes[a].first_layer < lifetimes[b].first_layer;
+  });
+
+  // the last layer reading the blob on each buffer
+  std::vector<int> busy_until;
+  for (size_t i : order) {
+    const BlobLifetime &lifetime = lifetimes[i];
+    int fit = -1;
+    int largest = -1;
+    for (size_t b = 0; b < busy_until.size(); ++b) {
+      if (busy_until[b] >= lifetime.first_layer) {
+        continue;
+      }
+      size_t bytes = (*buffer_bytes)[b];
+      if (bytes >= lifetime.bytes &&
+          (fit == -1 || bytes < (*buffer_bytes)[fit])) {
+        fit = static_cast<int>(b);
+      }
+      if (largest == -1 || bytes > (*buffer_bytes)[largest]) {
+        largest = static_cast<int>(b);
+      }
+    }
+    int buffer = fit != -1 ? fit : largest;
+    if (buffer == -1) {
+      buffer = static_cast<int>(busy_until.size());
+      busy_until.push_back(0);
+      buffer_bytes->push_back(0);
+    }
+    (*buffer_bytes)[buffer] = std::max((*buffer_bytes)[buffer], lifetime.bytes);
+    busy_until[buffer] = std::max(lifetime.first_layer, lifetime.last_layer);
+    buffers[i] = buffer;
+  }
+  return buffers;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
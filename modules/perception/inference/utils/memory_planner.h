@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// The layers between which a blob holds data, from the one writing it to the
+// last one reading it, and the bytes it needs.
+struct BlobLifetime {
+  int first_layer = 0;
+  int last_layer = 0;
+  size_t bytes = 0;
+};
+
+// Assigns blobs whose lifetimes do not overlap to the same buffer, each
+// buffer as large as the largest blob on it. A buffer is reused by a blob
+// written after the last layer reading the previous one, each blob takes the
+// smallest free buffer it fits in, or grows the largest free one.
+// Returns the buffer of each blob, buffer_bytes gets the size of each buffer.
+std::vector<int> PlanMemory(const std::vector<BlobLifetime> &lifetimes,
+                            std::vector<size_t> *buffer_bytes);
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/utils/memory_planner.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+BlobLifetime Lifetime(int first_layer, int last_layer, size_t bytes) {
+  BlobLifetime lifetime;
+  lifetime.first_layer = first_layer;
+  lifetime.last_layer = last_layer;
+  lifetime.bytes = bytes;
+  return lifetime;
+}
+
+TEST(MemoryPlannerTest, test_chain) {
+  // conv1 -> conv2 -> conv3 -> conv4, each output read by the next layer
+  std::vector<BlobLifetime> lifetimes = {
+      Lifetime(0, 1, 400), Lifetime(1, 2, 200), Lifetime(2, 3, 300),
+      Lifetime(3, 4, 100)};
+  std::vector<size_t> buffer_bytes;
+  std::vector<int> buffers = PlanMemory(lifetimes, &buffer_bytes);
+  ASSERT_EQ(buffers.size(), 4);
+  // a blob and the one its reader writes are live together, two buffers
+  // alternate
+  ASSERT_EQ(buffer_bytes.size(), 2);
+  EXPECT_EQ(buffers[0], buffers[2]);
+  EXPECT_EQ(buffers[1], buffers[3]);
+  EXPECT_NE(buffers[0], buffers[1]);
+  EXPECT_EQ(buffer_bytes[buffers[0]], 400);
+  EXPECT_EQ(buffer_bytes[buffers[1]], 200);
+}
+
+TEST(MemoryPlannerTest, test_branch) {
+  // the output of layer 0 is read again by layer 4
+  std::vector<BlobLifetime> lifetimes = {
+      Lifetime(0, 4, 100), Lifetime(1, 2, 100), Lifetime(2, 3, 100),
+      Lifetime(3, 4, 100), Lifetime(4, 5, 100)};
+  std::vector<size_t> buffer_bytes;
+  std::vector<int> buffers = PlanMemory(lifetimes, &buffer_bytes);
+  EXPECT_EQ(buffer_bytes.size(), 3);
+  for (size_t i = 1; i < buffers.size(); ++i) {
+    EXPECT_NE(buffers[0], buffers[i]);
+  }
+  // no two blobs live together share a buffer
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    for (size_t j = i + 1; j < lifetimes.size(); ++j) {
+      bool overlap = lifetimes[i].first_layer <= lifetimes[j].last_layer &&
+                     lifetimes[j].first_layer <= lifetimes[i].last_layer;
+      if (overlap) {
+        EXPECT_NE(buffers[i], buffers[j]);
+      }
+    }
+  }
+}
+
+TEST(MemoryPlannerTest, test_best_fit) {
+  // small and large blobs end together, the next ones take the buffer
+  // they fit best
+  std::vector<BlobLifetime> lifetimes = {
+      Lifetime(0, 1, 1000), Lifetime(0, 1, 10), Lifetime(2, 3, 8),
+      Lifetime(2, 3, 900), Lifetime(4, 5, 2000)};
+  std::vector<size_t> buffer_bytes;
+  std::vector<int> buffers = PlanMemory(lifetimes, &buffer_bytes);
+  ASSERT_EQ(buffer_bytes.size(), 2);
+  EXPECT_EQ(buffers[2], buffers[1]);
+  EXPECT_EQ(buffers[3], buffers[0]);
+  // nothing fits, the largest free buffer grows
+  EXPECT_EQ(buffers[4], buffers[0]);
+  EXPECT_EQ(buffer_bytes[buffers[0]], 2000);
+  EXPECT_EQ(buffer_bytes[buffers[1]], 10);
+
+  EXPECT_TRUE(PlanMemory({}, &buffer_bytes).empty());
+  EXPECT_TRUE(buffer_bytes.empty());
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
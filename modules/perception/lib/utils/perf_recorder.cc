@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/utils/perf_recorder.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace apollo {
+namespace perception {
+namespace lib {
+
+namespace {
+
+// full scope paths of the calling thread, innermost last
+thread_local std::vector<std::string> scope_stack;
+
+// histograms already looked up by the calling thread
+thread_local std::unordered_map<std::string, PerfStageHistogram *>
+    histogram_cache;
+
+int BucketIndex(uint64_t elapsed_us) {
+  int index = 0;
+  while (elapsed_us != 0 && index < PerfStageHistogram::kNumBuckets - 1) {
+    elapsed_us >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace
+
+PerfStageHistogram::PerfStageHistogram() : count(0), sum_us(0), max_us(0) {
+  for (int i = 0; i < kNumBuckets; ++i) {
+    buckets[i].store(0);
+  }
+}
+
+void PerfStageHistogram::Add(uint64_t elapsed_us) {
+  buckets[BucketIndex(elapsed_us)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum_us.fetch_add(elapsed_us, std::memory_order_relaxed);
+  uint64_t max = max_us.load(std::memory_order_relaxed);
+  while (elapsed_us > max &&
+         !max_us.compare_exchange_weak(max, elapsed_us,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+PerfRecorder::PerfRecorder() {}
+
+void PerfRecorder::Record(const std::string &stage, uint64_t elapsed_us) {
+  GetHistogram(stage)->Add(elapsed_us);
+}
+
+PerfStageHistogram *PerfRecorder::GetHistogram(const std::string &stage) {
+  auto iter = histogram_cache.find(stage);
+  if (iter != histogram_cache.end()) {
+    return iter->second;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &histogram = histograms_[stage];
+  if (histogram == nullptr) {
+    histogram.reset(new PerfStageHistogram);
+  }
+  histogram_cache[stage] = histogram.get();
+  return histogram.get();
+}
+
+void PerfRecorder::Summarize(bool reset,
+                             std::vector<PerfStageSummary> *summaries) {
+  summaries->clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &pair : histograms_) {
+    PerfStageHistogram &histogram = *pair.second;
+    uint64_t buckets[PerfStageHistogram::kNumBuckets];
+    uint64_t count = 0;
+    for (int i = 0; i < PerfStageHistogram::kNumBuckets; ++i) {
+      buckets[i] = reset ? histogram.buckets[i].exchange(0)
+                         : histogram.buckets[i].load();
+      count += buckets[i];
+    }
+    uint64_t sum_us =
+        reset ? histogram.sum_us.exchange(0) : histogram.sum_us.load();
+    uint64_t max_us =
+        reset ? histogram.max_us.exchange(0) : histogram.max_us.load();
+    if (reset) {
+      histogram.count.store(0);
+    }
+    if (count == 0) {
+      continue;
+    }
+
+    PerfStageSummary summary;
+    summary.name = pair.first;
+    summary.count = count;
+    summary.mean_ms = static_cast<double>(sum_us) * 1e-3 /
+                      static_cast<double>(count);
+    summary.max_ms = static_cast<double>(max_us) * 1e-3;
+    // a percentile is reported as the upper bound of its bucket
+    auto percentile = [&](double ratio) {
+      const double rank = ratio * static_cast<double>(count);
+      uint64_t accumulated = 0;
+      for (int i = 0; i < PerfStageHistogram::kNumBuckets; ++i) {
+        accumulated += buckets[i];
+        if (static_cast<double>(accumulated) >= rank) {
+          const double bound_ms = static_cast<double>(1ULL << i) * 1e-3;
+          return std::min(bound_ms, summary.max_ms);
+        }
+      }
+      return summary.max_ms;
+    };
+    summary.p50_ms = percentile(0.5);
+    summary.p90_ms = percentile(0.9);
+    summary.p99_ms = percentile(0.99);
+    summaries->push_back(summary);
+  }
+}
+
+const std::string &PerfRecorder::CurrentScope() {
+  static const std::string kEmptyScope;
+  return scope_stack.empty() ? kEmptyScope : scope_stack.back();
+}
+
+void PerfRecorder::PushScope(const std::string &name) {
+  if (scope_stack.empty()) {
+    scope_stack.push_back(name);
+  } else {
+    scope_stack.push_back(scope_stack.back() + "/" + name);
+  }
+}
+
+void PerfRecorder::PopScope() {
+  if (!scope_stack.empty()) {
+    scope_stack.pop_back();
+  }
+}
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
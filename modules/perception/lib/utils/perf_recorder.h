@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace perception {
+namespace lib {
+
+// timing histogram of one stage, updated without locks
+struct PerfStageHistogram {
+  // bucket i counts the elapsed times in [2^(i-1), 2^i) us
+  static const int kNumBuckets = 32;
+
+  PerfStageHistogram();
+
+  void Add(uint64_t elapsed_us);
+
+  std::atomic<uint64_t> buckets[kNumBuckets];
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> sum_us;
+  std::atomic<uint64_t> max_us;
+};
+
+struct PerfStageSummary {
+  std::string name;
+  uint64_t count = 0;
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+// Collects the times of the PERCEPTION_PERF macros per stage. Stages are
+// named by the path of the enclosing PERCEPTION_PERF_FUNCTION scopes, e.g.
+// "front_6mm_Perception/detector", so the summary keeps the hierarchy of
+// the pipeline.
+class PerfRecorder {
+ public:
+  void Enable(bool enable) { enabled_.store(enable); }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // thread safe, lock free once the stage was seen by the calling thread
+  void Record(const std::string &stage, uint64_t elapsed_us);
+
+  // @brief: summaries of the stages recorded since the last reset
+  // @param [in]: reset, restart the histograms
+  void Summarize(bool reset, std::vector<PerfStageSummary> *summaries);
+
+  // scope path of the calling thread, empty outside of any scope
+  static const std::string &CurrentScope();
+
+  static void PushScope(const std::string &name);
+
+  static void PopScope();
+
+ private:
+  PerfStageHistogram *GetHistogram(const std::string &stage);
+
+  std::atomic<bool> enabled_{false};
+  std::mutex mutex_;
+  // histograms are never removed, their addresses are cached per thread
+  std::map<std::string, std::unique_ptr<PerfStageHistogram>> histograms_;
+
+  DECLARE_SINGLETON(PerfRecorder)
+};
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
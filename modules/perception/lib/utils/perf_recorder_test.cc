@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "modules/perception/lib/utils/perf.h"
+#include "modules/perception/lib/utils/perf_recorder.h"
+
+namespace apollo {
+namespace perception {
+namespace lib {
+
+TEST(PerfRecorderTest, Summarize) {
+  PerfRecorder* recorder = PerfRecorder::Instance();
+  std::vector<PerfStageSummary> summaries;
+  recorder->Summarize(true, &summaries);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([recorder]() {
+      for (uint64_t i = 1; i <= 100; ++i) {
+        recorder->Record("stage", i * 100);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  recorder->Summarize(true, &summaries);
+  ASSERT_EQ(summaries.size(), 1);
+  const PerfStageSummary& summary = summaries[0];
+  EXPECT_EQ(summary.name, "stage");
+  EXPECT_EQ(summary.count, 400);
+  EXPECT_NEAR(summary.mean_ms, 5.05, 1e-6);
+  EXPECT_NEAR(summary.max_ms, 10.0, 1e-6);
+  // 5ms falls in the bucket [4.096ms, 8.192ms)
+  EXPECT_NEAR(summary.p50_ms, 8.192, 1e-6);
+  EXPECT_NEAR(summary.p99_ms, 10.0, 1e-6);
+
+  // the histograms were reset
+  recorder->Summarize(true, &summaries);
+  EXPECT_TRUE(summaries.empty());
+}
+
+TEST(PerfRecorderTest, ScopedTimers) {
+  PerfRecorder* recorder = PerfRecorder::Instance();
+  std::vector<PerfStageSummary> summaries;
+  recorder->Summarize(true, &summaries);
+  recorder->Enable(true);
+  {
+    TimerWrapper wrapper("pipeline");
+    PERCEPTION_PERF_BLOCK_START();
+    PERCEPTION_PERF_BLOCK_END("detector");
+    PERCEPTION_PERF_BLOCK_END("tracker");
+  }
+  recorder->Enable(false);
+  {
+    TimerWrapper wrapper("disabled");
+  }
+
+  recorder->Summarize(true, &summaries);
+  ASSERT_EQ(summaries.size(), 3);
+  EXPECT_EQ(summaries[0].name, "pipeline");
+  EXPECT_EQ(summaries[1].name, "pipeline/detector");
+  EXPECT_EQ(summaries[2].name, "pipeline/tracker");
+  for (const auto& summary : summaries) {
+    EXPECT_EQ(summary.count, 1);
+  }
+  EXPECT_TRUE(PerfRecorder::CurrentScope().empty());
+}
+
+}  // namespace lib
+}  // namespace perception
+}  // namespace apollo
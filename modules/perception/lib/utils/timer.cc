@@ -17,6 +17,7 @@
 #include <sys/time.h>
 
 #include "cyber/common/log.h"
+#include "modules/perception/lib/utils/perf_recorder.h"
 #include "modules/perception/lib/utils/timer.h"
 
 namespace apollo {
@@ -30,6 +31,7 @@ void Timer::Start() {
   gettimeofday(&tv, nullptr);
 
   start_time_ = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+  start_time_us_ = tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
 uint64_t Timer::End(const string &msg) {
@@ -40,11 +42,35 @@ uint64_t Timer::End(const string &msg) {
 
   ADEBUG << "TIMER " << msg << " elapsed_time: " << elapsed_time << " ms";
 
+  uint64_t end_time_us = tv.tv_sec * 1000000 + tv.tv_usec;
+  PerfRecorder *recorder = PerfRecorder::Instance();
+  if (recorder->enabled()) {
+    const string &scope = PerfRecorder::CurrentScope();
+    recorder->Record(scope.empty() ? msg : scope + "/" + msg,
+                     end_time_us - start_time_us_);
+  }
+
   // start new timer.
   start_time_ = end_time_;
+  start_time_us_ = end_time_us;
   return elapsed_time;
 }
 
+TimerWrapper::TimerWrapper(const string &msg) : msg_(msg) {
+  if (PerfRecorder::Instance()->enabled()) {
+    PerfRecorder::PushScope(msg_);
+    scope_pushed_ = true;
+  }
+  timer_.Start();
+}
+
+TimerWrapper::~TimerWrapper() {
+  if (scope_pushed_) {
+    PerfRecorder::PopScope();
+  }
+  timer_.End(msg_);
+}
+
 }  // namespace lib
 }  // namespace perception
 }  // namespace apollo
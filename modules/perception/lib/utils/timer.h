@@ -24,13 +24,14 @@ namespace lib {
 
 class Timer {
  public:
-  Timer() : start_time_(0), end_time_(0) {}
+  Timer() : start_time_(0), end_time_(0), start_time_us_(0) {}
 
   // no-thread safe.
   void Start();
 
   // return the elapsed time,
-  // also output msg and time in glog.
+  // also output msg and time in glog, and record it in the PerfRecorder
+  // when it is enabled.
   // automatically start a new timer.
   // no-thread safe.
   uint64_t End(const std::string &msg);
@@ -42,13 +43,16 @@ class Timer {
   // in ms.
   uint64_t start_time_;
   uint64_t end_time_;
+  // in us, for the PerfRecorder.
+  uint64_t start_time_us_;
 };
 
 class TimerWrapper {
  public:
-  explicit TimerWrapper(const std::string &msg) : msg_(msg) { timer_.Start(); }
+  // the timers started inside are recorded under msg
+  explicit TimerWrapper(const std::string &msg);
 
-  ~TimerWrapper() { timer_.End(msg_); }
+  ~TimerWrapper();
 
   TimerWrapper(const TimerWrapper &) = delete;
   TimerWrapper &operator=(const TimerWrapper &) = delete;
@@ -56,6 +60,7 @@ class TimerWrapper {
  private:
   Timer timer_;
   std::string msg_;
+  bool scope_pushed_ = false;
 };
 
 }  // namespace lib
@@ -119,6 +119,27 @@ LidarProcessResult LidarObstacleSegmentation::Process(
   }
 }
 
+LidarProcessResult LidarObstacleSegmentation::Process(
+    const LidarObstacleSegmentationOptions& options,
+    const base::SoaPointFCloud& cloud, LidarFrame* frame) {
+  const auto& sensor_name = options.sensor_name;
+
+  PERCEPTION_PERF_FUNCTION_WITH_INDICATOR(options.sensor_name);
+
+  PERCEPTION_PERF_BLOCK_START();
+  PointCloudPreprocessorOptions preprocessor_options;
+  preprocessor_options.sensor2novatel_extrinsics =
+    options.sensor2novatel_extrinsics;
+  if (cloud_preprocessor_.Preprocess(preprocessor_options, cloud, frame)) {
+    PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "preprocess");
+    return ProcessCommon(options, frame);
+  } else {
+    PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "preprocess");
+    return LidarProcessResult(LidarErrorCode::PointCloudPreprocessorError,
+                              "Failed to preprocess point cloud.");
+  }
+}
+
 LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
     const LidarObstacleSegmentationOptions& options, LidarFrame* frame) {
   const auto& sensor_name = options.sensor_name;
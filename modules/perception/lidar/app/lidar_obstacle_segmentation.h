@@ -55,6 +55,10 @@ class LidarObstacleSegmentation {
       const std::shared_ptr<apollo::drivers::PointCloud const>& message,
       LidarFrame* frame);
 
+  LidarProcessResult Process(const LidarObstacleSegmentationOptions& options,
+                             const base::SoaPointFCloud& cloud,
+                             LidarFrame* frame);
+
   LidarProcessResult Process(const LidarObstacleSegmentationOptions& options,
                              LidarFrame* frame);
 
@@ -25,6 +25,7 @@
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/base/sensor_meta.h"
+#include "modules/perception/lidar/common/lidar_frame_scratch.h"
 
 namespace apollo {
 namespace perception {
@@ -53,6 +54,8 @@ struct LidarFrame {
   base::SensorInfo sensor_info;
   // reserve string
   std::string reserve;
+  // scratch buffers of the stages
+  LidarFrameScratch scratch;
 
   void Reset() {
     if (cloud) {
@@ -73,6 +76,7 @@ struct LidarFrame {
     tracked_objects.clear();
     roi_indices.indices.clear();
     non_ground_indices.indices.clear();
+    scratch.Reset();
   }
 };  // struct LidarFrame
 
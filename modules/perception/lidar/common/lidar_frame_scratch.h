@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// @brief scratch buffers of the lidar stages, each drawn by one stage
+enum class LidarScratchBuffer {
+  ROI_LOCAL_X = 0,
+  ROI_LOCAL_Y = 1,
+  POINT_TO_GRID = 2,
+  MAX_SCRATCH_BUFFER = 3,
+};
+
+// @brief per-frame buffers the lidar stages draw from instead of allocating
+// their own. They belong to the LidarFrame, which LidarFramePool hands out
+// again, so they keep their capacity from frame to frame, and a buffer is
+// reserved to the largest size it had in any frame before, so the pipeline
+// stops allocating once it has seen its largest clouds.
+class LidarFrameScratch {
+ public:
+  LidarFrameScratch() = default;
+
+  // @brief draw an empty int buffer
+  // @param [in]: id, the buffer
+  // @return: the buffer, valid until the frame is reset
+  std::vector<int>* Ints(LidarScratchBuffer id) { return Draw(id, &ints_); }
+
+  // @brief draw an empty float buffer
+  // @param [in]: id, the buffer
+  // @return: the buffer, valid until the frame is reset
+  std::vector<float>* Floats(LidarScratchBuffer id) {
+    return Draw(id, &floats_);
+  }
+
+  // @brief record the sizes the buffers reached and empty them
+  void Reset() {
+    for (size_t i = 0; i < kBufferNum; ++i) {
+      RaiseHighWaterMark(i, std::max(ints_[i].size(), floats_[i].size()));
+      ints_[i].clear();
+      floats_[i].clear();
+    }
+  }
+
+  // @brief the largest size of a buffer in any frame reset so far
+  static size_t HighWaterMark(LidarScratchBuffer id) {
+    return HighWaterMarks()[static_cast<size_t>(id)].load(
+        std::memory_order_relaxed);
+  }
+
+ private:
+  static const size_t kBufferNum =
+      static_cast<size_t>(LidarScratchBuffer::MAX_SCRATCH_BUFFER);
+
+  template <typename T>
+  std::vector<T>* Draw(LidarScratchBuffer id,
+                       std::array<std::vector<T>, kBufferNum>* buffers) {
+    std::vector<T>* buffer = &(*buffers)[static_cast<size_t>(id)];
+    buffer->clear();
+    buffer->reserve(HighWaterMark(id));
+    return buffer;
+  }
+
+  static std::array<std::atomic<size_t>, kBufferNum>& HighWaterMarks() {
+    static std::array<std::atomic<size_t>, kBufferNum> marks{};
+    return marks;
+  }
+
+  static void RaiseHighWaterMark(size_t index, size_t size) {
+    auto& mark = HighWaterMarks()[index];
+    size_t current = mark.load(std::memory_order_relaxed);
+    while (size > current &&
+           !mark.compare_exchange_weak(current, size,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  std::array<std::vector<int>, kBufferNum> ints_;
+  std::array<std::vector<float>, kBufferNum> floats_;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/common/lidar_frame_scratch.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+TEST(LidarFrameScratchTest, lidar_frame_scratch_test) {
+  LidarFrameScratch scratch;
+  std::vector<int>* ints = scratch.Ints(LidarScratchBuffer::POINT_TO_GRID);
+  EXPECT_TRUE(ints->empty());
+  ints->assign(100, 1);
+  std::vector<float>* floats =
+      scratch.Floats(LidarScratchBuffer::ROI_LOCAL_X);
+  floats->assign(50, 1.f);
+  // the same buffer again, empty
+  EXPECT_EQ(scratch.Ints(LidarScratchBuffer::POINT_TO_GRID), ints);
+  EXPECT_TRUE(ints->empty());
+  EXPECT_GE(ints->capacity(), 100);
+  ints->assign(100, 1);
+
+  scratch.Reset();
+  EXPECT_TRUE(ints->empty());
+  EXPECT_TRUE(floats->empty());
+  EXPECT_EQ(LidarFrameScratch::HighWaterMark(LidarScratchBuffer::POINT_TO_GRID),
+            100);
+  EXPECT_EQ(LidarFrameScratch::HighWaterMark(LidarScratchBuffer::ROI_LOCAL_X),
+            50);
+  EXPECT_EQ(LidarFrameScratch::HighWaterMark(LidarScratchBuffer::ROI_LOCAL_Y),
+            0);
+
+  // another frame starts at the sizes reached before
+  LidarFrameScratch other;
+  EXPECT_GE(other.Ints(LidarScratchBuffer::POINT_TO_GRID)->capacity(), 100);
+  EXPECT_GE(other.Floats(LidarScratchBuffer::ROI_LOCAL_X)->capacity(), 50);
+  other.Ints(LidarScratchBuffer::POINT_TO_GRID)->assign(10, 1);
+  other.Reset();
+  EXPECT_EQ(LidarFrameScratch::HighWaterMark(LidarScratchBuffer::POINT_TO_GRID),
+            100);
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
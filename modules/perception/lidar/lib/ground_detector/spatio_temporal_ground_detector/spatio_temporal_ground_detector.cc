@@ -60,6 +60,8 @@ bool SpatioTemporalGroundDetector::Init(
   param_->roi_region_rad_z = config_params.roi_rad_z();
   param_->nr_grids_coarse = config_params.grid_size();
   param_->nr_smooth_iter = config_params.nr_smooth_iter();
+  param_->use_temporal_prior = config_params.use_temporal_prior();
+  param_->prior_inlier_percen_threshold = config_params.prior_inlier_ratio();
 
   pfdetector_ = new common::PlaneFitGroundDetector(*param_);
   pfdetector_->Init();
@@ -103,6 +105,12 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
   cloud_center_(0) = frame->lidar2world_pose(0, 3);
   cloud_center_(1) = frame->lidar2world_pose(1, 3);
   cloud_center_(2) = frame->lidar2world_pose(2, 3);
+  // the previous ground planes are kept in the grid of the previous center
+  if (has_prev_cloud_center_) {
+    const Eigen::Vector3f translation =
+        (cloud_center_ - prev_cloud_center_).cast<float>();
+    pfdetector_->SetGridTranslation(translation.data());
+  }
 
   // check output
   frame->non_ground_indices.indices.clear();
@@ -157,6 +165,7 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
               valid_point_num,
               nr_points_element)) {
      AINFO << "failed to call ground detector!";
+    has_prev_cloud_center_ = false;
     non_ground_indices.indices.insert(non_ground_indices.indices.end(),
                                point_indices_temp_.begin(),
                                point_indices_temp_.begin() + valid_point_num);
@@ -179,6 +188,8 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
     }
   }
   AINFO << "succeed to call ground detector!";
+  prev_cloud_center_ = cloud_center_;
+  has_prev_cloud_center_ = true;
 
   if (use_ground_service_) {
     auto ground_service = SceneManager::Instance().Service("GroundService");
@@ -15,6 +15,9 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/map_manager/map_manager.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "cyber/common/log.h"
 
 #include "modules/perception/proto/map_manager_config.pb.h"
@@ -40,13 +43,30 @@ bool MapManager::Init(const MapManagerInitOptions& options) {
   config_file = GetAbsolutePath(config_file, "map_manager.conf");
   MapManagerConfig config;
   CHECK(common::util::GetProtoFromFile(config_file, &config));
+  // the prefetch thread reads the tile params
+  prefetch_worker_.Release();
   update_pose_ = config.update_pose();
   roi_search_distance_ = config.roi_search_distance();
+  map_tile_size_ = config.map_tile_size();
+  map_tile_cache_size_ =
+      std::max(static_cast<size_t>(config.map_tile_cache_size()),
+               static_cast<size_t>(1));
+  map_tile_prefetch_num_ = static_cast<int>(config.map_tile_prefetch_num());
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    tiles_.clear();
+    prefetch_tiles_.clear();
+    has_last_point_ = false;
+  }
   hdmap_input_ = map::HDMapInput::Instance();
   if (!hdmap_input_->Init()) {
     AINFO << "Failed to init hdmap input.";
     return false;
   }
+  if (map_tile_size_ > 0.0 && map_tile_prefetch_num_ > 0) {
+    prefetch_worker_.Bind([this]() { return PrefetchTiles(); });
+    prefetch_worker_.Start();
+  }
   return true;
 }
 
@@ -71,6 +91,9 @@ bool MapManager::Update(const MapManagerOptions& options, LidarFrame* frame) {
   point.x = frame->lidar2world_pose.translation()(0);
   point.y = frame->lidar2world_pose.translation()(1);
   point.z = frame->lidar2world_pose.translation()(2);
+  if (map_tile_size_ > 0.0) {
+    return UpdateFromTile(point, frame);
+  }
   if (!hdmap_input_->GetRoiHDMapStruct(point, roi_search_distance_,
                                        frame->hdmap_struct)) {
     frame->hdmap_struct->road_polygons.clear();
@@ -81,6 +104,125 @@ bool MapManager::Update(const MapManagerOptions& options, LidarFrame* frame) {
   }
   return true;
 }
+bool MapManager::UpdateFromTile(const base::PointD& point,
+                                LidarFrame* frame) {
+  const TileIndex index = GetTileIndex(point.x, point.y);
+  std::shared_ptr<base::HdmapStruct> hdmap_struct;
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    auto iter = tiles_.find(index);
+    if (iter != tiles_.end()) {
+      iter->second.last_used = ++tile_clock_;
+      hdmap_struct = iter->second.hdmap_struct;
+    }
+  }
+  if (hdmap_struct == nullptr) {
+    hdmap_struct = QueryTile(index);
+    if (hdmap_struct == nullptr) {
+      // the cached tiles are shared, never clear them in place
+      frame->hdmap_struct.reset(new base::HdmapStruct);
+      AINFO << "Failed to get roi from hdmap.";
+      return true;
+    }
+    InsertTile(index, hdmap_struct);
+  }
+  // the tiles are not modified after they are cached
+  frame->hdmap_struct = hdmap_struct;
+  RequestPrefetch(point);
+  return true;
+}
+
+MapManager::TileIndex MapManager::GetTileIndex(double x, double y) const {
+  return TileIndex(static_cast<int>(std::floor(x / map_tile_size_)),
+                   static_cast<int>(std::floor(y / map_tile_size_)));
+}
+
+std::shared_ptr<base::HdmapStruct> MapManager::QueryTile(
+    const TileIndex& index) {
+  base::PointD center;
+  center.x = (index.first + 0.5) * map_tile_size_;
+  center.y = (index.second + 0.5) * map_tile_size_;
+  center.z = 0.0;
+  // half of the tile diagonal covers the distance of any point in the tile
+  // to the center
+  const double distance = roi_search_distance_ + map_tile_size_ * M_SQRT1_2;
+  std::shared_ptr<base::HdmapStruct> hdmap_struct(new base::HdmapStruct);
+  if (!hdmap_input_->GetRoiHDMapStruct(center, distance, hdmap_struct)) {
+    return nullptr;
+  }
+  return hdmap_struct;
+}
+
+void MapManager::InsertTile(
+    const TileIndex& index,
+    const std::shared_ptr<base::HdmapStruct>& hdmap_struct) {
+  std::lock_guard<std::mutex> lock(tile_mutex_);
+  MapTile& tile = tiles_[index];
+  tile.hdmap_struct = hdmap_struct;
+  tile.last_used = ++tile_clock_;
+  while (tiles_.size() > map_tile_cache_size_) {
+    auto oldest = tiles_.begin();
+    for (auto iter = tiles_.begin(); iter != tiles_.end(); ++iter) {
+      if (iter->second.last_used < oldest->second.last_used) {
+        oldest = iter;
+      }
+    }
+    tiles_.erase(oldest);
+  }
+}
+
+void MapManager::RequestPrefetch(const base::PointD& point) {
+  if (map_tile_prefetch_num_ <= 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    const double dx = has_last_point_ ? point.x - last_point_.x : 0.0;
+    const double dy = has_last_point_ ? point.y - last_point_.y : 0.0;
+    const double length = std::sqrt(dx * dx + dy * dy);
+    last_point_ = point;
+    has_last_point_ = true;
+    // the route is not known here, follow the heading of the vehicle
+    if (length < 1e-3) {
+      return;
+    }
+    prefetch_tiles_.clear();
+    for (int i = 1; i <= map_tile_prefetch_num_; ++i) {
+      const double step = i * map_tile_size_ / length;
+      const TileIndex index =
+          GetTileIndex(point.x + dx * step, point.y + dy * step);
+      if (tiles_.find(index) == tiles_.end()) {
+        prefetch_tiles_.push_back(index);
+      }
+    }
+    if (prefetch_tiles_.empty()) {
+      return;
+    }
+  }
+  prefetch_worker_.WakeUp();
+}
+
+bool MapManager::PrefetchTiles() {
+  std::vector<TileIndex> requests;
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    requests.swap(prefetch_tiles_);
+  }
+  for (const auto& index : requests) {
+    {
+      std::lock_guard<std::mutex> lock(tile_mutex_);
+      if (tiles_.find(index) != tiles_.end()) {
+        continue;
+      }
+    }
+    auto hdmap_struct = QueryTile(index);
+    if (hdmap_struct != nullptr) {
+      InsertTile(index, hdmap_struct);
+    }
+  }
+  return true;
+}
+
 bool MapManager::QueryPose(Eigen::Affine3d* sensor2world_pose) const {
   // TODO(...): map-based aligment to refine pose
   return false;
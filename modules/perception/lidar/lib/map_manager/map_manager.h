@@ -15,11 +15,17 @@
  *****************************************************************************/
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest_prod.h"
 
 #include "modules/perception/base/hdmap_struct.h"
+#include "modules/perception/lib/thread/thread_worker.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 #include "modules/perception/map/hdmap/hdmap_input.h"
 
@@ -35,7 +41,7 @@ class MapManager {
  public:
   MapManager() = default;
 
-  ~MapManager() = default;
+  ~MapManager() { prefetch_worker_.Release(); }
 
   bool Init(const MapManagerInitOptions& options = MapManagerInitOptions());
 
@@ -50,12 +56,50 @@ class MapManager {
 
   std::string Name() const { return "MapManager"; }
 
+ private:
+  typedef std::pair<int, int> TileIndex;
+
+  struct MapTile {
+    std::shared_ptr<base::HdmapStruct> hdmap_struct;
+    uint64_t last_used = 0;
+  };
+
+  // @brief: fill the frame with the cached tile around the point, the tile
+  // is queried from the hdmap on a cache miss
+  bool UpdateFromTile(const base::PointD& point, LidarFrame* frame);
+
+  TileIndex GetTileIndex(double x, double y) const;
+
+  // query the roi of the tile, large enough for any point inside it
+  std::shared_ptr<base::HdmapStruct> QueryTile(const TileIndex& index);
+
+  // insert the tile and evict the least recently used ones
+  void InsertTile(const TileIndex& index,
+                  const std::shared_ptr<base::HdmapStruct>& hdmap_struct);
+
+  // queue the tiles ahead of the vehicle for the prefetch thread
+  void RequestPrefetch(const base::PointD& point);
+
+  bool PrefetchTiles();
+
  private:
   LidarFrame* cached_frame_ = nullptr;
   map::HDMapInput* hdmap_input_ = nullptr;
   // params
   bool update_pose_ = false;
   double roi_search_distance_ = 80.0;
+  double map_tile_size_ = 0.0;
+  size_t map_tile_cache_size_ = 16;
+  int map_tile_prefetch_num_ = 2;
+
+  // tile cache, shared with the prefetch thread
+  std::mutex tile_mutex_;
+  std::map<TileIndex, MapTile> tiles_;
+  std::vector<TileIndex> prefetch_tiles_;
+  uint64_t tile_clock_ = 0;
+  base::PointD last_point_;
+  bool has_last_point_ = false;
+  lib::ThreadWorker prefetch_worker_;
 
   FRIEND_TEST(LidarLibMapManagerTest, lidar_map_manager_test);
 };  // class MapManager
@@ -18,7 +18,6 @@
 #include <algorithm>
 
 #include "modules/perception/common/geometry/common.h"
-#include "modules/perception/common/geometry/convex_hull_2d.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 // #include "modules/perception/lib/io/protobuf_util.h"
 
@@ -68,8 +67,7 @@ void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
     return;
   }
   LinePerturbation(&cloud);
-  common::ConvexHull2D<PointFCloud, PolygonDType> hull;
-  hull.GetConvexHull(cloud, &(object->polygon));
+  hull_.GetConvexHull(cloud, &(object->polygon));
 }
 
 void ObjectBuilder::ComputeOtherObjectInformation(ObjectPtr object) {
@@ -22,6 +22,7 @@
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/geometry/convex_hull_2d.h"
 #include "modules/perception/lib/registerer/registerer.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 
@@ -93,6 +94,12 @@ class ObjectBuilder {
           apollo::perception::base::PointF>& cloud,
       Eigen::Vector3f* min_pt,
       Eigen::Vector3f* max_pt);
+
+  // reused by the objects of all frames, keeps its buffers allocated
+  common::ConvexHull2D<
+      apollo::perception::base::PointCloud<apollo::perception::base::PointF>,
+      apollo::perception::base::PointCloud<apollo::perception::base::PointD>>
+      hull_;
 };  // class ObjectBuilder
 
 }  // namespace lidar
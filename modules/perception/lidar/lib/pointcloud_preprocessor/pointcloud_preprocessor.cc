@@ -114,6 +114,60 @@ bool PointCloudPreprocessor::Preprocess(
   return true;
 }
 
+bool PointCloudPreprocessor::Preprocess(
+    const PointCloudPreprocessorOptions& options,
+    const base::SoaPointFCloud& cloud, LidarFrame* frame) const {
+  if (frame == nullptr) {
+    return false;
+  }
+  if (frame->cloud == nullptr) {
+    frame->cloud = base::PointFCloudPool::Instance().Get();
+  }
+  if (frame->world_cloud == nullptr) {
+    frame->world_cloud = base::PointDCloudPool::Instance().Get();
+  }
+  frame->cloud->set_timestamp(cloud.get_timestamp());
+  if (cloud.size() > 0) {
+    const float* x = cloud.points_x().data();
+    const float* y = cloud.points_y().data();
+    const float* z = cloud.points_z().data();
+    frame->cloud->reserve(cloud.size());
+    base::PointF point;
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      if (filter_naninf_points_) {
+        if (std::isnan(x[i]) || std::isnan(y[i]) || std::isnan(z[i])) {
+          continue;
+        }
+        if (fabs(x[i]) > kPointInfThreshold ||
+            fabs(y[i]) > kPointInfThreshold ||
+            fabs(z[i]) > kPointInfThreshold) {
+          continue;
+        }
+      }
+      Eigen::Vector3d vec3d_lidar(x[i], y[i], z[i]);
+      Eigen::Vector3d vec3d_novatel =
+        options.sensor2novatel_extrinsics * vec3d_lidar;
+      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
+          vec3d_novatel[0] > box_backward_x_ &&
+          vec3d_novatel[1] < box_forward_y_ &&
+          vec3d_novatel[1] > box_backward_y_) {
+        continue;
+      }
+      if (filter_high_z_points_ && z[i] > z_threshold_) {
+        continue;
+      }
+      point.x = x[i];
+      point.y = y[i];
+      point.z = z[i];
+      point.intensity = cloud.points_intensity()[i];
+      frame->cloud->push_back(point, cloud.points_timestamp()[i], FLT_MAX,
+                              cloud.points_beam_id()[i], 0);
+    }
+    TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
+  }
+  return true;
+}
+
 bool PointCloudPreprocessor::Preprocess(
     const PointCloudPreprocessorOptions& options, LidarFrame* frame) const {
   if (frame == nullptr || frame->cloud == nullptr) {
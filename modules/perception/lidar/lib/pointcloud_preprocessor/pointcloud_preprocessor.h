@@ -19,6 +19,7 @@
 #include <string>
 
 #include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/perception/base/soa_point_cloud.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 
 namespace apollo {
@@ -52,6 +53,14 @@ class PointCloudPreprocessor {
       const std::shared_ptr<apollo::drivers::PointCloud const>& message,
       LidarFrame* frame) const;
 
+  // @brief: preprocess point cloud
+  // @param [in]: options
+  // @param [in]: point cloud shared by an in-process component, the points
+  //   are copied into the frame without a protobuf in between
+  // @param [in/out]: frame
+  bool Preprocess(const PointCloudPreprocessorOptions& options,
+                  const base::SoaPointFCloud& cloud, LidarFrame* frame) const;
+
   // @brief: preprocess point cloud
   // @param [in/out]: frame
   // cloud should be filled, required,
@@ -16,6 +16,8 @@
 
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
 
+#include <algorithm>
+
 #include "modules/perception/lidar/common/lidar_log.h"
 
 namespace apollo {
@@ -124,6 +126,48 @@ bool Bitmap2D::Check(const Eigen::Vector2d& p) const {
   return CheckBit(bit_p.z(), bitmap_[idx]);
 }
 
+void Bitmap2D::CheckPoints(const float* x, const float* y, const size_t size,
+                           const Eigen::Vector2d& offset,
+                           std::vector<int>* indices) const {
+  // the cell of a chunk of points is computed first in a branchless loop the
+  // compiler vectorizes, the bits are then looked up one by one
+  constexpr size_t kChunkSize = 256;
+  int64_t bit_index[kChunkSize];
+  const double min_x = min_range_.x() - offset.x();
+  const double min_y = min_range_.y() - offset.y();
+  const double max_x = max_range_.x() - offset.x();
+  const double max_y = max_range_.y() - offset.y();
+  const double inv_cell_x = 1.0 / cell_size_.x();
+  const double inv_cell_y = 1.0 / cell_size_.y();
+  const bool x_major = dir_major_ == DirectionMajor::XMAJOR;
+  const int64_t row_bits = static_cast<int64_t>(map_size_[1]) << 6;
+  for (size_t start = 0; start < size; start += kChunkSize) {
+    const size_t num = std::min(kChunkSize, size - start);
+    const float* chunk_x = x + start;
+    const float* chunk_y = y + start;
+    for (size_t i = 0; i < num; ++i) {
+      const double px = chunk_x[i];
+      const double py = chunk_y[i];
+      const bool exists =
+          px >= min_x && px < max_x && py >= min_y && py < max_y;
+      // clamped so points outside the range give a valid dummy index
+      const int64_t ix = static_cast<int64_t>(
+          std::max(0.0, (px - min_x) * inv_cell_x));
+      const int64_t iy = static_cast<int64_t>(
+          std::max(0.0, (py - min_y) * inv_cell_y));
+      const int64_t major = x_major ? ix : iy;
+      const int64_t minor = x_major ? iy : ix;
+      bit_index[i] = exists ? major * row_bits + minor : -1;
+    }
+    for (size_t i = 0; i < num; ++i) {
+      if (bit_index[i] >= 0 &&
+          CheckBit(bit_index[i] & 63, bitmap_[bit_index[i] >> 6])) {
+        indices->push_back(static_cast<int>(start + i));
+      }
+    }
+  }
+}
+
 // set and reset
 void Bitmap2D::Set(const Eigen::Vector2d& p) {
   const Vec3ui bit_p = RealToBitmap(p);
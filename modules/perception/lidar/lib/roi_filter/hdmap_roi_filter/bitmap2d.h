@@ -55,6 +55,11 @@ class Bitmap2D {
   bool IsExists(const Eigen::Vector2d& p) const;
 
   bool Check(const Eigen::Vector2d& p) const;
+  // batched IsExists and Check of the points (x[i], y[i]) + offset, the
+  // indices of the points inside the range and set are appended to indices
+  void CheckPoints(const float* x, const float* y, const size_t size,
+                   const Eigen::Vector2d& offset,
+                   std::vector<int>* indices) const;
   void Set(const Eigen::Vector2d& p);
   void Reset(const Eigen::Vector2d& p);
 
@@ -17,6 +17,7 @@
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 
 #include <algorithm>
+#include <functional>
 
 #include "modules/common/util/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
@@ -54,24 +55,31 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   extend_dist_ = config.extend_dist();
   no_edge_table_ = config.no_edge_table();
   set_roi_service_ = config.set_roi_service();
+  enable_bitmap_cache_ = config.enable_bitmap_cache();
+  bitmap_cache_margin_ = config.bitmap_cache_margin();
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
   polygons_world_.reserve(KPolygonMaxNum);
   polygons_local_.reserve(KPolygonMaxNum);
 
-  // init bitmap
-  Eigen::Vector2d min_range(-range_, -range_);
-  Eigen::Vector2d max_range(range_, range_);
+  // init bitmap, a cached bitmap also covers the margin the vehicle may move
+  const double bitmap_range =
+      enable_bitmap_cache_ ? range_ + bitmap_cache_margin_ : range_;
+  Eigen::Vector2d min_range(-bitmap_range, -bitmap_range);
+  Eigen::Vector2d max_range(bitmap_range, bitmap_range);
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
+  bitmap_valid_ = false;
 
   // output input parameters
   AINFO << " HDMap Roi Filter Parameters: "
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " enable_bitmap_cache: " << enable_bitmap_cache_
+        << " bitmap_cache_margin: " << bitmap_cache_margin_;
   return true;
 }
 
@@ -101,13 +109,34 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
     polygons_world_[i++] = &polygon;
   }
 
-  // transform to local
-  base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
-  TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
+  const Eigen::Vector2d vel_location =
+      frame->lidar2world_pose.translation().head<2>();
+  const size_t polygons_signature =
+      enable_bitmap_cache_ ? PolygonsSignature(polygons_world_) : 0;
+  const bool reuse_bitmap =
+      IsBitmapReusable(vel_location, polygons_signature);
+  if (!reuse_bitmap) {
+    bitmap_origin_ = vel_location;
+  }
+
+  // transform to local, the polygons only when they are rasterized
+  static const std::vector<PolygonDType*> kNoPolygons;
+  std::vector<float>* local_x =
+      frame->scratch.Floats(LidarScratchBuffer::ROI_LOCAL_X);
+  std::vector<float>* local_y =
+      frame->scratch.Floats(LidarScratchBuffer::ROI_LOCAL_Y);
+  TransformFrame(frame->cloud, frame->lidar2world_pose, bitmap_origin_,
+                 reuse_bitmap ? kNoPolygons : polygons_world_,
+                 &polygons_local_, local_x, local_y);
 
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+  if (!reuse_bitmap) {
+    RasterizePolygons(polygons_local_, bitmap_.max_range().x());
+    bitmap_valid_ = enable_bitmap_cache_;
+    polygons_signature_ = polygons_signature;
+  }
+  ADEBUG << "hdmap roi bitmap reused: " << reuse_bitmap;
+  bool ret = Bitmap2dFilter(bitmap_, vel_location - bitmap_origin_, *local_x,
+                            *local_y, &(frame->roi_indices));
 
   // set roi points label
   if (ret) {
@@ -124,13 +153,14 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   if (set_roi_service_) {
     auto roi_service = SceneManager::Instance().Service("ROIService");
     if (roi_service != nullptr) {
-      roi_service_content_.range_ = range_;
+      roi_service_content_.range_ = bitmap_.max_range().x();
       roi_service_content_.cell_size_ = cell_size_;
       roi_service_content_.map_size_ = bitmap_.map_size();
       roi_service_content_.bitmap_ = bitmap_.bitmap();
       roi_service_content_.major_dir_ =
           static_cast<ROIServiceContent::DirectionMajor>(bitmap_.dir_major());
       roi_service_content_.transform_ = frame->lidar2world_pose.translation();
+      roi_service_content_.transform_.head<2>() = bitmap_origin_;
       roi_service->UpdateServiceContent(roi_service_content_);
     } else {
       AINFO << "Failed to find roi service and cannot update.";
@@ -139,14 +169,12 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   return ret;
 }
 
-bool HdmapROIFilter::FilterWithPolygonMask(
-    const base::PointFCloudPtr& cloud,
-    const std::vector<PolygonDType>& map_polygons,
-    base::PointIndices* roi_indices) {
+void HdmapROIFilter::RasterizePolygons(
+    const std::vector<PolygonDType>& map_polygons, const double range) {
   std::vector<Polygon<double>> raw_polygons;
   // convert and obtain the major direction
   raw_polygons.resize(map_polygons.size());
-  double min_x = range_;
+  double min_x = range;
   double max_x = -min_x;
   double min_y = min_x;
   double max_y = max_x;
@@ -164,10 +192,10 @@ bool HdmapROIFilter::FilterWithPolygonMask(
       max_y = std::max(raw_polygon[j].y(), max_y);
     }
   }
-  min_x = std::max(min_x, -range_);
-  max_x = std::min(max_x, range_);
-  min_y = std::max(min_y, -range_);
-  max_y = std::min(max_y, range_);
+  min_x = std::max(min_x, -range);
+  max_x = std::min(max_x, range);
+  min_y = std::max(min_y, -range);
+  max_y = std::min(max_y, range);
 
   DirectionMajor major_dir = DirectionMajor::XMAJOR;
   if ((max_y - min_y) < (max_x - min_x)) {
@@ -177,14 +205,14 @@ bool HdmapROIFilter::FilterWithPolygonMask(
 
   DrawPolygonsMask<double>(raw_polygons, &bitmap_, extend_dist_,
                            no_edge_table_);
-  return Bitmap2dFilter(cloud, bitmap_, roi_indices);
 }
 
 void HdmapROIFilter::TransformFrame(
     const base::PointFCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
+    const Eigen::Vector2d& origin,
     const std::vector<PolygonDType*>& polygons_world,
-    std::vector<PolygonDType>* polygons_local,
-    base::PointFCloudPtr* cloud_local) {
+    std::vector<PolygonDType>* polygons_local, std::vector<float>* local_x,
+    std::vector<float>* local_y) {
   Eigen::Vector3d vel_location = vel_pose.translation();
   Eigen::Matrix3d vel_rot = vel_pose.linear();
   Eigen::Vector3d x_axis = vel_rot.row(0);
@@ -198,43 +226,61 @@ void HdmapROIFilter::TransformFrame(
     auto& polygon_local = (*polygons_local)[i];
     polygon_local.resize(polygon_world.size());
     for (size_t j = 0; j < polygon_local.size(); ++j) {
-      polygon_local[j].x = polygon_world[j].x - vel_location.x();
-      polygon_local[j].y = polygon_world[j].y - vel_location.y();
+      polygon_local[j].x = polygon_world[j].x - origin.x();
+      polygon_local[j].y = polygon_world[j].y - origin.y();
     }
   }
 
-  // transform cloud
-  (*cloud_local)->clear();
-  (*cloud_local)->resize(cloud->size());
-  for (size_t i = 0; i < (*cloud_local)->size(); ++i) {
+  // transform cloud, the vehicle is at vel_location - origin
+  const double offset_x = vel_location.x() - origin.x();
+  const double offset_y = vel_location.y() - origin.y();
+  local_x->resize(cloud->size());
+  local_y->resize(cloud->size());
+  for (size_t i = 0; i < cloud->size(); ++i) {
     const auto& pt = cloud->at(i);
-    auto& local_pt = (*cloud_local)->at(i);
     Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
-    local_pt.x = static_cast<float>(x_axis.dot(e_pt));
-    local_pt.y = static_cast<float>(y_axis.dot(e_pt));
+    (*local_x)[i] = static_cast<float>(x_axis.dot(e_pt) + offset_x);
+    (*local_y)[i] = static_cast<float>(y_axis.dot(e_pt) + offset_y);
   }
 }
 
-bool HdmapROIFilter::Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
-                                    const Bitmap2D& bitmap,
+bool HdmapROIFilter::Bitmap2dFilter(const Bitmap2D& bitmap,
+                                    const Eigen::Vector2d& vel_local,
+                                    const std::vector<float>& local_x,
+                                    const std::vector<float>& local_y,
                                     base::PointIndices* roi_indices) {
-  if (!bitmap.Check(Eigen::Vector2d(0.0, 0.0))) {
+  if (!bitmap.IsExists(vel_local) || !bitmap.Check(vel_local)) {
     AWARN << " Car is not in roi!!.";
     return false;
   }
   roi_indices->indices.clear();
-  roi_indices->indices.reserve(in_cloud->size());
-  for (size_t i = 0; i < in_cloud->size(); ++i) {
-    const auto& pt = in_cloud->at(i);
-    Eigen::Vector2d e_pt(pt.x, pt.y);
-    if (!bitmap.IsExists(e_pt)) {
-      continue;
-    }
-    if (bitmap.Check(e_pt)) {
-      roi_indices->indices.push_back(static_cast<int>(i));
+  roi_indices->indices.reserve(local_x.size());
+  bitmap.CheckPoints(local_x.data(), local_y.data(), local_x.size(),
+                     Eigen::Vector2d::Zero(), &roi_indices->indices);
+  return true;
+}
+
+bool HdmapROIFilter::IsBitmapReusable(const Eigen::Vector2d& vel_location,
+                                      const size_t polygons_signature) const {
+  return enable_bitmap_cache_ && bitmap_valid_ &&
+         polygons_signature == polygons_signature_ &&
+         (vel_location - bitmap_origin_).cwiseAbs().maxCoeff() <=
+             bitmap_cache_margin_;
+}
+
+size_t HdmapROIFilter::PolygonsSignature(
+    const std::vector<PolygonDType*>& polygons) {
+  std::hash<double> hasher;
+  size_t signature = polygons.size();
+  for (const auto* polygon : polygons) {
+    for (size_t i = 0; i < polygon->size(); ++i) {
+      signature ^= hasher(polygon->at(i).x) + 0x9e3779b9 + (signature << 6) +
+                   (signature >> 2);
+      signature ^= hasher(polygon->at(i).y) + 0x9e3779b9 + (signature << 6) +
+                   (signature >> 2);
     }
   }
-  return true;
+  return signature;
 }
 
 PERCEPTION_REGISTER_ROIFILTER(HdmapROIFilter);
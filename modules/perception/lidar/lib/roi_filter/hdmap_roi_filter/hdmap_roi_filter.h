@@ -45,19 +45,32 @@ class HdmapROIFilter : public BaseROIFilter {
   bool Filter(const ROIFilterOptions& options, LidarFrame* frame) override;
 
  private:
+  // transform the polygons and the cloud into the world aligned frame
+  // centered at origin
+  // rotates the cloud into the world aligned frame centered at origin, into
+  // local_x and local_y
   void TransformFrame(const base::PointFCloudPtr& cloud,
                       const Eigen::Affine3d& vel_pose,
+                      const Eigen::Vector2d& origin,
                       const std::vector<base::PolygonDType*>& polygons_world,
                       std::vector<base::PolygonDType>* polygons_local,
-                      base::PointFCloudPtr* cloud_local);
+                      std::vector<float>* local_x,
+                      std::vector<float>* local_y);
 
-  bool FilterWithPolygonMask(
-      const base::PointFCloudPtr& cloud,
-      const std::vector<base::PolygonDType>& map_polygons,
-      base::PointIndices* roi_indices);
+  void RasterizePolygons(const std::vector<base::PolygonDType>& map_polygons,
+                         const double range);
 
-  bool Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
-                      const Bitmap2D& bitmap, base::PointIndices* roi_indices);
+  bool Bitmap2dFilter(const Bitmap2D& bitmap, const Eigen::Vector2d& vel_local,
+                      const std::vector<float>& local_x,
+                      const std::vector<float>& local_y,
+                      base::PointIndices* roi_indices);
+
+  // whether the bitmap rasterized at bitmap_origin_ can be used again
+  bool IsBitmapReusable(const Eigen::Vector2d& vel_location,
+                        const size_t polygons_signature) const;
+
+  static size_t PolygonsSignature(
+      const std::vector<base::PolygonDType*>& polygons);
 
   // parameters for polygons scans convert
   double range_ = 120.0;
@@ -65,9 +78,14 @@ class HdmapROIFilter : public BaseROIFilter {
   double extend_dist_ = 0.0;
   bool no_edge_table_ = false;
   bool set_roi_service_ = false;
+  bool enable_bitmap_cache_ = false;
+  double bitmap_cache_margin_ = 10.0;
   std::vector<base::PolygonDType*> polygons_world_;
   std::vector<base::PolygonDType> polygons_local_;
   Bitmap2D bitmap_;
+  bool bitmap_valid_ = false;
+  Eigen::Vector2d bitmap_origin_ = Eigen::Vector2d::Zero();
+  size_t polygons_signature_ = 0;
   ROIServiceContent roi_service_content_;
 
   // unit tests only
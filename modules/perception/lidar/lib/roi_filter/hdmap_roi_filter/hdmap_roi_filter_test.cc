@@ -84,6 +84,42 @@ TEST(hdmap_roi_filter_bitmap2d_test, test_bitmap) {
   AINFO << bitmap;
 }
 
+TEST(hdmap_roi_filter_bitmap2d_test, test_check_points) {
+  Bitmap2D bitmap;
+  bitmap.Init(Eigen::Vector2d(-10.0, -10.0), Eigen::Vector2d(10.0, 10.0),
+              Eigen::Vector2d(0.25, 0.25));
+  for (const auto major_dir :
+       {DirectionMajor::XMAJOR, DirectionMajor::YMAJOR}) {
+    bitmap.SetUp(major_dir);
+    bitmap.Set(-2.0, -5.0, 3.0);
+    bitmap.Set(1.3, 2.0, 9.9);
+    bitmap.Set(Eigen::Vector2d(7.6, -8.1));
+
+    // a grid of points with some out of the range
+    std::vector<float> x;
+    std::vector<float> y;
+    for (float px = -11.f; px <= 11.f; px += 0.1f) {
+      for (float py = -11.f; py <= 11.f; py += 0.3f) {
+        x.push_back(px);
+        y.push_back(py);
+      }
+    }
+    const Eigen::Vector2d offset(0.5, -0.25);
+    std::vector<int> expected;
+    for (size_t i = 0; i < x.size(); ++i) {
+      const Eigen::Vector2d p(static_cast<double>(x[i]) + offset.x(),
+                              static_cast<double>(y[i]) + offset.y());
+      if (bitmap.IsExists(p) && bitmap.Check(p)) {
+        expected.push_back(static_cast<int>(i));
+      }
+    }
+    std::vector<int> indices;
+    bitmap.CheckPoints(x.data(), y.data(), x.size(), offset, &indices);
+    EXPECT_FALSE(indices.empty());
+    EXPECT_EQ(expected, indices);
+  }
+}
+
 // polygon scan test
 TEST(hdmap_roi_filter_bitmap2d_test, test_polygon_scan_cvter) {
   Edge edge;
@@ -122,8 +122,6 @@ bool CNNSegmentation::Init(const SegmentationInitOptions& options) {
   CHECK(feature_generator_->Init(feature_param, feature_blob_.get()))
       << "Failed to init feature generator.";
 
-  point2grid_.reserve(kDefaultPointCloudSize);
-
   // init cluster and background segmentation methods
   CHECK(InitClusterAndBackgroundSegmentation());
 
@@ -223,10 +221,11 @@ bool CNNSegmentation::InitClusterAndBackgroundSegmentation() {
 }
 
 void CNNSegmentation::MapPointToGrid(
-    const std::shared_ptr<AttributePointCloud<PointF>>& pc_ptr) {
+    const std::shared_ptr<AttributePointCloud<PointF>>& pc_ptr,
+    std::vector<int>* point2grid) {
   float inv_res_x = 0.5f * static_cast<float>(width_) / range_;
   // float inv_res_y = 0.5 * static_cast<float>(height_) / range_;
-  point2grid_.assign(pc_ptr->size(), -1);
+  point2grid->assign(pc_ptr->size(), -1);
   int pos_x = -1;
   int pos_y = -1;
   for (size_t i = 0; i < pc_ptr->size(); ++i) {
@@ -243,7 +242,7 @@ void CNNSegmentation::MapPointToGrid(
     if (pos_y < 0 || pos_y >= height_ || pos_x < 0 || pos_x >= width_) {
       continue;
     }
-    point2grid_[i] = pos_y * width_ + pos_x;
+    (*point2grid)[i] = pos_y * width_ + pos_x;
   }
 }
 
@@ -281,8 +280,13 @@ bool CNNSegmentation::Segment(const SegmentationOptions& options,
 
   // note we should use origninal cloud here, frame->cloud may be exchanged
   Timer timer;
-  // map 3d points to 2d image grids
-  MapPointToGrid(original_cloud_);
+  // map 3d points to 2d image grids, on the device with the features if set
+  const bool gpu_point_mapping = cnnseg_param_.gpu_point_mapping();
+  std::vector<int>* point2grid =
+      frame->scratch.Ints(LidarScratchBuffer::POINT_TO_GRID);
+  if (!gpu_point_mapping) {
+    MapPointToGrid(original_cloud_, point2grid);
+  }
   mapping_time_ = timer.toc(true);
 
   if (cudaSetDevice(gpu_id_) != cudaSuccess) {
@@ -291,13 +295,20 @@ bool CNNSegmentation::Segment(const SegmentationOptions& options,
   }
 
   // generate features
-  feature_generator_->Generate(original_cloud_, point2grid_);
+  if (gpu_point_mapping) {
+    feature_generator_->GenerateWithMapping(original_cloud_);
+  } else {
+    feature_generator_->Generate(original_cloud_, *point2grid);
+  }
   feature_time_ = timer.toc(true);
 
   // model inference
   inference_->Infer();
   infer_time_ = timer.toc(true);
 
+  grid_indices_ = gpu_point_mapping ? feature_generator_->Point2Grid()
+                                    : point2grid->data();
+
   // processing clustering
   GetObjectsFromSppEngine(&frame->segmented_objects);
 
@@ -313,7 +324,7 @@ bool CNNSegmentation::Segment(const SegmentationOptions& options,
 void CNNSegmentation::GetObjectsFromSppEngine(
     std::vector<std::shared_ptr<Object>>* objects) {
   Timer timer;
-  spp_engine_.GetSppData().grid_indices = point2grid_.data();
+  spp_engine_.GetSppData().grid_indices = grid_indices_;
   size_t num_foreground =
        spp_engine_.ProcessForegroundSegmentation(original_cloud_);
   fg_seg_time_ = timer.toc(true);
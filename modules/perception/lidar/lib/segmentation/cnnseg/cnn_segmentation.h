@@ -60,7 +60,8 @@ class CNNSegmentation : public BaseSegmentation {
       std::vector<std::shared_ptr<base::Object>>* objects);
 
   void MapPointToGrid(
-      const std::shared_ptr<base::AttributePointCloud<base::PointF>>& pc_ptr);
+      const std::shared_ptr<base::AttributePointCloud<base::PointF>>& pc_ptr,
+      std::vector<int>* point2grid);
 
   CNNSegParam cnnseg_param_;
   std::shared_ptr<inference::Inference> inference_;
@@ -83,8 +84,9 @@ class CNNSegmentation : public BaseSegmentation {
   float min_height_ = 0.f;
   float max_height_ = 0.f;
 
-  // 1-d index in feature map of each point
-  std::vector<int> point2grid_;
+  // the 1-d index in feature map of each point, mapped on the host into the
+  // scratch of the frame or on the device by feature_generator_
+  int* grid_indices_ = nullptr;
 
   // ground detector for background segmentation
   std::unique_ptr<BaseGroundDetector> ground_detector_;
@@ -121,8 +123,6 @@ class CNNSegmentation : public BaseSegmentation {
   std::string sensor_name_;
 
  private:
-  const int kDefaultPointCloudSize = 120000;
-
   FRIEND_TEST(CNNSegmentationTest, cnn_segmentation_sequence_test);
   FRIEND_TEST(CNNSegmentationTest, cnn_segmentation_test);
 };  // class CNNSegmentation
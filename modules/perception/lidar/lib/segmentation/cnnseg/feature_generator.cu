@@ -150,6 +150,28 @@ __global__ void TopIntensityKernel(const int n, Dtype* top_intensity,
   }
 }
 
+// same mapping as GroupPc2Pixel in util.h
+__global__ void PointToGridKernel(const int n, const base::PointF* pc,
+                                  const float scale, const float range,
+                                  const float min_height,
+                                  const float max_height, const int width,
+                                  const int height, int* point2grid) {
+  CUDA_KERNEL_LOOP(i, n) {
+    int idx = -1;
+    const float pz = pc[i].z;
+    if (pz > min_height && pz < max_height) {
+      const float fx = (range - (0.707107f * (pc[i].x + pc[i].y))) * scale;
+      const float fy = (range - (0.707107f * (pc[i].x - pc[i].y))) * scale;
+      const int pos_x = fx < 0 ? -1 : static_cast<int>(fx);
+      const int pos_y = fy < 0 ? -1 : static_cast<int>(fy);
+      if (pos_y >= 0 && pos_y < height && pos_x >= 0 && pos_x < width) {
+        idx = pos_y * width + pos_x;
+      }
+    }
+    point2grid[i] = idx;
+  }
+}
+
 template <typename Dtype>
 __global__ void SetKernel(const int n, const Dtype alpha, Dtype* y) {
   CUDA_KERNEL_LOOP(i, n) {
@@ -158,7 +180,7 @@ __global__ void SetKernel(const int n, const Dtype alpha, Dtype* y) {
 }
 
 void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
-                       const std::vector<int>& point2grid) {
+                       const std::vector<int>* point2grid) {
   // fill initial value for feature blob
   int map_size = width_ * height_;
   int block_size = (map_size + kGPUThreadSize - 1) / kGPUThreadSize;
@@ -180,6 +202,8 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
   // copy cloud data and point2grid from CPU to GPU memory
   size_t cloud_size = pc_ptr->size();
   if (cloud_size > pc_gpu_size_) {
+    // the last copy of the grid indices may still read point2grid_gpu_
+    BASE_CUDA_CHECK(cudaStreamSynchronize(copy_stream_));
     // cloud data
     BASE_CUDA_CHECK(cudaFree(pc_gpu_));
     BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void **>(&pc_gpu_),
@@ -193,8 +217,29 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
   BASE_CUDA_CHECK(cudaMemcpy(pc_gpu_, &(pc_ptr->front()),
                  sizeof(base::PointF) * cloud_size,
                  cudaMemcpyHostToDevice));
-  BASE_CUDA_CHECK(cudaMemcpy(point2grid_gpu_, point2grid.data(),
-                 sizeof(int) * cloud_size, cudaMemcpyHostToDevice));
+  if (point2grid != nullptr) {
+    BASE_CUDA_CHECK(cudaMemcpy(point2grid_gpu_, point2grid->data(),
+                   sizeof(int) * cloud_size, cudaMemcpyHostToDevice));
+  } else {
+    if (static_cast<int>(cloud_size) > point2grid_host_size_) {
+      BASE_CUDA_CHECK(cudaFreeHost(point2grid_host_));
+      BASE_CUDA_CHECK(cudaMallocHost(
+          reinterpret_cast<void **>(&point2grid_host_),
+          cloud_size * sizeof(int)));
+      point2grid_host_size_ = static_cast<int>(cloud_size);
+    }
+    int block_size = (cloud_size + kGPUThreadSize - 1) / kGPUThreadSize;
+    float scale = 0.5f * static_cast<float>(width_) / range_;
+    PointToGridKernel<<<block_size, kGPUThreadSize>>>(cloud_size, pc_gpu_,
+          scale, range_, min_height_, max_height_, width_, height_,
+          point2grid_gpu_);
+    // copied back on its own stream while the features and the network run
+    BASE_CUDA_CHECK(cudaEventRecord(mapped_event_, 0));
+    BASE_CUDA_CHECK(cudaStreamWaitEvent(copy_stream_, mapped_event_, 0));
+    BASE_CUDA_CHECK(cudaMemcpyAsync(point2grid_host_, point2grid_gpu_,
+                   sizeof(int) * cloud_size, cudaMemcpyDeviceToHost,
+                   copy_stream_));
+  }
 
   // compute features
   // float inv_res_x = 0.5 * width_ / range_;
@@ -217,6 +262,11 @@ void FeatureGenerator::GenerateGPU(const base::PointFCloudPtr& pc_ptr,
   }
 }
 
+int* FeatureGenerator::Point2Grid() {
+  BASE_CUDA_CHECK(cudaStreamSynchronize(copy_stream_));
+  return point2grid_host_;
+}
+
 void FeatureGenerator::ReleaseGPUMemory() {
   if (pc_gpu_ != nullptr) {
     BASE_CUDA_CHECK(cudaFree(pc_gpu_));
@@ -224,6 +274,15 @@ void FeatureGenerator::ReleaseGPUMemory() {
   if (point2grid_gpu_ != nullptr) {
     BASE_CUDA_CHECK(cudaFree(point2grid_gpu_));
   }
+  if (point2grid_host_ != nullptr) {
+    BASE_CUDA_CHECK(cudaFreeHost(point2grid_host_));
+  }
+  if (mapped_event_ != nullptr) {
+    BASE_CUDA_CHECK(cudaEventDestroy(mapped_event_));
+  }
+  if (copy_stream_ != nullptr) {
+    BASE_CUDA_CHECK(cudaStreamDestroy(copy_stream_));
+  }
 }
 
 }  // namespace lidar
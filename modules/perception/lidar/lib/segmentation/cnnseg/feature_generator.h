@@ -39,6 +39,13 @@ class FeatureGenerator {
                                pc_gpu_size_ * sizeof(base::PointF)));
     BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&point2grid_gpu_),
                                pc_gpu_size_ * sizeof(int)));
+    point2grid_host_size_ = pc_gpu_size_;
+    BASE_CUDA_CHECK(cudaMallocHost(reinterpret_cast<void**>(&point2grid_host_),
+                                   point2grid_host_size_ * sizeof(int)));
+    BASE_CUDA_CHECK(
+        cudaStreamCreateWithFlags(&copy_stream_, cudaStreamNonBlocking));
+    BASE_CUDA_CHECK(
+        cudaEventCreateWithFlags(&mapped_event_, cudaEventDisableTiming));
 #endif
   }
 
@@ -53,20 +60,39 @@ class FeatureGenerator {
   void Generate(const base::PointFCloudPtr& pc_ptr,
                 const std::vector<int>& point2grid) {
 #ifndef PERCEPTION_CPU_ONLY
-    GenerateGPU(pc_ptr, point2grid);
+    GenerateGPU(pc_ptr, &point2grid);
 #else
     GenerateCPU(pc_ptr, point2grid);
 #endif
   }
 
+  // Same as Generate, but the points are mapped to the grid here, on the
+  // device the cloud is uploaded once and the grid indices are copied back
+  // while the network runs, Point2Grid waits for them.
+  void GenerateWithMapping(const base::PointFCloudPtr& pc_ptr) {
+#ifndef PERCEPTION_CPU_ONLY
+    GenerateGPU(pc_ptr, nullptr);
+#else
+    MapPointToGrid(pc_ptr, &map_idx_);
+    GenerateCPU(pc_ptr, map_idx_);
+#endif
+  }
+
+  // grid index of every point of the last GenerateWithMapping, -1 for the
+  // points out of the grid, valid until the next call
+  int* Point2Grid();
+
   inline std::string Name() const { return "FeatureGenerator"; }
 
  private:
 #ifndef PERCEPTION_CPU_ONLY
+  // maps the points on the device when point2grid is nullptr
   void GenerateGPU(const base::PointFCloudPtr& pc_ptr,
-                   const std::vector<int>& point2grid);
+                   const std::vector<int>* point2grid);
   void ReleaseGPUMemory();
 #endif
+  void MapPointToGrid(const base::PointFCloudPtr& pc_ptr,
+                      std::vector<int>* point2grid) const;
   void GenerateCPU(const base::PointFCloudPtr& pc_ptr,
                    const std::vector<int>& point2grid);
 
@@ -112,6 +138,13 @@ class FeatureGenerator {
   base::PointF* pc_gpu_ = nullptr;
   int* point2grid_gpu_ = nullptr;
   int pc_gpu_size_ = 0;
+#ifndef PERCEPTION_CPU_ONLY
+  // pinned, so the grid indices are copied back asynchronously
+  int* point2grid_host_ = nullptr;
+  int point2grid_host_size_ = 0;
+  cudaStream_t copy_stream_ = nullptr;
+  cudaEvent_t mapped_event_ = nullptr;
+#endif
   const int kMaxPointCloudGPUSize = 120000;
   const int kGPUThreadSize = 512;
 
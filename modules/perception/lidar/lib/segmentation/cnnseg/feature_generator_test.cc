@@ -185,7 +185,7 @@ TEST_F(FeatureGeneratorTest, basic_test) {
     param.set_use_intensity_feature(true);
     feature_blob.Reshape(1, 8, param.height(), param.width());
     EXPECT_TRUE(generator_->Init(param, &feature_blob));
-    generator_->GenerateGPU(pc_ptr, point2grid);
+    generator_->GenerateGPU(pc_ptr, &point2grid);
     EXPECT_FALSE(generator_->mean_intensity_data_ == nullptr);
     EXPECT_FALSE(generator_->top_intensity_data_ == nullptr);
     // save feature map
@@ -210,10 +210,23 @@ TEST_F(FeatureGeneratorTest, basic_test) {
     param.set_use_intensity_feature(false);
     feature_blob.Reshape(1, 6, param.height(), param.width());
     EXPECT_TRUE(generator_->Init(param, &feature_blob));
-    generator_->GenerateGPU(pc_ptr, point2grid);
+    generator_->GenerateGPU(pc_ptr, &point2grid);
     EXPECT_TRUE(generator_->mean_intensity_data_ == nullptr);
     EXPECT_TRUE(generator_->top_intensity_data_ == nullptr);
   }
+  // gpu generator mapping the points itself
+  {
+    generator_.reset(new FeatureGenerator);
+    base::Blob<float> feature_blob;
+    param.set_use_intensity_feature(false);
+    feature_blob.Reshape(1, 6, param.height(), param.width());
+    EXPECT_TRUE(generator_->Init(param, &feature_blob));
+    generator_->GenerateWithMapping(pc_ptr);
+    const int* gpu_point2grid = generator_->Point2Grid();
+    for (size_t i = 0; i < point2grid.size(); ++i) {
+      EXPECT_EQ(point2grid[i], gpu_point2grid[i]);
+    }
+  }
 }
 
 }  // namespace lidar
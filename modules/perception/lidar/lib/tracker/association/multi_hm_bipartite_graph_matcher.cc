@@ -18,6 +18,7 @@
 
 #include "cyber/common/log.h"
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+#include "modules/perception/common/perception_gflags.h"
 
 
 namespace apollo {
@@ -26,6 +27,9 @@ namespace lidar {
 
 MultiHmBipartiteGraphMatcher::MultiHmBipartiteGraphMatcher() {
   cost_matrix_ = optimizer_.mutable_global_costs();
+  optimizer_.set_num_parallel_solvers(FLAGS_association_parallel_solvers);
+  optimizer_.set_jv_min_component_size(
+      FLAGS_association_jv_min_component_size);
 }
 
 MultiHmBipartiteGraphMatcher::~MultiHmBipartiteGraphMatcher() {
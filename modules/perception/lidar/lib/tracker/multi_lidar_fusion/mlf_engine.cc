@@ -16,10 +16,13 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_engine.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "cyber/task/task.h"
 #include "modules/common/util/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
+#include "modules/perception/lib/utils/perf.h"
 #include "modules/perception/lidar/lib/tracker/common/track_pool_types.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/proto/multi_lidar_fusion_config.pb.h"
 
@@ -68,11 +71,19 @@ bool MlfEngine::Init(const MultiTargetTrackerInitOptions& options) {
   tracker_.reset(new MlfTracker);
   MlfTrackerInitOptions tracker_init_options;
   CHECK(tracker_->Init(tracker_init_options));
+
+  worker_trackers_.clear();
+  for (uint32_t i = 1; i < config.num_filter_workers(); ++i) {
+    worker_trackers_.emplace_back(new MlfTracker);
+    CHECK(worker_trackers_.back()->Init(tracker_init_options));
+  }
   return true;
 }
 
 bool MlfEngine::Track(const MultiTargetTrackerOptions& options,
                       LidarFrame* frame) {
+  const std::string& sensor_name = frame->sensor_info.name;
+  PERCEPTION_PERF_BLOCK_START();
   // 0. modify objects timestamp if necessary
   if (use_frame_timestamp_) {
     for (auto& object : frame->segmented_objects) {
@@ -89,27 +100,31 @@ bool MlfEngine::Track(const MultiTargetTrackerOptions& options,
   // 2. split fg and bg objects, and transform to tracked objects
   SplitAndTransformToTrackedObjects(frame->segmented_objects,
                                     frame->sensor_info);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "mlf_split");
   // 3. assign tracked objects to tracks
   MlfTrackObjectMatcherOptions match_options;
   TrackObjectMatchAndAssign(match_options, foreground_objects_, "foreground",
                             &foreground_track_data_);
   TrackObjectMatchAndAssign(match_options, background_objects_, "background",
                             &background_track_data_);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "mlf_match");
   // 4. state filter in tracker if is main sensor
-  bool is_main_sensor =
-      (main_sensor_.find(frame->sensor_info.name) != main_sensor_.end());
+  bool is_main_sensor = (main_sensor_.find(sensor_name) != main_sensor_.end());
   if (is_main_sensor) {
     TrackStateFilter(foreground_track_data_, frame->timestamp);
     TrackStateFilter(background_track_data_, frame->timestamp);
   }
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "mlf_filter");
   // 5. track to object if is main sensor
   frame->tracked_objects.clear();
   if (is_main_sensor) {
     CollectTrackedResult(frame);
   }
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "mlf_collect");
   // 6. remove stale data
   RemoveStaleTrackData("foreground", frame->timestamp, &foreground_track_data_);
   RemoveStaleTrackData("background", frame->timestamp, &background_track_data_);
+  PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "mlf_remove_stale");
   AINFO << "MlfEngine publish objects: " << frame->tracked_objects.size()
         << " sensor_name: " << frame->sensor_info.name
         << " at timestamp: " << std::to_string(frame->timestamp);
@@ -171,15 +186,36 @@ void MlfEngine::TrackObjectMatchAndAssign(
 
 void MlfEngine::TrackStateFilter(const std::vector<MlfTrackDataPtr>& tracks,
                                  double frame_timestamp) {
-  std::vector<TrackedObjectPtr> objects;
-  for (auto& track_data : tracks) {
-    track_data->GetAndCleanCachedObjectsInTimeInterval(&objects);
-    for (auto& obj : objects) {
-      tracker_->UpdateTrackDataWithObject(track_data, obj);
+  if (worker_trackers_.empty() || tracks.size() < 2) {
+    std::vector<TrackedObjectPtr> objects;
+    for (auto& track_data : tracks) {
+      FilterTrack(tracker_.get(), frame_timestamp, track_data, &objects);
     }
-    if (objects.size() == 0) {
-      tracker_->UpdateTrackDataWithoutObject(frame_timestamp, track_data);
+    return;
+  }
+  // the tracks are independent, every worker filters its share of them
+  // with its own tracker
+  const size_t num_workers =
+      std::min(worker_trackers_.size() + 1, tracks.size());
+  cyber::ParallelFor(0, num_workers, 1, [&](size_t worker) {
+    MlfTracker* tracker =
+        worker == 0 ? tracker_.get() : worker_trackers_[worker - 1].get();
+    std::vector<TrackedObjectPtr> objects;
+    for (size_t i = worker; i < tracks.size(); i += num_workers) {
+      FilterTrack(tracker, frame_timestamp, tracks[i], &objects);
     }
+  });
+}
+
+void MlfEngine::FilterTrack(MlfTracker* tracker, double frame_timestamp,
+                            const MlfTrackDataPtr& track_data,
+                            std::vector<TrackedObjectPtr>* objects) {
+  track_data->GetAndCleanCachedObjectsInTimeInterval(objects);
+  for (auto& obj : *objects) {
+    tracker->UpdateTrackDataWithObject(track_data, obj);
+  }
+  if (objects->size() == 0) {
+    tracker->UpdateTrackDataWithoutObject(frame_timestamp, track_data);
   }
 }
 
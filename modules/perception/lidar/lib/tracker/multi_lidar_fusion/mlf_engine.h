@@ -72,6 +72,15 @@ class MlfEngine : public BaseMultiTargetTracker {
       const std::vector<MlfTrackDataPtr>& tracks,
       double frame_timestamp);
 
+  // @brief: filter a single track with the given tracker
+  // @params [in]: tracker
+  // @params [in]: frame timestamp
+  // @params [in/out]: track for filter
+  // @params [out]: cached objects of the track, reused across tracks
+  void FilterTrack(MlfTracker* tracker, double frame_timestamp,
+      const MlfTrackDataPtr& track_data,
+      std::vector<TrackedObjectPtr>* objects);
+
   // @brief: collect track results and store in frame tracked objects
   // @params [in/out]: lidar frame
   void CollectTrackedResult(LidarFrame* frame);
@@ -94,6 +103,9 @@ class MlfEngine : public BaseMultiTargetTracker {
   std::vector<TrackedObjectPtr> background_objects_;
   // tracker
   std::unique_ptr<MlfTracker> tracker_;
+  // trackers of the other filter workers, the filters keep scratch memory
+  // so every worker has its own
+  std::vector<std::unique_ptr<MlfTracker>> worker_trackers_;
   // track object matcher
   std::unique_ptr<MlfTrackObjectMatcher> matcher_;
   // offset maintained for numeric issues
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "modules/common/math/matrix_operations.h"
 #include "modules/common/util/file.h"
 #include "modules/perception/common/geometry/basic.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
@@ -207,12 +208,14 @@ void MlfMotionFilter::KalmanFilterUpdateWithPartialObservation(
   Eigen::Matrix<double, 2, 4> observation_transform;
   observation_transform.block<2, 2>(0, 0).setIdentity();
   observation_transform.block<2, 2>(0, 2).setZero();
+  const Eigen::Matrix2d innovation_covariance =
+      observation_transform * state_covariance *
+          observation_transform.transpose() +
+      measurement_covariance;
   Eigen::Matrix<double, 4, 2> kalman_gain_matrix =
-      static_cast<Eigen::Matrix<double, 4, 2, 0, 4, 2>>
-      (state_covariance * observation_transform.transpose() *
-       (observation_transform * state_covariance *
-            observation_transform.transpose() + measurement_covariance)
-           .inverse());
+      common::math::MultiplyByCovarianceInverse<double, 4, 2>(
+          state_covariance * observation_transform.transpose(),
+          innovation_covariance);
   Eigen::Vector4d state_gain =
       static_cast<Eigen::Matrix<double, 4, 1, 0, 4, 1>>
       (kalman_gain_matrix * (measurement - observation_transform * state));
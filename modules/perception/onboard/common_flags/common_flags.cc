@@ -29,6 +29,8 @@ DEFINE_bool(obs_benchmark_mode, false,
 DEFINE_bool(obs_save_fusion_supplement, false,
             "whether save fusion supplement data, default false");
 DEFINE_bool(start_visualizer, false, "Whether to start visualizer");
+DEFINE_string(obs_perf_summary_channel, "/apollo/perception/perf_summary",
+              "channel of the stage timing summaries of PerfSummaryComponent");
 
 }  // namespace onboard
 }  // namespace perception
@@ -27,6 +27,7 @@ DECLARE_string(obs_screen_output_dir);
 DECLARE_bool(obs_benchmark_mode);
 DECLARE_bool(obs_save_fusion_supplement);
 DECLARE_bool(start_visualizer);
+DECLARE_string(obs_perf_summary_channel);
 
 }  // namespace onboard
 }  // namespace perception
@@ -15,6 +15,10 @@
  *****************************************************************************/
 #include "modules/perception/onboard/component/fusion_camera_detection_component.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 #include <boost/format.hpp>
 #include <yaml-cpp/yaml.h>
 
@@ -217,18 +221,30 @@ void FusionCameraDetectionComponent::OnReceiveImage(
     return;
   }
   last_timestamp_ = msg_timestamp;
-  ++seq_num_;
 
-  // for e2e lantency statistics
-  {
-    const double cur_time = lib::TimeUtil::GetCurrentTime();
-    const double start_latency = (cur_time - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:Start:msg_time[" << camera_name << "-"
-          << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << GLOG_TIMESTAMP(cur_time) << "]:cur_latency[" << start_latency
-          << "]";
+  if (batch_time_window_ > 0.0) {
+    // a second image of a camera, or one out of the time window, closes the
+    // batch of the pending images
+    bool close_batch = pending_images_.count(camera_name) > 0;
+    for (const auto &pending : pending_images_) {
+      close_batch = close_batch ||
+                    std::fabs(pending.second->measurement_time() -
+                              message->measurement_time()) >
+                        batch_time_window_;
+    }
+    if (close_batch) {
+      ProcessPendingImages();
+    }
+    pending_images_[camera_name] = message;
+    if (pending_images_.size() == camera_names_.size()) {
+      ProcessPendingImages();
+    }
+    return;
   }
 
+  ++seq_num_;
+  LogFrameStatistics("Start", camera_name, message->measurement_time());
+
   // protobuf msg
   std::shared_ptr<apollo::perception::PerceptionObstacles> out_message(
       new (std::nothrow) apollo::perception::PerceptionObstacles);
@@ -238,11 +254,87 @@ void FusionCameraDetectionComponent::OnReceiveImage(
   std::shared_ptr<SensorFrameMessage> prefused_message(new (std::nothrow)
                                                            SensorFrameMessage);
 
-  if (InternalProc(message, camera_name, &error_code, prefused_message.get(),
-                   out_message.get()) != cyber::SUCC) {
+  const int ret = InternalProc(message, camera_name, &error_code,
+                               prefused_message.get(), out_message.get());
+  Publish(message, camera_name, ret, error_code, prefused_message,
+          out_message);
+}
+
+void FusionCameraDetectionComponent::ProcessPendingImages() {
+  typedef std::pair<std::string, std::shared_ptr<apollo::drivers::Image>>
+      PendingImage;
+  std::vector<PendingImage> images(pending_images_.begin(),
+                                   pending_images_.end());
+  pending_images_.clear();
+  std::stable_sort(images.begin(), images.end(),
+                   [](const PendingImage &lhs, const PendingImage &rhs) {
+                     return lhs.second->measurement_time() <
+                            rhs.second->measurement_time();
+                   });
+
+  const size_t num_images = images.size();
+  std::vector<std::shared_ptr<apollo::perception::PerceptionObstacles>>
+      out_messages(num_images);
+  std::vector<std::shared_ptr<SensorFrameMessage>> prefused_messages(
+      num_images);
+  std::vector<apollo::common::ErrorCode> error_codes(num_images,
+                                                     apollo::common::OK);
+  std::vector<int> results(num_images, cyber::FAIL);
+  std::vector<camera::CameraFrame *> frames;
+  std::vector<size_t> frame_indices;
+  for (size_t i = 0; i < num_images; ++i) {
+    ++seq_num_;
+    LogFrameStatistics("Start", images[i].first,
+                       images[i].second->measurement_time());
+    out_messages[i].reset(new (std::nothrow)
+                              apollo::perception::PerceptionObstacles);
+    prefused_messages[i].reset(new (std::nothrow) SensorFrameMessage);
+    camera::CameraFrame *frame = nullptr;
+    if (PrepareFrame(images[i].second, images[i].first, &error_codes[i],
+                     prefused_messages[i].get(), &frame) == cyber::SUCC) {
+      frames.push_back(frame);
+      frame_indices.push_back(i);
+    }
+  }
+
+  // all cameras go through the pipeline at once
+  const bool success =
+      frames.empty() ||
+      camera_obstacle_pipeline_->Perception(camera_perception_options_,
+                                            frames);
+  for (size_t k = 0; k < frames.size(); ++k) {
+    const size_t i = frame_indices[k];
+    if (!success) {
+      AERROR << "camera_obstacle_pipeline_->Perception() failed"
+             << " msg_timestamp: " << std::to_string(frames[k]->timestamp);
+      error_codes[i] = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+      prefused_messages[i]->error_code_ = error_codes[i];
+      continue;
+    }
+    results[i] = FinishFrame(images[i].second, images[i].first, *frames[k],
+                             &error_codes[i], prefused_messages[i].get(),
+                             out_messages[i].get());
+  }
+
+  for (size_t i = 0; i < num_images; ++i) {
+    Publish(images[i].second, images[i].first, results[i], error_codes[i],
+            prefused_messages[i], out_messages[i]);
+  }
+}
+
+void FusionCameraDetectionComponent::Publish(
+    const std::shared_ptr<apollo::drivers::Image const> &message,
+    const std::string &camera_name, int proc_result,
+    apollo::common::ErrorCode error_code,
+    const std::shared_ptr<SensorFrameMessage> &prefused_message,
+    const std::shared_ptr<apollo::perception::PerceptionObstacles>
+        &out_message) {
+  const double msg_timestamp = message->measurement_time() + timestamp_offset_;
+  if (proc_result != cyber::SUCC) {
     AERROR << "InternalProc failed, error_code: " << error_code;
-    if (MakeProtobufMsg(msg_timestamp, seq_num_, std::vector<base::ObjectPtr>(),
-                        error_code, out_message.get()) != cyber::SUCC) {
+    if (MakeProtobufMsg(msg_timestamp, prefused_message->seq_num_,
+                        std::vector<base::ObjectPtr>(), error_code,
+                        out_message.get()) != cyber::SUCC) {
       AERROR << "MakeProtobufMsg failed";
       return;
     }
@@ -260,17 +352,18 @@ void FusionCameraDetectionComponent::OnReceiveImage(
   if (output_final_obstacles_) {
     writer_->Write(out_message);
   }
+  LogFrameStatistics("End", camera_name, message->measurement_time());
+}
+
+void FusionCameraDetectionComponent::LogFrameStatistics(
+    const std::string &stage, const std::string &camera_name,
+    double measurement_time) {
   // for e2e lantency statistics
-  {
-    const double end_timestamp =
-        apollo::perception::lib::TimeUtil::GetCurrentTime();
-    const double end_latency =
-        (end_timestamp - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:End:msg_time[" << camera_name << "-"
-          << GLOG_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << GLOG_TIMESTAMP(end_timestamp) << "]:cur_latency[" << end_latency
-          << "]";
-  }
+  const double cur_time = lib::TimeUtil::GetCurrentTime();
+  const double latency = (cur_time - measurement_time) * 1e3;
+  AINFO << "FRAME_STATISTICS:Camera:" << stage << ":msg_time[" << camera_name
+        << "-" << GLOG_TIMESTAMP(measurement_time) << "]:cur_time["
+        << GLOG_TIMESTAMP(cur_time) << "]:cur_latency[" << latency << "]";
 }
 
 int FusionCameraDetectionComponent::InitConfig() {
@@ -311,6 +404,9 @@ int FusionCameraDetectionComponent::InitConfig() {
   frame_capacity_ = fusion_camera_detection_param.frame_capacity();
   image_channel_num_ = fusion_camera_detection_param.image_channel_num();
   enable_undistortion_ = fusion_camera_detection_param.enable_undistortion();
+  enable_fused_preprocessing_ =
+      fusion_camera_detection_param.enable_fused_preprocessing();
+  batch_time_window_ = fusion_camera_detection_param.batch_time_window();
   enable_visualization_ = fusion_camera_detection_param.enable_visualization();
   output_obstacles_channel_name_ =
       fusion_camera_detection_param.output_obstacles_channel_name();
@@ -434,6 +530,8 @@ int FusionCameraDetectionComponent::InitCameraFrames() {
     data_provider_init_options.image_height = image_height_;
     data_provider_init_options.image_width = image_width_;
     data_provider_init_options.do_undistortion = enable_undistortion_;
+    data_provider_init_options.fuse_preprocessing =
+        enable_fused_preprocessing_;
     data_provider_init_options.sensor_name = camera_name;
     int gpu_id = GetGpuId(camera_perception_init_options_);
     if (gpu_id == -1) {
@@ -524,6 +622,29 @@ int FusionCameraDetectionComponent::InternalProc(
     const std::string &camera_name, apollo::common::ErrorCode *error_code,
     SensorFrameMessage *prefused_message,
     apollo::perception::PerceptionObstacles *out_message) {
+  camera::CameraFrame *camera_frame = nullptr;
+  if (PrepareFrame(in_message, camera_name, error_code, prefused_message,
+                   &camera_frame) != cyber::SUCC) {
+    return cyber::FAIL;
+  }
+
+  if (!camera_obstacle_pipeline_->Perception(camera_perception_options_,
+                                             camera_frame)) {
+    AERROR << "camera_obstacle_pipeline_->Perception() failed"
+           << " msg_timestamp: " << std::to_string(camera_frame->timestamp);
+    *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+    prefused_message->error_code_ = *error_code;
+    return cyber::FAIL;
+  }
+  return FinishFrame(in_message, camera_name, *camera_frame, error_code,
+                     prefused_message, out_message);
+}
+
+int FusionCameraDetectionComponent::PrepareFrame(
+    const std::shared_ptr<apollo::drivers::Image const> &in_message,
+    const std::string &camera_name, apollo::common::ErrorCode *error_code,
+    SensorFrameMessage *prefused_message,
+    camera::CameraFrame **frame) {
   const double msg_timestamp =
       in_message->measurement_time() + timestamp_offset_;
   const int frame_size = static_cast<int>(camera_frames_.size());
@@ -573,15 +694,19 @@ int FusionCameraDetectionComponent::InternalProc(
   // Run camera perception pipeline
   camera_obstacle_pipeline_->GetCalibrationService(
       &camera_frame.calibration_service);
+  *frame = &camera_frame;
+  return cyber::SUCC;
+}
 
-  if (!camera_obstacle_pipeline_->Perception(camera_perception_options_,
-                                             &camera_frame)) {
-    AERROR << "camera_obstacle_pipeline_->Perception() failed"
-           << " msg_timestamp: " << std::to_string(msg_timestamp);
-    *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
-    prefused_message->error_code_ = *error_code;
-    return cyber::FAIL;
-  }
+int FusionCameraDetectionComponent::FinishFrame(
+    const std::shared_ptr<apollo::drivers::Image const> &in_message,
+    const std::string &camera_name, const camera::CameraFrame &camera_frame,
+    apollo::common::ErrorCode *error_code,
+    SensorFrameMessage *prefused_message,
+    apollo::perception::PerceptionObstacles *out_message) {
+  const double msg_timestamp =
+      in_message->measurement_time() + timestamp_offset_;
+  const Eigen::Affine3d &camera2world_trans = camera_frame.camera2world_pose;
   AINFO << "##" << camera_name << ": pitch "
         << camera_frame.calibration_service->QueryPitchAngle()
         << " | camera_grond_height "
@@ -598,7 +723,8 @@ int FusionCameraDetectionComponent::InternalProc(
 
   // process success, make pb msg
   if (output_final_obstacles_ &&
-      MakeProtobufMsg(msg_timestamp, seq_num_, camera_frame.tracked_objects,
+      MakeProtobufMsg(msg_timestamp, prefused_message->seq_num_,
+                      camera_frame.tracked_objects,
                       *error_code, out_message) != cyber::SUCC) {
     AERROR << "MakeProtobufMsg failed"
            << " ts: " << std::to_string(msg_timestamp);
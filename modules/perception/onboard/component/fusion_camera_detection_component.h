@@ -18,6 +18,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/component/component.h"
@@ -56,6 +57,17 @@ class FusionCameraDetectionComponent :
   void OnReceiveImage(
       const std::shared_ptr<apollo::drivers::Image>& in_message,
       const std::string &camera_name);
+  // runs the pending images of the cameras through the pipeline as one batch
+  void ProcessPendingImages();
+  void Publish(
+      const std::shared_ptr<apollo::drivers::Image const>& in_message,
+      const std::string &camera_name, int proc_result,
+      apollo::common::ErrorCode error_code,
+      const std::shared_ptr<SensorFrameMessage>& prefused_message,
+      const std::shared_ptr<apollo::perception::PerceptionObstacles>&
+          out_message);
+  void LogFrameStatistics(const std::string &stage,
+      const std::string &camera_name, double measurement_time);
   int InitConfig();
   int InitSensorInfo();
   int InitAlgorithmPlugin();
@@ -72,6 +84,23 @@ class FusionCameraDetectionComponent :
       SensorFrameMessage* prefused_message,
       apollo::perception::PerceptionObstacles* out_message);
 
+  // fills the next camera frame with the image, before the pipeline
+  int PrepareFrame(
+      const std::shared_ptr<apollo::drivers::Image const>& in_message,
+      const std::string &camera_name,
+      apollo::common::ErrorCode *error_code,
+      SensorFrameMessage* prefused_message,
+      camera::CameraFrame** frame);
+
+  // fills the output messages from the processed camera frame
+  int FinishFrame(
+      const std::shared_ptr<apollo::drivers::Image const>& in_message,
+      const std::string &camera_name,
+      const camera::CameraFrame& camera_frame,
+      apollo::common::ErrorCode *error_code,
+      SensorFrameMessage* prefused_message,
+      apollo::perception::PerceptionObstacles* out_message);
+
   int MakeProtobufMsg(double msg_timestamp,
       int seq_num, const std::vector<base::ObjectPtr>& objects,
       const apollo::common::ErrorCode error_code,
@@ -134,6 +163,7 @@ class FusionCameraDetectionComponent :
 
   // options for DataProvider
   bool enable_undistortion_ = false;
+  bool enable_fused_preprocessing_ = false;
 
   double timestamp_offset_ = 0.0;
 
@@ -154,6 +184,13 @@ class FusionCameraDetectionComponent :
   double last_timestamp_ = 0.0;
   double ts_diff_ = 1.0;
 
+  // images of the cameras within batch_time_window_ are processed together,
+  // 0 processes every image on its own
+  double batch_time_window_ = 0.0;
+  // camera name -> image waiting for the batch
+  std::map<std::string, std::shared_ptr<apollo::drivers::Image>>
+      pending_images_;
+
   std::shared_ptr<apollo::cyber::Writer<
         apollo::perception::PerceptionObstacles>> writer_;
 
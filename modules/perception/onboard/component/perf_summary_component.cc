@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/onboard/component/perf_summary_component.h"
+
+#include "modules/common/util/message_util.h"
+#include "modules/perception/lib/utils/time_util.h"
+#include "modules/perception/onboard/common_flags/common_flags.h"
+
+namespace apollo {
+namespace perception {
+namespace onboard {
+
+bool PerfSummaryComponent::Init() {
+  writer_ = node_->CreateWriter<PerceptionPerfSummary>(
+      FLAGS_obs_perf_summary_channel);
+  lib::PerfRecorder::Instance()->Enable(true);
+  last_timestamp_ = lib::TimeUtil::GetCurrentTime();
+  return true;
+}
+
+bool PerfSummaryComponent::Proc() {
+  lib::PerfRecorder::Instance()->Summarize(true, &summaries_);
+  const double timestamp = lib::TimeUtil::GetCurrentTime();
+
+  std::shared_ptr<PerceptionPerfSummary> out_message(
+      new PerceptionPerfSummary);
+  common::util::FillHeader("perception", out_message.get());
+  out_message->set_period_sec(timestamp - last_timestamp_);
+  last_timestamp_ = timestamp;
+  for (const auto& summary : summaries_) {
+    PerceptionStagePerf* stage = out_message->add_stages();
+    stage->set_name(summary.name);
+    stage->set_count(summary.count);
+    stage->set_mean_ms(summary.mean_ms);
+    stage->set_p50_ms(summary.p50_ms);
+    stage->set_p90_ms(summary.p90_ms);
+    stage->set_p99_ms(summary.p99_ms);
+    stage->set_max_ms(summary.max_ms);
+  }
+  writer_->Write(out_message);
+  return true;
+}
+
+}  // namespace onboard
+}  // namespace perception
+}  // namespace apollo
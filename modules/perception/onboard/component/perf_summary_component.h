@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "cyber/component/timer_component.h"
+#include "modules/perception/lib/utils/perf_recorder.h"
+#include "modules/perception/proto/perception_perf.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace onboard {
+
+// Enables the PerfRecorder of the process and periodically publishes the
+// stage timings of the PERCEPTION_PERF macros, the interval is the one of the
+// timer component in the dag.
+class PerfSummaryComponent : public cyber::TimerComponent {
+ public:
+  PerfSummaryComponent() = default;
+  ~PerfSummaryComponent() = default;
+
+  bool Init() override;
+  bool Proc() override;
+
+ private:
+  std::shared_ptr<apollo::cyber::Writer<PerceptionPerfSummary>> writer_;
+  std::vector<lib::PerfStageSummary> summaries_;
+  double last_timestamp_ = 0.0;
+};  // class PerfSummaryComponent
+
+CYBER_REGISTER_COMPONENT(PerfSummaryComponent);
+
+}  // namespace onboard
+}  // namespace perception
+}  // namespace apollo
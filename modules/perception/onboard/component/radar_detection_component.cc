@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 #include "modules/perception/onboard/component/radar_detection_component.h"
+
+#include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 #include "modules/perception/lib/utils/perf.h"
 
@@ -99,7 +101,7 @@ bool RadarDetectionComponent::InternalProc(
     const std::shared_ptr<ContiRadar>& in_message,
     std::shared_ptr<SensorFrameMessage> out_message) {
   PERCEPTION_PERF_FUNCTION_WITH_INDICATOR(radar_info_.name);
-  ContiRadar raw_obstacles = *in_message;
+  const ContiRadar& raw_obstacles = *in_message;
   {
     std::unique_lock<std::mutex> lock(_mutex);
     ++seq_num_;
@@ -114,7 +116,8 @@ bool RadarDetectionComponent::InternalProc(
   PERCEPTION_PERF_BLOCK_START();
   // init preprocessor_options
   radar::PreprocessorOptions preprocessor_options;
-  ContiRadar corrected_obstacles;
+  ContiRadar& corrected_obstacles = corrected_obstacles_;
+  corrected_obstacles.Clear();
   radar_preprocessor_->Preprocess(raw_obstacles, preprocessor_options,
                                   &corrected_obstacles);
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(radar_info_.name,
@@ -163,19 +166,26 @@ bool RadarDetectionComponent::InternalProc(
   position.x = radar_trans(0, 3);
   position.y = radar_trans(1, 3);
   position.z = radar_trans(2, 3);
-  options.roi_filter_options.roi.reset(new base::HdmapStruct());
-  if (FLAGS_obs_enable_hdmap_input) {
-    hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
-                                    options.roi_filter_options.roi);
+  if (roi_ == nullptr) {
+    roi_.reset(new base::HdmapStruct());
+  }
+  options.roi_filter_options.roi = roi_;
+  if (FLAGS_obs_enable_hdmap_input &&
+      !hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
+                                       roi_)) {
+    roi_->road_polygons.clear();
+    roi_->road_boundary.clear();
+    roi_->hole_polygons.clear();
+    roi_->junction_polygons.clear();
   }
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(radar_info_.name,
                                            "GetRoiHDMapStruct");
   // init object_filter_options
   // init track_options
   // init object_builder_options
-  std::vector<base::ObjectPtr> radar_objects;
-  bool result =
-      radar_perception_->Perceive(corrected_obstacles, options, &radar_objects);
+  base::FramePtr radar_frame = base::FramePool::Instance().Get();
+  bool result = radar_perception_->Perceive(corrected_obstacles, options,
+                                            &radar_frame->objects);
 
   if (!result) {
     out_message->error_code_ =
@@ -183,11 +193,10 @@ bool RadarDetectionComponent::InternalProc(
     AERROR << "RadarDetector Proc failed.";
     return true;
   }
-  out_message->frame_.reset(new base::Frame());
+  out_message->frame_ = radar_frame;
   out_message->frame_->sensor_info = radar_info_;
   out_message->frame_->timestamp = timestamp;
   out_message->frame_->sensor2world_pose = radar_trans;
-  out_message->frame_->objects = radar_objects;
 
   const double end_timestamp = lib::TimeUtil::GetCurrentTime();
   const double end_latency =
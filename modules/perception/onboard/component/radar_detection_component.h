@@ -86,6 +86,11 @@ class RadarDetectionComponent : public cyber::Component<ContiRadar> {
   std::shared_ptr<radar::BaseRadarObstaclePerception> radar_perception_;
   MsgBuffer<LocalizationEstimate> localization_subscriber_;
   std::shared_ptr<apollo::cyber::Writer<SensorFrameMessage>> writer_;
+
+  // reused across frames, the repeated obstacles of the proto and the roi
+  // polygons keep their memory
+  ContiRadar corrected_obstacles_;
+  std::shared_ptr<base::HdmapStruct> roi_;
 };
 
 CYBER_REGISTER_COMPONENT(RadarDetectionComponent);
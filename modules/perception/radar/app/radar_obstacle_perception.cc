@@ -62,6 +62,9 @@ bool RadarObstaclePerception::Init(const std::string& pipeline_name) {
   CHECK(roi_filter_->Init()) << "radar roi filter init error";
   CHECK(tracker_->Init()) << "radar tracker init error";
 
+  detect_frame_ptr_.reset(new base::Frame());
+  tracker_frame_ptr_.reset(new base::Frame());
+
   return true;
 }
 
@@ -72,28 +75,31 @@ bool RadarObstaclePerception::Perceive(
   PERCEPTION_PERF_FUNCTION();
   const std::string& sensor_name = options.sensor_name;
   PERCEPTION_PERF_BLOCK_START();
-  base::FramePtr detect_frame_ptr(new base::Frame());
+  detect_frame_ptr_->Reset();
   CHECK(detector_->Detect(corrected_obstacles,
                           options.detector_options,
-                          detect_frame_ptr)) << "radar detect error";
+                          detect_frame_ptr_)) << "radar detect error";
   ADEBUG << "Detected frame objects number: "
-           << detect_frame_ptr->objects.size();
+           << detect_frame_ptr_->objects.size();
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "detector");
   CHECK(roi_filter_->RoiFilter(options.roi_filter_options,
-                               detect_frame_ptr)) << "radar roi filter error";
+                               detect_frame_ptr_)) << "radar roi filter error";
   ADEBUG << "RoiFiltered frame objects number: "
-           << detect_frame_ptr->objects.size();
+           << detect_frame_ptr_->objects.size();
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "roi_filter");
 
-  base::FramePtr tracker_frame_ptr = std::make_shared<base::Frame>();
-  CHECK(tracker_->Track(*detect_frame_ptr,
+  tracker_frame_ptr_->Reset();
+  CHECK(tracker_->Track(*detect_frame_ptr_,
                         options.track_options,
-                        tracker_frame_ptr)) << "radar track error";
+                        tracker_frame_ptr_)) << "radar track error";
   ADEBUG << "tracked frame objects number: "
-           << tracker_frame_ptr->objects.size();
+           << tracker_frame_ptr_->objects.size();
   PERCEPTION_PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "tracker");
 
-  *objects = tracker_frame_ptr->objects;
+  objects->clear();
+  objects->swap(tracker_frame_ptr_->objects);
+  // release the detected objects to the pool
+  detect_frame_ptr_->objects.clear();
 
   return true;
 }
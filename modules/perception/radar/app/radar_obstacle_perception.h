@@ -41,6 +41,9 @@ class RadarObstaclePerception : public BaseRadarObstaclePerception{
   std::shared_ptr<BaseDetector> detector_;
   std::shared_ptr<BaseRoiFilter> roi_filter_;
   std::shared_ptr<BaseTracker> tracker_;
+  // frames reused across the cycles of the radar
+  base::FramePtr detect_frame_ptr_;
+  base::FramePtr tracker_frame_ptr_;
 };
 
 }  // namespace radar
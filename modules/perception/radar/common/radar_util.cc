@@ -19,7 +19,7 @@ namespace apollo {
 namespace perception {
 namespace radar {
 
-void MockRadarPolygon(base::ObjectPtr object) {
+void MockRadarPolygon(const base::ObjectPtr& object) {
   double theta = object->theta;
   const auto& center = object->center;
   double length = object->size(0);
@@ -21,7 +21,7 @@ namespace apollo {
 namespace perception {
 namespace radar {
 
-void MockRadarPolygon(base::ObjectPtr object);
+void MockRadarPolygon(const base::ObjectPtr& object);
 
 }  // namespace radar
 }  // namespace perception
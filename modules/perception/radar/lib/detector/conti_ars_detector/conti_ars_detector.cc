@@ -16,6 +16,9 @@
 #include "modules/perception/radar/lib/detector/conti_ars_detector/conti_ars_detector.h"
 
 #include <memory>
+#include <vector>
+
+#include "modules/perception/base/object_pool_types.h"
 
 namespace apollo {
 namespace perception {
@@ -59,8 +62,14 @@ void ContiArsDetector::RawObs2Frame(
   ADEBUG << "radar2novatel: " << radar2novatel;
   ADEBUG << "angular_speed: " << angular_speed;
   ADEBUG << "rotation_radar: " << rotation_radar;
-  for (const auto radar_obs : corrected_obstacles.contiobs()) {
-    base::ObjectPtr radar_object = std::make_shared<base::Object>();
+  // objects of the whole frame are taken from the pool at once, straight
+  // into the frame
+  size_t object_index = radar_frame->objects.size();
+  base::ObjectPool::Instance().BatchGet(corrected_obstacles.contiobs_size(),
+                                        &radar_frame->objects);
+  for (const auto& radar_obs : corrected_obstacles.contiobs()) {
+    const base::ObjectPtr& radar_object =
+        radar_frame->objects[object_index++];
     radar_object->id = radar_obs.obstacle_id();
     radar_object->track_id = radar_obs.obstacle_id();
     Eigen::Vector4d local_loc(radar_obs.longitude_dist(),
@@ -161,8 +170,6 @@ void ContiArsDetector::RawObs2Frame(
     radar_object->radar_supplement.range = local_range;
     radar_object->radar_supplement.angle = local_angle;
 
-    radar_frame->objects.push_back(radar_object);
-
     ADEBUG << "obs_id: " << radar_obs.obstacle_id() << ", "
               << "long_dist: " << radar_obs.longitude_dist() << ", "
               << "lateral_dist: " << radar_obs.lateral_dist() << ", "
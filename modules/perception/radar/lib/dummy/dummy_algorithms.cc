@@ -15,6 +15,8 @@
 *****************************************************************************/
 #include "modules/perception/radar/lib/dummy/dummy_algorithms.h"
 
+#include "modules/perception/base/object_pool_types.h"
+
 namespace apollo {
 namespace perception {
 namespace radar {
@@ -23,7 +25,7 @@ void DummyDetector::ContiObs2Frame(
         const drivers::ContiRadar& corrected_obstacles,
         base::FramePtr radar_frame) {
   for (const auto& radar_obs : corrected_obstacles.contiobs()) {
-    base::ObjectPtr radar_object(new base::Object);
+    base::ObjectPtr radar_object = base::ObjectPool::Instance().Get();
     radar_object->id = radar_obs.obstacle_id();
     radar_object->track_id = radar_obs.obstacle_id();
     radar_object->center(0) = radar_obs.longitude_dist();
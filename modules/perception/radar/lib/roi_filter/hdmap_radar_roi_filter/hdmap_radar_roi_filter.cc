@@ -24,10 +24,11 @@ namespace radar {
 bool HdmapRadarRoiFilter::RoiFilter(
           const RoiFilterOptions& options,
           base::FramePtr radar_frame) {
-  std::vector<base::ObjectPtr> origin_objects = radar_frame->objects;
+  origin_objects_.swap(radar_frame->objects);
   common::ObjectInRoiCheck(options.roi,
-                           origin_objects,
+                           origin_objects_,
                            &radar_frame->objects);
+  origin_objects_.clear();
   return true;
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "cyber/common/macros.h"
 #include "modules/perception/radar/lib/interface/base_roi_filter.h"
@@ -38,6 +39,9 @@ class HdmapRadarRoiFilter : public BaseRoiFilter {
   std::string Name() const override;
 
  private:
+  // objects before the filter, reused across frames
+  std::vector<base::ObjectPtr> origin_objects_;
+
   DISALLOW_COPY_AND_ASSIGN(HdmapRadarRoiFilter);
 };
 
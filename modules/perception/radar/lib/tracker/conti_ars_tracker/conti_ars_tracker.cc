@@ -15,6 +15,8 @@
 *****************************************************************************/
 #include "modules/perception/radar/lib/tracker/conti_ars_tracker/conti_ars_tracker.h"
 
+#include "modules/perception/base/object_pool_types.h"
+
 namespace apollo {
 namespace perception {
 namespace radar {
@@ -95,21 +97,22 @@ bool ContiArsTracker::Track(const base::Frame &detected_frame,
 }
 
 void ContiArsTracker::TrackObjects(const base::Frame &radar_frame) {
-  std::vector<TrackObjectPair> assignments;
-  std::vector<size_t> unassigned_tracks;
-  std::vector<size_t> unassigned_objects;
+  assignments_.clear();
+  unassigned_tracks_.clear();
+  unassigned_objects_.clear();
   TrackObjectMatcherOptions matcher_options;
   const auto &radar_tracks = track_manager_->GetTracks();
-  matcher_->Match(radar_tracks, radar_frame, matcher_options, &assignments,
-                  &unassigned_tracks, &unassigned_objects);
-  UpdateAssignedTracks(radar_frame, assignments);
-  UpdateUnassignedTracks(radar_frame, unassigned_tracks);
+  matcher_->Match(radar_tracks, radar_frame, matcher_options, &assignments_,
+                  &unassigned_tracks_, &unassigned_objects_);
+  UpdateAssignedTracks(radar_frame, assignments_);
+  UpdateUnassignedTracks(radar_frame, unassigned_tracks_);
   DeleteLostTracks();
-  CreateNewTracks(radar_frame, unassigned_objects);
+  CreateNewTracks(radar_frame, unassigned_objects_);
 }
 
 void ContiArsTracker::UpdateAssignedTracks(
-    const base::Frame &radar_frame, std::vector<TrackObjectPair> assignments) {
+    const base::Frame &radar_frame,
+    const std::vector<TrackObjectPair> &assignments) {
   auto &radar_tracks = track_manager_->mutable_tracks();
   for (size_t i = 0; i < assignments.size(); ++i) {
     radar_tracks[assignments[i].first]->UpdataObsRadar(
@@ -152,9 +155,10 @@ void ContiArsTracker::CollectTrackedFrame(base::FramePtr tracked_frame) {
   CHECK(tracked_frame != nullptr) << "tracked_frame is nullptr";
   auto &objects = tracked_frame->objects;
   const auto &radar_tracks = track_manager_->GetTracks();
+  objects.reserve(objects.size() + radar_tracks.size());
   for (size_t i = 0; i < radar_tracks.size(); ++i) {
     if (radar_tracks[i]->ConfirmTrack()) {
-      base::ObjectPtr object = base::ObjectPtr(new base::Object());
+      base::ObjectPtr object = base::ObjectPool::Instance().Get();
       const base::ObjectPtr &track_object = radar_tracks[i]->GetObs();
       *object = *track_object;
       object->tracking_time = radar_tracks[i]->GetTrackingTime();
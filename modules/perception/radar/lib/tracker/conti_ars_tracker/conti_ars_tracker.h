@@ -43,7 +43,7 @@ class ContiArsTracker : public BaseTracker {
   static double s_tracking_time_win_;
   void TrackObjects(const base::Frame &radar_frame);
   void UpdateAssignedTracks(const base::Frame &radar_frame,
-                            std::vector<TrackObjectPair> assignments);
+                            const std::vector<TrackObjectPair> &assignments);
   void UpdateUnassignedTracks(const base::Frame &radar_frame,
                               const std::vector<size_t> &unassigned_tracks);
   void DeleteLostTracks();
@@ -51,6 +51,11 @@ class ContiArsTracker : public BaseTracker {
                        const std::vector<size_t> &unassigned_objects);
   void CollectTrackedFrame(base::FramePtr tracked_frame);
 
+  // match results, reused across frames
+  std::vector<TrackObjectPair> assignments_;
+  std::vector<size_t> unassigned_tracks_;
+  std::vector<size_t> unassigned_objects_;
+
   DISALLOW_COPY_AND_ASSIGN(ContiArsTracker);
 };
 }  // namespace radar
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena.cc
+ **/
+
+#include "modules/planning/common/arena.h"
+
+#include <cstdint>
+
+#include "cyber/common/log.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// keeps up to 16MB of released blocks around for the next frames
+constexpr size_t kMaxPooledBlocks = 256;
+
+// Released blocks of the default size, shared by all the arenas.
+class BlockPool {
+ public:
+  static BlockPool* Instance() {
+    static BlockPool* pool = new BlockPool();
+    return pool;
+  }
+
+  char* Take() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (blocks_.empty()) {
+      return nullptr;
+    }
+    char* block = blocks_.back();
+    blocks_.pop_back();
+    return block;
+  }
+
+  // returns false if the pool is full and the caller keeps the block
+  bool Put(char* block) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (blocks_.size() >= kMaxPooledBlocks) {
+      return false;
+    }
+    blocks_.push_back(block);
+    return true;
+  }
+
+ private:
+  BlockPool() { blocks_.reserve(kMaxPooledBlocks); }
+
+  std::mutex mutex_;
+  std::vector<char*> blocks_;
+};
+
+}  // namespace
+
+constexpr size_t Arena::kDefaultBlockSize;
+
+Arena::Arena(const size_t block_size) : block_size_(block_size) {
+  CHECK_GT(block_size_, 0);
+}
+
+Arena::~Arena() { ReleaseBlocks(); }
+
+void* Arena::Allocate(const size_t bytes, const size_t alignment) {
+  DCHECK_EQ(alignment & (alignment - 1), 0);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.num_allocations;
+  stats_.allocated_bytes += bytes;
+
+  auto align = [alignment](char* p) {
+    const auto address = reinterpret_cast<std::uintptr_t>(p);
+    return reinterpret_cast<char*>((address + alignment - 1) &
+                                   ~(alignment - 1));
+  };
+
+  // large objects get a block of their own, so the current block is not
+  // wasted
+  if (bytes > block_size_ / 4) {
+    Block block = NewBlock(bytes + alignment);
+    return align(block.data);
+  }
+
+  char* p = cursor_ == nullptr ? nullptr : align(cursor_);
+  if (p == nullptr || p + bytes > limit_) {
+    Block block = NewBlock(block_size_);
+    cursor_ = block.data;
+    limit_ = block.data + block.size;
+    p = align(cursor_);
+    CHECK_LE(p + bytes, limit_);
+  }
+  cursor_ = p + bytes;
+  return p;
+}
+
+void Arena::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ReleaseBlocks();
+  blocks_.clear();
+  cursor_ = nullptr;
+  limit_ = nullptr;
+  stats_ = Stats();
+}
+
+Arena::Stats Arena::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::string Arena::DebugString() const {
+  const auto s = stats();
+  return common::util::StrCat(
+      "allocations: ", s.num_allocations, ", allocated: ", s.allocated_bytes,
+      "B, reserved: ", s.reserved_bytes, "B, blocks: ", s.num_blocks,
+      " (pooled: ", s.num_pooled_blocks, ")");
+}
+
+Arena::Block Arena::NewBlock(const size_t size) {
+  Block block;
+  block.size = size;
+  if (size == kDefaultBlockSize) {
+    block.data = BlockPool::Instance()->Take();
+    if (block.data != nullptr) {
+      ++stats_.num_pooled_blocks;
+    }
+  }
+  if (block.data == nullptr) {
+    block.data = static_cast<char*>(::operator new(size));
+  }
+  blocks_.push_back(block);
+  ++stats_.num_blocks;
+  stats_.reserved_bytes += size;
+  return block;
+}
+
+void Arena::ReleaseBlocks() {
+  for (const auto& block : blocks_) {
+    if (block.size == kDefaultBlockSize &&
+        BlockPool::Instance()->Put(block.data)) {
+      continue;
+    }
+    ::operator delete(block.data);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena.h
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class Arena
+ * @brief A monotonic allocator for the objects of one planning frame.
+ * Memory is handed out from blocks which are only released, as a whole, when
+ * the arena is reset or destroyed. Released blocks of the default size are
+ * kept in a process-wide pool and reused by the arena of the next frame, so
+ * a steady planning loop stops going to the heap for them.
+ */
+class Arena {
+ public:
+  struct Stats {
+    size_t num_allocations = 0;
+    size_t allocated_bytes = 0;
+    size_t reserved_bytes = 0;
+    size_t num_blocks = 0;
+    size_t num_pooled_blocks = 0;
+  };
+
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  explicit Arena(const size_t block_size = kDefaultBlockSize);
+
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /**
+   * @brief Allocates bytes aligned to alignment, which must be a power of
+   * two. It is safe to call from several threads.
+   */
+  void* Allocate(const size_t bytes, const size_t alignment);
+
+  /**
+   * @brief Releases all the memory of the arena. Objects allocated from it
+   * must have been destroyed.
+   */
+  void Reset();
+
+  Stats stats() const;
+
+  std::string DebugString() const;
+
+ private:
+  struct Block {
+    char* data = nullptr;
+    size_t size = 0;
+  };
+
+  Block NewBlock(const size_t size);
+
+  void ReleaseBlocks();
+
+  const size_t block_size_;
+  mutable std::mutex mutex_;
+  std::vector<Block> blocks_;
+  // the block allocations are currently taken from
+  char* cursor_ = nullptr;
+  char* limit_ = nullptr;
+  Stats stats_;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief A standard allocator backed by an arena, or by the heap when the
+ * arena is null. Copies of a container allocate from the heap, so only the
+ * container constructed with the arena is tied to its lifetime.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::false_type propagate_on_container_move_assignment;
+  typedef std::false_type propagate_on_container_swap;
+
+  ArenaAllocator() = default;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(const size_t n) {
+    if (arena_ == nullptr) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, const size_t) {
+    if (arena_ == nullptr) {
+      ::operator delete(p);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena_test.cc
+ **/
+
+#include "modules/planning/common/arena.h"
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/indexed_list.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(Arena, Allocate) {
+  Arena arena;
+  char* a = static_cast<char*>(arena.Allocate(3, 1));
+  auto* b = static_cast<double*>(arena.Allocate(sizeof(double), 8));
+  EXPECT_NE(nullptr, a);
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(b) % 8);
+  EXPECT_GE(reinterpret_cast<char*>(b), a + 3);
+  *b = 1.0;
+
+  auto stats = arena.stats();
+  EXPECT_EQ(2, stats.num_allocations);
+  EXPECT_EQ(3 + sizeof(double), stats.allocated_bytes);
+  EXPECT_EQ(1, stats.num_blocks);
+  EXPECT_EQ(Arena::kDefaultBlockSize, stats.reserved_bytes);
+
+  // a large allocation gets a block of its own
+  arena.Allocate(Arena::kDefaultBlockSize, 16);
+  stats = arena.stats();
+  EXPECT_EQ(2, stats.num_blocks);
+  EXPECT_EQ(2 * Arena::kDefaultBlockSize + 16, stats.reserved_bytes);
+
+  arena.Reset();
+  stats = arena.stats();
+  EXPECT_EQ(0, stats.num_allocations);
+  EXPECT_EQ(0, stats.num_blocks);
+}
+
+TEST(Arena, ReuseBlocks) {
+  {
+    Arena arena;
+    arena.Allocate(16, 8);
+  }
+  Arena arena;
+  arena.Allocate(16, 8);
+  EXPECT_EQ(1, arena.stats().num_pooled_blocks);
+}
+
+TEST(Arena, IndexedList) {
+  Arena arena;
+  IndexedList<int, std::string> list(&arena);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_NE(nullptr, list.Add(i, std::to_string(i)));
+  }
+  EXPECT_LT(0, arena.stats().num_allocations);
+  ASSERT_NE(nullptr, list.Find(42));
+  EXPECT_EQ("42", *list.Find(42));
+
+  // a copy does not allocate from the arena
+  const auto num_allocations = arena.stats().num_allocations;
+  IndexedList<int, std::string> copy;
+  copy = list;
+  auto dict = list.Dict();
+  EXPECT_EQ(100, copy.Items().size());
+  EXPECT_EQ(100, dict.size());
+  EXPECT_EQ(nullptr, dict.get_allocator().arena());
+  EXPECT_EQ(num_allocations, arena.stats().num_allocations);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,6 +20,7 @@
 #include "modules/planning/common/frame.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 #include "modules/routing/proto/routing.pb.h"
@@ -78,6 +79,13 @@ Frame::Frame(uint32_t sequence_num, const LocalView &local_view,
     : Frame(sequence_num, local_view, planning_start_point, start_time,
             vehicle_state, nullptr, output_trajectory) {}
 
+std::unique_ptr<Arena> Frame::CreateArena() {
+  if (!FLAGS_enable_frame_arena) {
+    return nullptr;
+  }
+  return std::unique_ptr<Arena>(new Arena());
+}
+
 const common::TrajectoryPoint &Frame::PlanningStartPoint() const {
   return planning_start_point_;
 }
@@ -175,7 +183,9 @@ bool Frame::CreateReferenceLineInfo(
       is_near_destination_ = true;
     }
     reference_line_info_.emplace_back(vehicle_state_, planning_start_point_,
-                                      *ref_line_iter, *segments_iter);
+                                      *ref_line_iter, *segments_iter,
+                                      arena_.get());
+    reference_line_info_.back().SetObstacleBoxIndex(obstacle_box_index_.get());
     ++ref_line_iter;
     ++segments_iter;
   }
@@ -381,6 +391,15 @@ Status Frame::InitFrameData() {
        Obstacle::CreateObstacles(*local_view_.prediction_obstacles)) {
     AddObstacle(*ptr);
   }
+  if (FLAGS_use_obstacle_box_index) {
+    // long enough for the lattice trajectories and the prediction horizon
+    const double time_length =
+        std::fmax(FLAGS_trajectory_time_length, FLAGS_prediction_total_time);
+    const auto num_slices = static_cast<size_t>(
+        std::ceil(time_length / FLAGS_trajectory_time_resolution) + 1);
+    obstacle_box_index_ = std::make_shared<ObstacleBoxIndex>(
+        obstacles(), FLAGS_trajectory_time_resolution, num_slices);
+  }
   if (FLAGS_enable_collision_detection && planning_start_point_.v() < 1e-3) {
     const auto *collision_obstacle = FindCollisionObstacle();
     if (collision_obstacle != nullptr) {
@@ -22,6 +22,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,11 +38,13 @@
 #include "modules/common/math/vec2d.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
+#include "modules/planning/common/arena.h"
 #include "modules/planning/common/change_lane_decider.h"
 #include "modules/planning/common/indexed_queue.h"
 // #include "modules/planning/common/lag_prediction.h"
 #include "modules/planning/common/local_view.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_index.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/common/trajectory_info.h"
@@ -160,6 +163,11 @@ class Frame {
 
   ThreadSafeIndexedObstacles *GetObstacleList() { return &obstacles_; }
 
+  // nullptr unless FLAGS_use_obstacle_box_index is set
+  const ObstacleBoxIndex *obstacle_box_index() const {
+    return obstacle_box_index_.get();
+  }
+
  private:
   common::Status InitFrameData();
 
@@ -182,13 +190,23 @@ class Frame {
 
   void AddObstacle(const Obstacle &obstacle);
 
+  /**
+   * @brief the arena the obstacles of the frame and of its reference lines
+   * are allocated from, nullptr if disabled.
+   */
+  const Arena *arena() const { return arena_.get(); }
+
  private:
+  static std::unique_ptr<Arena> CreateArena();
+
   uint32_t sequence_num_ = 0;
   LocalView local_view_;
   const hdmap::HDMap *hdmap_ = nullptr;
   common::TrajectoryPoint planning_start_point_;
   double start_time_ = 0.0;
   common::VehicleState vehicle_state_;
+  // declared before the containers allocating from it
+  std::unique_ptr<Arena> arena_ = CreateArena();
   std::list<ReferenceLineInfo> reference_line_info_;
   std::list<TrajectoryInfo> trajectory_info_;
 
@@ -199,7 +217,9 @@ class Frame {
    **/
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
-  ThreadSafeIndexedObstacles obstacles_;
+  ThreadSafeIndexedObstacles obstacles_{arena_.get()};
+  // predicted boxes of the obstacles above, shared by the reference lines
+  std::shared_ptr<const ObstacleBoxIndex> obstacle_box_index_;
   ChangeLaneDecider change_lane_decider_;
   ADCTrajectory trajectory_;  // last published trajectory
 
@@ -20,13 +20,16 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <functional>
+#include <new>
+#include <utility>
 #include <vector>
 
 #include "boost/thread/shared_mutex.hpp"
 
 #include "cyber/common/log.h"
-#include "modules/common/util/map_util.h"
+#include "modules/common/util/flat_hash_map.h"
+#include "modules/planning/common/arena.h"
 
 namespace apollo {
 namespace planning {
@@ -34,6 +37,35 @@ namespace planning {
 template <typename I, typename T>
 class IndexedList {
  public:
+  typedef apollo::common::util::FlatHashMap<
+      I, T*, std::hash<I>, std::equal_to<I>,
+      ArenaAllocator<std::pair<const I, T*>>>
+      ObjectDict;
+
+  static constexpr size_t kDefaultCapacity = 64;
+
+  IndexedList() : IndexedList(nullptr) {}
+
+  /**
+   * @brief the objects and the index are allocated from the arena, which must
+   * outlive the container. Copies of the container allocate from the heap.
+   * The index and the item list are sized for capacity objects, and are only
+   * regrown when more are added.
+   */
+  explicit IndexedList(Arena* arena, const size_t capacity = kDefaultCapacity)
+      : object_allocator_(arena),
+        object_dict_(capacity, ArenaAllocator<std::pair<const I, T*>>(arena)) {
+    object_list_.reserve(object_dict_.capacity());
+  }
+
+  IndexedList(const IndexedList& other)
+      : object_dict_(other.object_dict_.size()) {
+    object_list_.reserve(object_dict_.capacity());
+    *this = other;
+  }
+
+  ~IndexedList() { Clear(); }
+
   /**
    * @brief copy object into the container. If the id is already exist,
    * overwrite the object in the container.
@@ -48,12 +80,16 @@ class IndexedList {
       AWARN << "object " << id << " is already in container";
       *obs = object;
       return obs;
-    } else {
-      object_dict_.insert({id, object});
-      auto* ptr = &object_dict_.at(id);
-      object_list_.push_back(ptr);
-      return ptr;
     }
+    if (object_dict_.full()) {
+      object_dict_.reserve(2 * object_dict_.capacity());
+      object_list_.reserve(object_dict_.capacity());
+    }
+    T* ptr = object_allocator_.allocate(1);
+    new (ptr) T(object);
+    object_dict_.emplace(id, ptr);
+    object_list_.push_back(ptr);
+    return ptr;
   }
 
   /**
@@ -63,7 +99,8 @@ class IndexedList {
    * @return nullptr if the object is not found.
    */
   T* Find(const I id) {
-    return apollo::common::util::FindOrNull(object_dict_, id);
+    auto iter = object_dict_.find(id);
+    return iter == object_dict_.end() ? nullptr : iter->second;
   }
 
   /**
@@ -73,7 +110,8 @@ class IndexedList {
    * @return nullptr if the object is not found.
    */
   const T* Find(const I id) const {
-    return apollo::common::util::FindOrNull(object_dict_, id);
+    auto iter = object_dict_.find(id);
+    return iter == object_dict_.end() ? nullptr : iter->second;
   }
 
   /**
@@ -84,30 +122,45 @@ class IndexedList {
 
   /**
    * @brief List all the items in the container.
-   * @return the unordered_map of ids and objects in the container.
+   * @return the map of ids and object pointers in the container.
    */
-  const std::unordered_map<I, T>& Dict() const { return object_dict_; }
+  const ObjectDict& Dict() const { return object_dict_; }
 
   /**
    * @brief Copy the container with objects.
    */
   IndexedList& operator=(const IndexedList& other) {
-    this->object_list_.clear();
-    this->object_dict_.clear();
-    for (const auto& item : other.Dict()) {
-      Add(item.first, item.second);
+    if (this != &other) {
+      Clear();
+      for (const auto& item : other.Dict()) {
+        Add(item.first, *item.second);
+      }
     }
     return *this;
   }
 
  private:
+  void Clear() {
+    for (const T* item : object_list_) {
+      item->~T();
+      object_allocator_.deallocate(const_cast<T*>(item), 1);
+    }
+    object_list_.clear();
+    object_dict_.clear();
+  }
+
+  ArenaAllocator<T> object_allocator_;
   std::vector<const T*> object_list_;
-  std::unordered_map<I, T> object_dict_;
+  ObjectDict object_dict_;
 };
 
 template <typename I, typename T>
 class ThreadSafeIndexedList : public IndexedList<I, T> {
  public:
+  ThreadSafeIndexedList() = default;
+
+  explicit ThreadSafeIndexedList(Arena* arena) : IndexedList<I, T>(arena) {}
+
   T* Add(const I id, const T& object) {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     return IndexedList<I, T>::Add(id, object);
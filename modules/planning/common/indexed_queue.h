@@ -21,58 +21,72 @@
 #pragma once
 
 #include <memory>
-#include <queue>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
-#include "modules/common/util/map_util.h"
+#include "modules/common/util/flat_hash_map.h"
 
 namespace apollo {
 namespace planning {
 
+/**
+ * @class IndexedQueue
+ * @brief Keeps the latest capacity objects by id. The ids are kept in a ring
+ * and the objects in a map, both sized for capacity up front, so adding an
+ * object evicts the oldest one without allocating.
+ */
 template <typename I, typename T>
 class IndexedQueue {
  public:
   // Get infinite capacity with 0.
-  explicit IndexedQueue(size_t capacity) : capacity_(capacity) {}
+  explicit IndexedQueue(size_t capacity)
+      : capacity_(capacity), map_(capacity) {
+    ids_.reserve(capacity);
+  }
 
   const T *Find(const I id) const {
-    auto *result = apollo::common::util::FindOrNull(map_, id);
-    return result ? result->get() : nullptr;
+    auto iter = map_.find(id);
+    return iter == map_.end() ? nullptr : iter->second.get();
   }
 
   const T *Latest() const {
-    if (queue_.empty()) {
+    if (ids_.empty()) {
       return nullptr;
     }
-    return Find(queue_.back().first);
+    return Find(ids_[(head_ + ids_.size() - 1) % ids_.size()]);
   }
 
   bool Add(const I id, std::unique_ptr<T> ptr) {
     if (Find(id)) {
       return false;
     }
-    if (capacity_ > 0 && queue_.size() == capacity_) {
-      map_.erase(queue_.front().first);
-      queue_.pop();
+    if (capacity_ > 0 && ids_.size() == capacity_) {
+      map_.erase(ids_[head_]);
+      ids_[head_] = id;
+      head_ = (head_ + 1) % capacity_;
+    } else {
+      ids_.push_back(id);
     }
-    queue_.push(std::make_pair(id, ptr.get()));
-    map_[id] = std::move(ptr);
+    if (map_.full()) {
+      // only with infinite capacity
+      map_.reserve(2 * map_.capacity() + 1);
+    }
+    map_.emplace(id, std::move(ptr));
     return true;
   }
 
   void Clear() {
-    capacity_ = 0;
-    while (!queue_.empty()) {
-      queue_.pop();
-    }
+    ids_.clear();
+    head_ = 0;
     map_.clear();
   }
 
  public:
   size_t capacity_ = 0;
-  std::queue<std::pair<I, const T *>> queue_;
-  std::unordered_map<I, std::unique_ptr<T>> map_;
+  // the oldest id is at head_ once the ring is full
+  std::vector<I> ids_;
+  size_t head_ = 0;
+  apollo::common::util::FlatHashMap<I, std::unique_ptr<T>> map_;
 };
 
 }  // namespace planning
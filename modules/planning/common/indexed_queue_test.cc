@@ -59,5 +59,29 @@ TEST(IndexedQueue, QueueSize2) {
   ASSERT_EQ("three", *object.Latest());
 }
 
+TEST(IndexedQueue, Clear) {
+  StringIndexedQueue object(2);
+  ASSERT_TRUE(object.Add(1, std::make_unique<std::string>("one")));
+  object.Clear();
+  ASSERT_TRUE(object.Find(1) == nullptr);
+  ASSERT_TRUE(object.Latest() == nullptr);
+  // the capacity is kept
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(object.Add(i, std::make_unique<std::string>("")));
+  }
+  ASSERT_TRUE(object.Find(7) == nullptr);
+  ASSERT_TRUE(object.Find(8) != nullptr);
+  ASSERT_TRUE(object.Find(9) != nullptr);
+}
+
+TEST(IndexedQueue, Unbounded) {
+  StringIndexedQueue object(0);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(object.Add(i, std::make_unique<std::string>("")));
+  }
+  ASSERT_TRUE(object.Find(0) != nullptr);
+  ASSERT_TRUE(object.Latest() == object.Find(99));
+}
+
 }  // namespace planning
 }  // namespace apollo
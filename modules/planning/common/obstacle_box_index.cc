@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file obstacle_box_index.cc
+ **/
+
+#include "modules/planning/common/obstacle_box_index.h"
+
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABoxKDTree2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+ObstacleBoxIndex::ObstacleBoxIndex(const std::vector<const Obstacle*>& obstacles,
+                                   const double time_resolution,
+                                   const size_t num_slices)
+    : time_resolution_(time_resolution) {
+  CHECK_GT(time_resolution, 0.0);
+  for (const auto* obstacle : obstacles) {
+    if (obstacle->IsVirtual()) {
+      continue;
+    }
+    obstacle_index_[obstacle->Id()] = static_cast<int>(obstacle_ids_.size());
+    obstacle_ids_.push_back(obstacle->Id());
+  }
+
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 4;
+  boxes_.resize(num_slices);
+  trees_.reserve(num_slices);
+  for (size_t i = 0; i < num_slices; ++i) {
+    const double relative_time = static_cast<double>(i) * time_resolution;
+    auto& boxes = boxes_[i];
+    boxes.reserve(obstacle_ids_.size());
+    for (const auto* obstacle : obstacles) {
+      if (obstacle->IsVirtual()) {
+        continue;
+      }
+      // If an obstacle has no trajectory, it is considered as static.
+      // Obstacle::GetPointAtTime has handled this case.
+      const auto point = obstacle->GetPointAtTime(relative_time);
+      boxes.emplace_back(obstacle_index_[obstacle->Id()],
+                         obstacle->GetBoundingBox(point));
+    }
+    trees_.emplace_back(new AABoxKDTree2d<ObstacleBox>(boxes, params));
+  }
+}
+
+bool ObstacleBoxIndex::Covers(const double time_resolution,
+                              const size_t num_slices) const {
+  constexpr double kEpsilon = 1e-9;
+  return std::fabs(time_resolution - time_resolution_) < kEpsilon &&
+         num_slices <= trees_.size();
+}
+
+int ObstacleBoxIndex::ObstacleIndex(const std::string& id) const {
+  auto iter = obstacle_index_.find(id);
+  return iter == obstacle_index_.end() ? -1 : iter->second;
+}
+
+std::vector<const ObstacleBoxIndex::ObstacleBox*> ObstacleBoxIndex::GetBoxes(
+    const size_t slice, const Vec2d& point, const double distance) const {
+  CHECK_LT(slice, trees_.size());
+  return trees_[slice]->GetObjects(point, distance);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file obstacle_box_index.h
+ **/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleBoxIndex
+ * @brief The predicted bounding boxes of the obstacles of one frame, sampled
+ * every time_resolution seconds and indexed by a kd-tree per time slice. A
+ * collision query then only looks at the boxes near the ego box instead of
+ * every obstacle.
+ */
+class ObstacleBoxIndex {
+ public:
+  class ObstacleBox {
+   public:
+    ObstacleBox(const int obstacle_index, const common::math::Box2d& box)
+        : obstacle_index_(obstacle_index),
+          box_(box),
+          aabox_(box.GetAABox()) {}
+
+    // index of the obstacle in the index, see ObstacleIndex()
+    int obstacle_index() const { return obstacle_index_; }
+    // unbuffered bounding box of the obstacle at the time of the slice
+    const common::math::Box2d& box() const { return box_; }
+
+    const common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return box_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = box_.DistanceTo(point);
+      return distance * distance;
+    }
+
+   private:
+    int obstacle_index_ = 0;
+    common::math::Box2d box_;
+    common::math::AABox2d aabox_;
+  };
+
+  /**
+   * @brief Indexes the non-virtual obstacles at times 0, time_resolution, ...
+   * (num_slices - 1) * time_resolution.
+   */
+  ObstacleBoxIndex(const std::vector<const Obstacle*>& obstacles,
+                   const double time_resolution, const size_t num_slices);
+
+  double time_resolution() const { return time_resolution_; }
+  size_t num_slices() const { return trees_.size(); }
+  size_t num_obstacles() const { return obstacle_ids_.size(); }
+
+  /**
+   * @brief Whether slice i is at i * time_resolution for every i below
+   * num_slices, so a caller stepping by time_resolution can use it.
+   */
+  bool Covers(const double time_resolution, const size_t num_slices) const;
+
+  /**
+   * @return The index of the obstacle with the given id, -1 if it is not
+   * indexed.
+   */
+  int ObstacleIndex(const std::string& id) const;
+
+  /**
+   * @brief Gets the boxes of slice whose distance to point is at most
+   * distance.
+   */
+  std::vector<const ObstacleBox*> GetBoxes(const size_t slice,
+                                           const common::math::Vec2d& point,
+                                           const double distance) const;
+
+ private:
+  double time_resolution_ = 0.0;
+  std::vector<std::string> obstacle_ids_;
+  std::unordered_map<std::string, int> obstacle_index_;
+  // the trees point into boxes_
+  std::vector<std::vector<ObstacleBox>> boxes_;
+  std::vector<std::unique_ptr<common::math::AABoxKDTree2d<ObstacleBox>>>
+      trees_;
+};
+
+}  // namespace planning
+}  // namespace apollo
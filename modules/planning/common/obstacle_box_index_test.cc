@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_box_index.h"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+class ObstacleBoxIndexTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    prediction::PredictionObstacles prediction_obstacles;
+    ASSERT_TRUE(common::util::GetProtoFromFile(
+        "modules/planning/common/testdata/sample_prediction.pb.txt",
+        &prediction_obstacles));
+    owned_obstacles_ = Obstacle::CreateObstacles(prediction_obstacles);
+    for (const auto& obstacle : owned_obstacles_) {
+      obstacles_.push_back(obstacle.get());
+    }
+  }
+
+ protected:
+  std::list<std::unique_ptr<Obstacle>> owned_obstacles_;
+  std::vector<const Obstacle*> obstacles_;
+};
+
+TEST_F(ObstacleBoxIndexTest, MatchesLinearSearch) {
+  constexpr double kTimeResolution = 0.5;
+  constexpr size_t kNumSlices = 10;
+  ObstacleBoxIndex index(obstacles_, kTimeResolution, kNumSlices);
+  EXPECT_EQ(kNumSlices, index.num_slices());
+  EXPECT_EQ(obstacles_.size(), index.num_obstacles());
+  EXPECT_TRUE(index.Covers(kTimeResolution, kNumSlices));
+  EXPECT_FALSE(index.Covers(0.1, kNumSlices));
+  EXPECT_FALSE(index.Covers(kTimeResolution, kNumSlices + 1));
+  EXPECT_EQ(-1, index.ObstacleIndex("no_such_obstacle"));
+
+  for (size_t slice = 0; slice < kNumSlices; ++slice) {
+    const double relative_time = static_cast<double>(slice) * kTimeResolution;
+    for (const auto* center : obstacles_) {
+      const auto point = center->GetPointAtTime(relative_time);
+      const Vec2d query(point.path_point().x(), point.path_point().y());
+      for (const double distance : {0.0, 5.0, 50.0}) {
+        std::vector<int> expected;
+        for (const auto* obstacle : obstacles_) {
+          const auto box =
+              obstacle->GetBoundingBox(obstacle->GetPointAtTime(relative_time));
+          if (box.DistanceTo(query) <= distance) {
+            expected.push_back(index.ObstacleIndex(obstacle->Id()));
+          }
+        }
+        std::vector<int> found;
+        for (const auto* box : index.GetBoxes(slice, query, distance)) {
+          found.push_back(box->obstacle_index());
+        }
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected, found);
+      }
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -40,6 +40,12 @@ class PathDecision {
  public:
   PathDecision() = default;
 
+  /**
+   * @brief the obstacles added to the path decision are allocated from the
+   * arena, which must outlive it.
+   */
+  explicit PathDecision(Arena *arena) : obstacles_(arena) {}
+
   Obstacle *AddObstacle(const Obstacle &obstacle);
 
   const IndexedList<std::string, Obstacle> &obstacles() const;
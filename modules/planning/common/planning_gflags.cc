@@ -92,6 +92,9 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_incremental_reference_line_smoothing, true,
+            "When stitching, keep all the anchor points of the overlap on the "
+            "existing smoothed reference line instead of only the first one");
 DEFINE_double(reference_line_lateral_buffer, 0.5,
               "When creating reference line, the minimum distance with road "
               "curb for a vehicle driving on this line.");
@@ -288,11 +291,33 @@ DEFINE_uint32(max_planning_thread_pool_size, 15,
               "num of thread used in planning thread pool.");
 DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
+DEFINE_int32(max_num_add_obstacles_tasks, 4,
+             "max number of tasks a reference line adds its obstacles with.");
+DEFINE_int32(min_num_obstacles_per_add_task, 16,
+             "min number of obstacles worth a task of their own, fewer "
+             "obstacles are added on the planning thread alone.");
+DEFINE_bool(enable_sl_boundary_cache, false,
+            "True to reuse the sl boundaries of static obstacles on unchanged "
+            "reference lines across frames.");
+DEFINE_double(sl_boundary_cache_tolerance, 0.01,
+              "(unit: meter) max corner displacement of a static obstacle box "
+              "for its cached sl boundary to be reused.");
 DEFINE_bool(
     enable_multi_thread_in_dp_poly_path, false,
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_reference_line_planning, false,
+            "Enable multiple thread to plan on the reference lines of a "
+            "frame concurrently.");
+DEFINE_bool(enable_multi_thread_in_lattice_planner, false,
+            "Enable multiple thread to evaluate and check trajectory pairs in "
+            "lattice planner.");
+DEFINE_bool(enable_multi_thread_in_st_boundary_mapper, false,
+            "Enable multiple thread to map obstacles in st_boundary_mapper.");
+DEFINE_bool(enable_multi_thread_in_hybrid_a_star, false,
+            "Enable multiple thread to check the reeds shepp paths of an "
+            "analytic expansion in hybrid a star.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -316,6 +341,12 @@ DEFINE_double(lon_collision_buffer, 2.0,
               "The longitudinal buffer to keep distance to other vehicles");
 DEFINE_double(lat_collision_buffer, 0.1,
               "The lateral buffer to keep distance to other vehicles");
+DEFINE_bool(enable_frame_arena, true,
+            "Allocate the obstacles of a planning frame from an arena "
+            "released with the frame.");
+DEFINE_bool(use_obstacle_box_index, true,
+            "Index the predicted obstacle boxes once per frame and use the "
+            "index for collision and obstacle cost queries");
 DEFINE_uint32(num_sample_follow_per_timestamp, 3,
               "The number of sample points for each timestamp to follow");
 
@@ -351,6 +382,9 @@ DEFINE_double(comfort_acceleration_factor, 0.5,
               "Factor for comfort acceleration.");
 DEFINE_double(polynomial_minimal_param, 0.01,
               "Minimal time parameter in polynomials.");
+DEFINE_int32(lattice_evaluation_batch_size, 8,
+             "Number of trajectory pairs evaluated or checked together in "
+             "lattice planner.");
 DEFINE_double(lattice_stop_buffer, 0.02,
               "The buffer before the stop s to check trajectories.");
 
@@ -437,6 +471,9 @@ DEFINE_bool(use_osqp_optimizer_for_reference_line, true,
             "Use OSQP optimizer for reference line optimization.");
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
+DEFINE_bool(enable_osqp_workspace_reuse, true,
+            "True to update the OSQP workspace of the previous solve in place "
+            "when the problem keeps its sparsity pattern.");
 
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
@@ -46,6 +46,7 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_incremental_reference_line_smoothing);
 DECLARE_double(reference_line_lateral_buffer);
 
 DECLARE_bool(enable_smooth_reference_line);
@@ -148,8 +149,16 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_uint32(max_planning_thread_pool_size);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
+DECLARE_int32(max_num_add_obstacles_tasks);
+DECLARE_int32(min_num_obstacles_per_add_task);
+DECLARE_bool(enable_sl_boundary_cache);
+DECLARE_double(sl_boundary_cache_tolerance);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_reference_line_planning);
+DECLARE_bool(enable_multi_thread_in_lattice_planner);
+DECLARE_bool(enable_multi_thread_in_st_boundary_mapper);
+DECLARE_bool(enable_multi_thread_in_hybrid_a_star);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
@@ -166,6 +175,8 @@ DECLARE_double(backup_trajectory_cost);
 DECLARE_double(min_velocity_sample_gap);
 DECLARE_double(lon_collision_buffer);
 DECLARE_double(lat_collision_buffer);
+DECLARE_bool(enable_frame_arena);
+DECLARE_bool(use_obstacle_box_index);
 DECLARE_uint32(num_sample_follow_per_timestamp);
 
 DECLARE_bool(lateral_optimization);
@@ -196,6 +207,7 @@ DECLARE_double(default_lon_buffer);
 DECLARE_double(time_min_density);
 DECLARE_double(comfort_acceleration_factor);
 DECLARE_double(polynomial_minimal_param);
+DECLARE_int32(lattice_evaluation_batch_size);
 DECLARE_double(lattice_stop_buffer);
 DECLARE_double(max_s_lateral_optimization);
 DECLARE_double(default_delta_s_lateral_optimization);
@@ -229,6 +241,7 @@ DECLARE_bool(use_gear_shift_trajectory);
 DECLARE_bool(use_osqp_optimizer_for_qp_st);
 DECLARE_bool(use_osqp_optimizer_for_reference_line);
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_osqp_workspace_reuse);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
 
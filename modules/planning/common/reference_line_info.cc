@@ -20,6 +20,9 @@
 
 #include "modules/planning/common/reference_line_info.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "cyber/task/task.h"
 #include "modules/planning/proto/sl_boundary.pb.h"
 
@@ -30,6 +33,7 @@
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/sl_boundary_cache.h"
 
 namespace apollo {
 namespace planning {
@@ -45,10 +49,12 @@ using apollo::common::math::Vec2d;
 ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
                                      const TrajectoryPoint& adc_planning_point,
                                      const ReferenceLine& reference_line,
-                                     const hdmap::RouteSegments& segments)
+                                     const hdmap::RouteSegments& segments,
+                                     Arena* arena)
     : vehicle_state_(vehicle_state),
       adc_planning_point_(adc_planning_point),
       reference_line_(reference_line),
+      path_decision_(arena),
       lanes_(segments) {}
 
 bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
@@ -99,6 +105,9 @@ bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
   }
   is_on_reference_line_ =
       reference_line_.IsOnLane(sl_boundary_info_.adc_sl_boundary_);
+  if (FLAGS_enable_sl_boundary_cache) {
+    reference_line_key_ = SlBoundaryCache::ReferenceLineKey(reference_line_);
+  }
   if (!AddObstacles(obstacles)) {
     AERROR << "Failed to add obstacles to reference line";
     return false;
@@ -305,8 +314,7 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
   }
 
   SLBoundary perception_sl;
-  if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
-                                     &perception_sl)) {
+  if (!GetPerceptionSlBoundary(*obstacle, &perception_sl)) {
     AERROR << "Failed to get sl boundary for obstacle: " << obstacle->Id();
     return mutable_obstacle;
   }
@@ -340,29 +348,100 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
   return mutable_obstacle;
 }
 
+bool ReferenceLineInfo::GetPerceptionSlBoundary(
+    const Obstacle& obstacle, SLBoundary* const sl_boundary) const {
+  if (!FLAGS_enable_sl_boundary_cache) {
+    return reference_line_.GetSLBoundary(obstacle.PerceptionBoundingBox(),
+                                         sl_boundary);
+  }
+  // static obstacles on an unchanged reference line keep their boundary,
+  // the others share it with the reference line infos of the same frame
+  const double tolerance =
+      obstacle.IsStatic() ? FLAGS_sl_boundary_cache_tolerance : 0.0;
+  auto* sl_boundary_cache = SlBoundaryCache::Instance();
+  if (sl_boundary_cache->Get(reference_line_key_, obstacle.Id(),
+                             obstacle.PerceptionBoundingBox(), tolerance,
+                             sl_boundary)) {
+    return true;
+  }
+  if (!reference_line_.GetSLBoundary(obstacle.PerceptionBoundingBox(),
+                                     sl_boundary)) {
+    return false;
+  }
+  sl_boundary_cache->Put(reference_line_key_, obstacle.Id(),
+                         obstacle.PerceptionBoundingBox(), *sl_boundary);
+  return true;
+}
+
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
-  if (FLAGS_use_multi_thread_to_add_obstacles) {
-    std::vector<std::future<Obstacle*>> results;
-    for (const auto* obstacle : obstacles) {
-      results.push_back(
-          cyber::Async(&ReferenceLineInfo::AddObstacle, this, obstacle));
+  const auto start_time = std::chrono::steady_clock::now();
+  const size_t num_tasks = NumAddObstaclesTasks(obstacles.size());
+  bool success = true;
+  if (num_tasks > 1) {
+    // a few chunks of obstacles, the first one added on this thread
+    const size_t chunk_size = (obstacles.size() + num_tasks - 1) / num_tasks;
+    std::vector<std::future<bool>> results;
+    results.reserve(num_tasks - 1);
+    for (size_t begin = chunk_size; begin < obstacles.size();
+         begin += chunk_size) {
+      const size_t end = std::min(begin + chunk_size, obstacles.size());
+      results.push_back(cyber::Async([this, &obstacles, begin, end] {
+        return AddObstacleRange(obstacles, begin, end);
+      }));
     }
+    success = AddObstacleRange(obstacles, 0, chunk_size);
+    // wait for every chunk, they all refer to obstacles
     for (auto& result : results) {
-      if (!result.get()) {
-        AERROR << "Fail to add obstacles.";
-        return false;
-      }
+      success = result.get() && success;
     }
   } else {
-    for (const auto* obstacle : obstacles) {
-      if (!AddObstacle(obstacle)) {
-        AERROR << "Failed to add obstacle " << obstacle->Id();
-        return false;
-      }
-    }
+    success = AddObstacleRange(obstacles, 0, obstacles.size());
+  }
+  // the time per obstacle against the number of tasks shows where
+  // FLAGS_min_num_obstacles_per_add_task should be
+  const double time_diff_ms =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start_time)
+          .count();
+  ADEBUG << "added " << obstacles.size() << " obstacles with " << num_tasks
+         << " tasks in " << time_diff_ms << " ms";
+  if (!success) {
+    AERROR << "Fail to add obstacles.";
+    return false;
+  }
+
+  if (FLAGS_enable_sl_boundary_cache) {
+    const auto* sl_boundary_cache = SlBoundaryCache::Instance();
+    const size_t num_hits = sl_boundary_cache->num_hits();
+    const size_t num_lookups = num_hits + sl_boundary_cache->num_misses();
+    ADEBUG << "sl boundary cache hits: " << num_hits << " / " << num_lookups;
   }
+  return true;
+}
 
+size_t ReferenceLineInfo::NumAddObstaclesTasks(const size_t num_obstacles) {
+  if (!FLAGS_use_multi_thread_to_add_obstacles) {
+    return 1;
+  }
+  const size_t min_num_per_task = static_cast<size_t>(
+      std::max(FLAGS_min_num_obstacles_per_add_task, 1));
+  const size_t max_num_tasks =
+      static_cast<size_t>(std::max(FLAGS_max_num_add_obstacles_tasks, 1));
+  return std::max<size_t>(
+      std::min(num_obstacles / min_num_per_task, max_num_tasks), 1);
+}
+
+bool ReferenceLineInfo::AddObstacleRange(
+    const std::vector<const Obstacle*>& obstacles, const size_t begin,
+    const size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    if (!AddObstacle(obstacles[i])) {
+      AERROR << "Failed to add obstacle "
+             << (obstacles[i] ? obstacles[i]->Id() : "");
+      return false;
+    }
+  }
   return true;
 }
 
@@ -34,6 +34,7 @@
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/map/pnc_map/pnc_map.h"
+#include "modules/planning/common/obstacle_box_index.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -52,7 +53,8 @@ class ReferenceLineInfo {
   explicit ReferenceLineInfo(const common::VehicleState& vehicle_state,
                              const common::TrajectoryPoint& adc_planning_point,
                              const ReferenceLine& reference_line,
-                             const hdmap::RouteSegments& segments);
+                             const hdmap::RouteSegments& segments,
+                             Arena* arena = nullptr);
 
   bool Init(const std::vector<const Obstacle*>& obstacles);
 
@@ -153,6 +155,14 @@ class ReferenceLineInfo {
     offset_to_other_reference_line_ = offset;
   }
 
+  // predicted obstacle boxes of the frame, may be nullptr
+  const ObstacleBoxIndex* obstacle_box_index() const {
+    return obstacle_box_index_;
+  }
+  void SetObstacleBoxIndex(const ObstacleBoxIndex* obstacle_box_index) {
+    obstacle_box_index_ = obstacle_box_index;
+  }
+
   void set_is_on_reference_line() { is_on_reference_line_ = true; }
 
   void InitFirstOverlaps();
@@ -192,6 +202,19 @@ class ReferenceLineInfo {
 
   bool IsUnrelaventObstacle(const Obstacle* obstacle);
 
+  bool GetPerceptionSlBoundary(const Obstacle& obstacle,
+                               SLBoundary* const sl_boundary) const;
+
+  /**
+   * @brief the number of tasks to add num_obstacles with, one unless
+   * multi-threading is on and every task gets at least
+   * FLAGS_min_num_obstacles_per_add_task of them
+   */
+  static size_t NumAddObstaclesTasks(const size_t num_obstacles);
+
+  bool AddObstacleRange(const std::vector<const Obstacle*>& obstacles,
+                        const size_t begin, const size_t end);
+
   void MakeDecision(DecisionResult* decision_result) const;
 
   int MakeMainStopDecision(DecisionResult* decision_result) const;
@@ -210,6 +233,8 @@ class ReferenceLineInfo {
   const common::VehicleState vehicle_state_;
   const common::TrajectoryPoint adc_planning_point_;
   ReferenceLine reference_line_;
+  // key of reference_line_ in the SlBoundaryCache
+  size_t reference_line_key_ = 0;
 
   /**
    * @brief this is the number that measures the goodness of this reference
@@ -256,6 +281,8 @@ class ReferenceLineInfo {
 
   double offset_to_other_reference_line_ = 0.0;
 
+  const ObstacleBoxIndex* obstacle_box_index_ = nullptr;
+
   double priority_cost_ = 0.0;
 
   PlanningTarget planning_target_;
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file sl_boundary_cache.cc
+ **/
+
+#include "modules/planning/common/sl_boundary_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "modules/common/math/math_utils.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+namespace {
+
+// a few reference lines are planned on at a time
+constexpr size_t kMaxNumReferenceLines = 8;
+constexpr size_t kMaxNumEntriesPerReferenceLine = 2000;
+
+// upper bound of how far a corner of the box moved from the cached one
+double MaxCornerDisplacement(const Box2d& cached, const Box2d& box) {
+  const double heading_diff = std::fabs(
+      common::math::NormalizeAngle(box.heading() - cached.heading()));
+  return cached.center().DistanceTo(box.center()) +
+         heading_diff * cached.diagonal() * 0.5 +
+         std::fabs(box.length() - cached.length()) * 0.5 +
+         std::fabs(box.width() - cached.width()) * 0.5;
+}
+
+}  // namespace
+
+SlBoundaryCache::SlBoundaryCache() {}
+
+size_t SlBoundaryCache::ReferenceLineKey(const ReferenceLine& reference_line) {
+  std::hash<double> hash_double;
+  size_t key = reference_line.reference_points().size();
+  for (const auto& point : reference_line.reference_points()) {
+    key ^= hash_double(point.x()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= hash_double(point.y()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+  }
+  return key;
+}
+
+bool SlBoundaryCache::Get(const size_t reference_line_key,
+                          const std::string& obstacle_id, const Box2d& box,
+                          SLBoundary* const sl_boundary) {
+  return Get(reference_line_key, obstacle_id, box,
+             FLAGS_sl_boundary_cache_tolerance, sl_boundary);
+}
+
+bool SlBoundaryCache::Get(const size_t reference_line_key,
+                          const std::string& obstacle_id, const Box2d& box,
+                          const double tolerance,
+                          SLBoundary* const sl_boundary) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& reference_line = reference_lines_[reference_line_key];
+  reference_line.last_used = ++tick_;
+  const auto it = reference_line.entries.find(obstacle_id);
+  if (it == reference_line.entries.end() ||
+      MaxCornerDisplacement(it->second.box, box) > tolerance) {
+    ++num_misses_;
+    return false;
+  }
+  ++num_hits_;
+  *sl_boundary = it->second.sl_boundary;
+  return true;
+}
+
+void SlBoundaryCache::Put(const size_t reference_line_key,
+                          const std::string& obstacle_id, const Box2d& box,
+                          const SLBoundary& sl_boundary) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& reference_line = reference_lines_[reference_line_key];
+  reference_line.last_used = ++tick_;
+  if (reference_line.entries.size() >= kMaxNumEntriesPerReferenceLine) {
+    reference_line.entries.clear();
+  }
+  auto& entry = reference_line.entries[obstacle_id];
+  entry.box = box;
+  entry.sl_boundary = sl_boundary;
+
+  // drop the reference lines which are not planned on any more
+  while (reference_lines_.size() > kMaxNumReferenceLines) {
+    const auto oldest = std::min_element(
+        reference_lines_.begin(), reference_lines_.end(),
+        [](const std::pair<const size_t, ReferenceLineEntries>& lhs,
+           const std::pair<const size_t, ReferenceLineEntries>& rhs) {
+          return lhs.second.last_used < rhs.second.last_used;
+        });
+    reference_lines_.erase(oldest);
+  }
+}
+
+void SlBoundaryCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reference_lines_.clear();
+  num_hits_ = 0;
+  num_misses_ = 0;
+}
+
+size_t SlBoundaryCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+size_t SlBoundaryCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+}  // namespace planning
+}  // namespace apollo
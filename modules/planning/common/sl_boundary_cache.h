@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file sl_boundary_cache.h
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/common/macros.h"
+
+#include "modules/common/math/box2d.h"
+#include "modules/planning/proto/sl_boundary.pb.h"
+#include "modules/planning/reference_line/reference_line.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class SlBoundaryCache
+ * @brief Keeps the sl boundaries of obstacles on reference lines. The
+ * reference lines are keyed by their geometry, so a reference line which is
+ * provided again unchanged reuses the boundaries of the previous frames for
+ * static obstacles, and of the same frame for the others.
+ */
+class SlBoundaryCache {
+ public:
+  ~SlBoundaryCache() = default;
+
+  /**
+   * @brief Key of the reference line geometry, equal for reference lines
+   * with the same points.
+   */
+  static size_t ReferenceLineKey(const ReferenceLine& reference_line);
+
+  /**
+   * @brief Looks up the sl boundary of the obstacle on the reference line. It
+   * is found if no corner of the box moved more than
+   * FLAGS_sl_boundary_cache_tolerance since the boundary was put.
+   */
+  bool Get(const size_t reference_line_key, const std::string& obstacle_id,
+           const common::math::Box2d& box, SLBoundary* const sl_boundary);
+
+  /**
+   * @brief Looks up the sl boundary with the given tolerance instead. With a
+   * zero tolerance only a boundary put for the very same box is found, which
+   * lets the reference line infos of one frame share the boundaries of
+   * moving obstacles on a reference line they have in common.
+   */
+  bool Get(const size_t reference_line_key, const std::string& obstacle_id,
+           const common::math::Box2d& box, const double tolerance,
+           SLBoundary* const sl_boundary);
+
+  void Put(const size_t reference_line_key, const std::string& obstacle_id,
+           const common::math::Box2d& box, const SLBoundary& sl_boundary);
+
+  void Clear();
+
+  size_t num_hits() const;
+  size_t num_misses() const;
+
+ private:
+  struct Entry {
+    common::math::Box2d box;
+    SLBoundary sl_boundary;
+  };
+
+  struct ReferenceLineEntries {
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t last_used = 0;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<size_t, ReferenceLineEntries> reference_lines_;
+  uint64_t tick_ = 0;
+  size_t num_hits_ = 0;
+  size_t num_misses_ = 0;
+
+  // this is a singleton class
+  DECLARE_SINGLETON(SlBoundaryCache)
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file sl_boundary_cache_test.cc
+ **/
+
+#include "modules/planning/common/sl_boundary_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+ReferenceLine StraightLine(const double y) {
+  std::vector<ReferencePoint> reference_points;
+  for (int i = 0; i < 10; ++i) {
+    reference_points.emplace_back(
+        hdmap::MapPathPoint(Vec2d(static_cast<double>(i), y), 0.0), 0.0,
+        0.0);
+  }
+  return ReferenceLine(reference_points);
+}
+
+}  // namespace
+
+TEST(SlBoundaryCacheTest, ReferenceLineKey) {
+  EXPECT_EQ(SlBoundaryCache::ReferenceLineKey(StraightLine(0.0)),
+            SlBoundaryCache::ReferenceLineKey(StraightLine(0.0)));
+  EXPECT_NE(SlBoundaryCache::ReferenceLineKey(StraightLine(0.0)),
+            SlBoundaryCache::ReferenceLineKey(StraightLine(0.5)));
+}
+
+TEST(SlBoundaryCacheTest, GetAndPut) {
+  FLAGS_sl_boundary_cache_tolerance = 0.01;
+  auto* cache = SlBoundaryCache::Instance();
+  cache->Clear();
+
+  const Box2d box(Vec2d(5.0, 2.0), 0.0, 4.0, 2.0);
+  SLBoundary sl_boundary;
+  EXPECT_FALSE(cache->Get(1, "parked", box, &sl_boundary));
+
+  SLBoundary computed;
+  computed.set_start_s(3.0);
+  computed.set_end_s(7.0);
+  computed.set_start_l(1.0);
+  computed.set_end_l(3.0);
+  cache->Put(1, "parked", box, computed);
+
+  // jitter below the tolerance
+  EXPECT_TRUE(cache->Get(1, "parked", Box2d(Vec2d(5.005, 2.0), 0.0, 4.0, 2.0),
+                         &sl_boundary));
+  EXPECT_DOUBLE_EQ(3.0, sl_boundary.start_s());
+  EXPECT_DOUBLE_EQ(3.0, sl_boundary.end_l());
+
+  // moved, turned, or on another reference line
+  EXPECT_FALSE(cache->Get(1, "parked", Box2d(Vec2d(5.5, 2.0), 0.0, 4.0, 2.0),
+                          &sl_boundary));
+  EXPECT_FALSE(cache->Get(1, "parked", Box2d(Vec2d(5.0, 2.0), 0.1, 4.0, 2.0),
+                          &sl_boundary));
+  EXPECT_FALSE(cache->Get(2, "parked", box, &sl_boundary));
+
+  EXPECT_EQ(1, cache->num_hits());
+  EXPECT_EQ(4, cache->num_misses());
+
+  // a moving obstacle only shares the boundary of the very same box
+  EXPECT_TRUE(cache->Get(1, "parked", box, 0.0, &sl_boundary));
+  EXPECT_FALSE(cache->Get(1, "parked",
+                          Box2d(Vec2d(5.005, 2.0), 0.0, 4.0, 2.0), 0.0,
+                          &sl_boundary));
+}
+
+}  // namespace planning
+}  // namespace apollo
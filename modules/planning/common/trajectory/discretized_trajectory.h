@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <vector>
 
 #include "modules/planning/proto/planning.pb.h"
@@ -73,6 +74,15 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
     insert(begin(), trajectory_points.begin(), trajectory_points.end());
   }
 
+  void PrependTrajectoryPoints(
+      std::vector<common::TrajectoryPoint>&& trajectory_points) {
+    if (!empty() && trajectory_points.size() > 1) {
+      CHECK(trajectory_points.back().relative_time() < front().relative_time());
+    }
+    insert(begin(), std::make_move_iterator(trajectory_points.begin()),
+           std::make_move_iterator(trajectory_points.end()));
+  }
+
   const common::TrajectoryPoint& TrajectoryPointAt(const size_t index) const;
 
   size_t NumOfPoints() const;
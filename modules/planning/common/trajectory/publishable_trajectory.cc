@@ -41,7 +41,14 @@ void PublishableTrajectory::PopulateTrajectoryProtobuf(
     ADCTrajectory* trajectory_pb) const {
   CHECK_NOTNULL(trajectory_pb);
   trajectory_pb->mutable_header()->set_timestamp_sec(header_time_);
-  trajectory_pb->mutable_trajectory_point()->CopyFrom({begin(), end()});
+  // the points are copied straight into the message, the cleared elements
+  // of a reused message are recycled by Add()
+  auto* trajectory_points = trajectory_pb->mutable_trajectory_point();
+  trajectory_points->Clear();
+  trajectory_points->Reserve(static_cast<int>(size()));
+  for (const auto& trajectory_point : *this) {
+    trajectory_points->Add()->CopyFrom(trajectory_point);
+  }
   if (!empty()) {
     const auto& last_tp = back();
     trajectory_pb->set_total_path_length(last_tp.path_point().s());
@@ -47,6 +47,11 @@ TEST(basic_test, DiscretizedTrajectory) {
     EXPECT_TRUE(apollo::common::util::IsProtoEqual(
         output_trajectory.trajectory_point(i), trajectory.trajectory_point(i)));
   }
+
+  // populating a used message replaces its points
+  publishable_trajectory.PopulateTrajectoryProtobuf(&output_trajectory);
+  EXPECT_EQ(trajectory.trajectory_point_size(),
+            output_trajectory.trajectory_point_size());
 }
 
 }  // namespace planning
@@ -140,7 +140,7 @@ std::vector<TrajectoryPoint> TrajectoryStitcher::ComputeStitchingTrajectory(
     return ComputeReinitStitchingTrajectory(vehicle_state);
   }
 
-  auto time_matched_point = prev_trajectory->TrajectoryPointAt(
+  const auto& time_matched_point = prev_trajectory->TrajectoryPointAt(
       static_cast<uint32_t>(time_matched_index));
 
   if (!time_matched_point.has_path_point()) {
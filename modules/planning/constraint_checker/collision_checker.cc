@@ -83,9 +83,8 @@ bool CollisionChecker::InCollision(
 }
 
 bool CollisionChecker::InCollision(
-    const DiscretizedTrajectory& discretized_trajectory) {
-  CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+    const DiscretizedTrajectory& discretized_trajectory) const {
+  CHECK_LE(discretized_trajectory.NumOfPoints(), num_time_steps_);
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
@@ -104,8 +103,29 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
+    if (obstacle_box_index_ == nullptr) {
+      for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
+        if (ego_box.HasOverlap(obstacle_box)) {
+          return true;
+        }
+      }
+      continue;
+    }
+
+    // an extended obstacle box overlapping the ego box is within this
+    // distance of the ego box center before it is extended
+    const double distance = ego_box.diagonal() / 2.0 +
+                            FLAGS_lon_collision_buffer +
+                            FLAGS_lat_collision_buffer;
+    for (const auto* obstacle_box :
+         obstacle_box_index_->GetBoxes(i, ego_box.center(), distance)) {
+      if (!is_considered_obstacle_[obstacle_box->obstacle_index()]) {
+        continue;
+      }
+      Box2d box = obstacle_box->box();
+      box.LongitudinalExtend(2.0 * FLAGS_lon_collision_buffer);
+      box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
+      if (ego_box.HasOverlap(box)) {
         return true;
       }
     }
@@ -138,6 +158,36 @@ void CollisionChecker::BuildPredictedEnvironment(
   }
 
   double relative_time = 0.0;
+  while (relative_time < FLAGS_trajectory_time_length) {
+    ++num_time_steps_;
+    relative_time += FLAGS_trajectory_time_resolution;
+  }
+
+  const auto* obstacle_box_index =
+      ptr_reference_line_info_->obstacle_box_index();
+  if (obstacle_box_index != nullptr &&
+      obstacle_box_index->Covers(FLAGS_trajectory_time_resolution,
+                                 num_time_steps_)) {
+    std::vector<int> indices;
+    for (const Obstacle* obstacle : obstacles_considered) {
+      const int index = obstacle_box_index->ObstacleIndex(obstacle->Id());
+      if (index < 0) {
+        break;
+      }
+      indices.push_back(index);
+    }
+    if (indices.size() == obstacles_considered.size()) {
+      obstacle_box_index_ = obstacle_box_index;
+      is_considered_obstacle_.resize(obstacle_box_index->num_obstacles(),
+                                     false);
+      for (const int index : indices) {
+        is_considered_obstacle_[index] = true;
+      }
+      return;
+    }
+  }
+
+  relative_time = 0.0;
   while (relative_time < FLAGS_trajectory_time_length) {
     std::vector<Box2d> predicted_env;
     for (const Obstacle* obstacle : obstacles_considered) {
@@ -25,6 +25,7 @@
 
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_index.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
@@ -41,7 +42,7 @@ class CollisionChecker {
       const ReferenceLineInfo* ptr_reference_line_info,
       const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph);
 
-  bool InCollision(const DiscretizedTrajectory& discretized_trajectory);
+  bool InCollision(const DiscretizedTrajectory& discretized_trajectory) const;
 
   static bool InCollision(const std::vector<const Obstacle*>& obstacles,
       const DiscretizedTrajectory& ego_trajectory, const double ego_length,
@@ -64,6 +65,13 @@ class CollisionChecker {
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
   std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+
+  // with an obstacle box index from the reference line info, the considered
+  // obstacles are looked up in it by their index instead of being copied to
+  // predicted_bounding_rectangles_
+  const ObstacleBoxIndex* obstacle_box_index_ = nullptr;
+  std::vector<bool> is_considered_obstacle_;
+  size_t num_time_steps_ = 0;
 };
 
 }  // namespace planning
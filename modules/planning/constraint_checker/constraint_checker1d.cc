@@ -20,6 +20,8 @@
 
 #include "modules/planning/constraint_checker/constraint_checker1d.h"
 
+#include <vector>
+
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
 
@@ -32,46 +34,68 @@ inline bool fuzzy_within(const double v, const double lower, const double upper,
                          const double e = 1.0e-4) {
   return v > lower - e && v < upper + e;
 }
+
+// the times the trajectory is checked at, up to its param length
+std::vector<double> SampleTimes(const Curve1d& lon_trajectory) {
+  std::vector<double> ts;
+  double t = 0.0;
+  while (t < lon_trajectory.ParamLength()) {
+    ts.push_back(t);
+    t += FLAGS_trajectory_time_resolution;
+  }
+  return ts;
+}
+
 }  // namespace
 
 bool ConstraintChecker1d::IsValidLongitudinalTrajectory(
     const Curve1d& lon_trajectory) {
-  double t = 0.0;
-  while (t < lon_trajectory.ParamLength()) {
-    double v = lon_trajectory.Evaluate(1, t);  // evaluate_v
+  const std::vector<double> ts = SampleTimes(lon_trajectory);
+  std::vector<double> lon_values;
+  lon_trajectory.EvaluateBatch(3, ts, &lon_values);
+  const size_t n = ts.size();
+  for (size_t i = 0; i < n; ++i) {
+    double v = lon_values[n + i];  // evaluate_v
     if (!fuzzy_within(v, FLAGS_speed_lower_bound, FLAGS_speed_upper_bound)) {
       return false;
     }
 
-    double a = lon_trajectory.Evaluate(2, t);  // evaluate_a
+    double a = lon_values[2 * n + i];  // evaluate_a
     if (!fuzzy_within(a, FLAGS_longitudinal_acceleration_lower_bound,
                       FLAGS_longitudinal_acceleration_upper_bound)) {
       return false;
     }
 
-    double j = lon_trajectory.Evaluate(3, t);
+    double j = lon_values[3 * n + i];
     if (!fuzzy_within(j, FLAGS_longitudinal_jerk_lower_bound,
                       FLAGS_longitudinal_jerk_upper_bound)) {
       return false;
     }
-    t += FLAGS_trajectory_time_resolution;
   }
   return true;
 }
 
 bool ConstraintChecker1d::IsValidLateralTrajectory(
     const Curve1d& lat_trajectory, const Curve1d& lon_trajectory) {
-  double t = 0.0;
-  while (t < lon_trajectory.ParamLength()) {
-    double s = lon_trajectory.Evaluate(0, t);
-    double dd_ds = lat_trajectory.Evaluate(1, s);
-    double ds_dt = lon_trajectory.Evaluate(1, t);
-
-    double d2d_ds2 = lat_trajectory.Evaluate(2, s);
-    double d2s_dt2 = lon_trajectory.Evaluate(2, t);
+  const std::vector<double> ts = SampleTimes(lon_trajectory);
+  std::vector<double> lon_values;
+  lon_trajectory.EvaluateBatch(3, ts, &lon_values);
+  const size_t n = ts.size();
+  const std::vector<double> ss(lon_values.begin(), lon_values.begin() + n);
+  std::vector<double> lat_values;
+  lat_trajectory.EvaluateBatch(3, ss, &lat_values);
+  const double lat_param_length = lat_trajectory.ParamLength();
+
+  for (size_t i = 0; i < n; ++i) {
+    double s = ss[i];
+    double dd_ds = lat_values[n + i];
+    double ds_dt = lon_values[n + i];
+
+    double d2d_ds2 = lat_values[2 * n + i];
+    double d2s_dt2 = lon_values[2 * n + i];
 
     double a = 0.0;
-    if (s < lat_trajectory.ParamLength()) {
+    if (s < lat_param_length) {
       a = d2d_ds2 * ds_dt * ds_dt + dd_ds * d2s_dt2;
     }
 
@@ -82,14 +106,13 @@ bool ConstraintChecker1d::IsValidLateralTrajectory(
 
     // this is not accurate, just an approximation...
     double j = 0.0;
-    if (s < lat_trajectory.ParamLength()) {
-      j = lat_trajectory.Evaluate(3, s) * lon_trajectory.Evaluate(3, t);
+    if (s < lat_param_length) {
+      j = lat_values[3 * n + i] * lon_values[3 * n + i];
     }
 
     if (!fuzzy_within(j, -FLAGS_lateral_jerk_bound, FLAGS_lateral_jerk_bound)) {
       return false;
     }
-    t += FLAGS_trajectory_time_resolution;
   }
   return true;
 }
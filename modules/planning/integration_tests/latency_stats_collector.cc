@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/integration_tests/latency_stats_collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+struct Summary {
+  size_t count = 0;
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+Summary Summarize(const std::vector<double>& samples) {
+  Summary summary;
+  if (samples.empty()) {
+    return summary;
+  }
+  summary.count = samples.size();
+  summary.mean_ms = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                    static_cast<double>(samples.size());
+  summary.p50_ms = LatencyStatsCollector::Percentile(samples, 50.0);
+  summary.p99_ms = LatencyStatsCollector::Percentile(samples, 99.0);
+  summary.max_ms = *std::max_element(samples.begin(), samples.end());
+  return summary;
+}
+
+}  // namespace
+
+void LatencyStatsCollector::Add(const std::string& category,
+                                const std::string& name,
+                                const double time_ms) {
+  samples_[category][name].push_back(time_ms);
+}
+
+double LatencyStatsCollector::Percentile(std::vector<double> samples,
+                                         const double percentile) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const double rank =
+      std::ceil(percentile / 100.0 * static_cast<double>(samples.size()));
+  const size_t index = static_cast<size_t>(
+      std::min(std::max(rank, 1.0), static_cast<double>(samples.size()))) - 1;
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+nlohmann::json LatencyStatsCollector::ToJson() const {
+  nlohmann::json json = nlohmann::json::object();
+  for (const auto& category : samples_) {
+    nlohmann::json category_json = nlohmann::json::object();
+    for (const auto& name : category.second) {
+      const Summary summary = Summarize(name.second);
+      category_json[name.first] = {{"count", summary.count},
+                                   {"mean_ms", summary.mean_ms},
+                                   {"p50_ms", summary.p50_ms},
+                                   {"p99_ms", summary.p99_ms},
+                                   {"max_ms", summary.max_ms}};
+    }
+    json[category.first] = category_json;
+  }
+  return json;
+}
+
+std::string LatencyStatsCollector::DebugString() const {
+  std::ostringstream os;
+  for (const auto& category : samples_) {
+    os << category.first << ":\n";
+    for (const auto& name : category.second) {
+      const Summary summary = Summarize(name.second);
+      os << "  " << name.first << ": count " << summary.count << ", mean "
+         << summary.mean_ms << " ms, p50 " << summary.p50_ms << " ms, p99 "
+         << summary.p99_ms << " ms, max " << summary.max_ms << " ms\n";
+    }
+  }
+  return os.str();
+}
+
+}  // namespace planning
+}  // namespace apollo
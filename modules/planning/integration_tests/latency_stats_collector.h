@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "third_party/json/json.hpp"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LatencyStatsCollector
+ * @brief Collects latency samples by category (e.g. "task") and name (e.g.
+ * the task name) and summarizes them as count, mean, p50, p99 and max.
+ */
+class LatencyStatsCollector {
+ public:
+  void Add(const std::string& category, const std::string& name,
+           const double time_ms);
+
+  /**
+   * @brief Nearest rank percentile of the samples, 0.0 if there are none.
+   */
+  static double Percentile(std::vector<double> samples,
+                           const double percentile);
+
+  /**
+   * @brief {category: {name: {"count", "mean_ms", "p50_ms", "p99_ms",
+   * "max_ms"}}}
+   */
+  nlohmann::json ToJson() const;
+
+  // "name: count, mean, p50, p99, max" lines, one per name
+  std::string DebugString() const;
+
+ private:
+  std::map<std::string, std::map<std::string, std::vector<double>>> samples_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/integration_tests/latency_stats_collector.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(LatencyStatsCollectorTest, Percentile) {
+  EXPECT_DOUBLE_EQ(0.0, LatencyStatsCollector::Percentile({}, 50.0));
+  std::vector<double> samples;
+  for (int i = 100; i >= 1; --i) {
+    samples.push_back(static_cast<double>(i));
+  }
+  EXPECT_DOUBLE_EQ(50.0, LatencyStatsCollector::Percentile(samples, 50.0));
+  EXPECT_DOUBLE_EQ(99.0, LatencyStatsCollector::Percentile(samples, 99.0));
+  EXPECT_DOUBLE_EQ(100.0, LatencyStatsCollector::Percentile(samples, 100.0));
+  EXPECT_DOUBLE_EQ(1.0, LatencyStatsCollector::Percentile(samples, 0.0));
+  EXPECT_DOUBLE_EQ(7.0, LatencyStatsCollector::Percentile({7.0}, 99.0));
+}
+
+TEST(LatencyStatsCollectorTest, ToJson) {
+  LatencyStatsCollector collector;
+  collector.Add("task", "DpPolyPathOptimizer", 2.0);
+  collector.Add("task", "DpPolyPathOptimizer", 4.0);
+  collector.Add("cycle", "RunOnce", 30.0);
+
+  const auto json = collector.ToJson();
+  ASSERT_EQ(1, json.count("task"));
+  const auto& task = json["task"]["DpPolyPathOptimizer"];
+  EXPECT_EQ(2, task["count"].get<int>());
+  EXPECT_DOUBLE_EQ(3.0, task["mean_ms"].get<double>());
+  EXPECT_DOUBLE_EQ(2.0, task["p50_ms"].get<double>());
+  EXPECT_DOUBLE_EQ(4.0, task["p99_ms"].get<double>());
+  EXPECT_DOUBLE_EQ(4.0, task["max_ms"].get<double>());
+  EXPECT_DOUBLE_EQ(30.0, json["cycle"]["RunOnce"]["p50_ms"].get<double>());
+  EXPECT_EQ(0, json.count("stage"));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file planning_benchmark.cc
+ * @brief Replays a directory of recorded planning inputs through StdPlanning,
+ * or NaviPlanning with --use_navigation_mode, and reports the p50/p99
+ * latency per cycle, per task and per scenario stage.
+ *
+ * Every sub-directory of --planning_benchmark_dir is one frame, replayed in
+ * the order of the directory names, holding the inputs the planning component
+ * would have seen in text or binary proto files:
+ *   localization.pb.txt, chassis.pb.txt (required),
+ *   prediction.pb.txt, traffic_light.pb.txt, relative_map.pb.txt,
+ *   routing_response.pb.txt (kept for the next frames until one changes it).
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/map/relative_map/proto/navigation.pb.h"
+#include "modules/perception/proto/traffic_light_detection.pb.h"
+#include "modules/planning/proto/planning_config.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+#include "modules/map/pnc_map/pnc_map.h"
+#include "modules/planning/common/local_view.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/latency_stats_collector.h"
+#include "modules/planning/navi_planning.h"
+#include "modules/planning/std_planning.h"
+
+DEFINE_string(planning_benchmark_dir, "",
+              "directory of the recorded frames, one sub-directory per frame");
+DEFINE_int32(planning_benchmark_iterations, 10,
+             "number of times the frames are replayed, each time by a newly "
+             "initialized planning");
+DEFINE_string(planning_benchmark_output_file, "",
+              "json file for the latency report, stdout when empty");
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::time::Clock;
+using apollo::common::util::GetProtoFromFile;
+using apollo::common::util::PathExists;
+
+namespace {
+
+struct BenchmarkFrame {
+  std::string name;
+  LocalView local_view;
+};
+
+template <typename T>
+std::shared_ptr<T> LoadMessage(const std::string& file_name) {
+  if (!PathExists(file_name)) {
+    return nullptr;
+  }
+  auto message = std::make_shared<T>();
+  if (!GetProtoFromFile(file_name, message.get())) {
+    AERROR << "Failed to load " << file_name;
+    return nullptr;
+  }
+  return message;
+}
+
+bool LoadFrames(const std::string& dir, std::vector<BenchmarkFrame>* frames) {
+  std::vector<std::string> frame_names = cyber::common::ListSubPaths(dir);
+  std::sort(frame_names.begin(), frame_names.end());
+
+  std::shared_ptr<routing::RoutingResponse> routing;
+  for (const auto& frame_name : frame_names) {
+    const std::string frame_dir = dir + "/" + frame_name + "/";
+    BenchmarkFrame frame;
+    frame.name = frame_name;
+    auto& local_view = frame.local_view;
+    local_view.localization_estimate =
+        LoadMessage<localization::LocalizationEstimate>(
+            frame_dir + "localization.pb.txt");
+    local_view.chassis =
+        LoadMessage<canbus::Chassis>(frame_dir + "chassis.pb.txt");
+    if (local_view.localization_estimate == nullptr ||
+        local_view.chassis == nullptr) {
+      AERROR << "Skip frame " << frame_name
+             << " without localization or chassis";
+      continue;
+    }
+    local_view.prediction_obstacles =
+        LoadMessage<prediction::PredictionObstacles>(frame_dir +
+                                                     "prediction.pb.txt");
+    if (local_view.prediction_obstacles == nullptr) {
+      local_view.prediction_obstacles =
+          std::make_shared<prediction::PredictionObstacles>();
+    }
+    local_view.traffic_light =
+        LoadMessage<perception::TrafficLightDetection>(frame_dir +
+                                                       "traffic_light.pb.txt");
+    if (local_view.traffic_light == nullptr) {
+      local_view.traffic_light =
+          std::make_shared<perception::TrafficLightDetection>();
+    }
+    local_view.relative_map =
+        LoadMessage<relative_map::MapMsg>(frame_dir + "relative_map.pb.txt");
+
+    auto new_routing = LoadMessage<routing::RoutingResponse>(
+        frame_dir + "routing_response.pb.txt");
+    local_view.is_new_routing =
+        new_routing != nullptr &&
+        (routing == nullptr ||
+         hdmap::PncMap::IsNewRouting(*routing, *new_routing));
+    if (local_view.is_new_routing) {
+      routing = new_routing;
+    }
+    local_view.routing = routing;
+    frames->push_back(std::move(frame));
+  }
+  return !frames->empty();
+}
+
+// planning runs on the system clock so it can be timed, the recorded inputs
+// are moved to the current time to look as fresh as they were on the road
+void Restamp(LocalView* local_view) {
+  const double offset =
+      Clock::NowInSeconds() -
+      local_view->localization_estimate->header().timestamp_sec();
+  auto shift_header = [offset](common::Header* header) {
+    if (header->has_timestamp_sec()) {
+      header->set_timestamp_sec(header->timestamp_sec() + offset);
+    }
+  };
+  auto* localization = local_view->localization_estimate.get();
+  shift_header(localization->mutable_header());
+  if (localization->has_measurement_time()) {
+    localization->set_measurement_time(localization->measurement_time() +
+                                       offset);
+  }
+  shift_header(local_view->chassis->mutable_header());
+  shift_header(local_view->traffic_light->mutable_header());
+  auto* prediction = local_view->prediction_obstacles.get();
+  shift_header(prediction->mutable_header());
+  for (auto& obstacle : *prediction->mutable_prediction_obstacle()) {
+    if (obstacle.has_timestamp()) {
+      obstacle.set_timestamp(obstacle.timestamp() + offset);
+    }
+    auto* perception_obstacle = obstacle.mutable_perception_obstacle();
+    if (perception_obstacle->has_timestamp()) {
+      perception_obstacle->set_timestamp(perception_obstacle->timestamp() +
+                                         offset);
+    }
+  }
+  if (local_view->relative_map != nullptr) {
+    shift_header(local_view->relative_map->mutable_header());
+  }
+}
+
+std::unique_ptr<PlanningBase> CreatePlanning() {
+  if (FLAGS_use_navigation_mode) {
+    return std::unique_ptr<PlanningBase>(new NaviPlanning());
+  }
+  return std::unique_ptr<PlanningBase>(new StdPlanning());
+}
+
+void RecordLatency(const ADCTrajectory& trajectory, const double cycle_ms,
+                   LatencyStatsCollector* collector) {
+  collector->Add("cycle", "RunOnce", cycle_ms);
+  for (const auto& task_stats : trajectory.latency_stats().task_stats()) {
+    collector->Add("task", task_stats.name(), task_stats.time_ms());
+  }
+  const auto& planning_data = trajectory.debug().planning_data();
+  if (planning_data.has_scenario()) {
+    const auto& scenario = planning_data.scenario();
+    collector->Add("stage",
+                   ScenarioConfig::ScenarioType_Name(scenario.scenario_type()) +
+                       "/" +
+                       ScenarioConfig::StageType_Name(scenario.stage_type()),
+                   cycle_ms);
+  }
+}
+
+bool RunBenchmark() {
+  if (FLAGS_planning_benchmark_dir.empty()) {
+    AERROR << "Requires --planning_benchmark_dir";
+    return false;
+  }
+  std::vector<BenchmarkFrame> frames;
+  if (!LoadFrames(FLAGS_planning_benchmark_dir, &frames)) {
+    AERROR << "No frame loaded from " << FLAGS_planning_benchmark_dir;
+    return false;
+  }
+  PlanningConfig config;
+  if (!GetProtoFromFile(FLAGS_planning_config_file, &config)) {
+    AERROR << "Failed to load planning config file "
+           << FLAGS_planning_config_file;
+    return false;
+  }
+
+  // the task latencies and the scenario stage are only reported with the
+  // debug info
+  FLAGS_enable_record_debug = true;
+  Clock::SetMode(Clock::SYSTEM);
+
+  LatencyStatsCollector collector;
+  int failed_cycles = 0;
+  for (int i = 0; i < FLAGS_planning_benchmark_iterations; ++i) {
+    auto planning = CreatePlanning();
+    if (!planning->Init(config).ok()) {
+      AERROR << "Failed to init planning";
+      return false;
+    }
+    for (auto& frame : frames) {
+      Restamp(&frame.local_view);
+      ADCTrajectory trajectory;
+      const auto start = std::chrono::steady_clock::now();
+      planning->RunOnce(frame.local_view, &trajectory);
+      const std::chrono::duration<double, std::milli> cycle_ms =
+          std::chrono::steady_clock::now() - start;
+      if (trajectory.header().status().error_code() != common::OK) {
+        ++failed_cycles;
+        ADEBUG << "Planning failed on frame " << frame.name << ": "
+               << trajectory.header().status().msg();
+      }
+      RecordLatency(trajectory, cycle_ms.count(), &collector);
+    }
+  }
+  AINFO << "Planning benchmark latency:\n" << collector.DebugString();
+
+  nlohmann::json report = collector.ToJson();
+  report["planning"] = FLAGS_use_navigation_mode ? "NaviPlanning"
+                                                 : "StdPlanning";
+  report["frames"] = frames.size();
+  report["iterations"] = FLAGS_planning_benchmark_iterations;
+  report["failed_cycles"] = failed_cycles;
+  if (FLAGS_planning_benchmark_output_file.empty()) {
+    std::cout << report.dump(2) << std::endl;
+    return true;
+  }
+  std::ofstream output(FLAGS_planning_benchmark_output_file);
+  if (!output) {
+    AERROR << "Failed to open " << FLAGS_planning_benchmark_output_file;
+    return false;
+  }
+  output << report.dump(2) << std::endl;
+  return true;
+}
+
+}  // namespace
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::RunBenchmark() ? 0 : 1;
+}
@@ -36,7 +36,7 @@ namespace planning {
 using apollo::common::math::lerp;
 using apollo::common::math::Box2d;
 using apollo::common::math::Polygon2d;
-using apollo::common::math::PathMatcher;
+using apollo::common::math::IndexedPathMatcher;
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
 
@@ -60,15 +60,14 @@ PathTimeGraph::PathTimeGraph(
 
 SLBoundary PathTimeGraph::ComputeObstacleBoundary(
     const std::vector<common::math::Vec2d>& vertices,
-    const std::vector<PathPoint>& discretized_ref_points) const {
+    IndexedPathMatcher* path_matcher) const {
   double start_s(std::numeric_limits<double>::max());
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
 
   for (const auto& point : vertices) {
-    auto sl_point = PathMatcher::GetPathFrenetCoordinate(discretized_ref_points,
-                                                         point.x(), point.y());
+    auto sl_point = path_matcher->GetPathFrenetCoordinate(point.x(), point.y());
     start_s = std::fmin(start_s, sl_point.first);
     end_s = std::fmax(end_s, sl_point.first);
     start_l = std::fmin(start_l, sl_point.second);
@@ -87,14 +86,16 @@ SLBoundary PathTimeGraph::ComputeObstacleBoundary(
 void PathTimeGraph::SetupObstacles(
     const std::vector<const Obstacle*>& obstacles,
     const std::vector<PathPoint>& discretized_ref_points) {
+  // all the obstacle corners are matched against the same reference line
+  IndexedPathMatcher path_matcher(discretized_ref_points);
   for (const Obstacle* obstacle : obstacles) {
     if (obstacle->IsVirtual()) {
       continue;
     }
     if (!obstacle->HasTrajectory()) {
-      SetStaticObstacle(obstacle, discretized_ref_points);
+      SetStaticObstacle(obstacle, &path_matcher);
     } else {
-      SetDynamicObstacle(obstacle, discretized_ref_points);
+      SetDynamicObstacle(obstacle, &path_matcher);
     }
   }
 
@@ -121,14 +122,13 @@ void PathTimeGraph::SetupObstacles(
   }
 }
 
-void PathTimeGraph::SetStaticObstacle(
-    const Obstacle* obstacle,
-    const std::vector<PathPoint>& discretized_ref_points) {
+void PathTimeGraph::SetStaticObstacle(const Obstacle* obstacle,
+                                      IndexedPathMatcher* path_matcher) {
   const Polygon2d& polygon = obstacle->PerceptionPolygon();
 
   std::string obstacle_id = obstacle->Id();
   SLBoundary sl_boundary =
-      ComputeObstacleBoundary(polygon.GetAllVertices(), discretized_ref_points);
+      ComputeObstacleBoundary(polygon.GetAllVertices(), path_matcher);
 
   double left_width = FLAGS_default_reference_line_width * 0.5;
   double right_width = FLAGS_default_reference_line_width * 0.5;
@@ -161,15 +161,14 @@ void PathTimeGraph::SetStaticObstacle(
          << ", end_l : " << sl_boundary.end_l();
 }
 
-void PathTimeGraph::SetDynamicObstacle(
-    const Obstacle* obstacle,
-    const std::vector<PathPoint>& discretized_ref_points) {
+void PathTimeGraph::SetDynamicObstacle(const Obstacle* obstacle,
+                                       IndexedPathMatcher* path_matcher) {
   double relative_time = time_range_.first;
   while (relative_time < time_range_.second) {
     TrajectoryPoint point = obstacle->GetPointAtTime(relative_time);
     Box2d box = obstacle->GetBoundingBox(point);
     SLBoundary sl_boundary =
-        ComputeObstacleBoundary(box.GetAllCorners(), discretized_ref_points);
+        ComputeObstacleBoundary(box.GetAllCorners(), path_matcher);
 
     double left_width = FLAGS_default_reference_line_width * 0.5;
     double right_width = FLAGS_default_reference_line_width * 0.5;
@@ -28,6 +28,7 @@
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/planning/proto/lattice_structure.pb.h"
 
+#include "modules/common/math/path_matcher.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/obstacle.h"
@@ -76,18 +77,16 @@ class PathTimeGraph {
 
   SLBoundary ComputeObstacleBoundary(
       const std::vector<common::math::Vec2d>& vertices,
-      const std::vector<common::PathPoint>& discretized_ref_points) const;
+      common::math::IndexedPathMatcher* path_matcher) const;
 
   PathTimePoint SetPathTimePoint(const std::string& obstacle_id, const double s,
                                  const double t) const;
 
-  void SetStaticObstacle(
-      const Obstacle* obstacle,
-      const std::vector<common::PathPoint>& discretized_ref_points);
+  void SetStaticObstacle(const Obstacle* obstacle,
+                       common::math::IndexedPathMatcher* path_matcher);
 
-  void SetDynamicObstacle(
-      const Obstacle* obstacle,
-      const std::vector<common::PathPoint>& discretized_ref_points);
+  void SetDynamicObstacle(const Obstacle* obstacle,
+                        common::math::IndexedPathMatcher* path_matcher);
 
   void UpdateLateralBoundsByObstacle(
       const SLBoundary& sl_boundary,
@@ -57,6 +57,49 @@ double LatticeTrajectory1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void LatticeTrajectory1d::EvaluateBatch(const std::uint32_t max_order,
+                                        const std::vector<double>& params,
+                                        std::vector<double>* values) const {
+  ptr_trajectory1d_->EvaluateBatch(max_order, params, values);
+
+  // the params beyond the trajectory are extrapolated as in Evaluate
+  const double param_length = ptr_trajectory1d_->ParamLength();
+  const size_t n = params.size();
+  bool has_end_state = false;
+  double p = 0.0;
+  double v = 0.0;
+  double a = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    if (params[i] < param_length) {
+      continue;
+    }
+    if (!has_end_state) {
+      p = ptr_trajectory1d_->Evaluate(0, param_length);
+      v = ptr_trajectory1d_->Evaluate(1, param_length);
+      a = ptr_trajectory1d_->Evaluate(2, param_length);
+      has_end_state = true;
+    }
+    const double t = params[i] - param_length;
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      double value = 0.0;
+      switch (order) {
+        case 0:
+          value = p + v * t + 0.5 * a * t * t;
+          break;
+        case 1:
+          value = v + a * t;
+          break;
+        case 2:
+          value = a;
+          break;
+        default:
+          break;
+      }
+      (*values)[order * n + i] = value;
+    }
+  }
+}
+
 double LatticeTrajectory1d::ParamLength() const {
   return ptr_trajectory1d_->ParamLength();
 }
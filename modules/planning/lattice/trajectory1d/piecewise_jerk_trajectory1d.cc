@@ -69,6 +69,35 @@ double PiecewiseJerkTrajectory1d::Evaluate(const std::uint32_t order,
   return segments_[index - 1].Evaluate(order, param - param_[index - 1]);
 }
 
+void PiecewiseJerkTrajectory1d::EvaluateBatch(
+    const std::uint32_t max_order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  const size_t n = params.size();
+  values->resize((max_order + 1) * n);
+  // the segment of every param is looked up once for all orders
+  std::vector<size_t> segment_index(n);
+  std::vector<double> relative_params(n);
+  for (size_t i = 0; i < n; ++i) {
+    CHECK_GE(params[i], -FLAGS_lattice_epsilon);
+    auto it_lower = std::lower_bound(param_.begin(), param_.end(), params[i]);
+    size_t index = 0;
+    if (it_lower == param_.end()) {
+      index = segments_.size() - 1;
+    } else if (it_lower != param_.begin()) {
+      index = std::distance(param_.begin(), it_lower) - 1;
+    }
+    segment_index[i] = index;
+    relative_params[i] = params[i] - param_[index];
+  }
+  for (std::uint32_t order = 0; order <= max_order; ++order) {
+    double* out = values->data() + order * n;
+    for (size_t i = 0; i < n; ++i) {
+      out[i] =
+          segments_[segment_index[i]].Evaluate(order, relative_params[i]);
+    }
+  }
+}
+
 double PiecewiseJerkTrajectory1d::ParamLength() const {
   return param_.back();
 }
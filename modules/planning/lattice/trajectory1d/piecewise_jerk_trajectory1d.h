@@ -38,6 +38,10 @@ class PiecewiseJerkTrajectory1d : public Curve1d {
   double Evaluate(const std::uint32_t order,
                   const double param) const;
 
+  void EvaluateBatch(const std::uint32_t max_order,
+                     const std::vector<double>& params,
+                     std::vector<double>* values) const override;
+
   double ParamLength() const;
 
   std::string ToString() const;
@@ -17,6 +17,7 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
@@ -40,30 +41,48 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
   double accumulated_trajectory_s = 0.0;
   PathPoint prev_trajectory_point;
 
+  std::vector<double> t_params;
+  for (double t_param = 0.0; t_param < FLAGS_trajectory_time_length;
+       t_param = t_param + FLAGS_trajectory_time_resolution) {
+    t_params.push_back(t_param);
+  }
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about t_param > lon_trajectory.ParamLength() situation
+  std::vector<double> lon_values;
+  lon_trajectory.EvaluateBatch(2, t_params, &lon_values);
+  const size_t num_lon = t_params.size();
+
+  std::vector<double> ss;
+  std::vector<double> relative_ss;
   double last_s = -FLAGS_lattice_epsilon;
-  double t_param = 0.0;
-  while (t_param < FLAGS_trajectory_time_length) {
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about t_param > lon_trajectory.ParamLength() situation
-    double s = lon_trajectory.Evaluate(0, t_param);
+  for (size_t i = 0; i < num_lon; ++i) {
+    double s = lon_values[i];
     if (last_s > 0.0) {
       s = std::max(last_s, s);
     }
     last_s = s;
-
-    double s_dot =
-        std::max(FLAGS_lattice_epsilon, lon_trajectory.Evaluate(1, t_param));
-    double s_ddot = lon_trajectory.Evaluate(2, t_param);
     if (s > s_ref_max) {
       break;
     }
-
-    double relative_s = s - s0;
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about s_param > lat_trajectory.ParamLength() situation
-    double d = lat_trajectory.Evaluate(0, relative_s);
-    double d_prime = lat_trajectory.Evaluate(1, relative_s);
-    double d_pprime = lat_trajectory.Evaluate(2, relative_s);
+    ss.push_back(s);
+    relative_ss.push_back(s - s0);
+  }
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about s_param > lat_trajectory.ParamLength() situation
+  std::vector<double> lat_values;
+  lat_trajectory.EvaluateBatch(2, relative_ss, &lat_values);
+  const size_t num_lat = relative_ss.size();
+
+  for (size_t i = 0; i < num_lat; ++i) {
+    const double t_param = t_params[i];
+    const double s = ss[i];
+    const double s_dot =
+        std::max(FLAGS_lattice_epsilon, lon_values[num_lon + i]);
+    const double s_ddot = lon_values[2 * num_lon + i];
+
+    const double d = lat_values[i];
+    const double d_prime = lat_values[num_lat + i];
+    const double d_pprime = lat_values[2 * num_lat + i];
 
     PathPoint matched_ref_point = PathMatcher::MatchToPath(reference_line, s);
 
@@ -106,8 +125,6 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
 
     combined_trajectory.AppendTrajectoryPoint(trajectory_point);
 
-    t_param = t_param + FLAGS_trajectory_time_resolution;
-
     prev_trajectory_point = trajectory_point.path_point();
   }
   return combined_trajectory;
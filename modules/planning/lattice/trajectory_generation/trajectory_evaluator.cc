@@ -22,8 +22,10 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker1d.h"
@@ -42,13 +44,30 @@ using Trajectory1dPair =
 
 using PtrTrajectory1d = std::shared_ptr<Trajectory1d>;
 
+namespace {
+
+// Runs func(i) for i in [0, n), on the planning threads when enabled.
+template <typename F>
+void ForEach(size_t n, F&& func) {
+  if (FLAGS_enable_multi_thread_in_lattice_planner) {
+    cyber::ParallelFor(0, n, 1, func);
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      func(i);
+    }
+  }
+}
+
+}  // namespace
+
 TrajectoryEvaluator::TrajectoryEvaluator(
     const std::array<double, 3>& init_s, const PlanningTarget& planning_target,
     const std::vector<PtrTrajectory1d>& lon_trajectories,
     const std::vector<PtrTrajectory1d>& lat_trajectories,
     std::shared_ptr<PathTimeGraph> path_time_graph,
     std::shared_ptr<std::vector<PathPoint>> reference_line)
-    : path_time_graph_(path_time_graph),
+    : lat_trajectories_(lat_trajectories),
+      path_time_graph_(path_time_graph),
       reference_line_(reference_line),
       init_s_(init_s) {
   const double start_time = 0.0;
@@ -64,6 +83,7 @@ TrajectoryEvaluator::TrajectoryEvaluator(
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+  std::vector<PtrTrajectory1d> valid_lon_trajectories;
   for (const auto& lon_trajectory : lon_trajectories) {
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
@@ -74,22 +94,75 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
-    for (const auto& lat_trajectory : lat_trajectories) {
-      /**
-       * The validity of the code needs to be verified.
-      if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
-                                                         *lon_trajectory)) {
-        continue;
-      }
-      */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+    valid_lon_trajectories.push_back(lon_trajectory);
+  }
+
+  // the longitudinal costs are shared by all the pairs of a lon. trajectory
+  lon_trajectories_.resize(valid_lon_trajectories.size());
+  ForEach(valid_lon_trajectories.size(), [&](size_t i) {
+    lon_trajectories_[i] =
+        EvaluateLon(planning_target, valid_lon_trajectories[i]);
+  });
+
+  /**
+   * The validity of the code needs to be verified.
+  if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
+                                                     *lon_trajectory)) {
+    continue;
+  }
+  */
+  const size_t num_lat = lat_trajectories_.size();
+  std::vector<PairCost> pairs(lon_trajectories_.size() * num_lat);
+  for (size_t i = 0; i < lon_trajectories_.size(); ++i) {
+    for (size_t j = 0; j < num_lat; ++j) {
+      pairs[i * num_lat + j] = {i, j, lon_trajectories_[i].cost, true};
     }
   }
+
+  // the lateral costs are only deferred when they can not be negative
+  const bool defer_lat_cost = FLAGS_weight_lat_offset >= 0.0 &&
+                              FLAGS_weight_lat_comfort >= 0.0 &&
+                              FLAGS_weight_same_side_offset >= 0.0 &&
+                              FLAGS_weight_opposite_side_offset >= 0.0;
+  if (!defer_lat_cost) {
+    ForEach(pairs.size(), [&](size_t k) {
+      auto& pair = pairs[k];
+      pair.cost += EvaluateLat(lon_trajectories_[pair.lon_index],
+                               lat_trajectories_[pair.lat_index]);
+      pair.is_lower_bound = false;
+    });
+  }
+  cost_queue_ = std::priority_queue<PairCost, std::vector<PairCost>,
+                                    CostComparator>(CostComparator(),
+                                                    std::move(pairs));
+  ResolveTopPair();
   ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
 }
 
+void TrajectoryEvaluator::ResolveTopPair() {
+  std::vector<PairCost> batch;
+  while (!cost_queue_.empty() && cost_queue_.top().is_lower_bound) {
+    // pairs whose lower bound is above the cost of the top pair need no
+    // evaluation, so only a batch of pairs is taken at a time.
+    batch.clear();
+    while (!cost_queue_.empty() && cost_queue_.top().is_lower_bound &&
+           batch.size() < static_cast<size_t>(std::max(
+                              1, FLAGS_lattice_evaluation_batch_size))) {
+      batch.push_back(cost_queue_.top());
+      cost_queue_.pop();
+    }
+    ForEach(batch.size(), [&](size_t k) {
+      auto& pair = batch[k];
+      pair.cost += EvaluateLat(lon_trajectories_[pair.lon_index],
+                               lat_trajectories_[pair.lat_index]);
+      pair.is_lower_bound = false;
+    });
+    for (const auto& pair : batch) {
+      cost_queue_.push(pair);
+    }
+  }
+}
+
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
   return !cost_queue_.empty();
 }
@@ -103,26 +176,22 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   CHECK(has_more_trajectory_pairs() == true);
   auto top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  ResolveTopPair();
+  return Trajectory1dPair(lon_trajectories_[top.lon_index].trajectory,
+                          lat_trajectories_[top.lat_index]);
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().cost;
 }
 
-double TrajectoryEvaluator::Evaluate(
+TrajectoryEvaluator::LonTrajectory TrajectoryEvaluator::EvaluateLon(
     const PlanningTarget& planning_target,
     const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory,
     std::vector<double>* cost_components) const {
-  // Costs:
-  // 1. Cost of missing the objective, e.g., cruise, stop, etc.
-  // 2. Cost of logitudinal jerk
-  // 3. Cost of logitudinal collision
-  // 4. Cost of lateral offsets
-  // 5. Cost of lateral comfort
-
-  // Longitudinal costs
+  LonTrajectory result;
+  result.trajectory = lon_trajectory;
+
   double lon_objective_cost =
       LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
 
@@ -132,33 +201,51 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
+  if (cost_components != nullptr) {
+    cost_components->emplace_back(lon_objective_cost);
+    cost_components->emplace_back(lon_jerk_cost);
+    cost_components->emplace_back(lon_collision_cost);
+  }
+
+  result.cost = lon_objective_cost * FLAGS_weight_lon_objective +
+                lon_jerk_cost * FLAGS_weight_lon_jerk +
+                lon_collision_cost * FLAGS_weight_lon_collision +
+                centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+
   // decides the longitudinal evaluation horizon for lateral trajectories.
   double evaluation_horizon =
       std::min(FLAGS_decision_horizon,
                lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
   for (double s = 0.0; s < evaluation_horizon;
        s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
+    result.s_values.emplace_back(s);
+  }
+
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    LonSample sample;
+    sample.relative_s = lon_trajectory->Evaluate(0, t) - init_s_[0];
+    sample.s_dot = lon_trajectory->Evaluate(1, t);
+    sample.s_dotdot = lon_trajectory->Evaluate(2, t);
+    result.samples.push_back(sample);
   }
+  return result;
+}
 
-  // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+double TrajectoryEvaluator::EvaluateLat(
+    const LonTrajectory& lon_trajectory, const PtrTrajectory1d& lat_trajectory,
+    std::vector<double>* cost_components) const {
+  double lat_offset_cost =
+      LatOffsetCost(lat_trajectory, lon_trajectory.s_values);
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+  double lat_comfort_cost =
+      LatComfortCost(lon_trajectory.samples, lat_trajectory);
 
   if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
     cost_components->emplace_back(lat_offset_cost);
   }
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
+  return lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
@@ -183,19 +270,14 @@ double TrajectoryEvaluator::LatOffsetCost(
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const std::vector<LonSample>& lon_samples,
     const PtrTrajectory1d& lat_trajectory) const {
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
-
-    double relative_s = s - init_s_[0];
-    double l_prime = lat_trajectory->Evaluate(1, relative_s);
-    double l_primeprime = lat_trajectory->Evaluate(2, relative_s);
-    double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
+  for (const auto& sample : lon_samples) {
+    double l_prime = lat_trajectory->Evaluate(1, sample.relative_s);
+    double l_primeprime = lat_trajectory->Evaluate(2, sample.relative_s);
+    double cost = l_primeprime * sample.s_dot * sample.s_dot +
+                  l_prime * sample.s_dotdot;
     max_cost = std::max(max_cost, std::fabs(cost));
   }
   return max_cost;
@@ -35,11 +35,6 @@ namespace apollo {
 namespace planning {
 
 class TrajectoryEvaluator {
-  // normal use
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>, double>
-      PairCost;
-
   // auto tuning
   typedef std::pair<
       std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>,
@@ -69,17 +64,48 @@ class TrajectoryEvaluator {
   std::vector<double> top_trajectory_pair_component_cost() const;
 
  private:
-  double Evaluate(const PlanningTarget& planning_target,
-                  const std::shared_ptr<Curve1d>& lon_trajectory,
-                  const std::shared_ptr<Curve1d>& lat_trajectory,
-                  std::vector<double>* cost_components = nullptr) const;
+  // the state of a lon. trajectory at each time stamp, shared by the lateral
+  // costs of all the pairs it is part of
+  struct LonSample {
+    double relative_s;
+    double s_dot;
+    double s_dotdot;
+  };
+
+  struct LonTrajectory {
+    std::shared_ptr<Curve1d> trajectory;
+    double cost = 0.0;
+    std::vector<double> s_values;
+    std::vector<LonSample> samples;
+  };
+
+  // Costs of a lon. trajectory alone:
+  // 1. Cost of missing the objective, e.g., cruise, stop, etc.
+  // 2. Cost of logitudinal jerk
+  // 3. Cost of logitudinal collision
+  // 4. Cost of centripetal acceleration
+  LonTrajectory EvaluateLon(const PlanningTarget& planning_target,
+                            const std::shared_ptr<Curve1d>& lon_trajectory,
+                            std::vector<double>* cost_components = nullptr)
+      const;
+
+  // Costs depending on the lat. trajectory of a pair:
+  // 1. Cost of lateral offsets
+  // 2. Cost of lateral comfort
+  double EvaluateLat(const LonTrajectory& lon_trajectory,
+                     const std::shared_ptr<Curve1d>& lat_trajectory,
+                     std::vector<double>* cost_components = nullptr) const;
 
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
                        const std::vector<double>& s_values) const;
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+  double LatComfortCost(const std::vector<LonSample>& lon_samples,
                         const std::shared_ptr<Curve1d>& lat_trajectory) const;
 
+  // Evaluates the lateral costs of the cheapest pairs until the top of the
+  // queue holds a full cost.
+  void ResolveTopPair();
+
   double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
 
   double LonCollisionCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
@@ -98,16 +124,30 @@ class TrajectoryEvaluator {
       const std::vector<apollo::common::SpeedPoint>& st_points,
       double t, double *traj_s) const;
 
+  // Until its lateral costs are evaluated, a pair is queued with the cost of
+  // its lon. trajectory, which is a lower bound of its full cost as long as
+  // the lateral weights are non-negative.
+  struct PairCost {
+    size_t lon_index;
+    size_t lat_index;
+    double cost;
+    bool is_lower_bound;
+  };
+
   struct CostComparator
       : public std::binary_function<const PairCost&, const PairCost&, bool> {
     bool operator()(const PairCost& left, const PairCost& right) const {
-      return left.second > right.second;
+      return left.cost > right.cost;
     }
   };
 
   std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
       cost_queue_;
 
+  std::vector<LonTrajectory> lon_trajectories_;
+
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+
   std::shared_ptr<PathTimeGraph> path_time_graph_;
 
   std::shared_ptr<std::vector<apollo::common::PathPoint>> reference_line_;
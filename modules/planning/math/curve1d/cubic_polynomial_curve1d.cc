@@ -72,6 +72,12 @@ double CubicPolynomialCurve1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void CubicPolynomialCurve1d::EvaluateBatch(
+    const std::uint32_t max_order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  EvaluatePolynomialBatch(coef_, max_order, params, values);
+}
+
 std::string CubicPolynomialCurve1d::ToString() const {
   return apollo::common::util::StrCat(
       apollo::common::util::PrintIter(coef_, "\t"), param_, "\n");
@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace planning {
@@ -36,6 +38,24 @@ class Curve1d {
   virtual double Evaluate(const std::uint32_t order,
                           const double param) const = 0;
 
+  /**
+   * @brief Evaluates the derivatives of order 0 to max_order at every param.
+   * The values are stored order by order, values[order * params.size() + i]
+   * belongs to params[i]. Curves override it to evaluate a whole batch in one
+   * virtual call.
+   */
+  virtual void EvaluateBatch(const std::uint32_t max_order,
+                             const std::vector<double>& params,
+                             std::vector<double>* values) const {
+    const size_t n = params.size();
+    values->resize((max_order + 1) * n);
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      for (size_t i = 0; i < n; ++i) {
+        (*values)[order * n + i] = Evaluate(order, params[i]);
+      }
+    }
+  }
+
   virtual double ParamLength() const = 0;
 
   virtual std::string ToString() const = 0;
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -34,6 +38,42 @@ class PolynomialCurve1d : public Curve1d {
   virtual size_t Order() const = 0;
 
  protected:
+  // Horner's scheme over the whole batch for each derivative, the inner loops
+  // run over contiguous params so the compiler can vectorize them.
+  template <size_t N>
+  static void EvaluatePolynomialBatch(const std::array<double, N>& coef,
+                                      const std::uint32_t max_order,
+                                      const std::vector<double>& params,
+                                      std::vector<double>* values) {
+    const size_t n = params.size();
+    values->resize((max_order + 1) * n);
+    const double* p = params.data();
+    std::array<double, N> c;
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      double* out = values->data() + order * n;
+      if (order >= N) {
+        std::fill(out, out + n, 0.0);
+        continue;
+      }
+      // c[k] multiplies p^k in the derivative of the given order
+      const size_t degree = N - 1 - order;
+      for (size_t k = 0; k <= degree; ++k) {
+        double factor = 1.0;
+        for (size_t j = 1; j <= order; ++j) {
+          factor *= static_cast<double>(k + j);
+        }
+        c[k] = factor * coef[k + order];
+      }
+      std::fill(out, out + n, c[degree]);
+      for (size_t k = degree; k > 0; --k) {
+        const double ck = c[k - 1];
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = out[i] * p[i] + ck;
+        }
+      }
+    }
+  }
+
   double param_ = 0.0;
 };
 
@@ -75,6 +75,12 @@ double QuarticPolynomialCurve1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void QuarticPolynomialCurve1d::EvaluateBatch(
+    const std::uint32_t max_order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  EvaluatePolynomialBatch(coef_, max_order, params, values);
+}
+
 QuarticPolynomialCurve1d& QuarticPolynomialCurve1d::FitWithEndPointFirstOrder(
     const double x0, const double dx0, const double ddx0, const double x1,
     const double dx1, const double p) {
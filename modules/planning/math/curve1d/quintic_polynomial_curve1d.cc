@@ -86,6 +86,12 @@ double QuinticPolynomialCurve1d::Evaluate(const uint32_t order,
   }
 }
 
+void QuinticPolynomialCurve1d::EvaluateBatch(
+    const std::uint32_t max_order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  EvaluatePolynomialBatch(coef_, max_order, params, values);
+}
+
 void QuinticPolynomialCurve1d::SetParam(const double x0, const double dx0,
                                         const double ddx0, const double x1,
                                         const double dx1, const double ddx1,
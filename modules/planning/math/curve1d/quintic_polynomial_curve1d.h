@@ -22,6 +22,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -55,6 +56,10 @@ class QuinticPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  void EvaluateBatch(const std::uint32_t max_order,
+                     const std::vector<double>& params,
+                     std::vector<double>* values) const override;
+
   double ParamLength() const override { return param_; }
   std::string ToString() const override;
 
@@ -16,7 +16,10 @@
 
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "modules/planning/math/curve1d/cubic_polynomial_curve1d.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
 namespace apollo {
@@ -70,5 +73,35 @@ TEST(QuinticPolynomialCurve1dTest, IntegratedFromQuarticCurve) {
                 quintic_curve.Evaluate(4, value), 1e-8);
   }
 }
+
+TEST(QuinticPolynomialCurve1dTest, EvaluateBatch) {
+  const QuinticPolynomialCurve1d quintic_curve(0.0, 1.0, 0.8, 10.0, 5.0, 0.0,
+                                               8.0);
+  const QuarticPolynomialCurve1d quartic_curve(2, 1, 4, 3, 2, 4);
+  const CubicPolynomialCurve1d cubic_curve(1.0, 2.0, 0.5, 3.0, 4.0);
+  std::vector<double> params;
+  for (double value = 0.0; value < 8.1; value += 0.3) {
+    params.push_back(value);
+  }
+  const size_t n = params.size();
+  const std::vector<const Curve1d*> curves = {&quintic_curve, &quartic_curve,
+                                              &cubic_curve};
+  for (const Curve1d* curve : curves) {
+    std::vector<double> values;
+    curve->EvaluateBatch(5, params, &values);
+    ASSERT_EQ(6 * n, values.size());
+    for (std::uint32_t order = 0; order <= 5; ++order) {
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(curve->Evaluate(order, params[i]), values[order * n + i],
+                    1e-8);
+      }
+    }
+  }
+
+  std::vector<double> values;
+  quintic_curve.EvaluateBatch(1, {}, &values);
+  EXPECT_TRUE(values.empty());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file quintic_polynomial_sampler.cc
+ **/
+
+#include "modules/planning/math/curve1d/quintic_polynomial_sampler.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+QuinticPolynomialSampler::QuinticPolynomialSampler(
+    const std::vector<double>& params)
+    : params_(params) {
+  const size_t n = params_.size();
+  powers_[0].assign(n, 1.0);
+  for (size_t k = 1; k < powers_.size(); ++k) {
+    powers_[k].resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      powers_[k][i] = powers_[k - 1][i] * params_[i];
+    }
+  }
+}
+
+void QuinticPolynomialSampler::Evaluate(const QuinticPolynomialCurve1d& curve,
+                                        const std::uint32_t order,
+                                        std::vector<double>* values) const {
+  CHECK_NOTNULL(values);
+  DCHECK_LE(order, 2);
+  const size_t n = params_.size();
+  values->resize(n);
+  // c[k] multiplies params^k of the requested derivative
+  std::array<double, 6> c{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+  for (size_t k = order; k < c.size(); ++k) {
+    double factor = 1.0;
+    for (size_t j = 0; j < order; ++j) {
+      factor *= static_cast<double>(k - j);
+    }
+    c[k - order] = factor * curve.Coef(k);
+  }
+  const double* p0 = powers_[0].data();
+  const double* p1 = powers_[1].data();
+  const double* p2 = powers_[2].data();
+  const double* p3 = powers_[3].data();
+  const double* p4 = powers_[4].data();
+  const double* p5 = powers_[5].data();
+  double* out = values->data();
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = c[0] * p0[i] + c[1] * p1[i] + c[2] * p2[i] + c[3] * p3[i] +
+             c[4] * p4[i] + c[5] * p5[i];
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file quintic_polynomial_sampler.h
+ **/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+// Evaluates quintic polynomial curves at a fixed set of params. The powers
+// of the params are computed once, so evaluating a curve is a few
+// multiply-adds per sample over contiguous arrays, which the compiler can
+// vectorize. Build one sampler and evaluate every curve sharing the params.
+class QuinticPolynomialSampler {
+ public:
+  QuinticPolynomialSampler() = default;
+
+  explicit QuinticPolynomialSampler(const std::vector<double>& params);
+
+  size_t size() const { return params_.size(); }
+
+  const std::vector<double>& params() const { return params_; }
+
+  // (*values)[i] = curve.Evaluate(order, params()[i]), order is 0, 1 or 2
+  void Evaluate(const QuinticPolynomialCurve1d& curve,
+                const std::uint32_t order, std::vector<double>* values) const;
+
+ private:
+  std::vector<double> params_;
+  // powers_[k][i] = params_[i]^k
+  std::array<std::vector<double>, 6> powers_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/math/curve1d/quintic_polynomial_sampler.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(QuinticPolynomialSamplerTest, MatchesCurveEvaluate) {
+  std::vector<double> params;
+  for (double s = 0.0; s < 20.0; s += 0.3) {
+    params.push_back(s);
+  }
+  QuinticPolynomialSampler sampler(params);
+  EXPECT_EQ(params.size(), sampler.size());
+
+  const QuinticPolynomialCurve1d curves[] = {
+      {0.0, 1.0, 0.8, 10.0, 0.5, -0.2, 20.0},
+      {-1.5, 0.0, 0.0, 2.0, 0.0, 0.0, 20.0},
+  };
+  std::vector<double> values;
+  for (const auto& curve : curves) {
+    for (std::uint32_t order = 0; order <= 2; ++order) {
+      sampler.Evaluate(curve, order, &values);
+      ASSERT_EQ(params.size(), values.size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        EXPECT_NEAR(curve.Evaluate(order, params[i]), values[i], 1e-9);
+      }
+    }
+  }
+}
+
+TEST(QuinticPolynomialSamplerTest, Empty) {
+  QuinticPolynomialSampler sampler;
+  std::vector<double> values(3, 1.0);
+  sampler.Evaluate(QuinticPolynomialCurve1d(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0),
+                   0, &values);
+  EXPECT_TRUE(values.empty());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -47,35 +47,27 @@ bool Fem1dExpandedQpProblem::Optimize() {
   x_derivative_.resize(num_var_);
   x_second_order_derivative_.resize(num_var_);
 
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  OSQPWorkspace* work = nullptr;
-
   const size_t kNumVariable = 3 * num_var_;
-  OptimizeWithOsqp(kNumVariable, lower_bounds.size(), P_data, P_indices,
-                   P_indptr, A_data, A_indices, A_indptr, lower_bounds,
-                   upper_bounds, q, data, &work, settings);
+  if (!OptimizeWithOsqp(kNumVariable, lower_bounds.size(), P_data, P_indices,
+                        P_indptr, A_data, A_indices, A_indptr, lower_bounds,
+                        upper_bounds, q)) {
+    AERROR << "Failed to find QP solution.";
+    return false;
+  }
 
   // extract primal results
+  const c_float* solution = osqp_solver_->primal();
   x_.resize(num_var_);
   x_derivative_.resize(num_var_);
   x_second_order_derivative_.resize(num_var_);
   for (size_t i = 0; i < x_bounds_.size(); ++i) {
-    x_.at(i) = work->solution->x[i];
-    x_derivative_.at(i) = work->solution->x[i + num_var_];
-    x_second_order_derivative_.at(i) = work->solution->x[i + 2 * num_var_];
+    x_.at(i) = solution[i];
+    x_derivative_.at(i) = solution[i + num_var_];
+    x_second_order_derivative_.at(i) = solution[i + 2 * num_var_];
   }
   x_derivative_.back() = 0.0;
   x_second_order_derivative_.back() = 0.0;
 
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
-
   return true;
 }
 
@@ -50,15 +50,12 @@ bool Fem1dLinearQpProblem::Optimize() {
   diff = end_time3 - end_time2;
   ADEBUG << "CalculateOffset used time: " << diff.count() * 1000 << " ms.";
 
-  // Problem settings
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  OSQPWorkspace* work = nullptr;
-
-  OptimizeWithOsqp(num_var_, lower_bounds.size(), P_data, P_indices, P_indptr,
-                   A_data, A_indices, A_indptr, lower_bounds, upper_bounds, q,
-                   data, &work, settings);
+  if (!OptimizeWithOsqp(num_var_, lower_bounds.size(), P_data, P_indices,
+                        P_indptr, A_data, A_indices, A_indptr, lower_bounds,
+                        upper_bounds, q)) {
+    AERROR << "Failed to find QP solution.";
+    return false;
+  }
 
   x_.resize(num_var_ + 1);
   x_derivative_.resize(num_var_ + 1);
@@ -68,18 +65,12 @@ bool Fem1dLinearQpProblem::Optimize() {
   x_derivative_.front() = x_init_[1];
   x_second_order_derivative_.front() = x_init_[2];
 
+  const c_float* solution = osqp_solver_->primal();
   for (size_t i = 0; i < num_var_; ++i) {
-    x_.at(i + 1) = work->solution->x[i];
+    x_.at(i + 1) = solution[i];
     // TODO(All): extract x_derivative_ and x_second_order_derivative_
   }
 
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
-
   auto end_time4 = std::chrono::system_clock::now();
   diff = end_time4 - end_time3;
   ADEBUG << "Run OptimizeWithOsqp used time: " << diff.count() * 1000 << " ms.";
@@ -20,12 +20,16 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "osqp/include/osqp.h"
 
+#include "modules/planning/math/osqp_solver.h"
+
 namespace apollo {
 namespace planning {
 
@@ -125,15 +129,18 @@ class Fem1dQpProblem {
       std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
       std::vector<c_float>* upper_bounds) = 0;
 
-  bool OptimizeWithOsqp(
-      const size_t kernel_dim, const size_t num_affine_constraint,
-      std::vector<c_float>& P_data, std::vector<c_int>& P_indices,    // NOLINT
-      std::vector<c_int>& P_indptr, std::vector<c_float>& A_data,     // NOLINT
-      std::vector<c_int>& A_indices, std::vector<c_int>& A_indptr,    // NOLINT
-      std::vector<c_float>& lower_bounds,                             // NOLINT
-      std::vector<c_float>& upper_bounds,                             // NOLINT
-      std::vector<c_float>& q, OSQPData* data, OSQPWorkspace** work,  // NOLINT
-      OSQPSettings* settings);
+  // solves with osqp_solver_, whose workspace is kept for the next call
+  bool OptimizeWithOsqp(const size_t kernel_dim,
+                        const size_t num_affine_constraint,
+                        const std::vector<c_float>& P_data,
+                        const std::vector<c_int>& P_indices,
+                        const std::vector<c_int>& P_indptr,
+                        const std::vector<c_float>& A_data,
+                        const std::vector<c_int>& A_indices,
+                        const std::vector<c_int>& A_indptr,
+                        const std::vector<c_float>& lower_bounds,
+                        const std::vector<c_float>& upper_bounds,
+                        const std::vector<c_float>& q);
 
   virtual void ProcessBound(
       const std::vector<std::tuple<double, double, double>>& src,
@@ -171,6 +178,10 @@ class Fem1dQpProblem {
   double delta_s_tetra_ = 1.0;  // delta_s^4
   double delta_s_penta_ = 1.0;  // delta_s^5
   double delta_s_hex_ = 1.0;    // delta_s^6
+
+  // kept across Optimize() calls, so a problem which is initialized again
+  // with the same size only updates the values of the last workspace
+  std::unique_ptr<OsqpSolver> osqp_solver_;
 };
 
 }  // namespace planning
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file osqp_solver.cc
+ **/
+
+#include "modules/planning/math/osqp_solver.h"
+
+#include "cyber/common/log.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// osqp keeps the upper triangular part of P and expects updates of its values
+// in that order, so it is extracted up front for both.
+void UpperTriangular(const std::vector<c_float>& data,
+                     const std::vector<c_int>& indices,
+                     const std::vector<c_int>& indptr,
+                     std::vector<c_float>* triu_data,
+                     std::vector<c_int>* triu_indices,
+                     std::vector<c_int>* triu_indptr) {
+  triu_data->clear();
+  triu_indices->clear();
+  triu_indptr->clear();
+  for (size_t c = 0; c + 1 < indptr.size(); ++c) {
+    triu_indptr->push_back(static_cast<c_int>(triu_data->size()));
+    for (c_int i = indptr[c]; i < indptr[c + 1]; ++i) {
+      if (indices[i] <= static_cast<c_int>(c)) {
+        triu_data->push_back(data[i]);
+        triu_indices->push_back(indices[i]);
+      }
+    }
+  }
+  triu_indptr->push_back(static_cast<c_int>(triu_data->size()));
+}
+
+}  // namespace
+
+OsqpSolver::OsqpSolver(const OSQPSettings& settings) : settings_(settings) {
+  settings_.warm_start = true;
+}
+
+OsqpSolver::~OsqpSolver() { Reset(); }
+
+void OsqpSolver::Reset() {
+  osqp_cleanup(work_);
+  work_ = nullptr;
+  num_var_ = 0;
+  num_constraint_ = 0;
+  last_primal_.clear();
+  last_dual_.clear();
+  workspace_reused_ = false;
+}
+
+bool OsqpSolver::Solve(const std::vector<c_float>& P_data,
+                       const std::vector<c_int>& P_indices,
+                       const std::vector<c_int>& P_indptr,
+                       const std::vector<c_float>& A_data,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr,
+                       const std::vector<c_float>& q,
+                       const std::vector<c_float>& lower_bounds,
+                       const std::vector<c_float>& upper_bounds) {
+  const c_int num_var = static_cast<c_int>(q.size());
+  const c_int num_constraint = static_cast<c_int>(lower_bounds.size());
+  if (num_var == 0 || P_indptr.size() != q.size() + 1 ||
+      A_indptr.size() != q.size() + 1 ||
+      upper_bounds.size() != lower_bounds.size()) {
+    AERROR << "Malformed qp problem, num_var: " << num_var
+           << ", num_constraint: " << num_constraint;
+    return false;
+  }
+
+  UpperTriangular(P_data, P_indices, P_indptr, &P_data_, &P_indices_,
+                  &P_indptr_);
+
+  workspace_reused_ =
+      FLAGS_enable_osqp_workspace_reuse && work_ != nullptr &&
+      !last_primal_.empty() && num_var == num_var_ &&
+      num_constraint == num_constraint_ && P_indptr_ == work_P_indptr_ &&
+      P_indices_ == work_P_indices_ && A_indptr == work_A_indptr_ &&
+      A_indices == work_A_indices_;
+  if (workspace_reused_ &&
+      !Update(A_data, q, lower_bounds, upper_bounds)) {
+    AWARN << "Failed to update the osqp workspace, setting it up again.";
+    workspace_reused_ = false;
+  }
+  if (!workspace_reused_) {
+    const bool warm_start =
+        num_var == num_var_ && num_constraint == num_constraint_ &&
+        !last_primal_.empty();
+    num_var_ = num_var;
+    num_constraint_ = num_constraint;
+    if (!Setup(A_data, A_indices, A_indptr, q, lower_bounds, upper_bounds)) {
+      AERROR << "Failed to set up the osqp workspace.";
+      Reset();
+      return false;
+    }
+    if (warm_start) {
+      osqp_warm_start(work_, last_primal_.data(), last_dual_.data());
+    }
+  }
+  ADEBUG << "osqp workspace reused: " << workspace_reused_;
+
+  osqp_solve(work_);
+
+  if (work_->info->status_val == OSQP_SOLVED) {
+    last_primal_.assign(work_->solution->x, work_->solution->x + num_var_);
+    last_dual_.assign(work_->solution->y,
+                      work_->solution->y + num_constraint_);
+  } else {
+    last_primal_.clear();
+    last_dual_.clear();
+  }
+  return true;
+}
+
+const c_float* OsqpSolver::primal() const {
+  return work_ == nullptr ? nullptr : work_->solution->x;
+}
+
+c_int OsqpSolver::status() const {
+  return work_ == nullptr ? OSQP_UNSOLVED : work_->info->status_val;
+}
+
+bool OsqpSolver::Update(const std::vector<c_float>& A_data,
+                        const std::vector<c_float>& q,
+                        const std::vector<c_float>& lower_bounds,
+                        const std::vector<c_float>& upper_bounds) {
+  // the iterates of the previous solve are kept in the workspace, so with
+  // warm_start set the next solve starts from them
+  return osqp_update_P_A(work_, P_data_.data(), OSQP_NULL,
+                         static_cast<c_int>(P_data_.size()),
+                         const_cast<c_float*>(A_data.data()), OSQP_NULL,
+                         static_cast<c_int>(A_data.size())) == 0 &&
+         osqp_update_lin_cost(work_, const_cast<c_float*>(q.data())) == 0 &&
+         osqp_update_bounds(work_, const_cast<c_float*>(lower_bounds.data()),
+                            const_cast<c_float*>(upper_bounds.data())) == 0;
+}
+
+bool OsqpSolver::Setup(const std::vector<c_float>& A_data,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr,
+                       const std::vector<c_float>& q,
+                       const std::vector<c_float>& lower_bounds,
+                       const std::vector<c_float>& upper_bounds) {
+  osqp_cleanup(work_);
+  work_ = nullptr;
+
+  // osqp_setup copies the problem data, so the arrays are only borrowed here
+  OSQPData data;
+  data.n = num_var_;
+  data.m = num_constraint_;
+  data.P = csc_matrix(data.n, data.n, static_cast<c_int>(P_data_.size()),
+                      P_data_.data(), P_indices_.data(), P_indptr_.data());
+  data.q = const_cast<c_float*>(q.data());
+  data.A = csc_matrix(data.m, data.n, static_cast<c_int>(A_data.size()),
+                      const_cast<c_float*>(A_data.data()),
+                      const_cast<c_int*>(A_indices.data()),
+                      const_cast<c_int*>(A_indptr.data()));
+  data.l = const_cast<c_float*>(lower_bounds.data());
+  data.u = const_cast<c_float*>(upper_bounds.data());
+
+  work_ = osqp_setup(&data, &settings_);
+
+  c_free(data.A);
+  c_free(data.P);
+
+  if (work_ == nullptr) {
+    return false;
+  }
+  work_P_indices_ = P_indices_;
+  work_P_indptr_ = P_indptr_;
+  work_A_indices_ = A_indices;
+  work_A_indptr_ = A_indptr;
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file osqp_solver.h
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "osqp/include/osqp.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class OsqpSolver
+ * @brief Keeps an osqp workspace alive between solves. When a problem has the
+ * same dimensions and sparsity pattern as the previous one, only its values
+ * are updated and the solver starts from the previous solution, which skips
+ * the setup and the symbolic factorization. Otherwise the workspace is set up
+ * again, warm started from the previous solution if the dimensions match.
+ */
+class OsqpSolver {
+ public:
+  explicit OsqpSolver(const OSQPSettings& settings);
+
+  ~OsqpSolver();
+
+  OsqpSolver(const OsqpSolver&) = delete;
+  OsqpSolver& operator=(const OsqpSolver&) = delete;
+
+  /**
+   * @brief Solves min 0.5 * x'Px + q'x s.t. l <= Ax <= u, with P and A in csc
+   * format. Only the upper triangular part of P is used.
+   * @return false if the problem is malformed or the workspace can not be set
+   * up; check status() for the outcome of the solve itself.
+   */
+  bool Solve(const std::vector<c_float>& P_data,
+             const std::vector<c_int>& P_indices,
+             const std::vector<c_int>& P_indptr,
+             const std::vector<c_float>& A_data,
+             const std::vector<c_int>& A_indices,
+             const std::vector<c_int>& A_indptr,
+             const std::vector<c_float>& q,
+             const std::vector<c_float>& lower_bounds,
+             const std::vector<c_float>& upper_bounds);
+
+  // the primal solution of the last solve, num_var() values
+  const c_float* primal() const;
+
+  // osqp status of the last solve, OSQP_UNSOLVED without a workspace
+  c_int status() const;
+
+  c_int num_var() const { return num_var_; }
+
+  // whether the last solve updated the previous workspace in place
+  bool workspace_reused() const { return workspace_reused_; }
+
+  /**
+   * @brief Releases the workspace and forgets the previous solution.
+   */
+  void Reset();
+
+ private:
+  bool Update(const std::vector<c_float>& A_data,
+              const std::vector<c_float>& q,
+              const std::vector<c_float>& lower_bounds,
+              const std::vector<c_float>& upper_bounds);
+
+  bool Setup(const std::vector<c_float>& A_data,
+             const std::vector<c_int>& A_indices,
+             const std::vector<c_int>& A_indptr,
+             const std::vector<c_float>& q,
+             const std::vector<c_float>& lower_bounds,
+             const std::vector<c_float>& upper_bounds);
+
+  OSQPSettings settings_;
+  OSQPWorkspace* work_ = nullptr;
+
+  c_int num_var_ = 0;
+  c_int num_constraint_ = 0;
+
+  // upper triangular part of the last P
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+
+  // sparsity pattern of the workspace
+  std::vector<c_int> work_P_indices_;
+  std::vector<c_int> work_P_indptr_;
+  std::vector<c_int> work_A_indices_;
+  std::vector<c_int> work_A_indptr_;
+
+  // solution of the last solved problem, empty if it was not solved
+  std::vector<c_float> last_primal_;
+  std::vector<c_float> last_dual_;
+
+  bool workspace_reused_ = false;
+};
+
+}  // namespace planning
+}  // namespace apollo
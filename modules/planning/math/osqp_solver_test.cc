@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file osqp_solver_test.cc
+ **/
+
+#include "modules/planning/math/osqp_solver.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+OSQPSettings TestSettings() {
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.polish = true;
+  settings.verbose = false;
+  return settings;
+}
+
+}  // namespace
+
+// min 0.5 * x'Px + q'x, s.t. x0 + x1 = 1, 0 <= x0 <= 0.7, 0 <= x1 <= 0.7
+TEST(OsqpSolverTest, ReuseWorkspace) {
+  FLAGS_enable_osqp_workspace_reuse = true;
+  OsqpSolver solver(TestSettings());
+
+  // full P = [4, 1; 1, 2]
+  const std::vector<c_float> P_data = {4.0, 1.0, 1.0, 2.0};
+  const std::vector<c_int> P_indices = {0, 1, 0, 1};
+  const std::vector<c_int> P_indptr = {0, 2, 4};
+  // A = [1, 1; 1, 0; 0, 1]
+  const std::vector<c_float> A_data = {1.0, 1.0, 1.0, 1.0};
+  const std::vector<c_int> A_indices = {0, 1, 0, 2};
+  const std::vector<c_int> A_indptr = {0, 2, 4};
+  const std::vector<c_float> lower_bounds = {1.0, 0.0, 0.0};
+  const std::vector<c_float> upper_bounds = {1.0, 0.7, 0.7};
+
+  EXPECT_TRUE(solver.Solve(P_data, P_indices, P_indptr, A_data, A_indices,
+                           A_indptr, {1.0, 1.0}, lower_bounds, upper_bounds));
+  EXPECT_EQ(OSQP_SOLVED, solver.status());
+  EXPECT_FALSE(solver.workspace_reused());
+  EXPECT_NEAR(0.3, solver.primal()[0], 1e-3);
+  EXPECT_NEAR(0.7, solver.primal()[1], 1e-3);
+
+  // same pattern, new values
+  EXPECT_TRUE(solver.Solve(P_data, P_indices, P_indptr, A_data, A_indices,
+                           A_indptr, {0.0, 3.0}, lower_bounds, upper_bounds));
+  EXPECT_EQ(OSQP_SOLVED, solver.status());
+  EXPECT_TRUE(solver.workspace_reused());
+  EXPECT_NEAR(0.7, solver.primal()[0], 1e-3);
+  EXPECT_NEAR(0.3, solver.primal()[1], 1e-3);
+
+  // a different dimension sets the workspace up again
+  EXPECT_TRUE(solver.Solve({2.0}, {0}, {0, 1}, {1.0}, {0}, {0, 1}, {-2.0},
+                           {0.0}, {0.5}));
+  EXPECT_EQ(OSQP_SOLVED, solver.status());
+  EXPECT_FALSE(solver.workspace_reused());
+  EXPECT_EQ(1, solver.num_var());
+  EXPECT_NEAR(0.5, solver.primal()[0], 1e-3);
+}
+
+TEST(OsqpSolverTest, MalformedProblem) {
+  OsqpSolver solver(TestSettings());
+  EXPECT_FALSE(solver.Solve({2.0}, {0}, {0, 1}, {1.0}, {0}, {0, 1}, {-2.0},
+                            {0.0}, {}));
+  EXPECT_EQ(nullptr, solver.primal());
+}
+
+}  // namespace planning
+}  // namespace apollo
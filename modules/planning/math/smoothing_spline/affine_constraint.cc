@@ -31,18 +31,31 @@ AffineConstraint::AffineConstraint(const bool is_equality)
 AffineConstraint::AffineConstraint(const Eigen::MatrixXd& constraint_matrix,
                                    const Eigen::MatrixXd& constraint_boundary,
                                    const bool is_equality)
-    : constraint_matrix_(constraint_matrix),
-      constraint_boundary_(constraint_boundary),
-      is_equality_(is_equality) {
+    : is_equality_(is_equality) {
   CHECK_EQ(constraint_boundary.rows(), constraint_matrix.rows());
+  AddConstraint(constraint_matrix, constraint_boundary);
 }
 
 void AffineConstraint::SetIsEquality(const double is_equality) {
   is_equality_ = is_equality;
 }
 
-const Eigen::MatrixXd& AffineConstraint::constraint_matrix() const {
-  return constraint_matrix_;
+Eigen::MatrixXd AffineConstraint::constraint_matrix() const {
+  Eigen::MatrixXd constraint_matrix =
+      Eigen::MatrixXd::Zero(num_rows_, num_cols_);
+  for (const auto& entry : constraint_entries_) {
+    constraint_matrix(entry.row(), entry.col()) = entry.value();
+  }
+  return constraint_matrix;
+}
+
+Eigen::SparseMatrix<double, Eigen::RowMajor>
+AffineConstraint::sparse_constraint_matrix() const {
+  Eigen::SparseMatrix<double, Eigen::RowMajor> constraint_matrix(num_rows_,
+                                                                 num_cols_);
+  constraint_matrix.setFromTriplets(constraint_entries_.begin(),
+                                    constraint_entries_.end());
+  return constraint_matrix;
 }
 
 const Eigen::MatrixXd& AffineConstraint::constraint_boundary() const {
@@ -52,42 +65,90 @@ const Eigen::MatrixXd& AffineConstraint::constraint_boundary() const {
 bool AffineConstraint::AddConstraint(
     const Eigen::MatrixXd& constraint_matrix,
     const Eigen::MatrixXd& constraint_boundary) {
-  if (constraint_matrix.rows() != constraint_boundary.rows()) {
+  const int rows = static_cast<int>(constraint_matrix.rows());
+  const int cols = static_cast<int>(constraint_matrix.cols());
+  if (!CheckConstraint(rows, cols, constraint_boundary)) {
+    return false;
+  }
+  for (int c = 0; c < cols; ++c) {
+    for (int r = 0; r < rows; ++r) {
+      if (constraint_matrix(r, c) != 0.0) {
+        constraint_entries_.emplace_back(num_rows_ + r, c,
+                                         constraint_matrix(r, c));
+      }
+    }
+  }
+  num_cols_ = cols;
+  AppendBoundary(constraint_boundary);
+  num_rows_ += rows;
+  return true;
+}
+
+bool AffineConstraint::AddConstraint(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
+  const int rows = static_cast<int>(constraint_matrix.rows());
+  const int cols = static_cast<int>(constraint_matrix.cols());
+  if (!CheckConstraint(rows, cols, constraint_boundary)) {
+    return false;
+  }
+  for (int r = 0; r < constraint_matrix.outerSize(); ++r) {
+    for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(
+             constraint_matrix, r);
+         it; ++it) {
+      if (it.value() != 0.0) {
+        constraint_entries_.emplace_back(num_rows_ + r,
+                                         static_cast<int>(it.col()),
+                                         it.value());
+      }
+    }
+  }
+  num_cols_ = cols;
+  AppendBoundary(constraint_boundary);
+  num_rows_ += rows;
+  return true;
+}
+
+bool AffineConstraint::CheckConstraint(
+    const int rows, const int cols,
+    const Eigen::MatrixXd& constraint_boundary) const {
+  if (rows != constraint_boundary.rows()) {
     AERROR << "Fail to add constraint because constraint matrix rows != "
               "constraint boundary rows.";
-    AERROR << "constraint matrix rows = " << constraint_matrix.rows();
+    AERROR << "constraint matrix rows = " << rows;
     AERROR << "constraint boundary rows = " << constraint_boundary.rows();
     return false;
   }
 
-  if (constraint_matrix_.rows() == 0) {
-    constraint_matrix_ = constraint_matrix;
-    constraint_boundary_ = constraint_boundary;
+  if (num_rows_ == 0) {
     return true;
   }
-  if (constraint_matrix_.cols() != constraint_matrix.cols()) {
+  if (num_cols_ != cols) {
     AERROR
         << "constraint_matrix_ cols and constraint_matrix cols do not match.";
-    AERROR << "constraint_matrix_.cols() = " << constraint_matrix_.cols();
-    AERROR << "constraint_matrix.cols() = " << constraint_matrix.cols();
+    AERROR << "constraint_matrix_.cols() = " << num_cols_;
+    AERROR << "constraint_matrix.cols() = " << cols;
     return false;
   }
   if (constraint_boundary.cols() != 1) {
     AERROR << "constraint_boundary.cols() should be 1.";
     return false;
   }
-
-  Eigen::MatrixXd n_matrix(constraint_matrix_.rows() + constraint_matrix.rows(),
-                           constraint_matrix_.cols());
-  Eigen::MatrixXd n_boundary(
-      constraint_boundary_.rows() + constraint_boundary.rows(), 1);
-
-  n_matrix << constraint_matrix_, constraint_matrix;
-  n_boundary << constraint_boundary_, constraint_boundary;
-  constraint_matrix_ = n_matrix;
-  constraint_boundary_ = n_boundary;
   return true;
 }
 
+void AffineConstraint::AppendBoundary(
+    const Eigen::MatrixXd& constraint_boundary) {
+  if (num_rows_ == 0) {
+    constraint_boundary_ = constraint_boundary;
+    return;
+  }
+  const auto rows = constraint_boundary_.rows();
+  constraint_boundary_.conservativeResize(rows + constraint_boundary.rows(),
+                                          1);
+  constraint_boundary_.bottomRows(constraint_boundary.rows()) =
+      constraint_boundary;
+}
+
 }  // namespace planning
 }  // namespace apollo
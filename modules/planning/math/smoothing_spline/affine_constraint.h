@@ -20,7 +20,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
 #include "modules/planning/math/polynomial_xd.h"
 
 namespace apollo {
@@ -36,13 +39,27 @@ class AffineConstraint {
 
   void SetIsEquality(const double is_equality);
 
-  const Eigen::MatrixXd& constraint_matrix() const;
+  // the constraints are stored by their nonzero entries; the dense matrix is
+  // assembled on each call and meant for the dense solvers
+  Eigen::MatrixXd constraint_matrix() const;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> sparse_constraint_matrix()
+      const;
   const Eigen::MatrixXd& constraint_boundary() const;
   bool AddConstraint(const Eigen::MatrixXd& constraint_matrix,
                      const Eigen::MatrixXd& constraint_boundary);
+  bool AddConstraint(
+      const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+      const Eigen::MatrixXd& constraint_boundary);
+
+ private:
+  bool CheckConstraint(const int rows, const int cols,
+                       const Eigen::MatrixXd& constraint_boundary) const;
+  void AppendBoundary(const Eigen::MatrixXd& constraint_boundary);
 
  private:
-  Eigen::MatrixXd constraint_matrix_;
+  std::vector<Eigen::Triplet<double>> constraint_entries_;
+  int num_rows_ = 0;
+  int num_cols_ = 0;
   Eigen::MatrixXd constraint_boundary_;
   bool is_equality_ = true;
 };
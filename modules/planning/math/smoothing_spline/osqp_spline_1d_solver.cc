@@ -30,55 +30,38 @@ namespace apollo {
 namespace planning {
 
 using Eigen::MatrixXd;
-using apollo::common::math::DenseToCSCMatrix;
+using apollo::common::math::SparseToCSCMatrix;
 
-OsqpSpline1dSolver::OsqpSpline1dSolver(const std::vector<double>& x_knots,
-                                       const uint32_t order)
-    : Spline1dSolver(x_knots, order) {
-  // Problem settings
-  settings_ = reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
+namespace {
 
+OSQPSettings Spline1dSettings() {
   // Define Solver settings as default
-  osqp_set_default_settings(settings_);
-  settings_->alpha = 1.0;  // Change alpha parameter
-  settings_->eps_abs = 1.0e-03;
-  settings_->eps_rel = 1.0e-03;
-  settings_->max_iter = 5000;
-  // settings_->polish = true;
-  settings_->verbose = FLAGS_enable_osqp_debug;
-  settings_->warm_start = true;
-
-  // Populate data
-  data_ = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.alpha = 1.0;  // Change alpha parameter
+  settings.eps_abs = 1.0e-03;
+  settings.eps_rel = 1.0e-03;
+  settings.max_iter = 5000;
+  // settings.polish = true;
+  settings.verbose = FLAGS_enable_osqp_debug;
+  settings.warm_start = true;
+  return settings;
 }
 
-OsqpSpline1dSolver::~OsqpSpline1dSolver() { CleanUp(); }
+}  // namespace
 
-void OsqpSpline1dSolver::CleanUp() {
-  osqp_cleanup(work_);
-  if (data_ != nullptr) {
-    c_free(data_->A);
-    c_free(data_->P);
-    c_free(data_);
-  }
-  if (settings_ != nullptr) {
-    c_free(settings_);
-  }
-}
+OsqpSpline1dSolver::OsqpSpline1dSolver(const std::vector<double>& x_knots,
+                                       const uint32_t order)
+    : Spline1dSolver(x_knots, order), osqp_solver_(Spline1dSettings()) {}
 
-void OsqpSpline1dSolver::ResetOsqp() {
-  // Problem settings
-  settings_ = reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  // Populate data
-  data_ = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-}
+void OsqpSpline1dSolver::CleanUp() { osqp_solver_.Reset(); }
 
 bool OsqpSpline1dSolver::Solve() {
   // Namings here are following osqp convention.
   // For details, visit: https://osqp.org/docs/examples/demo.html
 
   // change P to csc format
-  const MatrixXd& P = kernel_.kernel_matrix();
+  const Eigen::SparseMatrix<double>& P = kernel_.sparse_kernel_matrix();
   ADEBUG << "P: " << P.rows() << ", " << P.cols();
   if (P.rows() == 0) {
     return false;
@@ -87,17 +70,27 @@ bool OsqpSpline1dSolver::Solve() {
   std::vector<c_float> P_data;
   std::vector<c_int> P_indices;
   std::vector<c_int> P_indptr;
-  DenseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
-
-  // change A to csc format
-  const MatrixXd& inequality_constraint_matrix =
-      constraint_.inequality_constraint().constraint_matrix();
-  const MatrixXd& equality_constraint_matrix =
-      constraint_.equality_constraint().constraint_matrix();
-  MatrixXd A(
+  SparseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
+
+  // change A to csc format, stacking the rows of both constraints
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>
+      inequality_constraint_matrix =
+          constraint_.inequality_constraint().sparse_constraint_matrix();
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>
+      equality_constraint_matrix =
+          constraint_.equality_constraint().sparse_constraint_matrix();
+  Eigen::SparseMatrix<double, Eigen::RowMajor> stacked_constraint_matrix(
       inequality_constraint_matrix.rows() + equality_constraint_matrix.rows(),
-      inequality_constraint_matrix.cols());
-  A << inequality_constraint_matrix, equality_constraint_matrix;
+      P.cols());
+  if (inequality_constraint_matrix.rows() > 0) {
+    stacked_constraint_matrix.topRows(inequality_constraint_matrix.rows()) =
+        inequality_constraint_matrix;
+  }
+  if (equality_constraint_matrix.rows() > 0) {
+    stacked_constraint_matrix.bottomRows(equality_constraint_matrix.rows()) =
+        equality_constraint_matrix;
+  }
+  const Eigen::SparseMatrix<double> A = stacked_constraint_matrix;
   ADEBUG << "A: " << A.rows() << ", " << A.cols();
   if (A.rows() == 0) {
     return false;
@@ -106,14 +99,11 @@ bool OsqpSpline1dSolver::Solve() {
   std::vector<c_float> A_data;
   std::vector<c_int> A_indices;
   std::vector<c_int> A_indptr;
-  DenseToCSCMatrix(A, &A_data, &A_indices, &A_indptr);
+  SparseToCSCMatrix(A, &A_data, &A_indices, &A_indptr);
 
   // set q, l, u: l < A < u
   const MatrixXd& q_eigen = kernel_.offset();
-  c_float q[q_eigen.rows()];  // NOLINT
-  for (int i = 0; i < q_eigen.size(); ++i) {
-    q[i] = q_eigen(i);
-  }
+  std::vector<c_float> q(q_eigen.data(), q_eigen.data() + q_eigen.size());
 
   const MatrixXd& inequality_constraint_boundary =
       constraint_.inequality_constraint().constraint_boundary();
@@ -125,8 +115,8 @@ bool OsqpSpline1dSolver::Solve() {
 
   constexpr double kEpsilon = 1e-9;
   constexpr float kUpperLimit = 1e9;
-  c_float l[constraint_num];  // NOLINT
-  c_float u[constraint_num];  // NOLINT
+  std::vector<c_float> l(constraint_num);
+  std::vector<c_float> u(constraint_num);
   for (int i = 0; i < constraint_num; ++i) {
     if (i < inequality_constraint_boundary.rows()) {
       l[i] = inequality_constraint_boundary(i, 0);
@@ -139,24 +129,15 @@ bool OsqpSpline1dSolver::Solve() {
     }
   }
 
-  data_->n = P.rows();
-  data_->m = constraint_num;
-  data_->P = csc_matrix(data_->n, data_->n, P_data.size(), P_data.data(),
-                        P_indices.data(), P_indptr.data());
-  data_->q = q;
-  data_->A = csc_matrix(data_->m, data_->n, A_data.size(), A_data.data(),
-                        A_indices.data(), A_indptr.data());
-  data_->l = l;
-  data_->u = u;
-
-  work_ = osqp_setup(data_, settings_);
-
-  // Solve Problem
-  osqp_solve(work_);
+  // Solve Problem, reusing the workspace of the last cycle when possible
+  if (!osqp_solver_.Solve(P_data, P_indices, P_indptr, A_data, A_indices,
+                          A_indptr, q, l, u)) {
+    return false;
+  }
 
   MatrixXd solved_params = MatrixXd::Zero(P.rows(), 1);
   for (int i = 0; i < P.rows(); ++i) {
-    solved_params(i, 0) = work_->solution->x[i];
+    solved_params(i, 0) = osqp_solver_.primal()[i];
   }
 
   last_num_param_ = static_cast<int>(P.rows());
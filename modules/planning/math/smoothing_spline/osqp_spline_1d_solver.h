@@ -25,6 +25,7 @@
 #include "osqp/include/osqp.h"
 
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/osqp_solver.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_solver.h"
 
 namespace apollo {
@@ -33,18 +34,15 @@ namespace planning {
 class OsqpSpline1dSolver : public Spline1dSolver {
  public:
   OsqpSpline1dSolver(const std::vector<double>& x_knots, const uint32_t order);
-  virtual ~OsqpSpline1dSolver();
+  virtual ~OsqpSpline1dSolver() = default;
 
   bool Solve() override;
 
+  // releases the osqp workspace kept from the previous solve
   void CleanUp();
 
-  void ResetOsqp();
-
  private:
-  OSQPSettings* settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  OsqpSolver osqp_solver_;
 };
 
 }  // namespace planning
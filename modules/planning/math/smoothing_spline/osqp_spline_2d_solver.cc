@@ -31,14 +31,27 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kRoadBound = 1e10;
+
+OSQPSettings Spline2dSettings() {
+  // Define Solver settings as default
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.alpha = 1.0;  // Change alpha parameter
+  settings.eps_abs = 1.0e-05;
+  settings.eps_rel = 1.0e-05;
+  settings.max_iter = 5000;
+  settings.polish = true;
+  settings.verbose = FLAGS_enable_osqp_debug;
+  return settings;
 }
+}  // namespace
 
-using apollo::common::math::DenseToCSCMatrix;
+using apollo::common::math::SparseToCSCMatrix;
 using Eigen::MatrixXd;
 
 OsqpSpline2dSolver::OsqpSpline2dSolver(const std::vector<double>& t_knots,
                                        const uint32_t order)
-    : Spline2dSolver(t_knots, order) {}
+    : Spline2dSolver(t_knots, order), osqp_solver_(Spline2dSettings()) {}
 
 void OsqpSpline2dSolver::Reset(const std::vector<double>& t_knots,
                                const uint32_t order) {
@@ -61,7 +74,7 @@ bool OsqpSpline2dSolver::Solve() {
   // For details, visit: https://osqp.org/docs/examples/demo.html
 
   // change P to csc format
-  const MatrixXd& P = kernel_.kernel_matrix();
+  const Eigen::SparseMatrix<double>& P = kernel_.sparse_kernel_matrix();
   ADEBUG << "P: " << P.rows() << ", " << P.cols();
   if (P.rows() == 0) {
     return false;
@@ -70,17 +83,27 @@ bool OsqpSpline2dSolver::Solve() {
   std::vector<c_float> P_data;
   std::vector<c_int> P_indices;
   std::vector<c_int> P_indptr;
-  DenseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
-
-  // change A to csc format
-  const MatrixXd& inequality_constraint_matrix =
-      constraint_.inequality_constraint().constraint_matrix();
-  const MatrixXd& equality_constraint_matrix =
-      constraint_.equality_constraint().constraint_matrix();
-  MatrixXd A(
+  SparseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
+
+  // change A to csc format, stacking the rows of both constraints
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>
+      inequality_constraint_matrix =
+          constraint_.inequality_constraint().sparse_constraint_matrix();
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>
+      equality_constraint_matrix =
+          constraint_.equality_constraint().sparse_constraint_matrix();
+  Eigen::SparseMatrix<double, Eigen::RowMajor> stacked_constraint_matrix(
       inequality_constraint_matrix.rows() + equality_constraint_matrix.rows(),
-      inequality_constraint_matrix.cols());
-  A << inequality_constraint_matrix, equality_constraint_matrix;
+      P.cols());
+  if (inequality_constraint_matrix.rows() > 0) {
+    stacked_constraint_matrix.topRows(inequality_constraint_matrix.rows()) =
+        inequality_constraint_matrix;
+  }
+  if (equality_constraint_matrix.rows() > 0) {
+    stacked_constraint_matrix.bottomRows(equality_constraint_matrix.rows()) =
+        equality_constraint_matrix;
+  }
+  const Eigen::SparseMatrix<double> A = stacked_constraint_matrix;
   ADEBUG << "A: " << A.rows() << ", " << A.cols();
   if (A.rows() == 0) {
     return false;
@@ -89,14 +112,11 @@ bool OsqpSpline2dSolver::Solve() {
   std::vector<c_float> A_data;
   std::vector<c_int> A_indices;
   std::vector<c_int> A_indptr;
-  DenseToCSCMatrix(A, &A_data, &A_indices, &A_indptr);
+  SparseToCSCMatrix(A, &A_data, &A_indices, &A_indptr);
 
   // set q, l, u: l < A < u
   const MatrixXd& q_eigen = kernel_.offset();
-  c_float q[q_eigen.rows()];  // NOLINT
-  for (int i = 0; i < q_eigen.size(); ++i) {
-    q[i] = q_eigen(i);
-  }
+  std::vector<c_float> q(q_eigen.data(), q_eigen.data() + q_eigen.size());
 
   const MatrixXd& inequality_constraint_boundary =
       constraint_.inequality_constraint().constraint_boundary();
@@ -108,8 +128,8 @@ bool OsqpSpline2dSolver::Solve() {
 
   constexpr float kEpsilon = 1e-9f;
   constexpr float kUpperLimit = 1e9f;
-  c_float l[constraint_num];  // NOLINT
-  c_float u[constraint_num];  // NOLINT
+  std::vector<c_float> l(constraint_num);
+  std::vector<c_float> u(constraint_num);
   for (int i = 0; i < constraint_num; ++i) {
     if (i < inequality_constraint_boundary.rows()) {
       l[i] = inequality_constraint_boundary(i, 0);
@@ -121,52 +141,19 @@ bool OsqpSpline2dSolver::Solve() {
     }
   }
 
-  // Problem settings
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-
-  // Populate data
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  data->n = P.rows();
-  data->m = constraint_num;
-  data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
-                       P_indices.data(), P_indptr.data());
-  data->q = q;
-  data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
-                       A_indices.data(), A_indptr.data());
-  data->l = l;
-  data->u = u;
-
-  // Define Solver settings as default
-  osqp_set_default_settings(settings);
-  settings->alpha = 1.0;  // Change alpha parameter
-  settings->eps_abs = 1.0e-05;
-  settings->eps_rel = 1.0e-05;
-  settings->max_iter = 5000;
-  settings->polish = true;
-  settings->verbose = FLAGS_enable_osqp_debug;
-
-  // Setup workspace
-  OSQPWorkspace* work = osqp_setup(data, settings);
-
-  // Solve Problem
-  osqp_solve(work);
+  // Solve Problem, warm started from the last one when it has the same shape
+  if (!osqp_solver_.Solve(P_data, P_indices, P_indptr, A_data, A_indices,
+                          A_indptr, q, l, u)) {
+    return false;
+  }
+  ADEBUG << "OsqpSpline2dSolver reused workspace: "
+         << osqp_solver_.workspace_reused();
 
   MatrixXd solved_params = MatrixXd::Zero(P.rows(), 1);
   for (int i = 0; i < P.rows(); ++i) {
-    solved_params(i, 0) = work->solution->x[i];
+    solved_params(i, 0) = osqp_solver_.primal()[i];
   }
 
-  last_num_param_ = static_cast<int>(P.rows());
-  last_num_constraint_ = static_cast<int>(constraint_num);
-
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
-
   return spline_.set_splines(solved_params, spline_.spline_order());
 }
 
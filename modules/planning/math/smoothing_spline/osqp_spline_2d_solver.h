@@ -25,6 +25,7 @@
 #include "gtest/gtest_prod.h"
 #include "osqp/include/osqp.h"
 
+#include "modules/planning/math/osqp_solver.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
 
@@ -52,13 +53,9 @@ class OsqpSpline2dSolver final : public Spline2dSolver {
   FRIEND_TEST(OSQPSolverTest, basic_test);
 
  private:
-  OSQPSettings* osqp_settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
-
-  int last_num_constraint_ = 0;
-  int last_num_param_ = 0;
-  bool last_problem_success_ = false;
+  // kept between solves, as the reference line smoother solves a problem of
+  // the same shape every time it extends the reference line
+  OsqpSolver osqp_solver_;
 };
 
 }  // namespace planning
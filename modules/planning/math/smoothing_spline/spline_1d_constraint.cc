@@ -57,6 +57,20 @@ bool Spline1dConstraint::AddEqualityConstraint(
                                             constraint_boundary);
 }
 
+bool Spline1dConstraint::AddInequalityConstraint(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
+  return inequality_constraint_.AddConstraint(constraint_matrix,
+                                              constraint_boundary);
+}
+
+bool Spline1dConstraint::AddEqualityConstraint(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
+  return equality_constraint_.AddConstraint(constraint_matrix,
+                                            constraint_boundary);
+}
+
 bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
                                      const std::vector<double>& lower_bound,
                                      const std::vector<double>& upper_bound) {
@@ -76,9 +90,11 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
   }
   // emplace affine constraints
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * num_params);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -88,7 +104,7 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      inequality_constraint(i, j + index * num_params) = coef;
+      inequality_constraint.coeffRef(i, j + index * num_params) = coef;
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -99,8 +115,8 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * num_params) = coef;
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * num_params) = coef;
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -131,9 +147,11 @@ bool Spline1dConstraint::AddDerivativeBoundary(
 
   // emplace affine constraints
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * num_params);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -142,7 +160,7 @@ bool Spline1dConstraint::AddDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 1; j < num_params; ++j) {
-      inequality_constraint(i, j + index * num_params) = coef * j;
+      inequality_constraint.coeffRef(i, j + index * num_params) = coef * j;
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -153,8 +171,8 @@ bool Spline1dConstraint::AddDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 1; j < num_params; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * num_params) = coef * j;
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * num_params) = coef * j;
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -184,9 +202,11 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
 
   // emplace affine constraints
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * num_params);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -195,7 +215,8 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 2; j < num_params; ++j) {
-      inequality_constraint(i, j + index * num_params) = coef * j * (j - 1);
+      inequality_constraint.coeffRef(i, j + index * num_params) =
+          coef * j * (j - 1);
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -206,8 +227,9 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 2; j < num_params; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * num_params) = coef * j * (j - 1);
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * num_params) =
+          coef * j * (j - 1);
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -239,9 +261,11 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
 
   // emplace affine constraints
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * num_params);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -250,7 +274,7 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 3; j < num_params; ++j) {
-      inequality_constraint(i, j + index * num_params) =
+      inequality_constraint.coeffRef(i, j + index * num_params) =
           coef * j * (j - 1) * (j - 2);
       coef *= corrected_x;
     }
@@ -262,8 +286,8 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 3; j < num_params; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * num_params) =
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * num_params) =
           coef * j * (j - 1) * (j - 2);
       coef *= corrected_x;
     }
@@ -279,11 +303,13 @@ bool Spline1dConstraint::AddPointConstraint(const double x, const double fx) {
   std::vector<double> power_x;
   const uint32_t num_params = spline_order_ + 1;
   GeneratePowerX(x - x_knots_[index], num_params, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      1, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   uint32_t index_offset = index * num_params;
   for (uint32_t i = 0; i < num_params; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i];
+    equality_constraint.coeffRef(0, index_offset + i) = power_x[i];
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = fx;
@@ -320,11 +346,13 @@ bool Spline1dConstraint::AddPointDerivativeConstraint(const double x,
   std::vector<double> power_x;
   const uint32_t num_params = spline_order_ + 1;
   GeneratePowerX(x - x_knots_[index], num_params, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      1, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   uint32_t index_offset = index * num_params;
   for (uint32_t i = 1; i < num_params; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i - 1] * i;
+    equality_constraint.coeffRef(0, index_offset + i) = power_x[i - 1] * i;
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = dfx;
@@ -344,11 +372,14 @@ bool Spline1dConstraint::AddPointSecondDerivativeConstraint(const double x,
   std::vector<double> power_x;
   const uint32_t num_params = spline_order_ + 1;
   GeneratePowerX(x - x_knots_[index], num_params, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      1, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   uint32_t index_offset = index * num_params;
   for (uint32_t i = 2; i < num_params; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i - 2] * i * (i - 1);
+    equality_constraint.coeffRef(0, index_offset + i) =
+        power_x[i - 2] * i * (i - 1);
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = ddfx;
@@ -369,11 +400,13 @@ bool Spline1dConstraint::AddPointThirdDerivativeConstraint(const double x,
   std::vector<double> power_x;
   const uint32_t num_params = spline_order_ + 1;
   GeneratePowerX(x - x_knots_[index], num_params, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      1, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   uint32_t index_offset = index * num_params;
   for (uint32_t i = 3; i < num_params; ++i) {
-    equality_constraint(0, index_offset + i) =
+    equality_constraint.coeffRef(0, index_offset + i) =
         power_x[i - 3] * i * (i - 1) * (i - 2);
   }
   Eigen::MatrixXd equality_boundary(1, 1);
@@ -394,8 +427,10 @@ bool Spline1dConstraint::AddSmoothConstraint() {
     return false;
   }
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd equality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
       x_knots_.size() - 2, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd equality_boundary =
       Eigen::MatrixXd::Zero(x_knots_.size() - 2, 1);
 
@@ -405,8 +440,8 @@ bool Spline1dConstraint::AddSmoothConstraint() {
     const double x_left = x_knots_[i + 1] - x_knots_[i];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      equality_constraint(i, num_params * i + j) = left_coef;
-      equality_constraint(i, num_params * (i + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, num_params * i + j) = left_coef;
+      equality_constraint.coeffRef(i, num_params * (i + 1) + j) = right_coef;
       left_coef *= x_left;
       right_coef *= x_right;
     }
@@ -423,8 +458,10 @@ bool Spline1dConstraint::AddDerivativeSmoothConstraint() {
   const uint32_t n_constraint =
       (static_cast<uint32_t>(x_knots_.size()) - 2) * 2;
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(n_constraint, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      n_constraint, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 2) {
@@ -435,11 +472,13 @@ bool Spline1dConstraint::AddDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 2 + 1] - x_knots_[i / 2];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      equality_constraint(i, num_params * (i / 2) + j) = left_coef;
-      equality_constraint(i, num_params * ((i / 2) + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, num_params * (i / 2) + j) = left_coef;
+      equality_constraint.coeffRef(i, num_params * ((i / 2) + 1) + j) =
+          right_coef;
       if (j >= 1) {
-        equality_constraint(i + 1, num_params * (i / 2) + j) = left_dcoef * j;
-        equality_constraint(i + 1, num_params * ((i / 2) + 1) + j) =
+        equality_constraint.coeffRef(i + 1, num_params * (i / 2) + j) =
+            left_dcoef * j;
+        equality_constraint.coeffRef(i + 1, num_params * ((i / 2) + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -460,8 +499,10 @@ bool Spline1dConstraint::AddSecondDerivativeSmoothConstraint() {
   const uint32_t n_constraint =
       (static_cast<uint32_t>(x_knots_.size()) - 2) * 3;
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(n_constraint, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      n_constraint, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 3) {
@@ -475,21 +516,23 @@ bool Spline1dConstraint::AddSecondDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 3 + 1] - x_knots_[i / 3];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      equality_constraint(i, num_params * (i / 3) + j) = left_coef;
-      equality_constraint(i, num_params * (i / 3 + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, num_params * (i / 3) + j) = left_coef;
+      equality_constraint.coeffRef(i, num_params * (i / 3 + 1) + j) =
+          right_coef;
 
       if (j >= 2) {
-        equality_constraint(i + 2, num_params * i / 3 + j) =
+        equality_constraint.coeffRef(i + 2, num_params * i / 3 + j) =
             left_ddcoef * j * (j - 1);
-        equality_constraint(i + 2, num_params * (i / 3 + 1) + j) =
+        equality_constraint.coeffRef(i + 2, num_params * (i / 3 + 1) + j) =
             right_ddcoef * j * (j - 1);
         left_ddcoef = left_dcoef;
         right_ddcoef = right_dcoef;
       }
 
       if (j >= 1) {
-        equality_constraint(i + 1, num_params * (i / 3) + j) = left_dcoef * j;
-        equality_constraint(i + 1, num_params * (i / 3 + 1) + j) =
+        equality_constraint.coeffRef(i + 1, num_params * (i / 3) + j) =
+            left_dcoef * j;
+        equality_constraint.coeffRef(i + 1, num_params * (i / 3 + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -510,8 +553,10 @@ bool Spline1dConstraint::AddThirdDerivativeSmoothConstraint() {
   const uint32_t n_constraint =
       (static_cast<uint32_t>(x_knots_.size()) - 2) * 4;
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(n_constraint, (x_knots_.size() - 1) * num_params);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> equality_constraint(
+      n_constraint, (x_knots_.size() - 1) * num_params);
+  equality_constraint.reserve(
+      Eigen::VectorXi::Constant(equality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 4) {
@@ -527,30 +572,32 @@ bool Spline1dConstraint::AddThirdDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 4 + 1] - x_knots_[i / 4];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < num_params; ++j) {
-      equality_constraint(i, num_params * i / 4 + j) = left_coef;
-      equality_constraint(i, num_params * (i / 4 + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, num_params * i / 4 + j) = left_coef;
+      equality_constraint.coeffRef(i, num_params * (i / 4 + 1) + j) =
+          right_coef;
 
       if (j >= 3) {
-        equality_constraint(i + 3, num_params * i / 4 + j) =
+        equality_constraint.coeffRef(i + 3, num_params * i / 4 + j) =
             left_dddcoef * j * (j - 1) * (j - 2);
-        equality_constraint(i + 3, num_params * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 3, num_params * (i / 4 + 1) + j) =
             right_dddcoef * j * (j - 1) * (j - 2);
         left_dddcoef = left_ddcoef;
         right_dddcoef = right_ddcoef;
       }
 
       if (j >= 2) {
-        equality_constraint(i + 2, num_params * i / 4 + j) =
+        equality_constraint.coeffRef(i + 2, num_params * i / 4 + j) =
             left_ddcoef * j * (j - 1);
-        equality_constraint(i + 2, num_params * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 2, num_params * (i / 4 + 1) + j) =
             right_ddcoef * j * (j - 1);
         left_ddcoef = left_dcoef;
         right_ddcoef = right_dcoef;
       }
 
       if (j >= 1) {
-        equality_constraint(i + 1, num_params * i / 4 + j) = left_dcoef * j;
-        equality_constraint(i + 1, num_params * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 1, num_params * i / 4 + j) =
+            left_dcoef * j;
+        equality_constraint.coeffRef(i + 1, num_params * (i / 4 + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -572,8 +619,10 @@ bool Spline1dConstraint::AddMonotoneInequalityConstraint(
   }
 
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  Eigen::SparseMatrix<double, Eigen::RowMajor> inequality_constraint(
       x_coord.size() - 1, (x_knots_.size() - 1) * num_params);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), 2 * num_params));
   Eigen::MatrixXd inequality_boundary =
       Eigen::MatrixXd::Zero(x_coord.size() - 1, 1);
 
@@ -590,15 +639,18 @@ bool Spline1dConstraint::AddMonotoneInequalityConstraint(
     // if constraint on the same spline
     if (cur_spline_index == prev_spline_index) {
       for (uint32_t j = 0; j < cur_coef.size(); ++j) {
-        inequality_constraint(i - 1, cur_spline_index * num_params + j) =
+        inequality_constraint.coeffRef(i - 1,
+                                       cur_spline_index * num_params + j) =
             cur_coef[j] - prev_coef[j];
       }
     } else {
       // if not on the same spline
       for (uint32_t j = 0; j < cur_coef.size(); ++j) {
-        inequality_constraint(i - 1, prev_spline_index * num_params + j) =
+        inequality_constraint.coeffRef(i - 1,
+                                       prev_spline_index * num_params + j) =
             -prev_coef[j];
-        inequality_constraint(i - 1, cur_spline_index * num_params + j) =
+        inequality_constraint.coeffRef(i - 1,
+                                       cur_spline_index * num_params + j) =
             cur_coef[j];
       }
     }
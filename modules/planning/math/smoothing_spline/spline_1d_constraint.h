@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
 
 #include "modules/planning/math/smoothing_spline/affine_constraint.h"
 #include "modules/planning/math/smoothing_spline/spline_1d.h"
@@ -43,6 +44,12 @@ class Spline1dConstraint {
                                const Eigen::MatrixXd& constraint_boundary);
   bool AddEqualityConstraint(const Eigen::MatrixXd& constraint_matrix,
                              const Eigen::MatrixXd& constraint_boundary);
+  bool AddInequalityConstraint(
+      const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+      const Eigen::MatrixXd& constraint_boundary);
+  bool AddEqualityConstraint(
+      const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+      const Eigen::MatrixXd& constraint_boundary);
 
   // preset method
   /**
@@ -40,14 +40,16 @@ Spline1dKernel::Spline1dKernel(const std::vector<double>& x_knots,
       (static_cast<uint32_t>(x_knots.size()) > 1
            ? (static_cast<uint32_t>(x_knots.size()) - 1) * (1 + spline_order_)
            : 0);
-  kernel_matrix_ = Eigen::MatrixXd::Zero(total_params_, total_params_);
+  kernel_matrix_.resize(total_params_, total_params_);
+  kernel_matrix_.reserve(
+      Eigen::VectorXi::Constant(total_params_, spline_order_ + 1));
   offset_ = Eigen::MatrixXd::Zero(total_params_, 1);
 }
 
 void Spline1dKernel::AddRegularization(const double regularized_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += 2.0 * id_matrix * regularized_param;
+  for (uint32_t i = 0; i < total_params_; ++i) {
+    kernel_matrix_.coeffRef(i, i) += 2.0 * regularized_param;
+  }
 }
 
 bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
@@ -58,7 +60,13 @@ bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
       offset.rows() != offset_.rows()) {
     return false;
   }
-  kernel_matrix_ += kernel * weight;
+  for (int c = 0; c < kernel.cols(); ++c) {
+    for (int r = 0; r < kernel.rows(); ++r) {
+      if (kernel(r, c) != 0.0) {
+        kernel_matrix_.coeffRef(r, c) += kernel(r, c) * weight;
+      }
+    }
+  }
   offset_ += offset * weight;
   return true;
 }
@@ -69,13 +77,18 @@ bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
   return AddKernel(kernel, offset, weight);
 }
 
-Eigen::MatrixXd* Spline1dKernel::mutable_kernel_matrix() {
+Eigen::SparseMatrix<double>* Spline1dKernel::mutable_kernel_matrix() {
   return &kernel_matrix_;
 }
 
 Eigen::MatrixXd* Spline1dKernel::mutable_offset() { return &offset_; }
 
-const Eigen::MatrixXd& Spline1dKernel::kernel_matrix() const {
+Eigen::MatrixXd Spline1dKernel::kernel_matrix() const {
+  return Eigen::MatrixXd(kernel_matrix_);
+}
+
+const Eigen::SparseMatrix<double>& Spline1dKernel::sparse_kernel_matrix()
+    const {
   return kernel_matrix_;
 }
 
@@ -91,8 +104,7 @@ void Spline1dKernel::AddNthDerivativekernelMatrix(const uint32_t n,
         SplineSegKernel::Instance()->NthDerivativeKernel(
             n, num_params, x_knots_[i + 1] - x_knots_[i]) *
         weight;
-    kernel_matrix_.block(i * num_params, i * num_params, num_params,
-                         num_params) += cur_kernel;
+    AddBlock(i * num_params, cur_kernel);
   }
 }
 
@@ -122,8 +134,7 @@ void Spline1dKernel::AddNthDerivativekernelMatrixForSplineK(
       SplineSegKernel::Instance()->NthDerivativeKernel(
           n, num_params, x_knots_[k + 1] - x_knots_[k]) *
       weight;
-  kernel_matrix_.block(k * num_params, k * num_params, num_params,
-                       num_params) += cur_kernel;
+  AddBlock(k * num_params, cur_kernel);
 }
 
 void Spline1dKernel::AddDerivativeKernelMatrixForSplineK(const uint32_t k,
@@ -174,12 +185,20 @@ bool Spline1dKernel::AddReferenceLineKernelMatrix(
       }
     }
 
-    kernel_matrix_.block(cur_index * num_params, cur_index * num_params,
-                         num_params, num_params) += weight * ref_kernel;
+    AddBlock(cur_index * num_params, weight * ref_kernel);
   }
   return true;
 }
 
+void Spline1dKernel::AddBlock(const uint32_t start,
+                              const Eigen::MatrixXd& block) {
+  for (int c = 0; c < block.cols(); ++c) {
+    for (int r = 0; r < block.rows(); ++r) {
+      kernel_matrix_.coeffRef(start + r, start + c) += block(r, c);
+    }
+  }
+}
+
 uint32_t Spline1dKernel::FindIndex(const double x) const {
   auto upper_bound = std::upper_bound(x_knots_.begin() + 1, x_knots_.end(), x);
   return std::min(static_cast<uint32_t>(x_knots_.size() - 1),
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
 
 #include "modules/planning/math/smoothing_spline/spline_1d.h"
 
@@ -43,10 +44,13 @@ class Spline1dKernel {
                  const double weight);
   bool AddKernel(const Eigen::MatrixXd& kernel, const double weight);
 
-  Eigen::MatrixXd* mutable_kernel_matrix();
+  Eigen::SparseMatrix<double>* mutable_kernel_matrix();
   Eigen::MatrixXd* mutable_offset();
 
-  const Eigen::MatrixXd& kernel_matrix() const;
+  // the kernel is block diagonal and stored sparse; the dense matrix is
+  // assembled on each call and meant for the dense solvers
+  Eigen::MatrixXd kernel_matrix() const;
+  const Eigen::SparseMatrix<double>& sparse_kernel_matrix() const;
   const Eigen::MatrixXd& offset() const;
 
   // build-in kernel methods
@@ -75,10 +79,11 @@ class Spline1dKernel {
   void AddNthDerivativekernelMatrixForSplineK(const uint32_t n,
                                               const uint32_t k,
                                               const double weight);
+  void AddBlock(const uint32_t start, const Eigen::MatrixXd& block);
   uint32_t FindIndex(const double x) const;
 
  private:
-  Eigen::MatrixXd kernel_matrix_;
+  Eigen::SparseMatrix<double> kernel_matrix_;
   Eigen::MatrixXd offset_;
   std::vector<double> x_knots_;
   uint32_t spline_order_;
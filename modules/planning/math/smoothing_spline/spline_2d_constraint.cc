@@ -55,6 +55,20 @@ bool Spline2dConstraint::AddEqualityConstraint(
                                             constraint_boundary);
 }
 
+bool Spline2dConstraint::AddInequalityConstraint(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
+  return inequality_constraint_.AddConstraint(constraint_matrix,
+                                              constraint_boundary);
+}
+
+bool Spline2dConstraint::AddEqualityConstraint(
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
+  return equality_constraint_.AddConstraint(constraint_matrix,
+                                            constraint_boundary);
+}
+
 // preset method
 /**
  *   @brief: inequality boundary constraints
@@ -70,8 +84,10 @@ bool Spline2dConstraint::Add2dBoundary(
       lateral_bound.size() != longitudinal_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(
+      affine_inequality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -86,13 +102,15 @@ bool Spline2dConstraint::Add2dBoundary(
         AffineCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * (spline_order_ + 1); ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper longitudinal
-      affine_inequality(4 * i + 2, index_offset + j) = longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) =
+          longitudinal_coef[j];
       // lower longitudinal
-      affine_inequality(4 * i + 3, index_offset + j) = -longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -longitudinal_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_lateral - lateral_bound[i];
@@ -113,8 +131,10 @@ bool Spline2dConstraint::Add2dDerivativeBoundary(
       lateral_bound.size() != longitudinal_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(
+      affine_inequality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -129,13 +149,15 @@ bool Spline2dConstraint::Add2dDerivativeBoundary(
         AffineDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * (spline_order_ + 1); ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper longitudinal
-      affine_inequality(4 * i + 2, index_offset + j) = longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) =
+          longitudinal_coef[j];
       // lower longitudinal
-      affine_inequality(4 * i + 3, index_offset + j) = -longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -longitudinal_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_lateral - lateral_bound[i];
@@ -156,8 +178,10 @@ bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
       lateral_bound.size() != longitudinal_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(
+      affine_inequality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -173,13 +197,15 @@ bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
         AffineSecondDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * (spline_order_ + 1); ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper longitudinal
-      affine_inequality(4 * i + 2, index_offset + j) = longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) =
+          longitudinal_coef[j];
       // lower longitudinal
-      affine_inequality(4 * i + 3, index_offset + j) = -longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -longitudinal_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_lateral - lateral_bound[i];
@@ -200,8 +226,10 @@ bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
       lateral_bound.size() != longitudinal_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(
+      affine_inequality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -216,13 +244,15 @@ bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
         AffineThirdDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * (spline_order_ + 1); ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper longitudinal
-      affine_inequality(4 * i + 2, index_offset + j) = longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) =
+          longitudinal_coef[j];
       // lower longitudinal
-      affine_inequality(4 * i + 3, index_offset + j) = -longitudinal_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -longitudinal_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_lateral - lateral_bound[i];
@@ -263,14 +293,16 @@ bool Spline2dConstraint::AddPointKthOrderDerivativeConstraint(
     const double t, const double x_kth_derivative,
     const double y_kth_derivative, const std::vector<double>& coef) {
   const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd affine_equality = Eigen::MatrixXd::Zero(2, total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(2, total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary = Eigen::MatrixXd::Zero(2, 1);
   affine_boundary << x_kth_derivative, y_kth_derivative;
   const size_t index = FindIndex(t);
   const size_t index_offset = index * 2 * num_params;
   for (size_t i = 0; i < num_params; ++i) {
-    affine_equality(0, i + index_offset) = coef[i];
-    affine_equality(1, i + num_params + index_offset) = coef[i];
+    affine_equality.coeffRef(0, i + index_offset) = coef[i];
+    affine_equality.coeffRef(1, i + num_params + index_offset) = coef[i];
   }
   return AddEqualityConstraint(affine_equality, affine_boundary);
 }
@@ -283,15 +315,20 @@ bool Spline2dConstraint::AddPointAngleConstraint(const double t,
   const double rel_t = t - t_knots_[index];
 
   // add equality constraint
-  Eigen::MatrixXd affine_equality = Eigen::MatrixXd::Zero(1, total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(1, total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary = Eigen::MatrixXd::Zero(1, 1);
   std::vector<double> line_derivative_coef = AffineDerivativeCoef(angle, rel_t);
   for (uint32_t i = 0; i < line_derivative_coef.size(); ++i) {
-    affine_equality(0, i + index_offset) = line_derivative_coef[i];
+    affine_equality.coeffRef(0, i + index_offset) = line_derivative_coef[i];
   }
 
   // add inequality constraint
-  Eigen::MatrixXd affine_inequality = Eigen::MatrixXd::Zero(2, total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_inequality(
+      2, total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(
+      affine_inequality.rows(), 2 * (spline_order_ + 1)));
   const Eigen::MatrixXd affine_inequality_boundary =
       Eigen::MatrixXd::Zero(2, 1);
   std::vector<double> t_coef = DerivativeCoef(rel_t);
@@ -311,8 +348,9 @@ bool Spline2dConstraint::AddPointAngleConstraint(const double t,
   }
 
   for (uint32_t i = 0; i < t_coef.size(); ++i) {
-    affine_inequality(0, i + index_offset) = t_coef[i] * x_sign;
-    affine_inequality(1, i + index_offset + num_params) = t_coef[i] * y_sign;
+    affine_inequality.coeffRef(0, i + index_offset) = t_coef[i] * x_sign;
+    affine_inequality.coeffRef(1, i + index_offset + num_params) =
+        t_coef[i] * y_sign;
   }
   if (!AddEqualityConstraint(affine_equality, affine_boundary)) {
     return false;
@@ -325,8 +363,10 @@ bool Spline2dConstraint::AddSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(2 * (t_knots_.size() - 2), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(
+      2 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(2 * (t_knots_.size() - 2), 1);
   for (uint32_t i = 0; i + 2 < t_knots_.size(); ++i) {
@@ -336,11 +376,12 @@ bool Spline2dConstraint::AddSmoothConstraint() {
     std::vector<double> power_t = PolyCoef(rel_t);
 
     for (uint32_t j = 0; j < num_params; ++j) {
-      affine_equality(2 * i, j + index_offset) = power_t[j];
-      affine_equality(2 * i + 1, j + index_offset + num_params) = power_t[j];
+      affine_equality.coeffRef(2 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(2 * i + 1, j + index_offset + num_params) =
+          power_t[j];
     }
-    affine_equality(2 * i, index_offset + 2 * num_params) = -1.0;
-    affine_equality(2 * i + 1, index_offset + 3 * num_params) = -1.0;
+    affine_equality.coeffRef(2 * i, index_offset + 2 * num_params) = -1.0;
+    affine_equality.coeffRef(2 * i + 1, index_offset + 3 * num_params) = -1.0;
   }
   return AddEqualityConstraint(affine_equality, affine_boundary);
 }
@@ -350,8 +391,10 @@ bool Spline2dConstraint::AddDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return true;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(4 * (t_knots_.size() - 2), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(
+      4 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * (t_knots_.size() - 2), 1);
 
@@ -362,16 +405,19 @@ bool Spline2dConstraint::AddDerivativeSmoothConstraint() {
     std::vector<double> power_t = PolyCoef(rel_t);
     std::vector<double> derivative_t = DerivativeCoef(rel_t);
     for (uint32_t j = 0; j < num_params; ++j) {
-      affine_equality(4 * i, j + index_offset) = power_t[j];
-      affine_equality(4 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(4 * i + 2, j + index_offset + num_params) = power_t[j];
-      affine_equality(4 * i + 3, j + index_offset + num_params) =
+      affine_equality.coeffRef(4 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(4 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(4 * i + 2, j + index_offset + num_params) =
+          power_t[j];
+      affine_equality.coeffRef(4 * i + 3, j + index_offset + num_params) =
           derivative_t[j];
     }
-    affine_equality(4 * i, index_offset + 2 * num_params) = -1.0;
-    affine_equality(4 * i + 1, index_offset + 2 * num_params + 1) = -1.0;
-    affine_equality(4 * i + 2, index_offset + 3 * num_params) = -1.0;
-    affine_equality(4 * i + 3, index_offset + 3 * num_params + 1) = -1.0;
+    affine_equality.coeffRef(4 * i, index_offset + 2 * num_params) = -1.0;
+    affine_equality.coeffRef(4 * i + 1, index_offset + 2 * num_params + 1) =
+        -1.0;
+    affine_equality.coeffRef(4 * i + 2, index_offset + 3 * num_params) = -1.0;
+    affine_equality.coeffRef(4 * i + 3, index_offset + 3 * num_params + 1) =
+        -1.0;
   }
   return AddEqualityConstraint(affine_equality, affine_boundary);
 }
@@ -381,8 +427,10 @@ bool Spline2dConstraint::AddSecondDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return true;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(6 * (t_knots_.size() - 2), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(
+      6 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(6 * (t_knots_.size() - 2), 1);
 
@@ -394,21 +442,27 @@ bool Spline2dConstraint::AddSecondDerivativeSmoothConstraint() {
     std::vector<double> derivative_t = DerivativeCoef(rel_t);
     std::vector<double> second_derivative_t = SecondDerivativeCoef(rel_t);
     for (uint32_t j = 0; j < num_params; ++j) {
-      affine_equality(6 * i, j + index_offset) = power_t[j];
-      affine_equality(6 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(6 * i + 2, j + index_offset) = second_derivative_t[j];
-      affine_equality(6 * i + 3, j + index_offset + num_params) = power_t[j];
-      affine_equality(6 * i + 4, j + index_offset + num_params) =
+      affine_equality.coeffRef(6 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(6 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(6 * i + 2, j + index_offset) =
+          second_derivative_t[j];
+      affine_equality.coeffRef(6 * i + 3, j + index_offset + num_params) =
+          power_t[j];
+      affine_equality.coeffRef(6 * i + 4, j + index_offset + num_params) =
           derivative_t[j];
-      affine_equality(6 * i + 5, j + index_offset + num_params) =
+      affine_equality.coeffRef(6 * i + 5, j + index_offset + num_params) =
           second_derivative_t[j];
     }
-    affine_equality(6 * i, index_offset + 2 * num_params) = -1.0;
-    affine_equality(6 * i + 1, index_offset + 2 * num_params + 1) = -1.0;
-    affine_equality(6 * i + 2, index_offset + 2 * num_params + 2) = -2.0;
-    affine_equality(6 * i + 3, index_offset + 3 * num_params) = -1.0;
-    affine_equality(6 * i + 4, index_offset + 3 * num_params + 1) = -1.0;
-    affine_equality(6 * i + 5, index_offset + 3 * num_params + 2) = -2.0;
+    affine_equality.coeffRef(6 * i, index_offset + 2 * num_params) = -1.0;
+    affine_equality.coeffRef(6 * i + 1, index_offset + 2 * num_params + 1) =
+        -1.0;
+    affine_equality.coeffRef(6 * i + 2, index_offset + 2 * num_params + 2) =
+        -2.0;
+    affine_equality.coeffRef(6 * i + 3, index_offset + 3 * num_params) = -1.0;
+    affine_equality.coeffRef(6 * i + 4, index_offset + 3 * num_params + 1) =
+        -1.0;
+    affine_equality.coeffRef(6 * i + 5, index_offset + 3 * num_params + 2) =
+        -2.0;
   }
   return AddEqualityConstraint(affine_equality, affine_boundary);
 }
@@ -418,8 +472,10 @@ bool Spline2dConstraint::AddThirdDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(8 * (t_knots_.size() - 2), total_param_);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> affine_equality(
+      8 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(
+      affine_equality.rows(), 2 * (spline_order_ + 1)));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(8 * (t_knots_.size() - 2), 1);
 
@@ -432,26 +488,35 @@ bool Spline2dConstraint::AddThirdDerivativeSmoothConstraint() {
     std::vector<double> second_derivative_t = SecondDerivativeCoef(rel_t);
     std::vector<double> third_derivative_t = ThirdDerivativeCoef(rel_t);
     for (uint32_t j = 0; j < num_params; ++j) {
-      affine_equality(8 * i, j + index_offset) = power_t[j];
-      affine_equality(8 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(8 * i + 2, j + index_offset) = second_derivative_t[j];
-      affine_equality(8 * i + 3, j + index_offset) = third_derivative_t[j];
-      affine_equality(8 * i + 4, j + index_offset + num_params) = power_t[j];
-      affine_equality(8 * i + 5, j + index_offset + num_params) =
+      affine_equality.coeffRef(8 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(8 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(8 * i + 2, j + index_offset) =
+          second_derivative_t[j];
+      affine_equality.coeffRef(8 * i + 3, j + index_offset) =
+          third_derivative_t[j];
+      affine_equality.coeffRef(8 * i + 4, j + index_offset + num_params) =
+          power_t[j];
+      affine_equality.coeffRef(8 * i + 5, j + index_offset + num_params) =
           derivative_t[j];
-      affine_equality(8 * i + 6, j + index_offset + num_params) =
+      affine_equality.coeffRef(8 * i + 6, j + index_offset + num_params) =
           second_derivative_t[j];
-      affine_equality(8 * i + 7, j + index_offset + num_params) =
+      affine_equality.coeffRef(8 * i + 7, j + index_offset + num_params) =
           third_derivative_t[j];
     }
-    affine_equality(8 * i, index_offset + 2 * num_params) = -1.0;
-    affine_equality(8 * i + 1, index_offset + 2 * num_params + 1) = -1.0;
-    affine_equality(8 * i + 2, index_offset + 2 * num_params + 2) = -2.0;
-    affine_equality(8 * i + 3, index_offset + 2 * num_params + 3) = -6.0;
-    affine_equality(8 * i + 4, index_offset + 3 * num_params) = -1.0;
-    affine_equality(8 * i + 5, index_offset + 3 * num_params + 1) = -1.0;
-    affine_equality(8 * i + 6, index_offset + 3 * num_params + 2) = -2.0;
-    affine_equality(8 * i + 7, index_offset + 3 * num_params + 3) = -6.0;
+    affine_equality.coeffRef(8 * i, index_offset + 2 * num_params) = -1.0;
+    affine_equality.coeffRef(8 * i + 1, index_offset + 2 * num_params + 1) =
+        -1.0;
+    affine_equality.coeffRef(8 * i + 2, index_offset + 2 * num_params + 2) =
+        -2.0;
+    affine_equality.coeffRef(8 * i + 3, index_offset + 2 * num_params + 3) =
+        -6.0;
+    affine_equality.coeffRef(8 * i + 4, index_offset + 3 * num_params) = -1.0;
+    affine_equality.coeffRef(8 * i + 5, index_offset + 3 * num_params + 1) =
+        -1.0;
+    affine_equality.coeffRef(8 * i + 6, index_offset + 3 * num_params + 2) =
+        -2.0;
+    affine_equality.coeffRef(8 * i + 7, index_offset + 3 * num_params + 3) =
+        -6.0;
   }
   return AddEqualityConstraint(affine_equality, affine_boundary);
 }
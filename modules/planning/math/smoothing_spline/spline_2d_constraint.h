@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
 
 #include "modules/common/math/vec2d.h"
 #include "modules/planning/math/smoothing_spline/affine_constraint.h"
@@ -40,6 +41,12 @@ class Spline2dConstraint {
                                const Eigen::MatrixXd& constraint_boundary);
   bool AddEqualityConstraint(const Eigen::MatrixXd& constraint_matrix,
                              const Eigen::MatrixXd& constraint_boundary);
+  bool AddInequalityConstraint(
+      const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+      const Eigen::MatrixXd& constraint_boundary);
+  bool AddEqualityConstraint(
+      const Eigen::SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+      const Eigen::MatrixXd& constraint_boundary);
 
   // preset method
   /**
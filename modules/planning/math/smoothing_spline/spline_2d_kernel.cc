@@ -35,15 +35,17 @@ Spline2dKernel::Spline2dKernel(const std::vector<double>& t_knots,
   total_params_ =
       (t_knots_.size() > 1 ? 2 * (t_knots_.size() - 1) * (1 + spline_order_)
                            : 0);
-  kernel_matrix_ = Eigen::MatrixXd::Zero(total_params_, total_params_);
+  kernel_matrix_.resize(total_params_, total_params_);
+  kernel_matrix_.reserve(
+      Eigen::VectorXi::Constant(total_params_, spline_order_ + 1));
   offset_ = Eigen::MatrixXd::Zero(total_params_, 1);
 }
 
 // customized input output
 void Spline2dKernel::AddRegularization(const double regularization_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += id_matrix * regularization_param;
+  for (size_t i = 0; i < total_params_; ++i) {
+    kernel_matrix_.coeffRef(i, i) += regularization_param;
+  }
 }
 
 bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
@@ -54,7 +56,13 @@ bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
       offset.rows() != offset_.rows()) {
     return false;
   }
-  kernel_matrix_ += kernel * weight;
+  for (int c = 0; c < kernel.cols(); ++c) {
+    for (int r = 0; r < kernel.rows(); ++r) {
+      if (kernel(r, c) != 0.0) {
+        kernel_matrix_.coeffRef(r, c) += kernel(r, c) * weight;
+      }
+    }
+  }
   offset_ += offset * weight;
   return true;
 }
@@ -65,13 +73,17 @@ bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
   return AddKernel(kernel, offset, weight);
 }
 
-Eigen::MatrixXd* Spline2dKernel::mutable_kernel_matrix() {
+Eigen::SparseMatrix<double>* Spline2dKernel::mutable_kernel_matrix() {
   return &kernel_matrix_;
 }
 
 Eigen::MatrixXd* Spline2dKernel::mutable_offset() { return &offset_; }
 
 const Eigen::MatrixXd Spline2dKernel::kernel_matrix() const {
+  return Eigen::MatrixXd(kernel_matrix_ * 2.0);
+}
+
+Eigen::SparseMatrix<double> Spline2dKernel::sparse_kernel_matrix() const {
   return kernel_matrix_ * 2.0;
 }
 
@@ -87,10 +99,8 @@ void Spline2dKernel::AddNthDerivativeKernelMatrix(const uint32_t n,
         SplineSegKernel::Instance()->NthDerivativeKernel(
             n, num_params, t_knots_[i + 1] - t_knots_[i]) *
         weight;
-    kernel_matrix_.block(2 * i * num_params, 2 * i * num_params, num_params,
-                         num_params) += cur_kernel;
-    kernel_matrix_.block((2 * i + 1) * num_params, (2 * i + 1) * num_params,
-                         num_params, num_params) += cur_kernel;
+    AddBlock(2 * i * num_params, cur_kernel);
+    AddBlock((2 * i + 1) * num_params, cur_kernel);
   }
 }
 
@@ -144,16 +154,21 @@ bool Spline2dKernel::AddReferenceLineKernelMatrix(
         ref_kernel(r, c) = power_t[r + c];
       }
     }
-    kernel_matrix_.block((2 * cur_index) * num_params,
-                         (2 * cur_index) * num_params, num_params,
-                         num_params) += weight * ref_kernel;
-    kernel_matrix_.block((2 * cur_index + 1) * num_params,
-                         (2 * cur_index + 1) * num_params, num_params,
-                         num_params) += weight * ref_kernel;
+    AddBlock((2 * cur_index) * num_params, weight * ref_kernel);
+    AddBlock((2 * cur_index + 1) * num_params, weight * ref_kernel);
   }
   return true;
 }
 
+void Spline2dKernel::AddBlock(const size_t start,
+                              const Eigen::MatrixXd& block) {
+  for (int c = 0; c < block.cols(); ++c) {
+    for (int r = 0; r < block.rows(); ++r) {
+      kernel_matrix_.coeffRef(start + r, start + c) += block(r, c);
+    }
+  }
+}
+
 uint32_t Spline2dKernel::find_index(const double t) const {
   auto upper_bound = std::upper_bound(t_knots_.begin() + 1, t_knots_.end(), t);
   return std::min(static_cast<uint32_t>(t_knots_.size() - 1),
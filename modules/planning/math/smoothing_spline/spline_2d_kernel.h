@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
 
 #include "modules/common/math/vec2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
@@ -41,10 +42,13 @@ class Spline2dKernel {
                  const double weight);
   bool AddKernel(const Eigen::MatrixXd& kernel, const double weight);
 
-  Eigen::MatrixXd* mutable_kernel_matrix();
+  Eigen::SparseMatrix<double>* mutable_kernel_matrix();
   Eigen::MatrixXd* mutable_offset();
 
+  // the kernel is block diagonal and stored sparse; the dense matrix is
+  // assembled on each call and meant for the dense solvers
   const Eigen::MatrixXd kernel_matrix() const;
+  Eigen::SparseMatrix<double> sparse_kernel_matrix() const;
   const Eigen::MatrixXd offset() const;
 
   // build-in kernel methods
@@ -59,10 +63,11 @@ class Spline2dKernel {
 
  private:
   void AddNthDerivativeKernelMatrix(const uint32_t n, const double weight);
+  void AddBlock(const size_t start, const Eigen::MatrixXd& block);
   uint32_t find_index(const double x) const;
 
  private:
-  Eigen::MatrixXd kernel_matrix_;
+  Eigen::SparseMatrix<double> kernel_matrix_;
   Eigen::MatrixXd offset_;
   std::vector<double> t_knots_;
   uint32_t spline_order_;
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file spline_qp_benchmark.cc
+ * @brief Times the spline kernel and constraint construction and the QP
+ *        solves of planning, at the sizes the optimizers use. The results of
+ *        --benchmark_format=json can be compared with the stored
+ *        spline_qp_benchmark_baseline.json by
+ *        modules/tools/benchmark/compare_benchmark.py.
+ **/
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/math/finite_element_qp/fem_1d_expanded_jerk_qp_problem.h"
+#include "modules/planning/math/smoothing_spline/active_set_spline_1d_solver.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_constraint.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_kernel.h"
+#include "modules/planning/math/smoothing_spline/spline_2d_constraint.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr uint32_t kSplineOrder = 5;
+
+// knots every 1 s or 1 m, as the spline speed and path optimizers use
+std::vector<double> MakeKnots(const int num_segments) {
+  std::vector<double> knots;
+  for (int i = 0; i <= num_segments; ++i) {
+    knots.push_back(static_cast<double>(i));
+  }
+  return knots;
+}
+
+// four evaluation points per segment
+std::vector<double> MakeEvaluatedCoords(const int num_segments) {
+  std::vector<double> coords;
+  for (int i = 0; i <= 4 * num_segments; ++i) {
+    coords.push_back(0.25 * i);
+  }
+  return coords;
+}
+
+// a reference which accelerates and settles, for the speed profiles
+std::vector<double> MakeReference(const std::vector<double>& coords) {
+  std::vector<double> reference;
+  for (const double t : coords) {
+    reference.push_back(10.0 * t + 2.0 * std::sin(0.3 * t));
+  }
+  return reference;
+}
+
+}  // namespace
+
+static void BM_Spline1dKernel(benchmark::State& state) {  // NOLINT
+  const int num_segments = static_cast<int>(state.range(0));
+  const std::vector<double> knots = MakeKnots(num_segments);
+  const std::vector<double> coords = MakeEvaluatedCoords(num_segments);
+  const std::vector<double> reference = MakeReference(coords);
+  for (auto _ : state) {
+    Spline1dKernel kernel(knots, kSplineOrder);
+    kernel.AddDerivativeKernelMatrix(10.0);
+    kernel.AddSecondOrderDerivativeMatrix(100.0);
+    kernel.AddThirdOrderDerivativeMatrix(1000.0);
+    kernel.AddReferenceLineKernelMatrix(coords, reference, 0.4);
+    kernel.AddRegularization(1e-5);
+    benchmark::DoNotOptimize(kernel.sparse_kernel_matrix().valuePtr());
+  }
+}
+BENCHMARK(BM_Spline1dKernel)->Arg(8)->Arg(16)->Arg(32);
+
+static void BM_Spline1dConstraint(benchmark::State& state) {  // NOLINT
+  const int num_segments = static_cast<int>(state.range(0));
+  const std::vector<double> knots = MakeKnots(num_segments);
+  const std::vector<double> coords = MakeEvaluatedCoords(num_segments);
+  const std::vector<double> lower_bound(coords.size(), 0.0);
+  const std::vector<double> upper_bound(coords.size(), 200.0);
+  const std::vector<double> speed_lower_bound(coords.size(), 0.0);
+  const std::vector<double> speed_upper_bound(coords.size(), 15.0);
+  for (auto _ : state) {
+    Spline1dConstraint constraint(knots, kSplineOrder);
+    constraint.AddBoundary(coords, lower_bound, upper_bound);
+    constraint.AddDerivativeBoundary(coords, speed_lower_bound,
+                                     speed_upper_bound);
+    constraint.AddThirdDerivativeSmoothConstraint();
+    constraint.AddMonotoneInequalityConstraintAtKnots();
+    constraint.AddPointConstraint(0.0, 0.0);
+    constraint.AddPointDerivativeConstraint(0.0, 10.0);
+    constraint.AddPointSecondDerivativeConstraint(0.0, 0.0);
+    benchmark::DoNotOptimize(constraint.inequality_constraint()
+                                 .sparse_constraint_matrix()
+                                 .nonZeros());
+  }
+}
+BENCHMARK(BM_Spline1dConstraint)->Arg(8)->Arg(16)->Arg(32);
+
+static void BM_Spline2dConstraint(benchmark::State& state) {  // NOLINT
+  const int num_segments = static_cast<int>(state.range(0));
+  const std::vector<double> knots = MakeKnots(num_segments);
+  const std::vector<double> coords = MakeEvaluatedCoords(num_segments);
+  std::vector<double> angles;
+  std::vector<common::math::Vec2d> ref_points;
+  for (const double t : coords) {
+    angles.push_back(0.1 * std::sin(0.2 * t));
+    ref_points.emplace_back(t, std::sin(0.2 * t));
+  }
+  const std::vector<double> longitudinal_bound(coords.size(), 0.2);
+  const std::vector<double> lateral_bound(coords.size(), 0.5);
+  for (auto _ : state) {
+    Spline2dConstraint constraint(knots, kSplineOrder);
+    constraint.Add2dBoundary(coords, angles, ref_points, longitudinal_bound,
+                             lateral_bound);
+    constraint.AddThirdDerivativeSmoothConstraint();
+    constraint.AddPointConstraint(0.0, 0.0, 0.0);
+    constraint.AddPointAngleConstraint(0.0, 0.0);
+    benchmark::DoNotOptimize(constraint.inequality_constraint()
+                                 .sparse_constraint_matrix()
+                                 .nonZeros());
+  }
+}
+BENCHMARK(BM_Spline2dConstraint)->Arg(8)->Arg(16)->Arg(32);
+
+// a speed profile, as the QP spline speed optimizer builds it, solved with
+// the ActiveSetQpSolver
+static void BM_ActiveSetSpline1dSolve(benchmark::State& state) {  // NOLINT
+  const int num_segments = static_cast<int>(state.range(0));
+  const std::vector<double> knots = MakeKnots(num_segments);
+  const std::vector<double> coords = MakeEvaluatedCoords(num_segments);
+  const std::vector<double> reference = MakeReference(coords);
+  const std::vector<double> lower_bound(coords.size(), 0.0);
+  const std::vector<double> upper_bound(coords.size(), 20.0 * num_segments);
+  const std::vector<double> speed_lower_bound(coords.size(), 0.0);
+  const std::vector<double> speed_upper_bound(coords.size(), 15.0);
+  for (auto _ : state) {
+    ActiveSetSpline1dSolver solver(knots, kSplineOrder + 1);
+    auto* constraint = solver.mutable_spline_constraint();
+    constraint->AddBoundary(coords, lower_bound, upper_bound);
+    constraint->AddDerivativeBoundary(coords, speed_lower_bound,
+                                      speed_upper_bound);
+    constraint->AddThirdDerivativeSmoothConstraint();
+    constraint->AddMonotoneInequalityConstraintAtKnots();
+    constraint->AddPointConstraint(0.0, 0.0);
+    constraint->AddPointDerivativeConstraint(0.0, 10.0);
+    constraint->AddPointSecondDerivativeConstraint(0.0, 0.0);
+    auto* kernel = solver.mutable_spline_kernel();
+    kernel->AddThirdOrderDerivativeMatrix(1000.0);
+    kernel->AddReferenceLineKernelMatrix(coords, reference, 0.4);
+    kernel->AddRegularization(1.0);
+    benchmark::DoNotOptimize(solver.Solve());
+  }
+}
+BENCHMARK(BM_ActiveSetSpline1dSolve)->Arg(8)->Arg(16);
+
+// a lateral path, as the piecewise jerk path optimizer builds it, solved
+// with OSQP
+static void BM_Fem1dExpandedJerkQpProblem(benchmark::State& state) {  // NOLINT
+  const size_t num_points = static_cast<size_t>(state.range(0));
+  const std::array<double, 3> x_init = {0.5, 0.01, 0.001};
+  const std::array<double, 5> weights = {1.0, 2.0, 3.0, 4.0, 1.45};
+  std::vector<std::tuple<double, double, double>> x_bounds;
+  for (size_t i = 0; i < num_points; ++i) {
+    // an obstacle narrows the lane in the middle
+    const bool obstacle = i > num_points / 3 && i < num_points / 2;
+    x_bounds.emplace_back(static_cast<double>(i), obstacle ? 0.8 : -1.8, 1.9);
+  }
+  for (auto _ : state) {
+    Fem1dExpandedJerkQpProblem problem;
+    problem.Init(num_points, x_init, 0.5, weights, 1.25);
+    problem.SetVariableBounds(x_bounds);
+    benchmark::DoNotOptimize(problem.Optimize());
+  }
+}
+BENCHMARK(BM_Fem1dExpandedJerkQpProblem)->Arg(100)->Arg(200)->Arg(400);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
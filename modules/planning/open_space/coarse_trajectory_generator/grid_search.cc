@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+GridSearch::GridSearch(const PlannerOpenSpaceConfig& open_space_conf) {
+  xy_grid_resolution_ =
+      open_space_conf.warm_start_config().grid_a_star_xy_resolution();
+  node_radius_ = open_space_conf.warm_start_config().node_radius();
+}
+
+bool GridSearch::GenerateDpMap(
+    const double ex, const double ey, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::Vec2d>>&
+        obstacles_vertices_vec) {
+  dp_map_reused_ = false;
+  if (XYbounds.size() != 4 || XYbounds[1] <= XYbounds[0] ||
+      XYbounds[3] <= XYbounds[2] || xy_grid_resolution_ <= 0.0) {
+    AERROR << "Invalid XYbounds or grid resolution for the dp map";
+    dp_map_.clear();
+    return false;
+  }
+  if (!dp_map_.empty() && ex == ex_ && ey == ey_ && XYbounds == XYbounds_ &&
+      obstacles_vertices_vec == obstacles_vertices_vec_) {
+    dp_map_reused_ = true;
+    return true;
+  }
+
+  ex_ = ex;
+  ey_ = ey;
+  XYbounds_ = XYbounds;
+  obstacles_vertices_vec_ = obstacles_vertices_vec;
+  max_grid_x_ = static_cast<int>(
+                    std::floor((XYbounds_[1] - XYbounds_[0]) /
+                               xy_grid_resolution_)) +
+                1;
+  max_grid_y_ = static_cast<int>(
+                    std::floor((XYbounds_[3] - XYbounds_[2]) /
+                               xy_grid_resolution_)) +
+                1;
+
+  const int goal_index = GetCellIndex(ex, ey);
+  if (goal_index < 0) {
+    AERROR << "The goal is out of the XYbounds";
+    dp_map_.clear();
+    return false;
+  }
+  MarkObstacles(obstacles_vertices_vec);
+  // the goal is checked against the vehicle box by the caller, the coarse
+  // grid must not block it
+  occupied_[goal_index] = false;
+  Dijkstra(goal_index);
+  return true;
+}
+
+double GridSearch::CheckDpMap(const double sx, const double sy) const {
+  const int index = GetCellIndex(sx, sy);
+  if (index < 0 || dp_map_.empty() || dp_map_[index] == kInfinity) {
+    return 0.0;
+  }
+  return dp_map_[index];
+}
+
+int GridSearch::GetCellIndex(const double x, const double y) const {
+  if (XYbounds_.size() != 4 || x < XYbounds_[0] || x > XYbounds_[1] ||
+      y < XYbounds_[2] || y > XYbounds_[3]) {
+    return -1;
+  }
+  const int grid_x = std::min(
+      static_cast<int>((x - XYbounds_[0]) / xy_grid_resolution_),
+      max_grid_x_ - 1);
+  const int grid_y = std::min(
+      static_cast<int>((y - XYbounds_[2]) / xy_grid_resolution_),
+      max_grid_y_ - 1);
+  return grid_y * max_grid_x_ + grid_x;
+}
+
+void GridSearch::MarkObstacles(
+    const std::vector<std::vector<common::math::Vec2d>>&
+        obstacles_vertices_vec) {
+  occupied_.assign(max_grid_x_ * max_grid_y_, false);
+  // every cell an obstacle edge passes through is blocked, so the edges have
+  // no diagonal gaps on the grid
+  const double radius =
+      std::max(node_radius_, xy_grid_resolution_ * std::sqrt(0.5));
+  auto to_grid = [this](const double value, const double lower,
+                        const int max_grid) {
+    return std::max(
+        0, std::min(max_grid - 1,
+                    static_cast<int>(
+                        std::floor((value - lower) / xy_grid_resolution_))));
+  };
+  for (const auto& obstacle_vertices : obstacles_vertices_vec) {
+    for (size_t i = 0; i + 1 < obstacle_vertices.size(); ++i) {
+      const common::math::LineSegment2d line_segment(obstacle_vertices[i],
+                                                     obstacle_vertices[i + 1]);
+      const auto& start = line_segment.start();
+      const auto& end = line_segment.end();
+      const int min_grid_x = to_grid(std::min(start.x(), end.x()) - radius,
+                                     XYbounds_[0], max_grid_x_);
+      const int max_grid_x = to_grid(std::max(start.x(), end.x()) + radius,
+                                     XYbounds_[0], max_grid_x_);
+      const int min_grid_y = to_grid(std::min(start.y(), end.y()) - radius,
+                                     XYbounds_[2], max_grid_y_);
+      const int max_grid_y = to_grid(std::max(start.y(), end.y()) + radius,
+                                     XYbounds_[2], max_grid_y_);
+      for (int grid_y = min_grid_y; grid_y <= max_grid_y; ++grid_y) {
+        for (int grid_x = min_grid_x; grid_x <= max_grid_x; ++grid_x) {
+          const int index = grid_y * max_grid_x_ + grid_x;
+          if (occupied_[index]) {
+            continue;
+          }
+          const common::math::Vec2d center(
+              XYbounds_[0] + (grid_x + 0.5) * xy_grid_resolution_,
+              XYbounds_[2] + (grid_y + 0.5) * xy_grid_resolution_);
+          if (line_segment.DistanceTo(center) <= radius) {
+            occupied_[index] = true;
+          }
+        }
+      }
+    }
+  }
+}
+
+void GridSearch::Dijkstra(const int goal_index) {
+  dp_map_.assign(max_grid_x_ * max_grid_y_, kInfinity);
+  dp_map_[goal_index] = 0.0;
+
+  const double diagonal = std::sqrt(2.0) * xy_grid_resolution_;
+  const int kNumNeighbors = 8;
+  const int dx[kNumNeighbors] = {-1, 0, 1, -1, 1, -1, 0, 1};
+  const int dy[kNumNeighbors] = {-1, -1, -1, 0, 0, 1, 1, 1};
+  const double step[kNumNeighbors] = {
+      diagonal, xy_grid_resolution_, diagonal, xy_grid_resolution_,
+      xy_grid_resolution_, diagonal, xy_grid_resolution_, diagonal};
+
+  using CellCost = std::pair<double, int>;
+  std::priority_queue<CellCost, std::vector<CellCost>, std::greater<CellCost>>
+      open_pq;
+  open_pq.emplace(0.0, goal_index);
+  while (!open_pq.empty()) {
+    const auto current = open_pq.top();
+    open_pq.pop();
+    const int index = current.second;
+    if (current.first > dp_map_[index]) {
+      continue;
+    }
+    const int grid_x = index % max_grid_x_;
+    const int grid_y = index / max_grid_x_;
+    for (int i = 0; i < kNumNeighbors; ++i) {
+      const int next_x = grid_x + dx[i];
+      const int next_y = grid_y + dy[i];
+      if (next_x < 0 || next_x >= max_grid_x_ || next_y < 0 ||
+          next_y >= max_grid_y_) {
+        continue;
+      }
+      const int next_index = next_y * max_grid_x_ + next_x;
+      if (occupied_[next_index]) {
+        continue;
+      }
+      const double next_cost = current.first + step[i];
+      if (next_cost < dp_map_[next_index]) {
+        dp_map_[next_index] = next_cost;
+        open_pq.emplace(next_cost, next_index);
+      }
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "modules/planning/proto/planner_open_space_config.pb.h"
+
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class GridSearch
+ * @brief Holonomic-with-obstacles cost map for hybrid a star. A 2d grid over
+ * the XY bounds is searched by dijkstra from the goal, with the cells close to
+ * the obstacles blocked, so every cell holds the length of the shortest
+ * obstacle free path to the goal.
+ */
+class GridSearch {
+ public:
+  explicit GridSearch(const PlannerOpenSpaceConfig& open_space_conf);
+  virtual ~GridSearch() = default;
+
+  /**
+   * @brief Generates the cost map towards (ex, ey). The map of the previous
+   * call is kept if the goal, the bounds and the obstacles are unchanged.
+   */
+  bool GenerateDpMap(const double ex, const double ey,
+                     const std::vector<double>& XYbounds,
+                     const std::vector<std::vector<common::math::Vec2d>>&
+                         obstacles_vertices_vec);
+
+  /**
+   * @brief Length of the shortest obstacle free path from (sx, sy) to the
+   * goal, 0.0 if the goal can not be reached on the grid, so it never
+   * overrules other heuristics there.
+   */
+  double CheckDpMap(const double sx, const double sy) const;
+
+  // whether the last GenerateDpMap kept the previous cost map
+  bool dp_map_reused() const { return dp_map_reused_; }
+
+ private:
+  int GetCellIndex(const double x, const double y) const;
+
+  void MarkObstacles(const std::vector<std::vector<common::math::Vec2d>>&
+                         obstacles_vertices_vec);
+
+  void Dijkstra(const int goal_index);
+
+ private:
+  double xy_grid_resolution_ = 0.0;
+  double node_radius_ = 0.0;
+
+  // inputs of the current cost map
+  double ex_ = 0.0;
+  double ey_ = 0.0;
+  std::vector<double> XYbounds_;
+  std::vector<std::vector<common::math::Vec2d>> obstacles_vertices_vec_;
+
+  int max_grid_x_ = 0;
+  int max_grid_y_ = 0;
+  std::vector<bool> occupied_;
+  std::vector<double> dp_map_;
+  bool dp_map_reused_ = false;
+};
+
+}  // namespace planning
+}  // namespace apollo
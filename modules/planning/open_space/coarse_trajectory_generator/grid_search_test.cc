@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+class GridSearchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    planner_open_space_config_.mutable_warm_start_config()
+        ->set_grid_a_star_xy_resolution(0.5);
+    planner_open_space_config_.mutable_warm_start_config()->set_node_radius(
+        0.5);
+    grid_search_.reset(new GridSearch(planner_open_space_config_));
+    XYbounds_ = {-10.0, 10.0, -10.0, 10.0};
+  }
+
+ protected:
+  PlannerOpenSpaceConfig planner_open_space_config_;
+  std::unique_ptr<GridSearch> grid_search_;
+  std::vector<double> XYbounds_;
+};
+
+TEST_F(GridSearchTest, NoObstacle) {
+  ASSERT_TRUE(grid_search_->GenerateDpMap(5.0, 0.0, XYbounds_, {}));
+  EXPECT_DOUBLE_EQ(0.0, grid_search_->CheckDpMap(5.0, 0.0));
+  EXPECT_NEAR(10.0, grid_search_->CheckDpMap(-5.0, 0.0), 0.5);
+  // out of the bounds
+  EXPECT_DOUBLE_EQ(0.0, grid_search_->CheckDpMap(-15.0, 0.0));
+}
+
+TEST_F(GridSearchTest, WallWithGap) {
+  // a wall at x = 0 with a gap between y = 6 and y = 9
+  const std::vector<std::vector<Vec2d>> obstacles = {
+      {Vec2d(0.0, -10.0), Vec2d(0.0, 6.0)},
+      {Vec2d(0.0, 9.0), Vec2d(0.0, 10.0)}};
+  ASSERT_TRUE(grid_search_->GenerateDpMap(5.0, 0.0, XYbounds_, obstacles));
+  EXPECT_FALSE(grid_search_->dp_map_reused());
+  // around the wall through the gap, about 2 * sqrt(5^2 + 7.5^2)
+  const double cost = grid_search_->CheckDpMap(-5.0, 0.0);
+  EXPECT_GT(cost, 17.0);
+  EXPECT_LT(cost, 20.0);
+
+  // same goal and obstacles
+  ASSERT_TRUE(grid_search_->GenerateDpMap(5.0, 0.0, XYbounds_, obstacles));
+  EXPECT_TRUE(grid_search_->dp_map_reused());
+  EXPECT_DOUBLE_EQ(cost, grid_search_->CheckDpMap(-5.0, 0.0));
+
+  // the gap is closed, the goal can not be reached from the other side
+  const std::vector<std::vector<Vec2d>> closed_wall = {
+      {Vec2d(0.0, -10.0), Vec2d(0.0, 10.0)}};
+  ASSERT_TRUE(grid_search_->GenerateDpMap(5.0, 0.0, XYbounds_, closed_wall));
+  EXPECT_FALSE(grid_search_->dp_map_reused());
+  EXPECT_DOUBLE_EQ(0.0, grid_search_->CheckDpMap(-5.0, 0.0));
+  EXPECT_NEAR(std::hypot(3.0, 3.0), grid_search_->CheckDpMap(2.0, 3.0), 0.5);
+}
+
+TEST_F(GridSearchTest, GoalOutOfBounds) {
+  EXPECT_FALSE(grid_search_->GenerateDpMap(15.0, 0.0, XYbounds_, {}));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,15 +20,28 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/hybrid_a_star.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/task/task.h"
+
 namespace apollo {
 namespace planning {
 
 using apollo::common::time::Clock;
 
+namespace {
+
+// cell size of the grid the obstacle segments are bucketed into
+constexpr double kSegmentGridResolution = 1.0;
+
+}  // namespace
+
 HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
   planner_open_space_config_.CopyFrom(open_space_conf);
   reed_shepp_generator_.reset(
       new ReedShepp(vehicle_param_, planner_open_space_config_));
+  grid_search_.reset(new GridSearch(planner_open_space_config_));
   next_node_num_ =
       planner_open_space_config_.warm_start_config().next_node_num();
   max_steer_angle_ =
@@ -57,16 +70,19 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().heu_rs_steer_penalty();
   heu_rs_steer_change_penalty_ = planner_open_space_config_.warm_start_config()
                                      .heu_rs_steer_change_penalty();
+  analytic_expansion_candidate_num_ =
+      planner_open_space_config_.warm_start_config()
+          .analytic_expansion_candidate_num();
 }
 
-bool HybridAStar::AnalyticExpansion(
-    std::shared_ptr<Node3d> current_node,
-    const std::vector<std::vector<common::math::Vec2d>>&
-        obstacles_vertices_vec) {
+bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
   std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
       ReedSheppPath_cache_[current_node->GetIndex()];
-  if (!RSPCheck(reeds_shepp_to_check, obstacles_vertices_vec)) {
-    return false;
+  if (!RSPCheck(reeds_shepp_to_check)) {
+    reeds_shepp_to_check = NextCollisionFreeRSP(current_node);
+    if (reeds_shepp_to_check == nullptr) {
+      return false;
+    }
   }
   AINFO << "Reach the end configuration with Reed Sharp";
   // load the whole RSP as nodes and add to the close set
@@ -74,6 +90,41 @@ bool HybridAStar::AnalyticExpansion(
   return true;
 }
 
+std::shared_ptr<ReedSheppPath> HybridAStar::NextCollisionFreeRSP(
+    std::shared_ptr<Node3d> current_node) {
+  if (analytic_expansion_candidate_num_ <= 1) {
+    return nullptr;
+  }
+  std::vector<std::shared_ptr<ReedSheppPath>> candidates;
+  if (!reed_shepp_generator_->ShortestRSPs(current_node, end_node_,
+                                           analytic_expansion_candidate_num_,
+                                           &candidates)) {
+    return nullptr;
+  }
+  // the first candidate is the shortest path, which is already checked
+  const size_t num_candidates = candidates.size();
+  std::vector<char> collision_free(num_candidates, 0);
+  auto check_candidate = [&](size_t i) {
+    collision_free[i] = RSPCheck(candidates[i]) ? 1 : 0;
+  };
+  if (FLAGS_enable_multi_thread_in_hybrid_a_star) {
+    cyber::ParallelFor(1, num_candidates, 1, check_candidate);
+  } else {
+    for (size_t i = 1; i < num_candidates; ++i) {
+      check_candidate(i);
+      if (collision_free[i]) {
+        break;
+      }
+    }
+  }
+  for (size_t i = 1; i < num_candidates; ++i) {
+    if (collision_free[i]) {
+      return candidates[i];
+    }
+  }
+  return nullptr;
+}
+
 bool HybridAStar::ReedSheppHeuristic(
     std::shared_ptr<Node3d> current_node,
     std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
@@ -88,9 +139,7 @@ bool HybridAStar::ReedSheppHeuristic(
 }
 
 bool HybridAStar::RSPCheck(
-    const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-    const std::vector<std::vector<common::math::Vec2d>>&
-        obstacles_vertices_vec) {
+    const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) const {
   for (size_t i = 0; i < reeds_shepp_to_end->x.size(); i++) {
     if (reeds_shepp_to_end->x[i] > XYbounds_[1] ||
         reeds_shepp_to_end->x[i] < XYbounds_[0] ||
@@ -98,30 +147,97 @@ bool HybridAStar::RSPCheck(
         reeds_shepp_to_end->y[i] < XYbounds_[2]) {
       return false;
     }
-    std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-        reeds_shepp_to_end->x[i], reeds_shepp_to_end->y[i],
-        reeds_shepp_to_end->phi[i], XYbounds_, planner_open_space_config_));
-    if (!ValidityCheck(node, obstacles_vertices_vec)) {
+    Node3d node(reeds_shepp_to_end->x[i], reeds_shepp_to_end->y[i],
+                reeds_shepp_to_end->phi[i]);
+    if (!ValidityCheck(node.GetBoundingBox(vehicle_param_))) {
       return false;
     }
   }
   return true;
 }
 
-bool HybridAStar::ValidityCheck(
-    std::shared_ptr<Node3d> node,
+void HybridAStar::LoadObstacleSegments(
     const std::vector<std::vector<common::math::Vec2d>>&
         obstacles_vertices_vec) {
-  if (obstacles_vertices_vec.size() == 0) {
+  obstacle_segments_.clear();
+  segment_min_grids_.clear();
+  for (const auto& obstacle_vertices : obstacles_vertices_vec) {
+    for (size_t i = 0; i + 1 < obstacle_vertices.size(); ++i) {
+      obstacle_segments_.emplace_back(obstacle_vertices[i],
+                                      obstacle_vertices[i + 1]);
+    }
+  }
+  segment_grid_x_ = static_cast<int>((XYbounds_[1] - XYbounds_[0]) /
+                                     kSegmentGridResolution) +
+                    1;
+  segment_grid_y_ = static_cast<int>((XYbounds_[3] - XYbounds_[2]) /
+                                     kSegmentGridResolution) +
+                    1;
+  segment_grid_.assign(segment_grid_x_ * segment_grid_y_, {});
+  for (size_t i = 0; i < obstacle_segments_.size(); ++i) {
+    const auto& start = obstacle_segments_[i].start();
+    const auto& end = obstacle_segments_[i].end();
+    int min_grid_x = 0;
+    int max_grid_x = 0;
+    int min_grid_y = 0;
+    int max_grid_y = 0;
+    GetSegmentGridRange(std::min(start.x(), end.x()),
+                        std::max(start.x(), end.x()),
+                        std::min(start.y(), end.y()),
+                        std::max(start.y(), end.y()), &min_grid_x,
+                        &max_grid_x, &min_grid_y, &max_grid_y);
+    for (int grid_y = min_grid_y; grid_y <= max_grid_y; ++grid_y) {
+      for (int grid_x = min_grid_x; grid_x <= max_grid_x; ++grid_x) {
+        segment_grid_[grid_y * segment_grid_x_ + grid_x].push_back(
+            static_cast<int>(i));
+      }
+    }
+    segment_min_grids_.emplace_back(min_grid_x, min_grid_y);
+  }
+}
+
+void HybridAStar::GetSegmentGridRange(const double min_x, const double max_x,
+                                      const double min_y, const double max_y,
+                                      int* min_grid_x, int* max_grid_x,
+                                      int* min_grid_y, int* max_grid_y) const {
+  // out of bounds parts are clamped to the border cells, which keeps the
+  // ranges of overlapping boxes overlapping
+  auto to_grid = [](const double value, const double lower,
+                    const int max_grid) {
+    const int grid =
+        static_cast<int>(std::floor((value - lower) / kSegmentGridResolution));
+    return std::max(0, std::min(max_grid - 1, grid));
+  };
+  *min_grid_x = to_grid(min_x, XYbounds_[0], segment_grid_x_);
+  *max_grid_x = to_grid(max_x, XYbounds_[0], segment_grid_x_);
+  *min_grid_y = to_grid(min_y, XYbounds_[2], segment_grid_y_);
+  *max_grid_y = to_grid(max_y, XYbounds_[2], segment_grid_y_);
+}
+
+bool HybridAStar::ValidityCheck(const Box2d& bounding_box) const {
+  if (obstacle_segments_.empty()) {
     return true;
   }
-  for (const auto& obstacle_vertices : obstacles_vertices_vec) {
-    size_t vertices_num = obstacle_vertices.size();
-    for (size_t i = 0; i < vertices_num - 1; i++) {
-      common::math::LineSegment2d line_segment = common::math::LineSegment2d(
-          obstacle_vertices[i], obstacle_vertices[i + 1]);
-      if (node->GetBoundingBox(vehicle_param_).HasOverlap(line_segment)) {
-        return false;
+  int min_grid_x = 0;
+  int max_grid_x = 0;
+  int min_grid_y = 0;
+  int max_grid_y = 0;
+  GetSegmentGridRange(bounding_box.min_x(), bounding_box.max_x(),
+                      bounding_box.min_y(), bounding_box.max_y(), &min_grid_x,
+                      &max_grid_x, &min_grid_y, &max_grid_y);
+  // only the segments sharing a cell with the box can overlap with it. Every
+  // one of them is checked once, in the first cell of the range both cover,
+  // which keeps the check free of state and safe to run concurrently.
+  for (int grid_y = min_grid_y; grid_y <= max_grid_y; ++grid_y) {
+    for (int grid_x = min_grid_x; grid_x <= max_grid_x; ++grid_x) {
+      for (const int i : segment_grid_[grid_y * segment_grid_x_ + grid_x]) {
+        if (grid_x != std::max(segment_min_grids_[i].first, min_grid_x) ||
+            grid_y != std::max(segment_min_grids_[i].second, min_grid_y)) {
+          continue;
+        }
+        if (bounding_box.HasOverlap(obstacle_segments_[i])) {
+          return false;
+        }
       }
     }
   }
@@ -131,12 +247,12 @@ bool HybridAStar::ValidityCheck(
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node =
+      NewNode(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+              reeds_shepp_to_end->phi, XYbounds_, planner_open_space_config_);
   end_node->SetPre(current_node);
   end_node->SetTrajCost(CalculateRSPCost(reeds_shepp_to_end));
-  close_set_.insert(std::make_pair(end_node->GetIndex(), end_node));
+  close_set_[end_node->GetIndex()] = true;
   return end_node;
 }
 
@@ -191,9 +307,10 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_y.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node =
+      NewNode(std::move(intermediate_x), std::move(intermediate_y),
+              std::move(intermediate_phi), XYbounds_,
+              planner_open_space_config_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0);
   next_node->SetSteer(steering);
@@ -206,7 +323,9 @@ void HybridAStar::CalculateNodeCost(
   next_node->SetTrajCost(current_node->GetTrajCost() +
                          TrajCost(current_node, next_node));
   // evaluate heuristic cost
-  next_node->SetHeuCost(NonHoloNoObstacleHeuristic(reeds_shepp_to_end));
+  next_node->SetHeuCost(
+      std::max(NonHoloNoObstacleHeuristic(reeds_shepp_to_end),
+               HoloObstacleHeuristic(next_node)));
 }
 
 double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
@@ -229,6 +348,13 @@ double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
   return piecewise_cost;
 }
 
+double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
+  // the grid path length weighted like the reeds shepp segments, so that it
+  // stays comparable to the non-holonomic heuristic
+  return grid_search_->CheckDpMap(next_node->GetX(), next_node->GetY()) *
+         std::min(heu_rs_forward_penalty_, heu_rs_back_penalty_);
+}
+
 double HybridAStar::NonHoloNoObstacleHeuristic(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
   return CalculateRSPCost(reeds_shepp_to_end);
@@ -360,27 +486,51 @@ bool HybridAStar::Plan(
     const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
-  // clear containers
+  double start_timestamp = 0.0;
+  // clear containers, the nodes of the last plan go back to the arena
   open_set_.clear();
-  close_set_.clear();
   while (!open_pq_.empty()) open_pq_.pop();
+  ReedSheppPath_cache_.clear();
+  start_node_ = nullptr;
+  end_node_ = nullptr;
   final_node_ = nullptr;
+  node_arena_.Reset();
 
   // load XYbounds
   XYbounds_ = XYbounds;
+  if (XYbounds_.size() != 4 || sx < XYbounds_[0] || sx > XYbounds_[1] ||
+      sy < XYbounds_[2] || sy > XYbounds_[3] || ex < XYbounds_[0] ||
+      ex > XYbounds_[1] || ey < XYbounds_[2] || ey > XYbounds_[3]) {
+    AERROR << "start or end configuration out of the XYbounds";
+    return false;
+  }
+  close_set_.assign(Node3d::GetGridNum(XYbounds_, planner_open_space_config_),
+                    false);
   // load nodes and obstacles
-  start_node_.reset(
-      new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
-  end_node_.reset(
-      new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
-  if (!ValidityCheck(start_node_, obstacles_vertices_vec)) {
+  LoadObstacleSegments(obstacles_vertices_vec);
+  start_node_ =
+      NewNode(std::vector<double>{sx}, std::vector<double>{sy},
+              std::vector<double>{sphi}, XYbounds_, planner_open_space_config_);
+  end_node_ =
+      NewNode(std::vector<double>{ex}, std::vector<double>{ey},
+              std::vector<double>{ephi}, XYbounds_, planner_open_space_config_);
+  if (!ValidityCheck(start_node_->GetBoundingBox(vehicle_param_))) {
     AERROR << "start_node in collision with obstacles";
     return false;
   }
-  if (!ValidityCheck(end_node_, obstacles_vertices_vec)) {
+  if (!ValidityCheck(end_node_->GetBoundingBox(vehicle_param_))) {
     AERROR << "end_node in collision with obstacles";
     return false;
   }
+  // generate the holonomic-with-obstacles cost map towards the end node
+  start_timestamp = Clock::NowInSeconds();
+  if (!grid_search_->GenerateDpMap(ex, ey, XYbounds_,
+                                   obstacles_vertices_vec)) {
+    AERROR << "GenerateDpMap failed";
+    return false;
+  }
+  ADEBUG << "dp map time: " << Clock::NowInSeconds() - start_timestamp
+         << ", reused: " << grid_search_->dp_map_reused();
   // load open set, priority queue and ReedSheepPath_cache
   open_set_.insert(std::make_pair(start_node_->GetIndex(), start_node_));
   open_pq_.push(
@@ -398,9 +548,12 @@ bool HybridAStar::Plan(
   // Hybrid A* begins
   size_t explored_node_num = 0;
   double reeds_shepp_time = 0.0;
-  double start_timestamp = 0.0;
   double end_timestamp = 0.0;
   while (!open_pq_.empty()) {
+    if (cancel_flag_ != nullptr && cancel_flag_->load()) {
+      AINFO << "Hybrid A searching cancelled";
+      return false;
+    }
     // take out the lowest cost neighoring node
     size_t current_id = open_pq_.top().first;
     open_pq_.pop();
@@ -408,10 +561,10 @@ bool HybridAStar::Plan(
     // check if a analystic curve could be connected from current configuration
     // to the end configuration without collision. if so, search ends.
     start_timestamp = Clock::NowInSeconds();
-    if (AnalyticExpansion(current_node, obstacles_vertices_vec)) {
+    if (AnalyticExpansion(current_node)) {
       break;
     }
-    close_set_.insert(std::make_pair(current_node->GetIndex(), current_node));
+    close_set_[current_node->GetIndex()] = true;
     end_timestamp = Clock::NowInSeconds();
     reeds_shepp_time += (end_timestamp - start_timestamp);
     for (size_t i = 0; i < next_node_num_; i++) {
@@ -420,12 +573,12 @@ bool HybridAStar::Plan(
       if (next_node == nullptr) {
         continue;
       }
-      // collision check
-      if (!ValidityCheck(next_node, obstacles_vertices_vec)) {
+      // check if the node is already in the close set
+      if (close_set_[next_node->GetIndex()]) {
         continue;
       }
-      // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      // collision check
+      if (!ValidityCheck(next_node->GetBoundingBox(vehicle_param_))) {
         continue;
       }
 
@@ -31,12 +31,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
@@ -45,7 +47,9 @@
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
+#include "modules/common/math/line_segment2d.h"
 #include "modules/common/time/time.h"
+#include "modules/planning/common/arena.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -74,20 +78,38 @@ class HybridAStar {
                 obstacles_vertices_vec,
             HybridAStartResult* result);
 
+  // Plan gives up and returns false once the flag is set, nullptr never
+  // cancels; the flag must outlive this object
+  void set_cancel_flag(const std::atomic<bool>* cancel_flag) {
+    cancel_flag_ = cancel_flag;
+  }
+
  private:
-  bool AnalyticExpansion(std::shared_ptr<Node3d> current_node,
-                         const std::vector<std::vector<common::math::Vec2d>>&
-                             obstacles_vertices_vec);
+  bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
   bool ReedSheppHeuristic(std::shared_ptr<Node3d> current_node,
                           std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
+  // bucket the obstacle edges into the segment grid
+  void LoadObstacleSegments(const std::vector<std::vector<common::math::Vec2d>>&
+                                obstacles_vertices_vec);
+  // range of the segment grid cells covering an axis aligned box
+  void GetSegmentGridRange(const double min_x, const double max_x,
+                           const double min_y, const double max_y,
+                           int* min_grid_x, int* max_grid_x, int* min_grid_y,
+                           int* max_grid_y) const;
   // check collision and validity
-  bool ValidityCheck(std::shared_ptr<Node3d> node,
-                     const std::vector<std::vector<common::math::Vec2d>>&
-                         obstacles_vertices_vec);
+  bool ValidityCheck(const Box2d& bounding_box) const;
   // check Reeds Shepp path collision and validity
-  bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-                const std::vector<std::vector<common::math::Vec2d>>&
-                    obstacles_vertices_vec);
+  bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) const;
+  // the shortest collision free one of the next shortest Reeds Shepp paths,
+  // nullptr if there is none
+  std::shared_ptr<ReedSheppPath> NextCollisionFreeRSP(
+      std::shared_ptr<Node3d> current_node);
+  // nodes are allocated from node_arena_ and released with it by Plan()
+  template <typename... Args>
+  std::shared_ptr<Node3d> NewNode(Args&&... args) {
+    return std::allocate_shared<Node3d>(ArenaAllocator<Node3d>(&node_arena_),
+                                        std::forward<Args>(args)...);
+  }
   // load the whole RSP as nodes and add to the close set
   std::shared_ptr<Node3d> LoadRSPinCS(
       const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
@@ -100,7 +122,7 @@ class HybridAStar {
   double TrajCost(std::shared_ptr<Node3d> current_node,
                   std::shared_ptr<Node3d> next_node);
   double HeuristicCost();
-  double HoloObstacleHeuristic();
+  double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
   double NonHoloNoObstacleHeuristic(
       const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
   double CalculateRSPCost(
@@ -127,7 +149,11 @@ class HybridAStar {
   double heu_rs_gear_switch_penalty_ = 0.0;
   double heu_rs_steer_penalty_ = 0.0;
   double heu_rs_steer_change_penalty_ = 0.0;
+  size_t analytic_expansion_candidate_num_ = 1;
+  const std::atomic<bool>* cancel_flag_ = nullptr;
   std::vector<double> XYbounds_;
+  // declared before every node holder, so that it is destroyed after them
+  Arena node_arena_;
   std::shared_ptr<Node3d> start_node_;
   std::shared_ptr<Node3d> end_node_;
   std::shared_ptr<Node3d> final_node_;
@@ -141,10 +167,22 @@ class HybridAStar {
                       std::vector<std::pair<size_t, double>>, cmp>
       open_pq_;
   std::unordered_map<size_t, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<size_t, std::shared_ptr<Node3d>> close_set_;
+  // indexed by the node index
+  std::vector<bool> close_set_;
   std::unordered_map<size_t, std::shared_ptr<ReedSheppPath>>
       ReedSheppPath_cache_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
+  // kept across plans, so the cost map is reused while the goal and the
+  // obstacles do not change
+  std::unique_ptr<GridSearch> grid_search_;
+  // obstacle edges and, for every cell of the segment grid, the edges whose
+  // bounding box touches it
+  std::vector<common::math::LineSegment2d> obstacle_segments_;
+  std::vector<std::vector<int>> segment_grid_;
+  int segment_grid_x_ = 0;
+  int segment_grid_y_ = 0;
+  // the first cell of every segment range
+  std::vector<std::pair<int, int>> segment_min_grids_;
 };
 
 }  // namespace planning
@@ -20,6 +20,8 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 
+#include <utility>
+
 namespace apollo {
 namespace planning {
 
@@ -41,20 +43,7 @@ Node3d::Node3d(double x, double y, double phi,
       << "x_ is smaller than xmin when constructing node3d";
   CHECK_GE(y_, XYbounds[2])
       << "y_ is smaller than ymin when constructing node3d";
-  x_grid_ = static_cast<size_t>(
-      (x_ - XYbounds[0]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  y_grid_ = static_cast<size_t>(
-      (y_ - XYbounds[2]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  phi_grid_ = static_cast<size_t>(
-      (phi_ - (-M_PI)) /
-      open_space_conf.warm_start_config().phi_grid_resolution());
-  index_ = static_cast<size_t>(
-      static_cast<double>(phi_grid_) * (XYbounds[1] - XYbounds[0]) *
-          (XYbounds[3] - XYbounds[2]) +
-      static_cast<double>(y_grid_) * (XYbounds[1] - XYbounds[0]) +
-      static_cast<double>(x_grid_));
+  ComputeGridIndex(XYbounds, open_space_conf);
 }
 
 Node3d::Node3d(std::vector<double> traversed_x, std::vector<double> traversed_y,
@@ -70,24 +59,44 @@ Node3d::Node3d(std::vector<double> traversed_x, std::vector<double> traversed_y,
       << "x_ is smaller than xmin when constructing node3d";
   CHECK_GE(y_, XYbounds[2])
       << "y_ is smaller than ymin when constructing node3d";
+  ComputeGridIndex(XYbounds, open_space_conf);
+  traversed_x_ = std::move(traversed_x);
+  traversed_y_ = std::move(traversed_y);
+  traversed_phi_ = std::move(traversed_phi);
+}
+
+size_t Node3d::GetGridNum(const std::vector<double>& XYbounds,
+                          const PlannerOpenSpaceConfig& open_space_conf) {
+  const auto& warm_start_config = open_space_conf.warm_start_config();
+  const size_t max_grid_x = static_cast<size_t>(
+      (XYbounds[1] - XYbounds[0]) / warm_start_config.xy_grid_resolution() +
+      1);
+  const size_t max_grid_y = static_cast<size_t>(
+      (XYbounds[3] - XYbounds[2]) / warm_start_config.xy_grid_resolution() +
+      1);
+  const size_t max_grid_phi = static_cast<size_t>(
+      2 * M_PI / warm_start_config.phi_grid_resolution() + 1);
+  return max_grid_x * max_grid_y * max_grid_phi;
+}
+
+void Node3d::ComputeGridIndex(const std::vector<double>& XYbounds,
+                              const PlannerOpenSpaceConfig& open_space_conf) {
   // XYbounds in xmin, xmax, ymin, ymax
-  x_grid_ = static_cast<size_t>(
-      (x_ - XYbounds[0]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  y_grid_ = static_cast<size_t>(
-      (y_ - XYbounds[2]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  phi_grid_ = static_cast<size_t>(
-      (phi_ - (-M_PI)) /
-      open_space_conf.warm_start_config().phi_grid_resolution());
-  index_ = static_cast<size_t>(
-      static_cast<double>(phi_grid_) * (XYbounds[1] - XYbounds[0]) *
-          (XYbounds[3] - XYbounds[2]) +
-      static_cast<double>(y_grid_) * (XYbounds[1] - XYbounds[0]) +
-      static_cast<double>(x_grid_));
-  traversed_x_ = traversed_x;
-  traversed_y_ = traversed_y;
-  traversed_phi_ = traversed_phi;
+  const auto& warm_start_config = open_space_conf.warm_start_config();
+  x_grid_ = static_cast<size_t>((x_ - XYbounds[0]) /
+                                warm_start_config.xy_grid_resolution());
+  y_grid_ = static_cast<size_t>((y_ - XYbounds[2]) /
+                                warm_start_config.xy_grid_resolution());
+  phi_grid_ = static_cast<size_t>((phi_ - (-M_PI)) /
+                                  warm_start_config.phi_grid_resolution());
+  // strides in grid cells, so that different cells never share an index
+  const size_t max_grid_x = static_cast<size_t>(
+      (XYbounds[1] - XYbounds[0]) / warm_start_config.xy_grid_resolution() +
+      1);
+  const size_t max_grid_y = static_cast<size_t>(
+      (XYbounds[3] - XYbounds[2]) / warm_start_config.xy_grid_resolution() +
+      1);
+  index_ = (phi_grid_ * max_grid_y + y_grid_) * max_grid_x + x_grid_;
 }
 
 Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_) {
@@ -70,6 +70,13 @@ class Node3d {
   void SetTrajCost(double cost) { traj_cost_ = cost; }
   void SetHeuCost(double cost) { heuristic_cost_ = cost; }
   void SetSteer(double steering) { steering_ = steering; }
+  // upper bound of the node indices within XYbounds
+  static size_t GetGridNum(const std::vector<double>& XYbounds,
+                           const PlannerOpenSpaceConfig& open_space_conf);
+
+ private:
+  void ComputeGridIndex(const std::vector<double>& XYbounds,
+                        const PlannerOpenSpaceConfig& open_space_conf);
 
  private:
   double x_ = 0.0;
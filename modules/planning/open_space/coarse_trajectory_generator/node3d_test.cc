@@ -57,5 +57,20 @@ TEST_F(Node3dTest, GetBoundingBox) {
   ASSERT_EQ(test_box.width(), gold_box.width());
 }
 
+TEST_F(Node3dTest, GetIndex) {
+  PlannerOpenSpaceConfig open_space_conf;
+  open_space_conf.mutable_warm_start_config()->set_xy_grid_resolution(0.3);
+  open_space_conf.mutable_warm_start_config()->set_phi_grid_resolution(0.1);
+  const std::vector<double> XYbounds = {0.0, 10.0, 0.0, 10.0};
+  // the 11th cell of the first row and the first cell of the second row
+  Node3d node_a(3.05, 0.1, 0.0, XYbounds, open_space_conf);
+  Node3d node_b(0.1, 0.35, 0.0, XYbounds, open_space_conf);
+  EXPECT_NE(node_a.GetIndex(), node_b.GetIndex());
+
+  const size_t grid_num = Node3d::GetGridNum(XYbounds, open_space_conf);
+  Node3d node_c(10.0, 10.0, M_PI - 1e-6, XYbounds, open_space_conf);
+  EXPECT_LT(node_c.GetIndex(), grid_num);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,6 +20,9 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace apollo {
 namespace planning {
 
@@ -94,19 +97,47 @@ bool ReedShepp::ShortestRSP(const std::shared_ptr<Node3d> start_node,
     return false;
   }
 
-  (*optimal_path).x = all_possible_paths[optimal_path_index].x;
-  (*optimal_path).y = all_possible_paths[optimal_path_index].y;
-  (*optimal_path).phi = all_possible_paths[optimal_path_index].phi;
-  (*optimal_path).gear = all_possible_paths[optimal_path_index].gear;
-  (*optimal_path).total_length =
-      all_possible_paths[optimal_path_index].total_length;
-  (*optimal_path).segs_types =
-      all_possible_paths[optimal_path_index].segs_types;
-  (*optimal_path).segs_lengths =
-      all_possible_paths[optimal_path_index].segs_lengths;
+  *optimal_path = std::move(all_possible_paths[optimal_path_index]);
   return true;
 }
 
+bool ReedShepp::ShortestRSPs(
+    const std::shared_ptr<Node3d> start_node,
+    const std::shared_ptr<Node3d> end_node, const size_t max_path_num,
+    std::vector<std::shared_ptr<ReedSheppPath>>* paths) {
+  paths->clear();
+  std::vector<ReedSheppPath> all_possible_paths;
+  if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
+    AERROR << "Fail to generate different combination of Reed Shepp "
+              "paths";
+    return false;
+  }
+
+  // only the paths which are returned get interpolated
+  std::vector<size_t> order(all_possible_paths.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&all_possible_paths](const size_t lhs, const size_t rhs) {
+                     return all_possible_paths[lhs].total_length <
+                            all_possible_paths[rhs].total_length;
+                   });
+  for (const size_t index : order) {
+    if (paths->size() >= max_path_num) {
+      break;
+    }
+    auto& path = all_possible_paths[index];
+    if (!GenerateLocalConfigurations(start_node, end_node, &path) ||
+        std::abs(path.x.back() - end_node->GetX()) > 1e-3 ||
+        std::abs(path.y.back() - end_node->GetY()) > 1e-3 ||
+        std::abs(path.phi.back() - end_node->GetPhi()) > 1e-3) {
+      ADEBUG << "Skip a RSP not reaching the end position";
+      continue;
+    }
+    paths->push_back(std::make_shared<ReedSheppPath>(std::move(path)));
+  }
+  return !paths->empty();
+}
+
 bool ReedShepp::GenerateRSPs(const std::shared_ptr<Node3d> start_node,
                              const std::shared_ptr<Node3d> end_node,
                              std::vector<ReedSheppPath>* all_possible_paths) {
@@ -63,6 +63,12 @@ class ReedShepp {
   bool ShortestRSP(const std::shared_ptr<Node3d> start_node,
                    const std::shared_ptr<Node3d> end_node,
                    std::shared_ptr<ReedSheppPath> optimal_path);
+  // Interpolate up to max_path_num of the shortest Reed Shepp paths, sorted by
+  // length
+  bool ShortestRSPs(const std::shared_ptr<Node3d> start_node,
+                    const std::shared_ptr<Node3d> end_node,
+                    const size_t max_path_num,
+                    std::vector<std::shared_ptr<ReedSheppPath>>* paths);
 
  private:
   // Generate all possible combination of movement primitives by Reed Shepp and
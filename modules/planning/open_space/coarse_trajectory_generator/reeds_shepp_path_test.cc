@@ -136,5 +136,25 @@ TEST_F(reeds_shepp, test_set_5) {
   }
   check(start_node, end_node, optimal_path);
 }
+TEST_F(reeds_shepp, shortest_paths) {
+  std::shared_ptr<Node3d> start_node = std::shared_ptr<Node3d>(new Node3d(
+      0.0, 0.0, 10.0 * M_PI / 180.0, XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
+      7.0, -8.0, 50.0 * M_PI / 180.0, XYbounds_, planner_open_space_config_));
+  std::shared_ptr<ReedSheppPath> optimal_path =
+      std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
+  ASSERT_TRUE(reedshepp_test->ShortestRSP(start_node, end_node, optimal_path));
+  std::vector<std::shared_ptr<ReedSheppPath>> paths;
+  ASSERT_TRUE(reedshepp_test->ShortestRSPs(start_node, end_node, 3, &paths));
+  ASSERT_GT(paths.size(), 1);
+  ASSERT_LE(paths.size(), 3);
+  EXPECT_DOUBLE_EQ(optimal_path->total_length, paths.front()->total_length);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    check(start_node, end_node, paths[i]);
+    if (i > 0) {
+      EXPECT_LE(paths[i - 1]->total_length, paths[i]->total_length);
+    }
+  }
+}
 }  // namespace planning
 }  // namespace apollo
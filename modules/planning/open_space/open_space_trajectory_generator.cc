@@ -46,17 +46,24 @@ Status OpenSpaceTrajectoryGenerator::Init(
 
   // initialize warm start class pointer
   warm_start_.reset(new HybridAStar(planner_open_space_config));
+  warm_start_->set_cancel_flag(&is_stop_);
 
   // initialize dual variable warm start class pointer
   dual_variable_warm_start_.reset(
       new DualVariableWarmStartProblem(planner_open_space_config));
+  dual_variable_warm_start_->set_cancel_flag(&is_stop_);
 
   // initialize distance approach class pointer
   distance_approach_.reset(
       new DistanceApproachProblem(planner_open_space_config));
+  distance_approach_->set_cancel_flag(&is_stop_);
   return Status::OK();
 }
 
+void OpenSpaceTrajectoryGenerator::Stop() { is_stop_ = true; }
+
+void OpenSpaceTrajectoryGenerator::Restart() { is_stop_ = false; }
+
 apollo::common::Status OpenSpaceTrajectoryGenerator::Plan(
     const std::vector<common::TrajectoryPoint>& stitching_trajectory,
     const VehicleState& vehicle_state, const std::vector<double>& XYbounds,
@@ -71,6 +78,10 @@ apollo::common::Status OpenSpaceTrajectoryGenerator::Plan(
       obstacles_b.cols() == 0) {
     return Status(ErrorCode::PLANNING_ERROR, "Generator input data not ready");
   }
+  if (is_stop_) {
+    return Status(ErrorCode::PLANNING_ERROR,
+                  "Open space trajectory generation cancelled");
+  }
 
   // Generate Stop trajectory if init point close to destination
   if (IsInitPointNearDestination(stitching_trajectory.back(), end_pose,
@@ -131,6 +142,10 @@ apollo::common::Status OpenSpaceTrajectoryGenerator::Plan(
                         xF(2, 0), XYbounds_, obstacles_vertices_vec, &result)) {
     ADEBUG << "State warm start problem solved successfully!";
   } else {
+    if (is_stop_) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Open space trajectory generation cancelled");
+    }
     return Status(ErrorCode::PLANNING_ERROR,
                   "State warm start problem failed to solve");
   }
@@ -175,6 +190,10 @@ apollo::common::Status OpenSpaceTrajectoryGenerator::Plan(
     if (dual_variable_warm_start_status) {
       ADEBUG << "Dual variable problem solved successfully!";
     } else {
+      if (is_stop_) {
+        return Status(ErrorCode::PLANNING_ERROR,
+                      "Open space trajectory generation cancelled");
+      }
       return Status(ErrorCode::PLANNING_ERROR,
                     "Dual variable problem failed to solve");
     }
@@ -205,6 +224,10 @@ apollo::common::Status OpenSpaceTrajectoryGenerator::Plan(
   if (distance_approach_status) {
     ADEBUG << "Distance approach problem solved successfully!";
   } else {
+    if (is_stop_) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Open space trajectory generation cancelled");
+    }
     return Status(ErrorCode::PLANNING_ERROR,
                   "Distance approach problem failed to solve");
   }
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -100,8 +101,14 @@ class OpenSpaceTrajectoryGenerator {
                       const Eigen::MatrixXd& control_result_ds,
                       const Eigen::MatrixXd& time_result_ds);
 
+  /**
+   * @brief Cancels the trajectory generation in progress, called from
+   * another thread. Plan returns an error until Restart is called.
+   */
   void Stop();
 
+  void Restart();
+
   void RecordDebugInfo(const Eigen::MatrixXd& xWS, const Eigen::MatrixXd& uWs,
                        const Eigen::MatrixXd& l_warm_up,
                        const Eigen::MatrixXd& n_warm_up,
@@ -143,6 +150,8 @@ class OpenSpaceTrajectoryGenerator {
   std::vector<double> XYbounds_;
   apollo::common::Trajectory trajectory_to_end_;
   apollo::planning_internal::OpenSpaceDebug open_space_debug_;
+  // checked by the warm start and the smoothers while they run
+  std::atomic<bool> is_stop_{false};
 };
 
 }  // namespace planning
@@ -20,6 +20,8 @@
 
 #include "modules/planning/open_space/trajectory_smoother/distance_approach_ipopt_interface.h"
 
+#include <algorithm>
+
 namespace apollo {
 namespace planning {
 
@@ -404,8 +406,11 @@ bool DistanceApproachIPOPTInterface::get_starting_point(
   }
 
   // 2. time scale variable initialization, horizon_ + 1
+  const bool warm_start_time =
+      static_cast<int>(warm_start_.time_scaling.size()) == horizon_ + 1;
   for (int i = 0; i < horizon_ + 1; ++i) {
-    x[time_start_index_ + i] = 0.5;
+    x[time_start_index_ + i] =
+        warm_start_time ? warm_start_.time_scaling[i] : 0.5;
   }
 
   // 3. lagrange constraint l, obstacles_edges_sum_ * (horizon_+1)
@@ -423,6 +428,25 @@ bool DistanceApproachIPOPTInterface::get_starting_point(
       x[n_start_index_ + index + j] = n_warm_up_(j, i);
     }
   }
+
+  // 5. multipliers, only asked for with warm_start_init_point
+  if (init_z) {
+    if (static_cast<int>(warm_start_.z_L.size()) == n &&
+        static_cast<int>(warm_start_.z_U.size()) == n) {
+      std::copy(warm_start_.z_L.begin(), warm_start_.z_L.end(), z_L);
+      std::copy(warm_start_.z_U.begin(), warm_start_.z_U.end(), z_U);
+    } else {
+      std::fill(z_L, z_L + n, 1.0);
+      std::fill(z_U, z_U + n, 1.0);
+    }
+  }
+  if (init_lambda) {
+    if (static_cast<int>(warm_start_.lambda.size()) == m) {
+      std::copy(warm_start_.lambda.begin(), warm_start_.lambda.end(), lambda);
+    } else {
+      std::fill(lambda, lambda + m, 0.0);
+    }
+  }
   ADEBUG << "get_starting_point out";
   return true;
 }
@@ -1353,6 +1377,11 @@ void DistanceApproachIPOPTInterface::finalize_solution(
   state_result_(3, horizon_) = xf_(3, 0);
   time_result_(0, horizon_) = x[time_index];
   time_result_ = ts_ * time_result_;
+  warm_start_result_.time_scaling.assign(x + time_start_index_,
+                                         x + time_start_index_ + horizon_ + 1);
+  warm_start_result_.z_L.assign(z_L, z_L + n);
+  warm_start_result_.z_U.assign(z_U, z_U + n);
+  warm_start_result_.lambda.assign(lambda, lambda + m);
   for (int j = 0; j < obstacles_edges_sum_; j++) {
     dual_l_result_(j, horizon_) = x[dual_l_index + j];
   }
@@ -1368,6 +1397,14 @@ void DistanceApproachIPOPTInterface::finalize_solution(
   ADEBUG << "finalize_solution done!";
 }
 
+bool DistanceApproachIPOPTInterface::intermediate_callback(
+    Ipopt::AlgorithmMode mode, int iter, double obj_value, double inf_pr,
+    double inf_du, double mu, double d_norm, double regularization_size,
+    double alpha_du, double alpha_pr, int ls_trials,
+    const Ipopt::IpoptData* ip_data, Ipopt::IpoptCalculatedQuantities* ip_cq) {
+  return cancel_flag_ == nullptr || !cancel_flag_->load();
+}
+
 void DistanceApproachIPOPTInterface::get_optimization_results(
     Eigen::MatrixXd* state_result, Eigen::MatrixXd* control_result,
     Eigen::MatrixXd* time_result, Eigen::MatrixXd* dual_l_result,
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <vector>
 
@@ -48,6 +49,20 @@
 namespace apollo {
 namespace planning {
 
+/**
+ * @brief Time scaling and multipliers of a solved problem, so a later problem
+ * of the same size starts from them instead of the default initial point.
+ */
+struct DistanceApproachWarmStart {
+  // time scaling variables, horizon + 1
+  std::vector<double> time_scaling;
+  // multipliers of the variable bounds
+  std::vector<double> z_L;
+  std::vector<double> z_U;
+  // multipliers of the constraints
+  std::vector<double> lambda;
+};
+
 class DistanceApproachIPOPTInterface : public Ipopt::TNLP {
  public:
   explicit DistanceApproachIPOPTInterface(
@@ -110,12 +125,37 @@ class DistanceApproachIPOPTInterface : public Ipopt::TNLP {
                          double obj_value, const Ipopt::IpoptData* ip_data,
                          Ipopt::IpoptCalculatedQuantities* ip_cq) override;
 
+  /** This method is called every iteration, returning false stops the
+   * solver when the cancel flag is set */
+  bool intermediate_callback(
+      Ipopt::AlgorithmMode mode, int iter, double obj_value, double inf_pr,
+      double inf_du, double mu, double d_norm, double regularization_size,
+      double alpha_du, double alpha_pr, int ls_trials,
+      const Ipopt::IpoptData* ip_data,
+      Ipopt::IpoptCalculatedQuantities* ip_cq) override;
+
+  // the solve stops once the flag is set, nullptr never cancels
+  void set_cancel_flag(const std::atomic<bool>* cancel_flag) {
+    cancel_flag_ = cancel_flag;
+  }
+
   void get_optimization_results(Eigen::MatrixXd* state_result,
                                 Eigen::MatrixXd* control_result,
                                 Eigen::MatrixXd* time_result,
                                 Eigen::MatrixXd* dual_l_result,
                                 Eigen::MatrixXd* dual_n_result) const;
 
+  // warm start of the time scaling and, if ipopt asks for them, the
+  // multipliers; ignored when its size does not match the problem
+  void set_warm_start(const DistanceApproachWarmStart& warm_start) {
+    warm_start_ = warm_start;
+  }
+
+  // time scaling and multipliers of the last solution
+  const DistanceApproachWarmStart& warm_start_result() const {
+    return warm_start_result_;
+  }
+
   //***************    start ADOL-C part ***********************************
   /** Template to return the objective value */
   template <class T>
@@ -175,6 +215,9 @@ class DistanceApproachIPOPTInterface : public Ipopt::TNLP {
   Eigen::MatrixXd control_result_;
   Eigen::MatrixXd time_result_;
 
+  DistanceApproachWarmStart warm_start_;
+  DistanceApproachWarmStart warm_start_result_;
+
   // obstacles_A
   Eigen::MatrixXd obstacles_A_;
 
@@ -184,6 +227,8 @@ class DistanceApproachIPOPTInterface : public Ipopt::TNLP {
   // whether to use fix time
   bool use_fix_time_ = false;
 
+  const std::atomic<bool>* cancel_flag_ = nullptr;
+
   // state start index
   int state_start_index_ = 0;
 
@@ -40,67 +40,44 @@ bool DistanceApproachProblem::Solve(
     Eigen::MatrixXd* state_result, Eigen::MatrixXd* control_result,
     Eigen::MatrixXd* time_result, Eigen::MatrixXd* dual_l_result,
     Eigen::MatrixXd* dual_n_result) {
-  // TODO(QiL) : evaluate whether need to new it everytime
   auto t_start = cyber::Time::Now().ToSecond();
+  if (!InitializeApplication()) {
+    return false;
+  }
+
   DistanceApproachIPOPTInterface* ptop = new DistanceApproachIPOPTInterface(
       horizon, ts, ego, xWS, uWS, l_warm_up, n_warm_up, x0, xF, last_time_u,
       XYbounds, obstacles_edges_num, obstacles_num, obstacles_A, obstacles_b,
       planner_open_space_config_);
 
-  Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
-
-  // Create an instance of the IpoptApplication
-  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
-
-  app->Options()->SetIntegerValue("print_level",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_print_level());
-  app->Options()->SetIntegerValue("mumps_mem_percent",
-      planner_open_space_config_.distance_approach_config().
-        ipopt_config().mumps_mem_percent());
-  app->Options()->SetNumericValue("mumps_pivtol",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().mumps_pivtol());
-  app->Options()->SetIntegerValue("max_iter",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_max_iter());
-  app->Options()->SetNumericValue("tol",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_tol());
-  app->Options()->SetNumericValue("acceptable_constr_viol_tol",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_acceptable_constr_viol_tol());
-  app->Options()->SetNumericValue("min_hessian_perturbation",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_min_hessian_perturbation());
-  app->Options()->SetNumericValue("jacobian_regularization_value",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_jacobian_regularization_value());
-  app->Options()->SetStringValue("print_timing_statistics",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_print_timing_statistics());
-  app->Options()->SetStringValue("alpha_for_y",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_alpha_for_y());
-  app->Options()->SetStringValue("recalc_y",
-      planner_open_space_config_.distance_approach_config().\
-        ipopt_config().ipopt_recalc_y());
-
-  Ipopt::ApplicationReturnStatus status = app->Initialize();
-  if (status != Ipopt::Solve_Succeeded) {
-    AERROR << "*** Distiance Approach problem error during initialization!";
-    return false;
+  // the multipliers are only meaningful for a problem of the same size
+  const bool warm_start =
+      planner_open_space_config_.distance_approach_config()
+          .enable_warm_start_from_last_solution() &&
+      !last_solution_.time_scaling.empty() && horizon == last_horizon_ &&
+      obstacles_num == last_obstacles_num_ &&
+      obstacles_edges_num.rows() == last_obstacles_edges_num_.rows() &&
+      obstacles_edges_num.cols() == last_obstacles_edges_num_.cols() &&
+      obstacles_edges_num == last_obstacles_edges_num_;
+  ptop->set_cancel_flag(cancel_flag_);
+  if (warm_start) {
+    ptop->set_warm_start(last_solution_);
   }
+  app_->Options()->SetStringValue("warm_start_init_point",
+                                  warm_start ? "yes" : "no");
+  ADEBUG << "DistanceApproachProblem warm started: " << warm_start;
+
+  Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
 
-  status = app->OptimizeTNLP(problem);
+  Ipopt::ApplicationReturnStatus status = app_->OptimizeTNLP(problem);
 
   if (status == Ipopt::Solve_Succeeded ||
       status == Ipopt::Solved_To_Acceptable_Level) {
     // Retrieve some statistics about the solve
-    Ipopt::Index iter_count = app->Statistics()->IterationCount();
+    Ipopt::Index iter_count = app_->Statistics()->IterationCount();
     AINFO << "*** The problem solved in " << iter_count << " iterations!";
 
-    Ipopt::Number final_obj = app->Statistics()->FinalObjective();
+    Ipopt::Number final_obj = app_->Statistics()->FinalObjective();
     AINFO << "*** The final value of the objective function is " << final_obj
           << '.';
 
@@ -108,7 +85,13 @@ bool DistanceApproachProblem::Solve(
 
     AINFO << "DistanceApproachProblem solving time in second : "
           << t_end - t_start;
+
+    last_horizon_ = horizon;
+    last_obstacles_num_ = obstacles_num;
+    last_obstacles_edges_num_ = obstacles_edges_num;
+    last_solution_ = ptop->warm_start_result();
   } else {
+    last_solution_ = DistanceApproachWarmStart();
     AINFO << "Solve not succeeding, return status: " << int(status);
   }
 
@@ -119,5 +102,44 @@ bool DistanceApproachProblem::Solve(
          status == Ipopt::Solved_To_Acceptable_Level;
 }
 
+bool DistanceApproachProblem::InitializeApplication() {
+  if (Ipopt::IsValid(app_)) {
+    return true;
+  }
+  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
+  const auto& ipopt_config =
+      planner_open_space_config_.distance_approach_config().ipopt_config();
+
+  app->Options()->SetIntegerValue("print_level",
+                                  ipopt_config.ipopt_print_level());
+  app->Options()->SetIntegerValue("mumps_mem_percent",
+                                  ipopt_config.mumps_mem_percent());
+  app->Options()->SetNumericValue("mumps_pivtol", ipopt_config.mumps_pivtol());
+  app->Options()->SetIntegerValue("max_iter", ipopt_config.ipopt_max_iter());
+  app->Options()->SetNumericValue("tol", ipopt_config.ipopt_tol());
+  app->Options()->SetNumericValue(
+      "acceptable_constr_viol_tol",
+      ipopt_config.ipopt_acceptable_constr_viol_tol());
+  app->Options()->SetNumericValue(
+      "min_hessian_perturbation",
+      ipopt_config.ipopt_min_hessian_perturbation());
+  app->Options()->SetNumericValue(
+      "jacobian_regularization_value",
+      ipopt_config.ipopt_jacobian_regularization_value());
+  app->Options()->SetStringValue("print_timing_statistics",
+                                 ipopt_config.ipopt_print_timing_statistics());
+  app->Options()->SetStringValue("alpha_for_y",
+                                 ipopt_config.ipopt_alpha_for_y());
+  app->Options()->SetStringValue("recalc_y", ipopt_config.ipopt_recalc_y());
+
+  Ipopt::ApplicationReturnStatus status = app->Initialize();
+  if (status != Ipopt::Solve_Succeeded) {
+    AERROR << "*** Distiance Approach problem error during initialization!";
+    return false;
+  }
+  app_ = app;
+  return true;
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -55,8 +56,30 @@ class DistanceApproachProblem {
              Eigen::MatrixXd* control_result, Eigen::MatrixXd* time_result,
              Eigen::MatrixXd* dual_l_result, Eigen::MatrixXd* dual_n_result);
 
+  // a started solve stops once the flag is set, nullptr never cancels; the
+  // flag must outlive this object
+  void set_cancel_flag(const std::atomic<bool>* cancel_flag) {
+    cancel_flag_ = cancel_flag;
+  }
+
+ private:
+  // sets the options and initializes the ipopt application on the first
+  // solve, later solves reuse it
+  bool InitializeApplication();
+
  private:
   PlannerOpenSpaceConfig planner_open_space_config_;
+
+  Ipopt::SmartPtr<Ipopt::IpoptApplication> app_;
+
+  const std::atomic<bool>* cancel_flag_ = nullptr;
+
+  // problem size and solution of the last successful solve, used to warm
+  // start the next one
+  size_t last_horizon_ = 0;
+  size_t last_obstacles_num_ = 0;
+  Eigen::MatrixXi last_obstacles_edges_num_;
+  DistanceApproachWarmStart last_solution_;
 };
 
 }  // namespace planning
@@ -559,7 +559,7 @@ void DualVariableWarmStartIPOPTInterface::finalize_solution(
   // horizon_]
   for (int i = 0; i < horizon_ + 1; ++i) {
     for (int j = 0; j < obstacles_edges_sum_; ++j) {
-      l_warm_up_(0, i) = x[variable_index];
+      l_warm_up_(j, i) = x[variable_index];
       ++variable_index;
     }
   }
@@ -568,7 +568,7 @@ void DualVariableWarmStartIPOPTInterface::finalize_solution(
   // 2. lagrange constraint n, [0, 4*obstacles_num-1] * [0, horizon_]
   for (int i = 0; i < horizon_ + 1; ++i) {
     for (int j = 0; j < 4 * obstacles_num_; ++j) {
-      n_warm_up_(0, i) = x[variable_index];
+      n_warm_up_(j, i) = x[variable_index];
       ++variable_index;
     }
   }
@@ -581,6 +581,14 @@ void DualVariableWarmStartIPOPTInterface::finalize_solution(
   free(hessval);
 }
 
+bool DualVariableWarmStartIPOPTInterface::intermediate_callback(
+    Ipopt::AlgorithmMode mode, int iter, double obj_value, double inf_pr,
+    double inf_du, double mu, double d_norm, double regularization_size,
+    double alpha_du, double alpha_pr, int ls_trials,
+    const Ipopt::IpoptData* ip_data, Ipopt::IpoptCalculatedQuantities* ip_cq) {
+  return cancel_flag_ == nullptr || !cancel_flag_->load();
+}
+
 void DualVariableWarmStartIPOPTInterface::get_optimization_results(
     Eigen::MatrixXd* l_warm_up, Eigen::MatrixXd* n_warm_up) const {
   *l_warm_up = l_warm_up_;
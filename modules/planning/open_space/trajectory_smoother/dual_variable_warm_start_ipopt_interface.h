@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <vector>
 
@@ -102,6 +103,20 @@ class DualVariableWarmStartIPOPTInterface : public Ipopt::TNLP {
                          double obj_value, const Ipopt::IpoptData* ip_data,
                          Ipopt::IpoptCalculatedQuantities* ip_cq) override;
 
+  /** This method is called every iteration, returning false stops the
+   * solver when the cancel flag is set */
+  bool intermediate_callback(
+      Ipopt::AlgorithmMode mode, int iter, double obj_value, double inf_pr,
+      double inf_du, double mu, double d_norm, double regularization_size,
+      double alpha_du, double alpha_pr, int ls_trials,
+      const Ipopt::IpoptData* ip_data,
+      Ipopt::IpoptCalculatedQuantities* ip_cq) override;
+
+  // the solve stops once the flag is set, nullptr never cancels
+  void set_cancel_flag(const std::atomic<bool>* cancel_flag) {
+    cancel_flag_ = cancel_flag;
+  }
+
   //***************    start ADOL-C part ***********************************
   /** Template to return the objective value */
   template <class T>
@@ -157,6 +172,8 @@ class DualVariableWarmStartIPOPTInterface : public Ipopt::TNLP {
 
   double weight_d_;
 
+  const std::atomic<bool>* cancel_flag_ = nullptr;
+
   //***************    start ADOL-C part ***********************************
   double* obj_lam;
   unsigned int* rind_L; /* row indices    */
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/trajectory_smoother/dual_variable_warm_start_osqp_interface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// keeps the hessian positive definite where A' * lambda vanishes
+constexpr double kRegularization = 1e-6;
+
+// at the optimum ||A' * lambda|| is the distance between the ego box and the
+// obstacle, below this they overlap or touch and the dual variables of the
+// block are left at zero
+constexpr double kMinDualNorm = 1e-3;
+
+using SparseColumns = std::vector<std::vector<std::pair<c_int, c_float>>>;
+
+void ToCsc(const SparseColumns& columns, std::vector<c_float>* data,
+           std::vector<c_int>* indices, std::vector<c_int>* indptr) {
+  data->clear();
+  indices->clear();
+  indptr->clear();
+  for (const auto& column : columns) {
+    indptr->push_back(static_cast<c_int>(data->size()));
+    for (const auto& entry : column) {
+      indices->push_back(entry.first);
+      data->push_back(entry.second);
+    }
+  }
+  indptr->push_back(static_cast<c_int>(data->size()));
+}
+
+}  // namespace
+
+DualVariableWarmStartOSQPInterface::DualVariableWarmStartOSQPInterface(
+    size_t horizon, const Eigen::MatrixXd& ego,
+    const Eigen::MatrixXi& obstacles_edges_num, const size_t obstacles_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    const Eigen::MatrixXd& xWS)
+    : obstacles_edges_num_(obstacles_edges_num),
+      obstacles_A_(obstacles_A),
+      obstacles_b_(obstacles_b),
+      xWS_(xWS) {
+  CHECK(horizon < std::numeric_limits<int>::max())
+      << "Invalid cast on horizon in open space planner";
+  horizon_ = static_cast<int>(horizon);
+  CHECK(obstacles_num < std::numeric_limits<int>::max())
+      << "Invalid cast on obstacles_num in open space planner";
+  obstacles_num_ = static_cast<int>(obstacles_num);
+  const double w_ev = ego(1, 0) + ego(3, 0);
+  const double l_ev = ego(0, 0) + ego(2, 0);
+  g_ = {l_ev / 2, w_ev / 2, l_ev / 2, w_ev / 2};
+  offset_ = (ego(0, 0) + ego(2, 0)) / 2 - ego(2, 0);
+  obstacles_edges_sum_ = obstacles_edges_num_.sum();
+  l_start_index_ = 0;
+  n_start_index_ = l_start_index_ + obstacles_edges_sum_ * (horizon_ + 1);
+  num_of_variables_ = n_start_index_ + 4 * obstacles_num_ * (horizon_ + 1);
+  l_warm_up_ = Eigen::MatrixXd::Zero(obstacles_edges_sum_, horizon_ + 1);
+  n_warm_up_ = Eigen::MatrixXd::Zero(4 * obstacles_num_, horizon_ + 1);
+}
+
+bool DualVariableWarmStartOSQPInterface::Optimize(OsqpSolver* solver) {
+  CHECK_NOTNULL(solver);
+  if (num_of_variables_ == 0) {
+    return true;
+  }
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> q;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  FormulateProblem(&P_data, &P_indices, &P_indptr, &A_data, &A_indices,
+                   &A_indptr, &q, &lower_bounds, &upper_bounds);
+
+  if (!solver->Solve(P_data, P_indices, P_indptr, A_data, A_indices, A_indptr,
+                     q, lower_bounds, upper_bounds)) {
+    AERROR << "Failed to set up the dual variable warm start qp";
+    return false;
+  }
+  if (solver->status() != OSQP_SOLVED) {
+    AERROR << "Dual variable warm start qp not solved, osqp status: "
+           << solver->status();
+    return false;
+  }
+  SetResults(solver->primal());
+  return true;
+}
+
+void DualVariableWarmStartOSQPInterface::FormulateProblem(
+    std::vector<c_float>* P_data, std::vector<c_int>* P_indices,
+    std::vector<c_int>* P_indptr, std::vector<c_float>* A_data,
+    std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr,
+    std::vector<c_float>* q, std::vector<c_float>* lower_bounds,
+    std::vector<c_float>* upper_bounds) const {
+  // two equality constraints per block, then lambda >= 0 and mu >= 0
+  const int num_of_block_constraints = 2 * obstacles_num_ * (horizon_ + 1);
+  const int num_of_constraints = num_of_block_constraints + num_of_variables_;
+
+  SparseColumns P_columns(num_of_variables_);
+  SparseColumns A_columns(num_of_variables_);
+  q->assign(num_of_variables_, 0.0);
+  lower_bounds->assign(num_of_constraints, 0.0);
+  upper_bounds->assign(num_of_constraints, 0.0);
+
+  int l_index = l_start_index_;
+  int n_index = n_start_index_;
+  int constraint_index = 0;
+  for (int i = 0; i < horizon_ + 1; ++i) {
+    const double cos_phi = std::cos(xWS_(2, i));
+    const double sin_phi = std::sin(xWS_(2, i));
+    const double t_x = xWS_(0, i) + cos_phi * offset_;
+    const double t_y = xWS_(1, i) + sin_phi * offset_;
+    int edges_counter = 0;
+    for (int j = 0; j < obstacles_num_; ++j) {
+      const int current_edges_num = obstacles_edges_num_(j, 0);
+      for (int k = 0; k < current_edges_num; ++k) {
+        const double a_x = obstacles_A_(edges_counter + k, 0);
+        const double a_y = obstacles_A_(edges_counter + k, 1);
+        auto* P_column = &P_columns[l_index + k];
+        // 0.5 * ||A' * lambda||^2, the block of this obstacle
+        for (int h = 0; h < current_edges_num; ++h) {
+          double value = a_x * obstacles_A_(edges_counter + h, 0) +
+                         a_y * obstacles_A_(edges_counter + h, 1);
+          if (h == k) {
+            value += kRegularization;
+          }
+          P_column->emplace_back(l_index + h, value);
+        }
+        // max (A * t - b)' * lambda
+        (*q)[l_index + k] =
+            -(a_x * t_x + a_y * t_y - obstacles_b_(edges_counter + k, 0));
+        // R' * A' * lambda
+        A_columns[l_index + k].emplace_back(constraint_index,
+                                            cos_phi * a_x + sin_phi * a_y);
+        A_columns[l_index + k].emplace_back(constraint_index + 1,
+                                            -sin_phi * a_x + cos_phi * a_y);
+      }
+      for (int k = 0; k < 4; ++k) {
+        P_columns[n_index + k].emplace_back(n_index + k, kRegularization);
+        // max -g' * mu
+        (*q)[n_index + k] = g_[k];
+        // G' * mu, G = [I; -I]
+        A_columns[n_index + k].emplace_back(constraint_index + k % 2,
+                                            k < 2 ? 1.0 : -1.0);
+      }
+      edges_counter += current_edges_num;
+      l_index += current_edges_num;
+      n_index += 4;
+      constraint_index += 2;
+    }
+  }
+  CHECK_EQ(constraint_index, num_of_block_constraints);
+
+  for (int i = 0; i < num_of_variables_; ++i) {
+    A_columns[i].emplace_back(constraint_index + i, 1.0);
+    (*upper_bounds)[constraint_index + i] = OSQP_INFTY;
+  }
+
+  ToCsc(P_columns, P_data, P_indices, P_indptr);
+  ToCsc(A_columns, A_data, A_indices, A_indptr);
+}
+
+void DualVariableWarmStartOSQPInterface::SetResults(const c_float* solution) {
+  l_warm_up_.setZero();
+  n_warm_up_.setZero();
+  int l_index = l_start_index_;
+  int n_index = n_start_index_;
+  for (int i = 0; i < horizon_ + 1; ++i) {
+    int edges_counter = 0;
+    for (int j = 0; j < obstacles_num_; ++j) {
+      const int current_edges_num = obstacles_edges_num_(j, 0);
+      double tmp1 = 0.0;
+      double tmp2 = 0.0;
+      for (int k = 0; k < current_edges_num; ++k) {
+        const double lambda = std::max(0.0, solution[l_index + k]);
+        tmp1 += obstacles_A_(edges_counter + k, 0) * lambda;
+        tmp2 += obstacles_A_(edges_counter + k, 1) * lambda;
+      }
+      const double norm = std::hypot(tmp1, tmp2);
+      if (norm > kMinDualNorm) {
+        for (int k = 0; k < current_edges_num; ++k) {
+          l_warm_up_(edges_counter + k, i) =
+              std::max(0.0, solution[l_index + k]) / norm;
+        }
+        for (int k = 0; k < 4; ++k) {
+          n_warm_up_(4 * j + k, i) =
+              std::max(0.0, solution[n_index + k]) / norm;
+        }
+      }
+      edges_counter += current_edges_num;
+      l_index += current_edges_num;
+      n_index += 4;
+    }
+  }
+}
+
+void DualVariableWarmStartOSQPInterface::get_optimization_results(
+    Eigen::MatrixXd* l_warm_up, Eigen::MatrixXd* n_warm_up) const {
+  *l_warm_up = l_warm_up_;
+  *n_warm_up = n_warm_up_;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/planning/math/osqp_solver.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class DualVariableWarmStartOSQPInterface
+ * @brief Dual variable warm start as one sparse qp, block diagonal over the
+ * time steps and obstacles:
+ *   max (A * t - b)' * lambda - g' * mu - 0.5 * ||A' * lambda||^2
+ *   s.t. G' * mu + R' * A' * lambda = 0, lambda >= 0, mu >= 0
+ * Each block is scaled to ||A' * lambda|| = 1 afterwards, which makes
+ * (A * t - b)' * lambda - g' * mu the distance between the ego box and the
+ * obstacle, the same dual variables the ipopt formulation looks for.
+ */
+class DualVariableWarmStartOSQPInterface {
+ public:
+  DualVariableWarmStartOSQPInterface(
+      size_t horizon, const Eigen::MatrixXd& ego,
+      const Eigen::MatrixXi& obstacles_edges_num, const size_t obstacles_num,
+      const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+      const Eigen::MatrixXd& xWS);
+
+  virtual ~DualVariableWarmStartOSQPInterface() = default;
+
+  /**
+   * @brief Solves the qp with the given solver, whose workspace is reused
+   * when the number of obstacles, edges and time steps is unchanged.
+   */
+  bool Optimize(OsqpSolver* solver);
+
+  void get_optimization_results(Eigen::MatrixXd* l_warm_up,
+                                Eigen::MatrixXd* n_warm_up) const;
+
+ private:
+  void FormulateProblem(std::vector<c_float>* P_data,
+                        std::vector<c_int>* P_indices,
+                        std::vector<c_int>* P_indptr,
+                        std::vector<c_float>* A_data,
+                        std::vector<c_int>* A_indices,
+                        std::vector<c_int>* A_indptr, std::vector<c_float>* q,
+                        std::vector<c_float>* lower_bounds,
+                        std::vector<c_float>* upper_bounds) const;
+
+  void SetResults(const c_float* solution);
+
+ private:
+  int horizon_ = 0;
+  int obstacles_num_ = 0;
+  int obstacles_edges_sum_ = 0;
+  Eigen::MatrixXi obstacles_edges_num_;
+  Eigen::MatrixXd obstacles_A_;
+  Eigen::MatrixXd obstacles_b_;
+  Eigen::MatrixXd xWS_;
+  std::vector<double> g_;
+  double offset_ = 0.0;
+
+  // lagrangian l start index, lagrangian n follows it
+  int l_start_index_ = 0;
+  int n_start_index_ = 0;
+  int num_of_variables_ = 0;
+
+  Eigen::MatrixXd l_warm_up_;
+  Eigen::MatrixXd n_warm_up_;
+};
+
+}  // namespace planning
+}  // namespace apollo
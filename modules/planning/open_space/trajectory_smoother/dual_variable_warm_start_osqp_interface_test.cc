@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/trajectory_smoother/dual_variable_warm_start_osqp_interface.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+class DualVariableWarmStartOSQPInterfaceTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    OSQPSettings settings;
+    osqp_set_default_settings(&settings);
+    settings.polish = true;
+    settings.verbose = false;
+    solver_.reset(new OsqpSolver(settings));
+
+    // a 2m x 2m ego box centered at the rear axle
+    ego_ = Eigen::MatrixXd::Ones(4, 1);
+    obstacles_edges_num_ = 4 * Eigen::MatrixXi::Ones(obstacles_num_, 1);
+    // the square [3, 4] x [-0.5, 0.5] as A * x <= b
+    obstacles_A_ = Eigen::MatrixXd(4, 2);
+    obstacles_A_ << 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0;
+    obstacles_b_ = Eigen::MatrixXd(4, 1);
+    obstacles_b_ << 4.0, 0.5, -3.0, 0.5;
+  }
+
+ protected:
+  size_t horizon_ = 2;
+  size_t obstacles_num_ = 1;
+  Eigen::MatrixXd ego_;
+  Eigen::MatrixXi obstacles_edges_num_;
+  Eigen::MatrixXd obstacles_A_;
+  Eigen::MatrixXd obstacles_b_;
+  std::unique_ptr<OsqpSolver> solver_;
+};
+
+TEST_F(DualVariableWarmStartOSQPInterfaceTest, separated) {
+  // the ego box stays at the origin heading to the obstacle, 2m away
+  Eigen::MatrixXd xWS = Eigen::MatrixXd::Zero(4, horizon_ + 1);
+  DualVariableWarmStartOSQPInterface qp(horizon_, ego_, obstacles_edges_num_,
+                                        obstacles_num_, obstacles_A_,
+                                        obstacles_b_, xWS);
+  ASSERT_TRUE(qp.Optimize(solver_.get()));
+  Eigen::MatrixXd l_warm_up;
+  Eigen::MatrixXd n_warm_up;
+  qp.get_optimization_results(&l_warm_up, &n_warm_up);
+  ASSERT_EQ(4, l_warm_up.rows());
+  ASSERT_EQ(4, n_warm_up.rows());
+  ASSERT_EQ(static_cast<int>(horizon_) + 1, l_warm_up.cols());
+
+  for (size_t i = 0; i < horizon_ + 1; ++i) {
+    // only the edge facing the ego box and the ego front are active
+    EXPECT_NEAR(1.0, l_warm_up(2, i), 1e-2);
+    EXPECT_NEAR(1.0, n_warm_up(0, i), 1e-2);
+    // the distance of the dual variables is the distance of the boxes
+    double distance = 0.0;
+    for (int k = 0; k < 4; ++k) {
+      distance -= obstacles_b_(k, 0) * l_warm_up(k, i);
+      distance -= n_warm_up(k, i);
+    }
+    EXPECT_NEAR(2.0, distance, 1e-2);
+  }
+
+  // same problem size, the workspace is kept
+  ASSERT_TRUE(qp.Optimize(solver_.get()));
+  EXPECT_TRUE(solver_->workspace_reused());
+}
+
+TEST_F(DualVariableWarmStartOSQPInterfaceTest, overlapping) {
+  // the ego box is on top of the obstacle
+  Eigen::MatrixXd xWS = Eigen::MatrixXd::Zero(4, horizon_ + 1);
+  xWS.row(0).setConstant(3.5);
+  DualVariableWarmStartOSQPInterface qp(horizon_, ego_, obstacles_edges_num_,
+                                        obstacles_num_, obstacles_A_,
+                                        obstacles_b_, xWS);
+  ASSERT_TRUE(qp.Optimize(solver_.get()));
+  Eigen::MatrixXd l_warm_up;
+  Eigen::MatrixXd n_warm_up;
+  qp.get_optimization_results(&l_warm_up, &n_warm_up);
+  EXPECT_NEAR(0.0, l_warm_up.cwiseAbs().sum(), 1e-6);
+  EXPECT_NEAR(0.0, n_warm_up.cwiseAbs().sum(), 1e-6);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -25,6 +25,7 @@
 
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/open_space/trajectory_smoother/dual_variable_warm_start_osqp_interface.h"
 
 namespace apollo {
 namespace planning {
@@ -40,62 +41,48 @@ bool DualVariableWarmStartProblem::Solve(
     const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
     const Eigen::MatrixXd& xWS, Eigen::MatrixXd* l_warm_up,
     Eigen::MatrixXd* n_warm_up) {
+  if (SolveWithIpopt(horizon, ts, ego, obstacles_num, obstacles_edges_num,
+                     obstacles_A, obstacles_b, xWS, l_warm_up, n_warm_up)) {
+    return true;
+  }
+  if (!planner_open_space_config_.dual_variable_warm_start_config()
+           .use_osqp_fallback() ||
+      (cancel_flag_ != nullptr && cancel_flag_->load())) {
+    return false;
+  }
+  AWARN << "Dual variable warm start falls back to osqp";
+  return SolveWithOsqp(horizon, ego, obstacles_num, obstacles_edges_num,
+                       obstacles_A, obstacles_b, xWS, l_warm_up, n_warm_up);
+}
+
+bool DualVariableWarmStartProblem::SolveWithIpopt(
+    const size_t horizon, const double ts, const Eigen::MatrixXd& ego,
+    const size_t obstacles_num, const Eigen::MatrixXi& obstacles_edges_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    const Eigen::MatrixXd& xWS, Eigen::MatrixXd* l_warm_up,
+    Eigen::MatrixXd* n_warm_up) {
   auto t_start = cyber::Time::Now().ToSecond();
+  if (!InitializeApplication()) {
+    return false;
+  }
+
   DualVariableWarmStartIPOPTInterface* ptop =
       new DualVariableWarmStartIPOPTInterface(
           horizon, ts, ego, obstacles_edges_num, obstacles_num, obstacles_A,
           obstacles_b, xWS, planner_open_space_config_);
+  ptop->set_cancel_flag(cancel_flag_);
 
   Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
 
-  // Create an instance of the IpoptApplication
-  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
-
-  app->Options()->SetIntegerValue("print_level", planner_open_space_config_.
-      dual_variable_warm_start_config().ipopt_config().ipopt_print_level());
-  app->Options()->SetIntegerValue("mumps_mem_percent",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().mumps_mem_percent());
-  app->Options()->SetNumericValue("mumps_pivtol", planner_open_space_config_.
-      dual_variable_warm_start_config().ipopt_config().mumps_pivtol());
-  app->Options()->SetIntegerValue("max_iter", planner_open_space_config_.
-      dual_variable_warm_start_config().ipopt_config().ipopt_max_iter());
-  app->Options()->SetNumericValue("tol", planner_open_space_config_.
-      dual_variable_warm_start_config().ipopt_config().ipopt_tol());
-  app->Options()->SetNumericValue("acceptable_constr_viol_tol",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().ipopt_acceptable_constr_viol_tol());
-  app->Options()->SetNumericValue("min_hessian_perturbation",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().ipopt_min_hessian_perturbation());
-  app->Options()->SetNumericValue("jacobian_regularization_value",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().ipopt_jacobian_regularization_value());
-  app->Options()->SetStringValue("print_timing_statistics",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().ipopt_print_timing_statistics());
-  app->Options()->SetStringValue("alpha_for_y",
-      planner_open_space_config_.dual_variable_warm_start_config().
-      ipopt_config().ipopt_alpha_for_y());
-  app->Options()->SetStringValue("recalc_y", planner_open_space_config_.
-      dual_variable_warm_start_config().ipopt_config().ipopt_recalc_y());
-
-  Ipopt::ApplicationReturnStatus status = app->Initialize();
-  if (status != Ipopt::Solve_Succeeded) {
-    AERROR
-        << "*** Dual variable wart start problem error during initialization!";
-    return false;
-  }
-
-  status = app->OptimizeTNLP(problem);
+  Ipopt::ApplicationReturnStatus status = app_->OptimizeTNLP(problem);
 
   if (status == Ipopt::Solve_Succeeded ||
       status == Ipopt::Solved_To_Acceptable_Level) {
     // Retrieve some statistics about the solve
-    Ipopt::Index iter_count = app->Statistics()->IterationCount();
+    Ipopt::Index iter_count = app_->Statistics()->IterationCount();
     AINFO << "*** The problem solved in " << iter_count << " iterations!";
 
-    Ipopt::Number final_obj = app->Statistics()->FinalObjective();
+    Ipopt::Number final_obj = app_->Statistics()->FinalObjective();
     AINFO << "*** The final value of the objective function is " << final_obj
           << '.';
     auto t_end = cyber::Time::Now().ToSecond();
@@ -112,5 +99,75 @@ bool DualVariableWarmStartProblem::Solve(
          status == Ipopt::Solved_To_Acceptable_Level;
 }
 
+bool DualVariableWarmStartProblem::SolveWithOsqp(
+    const size_t horizon, const Eigen::MatrixXd& ego,
+    const size_t obstacles_num, const Eigen::MatrixXi& obstacles_edges_num,
+    const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
+    const Eigen::MatrixXd& xWS, Eigen::MatrixXd* l_warm_up,
+    Eigen::MatrixXd* n_warm_up) {
+  auto t_start = cyber::Time::Now().ToSecond();
+  if (osqp_solver_ == nullptr) {
+    OSQPSettings settings;
+    osqp_set_default_settings(&settings);
+    settings.polish = true;
+    settings.verbose = false;
+    osqp_solver_.reset(new OsqpSolver(settings));
+  }
+
+  DualVariableWarmStartOSQPInterface qp(horizon, ego, obstacles_edges_num,
+                                        obstacles_num, obstacles_A,
+                                        obstacles_b, xWS);
+  if (!qp.Optimize(osqp_solver_.get())) {
+    return false;
+  }
+  qp.get_optimization_results(l_warm_up, n_warm_up);
+
+  auto t_end = cyber::Time::Now().ToSecond();
+  AINFO << "Dual vairable warm start osqp solving time in second : "
+        << t_end - t_start;
+  return true;
+}
+
+bool DualVariableWarmStartProblem::InitializeApplication() {
+  if (Ipopt::IsValid(app_)) {
+    return true;
+  }
+  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
+  const auto& ipopt_config = planner_open_space_config_
+                                 .dual_variable_warm_start_config()
+                                 .ipopt_config();
+
+  app->Options()->SetIntegerValue("print_level",
+                                  ipopt_config.ipopt_print_level());
+  app->Options()->SetIntegerValue("mumps_mem_percent",
+                                  ipopt_config.mumps_mem_percent());
+  app->Options()->SetNumericValue("mumps_pivtol", ipopt_config.mumps_pivtol());
+  app->Options()->SetIntegerValue("max_iter", ipopt_config.ipopt_max_iter());
+  app->Options()->SetNumericValue("tol", ipopt_config.ipopt_tol());
+  app->Options()->SetNumericValue(
+      "acceptable_constr_viol_tol",
+      ipopt_config.ipopt_acceptable_constr_viol_tol());
+  app->Options()->SetNumericValue(
+      "min_hessian_perturbation",
+      ipopt_config.ipopt_min_hessian_perturbation());
+  app->Options()->SetNumericValue(
+      "jacobian_regularization_value",
+      ipopt_config.ipopt_jacobian_regularization_value());
+  app->Options()->SetStringValue("print_timing_statistics",
+                                 ipopt_config.ipopt_print_timing_statistics());
+  app->Options()->SetStringValue("alpha_for_y",
+                                 ipopt_config.ipopt_alpha_for_y());
+  app->Options()->SetStringValue("recalc_y", ipopt_config.ipopt_recalc_y());
+
+  Ipopt::ApplicationReturnStatus status = app->Initialize();
+  if (status != Ipopt::Solve_Succeeded) {
+    AERROR
+        << "*** Dual variable wart start problem error during initialization!";
+    return false;
+  }
+  app_ = app;
+  return true;
+}
+
 }  // namespace planning
 }  // namespace apollo
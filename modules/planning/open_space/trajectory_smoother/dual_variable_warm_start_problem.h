@@ -20,8 +20,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "Eigen/Dense"
+#include "IpIpoptApplication.hpp"
 
+#include "modules/planning/math/osqp_solver.h"
 #include "modules/planning/open_space/trajectory_smoother/dual_variable_warm_start_ipopt_interface.h"
 #include "modules/planning/proto/planning.pb.h"
 
@@ -42,8 +47,42 @@ class DualVariableWarmStartProblem {
              const Eigen::MatrixXd& obstacles_b, const Eigen::MatrixXd& xWS,
              Eigen::MatrixXd* l_warm_up, Eigen::MatrixXd* n_warm_up);
 
+  // a started solve stops once the flag is set, nullptr never cancels; the
+  // flag must outlive this object
+  void set_cancel_flag(const std::atomic<bool>* cancel_flag) {
+    cancel_flag_ = cancel_flag;
+  }
+
+ private:
+  // sets the options and initializes the ipopt application on the first
+  // solve, later solves reuse it
+  bool InitializeApplication();
+
+  bool SolveWithIpopt(const size_t horizon, const double ts,
+                      const Eigen::MatrixXd& ego, const size_t obstacles_num,
+                      const Eigen::MatrixXi& obstacles_edges_num,
+                      const Eigen::MatrixXd& obstacles_A,
+                      const Eigen::MatrixXd& obstacles_b,
+                      const Eigen::MatrixXd& xWS, Eigen::MatrixXd* l_warm_up,
+                      Eigen::MatrixXd* n_warm_up);
+
+  bool SolveWithOsqp(const size_t horizon, const Eigen::MatrixXd& ego,
+                     const size_t obstacles_num,
+                     const Eigen::MatrixXi& obstacles_edges_num,
+                     const Eigen::MatrixXd& obstacles_A,
+                     const Eigen::MatrixXd& obstacles_b,
+                     const Eigen::MatrixXd& xWS, Eigen::MatrixXd* l_warm_up,
+                     Eigen::MatrixXd* n_warm_up);
+
  private:
   PlannerOpenSpaceConfig planner_open_space_config_;
+
+  Ipopt::SmartPtr<Ipopt::IpoptApplication> app_;
+
+  const std::atomic<bool>* cancel_flag_ = nullptr;
+
+  // keeps the qp workspace between solves of the same size
+  std::unique_ptr<OsqpSolver> osqp_solver_;
 };
 
 }  // namespace planning
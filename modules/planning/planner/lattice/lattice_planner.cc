@@ -20,6 +20,7 @@
 
 #include "modules/planning/planner/lattice/lattice_planner.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -27,6 +28,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
@@ -54,6 +56,38 @@ using apollo::common::time::Clock;
 
 namespace {
 
+// A trajectory pair taken from the evaluator in the order of cost.
+struct Candidate {
+  double cost = 0.0;
+  std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>
+      trajectory_pair;
+  DiscretizedTrajectory combined_trajectory;
+  ConstraintChecker::Result result = ConstraintChecker::Result::VALID;
+  bool in_collision = false;
+};
+
+void CheckCandidate(const std::vector<PathPoint>& reference_line,
+                    const double init_relative_time,
+                    const CollisionChecker& collision_checker,
+                    Candidate* candidate) {
+  // combine two 1d trajectories to one 2d trajectory
+  candidate->combined_trajectory = TrajectoryCombiner::Combine(
+      reference_line, *candidate->trajectory_pair.first,
+      *candidate->trajectory_pair.second, init_relative_time);
+
+  // check longitudinal and lateral acceleration
+  // considering trajectory curvatures
+  candidate->result =
+      ConstraintChecker::ValidTrajectory(candidate->combined_trajectory);
+  if (candidate->result != ConstraintChecker::Result::VALID) {
+    return;
+  }
+
+  // check collision with other obstacles
+  candidate->in_collision =
+      collision_checker.InCollision(candidate->combined_trajectory);
+}
+
 std::vector<PathPoint> ToDiscretizedReferenceLine(
     const std::vector<ReferencePoint>& ref_points) {
   double s = 0.0;
@@ -231,19 +265,40 @@ Status LatticePlanner::PlanOnReferenceLine(
 
   size_t num_lattice_traj = 0;
 
-  while (trajectory_evaluator.has_more_trajectory_pairs()) {
-    double trajectory_pair_cost =
-        trajectory_evaluator.top_trajectory_pair_cost();
-    auto trajectory_pair = trajectory_evaluator.next_top_trajectory_pair();
-
-    // combine two 1d trajectories to one 2d trajectory
-    auto combined_trajectory = TrajectoryCombiner::Combine(
-        *ptr_reference_line, *trajectory_pair.first, *trajectory_pair.second,
-        planning_init_point.relative_time());
+  // the best pairs are combined and checked a batch at a time, then
+  // consumed in the order of cost, so the first valid one is still chosen.
+  const size_t batch_size =
+      FLAGS_enable_multi_thread_in_lattice_planner
+          ? static_cast<size_t>(
+                std::max(1, FLAGS_lattice_evaluation_batch_size))
+          : 1;
+  std::vector<Candidate> candidates;
+  size_t next_candidate = 0;
+  while (next_candidate < candidates.size() ||
+         trajectory_evaluator.has_more_trajectory_pairs()) {
+    if (next_candidate == candidates.size()) {
+      candidates.clear();
+      next_candidate = 0;
+      while (candidates.size() < batch_size &&
+             trajectory_evaluator.has_more_trajectory_pairs()) {
+        candidates.emplace_back();
+        candidates.back().cost =
+            trajectory_evaluator.top_trajectory_pair_cost();
+        candidates.back().trajectory_pair =
+            trajectory_evaluator.next_top_trajectory_pair();
+      }
+      cyber::ParallelFor(0, candidates.size(), 1, [&](size_t i) {
+        CheckCandidate(*ptr_reference_line,
+                       planning_init_point.relative_time(), collision_checker,
+                       &candidates[i]);
+      });
+    }
+    const auto& candidate = candidates[next_candidate++];
+    double trajectory_pair_cost = candidate.cost;
+    const auto& trajectory_pair = candidate.trajectory_pair;
+    const auto& combined_trajectory = candidate.combined_trajectory;
 
-    // check longitudinal and lateral acceleration
-    // considering trajectory curvatures
-    auto result = ConstraintChecker::ValidTrajectory(combined_trajectory);
+    auto result = candidate.result;
     if (result != ConstraintChecker::Result::VALID) {
       ++combined_constraint_failure_count;
 
@@ -274,8 +329,7 @@ Status LatticePlanner::PlanOnReferenceLine(
       continue;
     }
 
-    // check collision with other obstacles
-    if (collision_checker.InCollision(combined_trajectory)) {
+    if (candidate.in_collision) {
       ++collision_failure_count;
       continue;
     }
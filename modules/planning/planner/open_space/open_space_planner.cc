@@ -20,8 +20,12 @@
 
 #include "modules/planning/planner/open_space/open_space_planner.h"
 
+#include <cmath>
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "cyber/task/task.h"
+#include "modules/common/math/math_utils.h"
 #include "modules/common/util/string_tokenizer.h"
 #include "modules/planning/common/planning_gflags.h"
 
@@ -30,6 +34,55 @@ namespace planning {
 
 using apollo::common::ErrorCode;
 
+namespace {
+
+// the planning thread drops its plan if the region of interest moves more
+// than this, in meters and radians
+constexpr double kRoiChangeTolerance = 0.1;
+
+bool IsClose(const std::vector<double>& lhs, const std::vector<double>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (std::fabs(lhs[i] - rhs[i]) > kRoiChangeTolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsRoiChanged(const OpenSpaceThreadData& last,
+                  const OpenSpaceThreadData& current) {
+  if (std::fabs(common::math::NormalizeAngle(current.rotate_angle -
+                                             last.rotate_angle)) >
+          kRoiChangeTolerance ||
+      current.translate_origin.DistanceTo(last.translate_origin) >
+          kRoiChangeTolerance ||
+      !IsClose(last.end_pose, current.end_pose) ||
+      !IsClose(last.XYbounds, current.XYbounds) ||
+      last.obstacles_vertices_vec.size() !=
+          current.obstacles_vertices_vec.size()) {
+    return true;
+  }
+  for (size_t i = 0; i < current.obstacles_vertices_vec.size(); ++i) {
+    const auto& last_vertices = last.obstacles_vertices_vec[i];
+    const auto& current_vertices = current.obstacles_vertices_vec[i];
+    if (last_vertices.size() != current_vertices.size()) {
+      return true;
+    }
+    for (size_t j = 0; j < current_vertices.size(); ++j) {
+      if (current_vertices[j].DistanceTo(last_vertices[j]) >
+          kRoiChangeTolerance) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 Status OpenSpacePlanner::Init(const PlanningConfig& planning_confgs) {
   AINFO << "In OpenSpacePlanner::Init()";
 
@@ -65,40 +118,56 @@ apollo::common::Status OpenSpacePlanner::Plan(
                     "Generate Open Space ROI failed");
     }
 
-    {
-      std::lock_guard<std::mutex> lock(open_space_mutex_);
-      thread_data_.stitching_trajectory = stitching_trajectory;
-      thread_data_.vehicle_state = frame->vehicle_state();
-      thread_data_.rotate_angle = open_space_roi_generator_->origin_heading();
-      thread_data_.translate_origin = open_space_roi_generator_->origin_point();
-      thread_data_.end_pose = open_space_roi_generator_->open_space_end_pose();
-      thread_data_.obstacles_edges_num =
-          open_space_roi_generator_->obstacles_edges_num();
-      thread_data_.obstacles_A = open_space_roi_generator_->obstacles_A();
-      thread_data_.obstacles_b = open_space_roi_generator_->obstacles_b();
-      thread_data_.obstacles_vertices_vec =
-          open_space_roi_generator_->obstacles_vertices_vec();
-      thread_data_.XYbounds = open_space_roi_generator_->ROI_xy_boundary();
-    }
+    OpenSpaceThreadData thread_data;
+    thread_data.stitching_trajectory = stitching_trajectory;
+    thread_data.vehicle_state = frame->vehicle_state();
+    thread_data.rotate_angle = open_space_roi_generator_->origin_heading();
+    thread_data.translate_origin = open_space_roi_generator_->origin_point();
+    thread_data.end_pose = open_space_roi_generator_->open_space_end_pose();
+    thread_data.obstacles_edges_num =
+        open_space_roi_generator_->obstacles_edges_num();
+    thread_data.obstacles_A = open_space_roi_generator_->obstacles_A();
+    thread_data.obstacles_b = open_space_roi_generator_->obstacles_b();
+    thread_data.obstacles_vertices_vec =
+        open_space_roi_generator_->obstacles_vertices_vec();
+    thread_data.XYbounds = open_space_roi_generator_->ROI_xy_boundary();
 
     // check vehicle state
     if (IsVehicleNearDestination(
-            thread_data_.vehicle_state, thread_data_.end_pose,
-            thread_data_.rotate_angle, thread_data_.translate_origin)) {
+            thread_data.vehicle_state, thread_data.end_pose,
+            thread_data.rotate_angle, thread_data.translate_origin)) {
       return Status(ErrorCode::OK, "Vehicle is near to destination");
     }
 
+    {
+      std::lock_guard<std::mutex> lock(open_space_mutex_);
+      // a plan in progress on a region of interest that has moved is
+      // useless, it is cancelled so the new inputs are picked up right away.
+      // Stop under the lock, the planning thread restarts the generator
+      // under it before taking the inputs.
+      if (thread_data_.version > 0 && IsRoiChanged(thread_data_, thread_data)) {
+        ADEBUG << "Open space region of interest changed, cancel planning";
+        open_space_trajectory_generator_->Stop();
+      }
+      thread_data.version = thread_data_.version + 1;
+      thread_data_ = std::move(thread_data);
+    }
+    input_updated_.notify_one();
+
     // Check if trajectory updated
     if (trajectory_updated_) {
-      std::lock_guard<std::mutex> lock(open_space_mutex_);
-      // if (open_space_trajectory_generator_->end_pose() ==
-      //     thread_data_.end_pose) {
-      open_space_trajectory_generator_->UpdateTrajectory(&trajectory_to_end_);
-      open_space_trajectory_generator_->UpdateDebugInfo(&open_space_debug_);
-      open_space_trajectory_generator_->GetStitchingTrajectory(
-          &stitching_trajectory_);
+      OpenSpaceResultData result_data;
+      {
+        std::lock_guard<std::mutex> lock(open_space_mutex_);
+        std::swap(result_data, result_data_);
+        trajectory_updated_.store(false);
+      }
+      ADEBUG << "Load trajectory planned from inputs of version "
+             << result_data.version;
+      trajectory_to_end_ = std::move(result_data.trajectory_to_end);
+      open_space_debug_ = std::move(result_data.open_space_debug);
+      stitching_trajectory_ = std::move(result_data.stitching_trajectory);
       LoadTrajectoryToFrame(frame);
-      trajectory_updated_.store(false);
       return Status::OK();
     }
 
@@ -156,30 +225,54 @@ void OpenSpacePlanner::GenerateTrajectoryThread() {
   while (!is_stop_) {
     OpenSpaceThreadData thread_data;
     {
-      std::lock_guard<std::mutex> lock(open_space_mutex_);
+      std::unique_lock<std::mutex> lock(open_space_mutex_);
+      input_updated_.wait(lock, [this] {
+        return is_stop_ || thread_data_.version != planned_version_;
+      });
+      if (is_stop_) {
+        break;
+      }
+      open_space_trajectory_generator_->Restart();
       thread_data = thread_data_;
+      planned_version_ = thread_data.version;
     }
-    if (!trajectory_updated_) {
-      Status status = open_space_trajectory_generator_->Plan(
-          thread_data.stitching_trajectory, thread_data.vehicle_state,
-          thread_data.XYbounds, thread_data.rotate_angle,
-          thread_data.translate_origin, thread_data.end_pose,
-          thread_data.obstacles_edges_num, thread_data.obstacles_A,
-          thread_data.obstacles_b, thread_data_.obstacles_vertices_vec);
-      if (status == Status::OK()) {
-        trajectory_updated_.store(true);
-      } else {
-        AERROR_EVERY(200)
-            << "Multi-thread trajectory generator not OK with return satus : "
-            << status.ToString();
-      }
+    Status status = open_space_trajectory_generator_->Plan(
+        thread_data.stitching_trajectory, thread_data.vehicle_state,
+        thread_data.XYbounds, thread_data.rotate_angle,
+        thread_data.translate_origin, thread_data.end_pose,
+        thread_data.obstacles_edges_num, thread_data.obstacles_A,
+        thread_data.obstacles_b, thread_data.obstacles_vertices_vec);
+    if (status == Status::OK()) {
+      // the back buffer, only this thread uses the generator outputs
+      OpenSpaceResultData result_data;
+      open_space_trajectory_generator_->UpdateTrajectory(
+          &result_data.trajectory_to_end);
+      open_space_trajectory_generator_->UpdateDebugInfo(
+          &result_data.open_space_debug);
+      open_space_trajectory_generator_->GetStitchingTrajectory(
+          &result_data.stitching_trajectory);
+      result_data.version = thread_data.version;
+      std::lock_guard<std::mutex> lock(open_space_mutex_);
+      std::swap(result_data, result_data_);
+      trajectory_updated_.store(true);
+    } else {
+      AERROR_EVERY(200)
+          << "Multi-thread trajectory generator not OK with return satus : "
+          << status.ToString();
     }
   }
 }
 
 void OpenSpacePlanner::Stop() {
-  is_stop_ = true;
+  {
+    std::lock_guard<std::mutex> lock(open_space_mutex_);
+    is_stop_ = true;
+    if (open_space_trajectory_generator_ != nullptr) {
+      open_space_trajectory_generator_->Stop();
+    }
+  }
   if (FLAGS_enable_open_space_planner_thread) {
+    input_updated_.notify_one();
     task_future_.get();
   }
 }
@@ -20,7 +20,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -61,6 +66,16 @@ struct OpenSpaceThreadData {
   Eigen::MatrixXd obstacles_b;
   std::vector<double> XYbounds;
   std::vector<std::vector<common::math::Vec2d>> obstacles_vertices_vec;
+  // increased on every update of the inputs
+  uint64_t version = 0;
+};
+
+// trajectory generated by the planning thread from the inputs of version
+struct OpenSpaceResultData {
+  apollo::common::Trajectory trajectory_to_end;
+  planning_internal::OpenSpaceDebug open_space_debug;
+  std::vector<common::TrajectoryPoint> stitching_trajectory;
+  uint64_t version = 0;
 };
 
 /**
@@ -134,7 +149,14 @@ class OpenSpacePlanner : public Planner {
   apollo::common::Trajectory trajectory_to_end_;
   apollo::planning::ADCTrajectory trajectory_to_end_pb_;
 
+  // inputs written by Plan and taken by the planning thread, which is woken
+  // up by input_updated_ and plans every version at most once
   OpenSpaceThreadData thread_data_;
+  std::condition_variable input_updated_;
+  uint64_t planned_version_ = 0;
+  // results are generated into a back buffer by the planning thread and
+  // swapped in here, Plan swaps them out again
+  OpenSpaceResultData result_data_;
   std::future<void> task_future_;
   std::atomic<bool> is_stop_{false};
   std::atomic<bool> trajectory_updated_{false};
@@ -128,17 +128,19 @@ bool PlanningComponent::Proc(
     return false;
   }
 
-  ADCTrajectory adc_trajectory_pb;
-  planning_base_->RunOnce(local_view_, &adc_trajectory_pb);
-  auto start_time = adc_trajectory_pb.header().timestamp_sec();
-  common::util::FillHeader(node_->Name(), &adc_trajectory_pb);
+  // planned straight into the published message, the readers share it, so
+  // a new one is made every cycle instead of copying a reused one
+  auto adc_trajectory_pb = std::make_shared<ADCTrajectory>();
+  planning_base_->RunOnce(local_view_, adc_trajectory_pb.get());
+  auto start_time = adc_trajectory_pb->header().timestamp_sec();
+  common::util::FillHeader(node_->Name(), adc_trajectory_pb.get());
 
   // modify trajecotry relative time due to the timestamp change in header
-  const double dt = start_time - adc_trajectory_pb.header().timestamp_sec();
-  for (auto& p : *adc_trajectory_pb.mutable_trajectory_point()) {
+  const double dt = start_time - adc_trajectory_pb->header().timestamp_sec();
+  for (auto& p : *adc_trajectory_pb->mutable_trajectory_point()) {
     p.set_relative_time(p.relative_time() + dt);
   }
-  planning_writer_->Write(std::make_shared<ADCTrajectory>(adc_trajectory_pb));
+  planning_writer_->Write(adc_trajectory_pb);
   return true;
 }
 
@@ -155,8 +157,8 @@ void PlanningComponent::CheckRerouting() {
 }
 
 bool PlanningComponent::CheckInput() {
-  ADCTrajectory trajectory_pb;
-  auto* not_ready = trajectory_pb.mutable_decision()
+  auto trajectory_pb = std::make_shared<ADCTrajectory>();
+  auto* not_ready = trajectory_pb->mutable_decision()
                         ->mutable_main_decision()
                         ->mutable_not_ready();
 
@@ -172,8 +174,8 @@ bool PlanningComponent::CheckInput() {
 
   if (not_ready->has_reason()) {
     AERROR << not_ready->reason() << "; skip the planning cycle.";
-    common::util::FillHeader(node_->Name(), &trajectory_pb);
-    planning_writer_->Write(std::make_shared<ADCTrajectory>(trajectory_pb));
+    common::util::FillHeader(node_->Name(), trajectory_pb.get());
+    planning_writer_->Write(trajectory_pb);
     return false;
   }
   return true;
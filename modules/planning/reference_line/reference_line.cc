@@ -382,6 +382,23 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+                           std::vector<SLPoint>* const sl_points) const {
+  DCHECK_NOTNULL(sl_points);
+  std::vector<double> s;
+  std::vector<double> l;
+  if (!map_path_.GetProjections(xy_points, &s, &l)) {
+    AERROR << "Can't get nearest points from path.";
+    return false;
+  }
+  sl_points->resize(xy_points.size());
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    (*sl_points)[i].set_s(s[i]);
+    (*sl_points)[i].set_l(l[i]);
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -606,13 +623,13 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   double end_l(std::numeric_limits<double>::lowest());
   std::vector<common::math::Vec2d> corners;
   box.GetAllCorners(&corners);
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(corners, &sl_points)) {
+    AERROR << "failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_points) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
@@ -636,13 +653,18 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  std::vector<common::math::Vec2d> points;
+  points.reserve(polygon.point_size());
   for (const auto& point : polygon.point()) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    points.emplace_back(point.x(), point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "failed to get projection for polygon: "
+           << polygon.ShortDebugString() << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_points) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
@@ -849,7 +849,11 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
   // generate anchor points:
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_ref, &anchor_points);
-  // modify anchor points based on prefix_ref
+  // modify anchor points based on prefix_ref: the first one on the prefix is
+  // fixed to it, and in incremental mode the following ones on the prefix
+  // are moved onto it as well, so only the appended part is really smoothed
+  // again and the solver starts from the previous solution on the overlap.
+  bool is_first_on_prefix = true;
   for (auto &point : anchor_points) {
     common::SLPoint sl_point;
     Vec2d xy{point.path_point.x(), point.path_point.y()};
@@ -857,17 +861,32 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
       continue;
     }
     if (sl_point.s() < 0 || sl_point.s() > prefix_ref.Length()) {
-      continue;
+      if (is_first_on_prefix) {
+        continue;
+      }
+      break;
     }
     auto prefix_ref_point = prefix_ref.GetNearestReferencePoint(sl_point.s());
     point.path_point.set_x(prefix_ref_point.x());
     point.path_point.set_y(prefix_ref_point.y());
     point.path_point.set_z(0.0);
     point.path_point.set_theta(prefix_ref_point.heading());
-    point.longitudinal_bound = 1e-6;
-    point.lateral_bound = 1e-6;
-    point.enforced = true;
-    break;
+    if (is_first_on_prefix) {
+      point.longitudinal_bound = 1e-6;
+      point.lateral_bound = 1e-6;
+      point.enforced = true;
+      is_first_on_prefix = false;
+    } else {
+      // the end point keeps its own tight bounds
+      point.longitudinal_bound =
+          std::min(point.longitudinal_bound,
+                   smoother_config_.longitudinal_boundary_bound());
+      point.lateral_bound = std::min(point.lateral_bound,
+                                     smoother_config_.lateral_boundary_bound());
+    }
+    if (!FLAGS_enable_incremental_reference_line_smoothing) {
+      break;
+    }
   }
 
   smoother_->SetAnchorPoints(anchor_points);
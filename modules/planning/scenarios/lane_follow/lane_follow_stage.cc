@@ -21,8 +21,10 @@
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
 #include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
@@ -114,7 +116,20 @@ Stage::StageStatus LaneFollowStage::Process(
     const TrajectoryPoint& planning_start_point, Frame* frame) {
   bool has_drivable_reference_line = false;
   bool disable_low_priority_path = false;
+  // when planned concurrently, the results are still taken in the order of
+  // the reference lines, so a change lane path disables the same lower
+  // priority paths as when they are planned one by one.
+  const bool plan_concurrently =
+      FLAGS_enable_multi_thread_in_reference_line_planning &&
+      frame->reference_line_info().size() > 1;
+  std::vector<Status> planned_status;
+  if (plan_concurrently) {
+    planned_status =
+        PlanOnReferenceLinesConcurrently(planning_start_point, frame);
+  }
+  size_t index = 0;
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    const size_t reference_line_index = index++;
     if (disable_low_priority_path) {
       reference_line_info.SetDrivable(false);
     }
@@ -122,7 +137,10 @@ Stage::StageStatus LaneFollowStage::Process(
       continue;
     }
     auto cur_status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+        plan_concurrently
+            ? planned_status[reference_line_index]
+            : PlanOnReferenceLine(planning_start_point, frame,
+                                  &reference_line_info, task_list_);
     if (cur_status.ok() && reference_line_info.IsDrivable()) {
       has_drivable_reference_line = true;
       if (FLAGS_prioritize_change_lane &&
@@ -138,9 +156,44 @@ Stage::StageStatus LaneFollowStage::Process(
                                      : StageStatus::ERROR;
 }
 
+std::vector<Status> LaneFollowStage::PlanOnReferenceLinesConcurrently(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  auto* reference_line_infos = frame->mutable_reference_line_info();
+  std::vector<Status> planned_status(reference_line_infos->size(),
+                                     Status::OK());
+  std::vector<size_t> indices;
+  std::vector<ReferenceLineInfo*> drivable_infos;
+  size_t index = 0;
+  for (auto& reference_line_info : *reference_line_infos) {
+    if (reference_line_info.IsDrivable()) {
+      indices.push_back(index);
+      drivable_infos.push_back(&reference_line_info);
+    }
+    ++index;
+  }
+  // the tasks keep per run state, so each reference line runs its own copy
+  std::vector<const std::vector<Task*>*> task_lists;
+  for (size_t i = 0; i < drivable_infos.size(); ++i) {
+    task_lists.push_back(&TaskListAt(i));
+  }
+  cyber::ParallelFor(0, drivable_infos.size(), 1, [&](size_t i) {
+    planned_status[indices[i]] = PlanOnReferenceLine(
+        planning_start_point, frame, drivable_infos[i], *task_lists[i]);
+  });
+  return planned_status;
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             task_list_);
+}
+
+Status LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    const std::vector<Task*>& task_list) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -157,7 +210,7 @@ Status LaneFollowStage::PlanOnReferenceLine(
 
   auto ret = Status::OK();
 
-  for (auto* optimizer : task_list_) {
+  for (auto* optimizer : task_list) {
     const double start_timestamp = Clock::NowInSeconds();
     ret = optimizer->Execute(frame, reference_line_info);
     if (!ret.ok()) {
@@ -65,6 +65,16 @@ class LaneFollowStage : public Stage {
                        const std::string& name, const double time_diff_ms);
 
  private:
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>& task_list);
+
+  // Plans all the drivable reference lines on the planning threads, the
+  // status of the others is left ok.
+  std::vector<common::Status> PlanOnReferenceLinesConcurrently(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
 };
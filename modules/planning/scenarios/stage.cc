@@ -66,6 +66,23 @@ Task* Stage::FindTask(TaskConfig::TaskType task_type) const {
   }
 }
 
+const std::vector<Task*>& Stage::TaskListAt(const size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  while (task_list_copies_.size() < index) {
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<Task*> task_list;
+    for (const auto* task : task_list_) {
+      tasks.push_back(TaskFactory::CreateTask(task->Config()));
+      task_list.push_back(tasks.back().get());
+    }
+    task_copies_.push_back(std::move(tasks));
+    task_list_copies_.push_back(std::move(task_list));
+  }
+  return task_list_copies_[index - 1];
+}
+
 bool Stage::ExecuteTaskOnReferenceLine(
     const common::TrajectoryPoint& planning_start_point, Frame* frame) {
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -76,6 +76,14 @@ class Stage {
 
   Task* FindTask(TaskConfig::TaskType task_type) const;
 
+  /**
+   * @brief The task list for the index-th of several reference lines planned
+   * concurrently: TaskList() for the first one, and separate instances of the
+   * same tasks, created on first use, for the others. It is not thread safe
+   * and should be called before the reference lines are dispatched.
+   */
+  const std::vector<Task*>& TaskListAt(const size_t index);
+
   ScenarioConfig::StageType NextStage() const { return next_stage_; }
 
  protected:
@@ -84,6 +92,9 @@ class Stage {
 
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
+  // task lists for the reference lines after the first one, see TaskListAt()
+  std::vector<std::vector<std::unique_ptr<Task>>> task_copies_;
+  std::vector<std::vector<Task*>> task_list_copies_;
   ScenarioConfig::StageConfig config_;
   ScenarioConfig::StageType next_stage_;
   void* context_;
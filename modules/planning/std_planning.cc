@@ -333,6 +333,16 @@ void StdPlanning::RunOnce(const LocalView& local_view,
   ADEBUG << "total planning time spend: " << time_diff_ms << " ms.";
 
   trajectory_pb->mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  if (frame_->arena() != nullptr) {
+    const auto arena_stats = frame_->arena()->stats();
+    auto* stats_pb =
+        trajectory_pb->mutable_latency_stats()->mutable_frame_arena_stats();
+    stats_pb->set_num_allocations(arena_stats.num_allocations);
+    stats_pb->set_allocated_bytes(arena_stats.allocated_bytes);
+    stats_pb->set_reserved_bytes(arena_stats.reserved_bytes);
+    stats_pb->set_num_blocks(arena_stats.num_blocks);
+    stats_pb->set_num_pooled_blocks(arena_stats.num_pooled_blocks);
+  }
   ADEBUG << "Planning latency: "
          << trajectory_pb->latency_stats().DebugString();
 
@@ -30,7 +30,12 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
-}
+constexpr double kIgnoreDistance = 200.0;
+constexpr double kAccelEpsilon = 0.1;
+constexpr size_t kAccelShift = 100;
+constexpr double kJerkEpsilon = 0.1;
+constexpr size_t kJerkShift = 200;
+}  // namespace
 
 DpStCost::DpStCost(const DpStSpeedConfig& config,
                    const std::vector<const Obstacle*>& obstacles,
@@ -48,8 +53,17 @@ DpStCost::DpStCost(const DpStSpeedConfig& config,
   for (auto& vec : boundary_cost_) {
     vec.resize(config_.matrix_dimension_t(), std::make_pair(-1.0, -1.0));
   }
-  accel_cost_.fill(-1.0);
-  jerk_cost_.fill(-1.0);
+  // every key stands for the accel or jerk at the center of its bucket
+  for (size_t i = 0; i < accel_cost_.size(); ++i) {
+    accel_cost_[i] = ComputeAccelCost(
+        (static_cast<double>(i) - static_cast<double>(kAccelShift)) *
+        kAccelEpsilon);
+  }
+  for (size_t i = 0; i < jerk_cost_.size(); ++i) {
+    jerk_cost_[i] = ComputeJerkCost(
+        (static_cast<double>(i) - static_cast<double>(kJerkShift)) *
+        kJerkEpsilon);
+  }
 }
 
 void DpStCost::AddToKeepClearRange(
@@ -103,7 +117,30 @@ bool DpStCost::InKeepClearRange(double s) const {
   return false;
 }
 
-double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
+void DpStCost::CacheBoundarySRange(const uint32_t index_t, const double t) {
+  for (const auto* obstacle : obstacles_) {
+    if (!obstacle->IsBlockingObstacle()) {
+      continue;
+    }
+    const auto& boundary = obstacle->st_boundary();
+    if (boundary.min_s() > kIgnoreDistance) {
+      continue;
+    }
+    if (t < boundary.min_t() || t > boundary.max_t()) {
+      continue;
+    }
+    auto search = boundary_map_.find(boundary.id());
+    if (search == boundary_map_.end()) {
+      continue;
+    }
+    auto& s_range = boundary_cost_[search->second][index_t];
+    if (s_range.first < 0.0) {
+      boundary.GetBoundarySRange(t, &s_range.first, &s_range.second);
+    }
+  }
+}
+
+double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) const {
   const double s = st_graph_point.point().s();
   const double t = st_graph_point.point().t();
 
@@ -113,8 +150,7 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
       continue;
     }
 
-    auto boundary = obstacle->st_boundary();
-    const double kIgnoreDistance = 200.0;
+    const auto& boundary = obstacle->st_boundary();
     if (boundary.min_s() > kIgnoreDistance) {
       continue;
     }
@@ -128,14 +164,16 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
     double s_upper = 0.0;
     double s_lower = 0.0;
 
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
+    auto search = boundary_map_.find(boundary.id());
+    const auto* s_range =
+        search == boundary_map_.end()
+            ? nullptr
+            : &boundary_cost_[search->second][st_graph_point.index_t()];
+    if (s_range == nullptr || s_range->first < 0.0) {
       boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
     } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
+      s_upper = s_range->first;
+      s_lower = s_range->second;
     }
     if (s < s_lower) {
       constexpr double kSafeTimeBuffer = 3.0;
@@ -190,83 +228,70 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
-double DpStCost::GetAccelCost(const double accel) {
+double DpStCost::ComputeAccelCost(const double accel) const {
   double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 100;
-  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
-  DCHECK_LT(accel_key, accel_cost_.size());
-  if (accel_key >= accel_cost_.size()) {
-    return kInf;
+  const double accel_sq = accel * accel;
+  double max_acc = config_.max_acceleration();
+  double max_dec = config_.max_deceleration();
+  double accel_penalty = config_.accel_penalty();
+  double decel_penalty = config_.decel_penalty();
+
+  if (accel > 0.0) {
+    cost = accel_penalty * accel_sq;
+  } else {
+    cost = decel_penalty * accel_sq;
   }
+  cost += accel_sq * decel_penalty * decel_penalty /
+              (1 + std::exp(1.0 * (accel - max_dec))) +
+          accel_sq * accel_penalty * accel_penalty /
+              (1 + std::exp(-1.0 * (accel - max_acc)));
+  return cost;
+}
 
-  if (accel_cost_.at(accel_key) < 0.0) {
-    const double accel_sq = accel * accel;
-    double max_acc = config_.max_acceleration();
-    double max_dec = config_.max_deceleration();
-    double accel_penalty = config_.accel_penalty();
-    double decel_penalty = config_.decel_penalty();
-
-    if (accel > 0.0) {
-      cost = accel_penalty * accel_sq;
-    } else {
-      cost = decel_penalty * accel_sq;
-    }
-    cost += accel_sq * decel_penalty * decel_penalty /
-                (1 + std::exp(1.0 * (accel - max_dec))) +
-            accel_sq * accel_penalty * accel_penalty /
-                (1 + std::exp(-1.0 * (accel - max_acc)));
-    accel_cost_.at(accel_key) = cost;
-  } else {
-    cost = accel_cost_.at(accel_key);
+double DpStCost::GetAccelCost(const double accel) const {
+  const double key = accel / kAccelEpsilon + 0.5 + kAccelShift;
+  if (key < 0.0 || key >= static_cast<double>(accel_cost_.size())) {
+    return kInf;
   }
-  return cost * unit_t_;
+  return accel_cost_[static_cast<size_t>(key)] * unit_t_;
 }
 
 double DpStCost::GetAccelCostByThreePoints(const STPoint& first,
                                           const STPoint& second,
-                                          const STPoint& third) {
+                                          const STPoint& third) const {
   double accel = (first.s() + third.s() - 2 * second.s()) / (unit_t_ * unit_t_);
   return GetAccelCost(accel);
 }
 
 double DpStCost::GetAccelCostByTwoPoints(const double pre_speed,
                                         const STPoint& pre_point,
-                                        const STPoint& curr_point) {
+                                        const STPoint& curr_point) const {
   double current_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   double accel = (current_speed - pre_speed) / unit_t_;
   return GetAccelCost(accel);
 }
 
-double DpStCost::JerkCost(const double jerk) {
-  double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 200;
-  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
-  if (jerk_key >= jerk_cost_.size()) {
-    return kInf;
+double DpStCost::ComputeJerkCost(const double jerk) const {
+  const double jerk_sq = jerk * jerk;
+  if (jerk > 0) {
+    return config_.positive_jerk_coeff() * jerk_sq * unit_t_;
   }
+  return config_.negative_jerk_coeff() * jerk_sq * unit_t_;
+}
 
-  if (jerk_cost_.at(jerk_key) < 0.0) {
-    double jerk_sq = jerk * jerk;
-    if (jerk > 0) {
-      cost = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
-    } else {
-      cost = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
-    }
-    jerk_cost_.at(jerk_key) = cost;
-  } else {
-    cost = jerk_cost_.at(jerk_key);
+double DpStCost::JerkCost(const double jerk) const {
+  const double key = jerk / kJerkEpsilon + 0.5 + kJerkShift;
+  if (key < 0.0 || key >= static_cast<double>(jerk_cost_.size())) {
+    return kInf;
   }
-
   // TODO(All): normalize to unit_t_
-  return cost;
+  return jerk_cost_[static_cast<size_t>(key)];
 }
 
 double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
                                         const STPoint& second,
                                         const STPoint& third,
-                                        const STPoint& fourth) {
+                                        const STPoint& fourth) const {
   double jerk = (fourth.s() - 3 * third.s() + 3 * second.s() - first.s()) /
                (unit_t_ * unit_t_ * unit_t_);
   return JerkCost(jerk);
@@ -275,7 +300,7 @@ double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
 double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
                                        const double pre_acc,
                                        const STPoint& pre_point,
-                                       const STPoint& curr_point) {
+                                       const STPoint& curr_point) const {
   const double curr_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   const double curr_accel = (curr_speed - pre_speed) / unit_t_;
   const double jerk = (curr_accel - pre_acc) / unit_t_;
@@ -285,7 +310,7 @@ double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
 double DpStCost::GetJerkCostByThreePoints(const double first_speed,
                                          const STPoint& first,
                                          const STPoint& second,
-                                         const STPoint& third) {
+                                         const STPoint& third) const {
   const double pre_speed = (second.s() - first.s()) / unit_t_;
   const double pre_acc = (pre_speed - first_speed) / unit_t_;
   const double curr_speed = (third.s() - second.s()) / unit_t_;
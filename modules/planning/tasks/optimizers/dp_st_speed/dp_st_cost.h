@@ -42,7 +42,12 @@ class DpStCost {
                     const std::vector<const Obstacle*>& obstacles,
                     const common::TrajectoryPoint& init_point);
 
-  double GetObstacleCost(const StGraphPoint& point);
+  // Computes the s range of every obstacle boundary at time t for the
+  // points of column index_t, GetObstacleCost only reads the result so the
+  // points of one column can be evaluated in parallel.
+  void CacheBoundarySRange(const uint32_t index_t, const double t);
+
+  double GetObstacleCost(const StGraphPoint& point) const;
 
   double GetReferenceCost(const STPoint& point,
                          const STPoint& reference_point) const;
@@ -51,24 +56,28 @@ class DpStCost {
                      const double speed_limit) const;
 
   double GetAccelCostByTwoPoints(const double pre_speed, const STPoint& first,
-                                const STPoint& second);
+                                const STPoint& second) const;
   double GetAccelCostByThreePoints(const STPoint& first, const STPoint& second,
-                                  const STPoint& third);
+                                  const STPoint& third) const;
 
   double GetJerkCostByTwoPoints(const double pre_speed, const double pre_acc,
                                const STPoint& pre_point,
-                               const STPoint& curr_point);
+                               const STPoint& curr_point) const;
   double GetJerkCostByThreePoints(const double first_speed,
                                  const STPoint& first_point,
                                  const STPoint& second_point,
-                                 const STPoint& third_point);
+                                 const STPoint& third_point) const;
 
   double GetJerkCostByFourPoints(const STPoint& first, const STPoint& second,
-                                const STPoint& third, const STPoint& fourth);
+                                const STPoint& third,
+                                const STPoint& fourth) const;
 
  private:
-  double GetAccelCost(const double accel);
-  double JerkCost(const double jerk);
+  // accel and jerk costs are looked up in tables filled on construction
+  double GetAccelCost(const double accel) const;
+  double JerkCost(const double jerk) const;
+  double ComputeAccelCost(const double accel) const;
+  double ComputeJerkCost(const double jerk) const;
 
   void AddToKeepClearRange(const std::vector<const Obstacle*>& obstacles);
   static void SortAndMergeRange(
@@ -82,6 +91,7 @@ class DpStCost {
   double unit_t_ = 0.0;
 
   std::unordered_map<std::string, int> boundary_map_;
+  // s range of each boundary per t index, s_upper < 0 until cached
   std::vector<std::vector<std::pair<double, double>>> boundary_cost_;
 
   std::vector<std::pair<double, double>> keep_clear_range_;
@@ -57,13 +57,7 @@ class DpStGraph {
 
   apollo::common::Status CalculateTotalCost();
 
-  // defined for cyber task
-  struct StGraphMessage {
-    StGraphMessage(const uint32_t c_, const int32_t r_) : c(c_), r(r_) {}
-    uint32_t c;
-    uint32_t r;
-  };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  void CalculateCostAt(const uint32_t c, const uint32_t r);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                           const STPoint& third, const STPoint& forth,
@@ -77,6 +71,10 @@ class DpStGraph {
   void GetRowRange(const StGraphPoint& point, size_t* highest_row,
                    size_t* lowest_row);
 
+  StGraphPoint& CostAt(const uint32_t c, const uint32_t r) {
+    return cost_table_[c * dim_s_ + r];
+  }
+
  private:
   const StGraphData& st_graph_data_;
 
@@ -101,9 +99,15 @@ class DpStGraph {
   double unit_s_ = 0.0;
   double unit_t_ = 0.0;
 
-  // cost_table_[t][s]
+  uint32_t dim_s_ = 0;
+  uint32_t dim_t_ = 0;
+
+  // cost_table_[t * dim_s_ + s], the points of one column are contiguous
   // row: s, col: t --- NOTICE: Please do NOT change.
-  std::vector<std::vector<StGraphPoint>> cost_table_;
+  std::vector<StGraphPoint> cost_table_;
+
+  // speed limit at the s of every row
+  std::vector<double> speed_limit_by_row_;
 };
 
 }  // namespace planning
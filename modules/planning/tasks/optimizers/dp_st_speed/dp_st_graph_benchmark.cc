@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file dp_st_graph_benchmark.cc
+ **/
+
+#include <benchmark/benchmark.h>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_internal.pb.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/tasks/optimizers/dp_st_speed/dp_st_graph.h"
+
+DEFINE_string(dp_st_graph_benchmark_file, "",
+              "STGraphDebug text proto recorded by the planning module, the "
+              "built-in scene is used when empty");
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::util::GetProtoFromFile;
+using apollo::planning_internal::STGraphDebug;
+
+namespace {
+
+constexpr double kPathLength = 149.0;
+
+// Holds everything DpStGraph keeps references to.
+class Scene {
+ public:
+  Scene() {
+    PlanningConfig planning_config;
+    CHECK(GetProtoFromFile(FLAGS_planning_config_file, &planning_config))
+        << "failed to load planning config file " << FLAGS_planning_config_file;
+    for (const auto& cfg : planning_config.default_task_config()) {
+      if (cfg.task_type() == TaskConfig::DP_ST_SPEED_OPTIMIZER) {
+        dp_config_ = cfg.dp_st_speed_config();
+        break;
+      }
+    }
+
+    STGraphDebug debug;
+    if (FLAGS_dp_st_graph_benchmark_file.empty()) {
+      debug = DefaultDebug();
+    } else {
+      CHECK(GetProtoFromFile(FLAGS_dp_st_graph_benchmark_file, &debug))
+          << "failed to load " << FLAGS_dp_st_graph_benchmark_file;
+    }
+    LoadDebug(debug);
+
+    init_point_.set_v(10.0);
+    init_point_.set_a(0.0);
+    adc_sl_boundary_.set_start_s(0.0);
+    adc_sl_boundary_.set_end_s(5.0);
+    adc_sl_boundary_.set_start_l(-1.1);
+    adc_sl_boundary_.set_end_l(1.1);
+    st_graph_data_ =
+        StGraphData(boundaries_, init_point_, speed_limit_, kPathLength);
+  }
+
+  bool Search() {
+    DpStGraph dp_st_graph(st_graph_data_, dp_config_, obstacles_, init_point_,
+                          adc_sl_boundary_);
+    SpeedData speed_data;
+    return dp_st_graph.Search(&speed_data).ok();
+  }
+
+ private:
+  // a car cutting in ahead, a slower leader and a stop fence
+  static STGraphDebug DefaultDebug() {
+    STGraphDebug debug;
+    auto add_boundary = [&debug](const std::string& name, double t0,
+                                 double t1, double s0, double s1, double v) {
+      auto* boundary = debug.add_boundary();
+      boundary->set_name(name);
+      boundary->set_type(StGraphBoundaryDebug::ST_BOUNDARY_TYPE_YIELD);
+      auto add_point = [boundary](double t, double s) {
+        auto* point = boundary->add_point();
+        point->set_t(t);
+        point->set_s(s);
+      };
+      add_point(t0, s0);
+      add_point(t1, s0 + v * (t1 - t0));
+      add_point(t1, s1 + v * (t1 - t0));
+      add_point(t0, s1);
+    };
+    add_boundary("cut_in", 2.0, 5.0, 40.0, 45.0, 3.0);
+    add_boundary("leader", 0.0, 8.0, 80.0, 85.0, 6.0);
+    add_boundary("fence", 0.0, 8.0, 140.0, 141.0, 0.0);
+    for (double s = 0.0; s < 200.0; s += 1.0) {
+      auto* speed_limit = debug.add_speed_limit();
+      speed_limit->set_s(s);
+      speed_limit->set_v(s < 60.0 ? 15.0 : 20.0);
+    }
+    return debug;
+  }
+
+  // boundary points are the lower points by t followed by the upper points
+  // in reverse, see StBoundary
+  void LoadDebug(const STGraphDebug& debug) {
+    for (const auto& boundary_debug : debug.boundary()) {
+      const int num = boundary_debug.point_size();
+      std::vector<std::pair<STPoint, STPoint>> point_pairs;
+      for (int i = 0; i < num / 2; ++i) {
+        const auto& lower = boundary_debug.point(i);
+        const auto& upper = boundary_debug.point(num - 1 - i);
+        point_pairs.emplace_back(STPoint(lower.s(), lower.t()),
+                                 STPoint(upper.s(), lower.t()));
+      }
+      if (point_pairs.size() < 2) {
+        continue;
+      }
+      StBoundary boundary(point_pairs);
+      boundary.SetId(boundary_debug.name());
+      if (boundary_debug.type() ==
+          StGraphBoundaryDebug::ST_BOUNDARY_TYPE_KEEP_CLEAR) {
+        boundary.SetBoundaryType(StBoundary::BoundaryType::KEEP_CLEAR);
+      }
+      obstacle_list_.emplace_back();
+      auto& obstacle = obstacle_list_.back();
+      obstacle.SetId(boundary_debug.name());
+      obstacle.SetBlockingObstacle(true);
+      obstacle.SetStBoundary(boundary);
+    }
+    for (const auto& obstacle : obstacle_list_) {
+      obstacles_.push_back(&obstacle);
+      boundaries_.push_back(&obstacle.st_boundary());
+    }
+    for (const auto& point : debug.speed_limit()) {
+      speed_limit_.AppendSpeedLimit(point.s(), point.v());
+    }
+  }
+
+  DpStSpeedConfig dp_config_;
+  std::list<Obstacle> obstacle_list_;
+  std::vector<const Obstacle*> obstacles_;
+  std::vector<const StBoundary*> boundaries_;
+  SpeedLimit speed_limit_;
+  common::TrajectoryPoint init_point_;
+  SLBoundary adc_sl_boundary_;
+  StGraphData st_graph_data_;
+};
+
+}  // namespace
+
+static void BM_Search(benchmark::State& state) {  // NOLINT
+  FLAGS_enable_multi_thread_in_dp_st_graph = state.range(0) != 0;
+  Scene scene;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(scene.Search());
+  }
+}
+BENCHMARK(BM_Search)->Arg(0)->Arg(1)->UseRealTime();
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
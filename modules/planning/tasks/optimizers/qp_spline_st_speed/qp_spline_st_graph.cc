@@ -318,7 +318,7 @@ Status QpSplineStGraph::AddKernel(
   }
 
   // init point jerk continuous kernel
-  (*spline_kernel->mutable_kernel_matrix())(2, 2) +=
+  spline_kernel->mutable_kernel_matrix()->coeffRef(2, 2) +=
       2.0 * 4.0 *
       qp_st_speed_config_.qp_spline_config().init_jerk_kernel_weight();
   (*spline_kernel->mutable_offset())(2, 0) +=
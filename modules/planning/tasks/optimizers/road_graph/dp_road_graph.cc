@@ -20,6 +20,7 @@
 
 #include "modules/planning/tasks/optimizers/road_graph/dp_road_graph.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/task/task.h"
@@ -47,7 +48,13 @@ DpRoadGraph::DpRoadGraph(const DpPolyPathConfig &config,
     : config_(config),
       reference_line_info_(reference_line_info),
       reference_line_(reference_line_info.reference_line()),
-      speed_data_(speed_data) {}
+      speed_data_(speed_data) {
+  prune_dominated_edges_ =
+      config_.path_l_cost() >= 0.0 && config_.path_dl_cost() >= 0.0 &&
+      config_.path_ddl_cost() >= 0.0 && config_.path_l_cost_param_b() >= 0.0 &&
+      config_.path_end_l_cost() >= 0.0 &&
+      config_.obstacle_collision_cost() >= 0.0;
+}
 
 bool DpRoadGraph::FindPathTunnel(const common::TrajectoryPoint &init_point,
                                  const std::vector<const Obstacle *> &obstacles,
@@ -127,9 +134,12 @@ bool DpRoadGraph::GenerateMinCostPath(
   TrajectoryCost trajectory_cost(
       config_, reference_line_, reference_line_info_.IsChangeLanePath(),
       obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_,
-      reference_line_info_.AdcSlBoundary());
+      reference_line_info_.AdcSlBoundary(),
+      reference_line_info_.obstacle_box_index());
 
-  std::list<std::list<DpRoadGraphNode>> graph_nodes;
+  // levels are filled before the next one refers to them, nodes never move
+  std::vector<std::vector<DpRoadGraphNode>> graph_nodes;
+  graph_nodes.reserve(path_waypoints.size());
 
   // find one point from first row
   const auto &first_row = path_waypoints.front();
@@ -143,34 +153,67 @@ bool DpRoadGraph::GenerateMinCostPath(
   graph_nodes.emplace_back();
   graph_nodes.back().emplace_back(first_row[nearest_i], nullptr,
                                   ComparableCost());
-  auto &front = graph_nodes.front().front();
-  size_t total_level = path_waypoints.size();
+  const auto &front = graph_nodes.front().front();
+  const auto total_level = static_cast<uint32_t>(path_waypoints.size());
+
+  LevelContext context;
+  context.total_level = total_level;
+  context.trajectory_cost = &trajectory_cost;
+  context.front = &front;
 
   for (size_t level = 1; level < path_waypoints.size(); ++level) {
     const auto &prev_dp_nodes = graph_nodes.back();
     const auto &level_points = path_waypoints[level];
+    if (level_points.empty()) {
+      AERROR << "No waypoint sampled at level " << level;
+      return false;
+    }
 
-    graph_nodes.emplace_back();
-    std::vector<std::future<void>> results;
-
-    for (size_t i = 0; i < level_points.size(); ++i) {
-      const auto &cur_point = level_points[i];
-
-      graph_nodes.back().emplace_back(cur_point, nullptr);
+    context.level = static_cast<uint32_t>(level);
+    context.prev_nodes.clear();
+    for (const auto &prev_dp_node : prev_dp_nodes) {
+      context.prev_nodes.push_back(&prev_dp_node);
+    }
+    if (prune_dominated_edges_) {
+      // same order as ComparableCost, without its epsilon so that the
+      // comparison is a strict weak ordering
+      std::stable_sort(
+          context.prev_nodes.begin(), context.prev_nodes.end(),
+          [](const DpRoadGraphNode *lhs, const DpRoadGraphNode *rhs) {
+            const auto &lhs_cost = lhs->min_cost;
+            const auto &rhs_cost = rhs->min_cost;
+            if (lhs_cost.cost_items != rhs_cost.cost_items) {
+              return lhs_cost.cost_items < rhs_cost.cost_items;
+            }
+            return lhs_cost.safety_cost + lhs_cost.smoothness_cost <
+                   rhs_cost.safety_cost + rhs_cost.smoothness_cost;
+          });
+    }
 
-      auto msg = std::make_shared<RoadGraphMessage>(
-          prev_dp_nodes, level, total_level, &trajectory_cost, &front,
-          &(graph_nodes.back().back()));
+    // all points of a level share the same s
+    const double end_s = level_points.front().s();
+    context.samples =
+        trajectory_cost.SampleEdge(prev_dp_nodes.front().sl_point.s(), end_s);
+    if (reference_line_info_.IsChangeLanePath() && level >= 2) {
+      context.front_samples =
+          trajectory_cost.SampleEdge(init_sl_point_.s(), end_s);
+    }
 
-      if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        results.emplace_back(cyber::Async(&DpRoadGraph::UpdateNode, this, msg));
-      } else {
-        UpdateNode(msg);
-      }
+    graph_nodes.emplace_back();
+    auto &level_nodes = graph_nodes.back();
+    level_nodes.reserve(level_points.size());
+    for (const auto &cur_point : level_points) {
+      level_nodes.emplace_back(cur_point, nullptr);
     }
+
     if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-      for (auto &result : results) {
-        result.get();
+      cyber::ParallelFor(0, level_nodes.size(), 1,
+                         [this, &context, &level_nodes](size_t i) {
+                           UpdateNode(context, &level_nodes[i]);
+                         });
+    } else {
+      for (auto &level_node : level_nodes) {
+        UpdateNode(context, &level_node);
       }
     }
   }
@@ -203,17 +246,21 @@ bool DpRoadGraph::GenerateMinCostPath(
   return true;
 }
 
-void DpRoadGraph::UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg) {
-  DCHECK_NOTNULL(msg);
-  DCHECK_NOTNULL(msg->trajectory_cost);
-  DCHECK_NOTNULL(msg->front);
-  DCHECK_NOTNULL(msg->cur_node);
-  for (const auto &prev_dp_node : msg->prev_nodes) {
-    const auto &prev_sl_point = prev_dp_node.sl_point;
-    const auto &cur_point = msg->cur_node->sl_point;
+void DpRoadGraph::UpdateNode(const LevelContext &context,
+                             DpRoadGraphNode *cur_node) {
+  DCHECK_NOTNULL(context.trajectory_cost);
+  DCHECK_NOTNULL(context.front);
+  DCHECK_NOTNULL(cur_node);
+  const auto &cur_point = cur_node->sl_point;
+  for (const auto *prev_dp_node : context.prev_nodes) {
+    // the remaining nodes cost at least as much as this one
+    if (prune_dominated_edges_ && prev_dp_node->min_cost > cur_node->min_cost) {
+      break;
+    }
+    const auto &prev_sl_point = prev_dp_node->sl_point;
     double init_dl = 0.0;
     double init_ddl = 0.0;
-    if (msg->level == 1) {
+    if (context.level == 1) {
       init_dl = init_frenet_frame_point_.dl();
       init_ddl = init_frenet_frame_point_.ddl();
     }
@@ -224,29 +271,41 @@ void DpRoadGraph::UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg) {
     if (!IsValidCurve(curve)) {
       continue;
     }
-    const auto cost =
-        msg->trajectory_cost->Calculate(curve, prev_sl_point.s(), cur_point.s(),
-                                        msg->level, msg->total_level) +
-        prev_dp_node.min_cost;
+    const auto cost = CalculateEdgeCost(context, context.samples, curve,
+                                        prev_sl_point.s(), cur_point.s()) +
+                      prev_dp_node->min_cost;
 
-    msg->cur_node->UpdateCost(&prev_dp_node, curve, cost);
+    cur_node->UpdateCost(prev_dp_node, curve, cost);
   }
 
   // try to connect the current point with the first point directly
-  if (reference_line_info_.IsChangeLanePath() && msg->level >= 2) {
+  if (reference_line_info_.IsChangeLanePath() && context.level >= 2) {
     const double init_dl = init_frenet_frame_point_.dl();
     const double init_ddl = init_frenet_frame_point_.ddl();
-    QuinticPolynomialCurve1d curve(
-        init_sl_point_.l(), init_dl, init_ddl, msg->cur_node->sl_point.l(), 0.0,
-        0.0, msg->cur_node->sl_point.s() - init_sl_point_.s());
+    QuinticPolynomialCurve1d curve(init_sl_point_.l(), init_dl, init_ddl,
+                                   cur_point.l(), 0.0, 0.0,
+                                   cur_point.s() - init_sl_point_.s());
     if (!IsValidCurve(curve)) {
       return;
     }
-    const auto cost = msg->trajectory_cost->Calculate(
-        curve, init_sl_point_.s(), msg->cur_node->sl_point.s(), msg->level,
-        msg->total_level);
-    msg->cur_node->UpdateCost(msg->front, curve, cost);
+    const auto cost = CalculateEdgeCost(context, context.front_samples, curve,
+                                        init_sl_point_.s(), cur_point.s());
+    cur_node->UpdateCost(context.front, curve, cost);
+  }
+}
+
+ComparableCost DpRoadGraph::CalculateEdgeCost(
+    const LevelContext &context, const TrajectoryCost::EdgeSamples &samples,
+    const QuinticPolynomialCurve1d &curve, const double start_s,
+    const double end_s) const {
+  const auto &trajectory_cost = *context.trajectory_cost;
+  if (samples.start_s == start_s && samples.end_s == end_s) {
+    return trajectory_cost.Calculate(curve, samples, context.level,
+                                     context.total_level);
   }
+  return trajectory_cost.Calculate(curve,
+                                   trajectory_cost.SampleEdge(start_s, end_s),
+                                   context.level, context.total_level);
 }
 
 bool DpRoadGraph::IsValidCurve(const QuinticPolynomialCurve1d &curve) const {
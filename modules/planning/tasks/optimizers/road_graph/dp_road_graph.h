@@ -21,7 +21,6 @@
 #pragma once
 
 #include <limits>
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -107,25 +106,25 @@ class DpRoadGraph {
                     const double end_s, const uint32_t curr_level,
                     const uint32_t total_level, ComparableCost *cost);
 
-  struct RoadGraphMessage {
-    RoadGraphMessage(const std::list<DpRoadGraphNode> &_prev_nodes,
-                     const uint32_t _level, const uint32_t _total_level,
-                     TrajectoryCost *_trajectory_cost, DpRoadGraphNode *_front,
-                     DpRoadGraphNode *_cur_node)
-        : prev_nodes(_prev_nodes),
-          level(_level),
-          total_level(_total_level),
-          trajectory_cost(_trajectory_cost),
-          front(_front),
-          cur_node(_cur_node) {}
-    const std::list<DpRoadGraphNode> &prev_nodes;
-    const uint32_t level;
-    const uint32_t total_level;
-    TrajectoryCost *trajectory_cost = nullptr;
-    DpRoadGraphNode *front = nullptr;
-    DpRoadGraphNode *cur_node = nullptr;
+  // What the nodes of one level share while they are updated.
+  struct LevelContext {
+    // nodes of the previous level by ascending min_cost
+    std::vector<const DpRoadGraphNode *> prev_nodes;
+    uint32_t level = 0;
+    uint32_t total_level = 0;
+    const TrajectoryCost *trajectory_cost = nullptr;
+    const DpRoadGraphNode *front = nullptr;
+    // samples of the edges from the previous level and from front
+    TrajectoryCost::EdgeSamples samples;
+    TrajectoryCost::EdgeSamples front_samples;
   };
-  void UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg);
+  void UpdateNode(const LevelContext &context, DpRoadGraphNode *cur_node);
+
+  ComparableCost CalculateEdgeCost(const LevelContext &context,
+                                   const TrajectoryCost::EdgeSamples &samples,
+                                   const QuinticPolynomialCurve1d &curve,
+                                   const double start_s,
+                                   const double end_s) const;
 
  private:
   DpPolyPathConfig config_;
@@ -139,6 +138,10 @@ class DpRoadGraph {
 
   ObjectSidePass sidepass_;
 
+  // an edge whose previous node already costs more than the best edge found
+  // is skipped, which needs every edge cost to be non-negative
+  bool prune_dominated_edges_ = false;
+
   std::unique_ptr<WaypointSampler> waypoint_sampler_;
 };
 
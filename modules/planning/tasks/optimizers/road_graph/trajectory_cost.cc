@@ -26,6 +26,7 @@
 #include "modules/common/proto/pnc_point.pb.h"
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/angle.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -38,6 +39,17 @@ using apollo::common::math::Box2d;
 using apollo::common::math::Sigmoid;
 using apollo::common::math::Vec2d;
 
+namespace {
+// the predicted obstacle boxes are enlarged by this in length and width
+constexpr double kObstacleBoxBuff = 0.5;
+
+Box2d ExpandObstacleBox(const Box2d &obstacle_box) {
+  return Box2d(obstacle_box.center(), obstacle_box.heading(),
+               obstacle_box.length() + kObstacleBoxBuff,
+               obstacle_box.width() + kObstacleBoxBuff);
+}
+}  // namespace
+
 TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
                                const ReferenceLine &reference_line,
                                const bool is_change_lane_path,
@@ -45,7 +57,8 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
                                const common::VehicleParam &vehicle_param,
                                const SpeedData &heuristic_speed_data,
                                const common::SLPoint &init_sl_point,
-                               const SLBoundary &adc_sl_boundary)
+                               const SLBoundary &adc_sl_boundary,
+                               const ObstacleBoxIndex *obstacle_box_index)
     : config_(config),
       reference_line_(&reference_line),
       is_change_lane_path_(is_change_lane_path),
@@ -59,6 +72,14 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
   num_of_time_stamps_ = static_cast<uint32_t>(
       std::floor(total_time / config.eval_time_interval()));
 
+  if (obstacle_box_index != nullptr &&
+      obstacle_box_index->Covers(config.eval_time_interval(),
+                                 num_of_time_stamps_ + 1)) {
+    obstacle_box_index_ = obstacle_box_index;
+    is_indexed_dynamic_obstacle_.resize(obstacle_box_index->num_obstacles(),
+                                        false);
+  }
+
   for (const auto *ptr_obstacle : obstacles) {
     if (ptr_obstacle->IsIgnore()) {
       continue;
@@ -89,26 +110,89 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
     } else if (ptr_obstacle->IsStatic() || is_bycycle_or_pedestrian) {
       static_obstacle_sl_boundaries_.push_back(std::move(sl_boundary));
     } else {
+      const int index = obstacle_box_index_ == nullptr
+                            ? -1
+                            : obstacle_box_index_->ObstacleIndex(
+                                  ptr_obstacle->Id());
+      if (index >= 0) {
+        if (!is_indexed_dynamic_obstacle_[index]) {
+          is_indexed_dynamic_obstacle_[index] = true;
+          ++num_indexed_dynamic_obstacles_;
+        }
+        continue;
+      }
       std::vector<Box2d> box_by_time;
       for (uint32_t t = 0; t <= num_of_time_stamps_; ++t) {
         TrajectoryPoint trajectory_point =
             ptr_obstacle->GetPointAtTime(t * config.eval_time_interval());
 
         Box2d obstacle_box = ptr_obstacle->GetBoundingBox(trajectory_point);
-        constexpr double kBuff = 0.5;
-        Box2d expanded_obstacle_box =
-            Box2d(obstacle_box.center(), obstacle_box.heading(),
-                  obstacle_box.length() + kBuff, obstacle_box.width() + kBuff);
-        box_by_time.push_back(expanded_obstacle_box);
+        box_by_time.push_back(ExpandObstacleBox(obstacle_box));
       }
       dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
+
+  if (!dynamic_obstacle_boxes_.empty() || num_indexed_dynamic_obstacles_ > 0) {
+    time_stamp_ref_s_.reserve(num_of_time_stamps_);
+    double time_stamp = 0.0;
+    for (uint32_t index = 0; index < num_of_time_stamps_;
+         ++index, time_stamp += config_.eval_time_interval()) {
+      common::SpeedPoint speed_point;
+      heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
+      time_stamp_ref_s_.push_back(speed_point.s() + init_sl_point_.s());
+    }
+  }
+}
+
+TrajectoryCost::EdgeSamples TrajectoryCost::SampleEdge(
+    const double start_s, const double end_s) const {
+  EdgeSamples samples;
+  samples.start_s = start_s;
+  samples.end_s = end_s;
+
+  const double length = end_s - start_s;
+  std::vector<double> params;
+  for (double curve_s = 0.0; curve_s <= length;
+       curve_s += config_.path_resolution()) {
+    params.push_back(curve_s);
+    if (curve_s < length) {
+      ++samples.num_path_cost_samples;
+    }
+  }
+  samples.lane_left_width.resize(params.size(), 0.0);
+  samples.lane_right_width.resize(params.size(), 0.0);
+  for (size_t i = 0; i < samples.num_path_cost_samples; ++i) {
+    reference_line_->GetLaneWidth(start_s + params[i],
+                                  &samples.lane_left_width[i],
+                                  &samples.lane_right_width[i]);
+  }
+  samples.path_sampler = QuinticPolynomialSampler(params);
+
+  params.clear();
+  for (uint32_t index = 0; index < time_stamp_ref_s_.size(); ++index) {
+    const double ref_s = time_stamp_ref_s_[index];
+    if (ref_s < start_s) {
+      continue;
+    }
+    if (ref_s > end_s) {
+      break;
+    }
+    params.push_back(ref_s - start_s);
+    samples.time_index.push_back(index);
+    const ReferencePoint ref_point = reference_line_->GetReferencePoint(ref_s);
+    samples.ref_xy.emplace_back(ref_point.x(), ref_point.y());
+    samples.ref_heading.push_back(ref_point.heading());
+    samples.ref_kappa.push_back(ref_point.kappa());
+  }
+  samples.dynamic_sampler = QuinticPolynomialSampler(params);
+  return samples;
 }
 
 ComparableCost TrajectoryCost::CalculatePathCost(
-    const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s, const uint32_t curr_level, const uint32_t total_level) {
+    const QuinticPolynomialCurve1d &curve, const EdgeSamples &samples,
+    const std::vector<double> &l, const uint32_t curr_level,
+    const uint32_t total_level) const {
   ComparableCost cost;
   double path_cost = 0.0;
   std::function<double(const double)> quasi_softmax = [this](const double x) {
@@ -118,26 +202,29 @@ ComparableCost TrajectoryCost::CalculatePathCost(
     return (b + std::exp(-k * (x - l0))) / (1.0 + std::exp(-k * (x - l0)));
   };
 
-  for (double curve_s = 0.0; curve_s < (end_s - start_s);
-       curve_s += config_.path_resolution()) {
-    const double l = curve.Evaluate(0, curve_s);
+  std::vector<double> dl;
+  std::vector<double> ddl;
+  samples.path_sampler.Evaluate(curve, 1, &dl);
+  samples.path_sampler.Evaluate(curve, 2, &ddl);
 
-    path_cost += l * l * config_.path_l_cost() * quasi_softmax(std::fabs(l));
+  const auto &curve_s = samples.path_sampler.params();
+  for (size_t i = 0; i < samples.num_path_cost_samples; ++i) {
+    path_cost +=
+        l[i] * l[i] * config_.path_l_cost() * quasi_softmax(std::fabs(l[i]));
 
-    const double dl = std::fabs(curve.Evaluate(1, curve_s));
-    if (IsOffRoad(curve_s + start_s, l, dl, is_change_lane_path_)) {
+    const double abs_dl = std::fabs(dl[i]);
+    if (IsOffRoad(curve_s[i] + samples.start_s, l[i], abs_dl,
+                  samples.lane_left_width[i], samples.lane_right_width[i])) {
       cost.cost_items[ComparableCost::OUT_OF_BOUNDARY] = true;
     }
 
-    path_cost += dl * dl * config_.path_dl_cost();
-
-    const double ddl = std::fabs(curve.Evaluate(2, curve_s));
-    path_cost += ddl * ddl * config_.path_ddl_cost();
+    path_cost += abs_dl * abs_dl * config_.path_dl_cost();
+    path_cost += ddl[i] * ddl[i] * config_.path_ddl_cost();
   }
   path_cost *= config_.path_resolution();
 
   if (curr_level == total_level) {
-    const double end_l = curve.Evaluate(0, end_s - start_s);
+    const double end_l = curve.Evaluate(0, samples.end_s - samples.start_s);
     path_cost +=
         std::sqrt(end_l - init_sl_point_.l() / 2.0) * config_.path_end_l_cost();
   }
@@ -146,8 +233,8 @@ ComparableCost TrajectoryCost::CalculatePathCost(
 }
 
 bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
-                               const double dl,
-                               const bool is_change_lane_path) {
+                               const double dl, const double left_width,
+                               const double right_width) const {
   constexpr double kIgnoreDistance = 5.0;
   if (ref_s - init_sl_point_.s() < kIgnoreDistance) {
     return false;
@@ -169,10 +256,6 @@ bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
   const double r_l = param.back_edge_to_center();
   const double r = std::sqrt(r_w * r_w + r_l * r_l);
 
-  double left_width = 0.0;
-  double right_width = 0.0;
-  reference_line_->GetLaneWidth(ref_s, &left_width, &right_width);
-
   double left_bound = std::max(init_sl_point_.l() + r + buffer, left_width);
   double right_bound = std::min(init_sl_point_.l() - r - buffer, -right_width);
   if (rear_center.y() + r + buffer / 2.0 > left_bound ||
@@ -188,14 +271,16 @@ bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
 }
 
 ComparableCost TrajectoryCost::CalculateStaticObstacleCost(
-    const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s) {
+    const EdgeSamples &samples, const std::vector<double> &l) const {
   ComparableCost obstacle_cost;
-  for (double curr_s = start_s; curr_s <= end_s;
-       curr_s += config_.path_resolution()) {
-    const double curr_l = curve.Evaluate(0, curr_s - start_s);
+  if (static_obstacle_sl_boundaries_.empty()) {
+    return obstacle_cost;
+  }
+  const auto &curve_s = samples.path_sampler.params();
+  for (size_t i = 0; i < curve_s.size(); ++i) {
+    const double curr_s = samples.start_s + curve_s[i];
     for (const auto &obs_sl_boundary : static_obstacle_sl_boundaries_) {
-      obstacle_cost += GetCostFromObsSL(curr_s, curr_l, obs_sl_boundary);
+      obstacle_cost += GetCostFromObsSL(curr_s, l[i], obs_sl_boundary);
     }
   }
   obstacle_cost.safety_cost *= config_.path_resolution();
@@ -203,35 +288,36 @@ ComparableCost TrajectoryCost::CalculateStaticObstacleCost(
 }
 
 ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
-    const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s) const {
+    const QuinticPolynomialCurve1d &curve, const EdgeSamples &samples) const {
   ComparableCost obstacle_cost;
-  if (dynamic_obstacle_boxes_.empty()) {
+  if ((dynamic_obstacle_boxes_.empty() &&
+       num_indexed_dynamic_obstacles_ == 0) ||
+      samples.time_index.empty()) {
     return obstacle_cost;
   }
 
-  double time_stamp = 0.0;
-  for (size_t index = 0; index < num_of_time_stamps_;
-       ++index, time_stamp += config_.eval_time_interval()) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    double ref_s = speed_point.s() + init_sl_point_.s();
-    if (ref_s < start_s) {
-      continue;
+  std::vector<double> l;
+  std::vector<double> dl;
+  samples.dynamic_sampler.Evaluate(curve, 0, &l);
+  samples.dynamic_sampler.Evaluate(curve, 1, &dl);
+  for (size_t i = 0; i < samples.time_index.size(); ++i) {
+    const Box2d ego_box = GetBoxFromSample(samples, i, l[i], dl[i]);
+    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
+      obstacle_cost += GetCostBetweenObsBoxes(
+          ego_box, obstacle_trajectory.at(samples.time_index[i]));
     }
-    if (ref_s > end_s) {
-      break;
+    if (num_indexed_dynamic_obstacles_ == 0) {
+      continue;
     }
-
-    const double s = ref_s - start_s;  // s on spline curve
-    const double l = curve.Evaluate(0, s);
-    const double dl = curve.Evaluate(1, s);
-
-    const common::SLPoint sl = common::util::MakeSLPoint(ref_s, l);
-    const Box2d ego_box = GetBoxFromSLPoint(sl, dl);
-    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
-      obstacle_cost +=
-          GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
+    // any box within obstacle_ignore_distance of the ego box, once expanded
+    const double distance = config_.obstacle_ignore_distance() +
+                            ego_box.diagonal() / 2.0 + kObstacleBoxBuff;
+    for (const auto *obstacle_box : obstacle_box_index_->GetBoxes(
+             samples.time_index[i], ego_box.center(), distance)) {
+      if (is_indexed_dynamic_obstacle_[obstacle_box->obstacle_index()]) {
+        obstacle_cost += GetCostBetweenObsBoxes(
+            ego_box, ExpandObstacleBox(obstacle_box->box()));
+      }
     }
   }
   constexpr double kDynamicObsWeight = 1e-6;
@@ -241,7 +327,8 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
 }
 
 ComparableCost TrajectoryCost::GetCostFromObsSL(
-    const double adc_s, const double adc_l, const SLBoundary &obs_sl_boundary) {
+    const double adc_s, const double adc_l,
+    const SLBoundary &obs_sl_boundary) const {
   const auto &vehicle_param =
       common::VehicleConfigHelper::Instance()->GetConfig().vehicle_param();
 
@@ -310,37 +397,48 @@ ComparableCost TrajectoryCost::GetCostBetweenObsBoxes(
   return obstacle_cost;
 }
 
-Box2d TrajectoryCost::GetBoxFromSLPoint(const common::SLPoint &sl,
-                                        const double dl) const {
-  Vec2d xy_point;
-  reference_line_->SLToXY(sl, &xy_point);
-
-  ReferencePoint reference_point = reference_line_->GetReferencePoint(sl.s());
+// same as ReferenceLine::SLToXY on the sampled reference point
+Box2d TrajectoryCost::GetBoxFromSample(const EdgeSamples &samples,
+                                       const size_t i, const double l,
+                                       const double dl) const {
+  const auto angle = common::math::Angle16::from_rad(samples.ref_heading[i]);
+  const Vec2d xy_point(samples.ref_xy[i].x() - common::math::sin(angle) * l,
+                       samples.ref_xy[i].y() + common::math::cos(angle) * l);
 
-  const double one_minus_kappa_r_d = 1 - reference_point.kappa() * sl.l();
+  const double one_minus_kappa_r_d = 1 - samples.ref_kappa[i] * l;
   const double delta_theta = std::atan2(dl, one_minus_kappa_r_d);
   const double theta =
-      common::math::NormalizeAngle(delta_theta + reference_point.heading());
+      common::math::NormalizeAngle(delta_theta + samples.ref_heading[i]);
   return Box2d(xy_point, theta, vehicle_param_.length(),
                vehicle_param_.width());
 }
 
-// TODO(All): optimize obstacle cost calculation time
 ComparableCost TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
                                          const double start_s,
                                          const double end_s,
                                          const uint32_t curr_level,
                                          const uint32_t total_level) {
+  return Calculate(curve, SampleEdge(start_s, end_s), curr_level,
+                   total_level);
+}
+
+ComparableCost TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
+                                         const EdgeSamples &samples,
+                                         const uint32_t curr_level,
+                                         const uint32_t total_level) const {
+  // l is shared by the path and the static obstacle cost
+  std::vector<double> l;
+  samples.path_sampler.Evaluate(curve, 0, &l);
+
   ComparableCost total_cost;
   // path cost
-  total_cost +=
-      CalculatePathCost(curve, start_s, end_s, curr_level, total_level);
+  total_cost += CalculatePathCost(curve, samples, l, curr_level, total_level);
 
   // static obstacle cost
-  total_cost += CalculateStaticObstacleCost(curve, start_s, end_s);
+  total_cost += CalculateStaticObstacleCost(samples, l);
 
   // dynamic obstacle cost
-  total_cost += CalculateDynamicObstacleCost(curve, start_s, end_s);
+  total_cost += CalculateDynamicObstacleCost(curve, samples);
   return total_cost;
 }
 
@@ -27,9 +27,11 @@
 
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_index.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_sampler.h"
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/tasks/optimizers/road_graph/comparable_cost.h"
 
@@ -38,6 +40,29 @@ namespace planning {
 
 class TrajectoryCost {
  public:
+  // The samples of one edge between two levels. They only depend on the s
+  // range of the edge, so they are built once and shared by all its curves.
+  struct EdgeSamples {
+    double start_s = 0.0;
+    double end_s = 0.0;
+
+    // curve s every path_resolution up to end_s - start_s
+    QuinticPolynomialSampler path_sampler;
+    // the first num_path_cost_samples are below end_s - start_s and used by
+    // the path cost, the static obstacle cost uses all
+    size_t num_path_cost_samples = 0;
+    std::vector<double> lane_left_width;
+    std::vector<double> lane_right_width;
+
+    // curve s of the heuristic speed profile at the dynamic obstacle time
+    // stamps within the edge
+    QuinticPolynomialSampler dynamic_sampler;
+    std::vector<uint32_t> time_index;
+    std::vector<common::math::Vec2d> ref_xy;
+    std::vector<double> ref_heading;
+    std::vector<double> ref_kappa;
+  };
+
   TrajectoryCost() = default;
   explicit TrajectoryCost(const DpPolyPathConfig &config,
                           const ReferenceLine &reference_line,
@@ -46,36 +71,44 @@ class TrajectoryCost {
                           const common::VehicleParam &vehicle_param,
                           const SpeedData &heuristic_speed_data,
                           const common::SLPoint &init_sl_point,
-                          const SLBoundary &adc_sl_boundary);
+                          const SLBoundary &adc_sl_boundary,
+                          const ObstacleBoxIndex *obstacle_box_index = nullptr);
   ComparableCost Calculate(const QuinticPolynomialCurve1d &curve,
                            const double start_s, const double end_s,
                            const uint32_t curr_level,
                            const uint32_t total_level);
 
+  EdgeSamples SampleEdge(const double start_s, const double end_s) const;
+
+  ComparableCost Calculate(const QuinticPolynomialCurve1d &curve,
+                           const EdgeSamples &samples,
+                           const uint32_t curr_level,
+                           const uint32_t total_level) const;
+
  private:
   ComparableCost CalculatePathCost(const QuinticPolynomialCurve1d &curve,
-                                   const double start_s, const double end_s,
+                                   const EdgeSamples &samples,
+                                   const std::vector<double> &l,
                                    const uint32_t curr_level,
-                                   const uint32_t total_level);
-  ComparableCost CalculateStaticObstacleCost(
-      const QuinticPolynomialCurve1d &curve, const double start_s,
-      const double end_s);
+                                   const uint32_t total_level) const;
+  ComparableCost CalculateStaticObstacleCost(const EdgeSamples &samples,
+                                             const std::vector<double> &l) const;
   ComparableCost CalculateDynamicObstacleCost(
-      const QuinticPolynomialCurve1d &curve, const double start_s,
-      const double end_s) const;
+      const QuinticPolynomialCurve1d &curve, const EdgeSamples &samples) const;
   ComparableCost GetCostBetweenObsBoxes(
       const common::math::Box2d &ego_box,
       const common::math::Box2d &obstacle_box) const;
 
   FRIEND_TEST(AllTrajectoryTests, GetCostFromObsSL);
   ComparableCost GetCostFromObsSL(const double adc_s, const double adc_l,
-                                  const SLBoundary &obs_sl_boundary);
+                                  const SLBoundary &obs_sl_boundary) const;
 
-  common::math::Box2d GetBoxFromSLPoint(const common::SLPoint &sl,
-                                        const double dl) const;
+  common::math::Box2d GetBoxFromSample(const EdgeSamples &samples,
+                                       const size_t i, const double l,
+                                       const double dl) const;
 
   bool IsOffRoad(const double ref_s, const double l, const double dl,
-                 const bool is_change_lane_path);
+                 const double left_width, const double right_width) const;
 
   const DpPolyPathConfig config_;
   const ReferenceLine *reference_line_ = nullptr;
@@ -85,7 +118,14 @@ class TrajectoryCost {
   const common::SLPoint init_sl_point_;
   const SLBoundary adc_sl_boundary_;
   uint32_t num_of_time_stamps_ = 0;
+  // s on the reference line of the heuristic speed profile per time stamp
+  std::vector<double> time_stamp_ref_s_;
   std::vector<std::vector<common::math::Box2d>> dynamic_obstacle_boxes_;
+  // dynamic obstacles looked up in obstacle_box_index_ instead of
+  // dynamic_obstacle_boxes_, by their index in it
+  const ObstacleBoxIndex *obstacle_box_index_ = nullptr;
+  std::vector<bool> is_indexed_dynamic_obstacle_;
+  size_t num_indexed_dynamic_obstacles_ = 0;
   std::vector<double> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
@@ -29,6 +29,7 @@
 #include "modules/planning/proto/decision.pb.h"
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -68,7 +69,81 @@ StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_distance_(planning_distance),
       planning_time_(planning_time),
-      is_change_lane_(is_change_lane) {}
+      is_change_lane_(is_change_lane) {
+  InitAdcBoxes();
+}
+
+void StBoundaryMapper::AdcBoxes::Add(const Box2d& box) {
+  boxes_.push_back(box);
+  min_x_.push_back(box.min_x());
+  max_x_.push_back(box.max_x());
+  min_y_.push_back(box.min_y());
+  max_y_.push_back(box.max_y());
+  bound_min_x_ = std::fmin(bound_min_x_, box.min_x());
+  bound_max_x_ = std::fmax(bound_max_x_, box.max_x());
+  bound_min_y_ = std::fmin(bound_min_y_, box.min_y());
+  bound_max_y_ = std::fmax(bound_max_y_, box.max_y());
+}
+
+int StBoundaryMapper::AdcBoxes::FirstOverlap(const Box2d& box) const {
+  const double min_x = box.min_x();
+  const double max_x = box.max_x();
+  const double min_y = box.min_y();
+  const double max_y = box.max_y();
+  if (max_x < bound_min_x_ || min_x > bound_max_x_ || max_y < bound_min_y_ ||
+      min_y > bound_max_y_) {
+    return -1;
+  }
+  const int num_boxes = static_cast<int>(boxes_.size());
+  for (int i = 0; i < num_boxes; ++i) {
+    if (max_x < min_x_[i] || min_x > max_x_[i] || max_y < min_y_[i] ||
+        min_y > max_y_[i]) {
+      continue;
+    }
+    if (boxes_[i].HasOverlap(box)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void StBoundaryMapper::InitAdcBoxes() {
+  const auto& path_points = path_data_.discretized_path();
+  if (path_points.empty()) {
+    return;
+  }
+  const double buffer = st_boundary_config_.boundary_buffer();
+  for (const auto& path_point : path_points) {
+    if (path_point.s() > planning_distance_) {
+      break;
+    }
+    path_point_boxes_.Add(GetAdcBox(path_point, buffer));
+  }
+
+  const int default_num_point = 50;
+  if (path_points.size() > 2 * default_num_point) {
+    const auto ratio = path_points.size() / default_num_point;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_ = DiscretizedPath(sampled_path_points);
+  } else {
+    sampled_path_ = DiscretizedPath(path_points);
+  }
+
+  const double step_length = vehicle_param_.front_edge_to_center();
+  const auto path_len =
+      std::min(FLAGS_max_trajectory_len, sampled_path_.Length());
+  for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
+    const auto curr_adc_path_point =
+        sampled_path_.Evaluate(path_s + sampled_path_.front().s());
+    coarse_boxes_.Add(GetAdcBox(curr_adc_path_point, buffer));
+    coarse_s_.push_back(path_s);
+  }
+}
 
 Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   const auto& obstacles = path_decision->obstacles();
@@ -90,6 +165,8 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
+  std::vector<Obstacle*> obstacles_without_decision;
+  std::vector<std::pair<Obstacle*, ObjectDecisionType>> obstacles_with_decision;
 
   for (const auto* const_obstacle : obstacles.Items()) {
     auto* obstacle = path_decision->Find(const_obstacle->Id());
@@ -109,12 +186,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
     }
 
     if (!obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(obstacle).ok()) {
-        std::string msg = StrCat("Fail to map obstacle ", obstacle->Id(),
-                                 " without decision.");
-        AERROR << msg;
-        return Status(ErrorCode::PLANNING_ERROR, msg);
-      }
+      obstacles_without_decision.push_back(obstacle);
       continue;
     }
 
@@ -139,17 +211,18 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(obstacle, decision).ok()) {
-        AERROR << "Fail to map obstacle " << obstacle->Id()
-               << " with decision: " << decision.DebugString();
-        return Status(ErrorCode::PLANNING_ERROR,
-                      "Fail to map overtake/yield decision");
-      }
+      obstacles_with_decision.emplace_back(obstacle, decision);
     } else if (!decision.has_ignore()) {
       AWARN << "No mapping for decision: " << decision.DebugString();
     }
   }
 
+  const auto status =
+      MapObstacles(obstacles_without_decision, obstacles_with_decision);
+  if (!status.ok()) {
+    return status;
+  }
+
   if (stop_obstacle) {
     bool success = MapStopDecision(stop_obstacle, stop_decision);
     if (!success) {
@@ -190,9 +263,23 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
     }
   }
 
+  // the st boundaries of obstacles without a decision are needed below
+  std::vector<Obstacle*> obstacles_without_decision;
+  for (const auto* const_obstacle : obstacles.Items()) {
+    auto* obstacle = path_decision->Find(const_obstacle->Id());
+    if (!obstacle->HasLongitudinalDecision()) {
+      obstacles_without_decision.push_back(obstacle);
+    }
+  }
+  auto status = MapObstacles(obstacles_without_decision, {});
+  if (!status.ok()) {
+    return status;
+  }
+
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
+  std::vector<std::pair<Obstacle*, ObjectDecisionType>> obstacles_with_decision;
 
   for (const auto* const_obstacle : obstacles.Items()) {
     auto* obstacle = path_decision->Find(const_obstacle->Id());
@@ -205,12 +292,6 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
     }
 
     if (!obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(obstacle).ok()) {
-        std::string msg = StrCat("Fail to map obstacle ", obstacle->Id(),
-                                 " without decision.");
-        AERROR << msg;
-        return Status(ErrorCode::PLANNING_ERROR, msg);
-      }
       if (obstacle->st_boundary().IsEmpty() || decision.has_ignore()) {
         continue;
       }
@@ -238,17 +319,17 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(obstacle, decision).ok()) {
-        AERROR << "Fail to map obstacle " << obstacle->Id()
-               << " with decision: " << decision.DebugString();
-        return Status(ErrorCode::PLANNING_ERROR,
-                      "Fail to map overtake/yield decision");
-      }
+      obstacles_with_decision.emplace_back(obstacle, decision);
     } else {
       AWARN << "No mapping for decision: " << decision.DebugString();
     }
   }
 
+  status = MapObstacles({}, obstacles_with_decision);
+  if (!status.ok()) {
+    return status;
+  }
+
   if (stop_obstacle) {
     bool success = MapStopDecision(stop_obstacle, stop_decision);
     if (!success) {
@@ -260,6 +341,51 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
   return Status::OK();
 }
 
+Status StBoundaryMapper::MapObstacles(
+    const std::vector<Obstacle*>& obstacles_without_decision,
+    const std::vector<std::pair<Obstacle*, ObjectDecisionType>>&
+        obstacles_with_decision) const {
+  const size_t num_without_decision = obstacles_without_decision.size();
+  const size_t num_obstacles =
+      num_without_decision + obstacles_with_decision.size();
+  // every task sets the st boundary of its own obstacle only
+  std::vector<Status> statuses(num_obstacles);
+  auto map_obstacle = [&](size_t i) {
+    if (i < num_without_decision) {
+      statuses[i] = MapWithoutDecision(obstacles_without_decision[i]);
+    } else {
+      const auto& obstacle = obstacles_with_decision[i - num_without_decision];
+      statuses[i] = MapWithDecision(obstacle.first, obstacle.second);
+    }
+  };
+  if (FLAGS_enable_multi_thread_in_st_boundary_mapper) {
+    cyber::ParallelFor(0, num_obstacles, 1, map_obstacle);
+  } else {
+    for (size_t i = 0; i < num_obstacles; ++i) {
+      map_obstacle(i);
+    }
+  }
+
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    if (statuses[i].ok()) {
+      continue;
+    }
+    if (i < num_without_decision) {
+      std::string msg = StrCat("Fail to map obstacle ",
+                               obstacles_without_decision[i]->Id(),
+                               " without decision.");
+      AERROR << msg;
+      return Status(ErrorCode::PLANNING_ERROR, msg);
+    }
+    const auto& obstacle = obstacles_with_decision[i - num_without_decision];
+    AERROR << "Fail to map obstacle " << obstacle.first->Id()
+           << " with decision: " << obstacle.second.DebugString();
+    return Status(ErrorCode::PLANNING_ERROR,
+                  "Fail to map overtake/yield decision");
+  }
+  return Status::OK();
+}
+
 bool StBoundaryMapper::MapStopDecision(
     Obstacle* stop_obstacle, const ObjectDecisionType& stop_decision) const {
   DCHECK(stop_decision.has_stop()) << "Must have stop decision";
@@ -312,8 +438,7 @@ Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*obstacle, &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -334,15 +459,14 @@ Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
 }
 
 bool StBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
-    std::vector<STPoint>* upper_points,
+    const Obstacle& obstacle, std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
   DCHECK_NOTNULL(upper_points);
   DCHECK_NOTNULL(lower_points);
   DCHECK(upper_points->empty());
   DCHECK(lower_points->empty());
-  DCHECK_GT(path_points.size(), 0);
 
+  const auto& path_points = path_data_.discretized_path();
   if (path_points.empty()) {
     AERROR << "No points in path_data_.discretized_path().";
     return false;
@@ -355,47 +479,27 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
              << "] has NO prediction trajectory."
              << obstacle.Perception().ShortDebugString();
     }
-    for (const auto& curr_point_on_path : path_points) {
-      if (curr_point_on_path.s() > planning_distance_) {
-        break;
-      }
-      const Box2d obs_box = obstacle.PerceptionBoundingBox();
-
-      if (CheckOverlap(curr_point_on_path, obs_box,
-                       st_boundary_config_.boundary_buffer())) {
-        const double backward_distance = -vehicle_param_.front_edge_to_center();
-        const double forward_distance = vehicle_param_.length() +
-                                        vehicle_param_.width() +
-                                        obs_box.length() + obs_box.width();
-        double low_s =
-            std::fmax(0.0, curr_point_on_path.s() + backward_distance);
-        double high_s = std::fmin(planning_distance_,
-                                  curr_point_on_path.s() + forward_distance);
-        lower_points->emplace_back(low_s, 0.0);
-        lower_points->emplace_back(low_s, planning_time_);
-        upper_points->emplace_back(high_s, 0.0);
-        upper_points->emplace_back(high_s, planning_time_);
-        break;
-      }
+    const Box2d obs_box = obstacle.PerceptionBoundingBox();
+    const int index = path_point_boxes_.FirstOverlap(obs_box);
+    if (index >= 0) {
+      const auto& curr_point_on_path = path_points[index];
+      const double backward_distance = -vehicle_param_.front_edge_to_center();
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      double low_s = std::fmax(0.0, curr_point_on_path.s() + backward_distance);
+      double high_s = std::fmin(planning_distance_,
+                                curr_point_on_path.s() + forward_distance);
+      lower_points->emplace_back(low_s, 0.0);
+      lower_points->emplace_back(low_s, planning_time_);
+      upper_points->emplace_back(high_s, 0.0);
+      upper_points->emplace_back(high_s, planning_time_);
     }
   } else {
     const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path = DiscretizedPath(sampled_path_points);
-    } else {
-      discretized_path = DiscretizedPath(path_points);
-    }
+    const auto& discretized_path = sampled_path_;
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
-      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
 
       double trajectory_point_time = trajectory_point.relative_time();
       constexpr double kNegtiveTimeThreshold = -1.0;
@@ -403,65 +507,61 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
         continue;
       }
 
+      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
+      const int index = coarse_boxes_.FirstOverlap(obs_box);
+      if (index < 0) {
+        continue;
+      }
+      // found overlap, start searching with higher resolution
+      const double path_s = coarse_s_[index];
       const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
-                         st_boundary_config_.boundary_buffer())) {
-          // found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box,
-                                st_boundary_config_.boundary_buffer())) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box,
-                                st_boundary_config_.boundary_buffer())) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
-            }
+      const double backward_distance = -step_length;
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      const double default_min_step = 0.1;  // in meters
+      const double fine_tuning_step_length = std::fmin(
+          default_min_step, discretized_path.Length() / default_num_point);
+
+      bool find_low = false;
+      bool find_high = false;
+      double low_s = std::fmax(0.0, path_s + backward_distance);
+      double high_s =
+          std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+      while (low_s < high_s) {
+        if (find_low && find_high) {
+          break;
+        }
+        if (!find_low) {
+          const auto& point_low = discretized_path.Evaluate(
+              low_s + discretized_path.front().s());
+          if (!CheckOverlap(point_low, obs_box,
+                            st_boundary_config_.boundary_buffer())) {
+            low_s += fine_tuning_step_length;
+          } else {
+            find_low = true;
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - st_boundary_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + st_boundary_config_.point_extension(),
-                trajectory_point_time);
+        }
+        if (!find_high) {
+          const auto& point_high = discretized_path.Evaluate(
+              high_s + discretized_path.front().s());
+          if (!CheckOverlap(point_high, obs_box,
+                            st_boundary_config_.boundary_buffer())) {
+            high_s -= fine_tuning_step_length;
+          } else {
+            find_high = true;
           }
-          break;
         }
       }
+      if (find_high && find_low) {
+        lower_points->emplace_back(
+            low_s - st_boundary_config_.point_extension(),
+            trajectory_point_time);
+        upper_points->emplace_back(
+            high_s + st_boundary_config_.point_extension(),
+            trajectory_point_time);
+      }
     }
   }
   DCHECK_EQ(lower_points->size(), upper_points->size());
@@ -478,8 +578,7 @@ Status StBoundaryMapper::MapWithDecision(
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*obstacle, &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -529,6 +628,11 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(GetAdcBox(path_point, buffer));
+}
+
+Box2d StBoundaryMapper::GetAdcBox(const PathPoint& path_point,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -550,10 +654,8 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
           .rotate(path_point.theta());
   Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 }  // namespace planning
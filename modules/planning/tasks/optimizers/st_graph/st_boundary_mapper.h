@@ -20,12 +20,15 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/planning/proto/st_boundary_config.pb.h"
 
+#include "modules/common/math/box2d.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
@@ -61,15 +64,50 @@ class StBoundaryMapper {
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  /**
+   * ADC boxes along the path, built once and checked against every obstacle
+   * box. Their axis aligned bounds are kept in plain arrays, so most boxes
+   * are rejected by a tight loop before the separating axis test, and boxes
+   * away from all of them are rejected at once.
+   */
+  class AdcBoxes {
+   public:
+    void Add(const apollo::common::math::Box2d& box);
+
+    // index of the first box overlapping with box, -1 if there is none
+    int FirstOverlap(const apollo::common::math::Box2d& box) const;
+
+   private:
+    std::vector<apollo::common::math::Box2d> boxes_;
+    std::vector<double> min_x_;
+    std::vector<double> max_x_;
+    std::vector<double> min_y_;
+    std::vector<double> max_y_;
+    double bound_min_x_ = std::numeric_limits<double>::max();
+    double bound_max_x_ = std::numeric_limits<double>::lowest();
+    double bound_min_y_ = std::numeric_limits<double>::max();
+    double bound_max_y_ = std::numeric_limits<double>::lowest();
+  };
+
+  apollo::common::math::Box2d GetAdcBox(
+      const apollo::common::PathPoint& path_point, const double buffer) const;
+
+  void InitAdcBoxes();
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
    * upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<apollo::common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  // maps the obstacles, concurrently if enabled
+  apollo::common::Status MapObstacles(
+      const std::vector<Obstacle*>& obstacles_without_decision,
+      const std::vector<std::pair<Obstacle*, ObjectDecisionType>>&
+          obstacles_with_decision) const;
 
   apollo::common::Status MapWithoutDecision(Obstacle* obstacle) const;
 
@@ -88,6 +126,14 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+
+  // the discretized path sampled to at most about 100 points
+  DiscretizedPath sampled_path_;
+  // ADC boxes at the path points within planning_distance_
+  AdcBoxes path_point_boxes_;
+  // ADC boxes every front_edge_to_center along sampled_path_, and their s
+  AdcBoxes coarse_boxes_;
+  std::vector<double> coarse_s_;
 };
 
 }  // namespace planning
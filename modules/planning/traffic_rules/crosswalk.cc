@@ -54,6 +54,12 @@ using CrosswalkToStop =
 using CrosswalkStopTimer =
     std::unordered_map<std::string, std::unordered_map<std::string, double>>;
 
+double Crosswalk::expand_s_distance_ = 0.0;
+std::unordered_map<std::string, Polygon2d>
+    Crosswalk::expanded_crosswalk_polygons_;
+std::unordered_map<std::string, Crosswalk::CrosswalkClearance>
+    Crosswalk::crosswalk_clearances_;
+
 Crosswalk::Crosswalk(const TrafficRuleConfig& config) : TrafficRule(config) {}
 
 Status Crosswalk::ApplyRule(Frame* const frame,
@@ -66,7 +72,18 @@ Status Crosswalk::ApplyRule(Frame* const frame,
     return Status::OK();
   }
 
+  sequence_num_ = frame->SequenceNum();
   MakeDecisions(frame, reference_line_info);
+
+  // drop the obstacles which are gone
+  for (auto it = crosswalk_clearances_.begin();
+       it != crosswalk_clearances_.end();) {
+    if (it->second.sequence_num + 1 < sequence_num_) {
+      it = crosswalk_clearances_.erase(it);
+    } else {
+      ++it;
+    }
+  }
   return Status::OK();
 }
 
@@ -283,14 +300,9 @@ bool Crosswalk::CheckStopForObstacle(
     return false;
   }
 
-  // expand crosswalk polygon
   // note: crosswalk expanded area will include sideway area
-  Vec2d point(perception_obstacle.position().x(),
-              perception_obstacle.position().y());
-  const Polygon2d crosswalk_exp_poly =
-      crosswalk_ptr->polygon().ExpandByDistance(
-          config_.crosswalk().expand_s_distance());
-  bool in_expanded_crosswalk = crosswalk_exp_poly.IsPointIn(point);
+  const bool in_expanded_crosswalk =
+      IsInExpandedCrosswalk(crosswalk_ptr, obstacle);
 
   if (!in_expanded_crosswalk) {
     ADEBUG << "skip: obstacle_id[" << obstacle_id << "] type["
@@ -398,6 +410,45 @@ bool Crosswalk::CheckStopForObstacle(
   return stop;
 }
 
+const Polygon2d& Crosswalk::GetExpandedCrosswalkPolygon(
+    const CrosswalkInfoConstPtr crosswalk_ptr) {
+  const double expand_s_distance = config_.crosswalk().expand_s_distance();
+  if (expand_s_distance != expand_s_distance_) {
+    expanded_crosswalk_polygons_.clear();
+    crosswalk_clearances_.clear();
+    expand_s_distance_ = expand_s_distance;
+  }
+  const std::string& crosswalk_id = crosswalk_ptr->id().id();
+  auto it = expanded_crosswalk_polygons_.find(crosswalk_id);
+  if (it == expanded_crosswalk_polygons_.end()) {
+    it = expanded_crosswalk_polygons_
+             .emplace(crosswalk_id, crosswalk_ptr->polygon().ExpandByDistance(
+                                        expand_s_distance))
+             .first;
+  }
+  return it->second;
+}
+
+bool Crosswalk::IsInExpandedCrosswalk(
+    const CrosswalkInfoConstPtr crosswalk_ptr, const Obstacle& obstacle) {
+  const Polygon2d& crosswalk_exp_poly =
+      GetExpandedCrosswalkPolygon(crosswalk_ptr);
+  const Vec2d point(obstacle.Perception().position().x(),
+                    obstacle.Perception().position().y());
+  auto& clearance =
+      crosswalk_clearances_[crosswalk_ptr->id().id() + "/" + obstacle.Id()];
+  const bool is_cached = clearance.sequence_num + 1 >= sequence_num_ &&
+                         clearance.distance > 0.0;
+  clearance.sequence_num = sequence_num_;
+  if (is_cached &&
+      clearance.position.DistanceTo(point) < clearance.distance) {
+    return false;
+  }
+  clearance.position = point;
+  clearance.distance = crosswalk_exp_poly.DistanceTo(point);
+  return clearance.distance <= 0.0;
+}
+
 int Crosswalk::BuildStopDecision(Frame* const frame,
                                  ReferenceLineInfo* const reference_line_info,
                                  hdmap::PathOverlap* const crosswalk_overlap,
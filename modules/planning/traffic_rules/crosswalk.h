@@ -21,8 +21,11 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "modules/common/math/polygon2d.h"
+#include "modules/common/math/vec2d.h"
 #include "modules/planning/traffic_rules/traffic_rule.h"
 
 namespace apollo {
@@ -44,6 +47,10 @@ class Crosswalk : public TrafficRule {
       ReferenceLineInfo* const reference_line_info,
       const hdmap::CrosswalkInfoConstPtr crosswalk_ptr,
       const Obstacle& obstacle);
+  const common::math::Polygon2d& GetExpandedCrosswalkPolygon(
+      const hdmap::CrosswalkInfoConstPtr crosswalk_ptr);
+  bool IsInExpandedCrosswalk(const hdmap::CrosswalkInfoConstPtr crosswalk_ptr,
+                             const Obstacle& obstacle);
   int BuildStopDecision(Frame* frame,
                         ReferenceLineInfo* const reference_line_info,
                         hdmap::PathOverlap* const crosswalk_overlap,
@@ -52,6 +59,23 @@ class Crosswalk : public TrafficRule {
  private:
   static constexpr char const* const CROSSWALK_VO_ID_PREFIX = "CW_";
   std::vector<const hdmap::PathOverlap*> crosswalk_overlaps_;
+  uint32_t sequence_num_ = 0;
+
+  // an obstacle outside of an expanded crosswalk stays outside as long as it
+  // moves less than its distance to the crosswalk
+  struct CrosswalkClearance {
+    common::math::Vec2d position;
+    double distance = 0.0;
+    uint32_t sequence_num = 0;
+  };
+
+  // kept across frames, the crosswalk polygons only depend on the map
+  static double expand_s_distance_;
+  static std::unordered_map<std::string, common::math::Polygon2d>
+      expanded_crosswalk_polygons_;
+  // keyed by crosswalk id and obstacle id
+  static std::unordered_map<std::string, CrosswalkClearance>
+      crosswalk_clearances_;
 };
 
 }  // namespace planning
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "modules/common/status/status.h"
 #include "modules/planning/proto/auto_tuning_model_input.pb.h"
@@ -59,6 +60,23 @@ class AutotuningBaseModel {
   virtual double Evaluate(
       const autotuning::TrajectoryPointwiseFeature& point_feature) const = 0;
 
+  /**
+   * @brief : evaluate many candidate trajectories, models override it to
+   *          run them in one forward
+   * @param : input trajectory feature protos
+   * @return : the total value of reward / cost of each trajectory
+   */
+  virtual std::vector<double> EvaluateBatch(
+      const std::vector<autotuning::TrajectoryFeature>& trajectory_features)
+      const {
+    std::vector<double> values;
+    values.reserve(trajectory_features.size());
+    for (const auto& trajectory_feature : trajectory_features) {
+      values.push_back(Evaluate(trajectory_feature));
+    }
+    return values;
+  }
+
  protected:
   /**
    * @brief : stored autotuning mlp model
@@ -21,13 +21,18 @@ namespace planning {
 
 void AutotuningMLPModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
                              Eigen::MatrixXf* const output) const {
+  // each row is one sample, a batch runs through every layer once
+  if (layers_.empty()) {
+    output->resize(0, 0);
+    return;
+  }
   Eigen::MatrixXf inp = inputs[0];
   Eigen::MatrixXf temp;
   for (size_t i = 0; i < layers_.size(); ++i) {
     layers_[i]->Run({inp}, &temp);
-    inp = temp;
+    inp.swap(temp);
   }
-  *output = temp;
+  output->swap(inp);
 }
 
 }  // namespace planning
@@ -38,16 +38,21 @@ AutotuningRawFeatureGenerator::AutotuningRawFeatureGenerator(
     : reference_line_info_(reference_line_info),
       frame_(frame),
       speed_limit_(speed_limit),
-      obs_boundaries_(num_points, std::vector<std::array<double, 3>>()),
-      stop_boundaries_(num_points, std::vector<std::array<double, 3>>()),
-      nudge_boundaries_(num_points, std::vector<std::array<double, 3>>()),
-      side_pass_boundaries_(num_points, std::vector<std::array<double, 3>>()) {
+      obs_boundaries_(num_points + 1, std::vector<std::array<double, 3>>()),
+      stop_boundaries_(num_points + 1, std::vector<std::array<double, 3>>()),
+      nudge_boundaries_(num_points + 1, std::vector<std::array<double, 3>>()),
+      side_pass_boundaries_(num_points + 1,
+                            std::vector<std::array<double, 3>>()) {
   CHECK_GT(num_points, 0);
   CHECK_GT(time_range, kMinTimeRange);
+  // num_points intervals, both ends included
   double res = time_range / static_cast<double>(num_points);
-  for (double t = 0; t < res + time_range; t += res) {
-    eval_time_.push_back(t);
+  eval_time_.reserve(num_points + 1);
+  for (size_t i = 0; i <= num_points; ++i) {
+    eval_time_.push_back(res * static_cast<double>(i));
   }
+  // the obstacles are discretized once, shared by every evaluated profile
+  GenerateSTBoundaries(reference_line_info_);
 }
 
 common::Status AutotuningRawFeatureGenerator::EvaluateTrajectory(
@@ -77,12 +82,7 @@ common::Status AutotuningRawFeatureGenerator::EvaluateSpeedPoint(
   speed_feature->set_j(speed_point.da());
 
   // get speed limit at certain s();
-  if (speed_limit_.MinValidS() > s) {
-    speed_feature->set_speed_limit(kDefaultSpeedLimit);
-  } else {
-    double cur_speed_limit = speed_limit_.GetSpeedLimitByS(s);
-    speed_feature->set_speed_limit(cur_speed_limit);
-  }
+  speed_feature->set_speed_limit(GetSpeedLimitByS(s));
 
   // extracting obstacle related infos
 
@@ -144,6 +144,49 @@ common::Status AutotuningRawFeatureGenerator::EvaluateSpeedProfile(
   return common::Status::OK();
 }
 
+common::Status AutotuningRawFeatureGenerator::EvaluateSpeedProfiles(
+    const std::vector<std::vector<common::SpeedPoint>>& speed_profiles,
+    std::vector<autotuning::TrajectoryRawFeature>* const trajectory_features)
+    const {
+  for (const auto& speed_profile : speed_profiles) {
+    if (speed_profile.size() != eval_time_.size()) {
+      AERROR << "Evaluated time size and speed profile size is different";
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "mismatched evaluated time and speed profile size");
+    }
+  }
+  trajectory_features->resize(speed_profiles.size());
+  for (size_t j = 0; j < speed_profiles.size(); ++j) {
+    (*trajectory_features)[j].Clear();
+    auto* point_features =
+        (*trajectory_features)[j].mutable_point_feature();
+    point_features->Reserve(static_cast<int>(eval_time_.size()));
+  }
+  // time major, the boundaries at a time are visited once for all profiles
+  for (size_t i = 0; i < eval_time_.size(); ++i) {
+    for (size_t j = 0; j < speed_profiles.size(); ++j) {
+      auto* trajectory_point_feature =
+          (*trajectory_features)[j].add_point_feature();
+      auto status = EvaluateSpeedPoint(speed_profiles[j][i], i,
+                                       trajectory_point_feature);
+      if (status != common::Status::OK()) {
+        return Status(ErrorCode::PLANNING_ERROR,
+                      "Extracting speed profile error");
+      }
+    }
+  }
+  return common::Status::OK();
+}
+
+double AutotuningRawFeatureGenerator::GetSpeedLimitByS(const double s) const {
+  // speed limit is invalid before its first point, or without points at all
+  if (speed_limit_.speed_limit_points().size() < 2 ||
+      speed_limit_.MinValidS() > s) {
+    return kDefaultSpeedLimit;
+  }
+  return speed_limit_.GetSpeedLimitByS(s);
+}
+
 void AutotuningRawFeatureGenerator::GenerateSTBoundaries(
     const ReferenceLineInfo& reference_line_info) {
   const auto& path_decision = reference_line_info.path_decision();
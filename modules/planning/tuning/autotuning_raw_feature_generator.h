@@ -69,6 +69,16 @@ class AutotuningRawFeatureGenerator {
       const std::vector<common::SpeedPoint>& speed_profile,
       autotuning::TrajectoryRawFeature* const trajectory_feature) const;
 
+  /**
+   * EvaluateSpeedProfiles evaluates the speed profiles of many candidate
+   * trajectories at once, against the obstacle boundaries discretized once
+   * for all of them. Each shall match the time range as well as resolution.
+   */
+  common::Status EvaluateSpeedProfiles(
+      const std::vector<std::vector<common::SpeedPoint>>& speed_profiles,
+      std::vector<autotuning::TrajectoryRawFeature>* const trajectory_features)
+      const;
+
  private:
   void GenerateSTBoundaries(const ReferenceLineInfo& reference_line_info);
 
@@ -83,6 +93,8 @@ class AutotuningRawFeatureGenerator {
                                     autotuning::TrajectoryPointRawFeature* const
                                         trajectory_point_feature) const;
 
+  double GetSpeedLimitByS(const double s) const;
+
  private:
   std::vector<double> eval_time_;
   const ReferenceLineInfo& reference_line_info_;
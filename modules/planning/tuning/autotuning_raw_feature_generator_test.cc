@@ -73,5 +73,33 @@ TEST_F(AutotuningRawFeatureGeneratorTest, generate_input_trajectory_pointwise) {
   EXPECT_TRUE(result == common::Status::OK());
 }
 
+TEST_F(AutotuningRawFeatureGeneratorTest, generate_speed_profiles) {
+  ASSERT_TRUE(generator_ != nullptr);
+  // 17 intervals over 8 seconds, 18 points each
+  std::vector<std::vector<common::SpeedPoint>> speed_profiles(
+      3, std::vector<common::SpeedPoint>(18));
+  for (size_t j = 0; j < speed_profiles.size(); ++j) {
+    for (size_t i = 0; i < speed_profiles[j].size(); ++i) {
+      speed_profiles[j][i].set_t(8.0 * static_cast<double>(i) / 17.0);
+      speed_profiles[j][i].set_v(static_cast<double>(j));
+      speed_profiles[j][i].set_s(static_cast<double>(i * j));
+    }
+  }
+  std::vector<autotuning::TrajectoryRawFeature> features;
+  auto result = generator_->EvaluateSpeedProfiles(speed_profiles, &features);
+  EXPECT_TRUE(result == common::Status::OK());
+  ASSERT_EQ(features.size(), 3);
+  for (size_t j = 0; j < features.size(); ++j) {
+    ASSERT_EQ(features[j].point_feature_size(), 18);
+    const auto& speed_feature = features[j].point_feature(17).speed_feature();
+    EXPECT_DOUBLE_EQ(speed_feature.v(), static_cast<double>(j));
+    EXPECT_DOUBLE_EQ(speed_feature.s(), static_cast<double>(17 * j));
+  }
+
+  speed_profiles[1].pop_back();
+  result = generator_->EvaluateSpeedProfiles(speed_profiles, &features);
+  EXPECT_FALSE(result == common::Status::OK());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -29,6 +29,8 @@ constexpr double kMaxStop = 60.0;
 constexpr double kMaxNudge = 60.0;
 constexpr double kMaxNudgeLateralDistance = 10.0;
 constexpr double kMaxSidePassDistance = 100.0;
+// columns of a flattened speed point feature
+constexpr int kFeatureSize = 21;
 }
 
 common::Status AutotuningSpeedMLPModel::SetParams() {
@@ -39,19 +41,66 @@ common::Status AutotuningSpeedMLPModel::SetParams() {
 
 double AutotuningSpeedMLPModel::Evaluate(
     const autotuning::TrajectoryFeature& trajectory_feature) const {
-  return 0.0;
+  Eigen::MatrixXd flat_feature;
+  FlattenFeatures(trajectory_feature, &flat_feature);
+  return RunModel(flat_feature,
+                  {static_cast<int>(flat_feature.rows())}).front();
 }
 
 double AutotuningSpeedMLPModel::Evaluate(
     const autotuning::TrajectoryPointwiseFeature& point_feature) const {
-  return 0.0;
+  Eigen::MatrixXd flat_feature(1, kFeatureSize);
+  FlattenFeatures(point_feature.speed_input_feature(), 0, &flat_feature);
+  return RunModel(flat_feature, {1}).front();
+}
+
+std::vector<double> AutotuningSpeedMLPModel::EvaluateBatch(
+    const std::vector<autotuning::TrajectoryFeature>& trajectory_features)
+    const {
+  std::vector<int> row_counts;
+  row_counts.reserve(trajectory_features.size());
+  int row_count = 0;
+  for (const auto& trajectory_feature : trajectory_features) {
+    row_counts.push_back(trajectory_feature.point_feature_size());
+    row_count += row_counts.back();
+  }
+  Eigen::MatrixXd flat_feature(row_count, kFeatureSize);
+  int row = 0;
+  for (const auto& trajectory_feature : trajectory_features) {
+    for (int i = 0; i < trajectory_feature.point_feature_size(); ++i) {
+      FlattenFeatures(trajectory_feature.point_feature(i).speed_input_feature(),
+                      row++, &flat_feature);
+    }
+  }
+  return RunModel(flat_feature, row_counts);
+}
+
+std::vector<double> AutotuningSpeedMLPModel::RunModel(
+    const Eigen::MatrixXd& flat_feature,
+    const std::vector<int>& row_counts) const {
+  std::vector<double> values(row_counts.size(), 0.0);
+  if (mlp_model_ == nullptr || flat_feature.rows() == 0) {
+    return values;
+  }
+  Eigen::MatrixXf output;
+  mlp_model_->Run({flat_feature.cast<float>()}, &output);
+  // a model without layers loaded gives no output per row
+  if (output.rows() != flat_feature.rows()) {
+    return values;
+  }
+  int start = 0;
+  for (size_t i = 0; i < row_counts.size(); ++i) {
+    values[i] = output.middleRows(start, row_counts[i]).cast<double>().sum();
+    start += row_counts[i];
+  }
+  return values;
 }
 
 void AutotuningSpeedMLPModel::FlattenFeatures(
     const autotuning::TrajectoryFeature& feature,
     Eigen::MatrixXd* const flat_feature) const {
   int row_count = feature.point_feature_size();
-  int col_count = 21;
+  int col_count = kFeatureSize;
   flat_feature->resize(row_count, col_count);
 
   for (int i = 0; i < row_count; ++i) {
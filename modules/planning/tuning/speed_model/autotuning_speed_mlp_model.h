@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "modules/common/status/status.h"
 #include "modules/planning/tuning/autotuning_base_model.h"
 
@@ -48,6 +50,16 @@ class AutotuningSpeedMLPModel : public AutotuningBaseModel {
   double Evaluate(const autotuning::TrajectoryPointwiseFeature& point_feature)
       const override;
 
+  /**
+   * @brief : evaluate many trajectories, all their points flattened into one
+   *          matrix and run in one forward of the mlp model
+   * @param : input trajectory feature protos
+   * @return : the total value of reward / cost of each trajectory
+   */
+  std::vector<double> EvaluateBatch(
+      const std::vector<autotuning::TrajectoryFeature>& trajectory_features)
+      const override;
+
  private:
   /**
    * [FlattenFeatures description]
@@ -60,6 +72,15 @@ class AutotuningSpeedMLPModel : public AutotuningBaseModel {
   void FlattenFeatures(
       const autotuning::SpeedPointwiseFeature& speed_point_feature,
       const int row, Eigen::MatrixXd* const flat_feature) const;
+
+  /**
+   * @brief : run the mlp model on flattened features
+   * @param : flat_feature, one point per row
+   * @param : row_counts, rows of each trajectory, consecutive
+   * @return : the summed model output over the rows of each trajectory
+   */
+  std::vector<double> RunModel(const Eigen::MatrixXd& flat_feature,
+                               const std::vector<int>& row_counts) const;
 };
 
 }  // namespace planning
@@ -30,5 +30,22 @@ TEST(AutotuningSpeedMLPModel, test_case_one) {
   EXPECT_TRUE(speed_model.SetParams() == common::Status::OK());
 }
 
+TEST(AutotuningSpeedMLPModel, test_evaluate_batch) {
+  AutotuningSpeedMLPModel speed_model;
+  EXPECT_TRUE(speed_model.SetParams() == common::Status::OK());
+  std::vector<autotuning::TrajectoryFeature> features(2);
+  for (int i = 0; i < 5; ++i) {
+    features[0].add_point_feature()->mutable_speed_input_feature()->set_v(i);
+  }
+  features[1].add_point_feature();
+  // no layers loaded, every trajectory costs nothing
+  std::vector<double> values = speed_model.EvaluateBatch(features);
+  ASSERT_EQ(values.size(), 2);
+  EXPECT_DOUBLE_EQ(values[0], 0.0);
+  EXPECT_DOUBLE_EQ(values[1], 0.0);
+  EXPECT_DOUBLE_EQ(speed_model.Evaluate(features[0]), 0.0);
+  EXPECT_TRUE(speed_model.EvaluateBatch({}).empty());
+}
+
 }  // namespace planning
 }  // namespace apollo
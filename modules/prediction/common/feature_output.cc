@@ -46,6 +46,9 @@ bool FeatureOutput::Ready() {
 }
 
 void FeatureOutput::Insert(const Feature& feature) {
+  if (!FLAGS_offline_dump_feature_proto) {
+    return;
+  }
   features_.add_feature()->CopyFrom(feature);
 }
 
@@ -52,6 +52,22 @@ DEFINE_double(lane_search_radius_in_junction, 15.0,
 DEFINE_double(junction_search_radius, 1.0, "Search radius for a junction");
 DEFINE_double(pedestrian_nearby_lane_search_radius, 3.0,
               "Radius to determine if pedestrian-like obstacle is near lane.");
+DEFINE_bool(enable_map_query_cache, false,
+            "Serve the junction and lane radius queries from a grid cache");
+DEFINE_double(map_query_cache_grid_size, 4.0,
+              "Size of the grid cells of the map query cache");
+DEFINE_int32(max_num_map_query_cache_cells, 10000,
+             "Maximal number of cached queries before the cache is reset");
+DEFINE_double(semantic_map_resolution, 0.1,
+              "Meters per pixel of the semantic map images");
+DEFINE_int32(semantic_map_tile_size, 512,
+             "Pixels of the side of the pre-rendered semantic map tiles");
+DEFINE_int32(semantic_map_image_size, 224,
+             "Pixels of the side of the semantic map image of an agent");
+DEFINE_double(semantic_map_max_history_time, 1.0,
+              "Seconds of obstacle history drawn in the semantic map images");
+DEFINE_int32(max_num_semantic_map_tiles, 64,
+             "Maximal number of cached semantic map tiles");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0, "Distance threshold "
@@ -174,6 +190,9 @@ DEFINE_double(default_s_if_no_obstacle_in_lane_sequence, 1000.0,
               "The default s value if no obstacle in the lane sequence.");
 DEFINE_double(default_l_if_no_obstacle_in_lane_sequence, 10.0,
               "The default l value if no obstacle in the lane sequence.");
+DEFINE_bool(enable_batch_evaluation, false,
+            "If evaluate the obstacles of an evaluator together with one "
+            "forward pass of its network");
 
 // Obstacle trajectory
 DEFINE_bool(enable_cruise_regression, false,
@@ -231,6 +250,12 @@ DEFINE_bool(use_bell_curve_for_cost_function, false,
 
 DEFINE_int32(road_graph_max_search_horizon, 20,
              "Maximal search depth for building road graph");
+DEFINE_bool(enable_lane_graph_cache, false,
+            "Reuse the lane graphs across obstacles and frames");
+DEFINE_double(lane_graph_cache_s_resolution, 1.0,
+              "Resolution of the search end s of the cached lane graphs");
+DEFINE_int32(max_num_cached_lane_graph, 1000,
+             "Maximal number of cached lane graphs");
 
 DEFINE_double(lane_distance_threshold, 3.0,
               "The threshold for distance to ego/neighbor lane "
@@ -40,6 +40,14 @@ DECLARE_double(lane_search_radius);
 DECLARE_double(lane_search_radius_in_junction);
 DECLARE_double(junction_search_radius);
 DECLARE_double(pedestrian_nearby_lane_search_radius);
+DECLARE_bool(enable_map_query_cache);
+DECLARE_double(map_query_cache_grid_size);
+DECLARE_int32(max_num_map_query_cache_cells);
+DECLARE_double(semantic_map_resolution);
+DECLARE_int32(semantic_map_tile_size);
+DECLARE_int32(semantic_map_image_size);
+DECLARE_double(semantic_map_max_history_time);
+DECLARE_int32(max_num_semantic_map_tiles);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
@@ -111,6 +119,7 @@ DECLARE_double(distance_to_slow_down_at_stop_sign);
 DECLARE_double(time_to_center_if_not_reach);
 DECLARE_double(default_s_if_no_obstacle_in_lane_sequence);
 DECLARE_double(default_l_if_no_obstacle_in_lane_sequence);
+DECLARE_bool(enable_batch_evaluation);
 
 // Obstacle trajectory
 DECLARE_bool(enable_cruise_regression);
@@ -139,6 +148,9 @@ DECLARE_double(cost_function_sigma);
 DECLARE_bool(use_bell_curve_for_cost_function);
 
 DECLARE_int32(road_graph_max_search_horizon);
+DECLARE_bool(enable_lane_graph_cache);
+DECLARE_double(lane_graph_cache_s_resolution);
+DECLARE_int32(max_num_cached_lane_graph);
 
 // scenario feature extraction
 DECLARE_double(lane_distance_threshold);
@@ -17,7 +17,11 @@
 #include "modules/prediction/common/prediction_map.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -35,8 +39,200 @@ using apollo::hdmap::PNCJunctionInfo;
 using apollo::hdmap::OverlapInfo;
 using apollo::hdmap::MapPathPoint;
 
+namespace {
+
+// Grid cell of a query point together with the query radius
+struct QueryCell {
+  int64_t x;
+  int64_t y;
+  double radius;
+
+  bool operator==(const QueryCell& other) const {
+    return x == other.x && y == other.y && radius == other.radius;
+  }
+};
+
+struct QueryCellHash {
+  size_t operator()(const QueryCell& cell) const {
+    size_t seed = std::hash<int64_t>()(cell.x);
+    seed ^= std::hash<int64_t>()(cell.y) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    seed ^= std::hash<double>()(cell.radius) + 0x9e3779b9 + (seed << 6) +
+            (seed >> 2);
+    return seed;
+  }
+};
+
+QueryCell GetQueryCell(const Eigen::Vector2d& point, const double radius) {
+  const double grid_size = FLAGS_map_query_cache_grid_size;
+  return {static_cast<int64_t>(std::floor(point.x() / grid_size)),
+          static_cast<int64_t>(std::floor(point.y() / grid_size)), radius};
+}
+
+// The candidates of a cell are the objects within the query radius of any
+// point in the cell, a query then only keeps the ones within its radius.
+common::PointENU CellCenter(const QueryCell& cell) {
+  const double grid_size = FLAGS_map_query_cache_grid_size;
+  common::PointENU center;
+  center.set_x((static_cast<double>(cell.x) + 0.5) * grid_size);
+  center.set_y((static_cast<double>(cell.y) + 0.5) * grid_size);
+  return center;
+}
+
+double CandidateRadius(const QueryCell& cell) {
+  return cell.radius + 0.5 * std::sqrt(2.0) * FLAGS_map_query_cache_grid_size;
+}
+
+template <typename T>
+using CandidateMap =
+    std::unordered_map<QueryCell, std::vector<std::shared_ptr<const T>>,
+                       QueryCellHash>;
+
+std::mutex map_query_cache_mutex;
+const hdmap::HDMap* map_query_cache_map = nullptr;
+CandidateMap<JunctionInfo> junction_candidates;
+CandidateMap<LaneInfo> lane_candidates;
+
+// Reset the cache when the base map was switched or the cache is full,
+// requires map_query_cache_mutex.
+void CheckMapQueryCache() {
+  const hdmap::HDMap* base_map = HDMapUtil::BaseMapPtr();
+  const size_t max_num_cells =
+      static_cast<size_t>(FLAGS_max_num_map_query_cache_cells);
+  if (base_map != map_query_cache_map ||
+      junction_candidates.size() + lane_candidates.size() > max_num_cells) {
+    junction_candidates.clear();
+    lane_candidates.clear();
+    map_query_cache_map = base_map;
+  }
+}
+
+const std::vector<std::shared_ptr<const JunctionInfo>>& JunctionCandidates(
+    const QueryCell& cell, CandidateMap<JunctionInfo>* candidate_map) {
+  auto iter = candidate_map->find(cell);
+  if (iter != candidate_map->end()) {
+    return iter->second;
+  }
+  auto& candidates = (*candidate_map)[cell];
+  HDMapUtil::BaseMap().GetJunctions(CellCenter(cell), CandidateRadius(cell),
+                                    &candidates);
+  return candidates;
+}
+
+const std::vector<std::shared_ptr<const LaneInfo>>& LaneCandidates(
+    const QueryCell& cell, CandidateMap<LaneInfo>* candidate_map) {
+  auto iter = candidate_map->find(cell);
+  if (iter != candidate_map->end()) {
+    return iter->second;
+  }
+  auto& candidates = (*candidate_map)[cell];
+  HDMapUtil::BaseMap().GetLanes(CellCenter(cell), CandidateRadius(cell),
+                                &candidates);
+  return candidates;
+}
+
+void FilterJunctions(
+    const Eigen::Vector2d& point, const double radius,
+    const std::vector<std::shared_ptr<const JunctionInfo>>& candidates,
+    std::vector<std::shared_ptr<const JunctionInfo>>* junctions) {
+  junctions->clear();
+  for (const auto& junction : candidates) {
+    if (junction->polygon().DistanceTo(Vec2d(point.x(), point.y())) <=
+        radius) {
+      junctions->push_back(junction);
+    }
+  }
+}
+
+void FilterLanes(const Eigen::Vector2d& point, const double radius,
+                 const std::vector<std::shared_ptr<const LaneInfo>>& candidates,
+                 std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
+  lanes->clear();
+  for (const auto& lane : candidates) {
+    if (lane->DistanceTo(Vec2d(point.x(), point.y())) <= radius) {
+      lanes->push_back(lane);
+    }
+  }
+}
+
+}  // namespace
+
 bool PredictionMap::Ready() { return HDMapUtil::BaseMapPtr() != nullptr; }
 
+void PredictionMap::QueryJunctions(
+    const Eigen::Vector2d& point, const double radius,
+    std::vector<std::shared_ptr<const JunctionInfo>>* junctions) {
+  if (!FLAGS_enable_map_query_cache) {
+    common::PointENU hdmap_point;
+    hdmap_point.set_x(point.x());
+    hdmap_point.set_y(point.y());
+    HDMapUtil::BaseMap().GetJunctions(hdmap_point, radius, junctions);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(map_query_cache_mutex);
+  CheckMapQueryCache();
+  FilterJunctions(
+      point, radius,
+      JunctionCandidates(GetQueryCell(point, radius), &junction_candidates),
+      junctions);
+}
+
+void PredictionMap::QueryLanes(
+    const Eigen::Vector2d& point, const double radius,
+    std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
+  if (!FLAGS_enable_map_query_cache) {
+    common::PointENU hdmap_point;
+    hdmap_point.set_x(point.x());
+    hdmap_point.set_y(point.y());
+    HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, lanes);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(map_query_cache_mutex);
+  CheckMapQueryCache();
+  FilterLanes(point, radius,
+              LaneCandidates(GetQueryCell(point, radius), &lane_candidates),
+              lanes);
+}
+
+void PredictionMap::GetJunctions(
+    const std::vector<Eigen::Vector2d>& points, const double radius,
+    std::vector<std::vector<std::shared_ptr<const JunctionInfo>>>*
+        junctions) {
+  junctions->resize(points.size());
+  if (FLAGS_enable_map_query_cache) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      QueryJunctions(points[i], radius, &(*junctions)[i]);
+    }
+    return;
+  }
+  // without the cache the candidates of the cells only live for this batch
+  CandidateMap<JunctionInfo> candidate_map;
+  for (size_t i = 0; i < points.size(); ++i) {
+    FilterJunctions(
+        points[i], radius,
+        JunctionCandidates(GetQueryCell(points[i], radius), &candidate_map),
+        &(*junctions)[i]);
+  }
+}
+
+void PredictionMap::GetNearbyLanes(
+    const std::vector<Eigen::Vector2d>& points, const double radius,
+    std::vector<std::vector<std::shared_ptr<const LaneInfo>>>* lanes) {
+  lanes->resize(points.size());
+  if (FLAGS_enable_map_query_cache) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      QueryLanes(points[i], radius, &(*lanes)[i]);
+    }
+    return;
+  }
+  CandidateMap<LaneInfo> candidate_map;
+  for (size_t i = 0; i < points.size(); ++i) {
+    FilterLanes(points[i], radius,
+                LaneCandidates(GetQueryCell(points[i], radius), &candidate_map),
+                &(*lanes)[i]);
+  }
+}
+
 Eigen::Vector2d PredictionMap::PositionOnLane(
     const std::shared_ptr<const LaneInfo> lane_info, const double s) {
   common::PointENU point = lane_info->GetSmoothPoint(s);
@@ -89,11 +285,8 @@ bool PredictionMap::GetProjection(
 
 bool PredictionMap::HasNearbyLane(const double x, const double y,
                                   const double radius) {
-  common::PointENU point_enu;
-  point_enu.set_x(x);
-  point_enu.set_y(y);
   std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  HDMapUtil::BaseMap().GetLanes(point_enu, radius, &lanes);
+  QueryLanes({x, y}, radius, &lanes);
   return (!lanes.empty());
 }
 
@@ -130,10 +323,7 @@ bool PredictionMap::IsVirtualLane(const std::string& lane_id) {
 bool PredictionMap::OnVirtualLane(const Eigen::Vector2d& point,
                                   const double radius) {
   std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point[0]);
-  hdmap_point.set_y(point[1]);
-  HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, &lanes);
+  QueryLanes(point, radius, &lanes);
   for (const auto& lane : lanes) {
     if (IsVirtualLane(lane->id().id())) {
       return true;
@@ -267,11 +457,8 @@ bool PredictionMap::IsProjectionApproximateWithinLane(
 
 bool PredictionMap::NearJunction(const Eigen::Vector2d& point,
                                  const double radius) {
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point.x());
-  hdmap_point.set_y(point.y());
   std::vector<std::shared_ptr<const JunctionInfo>> junctions;
-  HDMapUtil::BaseMap().GetJunctions(hdmap_point, radius, &junctions);
+  QueryJunctions(point, radius, &junctions);
   return junctions.size() > 0;
 }
 
@@ -284,11 +471,8 @@ bool PredictionMap::IsPointInJunction(
 
 std::vector<std::shared_ptr<const JunctionInfo>> PredictionMap::GetJunctions(
     const Eigen::Vector2d& point, const double radius) {
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point.x());
-  hdmap_point.set_y(point.y());
   std::vector<std::shared_ptr<const JunctionInfo>> junctions;
-  HDMapUtil::BaseMap().GetJunctions(hdmap_point, radius, &junctions);
+  QueryJunctions(point, radius, &junctions);
   return junctions;
 }
 
@@ -488,10 +672,7 @@ std::vector<std::string> PredictionMap::NearbyLaneIds(
     const Eigen::Vector2d& point, const double radius) {
   std::vector<std::string> lane_ids;
   std::vector<std::shared_ptr<const LaneInfo>> lanes;
-  common::PointENU hdmap_point;
-  hdmap_point.set_x(point[0]);
-  hdmap_point.set_y(point[1]);
-  HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, &lanes);
+  QueryLanes(point, radius, &lanes);
   for (const auto& lane : lanes) {
     lane_ids.push_back(lane->id().id());
   }
@@ -660,7 +841,7 @@ std::vector<std::shared_ptr<const LaneInfo>> PredictionMap::GetNearbyLanes(
 
   std::vector<std::shared_ptr<const LaneInfo>> nearby_lanes;
 
-  HDMapUtil::BaseMap().GetLanes(position, nearby_radius, &nearby_lanes);
+  QueryLanes({position.x(), position.y()}, nearby_radius, &nearby_lanes);
   return nearby_lanes;
 }
 
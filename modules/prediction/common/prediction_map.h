@@ -404,7 +404,40 @@ class PredictionMap {
   static std::vector<std::shared_ptr<const hdmap::LaneInfo>> GetNearbyLanes(
       const common::PointENU& position, const double nearby_radius);
 
+  /**
+   * @brief Get the junctions near each of the points. The points in the same
+   *        grid cell share one map query.
+   * @param points The positions.
+   * @param radius The search radius.
+   * @param junctions The junctions near each point, in the order of points.
+   */
+  static void GetJunctions(
+      const std::vector<Eigen::Vector2d>& points, const double radius,
+      std::vector<std::vector<std::shared_ptr<const hdmap::JunctionInfo>>>*
+          junctions);
+
+  /**
+   * @brief Get the lanes near each of the points. The points in the same
+   *        grid cell share one map query.
+   * @param points The positions.
+   * @param radius The search radius.
+   * @param lanes The lanes near each point, in the order of points.
+   */
+  static void GetNearbyLanes(
+      const std::vector<Eigen::Vector2d>& points, const double radius,
+      std::vector<std::vector<std::shared_ptr<const hdmap::LaneInfo>>>* lanes);
+
  private:
+  // radius queries of the map, served from the grid cache when
+  // enable_map_query_cache is set
+  static void QueryJunctions(
+      const Eigen::Vector2d& point, const double radius,
+      std::vector<std::shared_ptr<const hdmap::JunctionInfo>>* junctions);
+
+  static void QueryLanes(
+      const Eigen::Vector2d& point, const double radius,
+      std::vector<std::shared_ptr<const hdmap::LaneInfo>>* lanes);
+
   static std::shared_ptr<const hdmap::LaneInfo> GetNeighborLane(
       const std::shared_ptr<const hdmap::LaneInfo>& ptr_ego_lane,
       const Eigen::Vector2d& ego_position,
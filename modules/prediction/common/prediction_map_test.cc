@@ -16,6 +16,8 @@
 
 #include "modules/prediction/common/prediction_map.h"
 
+#include <algorithm>
+
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
 
@@ -259,6 +261,39 @@ TEST_F(PredictionMapTest, neighbor_lane_detection) {
                                               curr_lanes));
 }
 
+TEST_F(PredictionMapTest, cached_nearby_lanes) {
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i < 20; ++i) {
+    points.emplace_back(120.0 + 0.7 * i, 340.0 + 1.3 * i);
+  }
+  const double radius = 3.0;
+  std::vector<std::vector<std::string>> lane_ids;
+  for (const auto& point : points) {
+    lane_ids.push_back(PredictionMap::NearbyLaneIds(point, radius));
+    std::sort(lane_ids.back().begin(), lane_ids.back().end());
+  }
+
+  std::vector<std::vector<std::shared_ptr<const LaneInfo>>> batch_lanes;
+  PredictionMap::GetNearbyLanes(points, radius, &batch_lanes);
+  ASSERT_EQ(points.size(), batch_lanes.size());
+
+  FLAGS_enable_map_query_cache = true;
+  for (size_t i = 0; i < points.size(); ++i) {
+    std::vector<std::string> cached_lane_ids =
+        PredictionMap::NearbyLaneIds(points[i], radius);
+    std::sort(cached_lane_ids.begin(), cached_lane_ids.end());
+    EXPECT_EQ(lane_ids[i], cached_lane_ids);
+
+    std::vector<std::string> batch_lane_ids;
+    for (const auto& lane : batch_lanes[i]) {
+      batch_lane_ids.push_back(lane->id().id());
+    }
+    std::sort(batch_lane_ids.begin(), batch_lane_ids.end());
+    EXPECT_EQ(lane_ids[i], batch_lane_ids);
+  }
+  FLAGS_enable_map_query_cache = false;
+}
+
 TEST_F(PredictionMapTest, lane_turn_type) {
   // Valid lane
   EXPECT_EQ(1, PredictionMap::LaneTurnType("l20"));
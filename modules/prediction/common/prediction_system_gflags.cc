@@ -31,7 +31,8 @@ DEFINE_string(prediction_data_dir,
               "/apollo/modules/prediction/data/prediction/",
               "Prefix of files to store feature data");
 DEFINE_string(offline_feature_proto_file_name, "",
-              "The bin file including a series of feature proto messages");
+              "The bin files including a series of feature proto messages, "
+              "or directories of them, separated by colon ':'");
 
 DEFINE_bool(prediction_test_mode, false, "Set prediction to test mode");
 DEFINE_double(
@@ -51,3 +52,18 @@ DEFINE_double(replay_timestamp_gap, 10.0,
               "Max timestamp gap for rosbag replay");
 DEFINE_int32(max_num_dump_feature, 50000,
              "Max number of features to dump");
+DEFINE_bool(offline_dump_feature_proto, true,
+            "If to keep the evaluated features for the feature proto dump "
+            "in the offline mode");
+DEFINE_int32(offline_num_workers, 1,
+             "Number of processes extracting the model features of the "
+             "offline feature proto files");
+DEFINE_int32(offline_row_group_size, 4096,
+             "Number of rows in a row group of the columnar model features");
+
+// Multi-thread evaluation and prediction
+DEFINE_bool(enable_multi_thread, false,
+            "If evaluate and predict the obstacles on the cyber task pool");
+DEFINE_int32(max_thread_num, 4,
+             "Number of workers of the multi-thread mode, each of them owns "
+             "its own evaluators and predictors");
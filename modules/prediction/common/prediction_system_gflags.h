@@ -34,3 +34,10 @@ DECLARE_string(prediction_offline_bags);
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
 DECLARE_int32(max_num_dump_feature);
+DECLARE_bool(offline_dump_feature_proto);
+DECLARE_int32(offline_num_workers);
+DECLARE_int32(offline_row_group_size);
+
+// Multi-thread evaluation and prediction
+DECLARE_bool(enable_multi_thread);
+DECLARE_int32(max_thread_num);
@@ -0,0 +1,329 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/semantic_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::hdmap::CrosswalkInfoConstPtr;
+using apollo::hdmap::HDMapUtil;
+using apollo::hdmap::JunctionInfoConstPtr;
+using apollo::hdmap::LaneInfoConstPtr;
+
+namespace {
+
+// fractional bits of the drawn points
+constexpr int kShift = 4;
+constexpr double kShiftScale = 1 << kShift;
+
+const cv::Scalar kLaneColor(128, 128, 128);
+const cv::Scalar kLaneBoundaryColor(255, 255, 255);
+const cv::Scalar kCrosswalkColor(0, 255, 255);
+const cv::Scalar kJunctionColor(255, 255, 0);
+
+int64_t TileKey(const int tile_x, const int tile_y) {
+  return (static_cast<int64_t>(tile_x) << 32) |
+         static_cast<uint32_t>(tile_y);
+}
+
+double TileLength() {
+  return FLAGS_semantic_map_tile_size * FLAGS_semantic_map_resolution;
+}
+
+// maps world points into the pixels of the area whose top left corner is
+// (min_x, max_y)
+class PixelMapper {
+ public:
+  PixelMapper(const double min_x, const double max_y)
+      : min_x_(min_x), max_y_(max_y),
+        scale_(kShiftScale / FLAGS_semantic_map_resolution) {}
+
+  cv::Point operator()(const double x, const double y) const {
+    return cv::Point(static_cast<int>(std::lround((x - min_x_) * scale_)),
+                     static_cast<int>(std::lround((max_y_ - y) * scale_)));
+  }
+
+ private:
+  double min_x_;
+  double max_y_;
+  double scale_;
+};
+
+void DrawLane(const LaneInfoConstPtr& lane, const PixelMapper& mapper,
+              cv::Mat* tile) {
+  const auto& points = lane->points();
+  const auto& headings = lane->headings();
+  const auto& accumulate_s = lane->accumulate_s();
+  if (points.size() < 2) {
+    return;
+  }
+  std::vector<cv::Point> left_boundary;
+  std::vector<cv::Point> right_boundary;
+  left_boundary.reserve(points.size());
+  right_boundary.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    double left_width = 0.0;
+    double right_width = 0.0;
+    lane->GetWidth(accumulate_s[i], &left_width, &right_width);
+    const double normal_x = -std::sin(headings[i]);
+    const double normal_y = std::cos(headings[i]);
+    left_boundary.push_back(mapper(points[i].x() + left_width * normal_x,
+                                   points[i].y() + left_width * normal_y));
+    right_boundary.push_back(mapper(points[i].x() - right_width * normal_x,
+                                    points[i].y() - right_width * normal_y));
+  }
+
+  std::vector<std::vector<cv::Point>> area(1, left_boundary);
+  area[0].insert(area[0].end(), right_boundary.rbegin(),
+                 right_boundary.rend());
+  cv::fillPoly(*tile, area, kLaneColor, 8, kShift);
+
+  std::vector<std::vector<cv::Point>> boundaries = {
+      std::move(left_boundary), std::move(right_boundary)};
+  cv::polylines(*tile, boundaries, false, kLaneBoundaryColor, 1, 8, kShift);
+}
+
+std::vector<cv::Point> PolygonPoints(
+    const common::math::Polygon2d& polygon, const PixelMapper& mapper) {
+  std::vector<cv::Point> polygon_points;
+  polygon_points.reserve(polygon.points().size());
+  for (const auto& point : polygon.points()) {
+    polygon_points.push_back(mapper(point.x(), point.y()));
+  }
+  return polygon_points;
+}
+
+}  // namespace
+
+SemanticMap::SemanticMap()
+    : tiles_(new common::util::LRUCache<int64_t, cv::Mat>(
+          FLAGS_max_num_semantic_map_tiles)) {}
+
+SemanticMap::ObstacleBox SemanticMap::BoxFromFeature(const Feature& feature,
+                                                     const double timestamp) {
+  ObstacleBox box;
+  box.id = feature.id();
+  box.x = feature.position().x();
+  box.y = feature.position().y();
+  box.heading = feature.theta();
+  box.length = feature.length();
+  box.width = feature.width();
+  box.age = timestamp - feature.timestamp();
+  return box;
+}
+
+void SemanticMap::SetFrame(std::vector<ObstacleBox> boxes) {
+  // the oldest boxes are drawn first so the latest ones stay on top
+  std::stable_sort(boxes.begin(), boxes.end(),
+                   [](const ObstacleBox& lhs, const ObstacleBox& rhs) {
+                     return lhs.age > rhs.age;
+                   });
+  boxes_ = std::move(boxes);
+}
+
+void SemanticMap::Clear() {
+  std::lock_guard<std::mutex> lock(tile_mutex_);
+  tiles_->Clear();
+  tile_map_ = nullptr;
+}
+
+cv::Mat SemanticMap::GetTile(const int tile_x, const int tile_y) {
+  const hdmap::HDMap* base_map = HDMapUtil::BaseMapPtr();
+  if (base_map != tile_map_) {
+    tiles_->Clear();
+    tile_map_ = base_map;
+  }
+  const int64_t key = TileKey(tile_x, tile_y);
+  cv::Mat* tile = tiles_->Get(key);
+  if (tile != nullptr) {
+    return *tile;
+  }
+  // the cached tile shares the pixels with the returned one, so an evicted
+  // tile stays valid for the current image
+  cv::Mat new_tile = RenderTile(tile_x, tile_y);
+  tiles_->Put(key, new_tile);
+  return new_tile;
+}
+
+cv::Mat SemanticMap::RenderTile(const int tile_x, const int tile_y) const {
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  cv::Mat tile(tile_size, tile_size, CV_8UC3, cv::Scalar(0, 0, 0));
+  const double length = TileLength();
+  const PixelMapper mapper(tile_x * length, (tile_y + 1) * length);
+
+  common::PointENU center;
+  center.set_x((tile_x + 0.5) * length);
+  center.set_y((tile_y + 0.5) * length);
+  // half of the tile diagonal
+  const double radius = length * M_SQRT1_2;
+  const hdmap::HDMap& base_map = HDMapUtil::BaseMap();
+
+  std::vector<LaneInfoConstPtr> lanes;
+  base_map.GetLanes(center, radius, &lanes);
+  for (const auto& lane : lanes) {
+    DrawLane(lane, mapper, &tile);
+  }
+
+  std::vector<CrosswalkInfoConstPtr> crosswalks;
+  base_map.GetCrosswalks(center, radius, &crosswalks);
+  for (const auto& crosswalk : crosswalks) {
+    std::vector<std::vector<cv::Point>> area = {
+        PolygonPoints(crosswalk->polygon(), mapper)};
+    cv::fillPoly(tile, area, kCrosswalkColor, 8, kShift);
+  }
+
+  std::vector<JunctionInfoConstPtr> junctions;
+  base_map.GetJunctions(center, radius, &junctions);
+  for (const auto& junction : junctions) {
+    std::vector<std::vector<cv::Point>> outline = {
+        PolygonPoints(junction->polygon(), mapper)};
+    cv::polylines(tile, outline, true, kJunctionColor, 1, 8, kShift);
+  }
+  return tile;
+}
+
+bool SemanticMap::GetAgentImage(const int id, const double x,
+                                const double y, const double heading,
+                                cv::Mat* image) {
+  if (HDMapUtil::BaseMapPtr() == nullptr) {
+    return false;
+  }
+  const int image_size = FLAGS_semantic_map_image_size;
+  const double resolution = FLAGS_semantic_map_resolution;
+  const double cos_heading = std::cos(heading);
+  const double sin_heading = std::sin(heading);
+  // pixel of the agent
+  const double agent_u = 0.5 * image_size;
+  const double agent_v = 0.75 * image_size;
+
+  // world bounding box of the rotated image
+  double min_x = x;
+  double max_x = x;
+  double min_y = y;
+  double max_y = y;
+  for (const double u : {0.0, static_cast<double>(image_size)}) {
+    for (const double v : {0.0, static_cast<double>(image_size)}) {
+      const double forward = (agent_v - v) * resolution;
+      const double left = (agent_u - u) * resolution;
+      const double corner_x = x + forward * cos_heading - left * sin_heading;
+      const double corner_y = y + forward * sin_heading + left * cos_heading;
+      min_x = std::min(min_x, corner_x);
+      max_x = std::max(max_x, corner_x);
+      min_y = std::min(min_y, corner_y);
+      max_y = std::max(max_y, corner_y);
+    }
+  }
+
+  // copy the tiles under the bounding box into one mosaic
+  const double tile_length = TileLength();
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  const int min_tile_x = static_cast<int>(std::floor(min_x / tile_length));
+  const int max_tile_x = static_cast<int>(std::floor(max_x / tile_length));
+  const int min_tile_y = static_cast<int>(std::floor(min_y / tile_length));
+  const int max_tile_y = static_cast<int>(std::floor(max_y / tile_length));
+  cv::Mat mosaic((max_tile_y - min_tile_y + 1) * tile_size,
+                 (max_tile_x - min_tile_x + 1) * tile_size, CV_8UC3);
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    for (int tile_y = min_tile_y; tile_y <= max_tile_y; ++tile_y) {
+      for (int tile_x = min_tile_x; tile_x <= max_tile_x; ++tile_x) {
+        const cv::Rect rect((tile_x - min_tile_x) * tile_size,
+                            (max_tile_y - tile_y) * tile_size, tile_size,
+                            tile_size);
+        GetTile(tile_x, tile_y).copyTo(mosaic(rect));
+      }
+    }
+  }
+
+  // the image pixel (u, v) samples the mosaic pixel
+  //   column = sin * u - cos * v + column0
+  //   row    = cos * u + sin * v + row0
+  const double mosaic_x = min_tile_x * tile_length;
+  const double mosaic_y = (max_tile_y + 1) * tile_length;
+  const double column0 = (x - mosaic_x) / resolution +
+                         agent_v * cos_heading - agent_u * sin_heading;
+  const double row0 = (mosaic_y - y) / resolution - agent_v * sin_heading -
+                      agent_u * cos_heading;
+  const cv::Mat transform =
+      (cv::Mat_<double>(2, 3) << sin_heading, -cos_heading, column0,
+       cos_heading, sin_heading, row0);
+  cv::warpAffine(mosaic, *image, transform, cv::Size(image_size, image_size),
+                 cv::INTER_NEAREST | cv::WARP_INVERSE_MAP,
+                 cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+
+  DrawObstacleBoxes(id, x, y, heading, image);
+  return true;
+}
+
+void SemanticMap::DrawObstacleBoxes(const int id, const double x,
+                                    const double y, const double heading,
+                                    cv::Mat* image) const {
+  const int image_size = FLAGS_semantic_map_image_size;
+  const double scale = kShiftScale / FLAGS_semantic_map_resolution;
+  const double max_age = FLAGS_semantic_map_max_history_time;
+  const double cos_heading = std::cos(heading);
+  const double sin_heading = std::sin(heading);
+  const double agent_u = 0.5 * image_size * kShiftScale;
+  const double agent_v = 0.75 * image_size * kShiftScale;
+  // no image pixel is farther from the agent
+  const double max_distance =
+      image_size * FLAGS_semantic_map_resolution * std::hypot(0.5, 0.75);
+
+  cv::Point corners[4];
+  for (const ObstacleBox& box : boxes_) {
+    if (box.age > max_age) {
+      continue;
+    }
+    const double half_diagonal = 0.5 * std::hypot(box.length, box.width);
+    if (std::hypot(box.x - x, box.y - y) > max_distance + half_diagonal) {
+      continue;
+    }
+    const double half_length_x = 0.5 * box.length * std::cos(box.heading);
+    const double half_length_y = 0.5 * box.length * std::sin(box.heading);
+    const double half_width_x = -0.5 * box.width * std::sin(box.heading);
+    const double half_width_y = 0.5 * box.width * std::cos(box.heading);
+    const double signs[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+    for (int i = 0; i < 4; ++i) {
+      const double dx = box.x - x + signs[i][0] * half_length_x +
+                        signs[i][1] * half_width_x;
+      const double dy = box.y - y + signs[i][0] * half_length_y +
+                        signs[i][1] * half_width_y;
+      const double forward = dx * cos_heading + dy * sin_heading;
+      const double left = -dx * sin_heading + dy * cos_heading;
+      corners[i] =
+          cv::Point(static_cast<int>(std::lround(agent_u - left * scale)),
+                    static_cast<int>(std::lround(agent_v - forward * scale)));
+    }
+    const double intensity =
+        255.0 * (1.0 - 0.8 * std::max(box.age, 0.0) / std::max(max_age, 1e-3));
+    const cv::Scalar color = box.id == id ? cv::Scalar(0, intensity, 0)
+                                          : cv::Scalar(0, 0, intensity);
+    cv::fillConvexPoly(*image, corners, 4, color, 8, kShift);
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
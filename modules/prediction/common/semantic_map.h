@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Rasterized semantic map around the obstacles for image based models
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "cyber/common/macros.h"
+#include "modules/common/util/lru_cache.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class SemanticMap
+ * @brief Renders a bird's eye view image around an agent, heading up.
+ *
+ * The static map layers (lanes, lane boundaries, crosswalks and junctions)
+ * are drawn once into square tiles which are cached. An agent image is a
+ * rotated crop of the tiles, composited with the boxes of the obstacle
+ * histories of the current frame:
+ *   lanes               gray
+ *   lane boundaries     white
+ *   crosswalks          yellow
+ *   junctions           cyan outline
+ *   obstacle histories  red, fading with the age
+ *   agent history       green, fading with the age
+ */
+class SemanticMap {
+ public:
+  struct ObstacleBox {
+    int id = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double heading = 0.0;
+    double length = 0.0;
+    double width = 0.0;
+    // seconds before the latest frame
+    double age = 0.0;
+  };
+
+  /**
+   * @brief Make the box of an obstacle feature
+   * @param feature The feature of an obstacle.
+   * @param timestamp The timestamp of the latest frame.
+   * @return The box of the obstacle.
+   */
+  static ObstacleBox BoxFromFeature(const Feature& feature,
+                                   const double timestamp);
+
+  /**
+   * @brief Set the obstacle boxes of the current frame
+   * @param boxes The boxes of the histories of all the obstacles.
+   */
+  void SetFrame(std::vector<ObstacleBox> boxes);
+
+  /**
+   * @brief Render the image around an agent, the agent is on the
+   *        horizontal center at three quarters of the height, heading up.
+   * @param id The id of the agent.
+   * @param x The x coordinate of the agent.
+   * @param y The y coordinate of the agent.
+   * @param heading The heading of the agent.
+   * @param image The image of semantic_map_image_size pixels square.
+   * @return True if the base map is ready.
+   */
+  bool GetAgentImage(const int id, const double x, const double y,
+                     const double heading, cv::Mat* image);
+
+  /**
+   * @brief Drop the cached tiles
+   */
+  void Clear();
+
+ private:
+  // the tile of (tile_x, tile_y), rendered on the first use,
+  // requires tile_mutex_
+  cv::Mat GetTile(const int tile_x, const int tile_y);
+
+  cv::Mat RenderTile(const int tile_x, const int tile_y) const;
+
+  void DrawObstacleBoxes(const int id, const double x, const double y,
+                         const double heading, cv::Mat* image) const;
+
+ private:
+  std::mutex tile_mutex_;
+
+  const hdmap::HDMap* tile_map_ = nullptr;
+
+  std::unique_ptr<common::util::LRUCache<int64_t, cv::Mat>> tiles_;
+
+  std::vector<ObstacleBox> boxes_;
+
+  DECLARE_SINGLETON(SemanticMap)
+};
+
+}  // namespace prediction
+}  // namespace apollo
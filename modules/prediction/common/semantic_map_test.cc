@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/semantic_map.h"
+
+#include <cmath>
+#include <vector>
+
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+class SemanticMapTest : public KMLMapBasedTest {};
+
+TEST_F(SemanticMapTest, agent_image) {
+  // a point on the center of lane l20
+  const double x = 124.85930930657942;
+  const double y = 348.52732962417451;
+  const double heading = -0.066794953844859783;
+  const int image_size = FLAGS_semantic_map_image_size;
+  const int agent_u = image_size / 2;
+  const int agent_v = image_size * 3 / 4;
+  SemanticMap* semantic_map = SemanticMap::Instance();
+  semantic_map->SetFrame({});
+
+  cv::Mat image;
+  EXPECT_TRUE(semantic_map->GetAgentImage(1, x, y, heading, &image));
+  EXPECT_EQ(image_size, image.rows);
+  EXPECT_EQ(image_size, image.cols);
+  EXPECT_EQ(CV_8UC3, image.type());
+  EXPECT_EQ(cv::Vec3b(128, 128, 128), image.at<cv::Vec3b>(agent_v, agent_u));
+
+  // the agent, an obstacle 5 meters ahead and an expired history
+  const double ahead = 5.0;
+  const int ahead_v =
+      agent_v - static_cast<int>(ahead / FLAGS_semantic_map_resolution);
+  std::vector<SemanticMap::ObstacleBox> boxes(3);
+  boxes[0].id = 1;
+  boxes[0].x = x;
+  boxes[0].y = y;
+  boxes[0].heading = heading;
+  boxes[0].length = 4.0;
+  boxes[0].width = 2.0;
+  boxes[1] = boxes[0];
+  boxes[1].id = 2;
+  boxes[1].x = x + ahead * std::cos(heading);
+  boxes[1].y = y + ahead * std::sin(heading);
+  boxes[2] = boxes[0];
+  boxes[2].id = 3;
+  boxes[2].age = FLAGS_semantic_map_max_history_time + 1.0;
+  semantic_map->SetFrame(boxes);
+
+  EXPECT_TRUE(semantic_map->GetAgentImage(1, x, y, heading, &image));
+  EXPECT_EQ(cv::Vec3b(0, 255, 0), image.at<cv::Vec3b>(agent_v, agent_u));
+  EXPECT_EQ(cv::Vec3b(0, 0, 255), image.at<cv::Vec3b>(ahead_v, agent_u));
+
+  // the same frame seen from the other obstacle
+  EXPECT_TRUE(semantic_map->GetAgentImage(2, x, y, heading, &image));
+  EXPECT_EQ(cv::Vec3b(0, 0, 255), image.at<cv::Vec3b>(agent_v, agent_u));
+  EXPECT_EQ(cv::Vec3b(0, 255, 0), image.at<cv::Vec3b>(ahead_v, agent_u));
+  semantic_map->SetFrame({});
+}
+
+}  // namespace prediction
+}  // namespace apollo
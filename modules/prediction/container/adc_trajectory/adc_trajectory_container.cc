@@ -108,25 +108,30 @@ void ADCTrajectoryContainer::SetJunctionPolygon() {
   if (adc_trajectory_.trajectory_point_size() > 0) {
     s_start = adc_trajectory_.trajectory_point(0).path_point().s();
   }
+  // Query the points within the search length in one batch, the junction
+  // is the first one found and s_at_junction is the s of the next point.
+  std::vector<Eigen::Vector2d> points;
   for (int i = 0; i < adc_trajectory_.trajectory_point_size(); ++i) {
-    double s = adc_trajectory_.trajectory_point(i).path_point().s();
-
-    if (s > FLAGS_adc_trajectory_search_length) {
+    const PathPoint& path_point =
+        adc_trajectory_.trajectory_point(i).path_point();
+    if (path_point.s() > FLAGS_adc_trajectory_search_length) {
       break;
     }
-
-    if (junction_info != nullptr) {
-      s_at_junction = s;
+    points.emplace_back(path_point.x(), path_point.y());
+  }
+  std::vector<std::vector<std::shared_ptr<const JunctionInfo>>> junctions;
+  PredictionMap::GetJunctions(points, FLAGS_junction_search_radius,
+                              &junctions);
+  const int num_points = static_cast<int>(points.size());
+  for (int i = 0; i < num_points; ++i) {
+    if (!junctions[i].empty() && junctions[i].front() != nullptr) {
+      junction_info = junctions[i].front();
+      if (i + 1 < num_points) {
+        s_at_junction =
+            adc_trajectory_.trajectory_point(i + 1).path_point().s();
+      }
       break;
     }
-
-    double x = adc_trajectory_.trajectory_point(i).path_point().x();
-    double y = adc_trajectory_.trajectory_point(i).path_point().y();
-    std::vector<std::shared_ptr<const JunctionInfo>> junctions =
-        PredictionMap::GetJunctions({x, y}, FLAGS_junction_search_radius);
-    if (!junctions.empty() && junctions.front() != nullptr) {
-      junction_info = junctions.front();
-    }
   }
 
   if (junction_info != nullptr && junction_info->junction().has_polygon()) {
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+FeatureHistory::FeatureHistory(const size_t capacity) {
+  const size_t num_slots = std::max(capacity, static_cast<size_t>(1));
+  slots_.reserve(num_slots);
+  for (size_t i = 0; i < num_slots; ++i) {
+    slots_.emplace_back(new Feature());
+  }
+  timestamp_.resize(num_slots);
+  position_x_.resize(num_slots);
+  position_y_.resize(num_slots);
+  velocity_x_.resize(num_slots);
+  velocity_y_.resize(num_slots);
+  velocity_z_.resize(num_slots);
+  acceleration_x_.resize(num_slots);
+  acceleration_y_.resize(num_slots);
+  speed_.resize(num_slots);
+}
+
+FeatureHistory::FeatureHistory(const FeatureHistory& other)
+    : head_(other.head_),
+      size_(other.size_),
+      timestamp_(other.timestamp_),
+      position_x_(other.position_x_),
+      position_y_(other.position_y_),
+      velocity_x_(other.velocity_x_),
+      velocity_y_(other.velocity_y_),
+      velocity_z_(other.velocity_z_),
+      acceleration_x_(other.acceleration_x_),
+      acceleration_y_(other.acceleration_y_),
+      speed_(other.speed_) {
+  slots_.reserve(other.slots_.size());
+  for (const auto& slot : other.slots_) {
+    slots_.emplace_back(new Feature(*slot));
+  }
+}
+
+FeatureHistory& FeatureHistory::operator=(const FeatureHistory& other) {
+  if (this != &other) {
+    FeatureHistory copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+void FeatureHistory::PushFront(const Feature& feature) {
+  if (size_ == slots_.size()) {
+    Grow();
+  }
+  head_ = head_ == 0 ? slots_.size() - 1 : head_ - 1;
+  ++size_;
+
+  // CopyFrom clears the slot and merges into it, the repeated messages of
+  // the dropped feature are kept and refilled
+  slots_[head_]->CopyFrom(feature);
+
+  timestamp_[head_] = feature.timestamp();
+  position_x_[head_] = feature.position().x();
+  position_y_[head_] = feature.position().y();
+  velocity_x_[head_] = feature.velocity().x();
+  velocity_y_[head_] = feature.velocity().y();
+  velocity_z_[head_] = feature.velocity().z();
+  acceleration_x_[head_] = feature.acceleration().x();
+  acceleration_y_[head_] = feature.acceleration().y();
+  speed_[head_] = feature.speed();
+}
+
+void FeatureHistory::PopBack() {
+  CHECK_GT(size_, 0);
+  --size_;
+}
+
+void FeatureHistory::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+void FeatureHistory::Grow() {
+  const size_t old_num_slots = slots_.size();
+  const size_t num_new_slots = std::max(old_num_slots, static_cast<size_t>(1));
+  // rotate so that the latest feature sits in the first slot, the new slots
+  // are then appended behind the earliest one
+  std::rotate(slots_.begin(), slots_.begin() + head_, slots_.end());
+  auto rotate_and_grow = [&](std::vector<double>* values) {
+    std::rotate(values->begin(), values->begin() + head_, values->end());
+    values->resize(old_num_slots + num_new_slots);
+  };
+  rotate_and_grow(&timestamp_);
+  rotate_and_grow(&position_x_);
+  rotate_and_grow(&position_y_);
+  rotate_and_grow(&velocity_x_);
+  rotate_and_grow(&velocity_y_);
+  rotate_and_grow(&velocity_z_);
+  rotate_and_grow(&acceleration_x_);
+  rotate_and_grow(&acceleration_y_);
+  rotate_and_grow(&speed_);
+  head_ = 0;
+
+  slots_.reserve(old_num_slots + num_new_slots);
+  for (size_t i = 0; i < num_new_slots; ++i) {
+    slots_.emplace_back(new Feature());
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Feature history of an obstacle
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureHistory
+ * @brief Ring of the historical features of an obstacle, from latest to
+ *        earliest. The slots keep their features after being dropped, so a
+ *        new feature is merged into the storage of the oldest one instead of
+ *        allocating its lane graphs again. The kinematic fields of every
+ *        feature are also kept in flat arrays for the loops over the history.
+ */
+class FeatureHistory {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity The number of slots allocated up front, the ring grows
+   *        when more features are kept.
+   */
+  explicit FeatureHistory(const size_t capacity = 16);
+
+  FeatureHistory(const FeatureHistory& other);
+
+  FeatureHistory& operator=(const FeatureHistory& other);
+
+  FeatureHistory(FeatureHistory&& other) = default;
+
+  FeatureHistory& operator=(FeatureHistory&& other) = default;
+
+  bool empty() const { return size_ == 0; }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return slots_.size(); }
+
+  /**
+   * @brief Get the ith feature from latest to earliest.
+   */
+  const Feature& operator[](const size_t i) const {
+    return *slots_[SlotIndex(i)];
+  }
+
+  Feature& operator[](const size_t i) { return *slots_[SlotIndex(i)]; }
+
+  const Feature& front() const { return (*this)[0]; }
+
+  Feature& front() { return (*this)[0]; }
+
+  const Feature& back() const { return (*this)[size_ - 1]; }
+
+  Feature& back() { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief Insert a feature as the latest one.
+   * @param feature The feature copied into the history.
+   */
+  void PushFront(const Feature& feature);
+
+  /**
+   * @brief Drop the earliest feature, its slot is reused by a later push.
+   */
+  void PopBack();
+
+  /**
+   * @brief Drop all the features.
+   */
+  void Clear();
+
+  /**
+   * @brief Kinematic fields of the ith feature from latest to earliest, as
+   *        they were when the feature was inserted.
+   */
+  double timestamp(const size_t i) const { return timestamp_[SlotIndex(i)]; }
+
+  double position_x(const size_t i) const {
+    return position_x_[SlotIndex(i)];
+  }
+
+  double position_y(const size_t i) const {
+    return position_y_[SlotIndex(i)];
+  }
+
+  double velocity_x(const size_t i) const {
+    return velocity_x_[SlotIndex(i)];
+  }
+
+  double velocity_y(const size_t i) const {
+    return velocity_y_[SlotIndex(i)];
+  }
+
+  double velocity_z(const size_t i) const {
+    return velocity_z_[SlotIndex(i)];
+  }
+
+  double acceleration_x(const size_t i) const {
+    return acceleration_x_[SlotIndex(i)];
+  }
+
+  double acceleration_y(const size_t i) const {
+    return acceleration_y_[SlotIndex(i)];
+  }
+
+  double speed(const size_t i) const { return speed_[SlotIndex(i)]; }
+
+ private:
+  size_t SlotIndex(const size_t i) const {
+    const size_t index = head_ + i;
+    return index < slots_.size() ? index : index - slots_.size();
+  }
+
+  // doubles the slots, keeping the features from latest to earliest
+  void Grow();
+
+ private:
+  std::vector<std::unique_ptr<Feature>> slots_;
+
+  // slot of the latest feature
+  size_t head_ = 0;
+
+  size_t size_ = 0;
+
+  // kinematic fields indexed by slot
+  std::vector<double> timestamp_;
+  std::vector<double> position_x_;
+  std::vector<double> position_y_;
+  std::vector<double> velocity_x_;
+  std::vector<double> velocity_y_;
+  std::vector<double> velocity_z_;
+  std::vector<double> acceleration_x_;
+  std::vector<double> acceleration_y_;
+  std::vector<double> speed_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+Feature MakeFeature(const int frame) {
+  Feature feature;
+  feature.set_id(1);
+  feature.set_timestamp(0.1 * frame);
+  feature.mutable_position()->set_x(1.0 * frame);
+  feature.mutable_position()->set_y(2.0 * frame);
+  feature.mutable_velocity()->set_x(3.0 * frame);
+  feature.mutable_velocity()->set_y(4.0 * frame);
+  feature.set_speed(5.0 * frame);
+  return feature;
+}
+
+}  // namespace
+
+TEST(FeatureHistoryTest, PushAndPop) {
+  FeatureHistory history(4);
+  EXPECT_TRUE(history.empty());
+  for (int frame = 0; frame < 3; ++frame) {
+    history.PushFront(MakeFeature(frame));
+  }
+  EXPECT_EQ(history.size(), 3);
+  EXPECT_DOUBLE_EQ(history.front().timestamp(), 0.2);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 0.0);
+
+  history.PopBack();
+  EXPECT_EQ(history.size(), 2);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 0.1);
+  EXPECT_DOUBLE_EQ(history.timestamp(1), 0.1);
+  EXPECT_DOUBLE_EQ(history.position_x(1), 1.0);
+}
+
+TEST(FeatureHistoryTest, ReuseAndGrow) {
+  FeatureHistory history(4);
+  // keep at most three features so the ring wraps around its slots
+  for (int frame = 0; frame < 10; ++frame) {
+    history.PushFront(MakeFeature(frame));
+    if (history.size() > 3) {
+      history.PopBack();
+    }
+  }
+  EXPECT_EQ(history.capacity(), 4);
+  // keep all the features from now on so the ring grows
+  for (int frame = 10; frame < 20; ++frame) {
+    history.PushFront(MakeFeature(frame));
+  }
+  EXPECT_EQ(history.size(), 13);
+  EXPECT_EQ(history.capacity(), 16);
+  for (size_t i = 0; i < history.size(); ++i) {
+    const int frame = 19 - static_cast<int>(i);
+    EXPECT_DOUBLE_EQ(history[i].timestamp(), 0.1 * frame);
+    EXPECT_DOUBLE_EQ(history.timestamp(i), 0.1 * frame);
+    EXPECT_DOUBLE_EQ(history.position_x(i), 1.0 * frame);
+    EXPECT_DOUBLE_EQ(history.position_y(i), 2.0 * frame);
+    EXPECT_DOUBLE_EQ(history.velocity_x(i), 3.0 * frame);
+    EXPECT_DOUBLE_EQ(history.velocity_y(i), 4.0 * frame);
+    EXPECT_DOUBLE_EQ(history.speed(i), 5.0 * frame);
+  }
+}
+
+TEST(FeatureHistoryTest, Copy) {
+  FeatureHistory history(2);
+  for (int frame = 0; frame < 3; ++frame) {
+    history.PushFront(MakeFeature(frame));
+  }
+  FeatureHistory copy(history);
+  history.front().set_speed(0.0);
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_DOUBLE_EQ(copy.front().speed(), 10.0);
+  EXPECT_DOUBLE_EQ(copy.back().timestamp(), 0.0);
+}
+
+}  // namespace prediction
+}  // namespace apollo
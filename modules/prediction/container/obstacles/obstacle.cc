@@ -66,7 +66,7 @@ int Obstacle::id() const { return id_; }
 
 double Obstacle::timestamp() const {
   if (feature_history_.size() > 0) {
-    return feature_history_.front().timestamp();
+    return feature_history_.timestamp(0);
   } else {
     return 0.0;
   }
@@ -154,11 +154,11 @@ bool Obstacle::IsNearJunction() {
 void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
                       const double timestamp, int pred_id) {
   if (feature_history_.size() > 0 &&
-      timestamp <= feature_history_.front().timestamp()) {
+      timestamp <= feature_history_.timestamp(0)) {
     AERROR << "Obstacle [" << id_ << "] received an older frame ["
            << std::setprecision(20) << timestamp
            << "] than the most recent timestamp [ "
-           << feature_history_.front().timestamp() << "].";
+           << feature_history_.timestamp(0) << "].";
     return;
   }
 
@@ -567,9 +567,9 @@ void Obstacle::SetVelocity(const PerceptionObstacle& perception_obstacle,
       FLAGS_adjust_velocity_by_position_shift &&
       history_size() > 0) {
     double diff_x =
-        feature->position().x() - feature_history_.front().position().x();
+        feature->position().x() - feature_history_.position_x(0);
     double diff_y =
-        feature->position().y() - feature_history_.front().position().y();
+        feature->position().y() - feature_history_.position_y(0);
     double prev_obstacle_size = std::max(feature_history_.front().length(),
                                          feature_history_.front().width());
     double obstacle_size =
@@ -653,10 +653,9 @@ void Obstacle::SetAcceleration(Feature* feature) {
 
   if (feature_history_.size() > 0) {
     double curr_ts = feature->timestamp();
-    double prev_ts = feature_history_.front().timestamp();
+    double prev_ts = feature_history_.timestamp(0);
 
     const Point3D& curr_velocity = feature->velocity();
-    const Point3D& prev_velocity = feature_history_.front().velocity();
 
     if (curr_ts > prev_ts) {
       /*
@@ -667,9 +666,12 @@ void Obstacle::SetAcceleration(Feature* feature) {
       double damping_y = Damp(curr_velocity.y(), 0.001);
       double damping_z = Damp(curr_velocity.z(), 0.001);
 
-      acc_x = (curr_velocity.x() - prev_velocity.x()) / (curr_ts - prev_ts);
-      acc_y = (curr_velocity.y() - prev_velocity.y()) / (curr_ts - prev_ts);
-      acc_z = (curr_velocity.z() - prev_velocity.z()) / (curr_ts - prev_ts);
+      acc_x = (curr_velocity.x() - feature_history_.velocity_x(0)) /
+              (curr_ts - prev_ts);
+      acc_y = (curr_velocity.y() - feature_history_.velocity_y(0)) /
+              (curr_ts - prev_ts);
+      acc_z = (curr_velocity.z() - feature_history_.velocity_z(0)) /
+              (curr_ts - prev_ts);
 
       acc_x *= damping_x;
       acc_y *= damping_y;
@@ -810,7 +812,7 @@ void Obstacle::InitKFMotionTracker(const Feature& feature) {
 void Obstacle::UpdateKFMotionTracker(const Feature& feature) {
   double delta_ts = 0.0;
   if (feature_history_.size() > 0) {
-    delta_ts = feature.timestamp() - feature_history_.front().timestamp();
+    delta_ts = feature.timestamp() - feature_history_.timestamp(0);
   }
   if (delta_ts > FLAGS_double_precision) {
     // Set transition matrix and predict
@@ -877,7 +879,7 @@ void Obstacle::InitKFPedestrianTracker(const Feature& feature) {
 void Obstacle::UpdateKFPedestrianTracker(const Feature& feature) {
   double delta_ts = 0.0;
   if (!feature_history_.empty()) {
-    delta_ts = feature.timestamp() - feature_history_.front().timestamp();
+    delta_ts = feature.timestamp() - feature_history_.timestamp(0);
   }
   if (delta_ts > std::numeric_limits<double>::epsilon()) {
     Eigen::Matrix<double, 2, 4> B = kf_pedestrian_tracker_.GetControlMatrix();
@@ -1417,7 +1419,7 @@ void Obstacle::SetMotionStatus() {
     speed_threshold = FLAGS_still_pedestrian_speed_threshold;
     std = FLAGS_still_pedestrian_position_std;
   }
-  double speed = feature_history_.front().speed();
+  double speed = feature_history_.speed(0);
 
   if (history_size == 1) {
     if (speed < speed_threshold) {
@@ -1438,18 +1440,15 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  start_x = feature_history_.position_x(history_size - 1);
+  start_y = feature_history_.position_y(history_size - 1);
+  for (int i = history_size - 2; i >= 0; --i) {
+    avg_drift_x += (feature_history_.position_x(i) - start_x) / (len - 1);
+    avg_drift_y += (feature_history_.position_y(i) - start_y) / (len - 1);
   }
 
-  double delta_ts = feature_history_.front().timestamp() -
-                    feature_history_.back().timestamp();
+  double delta_ts = feature_history_.timestamp(0) -
+                    feature_history_.timestamp(history_size - 1);
   double speed_sensibility =
       std::sqrt(2 * history_size) * 4 * std / ((history_size + 1) * delta_ts);
   if (speed < speed_threshold) {
@@ -1485,7 +1484,7 @@ void Obstacle::SetMotionStatusBySpeed() {
   }
 
   double speed_threshold = FLAGS_still_obstacle_speed_threshold;
-  double speed = feature_history_.front().speed();
+  double speed = feature_history_.speed(0);
 
   if (FLAGS_use_navigation_mode) {
     if (speed < speed_threshold) {
@@ -1497,7 +1496,7 @@ void Obstacle::SetMotionStatusBySpeed() {
 }
 
 void Obstacle::InsertFeatureToHistory(const Feature& feature) {
-  feature_history_.emplace_front(feature);
+  feature_history_.PushFront(feature);
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1506,11 +1505,11 @@ void Obstacle::Trim() {
     return;
   }
   int count = 0;
-  const double latest_ts = feature_history_.front().timestamp();
+  const double latest_ts = feature_history_.timestamp(0);
   while (!feature_history_.empty() &&
-         latest_ts - feature_history_.back().timestamp() >=
+         latest_ts - feature_history_.timestamp(feature_history_.size() - 1) >=
              FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
     ++count;
   }
   if (count > 0) {
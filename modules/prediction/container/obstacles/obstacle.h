@@ -21,7 +21,6 @@
 
 #pragma once
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,6 +28,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/math/kalman_filter.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 #include "modules/prediction/proto/feature.pb.h"
 
 /**
@@ -312,7 +312,7 @@ class Obstacle {
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
 
-  std::deque<Feature> feature_history_;
+  FeatureHistory feature_history_;
 
   common::math::KalmanFilter<double, 6, 2, 0> kf_motion_tracker_;
 
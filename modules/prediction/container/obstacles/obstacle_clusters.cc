@@ -17,8 +17,10 @@
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/road_graph.h"
 
 namespace apollo {
@@ -31,6 +33,8 @@ std::unordered_map<std::string, std::vector<LaneObstacle>>
     ObstacleClusters::lane_obstacles_;
 std::unordered_map<std::string, StopSign>
     ObstacleClusters::lane_id_stop_sign_map_;
+std::unique_ptr<common::util::LRUCache<std::string, LaneGraph>>
+    ObstacleClusters::lane_graph_cache_;
 
 void ObstacleClusters::Clear() {
   lane_graphs_.clear();
@@ -40,26 +44,38 @@ void ObstacleClusters::Clear() {
 
 void ObstacleClusters::Init() { Clear(); }
 
+namespace {
+
+// Set the start s of the lane sequences starting from lane_id.
+void SetStartS(const std::string& lane_id, const double start_s,
+               LaneGraph* lane_graph) {
+  for (int i = 0; i < lane_graph->lane_sequence_size(); ++i) {
+    LaneSequence* lane_seq_ptr = lane_graph->mutable_lane_sequence(i);
+    if (lane_seq_ptr->lane_segment_size() == 0) {
+      continue;
+    }
+    LaneSegment* first_lane_seg_ptr = lane_seq_ptr->mutable_lane_segment(0);
+    if (first_lane_seg_ptr->lane_id() != lane_id) {
+      continue;
+    }
+    first_lane_seg_ptr->set_start_s(start_s);
+  }
+}
+
+}  // namespace
+
 const LaneGraph& ObstacleClusters::GetLaneGraph(
     const double start_s, const double length,
     std::shared_ptr<const LaneInfo> lane_info_ptr) {
+  if (FLAGS_enable_lane_graph_cache) {
+    return GetCachedLaneGraph(start_s, length, lane_info_ptr);
+  }
   std::string lane_id = lane_info_ptr->id().id();
   if (lane_graphs_.find(lane_id) != lane_graphs_.end()) {
     // If this lane_segment has been used for constructing LaneGraph,
     // fetch the previously saved LaneGraph, modify its start_s,
     // then return this (save the time to construct the entire LaneGraph).
-    LaneGraph* lane_graph = &lane_graphs_[lane_id];
-    for (int i = 0; i < lane_graph->lane_sequence_size(); ++i) {
-      LaneSequence* lane_seq_ptr = lane_graph->mutable_lane_sequence(i);
-      if (lane_seq_ptr->lane_segment_size() == 0) {
-        continue;
-      }
-      LaneSegment* first_lane_seg_ptr = lane_seq_ptr->mutable_lane_segment(0);
-      if (first_lane_seg_ptr->lane_id() != lane_id) {
-        continue;
-      }
-      first_lane_seg_ptr->set_start_s(start_s);
-    }
+    SetStartS(lane_id, start_s, &lane_graphs_[lane_id]);
   } else {
     // If this lane_segment has not been used for constructing LaneGraph,
     // construct the LaneGraph and return.
@@ -71,6 +87,35 @@ const LaneGraph& ObstacleClusters::GetLaneGraph(
   return lane_graphs_[lane_id];
 }
 
+const LaneGraph& ObstacleClusters::GetCachedLaneGraph(
+    const double start_s, const double length,
+    std::shared_ptr<const LaneInfo> lane_info_ptr) {
+  if (lane_graph_cache_ == nullptr) {
+    lane_graph_cache_.reset(new common::util::LRUCache<std::string, LaneGraph>(
+        FLAGS_max_num_cached_lane_graph));
+  }
+  // start_s and length only decide where the search ends on the start lane,
+  // so the end s is rounded up and the graphs are shared by the searches
+  // ending in the same bucket of the lane.
+  const double resolution = FLAGS_lane_graph_cache_s_resolution;
+  const int64_t end_index =
+      static_cast<int64_t>(std::ceil((start_s + length) / resolution));
+  const std::string& lane_id = lane_info_ptr->id().id();
+  const std::string key = lane_id + "@" + std::to_string(end_index);
+
+  LaneGraph* lane_graph = lane_graph_cache_->Get(key);
+  if (lane_graph == nullptr) {
+    const double end_s = static_cast<double>(end_index) * resolution;
+    RoadGraph road_graph(start_s, end_s - start_s, lane_info_ptr);
+    LaneGraph new_lane_graph;
+    road_graph.BuildLaneGraph(&new_lane_graph);
+    lane_graph_cache_->Put(key, std::move(new_lane_graph));
+    lane_graph = lane_graph_cache_->GetSilently(key);
+  }
+  SetStartS(lane_id, start_s, lane_graph);
+  return *lane_graph;
+}
+
 LaneGraph ObstacleClusters::GetLaneGraphWithoutMemorizing(
     const double start_s, const double length,
     std::shared_ptr<const LaneInfo> lane_info_ptr) {
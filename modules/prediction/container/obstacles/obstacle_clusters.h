@@ -24,6 +24,7 @@
 
 #include "modules/prediction/proto/feature.pb.h"
 
+#include "modules/common/util/lru_cache.h"
 #include "modules/map/hdmap/hdmap_common.h"
 
 namespace apollo {
@@ -128,11 +129,18 @@ class ObstacleClusters {
 
   static void Clear();
 
+  static const LaneGraph& GetCachedLaneGraph(
+      const double start_s, const double length,
+      std::shared_ptr<const apollo::hdmap::LaneInfo> lane_info_ptr);
+
  private:
   static std::unordered_map<std::string, LaneGraph> lane_graphs_;
   static std::unordered_map<std::string,
                             std::vector<LaneObstacle>> lane_obstacles_;
   static std::unordered_map<std::string, StopSign> lane_id_stop_sign_map_;
+  // lane graphs kept across frames, keyed by the start lane and the end s
+  static std::unique_ptr<common::util::LRUCache<std::string, LaneGraph>>
+      lane_graph_cache_;
 };
 
 }  // namespace prediction
@@ -17,6 +17,7 @@
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
 #include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_map.h"
 
 namespace apollo {
@@ -47,5 +48,39 @@ TEST_F(ObstacleClustersTest, ObstacleClusters) {
   EXPECT_EQ("l21", lane_graph_2.lane_sequence(0).lane_segment(2).lane_id());
 }
 
+TEST_F(ObstacleClustersTest, CachedLaneGraph) {
+  auto lane = PredictionMap::LaneById("l9");
+  const LaneGraph lane_graph =
+      ObstacleClusters::GetLaneGraphWithoutMemorizing(99.0, 100.0, lane);
+
+  FLAGS_enable_lane_graph_cache = true;
+  const LaneGraph cached_lane_graph =
+      ObstacleClusters::GetLaneGraph(99.0, 100.0, lane);
+  ASSERT_EQ(lane_graph.lane_sequence_size(),
+            cached_lane_graph.lane_sequence_size());
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    const LaneSequence& lane_sequence = lane_graph.lane_sequence(i);
+    const LaneSequence& cached_lane_sequence =
+        cached_lane_graph.lane_sequence(i);
+    ASSERT_EQ(lane_sequence.lane_segment_size(),
+              cached_lane_sequence.lane_segment_size());
+    for (int j = 0; j < lane_sequence.lane_segment_size(); ++j) {
+      EXPECT_EQ(lane_sequence.lane_segment(j).lane_id(),
+                cached_lane_sequence.lane_segment(j).lane_id());
+      EXPECT_DOUBLE_EQ(lane_sequence.lane_segment(j).start_s(),
+                       cached_lane_sequence.lane_segment(j).start_s());
+    }
+  }
+
+  // a search ending in the same bucket reuses the graph with its own start
+  const LaneGraph& shifted_lane_graph =
+      ObstacleClusters::GetLaneGraph(99.2, 99.7, lane);
+  ASSERT_EQ(lane_graph.lane_sequence_size(),
+            shifted_lane_graph.lane_sequence_size());
+  EXPECT_DOUBLE_EQ(
+      99.2, shifted_lane_graph.lane_sequence(0).lane_segment(0).start_s());
+  FLAGS_enable_lane_graph_cache = false;
+}
+
 }  // namespace prediction
 }  // namespace apollo
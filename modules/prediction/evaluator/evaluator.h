@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "modules/prediction/container/obstacles/obstacle.h"
 
 /**
@@ -47,6 +49,17 @@ class Evaluator {
    * @param Obstacle pointer
    */
   virtual void Evaluate(Obstacle* obstacle) = 0;
+
+  /**
+   * @brief Evaluate obstacles together, evaluators running a network
+   *        override it to run one batched forward pass for all of them
+   * @param Obstacle pointers
+   */
+  virtual void EvaluateBatch(const std::vector<Obstacle*>& obstacles) {
+    for (Obstacle* obstacle : obstacles) {
+      Evaluate(obstacle);
+    }
+  }
 };
 
 }  // namespace prediction
@@ -16,6 +16,12 @@
 
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/task/task.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/evaluator/vehicle/cost_evaluator.h"
@@ -24,6 +30,7 @@
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
 #include "modules/prediction/evaluator/vehicle/rnn_evaluator.h"
 #include "modules/prediction/evaluator/cyclist/cyclist_keep_lane_evaluator.h"
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
 
 namespace apollo {
 namespace prediction {
@@ -94,6 +101,18 @@ void EvaluatorManager::Init(const PredictionConf& config) {
         << cyclist_on_lane_evaluator_ << "]";
   AINFO << "Defined default on lane obstacle evaluator ["
         << default_on_lane_evaluator_ << "]";
+
+  worker_evaluators_.clear();
+  if (FLAGS_enable_multi_thread && FLAGS_max_thread_num > 1) {
+    worker_evaluators_.resize(FLAGS_max_thread_num);
+    for (auto& worker_evaluators : worker_evaluators_) {
+      for (const auto& evaluator : evaluators_) {
+        worker_evaluators[evaluator.first] = CreateEvaluator(evaluator.first);
+      }
+    }
+    AINFO << "Evaluate obstacles with [" << worker_evaluators_.size()
+          << "] workers.";
+  }
 }
 
 Evaluator* EvaluatorManager::GetEvaluator(
@@ -109,6 +128,8 @@ void EvaluatorManager::Run(
           AdapterConfig::PERCEPTION_OBSTACLES);
   CHECK_NOTNULL(container);
 
+  std::vector<Obstacle*> obstacles;
+  obstacles.reserve(perception_obstacles.perception_obstacle_size());
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     if (!perception_obstacle.has_id()) {
@@ -130,29 +151,132 @@ void EvaluatorManager::Run(
       ADEBUG << "Ignore obstacle [" << id << "] in evaluator_manager";
       continue;
     }
+    if (!ObstaclesPrioritizer::Instance()->IsPrioritized(id)) {
+      ADEBUG << "Obstacle [" << id << "] is out of the prediction budget";
+      continue;
+    }
+    obstacles.push_back(obstacle);
+  }
 
-    EvaluateObstacle(obstacle);
+  // the evaluators of the offline mode dump features through a shared output
+  if (!worker_evaluators_.empty() && !FLAGS_prediction_offline_mode) {
+    EvaluateInParallel(obstacles);
+    return;
+  }
+
+  EvaluatorTimingMap timings;
+  EvaluateObstacles(obstacles, &evaluators_, &timings);
+  for (const auto& timing : timings) {
+    ADEBUG << "Evaluator [" << timing.first << "] evaluated ["
+           << timing.second.count << "] obstacles in ["
+           << timing.second.time_ms << "] ms.";
+  }
+}
+
+void EvaluatorManager::EvaluateInParallel(
+    const std::vector<Obstacle*>& obstacles) {
+  const size_t num_workers =
+      std::min(worker_evaluators_.size(), obstacles.size());
+  std::vector<EvaluatorTimingMap> worker_timings(num_workers);
+  cyber::ParallelFor(0, num_workers, 1, [&](size_t worker) {
+    std::vector<Obstacle*> worker_obstacles;
+    for (size_t i = worker; i < obstacles.size(); i += num_workers) {
+      worker_obstacles.push_back(obstacles[i]);
+    }
+    EvaluateObstacles(worker_obstacles, &worker_evaluators_[worker],
+                      &worker_timings[worker]);
+  });
+
+  EvaluatorTimingMap timings;
+  for (const auto& worker_timing : worker_timings) {
+    for (const auto& timing : worker_timing) {
+      timings[timing.first].count += timing.second.count;
+      timings[timing.first].time_ms += timing.second.time_ms;
+    }
+  }
+  for (const auto& timing : timings) {
+    ADEBUG << "Evaluator [" << timing.first << "] evaluated ["
+           << timing.second.count << "] obstacles in ["
+           << timing.second.time_ms << "] ms on [" << num_workers
+           << "] workers.";
   }
 }
 
 void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle) {
-  Evaluator* evaluator = nullptr;
+  EvaluatorTimingMap timings;
+  EvaluateObstacle(obstacle, &evaluators_, &timings);
+}
+
+void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
+                                        EvaluatorMap* evaluators,
+                                        EvaluatorTimingMap* timings) {
+  ObstacleConf::EvaluatorType type;
+  if (!SelectEvaluatorType(obstacle, &type)) {
+    return;
+  }
+  auto it = evaluators->find(type);
+  CHECK(it != evaluators->end() && it->second != nullptr)
+      << "Evaluator [" << type << "] is not registered.";
+
+  auto start_time = std::chrono::steady_clock::now();
+  it->second->Evaluate(obstacle);
+  std::chrono::duration<double, std::milli> diff =
+      std::chrono::steady_clock::now() - start_time;
+  EvaluatorTiming& timing = (*timings)[type];
+  ++timing.count;
+  timing.time_ms += diff.count();
+}
+
+void EvaluatorManager::EvaluateObstacles(
+    const std::vector<Obstacle*>& obstacles, EvaluatorMap* evaluators,
+    EvaluatorTimingMap* timings) {
+  if (!FLAGS_enable_batch_evaluation) {
+    for (Obstacle* obstacle : obstacles) {
+      EvaluateObstacle(obstacle, evaluators, timings);
+    }
+    return;
+  }
+
+  std::map<ObstacleConf::EvaluatorType, std::vector<Obstacle*>> batches;
+  for (Obstacle* obstacle : obstacles) {
+    ObstacleConf::EvaluatorType type;
+    if (SelectEvaluatorType(obstacle, &type)) {
+      batches[type].push_back(obstacle);
+    }
+  }
+  for (const auto& batch : batches) {
+    auto it = evaluators->find(batch.first);
+    CHECK(it != evaluators->end() && it->second != nullptr)
+        << "Evaluator [" << batch.first << "] is not registered.";
+
+    auto start_time = std::chrono::steady_clock::now();
+    it->second->EvaluateBatch(batch.second);
+    std::chrono::duration<double, std::milli> diff =
+        std::chrono::steady_clock::now() - start_time;
+    EvaluatorTiming& timing = (*timings)[batch.first];
+    timing.count += static_cast<int>(batch.second.size());
+    timing.time_ms += diff.count();
+  }
+}
+
+bool EvaluatorManager::SelectEvaluatorType(
+    Obstacle* obstacle, ObstacleConf::EvaluatorType* type) {
   switch (obstacle->type()) {
     case PerceptionObstacle::VEHICLE: {
       if (obstacle->HasJunctionFeatureWithExits() &&
           !obstacle->IsClosedToJunctionExit()) {
-        evaluator = GetEvaluator(vehicle_in_junction_evaluator_);
-        CHECK_NOTNULL(evaluator);
+        *type = vehicle_in_junction_evaluator_;
+        return true;
       } else if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(vehicle_on_lane_evaluator_);
-        CHECK_NOTNULL(evaluator);
+        *type = vehicle_on_lane_evaluator_;
+        return true;
       }
       break;
     }
     case PerceptionObstacle::BICYCLE: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
-        CHECK_NOTNULL(evaluator);
+        *type = cyclist_on_lane_evaluator_;
+        return true;
       }
       break;
     }
@@ -161,15 +285,13 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle) {
     }
     default: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(default_on_lane_evaluator_);
-        CHECK_NOTNULL(evaluator);
+        *type = default_on_lane_evaluator_;
+        return true;
       }
       break;
     }
   }
-  if (evaluator != nullptr) {
-    evaluator->Evaluate(obstacle);
-  }
+  return false;
 }
 
 std::unique_ptr<Evaluator> EvaluatorManager::CreateEvaluator(
@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "cyber/common/macros.h"
 #include "modules/prediction/evaluator/evaluator.h"
@@ -63,6 +64,55 @@ class EvaluatorManager {
   void EvaluateObstacle(Obstacle* obstacle);
 
  private:
+  using EvaluatorMap =
+      std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>>;
+
+  // number of evaluated obstacles and time spent in one evaluator
+  struct EvaluatorTiming {
+    int count = 0;
+    double time_ms = 0.0;
+  };
+  using EvaluatorTimingMap =
+      std::map<ObstacleConf::EvaluatorType, EvaluatorTiming>;
+
+  /**
+   * @brief Select the evaluator type of an obstacle
+   * @param Obstacle pointer
+   * @param Output evaluator type
+   * @return If the obstacle is to be evaluated
+   */
+  bool SelectEvaluatorType(Obstacle* obstacle,
+                           ObstacleConf::EvaluatorType* type);
+
+  /**
+   * @brief Evaluate an obstacle with an evaluator of a given set
+   * @param Obstacle pointer
+   * @param Evaluators to use
+   * @param Timings of the evaluators to update
+   */
+  void EvaluateObstacle(Obstacle* obstacle, EvaluatorMap* evaluators,
+                        EvaluatorTimingMap* timings);
+
+  /**
+   * @brief Evaluate obstacles with the evaluators of a given set, with
+   *        enable_batch_evaluation the obstacles of an evaluator are passed
+   *        to it together
+   * @param Obstacles to evaluate
+   * @param Evaluators to use
+   * @param Timings of the evaluators to update
+   */
+  void EvaluateObstacles(const std::vector<Obstacle*>& obstacles,
+                         EvaluatorMap* evaluators,
+                         EvaluatorTimingMap* timings);
+
+  /**
+   * @brief Evaluate the obstacles on the cyber task pool, the obstacles are
+   *        distributed over the workers in a fixed order and every worker
+   *        owns its evaluators, so the result matches the serial run
+   * @param Obstacles to evaluate
+   */
+  void EvaluateInParallel(const std::vector<Obstacle*>& obstacles);
+
   /**
    * @brief Register an evaluator by type
    * @param Evaluator type
@@ -83,7 +133,11 @@ class EvaluatorManager {
   void RegisterEvaluators();
 
  private:
-  std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>> evaluators_;
+  EvaluatorMap evaluators_;
+
+  // evaluator sets of the workers of the multi-thread mode, evaluators keep
+  // intermediate states and can not be shared between threads
+  std::vector<EvaluatorMap> worker_evaluators_;
 
   ObstacleConf::EvaluatorType vehicle_on_lane_evaluator_ =
       ObstacleConf::CRUISE_MLP_EVALUATOR;
@@ -102,29 +102,38 @@ CruiseMLPEvaluator::CruiseMLPEvaluator() {
 void CruiseMLPEvaluator::Clear() {
 }
 
-void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
+LaneGraph* CruiseMLPEvaluator::GetLaneGraph(Obstacle* obstacle_ptr) {
   // Sanity checks.
-  Clear();
   CHECK_NOTNULL(obstacle_ptr);
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
     AERROR << "Obstacle [" << id << "] has no latest feature.";
-    return;
+    return nullptr;
   }
   Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
   CHECK_NOTNULL(latest_feature_ptr);
   if (!latest_feature_ptr->has_lane() ||
       !latest_feature_ptr->lane().has_lane_graph()) {
     ADEBUG << "Obstacle [" << id << "] has no lane graph.";
-    return;
+    return nullptr;
   }
   LaneGraph* lane_graph_ptr =
       latest_feature_ptr->mutable_lane()->mutable_lane_graph();
   CHECK_NOTNULL(lane_graph_ptr);
   if (lane_graph_ptr->lane_sequence_size() == 0) {
     AERROR << "Obstacle [" << id << "] has no lane sequences.";
+    return nullptr;
+  }
+  return lane_graph_ptr;
+}
+
+void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
+  Clear();
+  LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+  if (lane_graph_ptr == nullptr) {
     return;
   }
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
 
   ADEBUG << "There are " << lane_graph_ptr->lane_sequence_size()
          << " lane sequences with probabilities:";
@@ -172,6 +181,72 @@ void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
   }
 }
 
+void CruiseMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles) {
+  // offline features are saved obstacle by obstacle
+  if (FLAGS_prediction_offline_mode) {
+    Evaluator::EvaluateBatch(obstacles);
+    return;
+  }
+  Clear();
+
+  // lane sequences of the go model at index 0 and of the cutin model at 1
+  std::vector<LaneSequence*> lane_sequences[2];
+  std::vector<Eigen::MatrixXf> lane_feature_mats[2];
+  std::vector<std::vector<double>> obs_feature_values[2];
+  for (Obstacle* obstacle_ptr : obstacles) {
+    LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+    if (lane_graph_ptr == nullptr) {
+      continue;
+    }
+    for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
+      LaneSequence* lane_sequence_ptr =
+          lane_graph_ptr->mutable_lane_sequence(i);
+      CHECK_NOTNULL(lane_sequence_ptr);
+      std::vector<double> feature_values;
+      ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
+      if (feature_values.size() !=
+          OBSTACLE_FEATURE_SIZE + INTERACTION_FEATURE_SIZE +
+              SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE) {
+        lane_sequence_ptr->set_probability(0.0);
+        ADEBUG << "Skip lane sequence due to incorrect feature size";
+        continue;
+      }
+      const int model = lane_sequence_ptr->vehicle_on_lane() ? 0 : 1;
+      lane_sequences[model].push_back(lane_sequence_ptr);
+      lane_feature_mats[model].push_back(VectorToMatrixXf(feature_values,
+          OBSTACLE_FEATURE_SIZE + INTERACTION_FEATURE_SIZE,
+          static_cast<int>(feature_values.size()), SINGLE_LANE_FEATURE_SIZE,
+          LANE_POINTS_SIZE));
+      feature_values.resize(OBSTACLE_FEATURE_SIZE);
+      obs_feature_values[model].push_back(std::move(feature_values));
+    }
+  }
+
+  const network::CruiseModel* models[2] = {go_model_ptr_.get(),
+                                           cutin_model_ptr_.get()};
+  for (int model = 0; model < 2; ++model) {
+    const int batch_size = static_cast<int>(lane_sequences[model].size());
+    if (batch_size == 0) {
+      continue;
+    }
+    Eigen::MatrixXf obs_feature_mat(batch_size, OBSTACLE_FEATURE_SIZE);
+    for (int i = 0; i < batch_size; ++i) {
+      for (size_t j = 0; j < OBSTACLE_FEATURE_SIZE; ++j) {
+        obs_feature_mat(i, j) =
+            static_cast<float>(obs_feature_values[model][i][j]);
+      }
+    }
+    Eigen::MatrixXf model_output;
+    models[model]->RunBatch(lane_feature_mats[model], obs_feature_mat,
+                            &model_output);
+    for (int i = 0; i < batch_size; ++i) {
+      lane_sequences[model][i]->set_probability(model_output(i, 0));
+      lane_sequences[model][i]->set_time_to_lane_center(model_output(i, 1));
+    }
+  }
+}
+
 void CruiseMLPEvaluator::ExtractFeatureValues
     (Obstacle* obstacle_ptr,
      LaneSequence* lane_sequence_ptr,
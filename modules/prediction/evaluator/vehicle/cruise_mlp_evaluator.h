@@ -44,6 +44,13 @@ class CruiseMLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override EvaluateBatch, runs each of the go and cutin models once
+   *        on the lane sequences of all the obstacles
+   * @param Obstacle pointers
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -55,6 +62,13 @@ class CruiseMLPEvaluator : public Evaluator {
   void Clear();
 
  private:
+  /**
+   * @brief Get the lane graph of an obstacle to evaluate
+   * @param Obstacle pointer
+   * @return Lane graph pointer, nullptr if there is nothing to evaluate
+   */
+  LaneGraph* GetLaneGraph(Obstacle* obstacle_ptr);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -17,6 +17,7 @@
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
 
 #include <limits>
+#include <utility>
 
 #include "modules/common/util/file.h"
 #include "modules/prediction/common/feature_output.h"
@@ -94,6 +95,79 @@ void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
   }
 }
 
+void MLPEvaluator::EvaluateBatch(const std::vector<Obstacle*>& obstacles) {
+  // offline features are saved obstacle by obstacle
+  if (FLAGS_prediction_offline_mode) {
+    Evaluator::EvaluateBatch(obstacles);
+    return;
+  }
+  Clear();
+  CHECK_LE(LANE_FEATURE_SIZE, 4 * FLAGS_max_num_lane_point);
+
+  // lane sequences with the expected feature size and their features
+  std::vector<LaneSequence*> lane_sequences;
+  std::vector<double> speeds;
+  std::vector<std::vector<double>> features;
+  for (Obstacle* obstacle_ptr : obstacles) {
+    CHECK_NOTNULL(obstacle_ptr);
+    int id = obstacle_ptr->id();
+    if (!obstacle_ptr->latest_feature().IsInitialized()) {
+      AERROR << "Obstacle [" << id << "] has no latest feature.";
+      continue;
+    }
+    Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+    if (!latest_feature_ptr->has_lane() ||
+        !latest_feature_ptr->lane().has_lane_graph()) {
+      ADEBUG << "Obstacle [" << id << "] has no lane graph.";
+      continue;
+    }
+    double speed = latest_feature_ptr->speed();
+    LaneGraph* lane_graph_ptr =
+        latest_feature_ptr->mutable_lane()->mutable_lane_graph();
+    if (lane_graph_ptr->lane_sequence_size() == 0) {
+      AERROR << "Obstacle [" << id << "] has no lane sequences.";
+      continue;
+    }
+
+    for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
+      LaneSequence* lane_sequence_ptr =
+          lane_graph_ptr->mutable_lane_sequence(i);
+      std::vector<double> feature_values;
+      ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
+      if (model_ptr_->dim_input() != static_cast<int>(feature_values.size())) {
+        ADEBUG << "Model feature size not consistent with model proto "
+               << "definition. model input dim = " << model_ptr_->dim_input()
+               << "; feature value size = " << feature_values.size();
+        lane_sequence_ptr->set_probability(0.0);
+        continue;
+      }
+      lane_sequences.push_back(lane_sequence_ptr);
+      speeds.push_back(speed);
+      features.push_back(std::move(feature_values));
+    }
+  }
+  if (lane_sequences.empty()) {
+    return;
+  }
+
+  Eigen::MatrixXd feature_mat(features.size(), model_ptr_->dim_input());
+  for (size_t i = 0; i < features.size(); ++i) {
+    feature_mat.row(i) =
+        Eigen::Map<const Eigen::RowVectorXd>(features[i].data(),
+                                             features[i].size());
+  }
+  Eigen::VectorXd probabilities;
+  ComputeProbabilities(feature_mat, &probabilities);
+
+  for (size_t i = 0; i < lane_sequences.size(); ++i) {
+    double centripetal_acc_probability =
+        ValidationChecker::ProbabilityByCentripetalAcceleration(
+            *lane_sequences[i], speeds[i]);
+    lane_sequences[i]->set_probability(probabilities(i) *
+                                       centripetal_acc_probability);
+  }
+}
+
 void MLPEvaluator::ExtractFeatureValues(Obstacle* obstacle_ptr,
                                         LaneSequence* lane_sequence_ptr,
                                         std::vector<double>* feature_values) {
@@ -336,6 +410,29 @@ void MLPEvaluator::LoadModel(const std::string& model_file) {
   CHECK(common::util::GetProtoFromFile(model_file, model_ptr_.get()))
       << "Unable to load model file: " << model_file << ".";
 
+  const int dim_input = model_ptr_->dim_input();
+  samples_mean_.resize(dim_input);
+  samples_std_.resize(dim_input);
+  for (int i = 0; i < dim_input; ++i) {
+    samples_mean_(i) = model_ptr_->samples_mean().columns(i);
+    samples_std_(i) = model_ptr_->samples_std().columns(i);
+  }
+  layer_weights_.clear();
+  layer_biases_.clear();
+  for (int i = 0; i < model_ptr_->num_layer(); ++i) {
+    const Layer& layer = model_ptr_->layer(i);
+    Eigen::MatrixXd weights(layer.layer_input_dim(), layer.layer_output_dim());
+    Eigen::RowVectorXd bias(layer.layer_output_dim());
+    for (int col = 0; col < layer.layer_output_dim(); ++col) {
+      bias(col) = layer.layer_bias().columns(col);
+      for (int row = 0; row < layer.layer_input_dim(); ++row) {
+        weights(row, col) = layer.layer_input_weight().rows(row).columns(col);
+      }
+    }
+    layer_weights_.push_back(std::move(weights));
+    layer_biases_.push_back(std::move(bias));
+  }
+
   AINFO << "Succeeded in loading the model file: " << model_file << ".";
 }
 
@@ -400,5 +497,43 @@ double MLPEvaluator::ComputeProbability(
   return probability;
 }
 
+void MLPEvaluator::ComputeProbabilities(const Eigen::MatrixXd& feature_values,
+                                        Eigen::VectorXd* probabilities) {
+  CHECK_NOTNULL(model_ptr_.get());
+  CHECK_EQ(feature_values.cols(), model_ptr_->dim_input());
+
+  // normalization
+  Eigen::MatrixXd layer_output =
+      (feature_values.rowwise() - samples_mean_).array().rowwise() /
+      (samples_std_.array() + 1e-10);
+
+  for (int i = 0; i < model_ptr_->num_layer(); ++i) {
+    Eigen::MatrixXd layer_input = std::move(layer_output);
+    layer_output = layer_input * layer_weights_[i];
+    layer_output.rowwise() += layer_biases_[i];
+    const Layer& layer = model_ptr_->layer(i);
+    if (layer.layer_activation_func() == Layer::RELU) {
+      layer_output = layer_output.cwiseMax(0.0);
+    } else if (layer.layer_activation_func() == Layer::TANH) {
+      layer_output = layer_output.array().tanh();
+    } else {
+      if (layer.layer_activation_func() != Layer::SIGMOID) {
+        AERROR << "Undefined activation function ["
+               << layer.layer_activation_func()
+               << "]. A default sigmoid will be used instead.";
+      }
+      layer_output = 1.0 / (1.0 + (-layer_output.array()).exp());
+    }
+  }
+
+  if (layer_output.cols() != 1) {
+    AERROR << "Model output layer has incorrect # outputs: "
+           << layer_output.cols();
+    probabilities->setZero(feature_values.rows());
+  } else {
+    *probabilities = layer_output.col(0);
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -21,6 +21,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Eigen/Dense"
+
 #include "modules/prediction/evaluator/evaluator.h"
 #include "modules/prediction/proto/fnn_vehicle_model.pb.h"
 
@@ -45,6 +47,13 @@ class MLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override EvaluateBatch, runs the model once on the lane
+   *        sequences of all the obstacles
+   * @param Obstacle pointers
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -89,6 +98,14 @@ class MLPEvaluator : public Evaluator {
    */
   double ComputeProbability(const std::vector<double>& feature_values);
 
+  /**
+   * @brief Compute the probabilities of a batch of feature vectors
+   * @param Feature values, one sample per row
+   * @param Output probabilities
+   */
+  void ComputeProbabilities(const Eigen::MatrixXd& feature_values,
+                            Eigen::VectorXd* probabilities);
+
   /**
    * @brief Save offline feature values in proto
    * @param Lane sequence
@@ -103,6 +120,12 @@ class MLPEvaluator : public Evaluator {
   static const size_t LANE_FEATURE_SIZE = 40;
 
   std::unique_ptr<FnnVehicleModel> model_ptr_;
+
+  // the model as matrices for the batched evaluation, built in LoadModel
+  Eigen::RowVectorXd samples_mean_;
+  Eigen::RowVectorXd samples_std_;
+  std::vector<Eigen::MatrixXd> layer_weights_;
+  std::vector<Eigen::RowVectorXd> layer_biases_;
 };
 
 }  // namespace prediction
@@ -56,5 +56,27 @@ TEST_F(MLPEvaluatorTest, OnLaneCase) {
   mlp_evaluator.Clear();
 }
 
+TEST_F(MLPEvaluatorTest, BatchMatchesSingle) {
+  MLPEvaluator mlp_evaluator;
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles_);
+  container.BuildLaneGraph();
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  ASSERT_TRUE(obstacle_ptr != nullptr);
+
+  mlp_evaluator.Evaluate(obstacle_ptr);
+  const LaneGraph lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+  mlp_evaluator.EvaluateBatch({obstacle_ptr});
+  const LaneGraph& batch_lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+  ASSERT_EQ(lane_graph.lane_sequence_size(),
+            batch_lane_graph.lane_sequence_size());
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    EXPECT_NEAR(lane_graph.lane_sequence(i).probability(),
+                batch_lane_graph.lane_sequence(i).probability(), 1e-9);
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -17,6 +17,7 @@
 #include "modules/prediction/evaluator/vehicle/rnn_evaluator.h"
 
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "modules/prediction/common/prediction_gflags.h"
@@ -27,6 +28,14 @@ namespace prediction {
 
 using apollo::hdmap::LaneInfo;
 
+namespace {
+
+// the rnn model is a singleton keeping the lstm states, it is shared by the
+// evaluators of the workers of the multi-thread mode
+std::mutex rnn_model_mutex;
+
+}  // namespace
+
 RNNEvaluator::RNNEvaluator() { LoadModel(FLAGS_evaluator_vehicle_rnn_file); }
 
 void RNNEvaluator::Evaluate(Obstacle* obstacle_ptr) {
@@ -74,6 +83,7 @@ void RNNEvaluator::Evaluate(Obstacle* obstacle_ptr) {
     obstacle_ptr->InitRNNStates();
   }
   obstacle_ptr->GetRNNStates(&states);
+  std::lock_guard<std::mutex> lock(rnn_model_mutex);
   for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
     LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
     int seq_id = lane_sequence_ptr->lane_sequence_id();
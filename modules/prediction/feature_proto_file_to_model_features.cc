@@ -14,12 +14,18 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "cyber/record/record_reader.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/util/message_util.h"
+#include "modules/common/util/string_util.h"
 #include "modules/common/adapters/proto/adapter_config.pb.h"
 
 #include "modules/prediction/common/feature_output.h"
@@ -32,8 +38,10 @@
 #include "modules/prediction/predictor/predictor_manager.h"
 #include "modules/prediction/proto/offline_features.pb.h"
 #include "modules/prediction/scenario/scenario_manager.h"
+#include "modules/prediction/util/columnar_feature_writer.h"
 #include "modules/prediction/util/data_extraction.h"
 
+using apollo::prediction::ColumnarFeatureWriter;
 using apollo::prediction::ContainerManager;
 using apollo::prediction::EvaluatorManager;
 using apollo::prediction::ObstaclesContainer;
@@ -41,17 +49,18 @@ using apollo::prediction::Obstacle;
 using apollo::prediction::Feature;
 using apollo::prediction::Features;
 using apollo::prediction::PredictionConf;
+using apollo::prediction::GetFeatureFileNames;
 
-void OfflineProcessFeatureProtoFile(
-    const std::string& features_proto_file_name) {
-  AERROR << "start";
+namespace {
+
+bool InitManagers() {
   // Load prediction conf
   PredictionConf prediction_conf;
   if (!apollo::common::util::GetProtoFromFile(FLAGS_prediction_conf_file,
                                       &prediction_conf)) {
     AERROR << "Unable to load prediction conf file: "
            << FLAGS_prediction_conf_file;
-    return;
+    return false;
   }
   ADEBUG << "Prediction config file is loaded into: "
             << prediction_conf.ShortDebugString();
@@ -61,13 +70,18 @@ void OfflineProcessFeatureProtoFile(
     FLAGS_prediction_adapter_config_filename, &adapter_conf)) {
     AERROR << "Unable to load adapter conf file: "
            << FLAGS_prediction_adapter_config_filename;
-    return;
+    return false;
   }
 
   // Initialization of all managers
   ContainerManager::Instance()->Init(adapter_conf);
   EvaluatorManager::Instance()->Init(prediction_conf);
+  return true;
+}
 
+void OfflineProcessFeatureProtoFile(
+    const std::string& features_proto_file_name,
+    ColumnarFeatureWriter* writer) {
   auto obstacles_container_ptr = ContainerManager::Instance()->GetContainer<
       ObstaclesContainer>(
         apollo::common::adapter::AdapterConfig::PERCEPTION_OBSTACLES);
@@ -82,12 +96,86 @@ void OfflineProcessFeatureProtoFile(
     obstacles_container_ptr->InsertFeatureProto(feature);
     Obstacle* obstacle_ptr = obstacles_container_ptr->GetObstacle(feature.id());
     EvaluatorManager::Instance()->EvaluateObstacle(obstacle_ptr);
+    writer->AddFeature(obstacle_ptr->latest_feature());
   }
 }
 
+// Each file starts from an empty obstacles container, so the workers take
+// every num_workers-th file and write their own output.
+int ProcessFeatureProtoFiles(const std::vector<std::string>& file_names,
+                             const int worker, const int num_workers) {
+  if (!InitManagers()) {
+    return 1;
+  }
+  const std::string output_file_name = FLAGS_prediction_data_dir +
+      "/model_features." + std::to_string(worker) + ".bin";
+  ColumnarFeatureWriter writer(output_file_name,
+                               FLAGS_offline_row_group_size);
+  if (!writer.is_open()) {
+    return 1;
+  }
+  for (size_t i = worker; i < file_names.size(); i += num_workers) {
+    AINFO << "Worker " << worker << " processing: [ " << i << " / "
+          << file_names.size() << " ]: " << file_names[i];
+    OfflineProcessFeatureProtoFile(file_names[i], &writer);
+  }
+  writer.Flush();
+  AINFO << "Worker " << worker << " wrote " << writer.num_rows()
+        << " rows into " << output_file_name;
+  return 0;
+}
+
+}  // namespace
+
 int main(int argc, char *argv[]) {
   google::ParseCommandLineFlags(&argc, &argv, true);
-  std::string file_name = FLAGS_offline_feature_proto_file_name;
-  OfflineProcessFeatureProtoFile(file_name);
-  return 0;
+  // the evaluators only save the model features in the offline mode, the
+  // evaluated feature protos are not dumped again
+  FLAGS_prediction_offline_mode = true;
+  FLAGS_offline_dump_feature_proto = false;
+
+  std::vector<std::string> inputs;
+  apollo::common::util::Split(FLAGS_offline_feature_proto_file_name, ':',
+                              &inputs);
+  std::vector<std::string> file_names;
+  for (const auto& input : inputs) {
+    GetFeatureFileNames(boost::filesystem::path(input), &file_names);
+  }
+  std::sort(file_names.begin(), file_names.end());
+  if (file_names.empty()) {
+    AERROR << "No feature proto file found in "
+           << FLAGS_offline_feature_proto_file_name;
+    return 1;
+  }
+
+  const int num_workers = std::max(1, std::min(FLAGS_offline_num_workers,
+      static_cast<int>(file_names.size())));
+  if (num_workers == 1) {
+    return ProcessFeatureProtoFiles(file_names, 0, 1);
+  }
+
+  // The prediction managers are process wide singletons, so the workers are
+  // processes instead of threads.
+  std::vector<pid_t> pids;
+  for (int worker = 0; worker < num_workers; ++worker) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+      _exit(ProcessFeatureProtoFiles(file_names, worker, num_workers));
+    }
+    if (pid < 0) {
+      AERROR << "Failed to fork worker " << worker;
+      continue;
+    }
+    pids.push_back(pid);
+  }
+  int result = static_cast<int>(pids.size()) == num_workers ? 0 : 1;
+  for (const pid_t pid : pids) {
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+      AERROR << "Worker process " << pid << " failed";
+      result = 1;
+    }
+  }
+  return result;
 }
@@ -26,32 +26,50 @@ void CruiseModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
                       Eigen::MatrixXf* output) const {
   // inputs = {lane_feature, obs_feature}
   CHECK_EQ(inputs.size(), 2);
-  output->resize(1, 2);
-
-  // Step 1: Run lane feature conv 1d
-  Eigen::MatrixXf lane_conv1d_0_output;
-  lane_conv1d_0_->Run({inputs[0]}, &lane_conv1d_0_output);
-  Eigen::MatrixXf lane_activation_1_output;
-  lane_activation_1_->Run({lane_conv1d_0_output}, &lane_activation_1_output);
-  Eigen::MatrixXf lane_conv1d_2_output;
-  lane_conv1d_2_->Run({lane_activation_1_output}, &lane_conv1d_2_output);
-
-  // Step 2: Run lane feature max pool 1d
-  Eigen::MatrixXf lane_maxpool1d_output;
-  lane_maxpool1d_->Run({lane_conv1d_2_output}, &lane_maxpool1d_output);
-  Eigen::MatrixXf lane_maxpool1d_flat = FlattenMatrix(lane_maxpool1d_output);
-
-  // Step 3: Run lane feature avg pool 1d
-  Eigen::MatrixXf lane_avgpool1d_output;
-  lane_avgpool1d_->Run({lane_conv1d_2_output}, &lane_avgpool1d_output);
-  Eigen::MatrixXf lane_avgpool1d_flat = FlattenMatrix(lane_avgpool1d_output);
+  RunBatch({inputs[0]}, inputs[1], output);
+}
+
+void CruiseModel::RunBatch(const std::vector<Eigen::MatrixXf>& lane_features,
+                           const Eigen::MatrixXf& obs_features,
+                           Eigen::MatrixXf* output) const {
+  const int batch_size = static_cast<int>(lane_features.size());
+  CHECK_EQ(obs_features.rows(), batch_size);
+  output->resize(batch_size, 2);
+  if (batch_size == 0) {
+    return;
+  }
 
+  // Step 1-3: Run the lane feature conv 1d and pooling sample by sample,
+  // the pooled lane features are stacked as the rows of one matrix
   Eigen::MatrixXf lane_feature;
-  concatenate_->Run({lane_maxpool1d_flat, lane_avgpool1d_flat}, &lane_feature);
+  for (int i = 0; i < batch_size; ++i) {
+    Eigen::MatrixXf lane_conv1d_0_output;
+    lane_conv1d_0_->Run({lane_features[i]}, &lane_conv1d_0_output);
+    Eigen::MatrixXf lane_activation_1_output;
+    lane_activation_1_->Run({lane_conv1d_0_output}, &lane_activation_1_output);
+    Eigen::MatrixXf lane_conv1d_2_output;
+    lane_conv1d_2_->Run({lane_activation_1_output}, &lane_conv1d_2_output);
+
+    Eigen::MatrixXf lane_maxpool1d_output;
+    lane_maxpool1d_->Run({lane_conv1d_2_output}, &lane_maxpool1d_output);
+    Eigen::MatrixXf lane_maxpool1d_flat = FlattenMatrix(lane_maxpool1d_output);
+
+    Eigen::MatrixXf lane_avgpool1d_output;
+    lane_avgpool1d_->Run({lane_conv1d_2_output}, &lane_avgpool1d_output);
+    Eigen::MatrixXf lane_avgpool1d_flat = FlattenMatrix(lane_avgpool1d_output);
+
+    Eigen::MatrixXf sample_lane_feature;
+    concatenate_->Run({lane_maxpool1d_flat, lane_avgpool1d_flat},
+                      &sample_lane_feature);
+    if (i == 0) {
+      lane_feature.resize(batch_size, sample_lane_feature.cols());
+    }
+    lane_feature.row(i) = sample_lane_feature;
+  }
 
   // Step 4: Run obstacle feature fully connected
   Eigen::MatrixXf obs_linear_0_output;
-  obs_linear_0_->Run({inputs[1]}, &obs_linear_0_output);
+  obs_linear_0_->Run({obs_features}, &obs_linear_0_output);
   Eigen::MatrixXf obs_activation_1_output;
   obs_activation_1_->Run({obs_linear_0_output}, &obs_activation_1_output);
   Eigen::MatrixXf obs_linear_3_output;
@@ -89,13 +107,15 @@ void CruiseModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
                                &classify_activation_10_output);
 
   CHECK_EQ(classify_activation_10_output.cols(), 1);
-  float probability = classify_activation_10_output(0, 0);
-  (*output)(0, 0) = probability;
-
-  // Step 7: Get regression result
-  if (probability < FLAGS_lane_sequence_threshold_cruise ||
-      !FLAGS_enable_cruise_regression) {
-    (*output)(0, 1) = static_cast<float>(FLAGS_time_to_center_if_not_reach);
+  output->col(0) = classify_activation_10_output.col(0);
+
+  // Step 7: Get regression result, only the samples reaching the threshold
+  // use it
+  const float default_time_to_lane_center =
+      static_cast<float>(FLAGS_time_to_center_if_not_reach);
+  output->col(1).setConstant(default_time_to_lane_center);
+  if (!FLAGS_enable_cruise_regression ||
+      output->col(0).maxCoeff() < FLAGS_lane_sequence_threshold_cruise) {
     return;
   }
 
@@ -128,9 +148,11 @@ void CruiseModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
   regress_activation_10_->Run({regress_linear_9_output},
                               &regress_activation_10_output);
 
-  CHECK_EQ(classify_activation_10_output.cols(), 1);
-  float time_to_lane_center = regress_activation_10_output(0, 0);
-  (*output)(0, 1) = time_to_lane_center;
+  for (int i = 0; i < batch_size; ++i) {
+    if ((*output)(i, 0) >= FLAGS_lane_sequence_threshold_cruise) {
+      (*output)(i, 1) = regress_activation_10_output(i, 0);
+    }
+  }
 }
 
 bool CruiseModel::LoadModel(
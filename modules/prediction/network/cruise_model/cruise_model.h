@@ -45,6 +45,17 @@ class CruiseModel : public NetModel {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) const override;
 
+  /**
+   * @brief Compute the model outputs of a batch of samples, the fully
+   *        connected layers run once on the whole batch
+   * @param Lane features of the samples
+   * @param Obstacle features of the samples, one sample per row
+   * @param Output of the network, one sample per row
+   */
+  void RunBatch(const std::vector<Eigen::MatrixXf>& lane_features,
+                const Eigen::MatrixXf& obs_features,
+                Eigen::MatrixXf* output) const;
+
  private:
   // LaneFeatureConvParameter
   std::unique_ptr<Conv1d> lane_conv1d_0_ =
@@ -82,12 +82,11 @@ bool Dense::Load(const DenseParameter& dense_pb) {
 void Dense::Run(const std::vector<Eigen::MatrixXf>& inputs,
                 Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf prod = static_cast<Eigen::MatrixXf>(inputs[0] * weights_);
+  output->noalias() = inputs[0] * weights_;
   if (use_bias_) {
-    Eigen::MatrixXf sum = prod.rowwise() + bias_.transpose();
-    prod = sum;
+    output->rowwise() += bias_.transpose();
   }
-  *output = prod.unaryExpr(kactivation_);
+  *output = output->unaryExpr(kactivation_);
   CHECK_EQ(output->cols(), units_);
 }
 
@@ -123,6 +122,19 @@ bool Conv1d::Load(const Conv1dParameter& conv1d_pb) {
   } else {
     stride_ = 1;
   }
+
+  // kernel i becomes row i, ordered as the columns of the unfolded input
+  CHECK_GT(kernel_.size(), 0);
+  const int num_rows = static_cast<int>(kernel_[0].rows());
+  const int kernel_size = static_cast<int>(kernel_[0].cols());
+  kernel_matrix_.resize(kernel_.size(), num_rows * kernel_size);
+  for (size_t i = 0; i < kernel_.size(); ++i) {
+    for (int p = 0; p < num_rows; ++p) {
+      for (int q = 0; q < kernel_size; ++q) {
+        kernel_matrix_(i, p * kernel_size + q) = kernel_[i](p, q);
+      }
+    }
+  }
   return true;
 }
 
@@ -134,21 +146,16 @@ void Conv1d::Run(const std::vector<Eigen::MatrixXf>& inputs,
   int kernel_size = static_cast<int>(kernel_[0].cols());
   int output_num_col =
       static_cast<int>((inputs[0].cols() - kernel_size) / stride_) + 1;
-  int output_num_row = static_cast<int>(kernel_.size());
-  output->resize(output_num_row, output_num_col);
-  for (int i = 0; i < output_num_row; ++i) {
-    for (int j = 0; j < output_num_col; ++j) {
-      float output_i_j_unbiased = 0.0f;
-      for (int p = 0; p < inputs[0].rows(); ++p) {
-        for (int q = j * stride_; q < j * stride_ + kernel_size; ++q) {
-          output_i_j_unbiased +=
-              inputs[0](p, q) * kernel_[i](p, q - j * stride_);
-        }
-      }
-
-      (*output)(i, j) = output_i_j_unbiased + bias_(i);
+  const int num_rows = static_cast<int>(inputs[0].rows());
+  patches_.resize(num_rows * kernel_size, output_num_col);
+  for (int j = 0; j < output_num_col; ++j) {
+    for (int p = 0; p < num_rows; ++p) {
+      patches_.block(p * kernel_size, j, kernel_size, 1) =
+          inputs[0].block(p, j * stride_, 1, kernel_size).transpose();
     }
   }
+  output->noalias() = kernel_matrix_ * patches_;
+  output->colwise() += bias_;
 }
 
 bool MaxPool1d::Load(const LayerParameter& layer_pb) {
@@ -300,22 +307,26 @@ bool BatchNormalization::Load(const LayerParameter& layer_pb) {
       return false;
     }
   }
+
+  // (x - mu) / (sqrt(sigma) + epsilon) * gamma + beta
+  folded_scale_ =
+      (sigma_.array().sqrt() + epsilon_).inverse().matrix().transpose();
+  if (scale_) {
+    folded_scale_.array() *= gamma_.transpose().array();
+  }
+  folded_shift_ = -mu_.transpose().cwiseProduct(folded_scale_);
+  if (center_) {
+    folded_shift_ += beta_.transpose();
+  }
   return true;
 }
 
 void BatchNormalization::Run(const std::vector<Eigen::MatrixXf>& inputs,
                              Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf temp = (inputs[0].rowwise() - mu_.transpose());
-  Eigen::MatrixXf norm =
-      temp.array().rowwise() / (sigma_.array().sqrt() + epsilon_).transpose();
-  if (scale_) {
-    norm = norm.array().rowwise() * gamma_.transpose().array();
-  }
-  if (center_) {
-    norm = norm.rowwise() + beta_.transpose();
-  }
-  *output = norm;
+  *output = inputs[0];
+  output->array().rowwise() *= folded_scale_.array();
+  output->rowwise() += folded_shift_;
 }
 
 bool LSTM::Load(const LayerParameter& layer_pb) {
@@ -423,43 +434,50 @@ bool LSTM::Load(const LayerParameter& layer_pb) {
     AERROR << "Fail to Load reccurent output weights!";
     return false;
   }
+
+  fused_w_.resize(wi_.rows(), 4 * units_);
+  fused_w_ << wi_, wf_, wc_, wo_;
+  fused_r_w_.resize(r_wi_.rows(), 4 * units_);
+  fused_r_w_ << r_wi_, r_wf_, r_wc_, r_wo_;
+  fused_b_.resize(4 * units_);
+  fused_b_ << bi_.transpose(), bf_.transpose(), bc_.transpose(),
+      bo_.transpose();
   ResetState();
   return true;
 }
 
-void LSTM::Step(const Eigen::MatrixXf& input, Eigen::MatrixXf* output,
-                Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1) {
-  Eigen::MatrixXf x_i = input * wi_ + bi_.transpose();
-  Eigen::MatrixXf x_f = input * wf_ + bf_.transpose();
-  Eigen::MatrixXf x_c = input * wc_ + bc_.transpose();
-  Eigen::MatrixXf x_o = input * wo_ + bo_.transpose();
-
-  Eigen::MatrixXf i = (x_i + (*ht_1) * r_wi_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf f = (x_f + (*ht_1) * r_wf_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf c =
-      f.array() * ct_1->array() +
-      i.array() * ((x_c + (*ht_1) * r_wc_).unaryExpr(kactivation_)).array();
-  Eigen::MatrixXf o = (x_o + (*ht_1) * r_wo_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf h = o.array() * (c.unaryExpr(kactivation_)).array();
-
-  *ht_1 = h;
-  *ct_1 = c;
-  *output = h;
+void LSTM::Step(const int step, Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1) {
+  gates_.noalias() = (*ht_1) * fused_r_w_;
+  gates_ += input_gates_.row(step);
+
+  auto i = gates_.segment(0, units_).unaryExpr(krecurrent_activation_);
+  auto f = gates_.segment(units_, units_).unaryExpr(krecurrent_activation_);
+  auto c_hat = gates_.segment(2 * units_, units_).unaryExpr(kactivation_);
+  ct_1->row(0) = f.cwiseProduct(ct_1->row(0)) + i.cwiseProduct(c_hat);
+  auto o =
+      gates_.segment(3 * units_, units_).unaryExpr(krecurrent_activation_);
+  ht_1->row(0) = o.cwiseProduct(ct_1->row(0).unaryExpr(kactivation_));
 }
 
 void LSTM::Run(const std::vector<Eigen::MatrixXf>& inputs,
                Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf sequences(inputs[0].rows(), units_);
-  Eigen::MatrixXf temp;
+  CHECK_GT(inputs[0].rows(), 0);
+  // the input projections of all steps do not depend on the state
+  input_gates_.noalias() = inputs[0] * fused_w_;
+  input_gates_.rowwise() += fused_b_;
+
+  if (return_sequences_) {
+    output->resize(inputs[0].rows(), units_);
+  }
   for (int i = 0; i < inputs[0].rows(); ++i) {
-    Step(inputs[0].row(i), &temp, &ht_1_, &ct_1_);
-    sequences.row(i) = temp.row(0);
+    Step(i, &ht_1_, &ct_1_);
+    if (return_sequences_) {
+      output->row(i) = ht_1_.row(0);
+    }
   }
-  if (return_sequences_) {
-    *output = sequences;
-  } else {
-    *output = temp.row(0);
+  if (!return_sequences_) {
+    *output = ht_1_;
   }
 }
 
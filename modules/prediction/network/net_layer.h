@@ -176,6 +176,12 @@ class Conv1d : public Layer {
   std::vector<Eigen::MatrixXf> kernel_;
   Eigen::VectorXf bias_;
   int stride_;
+
+  // kernels flattened to one row per output channel, built at load so the
+  // convolution runs as one matrix product over the unfolded input
+  Eigen::MatrixXf kernel_matrix_;
+  // unfolded input, one column per output position, reused between runs
+  Eigen::MatrixXf patches_;
 };
 
 /**
@@ -307,6 +313,9 @@ class BatchNormalization : public Layer {
   Eigen::VectorXf sigma_;
   Eigen::VectorXf gamma_;
   Eigen::VectorXf beta_;
+  // normalization folded into output = input * scale + shift at load
+  Eigen::RowVectorXf folded_scale_;
+  Eigen::RowVectorXf folded_shift_;
   float epsilon_ = 0.0f;
   float momentum_ = 0.0f;
   int axis_ = 0;
@@ -361,8 +370,8 @@ class LSTM : public Layer {
    * @param Hidden state of previous step and return current hidden state
    * @param Cell state of previous step and return current cell state
    */
-  void Step(const Eigen::MatrixXf& input, Eigen::MatrixXf* output,
-            Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1);
+  // runs step |step| of the input projections in input_gates_
+  void Step(const int step, Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1);
 
   Eigen::MatrixXf wi_;
   Eigen::MatrixXf wf_;
@@ -378,6 +387,16 @@ class LSTM : public Layer {
   Eigen::MatrixXf r_wc_;
   Eigen::MatrixXf r_wo_;
 
+  // weights and bias of the input, forget, cell and output gates side by
+  // side, built at load so every step runs one product per input
+  Eigen::MatrixXf fused_w_;
+  Eigen::MatrixXf fused_r_w_;
+  Eigen::RowVectorXf fused_b_;
+  // gate pre-activations of all steps and of one step, reused between runs
+  Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      input_gates_;
+  Eigen::RowVectorXf gates_;
+
   Eigen::MatrixXf ht_1_;
   Eigen::MatrixXf ct_1_;
   std::function<float(float)> kactivation_;
@@ -215,6 +215,38 @@ TEST(LayerTest, concat_test) {
   EXPECT_FLOAT_EQ(output(1, 1), 4.0);
 }
 
+TEST(LayerTest, conv1d_test) {
+  LayerParameter layer_pb;
+  Conv1d conv1d;
+
+  auto* kernel = layer_pb.mutable_conv1d()->mutable_kernel();
+  kernel->add_shape(2);
+  kernel->add_shape(1);
+  kernel->add_shape(2);
+  for (float value : {1.0, 1.0, 1.0, -1.0}) {
+    kernel->add_data(value);
+  }
+  auto* bias = layer_pb.mutable_conv1d()->mutable_bias();
+  bias->add_shape(2);
+  bias->add_data(0.0);
+  bias->add_data(0.5);
+  layer_pb.mutable_conv1d()->set_stride(1);
+  EXPECT_TRUE(conv1d.Load(layer_pb));
+
+  Eigen::MatrixXf input(1, 4);
+  input << 1.0, 2.0, 3.0, 4.0;
+  Eigen::MatrixXf output;
+  conv1d.Run({input}, &output);
+  ASSERT_EQ(output.rows(), 2);
+  ASSERT_EQ(output.cols(), 3);
+  EXPECT_FLOAT_EQ(output(0, 0), 3.0);
+  EXPECT_FLOAT_EQ(output(0, 1), 5.0);
+  EXPECT_FLOAT_EQ(output(0, 2), 7.0);
+  EXPECT_FLOAT_EQ(output(1, 0), -0.5);
+  EXPECT_FLOAT_EQ(output(1, 1), -0.5);
+  EXPECT_FLOAT_EQ(output(1, 2), -0.5);
+}
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
@@ -0,0 +1,313 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file prediction_benchmark.cc
+ * @brief Replays the perception obstacles, localization and planning
+ *        messages of records through the prediction managers, and reports
+ *        the latency percentiles and the allocations of every stage per
+ *        number of obstacles in the frame.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "cyber/record/record_reader.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/prediction/common/junction_analyzer.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+#include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
+#include "modules/prediction/container/container_manager.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/container/pose/pose_container.h"
+#include "modules/prediction/evaluator/evaluator_manager.h"
+#include "modules/prediction/predictor/predictor_manager.h"
+#include "modules/prediction/proto/prediction_conf.pb.h"
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
+#include "modules/prediction/scenario/scenario_manager.h"
+
+DEFINE_string(prediction_benchmark_records, "",
+              "Colon separated records to replay");
+DEFINE_int32(prediction_benchmark_repeat, 1,
+             "Number of times the records are replayed");
+DEFINE_int32(prediction_benchmark_bucket_size, 10,
+             "Number of obstacles per row of the report");
+
+namespace {
+
+// operator new of the whole process, workers included
+std::atomic<uint64_t> num_allocations(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::adapter::AdapterConfig;
+using apollo::localization::LocalizationEstimate;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+using apollo::planning::ADCTrajectory;
+using cyber::record::RecordMessage;
+using cyber::record::RecordReader;
+
+namespace {
+
+enum Stage { CONTAINER = 0, SCENARIO, EVALUATOR, PREDICTOR, NUM_STAGES };
+
+const char* const kStageNames[NUM_STAGES] = {"container", "scenario",
+                                             "evaluator", "predictor"};
+
+struct FrameSample {
+  double time_ms[NUM_STAGES] = {};
+  uint64_t num_allocations[NUM_STAGES] = {};
+};
+
+struct StageSamples {
+  std::vector<double> time_ms;
+  uint64_t num_allocations = 0;
+};
+
+// samples of every stage, by the number of obstacles bucket
+std::map<int, std::array<StageSamples, NUM_STAGES>> samples;
+
+// adds the time and the allocations of a scope to a stage of the frame
+class StageTimer {
+ public:
+  StageTimer(const Stage stage, FrameSample* frame_sample)
+      : stage_(stage), frame_sample_(frame_sample),
+        start_allocations_(num_allocations.load()),
+        start_time_(std::chrono::steady_clock::now()) {}
+
+  ~StageTimer() {
+    const std::chrono::duration<double, std::milli> diff =
+        std::chrono::steady_clock::now() - start_time_;
+    frame_sample_->time_ms[stage_] += diff.count();
+    frame_sample_->num_allocations[stage_] +=
+        num_allocations.load() - start_allocations_;
+  }
+
+ private:
+  Stage stage_;
+  FrameSample* frame_sample_;
+  uint64_t start_allocations_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+bool InitManagers() {
+  PredictionConf prediction_conf;
+  if (!common::util::GetProtoFromFile(FLAGS_prediction_conf_file,
+                                      &prediction_conf)) {
+    AERROR << "Unable to load prediction conf file: "
+           << FLAGS_prediction_conf_file;
+    return false;
+  }
+  common::adapter::AdapterManagerConfig adapter_conf;
+  if (!common::util::GetProtoFromFile(FLAGS_prediction_adapter_config_filename,
+                                      &adapter_conf)) {
+    AERROR << "Unable to load adapter conf file: "
+           << FLAGS_prediction_adapter_config_filename;
+    return false;
+  }
+  ContainerManager::Instance()->Init(adapter_conf);
+  EvaluatorManager::Instance()->Init(prediction_conf);
+  PredictorManager::Instance()->Init(prediction_conf);
+  ObstaclesPrioritizer::Instance()->Init(prediction_conf);
+  return true;
+}
+
+// the stages of PredictionComponent::OnPerception
+void OnPerception(const PerceptionObstacles& perception_obstacles) {
+  const int bucket = perception_obstacles.perception_obstacle_size() /
+                     std::max(FLAGS_prediction_benchmark_bucket_size, 1);
+  auto obstacles_container =
+      ContainerManager::Instance()->GetContainer<ObstaclesContainer>(
+          AdapterConfig::PERCEPTION_OBSTACLES);
+  auto pose_container =
+      ContainerManager::Instance()->GetContainer<PoseContainer>(
+          AdapterConfig::LOCALIZATION);
+  auto adc_trajectory_container =
+      ContainerManager::Instance()->GetContainer<ADCTrajectoryContainer>(
+          AdapterConfig::PLANNING_TRAJECTORY);
+  CHECK(obstacles_container != nullptr && pose_container != nullptr &&
+        adc_trajectory_container != nullptr);
+
+  FrameSample frame_sample;
+
+  {
+    StageTimer timer(CONTAINER, &frame_sample);
+    obstacles_container->Insert(perception_obstacles);
+  }
+  {
+    StageTimer timer(SCENARIO, &frame_sample);
+    ScenarioManager::Instance()->Run();
+  }
+  {
+    StageTimer timer(CONTAINER, &frame_sample);
+    const Scenario& scenario = ScenarioManager::Instance()->scenario();
+    if (scenario.type() == Scenario::JUNCTION && scenario.has_junction_id() &&
+        FLAGS_enable_junction_feature) {
+      JunctionAnalyzer::Init(scenario.junction_id());
+      obstacles_container->BuildJunctionFeature();
+    }
+    obstacles_container->BuildLaneGraph();
+    const PerceptionObstacle* adc = pose_container->ToPerceptionObstacle();
+    if (adc != nullptr) {
+      obstacles_container->InsertPerceptionObstacle(*adc, adc->timestamp());
+      adc_trajectory_container->SetPosition(
+          {adc->position().x(), adc->position().y()});
+    }
+  }
+  {
+    StageTimer timer(EVALUATOR, &frame_sample);
+    ObstaclesPrioritizer::Instance()->Run();
+    EvaluatorManager::Instance()->Run(perception_obstacles);
+  }
+  {
+    StageTimer timer(PREDICTOR, &frame_sample);
+    PredictorManager::Instance()->Run(perception_obstacles);
+  }
+
+  auto& bucket_samples = samples[bucket];
+  for (int stage = 0; stage < NUM_STAGES; ++stage) {
+    bucket_samples[stage].time_ms.push_back(frame_sample.time_ms[stage]);
+    bucket_samples[stage].num_allocations +=
+        frame_sample.num_allocations[stage];
+  }
+}
+
+void ReplayRecord(const std::string& record_file) {
+  RecordReader reader(record_file);
+  RecordMessage message;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name == FLAGS_perception_obstacle_topic) {
+      PerceptionObstacles perception_obstacles;
+      if (perception_obstacles.ParseFromString(message.content)) {
+        OnPerception(perception_obstacles);
+      }
+    } else if (message.channel_name == FLAGS_localization_topic) {
+      LocalizationEstimate localization;
+      if (localization.ParseFromString(message.content)) {
+        ContainerManager::Instance()
+            ->GetContainer<PoseContainer>(AdapterConfig::LOCALIZATION)
+            ->Insert(localization);
+      }
+    } else if (message.channel_name == FLAGS_planning_trajectory_topic) {
+      ADCTrajectory adc_trajectory;
+      if (adc_trajectory.ParseFromString(message.content)) {
+        ContainerManager::Instance()
+            ->GetContainer<ADCTrajectoryContainer>(
+                AdapterConfig::PLANNING_TRAJECTORY)
+            ->Insert(adc_trajectory);
+      }
+    }
+  }
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percent) {
+  if (sorted_values.empty()) {
+    return 0.0;
+  }
+  const size_t rank = static_cast<size_t>(
+      std::ceil(percent / 100.0 * static_cast<double>(sorted_values.size())));
+  return sorted_values[std::max(rank, static_cast<size_t>(1)) - 1];
+}
+
+void Report() {
+  const int bucket_size = std::max(FLAGS_prediction_benchmark_bucket_size, 1);
+  std::printf("%-11s %-10s %7s %9s %9s %9s %9s %12s\n", "obstacles", "stage",
+              "frames", "p50 ms", "p90 ms", "p99 ms", "max ms", "allocs/frame");
+  for (auto& bucket_samples : samples) {
+    const int min_obstacles = bucket_samples.first * bucket_size;
+    const std::string obstacles =
+        std::to_string(min_obstacles) + "-" +
+        std::to_string(min_obstacles + bucket_size - 1);
+    for (int stage = 0; stage < NUM_STAGES; ++stage) {
+      StageSamples& stage_samples = bucket_samples.second[stage];
+      std::vector<double>& time_ms = stage_samples.time_ms;
+      if (time_ms.empty()) {
+        continue;
+      }
+      std::sort(time_ms.begin(), time_ms.end());
+      const size_t num_frames = time_ms.size();
+      std::printf("%-11s %-10s %7zu %9.3f %9.3f %9.3f %9.3f %12.1f\n",
+                  obstacles.c_str(), kStageNames[stage], num_frames,
+                  Percentile(time_ms, 50.0), Percentile(time_ms, 90.0),
+                  Percentile(time_ms, 99.0), time_ms.back(),
+                  static_cast<double>(stage_samples.num_allocations) /
+                      static_cast<double>(num_frames));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (!apollo::prediction::InitManagers()) {
+    return 1;
+  }
+  std::vector<std::string> records;
+  apollo::common::util::Split(FLAGS_prediction_benchmark_records, ':',
+                              &records);
+  if (records.empty()) {
+    AERROR << "No record to replay, set --prediction_benchmark_records";
+    return 1;
+  }
+  for (int i = 0; i < FLAGS_prediction_benchmark_repeat; ++i) {
+    for (const auto& record : records) {
+      AINFO << "Replaying " << record;
+      apollo::prediction::ReplayRecord(record);
+    }
+  }
+  apollo::prediction::Report();
+  return 0;
+}
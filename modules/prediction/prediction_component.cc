@@ -32,6 +32,7 @@
 #include "modules/prediction/evaluator/evaluator_manager.h"
 #include "modules/prediction/predictor/predictor_manager.h"
 #include "modules/prediction/proto/offline_features.pb.h"
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
 #include "modules/prediction/scenario/scenario_manager.h"
 #include "modules/prediction/util/data_extraction.h"
 
@@ -126,6 +127,7 @@ bool PredictionComponent::Init() {
   ContainerManager::Instance()->Init(adapter_conf);
   EvaluatorManager::Instance()->Init(prediction_conf);
   PredictorManager::Instance()->Init(prediction_conf);
+  ObstaclesPrioritizer::Instance()->Init(prediction_conf);
 
   if (!FLAGS_use_navigation_mode && !PredictionMap::Ready()) {
     AERROR << "Map cannot be loaded.";
@@ -247,6 +249,8 @@ void PredictionComponent::OnPerception(
               << ", " << std::fixed << std::setprecision(6) << y << "].";
     ptr_ego_trajectory_container->SetPosition({x, y});
   }
+  // Rank the obstacles within the prediction budget
+  ObstaclesPrioritizer::Instance()->Run();
   auto end_time6 = std::chrono::system_clock::now();
 
   // Make evaluations
@@ -16,7 +16,12 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/task/task.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/predictor/free_move/free_move_predictor.h"
@@ -25,6 +30,7 @@
 #include "modules/prediction/predictor/move_sequence/move_sequence_predictor.h"
 #include "modules/prediction/predictor/regional/regional_predictor.h"
 #include "modules/prediction/predictor/single_lane/single_lane_predictor.h"
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
 
 namespace apollo {
 namespace prediction {
@@ -118,6 +124,18 @@ void PredictorManager::Init(const PredictionConf& config) {
         << default_on_lane_predictor_ << "].";
   AINFO << "Defined default off lane obstacle predictor ["
         << default_off_lane_predictor_ << "].";
+
+  worker_predictors_.clear();
+  if (FLAGS_enable_multi_thread && FLAGS_max_thread_num > 1) {
+    worker_predictors_.resize(FLAGS_max_thread_num);
+    for (auto& worker_predictors : worker_predictors_) {
+      for (const auto& predictor : predictors_) {
+        worker_predictors[predictor.first] = CreatePredictor(predictor.first);
+      }
+    }
+    AINFO << "Predict obstacles with [" << worker_predictors_.size()
+          << "] workers.";
+  }
 }
 
 Predictor* PredictorManager::GetPredictor(
@@ -136,7 +154,11 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
 
   CHECK_NOTNULL(obstacles_container);
 
-  Predictor* predictor = nullptr;
+  std::vector<const PerceptionObstacle*> perception_obstacle_ptrs;
+  std::vector<Obstacle*> obstacles;
+  const int num_obstacles = perception_obstacles.perception_obstacle_size();
+  perception_obstacle_ptrs.reserve(num_obstacles);
+  obstacles.reserve(num_obstacles);
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     if (!perception_obstacle.has_id()) {
@@ -149,90 +171,142 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
       AERROR << "A perception obstacle has invalid id [" << id << "].";
       continue;
     }
-
-    PredictionObstacle prediction_obstacle;
-    prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-    Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    perception_obstacle_ptrs.push_back(&perception_obstacle);
     // if obstacle == nullptr, that means obstacle is not predictable
     // Checkout the logic of non-predictable in obstacle.cc
-    if (obstacle != nullptr) {
-      if (obstacle->ToIgnore()) {
-        ADEBUG << "Ignore obstacle [" << id << "]";
-        predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
-        prediction_obstacle.mutable_priority()
-            ->set_priority(ObstaclePriority::IGNORE);
-      } else if (obstacle->IsStill()) {
-        ADEBUG << "Still obstacle [" << id << "]";
-        predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
-      } else {
-        switch (perception_obstacle.type()) {
-          case PerceptionObstacle::VEHICLE: {
-            if (obstacle->HasJunctionFeatureWithExits() &&
-                !obstacle->IsClosedToJunctionExit()) {
-              predictor = GetPredictor(vehicle_in_junction_predictor_);
-              CHECK_NOTNULL(predictor);
-            } else if (obstacle->IsOnLane()) {
-              predictor = GetPredictor(vehicle_on_lane_predictor_);
-              CHECK_NOTNULL(predictor);
-            } else {
-              predictor = GetPredictor(vehicle_off_lane_predictor_);
-              CHECK_NOTNULL(predictor);
-            }
-            break;
-          }
-          case PerceptionObstacle::PEDESTRIAN: {
-            predictor = GetPredictor(pedestrian_predictor_);
-            break;
-          }
-          case PerceptionObstacle::BICYCLE: {
-            if (obstacle->IsOnLane() && !obstacle->IsNearJunction()) {
-              predictor = GetPredictor(cyclist_on_lane_predictor_);
-            } else {
-              predictor = GetPredictor(cyclist_off_lane_predictor_);
-            }
-            break;
-          }
-          default: {
-            if (obstacle->IsOnLane()) {
-              predictor = GetPredictor(default_on_lane_predictor_);
-            } else {
-              predictor = GetPredictor(default_off_lane_predictor_);
-            }
-            break;
-          }
-        }
-      }
+    obstacles.push_back(obstacles_container->GetObstacle(id));
+  }
 
-      if (predictor != nullptr) {
-        predictor->Predict(obstacle);
-        if (FLAGS_enable_trim_prediction_trajectory &&
-            obstacle->type() == PerceptionObstacle::VEHICLE) {
-          CHECK_NOTNULL(adc_trajectory_container);
-          predictor->TrimTrajectories(obstacle, adc_trajectory_container);
-        }
-        for (const auto& trajectory : predictor->trajectories()) {
-          prediction_obstacle.add_trajectory()->CopyFrom(trajectory);
-        }
+  // the results are collected by the order of the perception obstacles, so
+  // the output does not depend on the scheduling of the workers
+  std::vector<PredictionObstacle> results(obstacles.size());
+  PredictorTimingMap timings;
+  if (!worker_predictors_.empty()) {
+    const size_t num_workers =
+        std::min(worker_predictors_.size(), obstacles.size());
+    std::vector<PredictorTimingMap> worker_timings(num_workers);
+    cyber::ParallelFor(0, num_workers, 1, [&](size_t worker) {
+      for (size_t i = worker; i < obstacles.size(); i += num_workers) {
+        PredictObstacle(*perception_obstacle_ptrs[i], obstacles[i],
+                        adc_trajectory_container, &worker_predictors_[worker],
+                        &worker_timings[worker], &results[i]);
+      }
+    });
+    for (const auto& worker_timing : worker_timings) {
+      for (const auto& timing : worker_timing) {
+        timings[timing.first].count += timing.second.count;
+        timings[timing.first].time_ms += timing.second.time_ms;
       }
-      prediction_obstacle.set_timestamp(obstacle->timestamp());
-      prediction_obstacle.set_is_static(obstacle->IsStill());
-    } else {
-      prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-      prediction_obstacle.set_is_static(true);
     }
+  } else {
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      PredictObstacle(*perception_obstacle_ptrs[i], obstacles[i],
+                      adc_trajectory_container, &predictors_, &timings,
+                      &results[i]);
+    }
+  }
+  for (const auto& timing : timings) {
+    ADEBUG << "Predictor [" << timing.first << "] predicted ["
+           << timing.second.count << "] obstacles in ["
+           << timing.second.time_ms << "] ms.";
+  }
 
-    prediction_obstacle.set_predicted_period(
-        FLAGS_prediction_trajectory_time_length);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
-        perception_obstacle);
-
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
+  for (auto& prediction_obstacle : results) {
+    prediction_obstacles_.add_prediction_obstacle()->Swap(&prediction_obstacle);
   }
   prediction_obstacles_.set_perception_error_code(
       perception_obstacles.error_code());
 }
 
+void PredictorManager::PredictObstacle(
+    const PerceptionObstacle& perception_obstacle, Obstacle* obstacle,
+    ADCTrajectoryContainer* adc_trajectory_container,
+    PredictorMap* predictors, PredictorTimingMap* timings,
+    PredictionObstacle* prediction_obstacle) {
+  prediction_obstacle->set_timestamp(perception_obstacle.timestamp());
+  if (obstacle != nullptr) {
+    ObstacleConf::PredictorType type = ObstacleConf::EMPTY_PREDICTOR;
+    if (obstacle->ToIgnore()) {
+      ADEBUG << "Ignore obstacle [" << obstacle->id() << "]";
+      prediction_obstacle->mutable_priority()
+          ->set_priority(ObstaclePriority::IGNORE);
+    } else if (obstacle->IsStill()) {
+      ADEBUG << "Still obstacle [" << obstacle->id() << "]";
+    } else if (!ObstaclesPrioritizer::Instance()->IsPrioritized(
+                   obstacle->id())) {
+      ADEBUG << "Obstacle [" << obstacle->id()
+             << "] is out of the prediction budget";
+      type = ObstacleConf::FREE_MOVE_PREDICTOR;
+    } else {
+      type = SelectPredictorType(perception_obstacle, obstacle);
+    }
+
+    auto it = predictors->find(type);
+    Predictor* predictor = it != predictors->end() ? it->second.get() : nullptr;
+    if (type != ObstacleConf::EMPTY_PREDICTOR &&
+        perception_obstacle.type() == PerceptionObstacle::VEHICLE) {
+      CHECK_NOTNULL(predictor);
+    }
+
+    if (predictor != nullptr) {
+      auto start_time = std::chrono::steady_clock::now();
+      predictor->Predict(obstacle);
+      if (FLAGS_enable_trim_prediction_trajectory &&
+          obstacle->type() == PerceptionObstacle::VEHICLE) {
+        CHECK_NOTNULL(adc_trajectory_container);
+        predictor->TrimTrajectories(obstacle, adc_trajectory_container);
+      }
+      for (const auto& trajectory : predictor->trajectories()) {
+        prediction_obstacle->add_trajectory()->CopyFrom(trajectory);
+      }
+      std::chrono::duration<double, std::milli> diff =
+          std::chrono::steady_clock::now() - start_time;
+      PredictorTiming& timing = (*timings)[type];
+      ++timing.count;
+      timing.time_ms += diff.count();
+    }
+    prediction_obstacle->set_timestamp(obstacle->timestamp());
+    prediction_obstacle->set_is_static(obstacle->IsStill());
+  } else {
+    prediction_obstacle->set_is_static(true);
+  }
+
+  prediction_obstacle->set_predicted_period(
+      FLAGS_prediction_trajectory_time_length);
+  prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
+      perception_obstacle);
+}
+
+ObstacleConf::PredictorType PredictorManager::SelectPredictorType(
+    const PerceptionObstacle& perception_obstacle, Obstacle* obstacle) {
+  switch (perception_obstacle.type()) {
+    case PerceptionObstacle::VEHICLE: {
+      if (obstacle->HasJunctionFeatureWithExits() &&
+          !obstacle->IsClosedToJunctionExit()) {
+        return vehicle_in_junction_predictor_;
+      } else if (obstacle->IsOnLane()) {
+        return vehicle_on_lane_predictor_;
+      }
+      return vehicle_off_lane_predictor_;
+    }
+    case PerceptionObstacle::PEDESTRIAN: {
+      return pedestrian_predictor_;
+    }
+    case PerceptionObstacle::BICYCLE: {
+      if (obstacle->IsOnLane() && !obstacle->IsNearJunction()) {
+        return cyclist_on_lane_predictor_;
+      }
+      return cyclist_off_lane_predictor_;
+    }
+    default: {
+      if (obstacle->IsOnLane()) {
+        return default_on_lane_predictor_;
+      }
+      return default_off_lane_predictor_;
+    }
+  }
+}
+
 std::unique_ptr<Predictor> PredictorManager::CreatePredictor(
     const ObstacleConf::PredictorType& type) {
   std::unique_ptr<Predictor> predictor_ptr(nullptr);
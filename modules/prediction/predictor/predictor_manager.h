@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "modules/prediction/predictor/predictor.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -66,6 +67,42 @@ class PredictorManager {
   const PredictionObstacles& prediction_obstacles();
 
  private:
+  using PredictorMap =
+      std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>>;
+
+  // number of predicted obstacles and time spent in one predictor
+  struct PredictorTiming {
+    int count = 0;
+    double time_ms = 0.0;
+  };
+  using PredictorTimingMap =
+      std::map<ObstacleConf::PredictorType, PredictorTiming>;
+
+  /**
+   * @brief Predict an obstacle with a predictor of a given set
+   * @param Perception obstacle
+   * @param Obstacle pointer, nullptr if the obstacle is not predictable
+   * @param ADC trajectory container
+   * @param Predictors to use
+   * @param Timings of the predictors to update
+   * @param Output prediction obstacle
+   */
+  void PredictObstacle(
+      const perception::PerceptionObstacle& perception_obstacle,
+      Obstacle* obstacle, ADCTrajectoryContainer* adc_trajectory_container,
+      PredictorMap* predictors, PredictorTimingMap* timings,
+      PredictionObstacle* prediction_obstacle);
+
+  /**
+   * @brief Select the predictor type of a predictable obstacle
+   * @param Perception obstacle
+   * @param Obstacle pointer
+   * @return Predictor type
+   */
+  ObstacleConf::PredictorType SelectPredictorType(
+      const perception::PerceptionObstacle& perception_obstacle,
+      Obstacle* obstacle);
+
   /**
    * @brief Register a predictor by type
    * @param Predictor type
@@ -86,7 +123,11 @@ class PredictorManager {
   void RegisterPredictors();
 
  private:
-  std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>> predictors_;
+  PredictorMap predictors_;
+
+  // predictor sets of the workers of the multi-thread mode, predictors keep
+  // their trajectories and can not be shared between threads
+  std::vector<PredictorMap> worker_predictors_;
 
   ObstacleConf::PredictorType vehicle_on_lane_predictor_ =
       ObstacleConf::LANE_SEQUENCE_PREDICTOR;
@@ -18,6 +18,7 @@
 
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/evaluator/evaluator_manager.h"
@@ -66,5 +67,41 @@ TEST_F(PredictorManagerTest, General) {
   EXPECT_EQ(prediction_obstacles.prediction_obstacle_size(), 1);
 }
 
+TEST_F(PredictorManagerTest, MultiThread) {
+  FLAGS_enable_trim_prediction_trajectory = false;
+  std::string conf_file = "modules/prediction/testdata/adapter_conf.pb.txt";
+  bool ret_load_conf = common::util::GetProtoFromFile(
+      conf_file, &adapter_conf_);
+  EXPECT_TRUE(ret_load_conf);
+
+  ContainerManager::Instance()->Init(adapter_conf_);
+  auto obstacles_container = ContainerManager::Instance()->GetContainer<
+      ObstaclesContainer>(AdapterConfig::PERCEPTION_OBSTACLES);
+  CHECK_NOTNULL(obstacles_container);
+  obstacles_container->Insert(perception_obstacles_);
+
+  FLAGS_enable_multi_thread = false;
+  EvaluatorManager::Instance()->Init(prediction_conf_);
+  PredictorManager::Instance()->Init(prediction_conf_);
+  EvaluatorManager::Instance()->Run(perception_obstacles_);
+  PredictorManager::Instance()->Run(perception_obstacles_);
+  const PredictionObstacles serial_obstacles =
+      PredictorManager::Instance()->prediction_obstacles();
+
+  FLAGS_enable_multi_thread = true;
+  FLAGS_max_thread_num = 2;
+  EvaluatorManager::Instance()->Init(prediction_conf_);
+  PredictorManager::Instance()->Init(prediction_conf_);
+  EvaluatorManager::Instance()->Run(perception_obstacles_);
+  PredictorManager::Instance()->Run(perception_obstacles_);
+  const PredictionObstacles& parallel_obstacles =
+      PredictorManager::Instance()->prediction_obstacles();
+  FLAGS_enable_multi_thread = false;
+
+  EXPECT_EQ(parallel_obstacles.prediction_obstacle_size(), 1);
+  EXPECT_EQ(serial_obstacles.SerializeAsString(),
+            parallel_obstacles.SerializeAsString());
+}
+
 }  // namespace prediction
 }  // namespace apollo
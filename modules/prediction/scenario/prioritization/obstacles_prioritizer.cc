@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
+#include "modules/prediction/container/container_manager.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/container/pose/pose_container.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::adapter::AdapterConfig;
+using apollo::common::math::Vec2d;
+using apollo::perception::PerceptionObstacle;
+
+ObstaclesPrioritizer::ObstaclesPrioritizer() {}
+
+void ObstaclesPrioritizer::Init(const PredictionConf& config) {
+  has_budget_ = config.has_prediction_budget();
+  budget_ = config.prediction_budget();
+  is_ranked_ = false;
+  prioritized_ids_.clear();
+  if (has_budget_) {
+    AINFO << "Prediction budget [" << budget_.ShortDebugString() << "].";
+  }
+}
+
+void ObstaclesPrioritizer::Run() {
+  is_ranked_ = false;
+  prioritized_ids_.clear();
+  if (!has_budget_) {
+    return;
+  }
+  auto obstacles_container =
+      ContainerManager::Instance()->GetContainer<ObstaclesContainer>(
+          AdapterConfig::PERCEPTION_OBSTACLES);
+  auto pose_container =
+      ContainerManager::Instance()->GetContainer<PoseContainer>(
+          AdapterConfig::LOCALIZATION);
+  auto adc_trajectory_container =
+      ContainerManager::Instance()->GetContainer<ADCTrajectoryContainer>(
+          AdapterConfig::PLANNING_TRAJECTORY);
+  if (obstacles_container == nullptr || pose_container == nullptr ||
+      adc_trajectory_container == nullptr) {
+    return;
+  }
+  const PerceptionObstacle* adc = pose_container->ToPerceptionObstacle();
+  if (adc == nullptr) {
+    ADEBUG << "No ADC pose, predict all the obstacles.";
+    return;
+  }
+  const Vec2d adc_position(adc->position().x(), adc->position().y());
+
+  std::vector<ObstacleRelevance> relevances;
+  for (const int id :
+       obstacles_container->GetCurrentFramePredictableObstacleIds()) {
+    if (id == PoseContainer::ID) {
+      continue;
+    }
+    Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    if (obstacle == nullptr || obstacle->history_size() == 0) {
+      continue;
+    }
+    relevances.push_back(ComputeRelevance(
+        obstacle->latest_feature(), adc_trajectory_container->adc_trajectory(),
+        adc_position, budget_.min_speed()));
+  }
+  prioritized_ids_ = SelectPrioritized(budget_, std::move(relevances));
+  is_ranked_ = true;
+  ADEBUG << "Prioritized [" << prioritized_ids_.size() << "] obstacles.";
+}
+
+bool ObstaclesPrioritizer::IsPrioritized(const int id) const {
+  return !is_ranked_ || prioritized_ids_.count(id) > 0;
+}
+
+ObstaclesPrioritizer::ObstacleRelevance ObstaclesPrioritizer::ComputeRelevance(
+    const Feature& feature, const planning::ADCTrajectory& adc_trajectory,
+    const Vec2d& adc_position, const double min_speed) {
+  const Vec2d position(feature.position().x(), feature.position().y());
+  Vec2d conflict_point = adc_position;
+  double adc_time = 0.0;
+  double min_distance_sqr = position.DistanceSquareTo(adc_position);
+  for (const auto& trajectory_point : adc_trajectory.trajectory_point()) {
+    const Vec2d point(trajectory_point.path_point().x(),
+                      trajectory_point.path_point().y());
+    const double distance_sqr = position.DistanceSquareTo(point);
+    if (distance_sqr < min_distance_sqr) {
+      min_distance_sqr = distance_sqr;
+      conflict_point = point;
+      adc_time = std::max(trajectory_point.relative_time(), 0.0);
+    }
+  }
+
+  ObstacleRelevance relevance;
+  relevance.id = feature.id();
+  relevance.distance = std::sqrt(min_distance_sqr);
+  // only the velocity towards the conflict point brings the obstacle closer
+  double closing_speed = feature.speed();
+  if (relevance.distance > std::numeric_limits<double>::epsilon()) {
+    const Vec2d velocity(feature.velocity().x(), feature.velocity().y());
+    closing_speed =
+        velocity.InnerProd(conflict_point - position) / relevance.distance;
+  }
+  const double obstacle_time =
+      relevance.distance / std::max(closing_speed, min_speed);
+  relevance.time_to_conflict = std::max(adc_time, obstacle_time);
+  return relevance;
+}
+
+std::unordered_set<int> ObstaclesPrioritizer::SelectPrioritized(
+    const PredictionBudget& budget,
+    std::vector<ObstacleRelevance> relevances) {
+  std::sort(relevances.begin(), relevances.end(),
+            [](const ObstacleRelevance& lhs, const ObstacleRelevance& rhs) {
+              if (lhs.time_to_conflict != rhs.time_to_conflict) {
+                return lhs.time_to_conflict < rhs.time_to_conflict;
+              }
+              return lhs.distance < rhs.distance;
+            });
+  std::unordered_set<int> prioritized_ids;
+  const size_t max_num_obstacles = static_cast<size_t>(
+      std::max(budget.max_num_prioritized_obstacles(), 0));
+  for (const auto& relevance : relevances) {
+    if (prioritized_ids.size() >= max_num_obstacles ||
+        relevance.time_to_conflict > budget.max_time_to_conflict()) {
+      break;
+    }
+    prioritized_ids.insert(relevance.id);
+  }
+  return prioritized_ids;
+}
+
+}  // namespace prediction
+}  // namespace apollo
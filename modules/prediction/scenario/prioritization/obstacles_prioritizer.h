@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Rank the obstacles by their relevance to the ADC
+ */
+
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/prediction/proto/feature.pb.h"
+#include "modules/prediction/proto/prediction_conf.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+class ObstaclesPrioritizer {
+ public:
+  struct ObstacleRelevance {
+    int id = 0;
+    // the time when both the obstacle and the ADC may reach the conflict point
+    double time_to_conflict = 0.0;
+    // distance from the obstacle to the conflict point
+    double distance = 0.0;
+  };
+
+  /**
+   * @brief Initialize the prediction budget
+   * @param config The prediction conf, no budget if not set.
+   */
+  void Init(const PredictionConf& config);
+
+  /**
+   * @brief Rank the predictable obstacles of the current frame
+   */
+  void Run();
+
+  /**
+   * @brief Check if an obstacle should be fully evaluated and predicted
+   * @param id The obstacle id.
+   * @return True if there is no budget or the obstacle is within it.
+   */
+  bool IsPrioritized(const int id) const;
+
+  /**
+   * @brief Compute the relevance of an obstacle to the ADC. The conflict point
+   *        is the point of the ADC trajectory nearest to the obstacle, or the
+   *        ADC position without trajectory.
+   * @param feature The latest feature of the obstacle.
+   * @param adc_trajectory The planned ADC trajectory.
+   * @param adc_position The ADC position.
+   * @param min_speed The minimal closing speed of the obstacle.
+   * @return The relevance of the obstacle.
+   */
+  static ObstacleRelevance ComputeRelevance(
+      const Feature& feature, const planning::ADCTrajectory& adc_trajectory,
+      const common::math::Vec2d& adc_position, const double min_speed);
+
+  /**
+   * @brief Select the obstacles with the earliest conflicts within the budget
+   * @param budget The prediction budget.
+   * @param relevances The relevance of the obstacles.
+   * @return The ids of the prioritized obstacles.
+   */
+  static std::unordered_set<int> SelectPrioritized(
+      const PredictionBudget& budget,
+      std::vector<ObstacleRelevance> relevances);
+
+ private:
+  bool has_budget_ = false;
+
+  PredictionBudget budget_;
+
+  // whether the obstacles of the current frame are ranked
+  bool is_ranked_ = false;
+
+  std::unordered_set<int> prioritized_ids_;
+
+  DECLARE_SINGLETON(ObstaclesPrioritizer)
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/scenario/prioritization/obstacles_prioritizer.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::math::Vec2d;
+
+namespace {
+
+Feature MakeFeature(const int id, const double x, const double y,
+                    const double velocity_x, const double velocity_y) {
+  Feature feature;
+  feature.set_id(id);
+  feature.mutable_position()->set_x(x);
+  feature.mutable_position()->set_y(y);
+  feature.mutable_velocity()->set_x(velocity_x);
+  feature.mutable_velocity()->set_y(velocity_y);
+  feature.set_speed(std::hypot(velocity_x, velocity_y));
+  return feature;
+}
+
+}  // namespace
+
+TEST(ObstaclesPrioritizerTest, ComputeRelevance) {
+  // the ADC drives along the x axis at 10 m/s
+  planning::ADCTrajectory adc_trajectory;
+  for (int i = 0; i <= 50; ++i) {
+    auto* trajectory_point = adc_trajectory.add_trajectory_point();
+    trajectory_point->mutable_path_point()->set_x(i * 1.0);
+    trajectory_point->mutable_path_point()->set_y(0.0);
+    trajectory_point->set_relative_time(i * 0.1);
+  }
+  const Vec2d adc_position(0.0, 0.0);
+
+  // crossing the ADC trajectory at x = 30 in 2 seconds
+  auto relevance = ObstaclesPrioritizer::ComputeRelevance(
+      MakeFeature(1, 30.0, 10.0, 0.0, -5.0), adc_trajectory, adc_position,
+      0.5);
+  EXPECT_EQ(1, relevance.id);
+  EXPECT_DOUBLE_EQ(10.0, relevance.distance);
+  EXPECT_DOUBLE_EQ(3.0, relevance.time_to_conflict);
+
+  // driving away from the ADC trajectory at the same place
+  relevance = ObstaclesPrioritizer::ComputeRelevance(
+      MakeFeature(2, 30.0, 10.0, 0.0, 5.0), adc_trajectory, adc_position,
+      0.5);
+  EXPECT_DOUBLE_EQ(20.0, relevance.time_to_conflict);
+
+  // behind the ADC without trajectory
+  relevance = ObstaclesPrioritizer::ComputeRelevance(
+      MakeFeature(3, -10.0, 0.0, 5.0, 0.0), planning::ADCTrajectory(),
+      adc_position, 0.5);
+  EXPECT_DOUBLE_EQ(10.0, relevance.distance);
+  EXPECT_DOUBLE_EQ(2.0, relevance.time_to_conflict);
+}
+
+TEST(ObstaclesPrioritizerTest, SelectPrioritized) {
+  std::vector<ObstaclesPrioritizer::ObstacleRelevance> relevances(4);
+  const double times[4] = {5.0, 1.0, 9.0, 1.0};
+  const double distances[4] = {10.0, 20.0, 5.0, 3.0};
+  for (int i = 0; i < 4; ++i) {
+    relevances[i].id = i;
+    relevances[i].time_to_conflict = times[i];
+    relevances[i].distance = distances[i];
+  }
+
+  PredictionBudget budget;
+  budget.set_max_num_prioritized_obstacles(2);
+  auto prioritized_ids =
+      ObstaclesPrioritizer::SelectPrioritized(budget, relevances);
+  EXPECT_EQ(2, prioritized_ids.size());
+  EXPECT_EQ(1, prioritized_ids.count(1));
+  EXPECT_EQ(1, prioritized_ids.count(3));
+
+  // the obstacle with a later conflict is cut off
+  budget.set_max_num_prioritized_obstacles(4);
+  prioritized_ids =
+      ObstaclesPrioritizer::SelectPrioritized(budget, relevances);
+  EXPECT_EQ(3, prioritized_ids.size());
+  EXPECT_EQ(0, prioritized_ids.count(2));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/util/columnar_feature_writer.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+const uint32_t ColumnarFeatureWriter::kMagic;
+
+ColumnarFeatureWriter::ColumnarFeatureWriter(const std::string& file_name,
+                                             const size_t row_group_size)
+    : output_(file_name, std::ios::binary | std::ios::trunc),
+      row_group_size_(std::max(row_group_size, static_cast<size_t>(1))) {
+  if (!output_.is_open()) {
+    AERROR << "Failed to open " << file_name;
+  }
+}
+
+ColumnarFeatureWriter::~ColumnarFeatureWriter() { Flush(); }
+
+void ColumnarFeatureWriter::AddFeature(const Feature& feature) {
+  if (!feature.has_lane() || !feature.lane().has_lane_graph()) {
+    return;
+  }
+  for (const LaneSequence& lane_sequence :
+       feature.lane().lane_graph().lane_sequence()) {
+    const int num_values = lane_sequence.features().mlp_features_size();
+    if (num_values == 0) {
+      continue;
+    }
+    if (num_values != num_feature_columns_ ||
+        obstacle_ids_.size() >= row_group_size_) {
+      Flush();
+      num_feature_columns_ = num_values;
+    }
+    obstacle_ids_.push_back(feature.id());
+    timestamps_.push_back(feature.timestamp());
+    lane_sequence_ids_.push_back(lane_sequence.lane_sequence_id());
+    labels_.push_back(lane_sequence.label());
+    for (const double value : lane_sequence.features().mlp_features()) {
+      values_.push_back(static_cast<float>(value));
+    }
+    ++num_rows_;
+  }
+}
+
+void ColumnarFeatureWriter::Flush() {
+  if (obstacle_ids_.empty()) {
+    return;
+  }
+  const uint32_t header[3] = {kMagic,
+                              static_cast<uint32_t>(obstacle_ids_.size()),
+                              static_cast<uint32_t>(num_feature_columns_)};
+  output_.write(reinterpret_cast<const char*>(header), sizeof(header));
+  WriteColumn(obstacle_ids_);
+  WriteColumn(timestamps_);
+  WriteColumn(lane_sequence_ids_);
+  WriteColumn(labels_);
+
+  const size_t num_rows = obstacle_ids_.size();
+  column_.resize(num_rows);
+  for (int c = 0; c < num_feature_columns_; ++c) {
+    for (size_t r = 0; r < num_rows; ++r) {
+      column_[r] = values_[r * num_feature_columns_ + c];
+    }
+    WriteColumn(column_);
+  }
+  output_.flush();
+
+  obstacle_ids_.clear();
+  timestamps_.clear();
+  lane_sequence_ids_.clear();
+  labels_.clear();
+  values_.clear();
+}
+
+template <typename T>
+void ColumnarFeatureWriter::WriteColumn(const std::vector<T>& column) {
+  output_.write(reinterpret_cast<const char*>(column.data()),
+                column.size() * sizeof(T));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class ColumnarFeatureWriter
+ * @brief Writes the model features of the lane sequences column by column.
+ *
+ * The file is a series of row groups, one row per lane sequence with model
+ * features, all little endian:
+ *   uint32 magic (kMagic)
+ *   uint32 number of rows
+ *   uint32 number of feature columns
+ *   int32[rows] obstacle id
+ *   float64[rows] timestamp
+ *   int32[rows] lane sequence id
+ *   int32[rows] label
+ *   float32[rows] for each feature column
+ * A row group only holds rows with the same number of features, a row with
+ * another number starts a new group.
+ */
+class ColumnarFeatureWriter {
+ public:
+  static const uint32_t kMagic = 0x47434650;  // "PFCG"
+
+  /**
+   * @brief Constructor
+   * @param file_name The output file.
+   * @param row_group_size The number of rows buffered before a write.
+   */
+  ColumnarFeatureWriter(const std::string& file_name,
+                        const size_t row_group_size);
+
+  /**
+   * @brief Destructor, writes the buffered rows
+   */
+  ~ColumnarFeatureWriter();
+
+  bool is_open() const { return output_.is_open(); }
+
+  /**
+   * @brief Add the lane sequences of a feature which have model features
+   * @param feature The evaluated feature.
+   */
+  void AddFeature(const Feature& feature);
+
+  /**
+   * @brief Write the buffered rows as one row group
+   */
+  void Flush();
+
+  size_t num_rows() const { return num_rows_; }
+
+ private:
+  template <typename T>
+  void WriteColumn(const std::vector<T>& column);
+
+ private:
+  std::ofstream output_;
+
+  size_t row_group_size_ = 0;
+
+  // number of rows written, including the buffered ones
+  size_t num_rows_ = 0;
+
+  int num_feature_columns_ = 0;
+
+  std::vector<int32_t> obstacle_ids_;
+  std::vector<double> timestamps_;
+  std::vector<int32_t> lane_sequence_ids_;
+  std::vector<int32_t> labels_;
+  // row major values, transposed when written
+  std::vector<float> values_;
+  std::vector<float> column_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/util/columnar_feature_writer.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+void AddLaneSequence(const int id, const int num_values, Feature* feature) {
+  LaneSequence* lane_sequence =
+      feature->mutable_lane()->mutable_lane_graph()->add_lane_sequence();
+  lane_sequence->set_lane_sequence_id(id);
+  lane_sequence->set_label(id % 2);
+  for (int i = 0; i < num_values; ++i) {
+    lane_sequence->mutable_features()->add_mlp_features(id + 0.5 * i);
+  }
+}
+
+template <typename T>
+std::vector<T> ReadColumn(const size_t num_rows, std::ifstream* input) {
+  std::vector<T> column(num_rows);
+  input->read(reinterpret_cast<char*>(column.data()), num_rows * sizeof(T));
+  return column;
+}
+
+}  // namespace
+
+TEST(ColumnarFeatureWriterTest, RowGroups) {
+  const std::string file_name = "/tmp/columnar_feature_writer_test.bin";
+  {
+    ColumnarFeatureWriter writer(file_name, 2);
+    ASSERT_TRUE(writer.is_open());
+    Feature feature;
+    feature.set_id(7);
+    feature.set_timestamp(1.5);
+    AddLaneSequence(0, 3, &feature);
+    AddLaneSequence(1, 3, &feature);
+    AddLaneSequence(2, 0, &feature);
+    AddLaneSequence(3, 3, &feature);
+    AddLaneSequence(4, 2, &feature);
+    writer.AddFeature(feature);
+    EXPECT_EQ(4, writer.num_rows());
+  }
+
+  std::ifstream input(file_name, std::ios::binary);
+  ASSERT_TRUE(input.is_open());
+  // the rows with three values fill one group and a half, then the row with
+  // two values starts its own group
+  const std::vector<uint32_t> expected_rows = {2, 1, 1};
+  const std::vector<uint32_t> expected_columns = {3, 3, 2};
+  const std::vector<int32_t> expected_ids = {0, 1, 3, 4};
+  size_t row = 0;
+  for (size_t group = 0; group < expected_rows.size(); ++group) {
+    uint32_t header[3];
+    input.read(reinterpret_cast<char*>(header), sizeof(header));
+    ASSERT_TRUE(input.good());
+    EXPECT_EQ(ColumnarFeatureWriter::kMagic, header[0]);
+    ASSERT_EQ(expected_rows[group], header[1]);
+    ASSERT_EQ(expected_columns[group], header[2]);
+    const size_t num_rows = header[1];
+    const auto obstacle_ids = ReadColumn<int32_t>(num_rows, &input);
+    const auto timestamps = ReadColumn<double>(num_rows, &input);
+    const auto lane_sequence_ids = ReadColumn<int32_t>(num_rows, &input);
+    const auto labels = ReadColumn<int32_t>(num_rows, &input);
+    std::vector<std::vector<float>> columns;
+    for (uint32_t c = 0; c < header[2]; ++c) {
+      columns.push_back(ReadColumn<float>(num_rows, &input));
+    }
+    for (size_t r = 0; r < num_rows; ++r, ++row) {
+      const int id = expected_ids[row];
+      EXPECT_EQ(7, obstacle_ids[r]);
+      EXPECT_DOUBLE_EQ(1.5, timestamps[r]);
+      EXPECT_EQ(id, lane_sequence_ids[r]);
+      EXPECT_EQ(id % 2, labels[r]);
+      for (uint32_t c = 0; c < header[2]; ++c) {
+        EXPECT_FLOAT_EQ(id + 0.5f * c, columns[c][r]);
+      }
+    }
+  }
+  EXPECT_EQ(expected_ids.size(), row);
+  input.peek();
+  EXPECT_TRUE(input.eof());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -43,5 +43,25 @@ void GetDataFileNames(const boost::filesystem::path& p,
   }
 }
 
+void GetFeatureFileNames(const boost::filesystem::path& p,
+                         std::vector<std::string>* feature_files) {
+  CHECK(feature_files);
+  if (!boost::filesystem::exists(p)) {
+    return;
+  }
+  if (boost::filesystem::is_regular_file(p)) {
+    if (p.extension() == ".bin") {
+      feature_files->push_back(p.c_str());
+    }
+    return;
+  }
+  if (boost::filesystem::is_directory(p)) {
+    for (auto& entry : boost::make_iterator_range(
+             boost::filesystem::directory_iterator(p), {})) {
+      GetFeatureFileNames(entry.path(), feature_files);
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -28,5 +28,8 @@ namespace prediction {
 void GetDataFileNames(const boost::filesystem::path& p,
                       std::vector<std::string>* data_files);
 
+void GetFeatureFileNames(const boost::filesystem::path& p,
+                         std::vector<std::string>* feature_files);
+
 }  // namespace prediction
 }  // namespace apollo
@@ -32,3 +32,14 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 3000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_int32(routing_landmark_num, 0,
+             "number of landmarks the topo creator precomputes the routing "
+             "costs from and to, for the landmark search heuristic");
+
+DEFINE_bool(enable_routing_landmark_heuristic, false,
+            "estimate the remaining routing cost from the landmark costs of "
+            "the topo graph when it has them");
+
+DEFINE_int32(route_matrix_thread_num, 4,
+             "number of threads computing the rows of a route cost matrix");
@@ -0,0 +1,221 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/core/route_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "modules/routing/common/routing_gflags.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// the cost of a move as accumulated by the routing search
+double GetMoveCost(const TopoEdge* edge) {
+  double cost = edge->Cost() + edge->ToNode()->Cost();
+  if (edge->Type() != TopoEdgeType::TET_FORWARD) {
+    cost -= (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2.0;
+  }
+  return std::max(cost, 0.0);
+}
+
+}  // namespace
+
+RouteMatrix::RouteMatrix(const TopoGraph* graph) : graph_(graph) {
+  CHECK_NOTNULL(graph_);
+  graph_->GetAllNodes(&nodes_);
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    node_indices_[nodes_[i]] = static_cast<int>(i);
+  }
+  move_begins_.reserve(nodes_.size() + 1);
+  for (const auto* node : nodes_) {
+    move_begins_.push_back(static_cast<int>(move_to_nodes_.size()));
+    for (const auto* edge : node->OutToAllEdge()) {
+      const auto iter = node_indices_.find(edge->ToNode());
+      if (iter == node_indices_.end()) {
+        continue;
+      }
+      move_to_nodes_.push_back(iter->second);
+      move_costs_.push_back(GetMoveCost(edge));
+    }
+  }
+  move_begins_.push_back(static_cast<int>(move_to_nodes_.size()));
+}
+
+bool RouteMatrix::ToWaypoint(const LaneWaypoint& lane_waypoint,
+                             Waypoint* const waypoint) const {
+  const auto* node = graph_->GetNode(lane_waypoint.id());
+  if (node == nullptr) {
+    AERROR << "Lane " << lane_waypoint.id() << " is not in the topo graph";
+    return false;
+  }
+  waypoint->node_index = node_indices_.at(node);
+  waypoint->fraction =
+      std::min(std::max(lane_waypoint.s() / node->Length(), 0.0), 1.0);
+  return true;
+}
+
+bool RouteMatrix::ComputeCosts(const std::vector<LaneWaypoint>& origins,
+                               const std::vector<LaneWaypoint>& destinations,
+                               std::vector<double>* const costs) const {
+  CHECK_NOTNULL(costs);
+  std::vector<Waypoint> origin_waypoints(origins.size());
+  for (size_t i = 0; i < origins.size(); ++i) {
+    if (!ToWaypoint(origins[i], &origin_waypoints[i])) {
+      return false;
+    }
+  }
+  std::vector<Waypoint> destination_waypoints(destinations.size());
+  std::vector<int> destination_counts(nodes_.size(), 0);
+  for (size_t i = 0; i < destinations.size(); ++i) {
+    if (!ToWaypoint(destinations[i], &destination_waypoints[i])) {
+      return false;
+    }
+    ++destination_counts[destination_waypoints[i].node_index];
+  }
+  costs->assign(origins.size() * destinations.size(), -1.0);
+  if (costs->empty()) {
+    return true;
+  }
+
+  std::atomic<size_t> next_origin(0);
+  const auto compute_rows = [&]() {
+    SearchState state;
+    state.costs.assign(nodes_.size(), kInfinity);
+    for (size_t i = next_origin++; i < origins.size(); i = next_origin++) {
+      ComputeRow(origin_waypoints[i], destination_waypoints,
+                 destination_counts, &state,
+                 costs->data() + i * destinations.size());
+    }
+  };
+  const size_t thread_num = std::min(
+      origins.size(),
+      static_cast<size_t>(std::max(FLAGS_route_matrix_thread_num, 1)));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(compute_rows);
+  }
+  compute_rows();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return true;
+}
+
+void RouteMatrix::ComputeRow(const Waypoint& origin,
+                             const std::vector<Waypoint>& destinations,
+                             const std::vector<int>& destination_counts,
+                             SearchState* const state,
+                             double* const row) const {
+  // the cost to the end of every node, from the origin
+  auto& costs = state->costs;
+  for (const int index : state->visited_nodes) {
+    costs[index] = kInfinity;
+  }
+  state->visited_nodes.clear();
+
+  const double origin_cost = nodes_[origin.node_index]->Cost();
+  // the cost to come back to the start of the origin lane
+  double reentry_cost = kInfinity;
+  // the destinations on other lanes than the origin are final once the
+  // search reaches their lanes
+  size_t unsettled_destinations = 0;
+  for (const auto& destination : destinations) {
+    if (destination.node_index != origin.node_index) {
+      ++unsettled_destinations;
+    }
+  }
+  bool need_reentry = std::any_of(
+      destinations.begin(), destinations.end(),
+      [&origin](const Waypoint& destination) {
+        return destination.node_index == origin.node_index &&
+               destination.fraction < origin.fraction;
+      });
+
+  using QueueItem = std::pair<double, int>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      queue;
+  costs[origin.node_index] = origin_cost * (1.0 - origin.fraction);
+  state->visited_nodes.push_back(origin.node_index);
+  queue.emplace(costs[origin.node_index], origin.node_index);
+  while (!queue.empty()) {
+    const QueueItem item = queue.top();
+    queue.pop();
+    if (item.first > costs[item.second]) {
+      continue;
+    }
+    // no move is negative, so no later node comes back to the origin lane
+    // for less
+    if (need_reentry && item.first - origin_cost >= reentry_cost) {
+      need_reentry = false;
+    }
+    if (item.second != origin.node_index) {
+      unsettled_destinations -= destination_counts[item.second];
+    }
+    if (unsettled_destinations == 0 && !need_reentry) {
+      break;
+    }
+    for (int m = move_begins_[item.second]; m < move_begins_[item.second + 1];
+         ++m) {
+      const int to_node = move_to_nodes_[m];
+      const double cost = item.first + move_costs_[m];
+      if (to_node == origin.node_index) {
+        reentry_cost = std::min(reentry_cost, cost - origin_cost);
+        continue;
+      }
+      if (cost < costs[to_node]) {
+        if (costs[to_node] == kInfinity) {
+          state->visited_nodes.push_back(to_node);
+        }
+        costs[to_node] = cost;
+        queue.emplace(cost, to_node);
+      }
+    }
+  }
+
+  for (size_t j = 0; j < destinations.size(); ++j) {
+    const auto& destination = destinations[j];
+    const double node_cost = nodes_[destination.node_index]->Cost();
+    double cost = kInfinity;
+    if (destination.node_index == origin.node_index) {
+      if (destination.fraction >= origin.fraction) {
+        cost = node_cost * (destination.fraction - origin.fraction);
+      } else {
+        cost = reentry_cost + node_cost * destination.fraction;
+      }
+    } else {
+      // the cost to the start of the destination lane, then along it
+      cost = costs[destination.node_index] -
+             node_cost * (1.0 - destination.fraction);
+    }
+    row[j] = cost < kInfinity ? std::max(cost, 0.0) : -1.0;
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/proto/routing.pb.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class RouteMatrix
+ *
+ * @brief Computes the routing costs between many origins and destinations,
+ * e.g. for the travel time estimates of dispatching. Every origin is
+ * searched once for all the destinations, and the origins are shared among
+ * worker threads reading the same graph.
+ *
+ * The costs are those minimized by the routing search. Lane changes are
+ * costed as in the search but their minimum lengths are not checked, and
+ * black lists are not supported.
+ */
+class RouteMatrix {
+ public:
+  /**
+   * @param graph the graph, which must outlive the matrix and not change
+   */
+  explicit RouteMatrix(const TopoGraph* graph);
+
+  /**
+   * @brief compute the routing costs from every origin to every destination
+   * @param origins the origins, of which the lane and s are used
+   * @param destinations the destinations, of which the lane and s are used
+   * @param costs the cost from origin i to destination j at
+   *        i * destinations.size() + j, negative when it is unreachable
+   * @return false if a waypoint is not on a lane of the graph
+   */
+  bool ComputeCosts(const std::vector<LaneWaypoint>& origins,
+                    const std::vector<LaneWaypoint>& destinations,
+                    std::vector<double>* const costs) const;
+
+ private:
+  struct Waypoint {
+    int node_index = 0;
+    // the fraction of the lane before the waypoint
+    double fraction = 0.0;
+  };
+
+  bool ToWaypoint(const LaneWaypoint& lane_waypoint,
+                  Waypoint* const waypoint) const;
+
+  // the search state of a thread, reused for its origins
+  struct SearchState {
+    std::vector<double> costs;
+    std::vector<int> visited_nodes;
+  };
+
+  /**
+   * @brief compute the costs from an origin to all the destinations
+   * @param destination_counts the number of destinations on every node
+   */
+  void ComputeRow(const Waypoint& origin,
+                  const std::vector<Waypoint>& destinations,
+                  const std::vector<int>& destination_counts,
+                  SearchState* const state, double* const row) const;
+
+ private:
+  const TopoGraph* graph_ = nullptr;
+  std::vector<const TopoNode*> nodes_;
+  std::unordered_map<const TopoNode*, int> node_indices_;
+  // the moves out of node i are [move_begins_[i], move_begins_[i + 1])
+  std::vector<int> move_begins_;
+  std::vector<int> move_to_nodes_;
+  std::vector<double> move_costs_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,98 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/core/route_matrix.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/routing/common/routing_gflags.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+void AddNode(const std::string& lane_id, const double cost, Graph* graph) {
+  auto* node = graph->add_node();
+  node->set_lane_id(lane_id);
+  node->set_length(100.0);
+  node->set_cost(cost);
+}
+
+void AddEdge(const std::string& from, const std::string& to,
+             const Edge::DirectionType type, const double cost,
+             Graph* graph) {
+  auto* edge = graph->add_edge();
+  edge->set_from_lane_id(from);
+  edge->set_to_lane_id(to);
+  edge->set_direction_type(type);
+  edge->set_cost(cost);
+}
+
+LaneWaypoint MakeWaypoint(const std::string& lane_id, const double s) {
+  LaneWaypoint waypoint;
+  waypoint.set_id(lane_id);
+  waypoint.set_s(s);
+  return waypoint;
+}
+
+}  // namespace
+
+TEST(RouteMatrixTest, ComputeCosts) {
+  Graph graph_proto;
+  AddNode("L1", 10.0, &graph_proto);
+  AddNode("L2", 20.0, &graph_proto);
+  AddNode("L3", 30.0, &graph_proto);
+  AddNode("R1", 12.0, &graph_proto);
+  AddEdge("L1", "L2", Edge::FORWARD, 0.0, &graph_proto);
+  AddEdge("L2", "L3", Edge::FORWARD, 0.0, &graph_proto);
+  AddEdge("L1", "R1", Edge::LEFT, 5.0, &graph_proto);
+  TopoGraph graph;
+  ASSERT_TRUE(graph.LoadGraph(graph_proto));
+
+  const std::vector<LaneWaypoint> origins = {MakeWaypoint("L1", 50.0),
+                                             MakeWaypoint("L3", 0.0)};
+  const std::vector<LaneWaypoint> destinations = {
+      MakeWaypoint("L3", 50.0), MakeWaypoint("R1", 100.0),
+      MakeWaypoint("L1", 80.0), MakeWaypoint("L1", 0.0)};
+  for (const int thread_num : {1, 4}) {
+    FLAGS_route_matrix_thread_num = thread_num;
+    RouteMatrix route_matrix(&graph);
+    std::vector<double> costs;
+    ASSERT_TRUE(route_matrix.ComputeCosts(origins, destinations, &costs));
+    ASSERT_EQ(origins.size() * destinations.size(), costs.size());
+    // half of L1, L2, then half of L3
+    EXPECT_DOUBLE_EQ(40.0, costs[0]);
+    // half of L1, then the lane change to R1, costed as in the search
+    EXPECT_DOUBLE_EQ(5.0 + 5.0 + 12.0 - (10.0 + 12.0) / 2.0, costs[1]);
+    EXPECT_DOUBLE_EQ(3.0, costs[2]);
+    // there is no way back to the start of L1
+    EXPECT_DOUBLE_EQ(-1.0, costs[3]);
+    EXPECT_DOUBLE_EQ(15.0, costs[4]);
+    EXPECT_DOUBLE_EQ(-1.0, costs[5]);
+  }
+
+  RouteMatrix route_matrix(&graph);
+  std::vector<double> costs;
+  EXPECT_FALSE(route_matrix.ComputeCosts({MakeWaypoint("X", 0.0)},
+                                         destinations, &costs));
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -105,5 +105,13 @@ void TopoGraph::GetNodesByRoadId(
   }
 }
 
+void TopoGraph::GetAllNodes(std::vector<const TopoNode*>* const nodes) const {
+  nodes->clear();
+  nodes->reserve(topo_nodes_.size());
+  for (const auto& node : topo_nodes_) {
+    nodes->push_back(node.get());
+  }
+}
+
 }  // namespace routing
 }  // namespace apollo
@@ -41,6 +41,7 @@ class TopoGraph {
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
+  void GetAllNodes(std::vector<const TopoNode*>* const nodes) const;
 
  private:
   void Clear();
@@ -213,6 +213,9 @@ void AStarStrategy::Clear() {
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (use_landmark_heuristic_) {
+    return LandmarkHeuristicCost(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = fabs(src_point.x() - dest_point.x()) +
@@ -220,12 +223,38 @@ double AStarStrategy::HeuristicCost(const TopoNode* src_node,
   return distance;
 }
 
+double AStarStrategy::LandmarkHeuristicCost(const TopoNode* src_node,
+                                            const TopoNode* dest_node) {
+  const auto& src = src_node->OriginNode()->PbNode();
+  const auto& dest = dest_node->OriginNode()->PbNode();
+  double cost = 0.0;
+  for (int i = 0; i < src.cost_from_landmark_size(); ++i) {
+    // cost(landmark, dest) <= cost(landmark, src) + cost(src, dest)
+    if (src.cost_from_landmark(i) >= 0.0 && dest.cost_from_landmark(i) >= 0.0) {
+      cost = std::max(cost,
+                      dest.cost_from_landmark(i) - src.cost_from_landmark(i));
+    }
+    // cost(src, landmark) <= cost(src, dest) + cost(dest, landmark)
+    if (src.cost_to_landmark(i) >= 0.0 && dest.cost_to_landmark(i) >= 0.0) {
+      cost = std::max(cost, src.cost_to_landmark(i) - dest.cost_to_landmark(i));
+    }
+  }
+  return cost;
+}
+
 bool AStarStrategy::Search(const TopoGraph* graph,
                            const SubTopoGraph* sub_graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
   Clear();
   AINFO << "Start A* search algorithm.";
+  const auto& src_pb_node = src_node->OriginNode()->PbNode();
+  const auto& dest_pb_node = dest_node->OriginNode()->PbNode();
+  use_landmark_heuristic_ =
+      FLAGS_enable_routing_landmark_heuristic &&
+      src_pb_node.cost_from_landmark_size() > 0 &&
+      src_pb_node.cost_from_landmark_size() ==
+          dest_pb_node.cost_from_landmark_size();
 
   std::priority_queue<SearchNode> open_set_detail;
 
@@ -289,8 +318,10 @@ bool AStarStrategy::Search(const TopoGraph* graph,
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
       double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 &&
-          f >= g_score_[to_node]) {
+      // the landmark heuristic is consistent, so the nodes are kept with
+      // their costs from the source rather than with their estimates
+      const double score = use_landmark_heuristic_ ? tentative_g_score : f;
+      if (open_set_.count(to_node) != 0 && score >= g_score_[to_node]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
@@ -310,7 +341,7 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         enter_s_[to_node] = to_node_enter_s;
       }
 
-      g_score_[to_node] = f;
+      g_score_[to_node] = score;
       SearchNode next_node(to_node);
       next_node.f = f;
       open_set_detail.push(next_node);
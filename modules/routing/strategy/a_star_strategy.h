@@ -37,11 +37,16 @@ class AStarStrategy : public Strategy {
  private:
   void Clear();
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
+  // the lower bound of the cost from a node to another by the triangle
+  // inequality with the landmark costs of their lanes
+  double LandmarkHeuristicCost(const TopoNode* src_node,
+                               const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
  private:
   bool change_lane_enabled_;
+  bool use_landmark_heuristic_ = false;
   std::unordered_set<const TopoNode*> open_set_;
   std::unordered_set<const TopoNode*> closed_set_;
   std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
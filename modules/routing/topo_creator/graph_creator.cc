@@ -16,14 +16,19 @@
 
 #include "modules/routing/topo_creator/graph_creator.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
 #include <vector>
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/file.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/topo_creator/edge_creator.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
 namespace apollo {
@@ -96,6 +101,7 @@ bool GraphCreator::Create() {
   const double min_turn_radius =
       VehicleConfigHelper::GetConfig().vehicle_param().min_turn_radius();
 
+  std::vector<const hdmap::Lane*> node_lanes;
   for (const auto& lane : pbmap_.lane()) {
     const auto& lane_id = lane.id().id();
     if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
@@ -110,15 +116,10 @@ bool GraphCreator::Create() {
     }
     AINFO << "Current lane id: " << lane_id;
     node_index_map_[lane_id] = graph_.node_size();
-    const auto iter = road_id_map_.find(lane_id);
-    if (iter != road_id_map_.end()) {
-      node_creator::GetPbNode(lane, iter->second, routing_conf_,
-                              graph_.add_node());
-    } else {
-      AWARN << "Failed to find road id of lane " << lane_id;
-      node_creator::GetPbNode(lane, "", routing_conf_, graph_.add_node());
-    }
+    graph_.add_node();
+    node_lanes.push_back(&lane);
   }
+  CreateNodes(node_lanes);
 
   std::string edge_id = "";
   for (const auto& lane : pbmap_.lane()) {
@@ -143,6 +144,10 @@ bool GraphCreator::Create() {
     }
   }
 
+  if (FLAGS_routing_landmark_num > 0) {
+    landmark_creator::AddLandmarks(FLAGS_routing_landmark_num, &graph_);
+  }
+
   if (!EndWith(dump_topo_file_path_, ".bin") &&
       !EndWith(dump_topo_file_path_, ".txt")) {
     AERROR << "Failed to dump topo data into file, incorrect file type "
@@ -165,6 +170,40 @@ bool GraphCreator::Create() {
   return true;
 }
 
+void GraphCreator::CreateNodes(const std::vector<const hdmap::Lane*>& lanes) {
+  // every node only depends on its own lane, so the nodes are created on all
+  // the cores with use_parallel_map_compiling
+  const int num_nodes = static_cast<int>(lanes.size());
+  const int num_workers =
+      FLAGS_use_parallel_map_compiling
+          ? std::max(1, std::min(static_cast<int>(
+                                     std::thread::hardware_concurrency()),
+                                 num_nodes))
+          : 1;
+  auto create_nodes = [this, &lanes, num_workers, num_nodes](const int worker) {
+    for (int i = worker; i < num_nodes; i += num_workers) {
+      const auto& lane = *lanes[i];
+      const auto iter = road_id_map_.find(lane.id().id());
+      if (iter != road_id_map_.end()) {
+        node_creator::GetPbNode(lane, iter->second, routing_conf_,
+                                graph_.mutable_node(i));
+      } else {
+        AWARN << "Failed to find road id of lane " << lane.id().id();
+        node_creator::GetPbNode(lane, "", routing_conf_,
+                                graph_.mutable_node(i));
+      }
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (int worker = 1; worker < num_workers; ++worker) {
+    futures.push_back(std::async(std::launch::async, create_nodes, worker));
+  }
+  create_nodes(0);
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
 std::string GraphCreator::GetEdgeID(const std::string& from_id,
                                     const std::string& to_id) {
   return from_id + "->" + to_id;
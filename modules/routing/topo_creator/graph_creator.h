@@ -19,6 +19,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "modules/map/proto/map.pb.h"
 #include "modules/routing/proto/routing_config.pb.h"
@@ -39,6 +40,7 @@ class GraphCreator {
 
  private:
   void InitForbiddenLanes();
+  void CreateNodes(const std::vector<const hdmap::Lane*>& lanes);
   std::string GetEdgeID(const std::string& from_id, const std::string& to_id);
 
   void AddEdge(
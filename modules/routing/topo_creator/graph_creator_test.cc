@@ -14,12 +14,19 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "modules/common/configs/config_gflags.h"
+
 #define private public
 #include "modules/routing/topo_creator/graph_creator.h"
 
 using apollo::hdmap::Lane;
+using apollo::routing::Graph;
+using apollo::routing::RoutingConfig;
 using apollo::routing::GraphCreator;
 
 TEST(GraphCreatorTest, IsValidUTurn) {
@@ -77,3 +84,32 @@ TEST(GraphCreatorTest, IsValidUTurn) {
     EXPECT_TRUE(GraphCreator::IsValidUTurn(lane, min_turn_radius));
   }
 }
+
+TEST(GraphCreatorTest, CreateNodes) {
+  RoutingConfig routing_conf;
+  routing_conf.set_base_speed(4.167);
+  std::vector<Graph> graphs;
+  for (const bool parallel : {false, true}) {
+    FLAGS_use_parallel_map_compiling = parallel;
+    GraphCreator creator("", "", routing_conf);
+    std::vector<const Lane*> lanes;
+    for (int i = 0; i < 100; ++i) {
+      auto* lane = creator.pbmap_.add_lane();
+      lane->mutable_id()->set_id("lane" + std::to_string(i));
+      lane->set_length(10.0 + i);
+      lane->set_speed_limit(5.0 + i % 10);
+      creator.road_id_map_[lane->id().id()] = "road" + std::to_string(i / 3);
+      creator.graph_.add_node();
+    }
+    for (const auto& lane : creator.pbmap_.lane()) {
+      lanes.push_back(&lane);
+    }
+    creator.CreateNodes(lanes);
+    graphs.push_back(creator.graph_);
+  }
+  FLAGS_use_parallel_map_compiling = false;
+  ASSERT_EQ(100, graphs[1].node_size());
+  EXPECT_EQ("lane42", graphs[1].node(42).lane_id());
+  EXPECT_EQ("road14", graphs[1].node(42).road_id());
+  EXPECT_EQ(graphs[0].SerializeAsString(), graphs[1].SerializeAsString());
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+struct Move {
+  int node_index;
+  double cost;
+};
+
+// the moves out of every node, or into every node for a reversed graph
+using Adjacency = std::vector<std::vector<Move>>;
+
+void BuildAdjacency(const Graph& graph, Adjacency* const forward,
+                    Adjacency* const backward) {
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+  }
+  forward->assign(graph.node_size(), {});
+  backward->assign(graph.node_size(), {});
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      continue;
+    }
+    const double cost =
+        GetMoveCost(graph.node(from_iter->second), graph.node(to_iter->second),
+                    edge);
+    (*forward)[from_iter->second].push_back({to_iter->second, cost});
+    (*backward)[to_iter->second].push_back({from_iter->second, cost});
+  }
+}
+
+std::vector<double> ComputeCosts(const Adjacency& adjacency, const int source) {
+  std::vector<double> costs(adjacency.size(), kInfinity);
+  using QueueItem = std::pair<double, int>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      queue;
+  costs[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty()) {
+    const QueueItem item = queue.top();
+    queue.pop();
+    if (item.first > costs[item.second]) {
+      continue;
+    }
+    for (const auto& move : adjacency[item.second]) {
+      const double cost = item.first + move.cost;
+      if (cost < costs[move.node_index]) {
+        costs[move.node_index] = cost;
+        queue.emplace(cost, move.node_index);
+      }
+    }
+  }
+  return costs;
+}
+
+}  // namespace
+
+double GetMoveCost(const Node& from_node, const Node& to_node,
+                   const Edge& edge) {
+  double cost = edge.cost() + to_node.cost();
+  if (edge.direction_type() != Edge::FORWARD) {
+    cost -= (from_node.cost() + to_node.cost()) / 2.0;
+  }
+  // the landmark costs bound the search costs from below only without
+  // negative moves
+  return std::max(cost, 0.0);
+}
+
+void AddLandmarks(const int num_landmarks, Graph* const graph) {
+  CHECK_NOTNULL(graph);
+  graph->clear_landmark_lane_id();
+  for (auto& node : *graph->mutable_node()) {
+    node.clear_cost_from_landmark();
+    node.clear_cost_to_landmark();
+  }
+  if (num_landmarks <= 0 || graph->node_size() == 0) {
+    return;
+  }
+  Adjacency forward;
+  Adjacency backward;
+  BuildAdjacency(*graph, &forward, &backward);
+
+  // Every landmark is the node the farthest from the previous ones, by the
+  // cost from or to them whichever is lower, so that the landmarks surround
+  // the graph. Nodes disconnected from all the landmarks are taken first.
+  std::vector<double> min_costs(graph->node_size(), kInfinity);
+  {
+    const auto costs_from_seed = ComputeCosts(forward, 0);
+    const auto costs_to_seed = ComputeCosts(backward, 0);
+    for (int i = 0; i < graph->node_size(); ++i) {
+      min_costs[i] = std::min(costs_from_seed[i], costs_to_seed[i]);
+    }
+  }
+  const int landmark_num = std::min(num_landmarks, graph->node_size());
+  for (int k = 0; k < landmark_num; ++k) {
+    const int landmark = static_cast<int>(
+        std::max_element(min_costs.begin(), min_costs.end()) -
+        min_costs.begin());
+    const auto costs_from_landmark = ComputeCosts(forward, landmark);
+    const auto costs_to_landmark = ComputeCosts(backward, landmark);
+    graph->add_landmark_lane_id(graph->node(landmark).lane_id());
+    for (int i = 0; i < graph->node_size(); ++i) {
+      auto* node = graph->mutable_node(i);
+      node->add_cost_from_landmark(costs_from_landmark[i] < kInfinity
+                                       ? costs_from_landmark[i]
+                                       : -1.0);
+      node->add_cost_to_landmark(
+          costs_to_landmark[i] < kInfinity ? costs_to_landmark[i] : -1.0);
+      min_costs[i] = std::min(
+          min_costs[i],
+          std::min(costs_from_landmark[i], costs_to_landmark[i]));
+    }
+    // never select a landmark twice
+    min_costs[landmark] = -1.0;
+  }
+  AINFO << "Added " << landmark_num << " routing landmarks.";
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
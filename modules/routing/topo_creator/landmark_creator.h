@@ -0,0 +1,45 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+/**
+ * @brief the routing cost of a move along an edge, as accumulated by the
+ * routing search: the cost of the edge and of the node it enters, less half
+ * of the costs of the nodes of a lane change
+ */
+double GetMoveCost(const Node& from_node, const Node& to_node,
+                   const Edge& edge);
+
+/**
+ * @brief select landmarks spread over the graph and record the routing costs
+ * of every node from and to them
+ * @param num_landmarks the number of landmarks, at most the number of nodes
+ * @param graph the graph, of which existing landmarks are replaced
+ */
+void AddLandmarks(const int num_landmarks, Graph* const graph);
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
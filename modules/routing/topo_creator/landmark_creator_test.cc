@@ -0,0 +1,136 @@
+/******************************************************************************
+  * Copyright 2019 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+namespace {
+
+void AddNode(const std::string& lane_id, const double cost, Graph* graph) {
+  auto* node = graph->add_node();
+  node->set_lane_id(lane_id);
+  node->set_length(100.0);
+  node->set_cost(cost);
+}
+
+void AddEdge(const int from, const int to, const Edge::DirectionType type,
+             const double cost, Graph* graph) {
+  auto* edge = graph->add_edge();
+  edge->set_from_lane_id(graph->node(from).lane_id());
+  edge->set_to_lane_id(graph->node(to).lane_id());
+  edge->set_direction_type(type);
+  edge->set_cost(cost);
+}
+
+}  // namespace
+
+TEST(LandmarkCreatorTest, AddLandmarks) {
+  // two parallel roads of three lanes, with lane changes between them, and
+  // an isolated lane
+  Graph graph;
+  AddNode("L1", 10.0, &graph);
+  AddNode("L2", 20.0, &graph);
+  AddNode("L3", 15.0, &graph);
+  AddNode("R1", 12.0, &graph);
+  AddNode("R2", 18.0, &graph);
+  AddNode("R3", 30.0, &graph);
+  AddNode("X", 5.0, &graph);
+  AddEdge(0, 1, Edge::FORWARD, 0.0, &graph);
+  AddEdge(1, 2, Edge::FORWARD, 0.0, &graph);
+  AddEdge(3, 4, Edge::FORWARD, 0.0, &graph);
+  AddEdge(4, 5, Edge::FORWARD, 0.0, &graph);
+  AddEdge(5, 0, Edge::FORWARD, 0.0, &graph);
+  AddEdge(0, 3, Edge::RIGHT, 50.0, &graph);
+  AddEdge(4, 1, Edge::LEFT, 50.0, &graph);
+
+  AddLandmarks(3, &graph);
+  ASSERT_EQ(3, graph.landmark_lane_id_size());
+  EXPECT_EQ("X", graph.landmark_lane_id(0));
+  for (const auto& node : graph.node()) {
+    EXPECT_EQ(3, node.cost_from_landmark_size());
+    EXPECT_EQ(3, node.cost_to_landmark_size());
+  }
+
+  // the costs between all the nodes
+  const int size = graph.node_size();
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  std::vector<std::vector<double>> costs(size,
+                                         std::vector<double>(size, kInfinity));
+  for (int i = 0; i < size; ++i) {
+    costs[i][i] = 0.0;
+  }
+  for (const auto& edge : graph.edge()) {
+    int from = 0;
+    int to = 0;
+    for (int i = 0; i < size; ++i) {
+      if (graph.node(i).lane_id() == edge.from_lane_id()) {
+        from = i;
+      }
+      if (graph.node(i).lane_id() == edge.to_lane_id()) {
+        to = i;
+      }
+    }
+    costs[from][to] =
+        std::min(costs[from][to],
+                 GetMoveCost(graph.node(from), graph.node(to), edge));
+  }
+  for (int k = 0; k < size; ++k) {
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j < size; ++j) {
+        costs[i][j] = std::min(costs[i][j], costs[i][k] + costs[k][j]);
+      }
+    }
+  }
+
+  for (int k = 0; k < graph.landmark_lane_id_size(); ++k) {
+    int landmark = 0;
+    while (graph.node(landmark).lane_id() != graph.landmark_lane_id(k)) {
+      ++landmark;
+    }
+    for (int i = 0; i < size; ++i) {
+      const auto& node = graph.node(i);
+      if (costs[landmark][i] < kInfinity) {
+        EXPECT_DOUBLE_EQ(costs[landmark][i], node.cost_from_landmark(k));
+      } else {
+        EXPECT_DOUBLE_EQ(-1.0, node.cost_from_landmark(k));
+      }
+      if (costs[i][landmark] < kInfinity) {
+        EXPECT_DOUBLE_EQ(costs[i][landmark], node.cost_to_landmark(k));
+      } else {
+        EXPECT_DOUBLE_EQ(-1.0, node.cost_to_landmark(k));
+      }
+    }
+  }
+
+  // more landmarks than nodes
+  AddLandmarks(20, &graph);
+  EXPECT_EQ(size, graph.landmark_lane_id_size());
+  EXPECT_EQ(size, graph.node(0).cost_from_landmark_size());
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
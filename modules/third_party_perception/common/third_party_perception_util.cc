@@ -55,14 +55,14 @@ void FillPerceptionPolygon(PerceptionObstacle* const perception_obstacle,
   // viewed from top
   const int sign_l[4] = {1, 1, -1, -1};
   const int sign_w[4] = {1, -1, -1, 1};
+  const double cos_heading = std::cos(heading);
+  const double sin_heading = std::sin(heading);
   for (int i = 0; i < 4; ++i) {
-    perception_obstacle->add_polygon_point();
-    perception_obstacle->mutable_polygon_point(i)->set_x(
-        mid_x + sign_l[i] * length * std::cos(heading) / 2.0 +
-        sign_w[i] * width * std::sin(heading) / 2.0);
-    perception_obstacle->mutable_polygon_point(i)->set_y(
-        mid_y + sign_l[i] * length * std::sin(heading) / 2.0 -
-        sign_w[i] * width * std::cos(heading) / 2.0);
+    auto* polygon_point = perception_obstacle->add_polygon_point();
+    polygon_point->set_x(mid_x + sign_l[i] * length * cos_heading / 2.0 +
+                         sign_w[i] * width * sin_heading / 2.0);
+    polygon_point->set_y(mid_y + sign_l[i] * length * sin_heading / 2.0 -
+                         sign_w[i] * width * cos_heading / 2.0);
   }
 }
 
@@ -18,6 +18,8 @@
  * @file
  */
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 
@@ -57,6 +59,17 @@ PerceptionObstacles MobileyeToPerceptionObstacles(
     const Mobileye& mobileye, const LocalizationEstimate& localization,
     const Chassis& chassis) {
   PerceptionObstacles obstacles;
+  MobileyeToPerceptionObstacles(mobileye, localization, chassis, &obstacles);
+  return obstacles;
+}
+
+void MobileyeToPerceptionObstacles(const Mobileye& mobileye,
+                                   const LocalizationEstimate& localization,
+                                   const Chassis& chassis,
+                                   PerceptionObstacles* const result) {
+  // cleared obstacles are kept by the repeated field and reused
+  result->Clear();
+  PerceptionObstacles& obstacles = *result;
   // retrieve position and velocity of the main vehicle from the localization
   // position
 
@@ -120,9 +133,27 @@ PerceptionObstacles MobileyeToPerceptionObstacles(
   double adc_vy = localization.pose().linear_velocity().y();
   double adc_velocity = Speed(adc_vx, adc_vy);
 
-  for (int index = 0; index < mobileye.details_738().num_obstacles() &&
-                      index < mobileye.details_739_size();
-       ++index) {
+  // the lane of the better quality marker, the same for every obstacle
+  double path_c1 = 0.0;
+  double path_c2 = 0.0;
+  double path_c3 = 0.0;
+
+  if (obstacles.lane_marker().left_lane_marker().quality() >=
+      obstacles.lane_marker().right_lane_marker().quality()) {
+    path_c1 = obstacles.lane_marker().left_lane_marker().c1_heading_angle();
+    path_c2 = obstacles.lane_marker().left_lane_marker().c2_curvature();
+    path_c3 =
+        obstacles.lane_marker().left_lane_marker().c3_curvature_derivative();
+  } else {
+    path_c1 = obstacles.lane_marker().right_lane_marker().c1_heading_angle();
+    path_c2 = obstacles.lane_marker().right_lane_marker().c2_curvature();
+    path_c3 = obstacles.lane_marker().right_lane_marker().c2_curvature();
+  }
+
+  const int num_obstacles = std::min(mobileye.details_738().num_obstacles(),
+                                     mobileye.details_739_size());
+  obstacles.mutable_perception_obstacle()->Reserve(num_obstacles);
+  for (int index = 0; index < num_obstacles; ++index) {
     auto* mob = obstacles.add_perception_obstacle();
     const auto& data_739 = mobileye.details_739(index);
     int mob_id = data_739.obstacle_id() + FLAGS_mobileye_id_offset;
@@ -164,22 +195,6 @@ PerceptionObstacles MobileyeToPerceptionObstacles(
     double converted_vx = 0.0;
     double converted_vy = 0.0;
 
-    double path_c1 = 0.0;
-    double path_c2 = 0.0;
-    double path_c3 = 0.0;
-
-    if (obstacles.lane_marker().left_lane_marker().quality() >=
-        obstacles.lane_marker().right_lane_marker().quality()) {
-      path_c1 = obstacles.lane_marker().left_lane_marker().c1_heading_angle();
-      path_c2 = obstacles.lane_marker().left_lane_marker().c2_curvature();
-      path_c3 =
-          obstacles.lane_marker().left_lane_marker().c3_curvature_derivative();
-    } else {
-      path_c1 = obstacles.lane_marker().right_lane_marker().c1_heading_angle();
-      path_c2 = obstacles.lane_marker().right_lane_marker().c2_curvature();
-      path_c3 = obstacles.lane_marker().right_lane_marker().c2_curvature();
-    }
-
     if (!FLAGS_use_navigation_mode) {
       converted_x = adc_x + xy_point.x();
       converted_y = adc_y + xy_point.y();
@@ -256,8 +271,6 @@ PerceptionObstacles MobileyeToPerceptionObstacles(
 
     mob->set_confidence(0.5);
   }
-
-  return obstacles;
 }
 
 RadarObstacles ContiToRadarObstacles(
@@ -265,6 +278,18 @@ RadarObstacles ContiToRadarObstacles(
     const apollo::localization::LocalizationEstimate& localization,
     const RadarObstacles& last_radar_obstacles, const Chassis& chassis) {
   RadarObstacles obstacles;
+  ContiToRadarObstacles(conti_radar, localization, last_radar_obstacles,
+                        chassis, &obstacles);
+  return obstacles;
+}
+
+void ContiToRadarObstacles(
+    const apollo::drivers::ContiRadar& conti_radar,
+    const apollo::localization::LocalizationEstimate& localization,
+    const RadarObstacles& last_radar_obstacles, const Chassis& chassis,
+    RadarObstacles* const result) {
+  result->Clear();
+  RadarObstacles& obstacles = *result;
 
   const double last_timestamp = last_radar_obstacles.header().timestamp_sec();
   const double current_timestamp = conti_radar.header().timestamp_sec();
@@ -277,7 +302,8 @@ RadarObstacles ContiToRadarObstacles(
   for (int index = 0; index < conti_radar.contiobs_size(); ++index) {
     const auto& contiobs = conti_radar.contiobs(index);
 
-    RadarObstacle rob;
+    // filled in place in the map, not copied into it
+    RadarObstacle& rob = (*obstacles.mutable_radar_obstacle())[index];
 
     rob.set_id(contiobs.obstacle_id());
     rob.set_rcs(contiobs.rcs());
@@ -353,17 +379,26 @@ RadarObstacles ContiToRadarObstacles(
     if (rob.moving_frames_count() >= FLAGS_movable_frames_count_threshold) {
       rob.set_movable(true);
     }
-    (*obstacles.mutable_radar_obstacle())[index] = rob;
   }
 
   obstacles.mutable_header()->CopyFrom(conti_radar.header());
-  return obstacles;
 }
 
 RadarObstacles DelphiToRadarObstacles(
     const DelphiESR& delphi_esr, const LocalizationEstimate& localization,
     const RadarObstacles& last_radar_obstacles) {
   RadarObstacles obstacles;
+  DelphiToRadarObstacles(delphi_esr, localization, last_radar_obstacles,
+                         &obstacles);
+  return obstacles;
+}
+
+void DelphiToRadarObstacles(const DelphiESR& delphi_esr,
+                            const LocalizationEstimate& localization,
+                            const RadarObstacles& last_radar_obstacles,
+                            RadarObstacles* const result) {
+  result->Clear();
+  RadarObstacles& obstacles = *result;
 
   const double last_timestamp = last_radar_obstacles.header().timestamp_sec();
   const double current_timestamp = delphi_esr.header().timestamp_sec();
@@ -409,7 +444,8 @@ RadarObstacles DelphiToRadarObstacles(
       continue;
     }
 
-    RadarObstacle rob;
+    // filled in place in the map, not copied into it
+    RadarObstacle& rob = (*obstacles.mutable_radar_obstacle())[index];
 
     rob.set_id(index);
     rob.set_rcs(static_cast<double>(motionpowers[index].can_tx_track_power()) -
@@ -480,16 +516,24 @@ RadarObstacles DelphiToRadarObstacles(
     if (rob.moving_frames_count() >= FLAGS_movable_frames_count_threshold) {
       rob.set_movable(true);
     }
-    (*obstacles.mutable_radar_obstacle())[index] = rob;
   }
 
   obstacles.mutable_header()->CopyFrom(delphi_esr.header());
-  return obstacles;
 }
 
 PerceptionObstacles RadarObstaclesToPerceptionObstacles(
     const RadarObstacles& radar_obstacles) {
   PerceptionObstacles obstacles;
+  RadarObstaclesToPerceptionObstacles(radar_obstacles, &obstacles);
+  return obstacles;
+}
+
+void RadarObstaclesToPerceptionObstacles(const RadarObstacles& radar_obstacles,
+                                         PerceptionObstacles* const result) {
+  result->Clear();
+  PerceptionObstacles& obstacles = *result;
+  obstacles.mutable_perception_obstacle()->Reserve(
+      radar_obstacles.radar_obstacle_size());
 
   for (const auto& iter : radar_obstacles.radar_obstacle()) {
     auto* pob = obstacles.add_perception_obstacle();
@@ -520,8 +564,6 @@ PerceptionObstacles RadarObstaclesToPerceptionObstacles(
   }
 
   obstacles.mutable_header()->CopyFrom(radar_obstacles.header());
-
-  return obstacles;
 }
 
 }  // namespace conversion
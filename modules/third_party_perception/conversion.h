@@ -25,6 +25,7 @@
 #include "modules/drivers/proto/delphi_esr.pb.h"
 #include "modules/drivers/proto/mobileye.pb.h"
 #include "modules/localization/proto/localization.pb.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/third_party_perception/proto/radar_obstacle.pb.h"
 
 /**
@@ -54,6 +55,29 @@ RadarObstacles ContiToRadarObstacles(
 apollo::perception::PerceptionObstacles RadarObstaclesToPerceptionObstacles(
     const RadarObstacles& radar_obstacles);
 
+// The same conversions into an existing message, cleared first, so that the
+// obstacles it held are reused. The result must not be an input.
+void MobileyeToPerceptionObstacles(
+    const apollo::drivers::Mobileye& mobileye,
+    const apollo::localization::LocalizationEstimate& localization,
+    const apollo::canbus::Chassis& chassis,
+    apollo::perception::PerceptionObstacles* const result);
+
+void DelphiToRadarObstacles(
+    const apollo::drivers::DelphiESR& delphi_esr,
+    const apollo::localization::LocalizationEstimate& localization,
+    const RadarObstacles& last_radar_obstacles, RadarObstacles* const result);
+
+void ContiToRadarObstacles(
+    const apollo::drivers::ContiRadar& conti_radar,
+    const apollo::localization::LocalizationEstimate& localization,
+    const RadarObstacles& last_radar_obstacles,
+    const apollo::canbus::Chassis& chassis, RadarObstacles* const result);
+
+void RadarObstaclesToPerceptionObstacles(
+    const RadarObstacles& radar_obstacles,
+    apollo::perception::PerceptionObstacles* const result);
+
 }  // namespace conversion
 }  // namespace third_party_perception
 }  // namespace apollo
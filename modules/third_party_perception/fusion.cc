@@ -20,6 +20,9 @@
 
 #include "modules/third_party_perception/fusion.h"
 
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/common/math/polygon2d.h"
@@ -32,10 +35,40 @@ namespace apollo {
 namespace third_party_perception {
 namespace fusion {
 
+using apollo::common::math::AABox2d;
+using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 using apollo::perception::PerceptionObstacle;
 using apollo::perception::PerceptionObstacles;
 
+namespace {
+
+// side of the grid cells radar obstacles are bucketed in, about a car
+constexpr double kGridCellSize = 5.0;
+
+std::int64_t GridIndex(const double value) {
+  return static_cast<std::int64_t>(std::floor(value / kGridCellSize));
+}
+
+std::uint64_t GridKey(const std::int64_t x, const std::int64_t y) {
+  return (static_cast<std::uint64_t>(x) << 32) ^
+         (static_cast<std::uint64_t>(y) & 0xffffffffULL);
+}
+
+// calls visit with the key of every cell box covers
+template <typename Visitor>
+void ForEachCell(const AABox2d& box, const Visitor& visit) {
+  const std::int64_t max_x = GridIndex(box.max_x());
+  const std::int64_t max_y = GridIndex(box.max_y());
+  for (std::int64_t x = GridIndex(box.min_x()); x <= max_x; ++x) {
+    for (std::int64_t y = GridIndex(box.min_y()); y <= max_y; ++y) {
+      visit(GridKey(x, y));
+    }
+  }
+}
+
+}  // namespace
+
 std::vector<Vec2d> PerceptionObstacleToVectorVec2d(
     const PerceptionObstacle& obstacle) {
   std::vector<Vec2d> result;
@@ -68,22 +101,60 @@ PerceptionObstacles MobileyeRadarFusion(
     const PerceptionObstacles& mobileye_obstacles,
     const PerceptionObstacles& radar_obstacles) {
   PerceptionObstacles mobileye_obstacles_fusion = mobileye_obstacles;
-  PerceptionObstacles radar_obstacles_fusion = radar_obstacles;
+  MobileyeRadarFusion(radar_obstacles, &mobileye_obstacles_fusion);
+  // mobileye_obstacles_fusion.MergeFrom(radar_obstacles);
+  return mobileye_obstacles_fusion;
+}
+
+void MobileyeRadarFusion(const PerceptionObstacles& radar_obstacles,
+                         PerceptionObstacles* const mobileye_obstacles) {
+  const int num_radar_obstacles = radar_obstacles.perception_obstacle_size();
+  if (num_radar_obstacles == 0 ||
+      mobileye_obstacles->perception_obstacle_size() == 0) {
+    return;
+  }
+
+  // the polygon of each radar obstacle is built once, not once per pair
+  std::vector<Polygon2d> radar_polygons(num_radar_obstacles);
+  std::unordered_map<std::uint64_t, std::vector<int>> grid;
+  for (int i = 0; i < num_radar_obstacles; ++i) {
+    const auto& radar_obstacle = radar_obstacles.perception_obstacle(i);
+    if (radar_obstacle.polygon_point_size() < 3) {
+      continue;
+    }
+    radar_polygons[i] =
+        Polygon2d(PerceptionObstacleToVectorVec2d(radar_obstacle));
+    ForEachCell(radar_polygons[i].AABoundingBox(),
+                [&grid, i](const std::uint64_t key) {
+                  grid[key].push_back(i);
+                });
+  }
 
   for (auto& mobileye_obstacle :
-       *(mobileye_obstacles_fusion.mutable_perception_obstacle())) {
-    for (auto& radar_obstacle :
-         *(radar_obstacles_fusion.mutable_perception_obstacle())) {
-      if (HasOverlap(mobileye_obstacle, radar_obstacle)) {
-        mobileye_obstacle.set_confidence(0.99);
-        mobileye_obstacle.mutable_velocity()->CopyFrom(
-            radar_obstacle.velocity());
+       *(mobileye_obstacles->mutable_perception_obstacle())) {
+    if (mobileye_obstacle.polygon_point_size() < 3) {
+      continue;
+    }
+    const Polygon2d polygon(PerceptionObstacleToVectorVec2d(mobileye_obstacle));
+    // the last overlapping radar obstacle in the list sets the velocity
+    int fused_index = -1;
+    ForEachCell(polygon.AABoundingBox(), [&](const std::uint64_t key) {
+      const auto iter = grid.find(key);
+      if (iter == grid.end()) {
+        return;
+      }
+      for (const int i : iter->second) {
+        if (i > fused_index && polygon.HasOverlap(radar_polygons[i])) {
+          fused_index = i;
+        }
       }
+    });
+    if (fused_index != -1) {
+      mobileye_obstacle.set_confidence(0.99);
+      mobileye_obstacle.mutable_velocity()->CopyFrom(
+          radar_obstacles.perception_obstacle(fused_index).velocity());
     }
   }
-
-  // mobileye_obstacles_fusion.MergeFrom(radar_obstacles_fusion);
-  return mobileye_obstacles_fusion;
 }
 
 }  // namespace fusion
@@ -34,6 +34,14 @@ apollo::perception::PerceptionObstacles MobileyeRadarFusion(
     const apollo::perception::PerceptionObstacles& mobileye_obstacles,
     const apollo::perception::PerceptionObstacles& radar_obstacles);
 
+// Fuses radar_obstacles into mobileye_obstacles in place: a mobileye
+// obstacle overlapping radar obstacles takes the velocity of the last of
+// them. The radar obstacles are bucketed in a grid, so each mobileye
+// obstacle is only tested against those around it.
+void MobileyeRadarFusion(
+    const apollo::perception::PerceptionObstacles& radar_obstacles,
+    apollo::perception::PerceptionObstacles* const mobileye_obstacles);
+
 }  // namespace fusion
 }  // namespace third_party_perception
 }  // namespace apollo
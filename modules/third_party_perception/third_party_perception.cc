@@ -46,8 +46,8 @@ void ThirdPartyPerception::OnMobileye(const Mobileye& message) {
   ADEBUG << "Received mobileye data: run mobileye callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
   if (FLAGS_enable_mobileye) {
-    mobileye_obstacles_ = conversion::MobileyeToPerceptionObstacles(
-        message, localization_, chassis_);
+    conversion::MobileyeToPerceptionObstacles(message, localization_,
+                                              chassis_, &mobileye_obstacles_);
   }
 }
 
@@ -60,28 +60,30 @@ void ThirdPartyPerception::OnChassis(const Chassis& message) {
 void ThirdPartyPerception::OnDelphiESR(const DelphiESR& message) {
   ADEBUG << "Received delphi esr data: run delphi esr callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
-  last_radar_obstacles_.CopyFrom(current_radar_obstacles_);
-  current_radar_obstacles_ = conversion::DelphiToRadarObstacles(
-      message, localization_, last_radar_obstacles_);
-  RadarObstacles filtered_radar_obstacles =
-      filter::FilterRadarObstacles(current_radar_obstacles_);
+  // the current obstacles become the last ones without a copy, the new
+  // ones are converted into the message of the last but one
+  last_radar_obstacles_.Swap(&current_radar_obstacles_);
+  conversion::DelphiToRadarObstacles(message, localization_,
+                                     last_radar_obstacles_,
+                                     &current_radar_obstacles_);
   if (FLAGS_enable_radar) {
-    radar_obstacles_ = conversion::RadarObstaclesToPerceptionObstacles(
-        filtered_radar_obstacles);
+    conversion::RadarObstaclesToPerceptionObstacles(
+        filter::FilterRadarObstacles(current_radar_obstacles_),
+        &radar_obstacles_);
   }
 }
 
 void ThirdPartyPerception::OnContiRadar(const ContiRadar& message) {
   ADEBUG << "Received delphi esr data: run continental radar callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
-  last_radar_obstacles_.CopyFrom(current_radar_obstacles_);
-  current_radar_obstacles_ = conversion::ContiToRadarObstacles(
-      message, localization_, last_radar_obstacles_, chassis_);
-  RadarObstacles filtered_radar_obstacles =
-      filter::FilterRadarObstacles(current_radar_obstacles_);
+  last_radar_obstacles_.Swap(&current_radar_obstacles_);
+  conversion::ContiToRadarObstacles(message, localization_,
+                                    last_radar_obstacles_, chassis_,
+                                    &current_radar_obstacles_);
   if (FLAGS_enable_radar) {
-    radar_obstacles_ = conversion::RadarObstaclesToPerceptionObstacles(
-        filtered_radar_obstacles);
+    conversion::RadarObstaclesToPerceptionObstacles(
+        filter::FilterRadarObstacles(current_radar_obstacles_),
+        &radar_obstacles_);
   }
 }
 
@@ -97,8 +99,9 @@ bool ThirdPartyPerception::Process(PerceptionObstacles* const response) {
 
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
 
-  *response =
-      fusion::MobileyeRadarFusion(mobileye_obstacles_, radar_obstacles_);
+  // fused in place and handed over, neither list is copied
+  fusion::MobileyeRadarFusion(radar_obstacles_, &mobileye_obstacles_);
+  response->Swap(&mobileye_obstacles_);
 
   common::util::FillHeader(FLAGS_third_party_perception_node_name, response);
 
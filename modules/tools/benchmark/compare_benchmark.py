@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+
+###############################################################################
+# Copyright 2019 The Apollo Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+###############################################################################
+"""
+Compares the results of a Google benchmark binary with a stored baseline, and
+flags the benchmarks which got slower than a threshold.
+
+Usage:
+    bazel-bin/modules/planning/math/spline_qp_benchmark \
+        --benchmark_repetitions=5 --benchmark_report_aggregates_only=true \
+        --benchmark_format=json > /tmp/current.json
+    python modules/tools/benchmark/compare_benchmark.py \
+        modules/planning/math/spline_qp_benchmark_baseline.json \
+        /tmp/current.json --threshold 0.1
+
+The exit status is 1 when a benchmark regressed. With --update, the current
+results replace the baseline instead. Baselines only compare well with runs
+on the same kind of machine, so the machines of both runs are printed.
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNIT_TO_NS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load_times(results):
+    """Returns the real time in ns of each benchmark, preferring the medians
+    of repeated runs to the mean of the single runs."""
+    medians = {}
+    iterations = {}
+    for benchmark in results['benchmarks']:
+        real_time = benchmark['real_time'] * \
+            TIME_UNIT_TO_NS[benchmark.get('time_unit', 'ns')]
+        if benchmark.get('run_type') == 'aggregate':
+            if benchmark.get('aggregate_name') == 'median':
+                medians[benchmark['run_name']] = real_time
+        else:
+            name = benchmark.get('run_name', benchmark['name'])
+            iterations.setdefault(name, []).append(real_time)
+    times = dict((name, sum(values) / len(values))
+                 for name, values in iterations.items())
+    times.update(medians)
+    return times
+
+
+def median_results(results):
+    """Keeps the context and the medians, or the single runs, of results."""
+    has_medians = any(b.get('aggregate_name') == 'median'
+                      for b in results['benchmarks'])
+    benchmarks = [b for b in results['benchmarks']
+                  if not has_medians or b.get('aggregate_name') == 'median']
+    return {'context': results['context'], 'benchmarks': benchmarks}
+
+
+def describe_machine(context):
+    return '%s CPUs at %s MHz' % (context.get('num_cpus', '?'),
+                                  context.get('mhz_per_cpu', '?'))
+
+
+def compare(baseline, current, threshold):
+    """Prints the comparison and returns the number of regressions."""
+    print('baseline: %s, %s' % (describe_machine(baseline['context']),
+                                baseline['context'].get('date', '?')))
+    print('current:  %s, %s' % (describe_machine(current['context']),
+                                current['context'].get('date', '?')))
+    baseline_times = load_times(baseline)
+    current_times = load_times(current)
+    regressions = 0
+    row = '%-50s %14s %14s %9s  %s'
+    print(row % ('benchmark', 'baseline ns', 'current ns', 'change', ''))
+    for name in sorted(set(baseline_times) | set(current_times)):
+        if name not in current_times:
+            print(row % (name, '%.0f' % baseline_times[name], '-', '-',
+                         'MISSING'))
+            continue
+        if name not in baseline_times:
+            print(row % (name, '-', '%.0f' % current_times[name], '-',
+                         'NO BASELINE'))
+            continue
+        change = current_times[name] / baseline_times[name] - 1.0
+        status = ''
+        if change > threshold:
+            status = 'REGRESSION'
+            regressions += 1
+        elif change < -threshold:
+            status = 'IMPROVED'
+        print(row % (name, '%.0f' % baseline_times[name],
+                     '%.0f' % current_times[name], '%+.1f%%' % (100 * change),
+                     status))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares Google benchmark results with a baseline.')
+    parser.add_argument('baseline', help='stored baseline JSON')
+    parser.add_argument('current', help='JSON output of the benchmark')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='relative slowdown reported as a regression')
+    parser.add_argument('--update', action='store_true',
+                        help='replace the baseline with the current results')
+    args = parser.parse_args()
+
+    with open(args.current) as current_file:
+        current = json.load(current_file)
+    if args.update:
+        with open(args.baseline, 'w') as baseline_file:
+            json.dump(median_results(current), baseline_file, indent=2,
+                      sort_keys=True)
+            baseline_file.write('\n')
+        print('Updated %s' % args.baseline)
+        return 0
+
+    with open(args.baseline) as baseline_file:
+        baseline = json.load(baseline_file)
+    regressions = compare(baseline, current, args.threshold)
+    if regressions > 0:
+        print('%d benchmark(s) regressed by more than %.0f%%' %
+              (regressions, 100 * args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,351 @@
+#!/usr/bin/env python
+
+###############################################################################
+# Copyright 2019 The Apollo Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+###############################################################################
+"""
+Replays the sensor data of a record through the whole stack, from perception
+to control, and reports the latency from lidar frame to control command, the
+frames dropped on the way and the CPU of every process.
+
+Usage:
+    python modules/tools/benchmark/system_benchmark.py \
+        --record data/bag/highway.record --rate 1.5 --output_dir /tmp/bench \
+        --max_p99_ms 300 --max_drop_ratio 0.05
+
+The launch file is started with cyber_latency_trace=1, the record is played
+without the channels the stack publishes itself, and a recorder captures the
+lidar frames, the output of every stage and the per-hop latency reports into
+<output_dir>/system_benchmark.record. The lidar timestamp travels in the
+header of every stage's output, so a frame is matched to the first control
+command computed from it. The latency is taken between the times the
+recorder received both, and the per-hop breakdown is printed by cyber_latency
+from the same record. With --analyze, an existing output record is analyzed
+again without running anything.
+
+The record must hold the inputs of the stack besides the lidar: localization,
+chassis, routing, radar if fused. The exit status is 1 when a threshold is
+exceeded, and the results are also written to <output_dir>/results.json.
+"""
+
+import argparse
+import bisect
+import json
+import os
+import signal
+import subprocess
+import sys
+import time
+
+from cyber_py.record import RecordReader
+from modules.common.proto import header_pb2
+from modules.control.proto import control_cmd_pb2
+from modules.perception.proto import perception_obstacle_pb2
+from modules.planning.proto import planning_pb2
+from modules.prediction.proto import prediction_obstacle_pb2
+
+
+LIDAR_CHANNEL = '/apollo/sensor/lidar128/compensator/PointCloud2'
+LATENCY_CHANNEL = '/apollo/cyber/latency'
+# Stages in pipeline order, with the channel and the message they publish.
+STAGES = [
+    ('perception', '/apollo/perception/obstacles',
+     perception_obstacle_pb2.PerceptionObstacles),
+    ('prediction', '/apollo/prediction',
+     prediction_obstacle_pb2.PredictionObstacles),
+    ('planning', '/apollo/planning', planning_pb2.ADCTrajectory),
+    ('control', '/apollo/control', control_cmd_pb2.ControlCommand),
+]
+# Perception rounds the lidar time it copies, frames are 100 ms apart.
+MATCH_TOLERANCE_NS = 1000000
+CPU_SAMPLE_INTERVAL = 1.0
+CLOCK_TICKS = os.sysconf('SC_CLK_TCK')
+
+
+def cloud_lidar_timestamp(data):
+    """Returns the lidar timestamp of a serialized PointCloud, parsing only its
+    header, which is serialized ahead of the points."""
+    # field 1, length delimited
+    if not data or ord(data[0:1]) != 0x0a:
+        return 0
+    size, shift, pos = 0, 0, 1
+    while True:
+        byte = ord(data[pos:pos + 1])
+        size |= (byte & 0x7f) << shift
+        shift += 7
+        pos += 1
+        if byte < 0x80:
+            break
+    header = header_pb2.Header()
+    header.ParseFromString(data[pos:pos + size])
+    return header.lidar_timestamp
+
+
+def percentile(values, p):
+    """Nearest-rank percentile of sorted values."""
+    if not values:
+        return 0.0
+    rank = max(1, int(round(p / 100.0 * len(values))))
+    return values[min(rank, len(values)) - 1]
+
+
+def read_record(record_file, lidar_channel):
+    """Returns the receive times of the lidar frames by lidar timestamp, and
+    for every stage the receive time of its first output for each lidar
+    timestamp it carries."""
+    frames = {}
+    first_seen = dict((name, {}) for name, _, _ in STAGES)
+    stages = dict((channel, (proto_type, first_seen[name]))
+                  for name, channel, proto_type in STAGES)
+    for msg in RecordReader(record_file).read_messages():
+        if msg.topic == lidar_channel:
+            lidar_timestamp = cloud_lidar_timestamp(msg.message)
+            if lidar_timestamp != 0:
+                frames.setdefault(lidar_timestamp, msg.timestamp)
+        elif msg.topic in stages:
+            proto_type, stage_first_seen = stages[msg.topic]
+            output = proto_type()
+            output.ParseFromString(msg.message)
+            lidar_timestamp = output.header.lidar_timestamp
+            if lidar_timestamp != 0:
+                stage_first_seen.setdefault(lidar_timestamp, msg.timestamp)
+    return frames, first_seen
+
+
+def match_frames(frames, first_seen):
+    """Returns the latencies in ms from each frame to the first output with
+    its lidar timestamp, and the number of frames without one."""
+    lidar_timestamps = sorted(first_seen)
+    latencies = []
+    dropped = 0
+    for lidar_timestamp, receive_time in frames.items():
+        pos = bisect.bisect_left(lidar_timestamps, lidar_timestamp)
+        nearest = [lidar_timestamps[i] for i in (pos - 1, pos)
+                   if 0 <= i < len(lidar_timestamps)]
+        nearest = [t for t in nearest
+                   if abs(t - lidar_timestamp) <= MATCH_TOLERANCE_NS]
+        if not nearest:
+            dropped += 1
+            continue
+        matched = min(nearest, key=lambda t: abs(t - lidar_timestamp))
+        latencies.append((first_seen[matched] - receive_time) / 1e6)
+    latencies.sort()
+    return latencies, dropped
+
+
+def analyze(record_file, lidar_channel):
+    """Returns the latency and drops from the lidar to every stage."""
+    frames, first_seen = read_record(record_file, lidar_channel)
+    results = {'frames': len(frames), 'stages': []}
+    for name, _, _ in STAGES:
+        latencies, dropped = match_frames(frames, first_seen[name])
+        results['stages'].append({
+            'stage': name,
+            'matched': len(latencies),
+            'dropped': dropped,
+            'p50_ms': percentile(latencies, 50),
+            'p90_ms': percentile(latencies, 90),
+            'p99_ms': percentile(latencies, 99),
+            'max_ms': latencies[-1] if latencies else 0.0,
+        })
+    return results
+
+
+def mainboard_processes():
+    """Returns the pids of the running mainboards by process name."""
+    processes = {}
+    for pid in os.listdir('/proc'):
+        if not pid.isdigit():
+            continue
+        try:
+            with open('/proc/%s/cmdline' % pid) as cmdline_file:
+                args = cmdline_file.read().split('\0')
+        except IOError:
+            continue
+        if not args[0].endswith('mainboard') or '-p' not in args:
+            continue
+        name_pos = args.index('-p') + 1
+        if name_pos < len(args):
+            processes[args[name_pos]] = int(pid)
+    return processes
+
+
+def cpu_ticks(pid):
+    """Returns the user and system time of a process in clock ticks."""
+    with open('/proc/%d/stat' % pid) as stat_file:
+        # the command may contain spaces, the fields follow its parenthesis
+        fields = stat_file.read().rsplit(')', 1)[1].split()
+    return int(fields[11]) + int(fields[12])
+
+
+def peak_rss_mb(pid):
+    with open('/proc/%d/status' % pid) as status_file:
+        for line in status_file:
+            if line.startswith('VmHWM:'):
+                return int(line.split()[1]) / 1024.0
+    return 0.0
+
+
+class CpuSampler(object):
+    """Samples the CPU of the mainboards while the record plays."""
+
+    def __init__(self):
+        self.last = {}
+        self.usage = {}
+        self.peak_rss = {}
+
+    def sample(self, interval):
+        now = time.time()
+        for name, pid in mainboard_processes().items():
+            try:
+                ticks = cpu_ticks(pid)
+                self.peak_rss[name] = peak_rss_mb(pid)
+            except IOError:
+                continue
+            if name in self.last and self.last[name][0] == pid:
+                _, last_ticks, last_time = self.last[name]
+                percent = 100.0 * (ticks - last_ticks) / CLOCK_TICKS / \
+                    max(now - last_time, interval / 10)
+                self.usage.setdefault(name, []).append(percent)
+            self.last[name] = (pid, ticks, now)
+
+    def results(self):
+        return [{
+            'process': name,
+            'mean_cpu_percent': sum(usage) / len(usage),
+            'max_cpu_percent': max(usage),
+            'peak_rss_mb': self.peak_rss.get(name, 0.0),
+        } for name, usage in sorted(self.usage.items())]
+
+
+def run(args, output_record):
+    """Runs the stack on the record, returns the CPU samples."""
+    env = dict(os.environ, cyber_latency_trace='1')
+    launch = subprocess.Popen(['cyber_launch', 'start', args.launch], env=env)
+    time.sleep(args.warmup)
+    record_channels = [args.lidar_channel, LATENCY_CHANNEL] + \
+        [channel for _, channel, _ in STAGES]
+    recorder = subprocess.Popen(['cyber_recorder', 'record', '-o',
+                                 output_record, '-c'] + record_channels)
+    # the stack publishes these itself
+    player = subprocess.Popen(['cyber_recorder', 'play', '-f', args.record,
+                               '-r', str(args.rate), '-k'] + record_channels)
+    sampler = CpuSampler()
+    try:
+        while player.poll() is None:
+            sampler.sample(CPU_SAMPLE_INTERVAL)
+            time.sleep(CPU_SAMPLE_INTERVAL)
+        # let the last frames reach control
+        time.sleep(args.drain)
+    finally:
+        for process in (player, recorder, launch):
+            if process.poll() is None:
+                process.send_signal(signal.SIGINT)
+                process.wait()
+    return sampler.results()
+
+
+def print_results(results):
+    print('%d lidar frames' % results['frames'])
+    row = '%-12s %8s %8s %10s %10s %10s %10s'
+    print(row % ('lidar to', 'matched', 'dropped', 'p50 ms', 'p90 ms',
+                 'p99 ms', 'max ms'))
+    for stage in results['stages']:
+        print(row % (stage['stage'], stage['matched'], stage['dropped'],
+                     '%.1f' % stage['p50_ms'], '%.1f' % stage['p90_ms'],
+                     '%.1f' % stage['p99_ms'], '%.1f' % stage['max_ms']))
+    if results.get('processes'):
+        row = '%-12s %10s %10s %12s'
+        print(row % ('process', 'mean cpu%', 'max cpu%', 'peak rss MB'))
+        for process in results['processes']:
+            print(row % (process['process'],
+                         '%.1f' % process['mean_cpu_percent'],
+                         '%.1f' % process['max_cpu_percent'],
+                         '%.0f' % process['peak_rss_mb']))
+
+
+def check(results, max_p99_ms, max_drop_ratio):
+    """Returns the number of thresholds the control stage exceeds."""
+    control = results['stages'][-1]
+    failures = 0
+    if max_p99_ms is not None and control['p99_ms'] > max_p99_ms:
+        print('p99 lidar to control %.1f ms exceeds %.1f ms' %
+              (control['p99_ms'], max_p99_ms))
+        failures += 1
+    drop_ratio = float(control['dropped']) / max(results['frames'], 1)
+    if max_drop_ratio is not None and drop_ratio > max_drop_ratio:
+        print('%.1f%% of the frames never reached control, more than %.1f%%' %
+              (100 * drop_ratio, 100 * max_drop_ratio))
+        failures += 1
+    if results['frames'] == 0:
+        print('no lidar frame on %s' % results['lidar_channel'])
+        failures += 1
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measures the latency from lidar to control command.')
+    parser.add_argument('--record', help='record with the sensor data to play')
+    parser.add_argument('--analyze', metavar='OUTPUT_RECORD',
+                        help='only analyze the record of an earlier run')
+    parser.add_argument('--launch', default='/apollo/modules/tools/benchmark/'
+                        'launch/system_benchmark.launch',
+                        help='launch file of the stack')
+    parser.add_argument('--rate', type=float, default=1.0,
+                        help='multiply the play rate by this factor')
+    parser.add_argument('--lidar_channel', default=LIDAR_CHANNEL,
+                        help='the lidar the latency is measured from')
+    parser.add_argument('--output_dir', default='/tmp/system_benchmark',
+                        help='where the record and the results are written')
+    parser.add_argument('--warmup', type=float, default=20.0,
+                        help='seconds for the modules to start up')
+    parser.add_argument('--drain', type=float, default=3.0,
+                        help='seconds to wait after the record played')
+    parser.add_argument('--max_p99_ms', type=float,
+                        help='fail above this p99 lidar to control latency')
+    parser.add_argument('--max_drop_ratio', type=float,
+                        help='fail when more frames never reach control')
+    args = parser.parse_args()
+
+    processes = []
+    if args.analyze:
+        output_record = args.analyze
+    elif args.record:
+        if not os.path.isdir(args.output_dir):
+            os.makedirs(args.output_dir)
+        output_record = os.path.join(args.output_dir,
+                                     'system_benchmark.record')
+        processes = run(args, output_record)
+    else:
+        parser.error('one of --record or --analyze is required')
+
+    results = analyze(output_record, args.lidar_channel)
+    results.update({'lidar_channel': args.lidar_channel, 'rate': args.rate,
+                    'processes': processes})
+    print_results(results)
+    print('')
+    subprocess.call(['cyber_latency', '-f', output_record])
+    if not args.analyze:
+        with open(os.path.join(args.output_dir, 'results.json'),
+                  'w') as results_file:
+            json.dump(results, results_file, indent=2, sort_keys=True)
+            results_file.write('\n')
+
+    return 1 if check(results, args.max_p99_ms, args.max_drop_ratio) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -71,9 +71,11 @@ void Buffer::SubscriptionCallbackImpl(
   if (now.ToNanosecond() < last_update_.ToNanosecond()) {
     AINFO << "Detected jump back in time. Clearing TF buffer.";
     clear();
+    cache_.Clear();
     // cache static transform stamped again.
     for (auto& msg : static_msgs_) {
       setTransform(msg, authority, true);
+      SetCacheTransform(msg, true);
     }
   }
   last_update_ = now;
@@ -108,6 +110,7 @@ void Buffer::SubscriptionCallbackImpl(
         static_msgs_.push_back(trans_stamped);
       }
       setTransform(trans_stamped, authority, is_static);
+      SetCacheTransform(trans_stamped, is_static);
     }
 
     catch (tf2::TransformException& ex) {
@@ -148,13 +151,60 @@ void Buffer::TF2MsgToCyber(
       tf2_trans_stamped.transform.rotation.w);
 }
 
+void Buffer::SetCacheTransform(
+    const geometry_msgs::TransformStamped& tf2_trans_stamped, bool is_static) {
+  TransformSample sample;
+  sample.stamp_ns = tf2_trans_stamped.header.stamp;
+  sample.translation[0] = tf2_trans_stamped.transform.translation.x;
+  sample.translation[1] = tf2_trans_stamped.transform.translation.y;
+  sample.translation[2] = tf2_trans_stamped.transform.translation.z;
+  sample.rotation[0] = tf2_trans_stamped.transform.rotation.x;
+  sample.rotation[1] = tf2_trans_stamped.transform.rotation.y;
+  sample.rotation[2] = tf2_trans_stamped.transform.rotation.z;
+  sample.rotation[3] = tf2_trans_stamped.transform.rotation.w;
+  cache_.SetTransform(tf2_trans_stamped.header.frame_id,
+                      tf2_trans_stamped.child_frame_id, sample, is_static);
+}
+
+void Buffer::CacheSampleToCyber(
+    const std::string& target_frame, const std::string& source_frame,
+    const TransformSample& sample,
+    apollo::transform::TransformStamped* trans_stamped) const {
+  // header
+  trans_stamped->mutable_header()->set_timestamp_sec(
+      static_cast<double>(sample.stamp_ns) / 1e9);
+  trans_stamped->mutable_header()->set_frame_id(target_frame);
+
+  // child_frame_id
+  trans_stamped->set_child_frame_id(source_frame);
+
+  // translation
+  auto* translation = trans_stamped->mutable_transform()->mutable_translation();
+  translation->set_x(sample.translation[0]);
+  translation->set_y(sample.translation[1]);
+  translation->set_z(sample.translation[2]);
+
+  // rotation
+  auto* rotation = trans_stamped->mutable_transform()->mutable_rotation();
+  rotation->set_qx(sample.rotation[0]);
+  rotation->set_qy(sample.rotation[1]);
+  rotation->set_qz(sample.rotation[2]);
+  rotation->set_qw(sample.rotation[3]);
+}
+
 apollo::transform::TransformStamped Buffer::lookupTransform(
     const std::string& target_frame, const std::string& source_frame,
     const cyber::Time& time, const float timeout_second) const {
+  apollo::transform::TransformStamped trans_stamped;
+  TransformSample sample;
+  if (cache_.LookupTransform(target_frame, source_frame, time.ToNanosecond(),
+                             &sample)) {
+    CacheSampleToCyber(target_frame, source_frame, sample, &trans_stamped);
+    return trans_stamped;
+  }
   tf2::Time tf2_time(time.ToNanosecond());
   geometry_msgs::TransformStamped tf2_trans_stamped =
       lookupTransform(target_frame, source_frame, tf2_time);
-  apollo::transform::TransformStamped trans_stamped;
   TF2MsgToCyber(tf2_trans_stamped, trans_stamped);
   return trans_stamped;
 }
@@ -176,6 +226,11 @@ bool Buffer::canTransform(const std::string& target_frame,
                           const cyber::Time& time,
                           const float timeout_second,
                           std::string* errstr) const {
+  TransformSample sample;
+  if (cache_.LookupTransform(target_frame, source_frame, time.ToNanosecond(),
+                             &sample)) {
+    return true;
+  }
   uint64_t timeout_ns = static_cast<uint64_t>(
       timeout_second * kSecondToNanoFactor);
   uint64_t start_time = cyber::Time::Now().ToNanosecond();
@@ -25,6 +25,7 @@
 
 #include "cyber/node/node.h"
 #include "modules/transform/buffer_interface.h"
+#include "modules/transform/transform_cache.h"
 
 namespace apollo {
 namespace transform {
@@ -129,6 +130,12 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
 
   void TF2MsgToCyber(const geometry_msgs::TransformStamped& tf2_trans_stamped,
                      apollo::transform::TransformStamped& trans_stamped) const; // NOLINT
+  void SetCacheTransform(
+      const geometry_msgs::TransformStamped& tf2_trans_stamped, bool is_static);
+  void CacheSampleToCyber(
+      const std::string& target_frame, const std::string& source_frame,
+      const TransformSample& sample,
+      apollo::transform::TransformStamped* trans_stamped) const;
 
   std::unique_ptr<cyber::Node> node_;
   std::shared_ptr<cyber::Reader<apollo::transform::TransformStampeds>>
@@ -138,6 +145,9 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
 
   cyber::Time last_update_;
   std::vector<geometry_msgs::TransformStamped> static_msgs_;
+  // answers the lookups by frame id without locking, the ones it cannot
+  // answer go to tf2::BufferCore
+  TransformCache cache_;
   DECLARE_SINGLETON(Buffer)
 };  // class
 
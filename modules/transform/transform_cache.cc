@@ -0,0 +1,458 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/transform/transform_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "Eigen/Geometry"
+
+namespace apollo {
+namespace transform {
+
+namespace {
+
+// deeper trees are left to tf2, which also reports the loops
+constexpr size_t kMaxChainDepth = 64;
+
+using ConstQuaternionMap = Eigen::Map<const Eigen::Quaterniond>;
+using ConstVectorMap = Eigen::Map<const Eigen::Vector3d>;
+
+void SetPose(const Eigen::Quaterniond& rotation,
+             const Eigen::Vector3d& translation, TransformSample* sample) {
+  Eigen::Map<Eigen::Quaterniond>(sample->rotation) = rotation;
+  Eigen::Map<Eigen::Vector3d>(sample->translation) = translation;
+}
+
+// the transform applying b first, then a
+TransformSample Compose(const TransformSample& a, const TransformSample& b) {
+  const ConstQuaternionMap a_rotation(a.rotation);
+  TransformSample result;
+  SetPose(a_rotation * ConstQuaternionMap(b.rotation),
+          a_rotation * ConstVectorMap(b.translation) +
+              ConstVectorMap(a.translation),
+          &result);
+  return result;
+}
+
+TransformSample Inverse(const TransformSample& a) {
+  const Eigen::Quaterniond rotation =
+      ConstQuaternionMap(a.rotation).conjugate();
+  TransformSample result;
+  SetPose(rotation, -(rotation * ConstVectorMap(a.translation)), &result);
+  return result;
+}
+
+// linear on the translation and spherical on the rotation, as tf2 does
+void InterpolateSamples(const TransformSample& before,
+                        const TransformSample& after, const uint64_t time_ns,
+                        TransformSample* sample) {
+  if (before.stamp_ns == after.stamp_ns) {
+    *sample = after;
+    return;
+  }
+  const double ratio = static_cast<double>(time_ns - before.stamp_ns) /
+                       static_cast<double>(after.stamp_ns - before.stamp_ns);
+  const ConstVectorMap before_translation(before.translation);
+  SetPose(ConstQuaternionMap(before.rotation)
+              .slerp(ratio, ConstQuaternionMap(after.rotation)),
+          before_translation +
+              ratio * (ConstVectorMap(after.translation) - before_translation),
+          sample);
+  sample->stamp_ns = time_ns;
+}
+
+uint64_t ChainKey(const std::string& target_frame,
+                  const std::string& source_frame) {
+  const uint64_t target_hash = std::hash<std::string>()(target_frame);
+  const uint64_t source_hash = std::hash<std::string>()(source_frame);
+  return target_hash ^ (source_hash + 0x9e3779b97f4a7c15ULL +
+                        (target_hash << 6) + (target_hash >> 2));
+}
+
+}  // namespace
+
+// Single writer ring of the latest dynamic transforms of a frame, in the
+// order of their stamps. The position a slot holds is stamped 2 * pos - 1
+// while it is written and 2 * pos once done, positions start at 1.
+class TransformCache::Ring {
+ public:
+  explicit Ring(uint32_t size) : mask_(size - 1), slots_(new Slot[size]) {}
+
+  void Push(const Frame* parent, const TransformSample& sample) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail > floor_.load(std::memory_order_relaxed) &&
+        sample.stamp_ns <= latest_stamp_ns_) {
+      return;
+    }
+    const uint64_t pos = tail + 1;
+    Slot& slot = slots_[pos & mask_];
+    slot.stamp.store(2 * pos - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.parent = parent;
+    slot.sample = sample;
+    slot.stamp.store(2 * pos, std::memory_order_release);
+    tail_.store(pos, std::memory_order_release);
+    latest_stamp_ns_ = sample.stamp_ns;
+  }
+
+  void Clear() {
+    floor_.store(tail_.load(std::memory_order_relaxed),
+                 std::memory_order_release);
+  }
+
+  bool Latest(const Frame* parent, TransformSample* sample) const {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    return Window(&first, &last) && Read(last, parent, sample);
+  }
+
+  bool Interpolate(const Frame* parent, const uint64_t time_ns,
+                   TransformSample* sample) const {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    if (!Window(&first, &last)) {
+      return false;
+    }
+    // first position not stamped before time_ns
+    TransformSample probe;
+    uint64_t lo = first;
+    uint64_t hi = last + 1;
+    while (lo < hi) {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      if (!Read(mid, parent, &probe)) {
+        return false;
+      }
+      if (probe.stamp_ns < time_ns) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    TransformSample after;
+    if (lo > last || !Read(lo, parent, &after)) {
+      return false;
+    }
+    if (after.stamp_ns == time_ns) {
+      *sample = after;
+      return true;
+    }
+    TransformSample before;
+    if (lo == first || !Read(lo - 1, parent, &before)) {
+      return false;
+    }
+    InterpolateSamples(before, after, time_ns, sample);
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> stamp = {0};
+    const Frame* parent = nullptr;
+    TransformSample sample;
+  };
+
+  // Positions a reader can expect to find, the oldest slot of a full ring is
+  // left out since the writer may be filling it already.
+  bool Window(uint64_t* first, uint64_t* last) const {
+    const uint64_t floor = floor_.load(std::memory_order_acquire);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    const uint64_t size = mask_ + 1;
+    *first = std::max(floor + 1, tail + 2 > size ? tail + 2 - size : 1);
+    *last = tail;
+    return *first <= *last;
+  }
+
+  bool Read(const uint64_t pos, const Frame* parent,
+            TransformSample* sample) const {
+    const Slot& slot = slots_[pos & mask_];
+    if (slot.stamp.load(std::memory_order_acquire) != 2 * pos) {
+      return false;
+    }
+    const Frame* slot_parent = slot.parent;
+    *sample = slot.sample;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.stamp.load(std::memory_order_relaxed) == 2 * pos &&
+           slot_parent == parent;
+  }
+
+  const uint64_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> tail_ = {0};
+  // positions up to floor_ were dropped by Clear()
+  std::atomic<uint64_t> floor_ = {0};
+  uint64_t latest_stamp_ns_ = 0;
+};
+
+struct TransformCache::Frame {
+  explicit Frame(const std::string& name) : name(name) {}
+
+  const std::string name;
+  // the fields below are guarded by mutex_, readers go through the chains
+  const Frame* parent = nullptr;
+  bool is_static = false;
+  TransformSample static_transform;
+  std::unique_ptr<Ring> ring;
+};
+
+struct TransformCache::Chain {
+  // a dynamic transform of a frame, or the composition of consecutive static
+  // transforms when ring is nullptr
+  struct Link {
+    const Ring* ring = nullptr;
+    const Frame* parent = nullptr;
+    TransformSample transform;
+  };
+
+  std::string target_frame;
+  std::string source_frame;
+  uint64_t version = 0;
+  // from the source, respectively the target, up to their common ancestor
+  std::vector<Link> source_links;
+  std::vector<Link> target_links;
+};
+
+namespace {
+
+bool SameTransform(const TransformSample& a, const TransformSample& b) {
+  return std::equal(a.translation, a.translation + 3, b.translation) &&
+         std::equal(a.rotation, a.rotation + 4, b.rotation);
+}
+
+}  // namespace
+
+TransformCache::TransformCache(uint32_t ring_size)
+    : ring_size_([ring_size] {
+        uint32_t size = 2;
+        while (size < ring_size) {
+          size <<= 1;
+        }
+        return size;
+      }()) {}
+
+TransformCache::~TransformCache() {}
+
+void TransformCache::SetTransform(const std::string& parent_frame,
+                                  const std::string& child_frame,
+                                  const TransformSample& sample,
+                                  bool is_static) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Frame* parent = GetOrAddFrame(parent_frame);
+  Frame* child = GetOrAddFrame(child_frame);
+  if (parent == nullptr || child == nullptr || parent == child) {
+    return;
+  }
+  if (is_static) {
+    if (!child->is_static || child->parent != parent ||
+        !SameTransform(child->static_transform, sample)) {
+      child->is_static = true;
+      child->parent = parent;
+      child->static_transform = sample;
+      version_.fetch_add(1, std::memory_order_release);
+    }
+    return;
+  }
+  if (child->is_static || child->parent != parent || !child->ring) {
+    if (!child->ring) {
+      child->ring.reset(new Ring(ring_size_));
+    } else if (child->parent != parent) {
+      child->ring->Clear();
+    }
+    child->is_static = false;
+    child->parent = parent;
+    version_.fetch_add(1, std::memory_order_release);
+  }
+  child->ring->Push(parent, sample);
+}
+
+bool TransformCache::LookupTransform(const std::string& target_frame,
+                                     const std::string& source_frame,
+                                     uint64_t time_ns,
+                                     TransformSample* transform) const {
+  // tf2 stamps the identity with the latest time of the frame
+  if (target_frame == source_frame) {
+    return false;
+  }
+  const Chain* chain = GetChain(target_frame, source_frame);
+  if (chain == nullptr) {
+    return false;
+  }
+  if (time_ns == 0) {
+    time_ns = std::numeric_limits<uint64_t>::max();
+    for (const auto* links : {&chain->source_links, &chain->target_links}) {
+      for (const auto& link : *links) {
+        TransformSample latest;
+        if (link.ring == nullptr) {
+          continue;
+        }
+        if (!link.ring->Latest(link.parent, &latest)) {
+          return false;
+        }
+        time_ns = std::min(time_ns, latest.stamp_ns);
+      }
+    }
+    if (time_ns == std::numeric_limits<uint64_t>::max()) {
+      time_ns = 0;
+    }
+  }
+
+  TransformSample to_ancestor[2];
+  const std::vector<Chain::Link>* links[2] = {&chain->source_links,
+                                              &chain->target_links};
+  for (int i = 0; i < 2; ++i) {
+    for (const auto& link : *links[i]) {
+      if (link.ring == nullptr) {
+        to_ancestor[i] = Compose(link.transform, to_ancestor[i]);
+        continue;
+      }
+      TransformSample sample;
+      if (!link.ring->Interpolate(link.parent, time_ns, &sample)) {
+        return false;
+      }
+      to_ancestor[i] = Compose(sample, to_ancestor[i]);
+    }
+  }
+  *transform = Compose(Inverse(to_ancestor[1]), to_ancestor[0]);
+  transform->stamp_ns = time_ns;
+  return true;
+}
+
+void TransformCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& frame : frames_) {
+    if (frame->ring) {
+      frame->ring->Clear();
+    }
+    frame->parent = nullptr;
+    frame->is_static = false;
+  }
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+TransformCache::Frame* TransformCache::GetOrAddFrame(const std::string& name) {
+  const uint64_t hash = std::hash<std::string>()(name);
+  Frame* frame = nullptr;
+  if (frame_map_.Get(hash, &frame)) {
+    // a name colliding with another one is left to tf2
+    return frame->name == name ? frame : nullptr;
+  }
+  frames_.emplace_back(new Frame(name));
+  frame_map_.Set(hash, frames_.back().get());
+  return frames_.back().get();
+}
+
+const TransformCache::Frame* TransformCache::FindFrame(
+    const std::string& name) const {
+  Frame* frame = nullptr;
+  if (!frame_map_.Get(std::hash<std::string>()(name), &frame) ||
+      frame->name != name) {
+    return nullptr;
+  }
+  return frame;
+}
+
+const TransformCache::Chain* TransformCache::GetChain(
+    const std::string& target_frame, const std::string& source_frame) const {
+  const Chain* chain = nullptr;
+  if (chain_map_.Get(ChainKey(target_frame, source_frame), &chain) &&
+      chain->version == version_.load(std::memory_order_acquire) &&
+      chain->target_frame == target_frame &&
+      chain->source_frame == source_frame) {
+    return chain;
+  }
+  return BuildChain(target_frame, source_frame);
+}
+
+const TransformCache::Chain* TransformCache::BuildChain(
+    const std::string& target_frame, const std::string& source_frame) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t key = ChainKey(target_frame, source_frame);
+  const uint64_t version = version_.load(std::memory_order_relaxed);
+  const Chain* built = nullptr;
+  if (chain_map_.Get(key, &built) && built->version == version &&
+      built->target_frame == target_frame &&
+      built->source_frame == source_frame) {
+    return built;
+  }
+
+  const Frame* target = FindFrame(target_frame);
+  const Frame* source = FindFrame(source_frame);
+  if (target == nullptr || source == nullptr) {
+    return nullptr;
+  }
+  std::vector<const Frame*> target_path;
+  std::vector<const Frame*> source_path;
+  for (const Frame* frame = target;
+       frame != nullptr && target_path.size() < kMaxChainDepth;
+       frame = frame->parent) {
+    target_path.push_back(frame);
+  }
+  for (const Frame* frame = source;
+       frame != nullptr && source_path.size() < kMaxChainDepth;
+       frame = frame->parent) {
+    source_path.push_back(frame);
+  }
+  size_t source_depth = 0;
+  auto target_it = target_path.end();
+  for (; source_depth < source_path.size(); ++source_depth) {
+    target_it = std::find(target_path.begin(), target_path.end(),
+                          source_path[source_depth]);
+    if (target_it != target_path.end()) {
+      break;
+    }
+  }
+  if (target_it == target_path.end()) {
+    return nullptr;
+  }
+  const size_t target_depth = target_it - target_path.begin();
+
+  std::unique_ptr<Chain> chain(new Chain());
+  chain->target_frame = target_frame;
+  chain->source_frame = source_frame;
+  chain->version = version;
+  const auto add_links = [](const std::vector<const Frame*>& path,
+                            const size_t depth,
+                            std::vector<Chain::Link>* links) {
+    for (size_t i = 0; i < depth; ++i) {
+      const Frame* frame = path[i];
+      if (frame->is_static) {
+        if (!links->empty() && links->back().ring == nullptr) {
+          links->back().transform =
+              Compose(frame->static_transform, links->back().transform);
+        } else {
+          links->emplace_back();
+          links->back().transform = frame->static_transform;
+        }
+        continue;
+      }
+      links->emplace_back();
+      links->back().ring = frame->ring.get();
+      links->back().parent = frame->parent;
+    }
+  };
+  add_links(source_path, source_depth, &chain->source_links);
+  add_links(target_path, target_depth, &chain->target_links);
+
+  chain_map_.Set(key, chain.get());
+  chains_.push_back(std::move(chain));
+  return chains_.back().get();
+}
+
+}  // namespace transform
+}  // namespace apollo
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/base/atomic_hash_map.h"
+
+namespace apollo {
+namespace transform {
+
+// A rigid transform at a time, mapping points of a child frame into its
+// parent frame.
+struct TransformSample {
+  uint64_t stamp_ns = 0;
+  double translation[3] = {0.0, 0.0, 0.0};
+  // x, y, z, w
+  double rotation[4] = {0.0, 0.0, 0.0, 1.0};
+};
+
+// Time indexed copy of the frame tree that Buffer keeps next to
+// tf2::BufferCore, so that the frequent lookups never take a lock.
+//
+// Each frame with a dynamic transform to its parent keeps its latest
+// samples in a ring, readers find the two samples around the requested time
+// by binary search and interpolate them as tf2 does. A slot is stamped with
+// the position it holds, so a reader that gets lapped by the writer fails
+// the lookup instead of reading a torn sample. The frames between a target
+// and a source are resolved once per topology into a chain, in which the
+// static transforms are already composed.
+//
+// SetTransform() and Clear() serialize on a mutex. LookupTransform() only
+// takes it to build a chain for a frame pair it has not seen yet, or after
+// the topology changed. A lookup the cache cannot answer exactly like tf2,
+// e.g. out of the buffered time range or between unconnected frames,
+// returns false and is meant to be retried on tf2::BufferCore.
+class TransformCache {
+ public:
+  static constexpr uint32_t kDefaultRingSize = 1024;
+
+  // ring_size is rounded up to a power of two
+  explicit TransformCache(uint32_t ring_size = kDefaultRingSize);
+  ~TransformCache();
+
+  // Samples of a dynamic transform older than the latest one of the frame
+  // are only kept by tf2.
+  void SetTransform(const std::string& parent_frame,
+                    const std::string& child_frame,
+                    const TransformSample& sample, bool is_static);
+
+  // Transform mapping the points of source_frame into target_frame at
+  // time_ns, 0 being the latest time all the transforms in between have in
+  // common. The stamp of the result is the time used.
+  bool LookupTransform(const std::string& target_frame,
+                       const std::string& source_frame, uint64_t time_ns,
+                       TransformSample* transform) const;
+
+  // Drops all the transforms, static ones included.
+  void Clear();
+
+ private:
+  struct Frame;
+  struct Chain;
+  class Ring;
+
+  Frame* GetOrAddFrame(const std::string& name);
+  const Frame* FindFrame(const std::string& name) const;
+  const Chain* GetChain(const std::string& target_frame,
+                        const std::string& source_frame) const;
+  const Chain* BuildChain(const std::string& target_frame,
+                          const std::string& source_frame) const;
+
+  const uint32_t ring_size_;
+
+  mutable std::mutex mutex_;
+  std::atomic<uint64_t> version_ = {0};
+
+  // owned by frames_ and chains_, the maps are only indexes
+  mutable cyber::base::AtomicHashMap<uint64_t, Frame*, 256> frame_map_;
+  mutable cyber::base::AtomicHashMap<uint64_t, const Chain*, 256> chain_map_;
+  std::vector<std::unique_ptr<Frame>> frames_;
+  // chains of an older topology stay alive for the readers still using them
+  mutable std::vector<std::unique_ptr<const Chain>> chains_;
+};
+
+}  // namespace transform
+}  // namespace apollo
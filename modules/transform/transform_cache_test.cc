@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/transform/transform_cache.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace transform {
+
+namespace {
+
+TransformSample MakeSample(uint64_t stamp_ns, double x, double y, double z,
+                           double yaw) {
+  TransformSample sample;
+  sample.stamp_ns = stamp_ns;
+  sample.translation[0] = x;
+  sample.translation[1] = y;
+  sample.translation[2] = z;
+  sample.rotation[2] = std::sin(yaw / 2.0);
+  sample.rotation[3] = std::cos(yaw / 2.0);
+  return sample;
+}
+
+double Yaw(const TransformSample& sample) {
+  return 2.0 * std::atan2(sample.rotation[2], sample.rotation[3]);
+}
+
+}  // namespace
+
+TEST(TransformCacheTest, ComposesStaticTransforms) {
+  TransformCache cache;
+  cache.SetTransform("novatel", "velodyne128", MakeSample(0, 0, 1, 1, 0),
+                     true);
+  cache.SetTransform("velodyne128", "camera", MakeSample(0, 1, 0, 0, M_PI_2),
+                     true);
+
+  TransformSample transform;
+  ASSERT_TRUE(cache.LookupTransform("novatel", "camera", 0, &transform));
+  EXPECT_EQ(transform.stamp_ns, 0);
+  EXPECT_NEAR(transform.translation[0], 1.0, 1e-9);
+  EXPECT_NEAR(transform.translation[1], 1.0, 1e-9);
+  EXPECT_NEAR(transform.translation[2], 1.0, 1e-9);
+  EXPECT_NEAR(Yaw(transform), M_PI_2, 1e-9);
+
+  // and the other way round
+  ASSERT_TRUE(cache.LookupTransform("camera", "novatel", 0, &transform));
+  EXPECT_NEAR(transform.translation[0], -1.0, 1e-9);
+  EXPECT_NEAR(transform.translation[1], 1.0, 1e-9);
+  EXPECT_NEAR(transform.translation[2], -1.0, 1e-9);
+  EXPECT_NEAR(Yaw(transform), -M_PI_2, 1e-9);
+
+  EXPECT_FALSE(cache.LookupTransform("novatel", "unknown", 0, &transform));
+  EXPECT_FALSE(cache.LookupTransform("novatel", "novatel", 0, &transform));
+}
+
+TEST(TransformCacheTest, InterpolatesDynamicTransforms) {
+  TransformCache cache;
+  cache.SetTransform("novatel", "velodyne128", MakeSample(0, 0, 0, 1, 0),
+                     true);
+  for (uint64_t i = 1; i <= 10; ++i) {
+    cache.SetTransform("world", "novatel",
+                       MakeSample(i * 100, i * 1.0, 0, 0, i * 0.1), false);
+  }
+
+  TransformSample transform;
+  ASSERT_TRUE(cache.LookupTransform("world", "velodyne128", 250, &transform));
+  EXPECT_EQ(transform.stamp_ns, 250);
+  EXPECT_NEAR(transform.translation[0], 2.5, 1e-9);
+  EXPECT_NEAR(transform.translation[2], 1.0, 1e-9);
+  EXPECT_NEAR(Yaw(transform), 0.25, 1e-9);
+
+  // exact stamps need no neighbor
+  ASSERT_TRUE(cache.LookupTransform("world", "velodyne128", 100, &transform));
+  EXPECT_NEAR(transform.translation[0], 1.0, 1e-9);
+  ASSERT_TRUE(cache.LookupTransform("world", "velodyne128", 1000, &transform));
+  EXPECT_NEAR(transform.translation[0], 10.0, 1e-9);
+
+  // latest
+  ASSERT_TRUE(cache.LookupTransform("world", "velodyne128", 0, &transform));
+  EXPECT_EQ(transform.stamp_ns, 1000);
+
+  // outside of the buffered range
+  EXPECT_FALSE(cache.LookupTransform("world", "velodyne128", 50, &transform));
+  EXPECT_FALSE(cache.LookupTransform("world", "velodyne128", 1001, &transform));
+}
+
+TEST(TransformCacheTest, UsesLatestCommonTime) {
+  TransformCache cache;
+  for (uint64_t i = 1; i <= 10; ++i) {
+    cache.SetTransform("world", "novatel", MakeSample(i * 100, i, 0, 0, 0),
+                       false);
+  }
+  for (uint64_t i = 1; i <= 5; ++i) {
+    cache.SetTransform("world", "obstacle", MakeSample(i * 100, 0, i, 0, 0),
+                       false);
+  }
+
+  TransformSample transform;
+  ASSERT_TRUE(cache.LookupTransform("obstacle", "novatel", 0, &transform));
+  EXPECT_EQ(transform.stamp_ns, 500);
+  EXPECT_NEAR(transform.translation[0], 5.0, 1e-9);
+  EXPECT_NEAR(transform.translation[1], -5.0, 1e-9);
+}
+
+TEST(TransformCacheTest, ForgetsOverwrittenAndOutdatedSamples) {
+  TransformCache cache(8);
+  for (uint64_t i = 1; i <= 20; ++i) {
+    cache.SetTransform("world", "novatel", MakeSample(i * 100, i, 0, 0, 0),
+                       false);
+  }
+  TransformSample transform;
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 1000, &transform));
+  ASSERT_TRUE(cache.LookupTransform("world", "novatel", 1500, &transform));
+  EXPECT_NEAR(transform.translation[0], 15.0, 1e-9);
+
+  // reparenting drops the samples of the former parent
+  cache.SetTransform("map", "novatel", MakeSample(2100, 0, 0, 0, 0), false);
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 1500, &transform));
+  EXPECT_FALSE(cache.LookupTransform("map", "novatel", 2050, &transform));
+  EXPECT_TRUE(cache.LookupTransform("map", "novatel", 2100, &transform));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.LookupTransform("map", "novatel", 2100, &transform));
+  // stamps may go back in time after a clear
+  cache.SetTransform("map", "novatel", MakeSample(100, 1, 0, 0, 0), false);
+  ASSERT_TRUE(cache.LookupTransform("map", "novatel", 0, &transform));
+  EXPECT_EQ(transform.stamp_ns, 100);
+}
+
+TEST(TransformCacheTest, ReadsWhileWriting) {
+  TransformCache cache(16);
+  cache.SetTransform("world", "novatel", MakeSample(1, 1, 1, 1, 0), false);
+  std::atomic<bool> done(false);
+  std::thread reader([&] {
+    TransformSample transform;
+    while (!done.load()) {
+      if (cache.LookupTransform("world", "novatel", 0, &transform)) {
+        // every sample has equal translations
+        ASSERT_EQ(transform.translation[0], transform.translation[1]);
+        ASSERT_EQ(transform.translation[0], transform.translation[2]);
+      }
+    }
+  });
+  for (uint64_t i = 2; i < 100000; ++i) {
+    const double value = static_cast<double>(i);
+    cache.SetTransform("world", "novatel",
+                       MakeSample(i, value, value, value, 0), false);
+  }
+  done.store(true);
+  reader.join();
+}
+
+}  // namespace transform
+}  // namespace apollo